@@ -5,6 +5,7 @@ import torch
 import tilelang
 from tilelang import language as T
 from tilelang.profiler import do_bench
+from tilelang.utils.sparse import compress_block_mask
 
 
 def is_hip():
@@ -31,7 +32,7 @@ def get_sparse_attn_mask_from_threshold(x, threshold, use_dense_for_last_block=F
     return dense_mask
 
 
-def blocksparse_flashattn(batch, heads, seq_len, dim, downsample_len, is_causal):
+def blocksparse_flashattn(batch, heads, seq_len, dim, downsample_len, is_causal, compressed=False):
     block_M = 64
     block_N = 64
     num_stages = 2
@@ -43,6 +44,7 @@ def blocksparse_flashattn(batch, heads, seq_len, dim, downsample_len, is_causal)
     dtype = T.float16
     accum_dtype = T.float32
     block_mask_dtype = T.bool
+    num_rows = batch * heads * downsample_len
 
     def kernel_func(block_M, block_N, num_stages, threads):
         @T.macro
@@ -162,7 +164,54 @@ def blocksparse_flashattn(batch, heads, seq_len, dim, downsample_len, is_causal)
                 T.copy(acc_o, O_shared)
                 T.copy(O_shared, Output[bz, by, bx * block_M : (bx + 1) * block_M, :])
 
-        return main
+        @T.prim_func
+        def main_csr(
+            Q: T.Tensor(shape, dtype),
+            K: T.Tensor(shape, dtype),
+            V: T.Tensor(shape, dtype),
+            RowPtr: T.Tensor([num_rows + 1], T.int32),
+            ColIdx: T.Tensor([T.dynamic("nnz")], T.int32),
+            RowOrder: T.Tensor([num_rows], T.int32),
+            Output: T.Tensor(shape, dtype),
+        ):
+            with T.Kernel(num_rows, threads=threads) as bx:
+                Q_shared = T.alloc_shared([block_M, dim], dtype)
+                K_shared = T.alloc_shared([block_N, dim], dtype)
+                V_shared = T.alloc_shared([block_N, dim], dtype)
+                O_shared = T.alloc_shared([block_M, dim], dtype)
+                acc_s = T.alloc_fragment([block_M, block_N], accum_dtype)
+                acc_s_cast = T.alloc_fragment([block_M, block_N], dtype)
+                acc_o = T.alloc_fragment([block_M, dim], accum_dtype)
+                scores_max = T.alloc_fragment([block_M], accum_dtype)
+                scores_max_prev = T.alloc_fragment([block_M], accum_dtype)
+                scores_scale = T.alloc_fragment([block_M], accum_dtype)
+                scores_sum = T.alloc_fragment([block_M], accum_dtype)
+                logsum = T.alloc_fragment([block_M], accum_dtype)
+
+                row = RowOrder[bx]
+                qb = row % downsample_len
+                hid = row // downsample_len % heads
+                bid = row // (downsample_len * heads)
+                row_start = RowPtr[row]
+
+                T.copy(Q[bid, hid, qb * block_M : (qb + 1) * block_M, :], Q_shared)
+                T.fill(acc_o, 0)
+                T.fill(logsum, 0)
+                T.fill(scores_max, -T.infinity(accum_dtype))
+
+                # Only the active blocks of the row, their indices stream in with the K/V tiles
+                for k in T.Pipelined(RowPtr[row + 1] - row_start, num_stages=num_stages):
+                    kb = ColIdx[row_start + k]
+                    MMA0(K, Q_shared, K_shared, acc_s, kb, qb, hid, bid)
+                    Softmax(acc_s, acc_s_cast, scores_max, scores_max_prev, scores_scale, scores_sum, logsum)
+                    Rescale(acc_o, scores_scale)
+                    MMA1(V, V_shared, acc_s_cast, acc_o, kb, hid, bid)
+                for i, j in T.Parallel(block_M, dim):
+                    acc_o[i, j] = T.if_then_else(logsum[i] > 0, acc_o[i, j] / logsum[i], 0)
+                T.copy(acc_o, O_shared)
+                T.copy(O_shared, Output[bid, hid, qb * block_M : (qb + 1) * block_M, :])
+
+        return main_csr if compressed else main
 
     return kernel_func(block_M, block_N, num_stages, threads)
 
@@ -198,8 +247,20 @@ def benchmark_topk_sparse_attention():
             warmup=10,
             rep=100,
         )
+        layout = compress_block_mask(block_mask)
+        csr_program = blocksparse_flashattn(BATCH, N_HEADS, SEQ_LEN, D_HEAD, downsample_len, is_causal=True, compressed=True)
+        csr_kernel = tilelang.compile(csr_program, out_idx=6)
+
+        def benchmark_csr_fn():
+            csr_kernel(q, k, v, layout.row_ptr, layout.col_idx, layout.row_order)
+
+        csr_latency = do_bench(
+            benchmark_csr_fn,
+            warmup=10,
+            rep=100,
+        )
         print(
-            f"BATCH: {BATCH}, N_HEADS: {N_HEADS}, SEQ_LEN: {SEQ_LEN}, D_HEAD: {D_HEAD}, TOPK: {TOPK}, BLOCK: {BLOCK}, ref_latency: {ref_latency}"
+            f"BATCH: {BATCH}, N_HEADS: {N_HEADS}, SEQ_LEN: {SEQ_LEN}, D_HEAD: {D_HEAD}, TOPK: {TOPK}, BLOCK: {BLOCK}, ref_latency: {ref_latency}, csr_latency: {csr_latency}"
         )
 
 
@@ -0,0 +1,319 @@
+"""Compile time of representative TileLang kernels, stage by stage.
+
+Every kernel of ``CASES`` is built from its example under ``examples/`` and
+compiled from scratch ``--repeat`` times, the disk and in-memory caches being
+disabled. The median of every stage is reported:
+
+- ``parse``: tracing the program with the frontend parser (``get_tir``);
+- ``semantic_check``, ``lower_and_legalize``, ``optimize_for_target``: the
+  lowering phases of ``tilelang.engine.lower``;
+- ``codegen``: device and host codegen, without the device compiler;
+- ``device_compile``: NVCC or NVRTC, as recorded by the compile profile;
+- ``other``: the rest of ``tilelang.compile``, mostly building the adapter;
+- ``total``: parse and compile.
+
+Results are keyed by commit and GPU arch so that they can be tracked like the
+runtime regressions of ``maint/scripts/regression_all.py``:
+
+    python benchmark_compile_time.py --output results.json --baseline baseline.json
+
+reports every stage slower than the baseline of the arch by more than
+``--threshold`` (and by more than ``--min-delta`` ms, below which the
+measurement is noise) and exits with 1, ``--update-baseline`` records the
+results as the new baseline.
+"""
+
+from __future__ import annotations
+
+import argparse
+import datetime
+import importlib
+import json
+import statistics
+import subprocess
+import sys
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Callable
+
+import tilelang
+from tilelang.transform import PassConfigKey
+
+EXAMPLES_ROOT = Path(__file__).resolve().parents[2] / "examples"
+
+STAGES = (
+    "parse",
+    "semantic_check",
+    "lower_and_legalize",
+    "optimize_for_target",
+    "codegen",
+    "device_compile",
+    "other",
+    "total",
+)
+
+# Relative slowdown over the baseline reported as a regression.
+_DEFAULT_THRESHOLD = 0.10
+# Absolute slowdown in ms below which a stage is not reported.
+_DEFAULT_MIN_DELTA = 20.0
+
+
+@dataclass
+class Case:
+    """A kernel of an example: ``factory(**params)`` of ``examples/<module>``."""
+
+    name: str
+    module: str
+    factory: str
+    params: dict[str, Any] = field(default_factory=dict)
+    # Minimum compute capability, e.g. 90 for the wgmma kernels.
+    min_arch: int = 0
+
+
+CASES = [
+    Case("gemm", "gemm/example_gemm", "matmul", dict(M=4096, N=4096, K=4096, block_M=128, block_N=128, block_K=32)),
+    Case(
+        "fa3_fwd",
+        "flash_attention/example_mha_fwd_bshd_wgmma_pipelined",
+        "flashattn",
+        dict(batch=8, heads=32, seq_len=4096, dim=128, is_causal=False, block_M=128, block_N=128, num_stages=2, threads=256),
+        min_arch=90,
+    ),
+    Case(
+        "mla_decode",
+        "deepseek_mla/example_mla_decode",
+        "flashattn",
+        dict(
+            batch=1,
+            heads=128,
+            kv_head_num=1,
+            seqlen_kv=8192,
+            dim=512,
+            pe_dim=64,
+            block_N=64,
+            block_H=64,
+            num_split=1,
+            softmax_scale=(512 + 64) ** -0.5,
+        ),
+    ),
+    Case(
+        "nsa_fwd",
+        "deepseek_nsa/example_tilelang_nsa_fwd",
+        "native_sparse_attention",
+        dict(batch=2, heads=64, seq_len=8192, dim=128, is_causal=True, block_size=64, groups=16, selected_blocks=16),
+    ),
+    Case(
+        "moe_routed",
+        "fusedmoe/example_fusedmoe_tilelang",
+        "moe_forward_tilelang_routed",
+        dict(d_hidden=7168, d_expert=2048, n_routed_experts=8, dtype="float16", group_sum=32768, group_count=8),
+    ),
+    Case(
+        "dequant_gemm_fp4",
+        "dequantize_gemm/example_dequant_gemm_bf16_fp4_hopper",
+        "matmul",
+        dict(M=4096, N=4096, K=4096, in_dtype="bfloat16", out_dtype="bfloat16", accum_dtype="float32"),
+        min_arch=90,
+    ),
+]
+
+
+def _load_jit(case: Case):
+    path = EXAMPLES_ROOT / case.module
+    # The examples import their siblings by name
+    if str(path.parent) not in sys.path:
+        sys.path.insert(0, str(path.parent))
+    module = importlib.import_module(path.name)
+    factory = getattr(module, case.factory)
+    # Compile the configuration given rather than autotuning
+    return getattr(factory, "jit_impl", factory)
+
+
+def _measure_once(jit, case: Case, target: str, backend: str) -> dict[str, float]:
+    start = time.perf_counter()
+    func = jit.get_tir(**case.params)
+    parse = (time.perf_counter() - start) * 1e3
+
+    pass_configs = {**(jit.pass_configs or {}), PassConfigKey.TL_ENABLE_COMPILE_PROFILE: True}
+    start = time.perf_counter()
+    kernel = tilelang.compile(func, out_idx=jit.out_idx, target=target, execution_backend=backend, pass_configs=pass_configs)
+    compile_ms = (time.perf_counter() - start) * 1e3
+
+    profile = kernel.compile_profile
+    stages = profile.stages
+    codegen = stages.get("device_codegen", 0.0) + stages.get("host_codegen", 0.0)
+    codegen -= sum(r.time_ms for r in profile.device_compile if r.stage in ("device_codegen", "host_codegen"))
+    result = {
+        "parse": parse,
+        "semantic_check": stages.get("semantic_check", 0.0),
+        "lower_and_legalize": stages.get("lower_and_legalize", 0.0),
+        "optimize_for_target": stages.get("optimize_for_target", 0.0),
+        "codegen": max(codegen, 0.0),
+        "device_compile": sum(r.time_ms for r in profile.device_compile),
+    }
+    result["other"] = max(compile_ms - sum(result.values()) + parse, 0.0)
+    result["total"] = parse + compile_ms
+    return result
+
+
+def measure(case: Case, target: str = "auto", backend: str = "auto", repeat: int = 3) -> dict[str, float]:
+    """Median time in ms of every stage of ``STAGES`` over ``repeat`` cold compiles."""
+    jit = _load_jit(case)
+    runs = [_measure_once(jit, case, target, backend) for _ in range(repeat)]
+    return {stage: statistics.median(run[stage] for run in runs) for stage in STAGES}
+
+
+def _device_arch() -> int | None:
+    try:
+        import torch
+
+        if not torch.cuda.is_available():
+            return None
+        major, minor = torch.cuda.get_device_capability()
+        return major * 10 + minor
+    except Exception:
+        return None
+
+
+def _git_commit() -> str | None:
+    try:
+        return subprocess.check_output(
+            ["git", "rev-parse", "HEAD"], cwd=str(Path(__file__).resolve().parent), stderr=subprocess.DEVNULL, text=True
+        ).strip()
+    except Exception:
+        return None
+
+
+def _compare_to_baseline(
+    results: dict[str, dict[str, float]], baseline: dict[str, dict[str, float]], threshold: float, min_delta: float
+) -> list[tuple[str, str, float, float]]:
+    """(case, stage, baseline ms, ms) of every stage slower than its baseline."""
+    regressions = []
+    for name, stages in sorted(results.items()):
+        for stage, ms in stages.items():
+            old = baseline.get(name, {}).get(stage)
+            if old is None:
+                continue
+            if ms > old * (1.0 + threshold) and ms - old > min_delta:
+                regressions.append((name, stage, old, ms))
+    return regressions
+
+
+def _load_baseline(path: Path, arch: str) -> dict[str, dict[str, float]]:
+    if not path.exists():
+        return {}
+    with open(path) as f:
+        entry = json.load(f).get(arch)
+    return {} if entry is None else entry["results"]
+
+
+def _update_baseline(path: Path, arch: str, commit: str | None, results: dict[str, dict[str, float]]) -> None:
+    data = {}
+    if path.exists():
+        with open(path) as f:
+            data = json.load(f)
+    data[arch] = {"commit": commit, "results": results}
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(data, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+
+def _print_table(results: dict[str, dict[str, float]]) -> None:
+    print("| kernel | " + " | ".join(STAGES) + " |")
+    print("|" + "---|" * (len(STAGES) + 1))
+    for name, stages in results.items():
+        print(f"| {name} | " + " | ".join(f"{stages[stage]:.1f}" for stage in STAGES) + " |")
+
+
+def run(
+    cases: list[Case],
+    *,
+    target: str = "auto",
+    backend: str = "auto",
+    repeat: int = 3,
+    output: str | None = None,
+    baseline: str | None = None,
+    update_baseline: bool = False,
+    threshold: float = _DEFAULT_THRESHOLD,
+    min_delta: float = _DEFAULT_MIN_DELTA,
+    log: Callable[[str], None] = print,
+) -> list[tuple[str, str, float, float]]:
+    """Measures ``cases`` and compares them to ``baseline``, returns the regressions."""
+    # Every repeat compiles from scratch
+    tilelang.disable_cache()
+    arch = _device_arch()
+    results, failures = {}, {}
+    for case in cases:
+        if arch is not None and arch < case.min_arch:
+            log(f"skipping {case.name}: needs sm_{case.min_arch}")
+            continue
+        try:
+            results[case.name] = measure(case, target, backend, repeat)
+        except Exception as error:  # noqa: BLE001
+            failures[case.name] = f"{type(error).__name__}: {error}"
+            log(f"failed {case.name}: {failures[case.name]}")
+            continue
+        log(f"{case.name}: {results[case.name]['total']:.1f} ms")
+
+    _print_table(results)
+    arch_key = f"sm_{arch}" if arch is not None else str(target)
+    commit = _git_commit()
+    regressions = []
+    if baseline is not None:
+        regressions = _compare_to_baseline(results, _load_baseline(Path(baseline), arch_key), threshold, min_delta)
+        if update_baseline:
+            _update_baseline(Path(baseline), arch_key, commit, results)
+    for name, stage, old, ms in regressions:
+        log(f"regression: {name} {stage} {old:.1f} ms -> {ms:.1f} ms ({ms / old:.2f}x)")
+
+    if output is not None:
+        with open(output, "w") as f:
+            json.dump(
+                {
+                    "commit": commit,
+                    "arch": arch_key,
+                    "target": target,
+                    "backend": backend,
+                    "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+                    "results": results,
+                    "failures": failures,
+                    "regressions": [{"kernel": n, "stage": s, "baseline": b, "time": t} for n, s, b, t in regressions],
+                },
+                f,
+                indent=2,
+            )
+            f.write("\n")
+    return regressions
+
+
+def _parse_args(argv: list[str] | None = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Measure the compile time of representative TileLang kernels.")
+    parser.add_argument("--target", default="auto", help="compilation target, e.g. 'cuda -arch=sm_90' without a GPU")
+    parser.add_argument("--backend", default="auto", help="execution backend, e.g. tvm_ffi or nvrtc")
+    parser.add_argument("--repeat", type=int, default=3, help="cold compiles of every kernel, the median is reported")
+    parser.add_argument("--filter", default=None, help="only measure the kernels whose name contains this substring")
+    parser.add_argument("--output", default=None, help="write the results as JSON to this file")
+    parser.add_argument("--baseline", default=None, help="baseline JSON, keyed by GPU arch, to compare against")
+    parser.add_argument("--update-baseline", action="store_true", help="record the results as the baseline of this arch")
+    parser.add_argument("--threshold", type=float, default=_DEFAULT_THRESHOLD, help="relative slowdown counted as a regression")
+    parser.add_argument("--min-delta", type=float, default=_DEFAULT_MIN_DELTA, help="ms of slowdown below which a stage is noise")
+    return parser.parse_args(argv)
+
+
+if __name__ == "__main__":
+    args = _parse_args()
+    selected = [case for case in CASES if not args.filter or args.filter in case.name]
+    found = run(
+        selected,
+        target=args.target,
+        backend=args.backend,
+        repeat=args.repeat,
+        output=args.output,
+        baseline=args.baseline,
+        update_baseline=args.update_baseline,
+        threshold=args.threshold,
+        min_delta=args.min_delta,
+    )
+    sys.exit(1 if found and not args.update_baseline else 0)
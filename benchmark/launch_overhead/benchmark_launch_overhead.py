@@ -0,0 +1,198 @@
+"""Host side launch overhead of the execution backends.
+
+The kernels measured do next to no work, so the time of a launch is the host
+path from the Python call to the kernel start: argument validation, shape
+and stride checks, TMA descriptor encoding and the driver launch itself.
+Every scenario is compiled for every backend of ``--backends`` and reports,
+in microseconds:
+
+- ``latency``: one call followed by a synchronization, the median over
+  ``--iters`` calls, what a dependent launch waits for;
+- ``host``: one call of a burst of ``--iters`` back to back calls, the host
+  time a launch costs when the GPU is never the bottleneck (its inverse is
+  the launch throughput).
+
+The scenarios are an empty kernel, a tiny copy, the tiny copy with
+``--num-args`` extra tensor arguments, a copy over a dynamic length, a TMA
+copy (sm_90 and newer) and the tiny copy replayed through ``JITKernel.graph()``.
+
+    python benchmark_launch_overhead.py --backends tvm_ffi cython nvrtc
+
+``regression_launch_overhead.py`` reports the host time of the same
+scenarios to ``maint/scripts/regression_all.py``.
+"""
+
+from __future__ import annotations
+
+import argparse
+import statistics
+import time
+from collections.abc import Callable, Sequence
+
+import torch
+import tilelang
+import tilelang.language as T
+from tvm import tir
+
+N = 128
+BACKENDS = ("tvm_ffi", "cython", "nvrtc", "cutedsl")
+SCENARIOS = ("empty", "tiny", "many_args", "dynamic", "tma", "graph")
+
+
+def empty_kernel():
+    @T.prim_func
+    def empty(A: T.Tensor((N,), T.float32)):
+        with T.Kernel(1, threads=32) as _:
+            T.evaluate(0)
+
+    return empty
+
+
+def tiny_kernel():
+    @T.prim_func
+    def tiny(A: T.Tensor((N,), T.float32), B: T.Tensor((N,), T.float32)):
+        with T.Kernel(1, threads=N) as _:
+            for i in T.Parallel(N):
+                B[i] = A[i]
+
+    return tiny
+
+
+def with_extra_args(func: tir.PrimFunc, num_args: int) -> tir.PrimFunc:
+    """``func`` taking ``num_args`` more tensors it does not use, checked by the host like any other."""
+    params, buffer_map = list(func.params), dict(func.buffer_map)
+    for i in range(num_args):
+        handle = tir.Var(f"X{i}_handle", "handle")
+        params.append(handle)
+        buffer_map[handle] = tir.decl_buffer((N,), "float32", name=f"X{i}")
+    return tir.PrimFunc(params, func.body, func.ret_type, buffer_map, func.attrs)
+
+
+def dynamic_kernel():
+    length = T.dynamic("length")
+
+    @T.prim_func
+    def dynamic(A: T.Tensor((length,), T.float32), B: T.Tensor((length,), T.float32)):
+        with T.Kernel(T.ceildiv(length, N), threads=N) as bx:
+            for i in T.Parallel(N):
+                if bx * N + i < length:
+                    B[bx * N + i] = A[bx * N + i]
+
+    return dynamic
+
+
+def tma_kernel():
+    @T.prim_func
+    def tma(A: T.Tensor((N, N), T.float16), B: T.Tensor((N, N), T.float16)):
+        with T.Kernel(1, threads=128) as _:
+            A_shared = T.alloc_shared((N, N), T.float16)
+            T.copy(A, A_shared)
+            T.copy(A_shared, B)
+
+    return tma
+
+
+def make_scenario(scenario: str, num_args: int = 16) -> tuple[tir.PrimFunc, Callable[[], list[torch.Tensor]]]:
+    """The kernel of a scenario and a factory of its arguments."""
+
+    def vectors(count):
+        return lambda: [torch.zeros(N, dtype=torch.float32, device="cuda") for _ in range(count)]
+
+    if scenario == "empty":
+        return empty_kernel(), vectors(1)
+    if scenario in ("tiny", "graph"):
+        return tiny_kernel(), vectors(2)
+    if scenario == "many_args":
+        return with_extra_args(tiny_kernel(), num_args), vectors(2 + num_args)
+    if scenario == "dynamic":
+        return dynamic_kernel(), lambda: [torch.zeros(3 * N + 5, dtype=torch.float32, device="cuda") for _ in range(2)]
+    if scenario == "tma":
+        return tma_kernel(), lambda: [torch.zeros(N, N, dtype=torch.float16, device="cuda") for _ in range(2)]
+    raise ValueError(f"unknown scenario {scenario!r}, expected one of {SCENARIOS}")
+
+
+def compile_scenario(scenario: str, backend: str, num_args: int = 16):
+    """The callable launching a scenario on a backend and its arguments."""
+    func, make_args = make_scenario(scenario, num_args)
+    target = "cutedsl" if backend == "cutedsl" else "auto"
+    kernel = tilelang.compile(func, target=target, execution_backend=backend)
+    launch = kernel.graph() if scenario == "graph" else kernel
+    return launch, make_args()
+
+
+def measure_latency(launch: Callable, args: Sequence[torch.Tensor], iters: int = 1000, warmup: int = 100) -> float:
+    """Median microseconds of one launch followed by a synchronization."""
+    for _ in range(warmup):
+        launch(*args)
+    torch.cuda.synchronize()
+    samples = []
+    for _ in range(iters):
+        start = time.perf_counter()
+        launch(*args)
+        torch.cuda.synchronize()
+        samples.append(time.perf_counter() - start)
+    return statistics.median(samples) * 1e6
+
+
+def measure_host(launch: Callable, args: Sequence[torch.Tensor], iters: int = 1000, warmup: int = 100, rounds: int = 5) -> float:
+    """Microseconds of one launch of a burst of back to back launches, the best round."""
+    for _ in range(warmup):
+        launch(*args)
+    torch.cuda.synchronize()
+    best = float("inf")
+    for _ in range(rounds):
+        start = time.perf_counter()
+        for _ in range(iters):
+            launch(*args)
+        best = min(best, time.perf_counter() - start)
+        torch.cuda.synchronize()
+    return best / iters * 1e6
+
+
+def _arch() -> int:
+    major, minor = torch.cuda.get_device_capability()
+    return major * 10 + minor
+
+
+def run(
+    backends: Sequence[str], scenarios: Sequence[str], iters: int = 1000, num_args: int = 16
+) -> dict[tuple[str, str], tuple[float, float]]:
+    """(latency, host) in microseconds of every scenario supported by every backend."""
+    results = {}
+    for scenario in scenarios:
+        if scenario == "tma" and _arch() < 90:
+            print(f"skipping {scenario}: needs sm_90")
+            continue
+        for backend in backends:
+            try:
+                launch, args = compile_scenario(scenario, backend, num_args)
+            except Exception as error:  # noqa: BLE001
+                print(f"skipping {scenario} on {backend}: {type(error).__name__}: {error}")
+                continue
+            results[scenario, backend] = (measure_latency(launch, args, iters), measure_host(launch, args, iters))
+    return results
+
+
+def _print_table(results: dict[tuple[str, str], tuple[float, float]], backends: Sequence[str]) -> None:
+    print("| scenario | " + " | ".join(f"{b} latency | {b} host" for b in backends) + " |")
+    print("|" + "---|" * (2 * len(backends) + 1))
+    for scenario in dict.fromkeys(s for s, _ in results):
+        cells = []
+        for backend in backends:
+            latency, host = results.get((scenario, backend), (None, None))
+            cells += ["-", "-"] if latency is None else [f"{latency:.2f}", f"{host:.2f}"]
+        print(f"| {scenario} | " + " | ".join(cells) + " |")
+
+
+def _parse_args(argv: list[str] | None = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Measure the host side launch overhead of the TileLang execution backends.")
+    parser.add_argument("--backends", nargs="+", default=list(BACKENDS), choices=BACKENDS)
+    parser.add_argument("--scenarios", nargs="+", default=list(SCENARIOS), choices=SCENARIOS)
+    parser.add_argument("--iters", type=int, default=1000, help="launches per measurement")
+    parser.add_argument("--num-args", type=int, default=16, help="extra tensor arguments of the many_args scenario")
+    return parser.parse_args(argv)
+
+
+if __name__ == "__main__":
+    args = _parse_args()
+    _print_table(run(args.backends, args.scenarios, args.iters, args.num_args), args.backends)
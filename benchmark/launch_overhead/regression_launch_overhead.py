@@ -0,0 +1,28 @@
+import tilelang.testing
+import benchmark_launch_overhead as bench
+
+# The backends the regression suite tracks, every one on every CUDA GPU
+BACKENDS = ("tvm_ffi", "cython", "nvrtc")
+
+
+def run_regression_perf(scenario, backend):
+    launch, args = bench.compile_scenario(scenario, backend)
+    # Host time of a launch in ms
+    return bench.measure_host(launch, args) * 1e-3
+
+
+def regression_launch_overhead():
+    for scenario in ("empty", "tiny", "many_args", "dynamic", "graph"):
+        for backend in BACKENDS:
+            tilelang.testing.process_func(run_regression_perf, f"launch_{scenario}_{backend}", scenario=scenario, backend=backend)
+
+
+def regression_launch_overhead_tma():
+    if bench._arch() < 90:
+        return
+    for backend in BACKENDS:
+        tilelang.testing.process_func(run_regression_perf, f"launch_tma_{backend}", scenario="tma", backend=backend)
+
+
+if __name__ == "__main__":
+    tilelang.testing.regression()
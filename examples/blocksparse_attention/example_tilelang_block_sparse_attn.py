@@ -4,6 +4,7 @@ import tilelang
 import tilelang.language as T
 from tilelang.profiler import do_bench
 import torch.nn.functional as F
+from tilelang.utils.sparse import compress_block_mask
 
 
 def get_sparse_attn_mask_from_topk(x, topk, use_dense_for_last_block=False):
@@ -126,6 +127,102 @@ def blocksparse_flashattn(batch, heads, seq_len, dim, downsample_len, is_causal)
     return kernel_func(block_M, block_N, num_stages, threads)
 
 
+@tilelang.jit(
+    out_idx=[6],
+    pass_configs={
+        tilelang.PassConfigKey.TL_ENABLE_FAST_MATH: True,
+    },
+)
+def blocksparse_flashattn_csr(batch, heads, seq_len, dim, downsample_len, is_causal, block_M=64, block_N=64, num_stages=2, threads=128):
+    """
+    Block-sparse attention over the CSR schedule of `compress_block_mask`.
+
+    Each CTA takes the row `RowOrder[bx]` (one query block of one head) and
+    only iterates its active KV blocks; the KV block indices are read in the
+    pipelined loop, so they stream in with the K/V tiles they select.
+    """
+    scale = (1.0 / dim) ** 0.5 * 1.44269504  # log2(e)
+    shape = [batch, heads, seq_len, dim]
+    num_rows = batch * heads * downsample_len
+    nnz = T.dynamic("nnz")
+
+    dtype = T.float16
+    accum_dtype = T.float32
+
+    @T.prim_func
+    def blocksparse_flashattn_csr(
+        Q: T.Tensor(shape, dtype),
+        K: T.Tensor(shape, dtype),
+        V: T.Tensor(shape, dtype),
+        RowPtr: T.Tensor([num_rows + 1], T.int32),
+        ColIdx: T.Tensor([nnz], T.int32),
+        RowOrder: T.Tensor([num_rows], T.int32),
+        Output: T.Tensor(shape, dtype),
+    ):
+        with T.Kernel(num_rows, threads=threads) as bx:
+            Q_shared = T.alloc_shared([block_M, dim], dtype)
+            K_shared = T.alloc_shared([block_N, dim], dtype)
+            V_shared = T.alloc_shared([block_N, dim], dtype)
+            O_shared = T.alloc_shared([block_M, dim], dtype)
+            acc_s = T.alloc_fragment([block_M, block_N], accum_dtype)
+            acc_s_cast = T.alloc_fragment([block_M, block_N], dtype)
+            acc_o = T.alloc_fragment([block_M, dim], accum_dtype)
+            scores_max = T.alloc_fragment([block_M], accum_dtype)
+            scores_max_prev = T.alloc_fragment([block_M], accum_dtype)
+            scores_scale = T.alloc_fragment([block_M], accum_dtype)
+            scores_sum = T.alloc_fragment([block_M], accum_dtype)
+            logsum = T.alloc_fragment([block_M], accum_dtype)
+
+            row = RowOrder[bx]
+            qb = row % downsample_len
+            hid = row // downsample_len % heads
+            bid = row // (downsample_len * heads)
+            row_start = RowPtr[row]
+
+            T.copy(Q[bid, hid, qb * block_M : (qb + 1) * block_M, :], Q_shared)
+            T.fill(acc_o, 0)
+            T.fill(logsum, 0)
+            T.fill(scores_max, -T.infinity(accum_dtype))
+
+            for k in T.Pipelined(RowPtr[row + 1] - row_start, num_stages=num_stages):
+                kb = ColIdx[row_start + k]
+                T.copy(K[bid, hid, kb * block_N : (kb + 1) * block_N, :], K_shared)
+                if is_causal:
+                    for i, j in T.Parallel(block_M, block_N):
+                        acc_s[i, j] = T.if_then_else(qb * block_M + i >= kb * block_N + j, 0, -T.infinity(acc_s.dtype))
+                else:
+                    T.clear(acc_s)
+                T.gemm(Q_shared, K_shared, acc_s, transpose_B=True, policy=T.GemmWarpPolicy.FullRow)
+
+                T.copy(scores_max, scores_max_prev)
+                T.fill(scores_max, -T.infinity(accum_dtype))
+                T.reduce_max(acc_s, scores_max, dim=1, clear=False)
+                for i in T.Parallel(block_M):
+                    scores_max[i] = T.max(scores_max[i], scores_max_prev[i])
+                for i in T.Parallel(block_M):
+                    scores_scale[i] = T.exp2(scores_max_prev[i] * scale - scores_max[i] * scale)
+                for i, j in T.Parallel(block_M, block_N):
+                    acc_s[i, j] = T.exp2(acc_s[i, j] * scale - scores_max[i] * scale)
+                T.reduce_sum(acc_s, scores_sum, dim=1)
+                for i in T.Parallel(block_M):
+                    logsum[i] = logsum[i] * scores_scale[i] + scores_sum[i]
+                T.copy(acc_s, acc_s_cast)
+
+                for i, j in T.Parallel(block_M, dim):
+                    acc_o[i, j] *= scores_scale[i]
+
+                T.copy(V[bid, hid, kb * block_N : (kb + 1) * block_N, :], V_shared)
+                T.gemm(acc_s_cast, V_shared, acc_o, policy=T.GemmWarpPolicy.FullRow)
+
+            # Query blocks without an active block attend to nothing
+            for i, j in T.Parallel(block_M, dim):
+                acc_o[i, j] = T.if_then_else(logsum[i] > 0, acc_o[i, j] / logsum[i], 0)
+            T.copy(acc_o, O_shared)
+            T.copy(O_shared, Output[bid, hid, qb * block_M : (qb + 1) * block_M, :])
+
+    return blocksparse_flashattn_csr
+
+
 def test_topk_sparse_attention():
     # Config
     BATCH, N_HEADS, SEQ_LEN, D_HEAD = 1, 1, 256, 64
@@ -171,6 +268,13 @@ def test_topk_sparse_attention():
     torch.testing.assert_close(tilelang_output, ref_output, atol=1e-2, rtol=1e-2)
     print("Pass topk sparse attention test with qlen == klen")
 
+    # The compressed schedule only visits the active blocks
+    layout = compress_block_mask(block_mask)
+    csr_kernel = blocksparse_flashattn_csr(BATCH, N_HEADS, SEQ_LEN, D_HEAD, downsample_len, is_causal=True)
+    csr_output = csr_kernel(q, k, v, layout.row_ptr, layout.col_idx, layout.row_order)
+    torch.testing.assert_close(csr_output, ref_output, atol=1e-2, rtol=1e-2)
+    print("Pass topk sparse attention test with the CSR schedule")
+
 
 def main():
     test_topk_sparse_attention()
@@ -0,0 +1,11 @@
+import tilelang.testing
+import example_allgather_gemm
+
+
+@tilelang.testing.requires_cuda
+def test_example_allgather_gemm():
+    example_allgather_gemm.main(do_bench=False)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,240 @@
+import argparse
+import functools
+import torch
+import tilelang
+import tilelang.language as T
+from tilelang.autotuner import AutoTuner
+from tilelang.carver import FlashAttentionTemplate
+from tilelang.carver.arch import auto_infer_current_arch
+
+
+def attention_program(
+    batch,
+    heads,
+    kv_heads,
+    seq_q,
+    seq_kv,
+    dim,
+    is_causal,
+    pack_gqa,
+    block_M=64,
+    block_N=64,
+    num_stages=1,
+    threads=128,
+    num_split=1,
+):
+    """
+    Flash attention forward for prefill, chunked prefill and split-KV decode.
+
+    Q is ``[batch, seq_q, heads, dim]`` and K, V are ``[batch, seq_kv, kv_heads, dim]``. The causal
+    mask is aligned to the bottom right, so the queries are the last ``seq_q`` positions of the
+    sequence, and key blocks past the diagonal of a tile are skipped. With ``pack_gqa`` the query
+    heads of a KV head share the rows of a tile (row ``r`` is query ``r // group`` of head
+    ``r % group``). With ``num_split > 1`` each split writes its partial output and log-sum-exp,
+    and a second kernel combines them.
+    """
+    scale = (1.0 / dim) ** 0.5 * 1.44269504  # log2(e)
+    group = heads // kv_heads
+    pack = group if pack_gqa else 1
+    rows = seq_q * pack
+    problems = kv_heads if pack_gqa else heads
+    offset = seq_kv - seq_q
+    split_len = ((seq_kv + num_split - 1) // num_split + block_N - 1) // block_N * block_N
+    q_shape = [batch, seq_q, heads, dim]
+    kv_shape = [batch, seq_kv, kv_heads, dim]
+    dtype = T.float16
+    accum_dtype = T.float32
+    # A finite floor keeps the rescaling of rows without a visible key in a split from turning NaN
+    neg_large = -1e30
+
+    def query_pos(bx, i):
+        return (bx * block_M + i) // pack
+
+    def query_head(bx, hid, i):
+        return hid * group + (bx * block_M + i) % group if pack_gqa else hid
+
+    @T.prim_func
+    def main(
+        Q: T.Tensor(q_shape, dtype),
+        K: T.Tensor(kv_shape, dtype),
+        V: T.Tensor(kv_shape, dtype),
+        glse: T.Tensor([batch, seq_q, heads, num_split], accum_dtype),
+        Output_partial: T.Tensor([batch, seq_q, heads, num_split, dim], accum_dtype),
+        Output: T.Tensor(q_shape, dtype),
+    ):
+        with T.Kernel(T.ceildiv(rows, block_M), problems * num_split, batch, threads=threads) as (bx, by, bz):
+            Q_shared = T.alloc_shared([block_M, dim], dtype)
+            K_shared = T.alloc_shared([block_N, dim], dtype)
+            V_shared = T.alloc_shared([block_N, dim], dtype)
+            acc_s = T.alloc_fragment([block_M, block_N], accum_dtype)
+            acc_s_cast = T.alloc_fragment([block_M, block_N], dtype)
+            acc_o = T.alloc_fragment([block_M, dim], accum_dtype)
+            scores_max = T.alloc_fragment([block_M], accum_dtype)
+            scores_max_prev = T.alloc_fragment([block_M], accum_dtype)
+            scores_scale = T.alloc_fragment([block_M], accum_dtype)
+            scores_sum = T.alloc_fragment([block_M], accum_dtype)
+            logsum = T.alloc_fragment([block_M], accum_dtype)
+
+            hid = by // num_split
+            sid = by % num_split
+            kv_head = hid if pack_gqa else hid // group
+
+            for i, d in T.Parallel(block_M, dim):
+                Q_shared[i, d] = T.if_then_else(query_pos(bx, i) < seq_q, Q[bz, T.min(query_pos(bx, i), seq_q - 1), query_head(bx, hid, i), d], 0)
+            T.fill(acc_o, 0)
+            T.fill(logsum, 0)
+            T.fill(scores_max, neg_large)
+
+            kv_start = sid * split_len
+            kv_end = T.min(seq_kv, kv_start + split_len)
+            # Causal block skipping: the last row of the tile bounds the visible keys
+            loop_end = T.min(kv_end, (T.min(bx * block_M + block_M, rows) - 1) // pack + 1 + offset) if is_causal else kv_end
+            loop_range = T.ceildiv(T.max(loop_end - kv_start, 0), block_N)
+
+            for k in T.Pipelined(loop_range, num_stages=num_stages):
+                T.copy(K[bz, kv_start + k * block_N : kv_start + (k + 1) * block_N, kv_head, :], K_shared)
+                for i, j in T.Parallel(block_M, block_N):
+                    kv_idx = kv_start + k * block_N + j
+                    if is_causal:
+                        acc_s[i, j] = T.if_then_else((kv_idx < kv_end) & (kv_idx <= query_pos(bx, i) + offset), 0, -T.infinity(accum_dtype))
+                    else:
+                        acc_s[i, j] = T.if_then_else(kv_idx < kv_end, 0, -T.infinity(accum_dtype))
+                T.gemm(Q_shared, K_shared, acc_s, transpose_B=True, policy=T.GemmWarpPolicy.FullRow)
+
+                T.copy(scores_max, scores_max_prev)
+                T.fill(scores_max, -T.infinity(accum_dtype))
+                T.reduce_max(acc_s, scores_max, dim=1, clear=False)
+                for i in T.Parallel(block_M):
+                    scores_max[i] = T.max(scores_max[i], scores_max_prev[i])
+                for i in T.Parallel(block_M):
+                    scores_scale[i] = T.exp2(scores_max_prev[i] * scale - scores_max[i] * scale)
+                for i, j in T.Parallel(block_M, block_N):
+                    acc_s[i, j] = T.exp2(acc_s[i, j] * scale - scores_max[i] * scale)
+                T.reduce_sum(acc_s, scores_sum, dim=1)
+                for i in T.Parallel(block_M):
+                    logsum[i] = logsum[i] * scores_scale[i] + scores_sum[i]
+                T.copy(acc_s, acc_s_cast)
+                for i, j in T.Parallel(block_M, dim):
+                    acc_o[i, j] *= scores_scale[i]
+
+                T.copy(V[bz, kv_start + k * block_N : kv_start + (k + 1) * block_N, kv_head, :], V_shared)
+                T.gemm(acc_s_cast, V_shared, acc_o, policy=T.GemmWarpPolicy.FullRow)
+
+            for i, j in T.Parallel(block_M, dim):
+                acc_o[i, j] = T.if_then_else(logsum[i] > 0, acc_o[i, j] / logsum[i], 0)
+            if num_split == 1:
+                for i, d in T.Parallel(block_M, dim):
+                    if query_pos(bx, i) < seq_q:
+                        Output[bz, query_pos(bx, i), query_head(bx, hid, i), d] = acc_o[i, d]
+            else:
+                for i in T.Parallel(block_M):
+                    if query_pos(bx, i) < seq_q:
+                        glse[bz, query_pos(bx, i), query_head(bx, hid, i), sid] = T.if_then_else(
+                            logsum[i] > 0, T.log2(logsum[i]) + scores_max[i] * scale, -T.infinity(accum_dtype)
+                        )
+                for i, d in T.Parallel(block_M, dim):
+                    if query_pos(bx, i) < seq_q:
+                        Output_partial[bz, query_pos(bx, i), query_head(bx, hid, i), sid, d] = acc_o[i, d]
+
+        if num_split > 1:
+            # Combine the splits with their log-sum-exp
+            with T.Kernel(heads, seq_q, batch, threads=128) as (h, q, b):
+                o_accum = T.alloc_fragment([dim], accum_dtype)
+                lse_max = T.alloc_var(accum_dtype)
+                lse_sum = T.alloc_var(accum_dtype)
+
+                lse_max = -T.infinity(accum_dtype)
+                for s in T.serial(num_split):
+                    lse_max = T.max(lse_max, glse[b, q, h, s])
+                lse_sum = 0
+                for s in T.serial(num_split):
+                    lse_sum += T.exp2(glse[b, q, h, s] - lse_max)
+                lse_max = T.log2(lse_sum) + lse_max
+                T.clear(o_accum)
+                for s in T.serial(num_split):
+                    for d in T.Parallel(dim):
+                        o_accum[d] += Output_partial[b, q, h, s, d] * T.exp2(glse[b, q, h, s] - lse_max)
+                for d in T.Parallel(dim):
+                    Output[b, q, h, d] = o_accum[d]
+
+    return main
+
+
+attention = tilelang.jit(out_idx=[-1], pass_configs={tilelang.PassConfigKey.TL_ENABLE_FAST_MATH: True})(attention_program)
+
+
+def ref_program(Q, K, V, is_causal):
+    dim = Q.size(-1)
+    group = Q.size(2) // K.size(2)
+    seq_q, seq_kv = Q.size(1), K.size(1)
+    K = K.repeat_interleave(group, dim=2)
+    V = V.repeat_interleave(group, dim=2)
+    scores = torch.einsum("bqhd,bkhd->bhqk", Q.float(), K.float()) / dim**0.5
+    if is_causal:
+        q_pos = torch.arange(seq_q, device=Q.device)[:, None] + seq_kv - seq_q
+        kv_pos = torch.arange(seq_kv, device=Q.device)[None, :]
+        scores = scores.masked_fill(kv_pos > q_pos, float("-inf"))
+    attention = torch.softmax(scores, dim=-1)
+    return torch.einsum("bhqk,bkhd->bqhd", attention, V.float()).to(Q.dtype)
+
+
+def run_attention(batch, heads, kv_heads, seq_q, seq_kv, dim, is_causal, mode, tune=False):
+    template = FlashAttentionTemplate(
+        batch_size=batch,
+        num_heads=heads,
+        num_kv_heads=kv_heads,
+        seq_length=seq_q,
+        seq_kv_length=seq_kv,
+        head_dim=dim,
+        is_causal=is_causal,
+        mode=mode,
+        in_dtype=T.float16,
+        out_dtype=T.float16,
+        accum_dtype=T.float32,
+    ).with_arch(auto_infer_current_arch())
+    configs = template.get_autotune_configs(topk=10)
+    shape = (batch, heads, kv_heads, seq_q, seq_kv, dim, is_causal, template.pack_gqa)
+
+    if tune:
+        autotuner = (
+            AutoTuner.from_kernel(kernel=functools.partial(attention_program, *shape), configs=configs)
+            .set_compile_args(out_idx=[-1], target="auto")
+            .set_profile_args(ref_prog=lambda Q, K, V, *_: ref_program(Q, K, V, is_causal))
+        )
+        result = autotuner.run(warmup=10, rep=10)
+        config, kernel = result.config, result.kernel
+    else:
+        config = configs[0]
+        kernel = attention(*shape, **config)
+
+    num_split = config["num_split"]
+    Q = torch.randn(batch, seq_q, heads, dim, device="cuda", dtype=torch.float16)
+    K = torch.randn(batch, seq_kv, kv_heads, dim, device="cuda", dtype=torch.float16)
+    V = torch.randn(batch, seq_kv, kv_heads, dim, device="cuda", dtype=torch.float16)
+    glse = torch.empty(batch, seq_q, heads, num_split, device="cuda", dtype=torch.float32)
+    Output_partial = torch.empty(batch, seq_q, heads, num_split, dim, device="cuda", dtype=torch.float32)
+
+    out = kernel(Q, K, V, glse, Output_partial)
+    torch.testing.assert_close(out, ref_program(Q, K, V, is_causal), rtol=1e-2, atol=1e-2)
+    print(f"{mode}: {config} (pack_gqa={template.pack_gqa}) matches torch")
+
+    profiler = kernel.get_profiler(tensor_supply_type=tilelang.TensorSupplyType.Randn)
+    latency = profiler.do_bench(warmup=25, rep=100)
+    print(f"{mode}: {latency:.3f} ms, {template.estimated_flops() / latency * 1e-9:.2f} TFlops")
+
+
+def main(batch: int = 1, heads: int = 32, kv_heads: int = 8, dim: int = 128, tune: bool = False):
+    run_attention(batch, heads, kv_heads, 2048, 2048, dim, is_causal=True, mode="prefill", tune=tune)
+    run_attention(batch, heads, kv_heads, 512, 4096, dim, is_causal=True, mode="chunked_prefill", tune=tune)
+    run_attention(batch, heads, kv_heads, 1, 8192, dim, is_causal=True, mode="decode", tune=tune)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--batch", type=int, default=1, help="batch size")
+    parser.add_argument("--heads", type=int, default=32, help="query heads")
+    parser.add_argument("--kv_heads", type=int, default=8, help="key/value heads")
+    parser.add_argument("--dim", type=int, default=128, help="head dim")
+    parser.add_argument("--tune", action="store_true", help="autotune the carver configs")
+    args = parser.parse_args()
+    main(args.batch, args.heads, args.kv_heads, args.dim, args.tune)
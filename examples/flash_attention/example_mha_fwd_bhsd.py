@@ -1,6 +1,7 @@
 import torch
 import torch.nn.functional as F
 import tilelang
+import tilelang.testing
 from tilelang.autotuner import *
 import tilelang.language as T
 import itertools
@@ -166,7 +167,13 @@ def run_regression_perf(
 ):
     kernel = flashattn(batch, heads, seq_q, seq_kv, dim, is_causal, block_M=128, block_N=128, num_stages=2, threads=256)
     profiler = kernel.get_profiler()
-    return profiler.do_bench(backend="cupti")
+    latency = profiler.do_bench(backend="cupti")
+    total_flops = 4.0 * batch * heads * seq_q * seq_kv * dim
+    if is_causal:
+        total_flops *= 0.5
+    # Q, K, V and O in float16.
+    total_bytes = 2 * batch * heads * dim * (2 * seq_q + 2 * seq_kv)
+    return tilelang.testing.PerfMeasurement(latency, flops=total_flops, bytes=total_bytes)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,146 @@
+"""Cluster-cooperative FlashAttention forward (sm_90+).
+
+The CTAs of the Q tiles of one head all stream the same K/V tiles. Here the
+``cluster_size`` consecutive Q tiles of a head form a thread block cluster,
+and every K/V tile is loaded once per cluster by a TMA multicast into the
+shared memory of all its CTAs, which divides the L2 traffic of K and V by
+``cluster_size``. A ``T.cluster_sync()`` at the top of every iteration makes
+sure the peers are done with the previous tiles before they are overwritten.
+"""
+
+import torch
+import torch.nn.functional as F
+import tilelang
+import tilelang.language as T
+import argparse
+from functools import partial
+
+
+@tilelang.jit(
+    out_idx=[3],
+    pass_configs={
+        tilelang.PassConfigKey.TL_ENABLE_FAST_MATH: True,
+        # The loop synchronizes the cluster itself rather than through producer/consumer barriers
+        tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True,
+    },
+)
+def flashattn(batch, heads, seq_len, dim, is_causal, block_M=128, block_N=64, cluster_size=2, threads=128):
+    scale = (1.0 / dim) ** 0.5 * 1.44269504  # log2(e)
+    shape = [batch, seq_len, heads, dim]
+    dtype = T.float16
+    accum_dtype = T.float32
+    num_q_tiles = (seq_len + block_M - 1) // block_M
+    assert num_q_tiles % cluster_size == 0, f"{num_q_tiles} Q tiles do not split into clusters of {cluster_size}"
+    multicast = (1 << cluster_size) - 1
+
+    @T.prim_func
+    def main(
+        Q: T.Tensor(shape, dtype),
+        K: T.Tensor(shape, dtype),
+        V: T.Tensor(shape, dtype),
+        Output: T.Tensor(shape, dtype),
+    ):
+        with T.Kernel(num_q_tiles, heads, batch, threads=threads, cluster_dims=(cluster_size, 1, 1)) as (bx, by, bz):
+            Q_shared = T.alloc_shared([block_M, dim], dtype)
+            K_shared = T.alloc_shared([block_N, dim], dtype)
+            V_shared = T.alloc_shared([block_N, dim], dtype)
+            O_shared = T.alloc_shared([block_M, dim], dtype)
+            acc_s = T.alloc_fragment([block_M, block_N], accum_dtype)
+            acc_s_cast = T.alloc_fragment([block_M, block_N], dtype)
+            acc_o = T.alloc_fragment([block_M, dim], accum_dtype)
+            scores_max = T.alloc_fragment([block_M], accum_dtype)
+            logsum = T.alloc_fragment([block_M], accum_dtype)
+
+            T.copy(Q[bz, bx * block_M : (bx + 1) * block_M, by, :], Q_shared)
+            T.fill(acc_o, 0)
+            T.fill(logsum, 0)
+            T.fill(scores_max, -T.infinity(accum_dtype))
+
+            # Every CTA of the cluster runs the trip count of the last one, the
+            # tiles past its own diagonal are fully masked.
+            cluster_end = (bx // cluster_size + 1) * cluster_size * block_M
+            loop_range = T.min(T.ceildiv(seq_len, block_N), T.ceildiv(cluster_end, block_N)) if is_causal else T.ceildiv(seq_len, block_N)
+
+            for k in T.serial(loop_range):
+                # The peers have consumed the K/V tiles of the previous iteration
+                T.cluster_sync()
+                T.copy(K[bz, k * block_N : (k + 1) * block_N, by, :], K_shared, multicast=multicast)
+                if is_causal:
+                    for i, j in T.Parallel(block_M, block_N):
+                        acc_s[i, j] = T.if_then_else(bx * block_M + i >= k * block_N + j, 0, -T.infinity(acc_s.dtype))
+                else:
+                    for i, j in T.Parallel(block_M, block_N):
+                        acc_s[i, j] = T.if_then_else(k * block_N + j >= seq_len, -T.infinity(acc_s.dtype), 0)
+                T.gemm(Q_shared, K_shared, acc_s, transpose_B=True, policy=T.GemmWarpPolicy.FullRow)
+
+                T.online_softmax(acc_s, scores_max, logsum, acc_o, scale=scale)
+                T.copy(acc_s, acc_s_cast)
+
+                T.copy(V[bz, k * block_N : (k + 1) * block_N, by, :], V_shared, multicast=multicast)
+                T.gemm(acc_s_cast, V_shared, acc_o, policy=T.GemmWarpPolicy.FullRow)
+
+            for i, j in T.Parallel(block_M, dim):
+                acc_o[i, j] /= logsum[i]
+            T.copy(acc_o, O_shared)
+            T.copy(O_shared, Output[bz, bx * block_M : (bx + 1) * block_M, by, :])
+
+    return main
+
+
+def ref_program(Q, K, V, is_causal):
+    dim = Q.size(-1)
+    scores = torch.einsum("bqhd,bkhd->bhqk", Q, K)
+    scores = scores / torch.sqrt(torch.tensor(dim, dtype=scores.dtype))
+    if is_causal:
+        seq_len = Q.size(1)
+        mask = torch.tril(torch.ones(seq_len, seq_len, device=scores.device))
+        mask = mask.unsqueeze(0).unsqueeze(0)
+        scores = scores.masked_fill(mask == 0, float("-inf"))
+    attention_weights = F.softmax(scores, dim=-1)
+    output = torch.einsum("bhqk,bkhd->bqhd", attention_weights, V)
+    return output
+
+
+def main(
+    batch: int = 8,
+    heads: int = 32,
+    seq_len: int = 4096,
+    dim: int = 128,
+    is_causal: bool = False,
+    cluster_size: int = 2,
+):
+    flops_per_matmul = 2.0 * batch * heads * seq_len * seq_len * dim
+    total_flops = 2 * flops_per_matmul
+    if is_causal:
+        total_flops *= 0.5
+
+    kernel = flashattn(batch, heads, seq_len, dim, is_causal, cluster_size=cluster_size)
+    assert "tl::tma_load_multicast" in kernel.get_kernel_source()
+    ref_program_processed = partial(ref_program, is_causal=is_causal)
+    profiler = kernel.get_profiler()
+    profiler.assert_allclose(ref_program_processed, rtol=0.01, atol=0.01)
+    print("All checks pass.")
+    latency = profiler.do_bench(ref_program_processed, warmup=500)
+    print("Ref: {:.2f} ms".format(latency))
+    print("Ref: {:.2f} TFlops".format(total_flops / latency * 1e-9))
+    latency = profiler.do_bench(warmup=500)
+    print("Tile-lang: {:.2f} ms".format(latency))
+    print("Tile-lang: {:.2f} TFlops".format(total_flops / latency * 1e-9))
+
+
+def run_regression_perf(batch: int = 8, heads: int = 32, seq_len: int = 4096, dim: int = 128, is_causal: bool = False):
+    kernel = flashattn(batch, heads, seq_len, dim, is_causal)
+    profiler = kernel.get_profiler()
+    return profiler.do_bench(backend="cupti")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--batch", type=int, default=8, help="batch size")
+    parser.add_argument("--heads", type=int, default=32, help="heads")
+    parser.add_argument("--seq_len", type=int, default=4096, help="sequence length")
+    parser.add_argument("--dim", type=int, default=128, help="dim")
+    parser.add_argument("--is_causal", action="store_true", help="causal")
+    parser.add_argument("--cluster_size", type=int, default=2, help="CTAs sharing every K/V tile")
+    args = parser.parse_args()
+    main(args.batch, args.heads, args.seq_len, args.dim, args.is_causal, args.cluster_size)
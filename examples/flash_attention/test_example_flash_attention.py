@@ -9,11 +9,13 @@ import example_gqa_fwd_bshd
 import example_mha_fwd_bshd
 import example_gqa_fwd_bshd_wgmma_pipelined
 import example_mha_fwd_bshd_wgmma_pipelined
+import example_mha_fwd_bshd_cluster
 import example_mha_fwd_varlen
 import example_mha_bwd_bshd_wgmma_pipelined
 import example_mha_fwd_bhsd
 import example_gqa_bwd_tma_reduce_varlen
 import example_gqa_fwd_varlen
+import example_attention_carver
 
 
 @tilelang.testing.requires_cuda
@@ -93,6 +95,13 @@ def test_example_mha_fwd_bshd():
     example_mha_fwd_bshd.main(batch=1, seq_len=256)
 
 
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_example_mha_fwd_bshd_cluster():
+    example_mha_fwd_bshd_cluster.main(batch=1, heads=16, seq_len=512)
+    example_mha_fwd_bshd_cluster.main(batch=1, heads=16, seq_len=512, is_causal=True)
+
+
 @tilelang.testing.requires_cuda
 def test_example_mha_fwd_varlen():
     example_mha_fwd_varlen.main(batch=4, heads=16, seq_len=512, dim=64, causal=False)
@@ -105,5 +114,10 @@ def test_example_gqa_fwd_varlen():
     example_gqa_fwd_varlen.main(batch=4, heads=16, q_seqlen=512, k_seqlen=512, dim=64, is_causal=True)
 
 
+@tilelang.testing.requires_cuda
+def test_example_attention_carver():
+    example_attention_carver.main(batch=1, heads=16, kv_heads=4, dim=64)
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
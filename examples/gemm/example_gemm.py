@@ -1,5 +1,6 @@
 import tilelang
 import tilelang.language as T
+import tilelang.testing
 
 
 @tilelang.jit(out_idx=[-1])
@@ -57,10 +58,11 @@ def main():
     print(f"tilelang Latency: {latency}ms")
 
 
-def run_regression_perf():
-    kernel = matmul(1024, 1024, 1024, 128, 128, 32)
+def run_regression_perf(M=1024, N=1024, K=1024):
+    kernel = matmul(M, N, K, 128, 128, 32)
     profiler = kernel.get_profiler()
-    return profiler.do_bench(backend="cupti")
+    latency = profiler.do_bench(backend="cupti")
+    return tilelang.testing.PerfMeasurement(latency, flops=2 * M * N * K, bytes=2 * (M * K + K * N + M * N))
 
 
 if __name__ == "__main__":
@@ -1,6 +1,7 @@
 import torch
 import tilelang
 import tilelang.language as T
+import tilelang.testing
 
 
 def matmul(
@@ -34,7 +35,6 @@ def matmul(
             B_shared = T.alloc_shared(B_shared_shape, in_dtype)
             C_tmem = T.alloc_tmem([block_M, block_N], accum_dtype)
             mbar = T.alloc_barrier(1)
-            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
             C_shared = T.alloc_shared((block_M, block_N), out_dtype)
 
             for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
@@ -43,41 +43,51 @@ def matmul(
                 T.gemm(A_shared, B_shared, C_tmem, trans_A, trans_B, mbar=mbar, wg_wait=-1, clear_accum=k == 0)
                 T.mbarrier_wait_parity(mbar, k % 2)
 
-            T.copy(C_tmem, C_local)
-            T.copy(C_local, C_shared)
+            # Drained in chunks, the tcgen05.ld of a chunk overlapping the stores of the previous one
+            T.copy(C_tmem, C_shared)
 
             T.copy(C_shared, C[by * block_M, bx * block_N])
 
     return main
 
 
-M, N, K = 4096, 4096, 8192
-block_M, block_N, block_K = 128, 128, 128
-trans_A, trans_B = False, True
-in_dtype, out_dtype, accum_dtype = T.bfloat16, T.bfloat16, T.float
-num_stages = 0 if block_N >= 256 or block_M >= 256 or block_K >= 256 else 2
-threads = 256
-
-func = matmul(M, N, K, block_M, block_N, block_K, trans_A, trans_B, in_dtype, out_dtype, accum_dtype, num_stages, threads)
-jit_kernel = tilelang.compile(
-    func,
-    out_idx=[2],
-    target="cuda",
-    pass_configs={
-        tilelang.PassConfigKey.TL_DISABLE_TMA_LOWER: True,
-        tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True,
-    },
-)
-
-print(jit_kernel.get_kernel_source())
-
-a = torch.randn(M, K, device="cuda", dtype=torch.bfloat16)
-b = torch.randn(N, K, device="cuda", dtype=torch.bfloat16)
-c = jit_kernel(a, b)
-ref_c = (a.to(torch.float) @ b.T.to(torch.float)).to(torch.bfloat16)
-torch.testing.assert_close(c, ref_c, rtol=1e-2, atol=1e-2)
-
-profiler = jit_kernel.get_profiler()
-latency = profiler.do_bench()
-print(f"Latency: {latency} ms")
-print(f"Flops: {2 * M * N * K / (latency / 1e3) / 1e12} TFLOPS")
+def compile_matmul(M, N, K, block_M=128, block_N=128, block_K=128, in_dtype=T.bfloat16, out_dtype=T.bfloat16, accum_dtype=T.float, threads=256):
+    trans_A, trans_B = False, True
+    num_stages = 0 if block_N >= 256 or block_M >= 256 or block_K >= 256 else 2
+    func = matmul(M, N, K, block_M, block_N, block_K, trans_A, trans_B, in_dtype, out_dtype, accum_dtype, num_stages, threads)
+    return tilelang.compile(
+        func,
+        out_idx=[2],
+        target="cuda",
+        pass_configs={
+            tilelang.PassConfigKey.TL_DISABLE_TMA_LOWER: True,
+            tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True,
+        },
+    )
+
+
+def main(M=4096, N=4096, K=8192):
+    jit_kernel = compile_matmul(M, N, K)
+    print(jit_kernel.get_kernel_source())
+
+    a = torch.randn(M, K, device="cuda", dtype=torch.bfloat16)
+    b = torch.randn(N, K, device="cuda", dtype=torch.bfloat16)
+    c = jit_kernel(a, b)
+    ref_c = (a.to(torch.float) @ b.T.to(torch.float)).to(torch.bfloat16)
+    torch.testing.assert_close(c, ref_c, rtol=1e-2, atol=1e-2)
+
+    profiler = jit_kernel.get_profiler()
+    latency = profiler.do_bench()
+    print(f"Latency: {latency} ms")
+    print(f"Flops: {2 * M * N * K / (latency / 1e3) / 1e12} TFLOPS")
+
+
+def run_regression_perf(M=4096, N=4096, K=8192):
+    jit_kernel = compile_matmul(M, N, K)
+    profiler = jit_kernel.get_profiler()
+    latency = profiler.do_bench(backend="cupti")
+    return tilelang.testing.PerfMeasurement(latency, flops=2 * M * N * K, bytes=2 * (M * K + N * K + M * N))
+
+
+if __name__ == "__main__":
+    main()
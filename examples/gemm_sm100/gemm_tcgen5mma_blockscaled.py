@@ -0,0 +1,108 @@
+import torch
+import tilelang
+import tilelang.language as T
+
+
+def matmul_mxfp8(
+    M,
+    N,
+    K,
+    block_M,
+    block_N,
+    block_K,
+    out_dtype,
+    num_stages,
+    threads,
+    sf_vec_size=32,
+):
+    # C = (SFA * A) @ (SFB * B)^T, every 32 elements of K of a row of A and B
+    # sharing a UE8M0 scale factor, stored as its raw exponent byte.
+    in_dtype, accum_dtype = T.float8_e4m3fn, T.float
+    num_sf = block_K // sf_vec_size
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), in_dtype),
+        B: T.Tensor((N, K), in_dtype),
+        SFA: T.Tensor((M, K // sf_vec_size), T.uint8),
+        SFB: T.Tensor((N, K // sf_vec_size), T.uint8),
+        C: T.Tensor((M, N), out_dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), in_dtype)
+            B_shared = T.alloc_shared((block_N, block_K), in_dtype)
+            SFA_shared = T.alloc_shared((block_M, num_sf), T.uint8)
+            SFB_shared = T.alloc_shared((block_N, num_sf), T.uint8)
+            C_tmem = T.alloc_tmem([block_M, block_N], accum_dtype)
+            # one column per scale factor of a row of each 128-row chunk
+            SFA_tmem = T.alloc_tmem([128, block_M // 128 * num_sf], T.uint32)
+            SFB_tmem = T.alloc_tmem([128, block_N // 128 * num_sf], T.uint32)
+            mbar = T.alloc_barrier(1)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            C_shared = T.alloc_shared((block_M, block_N), out_dtype)
+
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[bx * block_N, k * block_K], B_shared)
+                T.copy(SFA[by * block_M, k * num_sf], SFA_shared)
+                T.copy(SFB[bx * block_N, k * num_sf], SFB_shared)
+                T.gemm_blockscaled(
+                    A_shared,
+                    B_shared,
+                    C_tmem,
+                    SFA_shared,
+                    SFB_shared,
+                    SFA_tmem,
+                    SFB_tmem,
+                    mbar=mbar,
+                    clear_accum=k == 0,
+                    sf_vec_size=sf_vec_size,
+                )
+                T.mbarrier_wait_parity(mbar, k % 2)
+
+            T.copy(C_tmem, C_local)
+            T.copy(C_local, C_shared)
+
+            T.copy(C_shared, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def ref_program(a, b, sfa, sfb, sf_vec_size=32):
+    scale_a = torch.exp2(sfa.to(torch.float) - 127).repeat_interleave(sf_vec_size, dim=1)
+    scale_b = torch.exp2(sfb.to(torch.float) - 127).repeat_interleave(sf_vec_size, dim=1)
+    return (a.to(torch.float) * scale_a) @ (b.to(torch.float) * scale_b).T
+
+
+M, N, K = 4096, 4096, 8192
+block_M, block_N, block_K = 128, 256, 128
+out_dtype = T.bfloat16
+num_stages = 2
+threads = 256
+
+func = matmul_mxfp8(M, N, K, block_M, block_N, block_K, out_dtype, num_stages, threads)
+jit_kernel = tilelang.compile(
+    func,
+    out_idx=[4],
+    target="cuda",
+    pass_configs={
+        tilelang.PassConfigKey.TL_DISABLE_TMA_LOWER: True,
+        tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True,
+    },
+)
+
+print(jit_kernel.get_kernel_source())
+
+a = torch.randn(M, K, device="cuda").to(torch.float8_e4m3fn)
+b = torch.randn(N, K, device="cuda").to(torch.float8_e4m3fn)
+# UE8M0 exponents of 2^-4 .. 2^3
+sfa = torch.randint(123, 131, (M, K // 32), device="cuda", dtype=torch.uint8)
+sfb = torch.randint(123, 131, (N, K // 32), device="cuda", dtype=torch.uint8)
+c = jit_kernel(a, b, sfa, sfb)
+ref_c = ref_program(a, b, sfa, sfb).to(torch.bfloat16)
+torch.testing.assert_close(c, ref_c, rtol=1e-2, atol=1e-2)
+
+profiler = jit_kernel.get_profiler()
+latency = profiler.do_bench()
+print(f"Latency: {latency} ms")
+print(f"Flops: {2 * M * N * K / (latency / 1e3) / 1e12} TFLOPS")
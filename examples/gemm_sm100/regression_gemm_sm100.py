@@ -0,0 +1,14 @@
+import torch
+import tilelang.testing
+import gemm_tcgen5mma
+
+
+def regression_gemm_tcgen5mma():
+    # tcgen05 MMA only exists on sm_100 class GPUs.
+    if torch.cuda.get_device_capability()[0] != 10:
+        return
+    tilelang.testing.process_func(gemm_tcgen5mma.run_regression_perf)
+
+
+if __name__ == "__main__":
+    tilelang.testing.regression()
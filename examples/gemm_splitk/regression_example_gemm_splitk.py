@@ -1,5 +1,6 @@
 import tilelang.testing
 import example_tilelang_gemm_splitk
+import example_tilelang_gemm_splitk_deterministic
 import example_tilelang_gemm_splitk_vectorize_atomicadd
 
 
@@ -7,6 +8,10 @@ def regression_example_tilelang_gemm_splitk():
     tilelang.testing.process_func(example_tilelang_gemm_splitk.run_regression_perf)
 
 
+def regression_example_tilelang_gemm_splitk_deterministic():
+    tilelang.testing.process_func(example_tilelang_gemm_splitk_deterministic.run_regression_perf)
+
+
 def regression_example_tilelang_gemm_splitk_vectorize_atomicadd():
     tilelang.testing.process_func(example_tilelang_gemm_splitk_vectorize_atomicadd.run_regression_perf)
 
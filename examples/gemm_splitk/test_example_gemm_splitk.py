@@ -1,6 +1,7 @@
 import tilelang.testing
 
 import example_tilelang_gemm_splitk
+import example_tilelang_gemm_splitk_deterministic
 import example_tilelang_gemm_splitk_vectorize_atomicadd
 
 
@@ -8,6 +9,10 @@ def test_example_tilelang_gemm_splitk():
     example_tilelang_gemm_splitk.main()
 
 
+def test_example_tilelang_gemm_splitk_deterministic():
+    example_tilelang_gemm_splitk_deterministic.main()
+
+
 def test_example_tilelang_gemm_splitk_vectorize_atomicadd():
     example_tilelang_gemm_splitk_vectorize_atomicadd.main()
 
@@ -256,6 +256,39 @@ def gemv_alloc_reducer(
     return main
 
 
+@tl.jit(out_idx=[-1])
+def tile_gemm_gemv(
+    N: int,
+    K: int,
+    BLOCK_N: int = 128,
+    BLOCK_K: int = 128,
+    threads: int = 128,
+    dtype: T.dtype = T.float16,
+    accum_dtype: T.dtype = T.float,
+):
+    # T.gemm on a single row of A takes the split-K SIMT path of the skinny gemms
+    @T.prim_func
+    def main(
+        A: T.Tensor((K,), dtype),
+        B: T.Tensor((N, K), dtype),
+        C: T.Tensor((N,), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, BLOCK_N), threads=threads) as bn:
+            A_shared = T.alloc_shared((1, BLOCK_K), dtype)
+            B_shared = T.alloc_shared((BLOCK_N, BLOCK_K), dtype)
+            C_local = T.alloc_fragment((1, BLOCK_N), accum_dtype)
+            T.clear(C_local)
+            for bk in T.Pipelined(T.ceildiv(K, BLOCK_K), num_stages=2):
+                for tk in T.Parallel(BLOCK_K):
+                    A_shared[0, tk] = A[bk * BLOCK_K + tk]
+                T.copy(B[bn * BLOCK_N, bk * BLOCK_K], B_shared)
+                T.gemm(A_shared, B_shared, C_local, transpose_B=True)
+            for tn in T.Parallel(BLOCK_N):
+                C[bn * BLOCK_N + tn] = C_local[0, tn]
+
+    return main
+
+
 def get_thread_template_configs():
     iter_params = dict(BLOCK_N=[2, 4, 8, 32, 64, 128], reduce_threads=[4, 8, 32])
     return [dict(zip(iter_params, values)) for values in itertools.product(*iter_params.values())]
@@ -346,6 +379,7 @@ def main(do_bench: bool = True):
     check_correctness_and_bench(splitk_gemv_vectorized(N, K, 2, 32), N, K, do_bench=do_bench)
     check_correctness_and_bench(splitk_gemv_vectorized_tvm(N, K, 2, 32), N, K, do_bench=do_bench)
     check_correctness_and_bench(gemv_alloc_reducer(N, K, block_M=128, block_N=128), N, K, do_bench=do_bench)
+    check_correctness_and_bench(tile_gemm_gemv(N, K), N, K, do_bench=do_bench)
 
     print("Test passed!")
 
@@ -0,0 +1,10 @@
+import tilelang.testing
+import rms_norm
+
+
+def regression_rms_norm():
+    tilelang.testing.process_func(rms_norm.run_regression_perf)
+
+
+if __name__ == "__main__":
+    tilelang.testing.regression()
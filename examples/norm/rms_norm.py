@@ -1,5 +1,6 @@
 import torch
 import tilelang
+import tilelang.testing
 import tilelang.language as T
 
 
@@ -63,6 +64,14 @@ def ref_program(x):
     return x * torch.rsqrt(x.pow(2).mean(-1, keepdim=True) + 1e-12)
 
 
+def run_regression_perf(M=8192, N=8192, blk_m=1):
+    kernel = rms_norm(M, N, blk_m)
+    profiler = kernel.get_profiler()
+    latency = profiler.do_bench(backend="cupti")
+    # Reads A and writes B once, in float32.
+    return tilelang.testing.PerfMeasurement(latency, flops=3 * M * N, bytes=2 * 4 * M * N)
+
+
 if __name__ == "__main__":
     M, N, blk_m, blk_k = 8192, 8192, 1, 512
     kernel = rms_norm(M, N, blk_m)
@@ -57,6 +57,30 @@ def tl_topk(
     return topk_kernel
 
 
+
+@tilelang.jit(out_idx=[1, 2])
+def tl_topk_fused(M, N, topk, blk_m, threads=128):
+    """Same selection in one pass with the fused T.topk operator."""
+    dtype = T.float32
+
+    @T.prim_func
+    def topk_kernel(
+        logits: T.Tensor([M, N], dtype),
+        topk_gates: T.Tensor([M, topk], dtype),
+        topk_indices: T.Tensor([M, topk], T.int32),
+    ):
+        with T.Kernel(T.ceildiv(M, blk_m), threads=threads) as bx:
+            logits_frag = T.alloc_fragment([blk_m, N], dtype=dtype)
+            T.copy(logits[bx * blk_m, 0], logits_frag)
+            T.topk(
+                logits_frag,
+                topk_gates[bx * blk_m : (bx + 1) * blk_m, :],
+                topk_indices[bx * blk_m : (bx + 1) * blk_m, :],
+                k=topk,
+            )
+
+    return topk_kernel
+
 def ref_program(logits, top_k):
     top_k_gates, top_k_indices = logits.topk(top_k, dim=1)
 
@@ -83,10 +107,17 @@ def main(argv=None):
     torch.testing.assert_close(tl_gates, torch_gates)
     torch.testing.assert_close(tl_indices, torch_indices)
 
+    fused_kernel = tl_topk_fused(M=M, N=N, topk=topk, blk_m=blk_m)
+    fused_gates, fused_indices = fused_kernel(logits)
+    torch.testing.assert_close(fused_gates, torch_gates)
+    torch.testing.assert_close(fused_indices, torch_indices)
+
     # profile
     profiler = kernel.get_profiler(tensor_supply_type=tilelang.TensorSupplyType.Auto)
     tilelang_latency = profiler.do_bench()
     print(f"Tilelang latency: {tilelang_latency}")
+    profiler = fused_kernel.get_profiler(tensor_supply_type=tilelang.TensorSupplyType.Auto)
+    print(f"Tilelang fused T.topk latency: {profiler.do_bench()}")
 
 
 def run_regression_perf(argv=None):
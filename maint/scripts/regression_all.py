@@ -1,10 +1,12 @@
 from __future__ import annotations
 
+import argparse
+import datetime
 import json
 import os
 import subprocess
 import sys
-from dataclasses import dataclass
+from dataclasses import asdict, dataclass
 from pathlib import Path
 
 try:
@@ -17,24 +19,39 @@ except Exception:  # pragma: no cover
 class PerfResult:
     name: str
     latency: float
+    # Work of one launch, reported by drivers returning a PerfMeasurement.
+    flops: float | None = None
+    bytes: float | None = None
+    tflops: float | None = None
+    gbps: float | None = None
+    # Achieved throughput over the roofline of the GPU at the kernel's
+    # arithmetic intensity, in percent.
+    pct_of_roofline: float | None = None
 
 
 _RESULTS: list[PerfResult] = []
 
 _RESULTS_JSON_PREFIX = "__TILELANG_PERF_RESULTS_JSON__="
 
+# Relative latency increase over the baseline reported as a regression.
+_DEFAULT_THRESHOLD = 0.05
 
-def _parse_table(output: str) -> dict[str, float]:
+
+def _parse_table(output: str) -> dict[str, PerfResult]:
     # Prefer a single JSON marker line if present.
     for line in reversed(output.splitlines()):
         if line.startswith(_RESULTS_JSON_PREFIX):
             payload = line[len(_RESULTS_JSON_PREFIX) :].strip()
             items = json.loads(payload)
-            data: dict[str, float] = {}
+            data: dict[str, PerfResult] = {}
             for item in items:
                 name = str(item["name"]).strip()
-                latency = float(item["latency"])
-                data[name] = latency
+                data[name] = PerfResult(
+                    name=name,
+                    latency=float(item["latency"]),
+                    flops=item.get("flops"),
+                    bytes=item.get("bytes"),
+                )
             return data
 
     # Backward-compatible text parsing (best-effort).
@@ -49,16 +66,25 @@ def _parse_table(output: str) -> dict[str, float]:
         if not name:
             continue
         try:
-            data[name] = float(val)
+            data[name] = PerfResult(name=name, latency=float(val))
         except ValueError:
             # Ignore unrelated prints/logs.
             continue
     return data
 
 
+def _repo_root() -> Path:
+    # repo_root/maint/scripts/regression_all.py -> repo_root
+    return Path(__file__).resolve().parents[2]
+
+
 def _examples_root() -> Path:
-    # repo_root/tilelang/testing/perf_regression.py -> repo_root
-    return Path(__file__).resolve().parents[2] / "examples"
+    return _repo_root() / "examples"
+
+
+def _benchmark_root() -> Path:
+    # Drivers measuring the runtime itself, such as the launch overhead
+    return _repo_root() / "benchmark"
 
 
 def _discover_bench_files(examples_root: Path) -> list[Path]:
@@ -70,22 +96,150 @@ def _discover_bench_files(examples_root: Path) -> list[Path]:
     return sorted({p for p in files if p.is_file() and p.name != "__init__.py"})
 
 
-def regression_all(examples_root: str | os.PathLike[str] | None = None) -> None:
+def _device_info() -> dict[str, str | None]:
+    """Name and `sm_XX` arch of the current GPU; None when there is none."""
+    try:
+        import torch
+
+        if not torch.cuda.is_available():
+            return {"gpu": None, "arch": None}
+        major, minor = torch.cuda.get_device_capability()
+        return {"gpu": torch.cuda.get_device_name(), "arch": f"sm_{major}{minor}"}
+    except Exception:
+        return {"gpu": None, "arch": None}
+
+
+def _git_commit() -> str | None:
+    try:
+        return subprocess.check_output(
+            ["git", "rev-parse", "HEAD"], cwd=str(Path(__file__).resolve().parent), stderr=subprocess.DEVNULL, text=True
+        ).strip()
+    except Exception:
+        return None
+
+
+def _peak_numbers() -> tuple[float | None, float | None]:
+    """Peak float16 tensor FLOP/s and DRAM bytes/s of the current GPU."""
+    try:
+        from tilelang.carver.arch import auto_infer_current_arch
+
+        arch = auto_infer_current_arch()
+        return arch.peak_tensor_flops("float16"), arch.peak_memory_bandwidth()
+    except Exception:
+        return None, None
+
+
+def _with_throughput(result: PerfResult, peak_flops: float | None, peak_bandwidth: float | None) -> PerfResult:
+    """Derives TFLOPS, GB/s and the percentage of the roofline from the work of a launch."""
+    seconds = result.latency * 1e-3
+    tflops = result.flops / seconds * 1e-12 if result.flops else None
+    gbps = result.bytes / seconds * 1e-9 if result.bytes else None
+
+    pct = None
+    if result.flops and peak_flops:
+        roof = peak_flops
+        if result.bytes and peak_bandwidth:
+            roof = min(peak_flops, result.flops / result.bytes * peak_bandwidth)
+        pct = 100.0 * result.flops / seconds / roof
+    elif result.bytes and peak_bandwidth:
+        pct = 100.0 * result.bytes / seconds / peak_bandwidth
+    return PerfResult(
+        name=result.name,
+        latency=result.latency,
+        flops=result.flops,
+        bytes=result.bytes,
+        tflops=tflops,
+        gbps=gbps,
+        pct_of_roofline=pct,
+    )
+
+
+def _compare_to_baseline(
+    results: dict[str, PerfResult], baseline: dict[str, float], threshold: float
+) -> list[tuple[str, float, float, float]]:
+    """(name, baseline, current, ratio) of every result slower than the baseline by more than `threshold`."""
+    regressions = []
+    for name in sorted(results):
+        old = baseline.get(name)
+        if not old:
+            continue
+        ratio = results[name].latency / old
+        if ratio > 1.0 + threshold:
+            regressions.append((name, old, results[name].latency, ratio))
+    return regressions
+
+
+def _load_baseline(path: Path, arch: str | None) -> dict[str, float]:
+    """Latencies recorded for `arch` in a baseline file; baselines are kept per GPU arch."""
+    if not path.exists():
+        return {}
+    with open(path) as f:
+        entry = json.load(f).get(str(arch))
+    return {} if entry is None else {k: float(v) for k, v in entry["results"].items()}
+
+
+def _update_baseline(path: Path, arch: str | None, commit: str | None, results: dict[str, PerfResult]) -> None:
+    data = {}
+    if path.exists():
+        with open(path) as f:
+            data = json.load(f)
+    data[str(arch)] = {"commit": commit, "results": {k: v.latency for k, v in sorted(results.items())}}
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(data, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+
+def _fmt(value: float | None) -> str:
+    return "-" if value is None else f"{value:.4g}"
+
+
+def regression_all(
+    examples_root: str | os.PathLike[str] | None = None,
+    *,
+    output: str | os.PathLike[str] | None = None,
+    baseline: str | os.PathLike[str] | None = None,
+    update_baseline: bool = False,
+    threshold: float = _DEFAULT_THRESHOLD,
+    filter: str | None = None,
+) -> list[tuple[str, float, float, float]]:
     """Run all example benchmark drivers and print a consolidated table.
 
-    Intended usage (CI): `python -c "import tilelang.testing.perf_regression as pr; pr.regression_all()"`
+    Intended usage (CI): `python maint/scripts/regression_all.py --baseline baseline.json`
+
+    Args:
+        examples_root: Directory searched for `regression_*.py` drivers,
+            `examples/` and `benchmark/` of the repository by default.
+        output: Writes the results, with the commit, GPU and arch, as JSON.
+        baseline: Baseline file holding the latencies of a reference commit
+            per GPU arch; results slower than it by more than `threshold`
+            are reported as regressions.
+        update_baseline: Records the results as the baseline of this arch.
+        threshold: Relative latency increase counted as a regression.
+        filter: Only runs the drivers whose path contains this substring.
+
+    Returns:
+        The regressions as (name, baseline latency, latency, ratio).
     """
 
-    root = Path(examples_root) if examples_root is not None else _examples_root()
-    if not root.exists():
-        raise FileNotFoundError(f"Examples root not found: {root}")
-
-    bench_files = _discover_bench_files(root)
+    if examples_root is not None:
+        root = Path(examples_root)
+        search_roots = [root]
+    else:
+        root = _repo_root()
+        search_roots = [_examples_root(), _benchmark_root()]
+    if not search_roots[0].exists():
+        raise FileNotFoundError(f"Examples root not found: {search_roots[0]}")
+
+    bench_files = sorted(p for r in search_roots if r.exists() for p in _discover_bench_files(r))
+    if filter:
+        bench_files = [p for p in bench_files if filter in str(p.relative_to(root))]
     if not bench_files:
         raise RuntimeError(f"No drivers found under: {root}")
 
-    merged: dict[str, float] = {}
+    merged: dict[str, PerfResult] = {}
     failures: list[str] = []
+    peak_flops, peak_bandwidth = _peak_numbers()
 
     total = len(bench_files)
     print(f"\n{'═' * 60}")
@@ -133,8 +287,8 @@ def regression_all(examples_root: str | os.PathLike[str] | None = None) -> None:
         num_tests = len(parsed)
         for k, v in parsed.items():
             if k not in merged:
-                merged[k] = v
-                _RESULTS.append(PerfResult(name=k, latency=v))
+                merged[k] = _with_throughput(v, peak_flops, peak_bandwidth)
+                _RESULTS.append(merged[k])
 
         print(f"  └─ ✅ Completed ({num_tests} tests)")
 
@@ -162,24 +316,79 @@ def regression_all(examples_root: str | os.PathLike[str] | None = None) -> None:
                 print(f"  {line}")
         print()
 
+    device = _device_info()
+    commit = _git_commit()
+    regressions: list[tuple[str, float, float, float]] = []
+    if baseline is not None:
+        regressions = _compare_to_baseline(merged, _load_baseline(Path(baseline), device["arch"]), threshold)
+        if update_baseline:
+            _update_baseline(Path(baseline), device["arch"], commit, merged)
+
+    if output is not None:
+        with open(output, "w") as f:
+            json.dump(
+                {
+                    "commit": commit,
+                    **device,
+                    "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+                    "results": [asdict(merged[k]) for k in sorted(merged)],
+                    "regressions": [{"name": n, "baseline": b, "latency": c, "ratio": r} for n, b, c, r in regressions],
+                },
+                f,
+                indent=2,
+            )
+            f.write("\n")
+
     fmt = os.environ.get("TL_PERF_REGRESSION_FORMAT", "text").strip().lower()
     if fmt == "json":
-        print(_RESULTS_JSON_PREFIX + json.dumps(merged, separators=(",", ":")))
-        return
+        print(_RESULTS_JSON_PREFIX + json.dumps({k: v.latency for k, v in merged.items()}, separators=(",", ":")))
+        return regressions
 
     print(f"{'─' * 60}")
     print("  Results")
     print(f"{'─' * 60}")
-    rows = [[k, merged[k]] for k in sorted(merged.keys())]
-    headers = ["Name", "Latency (ms)"]
+    rows = [[k, v.latency, _fmt(v.tflops), _fmt(v.gbps), _fmt(v.pct_of_roofline)] for k, v in sorted(merged.items())]
+    headers = ["Name", "Latency (ms)", "TFLOPS", "GB/s", "% of roofline"]
+    _print_table(rows, headers)
+
+    if regressions:
+        print(f"\n{'─' * 60}")
+        print(f"  Regressions over {threshold:.0%} on {device['arch']}")
+        print(f"{'─' * 60}")
+        rows = [[n, b, c, f"{r:.3f}x"] for n, b, c, r in regressions]
+        _print_table(rows, ["Name", "Baseline (ms)", "Latency (ms)", "Slowdown"])
+    return regressions
+
+
+def _print_table(rows: list[list], headers: list[str]) -> None:
     if tabulate is None:
-        print(f"| {headers[0]} | {headers[1]} |")
-        print("|---|---|")
-        for name, latency in rows:
-            print(f"| {name} | {latency} |")
+        print("| " + " | ".join(headers) + " |")
+        print("|" + "---|" * len(headers))
+        for row in rows:
+            print("| " + " | ".join(str(v) for v in row) + " |")
     else:
         print(tabulate(rows, headers=headers, tablefmt="github", stralign="left", numalign="decimal"))
 
 
+def _parse_args(argv: list[str] | None = None) -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Run the regression_*.py drivers of the examples tree.")
+    parser.add_argument("--examples-root", default=None, help="directory searched for the drivers, examples/ and benchmark/ by default")
+    parser.add_argument("--output", default=None, help="write the results as JSON to this file")
+    parser.add_argument("--baseline", default=None, help="baseline JSON, keyed by GPU arch, to compare against")
+    parser.add_argument("--update-baseline", action="store_true", help="record the results as the baseline of this arch")
+    parser.add_argument("--threshold", type=float, default=_DEFAULT_THRESHOLD, help="relative slowdown counted as a regression")
+    parser.add_argument("--filter", default=None, help="only run the drivers whose path contains this substring")
+    return parser.parse_args(argv)
+
+
 if __name__ == "__main__":
-    regression_all()
+    args = _parse_args()
+    found = regression_all(
+        args.examples_root,
+        output=args.output,
+        baseline=args.baseline,
+        update_baseline=args.update_baseline,
+        threshold=args.threshold,
+        filter=args.filter,
+    )
+    sys.exit(1 if found and not args.update_baseline else 0)
@@ -37,23 +37,26 @@ static Var CreateEnvThread(String name, String thread_tag, DataType dtype) {
   return var;
 }
 
-static ForFrame MakeIterVarFrame(const std::string &name, const PrimExpr &dom) {
+static ForFrame MakeIterVarFrame(
+    const std::string &name, const PrimExpr &dom,
+    const Map<String, tvm::ffi::Any> &annotations = {}) {
   using namespace tvm::tir;
   Var var = Var(name, dom->dtype);
   // Create a frame that represents a loop over the given domain.
   ObjectPtr<ForFrameNode> n = tvm::ffi::make_object<ForFrameNode>();
   n->vars.push_back(var);
   n->doms.push_back(Range(0, dom));
-  n->f_make_for_loop = [](const Array<Var> &vars, const Array<Range> &doms,
-                          const Array<Optional<PrimExpr>> &steps,
-                          Stmt body) -> Stmt {
+  n->f_make_for_loop = [annotations](const Array<Var> &vars,
+                                     const Array<Range> &doms,
+                                     const Array<Optional<PrimExpr>> &steps,
+                                     Stmt body) -> Stmt {
     ICHECK_EQ(vars.size(), 1);
     ICHECK_EQ(doms.size(), 1);
     Optional<PrimExpr> step =
         !steps.empty() ? steps[0] : Optional<PrimExpr>(std::nullopt);
     return For(vars[0], doms[0]->min, doms[0]->extent, ForKind::kSerial, body,
                /*thread_binding=*/std::nullopt,
-               /*annotations=*/tvm::ffi::Map<tvm::ffi::String, tvm::ffi::Any>{},
+               /*annotations=*/annotations,
                /*step=*/step);
   };
   return ForFrame(n);
@@ -118,8 +121,10 @@ ForFrame PipelinedFor(PrimExpr start, const PrimExpr &stop, int num_stages,
     int n = vars.size();
     ICHECK(n == 1);
     Map<String, tvm::ffi::Any> anno;
-    if (num_stages > 0)
-      anno.Set("num_stages", PrimExpr(num_stages));
+    // A negative depth requests automatic selection, see
+    // tl.transform.PipelineStageSelection.
+    if (num_stages != 0)
+      anno.Set("num_stages", PrimExpr(num_stages > 0 ? num_stages : -1));
     if (!order.empty())
       anno.Set("tl_pipeline_order", order);
     if (!stages.empty())
@@ -173,6 +178,7 @@ ForFrame PersistentFor(const Array<PrimExpr> &domain, const PrimExpr &wave_size,
                            Stmt body) -> Stmt {
     ICHECK_EQ(vars.size(), doms.size());
     Map<String, tvm::ffi::Any> anno;
+    anno.Set(tl::attr::kPersistentLoop, Integer(1));
     Array<PrimExpr> idxs(grouped_domain.size(), PrimExpr());
     PrimExpr rem = loop_var * wave_size + index;
 
@@ -209,6 +215,169 @@ ForFrame PersistentFor(const Array<PrimExpr> &domain, const PrimExpr &wave_size,
   return ForFrame(n);
 }
 
+/*!
+ * \brief Stream-K decomposition of a tiled reduction over persistent programs.
+ *
+ * The flattened iteration space of `num_tiles * iters_per_tile` MAC
+ * iterations is split evenly across `num_programs` programs; program `pid`
+ * visits every tile its contiguous range touches and binds (tile_id, k_begin,
+ * k_end), the range of K iterations of that tile it owns.
+ */
+ForFrame StreamKFor(const PrimExpr &num_tiles, const PrimExpr &iters_per_tile,
+                    const PrimExpr &num_programs, const PrimExpr &pid) {
+  using namespace tvm::tir;
+  ObjectPtr<ForFrameNode> n = tvm::ffi::make_object<ForFrameNode>();
+  DataType dtype = num_tiles.dtype();
+  Var tile_id("tile_id", dtype);
+  Var k_begin("k_begin", dtype);
+  Var k_end("k_end", dtype);
+  for (const Var &var : {tile_id, k_begin, k_end}) {
+    n->vars.push_back(var);
+    n->doms.push_back(Range(make_const(dtype, 0), num_tiles * iters_per_tile));
+  }
+
+  PrimExpr total_iters = num_tiles * iters_per_tile;
+  PrimExpr iters_per_program = floordiv(total_iters, num_programs);
+  PrimExpr extra_iters = floormod(total_iters, num_programs);
+  PrimExpr iter_begin = pid * iters_per_program + min(pid, extra_iters);
+  PrimExpr iter_end = iter_begin + iters_per_program +
+                      if_then_else(pid < extra_iters, make_const(dtype, 1),
+                                   make_const(dtype, 0));
+  // A contiguous range of at most iters_per_program + 1 iterations touches at
+  // most this many tiles.
+  PrimExpr max_segments =
+      floordiv(iters_per_program + iters_per_tile - 1, iters_per_tile) + 1;
+
+  n->f_make_for_loop = [=](const Array<Var> &vars, const Array<Range> &doms,
+                           const Array<Optional<PrimExpr>> &steps,
+                           Stmt body) -> Stmt {
+    ICHECK_EQ(vars.size(), 3);
+    Var segment("s", dtype);
+    PrimExpr tile = floordiv(iter_begin, iters_per_tile) + segment;
+    PrimExpr tile_begin = tile * iters_per_tile;
+    PrimExpr tile_end = tile_begin + iters_per_tile;
+    Stmt inner = LetStmt(vars[2], min(iter_end, tile_end) - tile_begin, body);
+    inner = LetStmt(vars[1], max(iter_begin, tile_begin) - tile_begin, inner);
+    auto out_if = IfThenElse(
+        iter_end <= vars[0] * iters_per_tile,
+        Evaluate(Call(DataType::Handle(), tvm::tl::loop_break(), {})), Stmt());
+    inner = LetStmt(vars[0], tile, SeqStmt({out_if, inner}));
+    return For(segment, 0, max_segments, ForKind::kSerial, inner);
+  };
+
+  return ForFrame(n);
+}
+
+/*!
+ * \brief Dynamic persistent tile loop fed by a global atomic work counter.
+ *
+ * Thread `thread_var == 0` of every CTA claims the next tile index with an
+ * atomic add on `counter[0]` and publishes it through the shared `slot`, so a
+ * CTA that finishes early immediately pulls more work instead of waiting for
+ * the next launch wave. The loop exits once the claimed index reaches
+ * `num_tiles`; `counter` has to be zero when the kernel starts.
+ */
+ForFrame TileQueueFor(const PrimExpr &num_tiles, const Buffer &counter,
+                      const Buffer &slot, const PrimExpr &thread_var) {
+  using namespace tvm::tir;
+  ICHECK_EQ(counter->dtype, slot->dtype)
+      << "TileQueue counter and slot must share a dtype";
+  ObjectPtr<ForFrameNode> n = tvm::ffi::make_object<ForFrameNode>();
+  DataType dtype = counter->dtype;
+  n->vars.push_back(Var("tile_id", dtype));
+  n->doms.push_back(Range(make_const(dtype, 0), cast(dtype, num_tiles)));
+
+  n->f_make_for_loop = [=](const Array<Var> &vars, const Array<Range> &doms,
+                           const Array<Optional<PrimExpr>> &steps,
+                           Stmt body) -> Stmt {
+    ICHECK_EQ(vars.size(), 1);
+    PrimExpr zero = make_const(dtype, 0);
+    PrimExpr claim = Call(
+        dtype, tl::atomic_add_ret_elem_op(),
+        {Call(DataType::Handle(), builtin::address_of(),
+              {BufferLoad(counter, {zero})}),
+         make_const(dtype, 1)});
+    Stmt fetch = IfThenElse(thread_var == 0, BufferStore(slot, claim, {zero}));
+    Stmt sync = Evaluate(Call(DataType::Int(32), builtin::tvm_storage_sync(),
+                              {StringImm("shared")}));
+    auto out_if =
+        IfThenElse(cast(dtype, num_tiles) <= vars[0],
+                   Evaluate(Call(DataType::Handle(), tl::loop_break(), {})));
+    // The second barrier keeps thread 0 from overwriting the slot before
+    // every thread has read the claimed index.
+    Stmt inner = LetStmt(vars[0], BufferLoad(slot, {zero}),
+                         SeqStmt({sync, out_if, body}));
+    Var iter("w", dtype);
+    // Every CTA claims at most num_tiles + 1 indices.
+    return For(iter, 0, cast(dtype, num_tiles) + 1, ForKind::kSerial,
+               SeqStmt({fetch, sync, inner}));
+  };
+
+  return ForFrame(n);
+}
+
+/*!
+ * \brief Persistent loop over the tiles of a ragged batch of sequences.
+ *
+ * `cu_tiles[b]` is the number of tiles of the sequences before `b`, so the
+ * batch holds `cu_tiles[batch]` tiles of real tokens. Program `pid` strides
+ * them by `num_programs` and binds (seq_id, tile_id), the sequence and the
+ * tile inside it, found by a binary search of `cu_tiles`. Empty sequences
+ * own no tile.
+ */
+ForFrame VarlenTilesFor(const Buffer &cu_tiles, const PrimExpr &num_programs,
+                        const PrimExpr &pid) {
+  using namespace tvm::tir;
+  ICHECK_EQ(cu_tiles->shape.size(), 1)
+      << "VarlenTiles expects one dimensional tile offsets";
+  ObjectPtr<ForFrameNode> n = tvm::ffi::make_object<ForFrameNode>();
+  DataType dtype = cu_tiles->dtype;
+  PrimExpr batch = cast(dtype, cu_tiles->shape[0]) - 1;
+  PrimExpr total = BufferLoad(cu_tiles, {batch});
+  for (const char *name : {"seq_id", "tile_id"}) {
+    n->vars.push_back(Var(name, dtype));
+    n->doms.push_back(Range(make_const(dtype, 0), total));
+  }
+  // Halving [lo, hi) until one sequence is left takes ceil(log2(batch))
+  // steps, and every step after that keeps lo in place.
+  int search_steps = 31;
+  if (const auto *imm = cu_tiles->shape[0].as<IntImmNode>()) {
+    search_steps = 0;
+    while ((int64_t(1) << search_steps) < imm->value - 1)
+      ++search_steps;
+  }
+
+  n->f_make_for_loop = [=](const Array<Var> &vars, const Array<Range> &doms,
+                           const Array<Optional<PrimExpr>> &steps,
+                           Stmt body) -> Stmt {
+    ICHECK_EQ(vars.size(), 2);
+    Var iter("w", dtype);
+    Var index("idx", dtype);
+    PrimExpr np = cast(dtype, num_programs);
+    std::vector<std::pair<Var, PrimExpr>> bindings;
+    PrimExpr lo = make_const(dtype, 0), hi = batch;
+    for (int i = 0; i < search_steps; ++i) {
+      Var mid("mid", dtype), new_lo("lo", dtype), new_hi("hi", dtype);
+      bindings.emplace_back(mid, floordiv(lo + hi, 2));
+      PrimExpr right = BufferLoad(cu_tiles, {mid}) <= index;
+      bindings.emplace_back(new_lo, Select(right, mid, lo));
+      bindings.emplace_back(new_hi, Select(right, hi, mid));
+      lo = new_lo;
+      hi = new_hi;
+    }
+    Stmt inner = LetStmt(vars[1], index - BufferLoad(cu_tiles, {lo}), body);
+    inner = LetStmt(vars[0], lo, inner);
+    for (auto it = bindings.rbegin(); it != bindings.rend(); ++it)
+      inner = LetStmt(it->first, it->second, inner);
+    inner = LetStmt(index, cast(dtype, pid) + iter * np, inner);
+    // pid < num_programs, so the extent is never negative
+    PrimExpr extent = floordiv(total + np - 1 - cast(dtype, pid), np);
+    return For(iter, 0, extent, ForKind::kSerial, inner);
+  };
+
+  return ForFrame(n);
+}
+
 /*!
  * \brief A frame that represents a kernel launch.
  *
@@ -276,9 +445,11 @@ KernelLaunchFrame KernelLaunch(const Array<PrimExpr> &grid_size,
     ICHECK(block_size.empty()) << "CPU kernel cannot have block size";
     ICHECK(attrs.defined());
     // create grid loop var
+    Map<String, tvm::ffi::Any> grid_annotations;
+    grid_annotations.Set(tilelang_cpu_grid_loop, Integer(1));
     for (int i = 0; i < grid_size.size(); i++) {
-      n->frames.push_back(
-          MakeIterVarFrame("block_var_" + std::to_string(i), grid_size[i]));
+      n->frames.push_back(MakeIterVarFrame("block_var_" + std::to_string(i),
+                                           grid_size[i], grid_annotations));
     }
   } else {
     // Launch GPU Kernel
@@ -332,6 +503,9 @@ TVM_FFI_STATIC_INIT_BLOCK() {
       .def("tl.Parallel", ParallelFor)
       .def("tl.Pipelined", PipelinedFor)
       .def("tl.Persistent", PersistentFor)
+      .def("tl.StreamK", StreamKFor)
+      .def("tl.TileQueue", TileQueueFor)
+      .def("tl.VarlenTiles", VarlenTilesFor)
       .def("tl.KernelLaunch", KernelLaunch);
 }
 
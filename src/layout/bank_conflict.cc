@@ -0,0 +1,299 @@
+/*!
+ * \file layout/bank_conflict.cc
+ * \brief Static estimation of shared memory bank conflicts
+ *
+ */
+
+#include "bank_conflict.h"
+
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace tvm {
+namespace tl {
+
+namespace {
+
+constexpr int kNumBanks = 32;
+constexpr int kWarpSize = 32;
+// Requests evaluated per access: the first warps and thread-local iterations
+// are representative of the regular access patterns of tile programs.
+constexpr int64_t kMaxWarps = 2;
+constexpr int64_t kMaxRequests = 8;
+
+// Evaluate `expr` under `vmap`, the remaining free variables taken as zero.
+bool EvalConst(const PrimExpr &expr, const Map<Var, PrimExpr> &vmap,
+               arith::Analyzer *analyzer, int64_t *value) {
+  PrimExpr e = Substitute(expr, vmap);
+  Map<Var, PrimExpr> zeros;
+  for (const Var &var : UndefinedVars(e)) {
+    zeros.Set(var, make_zero(var->dtype));
+  }
+  if (!zeros.empty()) {
+    e = Substitute(e, zeros);
+  }
+  e = analyzer->Simplify(e);
+  if (const int64_t *p = as_const_int(e)) {
+    *value = *p;
+    return true;
+  }
+  return false;
+}
+
+// Byte offset of the element at `coords` in the storage of `layout`.
+bool PhysicalAddress(const Layout &layout, const std::vector<int64_t> &coords,
+                     int bytes, arith::Analyzer *analyzer, int64_t *addr) {
+  Array<PrimExpr> input;
+  for (int64_t c : coords) {
+    input.push_back(IntImm(DataType::Int(32), c));
+  }
+  Array<PrimExpr> output = layout->Forward(input);
+  Array<PrimExpr> shape = layout->OutputShape();
+  int64_t flat = 0;
+  for (size_t i = 0; i < output.size(); ++i) {
+    int64_t index, extent;
+    if (!EvalConst(output[i], {}, analyzer, &index) ||
+        !EvalConst(shape[i], {}, analyzer, &extent))
+      return false;
+    flat = flat * extent + index;
+  }
+  *addr = flat * bytes;
+  return true;
+}
+
+// Account one warp-wide request; lanes with a negative address are inactive.
+void AddRequest(const std::vector<int64_t> &addrs, int bytes,
+                BankConflictCost *cost) {
+  int lanes_per_phase = std::min(kWarpSize, 128 / std::max(bytes, 4));
+  for (size_t begin = 0; begin < addrs.size(); begin += lanes_per_phase) {
+    std::vector<std::unordered_set<int64_t>> words(kNumBanks);
+    bool active = false;
+    for (size_t lane = begin;
+         lane < std::min(addrs.size(), begin + lanes_per_phase); ++lane) {
+      if (addrs[lane] < 0)
+        continue;
+      active = true;
+      for (int64_t w = addrs[lane] / 4; w <= (addrs[lane] + bytes - 1) / 4;
+           ++w) {
+        words[w % kNumBanks].insert(w);
+      }
+    }
+    if (!active)
+      continue;
+    size_t degree = 1;
+    for (const auto &bank : words) {
+      degree = std::max(degree, bank.size());
+    }
+    cost->wavefronts += degree;
+    cost->ideal += 1;
+    cost->analyzed = true;
+  }
+}
+
+bool ConstShape(const Array<PrimExpr> &shape, std::vector<int64_t> *result) {
+  for (const PrimExpr &e : shape) {
+    const int64_t *p = as_const_int(e);
+    if (p == nullptr)
+      return false;
+    result->push_back(*p);
+  }
+  return true;
+}
+
+} // namespace
+
+BankConflictCost EstimateLoopBankConflicts(const Layout &layout,
+                                           const Buffer &buffer,
+                                           const Array<PrimExpr> &indices,
+                                           const For &root,
+                                           const Fragment &loop_layout) {
+  BankConflictCost cost;
+  int bytes = buffer->dtype.bytes() * buffer->dtype.lanes();
+  std::vector<int64_t> shape, local_shape;
+  if (buffer->dtype.bits() < 8 || !ConstShape(buffer->shape, &shape) ||
+      !ConstShape(loop_layout->OutputShape(), &local_shape))
+    return cost;
+  const int64_t *thread_extent = as_const_int(loop_layout->ThreadExtent());
+  if (thread_extent == nullptr)
+    return cost;
+
+  Array<Var> loop_vars;
+  std::vector<std::pair<int64_t, int64_t>> loop_ranges;
+  Stmt body = root;
+  for (size_t i = 0; i < loop_layout->InputDim(); ++i) {
+    const ForNode *loop = body.as<ForNode>();
+    if (loop == nullptr)
+      return cost;
+    const int64_t *min = as_const_int(loop->min);
+    const int64_t *extent = as_const_int(loop->extent);
+    if (min == nullptr || extent == nullptr)
+      return cost;
+    loop_vars.push_back(loop->loop_var);
+    loop_ranges.emplace_back(*min, *min + *extent);
+    body = loop->body;
+  }
+
+  // The loop variables of the iteration run by thread `tx` at local `l*`.
+  Array<Var> inv_vars;
+  for (size_t i = 0; i < local_shape.size(); ++i) {
+    inv_vars.push_back(Var("l" + std::to_string(i)));
+  }
+  Var tx("tx");
+  inv_vars.push_back(tx);
+  Layout inverse = loop_layout->InverseWithLevel().first;
+  Array<PrimExpr> loop_values =
+      inverse->Forward(Array<PrimExpr>(inv_vars.begin(), inv_vars.end()));
+
+  arith::Analyzer analyzer;
+  Map<Var, PrimExpr> loop_map;
+  for (size_t i = 0; i < loop_vars.size(); ++i) {
+    loop_map.Set(loop_vars[i], cast(loop_vars[i]->dtype, loop_values[i]));
+  }
+  Array<PrimExpr> coords_expr = indices.Map([&](const PrimExpr &e) {
+    return analyzer.Simplify(Substitute(e, loop_map));
+  });
+
+  // Address of local iteration `local` of thread `t`, -1 when it is masked.
+  // Addresses that do not fold to constants (e.g. indirect indices) make the
+  // access unknown.
+  bool unknown = false;
+  auto address = [&](const std::vector<int64_t> &local, int64_t t) {
+    Map<Var, PrimExpr> vmap;
+    for (size_t i = 0; i < local.size(); ++i) {
+      vmap.Set(inv_vars[i], IntImm(DataType::Int(32), local[i]));
+    }
+    vmap.Set(tx, IntImm(DataType::Int(32), t));
+    for (size_t i = 0; i < loop_vars.size(); ++i) {
+      int64_t v;
+      if (!EvalConst(loop_values[i], vmap, &analyzer, &v)) {
+        unknown = true;
+        return int64_t(-1);
+      }
+      if (v < loop_ranges[i].first || v >= loop_ranges[i].second)
+        return int64_t(-1);
+    }
+    std::vector<int64_t> coords;
+    for (size_t i = 0; i < coords_expr.size(); ++i) {
+      int64_t c;
+      if (!EvalConst(coords_expr[i], vmap, &analyzer, &c)) {
+        unknown = true;
+        return int64_t(-1);
+      }
+      if (c < 0 || c >= shape[i])
+        return int64_t(-1);
+      coords.push_back(c);
+    }
+    int64_t addr;
+    if (!PhysicalAddress(layout, coords, bytes, &analyzer, &addr)) {
+      unknown = true;
+      return int64_t(-1);
+    }
+    return addr;
+  };
+
+  // Vectorize the innermost local loop as far as it stays contiguous.
+  int64_t inner = local_shape.empty() ? 1 : local_shape.back();
+  int64_t vec = 1;
+  for (int64_t v = 16 / bytes; v > 1; v /= 2) {
+    if (inner % v != 0)
+      continue;
+    std::vector<int64_t> local(local_shape.size(), 0);
+    int64_t base = address(local, 0);
+    bool contiguous = base >= 0 && base % (v * bytes) == 0;
+    for (int64_t j = 1; contiguous && j < v; ++j) {
+      local.back() = j;
+      contiguous = address(local, 0) == base + j * bytes;
+    }
+    if (contiguous) {
+      vec = v;
+      break;
+    }
+  }
+
+  int64_t num_local = 1;
+  for (int64_t extent : local_shape) {
+    num_local *= extent;
+  }
+  int64_t num_requests = std::min(kMaxRequests, num_local / vec);
+  int64_t num_warps =
+      std::min(kMaxWarps, (*thread_extent + kWarpSize - 1) / kWarpSize);
+  for (int64_t w = 0; w < num_warps; ++w) {
+    for (int64_t r = 0; r < num_requests; ++r) {
+      std::vector<int64_t> local(local_shape.size(), 0);
+      int64_t flat = r * vec;
+      for (int i = static_cast<int>(local_shape.size()) - 1; i >= 0; --i) {
+        local[i] = flat % local_shape[i];
+        flat /= local_shape[i];
+      }
+      std::vector<int64_t> addrs(kWarpSize, -1);
+      for (int lane = 0; lane < kWarpSize; ++lane) {
+        int64_t t = w * kWarpSize + lane;
+        if (t < *thread_extent)
+          addrs[lane] = address(local, t);
+      }
+      if (unknown)
+        return BankConflictCost();
+      AddRequest(addrs, static_cast<int>(vec * bytes), &cost);
+    }
+  }
+  return cost;
+}
+
+BankConflictCost EstimateLdmatrixBankConflicts(const Layout &layout,
+                                               const Buffer &buffer) {
+  BankConflictCost cost;
+  std::vector<int64_t> shape;
+  int bytes = buffer->dtype.bytes() * buffer->dtype.lanes();
+  if (buffer->dtype.bits() < 8 || buffer->shape.size() != 2 ||
+      !ConstShape(buffer->shape, &shape) || bytes > 16)
+    return cost;
+  int64_t vec = 16 / bytes;
+  if (shape[1] % vec != 0)
+    return cost;
+  arith::Analyzer analyzer;
+  for (int64_t r0 = 0; r0 + 8 <= shape[0] && r0 < 16; r0 += 8) {
+    for (int64_t c = 0; c < shape[1] / vec && c < 8; ++c) {
+      std::vector<int64_t> addrs(8, -1);
+      for (int64_t l = 0; l < 8; ++l) {
+        int64_t addr;
+        if (PhysicalAddress(layout, {r0 + l, c * vec}, bytes, &analyzer,
+                            &addr))
+          addrs[l] = addr;
+      }
+      AddRequest(addrs, 16, &cost);
+    }
+  }
+  return cost;
+}
+
+std::vector<std::pair<std::string, Layout>>
+SharedSwizzleCandidates(const Buffer &buffer) {
+  std::vector<std::pair<std::string, Layout>> candidates = {
+      {"linear", makeLinearLayout(buffer->shape)}};
+  std::vector<int64_t> shape;
+  int bits = buffer->dtype.bits() * buffer->dtype.lanes();
+  if (buffer->shape.size() != 2 || !ConstShape(buffer->shape, &shape) ||
+      bits < 8 || 128 % bits != 0 || shape[0] % 8 != 0)
+    return candidates;
+  int vector_size = 128 / bits;
+  int rows = static_cast<int>(shape[0]), cols = static_cast<int>(shape[1]);
+  if (cols % (vector_size * 2) == 0) {
+    candidates.emplace_back("32B swizzle",
+                            makeQuarterBankSwizzleLayout(rows, cols, bits));
+  }
+  if (cols % (vector_size * 4) == 0) {
+    candidates.emplace_back("64B swizzle",
+                            makeHalfBankSwizzleLayout(rows, cols, bits));
+  }
+  if (cols % (vector_size * 8) == 0) {
+    candidates.emplace_back("128B swizzle",
+                            makeFullBankSwizzleLayout(rows, cols, bits));
+  }
+  return candidates;
+}
+
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,91 @@
+/*!
+ * \file layout/bank_conflict.h
+ * \brief Static estimation of shared memory bank conflicts
+ *
+ */
+
+#ifndef TVM_TL_LAYOUT_BANK_CONFLICT_H_
+#define TVM_TL_LAYOUT_BANK_CONFLICT_H_
+
+#include <tvm/tir/buffer.h>
+#include <tvm/tir/stmt.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "layout.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/*!
+ * \brief Shared memory wavefronts of a set of warp-wide requests.
+ *
+ * A request of a warp is served in phases (32 lanes for accesses of up to 4
+ * bytes, 16 lanes for 8 bytes, 8 lanes for 16 bytes); every phase takes as
+ * many wavefronts as the largest number of distinct 4-byte words it touches
+ * in one of the 32 banks. `ideal` counts one wavefront per phase.
+ */
+struct BankConflictCost {
+  int64_t wavefronts{0}; ///< Wavefronts issued
+  int64_t ideal{0};      ///< Wavefronts of the same requests without conflicts
+  bool analyzed{false};  ///< Whether any request could be evaluated
+
+  BankConflictCost &operator+=(const BankConflictCost &other) {
+    wavefronts += other.wavefronts;
+    ideal += other.ideal;
+    analyzed |= other.analyzed;
+    return *this;
+  }
+  /// Average serialization of the requests, 1 when conflict free
+  double Degree() const {
+    return ideal == 0 ? 1.0 : static_cast<double>(wavefronts) / ideal;
+  }
+};
+
+/*!
+ * \brief Estimate the bank conflicts of the accesses of a parallel loop.
+ *
+ * The accesses `buffer[indices]` of the loop nest `root` are distributed over
+ * the threads by `loop_layout`. The requests of the first warps are evaluated
+ * for the first iterations of the thread-local loops, with the innermost one
+ * vectorized as far as its elements are contiguous in `buffer` (up to 16
+ * bytes). Variables other than the loop variables are taken as zero.
+ *
+ * \param layout Layout of the shared buffer the addresses go through.
+ * \param buffer The shared buffer.
+ * \param indices Indices of the accesses, in the loop variables of `root`.
+ * \param root Outermost loop of the parallel loop nest.
+ * \param loop_layout Thread mapping of the loop nest.
+ */
+BankConflictCost EstimateLoopBankConflicts(const Layout &layout,
+                                           const Buffer &buffer,
+                                           const Array<PrimExpr> &indices,
+                                           const For &root,
+                                           const Fragment &loop_layout);
+
+/*!
+ * \brief Estimate the bank conflicts of ldmatrix reads of a 2D buffer.
+ *
+ * Every phase of an ldmatrix reads one 16-byte row segment from each of 8
+ * consecutive rows; the first row groups and column segments are evaluated.
+ */
+BankConflictCost EstimateLdmatrixBankConflicts(const Layout &layout,
+                                               const Buffer &buffer);
+
+/*!
+ * \brief Layouts a 2D shared buffer may take to avoid bank conflicts.
+ *
+ * Returns the linear layout followed by the 32B, 64B and 128B bank swizzles
+ * (the swizzles TMA supports) that fit the shape of `buffer`.
+ */
+std::vector<std::pair<std::string, Layout>>
+SharedSwizzleCandidates(const Buffer &buffer);
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_LAYOUT_BANK_CONFLICT_H_
@@ -297,6 +297,91 @@ Fragment makeGemmFragmentACDNA(const int block_m, const int block_n,
   }
 }
 
+/*
+From https://github.com/ROCm/amd_matrix_instruction_calculator
+./matrix_calculator.py --architecture rdna3 --instruction
+v_wmma_f32_16x16x16_f16 --wavefront 32 --detail-instruction
+
+In wave32, lane l works on row (A) or column (B, C) l % 16 of a 16x16 tile.
+On RDNA3 both half-waves hold a copy of the whole K extent of A and B and the
+rows of C are interleaved between them, on RDNA4 each half-wave holds 8
+consecutive K values of A and B and 8 consecutive rows of C. Warps are laid
+out M first, and the fragments of a warp are indexed as
+[warp_k][warp_rows or warp_cols][local] for A/B and [warp_rows][warp_cols]
+[local] for C, matching RDNAWMMAIntrinEmitter.
+*/
+Fragment makeGemmFragmentCRDNA(const int block_m, const int block_n,
+                               const int warp_m, const int warp_n,
+                               const int element_size, bool is_gfx12) {
+  ICHECK(element_size == 32)
+      << "RDNA wmma only accumulates in 32 bits, got " << element_size;
+  ICHECK(block_m % warp_m == 0);
+  ICHECK(block_n % warp_n == 0);
+  ICHECK(warp_m % 16 == 0) << "warp_m=" << warp_m;
+  ICHECK(warp_n % 16 == 0) << "warp_n=" << warp_n;
+  IterVar i = make_itervar("i", block_m);
+  IterVar j = make_itervar("j", block_n);
+  IterVar rep = make_itervar("rep", 1);
+  PrimExpr row = FloorMod(i, 16);
+  PrimExpr lane =
+      FloorMod(j, 16) + 16 * (is_gfx12 ? FloorDiv(row, 8) : FloorMod(row, 2));
+  PrimExpr local = is_gfx12 ? FloorMod(row, 8) : FloorDiv(row, 2);
+  PrimExpr warp = FloorDiv(j, warp_n) * (block_m / warp_m) + FloorDiv(i, warp_m);
+  PrimExpr idx = (FloorDiv(FloorMod(i, warp_m), 16) * (warp_n / 16) +
+                  FloorDiv(FloorMod(j, warp_n), 16)) *
+                     8 +
+                 local;
+  return Fragment({i, j}, {idx}, warp * 32 + lane, rep);
+}
+
+// Operand fragment of a [block_s, block_k] tile, s being M for A or N for B,
+// replicated over the `replicate` warps along the other spatial axis.
+static Fragment makeGemmFragmentABRDNA(const int block_s, const int block_k,
+                                       const int warp_s, const int replicate,
+                                       const int warp_stride_s,
+                                       const int warp_stride_rep, bool k_first,
+                                       bool is_gfx12) {
+  ICHECK(block_s % warp_s == 0);
+  ICHECK(warp_s % 16 == 0) << "warp_s=" << warp_s;
+  ICHECK(block_k % 16 == 0) << "block_k=" << block_k;
+  const int half_waves = is_gfx12 ? 1 : 2;
+  const int local_size = is_gfx12 ? 8 : 16;
+  IterVar s = make_itervar("s", block_s);
+  IterVar k = make_itervar("k", block_k);
+  IterVar rep = make_itervar("rep", replicate * half_waves);
+  PrimExpr kk = FloorMod(k, 16);
+  PrimExpr half = is_gfx12 ? FloorDiv(kk, 8) : FloorMod(rep, half_waves);
+  PrimExpr warp = FloorDiv(s, warp_s) * warp_stride_s +
+                  FloorDiv(rep, half_waves) * warp_stride_rep;
+  PrimExpr thd = warp * 32 + FloorMod(s, 16) + 16 * half;
+  PrimExpr idx = (FloorDiv(k, 16) * (warp_s / 16) +
+                  FloorDiv(FloorMod(s, warp_s), 16)) *
+                     local_size +
+                 (is_gfx12 ? FloorMod(kk, 8) : kk);
+  if (k_first) {
+    return Fragment({k, s}, {idx}, thd, rep);
+  }
+  return Fragment({s, k}, {idx}, thd, rep);
+}
+
+Fragment makeGemmFragmentARDNA(const int block_m, const int block_n,
+                               const int block_k, const int warp_m,
+                               const int warp_n, bool transposed,
+                               bool is_gfx12) {
+  const int block_row_warps = block_m / warp_m;
+  return makeGemmFragmentABRDNA(block_m, block_k, warp_m, block_n / warp_n, 1,
+                                block_row_warps, transposed, is_gfx12);
+}
+
+Fragment makeGemmFragmentBRDNA(const int block_m, const int block_n,
+                               const int block_k, const int warp_m,
+                               const int warp_n, bool transposed,
+                               bool is_gfx12) {
+  const int block_row_warps = block_m / warp_m;
+  return makeGemmFragmentABRDNA(block_n, block_k, warp_n, block_row_warps,
+                                block_row_warps, 1, !transposed, is_gfx12);
+}
+
 Fragment makeGemmFragment32x32(int element_size) {
   IterVar i = make_itervar("i", 32);
   IterVar j = make_itervar("j", 32);
@@ -820,5 +905,24 @@ Layout makeGemmABLayoutCDNA(int stride, int continuous, int element_size,
                             int kPack) {
   return makeMatrixCoreSwizzleLayout(stride, continuous, element_size, kPack);
 }
+
+/*!
+ * \brief LDS layout of a K-major MFMA operand read vec_bytes at a time.
+ *
+ * The LDS of CDNA serves 128 bytes per clock, so a ds_read_b64 (ds_read_b128)
+ * of a wave runs in groups of 16 (8) consecutive lanes. The lanes of a group
+ * read consecutive rows of the operand at the same K, so the matrix core
+ * swizzle with vec_bytes wide units spreads each group over all the banks.
+ * Rows too narrow for one unit keep the padded layout.
+ */
+Layout makeGemmABLayoutCDNALds(int stride, int continuous, int element_size,
+                               int vec_bytes) {
+  ICHECK(vec_bytes == 8 || vec_bytes == 16) << "vec_bytes=" << vec_bytes;
+  int vec = vec_bytes * 8 / element_size;
+  if (continuous % vec != 0)
+    return makeGemmABLayoutPadded(stride, continuous, element_size);
+  return makeMatrixCoreSwizzleLayout(stride, continuous, element_size,
+                                     vec_bytes / 8);
+}
 } // namespace tl
 } // namespace tvm
@@ -11,7 +11,12 @@
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
 #include "arith/pattern_match.h"
+#include "tcgen05_layout.h"
 #include "tvm/node/functor.h"
 #include "tvm/node/repr_printer.h"
 #include "utils.h"
@@ -22,11 +27,69 @@ namespace tl {
 using namespace tir;
 
 static Var getPlaceholder(const std::string &s) {
+  // Shared by the PrimFuncs lowered concurrently (par_compile and the
+  // parallel lowering of multi-kernel modules).
+  static std::mutex mutex;
   static std::unordered_map<std::string, Var> map;
-  if (map.find(s) == map.end()) {
-    map[s] = Var(s);
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = map.find(s);
+  if (it == map.end()) {
+    it = map.emplace(s, Var(s)).first;
+  }
+  return it->second;
+}
+
+namespace {
+
+struct InverseMemoEntry {
+  Layout inverse;
+  arith::IterMapLevel level;
+  // Message of the NormalizeIterException raised by the inversion, if any.
+  std::string error;
+};
+
+using InverseMemo = std::unordered_map<ObjectRef, InverseMemoEntry,
+                                       ObjectPtrHash, ObjectPtrEqual>;
+
+thread_local InverseMemo *inverse_memo = nullptr;
+
+template <typename F>
+std::pair<Layout, arith::IterMapLevel> MemoizedInverse(const LayoutNode *node,
+                                                       F compute) {
+  if (inverse_memo == nullptr) {
+    return compute();
+  }
+  ObjectRef key = ffi::GetRef<Layout>(node);
+  auto it = inverse_memo->find(key);
+  if (it == inverse_memo->end()) {
+    InverseMemoEntry entry;
+    try {
+      std::tie(entry.inverse, entry.level) = compute();
+    } catch (const NormalizeIterException &e) {
+      entry.error = e.what();
+    }
+    it = inverse_memo->emplace(key, std::move(entry)).first;
+  }
+  if (!it->second.error.empty()) {
+    throw NormalizeIterException(it->second.error);
+  }
+  return {it->second.inverse, it->second.level};
+}
+
+} // namespace
+
+LayoutMemoScope::LayoutMemoScope() {
+  if (inverse_memo == nullptr) {
+    inverse_memo = new InverseMemo();
+    owner_ = true;
+  }
+}
+
+LayoutMemoScope::~LayoutMemoScope() {
+  if (owner_) {
+    delete inverse_memo;
+    inverse_memo = nullptr;
   }
-  return map[s];
 }
 
 Var ReplicationPlaceholder() { return getPlaceholder("_rep"); }
@@ -246,6 +309,11 @@ Fragment FragmentNode::BindThreadRange(Range thread_range) const {
 }
 
 std::pair<Layout, arith::IterMapLevel> LayoutNode::InverseWithLevel() const {
+  return MemoizedInverse(this, [this]() { return ComputeInverseWithLevel(); });
+}
+
+std::pair<Layout, arith::IterMapLevel>
+LayoutNode::ComputeInverseWithLevel() const {
   arith::Analyzer analyzer;
   auto collect_symbolic = [&](const Array<PrimExpr> &shape) {
     Array<PrimExpr> symbolic_dims;
@@ -648,14 +716,16 @@ Layout FragmentNode::Inverse() const {
 }
 
 std::pair<Layout, arith::IterMapLevel> FragmentNode::InverseWithLevel() const {
-  auto input_size_copy = input_size_;
-  input_size_copy.push_back(ReplicateExtent());
-  auto forward_index_copy = forward_index_;
-  forward_index_copy.push_back(
-      Substitute(forward_thread_,
-                 {{ReplicationPlaceholder(), InputPlaceholder(InputDim())}}));
-  auto fwd = Layout(input_size_copy, forward_index_copy);
-  return fwd->InverseWithLevel();
+  return MemoizedInverse(this, [this]() {
+    auto input_size_copy = input_size_;
+    input_size_copy.push_back(ReplicateExtent());
+    auto forward_index_copy = forward_index_;
+    forward_index_copy.push_back(
+        Substitute(forward_thread_,
+                   {{ReplicationPlaceholder(), InputPlaceholder(InputDim())}}));
+    auto fwd = Layout(input_size_copy, forward_index_copy);
+    return fwd->ComputeInverseWithLevel();
+  });
 }
 
 Fragment FragmentNode::CondenseReplicateVar() const {
@@ -693,6 +763,9 @@ std::string FragmentNode::DebugOutput() const {
 }
 
 bool LayoutNode::IsEqual(const LayoutNode *other, bool skip_index) const {
+  if (this == other) {
+    return true;
+  }
   bool ret = StructuralEqual()(this->InputShape(), other->InputShape());
   ret &= StructuralEqual()(this->OutputShape(), other->OutputShape());
   if (!ret) {
@@ -721,6 +794,9 @@ bool FragmentNode::IsEqual(const FragmentNode *other, bool skip_index) const {
   // Fragment Layout Comparison can skip the index comparison
   // when the output shape is the same, as we can do
   // a[i, j] = b[j, i] in register level.
+  if (this == other) {
+    return true;
+  }
 
   bool ret = StructuralEqual()(this->InputShape(), other->InputShape());
   if (!ret) {
@@ -843,6 +919,11 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                                              element_size, k_inner);
              }
            })
+      .def("tl.make_mfma_swizzled_layout",
+           [](int stride, int continuous, int element_size, int vec_bytes) {
+             return makeGemmABLayoutCDNALds(stride, continuous, element_size,
+                                            vec_bytes);
+           })
       .def("tl.make_volta_swizzled_layout",
            [](int stride, int mat_continuous, bool is_a, bool k_inner) {
              return makeGemmVoltaABLayout(stride, mat_continuous, is_a,
@@ -860,6 +941,14 @@ TVM_FFI_STATIC_INIT_BLOCK() {
              return makeGemmABLayoutSm100(stride, mat_continuous, continuity,
                                           element_size, k_inner);
            })
+      .def("tl.make_tcgen05_scale_factor_layout",
+           [](int rows, int num_sf) {
+             return makeTcgen05ScaleFactorLayout(rows, num_sf);
+           })
+      .def("tl.make_tcgen05_scale_factor_tmem_layout",
+           [](int rows, int num_sf) {
+             return makeTcgen05ScaleFactorTmemLayout(rows, num_sf);
+           })
       .def("tl.make_full_bank_swizzled_layout",
            [](int stride, int continuous, int element_size) {
              return makeFullBankSwizzleLayout(stride, continuous, element_size);
@@ -874,7 +963,25 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                                                  element_size);
            })
       .def("tl.make_linear_layout",
-           [](Array<PrimExpr> shape) { return makeLinearLayout(shape); });
+           [](Array<PrimExpr> shape) { return makeLinearLayout(shape); })
+      .def("tl.make_rdna_wmma_fragment_c",
+           [](int block_m, int block_n, int warp_m, int warp_n,
+              int element_size, bool is_gfx12) {
+             return makeGemmFragmentCRDNA(block_m, block_n, warp_m, warp_n,
+                                          element_size, is_gfx12);
+           })
+      .def("tl.make_rdna_wmma_fragment_a",
+           [](int block_m, int block_n, int block_k, int warp_m, int warp_n,
+              bool transposed, bool is_gfx12) {
+             return makeGemmFragmentARDNA(block_m, block_n, block_k, warp_m,
+                                          warp_n, transposed, is_gfx12);
+           })
+      .def("tl.make_rdna_wmma_fragment_b",
+           [](int block_m, int block_n, int block_k, int warp_m, int warp_n,
+              bool transposed, bool is_gfx12) {
+             return makeGemmFragmentBRDNA(block_m, block_n, block_k, warp_m,
+                                          warp_n, transposed, is_gfx12);
+           });
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
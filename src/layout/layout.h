@@ -77,6 +77,9 @@ public:
 
   virtual std::pair<Layout, arith::IterMapLevel> InverseWithLevel() const;
 
+  // InverseWithLevel() of this layout bypassing the LayoutMemoScope memo.
+  std::pair<Layout, arith::IterMapLevel> ComputeInverseWithLevel() const;
+
   virtual std::string DebugOutput() const;
 
   virtual bool IsEqual(const LayoutNode *other, bool skip_index = false) const;
@@ -192,6 +195,26 @@ public:
   TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(Fragment, Layout, FragmentNode);
 };
 
+/*!
+ * \brief Memoizes Layout::InverseWithLevel() on the calling thread while alive.
+ *
+ *  Layouts are immutable, so an inverse is keyed by the identity of the layout
+ *  node, which the memo keeps alive. Normalization failures are memoized as
+ *  well and rethrown. Layout inference computes the inverse of the same loop
+ *  and buffer fragments once per operator visit. Scopes nest; the outermost
+ *  one owns the memo.
+ */
+class LayoutMemoScope {
+public:
+  LayoutMemoScope();
+  ~LayoutMemoScope();
+  LayoutMemoScope(const LayoutMemoScope &) = delete;
+  LayoutMemoScope &operator=(const LayoutMemoScope &) = delete;
+
+private:
+  bool owner_{false};
+};
+
 Var InputPlaceholder(size_t idx);
 Var ReplicationPlaceholder();
 IterVar make_itervar(std::string name, PrimExpr dom);
@@ -223,6 +246,18 @@ Fragment makeGemmFragmentACDNA(const int block_m, const int block_n,
                                const int warp_n, const int element_size,
                                const int k_pack, bool transposed = false);
 
+Fragment makeGemmFragmentCRDNA(const int block_m, const int block_n,
+                               const int warp_m, const int warp_n,
+                               const int element_size, bool is_gfx12);
+Fragment makeGemmFragmentARDNA(const int block_m, const int block_n,
+                               const int block_k, const int warp_m,
+                               const int warp_n, bool transposed,
+                               bool is_gfx12);
+Fragment makeGemmFragmentBRDNA(const int block_m, const int block_n,
+                               const int block_k, const int warp_m,
+                               const int warp_n, bool transposed,
+                               bool is_gfx12);
+
 // Default Memory Layout (row-major linear layout for any dimension)
 Layout makeLinearLayout(Array<PrimExpr> shape);
 Layout makeGemmABLayoutPadded(int stride, int continuous, int element_size);
@@ -235,6 +270,8 @@ Layout makeGemmABLayoutSm100(int mat_stride, int mat_continuous, int continuity,
                              int element_size, bool k_inner = true);
 Layout makeGemmABLayoutCDNA(int stride, int continuous, int element_size,
                             int kPack);
+Layout makeGemmABLayoutCDNALds(int stride, int continuous, int element_size,
+                               int vec_bytes);
 
 Fragment makeGemmVoltaFragmentC(const int block_m, const int block_n,
                                 const int warp_m, const int warp_n,
@@ -107,5 +107,36 @@ expandTcgen05Layout(const Tcgen05Meta &meta, int tmem_phy_col_extent,
           num_chunks_each_wg};
 }
 
+static void CheckScaleFactorShape(int rows, int num_sf) {
+  ICHECK(rows % 128 == 0) << "scale factors of block scaled tcgen05.mma "
+                             "expect a multiple of 128 rows, got "
+                          << rows;
+  ICHECK(num_sf % 4 == 0) << "scale factors of block scaled tcgen05.mma "
+                             "expect a multiple of 4 per row, got "
+                          << num_sf;
+}
+
+Layout makeTcgen05ScaleFactorLayout(int rows, int num_sf) {
+  CheckScaleFactorShape(rows, num_sf);
+  Var i = InputPlaceholder(0);
+  Var j = InputPlaceholder(1);
+  PrimExpr chunk = FloorDiv(j, 4) * (rows / 128) + FloorDiv(i, 128);
+  // Row 32 * c + l of a chunk is the 4 bytes at 16 * l + 4 * c, the 16 bytes
+  // of row l of the copy landing in the 4 columns of lane l.
+  PrimExpr offset = FloorMod(i, 32) * 16 + FloorDiv(FloorMod(i, 128), 32) * 4 +
+                    FloorMod(j, 4);
+  return Layout(Array<PrimExpr>{rows, num_sf}, {chunk, offset});
+}
+
+Layout makeTcgen05ScaleFactorTmemLayout(int rows, int num_sf) {
+  CheckScaleFactorShape(rows, num_sf);
+  Var i = InputPlaceholder(0);
+  Var j = InputPlaceholder(1);
+  PrimExpr chunk = FloorDiv(j, 4) * (rows / 128) + FloorDiv(i, 128);
+  return Layout(Array<PrimExpr>{rows, num_sf},
+                {FloorMod(i, 32), chunk * 4 + FloorDiv(FloorMod(i, 128), 32),
+                 FloorMod(j, 4)});
+}
+
 } // namespace tl
 } // namespace tvm
@@ -29,5 +29,18 @@ std::tuple<bool, Fragment, int>
 expandTcgen05Layout(const Tcgen05Meta &meta, int tmem_phy_col_extent,
                     int num_threads, Range row_dom, Range col_dom);
 
+// Scale factors of block scaled tcgen05.mma. A (rows x num_sf) scale factor
+// matrix, rows being M for A or N for B, is split into chunks of 128 rows x 4
+// scale factors, ordered along the rows first. In tensor memory, lane l and
+// column c of a chunk hold the 4 scale factors of row 32 * c + l, the 32 lanes
+// being replicated to the 4 sub-partitions.
+//
+// Shared memory layout of the scale factors copied by tcgen05.cp.32x128b
+// .warpx4: (row, sf) |-> (chunk, byte in the 512-byte chunk).
+Layout makeTcgen05ScaleFactorLayout(int rows, int num_sf);
+// Tensor memory placement of the scale factors:
+// (row, sf) |-> (lane, column, byte in the 32-bit column).
+Layout makeTcgen05ScaleFactorTmemLayout(int rows, int num_sf);
+
 } // namespace tl
 } // namespace tvm
@@ -82,7 +82,7 @@ const Op &AtomicAddNode::GetElemOp() const { return atomic_add_elem_op(); }
  * @brief Get vectorization length based on dst dtype and target SM version.
  *
  * Returns:
- *   - 2 for float16/bfloat16
+ *   - 8 for float16/bfloat16 on SM >= 90, 2 otherwise
  *   - 4 for float32 on SM >= 90
  *   - 1 for all other cases
  *
@@ -90,15 +90,7 @@ const Op &AtomicAddNode::GetElemOp() const { return atomic_add_elem_op(); }
  * @return int The vectorization length.
  */
 int AtomicAddNode::GetVectorizeLength(Target target) const {
-  DataType dtype = dst->dtype;
-  if (dtype.is_float16() || dtype.is_bfloat16()) {
-    return 2;
-  }
-  if (dtype.is_float() && dtype.bits() == 32 &&
-      TargetHasSMVersionGE(target, 90)) {
-    return 4;
-  }
-  return 1;
+  return TargetGetAtomicAddVectorSize(target, dst->dtype);
 }
 
 std::pair<Array<PrimExpr>, PrimExpr>
@@ -32,6 +32,48 @@ static constexpr const char *kLocalVarInit = "tl.local_var_init";
 // that must NOT be marked with the restrict qualifier in codegen.
 // Type: Array<tir::Var>
 static constexpr const char *kNonRestrictParams = "tl.non_restrict_params";
+// Compile-time thread block cluster shape of a kernel, "x, y, z".
+// Type: String, attached by T.Kernel(cluster_dims=...)
+static constexpr const char *kClusterDims = "pragma_cluster_dims";
+// Blocks per SM a kernel must allow, the minBlocksPerSM of its
+// __launch_bounds__; 0 until the automatic selection resolved it.
+// Type: IntImm, attached by T.Kernel(min_blocks_per_sm=...)
+static constexpr const char *kMinBlocksPerSM = "pragma_min_blocks_per_sm";
+// Bitmask of the CTAs of the cluster that receive a multicast tma_load.
+// Type: PrimExpr, attached to the tma_load Call by T.copy(..., multicast=...)
+static constexpr const char *kMulticastMask = "multicast_mask";
+// Marks a tma_store whose completion is not awaited right after it is
+// issued, see inject_fence_proxy.cc. Type: IntImm
+static constexpr const char *kTMAStoreAsync = "tma_store_async";
+// Marks a tma_load whose coordinates are {col, row0, row1, row2, row3} of a
+// 2D descriptor, loading four gathered rows. Type: IntImm, attached to the
+// tma_load Call by T.gather_copy on sm100
+static constexpr const char *kTMAGather4 = "tma_gather4";
+// Number of CTAs (2) a tcgen05 instruction runs across, absent for a single
+// CTA. Type: IntImm, attached to the ptx_tcgen05_mma_ss, tcgen05_mma_arrive
+// and tensor memory (de)allocation Calls of kernels using 2-CTA T.gemm
+static constexpr const char *kCtaGroup = "cta_group";
+// Cache policy of the accesses to a global buffer inside the body, with the
+// values of the eviction_policy copy annotation (1=evict_first,
+// 2=evict_last, 3=no_allocate). Type: AttrStmt whose node is the data Var of
+// the buffer and whose value is an IntImm, emitted by SIMT T.copy
+static constexpr const char *kCacheHint = "tl.cache_hint";
+// Marks the wave loop built by T.Persistent, whose next iteration is the next
+// work item of the CTA. Type: IntImm, For annotation
+static constexpr const char *kPersistentLoop = "tl_persistent_loop";
+// The loops UnrollLoop unrolled and how many times, read by the compile
+// profile. Type: Array<Map<String, Any>> with the keys loop, extent, factor
+// and body_instructions, PrimFunc attribute
+static constexpr const char *kUnrollDecisions = "tl.unroll_decisions";
+// Requests the ping-pong schedule of the two consumer warpgroups of a warp
+// specialized kernel, see warp_group_pingpong.cc. Type: IntImm, annotation
+// of the kernel block set by T.annotate_pingpong, then of the consumer loops
+// it schedules
+static constexpr const char *kWarpGroupPingPong = "tl.warp_group_pingpong";
+// Marks an atomic whose lanes updating the same address combine their values
+// first, see aggregate_atomics.cc. Type: IntImm, annotation of the
+// atomic_{add,max,min}_elem_op Call
+static constexpr const char *kWarpAggregate = "tl.warp_aggregate";
 } // namespace attr
 
 static constexpr const char *kDebugMergeSharedMemoryAllocations =
@@ -39,21 +81,49 @@ static constexpr const char *kDebugMergeSharedMemoryAllocations =
 static constexpr const char *kDisableTMALower = "tl.disable_tma_lower";
 static constexpr const char *kDisableSafeMemoryLegalize =
     "tl.disable_safe_memory_legalize";
+static constexpr const char *kDisableLoopUnswitching =
+    "tl.disable_loop_unswitching";
+static constexpr const char *kDisableCopyElimination =
+    "tl.disable_copy_elimination";
+static constexpr const char *kDisableDeadStoreElimination =
+    "tl.disable_dead_store_elimination";
+static constexpr const char *kDisableReduceFusion = "tl.disable_reduce_fusion";
+static constexpr const char *kDisableParallelLoopFusion =
+    "tl.disable_parallel_loop_fusion";
+static constexpr const char *kDisableAliasCheck = "tl.disable_alias_check";
+static constexpr const char *kDisableAtomicAggregation =
+    "tl.disable_atomic_aggregation";
 static constexpr const char *kDisableWarpSpecialized =
     "tl.disable_warp_specialized";
 static constexpr const char *kConfigIndexBitwidth = "tl.config_index_bitwidth";
+static constexpr const char *kDisableIndexBitwidthDispatch =
+    "tl.disable_index_bitwidth_dispatch";
 static constexpr const char *kEnableAggressiveSharedMemoryMerge =
     "tl.enable_aggressive_shared_memory_merge";
+static constexpr const char *kEnableOptimalSharedMemoryPacking =
+    "tl.enable_optimal_shared_memory_packing";
 static constexpr const char *kDisableFastMath = "tl.disable_fast_math";
 static constexpr const char *kEnableFastMath = "tl.enable_fast_math";
 static constexpr const char *kPtxasRegisterUsageLevel =
     "tl.ptxas_register_usage_level";
 static constexpr const char *kEnablePTXASVerboseOutput =
     "tl.enable_ptxas_verbose_output";
+static constexpr const char *kFastCompile = "tl.fast_compile";
+static constexpr const char *kRegisterBudget = "tl.register_budget";
+static constexpr const char *kDisableRematerialization =
+    "tl.disable_rematerialization";
+static constexpr const char *kDisableIndexStrengthReduction =
+    "tl.disable_index_strength_reduction";
+static constexpr const char *kUnrollCodeSizeBudget =
+    "tl.unroll_code_size_budget";
 static constexpr const char *kDisableVectorize256 = "tl.disable_vectorize_256";
 static constexpr const char *kEnableVectorizePlannerVerbose =
     "tl.enable_vectorize_planner_verbose";
+static constexpr const char *kDisableSyncElision = "tl.disable_sync_elision";
+static constexpr const char *kEnableSyncElisionVerbose =
+    "tl.enable_sync_elision_verbose";
 static constexpr const char *kDisableWGMMA = "tl.disable_wgmma";
+static constexpr const char *kDisableGemv = "tl.disable_gemv";
 static constexpr const char *kDisableShuffleElect = "tl.disable_shuffle_elect";
 static constexpr const char *kStorageRewriteDetectInplace =
     "tl.storage_rewrite_detect_inplace";
@@ -65,6 +135,39 @@ static constexpr const char *kLayoutVisualizationFormats =
 static constexpr const char *kDeviceCompileFlags = "tl.device_compile_flags";
 static constexpr const char *kDisableDataRaceCheck =
     "tl.disable_data_race_check";
+static constexpr const char *kEnablePDLChaining = "tl.enable_pdl_chaining";
+static constexpr const char *kEnableCPUParallelGrid =
+    "tl.enable_cpu_parallel_grid";
+static constexpr const char *kEnableProfileRegion =
+    "tl.enable_profile_region";
+static constexpr const char *kEnableDeviceLog = "tl.enable_device_log";
+static constexpr const char *kDeviceAssertMode = "tl.device_assert_mode";
+static constexpr const char *kEnableCompileProfile =
+    "tl.enable_compile_profile";
+static constexpr const char *kParallelLowerWorkers =
+    "tl.parallel_lower_workers";
+static constexpr const char *kDisablePhaseCache = "tl.disable_phase_cache";
+static constexpr const char *kEnableDeviceCompilePCH =
+    "tl.enable_device_compile_pch";
+static constexpr const char *kEnableAutoL2Persistent =
+    "tl.enable_auto_l2_persistent";
+static constexpr const char *kWarpSpecializedOccupancy =
+    "tl.warp_specialized_occupancy";
+static constexpr const char *kDisableCacheHintInference =
+    "tl.disable_cache_hint_inference";
+static constexpr const char *kPipelinePrefetchDistance =
+    "tl.pipeline_prefetch_distance";
+static constexpr const char *kEnableSharedSwizzleInference =
+    "tl.enable_shared_swizzle_inference";
+static constexpr const char *kEnableBankConflictReport =
+    "tl.enable_bank_conflict_report";
+static constexpr const char *kEnableHostSignatureCache =
+    "tl.enable_host_signature_cache";
+static constexpr const char *kDisableWgmmaWaitDeferral =
+    "tl.disable_wgmma_wait_deferral";
+static constexpr const char *kDisableTmaCoalesce = "tl.disable_tma_coalesce";
+static constexpr const char *kDisablePipelineTripCountDispatch =
+    "tl.disable_pipeline_trip_count_dispatch";
 
 /*!
  * \brief Whether to disable thread storage synchronization
@@ -132,10 +235,20 @@ TVM_DLL const Op &ieee_frsqrt();
 // ieee_fdiv(x, y, rounding_mode) - IEEE-compliant division
 TVM_DLL const Op &ieee_fdiv();
 
+// Approximations of the special function unit, selected by LowerFastMath
+// within the ulp budget of a T.fastmath region.
+// ex2_approx(x) - 2**x, packed over the 32-bit words of half vectors
+TVM_DLL const Op &ex2_approx();
+// tanh_approx(x) - tanh(x), packed over the 32-bit words of half vectors
+TVM_DLL const Op &tanh_approx();
+
 // random op
 TVM_DLL const Op &rng_init();
 TVM_DLL const Op &rng_rand();
 TVM_DLL const Op &rng_rand_float();
+// philox_rand(seed, offset, index) - stateless Philox4x32-10 uint32 of an
+// element, vectorized over 4 consecutive indices into a single call
+TVM_DLL const Op &philox_rand();
 
 /*!
  * \brief tvm intrinsics for TMADescriptor creation for tiled load
@@ -158,6 +271,31 @@ TVM_DLL const Op &create_tma_descriptor();
  */
 TVM_DLL const Op &create_tma_im2col_descriptor();
 
+/*!
+ * \brief tvm intrinsics for retargeting a TMA descriptor on device
+ *
+ * Copies the host-encoded `descriptor` into a CTA-owned 128-byte global
+ * `workspace`, replaces its global address with `tensormap.replace` and
+ * fences the tensormap proxy. Evaluates to the patched descriptor, so it can
+ * stand in for the descriptor operand of tma_load/tma_store. The optional
+ * trailing operands also replace the `rank` global extents (innermost first)
+ * and the `rank - 1` byte strides of the outer dimensions.
+ *
+ * CuTensorMap& tma_descriptor_replace_address(workspace, descriptor,
+ * global_addr, [extent_0, ..., extent_{rank-1}, stride_1, ...,
+ * stride_{rank-1}])
+ *
+ */
+TVM_DLL const Op &tma_descriptor_replace_address();
+
+/*!
+ * \brief Whether `call` produces a TMA tensor map.
+ *
+ * The descriptor operand of tma_load/tma_store is one of these calls (before
+ * LowerHopperIntrin) while 1D bulk copies carry a plain access pointer there.
+ */
+TVM_DLL bool IsTMADescriptorCall(const CallNode *call);
+
 /*!
  * \brief Create a list of mbarrier with num_threads
  *
@@ -202,6 +340,34 @@ TVM_DLL const Op &tma_load_im2col();
  */
 TVM_DLL const Op &tma_store();
 
+/*!
+ * \brief tvm intrinsics for prefetching the box of a tensor descriptor from
+ * global memory into L2 (cp.async.bulk.prefetch.tensor)
+ *
+ * tma_prefetch(descriptor, coord_0, coord_1, ...)
+ *
+ */
+TVM_DLL const Op &tma_prefetch();
+
+/*!
+ * \brief tvm intrinsics for prefetching `bytes` contiguous bytes of global
+ * memory into L2 (cp.async.bulk.prefetch), the address and size are multiples
+ * of 16
+ *
+ * bulk_prefetch_l2(global_addr, bytes)
+ *
+ */
+TVM_DLL const Op &bulk_prefetch_l2();
+
+/*!
+ * \brief tvm intrinsics for prefetching the cache line of a global address
+ * into L2 (prefetch.global.L2)
+ *
+ * prefetch_l2(global_addr)
+ *
+ */
+TVM_DLL const Op &prefetch_l2();
+
 /*!
  * \brief tvm intrinsics for barrier initialization fence
  *
@@ -258,6 +424,29 @@ TVM_DLL const Op &ptx_tcgen05_mma_ss();
  */
 TVM_DLL const Op &ptx_tcgen05_mma_ts();
 
+/*!
+ * \brief tvm intrinsic for block scaled tcgen05 mma shared-shared instructions.
+ *
+ *  void ptx_tcgen05_mma_blockscaled_ss(StringImm kind, int scale_vec,
+ * Var A_descriptor, PrimExpr A_offset, Var B_descriptor, PrimExpr B_offset,
+ * Var C_data, PrimExpr C_offset, Var SFA_data, PrimExpr SFA_offset,
+ * Var SFB_data, PrimExpr SFB_offset, PrimExpr instr_desc, PrimExpr scale_out);
+ *
+ *  kind is "mxf8f6f4" or "mxf4nvf4", the scale factors of A and B being read
+ *  from the tensor memory columns at SFA_offset and SFB_offset.
+ */
+TVM_DLL const Op &ptx_tcgen05_mma_blockscaled_ss();
+
+/*!
+ * \brief tvm intrinsic for tcgen05.cp.32x128b.warpx4, copying 32 rows of 16
+ * bytes from shared memory into the 32 lanes of each of the 4 sub-partitions
+ * of tensor memory.
+ *
+ *  void ptx_tcgen05_cp(Var smem_descriptor, PrimExpr smem_offset,
+ * Var tmem_data, PrimExpr tmem_col_offset);
+ */
+TVM_DLL const Op &ptx_tcgen05_cp();
+
 /*!
  * \brief tvm intrinsics for initializing tensor memory
  *
@@ -285,6 +474,21 @@ TVM_DLL const Op &ptx_deallocate_tensor_memory();
  */
 TVM_DLL const Op &ptx_mma_sm70();
 
+/*!
+ * \brief tvm intrinsic for the block scaled ptx mma.sync of sm120.
+ *
+ *  void ptx_mma_blockscaled(StringImm A_dtype, StringImm B_dtype,
+ *                           Var multiplicand_a, Expr a_index,
+ *                           Var multiplicand_b, Expr b_index,
+ *                           Var accumulator, Expr c_index,
+ *                           Expr scale_a, Expr scale_b);
+ *
+ * Issues one m16n8k32 FP8 mma with float32 accumulation, row-major A and
+ * column-major B. scale_a and scale_b are the UE8M0 scale factors of the
+ * row of A and the column of B the calling lane provides, as uint32.
+ */
+TVM_DLL const Op &ptx_mma_blockscaled();
+
 /*!
  * \brief tvm intrinsics for ldmatrix
  *
@@ -326,6 +530,16 @@ TVM_DLL const Op &ptx_cp_async();
  */
 TVM_DLL const Op &pack_b16();
 
+/*!
+ * \brief Copy between two global addresses through shared memory chunks
+ *
+ * bulk_copy_g2g(dst, src, bytes, workspace, chunk_bytes)
+ *
+ * Issued by a single thread. The workspace holds two mbarriers in its first
+ * 128 bytes, followed by two chunks of chunk_bytes each.
+ */
+TVM_DLL const Op &bulk_copy_g2g();
+
 /*!
  * \brief Issue a shared memory fence for async operations
  *
@@ -343,10 +557,12 @@ TVM_DLL const Op &fence_proxy_async();
 TVM_DLL const Op &tma_store_arrive();
 
 /*!
- * \brief Wait for TMA_STORE to finish
+ * \brief Wait for TMA_STORE to finish reading its shared memory source
  *
- * tma_store_wait()
+ * tma_store_wait([count])
  *
+ * Waits until at most count (default 0) of the most recent bulk groups are
+ * still reading their source.
  */
 TVM_DLL const Op &tma_store_wait();
 
@@ -438,6 +654,23 @@ TVM_DLL const Op &get_warp_group_idx();
  */
 TVM_DLL const Op &wait_wgmma();
 
+/*!
+ * \brief Wait at a named barrier until thread_count threads arrived at it,
+ * this thread included
+ *
+ * named_barrier_sync(barrier_id, thread_count)
+ *
+ */
+TVM_DLL const Op &named_barrier_sync();
+
+/*!
+ * \brief Arrive at a named barrier without waiting for it
+ *
+ * named_barrier_arrive(barrier_id, thread_count)
+ *
+ */
+TVM_DLL const Op &named_barrier_arrive();
+
 /*!
  * \brief Synchronize all threads in a grid
  *
@@ -446,6 +679,22 @@ TVM_DLL const Op &wait_wgmma();
  */
 TVM_DLL const Op &sync_grid();
 
+/*!
+ * \brief Rank of the current CTA in its thread block cluster
+ *
+ * cluster_rank()
+ *
+ */
+TVM_DLL const Op &cluster_rank();
+
+/*!
+ * \brief Synchronize all threads in a thread block cluster
+ *
+ * cluster_sync()
+ *
+ */
+TVM_DLL const Op &cluster_sync();
+
 /*!
  * \brief Synchronize all threads in a warp
  *
@@ -478,6 +727,32 @@ TVM_DLL const Op &pdl_sync();
  */
 TVM_DLL const Op &loop_break();
 
+/*!
+ * \brief Base of a symmetric tensor on another rank of the node
+ *
+ * symm_remote_ptr(base, peer)
+ *
+ */
+TVM_DLL const Op &symm_remote_ptr();
+
+/*!
+ * \brief Set or add to a signal of a rank once the block is past its writes
+ *
+ * symm_signal(addr, value, op, leader[, barrier_id, thread_count])
+ *
+ * The optional named barrier synchronizes only the threads of a warp
+ * specialized role instead of the block.
+ */
+TVM_DLL const Op &symm_signal();
+
+/*!
+ * \brief Block until a local signal compares to a value
+ *
+ * symm_wait(addr, value, cmp, leader[, barrier_id, thread_count])
+ *
+ */
+TVM_DLL const Op &symm_wait();
+
 /*!
  * \brief tvm intrinsic for amd matrix core mfma instructions.
  *
@@ -505,6 +780,9 @@ TVM_DLL const Op &tvm_mfma_store();
 /*!
  * \brief tvm intrinsic for amd rdna matrix core instructions.
  *
+ *  The shape is the suffix of the wave32 builtin, e.g. f32_16x16x16_f16_w32
+ *  on RDNA3 or f32_16x16x16_f16_w32_gfx12 on RDNA4.
+ *
  *  void tvm_rdna_wmma(StringImm shape, StringImm A_layout, StringImm B_layout,
  *               StringImm A_dtype, StringImm B_dtype, StringImm C_dtype,
  *               Var multiplicand_a, Expr a_index,
@@ -613,6 +891,14 @@ TVM_DLL const Op &atomic_addx2_elem_op();
  */
 TVM_DLL const Op &atomic_addx4_elem_op();
 
+/*!
+ * \brief tilelang intrinsic for vectorized (x8) atomic addition.
+ *
+ *  This op is used to represent a vectorized atomic add operation on 8
+ * 16-bit floating point elements (128 bits) in tilelang.
+ */
+TVM_DLL const Op &atomic_addx8_elem_op();
+
 /*!
  * \brief tilelang intrinsic for atomic load.
  *
@@ -670,9 +956,44 @@ TVM_DLL const Op &device_assert();
  * \brief tilelang intrinsic for assert on device with additional message.
  *
  *  This op is used to represent an assert on device with additional message.
+ *
+ *  Both asserts follow kDeviceAssertMode: "thread" (the default) checks every
+ *  thread on its own, "warp" votes the condition across the active lanes so
+ *  that a failing warp reports once, and "off" compiles them out, condition
+ *  included.
  */
 TVM_DLL const Op &device_assert_with_msg();
 
+/*!
+ * \brief tilelang intrinsic marking the start of a profile region.
+ *
+ *  profile_begin(buffer_ptr, capacity, region_id)
+ *
+ *  Records globaltimer/clock64 of the calling warp into the profile ring
+ *  buffer of `capacity` records. Lowered to nothing unless
+ *  kEnableProfileRegion is set.
+ */
+TVM_DLL const Op &profile_begin();
+
+/*!
+ * \brief tilelang intrinsic marking the end of a profile region.
+ *
+ *  profile_end(buffer_ptr, capacity, region_id)
+ */
+TVM_DLL const Op &profile_end();
+
+/*!
+ * \brief tilelang intrinsic appending a record to the device log.
+ *
+ *  device_log(buffer_ptr, capacity, log_id, value...)
+ *
+ *  Writes {log_id, blockIdx, threadIdx, values} of the calling thread into
+ *  the log ring buffer of `capacity` records, reserving the slots of the
+ *  active lanes of a warp with one atomic. At most 4 int64/uint64/float64
+ *  values. Lowered to nothing unless kEnableDeviceLog is set.
+ */
+TVM_DLL const Op &device_log();
+
 /*!
  * \brief tilelang intrinsic for warp reduction sum.
  */
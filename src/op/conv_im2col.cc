@@ -0,0 +1,432 @@
+/*!
+ * \file tl/op/conv_im2col.cc
+ *
+ * Define the im2col operator feeding the implicit GEMMs of convolutions.
+ */
+
+#include "conv_im2col.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+
+#include "../layout/layout.h"
+#include "../target/utils.h"
+#include "../transform/common/loop_fusion_utils.h"
+#include "../transform/loop_partition.h"
+#include "../transform/loop_vectorize.h"
+#include "builtin.h"
+#include "copy.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+// Fixed arguments before the per spatial dimension ones.
+static constexpr int kNumFixedArgs = 8;
+// Per spatial dimension arguments: kernel, stride, dilation, padding,
+// input_shape and phase.
+static constexpr int kNumSpatialArgs = 6;
+
+/**
+ * @brief Construct a ConvIm2ColOp operator from call arguments.
+ *
+ * @param args Call arguments: [src_region, dst_region, pixel_step, k_step,
+ * groups, group, mode, eviction_policy], then the kernel, stride, dilation,
+ * padding, input_shape and phase of every spatial dimension, one array after
+ * the other.
+ */
+ConvIm2ColOp::ConvIm2ColOp(Array<PrimExpr> args,
+                           Map<String, ObjectRef> annotations) {
+  ObjectPtr<ConvIm2ColOpNode> node = tvm::ffi::make_object<ConvIm2ColOpNode>();
+  BufferRegion src = NormalizeToBufferRegion(args[0]);
+  BufferRegion dst = NormalizeToBufferRegion(args[1]);
+  node->src = src->buffer;
+  node->dst = dst->buffer;
+  node->dst_range = dst->region;
+  node->pixel_step = args[2];
+  node->k_step = args[3];
+  node->groups = Downcast<IntImm>(args[4])->value;
+  node->group = args[5];
+  node->mode = static_cast<ConvIm2ColMode>(Downcast<IntImm>(args[6])->value);
+  node->eviction_policy = Downcast<IntImm>(args[7])->value;
+  int spatial_dims = static_cast<int>(node->src->shape.size()) - 2;
+  ICHECK(spatial_dims >= 1 && spatial_dims <= 3)
+      << "T.conv_im2col expects a channels-last source with 1 to 3 spatial "
+         "dimensions, got `"
+      << node->src->name << "` of shape " << node->src->shape;
+  ICHECK_EQ(static_cast<int>(args.size()),
+            kNumFixedArgs + kNumSpatialArgs * spatial_dims)
+      << "T.conv_im2col expects the convolution parameters of "
+      << spatial_dims << " spatial dimensions";
+  auto spatial_arg = [&](int which, int i) {
+    return args[kNumFixedArgs + which * spatial_dims + i];
+  };
+  for (int i = 0; i < spatial_dims; i++) {
+    node->kernel.push_back(Downcast<IntImm>(spatial_arg(0, i)));
+    node->stride.push_back(Downcast<IntImm>(spatial_arg(1, i)));
+    node->dilation.push_back(Downcast<IntImm>(spatial_arg(2, i)));
+    node->padding.push_back(Downcast<IntImm>(spatial_arg(3, i)));
+    node->input_shape.push_back(spatial_arg(4, i));
+    node->phase.push_back(spatial_arg(5, i));
+    ICHECK(node->kernel[i]->value > 0 && node->stride[i]->value > 0 &&
+           node->dilation[i]->value > 0 && node->padding[i]->value >= 0)
+        << "T.conv_im2col got an invalid kernel " << node->kernel
+        << ", stride " << node->stride << ", dilation " << node->dilation
+        << " or padding " << node->padding;
+    if (node->mode == ConvIm2ColMode::kDgradPhase) {
+      ICHECK_EQ(node->dilation[i]->value, 1)
+          << "T.conv_im2col decomposes dgrad per phase without dilation only";
+    }
+  }
+  ICHECK(IsGlobalBuffer(node->src))
+      << "T.conv_im2col expects a global source, got `" << node->src->name
+      << "` in scope " << node->src.scope();
+  ICHECK_GE(node->dst_range.size(), 2)
+      << "T.conv_im2col expects a 2D destination tile, got `"
+      << node->dst->name << "` of shape " << node->dst->shape;
+  ICHECK_GE(node->groups, 1);
+  if (const auto *channels = as_const_int(node->src->shape.back())) {
+    ICHECK_EQ(*channels % node->groups, 0)
+        << "T.conv_im2col: " << node->groups << " groups do not divide the "
+        << *channels << " channels of `" << node->src->name << "`";
+  }
+  data_ = std::move(node);
+}
+
+TileOperator ConvIm2ColOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<ConvIm2ColOpNode>(*this);
+  if (par_op_.defined()) {
+    op->par_op_ = Downcast<ParallelOp>(par_op_->Clone());
+  }
+  return ConvIm2ColOp(op);
+}
+
+Array<PrimExpr> ConvIm2ColOpNode::PixelShape() const {
+  DataType dtype = pixel_step.dtype();
+  Array<PrimExpr> shape;
+  for (int i = 0; i < SpatialDims(); i++) {
+    int k = kernel[i]->value, s = stride[i]->value;
+    int d = dilation[i]->value, p = padding[i]->value;
+    if (mode == ConvIm2ColMode::kForward) {
+      PrimExpr extent = cast(dtype, src->shape[i + 1]);
+      shape.push_back(floordiv(extent + (2 * p - d * (k - 1) - 1), s) + 1);
+    } else if (mode == ConvIm2ColMode::kDgrad) {
+      shape.push_back(cast(dtype, input_shape[i]));
+    } else {
+      PrimExpr extent = cast(dtype, input_shape[i]) - cast(dtype, phase[i]);
+      shape.push_back(floordiv(extent + (s - 1), s));
+    }
+  }
+  return shape;
+}
+
+Array<PrimExpr> ConvIm2ColOpNode::TapShape() const {
+  DataType dtype = pixel_step.dtype();
+  Array<PrimExpr> shape;
+  for (int i = 0; i < SpatialDims(); i++) {
+    int k = kernel[i]->value, s = stride[i]->value;
+    if (mode != ConvIm2ColMode::kDgradPhase) {
+      shape.push_back(make_const(dtype, k));
+      continue;
+    }
+    int p = padding[i]->value;
+    PrimExpr first = floormod(cast(dtype, phase[i]) + p, s);
+    shape.push_back(floordiv(make_const(dtype, k + s - 1) - first, s));
+  }
+  return shape;
+}
+
+PrimExpr ConvIm2ColOpNode::Im2ColValue(PrimExpr row, PrimExpr col,
+                                       arith::Analyzer *analyzer) const {
+  DataType dtype = row.dtype();
+  int spatial_dims = SpatialDims();
+  Array<PrimExpr> pixel_shape = PixelShape();
+  Array<PrimExpr> tap_shape = TapShape();
+  PrimExpr channels = cast(dtype, src->shape.back());
+  PrimExpr group_channels = floordiv(channels, groups);
+
+  // Decompose the row into the batch and the pixel, the column into the tap
+  // and the channel, the last dimensions innermost.
+  std::vector<PrimExpr> pixel(spatial_dims), tap(spatial_dims);
+  PrimExpr rest = row;
+  PrimExpr tap_rest = floordiv(col, group_channels);
+  PrimExpr num_taps = make_const(dtype, 1);
+  for (int i = spatial_dims - 1; i >= 0; i--) {
+    pixel[i] = floormod(rest, pixel_shape[i]);
+    rest = floordiv(rest, pixel_shape[i]);
+    tap[i] = floormod(tap_rest, tap_shape[i]);
+    tap_rest = floordiv(tap_rest, tap_shape[i]);
+    num_taps = num_taps * tap_shape[i];
+  }
+  PrimExpr valid = rest < cast(dtype, src->shape[0]) &&
+                   floordiv(col, group_channels) < num_taps;
+
+  Array<PrimExpr> indices{rest};
+  for (int i = 0; i < spatial_dims; i++) {
+    int s = stride[i]->value, d = dilation[i]->value;
+    int p = padding[i]->value;
+    PrimExpr extent = cast(dtype, src->shape[i + 1]);
+    PrimExpr index;
+    if (mode == ConvIm2ColMode::kForward) {
+      index = pixel[i] * s - p + tap[i] * d;
+    } else if (mode == ConvIm2ColMode::kDgrad) {
+      PrimExpr numerator = pixel[i] + p - tap[i] * d;
+      if (s > 1) {
+        valid = valid && floormod(numerator, s) == 0;
+      }
+      index = floordiv(numerator, s);
+    } else {
+      PrimExpr ph = cast(dtype, phase[i]);
+      PrimExpr first = floormod(ph + p, s);
+      index = floordiv(ph + p - first, s) + pixel[i] - tap[i];
+    }
+    valid = valid && index >= 0 && index < extent;
+    indices.push_back(index);
+  }
+  indices.push_back(cast(dtype, group) * group_channels +
+                    floormod(col, group_channels));
+  indices = indices.Map([&](const PrimExpr &e) {
+    return cast(src->shape[0].dtype(), analyzer->Simplify(e));
+  });
+
+  PrimExpr value = BufferLoad(src, indices);
+  if (src->dtype != dst->dtype)
+    value = Cast(dst->dtype, value);
+  return if_then_else(analyzer->Simplify(valid), value,
+                      make_zero(dst->dtype));
+}
+
+For ConvIm2ColOpNode::MakeSIMTLoop(arith::Analyzer *analyzer) const {
+  size_t ndim = dst_range.size();
+  const Range &rows = dst_range[ndim - 2];
+  const Range &cols = dst_range[ndim - 1];
+  DataType dtype = pixel_step.dtype();
+  Var i("i", rows->extent.dtype()), j("j", cols->extent.dtype());
+  analyzer->Bind(i, Range(0, rows->extent));
+  analyzer->Bind(j, Range(0, cols->extent));
+
+  Array<PrimExpr> dst_indices;
+  for (size_t d = 0; d + 2 < ndim; d++) {
+    dst_indices.push_back(dst_range[d]->min);
+  }
+  dst_indices.push_back(rows->min + i);
+  dst_indices.push_back(cols->min + j);
+  PrimExpr row = pixel_step * cast(dtype, rows->extent) + cast(dtype, i);
+  PrimExpr col =
+      cast(dtype, k_step) * cast(dtype, cols->extent) + cast(dtype, j);
+  Stmt body = BufferStore(dst, Im2ColValue(row, col, analyzer), dst_indices);
+  body = For(j, 0, cols->extent, ForKind::kParallel, body);
+  return For(i, 0, rows->extent, ForKind::kParallel, body);
+}
+
+// TMA im2col loads cover forward tiles of a whole 2D shared buffer whose
+// channel box stays within a group, on a bounding box the corner ranges of
+// the tensor rank can describe.
+bool ConvIm2ColOpNode::CheckTMAIm2Col(Target target,
+                                      arith::Analyzer *analyzer) const {
+  if (mode != ConvIm2ColMode::kForward || !TargetHasBulkCopy(target) ||
+      !IsSharedBuffer(dst) || src->dtype != dst->dtype)
+    return false;
+  if (tvm::transform::PassContext::Current()
+          ->GetConfig<Bool>(kDisableTMALower, Bool(false))
+          .value())
+    return false;
+  if (dst->shape.size() != 2 || !is_zero(dst_range[0]->min) ||
+      !is_zero(dst_range[1]->min) ||
+      !analyzer->CanProveEqual(dst_range[0]->extent, dst->shape[0]) ||
+      !analyzer->CanProveEqual(dst_range[1]->extent, dst->shape[1]))
+    return false;
+  if (!src->strides.empty() && !is_one(src->strides.back()))
+    return false;
+  const auto *pixels = as_const_int(dst->shape[0]);
+  const auto *channels = as_const_int(dst->shape[1]);
+  if (pixels == nullptr || channels == nullptr || *pixels > 1024 ||
+      *channels > 256 || (*channels * src->dtype.bytes()) % 16 != 0)
+    return false;
+  int box_channels = static_cast<int>(*channels);
+  PrimExpr group_channels = floordiv(src->shape.back(), groups);
+  if (!analyzer->CanProveEqual(floormod(group_channels, box_channels), 0))
+    return false;
+  // Signed bits of the bounding box corners for tensors of rank 3, 4 and 5
+  static constexpr int kCornerBits[] = {16, 8, 5};
+  int64_t corner_bound = int64_t{1} << (kCornerBits[SpatialDims() - 1] - 1);
+  for (int i = 0; i < SpatialDims(); i++) {
+    int64_t lower = -padding[i]->value;
+    int64_t upper = padding[i]->value -
+                    dilation[i]->value * (kernel[i]->value - 1);
+    for (int64_t corner : {lower, upper}) {
+      if (corner < -corner_bound || corner >= corner_bound)
+        return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Lower to one TMA im2col load of the whole tile.
+ *
+ * The bounding box of the pixels spans the padded input minus the kernel
+ * footprint, `[-p, p - d * (k - 1)]` relative to the input, traversed with
+ * the convolution stride; the tap selects the offset into the box. Shared
+ * layouts other than the bank swizzles fall back to the SIMT loop.
+ */
+Stmt ConvIm2ColOpNode::LowerTMA(const LowerArgs &T,
+                                arith::Analyzer *analyzer) const {
+  int spatial_dims = SpatialDims();
+  Buffer shared_tensor = dst;
+  int swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_NONE);
+  if (T.layout_map.count(dst)) {
+    Layout layout = T.layout_map.at(dst);
+    shared_tensor = T.buffer_remap.at(dst);
+    int rows = *as_const_int(dst->shape[0]);
+    int continuous = *as_const_int(dst->shape[1]);
+    int bits = dst->dtype.bits();
+    if (StructuralEqual()(layout, makeLinearLayout(dst->shape))) {
+      swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_NONE);
+    } else if (StructuralEqual()(layout, makeQuarterBankSwizzleLayout(
+                                             rows, continuous, bits))) {
+      swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_32B);
+    } else if (StructuralEqual()(layout, makeHalfBankSwizzleLayout(
+                                             rows, continuous, bits))) {
+      swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_64B);
+    } else if (StructuralEqual()(layout, makeFullBankSwizzleLayout(
+                                             rows, continuous, bits))) {
+      swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_128B);
+    } else {
+      return LowerNormal(T, analyzer);
+    }
+  }
+
+  TMAIm2ColDesc desc;
+  desc.rank = src->shape.size();
+  desc.data_type = to_CUtensorMapDataType(src->dtype);
+  desc.global_addr = src->data;
+  desc.global_shape = ReverseArray(src->shape);
+  if (!src->strides.empty()) {
+    desc.global_stride = ReverseArray(src->strides);
+  } else {
+    PrimExpr elements = 1;
+    for (size_t i = 0; i < desc.rank; i++) {
+      desc.global_stride.push_back(elements);
+      elements *= desc.global_shape[i];
+    }
+  }
+  desc.global_stride = desc.global_stride.Map([&](PrimExpr e) {
+    return cast(DataType::Int(64), e) * src->dtype.bytes();
+  });
+  // Spatial dimensions in w, h, d order
+  desc.elem_stride.push_back(1);
+  for (int i = spatial_dims - 1; i >= 0; i--) {
+    int64_t p = padding[i]->value;
+    desc.elem_stride.push_back(stride[i]);
+    desc.lower_corner.push_back(static_cast<int>(-p));
+    desc.upper_corner.push_back(static_cast<int>(
+        p - dilation[i]->value * (kernel[i]->value - 1)));
+  }
+  desc.elem_stride.push_back(1);
+  desc.smem_box_pixel = *as_const_int(dst->shape[0]);
+  desc.smem_box_channel = *as_const_int(dst->shape[1]);
+  desc.l2_promotion = static_cast<int>(CU_TENSOR_MAP_L2_PROMOTION_L2_128B);
+  desc.oob_fill = static_cast<int>(CU_TENSOR_MAP_FLOAT_OOB_FILL_NONE);
+  desc.interleave = static_cast<int>(CU_TENSOR_MAP_INTERLEAVE_NONE);
+  desc.swizzle = swizzle;
+  Call create_desc = Call(DataType::Handle(), create_tma_im2col_descriptor(),
+                          desc.EncodeCallArgs());
+
+  DataType dtype = pixel_step.dtype();
+  Array<PrimExpr> pixel_shape = PixelShape();
+  PrimExpr group_channels = cast(dtype, floordiv(src->shape.back(), groups));
+  PrimExpr col = cast(dtype, k_step) * desc.smem_box_channel;
+  PrimExpr row = pixel_step * desc.smem_box_pixel;
+  PrimExpr tap = floordiv(col, group_channels);
+  Array<PrimExpr> coords{cast(dtype, group) * group_channels +
+                         floormod(col, group_channels)};
+  Array<PrimExpr> offsets;
+  for (int i = spatial_dims - 1; i >= 0; i--) {
+    int k = kernel[i]->value, s = stride[i]->value;
+    int d = dilation[i]->value, p = padding[i]->value;
+    coords.push_back(floormod(row, pixel_shape[i]) * s - p);
+    row = floordiv(row, pixel_shape[i]);
+    offsets.push_back(floormod(tap, k) * d);
+    tap = floordiv(tap, k);
+  }
+  coords.push_back(row);
+
+  Array<PrimExpr> args{create_desc, 0, shared_tensor.access_ptr(2)};
+  for (const PrimExpr &coord : coords)
+    args.push_back(analyzer->Simplify(coord));
+  for (const PrimExpr &offset : offsets)
+    args.push_back(analyzer->Simplify(offset));
+  args.push_back(eviction_policy);
+  return IfThenElse(
+      EQ(T.thread_var, T.thread_bounds->min),
+      Evaluate(Call(DataType::Handle(), tma_load_im2col(), args)));
+}
+
+Stmt ConvIm2ColOpNode::LowerNormal(const LowerArgs &T,
+                                   arith::Analyzer *analyzer) const {
+  auto simt_loop = MakeSIMTLoop(analyzer);
+  auto fused_loop = Downcast<For>(ParallelLoopFuser::Fuse(simt_loop));
+  if (T.target->GetTargetDeviceType() == kDLCPU || IsLocalBuffer(dst)) {
+    return VectorizeLoop(fused_loop, T.layout_map);
+  }
+  auto par_op = ParallelOp(fused_loop);
+  for (auto level :
+       {InferLevel::kCommon, InferLevel::kStrict, InferLevel::kFree}) {
+    par_op->InferLayout({T.target,
+                         T.thread_bounds,
+                         T.layout_map,
+                         analyzer,
+                         false,
+                         T.buffer_remap,
+                         {}},
+                        level);
+  }
+  return LowerParallelLoop(par_op->GetRoot(), par_op->GetLoopLayout(),
+                           T.thread_var, analyzer, T.layout_map,
+                           par_op->GetPredicate(T.thread_var));
+}
+
+/**
+ * @brief Lower the im2col load.
+ *
+ * Forward tiles on targets with bulk copies issue one TMA im2col load
+ * completed through the mbarrier of the pipeline. Other cases, dgrad tiles
+ * among them, lower to a SIMT loop storing `if_then_else(valid, src, 0)`
+ * along the channels, which the pipeline turns into predicated cp.async
+ * loads on sm80+.
+ */
+Stmt ConvIm2ColOpNode::Lower(const LowerArgs &T,
+                             arith::Analyzer *analyzer) const {
+  if (CheckTMAIm2Col(T.target, analyzer)) {
+    return LowerTMA(T, analyzer);
+  }
+  return LowerNormal(T, analyzer);
+}
+
+// Layouts follow T.copy: a TMA load leaves the shared layout to its consumer,
+// a SIMT loop infers its loop layout through ParallelOp.
+LayoutMap ConvIm2ColOpNode::InferLayout(const LayoutInferArgs &T,
+                                        InferLevel level) const {
+  if (CheckTMAIm2Col(T.target, T.analyzer)) {
+    return {};
+  }
+  if (!par_op_.defined()) {
+    arith::Analyzer analyzer;
+    par_op_ = ParallelOp(MakeSIMTLoop(&analyzer));
+  }
+  return par_op_->InferLayout(T, level);
+}
+
+TIR_REGISTER_TL_TILE_OP(ConvIm2ColOp, conv_im2col)
+    .set_num_inputs(-1)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() { ConvIm2ColOpNode::RegisterReflection(); }
+
+} // namespace tl
+} // namespace tvm
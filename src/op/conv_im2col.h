@@ -0,0 +1,126 @@
+/*!
+ * \file tl/op/conv_im2col.h
+ * \brief Implicit-GEMM tiles of convolutions: im2col loads of an activation
+ */
+
+#ifndef TVM_TL_OP_CONV_IM2COL_H_
+#define TVM_TL_OP_CONV_IM2COL_H_
+
+#include "operator.h"
+#include "parallel.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Which convolution GEMM the tile feeds
+enum class ConvIm2ColMode : uint8_t {
+  kForward = 0,     ///< fprop, and wgrad through the transposed tile
+  kDgrad = 1,       ///< dgrad, gathering the output gradient per input pixel
+  kDgradPhase = 2,  ///< dgrad restricted to the input pixels of one phase
+};
+
+/*!
+ * \brief Node class for im2col loads of a channels-last activation.
+ *
+ * `src` is `[N, S_1, ..., S_R, C]` with R = 1, 2 or 3 spatial dimensions,
+ * `dst` a `[P, K]` tile of the im2col matrix. Row `m = pixel_step * P + i`
+ * enumerates the GEMM pixels, batch outermost and the last spatial dimension
+ * innermost. Column `q = k_step * K + j` enumerates `(tap, c)` with the
+ * channel `c` of the group innermost: `c = q % Cg` and `tap = q / Cg` with
+ * `Cg = C / groups`, the last kernel dimension innermost in `tap`. The tile
+ * reads channel `group * Cg + c` of `src`, so grouped and depthwise
+ * convolutions load one group at a time.
+ *
+ * - kForward: the pixels are the outputs `o`, reading `o * s - p + kp * d`.
+ *   The wgrad GEMM consumes the same tile with the pixels as reduction.
+ * - kDgrad: `src` is the output gradient and the pixels the inputs `x` of
+ *   `input_shape`, reading `(x + p - kp * d) / s` where it divides exactly.
+ * - kDgradPhase: strided dgrad decomposed per phase `ph` of the stride, with
+ *   `d = 1`. The pixels are the inputs `x = ph + s * x'`, and only the taps
+ *   `kp = r + s * t` with `r = (ph + p) % s` contribute, so every load hits:
+ *   tap `t` of the `ceildiv(k - r, s)` per dimension reads
+ *   `(ph + p - r) / s + x' - t`.
+ *
+ * Out-of-bounds pixels, taps and channels read as zero.
+ */
+class ConvIm2ColOpNode : public TileOperatorNode {
+public:
+  tir::Buffer src;        ///< Global channels-last activation
+  tir::Buffer dst;        ///< Destination tile of the im2col matrix
+  Array<Range> dst_range; ///< Destination region, the last two dims the tile
+  PrimExpr pixel_step;    ///< Row tile of the im2col matrix
+  PrimExpr k_step;        ///< Column tile of the im2col matrix
+  int groups;             ///< Channel groups of the convolution
+  PrimExpr group;         ///< Group the tile loads
+  ConvIm2ColMode mode;    ///< Convolution GEMM the tile feeds
+  int eviction_policy;    ///< Cache eviction policy of the TMA loads
+  Array<Integer> kernel, stride, dilation, padding; ///< Per spatial dim
+  Array<PrimExpr> input_shape; ///< Spatial input shape, dgrad modes only
+  Array<PrimExpr> phase;       ///< Stride phase, kDgradPhase only
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.ConvIm2Col", ConvIm2ColOpNode,
+                                    TileOperatorNode);
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  LayoutMap InferLayout(const LayoutInferArgs &T, InferLevel level) const;
+  static const Op &Get();
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<ConvIm2ColOpNode>()
+        .def_ro("src", &ConvIm2ColOpNode::src)
+        .def_ro("dst", &ConvIm2ColOpNode::dst)
+        .def_ro("dst_range", &ConvIm2ColOpNode::dst_range)
+        .def_ro("pixel_step", &ConvIm2ColOpNode::pixel_step)
+        .def_ro("k_step", &ConvIm2ColOpNode::k_step)
+        .def_ro("groups", &ConvIm2ColOpNode::groups)
+        .def_ro("group", &ConvIm2ColOpNode::group)
+        .def_ro("eviction_policy", &ConvIm2ColOpNode::eviction_policy)
+        .def_ro("kernel", &ConvIm2ColOpNode::kernel)
+        .def_ro("stride", &ConvIm2ColOpNode::stride)
+        .def_ro("dilation", &ConvIm2ColOpNode::dilation)
+        .def_ro("padding", &ConvIm2ColOpNode::padding)
+        .def_ro("input_shape", &ConvIm2ColOpNode::input_shape)
+        .def_ro("phase", &ConvIm2ColOpNode::phase);
+  }
+
+  TileOperator Clone() const;
+
+private:
+  /// Number of spatial dimensions
+  int SpatialDims() const { return static_cast<int>(kernel.size()); }
+  /// Extents of the pixel dimensions the rows enumerate, spatial dims only
+  Array<PrimExpr> PixelShape() const;
+  /// Kernel taps per spatial dimension
+  Array<PrimExpr> TapShape() const;
+  /// The source element of im2col entry (row, col), zero if out of bounds
+  PrimExpr Im2ColValue(PrimExpr row, PrimExpr col,
+                       arith::Analyzer *analyzer) const;
+  /// Create SIMT-style parallel loop for the tile
+  For MakeSIMTLoop(arith::Analyzer *analyzer) const;
+  /// Whether the tile can use TMA im2col loads, independent of the layout
+  bool CheckTMAIm2Col(Target target, arith::Analyzer *analyzer) const;
+  /// Lower to one TMA im2col load, falling back to the SIMT loop
+  Stmt LowerTMA(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  /// Lower to a partitioned and vectorized SIMT loop
+  Stmt LowerNormal(const LowerArgs &T, arith::Analyzer *analyzer) const;
+
+  mutable ParallelOp par_op_; // Layout inference of the SIMT loop
+};
+
+/// Wrapper class for im2col loads
+class ConvIm2ColOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(ConvIm2ColOp, TileOperator,
+                                             ConvIm2ColOpNode);
+  TVM_DLL
+  ConvIm2ColOp(Array<PrimExpr> args,
+               Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_CONV_IM2COL_H_
@@ -0,0 +1,303 @@
+/*!
+ * \file tl/op/convert_layout.cc
+ * \brief Implementation of the fragment layout conversion operator
+ */
+
+#include "convert_layout.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+
+#include "../layout/layout.h"
+#include "../target/utils.h"
+#include "../transform/loop_partition.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+ConvertLayoutOp::ConvertLayoutOp(Array<PrimExpr> args,
+                                 Map<String, ObjectRef> annotations) {
+  /// ConvertLayout constructor arguments:
+  /// - src: fragment read
+  /// - dst: fragment written, of the shape of src
+  CHECK_EQ(args.size(), 2);
+  ObjectPtr<ConvertLayoutOpNode> node =
+      tvm::ffi::make_object<ConvertLayoutOpNode>();
+  node->srcRegion_ = NormalizeToBufferRegion(args[0]);
+  node->dstRegion_ = NormalizeToBufferRegion(args[1]);
+  node->src = node->srcRegion_->buffer;
+  node->dst = node->dstRegion_->buffer;
+
+  const Buffer &src = node->src, &dst = node->dst;
+  ICHECK(IsFragmentBuffer(src) && IsFragmentBuffer(dst))
+      << "T.convert_layout expects fragments, got " << src->name << " in "
+      << src.scope() << " and " << dst->name << " in " << dst.scope();
+  ICHECK(RegionHasShape(node->srcRegion_, src->shape) &&
+         RegionHasShape(node->dstRegion_, dst->shape))
+      << "T.convert_layout converts whole fragments, got regions of "
+      << src->name << " and " << dst->name;
+  ICHECK_EQ(src->shape.size(), dst->shape.size())
+      << "T.convert_layout expects fragments of the same shape, got "
+      << src->shape << " and " << dst->shape;
+  for (size_t d = 0; d < src->shape.size(); ++d) {
+    const int64_t *p_src = as_const_int(src->shape[d]);
+    const int64_t *p_dst = as_const_int(dst->shape[d]);
+    ICHECK(p_src && p_dst && *p_src == *p_dst)
+        << "T.convert_layout expects fragments of the same static shape, got "
+        << src->shape << " and " << dst->shape;
+  }
+  data_ = std::move(node);
+}
+
+TileOperator ConvertLayoutOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<ConvertLayoutOpNode>(*this);
+  return ConvertLayoutOp(op);
+}
+
+For ConvertLayoutOpNode::MakeElementwiseLoop(
+    const std::function<Stmt(const Array<PrimExpr> &)> &body) const {
+  Array<Var> vars;
+  for (size_t d = 0; d < src->shape.size(); ++d) {
+    vars.push_back(Var(std::string(1, static_cast<char>('i' + d))));
+  }
+  Stmt loop = body(Array<PrimExpr>(vars.begin(), vars.end()));
+  for (int d = static_cast<int>(vars.size()) - 1; d >= 0; --d) {
+    loop = For(vars[d], 0, src->shape[d], ForKind::kParallel, loop);
+  }
+  return Downcast<For>(loop);
+}
+
+/// Logical indices of the element of `dst_layout` at `locals` of `thread`
+static Array<PrimExpr> DstElement(const Layout &inverse,
+                                  const Array<PrimExpr> &locals,
+                                  const PrimExpr &thread, size_t ndim) {
+  Array<PrimExpr> args = locals;
+  args.push_back(thread);
+  Array<PrimExpr> indices = inverse->Forward(args);
+  return Array<PrimExpr>(indices.begin(), indices.begin() + ndim);
+}
+
+ConvertLayoutEnum ConvertLayoutOpNode::Classify(const Fragment &src_layout,
+                                                const Fragment &dst_layout,
+                                                int warp_size) const {
+  if (src_layout->IsEqual(dst_layout.get()))
+    return ConvertLayoutEnum::kRegister;
+  // Walking the elements of a thread needs the inverse of dst
+  auto [inverse, level] = dst_layout->InverseWithLevel();
+  if (level != arith::IterMapLevel::Bijective)
+    return ConvertLayoutEnum::kShared;
+  arith::Analyzer analyzer;
+  Array<PrimExpr> locals;
+  for (const PrimExpr &extent : dst_layout->OutputShape()) {
+    Var local("l" + std::to_string(locals.size()));
+    analyzer.Bind(local, Range(0, extent));
+    locals.push_back(local);
+  }
+  Var thread("thread"), other("other");
+  analyzer.Bind(thread, Range(0, dst_layout->ThreadExtent()));
+  analyzer.Bind(other, Range(0, dst_layout->ThreadExtent()));
+  size_t ndim = src->shape.size();
+  Array<PrimExpr> indices = DstElement(inverse, locals, thread, ndim);
+  PrimExpr src_thread =
+      src_layout->ForwardThread(indices, make_zero(thread.dtype()));
+  if (analyzer.CanProveEqual(src_thread, thread))
+    return ConvertLayoutEnum::kRegister;
+
+  // Every lane of a shuffle offers the element at the same local index
+  Array<PrimExpr> src_local = src_layout->Forward(indices);
+  Array<PrimExpr> other_local =
+      src_layout->Forward(DstElement(inverse, locals, other, ndim));
+  for (size_t k = 0; k < src_local.size(); ++k) {
+    if (!analyzer.CanProveEqual(src_local[k], other_local[k]))
+      return ConvertLayoutEnum::kShared;
+  }
+  if (!analyzer.CanProveEqual(floordiv(src_thread, warp_size),
+                              floordiv(thread, warp_size)))
+    return ConvertLayoutEnum::kShared;
+  return ConvertLayoutEnum::kShuffle;
+}
+
+Stmt ConvertLayoutOpNode::MakeWarpCopy(const LowerArgs &T,
+                                       const Fragment &src_layout,
+                                       const Fragment &dst_layout,
+                                       bool shuffle,
+                                       arith::Analyzer *analyzer) const {
+  Buffer src_buffer = T.buffer_remap.count(src) ? T.buffer_remap[src] : src;
+  Buffer dst_buffer = T.buffer_remap.count(dst) ? T.buffer_remap[dst] : dst;
+  Layout inverse = dst_layout->Inverse();
+  Array<PrimExpr> dst_shape = dst_layout->OutputShape();
+  Array<Var> local_vars;
+  for (size_t k = 0; k < dst_shape.size(); ++k) {
+    Var local("l" + std::to_string(k));
+    analyzer->Bind(local, Range(0, dst_shape[k]));
+    local_vars.push_back(local);
+  }
+  Array<PrimExpr> locals(local_vars.begin(), local_vars.end());
+  size_t ndim = src->shape.size();
+  auto simplify = [&](const Array<PrimExpr> &exprs) {
+    return exprs.Map([&](const PrimExpr &e) { return analyzer->Simplify(e); });
+  };
+  PrimExpr thread = T.thread_var - T.thread_bounds->min;
+  Array<PrimExpr> indices = DstElement(inverse, locals, thread, ndim);
+
+  PrimExpr value;
+  if (!shuffle && src_layout->IsEqual(dst_layout.get())) {
+    // Equal layouts need no inverse, which may not be bijective
+    value = BufferLoad(src_buffer, locals);
+  } else if (!shuffle) {
+    value = BufferLoad(src_buffer, simplify(src_layout->Forward(indices)));
+  } else {
+    // The local index does not depend on the lane, take the one of lane 0 so
+    // that it folds to a constant once the loops are unrolled
+    Array<PrimExpr> offered_local = src_layout->Forward(DstElement(
+        inverse, locals, make_zero(thread.dtype()), ndim));
+    PrimExpr offered = BufferLoad(src_buffer, simplify(offered_local));
+    PrimExpr lane = analyzer->Simplify(
+        src_layout->ForwardThread(indices, make_zero(thread.dtype())) +
+        T.thread_bounds->min);
+    if (TargetIsCuda(T.target)) {
+      value = Call(src->dtype, builtin::call_extern(),
+                   {StringImm("tl::shfl_sync"),
+                    make_const(DataType::UInt(32), 0xFFFFFFFF), offered,
+                    lane});
+    } else {
+      value = Call(src->dtype, builtin::call_extern(),
+                   {StringImm("tl::shfl"), offered, lane});
+    }
+  }
+  Stmt body = BufferStore(dst_buffer, cast(dst->dtype, value), locals);
+  for (int k = static_cast<int>(local_vars.size()) - 1; k >= 0; --k) {
+    body = For(local_vars[k], 0, dst_shape[k], ForKind::kUnrolled, body);
+  }
+  return body;
+}
+
+Stmt ConvertLayoutOpNode::MakeSharedCopy(const LowerArgs &T,
+                                         const Fragment &src_layout,
+                                         const Fragment &dst_layout,
+                                         arith::Analyzer *analyzer) const {
+  int64_t num_elems = 1;
+  for (const PrimExpr &extent : src->shape) {
+    num_elems *= *as_const_int(extent);
+  }
+  // T.AddWorkspace hands out an access pointer, view its data as a buffer
+  PrimExpr workspace =
+      T.AddWorkspace(static_cast<int>(num_elems), src->dtype);
+  const auto *access_ptr = workspace.as<CallNode>();
+  ICHECK(access_ptr && access_ptr->op.same_as(builtin::tvm_access_ptr()));
+  Buffer ws(Downcast<Var>(access_ptr->args[1]), src->dtype,
+            {IntImm(DataType::Int(32), num_elems)}, {}, PrimExpr(0),
+            src->name + "_exchange", 0, 0, BufferType::kDefault);
+  auto slot = [&](const Array<PrimExpr> &indices) {
+    PrimExpr flat = 0;
+    for (size_t d = 0; d < indices.size(); ++d) {
+      flat = flat * src->shape[d] + indices[d];
+    }
+    return flat;
+  };
+  For store = MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+    return BufferStore(ws, BufferLoad(src, indices), {slot(indices)});
+  });
+  For load = MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+    return BufferStore(dst, cast(dst->dtype, BufferLoad(ws, {slot(indices)})),
+                       indices);
+  });
+  // ThreadSync orders the accesses to the workspace
+  return SeqStmt({PartitionLoop(store, T.thread_var, analyzer, src_layout),
+                  PartitionLoop(load, T.thread_var, analyzer, dst_layout)});
+}
+
+/**
+ * @brief Lower the conversion after where the elements of dst live in src.
+ *
+ * When every thread already holds the elements it writes, they are copied
+ * between its registers. When each element comes from a lane of the same
+ * warp, and the local index it has in src is the same on every lane, the
+ * lanes exchange them with one full-warp shuffle per element, each lane
+ * offering its element at that local index. Otherwise, or when the threads
+ * do not form whole warps, src is written to shared memory and dst read
+ * back from it.
+ */
+Stmt ConvertLayoutOpNode::Lower(const LowerArgs &T,
+                                arith::Analyzer *analyzer) const {
+  Fragment src_layout = T.layout_map[src].as<Fragment>().value();
+  Fragment dst_layout = T.layout_map[dst].as<Fragment>().value();
+  int warp_size = TargetGetWarpSize(T.target);
+  const int64_t *p_min = as_const_int(T.thread_bounds->min);
+  const int64_t *p_extent = as_const_int(T.thread_bounds->extent);
+  // Full-mask shuffles need whole warps
+  bool whole_warps = (TargetIsCuda(T.target) || TargetIsRocm(T.target)) &&
+                     p_min && p_extent && *p_min % warp_size == 0 &&
+                     *p_extent % warp_size == 0;
+  ConvertLayoutEnum kind = Classify(src_layout, dst_layout, warp_size);
+  if (kind == ConvertLayoutEnum::kShuffle && !whole_warps)
+    kind = ConvertLayoutEnum::kShared;
+  switch (kind) {
+  case ConvertLayoutEnum::kRegister:
+    return MakeWarpCopy(T, src_layout, dst_layout, false, analyzer);
+  case ConvertLayoutEnum::kShuffle:
+    return MakeWarpCopy(T, src_layout, dst_layout, true, analyzer);
+  case ConvertLayoutEnum::kShared:
+    break;
+  }
+  return MakeSharedCopy(T, src_layout, dst_layout, analyzer);
+}
+
+/**
+ * @brief Infer the layouts of the fragments.
+ *
+ * The layouts given by other operators are kept, that is the point of the
+ * conversion. At the free level, a fragment without a layout takes the one
+ * of the other fragment, making the conversion a copy in registers, and two
+ * fragments without layouts are laid out as their elementwise loop would be
+ * partitioned.
+ */
+LayoutMap ConvertLayoutOpNode::InferLayout(const LayoutInferArgs &T,
+                                           InferLevel level) const {
+  if (level != InferLevel::kFree)
+    return {};
+  bool has_src = T.layout_map.count(src), has_dst = T.layout_map.count(dst);
+  if (has_src && has_dst)
+    return {};
+  LayoutMap result_map;
+  if (has_src) {
+    result_map.Set(dst, T.layout_map[src]);
+    return result_map;
+  }
+  if (has_dst) {
+    result_map.Set(src, T.layout_map[dst]);
+    return result_map;
+  }
+  For loop = MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+    return BufferStore(dst, BufferLoad(src, indices), indices);
+  });
+  int vector_size = 16 / src->dtype.bytes();
+  PrimExpr num_elems = 1;
+  for (const PrimExpr &extent : src->shape) {
+    num_elems = num_elems * extent;
+  }
+  while (vector_size > 1 &&
+         !T.analyzer->CanProve(
+             floormod(num_elems, T.thread_bounds->extent * vector_size) ==
+             0)) {
+    vector_size /= 2;
+  }
+  Fragment layout = PlanLoopPartition(loop, vector_size, T.thread_bounds);
+  result_map.Set(src, layout);
+  result_map.Set(dst, layout);
+  return result_map;
+}
+
+TIR_REGISTER_TL_TILE_OP(ConvertLayoutOp, convert_layout)
+    .set_num_inputs(2)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() { ConvertLayoutOpNode::RegisterReflection(); }
+
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,87 @@
+/*!
+ * \file tl/op/convert_layout.h
+ * \brief Conversion of a fragment into a fragment of another layout
+ */
+
+#ifndef TVM_TL_OP_CONVERT_LAYOUT_H_
+#define TVM_TL_OP_CONVERT_LAYOUT_H_
+
+#include "operator.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// How the elements of the destination reach their threads
+enum class ConvertLayoutEnum : uint8_t {
+  kRegister, ///< Every element is already held by its thread
+  kShuffle,  ///< Every element comes from a lane of the same warp
+  kShared,   ///< The elements are exchanged through shared memory
+};
+
+/*!
+ * \brief Node class copying a fragment into a fragment of another layout.
+ *
+ * Each operand keeps the layout its other users give it, e.g. the
+ * accumulator layout of a gemm for `src` and the operand layout of the next
+ * gemm for `dst`, instead of both having to agree on one. The copy is
+ * lowered after where the element a thread writes lives in `src`: in the
+ * same thread, in a lane of the same warp at a local index that does not
+ * depend on the lane, which one shuffle per element fetches, or elsewhere,
+ * in which case the fragment goes through shared memory.
+ */
+class ConvertLayoutOpNode : public TileOperatorNode {
+public:
+  tir::Buffer src, dst;
+  BufferRegion srcRegion_, dstRegion_;
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.ConvertLayoutOp", ConvertLayoutOpNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<ConvertLayoutOpNode>()
+        .def_ro("src", &ConvertLayoutOpNode::src)
+        .def_ro("dst", &ConvertLayoutOpNode::dst)
+        .def_ro("srcRegion", &ConvertLayoutOpNode::srcRegion_)
+        .def_ro("dstRegion", &ConvertLayoutOpNode::dstRegion_);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+
+private:
+  /// Parallel loop nest over the elements of the fragments
+  For MakeElementwiseLoop(
+      const std::function<Stmt(const Array<PrimExpr> &)> &body) const;
+  /// Where the elements of `dst_layout` live in `src_layout`
+  ConvertLayoutEnum Classify(const Fragment &src_layout,
+                             const Fragment &dst_layout, int warp_size) const;
+  /// Copy within the threads, or through one shuffle per element
+  Stmt MakeWarpCopy(const LowerArgs &T, const Fragment &src_layout,
+                    const Fragment &dst_layout, bool shuffle,
+                    arith::Analyzer *analyzer) const;
+  /// Copy through a shared memory workspace
+  Stmt MakeSharedCopy(const LowerArgs &T, const Fragment &src_layout,
+                      const Fragment &dst_layout,
+                      arith::Analyzer *analyzer) const;
+};
+
+/// Wrapper class for fragment layout conversions
+class ConvertLayoutOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(ConvertLayoutOp, TileOperator,
+                                             ConvertLayoutOpNode);
+  TVM_DLL ConvertLayoutOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_CONVERT_LAYOUT_H_
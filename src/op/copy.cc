@@ -22,11 +22,17 @@
 #include <tvm/tir/op_attr_types.h>
 #include <tvm/tir/transform.h>
 
+#include <functional>
+#include <unordered_set>
+
 namespace tvm {
 namespace tl {
 
 using namespace tir;
 
+// TMA has no L1 allocation to skip, no_allocate keeps only its L2 part.
+static int TMAEvictionPolicy(int policy) { return policy == 3 ? 1 : policy; }
+
 // Constructs a Copy operator node from call arguments and annotations.
 // args[0]: source region, args[1]: destination region
 // annotations: Map containing coalesced_width, disable_tma, eviction_policy,
@@ -309,6 +315,11 @@ LayoutMap CopyNode::InferLayout(const LayoutInferArgs &T,
     }
   }
 
+  // The drain goes through registers of its own, see LowerTmemDrain
+  if (copy_inst == CopyInst::kTMemDrain) {
+    return {};
+  }
+
   // Handle tensor memory (tmem) layout inference
   if (copy_inst == CopyInst::kTMemLoad || copy_inst == CopyInst::kTMemStore) {
     // Tensor memory copy
@@ -373,6 +384,19 @@ LayoutMap CopyNode::InferLayout(const LayoutInferArgs &T,
     return results;
   }
 
+  if (copy_inst == CopyInst::kBulkG2G) {
+    // Issued by one thread, so the fragments in the indices are replicated
+    Map<Buffer, Layout> result_map;
+    for (const auto &ranges : {src_range, dst_range}) {
+      for (const auto &range : ranges) {
+        CollectFragmentLayouts(range->min, T.let_var_to_expr, T.layout_map,
+                               T.thread_bounds->extent, T.thread_bounds,
+                               result_map);
+      }
+    }
+    return result_map;
+  }
+
   if (copy_inst == CopyInst::kBulkLoad || copy_inst == CopyInst::kBulkStore ||
       copy_inst == CopyInst::kBulkLoad1D ||
       copy_inst == CopyInst::kBulkStore1D) {
@@ -457,6 +481,23 @@ LayoutMap CopyNode::InferLayout(const LayoutInferArgs &T,
     par_op_ = ParallelOp((MakeSIMTLoop(&analyzer)));
   }
   auto layout_map = par_op_->InferLayout(T, level);
+  // An epilogue staging tile nobody else lays out is swizzled like a TMA
+  // store would, so that the 8 rows of each stmatrix hit distinct banks
+  size_t dim = dst->shape.size();
+  if (copy_inst == CopyInst::kSTSM && level == InferLevel::kFree &&
+      !T.layout_map.count(dst) && dst->dtype.bytes() == 2 && dim >= 2 &&
+      as_const_int(dst->shape[dim - 2]) && as_const_int(dst->shape[dim - 1])) {
+    int mat_stride = static_cast<int>(*as_const_int(dst->shape[dim - 2]));
+    int mat_continuous = static_cast<int>(*as_const_int(dst->shape[dim - 1]));
+    Layout swizzle_layout =
+        makeGemmABLayoutHopper(mat_stride, mat_continuous, mat_continuous,
+                               dst->dtype.bits(), /*k_inner=*/true);
+    Layout linear_layout = makeLinearLayout(
+        Array<PrimExpr>{Integer(mat_stride), Integer(mat_continuous)});
+    if (!StructuralEqual()(swizzle_layout, linear_layout)) {
+      layout_map.Set(dst, swizzle_layout);
+    }
+  }
   return layout_map;
 }
 // Checks if this copy can be lowered to a Bulk Load (TMA) instruction.
@@ -496,12 +537,91 @@ bool CopyNode::CheckBulkLoad(Target target, arith::Analyzer *analyzer,
   return true;
 }
 
+// Offset of `indices` in the physical buffer of `layout`, row-major over
+// its output shape.
+static PrimExpr PhysicalOffset(const Layout &layout,
+                               const Array<PrimExpr> &indices) {
+  Array<PrimExpr> physical = layout->Forward(indices);
+  Array<PrimExpr> shape = layout->OutputShape();
+  PrimExpr offset = 0;
+  for (size_t i = 0; i < physical.size(); i++) {
+    offset = offset * shape[i] + physical[i];
+  }
+  return offset;
+}
+
+// Checks whether a tile of a global buffer with an annotated layout is
+// stored as one contiguous chunk laid out exactly like the shared buffer,
+// e.g. the sparse metadata on sm90, whose layout atom is the same for gmem
+// and smem. A 1D TMA copy then moves the tile without reordering it.
+static bool IsLayoutPreservingTile(const Buffer &global_tensor,
+                                   const Buffer &shared_tensor,
+                                   const Array<Range> &global_range,
+                                   const Array<Range> &shared_range,
+                                   const LayoutMap &layout_map,
+                                   arith::Analyzer *analyzer) {
+  if (!layout_map.count(global_tensor) ||
+      global_range.size() != shared_range.size()) {
+    return false;
+  }
+  Layout global_layout = layout_map.at(global_tensor);
+  Layout shared_layout = layout_map.count(shared_tensor)
+                             ? layout_map.at(shared_tensor)
+                             : makeLinearLayout(shared_tensor->shape);
+  if (global_layout->InputDim() != global_range.size() ||
+      shared_layout->InputDim() != shared_range.size()) {
+    return false;
+  }
+  Array<PrimExpr> origin, tile, elements;
+  PrimExpr numel = 1;
+  for (size_t i = 0; i < shared_range.size(); i++) {
+    // the tile fills the whole shared buffer
+    if (!analyzer->CanProve(shared_range[i]->min == 0 &&
+                                shared_range[i]->extent ==
+                                    shared_tensor->shape[i] &&
+                                global_range[i]->extent ==
+                                    shared_range[i]->extent,
+                            arith::ProofStrength::kSymbolicBound)) {
+      return false;
+    }
+    Var x("x" + std::to_string(i), shared_tensor->shape[i].dtype());
+    analyzer->Bind(x, Range::FromMinExtent(0, shared_tensor->shape[i]));
+    tile.push_back(x);
+    origin.push_back(global_range[i]->min);
+    elements.push_back(global_range[i]->min + x);
+    numel *= shared_tensor->shape[i];
+  }
+  PrimExpr physical_numel = 1;
+  for (const PrimExpr &e : shared_layout->OutputShape()) {
+    physical_numel *= e;
+  }
+  if (!analyzer->CanProveEqual(physical_numel, numel)) {
+    return false;
+  }
+  // TMA moves whole 16 byte chunks from 16 byte aligned addresses
+  PrimExpr base = PhysicalOffset(global_layout, origin);
+  int bytes = shared_tensor->dtype.bytes();
+  if (!analyzer->CanProve(FloorMod(base * bytes, 16) == 0 &&
+                          FloorMod(numel * bytes, 16) == 0)) {
+    return false;
+  }
+  // element x of the tile lands at the same distance from the start of the
+  // chunk as in the shared buffer
+  PrimExpr diff = PhysicalOffset(global_layout, elements) - base -
+                  PhysicalOffset(shared_layout, tile);
+  return analyzer->CanProve(diff == 0);
+}
+
 bool CopyNode::CheckBulkCopy1D(const Buffer &global_tensor,
                                const Buffer &shared_tensor,
                                const Array<Range> &global_range,
                                const Array<Range> &shared_range,
                                const LayoutMap &layout_map,
                                arith::Analyzer *analyzer) const {
+  if (layout_map.count(global_tensor)) {
+    return IsLayoutPreservingTile(global_tensor, shared_tensor, global_range,
+                                  shared_range, layout_map, analyzer);
+  }
 
   // Step 1: check shared is contiguous (linear layout is also contiguous)
   bool shared_is_contiguous = true;
@@ -571,6 +691,64 @@ bool CopyNode::CheckBulkStore1D(Target target, const LayoutMap &layout_map,
                          shared_range, layout_map, analyzer);
 }
 
+// Whether `range` is one contiguous run of the row-major `buffer`: only
+// dimensions of extent 1 precede the innermost one that is not full.
+static bool IsContiguousRegion(const Buffer &buffer, const Array<Range> &range,
+                               arith::Analyzer *analyzer) {
+  bool partial = false;
+  for (int i = static_cast<int>(range.size()) - 1; i >= 0; i--) {
+    if (partial) {
+      if (!analyzer->CanProve(range[i]->extent == 1,
+                              arith::ProofStrength::kSymbolicBound))
+        return false;
+    } else if (!analyzer->CanProve(range[i]->extent == buffer->shape[i] &&
+                                       range[i]->min == 0,
+                                   arith::ProofStrength::kSymbolicBound)) {
+      partial = true;
+    }
+  }
+  return true;
+}
+
+// Offset in elements of the first element of a row-major region
+static PrimExpr RegionOffset(const Buffer &buffer, const Array<Range> &range) {
+  PrimExpr offset = 0;
+  for (size_t i = 0; i < range.size(); i++) {
+    offset = offset * buffer->shape[i] + range[i]->min;
+  }
+  return offset;
+}
+
+// Smallest global to global copy worth staging through shared memory
+constexpr int64_t kBulkG2GMinBytes = 4096;
+
+bool CopyNode::CheckBulkG2G(Target target, const LayoutMap &layout_map,
+                            arith::Analyzer *analyzer) const {
+  if (!TargetHasBulkCopy(target) || !IsGlobalBuffer(src) ||
+      !IsGlobalBuffer(dst) || src->dtype != dst->dtype ||
+      src->dtype.bits() % 8 != 0 || layout_map.count(src) ||
+      layout_map.count(dst))
+    return false;
+  if (!IsContiguousRegion(src, src_range, analyzer) ||
+      !IsContiguousRegion(dst, dst_range, analyzer))
+    return false;
+  PrimExpr src_elements = 1, dst_elements = 1;
+  for (const Range &r : src_range)
+    src_elements *= r->extent;
+  for (const Range &r : dst_range)
+    dst_elements *= r->extent;
+  if (!analyzer->CanProveEqual(src_elements, dst_elements))
+    return false;
+  // cp.async.bulk moves 16-byte aligned multiples of 16 bytes
+  int bytes = src->dtype.bytes();
+  return analyzer->CanProve(src_elements * bytes >= kBulkG2GMinBytes) &&
+         analyzer->CanProveEqual(floormod(src_elements * bytes, 16), 0) &&
+         analyzer->CanProveEqual(
+             floormod(RegionOffset(src, src_range) * bytes, 16), 0) &&
+         analyzer->CanProveEqual(
+             floormod(RegionOffset(dst, dst_range) * bytes, 16), 0);
+}
+
 // Checks if this copy can be lowered to a Bulk Store (TMA) instruction.
 // Requires: TMA support, shared->global scope, matching dtypes.
 bool CopyNode::CheckBulkStore(Target target, arith::Analyzer *analyzer,
@@ -636,9 +814,16 @@ bool CopyNode::CheckTMemStore(Target target) const {
          dst.scope() == "shared.tmem";
 }
 
+// Checks if copy can drain tensor memory to shared memory (tcgen05.ld).
+// Requires: tmem support, shared.tmem->shared scope.
+bool CopyNode::CheckTMemDrain(Target target) const {
+  return TargetHasTmem(target) && src.scope() == "shared.tmem" &&
+         (dst.scope() == "shared.dyn" || dst.scope() == "shared");
+}
+
 // Selects the most specific copy instruction for the given target and buffers.
 // Priority: BulkLoad1D, BulkStore1D, BulkLoad, BulkStore, LDSM, STSM, TMemLoad,
-// TMemStore, Normal.
+// TMemStore, TMemDrain, Normal.
 CopyInst CopyNode::GetCopyInst(Target target, bool disable_tma_lower,
                                const LayoutMap &layout_map,
                                arith::Analyzer *analyzer,
@@ -647,14 +832,21 @@ CopyInst CopyNode::GetCopyInst(Target target, bool disable_tma_lower,
   // when tilelang.PassConfigKey.TL_DISABLE_TMA_LOWER is True,
   // we will not use tma for bulk load/store
 
+  // A device-side patched descriptor only exists for multi-dim TMA, so the
+  // 1d path (which carries a raw pointer instead of a descriptor) is skipped.
+  bool device_desc = GetTMAGlobalAddress().defined();
+
   // Check tensor memory operations first (highest priority for SM100/Blackwell)
   // 1d tma access can not support out of bound access
-  if (!disable_tma_lower && !buffer_oob &&
+  if (!disable_tma_lower && !buffer_oob && !device_desc &&
       CheckBulkLoad1D(target, layout_map, analyzer)) {
     return CopyInst::kBulkLoad1D;
-  } else if (!disable_tma_lower && !buffer_oob &&
+  } else if (!disable_tma_lower && !buffer_oob && !device_desc &&
              CheckBulkStore1D(target, layout_map, analyzer)) {
     return CopyInst::kBulkStore1D;
+  } else if (!disable_tma_lower && !device_desc &&
+             CheckBulkG2G(target, layout_map, analyzer)) {
+    return CopyInst::kBulkG2G;
   } else if (!disable_tma_lower && CheckBulkLoad(target, analyzer)) {
     return CopyInst::kBulkLoad;
   } else if (!disable_tma_lower && CheckBulkStore(target, analyzer)) {
@@ -667,6 +859,8 @@ CopyInst CopyNode::GetCopyInst(Target target, bool disable_tma_lower,
     return CopyInst::kTMemLoad;
   } else if (CheckTMemStore(target)) {
     return CopyInst::kTMemStore;
+  } else if (CheckTMemDrain(target)) {
+    return CopyInst::kTMemDrain;
   } else {
     return CopyInst::kNormal;
   }
@@ -683,10 +877,35 @@ Stmt CopyNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
       pass_ctx->GetConfig<Bool>(kDisableTMALower, Bool(false)).value();
   auto copy_inst = GetCopyInst(target, disable_tma_lower || GetDisableTMA(),
                                T.layout_map, analyzer);
+  if (GetTMAGlobalAddress().defined() && copy_inst != CopyInst::kBulkLoad &&
+      copy_inst != CopyInst::kBulkStore) {
+    LOG(FATAL) << "Copy from " << src->name << " to " << dst->name
+               << " requests a device-side TMA descriptor update "
+                  "(tma_global_address), but it cannot be lowered to a TMA "
+                  "bulk copy (got "
+               << CopyInstToString(copy_inst) << ")";
+  }
+  if (GetMulticastMask().defined() && copy_inst != CopyInst::kBulkLoad &&
+      copy_inst != CopyInst::kBulkLoad1D) {
+    // Every CTA still loads the tile itself, which is correct but forgoes
+    // the L2 traffic reduction.
+    LOG(WARNING) << "Copy from " << src->name << " to " << dst->name
+                 << " requests a multicast load, but it is lowered to "
+                 << CopyInstToString(copy_inst)
+                 << ", the multicast mask is ignored";
+  }
+  if (int stages = GetTMAStoreStages();
+      stages > 0 && !disable_tma_lower && !GetDisableTMA()) {
+    Stmt store = LowerPipelinedTmaStore(T, analyzer, stages);
+    if (store.defined())
+      return store;
+  }
   if (copy_inst == CopyInst::kTMemLoad || copy_inst == CopyInst::kTMemStore) {
     auto tmem_copy = LowerTmemCopy(T, analyzer);
     ICHECK(tmem_copy.defined()) << "Failed to lower tensor memory copy";
     return tmem_copy;
+  } else if (copy_inst == CopyInst::kTMemDrain) {
+    return LowerTmemDrain(T, analyzer);
   } else if (copy_inst == CopyInst::kBulkLoad1D ||
              copy_inst == CopyInst::kBulkStore1D) {
     auto bulk_copy = LowerBulkCopy1D(T, analyzer, copy_inst);
@@ -697,6 +916,8 @@ Stmt CopyNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
     auto bulk_copy = LowerBulkCopy(T, analyzer, copy_inst);
     ICHECK(bulk_copy.defined()) << "Failed to lower bulk load/store";
     return bulk_copy;
+  } else if (copy_inst == CopyInst::kBulkG2G) {
+    return LowerBulkG2G(T, analyzer);
   } else if (copy_inst == CopyInst::kLDSM || copy_inst == CopyInst::kSTSM) {
     auto ldsm_copy = LowerLDSMCopy(T, analyzer, copy_inst);
     ICHECK(ldsm_copy.defined()) << "Failed to lower ptx matrix copy";
@@ -708,9 +929,61 @@ Stmt CopyNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
   }
 }
 
+int CopyNode::InferEvictionPolicy(const LowerArgs &T) const {
+  if (annotations.count("eviction_policy")) {
+    return GetEvictionPolicy();
+  }
+  if (!IsGlobalBuffer(src) || IsGlobalBuffer(dst) || T.block_vars.empty()) {
+    return 0;
+  }
+  if (tvm::transform::PassContext::Current()
+          ->GetConfig<Bool>(kDisableCacheHintInference, Bool(false))
+          .value()) {
+    return 0;
+  }
+  // Variables the source region depends on, looking through let bindings.
+  std::unordered_set<const VarNode *> used;
+  std::function<void(const PrimExpr &)> collect = [&](const PrimExpr &e) {
+    PostOrderVisit(e, [&](const ObjectRef &node) {
+      if (const auto *v = node.as<VarNode>()) {
+        if (used.insert(v).second) {
+          if (auto bound = T.let_var_to_expr.Get(GetRef<Var>(v))) {
+            collect(bound.value());
+          }
+        }
+      }
+    });
+  };
+  for (const Range &r : src_range) {
+    collect(r->min);
+  }
+  for (const Var &bv : T.block_vars) {
+    if (!used.count(bv.get())) {
+      return 0; // other CTAs read the same tile
+    }
+  }
+  return 3; // no_allocate
+}
+
 // Lowers the copy using standard load/store with loop transformations.
 Stmt CopyNode::LowerNormalCopy(const LowerArgs &T,
                                arith::Analyzer *analyzer) const {
+  Stmt body = LowerNormalCopyBody(T, analyzer);
+  // Tag the global side with the cache policy, read back by codegen when
+  // emitting the loads and stores of the buffer.
+  int policy = InferEvictionPolicy(T);
+  if (policy != 0 && T.target->GetTargetDeviceType() != kDLCPU) {
+    const Buffer &global = IsGlobalBuffer(src) ? src : dst;
+    if (IsGlobalBuffer(global)) {
+      body = AttrStmt(global->data, attr::kCacheHint,
+                      IntImm(DataType::Int(32), policy), body);
+    }
+  }
+  return body;
+}
+
+Stmt CopyNode::LowerNormalCopyBody(const LowerArgs &T,
+                                   arith::Analyzer *analyzer) const {
   bool is_cpu_target = T.target->GetTargetDeviceType() == kDLCPU;
   auto simt_loop = MakeSIMTLoop(analyzer);
   auto fused_loop = Downcast<For>(ParallelLoopFuser::Fuse(simt_loop));
@@ -748,6 +1021,122 @@ Stmt CopyNode::LowerNormalCopy(const LowerArgs &T,
   }
 }
 
+// Stages the fragment tile through `stages` shared buffers of a slice of its
+// rows each, and writes every slice out with an asynchronous TMA store, so
+// that the store of a slice overlaps with the staging of the next one and
+// with whatever follows the copy. Before a buffer is rewritten, the threads
+// wait for all but the stages - 1 most recent bulk groups to have been read
+// (cp.async.bulk.wait_group.read), which always include the last store from
+// that buffer, also from the previous execution of the copy. The buffers are
+// a workspace of dynamic shared memory, packed by the merged allocation
+// planner like any other.
+Stmt CopyNode::LowerPipelinedTmaStore(const LowerArgs &T,
+                                      arith::Analyzer *analyzer,
+                                      int stages) const {
+  auto unsupported = [&](const char *reason) {
+    LOG(WARNING) << "Copy from " << src->name << " to " << dst->name
+                 << " cannot be lowered to a pipelined TMA store: " << reason
+                 << ", fallback to the default lowering";
+    return Stmt();
+  };
+  if (!TargetHasBulkCopy(T.target))
+    return unsupported("the target has no TMA");
+  if (!IsFragmentBuffer(src) || !IsGlobalBuffer(dst))
+    return unsupported("expects a fragment source and a global destination");
+  std::vector<size_t> src_dims, dst_dims;
+  for (size_t i = 0; i < src_range.size(); ++i) {
+    if (!is_one(src_range[i]->extent))
+      src_dims.push_back(i);
+  }
+  for (size_t i = 0; i < dst_range.size(); ++i) {
+    if (!is_one(dst_range[i]->extent))
+      dst_dims.push_back(i);
+  }
+  if (src_dims.size() != 2 || dst_dims.size() != 2 ||
+      dst_dims[1] + 1 != dst_range.size())
+    return unsupported("expects a 2D tile along the innermost dimension");
+  const int64_t *rows = as_const_int(src_range[src_dims[0]]->extent);
+  const int64_t *cols = as_const_int(src_range[src_dims[1]]->extent);
+  if (rows == nullptr || cols == nullptr || *rows % stages != 0)
+    return unsupported("expects constant extents, rows divisible by stages");
+  int64_t slice_rows = *rows / stages;
+  // TMA needs every slice to start at a 128-byte aligned shared address
+  if (slice_rows * *cols * dst->dtype.bytes() % 128 != 0)
+    return unsupported("the slices are not multiples of 128 bytes");
+
+  PrimExpr workspace =
+      T.AddWorkspace(static_cast<int>(*rows * *cols), dst->dtype);
+  const auto *access_ptr = workspace.as<CallNode>();
+  ICHECK(access_ptr && access_ptr->op.same_as(builtin::tvm_access_ptr()));
+  auto i32 = [](int64_t value) { return IntImm(DataType::Int(32), value); };
+  Buffer staging(Downcast<Var>(access_ptr->args[1]), dst->dtype,
+                 {i32(stages), i32(slice_rows), i32(*cols)}, {}, PrimExpr(0),
+                 dst->name + "_staging", 0, 0, BufferType::kDefault);
+
+  Stmt wait = Evaluate(
+      Call(DataType::Handle(), tma_store_wait(), {i32(stages - 1)}));
+  Stmt sync = Evaluate(Call(DataType::Int(32), builtin::tvm_storage_sync(),
+                            {StringImm("shared")}));
+  Array<Stmt> seq;
+  for (int s = 0; s < stages; ++s) {
+    auto slice = [&](const Array<Range> &range, size_t dim) {
+      Array<Range> sliced = range;
+      sliced.Set(dim, Range::FromMinExtent(range[dim]->min + s * slice_rows,
+                                           i32(slice_rows)));
+      return sliced;
+    };
+    Array<Range> slot{Range::FromMinExtent(i32(s), i32(1)),
+                      Range::FromMinExtent(i32(0), i32(slice_rows)),
+                      Range::FromMinExtent(i32(0), i32(*cols))};
+    auto stage = ffi::make_object<CopyNode>(*this);
+    stage->dst = staging;
+    stage->src_range = slice(src_range, src_dims[0]);
+    stage->dst_range = slot;
+    stage->annotations = {};
+    auto store = ffi::make_object<CopyNode>(*this);
+    store->src = staging;
+    store->src_range = slot;
+    store->dst_range = slice(dst_range, dst_dims[0]);
+    store->annotations = {{attr::kTMAStoreAsync, Integer(1)}};
+
+    seq.push_back(wait);
+    seq.push_back(sync);
+    seq.push_back(stage->LowerNormalCopy(T, analyzer));
+    seq.push_back(sync);
+    seq.push_back(store->LowerBulkCopy(T, analyzer, CopyInst::kBulkStore));
+  }
+  return SeqStmt(seq);
+}
+
+// A single thread streams the region through two shared memory chunks: the
+// cp.async.bulk load of a chunk overlaps the cp.async.bulk store of the
+// previous one, see tl::bulk_copy_g2g. The chunks and their two mbarriers
+// are a workspace of dynamic shared memory.
+Stmt CopyNode::LowerBulkG2G(const LowerArgs &T,
+                            arith::Analyzer *analyzer) const {
+  constexpr int64_t kChunkBytes = 16384;
+  // The mbarriers take the first 128 bytes of the workspace
+  constexpr int kBarrierBytes = 128;
+  PrimExpr elements = 1;
+  for (const Range &r : src_range)
+    elements *= r->extent;
+  elements = analyzer->Simplify(elements);
+  PrimExpr bytes = elements * src->dtype.bytes();
+  int64_t chunk = kChunkBytes;
+  if (const int64_t *total = as_const_int(analyzer->Simplify(bytes)))
+    chunk = std::min(chunk, *total);
+  PrimExpr workspace = T.AddWorkspace(
+      static_cast<int>(kBarrierBytes + 2 * chunk), DataType::UInt(8));
+  PrimExpr src_addr = src.access_ptr(1, DataType::Handle(), 1,
+                                     RegionOffset(src, src_range), elements);
+  PrimExpr dst_addr = dst.access_ptr(2, DataType::Handle(), 1,
+                                     RegionOffset(dst, dst_range), elements);
+  Stmt copy = Evaluate(Call(DataType::Handle(), bulk_copy_g2g(),
+                            {dst_addr, src_addr, bytes, workspace,
+                             IntImm(DataType::Int(32), chunk)}));
+  return IfThenElse(EQ(T.thread_var, T.thread_bounds->min), copy);
+}
+
 // Lowers copy to LDSM/STSM (warp-level 8x8 matrix) instructions.
 // Falls back to LowerNormalCopy if hardware constraints are not met.
 Stmt CopyNode::LowerLDSMCopy(const LowerArgs &T, arith::Analyzer *analyzer,
@@ -843,10 +1232,25 @@ Stmt CopyNode::LowerLDSMCopy(const LowerArgs &T, arith::Analyzer *analyzer,
     return LowerNormalCopy(T, analyzer);
   }
 
-  // Can only support local_range to be a full range
-  for (size_t i = 0; i < dst_range.size(); i++) {
-    if (!is_zero(dst_range[i]->min) ||
-        !analyzer->CanProveEqual(dst_range[i]->extent, dst->shape[i]))
+  // Can only support local_range to be a full range. The shared range may be
+  // any region of the same shape, e.g. one stage of a staging buffer with
+  // leading dimensions of extent 1.
+  const Buffer &local_buffer = is_ldmatrix ? dst : src;
+  const Array<Range> &local_range = is_ldmatrix ? dst_range : src_range;
+  const Array<Range> &shared_range = is_ldmatrix ? src_range : dst_range;
+  if (local_range.size() > shared_range.size())
+    return LowerNormalCopy(T, analyzer);
+  size_t num_leading = shared_range.size() - local_range.size();
+  for (size_t i = 0; i < num_leading; i++) {
+    if (!is_one(shared_range[i]->extent))
+      return LowerNormalCopy(T, analyzer);
+  }
+  for (size_t i = 0; i < local_range.size(); i++) {
+    if (!is_zero(local_range[i]->min) ||
+        !analyzer->CanProveEqual(local_range[i]->extent,
+                                 local_buffer->shape[i]) ||
+        !analyzer->CanProveEqual(shared_range[num_leading + i]->extent,
+                                 local_range[i]->extent))
       // TMA ldmatrix/stmatrix cannot support non-full range, will be fallback
       // to normal copy
       return LowerNormalCopy(T, analyzer);
@@ -885,6 +1289,13 @@ Stmt CopyNode::LowerLDSMCopy(const LowerArgs &T, arith::Analyzer *analyzer,
              FloorMod(T.thread_var, 2),
          warp + FloorDiv(FloorMod(T.thread_var, 8), 2)});
   shared_coords.pop_back(); // remove rep
+  Array<PrimExpr> region_coords;
+  for (size_t i = 0; i < shared_range.size(); i++) {
+    PrimExpr offset =
+        i < num_leading ? PrimExpr(0) : shared_coords[i - num_leading];
+    region_coords.push_back(shared_range[i]->min + offset);
+  }
+  shared_coords = region_coords;
   if (shared_layout.defined())
     shared_coords = shared_layout->Forward(shared_coords);
   PrimExpr shared_addr = shared_tensor.access_ptr(
@@ -1117,6 +1528,143 @@ Stmt CopyNode::LowerTmemCopy(const LowerArgs &T,
   return body;
 }
 
+// Drains a 32-bit tensor memory tile to shared memory. Every thread of a
+// warpgroup owns one lane (row) of the tile and its share of the columns,
+// read with tcgen05.ld.32x32b in chunks of the widest .xN whose two register
+// buffers fit in kDrainRegisters. The load of a chunk is issued right after
+// the previous one has landed (tcgen05.wait::ld waits for all of them), so
+// it overlaps the conversion and the shared stores of that chunk. The chunks
+// are unrolled to keep the register buffers in registers.
+Stmt CopyNode::LowerTmemDrain(const LowerArgs &T,
+                              arith::Analyzer *analyzer) const {
+  constexpr int WARPGROUP_SIZE = 128;
+  constexpr int kDrainRegisters = 64;
+  constexpr int kMaxChunk = 128; // tcgen05.ld.32x32b.x128
+  ICHECK_EQ(src->dtype.bits(), 32)
+      << "Draining tensor memory to shared memory needs a 32-bit "
+         "accumulator, got "
+      << src->dtype << " for " << src->name;
+
+  Array<IterVar> loop_vars = MakeIterVars();
+  ICHECK(loop_vars.size() == 2) << "Only support 2D tensor memory copy, got "
+                                << loop_vars.size() << " dimensions";
+  for (const auto &iv : loop_vars)
+    analyzer->Bind(iv->var, iv->dom);
+  ICHECK(!MakePredicate(analyzer, loop_vars, src->shape, 0).defined() &&
+         !MakePredicate(analyzer, loop_vars, dst->shape, 1).defined())
+      << "Tensor memory copy does not support predicates";
+  const int64_t *rows = as_const_int(loop_vars[0]->dom->extent);
+  const int64_t *cols = as_const_int(loop_vars[1]->dom->extent);
+  ICHECK(rows && cols)
+      << "Tensor memory copy requires loop bounds to be constant integers";
+  const int64_t *num_threads = as_const_int(T.thread_bounds->extent);
+  ICHECK(num_threads && *num_threads % WARPGROUP_SIZE == 0 &&
+         analyzer->CanProveEqual(FloorMod(T.thread_bounds->min, WARPGROUP_SIZE),
+                                 0))
+      << "Tensor memory copy requires thread bounds to be aligned to "
+         "warpgroups, but found thread range = "
+      << T.thread_bounds;
+
+  // The lanes and columns must be the rows and columns of the copy, the
+  // lanes all 128 of them (layout D of a 128-row MMA)
+  ICHECK(T.layout_map.count(src))
+      << "Source buffer " << src->name << " does not have a layout specified";
+  Array<PrimExpr> phy_indices =
+      T.layout_map[src]->Forward(MakeIndices(loop_vars, 0));
+  PrimExpr lane_offset =
+      analyzer->Simplify(phy_indices[0] - loop_vars[0]->var);
+  PrimExpr col_offset = analyzer->Simplify(phy_indices[1] - loop_vars[1]->var);
+  ICHECK(*rows == WARPGROUP_SIZE && is_zero(lane_offset) &&
+         is_const_int(col_offset))
+      << "Cannot drain " << src->name << " to " << dst->name
+      << " directly, whose tensor memory layout is not the 128 lanes by "
+         "columns of the copy; copy it to a fragment first";
+  int num_wgs = static_cast<int>(*num_threads / WARPGROUP_SIZE);
+  ICHECK(*cols % num_wgs == 0)
+      << "The " << *cols << " columns of " << src->name
+      << " do not split over " << num_wgs << " warpgroups";
+  int wg_cols = static_cast<int>(*cols / num_wgs);
+  int chunk = 1;
+  while (chunk * 2 <= std::min(kDrainRegisters / 2, kMaxChunk) &&
+         wg_cols % (chunk * 2) == 0)
+    chunk *= 2;
+  int num_chunks = wg_cols / chunk;
+
+  PrimExpr rel = T.thread_var - T.thread_bounds->min;
+  PrimExpr lane = FloorMod(rel, WARPGROUP_SIZE);
+  PrimExpr wg_col = FloorDiv(rel, WARPGROUP_SIZE) * wg_cols;
+  Buffer regs = decl_buffer({2 * chunk}, src->dtype, src->name + "_drain",
+                            "local");
+  // Translated to the tensor memory address in lower_shared_tmem
+  Map<Var, PrimExpr> origin;
+  for (const auto &iv : loop_vars)
+    origin.Set(iv->var, make_zero(iv->var.dtype()));
+  Array<PrimExpr> start_indices = MakeIndices(loop_vars, 0);
+  PrimExpr tmem_start = BufferLoad(src, start_indices.Map([&](PrimExpr e) {
+                                      return Substitute(e, origin);
+                                    }));
+  std::string ld_name = "tl::tcgen05_ld_32dp32bNx<" + std::to_string(chunk) +
+                        ", false, false>";
+  auto load = [&](int c) {
+    return Evaluate(Call(DataType::Handle(), builtin::call_extern(),
+                         {StringImm(ld_name), tmem_start, wg_col + c * chunk,
+                          regs.access_ptr(2, DataType::Handle(), 1,
+                                          (c % 2) * chunk, PrimExpr(chunk))}));
+  };
+  Stmt wait = Evaluate(Call(DataType::Handle(), builtin::call_extern(),
+                            {StringImm("tl::fence_view_async_tmem_load")}));
+
+  Buffer dst_buffer = dst;
+  Layout dst_layout;
+  if (T.buffer_remap.count(dst)) {
+    dst_layout = T.layout_map[dst];
+    dst_buffer = T.buffer_remap[dst];
+  }
+  Array<PrimExpr> dst_indices = MakeIndices(loop_vars, 1);
+  int vec = std::max(1, std::min(chunk, 16 / dst->dtype.bytes()));
+  Var v("v");
+  analyzer->Bind(v, Range(0, vec));
+  // 16-byte stores when the vector stays contiguous in the (swizzled) layout
+  auto contiguous = [&](const Array<PrimExpr> &indices) {
+    Map<Var, PrimExpr> first{{v, make_zero(v.dtype())}};
+    for (size_t d = 0; d + 1 < indices.size(); ++d) {
+      if (!analyzer->CanProveEqual(indices[d], Substitute(indices[d], first)))
+        return false;
+    }
+    PrimExpr last = indices.back();
+    return analyzer->CanProveEqual(last - Substitute(last, first), v);
+  };
+  auto store = [&](int c) {
+    Array<Stmt> stores;
+    for (int k = 0; k < chunk; k += vec) {
+      Map<Var, PrimExpr> vmap{{loop_vars[0]->var, lane},
+                              {loop_vars[1]->var, wg_col + c * chunk + k + v}};
+      Array<PrimExpr> indices;
+      for (const PrimExpr &index : dst_indices)
+        indices.push_back(Substitute(index, vmap));
+      if (dst_layout.defined())
+        indices = dst_layout->Forward(indices);
+      indices = indices.Map([&](PrimExpr e) { return analyzer->Simplify(e); });
+      PrimExpr value = BufferLoad(regs, {(c % 2) * chunk + k + v});
+      Stmt body = BufferStore(dst_buffer, Cast(dst->dtype, value), indices);
+      ForKind kind = vec > 1 && contiguous(indices) ? ForKind::kVectorized
+                                                    : ForKind::kUnrolled;
+      stores.push_back(For(v, 0, vec, kind, body));
+    }
+    return SeqStmt::Flatten(stores);
+  };
+
+  Array<Stmt> seq{load(0)};
+  for (int c = 0; c < num_chunks; ++c) {
+    seq.push_back(wait);
+    if (c + 1 < num_chunks)
+      seq.push_back(load(c + 1));
+    seq.push_back(store(c));
+  }
+  return Allocate(regs->data, regs->dtype, regs->shape, const_true(),
+                  SeqStmt(seq));
+}
+
 // Lowers copy to a bulk TMA (Tensor Memory Accelerator) transfer.
 // Falls back to LowerNormalCopy if preconditions are not satisfied.
 Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
@@ -1124,6 +1672,16 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
   ICHECK(copy_inst == CopyInst::kBulkLoad || copy_inst == CopyInst::kBulkStore)
       << "Invalid copy inst " << static_cast<int>(copy_inst);
   bool is_load = copy_inst == CopyInst::kBulkLoad;
+  Optional<PrimExpr> tma_global_address = GetTMAGlobalAddress();
+  // With a device-side patched descriptor the global buffer is only a
+  // template, so a SIMT fallback would silently touch the wrong tensor.
+  auto fallback = [&]() -> Stmt {
+    ICHECK(!tma_global_address.defined())
+        << "Copy from " << src->name << " to " << dst->name
+        << " requests a device-side TMA descriptor update but falls back to "
+           "a normal copy, see the warning above";
+    return LowerNormalCopy(T, analyzer);
+  };
   Buffer global_tensor = is_load ? src : dst;
   Buffer shared_tensor = is_load ? dst : src;
   Array<Range> global_range = is_load ? src_range : dst_range;
@@ -1133,7 +1691,7 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
   if (T.layout_map.count(global_tensor)) {
     LOG(WARNING) << "TMA bulk copy cannot support a non-swizzled global "
                     "layout, fallback to normal copy.";
-    return LowerNormalCopy(T, analyzer);
+    return fallback();
   }
 
   // linear layout must be computed before remapping
@@ -1217,7 +1775,7 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
       if (stride->value % 16 != 0 || stride->value >= (1ULL << 40)) {
         LOG(WARNING) << "TMA bulk copy cannot support a global stride of "
                      << desc.global_stride[i] << ", fallback to normal copy.";
-        return LowerNormalCopy(T, analyzer);
+        return fallback();
       }
     }
   }
@@ -1306,12 +1864,12 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
       LOG(WARNING) << "Bulk copy cannot support a padded layout for src: "
                    << src->name << ", dst: " << dst->name
                    << ", fallback to normal copy";
-      return LowerNormalCopy(T, analyzer);
+      return fallback();
     } else {
       LOG(WARNING) << "Came across unsupported swizzle layout for src: "
                    << src->name << ", dst: " << dst->name
                    << ", fallback to normal copy";
-      return LowerNormalCopy(T, analyzer);
+      return fallback();
     }
   }
 
@@ -1320,7 +1878,7 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
     LOG(WARNING) << "inner_box_dim " << desc.smem_box[0]
                  << " can only be a constant integer for TMA bulk copy, "
                     "fallback to normal copy";
-    return LowerNormalCopy(T, analyzer);
+    return fallback();
   }
   int instruction_dim = *inner_box_dim;
   if (desc.swizzle == static_cast<int>(CU_TENSOR_MAP_SWIZZLE_64B)) {
@@ -1357,12 +1915,37 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
       LOG(WARNING) << "TMA bulk copy cannot support a swizzled global layout "
                       "with inner_box_dim_ > "
                    << check.max_dim << ", will be fallback to normal copy";
-      return LowerNormalCopy(T, analyzer);
+      return fallback();
     }
   }
 
-  Call create_descriptor =
+  PrimExpr create_descriptor =
       Call(DataType::Handle(), create_tma_descriptor(), desc.EncodeCallArgs());
+  if (tma_global_address.defined()) {
+    Optional<PrimExpr> workspace = GetTMADescWorkspace();
+    ICHECK(workspace.defined())
+        << "tma_global_address requires a tma_desc_workspace annotation";
+    Array<PrimExpr> replace_args{workspace.value(), create_descriptor,
+                                 tma_global_address.value()};
+    if (auto shape = GetTMAGlobalShape()) {
+      // Extents innermost first, then the byte strides of the outer dims of
+      // the contiguous tensor, in the order of the descriptor fields.
+      ICHECK_EQ(shape.value().size(), desc.rank)
+          << "tma_global_shape of " << global_tensor->name
+          << " must have one extent per dimension, got " << shape.value();
+      Array<PrimExpr> extents = ReverseArray(shape.value());
+      for (const PrimExpr &e : extents)
+        replace_args.push_back(cast(DataType::Int(32), e));
+      PrimExpr stride = make_const(DataType::Int(64),
+                                   global_tensor->dtype.bytes());
+      for (size_t i = 0; i + 1 < extents.size(); i++) {
+        stride = stride * cast(DataType::Int(64), extents[i]);
+        replace_args.push_back(stride);
+      }
+    }
+    create_descriptor = Call(DataType::Handle(),
+                             tma_descriptor_replace_address(), replace_args);
+  }
 
   Array<PrimExpr> args;
   args.reserve(desc.rank + 4);
@@ -1370,6 +1953,11 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
   if (is_load)
     args.push_back(0); // mbarrier id placeholder
   auto op = is_load ? tma_load() : tma_store();
+  Map<String, ObjectRef> op_annotations;
+  if (auto mask = GetMulticastMask(); mask && is_load)
+    op_annotations.Set(attr::kMulticastMask, mask.value());
+  if (!is_load && GetTMAStoreAsync())
+    op_annotations.Set(attr::kTMAStoreAsync, Integer(1));
 
   Stmt tma_copy;
   PrimExpr total_elements = 1;
@@ -1390,9 +1978,10 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
     int need_reduce = 0;
     if (!is_load)
       args.push_back(need_reduce);
-    args.push_back(GetEvictionPolicy());
-    tma_copy = For(loop_var, 0, loop_extent, ForKind::kUnrolled,
-                   Evaluate(Call(DataType::Handle(), op, args)));
+    args.push_back(TMAEvictionPolicy(InferEvictionPolicy(T)));
+    tma_copy =
+        For(loop_var, 0, loop_extent, ForKind::kUnrolled,
+            Evaluate(Call(DataType::Handle(), op, args, op_annotations)));
   } else {
     PrimExpr shared_addr = shared_tensor.access_ptr(
         is_load ? 2 : 1, DataType::Handle(), 1, shared_offset, total_elements);
@@ -1402,8 +1991,8 @@ Stmt CopyNode::LowerBulkCopy(const LowerArgs &T, arith::Analyzer *analyzer,
     int need_reduce = 0;
     if (!is_load)
       args.push_back(need_reduce);
-    args.push_back(GetEvictionPolicy());
-    tma_copy = Evaluate(Call(DataType::Handle(), op, args));
+    args.push_back(TMAEvictionPolicy(InferEvictionPolicy(T)));
+    tma_copy = Evaluate(Call(DataType::Handle(), op, args, op_annotations));
   }
   tma_copy = IfThenElse(EQ(T.thread_var, T.thread_bounds->min), tma_copy);
 
@@ -1463,6 +2052,14 @@ Stmt CopyNode::LowerBulkCopy1D(const LowerArgs &T, arith::Analyzer *analyzer,
     shared_offset += shared_indices[i] * shared_strides[i];
   }
 
+  if (T.layout_map.count(global_tensor)) {
+    // The tile is one chunk of the physical global buffer laid out like the
+    // shared buffer, see IsLayoutPreservingTile
+    global_offset = PhysicalOffset(T.layout_map.at(global_tensor),
+                                   global_indices);
+    shared_offset = 0;
+  }
+
   PrimExpr elements = analyzer->Simplify(shared_elements);
   PrimExpr shared_addr = shared_tensor.access_ptr(
       is_load ? 2 : 1, DataType::Handle(), 1, shared_offset, elements);
@@ -1470,17 +2067,26 @@ Stmt CopyNode::LowerBulkCopy1D(const LowerArgs &T, arith::Analyzer *analyzer,
       is_load ? 1 : 2, DataType::Handle(), 1, global_offset, elements);
   Stmt tma_copy;
   if (is_load) {
+    Map<String, ObjectRef> op_annotations;
+    if (auto mask = GetMulticastMask())
+      op_annotations.Set(attr::kMulticastMask, mask.value());
     // the zero is a placeholder for mbarrier ids
     tma_copy = Evaluate(
         Call(DataType::Handle(), tma_load(),
              {shared_addr, global_addr, 0,
-              elements * shared_tensor->dtype.bytes(), GetEvictionPolicy()}));
+              elements * shared_tensor->dtype.bytes(),
+              TMAEvictionPolicy(InferEvictionPolicy(T))},
+             op_annotations));
   } else {
     int need_reduce = 0;
+    Map<String, ObjectRef> op_annotations;
+    if (GetTMAStoreAsync())
+      op_annotations.Set(attr::kTMAStoreAsync, Integer(1));
     tma_copy = Evaluate(
         Call(DataType::Handle(), tma_store(),
              {global_addr, shared_addr, elements * shared_tensor->dtype.bytes(),
-              need_reduce, GetEvictionPolicy()}));
+              need_reduce, TMAEvictionPolicy(InferEvictionPolicy(T))},
+             op_annotations));
   }
   tma_copy = IfThenElse(EQ(T.thread_var, T.thread_bounds->min), tma_copy);
   return tma_copy;
@@ -1510,158 +2116,6 @@ Array<PrimExpr> TMADesc::EncodeCallArgs() const {
   return args;
 }
 
-// Constructs a Conv2DIm2ColOp node from call arguments.
-// args: src, dst, nhw_step, c_step, kernel, stride, dilation, padding,
-// eviction_policy
-Conv2DIm2ColOp::Conv2DIm2ColOp(Array<PrimExpr> args,
-                               Map<String, ObjectRef> annotations) {
-  ObjectPtr<Conv2DIm2ColOpNode> node =
-      tvm::ffi::make_object<Conv2DIm2ColOpNode>();
-  node->srcRegion_ = NormalizeToBufferRegion(args[0]);
-  node->dstRegion_ = NormalizeToBufferRegion(args[1]);
-  node->src_ = node->srcRegion_->buffer;
-  node->dst_ = node->dstRegion_->buffer;
-  node->nhw_step_ = args[2];
-  node->c_step_ = args[3];
-  node->kernel_ = args[4].as<IntImm>().value()->value;
-  node->stride_ = args[5].as<IntImm>().value()->value;
-  node->dilation_ = args[6].as<IntImm>().value()->value;
-  node->padding_ = args[7].as<IntImm>().value()->value;
-  node->eviction_policy_ = args[8].as<IntImm>().value()->value;
-  data_ = std::move(node);
-}
-
-// Creates a shallow copy of this Conv2DIm2ColOpNode.
-TileOperator Conv2DIm2ColOpNode::Clone() const {
-  auto op = tvm::ffi::make_object<Conv2DIm2ColOpNode>(*this);
-  return Conv2DIm2ColOp(op);
-}
-
-// Lowers Conv2D im2col into a TMA-backed PTX sequence for Hopper.
-Stmt Conv2DIm2ColOpNode::Lower(const LowerArgs &T,
-                               arith::Analyzer *analyzer) const {
-  ICHECK(TargetIsHopper(T.target));
-  ICHECK(src_.scope() == "global" &&
-         (dst_.scope() == "shared.dyn" || dst_.scope() == "shared"));
-  ICHECK(src_->shape.size() == 4);
-  ICHECK(dst_->shape.size() == 2);
-  ICHECK(src_->dtype == dst_->dtype);
-  Layout shared_layout;
-  if (T.layout_map.count(dst_)) {
-    shared_layout = T.layout_map[dst_];
-  }
-
-  TMAIm2ColDesc desc;
-  desc.rank = src_->shape.size();
-  desc.data_type = to_CUtensorMapDataType(src_->dtype);
-  desc.global_addr = src_->data;
-  desc.global_shape = ReverseArray(src_->shape);
-
-  if (!src_->strides.empty()) {
-    desc.global_stride = ReverseArray(src_->strides);
-  } else {
-    // Create stride from shape
-    PrimExpr stride = 1;
-    desc.global_stride.reserve(desc.rank);
-    for (size_t i = 0; i < desc.rank; i++) {
-      desc.global_stride.push_back(stride);
-      stride *= desc.global_shape[i];
-    }
-  }
-  // The first stride element should be 1
-  ICHECK(is_one(desc.global_stride[0])) << desc.global_stride;
-  // Make global stride in bytes
-  desc.global_stride = desc.global_stride.Map([&](PrimExpr e) {
-    return cast(DataType::Int(64), e) * src_->dtype.bytes();
-  });
-  desc.elem_stride = {1, stride_, stride_, 1};
-  desc.lower_corner = {-padding_, -padding_};
-  desc.upper_corner = {-padding_, -padding_};
-  desc.smem_box_pixel = Downcast<IntImm>(dst_->shape[0])->value;
-  desc.smem_box_channel = Downcast<IntImm>(dst_->shape[1])->value;
-  desc.l2_promotion = static_cast<int>(CU_TENSOR_MAP_L2_PROMOTION_L2_128B);
-  desc.oob_fill = static_cast<int>(CU_TENSOR_MAP_FLOAT_OOB_FILL_NONE);
-  desc.interleave = static_cast<int>(CU_TENSOR_MAP_INTERLEAVE_NONE);
-  if (!shared_layout.defined()) {
-    desc.swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_NONE);
-  } else {
-    ICHECK(shared_layout->InputDim() == 2) << "Cannot detect TMA layout.";
-    auto stride = as_const_int(shared_layout->InputShape()[0]);
-    auto continuous = as_const_int(shared_layout->InputShape()[1]);
-    ICHECK(stride != nullptr && continuous != nullptr);
-
-    if (StructuralEqual()(shared_layout,
-                          makeQuarterBankSwizzleLayout(*stride, *continuous,
-                                                       dst_->dtype.bits()))) {
-      desc.swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_32B);
-    } else if (StructuralEqual()(shared_layout, makeHalfBankSwizzleLayout(
-                                                    *stride, *continuous,
-                                                    dst_->dtype.bits()))) {
-      desc.swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_64B);
-    } else if (StructuralEqual()(shared_layout, makeFullBankSwizzleLayout(
-                                                    *stride, *continuous,
-                                                    dst_->dtype.bits()))) {
-      desc.swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_128B);
-    } else {
-      LOG(FATAL) << "Cannot detect TMA layout.";
-    }
-  }
-
-  Call create_desc = Call(DataType::Handle(), create_tma_im2col_descriptor(),
-                          desc.EncodeCallArgs());
-
-  Array<PrimExpr> global_coords; // c, w, h, n
-  Array<PrimExpr> image_offset;  // w, h
-  global_coords.reserve(desc.rank);
-
-  ICHECK(analyzer->CanProveEqual(
-      FloorMod(desc.global_shape[0], desc.smem_box_channel), 0))
-      << "Currently can only support divisible channel case";
-
-  global_coords.push_back(
-      FloorMod(c_step_ * desc.smem_box_channel, desc.global_shape[0]));
-  image_offset.push_back(
-      dilation_ *
-      FloorMod(FloorDiv(c_step_ * desc.smem_box_channel, desc.global_shape[0]),
-               kernel_));
-  image_offset.push_back(dilation_ * FloorDiv(c_step_ * desc.smem_box_channel,
-                                              desc.global_shape[0] * kernel_));
-
-  PrimExpr h_dim =
-      FloorDiv(src_->shape[1] + 2 * padding_ - (kernel_ - 1) * dilation_ - 1,
-               stride_) +
-      1;
-  PrimExpr w_dim =
-      FloorDiv(src_->shape[2] + 2 * padding_ - (kernel_ - 1) * dilation_ - 1,
-               stride_) +
-      1;
-  global_coords.push_back(
-      stride_ * FloorMod(nhw_step_ * desc.smem_box_pixel, w_dim) - padding_);
-  global_coords.push_back(
-      stride_ *
-          FloorMod(FloorDiv(nhw_step_ * desc.smem_box_pixel, w_dim), h_dim) -
-      padding_);
-  global_coords.push_back(
-      FloorDiv(nhw_step_ * desc.smem_box_pixel, w_dim * h_dim));
-
-  Array<PrimExpr> args;
-  args.reserve(desc.rank * 2 + 2);
-  args.push_back(create_desc);
-  args.push_back(0); // mbar placeholder
-  auto dst_buffer = T.buffer_remap.count(dst_) ? T.buffer_remap[dst_] : dst_;
-  auto shared_addr = dst_buffer.access_ptr(2);
-  args.push_back(shared_addr);
-  for (auto coord : global_coords)
-    args.push_back(coord);
-  for (auto offset : image_offset)
-    args.push_back(offset);
-  args.push_back(this->eviction_policy_);
-  Stmt tma_copy =
-      IfThenElse(EQ(T.thread_var, T.thread_bounds->min),
-                 Evaluate(Call(DataType::Handle(), tma_load_im2col(), args)));
-  return tma_copy;
-}
-
 // Encodes the TMA im2col descriptor for create_tma_im2col_descriptor().
 Array<PrimExpr> TMAIm2ColDesc::EncodeCallArgs() const {
   Array<PrimExpr> args;
@@ -1724,25 +2178,6 @@ TIR_REGISTER_TL_TILE_OP(Copy, copy)
     .set_attr<TCallEffectKind>("TCallEffectKind",
                                Integer(CallEffectKind::kOpaque));
 
-// Layout inference hook - returns empty map (no layout suggestions).
-LayoutMap Conv2DIm2ColOpNode::InferLayout(const LayoutInferArgs &T,
-                                          InferLevel level) const {
-  return {};
-}
-
-// Register the Conv2DIm2Col operation with TVM's TIR system
-// This operation performs im2col transformation for 2D convolutions using TMA
-// - Takes 9 inputs: src_buffer, dst_buffer, nhw_step, c_step, kernel, stride,
-// dilation, padding, eviction_policy
-// - Marked as opaque since it has side effects (memory writes)
-TIR_REGISTER_TL_TILE_OP(Conv2DIm2ColOp, c2d_im2col)
-    .set_num_inputs(9)
-    .set_attr<TCallEffectKind>("TCallEffectKind",
-                               Integer(CallEffectKind::kOpaque));
-
-TVM_FFI_STATIC_INIT_BLOCK() {
-  CopyNode::RegisterReflection();
-  Conv2DIm2ColOpNode::RegisterReflection();
-}
+TVM_FFI_STATIC_INIT_BLOCK() { CopyNode::RegisterReflection(); }
 } // namespace tl
 } // namespace tvm
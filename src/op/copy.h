@@ -26,6 +26,8 @@ enum class CopyInst : uint8_t {
   kBulkStore1D = 6, // utilize tma store 1d
   kTMemLoad = 7,    // tcgen05.ld (tensor memory -> register)
   kTMemStore = 8,   // tcgen05.st (register -> tensor memory)
+  kBulkG2G = 9,     // global -> shared -> global through cp.async.bulk
+  kTMemDrain = 10,  // tcgen05.ld to shared memory, pipelined through registers
 };
 
 /// Convert CopyInst enum to string for debugging
@@ -49,6 +51,10 @@ inline const char *CopyInstToString(CopyInst inst) {
     return "TMemLoad";
   case CopyInst::kTMemStore:
     return "TMemStore";
+  case CopyInst::kBulkG2G:
+    return "BulkG2G";
+  case CopyInst::kTMemDrain:
+    return "TMemDrain";
   default:
     return "Unknown";
   }
@@ -73,7 +79,7 @@ struct TMADesc {
 };
 
 /*!
- * \brief Descriptor for TMA-based im2col transformation used in Conv2D.
+ * \brief Descriptor for TMA-based im2col transformation used in convolutions.
  *
  * This supports extracting patches from the input image (im2col)
  * for convolution lowering, storing them in shared memory.
@@ -102,15 +108,6 @@ struct TMAIm2ColDesc {
   Array<PrimExpr> EncodeCallArgs() const;
 };
 
-/*!
- * \brief Get TVM Op handle for Conv2DIm2Col.
- */
-
-/*!
- * \brief Clone this Conv2DIm2Col operator.
- *
- * Returns a TileOperator reference that is a shallow clone of this operator.
- */
 class CopyNode : public TileOperatorNode {
 public:
   Buffer src, dst;                   // Source and destination buffers
@@ -120,7 +117,19 @@ public:
   //   - "coalesced_width": IntImm, width for coalesced memory access
   //   - "disable_tma": Bool, whether to disable TMA acceleration
   //   - "eviction_policy": IntImm, cache eviction policy (0=normal, 1=first,
-  //   2=last)
+  //   2=last, 3=no_allocate: evict_first in L2 and no L1 allocation)
+  //   - "tma_global_address": PrimExpr, device-side global address that
+  //     replaces the base address of the TMA descriptor at runtime
+  //   - "tma_desc_workspace": PrimExpr, 128-byte aligned global scratch slot
+  //     the patched descriptor is written to (requires "tma_global_address")
+  //   - attr::kMulticastMask ("multicast_mask"): PrimExpr, CTAs of the
+  //     cluster receiving a TMA load, which is issued once for all of them
+  //   - attr::kTMAStoreAsync ("tma_store_async"): IntImm, do not wait for a
+  //     TMA store right after issuing it; the source buffer must not be
+  //     rewritten before a T.tma_store_wait()
+  //   - "tma_store_stages": IntImm, number of shared buffers a fragment tile
+  //     is staged through, one slice of its rows each, by a pipelined TMA
+  //     store (LowerPipelinedTmaStore)
   //   - attr::kParallelLoopLayout ("parallel_loop_layout"): Fragment, loop
   //     layout hint applied to the outermost generated parallel loop of this
   //     copy's SIMT loop nest.
@@ -158,6 +167,65 @@ public:
     return 0; // default: evict_normal
   }
 
+  /*!
+   * \brief The annotated eviction policy, or the one inferred for a
+   *        streaming global source when there is none.
+   *
+   * A source tile whose address depends on every blockIdx of the kernel is
+   * read by a single CTA, keeping it in L1 or L2 only evicts reused data, so
+   * it is loaded with no_allocate. Stores are never inferred: the next
+   * kernel may read them from L2.
+   */
+  int InferEvictionPolicy(const LowerArgs &T) const;
+
+  Optional<PrimExpr> GetTMAGlobalAddress() const {
+    if (auto val = annotations.Get("tma_global_address")) {
+      return Downcast<PrimExpr>(val.value());
+    }
+    return std::nullopt;
+  }
+
+  Optional<PrimExpr> GetMulticastMask() const {
+    if (auto val = annotations.Get("multicast_mask")) {
+      return Downcast<PrimExpr>(val.value());
+    }
+    return std::nullopt;
+  }
+
+  bool GetTMAStoreAsync() const {
+    if (auto val = annotations.Get("tma_store_async")) {
+      if (auto int_val = val->as<IntImmNode>()) {
+        return int_val->value != 0;
+      }
+    }
+    return false;
+  }
+
+  int GetTMAStoreStages() const {
+    if (auto val = annotations.Get("tma_store_stages")) {
+      if (auto int_val = val->as<IntImmNode>()) {
+        return static_cast<int>(int_val->value);
+      }
+    }
+    return 0;
+  }
+
+  /// Shape of the contiguous tensor behind tma_global_address, in buffer
+  /// dimension order; absent when only the address changes.
+  Optional<Array<PrimExpr>> GetTMAGlobalShape() const {
+    if (auto val = annotations.Get("tma_global_shape")) {
+      return Downcast<Array<PrimExpr>>(val.value());
+    }
+    return std::nullopt;
+  }
+
+  Optional<PrimExpr> GetTMADescWorkspace() const {
+    if (auto val = annotations.Get("tma_desc_workspace")) {
+      return Downcast<PrimExpr>(val.value());
+    }
+    return std::nullopt;
+  }
+
   /*!
    * \brief Lower the copy operator to a TIR statement.
    * \param T        Arguments for lowering.
@@ -206,6 +274,12 @@ public:
                        const LayoutMap &layout_map,
                        arith::Analyzer *analyzer) const;
 
+  /*!
+   * \brief Check if a global to global copy can go through cp.async.bulk.
+   */
+  bool CheckBulkG2G(Target target, const LayoutMap &layout_map,
+                    arith::Analyzer *analyzer) const;
+
   /*!
    * \brief Check if lds memory copy is supported.
    */
@@ -226,6 +300,11 @@ public:
    */
   bool CheckTMemStore(Target target) const;
 
+  /*!
+   * \brief Check if tensor memory can be drained to shared memory.
+   */
+  bool CheckTMemDrain(Target target) const;
+
   /*!
    * \brief Get the copy instruction type.
    */
@@ -246,6 +325,20 @@ protected:
   Stmt LowerBulkCopy1D(const LowerArgs &T, arith::Analyzer *analyzer,
                        CopyInst copy_inst) const;
 
+  /*!
+   * \brief Generate lowering for a fragment to global copy staged through
+   * `stages` shared buffers, each written out by an asynchronous TMA store.
+   * Returns an undefined Stmt when the copy does not qualify.
+   */
+  Stmt LowerPipelinedTmaStore(const LowerArgs &T, arith::Analyzer *analyzer,
+                              int stages) const;
+
+  /*!
+   * \brief Generate lowering for a global to global copy staged through two
+   * shared memory chunks by cp.async.bulk loads and stores.
+   */
+  Stmt LowerBulkG2G(const LowerArgs &T, arith::Analyzer *analyzer) const;
+
   /*!
    * \brief Generate lowering for LDS Memory Copy (shared memory to shared
    * memory or smem usage).
@@ -258,11 +351,23 @@ protected:
    */
   Stmt LowerTmemCopy(const LowerArgs &T, arith::Analyzer *analyzer) const;
 
+  /*!
+   * \brief Generate lowering for a tensor memory to shared memory copy, the
+   * tcgen05.ld of a chunk overlapping the shared stores of the previous one.
+   */
+  Stmt LowerTmemDrain(const LowerArgs &T, arith::Analyzer *analyzer) const;
+
   /*!
    * \brief Generate lowering for normal copy.
    */
   Stmt LowerNormalCopy(const LowerArgs &T, arith::Analyzer *analyzer) const;
 
+  /*!
+   * \brief Build the SIMT loop of LowerNormalCopy, before cache hint tagging.
+   */
+  Stmt LowerNormalCopyBody(const LowerArgs &T,
+                           arith::Analyzer *analyzer) const;
+
   /*!
    * \brief Generate SIMT (thread-level) loop for copying.
    */
@@ -302,17 +407,6 @@ protected:
    * configuration (buffers, parameters, and layout-related fields).
    * @return A TileOperator owning the cloned operator node.
    */
-
-  /**
-   * \brief Constructor.
-   * \param args Expression arguments for the Conv2D im2col operator.
-   * \param vmap Buffer variable mapping.
-   */
-
-  /**
-   * \brief Get the TVM Op handle corresponding to this Conv2DIm2Col operator.
-   * @return Reference to the singleton TVM Op representing this operator.
-   */
   TileOperator Clone() const;
 
 private:
@@ -356,70 +450,6 @@ public:
   static const Op &Get();
 };
 
-/*!
- * \brief Special operator for Conv2D im2col transformation.
- *
- * This operator converts input image layout into columnar format suitable
- * for matrix multiplication-based convolution lowering.
- */
-class Conv2DIm2ColOpNode : public TileOperatorNode {
-public:
-  BufferRegion srcRegion_, dstRegion_;
-  Buffer src_,
-      dst_;      // Source (input feature map) and destination (im2col matrix)
-  int stride_;   // Stride for convolution
-  int padding_;  // Padding amount
-  int dilation_; // Dilation factor
-  int kernel_;   // Kernel size
-  int eviction_policy_; // Cache eviction policy
-  PrimExpr nhw_step_;   // Step size in NHW dimensions
-  PrimExpr c_step_;     // Step size in channel dimension
-
-  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.Conv2DIm2Col", Conv2DIm2ColOpNode,
-                                    TileOperatorNode);
-
-  static void RegisterReflection() {
-    namespace refl = tvm::ffi::reflection;
-    refl::ObjectDef<Conv2DIm2ColOpNode>()
-        .def_ro("srcRegion", &Conv2DIm2ColOpNode::srcRegion_)
-        .def_ro("dstRegion", &Conv2DIm2ColOpNode::dstRegion_)
-        .def_ro("src", &Conv2DIm2ColOpNode::src_)
-        .def_ro("dst", &Conv2DIm2ColOpNode::dst_)
-        .def_ro("stride", &Conv2DIm2ColOpNode::stride_)
-        .def_ro("padding", &Conv2DIm2ColOpNode::padding_)
-        .def_ro("dilation", &Conv2DIm2ColOpNode::dilation_)
-        .def_ro("kernel", &Conv2DIm2ColOpNode::kernel_)
-        .def_ro("eviction_policy", &Conv2DIm2ColOpNode::eviction_policy_);
-  }
-
-  /*!
-   * \brief Lower to TIR statement.
-   */
-  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
-
-  /*!
-   * \brief Infer layout for this operator.
-   */
-  LayoutMap InferLayout(const LayoutInferArgs &T,
-                        InferLevel level) const override;
-
-  /*!
-   * \brief Get TVM Op handle.
-   */
-  static const Op &Get();
-  TileOperator Clone() const;
-};
-
-class Conv2DIm2ColOp : public TileOperator {
-public:
-  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(Conv2DIm2ColOp, TileOperator,
-                                             Conv2DIm2ColOpNode);
-  TVM_DLL
-  Conv2DIm2ColOp(Array<PrimExpr> args,
-                 Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
-  static const Op &Get();
-};
-
 } // namespace tl
 } // namespace tvm
 
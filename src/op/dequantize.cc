@@ -0,0 +1,394 @@
+/*!
+ * \file tl/op/dequantize.cc
+ * \brief Implementation of the dequantization operator
+ */
+
+#include "dequantize.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+
+#include "../layout/layout.h"
+#include "../target/utils.h"
+#include "../transform/loop_partition.h"
+#include "../transform/loop_vectorize.h"
+#include "parallel.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// The 16 values of the NF4 code book
+static const float kNF4CodeBook[16] = {
+    -1.0f,
+    -0.6961928009986877f,
+    -0.5250730514526367f,
+    -0.39491748809814453f,
+    -0.28444138169288635f,
+    -0.18477343022823334f,
+    -0.09105003625154495f,
+    0.0f,
+    0.07958029955625534f,
+    0.16093020141124725f,
+    0.24611230194568634f,
+    0.33791524171829224f,
+    0.44070982933044434f,
+    0.5626170039176941f,
+    0.7229568362236023f,
+    1.0f,
+};
+
+DequantizeOp::DequantizeOp(Array<PrimExpr> args,
+                           Map<String, ObjectRef> annotations) {
+  /// Dequantize constructor arguments:
+  /// - packed: (N, K / 2) region of 8-bit elements holding two codes each
+  /// - out: (N, K) fragment receiving the decoded elements
+  /// - format: DequantFormatEnum
+  /// - group_size: consecutive elements of a row sharing a scale
+  /// - has_scale, has_zero: whether the regions follow
+  /// - scale, zero: (N, K / group_size), those present in order
+  CHECK_GE(args.size(), 6);
+  ObjectPtr<DequantizeOpNode> node = tvm::ffi::make_object<DequantizeOpNode>();
+  node->packedRegion_ = NormalizeToBufferRegion(args[0]);
+  node->outRegion_ = NormalizeToBufferRegion(args[1]);
+  node->packed = node->packedRegion_->buffer;
+  node->out = node->outRegion_->buffer;
+  node->format = static_cast<int>(args[2].as<IntImmNode>()->value);
+  node->group_size = static_cast<int>(args[3].as<IntImmNode>()->value);
+  size_t next = 6;
+  auto optional_region = [&](int flag, BufferRegion *region, Buffer *buffer) {
+    if (!is_one(args[flag]))
+      return;
+    ICHECK_LT(next, args.size()) << "T.dequantize is missing an operand";
+    *region = NormalizeToBufferRegion(args[next++]);
+    *buffer = (*region)->buffer;
+  };
+  optional_region(4, &node->scaleRegion_, &node->scale);
+  optional_region(5, &node->zeroRegion_, &node->zero);
+  ICHECK_EQ(next, args.size()) << "T.dequantize got unexpected operands";
+
+  const Buffer &out = node->out;
+  ICHECK(IsFragmentBuffer(out) && out->shape.size() == 2 &&
+         out->dtype.is_float())
+      << "T.dequantize expects a floating point (N, K) fragment, got "
+      << out->name << " of shape " << out->shape << " and dtype "
+      << out->dtype << " in " << out.scope();
+  ICHECK(RegionHasShape(node->outRegion_, out->shape))
+      << "T.dequantize decodes whole fragments, got a region of "
+      << out->name;
+  ICHECK(node->format >= int(DequantFormatEnum::kInt4) &&
+         node->format <= int(DequantFormatEnum::kMXFP4))
+      << "Unknown dequantization format " << node->format;
+  arith::Analyzer analyzer;
+  ICHECK(analyzer.CanProveEqual(floormod(out->shape[1], 2), 0))
+      << "T.dequantize expects an even number of columns, got "
+      << out->shape;
+  Array<PrimExpr> packed_shape = {out->shape[0], floordiv(out->shape[1], 2)};
+  DataType packed_dtype = node->packed->dtype;
+  ICHECK((packed_dtype.is_int() || packed_dtype.is_uint()) &&
+         packed_dtype.bits() == 8 && packed_dtype.lanes() == 1)
+      << "T.dequantize expects two codes per int8 or uint8 element, got "
+      << node->packed->name << " of dtype " << packed_dtype;
+  ICHECK(RegionHasShape(node->packedRegion_, packed_shape))
+      << "T.dequantize expects packed elements of shape " << packed_shape
+      << ", got " << node->packedRegion_;
+  if (IsFragmentBuffer(node->packed)) {
+    ICHECK_EQ(node->packed->shape.size(), 2)
+        << "T.dequantize expects a 2D packed fragment, got "
+        << node->packed->shape;
+  }
+
+  ICHECK_GT(node->group_size, 0);
+  ICHECK(analyzer.CanProveEqual(floormod(out->shape[1], node->group_size), 0))
+      << "T.dequantize expects the columns " << out->shape[1]
+      << " to be a multiple of the group size " << node->group_size;
+  Array<PrimExpr> group_shape = {out->shape[0],
+                                 floordiv(out->shape[1], node->group_size)};
+  for (const BufferRegion &region : {node->scaleRegion_, node->zeroRegion_}) {
+    if (!region.defined())
+      continue;
+    ICHECK(!IsFragmentBuffer(region->buffer))
+        << "T.dequantize reads " << region->buffer->name
+        << " from every thread holding a group, so it must not be a fragment";
+    ICHECK(RegionHasShape(region, group_shape))
+        << "T.dequantize expects a region of shape " << group_shape
+        << ", got " << region;
+  }
+  if (node->isMXFP4()) {
+    ICHECK(node->scale.defined() && node->scale->dtype == DataType::UInt(8))
+        << "mxfp4 expects uint8 scales holding e8m0 exponents";
+  } else if (node->scale.defined()) {
+    ICHECK(node->scale->dtype.is_float())
+        << "T.dequantize expects floating point scales, got "
+        << node->scale->dtype;
+  }
+  ICHECK(!node->zero.defined() || node->isInteger())
+      << "T.dequantize only subtracts zero points from integers";
+  data_ = std::move(node);
+}
+
+TileOperator DequantizeOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<DequantizeOpNode>(*this);
+  return DequantizeOp(op);
+}
+
+For DequantizeOpNode::MakeElementwiseLoop(
+    const std::function<Stmt(const Var &, const Var &)> &body) const {
+  Var i("i"), j("j");
+  return For(i, 0, out->shape[0], ForKind::kParallel,
+             For(j, 0, out->shape[1], ForKind::kParallel, body(i, j)));
+}
+
+PrimExpr DequantizeOpNode::MakeDecode(const Var &i, const Var &j) const {
+  DataType i32 = DataType::Int(32);
+  DataType f32 = DataType::Float(32);
+  Array<PrimExpr> index = RegionIndices(packedRegion_, {i, floordiv(j, 2)});
+  PrimExpr byte = cast(i32, BufferLoad(packed, index));
+  PrimExpr code = (byte >> (floormod(j, 2) * 4)) & 15;
+  switch (static_cast<DequantFormatEnum>(format)) {
+  case DequantFormatEnum::kInt4:
+    return cast(f32, (code ^ 8) - 8);
+  case DequantFormatEnum::kUInt4:
+    return cast(f32, code);
+  case DequantFormatEnum::kNF4: {
+    // Binary search of the code book over the bits of the code
+    std::function<PrimExpr(int, int)> lookup = [&](int begin, int width) {
+      if (width == 1)
+        return PrimExpr(make_const(f32, kNF4CodeBook[begin]));
+      int half = width / 2;
+      return Select((code & half) != 0, lookup(begin + half, half),
+                    lookup(begin, half));
+    };
+    return lookup(0, 16);
+  }
+  default: {
+    // e2m1 is (2 + m) * 2^(e - 2), or m / 2 for subnormals
+    PrimExpr e = (code >> 1) & 3;
+    PrimExpr m = code & 1;
+    PrimExpr magnitude =
+        cast(f32, Select(e == 0, m * 2, (m + 2) << e)) * make_const(f32, 0.25);
+    return Select(code >= 8, -magnitude, magnitude);
+  }
+  }
+}
+
+Stmt DequantizeOpNode::MakeOutputStore(const Var &i, const Var &j,
+                                       PrimExpr value) const {
+  DataType f32 = DataType::Float(32);
+  Array<PrimExpr> group = {i, floordiv(j, group_size)};
+  if (zero.defined()) {
+    value = value - cast(f32, BufferLoad(zero, RegionIndices(zeroRegion_,
+                                                             group)));
+  }
+  if (scale.defined()) {
+    PrimExpr factor = BufferLoad(scale, RegionIndices(scaleRegion_, group));
+    if (isMXFP4()) {
+      // The e8m0 exponent is that of 2^(s - 127) in float32
+      factor = reinterpret(f32, cast(DataType::UInt(32), factor) << 23);
+    }
+    value = value * cast(f32, factor);
+  }
+  return BufferStore(out, cast(out->dtype, value), {i, j});
+}
+
+// Offset of element `indices` of `layout` in the thread-local storage
+static PrimExpr LocalOffset(const Fragment &layout,
+                            const Array<PrimExpr> &indices) {
+  Array<PrimExpr> local = layout->Forward(indices);
+  Array<PrimExpr> local_shape = layout->OutputShape();
+  PrimExpr offset = 0;
+  for (size_t d = 0; d < local.size(); ++d) {
+    offset = offset * local_shape[d] + local[d];
+  }
+  return offset;
+}
+
+bool DequantizeOpNode::HoldsPairs(const Fragment &out_layout,
+                                  const Fragment &packed_layout) const {
+  arith::Analyzer analyzer;
+  if (!analyzer.CanProveEqual(out_layout->ReplicateExtent(),
+                              packed_layout->ReplicateExtent()))
+    return false;
+  Var i("i"), j("j"), rep("rep");
+  analyzer.Bind(i, Range(0, out->shape[0]));
+  analyzer.Bind(j, Range(0, floordiv(out->shape[1], 2)));
+  analyzer.Bind(rep, Range(0, out_layout->ReplicateExtent()));
+  PrimExpr even = LocalOffset(out_layout, {i, 2 * j});
+  PrimExpr thread = out_layout->ForwardThread({i, 2 * j}, rep);
+  return analyzer.CanProveEqual(LocalOffset(packed_layout, {i, j}) * 2,
+                                even) &&
+         analyzer.CanProveEqual(LocalOffset(out_layout, {i, 2 * j + 1}),
+                                even + 1) &&
+         analyzer.CanProveEqual(
+             out_layout->ForwardThread({i, 2 * j + 1}, rep), thread) &&
+         analyzer.CanProveEqual(packed_layout->ForwardThread({i, j}, rep),
+                                thread);
+}
+
+Optional<Fragment>
+DequantizeOpNode::PackedLayout(const Fragment &out_layout) const {
+  Var row = InputPlaceholder(0), col = InputPlaceholder(1);
+  PrimExpr thd =
+      out_layout->ForwardThread({row, 2 * col}, ReplicationPlaceholder());
+  Fragment packed_layout =
+      Fragment({out->shape[0], floordiv(out->shape[1], 2)},
+               {floordiv(LocalOffset(out_layout, {row, 2 * col}), 2)}, thd,
+               out_layout->ReplicateExtent(), std::nullopt)
+          ->BindThreadRange(out_layout->ThreadRange());
+  if (!HoldsPairs(out_layout, packed_layout))
+    return std::nullopt;
+  return packed_layout;
+}
+
+Fragment DequantizeOpNode::OutLayout(const Fragment &packed_layout) const {
+  Var row = InputPlaceholder(0), col = InputPlaceholder(1);
+  Array<PrimExpr> pair = {row, floordiv(col, 2)};
+  PrimExpr thd =
+      packed_layout->ForwardThread(pair, ReplicationPlaceholder());
+  return Fragment(out->shape,
+                  {LocalOffset(packed_layout, pair) * 2 + floormod(col, 2)},
+                  thd, packed_layout->ReplicateExtent(), std::nullopt)
+      ->BindThreadRange(packed_layout->ThreadRange());
+}
+
+/**
+ * @brief Lower the decoding of the packed elements.
+ *
+ * When the packed fragment holds, in every thread, the bytes of the pairs of
+ * consecutive thread-local elements of out, as the layout inferred for it
+ * arranges, the bytes are decoded in registers eight elements at a time by
+ * the LOP3 and PRMT sequences of tl_templates/cuda/dequantize.h. Whatever
+ * the layout of out, e.g. the MMA operand layout a gemm gave it, the codes
+ * never go through shared memory. The scales and the zero points, which
+ * depend on the columns of the elements, are applied by a vectorized
+ * elementwise loop afterwards. Otherwise, e.g. for packed elements in shared
+ * memory, every element is decoded in the elementwise loop.
+ */
+Stmt DequantizeOpNode::Lower(const LowerArgs &T,
+                             arith::Analyzer *analyzer) const {
+  Fragment out_layout = T.layout_map[out].as<Fragment>().value();
+  bool fast_decode = false;
+  if (IsFragmentBuffer(packed)) {
+    Fragment packed_layout = T.layout_map[packed].as<Fragment>().value();
+    fast_decode = HoldsPairs(out_layout, packed_layout);
+    if (!fast_decode) {
+      Var i("i"), j("j");
+      arith::Analyzer inner_analyzer;
+      inner_analyzer.Bind(i, Range(0, out->shape[0]));
+      inner_analyzer.Bind(j, Range(0, out->shape[1]));
+      ICHECK(ProveFragmentContains(out_layout, packed_layout, {i, j},
+                                   {i, floordiv(j, 2)}, inner_analyzer))
+          << "T.dequantize decodes " << out->name << " from the threads "
+          << "holding " << packed->name << ", but the layouts differ:\n"
+          << out->name << " = " << out_layout->DebugOutput() << "\n"
+          << packed->name << " = " << packed_layout->DebugOutput();
+    }
+  }
+  PrimExpr num_local = 1;
+  for (const PrimExpr &extent : out_layout->OutputShape()) {
+    num_local = num_local * extent;
+  }
+  const int64_t *p_num_local = as_const_int(num_local);
+  fast_decode = fast_decode && TargetIsCuda(T.target) &&
+                (out->dtype.is_float16() || out->dtype.is_bfloat16()) &&
+                p_num_local && *p_num_local % 8 == 0;
+  if (!fast_decode) {
+    For loop = MakeElementwiseLoop([&](const Var &i, const Var &j) {
+      return MakeOutputStore(i, j, MakeDecode(i, j));
+    });
+    return LowerParallelLoop(loop, out_layout, T.thread_var, analyzer,
+                             T.layout_map);
+  }
+
+  static const char *kDecoders[] = {
+      "tl::dequantize_int4x8", "tl::dequantize_uint4x8",
+      "tl::dequantize_nf4x8", "tl::dequantize_fp4_e2m1x8",
+      "tl::dequantize_fp4_e2m1x8"};
+  Buffer packed_local = T.buffer_remap[packed];
+  Buffer out_local = T.buffer_remap[out];
+  Var r("r");
+  PrimExpr call = Call(
+      DataType::Handle(), builtin::call_extern(),
+      {StringImm(kDecoders[format]),
+       packed_local.access_ptr(1, DataType::Handle(), 1, r * 4, PrimExpr(4)),
+       out_local.access_ptr(2, DataType::Handle(), 1, r * 8, PrimExpr(8))});
+  Array<Stmt> seq;
+  seq.push_back(
+      For(r, 0, static_cast<int>(*p_num_local / 8), ForKind::kUnrolled,
+          Evaluate(call)));
+  if (scale.defined() || zero.defined()) {
+    For loop = MakeElementwiseLoop([&](const Var &i, const Var &j) {
+      PrimExpr decoded = cast(DataType::Float(32), BufferLoad(out, {i, j}));
+      return MakeOutputStore(i, j, decoded);
+    });
+    seq.push_back(LowerParallelLoop(loop, out_layout, T.thread_var, analyzer,
+                                    T.layout_map));
+  }
+  return SeqStmt::Flatten(seq);
+}
+
+/**
+ * @brief Infer the layouts of out and of a packed fragment.
+ *
+ * A layout given to out by another operator, e.g. the operand layout of a
+ * gemm, is kept. A packed fragment without a layout then takes the one
+ * holding the bytes of the thread-local pairs of elements of out in the same
+ * threads, which the copy filling it adopts, and conversely. With neither
+ * laid out, out is laid out as its elementwise loop would be partitioned,
+ * with runs of 8 consecutive columns per thread when they fit.
+ */
+LayoutMap DequantizeOpNode::InferLayout(const LayoutInferArgs &T,
+                                        InferLevel level) const {
+  if (level == InferLevel::kStrict)
+    return {};
+  bool packed_free = IsFragmentBuffer(packed) && !T.layout_map.count(packed);
+  LayoutMap result_map;
+  Fragment out_layout;
+  if (T.layout_map.count(out)) {
+    out_layout = T.layout_map[out].as<Fragment>().value();
+  } else if (IsFragmentBuffer(packed) && !packed_free) {
+    out_layout = OutLayout(T.layout_map[packed].as<Fragment>().value());
+    result_map.Set(out, out_layout);
+  } else if (level == InferLevel::kFree) {
+    For loop = MakeElementwiseLoop([&](const Var &i, const Var &j) {
+      return MakeOutputStore(i, j, MakeDecode(i, j));
+    });
+    int vector_size = 8;
+    PrimExpr num_elems = out->shape[0] * out->shape[1];
+    while (vector_size > 1 &&
+           !T.analyzer->CanProve(
+               floormod(num_elems, T.thread_bounds->extent * vector_size) ==
+               0)) {
+      vector_size /= 2;
+    }
+    out_layout = PlanLoopPartition(loop, vector_size, T.thread_bounds);
+    result_map.Set(out, out_layout);
+  } else {
+    return {};
+  }
+  if (packed_free) {
+    Optional<Fragment> packed_layout = PackedLayout(out_layout);
+    if (!packed_layout.defined()) {
+      std::ostringstream oss;
+      oss << "T.dequantize cannot pair the thread-local elements of "
+          << out->name << " in " << out_layout->DebugOutput() << ", keep "
+          << packed->name << " in shared memory instead";
+      throw LayoutConflictException(oss.str());
+    }
+    result_map.Set(packed, packed_layout.value());
+  }
+  return result_map;
+}
+
+TIR_REGISTER_TL_TILE_OP(DequantizeOp, dequantize)
+    .set_num_inputs(-1)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() { DequantizeOpNode::RegisterReflection(); }
+
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,97 @@
+/*!
+ * \file tl/op/dequantize.h
+ * \brief Decoding of packed 4-bit weights into fragments
+ */
+
+#ifndef TVM_TL_OP_DEQUANTIZE_H_
+#define TVM_TL_OP_DEQUANTIZE_H_
+
+#include "operator.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Encodings of the packed elements, two of them per byte
+enum class DequantFormatEnum : uint8_t {
+  kInt4,    ///< Two's complement integers
+  kUInt4,   ///< Unsigned integers
+  kNF4,     ///< Indices into the normal float code book
+  kFp4E2M1, ///< Floats with a sign, 2 exponent bits and 1 mantissa bit
+  kMXFP4,   ///< kFp4E2M1 scaled by a power of two stored as e8m0
+};
+
+/// Node class for dequantizing packed elements into a fragment
+class DequantizeOpNode : public TileOperatorNode {
+public:
+  tir::Buffer packed; ///< (N, K / 2) 8-bit elements, low nibble first
+  tir::Buffer out;    ///< (N, K) fragment receiving the decoded elements
+  /// Optional (N, K / group_size) scales, and zero points of integers
+  tir::Buffer scale, zero;
+  BufferRegion packedRegion_, outRegion_, scaleRegion_, zeroRegion_;
+  int format;     ///< DequantFormatEnum
+  int group_size; ///< Consecutive elements of a row sharing a scale
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.DequantizeOp", DequantizeOpNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<DequantizeOpNode>()
+        .def_ro("packed", &DequantizeOpNode::packed)
+        .def_ro("out", &DequantizeOpNode::out)
+        .def_ro("scale", &DequantizeOpNode::scale)
+        .def_ro("zero", &DequantizeOpNode::zero)
+        .def_ro("packedRegion", &DequantizeOpNode::packedRegion_)
+        .def_ro("outRegion", &DequantizeOpNode::outRegion_)
+        .def_ro("scaleRegion", &DequantizeOpNode::scaleRegion_)
+        .def_ro("zeroRegion", &DequantizeOpNode::zeroRegion_)
+        .def_ro("format", &DequantizeOpNode::format)
+        .def_ro("group_size", &DequantizeOpNode::group_size);
+  }
+
+  bool isSigned() const { return format == int(DequantFormatEnum::kInt4); }
+  bool isInteger() const {
+    return isSigned() || format == int(DequantFormatEnum::kUInt4);
+  }
+  bool isMXFP4() const { return format == int(DequantFormatEnum::kMXFP4); }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+
+private:
+  /// Parallel loop nest over the elements of out running `body(i, j)`
+  For MakeElementwiseLoop(
+      const std::function<Stmt(const Var &, const Var &)> &body) const;
+  /// Element (i, j) decoded from packed, in float32
+  PrimExpr MakeDecode(const Var &i, const Var &j) const;
+  /// Stores the decoded `value` of element (i, j) to out, after the scale
+  Stmt MakeOutputStore(const Var &i, const Var &j, PrimExpr value) const;
+  /// Whether the thread-local bytes of packed hold the pairs of consecutive
+  /// thread-local elements of out, as the fast decoders expect
+  bool HoldsPairs(const Fragment &out_layout,
+                  const Fragment &packed_layout) const;
+  /// Layout of packed holding the pairs of out, if the pairs are consecutive
+  Optional<Fragment> PackedLayout(const Fragment &out_layout) const;
+  /// Layout of out whose pairs the bytes of packed hold
+  Fragment OutLayout(const Fragment &packed_layout) const;
+};
+
+/// Wrapper class for dequantization
+class DequantizeOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(DequantizeOp, TileOperator,
+                                             DequantizeOpNode);
+  TVM_DLL DequantizeOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_DEQUANTIZE_H_
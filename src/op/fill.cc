@@ -136,11 +136,87 @@ For FillNode::MakeSIMTLoop(arith::Analyzer *analyzer) const {
   return Downcast<For>(body);
 }
 
+/**
+ * @brief Fill a contiguous region of a shared buffer with 128-bit stores.
+ *
+ * The loop partition of the SIMT loop follows the logical shape of the
+ * buffer, so a swizzled or narrow tile is only filled a few elements per
+ * store. When the region covers the whole buffer, its physical layout does
+ * not matter, and otherwise, without a layout, the region is contiguous
+ * when every dimension after the first one of extent other than 1 is full.
+ * Such a region is filled as a flat range of 16-byte vectors, consecutive
+ * vectors going to consecutive threads, so that every warp stores
+ * disjoint, contiguous 512 bytes per iteration without bank conflicts.
+ *
+ * @return The lowered fill, or std::nullopt if the region is not a
+ * contiguous range of whole vectors.
+ */
+Optional<Stmt>
+FillNode::LowerSharedVectorized(const LowerArgs &T,
+                                arith::Analyzer *analyzer) const {
+  DataType dtype = dst->dtype;
+  if (dtype.lanes() != 1 || dtype.bits() % 8 != 0 || 128 % dtype.bits() != 0)
+    return std::nullopt;
+  auto threads = as_const_int(T.thread_bounds->extent);
+  if (!threads)
+    return std::nullopt;
+  int ndim = dst->shape.size();
+  bool full = true;
+  for (int i = 0; i < ndim; i++) {
+    full = full && analyzer->CanProveEqual(region[i]->min, 0) &&
+           analyzer->CanProveEqual(region[i]->extent, dst->shape[i]);
+  }
+
+  Buffer physical = dst;
+  PrimExpr offset = 0;
+  PrimExpr numel = 1;
+  if (T.buffer_remap.count(dst)) {
+    // The whole physical buffer, whichever the layout
+    if (!full)
+      return std::nullopt;
+    physical = T.buffer_remap[dst];
+    for (const PrimExpr &extent : physical->shape) {
+      numel = numel * extent;
+    }
+  } else {
+    bool inner = false;
+    for (int i = 0; i < ndim; i++) {
+      if (inner &&
+          !(analyzer->CanProveEqual(region[i]->min, 0) &&
+            analyzer->CanProveEqual(region[i]->extent, dst->shape[i])))
+        return std::nullopt;
+      inner = inner || !is_one(region[i]->extent);
+      offset = offset * dst->shape[i] + region[i]->min;
+      numel = numel * region[i]->extent;
+    }
+  }
+  int vec = 128 / dtype.bits();
+  auto elems = as_const_int(analyzer->Simplify(numel));
+  if (!elems || *elems % vec != 0 ||
+      !analyzer->CanProveEqual(floormod(offset, vec), 0))
+    return std::nullopt;
+
+  int64_t units = *elems / vec;
+  Var i("i");
+  PrimExpr unit = i * static_cast<int>(*threads) +
+                  (T.thread_var - T.thread_bounds->min);
+  Buffer flat = physical.GetFlattenedBuffer();
+  Stmt body = BufferStore(flat, Broadcast(value, vec),
+                          {Ramp(offset + unit * vec, 1, vec)});
+  if (units % *threads != 0) {
+    body = IfThenElse(unit < static_cast<int>(units), body);
+  }
+  int64_t iters = (units + *threads - 1) / *threads;
+  return For(i, 0, static_cast<int>(iters), ForKind::kSerial, body);
+}
+
 /**
  * @brief Lower this Fill operator to a TIR statement for the target.
  *
  * Lowers the FillNode into a Stmt according to the destination buffer scope:
- * - "local.fragment" and shared ("shared", "shared.dyn"): create a parallel
+ * - shared ("shared", "shared.dyn") regions that are contiguous: see
+ *   LowerSharedVectorized.
+ * - "local.fragment" and other shared regions: create a parallel
  *   operation from a SIMT loop, infer its layout, partition the root loop by
  *   the thread variable, vectorize the resulting thread loop, and, if a
  *   per-thread predicate exists, guard the vectorized loop with that
@@ -180,6 +256,11 @@ Stmt FillNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
         VectorizeLoop(init_loop, analyzer, T.layout_map);
     return vectorized_thread_loop;
   } else if (IsSharedBuffer(dst) || IsGlobalBuffer(dst)) {
+    if (IsSharedBuffer(dst)) {
+      if (auto vectorized = LowerSharedVectorized(T, analyzer)) {
+        return vectorized.value();
+      }
+    }
     auto par_op = ParallelOp(MakeSIMTLoop(analyzer));
     par_op->InferLayout({T.target,
                          T.thread_bounds,
@@ -39,6 +39,9 @@ public:
 private:
   /// Create SIMT-style parallel loop for filling
   For MakeSIMTLoop(arith::Analyzer *analyzer) const;
+  /// Fill a contiguous shared memory region with 128-bit stores
+  Optional<Stmt> LowerSharedVectorized(const LowerArgs &T,
+                                       arith::Analyzer *analyzer) const;
 };
 
 /// Wrapper class for fill operations
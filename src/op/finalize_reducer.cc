@@ -27,9 +27,12 @@ using namespace tir;
  * `args[0]` and sets the reduction operation type from the integer code in
  * `args[1]`.
  *
- * @param args TL operator arguments: expects at least two elements where
- *             `args[0]` is an access pointer identifying the reducer variable
- * and `args[1]` is an integer encoding a `ReducerOpType` (e.g., Sum/Max/Min).
+ * @param args TL operator arguments: `args[0]` is an access pointer
+ * identifying the reducer variable, followed by the index paired with an
+ * argmax/argmin reducer, and the last one is an integer encoding a
+ * `ReducerOpType` (e.g., Sum/Max/ArgMax).
+ * @param annotations Optional `cluster` flag requesting a reduction across the
+ * CTAs of the thread block cluster after the intra-CTA one.
  */
 FinalizeReducerOp::FinalizeReducerOp(Array<PrimExpr> args,
                                      Map<String, ObjectRef> annotations) {
@@ -39,10 +42,48 @@ FinalizeReducerOp::FinalizeReducerOp(Array<PrimExpr> args,
   // underlying Buffer as reducer.
   auto region = NormalizeToBufferRegion(args[0]);
   node->reducer = region->buffer;
-  node->op = (ReducerOpType)*as_const_int(args[1]);
+  if (args.size() > 2) {
+    node->index = NormalizeToBufferRegion(args[1])->buffer;
+  }
+  node->op = (ReducerOpType)*as_const_int(args[args.size() - 1]);
+  if (auto val = annotations.Get("cluster")) {
+    if (auto int_val = val->as<IntImmNode>()) {
+      node->cluster = int_val->value != 0;
+    }
+  }
   data_ = std::move(node);
 }
 
+namespace {
+
+// The tl:: functor combining the partial results of a reducer.
+const char *CombinerName(ReducerOpType op) {
+  switch (op) {
+  case ReducerOpType::SUM:
+    return "tl::SumOp";
+  case ReducerOpType::MAX:
+  case ReducerOpType::ARGMAX:
+  // the updates of absmax reducers already store absolute values
+  case ReducerOpType::ABSMAX:
+    return "tl::MaxOp";
+  case ReducerOpType::MIN:
+  case ReducerOpType::ARGMIN:
+    return "tl::MinOp";
+  case ReducerOpType::PROD:
+    return "tl::ProdOp";
+  case ReducerOpType::BITAND:
+    return "tl::BitAndOp";
+  case ReducerOpType::BITOR:
+    return "tl::BitOrOp";
+  case ReducerOpType::BITXOR:
+    return "tl::BitXorOp";
+  }
+  LOG(FATAL) << "Unknown reducer op " << static_cast<int>(op);
+  return "";
+}
+
+} // namespace
+
 /**
  * @brief Lower the finalize_reducer TL operator to a TIR statement.
  *
@@ -58,6 +99,14 @@ FinalizeReducerOp::FinalizeReducerOp(Array<PrimExpr> args,
  *     T.AddWorkspace when reducing_threads >= 32) and stores the result via
  *     BufferStore.
  * - Wraps the store in parallel outer For loops over each output dimension.
+ *   Reductions wider than a warp whose workspace for the whole reducer fits
+ *   in 16 KiB are instead a single `run_batch<N>` call over the reducer.
+ *   On CUDA, reductions wider than a warp exchange one partial per warp (the
+ *   `*_compact` variants) rather than one per thread.
+ * - For argmax/argmin reducers, then reduces the paired index with MinOp over
+ *   the threads holding the reduced value.
+ * - When `cluster` is set, appends a reduction of the whole reducer across
+ *   the CTAs of the cluster (see MakeClusterAllReduce).
  *
  * @param T Lowering context containing buffer remapping, layout map, thread
  * bounds, target, and helper methods (e.g., AddWorkspace).
@@ -89,41 +138,112 @@ Stmt FinalizeReducerOpNode::Lower(const LowerArgs &T,
       << "Illegal finalize_reducer: extent=" << extent
       << "; T.thread_bounds=" << T.thread_bounds;
 
-  if (extent == 1)
-    return Evaluate(0);
+  std::string op_str = CombinerName(op);
+  bool is_arg = op == ReducerOpType::ARGMAX || op == ReducerOpType::ARGMIN;
+  Buffer index_buffer;
+  if (is_arg) {
+    ICHECK(index.defined())
+        << "finalize_reducer of the argmax/argmin reducer " << reducer->name
+        << " requires its index";
+    ICHECK(StructuralEqual()(index->shape, reducer->shape))
+        << "The index " << index->name << " of the reducer " << reducer->name
+        << " must have its shape " << reducer->shape << ", but got "
+        << index->shape;
+    index_buffer = T.buffer_remap[index];
+  }
+  Optional<Stmt> cluster_reduce;
+  if (cluster) {
+    ICHECK(!is_arg) << "Cluster reductions of argmax/argmin reducers are not "
+                       "supported";
+    cluster_reduce = MakeClusterAllReduce(T, buffer, op_str);
+  }
 
-  std::array op_names{"tl::SumOp", "tl::MaxOp", "tl::MinOp"};
-  auto op_str = op_names[(int)op];
+  if (extent == 1)
+    return cluster_reduce.value_or(Evaluate(0));
 
   // adopted from ReduceOp
   int reducing_threads = extent;
-  std::stringstream ss;
-  auto thread_offset = T.thread_bounds->min;
-  if (TargetIsHopper(T.target) || TargetIsSm100(T.target) ||
-      TargetIsSM120(T.target)) {
-    auto all_threads = T.thread_bounds->extent;
-    ss << "tl::AllReduce<" << op_str << ", " << reducing_threads << ", " << 1
-       << ", " << thread_offset << ", " << all_threads << ">::run_hopper";
-  } else {
-    ss << "tl::AllReduce<" << op_str << ", " << reducing_threads << ", " << 1
-       << ", " << thread_offset << ">::run";
+  int64_t num_elems = 1;
+  for (const PrimExpr &e : layout->OutputShape()) {
+    const int64_t *p_e = as_const_int(e);
+    num_elems = (p_e && num_elems > 0) ? num_elems * (*p_e) : -1;
   }
-  Array<PrimExpr> thread_reduce_args = {StringImm(ss.str()),
-                                        BufferLoad(buffer, indices_0)};
-  if (reducing_threads >= 32) {
+  // Every thread holds a copy of each element, but after the warp stage the
+  // copies of a warp agree: reductions wider than a warp only exchange one
+  // partial per warp through shared memory.
+  bool compact = TargetIsCuda(T.target) && reducing_threads > 32;
+  int64_t workspace_elems = compact ? reducing_threads / 32 : reducing_threads;
+  // Reductions across warps exchange all the elements at once when their
+  // workspace stays small, sharing the barriers of the exchange.
+  constexpr int64_t kMaxBatchWorkspaceBytes = 16 * 1024;
+  bool batched = TargetIsCuda(T.target) && !is_arg && reducing_threads > 32 &&
+                 num_elems > 1 &&
+                 num_elems * workspace_elems * buffer->dtype.bytes() <=
+                     kMaxBatchWorkspaceBytes;
+  bool use_named_barrier = TargetIsHopper(T.target) ||
+                           TargetIsSm100(T.target) || TargetIsSM120(T.target);
+  std::string method = batched ? "run_batch" : "run";
+  if (compact)
+    method += "_compact";
+  if (use_named_barrier)
+    method += "_hopper";
+  auto thread_offset = T.thread_bounds->min;
+  auto all_reduce_name = [&](const std::string &combiner) {
+    std::stringstream ss;
+    ss << "tl::AllReduce<" << combiner << ", " << reducing_threads << ", "
+       << 1 << ", " << thread_offset;
+    if (use_named_barrier || batched) {
+      ss << ", " << T.thread_bounds->extent;
+    }
+    ss << ">::" << method;
+    return ss.str();
+  };
+  Stmt body;
+  if (batched) {
     PrimExpr workspace =
-        T.AddWorkspace(*as_const_int(T.thread_bounds->extent), buffer->dtype);
-    thread_reduce_args.push_back(workspace);
-  }
-  auto call = Call(buffer->dtype, builtin::call_extern(), thread_reduce_args);
-  Stmt body = BufferStore(buffer, call, indices_0);
+        T.AddWorkspace(num_elems * workspace_elems, buffer->dtype);
+    std::string name =
+        all_reduce_name(op_str) + "<" + std::to_string(num_elems) + ">";
+    body = Evaluate(Call(DataType::Handle(), builtin::call_extern(),
+                         {StringImm(name), buffer.access_ptr(3), workspace}));
+  } else {
+    auto all_reduce = [&](const std::string &combiner, const PrimExpr &value) {
+      Array<PrimExpr> thread_reduce_args = {
+          StringImm(all_reduce_name(combiner)), value};
+      if (reducing_threads >= 32) {
+        int64_t elems =
+            compact ? workspace_elems : *as_const_int(T.thread_bounds->extent);
+        thread_reduce_args.push_back(T.AddWorkspace(elems, value.dtype()));
+      }
+      return Call(value.dtype(), builtin::call_extern(), thread_reduce_args);
+    };
+    PrimExpr value = BufferLoad(buffer, indices_0);
+    if (is_arg) {
+      // Reduce the values, then the indices of the threads that hold the
+      // result, so that ties resolve to the smallest index.
+      Var reduced("__finred_value", buffer->dtype);
+      PrimExpr idx = BufferLoad(index_buffer, indices_0);
+      PrimExpr candidate =
+          Select(value == reduced, idx, max_value(index_buffer->dtype));
+      body = LetStmt(
+          reduced, all_reduce(op_str, value),
+          SeqStmt({BufferStore(index_buffer, candidate, indices_0),
+                   BufferStore(buffer, reduced, indices_0),
+                   BufferStore(index_buffer, all_reduce("tl::MinOp", idx),
+                               indices_0)}));
+    } else {
+      body = BufferStore(buffer, all_reduce(op_str, value), indices_0);
+    }
 
-  // make the outer spatial loop
-  for (int i = layout->OutputDim() - 1; i >= 0; i--) {
-    body = For(indices_0[i].as<Var>().value(), 0, layout->OutputShape()[i],
-               ForKind::kParallel, body);
+    // make the outer spatial loop
+    for (int i = layout->OutputDim() - 1; i >= 0; i--) {
+      body = For(indices_0[i].as<Var>().value(), 0, layout->OutputShape()[i],
+                 ForKind::kParallel, body);
+    }
   }
 
+  if (cluster_reduce)
+    return SeqStmt({body, cluster_reduce.value()});
   return body;
 }
 
@@ -132,7 +252,8 @@ Stmt FinalizeReducerOpNode::Lower(const LowerArgs &T,
  *
  * Copies the existing layout for the reducer from the provided LayoutInferArgs
  * into a new LayoutMap and returns it. The inference does not modify the
- * layout; it preserves the reducer's current layout.
+ * layout; it preserves the reducer's current layout. The index of an
+ * argmax/argmin reducer shares it.
  *
  * @param T Provides the input layout map from which the reducer's layout is
  * copied.
@@ -143,7 +264,11 @@ Stmt FinalizeReducerOpNode::Lower(const LowerArgs &T,
 LayoutMap FinalizeReducerOpNode::InferLayout(const LayoutInferArgs &T,
                                              InferLevel level) const {
   LayoutMap layout_map;
-  layout_map.Set(reducer, T.layout_map.Get(reducer).value());
+  auto layout = T.layout_map.Get(reducer).value();
+  layout_map.Set(reducer, layout);
+  if (index.defined()) {
+    layout_map.Set(index, T.layout_map.Get(index).value_or(layout));
+  }
   return layout_map;
 }
 
@@ -11,6 +11,7 @@
 
 #include "../transform/layout_reducer.h"
 #include "./operator.h"
+#include "./reduce.h"
 
 /**
  * Get the Op singleton for the public FinalizeReducerOp handle.
@@ -25,7 +26,11 @@ using namespace tir;
 class FinalizeReducerOpNode : public TileOperatorNode {
 public:
   tir::Buffer reducer;
+  // Index paired with an argmax/argmin reducer, undefined otherwise.
+  tir::Buffer index;
   ReducerOpType op;
+  // Also reduce across the CTAs of the thread block cluster.
+  bool cluster{false};
 
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.FinalizeReducerOp",
                                     FinalizeReducerOpNode, TileOperatorNode);
@@ -34,7 +39,9 @@ public:
     namespace refl = tvm::ffi::reflection;
     refl::ObjectDef<FinalizeReducerOpNode>()
         .def_ro("reducer", &FinalizeReducerOpNode::reducer)
-        .def_ro("op", &FinalizeReducerOpNode::op);
+        .def_ro("index", &FinalizeReducerOpNode::index)
+        .def_ro("op", &FinalizeReducerOpNode::op)
+        .def_ro("cluster", &FinalizeReducerOpNode::cluster);
   }
 
   Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
@@ -0,0 +1,367 @@
+/*!
+ * \file tl/op/gather_copy.cc
+ *
+ * Define the gather copy operator, used to load paged KV-cache rows.
+ */
+
+#include "gather_copy.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+
+#include "../layout/layout.h"
+#include "../target/utils.h"
+#include "../transform/common/loop_fusion_utils.h"
+#include "../transform/loop_partition.h"
+#include "../transform/loop_vectorize.h"
+#include "builtin.h"
+#include "copy.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+// Rows loaded by one tile::gather4 instruction.
+static constexpr int kGatherRows = 4;
+
+/**
+ * @brief Construct a GatherCopy operator from call arguments.
+ *
+ * @param args Call arguments: [src_region, table_region, dst_region,
+ * page_size, offset].
+ */
+GatherCopy::GatherCopy(Array<PrimExpr> args,
+                       Map<String, ObjectRef> annotations) {
+  ObjectPtr<GatherCopyNode> node = tvm::ffi::make_object<GatherCopyNode>();
+  BufferRegion src = NormalizeToBufferRegion(args[0]);
+  BufferRegion table = NormalizeToBufferRegion(args[1]);
+  BufferRegion dst = NormalizeToBufferRegion(args[2]);
+  node->src = src->buffer;
+  node->src_range = src->region;
+  node->table = table->buffer;
+  node->table_range = table->region;
+  node->dst = dst->buffer;
+  node->dst_range = dst->region;
+  node->page_size = args[3];
+  node->offset = args[4];
+  ICHECK(IsGlobalBuffer(node->src))
+      << "T.gather_copy expects a global source, got `" << node->src->name
+      << "` in scope " << node->src.scope();
+  ICHECK(node->table->dtype.is_int() || node->table->dtype.is_uint())
+      << "T.gather_copy expects an integer index table, got "
+      << node->table->dtype;
+  ICHECK(!node->src_range.empty() && !node->table_range.empty());
+  data_ = std::move(node);
+}
+
+TileOperator GatherCopyNode::Clone() const {
+  auto op = tvm::ffi::make_object<GatherCopyNode>(*this);
+  if (par_op_.defined()) {
+    op->par_op_ = Downcast<ParallelOp>(par_op_->Clone());
+  }
+  return GatherCopy(op);
+}
+
+PrimExpr GatherCopyNode::GatheredRow(PrimExpr row) const {
+  DataType dtype = src_range[0]->min.dtype();
+  PrimExpr logical = cast(dtype, offset) + cast(dtype, row);
+  PrimExpr size = cast(dtype, page_size);
+  Array<PrimExpr> table_indices;
+  for (const Range &r : table_range) {
+    table_indices.push_back(r->min);
+  }
+  int last = table_indices.size() - 1;
+  DataType index_dtype = table_indices[last].dtype();
+  table_indices.Set(last, table_indices[last] +
+                              cast(index_dtype, floordiv(logical, size)));
+  PrimExpr page = cast(dtype, BufferLoad(table, table_indices));
+  if (is_one(page_size)) {
+    return src_range[0]->min + page;
+  }
+  return src_range[0]->min + page * size + floormod(logical, size);
+}
+
+For GatherCopyNode::MakeSIMTLoop(arith::Analyzer *analyzer) const {
+  Array<IterVar> loop_vars;
+  for (size_t i = 0; i < dst_range.size(); i++) {
+    if (is_one(dst_range[i]->extent))
+      continue;
+    Var var = Var(std::string{char('i' + loop_vars.size())},
+                  dst_range[i]->extent->dtype);
+    loop_vars.push_back(
+        {Range(0, dst_range[i]->extent), var, IterVarType::kDataPar});
+  }
+  ICHECK(!loop_vars.empty())
+      << "T.gather_copy expects at least one gathered row in " << dst->name;
+  for (const auto &iv : loop_vars)
+    analyzer->Bind(iv->var, iv->dom);
+
+  // The first loop walks the gathered rows, the others the copied dims.
+  Array<PrimExpr> dst_indices;
+  size_t idx = 0;
+  for (const Range &r : dst_range) {
+    if (is_one(r->extent)) {
+      dst_indices.push_back(r->min);
+    } else {
+      dst_indices.push_back(r->min + loop_vars[idx++]->var);
+    }
+  }
+  Array<PrimExpr> src_indices{GatheredRow(loop_vars[0]->var)};
+  idx = 1;
+  for (size_t i = 1; i < src_range.size(); i++) {
+    if (is_one(src_range[i]->extent)) {
+      src_indices.push_back(src_range[i]->min);
+      continue;
+    }
+    ICHECK(idx < loop_vars.size() &&
+           analyzer->CanProveEqual(src_range[i]->extent,
+                                   loop_vars[idx]->dom->extent))
+        << "T.gather_copy region mismatch: " << src->name << src_range
+        << " vs. " << dst->name << dst_range;
+    src_indices.push_back(src_range[i]->min + loop_vars[idx++]->var);
+  }
+  ICHECK(idx == loop_vars.size())
+      << "T.gather_copy region mismatch: " << src->name << src_range << " vs. "
+      << dst->name << dst_range;
+
+  PrimExpr value = BufferLoad(src, src_indices);
+  if (src->dtype != dst->dtype)
+    value = Cast(dst->dtype, value);
+  Stmt body = BufferStore(dst, value, dst_indices);
+  for (int i = loop_vars.size() - 1; i >= 0; i--) {
+    body = For(loop_vars[i]->var, 0, loop_vars[i]->dom->extent,
+               ForKind::kParallel, body);
+  }
+  return Downcast<For>(body);
+}
+
+// Bulk copies move whole rows of a 2D global source into a 2D shared tile,
+// both with 16-byte multiple row sizes.
+bool GatherCopyNode::CheckBulkGather(Target target,
+                                     arith::Analyzer *analyzer) const {
+  if (!TargetHasBulkCopy(target) || !IsSharedBuffer(dst))
+    return false;
+  if (tvm::transform::PassContext::Current()
+          ->GetConfig<Bool>(kDisableTMALower, Bool(false))
+          .value())
+    return false;
+  if (src->dtype != dst->dtype || src->shape.size() != 2 ||
+      dst->shape.size() != 2 || !src->strides.empty())
+    return false;
+  const auto *rows = as_const_int(dst_range[0]->extent);
+  const auto *cols = as_const_int(dst_range[1]->extent);
+  if (rows == nullptr || cols == nullptr)
+    return false;
+  if (!analyzer->CanProveEqual(src_range[1]->extent, dst_range[1]->extent))
+    return false;
+  int bytes = src->dtype.bytes();
+  const auto *row_elems = as_const_int(src->shape[1]);
+  return (*cols * bytes) % 16 == 0 &&
+         (row_elems == nullptr || (*row_elems * bytes) % 16 == 0);
+}
+
+/**
+ * @brief Lower to one tile::gather4 TMA load per four rows.
+ *
+ * The descriptor covers the whole source with a box of one row, the four row
+ * coordinates come from the table. Swizzled shared layouts are loaded in
+ * chunks of the swizzle width, in the chunk-major order T.copy uses for
+ * them. Other layouts fall back to the row-wise bulk loads.
+ */
+Stmt GatherCopyNode::LowerGather4(const LowerArgs &T,
+                                  arith::Analyzer *analyzer) const {
+  Buffer shared_tensor = dst;
+  int rows = *as_const_int(dst_range[0]->extent);
+  int cols = *as_const_int(dst_range[1]->extent);
+  int bytes = src->dtype.bytes();
+  bool full_tile = is_zero(dst_range[0]->min) && is_zero(dst_range[1]->min) &&
+                   analyzer->CanProveEqual(dst->shape[0], rows) &&
+                   analyzer->CanProveEqual(dst->shape[1], cols);
+
+  int swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_NONE);
+  int swizzle_bytes = 0;
+  if (T.layout_map.count(dst)) {
+    Layout layout = T.layout_map.at(dst);
+    shared_tensor = T.buffer_remap.at(dst);
+    const auto *stride = as_const_int(dst->shape[0]);
+    const auto *continuous = as_const_int(dst->shape[1]);
+    int bits = dst->dtype.bits();
+    auto matches = [&](Layout (*make)(int, int, int)) {
+      return StructuralEqual()(layout, make(*stride, *continuous, bits));
+    };
+    if (StructuralEqual()(layout, makeLinearLayout(dst->shape))) {
+      swizzle_bytes = 0;
+    } else if (stride == nullptr || continuous == nullptr) {
+      return LowerBulkRows(T, analyzer);
+    } else if (matches(makeQuarterBankSwizzleLayout)) {
+      swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_32B);
+      swizzle_bytes = 32;
+    } else if (matches(makeHalfBankSwizzleLayout)) {
+      swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_64B);
+      swizzle_bytes = 64;
+    } else if (matches(makeFullBankSwizzleLayout)) {
+      swizzle = static_cast<int>(CU_TENSOR_MAP_SWIZZLE_128B);
+      swizzle_bytes = 128;
+    } else {
+      return LowerBulkRows(T, analyzer);
+    }
+  }
+  int box = swizzle_bytes ? swizzle_bytes / bytes : cols;
+  if (box > 256 || cols % box != 0 || (swizzle_bytes && !full_tile) ||
+      !analyzer->CanProveEqual(dst->shape[1], cols) ||
+      !is_zero(dst_range[1]->min))
+    return LowerBulkRows(T, analyzer);
+
+  TMADesc desc;
+  desc.rank = 2;
+  desc.data_type = to_CUtensorMapDataType(src->dtype);
+  desc.global_addr = src->data;
+  desc.global_shape = ReverseArray(src->shape);
+  desc.global_stride = {make_const(DataType::Int(64), bytes),
+                        cast(DataType::Int(64), src->shape[1]) * bytes};
+  desc.smem_box = {box, 1};
+  desc.smem_stride = {1, 1};
+  desc.interleave = static_cast<int>(CU_TENSOR_MAP_INTERLEAVE_NONE);
+  desc.swizzle = swizzle;
+  desc.l2_promotion = static_cast<int>(CU_TENSOR_MAP_L2_PROMOTION_L2_128B);
+  desc.oob_fill = static_cast<int>(CU_TENSOR_MAP_FLOAT_OOB_FILL_NONE);
+  PrimExpr descriptor =
+      Call(DataType::Handle(), create_tma_descriptor(), desc.EncodeCallArgs());
+
+  Var group("g"), chunk("k");
+  PrimExpr first_row = dst_range[0]->min + group * kGatherRows;
+  PrimExpr smem_offset =
+      first_row * box + chunk * (box * cast(first_row.dtype(), dst->shape[0]));
+  Array<PrimExpr> args{descriptor, 0,
+                       shared_tensor.access_ptr(2, DataType::Handle(), 1,
+                                                smem_offset,
+                                                kGatherRows * box)};
+  args.push_back(cast(DataType::Int(32), src_range[1]->min + chunk * box));
+  for (int r = 0; r < kGatherRows; r++) {
+    args.push_back(cast(DataType::Int(32),
+                        GatheredRow(group * kGatherRows + r)));
+  }
+  args.push_back(0); // eviction policy
+  Map<String, ObjectRef> op_annotations;
+  op_annotations.Set(attr::kTMAGather4, Integer(1));
+  Stmt body = Evaluate(Call(DataType::Handle(), tma_load(), args,
+                            op_annotations));
+  body = For(chunk, 0, cols / box, ForKind::kUnrolled, body);
+  body = For(group, 0, rows / kGatherRows, ForKind::kUnrolled, body);
+  return IfThenElse(EQ(T.thread_var, T.thread_bounds->min), body);
+}
+
+/**
+ * @brief Lower to one 1D bulk TMA load per gathered row.
+ *
+ * Used on sm90, and on sm100 when the rows do not come in groups of four.
+ * Rows land contiguously, so only a linear shared layout qualifies.
+ */
+Stmt GatherCopyNode::LowerBulkRows(const LowerArgs &T,
+                                   arith::Analyzer *analyzer) const {
+  Buffer shared_tensor = dst;
+  if (T.layout_map.count(dst)) {
+    if (!StructuralEqual()(T.layout_map.at(dst), makeLinearLayout(dst->shape)))
+      return LowerNormal(T, analyzer);
+    shared_tensor = T.buffer_remap.at(dst);
+  }
+  int bytes = src->dtype.bytes();
+  Var row("r", dst_range[0]->min.dtype());
+  DataType dtype = src_range[0]->min.dtype();
+  PrimExpr src_offset = GatheredRow(row) * cast(dtype, src->shape[1]) +
+                        cast(dtype, src_range[1]->min);
+  PrimExpr dst_offset =
+      (dst_range[0]->min + row) * dst->shape[1] + dst_range[1]->min;
+  // The table entry is unknown, only the row pitch and column offsets count.
+  Var probe("p", dtype);
+  for (PrimExpr offset :
+       {probe * cast(dtype, src->shape[1]) + cast(dtype, src_range[1]->min),
+        dst_offset}) {
+    arith::ModularSet mod = analyzer->modular_set(offset * bytes);
+    if (mod->coeff % 16 != 0 || mod->base % 16 != 0)
+      return LowerNormal(T, analyzer);
+  }
+  PrimExpr elements = dst_range[1]->extent;
+  PrimExpr shared_addr = shared_tensor.access_ptr(2, DataType::Handle(), 1,
+                                                  dst_offset, elements);
+  PrimExpr global_addr =
+      src.access_ptr(1, DataType::Handle(), 1, src_offset, elements);
+  // the zero is a placeholder for mbarrier ids
+  Array<PrimExpr> args{shared_addr, global_addr, 0, elements * bytes, 0};
+  Stmt body = Evaluate(Call(DataType::Handle(), tma_load(), args));
+  body = For(row, 0, dst_range[0]->extent, ForKind::kSerial, body);
+  return IfThenElse(EQ(T.thread_var, T.thread_bounds->min), body);
+}
+
+Stmt GatherCopyNode::LowerNormal(const LowerArgs &T,
+                                 arith::Analyzer *analyzer) const {
+  auto simt_loop = MakeSIMTLoop(analyzer);
+  auto fused_loop = Downcast<For>(ParallelLoopFuser::Fuse(simt_loop));
+  if (T.target->GetTargetDeviceType() == kDLCPU || IsLocalBuffer(dst)) {
+    return VectorizeLoop(fused_loop, T.layout_map);
+  }
+  auto par_op = ParallelOp(fused_loop);
+  for (auto level :
+       {InferLevel::kCommon, InferLevel::kStrict, InferLevel::kFree}) {
+    par_op->InferLayout({T.target,
+                         T.thread_bounds,
+                         T.layout_map,
+                         analyzer,
+                         false,
+                         T.buffer_remap,
+                         {}},
+                        level);
+  }
+  return LowerParallelLoop(par_op->GetRoot(), par_op->GetLoopLayout(),
+                           T.thread_var, analyzer, T.layout_map,
+                           par_op->GetPredicate(T.thread_var));
+}
+
+/**
+ * @brief Lower the gather copy.
+ *
+ * Targets with bulk copies issue TMA loads completed through the mbarrier of
+ * the pipeline like the bulk loads of T.copy: tile::gather4 on sm100, one 1D
+ * bulk load per row otherwise. Other cases lower to a SIMT loop whose
+ * innermost dimension is vectorized; the table entry only depends on the row,
+ * so global to shared loads become 16-byte cp.async on sm80+ and plain buffer
+ * loads on HIP.
+ */
+Stmt GatherCopyNode::Lower(const LowerArgs &T,
+                           arith::Analyzer *analyzer) const {
+  if (!CheckBulkGather(T.target, analyzer)) {
+    return LowerNormal(T, analyzer);
+  }
+  if (TargetIsSm100(T.target) &&
+      *as_const_int(dst_range[0]->extent) % kGatherRows == 0) {
+    return LowerGather4(T, analyzer);
+  }
+  return LowerBulkRows(T, analyzer);
+}
+
+// Layouts follow T.copy: a TMA load leaves the shared layout to its consumer,
+// a SIMT loop infers its loop layout through ParallelOp.
+LayoutMap GatherCopyNode::InferLayout(const LayoutInferArgs &T,
+                                      InferLevel level) const {
+  if (CheckBulkGather(T.target, T.analyzer)) {
+    return {};
+  }
+  if (!par_op_.defined()) {
+    arith::Analyzer analyzer;
+    par_op_ = ParallelOp(MakeSIMTLoop(&analyzer));
+  }
+  return par_op_->InferLayout(T, level);
+}
+
+TIR_REGISTER_TL_TILE_OP(GatherCopy, gather_copy)
+    .set_num_inputs(5)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() { GatherCopyNode::RegisterReflection(); }
+
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,89 @@
+/*!
+ * \file tl/op/gather_copy.h
+ * \brief Copy of rows gathered through an index (page) table
+ */
+
+#ifndef TVM_TL_OP_GATHER_COPY_H_
+#define TVM_TL_OP_GATHER_COPY_H_
+
+#include "operator.h"
+#include "parallel.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/*!
+ * \brief Node class for gather copies.
+ *
+ * Row `i` of the first non-unit dimension of `dst` is read from row
+ * `src_range[0]->min + table[t / page_size] * page_size + t % page_size` of
+ * `src`, with `t = offset + i` and the table indexed along the last dimension
+ * of `table_range`. The remaining non-unit dimensions are copied as T.copy
+ * does, so `page_size = 1` gathers single rows through a plain index table.
+ */
+class GatherCopyNode : public TileOperatorNode {
+public:
+  tir::Buffer src;          ///< Global buffer the rows are gathered from
+  tir::Buffer table;        ///< Buffer holding the page (or row) indices
+  tir::Buffer dst;          ///< Destination buffer
+  Array<Range> src_range;   ///< Source region, dim 0 is the gathered one
+  Array<Range> table_range; ///< Region of the table, indexed on its last dim
+  Array<Range> dst_range;   ///< Destination region
+  PrimExpr page_size;       ///< Rows per table entry
+  PrimExpr offset;          ///< Logical row of the first destination row
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.GatherCopy", GatherCopyNode,
+                                    TileOperatorNode);
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  LayoutMap InferLayout(const LayoutInferArgs &T, InferLevel level) const;
+  static const Op &Get();
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<GatherCopyNode>()
+        .def_ro("src", &GatherCopyNode::src)
+        .def_ro("table", &GatherCopyNode::table)
+        .def_ro("dst", &GatherCopyNode::dst)
+        .def_ro("src_range", &GatherCopyNode::src_range)
+        .def_ro("table_range", &GatherCopyNode::table_range)
+        .def_ro("dst_range", &GatherCopyNode::dst_range)
+        .def_ro("page_size", &GatherCopyNode::page_size)
+        .def_ro("offset", &GatherCopyNode::offset);
+  }
+
+  TileOperator Clone() const;
+
+private:
+  /// Source row of the `row`-th gathered destination row
+  PrimExpr GatheredRow(PrimExpr row) const;
+  /// Create SIMT-style parallel loop for the gather
+  For MakeSIMTLoop(arith::Analyzer *analyzer) const;
+  /// Whether the gather can use TMA loads, independent of the dst layout
+  bool CheckBulkGather(Target target, arith::Analyzer *analyzer) const;
+  /// Lower to tile::gather4 loads, falling back to the row-wise bulk loads
+  Stmt LowerGather4(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  /// Lower to one 1D bulk load per row, falling back to the SIMT loop
+  Stmt LowerBulkRows(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  /// Lower to a partitioned and vectorized SIMT loop
+  Stmt LowerNormal(const LowerArgs &T, arith::Analyzer *analyzer) const;
+
+  mutable ParallelOp par_op_; // Layout inference of the SIMT loop
+};
+
+/// Wrapper class for gather copies
+class GatherCopy : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(GatherCopy, TileOperator,
+                                             GatherCopyNode);
+  TVM_DLL
+  GatherCopy(Array<PrimExpr> args,
+             Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_GATHER_COPY_H_
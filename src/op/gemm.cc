@@ -133,6 +133,8 @@ GemmInst GemmNode::getGemmInst(int block_size, Target target) const {
     return GemmInst::kWGMMA;
   } else if (TargetIsCDNA(target)) {
     return GemmInst::kMFMA;
+  } else if (TargetIsRDNA(target)) {
+    return GemmInst::kWMMA;
   } else if (TargetIsCuda(target)) {
     return GemmInst::kMMA;
   } else {
@@ -155,7 +157,7 @@ std::pair<int, int> GemmWarpPolicyNode::computeWarpPartition(
   int kNPerWarp = 8;            // Columns processed by a single warp
   if (TargetIsVolta(target)) {
     kNPerWarp = 16;
-  } else if (TargetIsCDNA(target)) {
+  } else if (TargetIsCDNA(target) || TargetIsRDNA(target)) {
     kNPerWarp = 16;
   }
   ICHECK(M % kMPerWarp == 0)
@@ -438,9 +440,76 @@ static int GetArchInt(Target target) {
  * nullptr).
  * @return Stmt A TIR statement representing the evaluated TL GEMM call.
  */
+Stmt LowerCPUGemm(const LowerArgs &T, const BufferRegion &a_region,
+                  const BufferRegion &b_region, const BufferRegion &c_region,
+                  bool trans_a, bool trans_b, int m, int n, int k,
+                  int stride_a, int stride_b, const PrimExpr &clear_accum) {
+  for (const auto &region : {a_region, b_region, c_region}) {
+    ICHECK(!IsFragmentBuffer(region->buffer))
+        << "gemm on CPU targets expects local or global buffers, allocate "
+        << region->buffer->name << " with T.alloc_local instead of "
+        << "T.alloc_fragment";
+  }
+  auto clear_accum_bool = clear_accum.as<Bool>();
+  ICHECK(clear_accum_bool.has_value())
+      << "clear_accum must be a constant Bool type, got " << clear_accum;
+
+  if (T.target->kind->name == "c") {
+    const int64_t *ldc = as_const_int(c_region->buffer->shape.back());
+    ICHECK(ldc) << "gemm on CPU targets requires a static C buffer shape";
+    std::stringstream ss;
+    ss << "tl::gemm_ss<" << m << ", " << n << ", " << k << ", " << trans_a
+       << ", " << trans_b << ", " << bool(clear_accum_bool.value()) << ", "
+       << stride_a << ", " << stride_b << ", " << *ldc << ">";
+    PrimExpr a_ptr = MakeAccessPtrFromRegion(a_region, 1, true);
+    PrimExpr b_ptr = MakeAccessPtrFromRegion(b_region, 1, true);
+    PrimExpr c_ptr = MakeAccessPtrFromRegion(c_region, 3, true);
+    return Evaluate(Call(DataType::Handle(), tl_gemm(),
+                         {StringImm(ss.str()), a_ptr, b_ptr, c_ptr}));
+  }
+
+  // Element (row, col) of the trailing two dimensions of a region.
+  auto element = [](const BufferRegion &region, PrimExpr row, PrimExpr col) {
+    Array<PrimExpr> indices;
+    size_t ndim = region->region.size();
+    for (size_t i = 0; i + 2 < ndim; ++i) {
+      indices.push_back(region->region[i]->min);
+    }
+    indices.push_back(region->region[ndim - 2]->min + row);
+    indices.push_back(region->region[ndim - 1]->min + col);
+    return BufferLoad(region->buffer, indices);
+  };
+  DataType accum_dtype = c_region->buffer->dtype;
+  Var i("i"), j("j"), kk("k");
+  BufferLoad a = trans_a ? element(a_region, kk, i) : element(a_region, i, kk);
+  BufferLoad b = trans_b ? element(b_region, j, kk) : element(b_region, kk, j);
+  BufferLoad c = element(c_region, i, j);
+  Stmt update = BufferStore(
+      c->buffer, c + Cast(accum_dtype, a) * Cast(accum_dtype, b), c->indices);
+  // i-k-j order keeps the innermost accesses of B and C contiguous.
+  Stmt body = For(kk, 0, k, ForKind::kSerial, For(j, 0, n, ForKind::kSerial,
+                                                   update));
+  if (clear_accum_bool.value()) {
+    Var jc("j");
+    BufferLoad c_clear = element(c_region, i, jc);
+    Stmt clear = For(jc, 0, n, ForKind::kSerial,
+                     BufferStore(c_clear->buffer, make_zero(accum_dtype),
+                                 c_clear->indices));
+    body = SeqStmt({clear, body});
+  }
+  return For(i, 0, m, ForKind::kSerial, body);
+}
+
 Stmt GemmNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
+  if (TargetIsCPU(T.target)) {
+    return LowerCPUGemm(T, aRegion_, bRegion_, cRegion_, transA_, transB_, m_,
+                        n_, k_, strideA_, strideB_, clearAccum_);
+  }
   auto block_size = *as_const_int(T.thread_bounds->extent);
   GemmInst gemm_inst = getGemmInst(block_size, T.target);
+  ICHECK(gemm_inst != GemmInst::kWMMA)
+      << "RDNA WMMA gemm has no template implementation, it is only lowered "
+         "by T.gemm_v2, unset TILELANG_USE_GEMM_V1";
   auto [warp_m, warp_n] =
       policy_->computeWarpPartition(m_, n_, block_size, T.target, gemm_inst);
 
@@ -600,6 +669,11 @@ LayoutMap GemmNode::InferLayout(const LayoutInferArgs &T,
   if (completed_)
     return {};
   LayoutMap results;
+  if (TargetIsCPU(T.target)) {
+    // CPU gemms operate on plain row-major local buffers.
+    completed_ = true;
+    return results;
+  }
   auto thread_range = T.thread_bounds;
   auto block_size = *as_const_int(thread_range->extent);
   GemmInst gemm_inst = getGemmInst(block_size, T.target);
@@ -39,7 +39,15 @@ inline const char *GemmWarpPolicyTypeToString(GemmWarpPolicyType type) {
 }
 
 // Target GEMM instruction
-enum class GemmInst : uint8_t { kMMA, kWGMMA, kTCGEN5MMA, kMFMA };
+enum class GemmInst : uint8_t {
+  kMMA,
+  kWGMMA,
+  kTCGEN5MMA,
+  kMFMA,
+  kWMMA,
+  kGEMV, ///< SIMT FMAs for skinny M, K split over the lanes of a warp
+  kMetalSimdgroup, ///< simdgroup_matrix 8x8 multiply-accumulates of Metal
+};
 
 /// Convert GemmInst enum to string for debugging
 inline const char *GemmInstToString(GemmInst inst) {
@@ -52,6 +60,12 @@ inline const char *GemmInstToString(GemmInst inst) {
     return "TCGEN5MMA";
   case GemmInst::kMFMA:
     return "MFMA";
+  case GemmInst::kWMMA:
+    return "WMMA";
+  case GemmInst::kGEMV:
+    return "GEMV";
+  case GemmInst::kMetalSimdgroup:
+    return "METAL_SIMDGROUP";
   default:
     return "Unknown";
   }
@@ -182,6 +196,18 @@ public:
   static const Op &Get();
 };
 
+/*!
+ * \brief Lower a GEMM over local buffers on a CPU target.
+ *
+ * C targets call the register-blocked micro-kernels of
+ * tl_templates/cpp/gemm.h through tl_gemm; LLVM targets get an i-k-j loop
+ * nest that the LLVM loop vectorizer turns into SIMD code.
+ */
+Stmt LowerCPUGemm(const LowerArgs &T, const BufferRegion &a_region,
+                  const BufferRegion &b_region, const BufferRegion &c_region,
+                  bool trans_a, bool trans_b, int m, int n, int k,
+                  int stride_a, int stride_b, const PrimExpr &clear_accum);
+
 } // namespace tl
 } // namespace tvm
 
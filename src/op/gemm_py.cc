@@ -89,6 +89,18 @@ GemmPy::GemmPy(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
   }
   node->cCoords_ = Array<PrimExpr>(
       {args[17].as<PrimExpr>().value(), args[18].as<PrimExpr>().value()});
+  if (args.size() > 19) {
+    ICHECK(args.size() == 21U || args.size() == 23U)
+        << "block scaled gemm expects SFA, SFB and optionally their tensor "
+           "memory buffers";
+    node->sfaRegion_ = NormalizeToBufferRegion(args[19]);
+    node->sfbRegion_ = NormalizeToBufferRegion(args[20]);
+    if (args.size() == 23U) {
+      node->sfaTmemRegion_ = NormalizeToBufferRegion(args[21]);
+      node->sfbTmemRegion_ = NormalizeToBufferRegion(args[22]);
+    }
+  }
+  node->annotations_ = annotations;
   data_ = std::move(node);
 }
 
@@ -105,7 +117,23 @@ TileOperator GemmPyNode::Clone() const {
   return GemmPy(op);
 }
 
+int GemmPyNode::sfVecSize() const {
+  if (auto vec = annotations_.Get("sf_vec_size")) {
+    return Downcast<Integer>(vec.value())->value;
+  }
+  return 32;
+}
+
 bool GemmPyNode::allowTcgen5Mma(Target target) const {
+  if (isBlockScaled()) {
+    return TargetIsSm100(target) && sfaTmemRegion_.defined() &&
+           (a_.scope() == "shared.dyn" || a_.scope() == "shared") &&
+           (b_.scope() == "shared.dyn" || b_.scope() == "shared") &&
+           c_.scope() == "shared.tmem" &&
+           GetTCGEN5BlockScaledMMAMeta(m_, n_, k_, a_->dtype, c_->dtype,
+                                       sfVecSize())
+               .first;
+  }
   return TargetIsSm100(target) &&
          ((a_.scope() == "shared.dyn" || a_.scope() == "shared" ||
            a_.scope() == "shared.tmem") &&
@@ -114,6 +142,38 @@ bool GemmPyNode::allowTcgen5Mma(Target target) const {
          GetTCGEN5MMAMeta(m_, n_, k_, a_->dtype, c_->dtype).first;
 }
 
+/**
+ * @brief Whether a block scaled gemm can use the mma.sync block scaled MMA.
+ *
+ * Consumer Blackwell (sm120) has no tensor memory; its block scaled MMA is a
+ * warp level mma.sync m16n8k32 of FP8 operands with one UE8M0 scale factor
+ * for every 32 elements of K, read directly from the SFA and SFB tiles in
+ * shared memory. A and B are K-major in shared memory and C is a float32
+ * fragment.
+ */
+bool GemmPyNode::allowBlockScaledMma(Target target) const {
+  return isBlockScaled() && TargetIsSM120(target) && IsSharedBuffer(a_) &&
+         IsSharedBuffer(b_) && IsFragmentBuffer(c_) && !transA_ && transB_ &&
+         a_->dtype.is_float8() && b_->dtype.is_float8() &&
+         c_->dtype == DataType::Float(32) && sfVecSize() == 32 &&
+         k_ % 32 == 0;
+}
+
+/**
+ * @brief Whether a block scaled gemm can use the block scaled MFMA of CDNA4.
+ *
+ * gfx950 has no dedicated scale factor memory either; its
+ * v_mfma_scale_f32_16x16x128_f8f6f4 takes one UE8M0 scale factor per lane
+ * for its 32 elements of K, read from the SFA and SFB tiles in shared memory.
+ */
+bool GemmPyNode::allowBlockScaledMfma(Target target) const {
+  return isBlockScaled() && TargetIsCDNA4(target) && IsSharedBuffer(a_) &&
+         IsSharedBuffer(b_) && IsFragmentBuffer(c_) && !transA_ && transB_ &&
+         a_->dtype.is_float8() && b_->dtype.is_float8() &&
+         c_->dtype == DataType::Float(32) && sfVecSize() == 32 &&
+         k_ % 128 == 0;
+}
+
 bool GemmPyNode::allowWgmma(int block_size, Target target) const {
   tvm::transform::PassContext ctxt = tvm::transform::PassContext::Current();
 
@@ -124,15 +184,70 @@ bool GemmPyNode::allowWgmma(int block_size, Target target) const {
          checkWgmma();
 }
 
+/**
+ * @brief Partition of the GEMV path for tiles too short for MMA.
+ *
+ * Decode-shaped tiles, M < 16 rows of A against a shared B, waste most of an
+ * MMA tile. The GEMV path instead gives every thread one column of C at a
+ * time, and K is split over `k_lanes` consecutive lanes, each loading `vec`
+ * consecutive elements of K at once: 128 bits when K is contiguous in both
+ * A and B, i.e. A not transposed and B transposed, as for the [N, K] weights
+ * of a linear layer, and one element otherwise. `k_lanes` is the largest
+ * power of two up to the warp size dividing K / vec, and the columns have to
+ * fill the threads evenly.
+ *
+ * @return {k_lanes, vec}, or an empty array if the gemm cannot take the path.
+ */
+Array<Integer> GemmPyNode::gemvPartition(int block_size, Target target) const {
+  tvm::transform::PassContext ctxt = tvm::transform::PassContext::Current();
+  if (ctxt->GetConfig(kDisableGemv, Optional<Bool>()).value_or(false) ||
+      !(TargetIsCuda(target) || TargetIsRocm(target)) || m_ >= 16 ||
+      isBlockScaled() || !IsSharedBuffer(a_) || !IsSharedBuffer(b_) ||
+      !IsFragmentBuffer(c_) || a_->dtype != b_->dtype)
+    return {};
+  int warp_size = TargetGetWarpSize(target);
+  int vec = !transA_ && transB_ ? std::max(1, 128 / a_->dtype.bits()) : 1;
+  if (block_size % warp_size != 0 || k_ % vec != 0)
+    return {};
+  int k_lanes = 1;
+  while (k_lanes * 2 <= warp_size && (k_ / vec) % (k_lanes * 2) == 0)
+    k_lanes *= 2;
+  if (n_ % (block_size / k_lanes) != 0)
+    return {};
+  return {k_lanes, vec};
+}
+
 GemmInst GemmPyNode::getGemmInst(int block_size, Target target) const {
   bool allow_tcgen5mma = allowTcgen5Mma(target);
+  if (isBlockScaled()) {
+    if (allowBlockScaledMma(target))
+      return GemmInst::kMMA;
+    if (allowBlockScaledMfma(target))
+      return GemmInst::kMFMA;
+    ICHECK(allow_tcgen5mma)
+        << "block scaled gemm requires the TCGEN5MMA of sm100 with A and B in "
+           "shared memory, C in tensor memory, M == 128, N % 128 == 0 and K a "
+           "multiple of 4 * sf_vec_size, or the MMA of sm120 with FP8 A and "
+           "B in shared memory, A not and B transposed, a float32 C fragment "
+           "and sf_vec_size == 32, or the MFMA of gfx950 with the same "
+           "operands and K % 128 == 0, got M=" << m_ << ", N=" << n_
+        << ", K=" << k_ << ", A dtype=" << a_->dtype
+        << ", sf_vec_size=" << sfVecSize() << " on " << target->str();
+    return GemmInst::kTCGEN5MMA;
+  }
   bool allow_wgmma = allowWgmma(block_size, target);
   if (allow_tcgen5mma) {
     return GemmInst::kTCGEN5MMA;
   } else if (allow_wgmma) {
     return GemmInst::kWGMMA;
+  } else if (!gemvPartition(block_size, target).empty()) {
+    return GemmInst::kGEMV;
+  } else if (TargetIsMetal(target)) {
+    return GemmInst::kMetalSimdgroup;
   } else if (TargetIsCDNA(target)) {
     return GemmInst::kMFMA;
+  } else if (TargetIsRDNA(target)) {
+    return GemmInst::kWMMA;
   } else if (TargetIsCuda(target)) {
     return GemmInst::kMMA;
   } else {
@@ -153,21 +268,23 @@ GemmInst GemmPyNode::getGemmInst(int block_size, Target target) const {
  * - (C, A, B) dtypes match one of the supported combinations below and K
  *   satisfies the required alignment; and
  * - for combinations that require specific orientations, A is not transposed
- *   and B is transposed.
+ *   and B is transposed, or, for 8-bit operands, the operand that is not
+ *   K-major can be staged into a K-major tile (see kMajorOrStageable).
  *
  * Supported combinations and constraints:
  * - C=float16:
  *   - A=float16, B=float16: K % 16 == 0
- *   - Various float8 mixes (e4m3/e5m2): require (!trans_A && trans_B) and K %
- * 32 == 0
+ *   - Various float8 mixes (e4m3/e5m2): require K-major or stageable operands
+ *     and K % 32 == 0
  * - C=float32:
  *   - A=float16, B=float16: K % 16 == 0
  *   - A=bfloat16, B=bfloat16: K % 16 == 0
  *   - A=float32, B=float32: require (!trans_A && trans_B) and K % 8 == 0
- *   - Various float8 mixes: require (!trans_A && trans_B) and K % 32 == 0
+ *   - Various float8 mixes: require K-major or stageable operands and K % 32
+ *     == 0
  * - C=int32:
- *   - 8-bit integer combinations (Int8/UInt8): require (!trans_A && trans_B)
- * and K % 32 == 0
+ *   - 8-bit integer combinations (Int8/UInt8): require K-major or stageable
+ *     operands and K % 32 == 0
  *
  * @return true if WGMMA is supported for the current buffers, dtypes, and
  *         transpose/shape constraints; false otherwise.
@@ -181,7 +298,7 @@ bool GemmPyNode::checkWgmma() const {
     if (a_->dtype == DataType::Float(16) && b_->dtype == DataType::Float(16))
       return k_ % 16 == 0;
     else if (a_->dtype.is_float8() && b_->dtype.is_float8())
-      return (!transA_) && transB_ && k_ % 32 == 0;
+      return kMajorOrStageable() && k_ % 32 == 0;
     else
       return false;
   } else if (c_->dtype == DataType::Float(32)) {
@@ -194,18 +311,18 @@ bool GemmPyNode::checkWgmma() const {
              b_->dtype == DataType::Float(32))
       return (!transA_) && transB_ && k_ % 8 == 0;
     else if (a_->dtype.is_float8() && b_->dtype.is_float8())
-      return (!transA_) && transB_ && k_ % 32 == 0;
+      return kMajorOrStageable() && k_ % 32 == 0;
     else
       return false;
   } else if (c_->dtype == DataType::Int(32)) {
     if (a_->dtype == DataType::Int(8) && b_->dtype == DataType::Int(8))
-      return (!transA_) && transB_ && k_ % 32 == 0;
+      return kMajorOrStageable() && k_ % 32 == 0;
     else if (a_->dtype == DataType::Int(8) && b_->dtype == DataType::UInt(8))
-      return (!transA_) && transB_ && k_ % 32 == 0;
+      return kMajorOrStageable() && k_ % 32 == 0;
     else if (a_->dtype == DataType::UInt(8) && b_->dtype == DataType::Int(8))
-      return (!transA_) && transB_ && k_ % 32 == 0;
+      return kMajorOrStageable() && k_ % 32 == 0;
     else if (a_->dtype == DataType::UInt(8) && b_->dtype == DataType::UInt(8))
-      return (!transA_) && transB_ && k_ % 32 == 0;
+      return kMajorOrStageable() && k_ % 32 == 0;
     else
       return false;
   } else {
@@ -213,6 +330,88 @@ bool GemmPyNode::checkWgmma() const {
   }
 }
 
+/**
+ * @brief Whether both operands are K-major, or can be copied into K-major
+ * tiles before the WGMMA.
+ *
+ * The WGMMA of 8-bit types only reads K-major tiles from shared memory. A
+ * transposed A or a non-transposed B in shared memory is copied into a
+ * K-major workspace by stageKMajor. The copy is reused by the next call of
+ * the gemm, which needs the WGMMA to have completed, i.e. wg_wait == 0.
+ */
+bool GemmPyNode::kMajorOrStageable() const {
+  auto stageable = [&](const Buffer &buffer) {
+    return IsSharedBuffer(buffer) && wgWait_ == 0;
+  };
+  return (!transA_ || stageable(a_)) && (transB_ || stageable(b_));
+}
+
+/**
+ * @brief Copy a tile that is not K-major into a K-major workspace.
+ *
+ * `region` is the [K, rows] tile of a transposed A or a non-transposed B.
+ * Each thread copies four consecutive elements of K of one row at a time:
+ * consecutive threads read consecutive rows of one line of the tile, and
+ * the four bytes of a thread land in one word of the workspace, which has
+ * the K-major swizzle of the WGMMA in `layout_map`. The threads issuing the
+ * gemm do the copy, so under warp specialization it overlaps the TMA loads
+ * of the producer, and ThreadSync and InjectFenceProxy order it before the
+ * WGMMA.
+ *
+ * @return The [rows, K] region of the workspace.
+ */
+BufferRegion GemmPyNode::stageKMajor(const LowerArgs &T,
+                                     const BufferRegion &region, int rows,
+                                     LayoutMap *layout_map,
+                                     Array<Stmt> *stmts) const {
+  const Buffer &src = region->buffer;
+  constexpr int kVec = 4;
+  ICHECK_EQ(k_ % kVec, 0);
+  PrimExpr workspace = T.AddWorkspace(rows * k_, src->dtype);
+  const auto *ptr = workspace.as<CallNode>();
+  ICHECK(ptr && ptr->op.same_as(builtin::tvm_access_ptr()));
+  Var data = Downcast<Var>(ptr->args[1]);
+  Buffer staged(data, src->dtype, {rows, k_}, {}, 0, src->name + "_kmajor", 0,
+                0, BufferType::kDefault);
+  Layout layout =
+      makeGemmABLayoutHopper(rows, k_, k_, src->dtype.bits(), true);
+  layout_map->Set(staged, layout);
+
+  auto extent = as_const_int(T.thread_bounds->extent);
+  ICHECK(extent) << "gemm requires a constant number of threads";
+  int threads = *extent;
+  int units = rows * k_ / kVec;
+  Var i("i"), v("v");
+  PrimExpr unit = i * threads + (T.thread_var - T.thread_bounds->min);
+  PrimExpr row = floormod(unit, rows);
+  PrimExpr k = floordiv(unit, rows) * kVec + v;
+
+  size_t ndim = region->region.size();
+  Array<PrimExpr> src_indices;
+  for (size_t d = 0; d + 2 < ndim; ++d) {
+    src_indices.push_back(region->region[d]->min);
+  }
+  src_indices.push_back(region->region[ndim - 2]->min + k);
+  src_indices.push_back(region->region[ndim - 1]->min + row);
+  Array<PrimExpr> physical = layout->Forward({row, k});
+  Array<PrimExpr> shape = layout->OutputShape();
+  PrimExpr offset = 0;
+  for (size_t d = 0; d < physical.size(); ++d) {
+    offset = offset * shape[d] + physical[d];
+  }
+  Buffer flat = staged.GetFlattenedBuffer();
+  Stmt body = BufferStore(flat, BufferLoad(src, src_indices), {offset});
+  body = For(v, 0, kVec, ForKind::kUnrolled, body);
+  if (units % threads != 0) {
+    body = IfThenElse(unit < units, body);
+  }
+  stmts->push_back(For(i, 0, (units + threads - 1) / threads,
+                       ForKind::kSerial, body));
+  return BufferRegion(staged,
+                      {Range::FromMinExtent(0, rows),
+                       Range::FromMinExtent(0, k_)});
+}
+
 /**
  * @brief Parse and return the numeric GPU architecture from a Target's "arch"
  * attribute.
@@ -241,11 +440,38 @@ static int GetArchInt(Target target) {
 }
 
 Stmt GemmPyNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
+  if (TargetIsCPU(T.target)) {
+    return LowerCPUGemm(T, aRegion_, bRegion_, cRegion_, transA_, transB_, m_,
+                        n_, k_, strideA_, strideB_, clearAccum_);
+  }
   if (const auto f = ffi::Function::GetGlobal("tl.gemm_py.lower")) {
+    GemmPy gemm = tvm::ffi::GetRef<GemmPy>(this);
+    LayoutMap layout_map = T.layout_map;
+    Array<Stmt> staging;
+    auto block_size = as_const_int(T.thread_bounds->extent);
+    if (a_->dtype.bits() == 8 && (transA_ || !transB_) && block_size &&
+        getGemmInst(*block_size, T.target) == GemmInst::kWGMMA) {
+      // The WGMMA of 8-bit types reads K-major operands only
+      auto node = tvm::ffi::make_object<GemmPyNode>(*this);
+      if (transA_) {
+        node->aRegion_ = stageKMajor(T, aRegion_, m_, &layout_map, &staging);
+        node->a_ = node->aRegion_->buffer;
+        node->transA_ = false;
+        node->strideA_ = k_;
+        node->offsetA_ = 0;
+      }
+      if (!transB_) {
+        node->bRegion_ = stageKMajor(T, bRegion_, n_, &layout_map, &staging);
+        node->b_ = node->bRegion_->buffer;
+        node->transB_ = true;
+        node->strideB_ = k_;
+        node->offsetB_ = 0;
+      }
+      gemm = GemmPy(node);
+    }
     // NOTE(wt): Decide GemmInst and compute warp partition on Python side
-    auto prim_func =
-        Downcast<PrimFunc>((*f)(tvm::ffi::GetRef<GemmPy>(this), T.layout_map,
-                                T.target, T.thread_bounds, T.thread_var));
+    auto prim_func = Downcast<PrimFunc>(
+        (*f)(gemm, layout_map, T.target, T.thread_bounds, T.thread_var));
     ICHECK(prim_func->attrs.defined());
     auto global_symbol =
         prim_func->attrs.GetAttr<tvm::ffi::String>("global_symbol");
@@ -257,16 +483,18 @@ Stmt GemmPyNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
         BlockNode *n = block.CopyOnWrite();
         n->name_hint = global_symbol.value();
       }
-      return BlockRealize(block_realize->iter_values, block_realize->predicate,
-                          block);
+      staging.push_back(BlockRealize(block_realize->iter_values,
+                                     block_realize->predicate, block));
+      return SeqStmt::Flatten(staging);
     }
     // warp with block realize node
-    return BlockRealize(
+    staging.push_back(BlockRealize(
         /*iter_values=*/Array<PrimExpr>(),
         /*predicate=*/const_true(),
         /*block=*/
         Block(/*iter_vars=*/{}, /*reads=*/{}, /*writes=*/{},
-              /*name_hint=*/global_symbol.value(), prim_func->body));
+              /*name_hint=*/global_symbol.value(), prim_func->body)));
+    return SeqStmt::Flatten(staging);
   } else {
     LOG(FATAL) << "No lower function found for gemm_py";
     return Stmt(); // This line will never be reached due to LOG(FATAL), but
@@ -279,6 +507,11 @@ LayoutMap GemmPyNode::InferLayout(const LayoutInferArgs &T,
   if (completed_)
     return {};
   LayoutMap results;
+  if (TargetIsCPU(T.target)) {
+    // CPU gemms operate on plain row-major local buffers.
+    completed_ = true;
+    return results;
+  }
 
   if (const auto f = ffi::Function::GetGlobal("tl.gemm_py.infer_layout")) {
     results = Downcast<LayoutMap>(
@@ -312,14 +545,20 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                         [](GemmPy gemm_py, int block_size, Target target) {
                           return gemm_py->getGemmInst(block_size, target);
                         });
+  refl::GlobalDef().def("tl.GemmPyGemvPartition",
+                        [](GemmPy gemm_py, int block_size, Target target) {
+                          return gemm_py->gemvPartition(block_size, target);
+                        });
 }
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef().def(
       "tl.get_tcgen5_mma_meta",
-      [](int M, int N, int K, DataType ab_dtype, DataType c_dtype) {
-        auto [success, meta] = GetTCGEN5MMAMeta(M, N, K, ab_dtype, c_dtype);
+      [](int M, int N, int K, DataType ab_dtype, DataType c_dtype,
+         bool use_2cta) {
+        auto [success, meta] =
+            GetTCGEN5MMAMeta(M, N, K, ab_dtype, c_dtype, use_2cta);
         Array<Integer> result;
         if (success) {
           result.push_back(Integer(meta.atom_m));
@@ -340,6 +579,30 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                                            scale_in_a, scale_in_b);
         return Integer(static_cast<int64_t>(desc));
       });
+  refl::GlobalDef().def(
+      "tl.get_tcgen5_blockscaled_mma_meta",
+      [](int M, int N, int K, DataType ab_dtype, DataType c_dtype,
+         int sf_vec_size) {
+        auto [success, meta] = GetTCGEN5BlockScaledMMAMeta(
+            M, N, K, ab_dtype, c_dtype, sf_vec_size);
+        Array<Integer> result;
+        if (success) {
+          result.push_back(Integer(meta.atom_m));
+          result.push_back(Integer(meta.atom_n));
+          result.push_back(Integer(meta.atom_k));
+          result.push_back(Integer(meta.enable_ws));
+          result.push_back(Integer(meta.enable_2cta));
+        }
+        return result;
+      });
+  refl::GlobalDef().def(
+      "tl.get_tcgen5_blockscaled_instr_desc",
+      [](int atom_m, int atom_n, DataType ab_dtype, bool a_is_k_major,
+         bool b_is_k_major, int sf_vec_size) {
+        uint32_t desc = GetTCGEN5BlockScaledInstrDesc(
+            atom_m, atom_n, ab_dtype, a_is_k_major, b_is_k_major, sf_vec_size);
+        return Integer(static_cast<int64_t>(desc));
+      });
 }
 
 } // namespace tl
@@ -21,6 +21,8 @@ public:
   bool checkWgmma() const;
   bool allowTcgen5Mma(Target target) const;
   bool allowWgmma(int block_size, Target target) const;
+  bool allowBlockScaledMma(Target target) const;
+  bool allowBlockScaledMfma(Target target) const;
   tir::Buffer a_, b_, c_;
   // BufferRegion for A, B and C
   BufferRegion aRegion_, bRegion_, cRegion_;
@@ -32,11 +34,18 @@ public:
   BufferRegion mbarRegion_;
   tir::Buffer mbar_; // mbar is optional, only used for TCGEN5MMA
   Array<PrimExpr> cCoords_;
+  // Scale factors of block scaled gemms in shared memory and their tensor
+  // memory copies, undefined for other gemms. The tensor memory copies are
+  // also undefined for the mma.sync block scaled gemms of sm120.
+  BufferRegion sfaRegion_, sfbRegion_, sfaTmemRegion_, sfbTmemRegion_;
   // k_pack please ref to bitblas/tl/mfma_macro_generator.py::k_pack
   // only will be enabled under cdna mfma instructions
   int kPack_ = 1;
   int wgWait_ = 0;
   mutable GemmWarpPolicy policy_;
+  // Lowering options forwarded to the Python gemm implementations, e.g.
+  // "fragment_double_buffer".
+  Map<String, ObjectRef> annotations_;
 
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.GemmPy", GemmPyNode, TileOperatorNode);
 
@@ -62,9 +71,14 @@ public:
         .def_ro("mbarRegion", &GemmPyNode::mbarRegion_)
         .def_ro("mbar", &GemmPyNode::mbar_)
         .def_ro("cCoords", &GemmPyNode::cCoords_)
+        .def_ro("sfaRegion", &GemmPyNode::sfaRegion_)
+        .def_ro("sfbRegion", &GemmPyNode::sfbRegion_)
+        .def_ro("sfaTmemRegion", &GemmPyNode::sfaTmemRegion_)
+        .def_ro("sfbTmemRegion", &GemmPyNode::sfbTmemRegion_)
         .def_ro("kPack", &GemmPyNode::kPack_)
         .def_ro("wgWait", &GemmPyNode::wgWait_)
-        .def_ro("policy", &GemmPyNode::policy_);
+        .def_ro("policy", &GemmPyNode::policy_)
+        .def_ro("annotations", &GemmPyNode::annotations_);
   }
 
   Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
@@ -73,10 +87,25 @@ public:
 
   TileOperator Clone() const;
 
+  bool isBlockScaled() const { return sfaRegion_.defined(); }
+  // Number of elements of K sharing a scale factor, the "sf_vec_size"
+  // annotation of block scaled gemms.
+  int sfVecSize() const;
+
   // Target GEMM instruction
   GemmInst getGemmInst(int block_size, Target target) const;
+  // Lanes splitting K and elements of K loaded at once by the GEMV path,
+  // empty if the gemm cannot take it
+  Array<Integer> gemvPartition(int block_size, Target target) const;
 
 private:
+  // Whether the operands are K-major, or can be staged into K-major tiles
+  bool kMajorOrStageable() const;
+  // Copy the [K, rows] tile `region` into a K-major workspace
+  BufferRegion stageKMajor(const LowerArgs &T, const BufferRegion &region,
+                           int rows, LayoutMap *layout_map,
+                           Array<Stmt> *stmts) const;
+
   mutable bool completed_ = false;
 };
 
@@ -0,0 +1,389 @@
+/*!
+ * \file tl/op/hadamard.cc
+ * \brief Implementation of the Walsh-Hadamard transform operator
+ */
+
+#include "hadamard.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+
+#include "../layout/layout.h"
+#include "../target/utils.h"
+#include "../transform/loop_partition.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Shared memory one exchange of the butterflies spanning warps may take
+static constexpr int kMaxWorkspaceBytes = 32 * 1024;
+/// Bits exchanged at once through shared memory, reading 2^k partners
+static constexpr int kMaxExchangeBits = 4;
+
+/// Bit `bit` of `index`
+static PrimExpr Bit(const PrimExpr &index, int bit) {
+  return floormod(floordiv(index, 1 << bit), 2);
+}
+
+HadamardOp::HadamardOp(Array<PrimExpr> args,
+                       Map<String, ObjectRef> annotations) {
+  /// Hadamard constructor arguments:
+  /// - buffer: fragment transformed in place
+  /// - dim: transformed dimension, non-negative
+  /// - scale: factor applied to the result
+  CHECK_EQ(args.size(), 3);
+  ObjectPtr<HadamardOpNode> node = tvm::ffi::make_object<HadamardOpNode>();
+  node->bufferRegion_ = NormalizeToBufferRegion(args[0]);
+  node->buffer = node->bufferRegion_->buffer;
+  node->dim = static_cast<int>(args[1].as<IntImmNode>()->value);
+  node->scale = args[2];
+
+  const Buffer &buffer = node->buffer;
+  ICHECK(IsFragmentBuffer(buffer) && buffer->dtype.is_float())
+      << "T.hadamard expects a floating point fragment, got " << buffer->name
+      << " of dtype " << buffer->dtype << " in " << buffer.scope();
+  ICHECK(RegionHasShape(node->bufferRegion_, buffer->shape))
+      << "T.hadamard transforms whole fragments, got a region of "
+      << buffer->name;
+  ICHECK(node->dim >= 0 && node->dim < static_cast<int>(buffer->shape.size()))
+      << "T.hadamard got dim " << node->dim << " for " << buffer->name
+      << " of shape " << buffer->shape;
+  for (const PrimExpr &extent : buffer->shape) {
+    ICHECK(as_const_int(extent))
+        << "T.hadamard expects a static shape, got " << buffer->shape;
+  }
+  int64_t n = *as_const_int(buffer->shape[node->dim]);
+  ICHECK(n > 0 && (n & (n - 1)) == 0)
+      << "T.hadamard expects a power of two extent along dim " << node->dim
+      << ", got " << buffer->shape;
+  data_ = std::move(node);
+}
+
+TileOperator HadamardOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<HadamardOpNode>(*this);
+  return HadamardOp(op);
+}
+
+int HadamardOpNode::NumStages() const {
+  int64_t n = *as_const_int(buffer->shape[dim]);
+  int stages = 0;
+  while ((int64_t{1} << stages) < n)
+    ++stages;
+  return stages;
+}
+
+For HadamardOpNode::MakeElementwiseLoop(
+    const std::function<Stmt(const Array<PrimExpr> &)> &body) const {
+  Array<Var> vars;
+  for (size_t d = 0; d < buffer->shape.size(); ++d) {
+    vars.push_back(Var(std::string(1, static_cast<char>('i' + d))));
+  }
+  Stmt loop = body(Array<PrimExpr>(vars.begin(), vars.end()));
+  for (int d = static_cast<int>(vars.size()) - 1; d >= 0; --d) {
+    loop = For(vars[d], 0, buffer->shape[d], ForKind::kParallel, loop);
+  }
+  return Downcast<For>(loop);
+}
+
+HadamardStageEnum HadamardOpNode::ClassifyStage(const Fragment &layout,
+                                                int bit, int warp_size,
+                                                int *lane_mask) const {
+  // Compare the places of the pairs j = high * 2h + low and j + h
+  int half = 1 << bit;
+  int n = static_cast<int>(*as_const_int(buffer->shape[dim]));
+  arith::Analyzer analyzer;
+  Var high("high"), low("low"), rep("rep");
+  analyzer.Bind(high, Range(0, n / (2 * half)));
+  analyzer.Bind(low, Range(0, half));
+  analyzer.Bind(rep, Range(0, layout->ReplicateExtent()));
+  Array<PrimExpr> lower, upper;
+  for (size_t d = 0; d < buffer->shape.size(); ++d) {
+    if (static_cast<int>(d) == dim) {
+      lower.push_back(high * (2 * half) + low);
+      upper.push_back(high * (2 * half) + low + half);
+      continue;
+    }
+    Var v("v" + std::to_string(d));
+    analyzer.Bind(v, Range(0, buffer->shape[d]));
+    lower.push_back(v);
+    upper.push_back(v);
+  }
+  PrimExpr thread = layout->ForwardThread(lower, rep);
+  PrimExpr distance =
+      analyzer.Simplify(layout->ForwardThread(upper, rep) - thread);
+  if (is_zero(distance))
+    return HadamardStageEnum::kRegister;
+
+  // A shuffle exchanges the elements at the same local index
+  Array<PrimExpr> local_lower = layout->Forward(lower);
+  Array<PrimExpr> local_upper = layout->Forward(upper);
+  for (size_t k = 0; k < local_lower.size(); ++k) {
+    if (!is_zero(analyzer.Simplify(local_upper[k] - local_lower[k])))
+      return HadamardStageEnum::kShared;
+  }
+  const int64_t *p_distance = as_const_int(distance);
+  if (!p_distance || *p_distance <= 0 || *p_distance >= warp_size ||
+      (*p_distance & (*p_distance - 1)) != 0)
+    return HadamardStageEnum::kShared;
+  int mask = static_cast<int>(*p_distance);
+  // The lower elements sit on the lanes with the bit of the mask clear, so
+  // the partner is the lane xor mask
+  if (!analyzer.CanProveEqual(floormod(floordiv(thread, mask), 2), 0))
+    return HadamardStageEnum::kShared;
+  *lane_mask = mask;
+  return HadamardStageEnum::kShuffle;
+}
+
+For HadamardOpNode::MakeRegisterStage(int bit, const Buffer &tmp) const {
+  int half = 1 << bit;
+  Array<PrimExpr> zero = {0};
+  return MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+    Array<PrimExpr> partner = indices;
+    partner.Set(dim, indices[dim] + half);
+    PrimExpr upper = BufferLoad(buffer, partner);
+    Stmt butterfly = SeqStmt(
+        {BufferStore(tmp, BufferLoad(buffer, indices), zero),
+         BufferStore(buffer, BufferLoad(tmp, zero) + upper, indices),
+         BufferStore(buffer, BufferLoad(tmp, zero) - upper, partner)});
+    return IfThenElse(Bit(indices[dim], bit) == 0, butterfly);
+  });
+}
+
+For HadamardOpNode::MakeShuffleStage(int bit, int lane_mask,
+                                     Target target) const {
+  return MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+    PrimExpr value = BufferLoad(buffer, indices);
+    PrimExpr partner;
+    if (TargetIsCuda(target)) {
+      partner = Call(buffer->dtype, builtin::call_extern(),
+                     {StringImm("tl::shfl_xor_sync"),
+                      make_const(DataType::UInt(32), 0xFFFFFFFF), value,
+                      lane_mask});
+    } else {
+      partner = Call(buffer->dtype, builtin::call_extern(),
+                     {StringImm("tl::shfl_xor"), value, lane_mask});
+    }
+    // The lower element of the pair takes the sum, the upper one the
+    // difference, so every lane shuffles and no lane diverges
+    PrimExpr sign = cast(buffer->dtype, 1 - 2 * Bit(indices[dim], bit));
+    return BufferStore(buffer, value * sign + partner, indices);
+  });
+}
+
+Array<Stmt> HadamardOpNode::MakeSharedStages(
+    const LowerArgs &T, const Fragment &layout, const std::vector<int> &bits,
+    const std::vector<int> &round_bits, arith::Analyzer *analyzer) const {
+  int num_rounds = 1 << round_bits.size();
+  int64_t num_elems = 1;
+  for (const PrimExpr &extent : buffer->shape) {
+    num_elems *= *as_const_int(extent);
+  }
+  int slice = static_cast<int>(num_elems / num_rounds);
+  // T.AddWorkspace hands out an access pointer, view its data as a buffer
+  PrimExpr workspace = T.AddWorkspace(slice, buffer->dtype);
+  const auto *access_ptr = workspace.as<CallNode>();
+  ICHECK(access_ptr && access_ptr->op.same_as(builtin::tvm_access_ptr()));
+  Buffer ws(Downcast<Var>(access_ptr->args[1]), buffer->dtype,
+            {IntImm(DataType::Int(32), slice)}, {}, PrimExpr(0),
+            buffer->name + "_exchange", 0, 0, BufferType::kDefault);
+
+  // Row-major slot of an element within its round, round bits removed from
+  // the index along dim from the highest down
+  auto slot = [&](const Array<PrimExpr> &indices) {
+    PrimExpr flat = 0;
+    for (size_t d = 0; d < indices.size(); ++d) {
+      PrimExpr index = indices[d], extent = buffer->shape[d];
+      if (static_cast<int>(d) == dim) {
+        for (int bit : round_bits) {
+          index = floordiv(index, 2 << bit) * (1 << bit) +
+                  floormod(index, 1 << bit);
+        }
+        extent = floordiv(extent, num_rounds);
+      }
+      flat = flat * extent + index;
+    }
+    return flat;
+  };
+  auto in_round = [&](const PrimExpr &index, int round, Stmt body) {
+    if (round_bits.empty())
+      return body;
+    PrimExpr cond = const_true();
+    for (size_t t = 0; t < round_bits.size(); ++t) {
+      cond = cond && Bit(index, round_bits[t]) == ((round >> t) & 1);
+    }
+    return IfThenElse(cond, body);
+  };
+
+  // Split the bits evenly over the fewest exchanges of kMaxExchangeBits
+  int num_bits = static_cast<int>(bits.size());
+  int num_groups = (num_bits + kMaxExchangeBits - 1) / kMaxExchangeBits;
+  Array<Stmt> seq;
+  for (int g = 0; g < num_groups; ++g) {
+    std::vector<int> group(bits.begin() + g * num_bits / num_groups,
+                           bits.begin() + (g + 1) * num_bits / num_groups);
+    int num_group_bits = static_cast<int>(group.size());
+    for (int round = 0; round < num_rounds; ++round) {
+      For store = MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+        return in_round(
+            indices[dim], round,
+            BufferStore(ws, BufferLoad(buffer, indices), {slot(indices)}));
+      });
+      // y[j] = sum over the patterns u of the group bits of
+      //        x[j with the group bits set to u] * (-1)^popcount(u & j)
+      For load = MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+        PrimExpr j = indices[dim];
+        PrimExpr base = j;
+        for (int bit : group) {
+          base = base - Bit(j, bit) * (1 << bit);
+        }
+        PrimExpr sum;
+        for (int u = 0; u < (1 << num_group_bits); ++u) {
+          PrimExpr index = base, sign = 1;
+          for (int t = 0; t < num_group_bits; ++t) {
+            if ((u >> t) & 1) {
+              index = index + (1 << group[t]);
+              sign = sign * (1 - 2 * Bit(j, group[t]));
+            }
+          }
+          Array<PrimExpr> partner = indices;
+          partner.Set(dim, index);
+          PrimExpr term = BufferLoad(ws, {slot(partner)});
+          if (u != 0)
+            term = cast(buffer->dtype, sign) * term;
+          sum = sum.defined() ? sum + term : term;
+        }
+        return in_round(j, round, BufferStore(buffer, sum, indices));
+      });
+      // ThreadSync orders the exchanges through the workspace
+      seq.push_back(PartitionLoop(store, T.thread_var, analyzer, layout));
+      seq.push_back(PartitionLoop(load, T.thread_var, analyzer, layout));
+    }
+  }
+  return seq;
+}
+
+/**
+ * @brief Lower the butterfly stages after the places of their pairs.
+ *
+ * Each bit of the index along dim is classified on the layout of the
+ * fragment. Pairs held by one thread are combined in registers. Pairs at the
+ * same local index of two lanes of a warp, the lanes differing in one bit,
+ * are combined through a shuffle, every lane keeping the sum or the
+ * difference. The remaining bits, whose pairs span warps, are combined
+ * through shared memory at most kMaxExchangeBits at a time: every thread
+ * writes its elements and reads back the partners of each. When the fragment
+ * exceeds kMaxWorkspaceBytes, the exchange goes in rounds over the slices
+ * selected by the highest bits held in registers.
+ */
+Stmt HadamardOpNode::Lower(const LowerArgs &T,
+                           arith::Analyzer *analyzer) const {
+  Fragment layout = T.layout_map[buffer].as<Fragment>().value();
+  int warp_size = TargetGetWarpSize(T.target);
+  const int64_t *p_min = as_const_int(T.thread_bounds->min);
+  const int64_t *p_extent = as_const_int(T.thread_bounds->extent);
+  // Full-mask shuffles need whole warps
+  bool whole_warps = (TargetIsCuda(T.target) || TargetIsRocm(T.target)) &&
+                     p_min && p_extent && *p_min % warp_size == 0 &&
+                     *p_extent % warp_size == 0;
+  Buffer tmp =
+      decl_buffer({1}, buffer->dtype, buffer->name + "_butterfly", "local");
+  Array<Stmt> seq;
+  std::vector<int> register_bits, shared_bits;
+  for (int bit = 0; bit < NumStages(); ++bit) {
+    int lane_mask = 0;
+    HadamardStageEnum stage =
+        ClassifyStage(layout, bit, warp_size, &lane_mask);
+    if (stage == HadamardStageEnum::kShuffle && !whole_warps)
+      stage = HadamardStageEnum::kShared;
+    switch (stage) {
+    case HadamardStageEnum::kRegister:
+      register_bits.push_back(bit);
+      seq.push_back(PartitionLoop(MakeRegisterStage(bit, tmp), T.thread_var,
+                                  analyzer, layout));
+      break;
+    case HadamardStageEnum::kShuffle:
+      seq.push_back(PartitionLoop(MakeShuffleStage(bit, lane_mask, T.target),
+                                  T.thread_var, analyzer, layout));
+      break;
+    case HadamardStageEnum::kShared:
+      shared_bits.push_back(bit);
+      break;
+    }
+  }
+  if (!shared_bits.empty()) {
+    int64_t bytes = buffer->dtype.bytes();
+    for (const PrimExpr &extent : buffer->shape) {
+      bytes *= *as_const_int(extent);
+    }
+    std::vector<int> round_bits;
+    for (auto it = register_bits.rbegin();
+         it != register_bits.rend() && bytes > kMaxWorkspaceBytes; ++it) {
+      round_bits.push_back(*it);
+      bytes /= 2;
+    }
+    for (const Stmt &stmt :
+         MakeSharedStages(T, layout, shared_bits, round_bits, analyzer)) {
+      seq.push_back(stmt);
+    }
+  }
+  if (!is_one(scale)) {
+    For loop = MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+      return BufferStore(buffer,
+                         BufferLoad(buffer, indices) *
+                             cast(buffer->dtype, scale),
+                         indices);
+    });
+    seq.push_back(LowerParallelLoop(loop, layout, T.thread_var, analyzer,
+                                    T.layout_map));
+  }
+  if (seq.empty())
+    return Evaluate(0);
+  return Allocate(tmp->data, tmp->dtype, tmp->shape, const_true(),
+                  SeqStmt::Flatten(seq));
+}
+
+/**
+ * @brief Infer the layout of the fragment.
+ *
+ * A layout given by another operator, e.g. the accumulator layout of a gemm
+ * or the layout a T.quantize of the result wants, is kept, the stages
+ * adapting to it. Otherwise the fragment is laid out as its elementwise loop
+ * would be partitioned, with runs of 16 bytes along the last dimension per
+ * thread when they fit.
+ */
+LayoutMap HadamardOpNode::InferLayout(const LayoutInferArgs &T,
+                                      InferLevel level) const {
+  if (level != InferLevel::kFree || T.layout_map.count(buffer))
+    return {};
+  For loop = MakeElementwiseLoop([&](const Array<PrimExpr> &indices) {
+    return BufferStore(buffer, BufferLoad(buffer, indices), indices);
+  });
+  int vector_size = 16 / buffer->dtype.bytes();
+  PrimExpr num_elems = 1;
+  for (const PrimExpr &extent : buffer->shape) {
+    num_elems = num_elems * extent;
+  }
+  while (vector_size > 1 &&
+         !T.analyzer->CanProve(
+             floormod(num_elems, T.thread_bounds->extent * vector_size) ==
+             0)) {
+    vector_size /= 2;
+  }
+  LayoutMap result_map;
+  result_map.Set(buffer, PlanLoopPartition(loop, vector_size, T.thread_bounds));
+  return result_map;
+}
+
+TIR_REGISTER_TL_TILE_OP(HadamardOp, hadamard)
+    .set_num_inputs(3)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() { HadamardOpNode::RegisterReflection(); }
+
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,95 @@
+/*!
+ * \file tl/op/hadamard.h
+ * \brief Fast Walsh-Hadamard transform of fragments
+ */
+
+#ifndef TVM_TL_OP_HADAMARD_H_
+#define TVM_TL_OP_HADAMARD_H_
+
+#include "operator.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Where the two elements of a butterfly live relative to each other
+enum class HadamardStageEnum : uint8_t {
+  kRegister, ///< In the same thread
+  kShuffle,  ///< In the same warp, at a lane distance of a power of two
+  kShared,   ///< Anywhere, exchanged through shared memory
+};
+
+/*!
+ * \brief Node class for in-place Walsh-Hadamard transforms of a fragment.
+ *
+ * The transform along `dim`, of a power of two extent n, is one butterfly
+ * stage per bit of the index along `dim`: the elements j and j + h, with
+ * bit h of j clear, become their sum and difference. The stages commute, so
+ * each is lowered after the place of its partner in the layout of the
+ * fragment: within the registers of a thread, through a warp shuffle, or,
+ * for all remaining bits at once, through a single exchange in shared
+ * memory. The result is multiplied by `scale`, e.g. 1 / sqrt(n) for the
+ * orthonormal transform.
+ */
+class HadamardOpNode : public TileOperatorNode {
+public:
+  tir::Buffer buffer; ///< Fragment transformed in place
+  BufferRegion bufferRegion_;
+  int dim;        ///< Transformed dimension
+  PrimExpr scale; ///< Applied to the transformed elements
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.HadamardOp", HadamardOpNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<HadamardOpNode>()
+        .def_ro("buffer", &HadamardOpNode::buffer)
+        .def_ro("bufferRegion", &HadamardOpNode::bufferRegion_)
+        .def_ro("dim", &HadamardOpNode::dim)
+        .def_ro("scale", &HadamardOpNode::scale);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+
+private:
+  /// log2 of the extent along dim
+  int NumStages() const;
+  /// Parallel loop nest over the elements of buffer running `body(indices)`
+  For MakeElementwiseLoop(
+      const std::function<Stmt(const Array<PrimExpr> &)> &body) const;
+  /// Where the partner of the butterfly of `bit` lives in `layout`, with the
+  /// lane distance of kShuffle in `lane_mask`
+  HadamardStageEnum ClassifyStage(const Fragment &layout, int bit,
+                                  int warp_size, int *lane_mask) const;
+  /// Butterfly of `bit` within the registers, through the scratch `tmp`
+  For MakeRegisterStage(int bit, const Buffer &tmp) const;
+  /// Butterfly of `bit` with the lane at `lane_mask`
+  For MakeShuffleStage(int bit, int lane_mask, Target target) const;
+  /// Transform over `bits` through shared memory, `round_bits` selecting the
+  /// slices of the fragment exchanged one after the other
+  Array<Stmt> MakeSharedStages(const LowerArgs &T, const Fragment &layout,
+                               const std::vector<int> &bits,
+                               const std::vector<int> &round_bits,
+                               arith::Analyzer *analyzer) const;
+};
+
+/// Wrapper class for Walsh-Hadamard transforms
+class HadamardOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(HadamardOp, TileOperator,
+                                             HadamardOpNode);
+  TVM_DLL HadamardOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_HADAMARD_H_
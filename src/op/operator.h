@@ -56,6 +56,8 @@ struct LowerArgs {
   // Map from LetStmt variable to its bound expression, for resolving
   // fragment buffer accesses through let bindings
   Map<Var, PrimExpr> let_var_to_expr;
+  // blockIdx launch variables of the kernel with an extent > 1
+  Array<Var> block_vars;
 };
 
 struct LayoutInferArgs {
@@ -6,6 +6,8 @@
 #include "parallel.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include <tvm/tir/op.h>
 
 #include "../layout/layout.h"
@@ -745,11 +747,149 @@ Fragment ParallelOpNode::ComputePlanCandidate(const LayoutInferArgs &T) const {
              << " ############# vector_size = " << vector_size
              << ", thread_bounds = " << T.thread_bounds << '\n';
   auto plan = PlanLoopPartition(root_, vector_size, T.thread_bounds);
+  // A narrower partition trades bytes per instruction for fewer shared
+  // memory bank conflicts, keep it when it moves more bytes per cycle.
+  bool has_shared_access = false;
+  PostOrderVisit(root_, [&](const ObjectRef &obj) {
+    if (const auto *store = obj.as<BufferStoreNode>()) {
+      has_shared_access |= IsSharedBuffer(store->buffer);
+    } else if (const auto *load = obj.as<BufferLoadNode>()) {
+      has_shared_access |= IsSharedBuffer(load->buffer);
+    }
+  });
+  if (has_shared_access && !root_->annotations.count(attr::kCoalescedWidth)) {
+    AccessCost best = EvaluateCandidate(plan, T);
+    for (int narrower = vector_size / 2;
+         narrower >= 1 && best.bank_conflict > 1; narrower /= 2) {
+      auto candidate = PlanLoopPartition(root_, narrower, T.thread_bounds);
+      AccessCost cost = EvaluateCandidate(candidate, T);
+      if (cost.Score() > best.Score()) {
+        plan = candidate;
+        best = cost;
+      }
+    }
+  }
   DLOG(INFO) << "[PlanLoopPartition] candidate = " << plan->DebugOutput()
              << '\n';
   return plan;
 }
 
+ParallelOpNode::AccessCost
+ParallelOpNode::EvaluateCandidate(const Fragment &candidate,
+                                  const LayoutInferArgs &T) const {
+  // Partition the loop as LowerTileOp would and plan its vectorization, so
+  // that the vector width accounts for every buffer of the loop under this
+  // thread mapping.
+  AccessCost cost;
+  auto root =
+      IfBufferRemapLoopGenerator::run(root_, T.buffer_remap, T.layout_map);
+  arith::Analyzer analyzer;
+  Var thread_var("tx", T.thread_bounds->extent.dtype());
+  analyzer.Bind(thread_var, T.thread_bounds);
+  try {
+    For partitioned = PartitionLoop(root, thread_var, &analyzer, candidate);
+    cost.vector_size = GetVectorizeSize(partitioned, &analyzer, T.layout_map);
+  } catch (const tvm::runtime::Error &) {
+    // Not partitionable as is, the final validation reports why if chosen
+    return cost;
+  }
+
+  int max_bits = TargetSupportVectorize256(T.target) ? 256 : 128;
+  int64_t total_bits = 0, accesses = 0;
+  PostOrderVisit(root, [&](const ObjectRef &obj) {
+    Buffer buffer;
+    if (const auto *store = obj.as<BufferStoreNode>()) {
+      buffer = store->buffer;
+    } else if (const auto *load = obj.as<BufferLoadNode>()) {
+      buffer = load->buffer;
+    }
+    if (!buffer.defined() ||
+        !(IsSharedBuffer(buffer) || IsGlobalBuffer(buffer)))
+      return;
+    int elem_bits = buffer->dtype.bits() * buffer->dtype.lanes();
+    total_bits += std::min(elem_bits * cost.vector_size, max_bits);
+    ++accesses;
+  });
+  if (accesses > 0) {
+    cost.bytes_per_access = total_bits / 8.0 / accesses;
+    cost.bank_conflict =
+        EstimateBankConflict(root, candidate, cost.vector_size, T);
+  }
+  DLOG(INFO) << "[EvaluateCandidate] " << candidate->DebugOutput()
+             << " vector_size = " << cost.vector_size
+             << ", bytes_per_access = " << cost.bytes_per_access
+             << ", bank_conflict = " << cost.bank_conflict << '\n';
+  return cost;
+}
+
+int ParallelOpNode::EstimateBankConflict(const For &root,
+                                         const Fragment &candidate,
+                                         int vector_size,
+                                         const LayoutInferArgs &T) const {
+  const int64_t *num_threads = as_const_int(T.thread_bounds->extent);
+  if (!num_threads)
+    return 1;
+  int warp_size = static_cast<int>(std::min<int64_t>(32, *num_threads));
+  // The loop indices the threads of the first warp start from
+  auto inverse = candidate->InverseWithLevel().first;
+  std::vector<Map<Var, PrimExpr>> thread_indices(warp_size);
+  for (int t = 0; t < warp_size; ++t) {
+    Array<PrimExpr> fwd;
+    for (size_t i = 0; i < candidate->OutputDim(); ++i)
+      fwd.push_back(0);
+    fwd.push_back(t);
+    auto indices = inverse->Forward(fwd);
+    for (size_t i = 0; i < loop_vars_.size(); ++i)
+      thread_indices[t].Set(loop_vars_[i]->var, indices[i]);
+    for (const auto &[var, iv] : inner_vars_)
+      thread_indices[t].Set(var, iv->dom->min);
+  }
+
+  int degree = 1;
+  bool known = true;
+  auto visit = [&](const Buffer &buffer, const Array<PrimExpr> &indices) {
+    if (!IsSharedBuffer(buffer) || !known)
+      return;
+    int elem_bits = buffer->dtype.bits() * buffer->dtype.lanes();
+    int words = std::max(1, std::min(elem_bits * vector_size, 128) / 32);
+    // A 64 (128) bit access is served in 2 (4) phases of the warp
+    int phase_size = std::max(1, 32 / words);
+    std::vector<int64_t> first_word(warp_size);
+    for (int t = 0; t < warp_size; ++t) {
+      PrimExpr offset = 0, stride = 1;
+      for (int i = static_cast<int>(indices.size()) - 1; i >= 0; --i) {
+        offset = offset + Substitute(indices[i], thread_indices[t]) * stride;
+        stride = stride * buffer->shape[i];
+      }
+      const int64_t *elem = as_const_int(analyzer_.Simplify(offset));
+      if (!elem) {
+        known = false;
+        return;
+      }
+      first_word[t] = *elem * elem_bits / 32;
+    }
+    for (int begin = 0; begin < warp_size; begin += phase_size) {
+      std::unordered_map<int64_t, std::unordered_set<int64_t>> banks;
+      for (int t = begin; t < std::min(begin + phase_size, warp_size); ++t) {
+        for (int w = 0; w < words; ++w) {
+          int64_t word = first_word[t] + w;
+          banks[word % 32].insert(word);
+        }
+      }
+      for (const auto &[_, distinct] : banks)
+        degree = std::max(degree, static_cast<int>(distinct.size()));
+    }
+  };
+  PostOrderVisit(root, [&](const ObjectRef &obj) {
+    if (const auto *store = obj.as<BufferStoreNode>()) {
+      visit(store->buffer, store->indices);
+    } else if (const auto *load = obj.as<BufferLoadNode>()) {
+      visit(load->buffer, load->indices);
+    }
+  });
+  return known ? degree : 1;
+}
+
 void ParallelOpNode::BuildReplicationGuardsIfNeeded(
     const LayoutInferArgs &T,
     const std::vector<Buffer> &store_shared_global_buffers,
@@ -812,6 +952,7 @@ ParallelOpNode::ChooseBestCandidate(const Fragment &candidate_from_buffer,
   //      - If plan-based contains buffer-based, prefer buffer.
   // 3) If neither contains the other, prefer the one with provably smaller or
   //    equal replication extent; otherwise fall back to buffer-based candidate.
+  // Candidates of the same replication are first ranked by EvaluateCandidate.
   // Note: Final global validation happens after selection elsewhere.
   auto vars =
       loop_vars_.Map([](const IterVar &iv) { return PrimExpr(iv->var); });
@@ -846,6 +987,25 @@ ParallelOpNode::ChooseBestCandidate(const Fragment &candidate_from_buffer,
   auto rep_buf = candidate_from_buffer->ReplicateExtent();
   auto rep_plan = candidate_from_plan->ReplicateExtent();
 
+  // With the same replication, prefer the candidate whose partitioned loop
+  // moves more bytes per memory instruction across all its buffers, e.g. a
+  // mixed-dtype loop whose buffer-derived layout leaves a thread too few
+  // contiguous elements to vectorize the narrow operand.
+  if (analyzer_.CanProveEqual(rep_buf, rep_plan)) {
+    AccessCost buf_cost = EvaluateCandidate(candidate_from_buffer, T);
+    AccessCost plan_cost = EvaluateCandidate(candidate_from_plan, T);
+    if (plan_cost.Score() > buf_cost.Score()) {
+      DLOG(INFO) << "[FreeInfer] prefer PlanLoopPartition (more bytes per "
+                    "access).";
+      return candidate_from_plan;
+    }
+    if (buf_cost.Score() > plan_cost.Score()) {
+      DLOG(INFO) << "[FreeInfer] prefer compute_from_buffer (more bytes per "
+                    "access).";
+      return candidate_from_buffer;
+    }
+  }
+
   // Prefer the contained candidate (tends to minimize replication while
   // respecting access coverage):
   if (buf_contains_plan && !plan_contains_buf) {
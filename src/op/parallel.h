@@ -132,6 +132,23 @@ private:
   // Compute plan-based loop layout candidate using vectorization and thread
   // bounds.
   Fragment ComputePlanCandidate(const LayoutInferArgs &T) const;
+  // Memory efficiency of the loop partitioned by a candidate layout, which
+  // ranks the candidates that are equally valid.
+  struct AccessCost {
+    // Vector width in elements of the partitioned loop.
+    int vector_size{1};
+    // Average bytes moved by one global or shared memory instruction.
+    double bytes_per_access{0};
+    // Worst shared memory bank conflict degree of the first warp.
+    int bank_conflict{1};
+    double Score() const { return bytes_per_access / bank_conflict; }
+  };
+  AccessCost EvaluateCandidate(const Fragment &candidate,
+                               const LayoutInferArgs &T) const;
+  // Bank conflict degree of the shared memory accesses of `root` by the
+  // first warp, 1 when it cannot be evaluated.
+  int EstimateBankConflict(const For &root, const Fragment &candidate,
+                           int vector_size, const LayoutInferArgs &T) const;
   // Add replication guard predicates when needed for cross-thread stores.
   void BuildReplicationGuardsIfNeeded(
       const LayoutInferArgs &T,
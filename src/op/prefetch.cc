@@ -0,0 +1,152 @@
+/*!
+ * \file tl/op/prefetch.cc
+ *
+ * Define the L2 prefetch operator.
+ */
+
+#include "prefetch.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+
+#include "../target/utils.h"
+#include "builtin.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+// Granularity of prefetch.global.L2.
+static constexpr int kL2LineBytes = 128;
+
+/**
+ * @brief Construct a Prefetch operator from call arguments.
+ *
+ * @param args Call arguments: [src_region], the global region to bring into
+ * L2.
+ */
+Prefetch::Prefetch(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
+  ObjectPtr<PrefetchNode> node = tvm::ffi::make_object<PrefetchNode>();
+  BufferRegion region = NormalizeToBufferRegion(args[0]);
+  node->src = region->buffer;
+  node->region = region->region;
+  ICHECK(IsGlobalBuffer(node->src))
+      << "T.prefetch expects a global buffer, got `" << node->src->name
+      << "` in scope " << node->src.scope();
+  ICHECK(!node->region.empty());
+  data_ = std::move(node);
+}
+
+TileOperator PrefetchNode::Clone() const {
+  auto op = tvm::ffi::make_object<PrefetchNode>(*this);
+  return Prefetch(op);
+}
+
+Array<PrimExpr> PrefetchNode::RowIndices(PrimExpr row, PrimExpr col) const {
+  int ndim = region.size();
+  Array<PrimExpr> indices(ndim, PrimExpr());
+  indices.Set(ndim - 1, col);
+  for (int i = ndim - 2; i >= 0; --i) {
+    PrimExpr extent = cast(row.dtype(), region[i]->extent);
+    indices.Set(i, region[i]->min +
+                       cast(region[i]->min.dtype(), floormod(row, extent)));
+    row = floordiv(row, extent);
+  }
+  return indices;
+}
+
+/**
+ * @brief Lower the prefetch to per-thread L2 prefetch instructions.
+ *
+ * The innermost rows of the region are spread over the threads of the block.
+ * When every row starts on a 16-byte boundary and spans a multiple of 16
+ * bytes, targets with bulk copies issue one cp.async.bulk.prefetch per row;
+ * otherwise each thread issues prefetch.global.L2 for its 128-byte lines.
+ * Targets without an L2 prefetch instruction lower it to nothing.
+ */
+Stmt PrefetchNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
+  if (!TargetIsCuda(T.target)) {
+    return Evaluate(0);
+  }
+  int ndim = region.size();
+  int elem_bytes = std::max(1, src->dtype.bytes());
+  PrimExpr inner = region[ndim - 1]->extent;
+  DataType dtype = inner.dtype();
+  PrimExpr rows = make_const(dtype, 1);
+  for (int i = 0; i < ndim - 1; ++i) {
+    rows = rows * cast(dtype, region[i]->extent);
+  }
+  PrimExpr num_threads = cast(dtype, T.thread_bounds->extent);
+  PrimExpr tx = cast(dtype, T.thread_var - T.thread_bounds->min);
+
+  // Row starts stay 16-byte aligned when the offset of any row is.
+  Array<PrimExpr> row_start;
+  for (int i = 0; i < ndim - 1; ++i) {
+    row_start.push_back(region[i]->min +
+                        Var("r" + std::to_string(i), region[i]->min.dtype()));
+  }
+  row_start.push_back(region[ndim - 1]->min);
+  PrimExpr offset_bytes = src.OffsetOf(row_start).back() * elem_bytes;
+  arith::ModularSet offset_mod = analyzer->modular_set(offset_bytes);
+  PrimExpr row_bytes = analyzer->Simplify(inner * elem_bytes);
+  const auto *row_bytes_imm = row_bytes.as<IntImmNode>();
+  bool use_bulk = TargetHasBulkCopy(T.target) && row_bytes_imm &&
+                  row_bytes_imm->value % 16 == 0 &&
+                  offset_mod->coeff % 16 == 0 && offset_mod->base % 16 == 0;
+
+  PrimExpr items = rows;
+  PrimExpr line_elems =
+      make_const(dtype, std::max(1, kL2LineBytes / elem_bytes));
+  PrimExpr lines = ceildiv(inner, line_elems);
+  if (!use_bulk) {
+    items = rows * lines;
+  }
+
+  Var iter("p", dtype);
+  PrimExpr item = iter * num_threads + tx;
+  Stmt body;
+  if (use_bulk) {
+    Array<PrimExpr> indices = RowIndices(item, region[ndim - 1]->min);
+    PrimExpr addr = Call(DataType::Handle(), builtin::address_of(),
+                         {BufferLoad(src, indices)});
+    body = Evaluate(Call(DataType::Handle(), bulk_prefetch_l2(),
+                         {addr, cast(DataType::UInt(32), row_bytes)}));
+  } else {
+    PrimExpr col = region[ndim - 1]->min +
+                   cast(region[ndim - 1]->min.dtype(),
+                        floormod(item, lines) * line_elems);
+    Array<PrimExpr> indices = RowIndices(floordiv(item, lines), col);
+    PrimExpr addr = Call(DataType::Handle(), builtin::address_of(),
+                         {BufferLoad(src, indices)});
+    body = Evaluate(Call(DataType::Handle(), prefetch_l2(), {addr}));
+  }
+  body = IfThenElse(item < items, body);
+  PrimExpr trips = analyzer->Simplify(ceildiv(items, num_threads));
+  if (is_one(trips)) {
+    Map<Var, PrimExpr> vmap;
+    vmap.Set(iter, make_const(dtype, 0));
+    return Substitute(body, vmap);
+  }
+  return For(iter, 0, trips, ForKind::kSerial, body);
+}
+
+LayoutMap PrefetchNode::InferLayout(const LayoutInferArgs &T,
+                                    InferLevel level) const {
+  return {};
+}
+
+TIR_REGISTER_TL_TILE_OP(Prefetch, prefetch)
+    .set_num_inputs(1)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() { PrefetchNode::RegisterReflection(); }
+
+} // namespace tl
+} // namespace tvm
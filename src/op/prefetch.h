@@ -0,0 +1,56 @@
+/*!
+ * \file tl/op/prefetch.h
+ * \brief L2 prefetch of a global buffer region
+ */
+
+#ifndef TVM_TL_OP_PREFETCH_H_
+#define TVM_TL_OP_PREFETCH_H_
+
+#include "operator.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Node class for L2 prefetch operations
+class PrefetchNode : public TileOperatorNode {
+public:
+  tir::Buffer src;     ///< Global buffer to prefetch from
+  Array<Range> region; ///< Region of the buffer brought into L2
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.Prefetch", PrefetchNode,
+                                    TileOperatorNode);
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  LayoutMap InferLayout(const LayoutInferArgs &T, InferLevel level) const;
+  static const Op &Get();
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<PrefetchNode>()
+        .def_ro("src", &PrefetchNode::src)
+        .def_ro("region", &PrefetchNode::region);
+  }
+
+  TileOperator Clone() const;
+
+private:
+  /// Indices of element `col` of the `row`-th innermost row of the region
+  Array<PrimExpr> RowIndices(PrimExpr row, PrimExpr col) const;
+};
+
+/// Wrapper class for L2 prefetch operations
+class Prefetch : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(Prefetch, TileOperator,
+                                             PrefetchNode);
+  TVM_DLL
+  Prefetch(Array<PrimExpr> args,
+           Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_PREFETCH_H_
@@ -15,6 +15,8 @@
 #include "../op/parallel.h"
 #include "../target/utils.h"
 #include "../transform/loop_partition.h"
+#include "../transform/loop_vectorize.h"
+#include "builtin.h"
 #include "tir/transforms/ir_utils.h"
 #include "tvm/tir/stmt.h"
 #include "utils.h"
@@ -39,6 +41,11 @@ ReduceOp::ReduceOp(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
   node->dim = args[3].as<IntImm>().value()->value;
   node->type = ReduceType(reduce_type);
   node->clear = args[4].as<Bool>().value();
+  // (dst, reduce_type, clear) of each sibling fused into this reduction
+  for (size_t i = 5; i + 2 < args.size(); i += 3) {
+    node->siblings_.push_back(
+        ReduceOp({args[0], args[i], args[i + 1], args[3], args[i + 2]}));
+  }
   data_ = std::move(node);
 }
 
@@ -173,7 +180,14 @@ std::string ReduceOpNode::MakeCodegenReducer() const {
  *   emits a call to a templated `tl::AllReduce<...>::run` (or `run_hopper`)
  *   via `builtin::call_extern`. For sufficiently large reducing thread counts
  *   (> 32) a workspace is allocated via T.AddWorkspace and passed to the
- *   AllReduce call.
+ *   AllReduce call; when the workspace of all the elements of a thread fits
+ *   in 16 KiB, they are reduced by a single `run_batch<N>` call after the
+ *   thread-local loop instead, sharing its barriers.
+ * - Siblings fused into the reduction by FuseSiblingReductions share the
+ *   thread-local loop, which reads each source element once, and one
+ *   `run_fused` (`run_batch_fused<N>`) call exchanges all their accumulators
+ *   through the same barriers. If their destinations are laid out
+ *   differently, each reduction is lowered on its own instead.
  * - The final body is wrapped in parallel loops over the destination spatial
  *   dimensions and partitioned by the lowering thread variable. If a temporary
  *   clear buffer is used, it is allocated for the body.
@@ -197,10 +211,25 @@ Stmt ReduceOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
 
   if (src_scope == "local.fragment" && dst_scope == "local.fragment") {
 
+    // This reduction and its fused siblings, which share the loops when all
+    // the destinations are laid out alike
+    std::vector<const ReduceOpNode *> reductions = {this};
+    Fragment dst_layout = T.layout_map[this->dst].as<Fragment>().value();
+    for (const TileOperator &sibling : siblings_) {
+      const auto *node = sibling.as<ReduceOpNode>();
+      ICHECK(node) << "A fused sibling of a reduction must be a reduction.";
+      auto layout = T.layout_map[node->dst].as<Fragment>();
+      if (!layout || !dst_layout->IsEqual(layout.value().get())) {
+        Array<Stmt> seq = {WithoutSiblings()->Lower(T, analyzer)};
+        for (const TileOperator &op : siblings_)
+          seq.push_back(op->Lower(T, analyzer));
+        return SeqStmt(seq);
+      }
+      reductions.push_back(node);
+    }
+
     Buffer src_buffer = get_buffer(this->src);
-    Buffer dst_buffer = get_buffer(this->dst);
     Fragment src_layout = T.layout_map[this->src].as<Fragment>().value();
-    Fragment dst_layout = T.layout_map[this->dst].as<Fragment>().value();
     size_t src_dim = src_layout->InputDim();
     size_t dst_dim = dst_layout->InputDim();
 
@@ -235,34 +264,40 @@ Stmt ReduceOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
 
     Array<Stmt> stmts;
 
-    bool require_init = this->clear;
-    if (this->type->isSum() || this->type->isAbsSum() ||
-        this->type->isBitAnd() || this->type->isBitOr() ||
-        this->type->isBitXor()) {
-      require_init = true;
-    }
+    std::vector<Buffer> dst_buffers, clear_buffers;
+    std::vector<bool> need_duplicates;
+    for (const ReduceOpNode *r : reductions) {
+      Buffer dst_buffer = get_buffer(r->dst);
+      bool require_init = r->clear;
+      if (r->type->isSum() || r->type->isAbsSum() || r->type->isBitAnd() ||
+          r->type->isBitOr() || r->type->isBitXor()) {
+        require_init = true;
+      }
 
-    Buffer clear_buffer = dst_buffer;
-    bool need_duplicate = false;
-    if ((this->type->isSum() || this->type->isAbsSum()) && !this->clear) {
-      need_duplicate = true;
-    } else if (this->type->isBitAnd() && !this->clear) {
-      need_duplicate = true;
-    } else if ((this->type->isBitOr() || this->type->isBitXor()) &&
-               !this->clear) {
-      need_duplicate = true;
-    }
+      Buffer clear_buffer = dst_buffer;
+      bool need_duplicate = false;
+      if ((r->type->isSum() || r->type->isAbsSum()) && !r->clear) {
+        need_duplicate = true;
+      } else if (r->type->isBitAnd() && !r->clear) {
+        need_duplicate = true;
+      } else if ((r->type->isBitOr() || r->type->isBitXor()) && !r->clear) {
+        need_duplicate = true;
+      }
 
-    if (need_duplicate) {
-      // Create a new buffer with same shape and dtype as dst_buffer
-      clear_buffer = decl_buffer(dst_buffer->shape, dst_buffer->dtype,
-                                 dst_buffer->name + "_clear",
-                                 GetPtrStorageScope(dst_buffer->data));
-    }
-    // make reduce-init stmt
-    if (require_init) {
-      stmts.push_back(
-          BufferStore(clear_buffer, this->MakeInitValue(), dst_indices));
+      if (need_duplicate) {
+        // Create a new buffer with same shape and dtype as dst_buffer
+        clear_buffer = decl_buffer(dst_buffer->shape, dst_buffer->dtype,
+                                   dst_buffer->name + "_clear",
+                                   GetPtrStorageScope(dst_buffer->data));
+      }
+      // make reduce-init stmt
+      if (require_init) {
+        stmts.push_back(
+            BufferStore(clear_buffer, r->MakeInitValue(), dst_indices));
+      }
+      dst_buffers.push_back(dst_buffer);
+      clear_buffers.push_back(clear_buffer);
+      need_duplicates.push_back(need_duplicate);
     }
 
     // make thread-local reduce
@@ -277,11 +312,18 @@ Stmt ReduceOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
       src_var_compressed.push_back(var);
     }
 
-    Stmt reduce_local = BufferStore(
-        clear_buffer,
-        this->MakeReduce(BufferLoad(clear_buffer, dst_indices),
-                         BufferLoad(src_buffer, src_indice_compressed)),
-        dst_indices);
+    // The fused reductions read each element of the source once
+    Array<Stmt> local_updates;
+    for (size_t r = 0; r < reductions.size(); ++r) {
+      local_updates.push_back(BufferStore(
+          clear_buffers[r],
+          reductions[r]->MakeReduce(
+              BufferLoad(clear_buffers[r], dst_indices),
+              BufferLoad(src_buffer, src_indice_compressed)),
+          dst_indices));
+    }
+    Stmt reduce_local =
+        local_updates.size() > 1 ? SeqStmt(local_updates) : local_updates[0];
 
     for (int i = static_cast<int>(src_layout->OutputDim()) - 1; i >= 0; --i) {
       reduce_local =
@@ -291,6 +333,37 @@ Stmt ReduceOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
     }
     stmts.push_back(reduce_local);
 
+    // Reductions across warps exchange all the elements of the thread at once
+    // after the thread-local loop, so that they share the barriers, unless the
+    // workspace of that would grow too large.
+    Buffer clear_buffer = clear_buffers[0];
+    int64_t num_outputs = static_cast<int64_t>(reductions.size());
+    int64_t num_elems = 1;
+    for (const PrimExpr &extent : clear_buffer->shape) {
+      const int64_t *p_extent = as_const_int(extent);
+      num_elems = p_extent ? num_elems * (*p_extent) : -1;
+      if (num_elems < 0)
+        break;
+    }
+    const int64_t *p_threads = as_const_int(T.thread_bounds->extent);
+    constexpr int64_t kMaxBatchWorkspaceBytes = 16 * 1024;
+    bool can_batch = TargetIsCuda(T.target) && dst_layout->InputDim() > 0 &&
+                     num_elems > 1 && p_threads != nullptr &&
+                     num_outputs * num_elems * (*p_threads) *
+                             clear_buffer->dtype.bytes() <=
+                         kMaxBatchWorkspaceBytes;
+    bool use_named_barrier = TargetIsHopper(T.target) ||
+                             TargetIsSm100(T.target) ||
+                             TargetIsSM120(T.target);
+    Array<Stmt> batched_reduces;
+    // The reducers of the fused siblings, after the one of this reduction
+    std::string sibling_reducers;
+    for (size_t r = 1; r < reductions.size(); ++r) {
+      sibling_reducers += (r > 1 ? ", " : "");
+      sibling_reducers += reductions[r]->MakeCodegenReducer();
+    }
+    bool fused = reductions.size() > 1;
+
     PrimExpr src_thread = src_layout->ForwardThread(
         src_vars.Map([](const auto &iv) { return PrimExpr(iv->var); }), {});
     auto iter_sum =
@@ -306,20 +379,60 @@ Stmt ReduceOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
           continue;
 
         int reducing_threads = (*extent) * (*scale);
+        bool batched = can_batch && reducing_threads > 32;
         std::stringstream ss;
 
         auto thread_offset = T.thread_bounds->min;
-        if (TargetIsHopper(T.target) || TargetIsSm100(T.target) ||
-            TargetIsSM120(T.target)) {
-          auto all_threads = T.thread_bounds->extent;
-          ss << "tl::AllReduce<" << this->MakeCodegenReducer() << ", "
-             << reducing_threads << ", " << (*scale) << ", " << thread_offset
-             << ", " << all_threads << ">::run_hopper";
-        } else {
-          ss << "tl::AllReduce<" << this->MakeCodegenReducer() << ", "
-             << reducing_threads << ", " << (*scale) << ", " << thread_offset
-             << ">::run";
+        ss << "tl::AllReduce<" << this->MakeCodegenReducer() << ", "
+           << reducing_threads << ", " << (*scale) << ", " << thread_offset;
+        if (use_named_barrier || batched) {
+          ss << ", " << T.thread_bounds->extent;
+        }
+        ss << ">::";
+        if (batched) {
+          PrimExpr workspace = T.AddWorkspace(
+              num_outputs * num_elems * (*p_threads), clear_buffer->dtype);
+          Array<PrimExpr> args;
+          if (fused) {
+            ss << (use_named_barrier ? "run_batch_fused_hopper<"
+                                     : "run_batch_fused<")
+               << num_elems << ", " << sibling_reducers << ">";
+            args = {StringImm(ss.str()), workspace};
+            for (const Buffer &buf : clear_buffers)
+              args.push_back(buf.access_ptr(3));
+          } else {
+            ss << (use_named_barrier ? "run_batch_hopper<" : "run_batch<")
+               << num_elems << ">";
+            args = {StringImm(ss.str()), clear_buffer.access_ptr(3),
+                    workspace};
+          }
+          batched_reduces.push_back(Evaluate(
+              Call(DataType::Handle(), builtin::call_extern(), args)));
+          continue;
         }
+        if (fused) {
+          // One exchange of all the accumulators of the element
+          Array<PrimExpr> args;
+          if (reducing_threads > 32) {
+            ss << (use_named_barrier ? "run_fused_smem_hopper<"
+                                     : "run_fused_smem<")
+               << sibling_reducers << ">";
+            int64_t threads = *as_const_int(T.thread_bounds->extent);
+            args = {StringImm(ss.str()),
+                    T.AddWorkspace(num_outputs * threads, clear_buffer->dtype)};
+          } else {
+            ss << "run_fused<" << sibling_reducers << ">";
+            args = {StringImm(ss.str())};
+          }
+          for (const Buffer &buf : clear_buffers) {
+            args.push_back(Call(DataType::Handle(), builtin::address_of(),
+                                {BufferLoad(buf, dst_indices)}));
+          }
+          stmts.push_back(Evaluate(
+              Call(DataType::Handle(), builtin::call_extern(), args)));
+          continue;
+        }
+        ss << (use_named_barrier ? "run_hopper" : "run");
         Array<PrimExpr> thread_reduce_args = {
             StringImm(ss.str()), BufferLoad(clear_buffer, dst_indices)};
         if (reducing_threads > 32) {
@@ -333,41 +446,58 @@ Stmt ReduceOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
       }
     }
 
-    if (need_duplicate) {
-      PrimExpr src_val = BufferLoad(clear_buffer, dst_indices);
-      PrimExpr dst_val = BufferLoad(dst_buffer, dst_indices);
+    Array<Stmt> post_stmts;
+    for (size_t r = 0; r < reductions.size(); ++r) {
+      if (!need_duplicates[r])
+        continue;
+      const ReduceOpNode *op = reductions[r];
+      PrimExpr src_val = BufferLoad(clear_buffers[r], dst_indices);
+      PrimExpr dst_val = BufferLoad(dst_buffers[r], dst_indices);
       PrimExpr update;
-      if (this->type->isSum() || this->type->isAbsSum()) {
+      if (op->type->isSum() || op->type->isAbsSum()) {
         update = dst_val + src_val;
-      } else if (this->type->isBitAnd()) {
-        update = this->clear ? src_val : bitwise_and(dst_val, src_val);
-      } else if (this->type->isBitOr()) {
+      } else if (op->type->isBitAnd()) {
+        update = op->clear ? src_val : bitwise_and(dst_val, src_val);
+      } else if (op->type->isBitOr()) {
         update = bitwise_or(dst_val, src_val);
-      } else if (this->type->isBitXor()) {
+      } else if (op->type->isBitXor()) {
         update = bitwise_xor(dst_val, src_val);
       } else {
-        LOG(FATAL) << "Unsupported reduce type: " << this->type->type;
+        LOG(FATAL) << "Unsupported reduce type: " << op->type->type;
       }
-      stmts.push_back(BufferStore(dst_buffer, update, dst_indices));
+      post_stmts.push_back(BufferStore(dst_buffers[r], update, dst_indices));
     }
-
-    Stmt body = stmts.size() > 1 ? SeqStmt(stmts) : stmts[0];
-    for (int i = static_cast<int>(dst_layout->InputDim()) - 1; i >= 0; --i) {
-      body = For(dst_vars[i]->var, 0, dst_vars[i]->dom->extent,
-                 ForKind::kParallel, body);
+    if (batched_reduces.empty()) {
+      stmts.insert(stmts.end(), post_stmts.begin(), post_stmts.end());
+      post_stmts.clear();
     }
 
-    if (dst_layout->InputDim() > 0) {
-      body = PartitionLoop(Downcast<For>(body), T.thread_var, analyzer,
-                           dst_layout);
-    } else {
+    auto make_loop = [&](const Array<Stmt> &seq) -> Stmt {
+      Stmt body = seq.size() > 1 ? SeqStmt(seq) : seq[0];
+      for (int i = static_cast<int>(dst_layout->InputDim()) - 1; i >= 0; --i) {
+        body = For(dst_vars[i]->var, 0, dst_vars[i]->dom->extent,
+                   ForKind::kParallel, body);
+      }
+      if (dst_layout->InputDim() > 0) {
+        return PartitionLoop(Downcast<For>(body), T.thread_var, analyzer,
+                             dst_layout);
+      }
       PrimExpr guard = (T.thread_var == T.thread_bounds->min);
-      body = IfThenElse(guard, body);
+      return IfThenElse(guard, body);
+    };
+
+    Array<Stmt> seq = {make_loop(stmts)};
+    seq.insert(seq.end(), batched_reduces.begin(), batched_reduces.end());
+    if (!post_stmts.empty()) {
+      seq.push_back(make_loop(post_stmts));
     }
+    Stmt body = seq.size() > 1 ? SeqStmt(seq) : seq[0];
 
-    if (need_duplicate) {
-      body = Allocate(clear_buffer->data, clear_buffer->dtype,
-                      clear_buffer->shape, const_true(), body);
+    for (size_t r = 0; r < reductions.size(); ++r) {
+      if (need_duplicates[r]) {
+        body = Allocate(clear_buffers[r]->data, clear_buffers[r]->dtype,
+                        clear_buffers[r]->shape, const_true(), body);
+      }
     }
     return body;
   }
@@ -377,11 +507,26 @@ Stmt ReduceOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
   return Stmt();
 }
 
+TileOperator ReduceOpNode::WithoutSiblings() const {
+  auto op = tvm::ffi::make_object<ReduceOpNode>(*this);
+  op->siblings_ = {};
+  return ReduceOp(op);
+}
+
 LayoutMap ReduceOpNode::InferLayout(const LayoutInferArgs &T,
                                     InferLevel level) const {
   if (level >= InferLevel::kStrict)
     return {};
 
+  if (!siblings_.empty()) {
+    LayoutMap result = WithoutSiblings()->InferLayout(T, level);
+    for (const TileOperator &sibling : siblings_) {
+      for (const auto &[buffer, layout] : sibling->InferLayout(T, level))
+        result.Set(buffer, layout);
+    }
+    return result;
+  }
+
   if (IsFragmentBuffer(src) && IsFragmentBuffer(dst) &&
       T.layout_map.count(src)) {
     auto src_layout = T.layout_map[src].as<Fragment>().value();
@@ -501,7 +646,10 @@ CumSumOp::CumSumOp(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
   /// - dst: output buffer
   /// - dim: dimension to cumsum
   /// - reverse: whether to cumsum in reverse order
-  CHECK_EQ(args.size(), 4);
+  /// - tile_id, has_state, has_reset: optional, followed by the state and
+  ///   reset regions that are present, in order
+  CHECK(args.size() == 4 || args.size() >= 7)
+      << "Unexpected number of cumsum arguments: " << args.size();
   ObjectPtr<CumSumOpNode> node = tvm::ffi::make_object<CumSumOpNode>();
   // node->src = vmap[GetVarFromAccessPtr(args[0])];
   // node->dst = vmap[GetVarFromAccessPtr(args[1])];
@@ -515,6 +663,50 @@ CumSumOp::CumSumOp(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
       << "The dim of cumsum should be less than the number of dimensions. Got "
          "dim="
       << node->dim << ", but src has " << node->src->shape.size() << " dims.";
+  if (args.size() > 4) {
+    node->tile_id = args[4];
+    size_t next = 7;
+    if (is_one(args[5])) {
+      ICHECK_LT(next, args.size()) << "cumsum is missing its scan state";
+      node->stateRegion_ = NormalizeToBufferRegion(args[next++]);
+      node->state = node->stateRegion_->buffer;
+      ICHECK(IsGlobalBuffer(node->state) && node->state->dtype.bits() == 64 &&
+             node->state->dtype.is_scalar() &&
+             (node->state->dtype.is_int() || node->state->dtype.is_uint()))
+          << "The scan state of cumsum must be a global int64 buffer, got "
+          << node->state->name << " of " << node->state->dtype << " in "
+          << node->state.scope();
+      size_t ndim = node->stateRegion_->region.size();
+      ICHECK_GE(ndim, 2) << "The scan state of cumsum must be "
+                            "(num_tiles, lanes), got "
+                         << node->stateRegion_;
+      for (size_t i = 0; i + 2 < ndim; ++i) {
+        ICHECK(is_one(node->stateRegion_->region[i]->extent))
+            << "The scan state of cumsum must be (num_tiles, lanes), got "
+            << node->stateRegion_;
+      }
+      arith::Analyzer analyzer;
+      const Range &lanes = node->stateRegion_->region[ndim - 1];
+      ICHECK(analyzer.CanProveEqual(lanes->extent,
+                                    node->state->shape[ndim - 1]))
+          << "The scan state of cumsum must span the lanes of "
+          << node->state->name << ", got " << node->stateRegion_;
+      ICHECK(node->dst->dtype.bits() == 32 && node->dst->dtype.is_scalar())
+          << "Device-wide cumsum packs the totals of the tiles with their "
+             "status in 64 bits and supports 32-bit dtypes, got "
+          << node->dst->dtype;
+    }
+    if (is_one(args[6])) {
+      ICHECK_LT(next, args.size()) << "cumsum is missing its reset flags";
+      node->resetRegion_ = NormalizeToBufferRegion(args[next++]);
+      node->reset = node->resetRegion_->buffer;
+      ICHECK(node->reset->dtype.is_int() || node->reset->dtype.is_uint() ||
+             node->reset->dtype.is_bool())
+          << "The reset flags of cumsum must be integers, got "
+          << node->reset->dtype;
+    }
+    ICHECK_EQ(next, args.size()) << "cumsum got unexpected operands";
+  }
 
   data_ = std::move(node);
 }
@@ -540,6 +732,9 @@ Stmt CumSumOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
       src_extents.push_back(range->extent);
     }
     int ndim = static_cast<int>(src_extents.size());
+    if (reset.defined() || state.defined()) {
+      return LowerSegmentedScan(T, srcPtr, dstPtr, src_extents);
+    }
 
     if (ndim == 1) {
       ICHECK_EQ(dim, 0) << "Cumulative sum over a 1D buffer only supports dim "
@@ -565,6 +760,85 @@ Stmt CumSumOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
   return Stmt();
 }
 
+/**
+ * @brief Lower a segmented or device-wide scan of a shared tile.
+ *
+ * Emits `tl::DeviceCumSum<threads, reverse, segmented, device>::run`. The
+ * tile is viewed as `lanes` independent sequences of `len` elements: the
+ * whole of a 1D tile, the rows (dim = 1) or the columns (dim = 0) of a 2D
+ * tile. Every sequence is scanned by one warp, which restarts at the flagged
+ * elements. In a device-wide scan the warp then publishes the total of the
+ * sequence in the status word of (tile_id, lane) and looks back over the
+ * words of the preceding tiles for the prefix to add, so that one launch
+ * scans a whole tensor.
+ */
+Stmt CumSumOpNode::LowerSegmentedScan(const LowerArgs &T,
+                                      const PrimExpr &src_ptr,
+                                      const PrimExpr &dst_ptr,
+                                      const Array<PrimExpr> &extents) const {
+  const int ndim = static_cast<int>(extents.size());
+  ICHECK(ndim == 1 || ndim == 2)
+      << "Segmented and device-wide cumsum support 1D or 2D tiles, got "
+      << ndim << "D.";
+  ICHECK(TargetIsCuda(T.target))
+      << "Segmented and device-wide cumsum are implemented for CUDA only, "
+         "but the target is "
+      << T.target->str();
+  const int64_t *p_threads = as_const_int(T.thread_bounds->extent);
+  ICHECK(p_threads && *p_threads % 32 == 0)
+      << "Segmented and device-wide cumsum require a whole number of warps, "
+         "got "
+      << T.thread_bounds->extent << " threads";
+  PrimExpr row_stride = src->shape.back();
+  PrimExpr lanes = 1, len = extents[0], lane_stride = 0, elem_stride = 1;
+  if (ndim == 2 && dim == 1) {
+    lanes = extents[0];
+    len = extents[1];
+    lane_stride = row_stride;
+  } else if (ndim == 2) {
+    lanes = extents[1];
+    len = extents[0];
+    lane_stride = 1;
+    elem_stride = row_stride;
+  }
+
+  arith::Analyzer analyzer;
+  PrimExpr reset_ptr = src_ptr;
+  if (reset.defined()) {
+    ICHECK(IsSharedBuffer(reset))
+        << "The reset flags of cumsum must be in shared memory, got "
+        << reset.scope();
+    bool same_shape = resetRegion_->region.size() == extents.size() &&
+                      analyzer.CanProveEqual(reset->shape.back(), row_stride);
+    for (size_t i = 0; same_shape && i < extents.size(); ++i) {
+      same_shape =
+          analyzer.CanProveEqual(resetRegion_->region[i]->extent, extents[i]);
+    }
+    ICHECK(same_shape) << "The reset flags of cumsum must be shaped as "
+                       << src->name << ", got " << resetRegion_;
+    reset_ptr = MakeAccessPtrFromRegion(resetRegion_, 1);
+  }
+  PrimExpr state_ptr = dst_ptr;
+  if (state.defined()) {
+    ICHECK(analyzer.CanProveEqual(state->shape.back(), lanes))
+        << "The scan state " << state->name << " must hold " << lanes
+        << " lanes per tile, got shape " << state->shape;
+    state_ptr = MakeAccessPtrFromRegion(stateRegion_, 3);
+  }
+
+  std::stringstream ss;
+  ss << "tl::DeviceCumSum<" << *p_threads << ", "
+     << (reverse ? "true" : "false") << ", "
+     << (reset.defined() ? "true" : "false") << ", "
+     << (state.defined() ? "true" : "false") << ">::run";
+  PrimExpr tile = state.defined() ? tile_id : PrimExpr(0);
+  Array<PrimExpr> args = {StringImm(ss.str()), src_ptr,   dst_ptr,
+                          reset_ptr,           state_ptr, tile,
+                          lanes,               len,       lane_stride,
+                          elem_stride};
+  return Evaluate(Call(DataType::Handle(), builtin::call_extern(), args));
+}
+
 LayoutMap CumSumOpNode::InferLayout(const LayoutInferArgs &T,
                                     InferLevel level) const {
   // Only infer layout in strict mode
@@ -596,18 +870,1352 @@ LayoutMap CumSumOpNode::InferLayout(const LayoutInferArgs &T,
 
   check_or_set_linear_layout(src);
   check_or_set_linear_layout(dst);
+  if (reset.defined()) {
+    check_or_set_linear_layout(reset);
+  }
 
   return result_map;
 }
 
 TIR_REGISTER_TL_TILE_OP(CumSumOp, cumsum)
-    .set_num_inputs(4)
+    .set_num_inputs(-1)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TopKOp::TopKOp(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
+  /// TopK constructor arguments:
+  /// - src: fragment reduced along its last dimension
+  /// - out_vals: selected values, k per row
+  /// - out_idx: columns of the selected values, k per row
+  /// - k: number of selected elements per row
+  /// - largest: select the largest elements, otherwise the smallest
+  CHECK_EQ(args.size(), 5);
+  ObjectPtr<TopKOpNode> node = tvm::ffi::make_object<TopKOpNode>();
+  node->srcRegion_ = NormalizeToBufferRegion(args[0]);
+  node->valsRegion_ = NormalizeToBufferRegion(args[1]);
+  node->idxRegion_ = NormalizeToBufferRegion(args[2]);
+  node->src = node->srcRegion_->buffer;
+  node->out_vals = node->valsRegion_->buffer;
+  node->out_idx = node->idxRegion_->buffer;
+  node->k = args[3].as<IntImm>().value()->value;
+  node->largest = args[4].as<Bool>().value();
+  ICHECK(IsFragmentBuffer(node->src))
+      << "T.topk expects a fragment source, but " << node->src->name
+      << " is in " << node->src.scope();
+  for (const BufferRegion &out : {node->valsRegion_, node->idxRegion_}) {
+    ICHECK(IsSharedBuffer(out->buffer) || IsGlobalBuffer(out->buffer))
+        << "T.topk writes shared or global buffers, but " << out->buffer->name
+        << " is in " << out->buffer.scope();
+    ICHECK_EQ(out->region.size(), node->src->shape.size())
+        << "T.topk expects " << out->buffer->name << " to have the rank of "
+        << node->src->name;
+    const int64_t *extent = as_const_int(out->region.back()->extent);
+    ICHECK(extent && *extent == node->k)
+        << "T.topk writes " << node->k << " elements per row, but the region "
+        << "of " << out->buffer->name << " is " << out->region;
+  }
+  ICHECK(node->out_vals->dtype == node->src->dtype)
+      << "T.topk expects values of " << node->src->dtype << ", got "
+      << node->out_vals->dtype;
+  ICHECK(node->out_idx->dtype == DataType::Int(32))
+      << "T.topk writes int32 indices, got " << node->out_idx->dtype;
+  const int64_t *cols = as_const_int(node->src->shape.back());
+  ICHECK(cols && node->k >= 1 && node->k <= *cols)
+      << "T.topk expects 1 <= k <= " << node->src->shape.back() << ", got k = "
+      << node->k;
+  data_ = std::move(node);
+}
+
+TileOperator TopKOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<TopKOpNode>(*this);
+  return TopKOp(op);
+}
+
+/**
+ * @brief Layout of the rows of a fragment reduced along its last dimension.
+ *
+ * Every row is replicated over the threads holding a part of it, as in the
+ * layout ReduceOpNode::InferLayout gives the destination of a reduction.
+ */
+static Fragment ReducedRowLayout(const Fragment &src_layout,
+                                 const Range &thread_bounds) {
+  const int dim = static_cast<int>(src_layout->InputDim()) - 1;
+  PrimExpr indice_rep_extent = src_layout->InputShape()[dim];
+  Array<PrimExpr> fwd;
+  Array<PrimExpr> row_shape;
+  for (int i = 0; i < dim; ++i) {
+    fwd.push_back(InputPlaceholder(i));
+    row_shape.push_back(src_layout->InputShape()[i]);
+  }
+  fwd.push_back(FloorMod(ReplicationPlaceholder(), indice_rep_extent));
+  PrimExpr thd = src_layout->ForwardThread(
+      fwd, FloorDiv(ReplicationPlaceholder(), indice_rep_extent));
+  return Fragment(row_shape, {}, thd,
+                  indice_rep_extent * src_layout->ReplicateExtent(),
+                  std::nullopt)
+      ->CondenseReplicateVar()
+      ->BindThreadRange(thread_bounds);
+}
+
+/**
+ * @brief Thread-local view of the rows of a 2D fragment.
+ *
+ * Gives the elements of row `row_iv` a thread holds, as local indices of the
+ * fragment in the thread-local iterators `local_vars`, and the group of
+ * threads sharing a row, found from the thread split of the columns as for
+ * ReduceOp.
+ */
+struct RowReduction {
+  IterVar row_iv, col_iv;
+  Array<PrimExpr> local_indices;
+  Array<IterVar> local_vars;
+  int reducing_threads{1}; ///< Width of the group of threads sharing a row
+  int split_scale{1};      ///< Thread stride within the group
+  bool single_split{true}; ///< Whether the columns take one thread split
+
+  RowReduction(const Fragment &layout, arith::Analyzer *analyzer)
+      : row_iv(Range(0, layout->InputShape()[0]), Var("i"),
+               IterVarType::kDataPar),
+        col_iv(Range(0, layout->InputShape()[1]), Var("rv"),
+               IterVarType::kDataPar) {
+    Array<IterVar> vars = {row_iv, col_iv};
+    Array<PrimExpr> indices = layout->Forward({row_iv->var, col_iv->var});
+    for (size_t i = 0; i < layout->OutputDim(); ++i) {
+      PrimExpr expr;
+      IterVar var;
+      std::tie(expr, var) =
+          CompressIterator(indices[i], vars, col_iv->var, analyzer);
+      local_indices.push_back(expr);
+      local_vars.push_back(var);
+    }
+    PrimExpr thread = layout->ForwardThread({row_iv->var, col_iv->var}, {});
+    auto iter_sum =
+        arith::NormalizeToIterSum(thread, ToVMap(vars), analyzer);
+    for (const auto &iter_split : iter_sum->args) {
+      auto mark = iter_split->source->source.as<Var>();
+      ICHECK(mark) << "Not a normalized iterator: " << iter_split->source;
+      if (!mark.value().same_as(col_iv->var))
+        continue;
+      auto p_scale = as_const_int(iter_split->scale);
+      auto p_extent = as_const_int(iter_split->extent);
+      ICHECK(p_scale != nullptr && p_extent != nullptr);
+      if (*p_extent == 1)
+        continue;
+      single_split = single_split && reducing_threads == 1;
+      reducing_threads = (*p_extent) * (*p_scale);
+      split_scale = *p_scale;
+    }
+  }
+
+  /// Offset of the current element among the elements of the row held
+  PrimExpr LocalOffset() const {
+    PrimExpr offset = 0;
+    for (const IterVar &iv : local_vars) {
+      offset = offset * iv->dom->extent + iv->var;
+    }
+    return offset;
+  }
+
+  /// Unrolled loops of `body` over the elements of the row held, in fresh
+  /// variables so that the loops can be instantiated more than once
+  Stmt ForEachLocal(const Stmt &body) const {
+    Map<Var, PrimExpr> vmap;
+    Array<Var> vars;
+    for (const IterVar &iv : local_vars) {
+      Var var = iv->var.copy_with_suffix("");
+      vmap.Set(iv->var, var);
+      vars.push_back(var);
+    }
+    Stmt loop = Substitute(body, vmap);
+    for (int i = static_cast<int>(local_vars.size()) - 1; i >= 0; --i) {
+      loop = For(vars[i], 0, local_vars[i]->dom->extent, ForKind::kUnrolled,
+                 loop, std::nullopt,
+                 {{tir::attr::pragma_unroll_explicit, Bool(false)}});
+    }
+    return loop;
+  }
+};
+
+/**
+ * @brief Lower the top-k selection of the rows of a fragment.
+ *
+ * The threads holding a row gather their elements and the columns of them
+ * into local arrays and call `tl::TopK` (k <= kMaxBitonicK) or
+ * `tl::TopKRadix`. The group of threads sharing a row is found from the
+ * thread split of the reduced dimension, as for ReduceOp; the row loop is
+ * partitioned with the layout ReduceOp would infer for the reduced fragment,
+ * so every thread of the group runs the selection of the row together.
+ * Groups wider than a warp exchange through workspaces in shared memory.
+ */
+Stmt TopKOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
+  Buffer src_buffer = T.buffer_remap.count(src) ? T.buffer_remap[src] : src;
+  Fragment src_layout = T.layout_map[src].as<Fragment>().value();
+  const int dim = static_cast<int>(src_layout->InputDim()) - 1;
+  const int64_t *p_threads = as_const_int(T.thread_bounds->extent);
+  ICHECK(p_threads) << "T.topk requires a constant block size";
+  const int64_t num_threads = *p_threads;
+
+  Array<IterVar> row_vars;
+  for (int i = 0; i < dim; ++i) {
+    Var var = Var(std::string{char('i' + i)});
+    row_vars.push_back(IterVar(Range(0, src_layout->InputShape()[i]), var,
+                               IterVarType::kDataPar));
+  }
+  Array<IterVar> src_vars = row_vars;
+  IterVar reduce_iv(Range(0, src_layout->InputShape()[dim]), Var("rv"),
+                    IterVarType::kDataPar);
+  src_vars.push_back(reduce_iv);
+  Array<PrimExpr> src_exprs =
+      src_vars.Map([](const auto &iv) { return PrimExpr(iv->var); });
+  Array<PrimExpr> src_indices = src_layout->Forward(src_exprs);
+
+  // The column of every element held by the thread, reported with its value.
+  Buffer col_buffer = decl_buffer(src_layout->OutputShape(), DataType::Int(32),
+                                  src->name + "_topk_col", "local");
+  Stmt fill_col = BufferStore(
+      col_buffer, cast(DataType::Int(32), reduce_iv->var), src_indices);
+  for (int i = dim; i >= 0; --i) {
+    fill_col = For(src_vars[i]->var, 0, src_vars[i]->dom->extent,
+                   ForKind::kParallel, fill_col);
+  }
+  fill_col = PartitionLoop(Downcast<For>(fill_col), T.thread_var, analyzer,
+                           src_layout);
+
+  // Gather the elements of the row held by the thread.
+  Array<PrimExpr> src_indice_compressed;
+  Array<IterVar> src_var_compressed;
+  for (size_t i = 0; i < src_layout->OutputDim(); ++i) {
+    PrimExpr expr;
+    IterVar var;
+    std::tie(expr, var) =
+        CompressIterator(src_indices[i], src_vars, reduce_iv->var, analyzer);
+    src_indice_compressed.push_back(expr);
+    src_var_compressed.push_back(var);
+  }
+  int64_t num_local = 1;
+  PrimExpr local_index = 0;
+  for (int i = static_cast<int>(src_var_compressed.size()) - 1; i >= 0; --i) {
+    const int64_t *extent = as_const_int(src_var_compressed[i]->dom->extent);
+    ICHECK(extent) << "T.topk requires a constant number of elements per "
+                      "thread";
+    local_index = local_index + src_var_compressed[i]->var * int(num_local);
+    num_local *= *extent;
+  }
+  Buffer vals_local = decl_buffer({Integer(num_local)}, src->dtype,
+                                  src->name + "_topk_vals", "local");
+  Buffer idx_local = decl_buffer({Integer(num_local)}, DataType::Int(32),
+                                 src->name + "_topk_idx", "local");
+  Stmt gather = SeqStmt(
+      {BufferStore(vals_local, BufferLoad(src_buffer, src_indice_compressed),
+                   {local_index}),
+       BufferStore(idx_local, BufferLoad(col_buffer, src_indice_compressed),
+                   {local_index})});
+  for (int i = static_cast<int>(src_var_compressed.size()) - 1; i >= 0; --i) {
+    gather =
+        For(src_var_compressed[i]->var, 0, src_var_compressed[i]->dom->extent,
+            ForKind::kUnrolled, gather, std::nullopt,
+            {{tir::attr::pragma_unroll_explicit, Bool(false)}});
+  }
+
+  // The threads sharing a row: `reducing_threads` consecutive threads of which
+  // every `scale`-th one holds a part of it.
+  int reducing_threads = 1, scale = 1;
+  PrimExpr src_thread = src_layout->ForwardThread(src_exprs, {});
+  auto iter_sum =
+      arith::NormalizeToIterSum(src_thread, ToVMap(src_vars), analyzer);
+  for (const auto &iter_split : iter_sum->args) {
+    auto mark = iter_split->source->source.as<Var>();
+    ICHECK(mark) << "Not a normalized iterator: " << iter_split->source;
+    if (!mark.value().same_as(reduce_iv->var))
+      continue;
+    auto split_scale = as_const_int(iter_split->scale);
+    auto split_extent = as_const_int(iter_split->extent);
+    ICHECK(split_scale != nullptr && split_extent != nullptr);
+    if (*split_extent == 1)
+      continue;
+    ICHECK_EQ(reducing_threads, 1)
+        << "T.topk expects the columns of " << src->name
+        << " to be spread over a single thread split, got "
+        << src_layout->DebugOutput();
+    reducing_threads = (*split_extent) * (*split_scale);
+    scale = *split_scale;
+  }
+
+  auto row_ptr = [&](const BufferRegion &region) {
+    Array<PrimExpr> indices;
+    for (int i = 0; i < dim; ++i) {
+      indices.push_back(region->region[i]->min + row_vars[i]->var);
+    }
+    indices.push_back(region->region[dim]->min);
+    return Call(DataType::Handle(), builtin::address_of(),
+                {BufferLoad(region->buffer, indices)});
+  };
+
+  bool use_bitonic = k <= kMaxBitonicK;
+  bool use_named_barrier = TargetIsHopper(T.target) ||
+                           TargetIsSm100(T.target) || TargetIsSM120(T.target);
+  std::stringstream ss;
+  ss << (use_bitonic ? "tl::TopK<" : "tl::TopKRadix<") << k << ", "
+     << num_local << ", " << (largest ? "true" : "false") << ", "
+     << reducing_threads << ", " << scale << ", " << T.thread_bounds->min
+     << ", " << num_threads << ">::"
+     << (use_named_barrier ? "run_hopper" : "run");
+  Array<PrimExpr> call_args = {StringImm(ss.str()), vals_local.access_ptr(1),
+                               idx_local.access_ptr(1), row_ptr(valsRegion_),
+                               row_ptr(idxRegion_)};
+  if (reducing_threads > 32) {
+    if (use_bitonic) {
+      // Every thread publishes its sorted list of the next power of two of k.
+      int slots = 1;
+      while (slots < k)
+        slots *= 2;
+      call_args.push_back(T.AddWorkspace(num_threads * slots, src->dtype));
+      call_args.push_back(
+          T.AddWorkspace(num_threads * slots, DataType::Int(32)));
+    } else {
+      call_args.push_back(T.AddWorkspace(num_threads, DataType::Int(32)));
+    }
+  }
+  Stmt body = SeqStmt(
+      {gather, Evaluate(Call(DataType::Handle(), builtin::call_extern(),
+                             call_args))});
+
+  if (dim > 0) {
+    Fragment row_layout = ReducedRowLayout(src_layout, T.thread_bounds);
+    for (int i = dim - 1; i >= 0; --i) {
+      body = For(row_vars[i]->var, 0, row_vars[i]->dom->extent,
+                 ForKind::kParallel, body);
+    }
+    body =
+        PartitionLoop(Downcast<For>(body), T.thread_var, analyzer, row_layout);
+  }
+  body = SeqStmt({fill_col, body});
+  for (const Buffer &buf : {vals_local, idx_local, col_buffer}) {
+    body = Allocate(buf->data, buf->dtype, buf->shape, const_true(), body);
+  }
+  return body;
+}
+
+// The outputs are addressed as plain rows, shared ones must stay linear.
+LayoutMap TopKOpNode::InferLayout(const LayoutInferArgs &T,
+                                  InferLevel level) const {
+  if (level != InferLevel::kStrict) {
+    return {};
+  }
+  LayoutMap result_map;
+  for (const Buffer &buf : {out_vals, out_idx}) {
+    if (!IsSharedBuffer(buf))
+      continue;
+    Layout linear_layout = makeLinearLayout(buf->shape);
+    if (T.layout_map.count(buf)) {
+      Layout existing = T.layout_map.Get(buf).value().as<Layout>().value();
+      ICHECK(StructuralEqual()(existing, linear_layout))
+          << "T.topk requires a linear layout for shared buffer " << buf->name
+          << ", but got a non-linear layout.";
+    } else {
+      result_map.Set(buf, linear_layout);
+    }
+  }
+  return result_map;
+}
+
+TIR_REGISTER_TL_TILE_OP(TopKOp, topk)
+    .set_num_inputs(5)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+OnlineSoftmaxOp::OnlineSoftmaxOp(Array<PrimExpr> args,
+                                 Map<String, ObjectRef> annotations) {
+  /// OnlineSoftmax constructor arguments:
+  /// - scores: (M, N) fragment, rewritten to its exp2 weights
+  /// - scores_max: (M,) fragment with the running maximum of the rows
+  /// - scores_sum: (M,) fragment with the running sum of the weights
+  /// - scale: factor applied to the scores before exp2
+  /// - accs...: (M, D) fragments rescaled by the change of the maximum
+  CHECK_GE(args.size(), 4);
+  ObjectPtr<OnlineSoftmaxOpNode> node =
+      tvm::ffi::make_object<OnlineSoftmaxOpNode>();
+  node->scoresRegion_ = NormalizeToBufferRegion(args[0]);
+  node->maxRegion_ = NormalizeToBufferRegion(args[1]);
+  node->sumRegion_ = NormalizeToBufferRegion(args[2]);
+  node->scores = node->scoresRegion_->buffer;
+  node->scores_max = node->maxRegion_->buffer;
+  node->scores_sum = node->sumRegion_->buffer;
+  node->scale = args[3];
+  for (size_t i = 4; i < args.size(); ++i) {
+    BufferRegion region = NormalizeToBufferRegion(args[i]);
+    node->accRegions_.push_back(region);
+    node->accs.push_back(region->buffer);
+  }
+  ICHECK_EQ(node->scores->shape.size(), 2)
+      << "T.online_softmax expects (M, N) scores, got " << node->scores->shape;
+  for (const Buffer &buf : {node->scores, node->scores_max, node->scores_sum}) {
+    ICHECK(IsFragmentBuffer(buf))
+        << "T.online_softmax expects fragments, but " << buf->name
+        << " is in " << buf.scope();
+    ICHECK(buf->dtype == DataType::Float(32))
+        << "T.online_softmax keeps its statistics in float32, but "
+        << buf->name << " is " << buf->dtype;
+  }
+  for (const Buffer &buf : {node->scores_max, node->scores_sum}) {
+    ICHECK(buf->shape.size() == 1 &&
+           StructuralEqual()(buf->shape[0], node->scores->shape[0]))
+        << "T.online_softmax expects " << buf->name << " of shape ("
+        << node->scores->shape[0] << ",), got " << buf->shape;
+  }
+  for (const Buffer &acc : node->accs) {
+    ICHECK(IsFragmentBuffer(acc) && acc->shape.size() == 2 &&
+           StructuralEqual()(acc->shape[0], node->scores->shape[0]))
+        << "T.online_softmax expects accumulator fragments of shape ("
+        << node->scores->shape[0] << ", D), got " << acc->name << " of shape "
+        << acc->shape << " in " << acc.scope();
+  }
+  data_ = std::move(node);
+}
+
+TileOperator OnlineSoftmaxOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<OnlineSoftmaxOpNode>(*this);
+  return OnlineSoftmaxOp(op);
+}
+
+/**
+ * @brief Lower the online softmax update of the rows of a fragment.
+ *
+ * For every row i, with m = scores_max[i] and s = scale:
+ *   m' = max(m, max_j scores[i, j])
+ *   scores[i, j] = exp2(scores[i, j] * s - m' * s)
+ *   scores_sum[i] = scores_sum[i] * exp2(m * s - m' * s) + sum_j scores[i, j]
+ *   acc[i, :] *= exp2(m * s - m' * s)
+ *   scores_max[i] = m'
+ *
+ * Every thread takes the maximum of its part of the row and the sum of its
+ * weights relative to it in one pass over its elements; the pairs are merged
+ * by `tl::OnlineSoftmaxReduce`, a single exchange between the threads of the
+ * row where reduce_max and reduce_sum need one each. The weights are then
+ * corrected by one multiplication. Rows whose scores are all -inf get zero
+ * weights.
+ */
+Stmt OnlineSoftmaxOpNode::Lower(const LowerArgs &T,
+                                arith::Analyzer *analyzer) const {
+  auto get_buffer = [&](const Buffer &buf) {
+    return T.buffer_remap.count(buf) ? T.buffer_remap[buf] : buf;
+  };
+  Buffer scores_buffer = get_buffer(scores);
+  Buffer max_buffer = get_buffer(scores_max);
+  Buffer sum_buffer = get_buffer(scores_sum);
+  Fragment scores_layout = T.layout_map[scores].as<Fragment>().value();
+  Fragment max_layout = T.layout_map[scores_max].as<Fragment>().value();
+  Fragment sum_layout = T.layout_map[scores_sum].as<Fragment>().value();
+  Fragment row_layout = ReducedRowLayout(scores_layout, T.thread_bounds);
+  DataType dtype = scores->dtype;
+  PrimExpr s = cast(dtype, scale);
+  PrimExpr neg_inf = -infinity(dtype);
+
+  RowReduction rows(scores_layout, analyzer);
+  ICHECK(rows.single_split)
+      << "T.online_softmax expects the columns of " << scores->name
+      << " to be spread over a single thread split, got "
+      << scores_layout->DebugOutput();
+
+  Array<PrimExpr> zero = {0};
+  auto scratch = [&](const std::string &name) {
+    return decl_buffer({1}, dtype, scores->name + "_" + name, "local");
+  };
+  Buffer row_max = scratch("row_max"), row_sum = scratch("row_sum");
+  Buffer row_base = scratch("row_base"), row_shift = scratch("row_shift");
+  Buffer alpha = decl_buffer(row_layout->OutputShape(), dtype,
+                             scores->name + "_rescale", "local");
+  auto load = [&](const Buffer &buf) { return BufferLoad(buf, zero); };
+  PrimExpr score = BufferLoad(scores_buffer, rows.local_indices);
+  Array<PrimExpr> row = {rows.row_iv->var};
+  Array<PrimExpr> max_index = max_layout->Forward(row);
+  Array<PrimExpr> sum_index = sum_layout->Forward(row);
+  Array<PrimExpr> alpha_index = row_layout->Forward(row);
+
+  Array<Stmt> stmts;
+  // Maximum of the part of the row, then its weights relative to it.
+  stmts.push_back(BufferStore(row_max, neg_inf, zero));
+  stmts.push_back(rows.ForEachLocal(
+      BufferStore(row_max, max(load(row_max), score), zero)));
+  stmts.push_back(BufferStore(row_base, load(row_max) * s, zero));
+  stmts.push_back(BufferStore(
+      row_shift, Select(load(row_max) == neg_inf, make_zero(dtype),
+                        load(row_base)),
+      zero));
+  stmts.push_back(BufferStore(row_sum, make_zero(dtype), zero));
+  stmts.push_back(rows.ForEachLocal(SeqStmt(
+      {BufferStore(scores_buffer, exp2(score * s - load(row_shift)),
+                   rows.local_indices),
+       BufferStore(row_sum, load(row_sum) + score, zero)})));
+  if (rows.reducing_threads > 1) {
+    ICHECK(TargetIsCuda(T.target))
+        << "T.online_softmax across threads is implemented for CUDA only, "
+           "but the target is "
+        << T.target->str();
+    const int64_t *p_threads = as_const_int(T.thread_bounds->extent);
+    ICHECK(p_threads) << "T.online_softmax requires a constant block size";
+    bool use_named_barrier = TargetIsHopper(T.target) ||
+                             TargetIsSm100(T.target) ||
+                             TargetIsSM120(T.target);
+    std::stringstream ss;
+    ss << "tl::OnlineSoftmaxReduce<" << rows.reducing_threads << ", "
+       << rows.split_scale << ", " << T.thread_bounds->min << ", "
+       << *p_threads << ">::" << (use_named_barrier ? "run_hopper" : "run");
+    Array<PrimExpr> call_args = {StringImm(ss.str()), row_max.access_ptr(3),
+                                 row_sum.access_ptr(3), s};
+    if (rows.reducing_threads > 32) {
+      call_args.push_back(T.AddWorkspace(2 * (*p_threads), dtype));
+    }
+    stmts.push_back(
+        Evaluate(Call(DataType::Handle(), builtin::call_extern(), call_args)));
+  }
+  // Merge the row with the running statistics.
+  PrimExpr prev_max = BufferLoad(max_buffer, max_index);
+  PrimExpr new_max = max(prev_max, load(row_max));
+  stmts.push_back(BufferStore(
+      row_shift, Select(new_max == neg_inf, make_zero(dtype), new_max * s),
+      zero));
+  stmts.push_back(BufferStore(alpha, exp2(prev_max * s - load(row_shift)),
+                              alpha_index));
+  stmts.push_back(BufferStore(
+      sum_buffer,
+      BufferLoad(sum_buffer, sum_index) * BufferLoad(alpha, alpha_index) +
+          load(row_sum) * exp2(load(row_max) * s - load(row_shift)),
+      sum_index));
+  stmts.push_back(BufferStore(max_buffer, new_max, max_index));
+  // Correct the weights from the maximum of the part to the one of the row;
+  // the parts without a finite score hold zeros and stay so.
+  stmts.push_back(BufferStore(
+      row_base, exp2(load(row_base) - load(row_shift)), zero));
+  stmts.push_back(rows.ForEachLocal(BufferStore(
+      scores_buffer, score * load(row_base), rows.local_indices)));
+
+  Stmt body = For(rows.row_iv->var, 0, rows.row_iv->dom->extent,
+                  ForKind::kParallel, SeqStmt(stmts));
+  Array<Stmt> seq = {
+      PartitionLoop(Downcast<For>(body), T.thread_var, analyzer, row_layout)};
+
+  // Rescale the accumulators, whose rows must be held by the same threads.
+  for (size_t k = 0; k < accs.size(); ++k) {
+    const Buffer &acc = accs[k];
+    Buffer acc_buffer = get_buffer(acc);
+    Fragment acc_layout = T.layout_map[acc].as<Fragment>().value();
+    Var i("i"), j("j");
+    arith::Analyzer inner_analyzer;
+    inner_analyzer.Bind(i, Range(0, acc_layout->InputShape()[0]));
+    inner_analyzer.Bind(j, Range(0, acc_layout->InputShape()[1]));
+    ICHECK(ProveFragmentContains(acc_layout, row_layout, {i, j}, {i},
+                                 inner_analyzer))
+        << "T.online_softmax rescales " << acc->name
+        << " by the rows of " << scores->name
+        << ", but the threads holding them differ:\n"
+        << acc->name << " = " << acc_layout->DebugOutput() << "\n"
+        << scores->name << " = " << scores_layout->DebugOutput()
+        << "\nUse the same warp policy for both GEMMs.";
+    Array<PrimExpr> acc_index = acc_layout->Forward({i, j});
+    Stmt rescale = BufferStore(
+        acc_buffer,
+        BufferLoad(acc_buffer, acc_index) *
+            cast(acc->dtype, BufferLoad(alpha, row_layout->Forward({i}))),
+        acc_index);
+    rescale = For(i, 0, acc_layout->InputShape()[0], ForKind::kParallel,
+                  For(j, 0, acc_layout->InputShape()[1], ForKind::kParallel,
+                      rescale));
+    seq.push_back(PartitionLoop(Downcast<For>(rescale), T.thread_var,
+                                analyzer, acc_layout));
+  }
+
+  Stmt result = seq.size() > 1 ? SeqStmt(seq) : seq[0];
+  for (const Buffer &buf : {row_max, row_sum, row_base, row_shift, alpha}) {
+    result = Allocate(buf->data, buf->dtype, buf->shape, const_true(), result);
+  }
+  return result;
+}
+
+/**
+ * @brief Infer the layout of the statistics from the scores.
+ *
+ * The row maximum and sum take the layout of the scores reduced along their
+ * rows, as a reduction would give them, so that every thread holding a part
+ * of a row also holds its statistics. The scores are expected to have the
+ * layout of a GEMM C fragment by then; layouts given to the statistics by
+ * other operators must hold every row on the same threads.
+ */
+LayoutMap OnlineSoftmaxOpNode::InferLayout(const LayoutInferArgs &T,
+                                           InferLevel level) const {
+  if (level >= InferLevel::kStrict || !T.layout_map.count(scores))
+    return {};
+  Fragment scores_layout = T.layout_map[scores].as<Fragment>().value();
+  Fragment row_layout = ReducedRowLayout(scores_layout, T.thread_bounds);
+  LayoutMap result_map;
+  for (const Buffer &buf : {scores_max, scores_sum}) {
+    if (!T.layout_map.count(buf)) {
+      result_map.Set(buf, row_layout);
+      continue;
+    }
+    Fragment layout = T.layout_map[buf].as<Fragment>().value();
+    Var i = InputPlaceholder(0);
+    arith::Analyzer analyzer;
+    analyzer.Bind(i, Range(0, scores->shape[0]));
+    if (!ProveFragmentContains(layout, row_layout, {i}, {i}, analyzer) ||
+        !ProveFragmentContains(row_layout, layout, {i}, {i}, analyzer)) {
+      std::ostringstream oss;
+      oss << "Layout may conflict with T.online_softmax for buffer " << buf
+          << " vs. " << scores << "\nLHS = " << layout->DebugOutput()
+          << "\nRHS = " << row_layout->DebugOutput()
+          << "\nThe statistics must be held by the threads of their rows";
+      throw LayoutConflictException(oss.str());
+    }
+  }
+  return result_map;
+}
+
+TIR_REGISTER_TL_TILE_OP(OnlineSoftmaxOp, online_softmax)
+    .set_num_inputs(-1)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+NormOp::NormOp(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
+  /// Norm constructor arguments:
+  /// - x: (M, N) fragment, the residual is added to it in place
+  /// - out: (M, N) region receiving the normalized rows
+  /// - norm_type: NormTypeEnum
+  /// - eps: added to the variance before rsqrt
+  /// - out_scale: factor applied before casting to the dtype of out
+  /// - has_weight, has_bias, has_residual: whether the regions follow
+  /// - weight: (N,), bias: (N,), residual: (M, N), those present in order
+  CHECK_GE(args.size(), 8);
+  ObjectPtr<NormOpNode> node = tvm::ffi::make_object<NormOpNode>();
+  node->xRegion_ = NormalizeToBufferRegion(args[0]);
+  node->outRegion_ = NormalizeToBufferRegion(args[1]);
+  node->x = node->xRegion_->buffer;
+  node->out = node->outRegion_->buffer;
+  node->norm_type = static_cast<int>(args[2].as<IntImmNode>()->value);
+  node->eps = args[3];
+  node->out_scale = args[4];
+  size_t next = 8;
+  auto optional_region = [&](int flag, BufferRegion *region, Buffer *buffer) {
+    if (!is_one(args[flag]))
+      return;
+    ICHECK_LT(next, args.size()) << "T.norm is missing an operand";
+    *region = NormalizeToBufferRegion(args[next++]);
+    *buffer = (*region)->buffer;
+  };
+  optional_region(5, &node->weightRegion_, &node->weight);
+  optional_region(6, &node->biasRegion_, &node->bias);
+  optional_region(7, &node->residualRegion_, &node->residual);
+  ICHECK_EQ(next, args.size()) << "T.norm got unexpected operands";
+
+  const Buffer &x = node->x;
+  ICHECK(IsFragmentBuffer(x) && x->shape.size() == 2 && x->dtype.is_float())
+      << "T.norm expects a floating point (M, N) fragment, got " << x->name
+      << " of shape " << x->shape << " and dtype " << x->dtype << " in "
+      << x.scope();
+  ICHECK(RegionHasShape(node->xRegion_, x->shape))
+      << "T.norm normalizes whole fragments, got a region of " << x->name;
+  ICHECK(node->isRMSNorm() || node->isLayerNorm())
+      << "Unknown norm type " << node->norm_type;
+  ICHECK(RegionHasShape(node->outRegion_, x->shape))
+      << "T.norm expects an output of shape " << x->shape << ", got "
+      << node->outRegion_;
+  if (IsFragmentBuffer(node->out)) {
+    ICHECK_EQ(node->out->shape.size(), 2)
+        << "T.norm expects a 2D fragment output, got " << node->out->shape;
+  }
+  Array<PrimExpr> row_shape = {x->shape[1]};
+  for (const BufferRegion &region : {node->weightRegion_, node->biasRegion_,
+                                     node->residualRegion_}) {
+    if (!region.defined())
+      continue;
+    const Buffer &buffer = region->buffer;
+    ICHECK(!IsFragmentBuffer(buffer) && !IsLocalBuffer(buffer))
+        << "T.norm reads " << buffer->name
+        << " from shared or global memory, but it is in " << buffer.scope();
+    const Array<PrimExpr> &shape =
+        region.same_as(node->residualRegion_) ? x->shape : row_shape;
+    ICHECK(RegionHasShape(region, shape))
+        << "T.norm expects " << buffer->name << " of shape " << shape
+        << ", got " << region;
+  }
+  data_ = std::move(node);
+}
+
+TileOperator NormOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<NormOpNode>(*this);
+  return NormOp(op);
+}
+
+For NormOpNode::MakeElementwiseLoop(
+    const std::function<Stmt(const Var &, const Var &)> &body) const {
+  Var i("i"), j("j");
+  return For(i, 0, x->shape[0], ForKind::kParallel,
+             For(j, 0, x->shape[1], ForKind::kParallel, body(i, j)));
+}
+
+Stmt NormOpNode::MakeResidualStore(const Var &i, const Var &j) const {
+  Array<PrimExpr> index = RegionIndices(residualRegion_, {i, j});
+  PrimExpr value =
+      BufferLoad(x, {i, j}) + cast(x->dtype, BufferLoad(residual, index));
+  return BufferStore(x, value, {i, j});
+}
+
+Stmt NormOpNode::MakeOutputStore(const Var &i, const Var &j,
+                                 const PrimExpr &mean,
+                                 const PrimExpr &rstd) const {
+  DataType f32 = DataType::Float(32);
+  PrimExpr value = cast(f32, BufferLoad(x, {i, j}));
+  if (isLayerNorm()) {
+    value = value - mean;
+  }
+  value = value * rstd;
+  if (weight.defined()) {
+    value = value * cast(f32, BufferLoad(weight,
+                                         RegionIndices(weightRegion_, {j})));
+  }
+  if (bias.defined()) {
+    value = value +
+            cast(f32, BufferLoad(bias, RegionIndices(biasRegion_, {j})));
+  }
+  if (!is_one(out_scale)) {
+    value = value * cast(f32, out_scale);
+  }
+  DataType out_dtype = out->dtype;
+  if (out_dtype.is_float8()) {
+    // Saturate instead of overflowing to NaN/inf on quantization.
+    PrimExpr bound = cast(f32, max_value(out_dtype));
+    value = min(max(value, -bound), bound);
+  }
+  return BufferStore(out, cast(out_dtype, value),
+                     RegionIndices(outRegion_, {i, j}));
+}
+
+/**
+ * @brief Lower the normalization of the rows of a fragment.
+ *
+ * The residual is added to x by a parallel loop, then a loop over the rows
+ * partitioned as in a reduction gathers the statistics of every row in one
+ * pass over the elements each thread holds: the sum of squares for RMSNorm,
+ * the Welford mean and sum of squared deviations for LayerNorm. The partial
+ * statistics are merged across the threads of the row by `tl::AllReduce` or
+ * `tl::WelfordReduce`, a single exchange of both moments. A last parallel
+ * loop writes the normalized, scaled and cast rows. Both parallel loops take
+ * the layout of x and are vectorized over the global or shared operands.
+ */
+Stmt NormOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
+  Buffer x_buffer = T.buffer_remap.count(x) ? T.buffer_remap[x] : x;
+  Fragment x_layout = T.layout_map[x].as<Fragment>().value();
+  Fragment row_layout = ReducedRowLayout(x_layout, T.thread_bounds);
+  if (IsFragmentBuffer(out)) {
+    Fragment out_layout = T.layout_map[out].as<Fragment>().value();
+    Var i("i"), j("j");
+    arith::Analyzer inner_analyzer;
+    inner_analyzer.Bind(i, Range(0, x->shape[0]));
+    inner_analyzer.Bind(j, Range(0, x->shape[1]));
+    ICHECK(ProveFragmentContains(x_layout, out_layout, {i, j}, {i, j},
+                                 inner_analyzer))
+        << "T.norm writes " << out->name << " from the threads holding "
+        << x->name << ", but the layouts differ:\n"
+        << out->name << " = " << out_layout->DebugOutput() << "\n"
+        << x->name << " = " << x_layout->DebugOutput();
+  }
+
+  RowReduction rows(x_layout, analyzer);
+  ICHECK(rows.single_split)
+      << "T.norm expects the columns of " << x->name
+      << " to be spread over a single thread split, got "
+      << x_layout->DebugOutput();
+  PrimExpr num_local = 1;
+  for (const IterVar &iv : rows.local_vars) {
+    num_local = num_local * iv->dom->extent;
+  }
+
+  DataType f32 = DataType::Float(32);
+  Array<PrimExpr> zero = {0};
+  auto scratch = [&](const std::string &name) {
+    return decl_buffer({1}, f32, x->name + "_" + name, "local");
+  };
+  Buffer row_mean = scratch("row_mean"), row_m2 = scratch("row_m2");
+  Buffer delta = scratch("delta");
+  Buffer mean = decl_buffer(row_layout->OutputShape(), f32, x->name + "_mean",
+                            "local");
+  Buffer rstd = decl_buffer(row_layout->OutputShape(), f32, x->name + "_rstd",
+                            "local");
+  auto load = [&](const Buffer &buf) { return BufferLoad(buf, zero); };
+  PrimExpr value = cast(f32, BufferLoad(x_buffer, rows.local_indices));
+  Array<PrimExpr> row_index = row_layout->Forward({rows.row_iv->var});
+
+  Array<Stmt> stmts;
+  stmts.push_back(BufferStore(row_m2, make_zero(f32), zero));
+  if (isLayerNorm()) {
+    stmts.push_back(BufferStore(row_mean, make_zero(f32), zero));
+    PrimExpr count = cast(f32, rows.LocalOffset() + 1);
+    stmts.push_back(rows.ForEachLocal(SeqStmt(
+        {BufferStore(delta, value - load(row_mean), zero),
+         BufferStore(row_mean, load(row_mean) + load(delta) / count, zero),
+         BufferStore(row_m2,
+                     load(row_m2) + load(delta) * (value - load(row_mean)),
+                     zero)})));
+  } else {
+    stmts.push_back(rows.ForEachLocal(
+        BufferStore(row_m2, load(row_m2) + value * value, zero)));
+  }
+  if (rows.reducing_threads > 1) {
+    const int64_t *p_threads = as_const_int(T.thread_bounds->extent);
+    ICHECK(p_threads) << "T.norm requires a constant block size";
+    bool use_named_barrier = TargetIsHopper(T.target) ||
+                             TargetIsSm100(T.target) ||
+                             TargetIsSM120(T.target);
+    std::stringstream ss;
+    if (isLayerNorm()) {
+      ICHECK(TargetIsCuda(T.target))
+          << "T.norm of LayerNorm across threads is implemented for CUDA "
+             "only, but the target is "
+          << T.target->str();
+      ss << "tl::WelfordReduce<" << rows.reducing_threads << ", "
+         << rows.split_scale << ", " << T.thread_bounds->min << ", "
+         << *p_threads << ">::" << (use_named_barrier ? "run_hopper" : "run");
+      Array<PrimExpr> call_args = {StringImm(ss.str()), row_mean.access_ptr(3),
+                                   row_m2.access_ptr(3),
+                                   cast(f32, num_local)};
+      if (rows.reducing_threads > 32) {
+        call_args.push_back(T.AddWorkspace(3 * (*p_threads), f32));
+      }
+      stmts.push_back(Evaluate(
+          Call(DataType::Handle(), builtin::call_extern(), call_args)));
+    } else {
+      ss << "tl::AllReduce<tl::SumOp, " << rows.reducing_threads << ", "
+         << rows.split_scale << ", " << T.thread_bounds->min;
+      if (use_named_barrier) {
+        ss << ", " << *p_threads;
+      }
+      ss << ">::" << (use_named_barrier ? "run_hopper" : "run");
+      Array<PrimExpr> call_args = {StringImm(ss.str()), load(row_m2)};
+      if (rows.reducing_threads > 32) {
+        call_args.push_back(T.AddWorkspace(*p_threads, f32));
+      }
+      stmts.push_back(BufferStore(
+          row_m2, Call(f32, builtin::call_extern(), call_args), zero));
+    }
+  }
+  PrimExpr n = cast(f32, x->shape[1]);
+  if (isLayerNorm()) {
+    stmts.push_back(BufferStore(mean, load(row_mean), row_index));
+  }
+  stmts.push_back(BufferStore(
+      rstd, rsqrt(load(row_m2) / n + cast(f32, eps)), row_index));
+  Stmt stats = For(rows.row_iv->var, 0, rows.row_iv->dom->extent,
+                   ForKind::kParallel, SeqStmt(stmts));
+
+  Array<Stmt> seq;
+  if (residual.defined()) {
+    For add = MakeElementwiseLoop(
+        [&](const Var &i, const Var &j) { return MakeResidualStore(i, j); });
+    seq.push_back(LowerParallelLoop(add, x_layout, T.thread_var, analyzer,
+                                    T.layout_map));
+  }
+  seq.push_back(
+      PartitionLoop(Downcast<For>(stats), T.thread_var, analyzer, row_layout));
+  For normalize = MakeElementwiseLoop([&](const Var &i, const Var &j) {
+    Array<PrimExpr> index = row_layout->Forward({i});
+    return MakeOutputStore(i, j, BufferLoad(mean, index),
+                           BufferLoad(rstd, index));
+  });
+  seq.push_back(LowerParallelLoop(normalize, x_layout, T.thread_var, analyzer,
+                                  T.layout_map));
+
+  Stmt result = SeqStmt(seq);
+  for (const Buffer &buf : {row_mean, row_m2, delta, mean, rstd}) {
+    result = Allocate(buf->data, buf->dtype, buf->shape, const_true(), result);
+  }
+  return result;
+}
+
+/**
+ * @brief Infer the layout of x from the accesses of the normalization.
+ *
+ * Unless another operator fixed it, x is laid out as the output loop would
+ * be partitioned, with every thread holding runs of as many consecutive
+ * columns as the global and shared operands can be vectorized over
+ * (GetVectorizeSize). This runs before the free inference of the copies
+ * that fill x, so that they adopt the vectorized layout too. A fragment
+ * output takes the layout of x.
+ */
+LayoutMap NormOpNode::InferLayout(const LayoutInferArgs &T,
+                                  InferLevel level) const {
+  if (level == InferLevel::kStrict)
+    return {};
+  LayoutMap result_map;
+  Fragment x_layout;
+  if (T.layout_map.count(x)) {
+    x_layout = T.layout_map[x].as<Fragment>().value();
+  } else {
+    For loop = MakeElementwiseLoop([&](const Var &i, const Var &j) {
+      Stmt store = MakeOutputStore(i, j, make_zero(DataType::Float(32)),
+                                   make_const(DataType::Float(32), 1));
+      return residual.defined() ? SeqStmt({MakeResidualStore(i, j), store})
+                                : store;
+    });
+    int vector_size = GetVectorizeSize(loop, T.analyzer, T.layout_map);
+    PrimExpr num_elems = x->shape[0] * x->shape[1];
+    while (vector_size > 1 &&
+           !T.analyzer->CanProve(
+               floormod(num_elems, T.thread_bounds->extent * vector_size) ==
+               0)) {
+      vector_size /= 2;
+    }
+    x_layout = PlanLoopPartition(loop, vector_size, T.thread_bounds);
+    result_map.Set(x, x_layout);
+  }
+  if (IsFragmentBuffer(out) && !out.same_as(x) && !T.layout_map.count(out)) {
+    result_map.Set(out, x_layout);
+  }
+  return result_map;
+}
+
+TIR_REGISTER_TL_TILE_OP(NormOp, norm)
+    .set_num_inputs(-1)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+QuantizeOp::QuantizeOp(Array<PrimExpr> args,
+                       Map<String, ObjectRef> annotations) {
+  /// Quantize constructor arguments:
+  /// - src: (M, N) floating point fragment
+  /// - dst: (M, N) region receiving the quantized elements
+  /// - scale: region receiving amax / max(dst dtype) of every group
+  /// - granularity: QuantGranularityEnum
+  /// - group_size: elements per scale of kBlock
+  /// - stochastic: whether to round stochastically
+  CHECK_EQ(args.size(), 6);
+  ObjectPtr<QuantizeOpNode> node = tvm::ffi::make_object<QuantizeOpNode>();
+  node->srcRegion_ = NormalizeToBufferRegion(args[0]);
+  node->dstRegion_ = NormalizeToBufferRegion(args[1]);
+  node->scaleRegion_ = NormalizeToBufferRegion(args[2]);
+  node->src = node->srcRegion_->buffer;
+  node->dst = node->dstRegion_->buffer;
+  node->scale = node->scaleRegion_->buffer;
+  node->granularity = static_cast<int>(args[3].as<IntImmNode>()->value);
+  node->group_size = static_cast<int>(args[4].as<IntImmNode>()->value);
+  node->stochastic = is_one(args[5]);
+
+  const Buffer &src = node->src;
+  ICHECK(IsFragmentBuffer(src) && src->shape.size() == 2 &&
+         src->dtype.is_float())
+      << "T.quantize expects a floating point (M, N) fragment, got "
+      << src->name << " of shape " << src->shape << " and dtype "
+      << src->dtype << " in " << src.scope();
+  ICHECK(RegionHasShape(node->srcRegion_, src->shape))
+      << "T.quantize quantizes whole fragments, got a region of "
+      << src->name;
+  ICHECK(RegionHasShape(node->dstRegion_, src->shape))
+      << "T.quantize expects an output of shape " << src->shape << ", got "
+      << node->dstRegion_;
+  DataType dst_dtype = node->dst->dtype;
+  ICHECK(dst_dtype.is_float8() || (dst_dtype.is_int() && dst_dtype.bits() == 8))
+      << "T.quantize casts to float8 or int8, got " << dst_dtype;
+  if (IsFragmentBuffer(node->dst)) {
+    ICHECK_EQ(node->dst->shape.size(), 2)
+        << "T.quantize expects a 2D fragment output, got " << node->dst->shape;
+  }
+
+  Array<PrimExpr> scale_shape;
+  arith::Analyzer analyzer;
+  switch (static_cast<QuantGranularityEnum>(node->granularity)) {
+  case QuantGranularityEnum::kToken:
+    scale_shape = {src->shape[0]};
+    break;
+  case QuantGranularityEnum::kBlock:
+    ICHECK(node->group_size > 0 &&
+           analyzer.CanProve(floormod(src->shape[1], node->group_size) == 0))
+        << "T.quantize of groups of " << node->group_size
+        << " elements needs rows of a multiple of them, got " << src->shape;
+    scale_shape = {src->shape[0], floordiv(src->shape[1], node->group_size)};
+    break;
+  case QuantGranularityEnum::kTensor:
+    scale_shape = {1};
+    break;
+  default:
+    LOG(FATAL) << "Unknown quantization granularity " << node->granularity;
+  }
+  ICHECK(RegionHasShape(node->scaleRegion_, scale_shape))
+      << "T.quantize expects scales of shape " << scale_shape << ", got "
+      << node->scaleRegion_;
+  ICHECK(node->scale->dtype.is_float())
+      << "T.quantize expects floating point scales, got "
+      << node->scale->dtype;
+  ICHECK(!IsFragmentBuffer(node->scale) ||
+         node->granularity == int(QuantGranularityEnum::kToken))
+      << "T.quantize keeps scales in a fragment for per-token "
+         "quantization only, use shared or global memory for "
+      << node->scale->name;
+  ICHECK(!IsLocalBuffer(node->scale))
+      << "T.quantize writes the scales to a fragment, shared or global "
+         "buffer, got a local buffer "
+      << node->scale->name;
+  data_ = std::move(node);
+}
+
+TileOperator QuantizeOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<QuantizeOpNode>(*this);
+  return QuantizeOp(op);
+}
+
+PrimExpr QuantizeOpNode::GroupExtent() const {
+  switch (static_cast<QuantGranularityEnum>(granularity)) {
+  case QuantGranularityEnum::kToken:
+    return src->shape[1];
+  case QuantGranularityEnum::kBlock:
+    return group_size;
+  default:
+    return src->shape[0] * src->shape[1];
+  }
+}
+
+For QuantizeOpNode::MakeElementwiseLoop(
+    const std::function<Stmt(const Var &, const Var &)> &body) const {
+  Var i("i"), j("j");
+  return For(i, 0, src->shape[0], ForKind::kParallel,
+             For(j, 0, src->shape[1], ForKind::kParallel, body(i, j)));
+}
+
+Stmt QuantizeOpNode::MakeOutputStore(const Var &i, const Var &j,
+                                     const PrimExpr &inv_scale) const {
+  DataType f32 = DataType::Float(32);
+  DataType dst_dtype = dst->dtype;
+  PrimExpr bound = cast(f32, max_value(dst_dtype));
+  PrimExpr value = cast(f32, BufferLoad(src, {i, j})) * inv_scale;
+  value = min(max(value, -bound), bound);
+  if (dst_dtype.is_float8()) {
+    if (stochastic) {
+      // Add random bits below the mantissa of the float8 type and drop
+      // them, so that the saturating round to nearest of the cast is exact
+      // and the magnitude rounds up with the probability of the remainder.
+      int mantissa = dst_dtype.is_float8_e5m2() ? 2 : 3;
+      int dropped = 23 - mantissa;
+      DataType u32 = DataType::UInt(32);
+      PrimExpr noise =
+          Call(u32, rng_rand(), {}) >> make_const(u32, 32 - dropped);
+      PrimExpr bits = (reinterpret(u32, value) + noise) &
+                      make_const(u32, ~((uint32_t(1) << dropped) - 1));
+      value = reinterpret(f32, bits);
+    }
+  } else {
+    if (stochastic) {
+      PrimExpr uniform = cast(f32, Call(DataType::UInt(32), rng_rand(), {})) *
+                         make_const(f32, 1.0 / 4294967296.0);
+      value = min(floor(value + uniform), bound);
+    } else {
+      value = round(value);
+    }
+  }
+  return BufferStore(dst, cast(dst_dtype, value),
+                     RegionIndices(dstRegion_, {i, j}));
+}
+
+/**
+ * @brief Lower the fused quantization of a fragment.
+ *
+ * The fragment is viewed as rows of the elements sharing a scale (a row of
+ * src, a group of group_size columns of it, or the whole fragment), so that
+ * a loop over those rows partitioned as in a reduction gathers the absolute
+ * maximum of every group from the elements each thread holds. The partial
+ * maxima are merged across the threads of a group by `tl::AllReduce` with
+ * `tl::MaxOp`, as the AbsMax reduction does; the whole fragment reduces over
+ * every thread of the block. A parallel loop in the layout of src then scales,
+ * saturates and casts the elements; float32 to float8 casts of consecutive
+ * elements are vectorized to packed `cvt.rn.satfinite` conversions.
+ */
+Stmt QuantizeOpNode::Lower(const LowerArgs &T,
+                           arith::Analyzer *analyzer) const {
+  Buffer src_buffer = T.buffer_remap.count(src) ? T.buffer_remap[src] : src;
+  Fragment src_layout = T.layout_map[src].as<Fragment>().value();
+  if (IsFragmentBuffer(dst)) {
+    Fragment dst_layout = T.layout_map[dst].as<Fragment>().value();
+    Var i("i"), j("j");
+    arith::Analyzer inner_analyzer;
+    inner_analyzer.Bind(i, Range(0, src->shape[0]));
+    inner_analyzer.Bind(j, Range(0, src->shape[1]));
+    ICHECK(ProveFragmentContains(src_layout, dst_layout, {i, j}, {i, j},
+                                 inner_analyzer))
+        << "T.quantize writes " << dst->name << " from the threads holding "
+        << src->name << ", but the layouts differ:\n"
+        << dst->name << " = " << dst_layout->DebugOutput() << "\n"
+        << src->name << " = " << src_layout->DebugOutput();
+  }
+  const int64_t *p_threads = as_const_int(T.thread_bounds->extent);
+  ICHECK(p_threads) << "T.quantize requires a constant block size";
+  bool use_named_barrier = TargetIsHopper(T.target) ||
+                           TargetIsSm100(T.target) || TargetIsSM120(T.target);
+  DataType f32 = DataType::Float(32);
+  auto all_reduce_max = [&](const PrimExpr &value, int threads, int scale) {
+    std::stringstream ss;
+    ss << "tl::AllReduce<tl::MaxOp, " << threads << ", " << scale << ", "
+       << T.thread_bounds->min;
+    if (use_named_barrier) {
+      ss << ", " << *p_threads;
+    }
+    ss << ">::" << (use_named_barrier ? "run_hopper" : "run");
+    Array<PrimExpr> call_args = {StringImm(ss.str()), value};
+    if (threads > 32) {
+      call_args.push_back(T.AddWorkspace(*p_threads, f32));
+    }
+    return Call(f32, builtin::call_extern(), call_args);
+  };
+
+  Array<PrimExpr> zero = {0};
+  Buffer amax = decl_buffer({1}, f32, src->name + "_amax", "local");
+  auto load_amax = [&]() { return BufferLoad(amax, zero); };
+  auto abs_value = [&](const Array<PrimExpr> &indices) {
+    return abs(cast(f32, BufferLoad(src_buffer, indices)));
+  };
+  PrimExpr bound = cast(f32, max_value(dst->dtype));
+  // Groups without a non-zero element keep a finite scale
+  PrimExpr floor_amax = make_const(f32, 1e-4);
+
+  Array<Stmt> seq;
+  Buffer inv_scale;
+  std::function<PrimExpr(const Var &, const Var &)> load_inv_scale;
+  if (granularity == int(QuantGranularityEnum::kTensor)) {
+    inv_scale = decl_buffer({1}, f32, src->name + "_inv_scale", "local");
+    Array<PrimExpr> local_shape = src_layout->OutputShape();
+    Array<Var> vars;
+    for (size_t d = 0; d < local_shape.size(); ++d) {
+      vars.push_back(Var("l" + std::to_string(d)));
+    }
+    Array<PrimExpr> local_index(vars.begin(), vars.end());
+    Stmt body =
+        BufferStore(amax, max(load_amax(), abs_value(local_index)), zero);
+    for (int d = static_cast<int>(vars.size()) - 1; d >= 0; --d) {
+      body = For(vars[d], 0, local_shape[d], ForKind::kUnrolled, body);
+    }
+    seq.push_back(BufferStore(amax, make_zero(f32), zero));
+    seq.push_back(body);
+    seq.push_back(BufferStore(
+        amax, max(all_reduce_max(load_amax(), *p_threads, 1), floor_amax),
+        zero));
+    seq.push_back(BufferStore(inv_scale, bound / load_amax(), zero));
+    seq.push_back(BufferStore(scale, load_amax() / bound,
+                              RegionIndices(scaleRegion_, {0})));
+    load_inv_scale = [&](const Var &, const Var &) {
+      return BufferLoad(inv_scale, zero);
+    };
+  } else {
+    PrimExpr group = GroupExtent();
+    Fragment grouped = src_layout;
+    if (granularity == int(QuantGranularityEnum::kBlock)) {
+      PrimExpr num_groups = floordiv(src->shape[0] * src->shape[1], group);
+      grouped = Downcast<Fragment>(
+          src_layout->Reshape({analyzer->Simplify(num_groups), group},
+                              analyzer));
+    }
+    Fragment row_layout = ReducedRowLayout(grouped, T.thread_bounds);
+    RowReduction rows(grouped, analyzer);
+    ICHECK(rows.single_split)
+        << "T.quantize expects the elements of a group of " << src->name
+        << " to be spread over a single thread split, got "
+        << src_layout->DebugOutput();
+    inv_scale = decl_buffer(row_layout->OutputShape(), f32,
+                            src->name + "_inv_scale", "local");
+    PrimExpr r = rows.row_iv->var;
+    Array<PrimExpr> scale_index = {r};
+    if (granularity == int(QuantGranularityEnum::kBlock)) {
+      PrimExpr groups_per_row = floordiv(src->shape[1], group);
+      scale_index = {floordiv(r, groups_per_row), floormod(r, groups_per_row)};
+    }
+
+    Array<Stmt> stmts;
+    stmts.push_back(BufferStore(amax, make_zero(f32), zero));
+    stmts.push_back(rows.ForEachLocal(BufferStore(
+        amax, max(load_amax(), abs_value(rows.local_indices)), zero)));
+    PrimExpr reduced = load_amax();
+    if (rows.reducing_threads > 1) {
+      reduced = all_reduce_max(reduced, rows.reducing_threads,
+                               rows.split_scale);
+    }
+    stmts.push_back(BufferStore(amax, max(reduced, floor_amax), zero));
+    stmts.push_back(BufferStore(inv_scale, bound / load_amax(),
+                                row_layout->Forward({r})));
+    stmts.push_back(BufferStore(scale, load_amax() / bound,
+                                RegionIndices(scaleRegion_, scale_index)));
+    Stmt stats = For(rows.row_iv->var, 0, rows.row_iv->dom->extent,
+                     ForKind::kParallel, SeqStmt(stmts));
+    seq.push_back(PartitionLoop(Downcast<For>(stats), T.thread_var, analyzer,
+                                row_layout));
+    load_inv_scale = [this, row_layout, inv_scale, group](const Var &i,
+                                                          const Var &j) {
+      PrimExpr row = i;
+      if (granularity == int(QuantGranularityEnum::kBlock)) {
+        row = i * floordiv(src->shape[1], group) + floordiv(j, group);
+      }
+      return BufferLoad(inv_scale, row_layout->Forward({row}));
+    };
+  }
+
+  For quantize = MakeElementwiseLoop([&](const Var &i, const Var &j) {
+    return MakeOutputStore(i, j, load_inv_scale(i, j));
+  });
+  seq.push_back(LowerParallelLoop(quantize, src_layout, T.thread_var, analyzer,
+                                  T.layout_map));
+
+  Stmt result = SeqStmt(seq);
+  for (const Buffer &buf : {amax, inv_scale}) {
+    result = Allocate(buf->data, buf->dtype, buf->shape, const_true(), result);
+  }
+  return result;
+}
+
+/**
+ * @brief Infer the layouts of the quantization.
+ *
+ * Unless another operator fixed it, src is laid out as the output loop would
+ * be partitioned, vectorized over the global or shared destination as for
+ * NormOp. A fragment destination takes the layout of src and fragment
+ * per-token scales the layout of its reduced rows.
+ */
+LayoutMap QuantizeOpNode::InferLayout(const LayoutInferArgs &T,
+                                      InferLevel level) const {
+  if (level == InferLevel::kStrict)
+    return {};
+  LayoutMap result_map;
+  Fragment src_layout;
+  if (T.layout_map.count(src)) {
+    src_layout = T.layout_map[src].as<Fragment>().value();
+  } else {
+    For loop = MakeElementwiseLoop([&](const Var &i, const Var &j) {
+      return MakeOutputStore(i, j, make_const(DataType::Float(32), 1));
+    });
+    int vector_size = GetVectorizeSize(loop, T.analyzer, T.layout_map);
+    PrimExpr num_elems = src->shape[0] * src->shape[1];
+    while (vector_size > 1 &&
+           !T.analyzer->CanProve(
+               floormod(num_elems, T.thread_bounds->extent * vector_size) ==
+               0)) {
+      vector_size /= 2;
+    }
+    src_layout = PlanLoopPartition(loop, vector_size, T.thread_bounds);
+    result_map.Set(src, src_layout);
+  }
+  if (IsFragmentBuffer(dst) && !T.layout_map.count(dst)) {
+    result_map.Set(dst, src_layout);
+  }
+  if (IsFragmentBuffer(scale) && !T.layout_map.count(scale)) {
+    result_map.Set(scale, ReducedRowLayout(src_layout, T.thread_bounds));
+  }
+  return result_map;
+}
+
+TIR_REGISTER_TL_TILE_OP(QuantizeOp, quantize)
+    .set_num_inputs(6)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+/**
+ * @brief Lower a cluster-wide element-wise all-reduce of a local buffer.
+ *
+ * Emits a call to `tl::ClusterAllReduce<reducer, N, threads, offset, chunk>`
+ * where N is the number of elements held by one thread. The partials are
+ * exchanged through a shared memory workspace that the peer CTAs read with
+ * `ld.shared::cluster`; `chunk` bounds that workspace to 16 KiB so that large
+ * fragments are exchanged in several rounds instead of inflating the shared
+ * memory footprint of the kernel.
+ */
+Stmt MakeClusterAllReduce(const LowerArgs &T, const Buffer &buffer,
+                          const std::string &reducer) {
+  ICHECK(TargetIsCuda(T.target) && TargetHasSMVersionGE(T.target, 90))
+      << "Cluster reductions require distributed shared memory (sm_90 or "
+         "newer), but the target is "
+      << T.target->str();
+  int64_t num_elems = 1;
+  for (const PrimExpr &extent : buffer->shape) {
+    const int64_t *p_extent = as_const_int(extent);
+    ICHECK(p_extent) << "Cluster reduction of " << buffer->name
+                     << " requires a constant number of elements per thread, "
+                        "but got shape "
+                     << buffer->shape;
+    num_elems *= *p_extent;
+  }
+  const int64_t *p_threads = as_const_int(T.thread_bounds->extent);
+  ICHECK(p_threads) << "Cluster reduction requires a constant block size";
+  int64_t threads = *p_threads;
+
+  constexpr int64_t kMaxWorkspaceBytes = 16 * 1024;
+  int64_t bytes = std::max<int64_t>(buffer->dtype.bytes(), 1);
+  int64_t chunk = std::max<int64_t>(1, kMaxWorkspaceBytes / (threads * bytes));
+  chunk = std::min(chunk, num_elems);
+
+  std::stringstream ss;
+  ss << "tl::ClusterAllReduce<" << reducer << ", " << num_elems << ", "
+     << threads << ", " << T.thread_bounds->min << ", " << chunk << ">::run";
+  PrimExpr workspace = T.AddWorkspace(threads * chunk, buffer->dtype);
+  return Evaluate(Call(DataType::Handle(), builtin::call_extern(),
+                       {StringImm(ss.str()), buffer.access_ptr(3), workspace}));
+}
+
+ClusterAllReduceOp::ClusterAllReduceOp(Array<PrimExpr> args,
+                                       Map<String, ObjectRef> annotations) {
+  /// ClusterAllReduce constructor arguments:
+  /// - buffer: fragment or local buffer reduced in place
+  /// - reduce_type: one of sum, max, min, bitand, bitor, bitxor
+  CHECK_EQ(args.size(), 2);
+  ObjectPtr<ClusterAllReduceOpNode> node =
+      tvm::ffi::make_object<ClusterAllReduceOpNode>();
+  node->bufferRegion_ = NormalizeToBufferRegion(args[0]);
+  node->buffer = node->bufferRegion_->buffer;
+  node->type = ReduceType(args[1].as<StringImm>().value()->value);
+  ICHECK(!node->type->isAbsSum() && !node->type->isAbsMax())
+      << "cluster_allreduce combines partial results, reduce the absolute "
+         "values within the CTA first";
+  data_ = std::move(node);
+}
+
+TileOperator ClusterAllReduceOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<ClusterAllReduceOpNode>(*this);
+  return ClusterAllReduceOp(op);
+}
+
+Stmt ClusterAllReduceOpNode::Lower(const LowerArgs &T,
+                                   arith::Analyzer *analyzer) const {
+  ICHECK(IsFragmentBuffer(buffer) || buffer.scope() == "local")
+      << "cluster_allreduce expects a fragment or local buffer, but "
+      << buffer->name << " is in " << buffer.scope();
+  Buffer local_buffer =
+      T.buffer_remap.count(buffer) ? T.buffer_remap[buffer] : buffer;
+  std::string reducer;
+  if (type->isSum()) {
+    reducer = "tl::SumOp";
+  } else if (type->isMax()) {
+    reducer = "tl::MaxOp";
+  } else if (type->isMin()) {
+    reducer = "tl::MinOp";
+  } else if (type->isBitAnd()) {
+    reducer = "tl::BitAndOp";
+  } else if (type->isBitOr()) {
+    reducer = "tl::BitOrOp";
+  } else {
+    reducer = "tl::BitXorOp";
+  }
+  return MakeClusterAllReduce(T, local_buffer, reducer);
+}
+
+LayoutMap ClusterAllReduceOpNode::InferLayout(const LayoutInferArgs &T,
+                                              InferLevel level) const {
+  // The reduction is element-wise per thread and works with any layout.
+  return {};
+}
+
+TIR_REGISTER_TL_TILE_OP(ClusterAllReduceOp, cluster_allreduce)
+    .set_num_inputs(2)
     .set_attr<TCallEffectKind>("TCallEffectKind",
                                Integer(CallEffectKind::kOpaque));
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   ReduceOpNode::RegisterReflection();
   CumSumOpNode::RegisterReflection();
+  TopKOpNode::RegisterReflection();
+  OnlineSoftmaxOpNode::RegisterReflection();
+  NormOpNode::RegisterReflection();
+  QuantizeOpNode::RegisterReflection();
+  ClusterAllReduceOpNode::RegisterReflection();
   ReduceTypeNode::RegisterReflection();
 }
 
@@ -87,6 +87,10 @@ public:
   int dim;         ///< Dimension to reduce along
   ReduceType type; ///< Type of reduction operation
   bool clear;      ///< Whether to clear destination before reduction
+  /// Reductions of the same source along the same dimension fused into this
+  /// one by FuseSiblingReductions, lowered in the same loops and exchanged
+  /// across threads together with it
+  Array<TileOperator> siblings_;
 
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.ReduceOp", ReduceOpNode,
                                     TileOperatorNode);
@@ -100,7 +104,8 @@ public:
         .def_ro("dstRegion", &ReduceOpNode::dstRegion_)
         .def_ro("dim", &ReduceOpNode::dim)
         .def_ro("type", &ReduceOpNode::type)
-        .def_ro("clear", &ReduceOpNode::clear);
+        .def_ro("clear", &ReduceOpNode::clear)
+        .def_ro("siblings", &ReduceOpNode::siblings_);
   }
 
   /// Lower the operator to TIR statements
@@ -118,6 +123,8 @@ private:
   PrimExpr MakeReduce(const PrimExpr &acc, const PrimExpr &b) const;
   /// Generate codegen reducer string
   std::string MakeCodegenReducer() const;
+  /// This reduction without its fused siblings
+  TileOperator WithoutSiblings() const;
 };
 
 /// Wrapper class for reduction operations
@@ -139,6 +146,15 @@ public:
   BufferRegion srcRegion_, dstRegion_;
   int dim;      ///< Dimension along which to compute cumulative sum
   bool reverse; ///< Whether to compute in reverse order
+  /// Optional flags of the elements restarting the scan, shaped as src
+  tir::Buffer reset;
+  BufferRegion resetRegion_;
+  /// Optional (num_tiles, lanes) int64 status words of a device-wide scan,
+  /// zeroed before the launch; the tile continues the scan of tiles
+  /// 0..tile_id-1 through decoupled look-back
+  tir::Buffer state;
+  BufferRegion stateRegion_;
+  PrimExpr tile_id; ///< Position of the tile in a device-wide scan
   TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.CumSumOp", CumSumOpNode,
                                     TileOperatorNode);
 
@@ -150,7 +166,12 @@ public:
         .def_ro("srcRegion", &CumSumOpNode::srcRegion_)
         .def_ro("dstRegion", &CumSumOpNode::dstRegion_)
         .def_ro("dim", &CumSumOpNode::dim)
-        .def_ro("reverse", &CumSumOpNode::reverse);
+        .def_ro("reverse", &CumSumOpNode::reverse)
+        .def_ro("reset", &CumSumOpNode::reset)
+        .def_ro("resetRegion", &CumSumOpNode::resetRegion_)
+        .def_ro("state", &CumSumOpNode::state)
+        .def_ro("stateRegion", &CumSumOpNode::stateRegion_)
+        .def_ro("tile_id", &CumSumOpNode::tile_id);
   }
 
   Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
@@ -158,6 +179,12 @@ public:
                         InferLevel level) const override;
   static const Op &Get();
   TileOperator Clone() const;
+
+private:
+  /// Lowers scans with reset flags or a device-wide scan state
+  Stmt LowerSegmentedScan(const LowerArgs &T, const PrimExpr &src_ptr,
+                          const PrimExpr &dst_ptr,
+                          const Array<PrimExpr> &extents) const;
 };
 
 /// Wrapper class for cumulative sum operations
@@ -171,6 +198,283 @@ public:
   static const Op &Get();
 };
 
+/*!
+ * \brief Node class for top-k selection along the last dimension.
+ *
+ * Every row of the fragment `src` is reduced to its `k` largest (or smallest)
+ * values and their column indices, written to the rows of the shared or
+ * global buffers `out_vals` and `out_idx`. Small `k` merges thread-local
+ * sorted lists with a bitonic butterfly and yields sorted rows, large `k`
+ * runs a radix select over the whole row and leaves the rows unsorted.
+ */
+class TopKOpNode : public TileOperatorNode {
+public:
+  tir::Buffer src, out_vals, out_idx; ///< Source and output buffers
+  BufferRegion srcRegion_, valsRegion_, idxRegion_;
+  int k;        ///< Number of selected elements per row
+  bool largest; ///< Select the largest elements, otherwise the smallest
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.TopKOp", TopKOpNode, TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<TopKOpNode>()
+        .def_ro("src", &TopKOpNode::src)
+        .def_ro("out_vals", &TopKOpNode::out_vals)
+        .def_ro("out_idx", &TopKOpNode::out_idx)
+        .def_ro("srcRegion", &TopKOpNode::srcRegion_)
+        .def_ro("valsRegion", &TopKOpNode::valsRegion_)
+        .def_ro("idxRegion", &TopKOpNode::idxRegion_)
+        .def_ro("k", &TopKOpNode::k)
+        .def_ro("largest", &TopKOpNode::largest);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+
+  /// Largest k served by the bitonic kernel, larger k use the radix select
+  static constexpr int kMaxBitonicK = 32;
+};
+
+/// Wrapper class for top-k selection
+class TopKOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(TopKOp, TileOperator, TopKOpNode);
+  TVM_DLL
+  TopKOp(Array<PrimExpr> args,
+         Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+/// Node class for the online softmax update of the rows of a fragment
+class OnlineSoftmaxOpNode : public TileOperatorNode {
+public:
+  tir::Buffer scores; ///< Scores of the block, rewritten to exp2 weights
+  tir::Buffer scores_max, scores_sum; ///< Running row maximum and sum
+  Array<tir::Buffer> accs;            ///< Accumulators rescaled in place
+  BufferRegion scoresRegion_, maxRegion_, sumRegion_;
+  Array<BufferRegion> accRegions_;
+  PrimExpr scale; ///< Factor applied to the scores before exp2
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.OnlineSoftmaxOp", OnlineSoftmaxOpNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<OnlineSoftmaxOpNode>()
+        .def_ro("scores", &OnlineSoftmaxOpNode::scores)
+        .def_ro("scores_max", &OnlineSoftmaxOpNode::scores_max)
+        .def_ro("scores_sum", &OnlineSoftmaxOpNode::scores_sum)
+        .def_ro("accs", &OnlineSoftmaxOpNode::accs)
+        .def_ro("scoresRegion", &OnlineSoftmaxOpNode::scoresRegion_)
+        .def_ro("maxRegion", &OnlineSoftmaxOpNode::maxRegion_)
+        .def_ro("sumRegion", &OnlineSoftmaxOpNode::sumRegion_)
+        .def_ro("accRegions", &OnlineSoftmaxOpNode::accRegions_)
+        .def_ro("scale", &OnlineSoftmaxOpNode::scale);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+};
+
+/// Wrapper class for the online softmax update
+class OnlineSoftmaxOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(OnlineSoftmaxOp, TileOperator,
+                                             OnlineSoftmaxOpNode);
+  TVM_DLL OnlineSoftmaxOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+/// Normalization over the last dimension of a fragment
+enum class NormTypeEnum : uint8_t {
+  kRMSNorm,   ///< x * rsqrt(mean(x^2) + eps)
+  kLayerNorm, ///< (x - mean(x)) * rsqrt(var(x) + eps)
+};
+
+/// Node class for fused row normalizations
+class NormOpNode : public TileOperatorNode {
+public:
+  tir::Buffer x;   ///< (M, N) fragment normalized along its rows
+  tir::Buffer out; ///< (M, N) destination of the normalized rows
+  /// Optional (N,) scale and shift, and (M, N) residual added to x first
+  tir::Buffer weight, bias, residual;
+  BufferRegion xRegion_, outRegion_, weightRegion_, biasRegion_,
+      residualRegion_;
+  int norm_type;      ///< NormTypeEnum
+  PrimExpr eps;       ///< Added to the variance before rsqrt
+  PrimExpr out_scale; ///< Applied before casting to the output dtype
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.NormOp", NormOpNode, TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<NormOpNode>()
+        .def_ro("x", &NormOpNode::x)
+        .def_ro("out", &NormOpNode::out)
+        .def_ro("weight", &NormOpNode::weight)
+        .def_ro("bias", &NormOpNode::bias)
+        .def_ro("residual", &NormOpNode::residual)
+        .def_ro("xRegion", &NormOpNode::xRegion_)
+        .def_ro("outRegion", &NormOpNode::outRegion_)
+        .def_ro("weightRegion", &NormOpNode::weightRegion_)
+        .def_ro("biasRegion", &NormOpNode::biasRegion_)
+        .def_ro("residualRegion", &NormOpNode::residualRegion_)
+        .def_ro("norm_type", &NormOpNode::norm_type)
+        .def_ro("eps", &NormOpNode::eps)
+        .def_ro("out_scale", &NormOpNode::out_scale);
+  }
+
+  bool isRMSNorm() const { return norm_type == int(NormTypeEnum::kRMSNorm); }
+  bool isLayerNorm() const {
+    return norm_type == int(NormTypeEnum::kLayerNorm);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+
+private:
+  /// Parallel loop nest over the elements of x running `body(i, j)`
+  For MakeElementwiseLoop(
+      const std::function<Stmt(const Var &, const Var &)> &body) const;
+  /// Adds the residual to element (i, j) of x
+  Stmt MakeResidualStore(const Var &i, const Var &j) const;
+  /// Stores the normalized element (i, j) to out, given its row statistics
+  Stmt MakeOutputStore(const Var &i, const Var &j, const PrimExpr &mean,
+                       const PrimExpr &rstd) const;
+};
+
+/// Wrapper class for fused row normalizations
+class NormOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(NormOp, TileOperator,
+                                             NormOpNode);
+  TVM_DLL NormOp(Array<PrimExpr> args,
+                 Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+/// Elements of a fragment sharing a quantization scale
+enum class QuantGranularityEnum : uint8_t {
+  kToken,  ///< Every row
+  kBlock,  ///< Every run of group_size consecutive elements of a row
+  kTensor, ///< The whole fragment
+};
+
+/// Node class for fused amax, scale and cast quantization
+class QuantizeOpNode : public TileOperatorNode {
+public:
+  tir::Buffer src;   ///< (M, N) floating point fragment
+  tir::Buffer dst;   ///< (M, N) destination of the quantized elements
+  tir::Buffer scale; ///< Scales, (M,), (M, N / group_size) or (1,)
+  BufferRegion srcRegion_, dstRegion_, scaleRegion_;
+  int granularity; ///< QuantGranularityEnum
+  int group_size;  ///< Elements per scale of kBlock
+  bool stochastic; ///< Round stochastically with tl::rng_rand
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.QuantizeOp", QuantizeOpNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<QuantizeOpNode>()
+        .def_ro("src", &QuantizeOpNode::src)
+        .def_ro("dst", &QuantizeOpNode::dst)
+        .def_ro("scale", &QuantizeOpNode::scale)
+        .def_ro("srcRegion", &QuantizeOpNode::srcRegion_)
+        .def_ro("dstRegion", &QuantizeOpNode::dstRegion_)
+        .def_ro("scaleRegion", &QuantizeOpNode::scaleRegion_)
+        .def_ro("granularity", &QuantizeOpNode::granularity)
+        .def_ro("group_size", &QuantizeOpNode::group_size)
+        .def_ro("stochastic", &QuantizeOpNode::stochastic);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+
+private:
+  /// Number of elements sharing a scale
+  PrimExpr GroupExtent() const;
+  /// Parallel loop nest over the elements of src running `body(i, j)`
+  For MakeElementwiseLoop(
+      const std::function<Stmt(const Var &, const Var &)> &body) const;
+  /// Stores the quantized element (i, j) to dst, given 1 / scale
+  Stmt MakeOutputStore(const Var &i, const Var &j,
+                       const PrimExpr &inv_scale) const;
+};
+
+/// Wrapper class for fused quantization
+class QuantizeOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(QuantizeOp, TileOperator,
+                                             QuantizeOpNode);
+  TVM_DLL QuantizeOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+/// Node class for element-wise reductions across the CTAs of a cluster
+class ClusterAllReduceOpNode : public TileOperatorNode {
+public:
+  tir::Buffer buffer; ///< Fragment or local buffer reduced in place
+  // Optional: keep the original region used to construct this op
+  BufferRegion bufferRegion_;
+  ReduceType type; ///< Type of reduction operation
+
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.ClusterAllReduceOp",
+                                    ClusterAllReduceOpNode, TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<ClusterAllReduceOpNode>()
+        .def_ro("buffer", &ClusterAllReduceOpNode::buffer)
+        .def_ro("bufferRegion", &ClusterAllReduceOpNode::bufferRegion_)
+        .def_ro("type", &ClusterAllReduceOpNode::type);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+};
+
+/// Wrapper class for cluster all-reduce operations
+class ClusterAllReduceOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(ClusterAllReduceOp, TileOperator,
+                                             ClusterAllReduceOpNode);
+  TVM_DLL ClusterAllReduceOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+/*!
+ * \brief Reduce the per-thread elements of a lowered local buffer across the
+ * CTAs of a thread block cluster through distributed shared memory.
+ *
+ * Every thread of the block must execute the returned statement.
+ *
+ * \param T Lowering context of the calling tile operator.
+ * \param buffer The buffer after layout remapping, i.e. the elements held by
+ * one thread.
+ * \param reducer The device reducer functor, e.g. "tl::SumOp".
+ */
+Stmt MakeClusterAllReduce(const LowerArgs &T, const Buffer &buffer,
+                          const std::string &reducer);
+
 } // namespace tl
 } // namespace tvm
 
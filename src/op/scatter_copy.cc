@@ -0,0 +1,264 @@
+/*!
+ * \file tl/op/scatter_copy.cc
+ *
+ * Define the scatter copy operator, used to route tokens to experts and to
+ * combine the expert outputs.
+ */
+
+#include "scatter_copy.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+
+#include "../layout/layout.h"
+#include "../target/utils.h"
+#include "../transform/common/loop_fusion_utils.h"
+#include "../transform/loop_partition.h"
+#include "../transform/loop_vectorize.h"
+#include "builtin.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/**
+ * @brief Construct a ScatterCopy operator from call arguments.
+ *
+ * @param args Call arguments: [src_region, index_region, dst_region,
+ * reduce_add].
+ */
+ScatterCopy::ScatterCopy(Array<PrimExpr> args,
+                         Map<String, ObjectRef> annotations) {
+  ObjectPtr<ScatterCopyNode> node = tvm::ffi::make_object<ScatterCopyNode>();
+  BufferRegion src = NormalizeToBufferRegion(args[0]);
+  BufferRegion index = NormalizeToBufferRegion(args[1]);
+  BufferRegion dst = NormalizeToBufferRegion(args[2]);
+  node->src = src->buffer;
+  node->src_range = src->region;
+  node->index = index->buffer;
+  node->index_range = index->region;
+  node->dst = dst->buffer;
+  node->dst_range = dst->region;
+  node->reduce_add = !is_zero(args[3]);
+  ICHECK(IsGlobalBuffer(node->dst))
+      << "T.scatter expects a global destination, got `" << node->dst->name
+      << "` in scope " << node->dst.scope();
+  ICHECK(node->index->dtype.is_int() || node->index->dtype.is_uint())
+      << "T.scatter expects an integer index table, got "
+      << node->index->dtype;
+  ICHECK(!node->dst_range.empty() && !node->index_range.empty());
+  data_ = std::move(node);
+}
+
+TileOperator ScatterCopyNode::Clone() const {
+  auto op = tvm::ffi::make_object<ScatterCopyNode>(*this);
+  if (par_op_.defined()) {
+    op->par_op_ = Downcast<ParallelOp>(par_op_->Clone());
+  }
+  return ScatterCopy(op);
+}
+
+PrimExpr ScatterCopyNode::ScatteredRow(PrimExpr row) const {
+  Array<PrimExpr> indices;
+  for (const Range &r : index_range) {
+    indices.push_back(r->min);
+  }
+  int last = indices.size() - 1;
+  indices.Set(last, indices[last] + cast(indices[last].dtype(), row));
+  DataType dtype = dst_range[0]->min.dtype();
+  return dst_range[0]->min + cast(dtype, BufferLoad(index, indices));
+}
+
+For ScatterCopyNode::MakeSIMTLoop(arith::Analyzer *analyzer) const {
+  Array<IterVar> loop_vars;
+  for (size_t i = 0; i < src_range.size(); i++) {
+    if (is_one(src_range[i]->extent))
+      continue;
+    Var var = Var(std::string{char('i' + loop_vars.size())},
+                  src_range[i]->extent->dtype);
+    loop_vars.push_back(
+        {Range(0, src_range[i]->extent), var, IterVarType::kDataPar});
+  }
+  ICHECK(!loop_vars.empty())
+      << "T.scatter expects at least one scattered row in " << src->name;
+  for (const auto &iv : loop_vars)
+    analyzer->Bind(iv->var, iv->dom);
+
+  // The first loop walks the scattered rows, the others the copied dims.
+  Array<PrimExpr> src_indices;
+  size_t idx = 0;
+  for (const Range &r : src_range) {
+    if (is_one(r->extent)) {
+      src_indices.push_back(r->min);
+    } else {
+      src_indices.push_back(r->min + loop_vars[idx++]->var);
+    }
+  }
+  Array<PrimExpr> dst_indices{ScatteredRow(loop_vars[0]->var)};
+  idx = 1;
+  for (size_t i = 1; i < dst_range.size(); i++) {
+    if (is_one(dst_range[i]->extent)) {
+      dst_indices.push_back(dst_range[i]->min);
+      continue;
+    }
+    ICHECK(idx < loop_vars.size() &&
+           analyzer->CanProveEqual(dst_range[i]->extent,
+                                   loop_vars[idx]->dom->extent))
+        << "T.scatter region mismatch: " << src->name << src_range << " vs. "
+        << dst->name << dst_range;
+    dst_indices.push_back(dst_range[i]->min + loop_vars[idx++]->var);
+  }
+  ICHECK(idx == loop_vars.size())
+      << "T.scatter region mismatch: " << src->name << src_range << " vs. "
+      << dst->name << dst_range;
+
+  PrimExpr value = BufferLoad(src, src_indices);
+  if (src->dtype != dst->dtype)
+    value = Cast(dst->dtype, value);
+  Stmt body;
+  if (reduce_add) {
+    PrimExpr dst_ptr = Call(DataType::Handle(), builtin::address_of(),
+                            {BufferLoad(dst, dst_indices)});
+    body = Evaluate(
+        Call(dst->dtype, atomic_add_elem_op(), {dst_ptr, value, Integer(0)}));
+  } else {
+    body = BufferStore(dst, value, dst_indices);
+  }
+  for (int i = loop_vars.size() - 1; i >= 0; i--) {
+    body = For(loop_vars[i]->var, 0, loop_vars[i]->dom->extent,
+               ForKind::kParallel, body);
+  }
+  return Downcast<For>(body);
+}
+
+// Bulk stores move whole rows of a linear 2D shared tile into a 2D global
+// destination; the atomic combine has no bulk form for every dtype and keeps
+// the SIMT loop.
+bool ScatterCopyNode::CheckBulkScatter(const LowerArgs &T,
+                                       arith::Analyzer *analyzer) const {
+  if (reduce_add || !TargetHasBulkCopy(T.target) || !IsSharedBuffer(src))
+    return false;
+  if (tvm::transform::PassContext::Current()
+          ->GetConfig<Bool>(kDisableTMALower, Bool(false))
+          .value())
+    return false;
+  if (src->dtype != dst->dtype || src->shape.size() != 2 ||
+      dst->shape.size() != 2 || !dst->strides.empty())
+    return false;
+  if (T.layout_map.count(src) &&
+      !StructuralEqual()(T.layout_map.at(src), makeLinearLayout(src->shape)))
+    return false;
+  if (!analyzer->CanProveEqual(src_range[1]->extent, dst_range[1]->extent))
+    return false;
+  const auto *cols = as_const_int(src_range[1]->extent);
+  if (cols == nullptr || (*cols * src->dtype.bytes()) % 16 != 0)
+    return false;
+  // The index entry is unknown, only the row pitch and column offsets count.
+  DataType dtype = dst_range[0]->min.dtype();
+  Var probe("p", dtype), row("r", src_range[0]->min.dtype());
+  PrimExpr dst_offset = probe * cast(dtype, dst->shape[1]) +
+                        cast(dtype, dst_range[1]->min);
+  PrimExpr src_offset =
+      (src_range[0]->min + row) * src->shape[1] + src_range[1]->min;
+  for (PrimExpr offset : {dst_offset, src_offset}) {
+    arith::ModularSet mod =
+        analyzer->modular_set(offset * src->dtype.bytes());
+    if (mod->coeff % 16 != 0 || mod->base % 16 != 0)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Lower to one 1D bulk TMA store per scattered row.
+ *
+ * The stores only commit their bulk group (attr::kTMAStoreAsync), so the rows
+ * stream out back to back and are waited for before the tile is rewritten.
+ */
+Stmt ScatterCopyNode::LowerBulkRows(const LowerArgs &T,
+                                    arith::Analyzer *analyzer) const {
+  Buffer shared_tensor = src;
+  if (T.buffer_remap.count(src)) {
+    shared_tensor = T.buffer_remap.at(src);
+  }
+  int bytes = src->dtype.bytes();
+  Var row("r", src_range[0]->min.dtype());
+  DataType dtype = dst_range[0]->min.dtype();
+  PrimExpr dst_offset = ScatteredRow(row) * cast(dtype, dst->shape[1]) +
+                        cast(dtype, dst_range[1]->min);
+  PrimExpr src_offset =
+      (src_range[0]->min + row) * src->shape[1] + src_range[1]->min;
+  PrimExpr elements = src_range[1]->extent;
+  PrimExpr shared_addr = shared_tensor.access_ptr(1, DataType::Handle(), 1,
+                                                  src_offset, elements);
+  PrimExpr global_addr =
+      dst.access_ptr(2, DataType::Handle(), 1, dst_offset, elements);
+  int need_reduce = 0;
+  Map<String, ObjectRef> op_annotations;
+  op_annotations.Set(attr::kTMAStoreAsync, Integer(1));
+  Array<PrimExpr> args{global_addr, shared_addr, elements * bytes, need_reduce,
+                       0};
+  Stmt body =
+      Evaluate(Call(DataType::Handle(), tma_store(), args, op_annotations));
+  body = For(row, 0, src_range[0]->extent, ForKind::kSerial, body);
+  return IfThenElse(EQ(T.thread_var, T.thread_bounds->min), body);
+}
+
+/**
+ * @brief Lower the scatter copy.
+ *
+ * Rows of a linear shared tile are written with bulk TMA stores on sm90+.
+ * Other cases lower to a SIMT loop whose innermost dimension is vectorized,
+ * the index entry only depends on the row; with `reduce_add` the vectorized
+ * loop emits packed atomic adds.
+ */
+Stmt ScatterCopyNode::Lower(const LowerArgs &T,
+                            arith::Analyzer *analyzer) const {
+  if (CheckBulkScatter(T, analyzer)) {
+    return LowerBulkRows(T, analyzer);
+  }
+  auto simt_loop = MakeSIMTLoop(analyzer);
+  auto fused_loop = Downcast<For>(ParallelLoopFuser::Fuse(simt_loop));
+  if (T.target->GetTargetDeviceType() == kDLCPU) {
+    return VectorizeLoop(fused_loop, T.layout_map);
+  }
+  auto par_op = ParallelOp(fused_loop);
+  for (auto level :
+       {InferLevel::kCommon, InferLevel::kStrict, InferLevel::kFree}) {
+    par_op->InferLayout({T.target,
+                         T.thread_bounds,
+                         T.layout_map,
+                         analyzer,
+                         false,
+                         T.buffer_remap,
+                         {}},
+                        level);
+  }
+  return LowerParallelLoop(par_op->GetRoot(), par_op->GetLoopLayout(),
+                           T.thread_var, analyzer, T.layout_map,
+                           par_op->GetPredicate(T.thread_var));
+}
+
+// A fragment source takes its layout through ParallelOp, like the SIMT path
+// of T.copy; a shared source leaves its layout to the producer.
+LayoutMap ScatterCopyNode::InferLayout(const LayoutInferArgs &T,
+                                       InferLevel level) const {
+  if (!par_op_.defined()) {
+    arith::Analyzer analyzer;
+    par_op_ = ParallelOp(MakeSIMTLoop(&analyzer));
+  }
+  return par_op_->InferLayout(T, level);
+}
+
+TIR_REGISTER_TL_TILE_OP(ScatterCopy, scatter_copy)
+    .set_num_inputs(4)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() { ScatterCopyNode::RegisterReflection(); }
+
+} // namespace tl
+} // namespace tvm
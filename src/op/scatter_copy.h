@@ -0,0 +1,83 @@
+/*!
+ * \file tl/op/scatter_copy.h
+ * \brief Copy of rows scattered through an index table
+ */
+
+#ifndef TVM_TL_OP_SCATTER_COPY_H_
+#define TVM_TL_OP_SCATTER_COPY_H_
+
+#include "operator.h"
+#include "parallel.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/*!
+ * \brief Node class for scatter copies.
+ *
+ * Row `i` of the first non-unit dimension of `src` is written to row
+ * `dst_range[0]->min + index[i]` of `dst`, with the index table read along
+ * the last dimension of `index_range`. The remaining non-unit dimensions are
+ * copied as T.copy does. With `reduce_add` the rows are accumulated with
+ * atomic adds, so rows sent to the same destination combine.
+ */
+class ScatterCopyNode : public TileOperatorNode {
+public:
+  tir::Buffer src;          ///< Buffer holding the rows to scatter
+  tir::Buffer index;        ///< Buffer holding the destination row indices
+  tir::Buffer dst;          ///< Global destination buffer
+  Array<Range> src_range;   ///< Source region
+  Array<Range> index_range; ///< Region of the index table, on its last dim
+  Array<Range> dst_range;   ///< Destination region, dim 0 is the scattered one
+  bool reduce_add;          ///< Accumulate with atomic adds instead of stores
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.ScatterCopy", ScatterCopyNode,
+                                    TileOperatorNode);
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  LayoutMap InferLayout(const LayoutInferArgs &T, InferLevel level) const;
+  static const Op &Get();
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<ScatterCopyNode>()
+        .def_ro("src", &ScatterCopyNode::src)
+        .def_ro("index", &ScatterCopyNode::index)
+        .def_ro("dst", &ScatterCopyNode::dst)
+        .def_ro("src_range", &ScatterCopyNode::src_range)
+        .def_ro("index_range", &ScatterCopyNode::index_range)
+        .def_ro("dst_range", &ScatterCopyNode::dst_range)
+        .def_ro("reduce_add", &ScatterCopyNode::reduce_add);
+  }
+
+  TileOperator Clone() const;
+
+private:
+  /// Destination row of the `row`-th source row
+  PrimExpr ScatteredRow(PrimExpr row) const;
+  /// Create SIMT-style parallel loop for the scatter
+  For MakeSIMTLoop(arith::Analyzer *analyzer) const;
+  /// Whether the rows can be stored with bulk TMA stores
+  bool CheckBulkScatter(const LowerArgs &T, arith::Analyzer *analyzer) const;
+  /// Lower to one 1D bulk store per row
+  Stmt LowerBulkRows(const LowerArgs &T, arith::Analyzer *analyzer) const;
+
+  mutable ParallelOp par_op_; // Layout inference of the SIMT loop
+};
+
+/// Wrapper class for scatter copies
+class ScatterCopy : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(ScatterCopy, TileOperator,
+                                             ScatterCopyNode);
+  TVM_DLL
+  ScatterCopy(Array<PrimExpr> args,
+              Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_SCATTER_COPY_H_
@@ -0,0 +1,187 @@
+/*!
+ * \file tl/op/symm.cc
+ * \brief Implementation of the symmetric memory communication operators
+ */
+
+#include "symm.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include "../target/utils.h"
+#include "builtin.h"
+#include "utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Data of the tensor of a peer standing for that of `buffer`
+static Var RemoteData(const Buffer &buffer) {
+  return Var(buffer->data->name_hint + "_peer",
+             buffer->data->type_annotation);
+}
+
+/// Bind `remote` to the tensor of `peer` of the symmetric `buffer` in `body`
+static Stmt BindRemote(const Buffer &buffer, const Var &remote,
+                       const PrimExpr &peer, Stmt body) {
+  PrimExpr base = Call(DataType::Handle(), symm_remote_ptr(),
+                       {buffer->data, cast(DataType::Int(32), peer)});
+  return LetStmt(remote, base, body);
+}
+
+static void CheckSymmetricTarget(const Target &target, const char *op) {
+  ICHECK(TargetIsCuda(target))
+      << op << " communicates through CUDA IPC mappings, got " << target;
+}
+
+PeerCopy::PeerCopy(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
+  /// PeerCopy constructor arguments:
+  /// - src, dst: regions of the copy
+  /// - peer: rank holding the remote side
+  /// - direction: PeerCopyDirection
+  CHECK_EQ(args.size(), 4);
+  ObjectPtr<PeerCopyNode> node = tvm::ffi::make_object<PeerCopyNode>();
+  annotations.Set("disable_tma", IntImm(DataType::Int(32), 1));
+  node->copy = Copy({args[0], args[1]}, annotations);
+  node->peer = args[2];
+  node->direction = static_cast<int>(args[3].as<IntImmNode>()->value);
+  ICHECK(node->direction == int(PeerCopyDirection::kPut) ||
+         node->direction == int(PeerCopyDirection::kGet))
+      << "Unknown peer copy direction " << node->direction;
+  const Buffer &symm = node->SymmetricBuffer();
+  ICHECK(IsGlobalBuffer(symm))
+      << (node->direction == int(PeerCopyDirection::kPut) ? "T.put" : "T.get")
+      << " expects a symmetric tensor in global memory, got " << symm->name
+      << " in " << symm.scope();
+  data_ = std::move(node);
+}
+
+TileOperator PeerCopyNode::Clone() const {
+  auto op = tvm::ffi::make_object<PeerCopyNode>(*this);
+  op->copy = Downcast<Copy>(copy->Clone());
+  return PeerCopy(op);
+}
+
+const Buffer &PeerCopyNode::SymmetricBuffer() const {
+  return direction == int(PeerCopyDirection::kPut) ? copy->dst : copy->src;
+}
+
+Stmt PeerCopyNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
+  CheckSymmetricTarget(T.target, "T.put/T.get");
+  const Buffer &symm = SymmetricBuffer();
+  Var remote = RemoteData(symm);
+  Stmt body = copy->Lower(T, analyzer);
+  body = Substitute(body, Map<Var, PrimExpr>{{symm->data, remote}});
+  return BindRemote(symm, remote, peer, body);
+}
+
+LayoutMap PeerCopyNode::InferLayout(const LayoutInferArgs &T,
+                                    InferLevel level) const {
+  return copy->InferLayout(T, level);
+}
+
+/// The uint64 signal element of `arg`, for `op`
+static BufferLoad SignalElement(const PrimExpr &arg, const char *op) {
+  const auto *load = arg.as<BufferLoadNode>();
+  ICHECK(load) << op << " expects an element of a signal tensor, got " << arg;
+  ICHECK(IsGlobalBuffer(load->buffer) &&
+         load->buffer->dtype == DataType::UInt(64))
+      << op << " expects a uint64 tensor in global memory, got "
+      << load->buffer->name << " of dtype " << load->buffer->dtype << " in "
+      << load->buffer.scope();
+  return tvm::ffi::GetRef<BufferLoad>(load);
+}
+
+SignalOp::SignalOp(Array<PrimExpr> args, Map<String, ObjectRef> annotations) {
+  /// Signal constructor arguments:
+  /// - signal: element of a symmetric uint64 tensor
+  /// - value: value set or added
+  /// - peer: rank whose signal is updated
+  /// - op: 0 to set, 1 to add
+  CHECK_EQ(args.size(), 4);
+  ObjectPtr<SignalOpNode> node = tvm::ffi::make_object<SignalOpNode>();
+  node->signal = SignalElement(args[0], "T.signal");
+  node->value = cast(DataType::UInt(64), args[1]);
+  node->peer = args[2];
+  node->op = static_cast<int>(args[3].as<IntImmNode>()->value);
+  ICHECK(node->op == 0 || node->op == 1)
+      << "Unknown signal op " << node->op;
+  data_ = std::move(node);
+}
+
+TileOperator SignalOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<SignalOpNode>(*this);
+  return SignalOp(op);
+}
+
+Stmt SignalOpNode::Lower(const LowerArgs &T, arith::Analyzer *analyzer) const {
+  CheckSymmetricTarget(T.target, "T.signal");
+  Var remote = RemoteData(signal->buffer);
+  Buffer remote_buffer = signal->buffer;
+  remote_buffer.CopyOnWrite()->data = remote;
+  PrimExpr addr = Call(DataType::Handle(), builtin::address_of(),
+                       {BufferLoad(remote_buffer, signal->indices)});
+  Stmt body = Evaluate(Call(
+      DataType::Handle(), symm_signal(),
+      {addr, value, IntImm(DataType::Int(32), op),
+       T.thread_var == T.thread_bounds->min}));
+  return BindRemote(signal->buffer, remote, peer, body);
+}
+
+SignalWaitOp::SignalWaitOp(Array<PrimExpr> args,
+                           Map<String, ObjectRef> annotations) {
+  /// SignalWait constructor arguments:
+  /// - signal: element of a local uint64 tensor
+  /// - value: value compared to
+  /// - cmp: comparison, as SymmCompare
+  CHECK_EQ(args.size(), 3);
+  ObjectPtr<SignalWaitOpNode> node = tvm::ffi::make_object<SignalWaitOpNode>();
+  node->signal = SignalElement(args[0], "T.signal_wait");
+  node->value = cast(DataType::UInt(64), args[1]);
+  node->cmp = static_cast<int>(args[2].as<IntImmNode>()->value);
+  ICHECK(node->cmp >= 0 && node->cmp <= 5)
+      << "Unknown signal comparison " << node->cmp;
+  data_ = std::move(node);
+}
+
+TileOperator SignalWaitOpNode::Clone() const {
+  auto op = tvm::ffi::make_object<SignalWaitOpNode>(*this);
+  return SignalWaitOp(op);
+}
+
+Stmt SignalWaitOpNode::Lower(const LowerArgs &T,
+                             arith::Analyzer *analyzer) const {
+  CheckSymmetricTarget(T.target, "T.signal_wait");
+  PrimExpr addr = Call(DataType::Handle(), builtin::address_of(), {signal});
+  return Evaluate(Call(DataType::Handle(), symm_wait(),
+                       {addr, value, IntImm(DataType::Int(32), cmp),
+                        T.thread_var == T.thread_bounds->min}));
+}
+
+TIR_REGISTER_TL_TILE_OP(PeerCopy, peer_copy)
+    .set_num_inputs(4)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TIR_REGISTER_TL_TILE_OP(SignalOp, signal)
+    .set_num_inputs(4)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TIR_REGISTER_TL_TILE_OP(SignalWaitOp, signal_wait)
+    .set_num_inputs(3)
+    .set_attr<TCallEffectKind>("TCallEffectKind",
+                               Integer(CallEffectKind::kOpaque));
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  PeerCopyNode::RegisterReflection();
+  SignalOpNode::RegisterReflection();
+  SignalWaitOpNode::RegisterReflection();
+}
+
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,157 @@
+/*!
+ * \file tl/op/symm.h
+ * \brief Communication between the ranks of a node through symmetric tensors
+ */
+
+#ifndef TVM_TL_OP_SYMM_H_
+#define TVM_TL_OP_SYMM_H_
+
+#include "copy.h"
+#include "operator.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Which side of a peer copy lives on the peer
+enum class PeerCopyDirection : uint8_t {
+  kPut = 0, ///< The destination, T.put
+  kGet = 1, ///< The source, T.get
+};
+
+/*!
+ * \brief Node class for tile copies to or from the symmetric tensor of a
+ * peer.
+ *
+ * A symmetric tensor is allocated at the same offset of the symmetric heap
+ * of every rank, and preceded by the addresses at which the tensors of the
+ * peers are mapped into this process (tl_templates/cuda/symm.h). The copy
+ * is lowered as the plain copy of the local tensor, with the data of the
+ * symmetric tensor rebound to that of `peer`. TMA is disabled, since the
+ * host-side descriptors only know the local tensor.
+ */
+class PeerCopyNode : public TileOperatorNode {
+public:
+  Copy copy;        ///< The copy with the symmetric tensor local
+  PrimExpr peer;    ///< Rank holding the remote side
+  int direction;    ///< PeerCopyDirection
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.PeerCopy", PeerCopyNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<PeerCopyNode>()
+        .def_ro("copy", &PeerCopyNode::copy)
+        .def_ro("peer", &PeerCopyNode::peer)
+        .def_ro("direction", &PeerCopyNode::direction);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override;
+  static const Op &Get();
+  TileOperator Clone() const;
+
+  /// The symmetric tensor of the copy
+  const Buffer &SymmetricBuffer() const;
+};
+
+/// Wrapper class for peer copies
+class PeerCopy : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(PeerCopy, TileOperator,
+                                             PeerCopyNode);
+  TVM_DLL PeerCopy(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+/*!
+ * \brief Node class for signals set or incremented on a peer.
+ *
+ * All threads of the block wait for each other first, so that the transfers
+ * the block issued before are visible to the peer once it sees the signal.
+ */
+class SignalOpNode : public TileOperatorNode {
+public:
+  BufferLoad signal; ///< Element of a symmetric uint64 tensor
+  PrimExpr value;    ///< Value set or added
+  PrimExpr peer;     ///< Rank whose signal is updated
+  int op;            ///< 0 to set, 1 to add, as SymmSignalOp
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.SignalOp", SignalOpNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<SignalOpNode>()
+        .def_ro("signal", &SignalOpNode::signal)
+        .def_ro("value", &SignalOpNode::value)
+        .def_ro("peer", &SignalOpNode::peer)
+        .def_ro("op", &SignalOpNode::op);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override {
+    return {};
+  }
+  static const Op &Get();
+  TileOperator Clone() const;
+};
+
+/// Wrapper class for signals
+class SignalOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(SignalOp, TileOperator,
+                                             SignalOpNode);
+  TVM_DLL SignalOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+/*!
+ * \brief Node class for waits of the block on a local signal.
+ */
+class SignalWaitOpNode : public TileOperatorNode {
+public:
+  BufferLoad signal; ///< Element of a local uint64 tensor
+  PrimExpr value;    ///< Value compared to
+  int cmp;           ///< Comparison, as SymmCompare
+  TVM_FFI_DECLARE_OBJECT_INFO_FINAL("tl.SignalWaitOp", SignalWaitOpNode,
+                                    TileOperatorNode);
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<SignalWaitOpNode>()
+        .def_ro("signal", &SignalWaitOpNode::signal)
+        .def_ro("value", &SignalWaitOpNode::value)
+        .def_ro("cmp", &SignalWaitOpNode::cmp);
+  }
+
+  Stmt Lower(const LowerArgs &T, arith::Analyzer *analyzer) const override;
+  LayoutMap InferLayout(const LayoutInferArgs &T,
+                        InferLevel level) const override {
+    return {};
+  }
+  static const Op &Get();
+  TileOperator Clone() const;
+};
+
+/// Wrapper class for signal waits
+class SignalWaitOp : public TileOperator {
+public:
+  TVM_FFI_DEFINE_OBJECT_REF_METHODS_NULLABLE(SignalWaitOp, TileOperator,
+                                             SignalWaitOpNode);
+  TVM_DLL SignalWaitOp(
+      Array<PrimExpr> args,
+      Map<String, ObjectRef> annotations = Map<String, ObjectRef>());
+  static const Op &Get();
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_OP_SYMM_H_
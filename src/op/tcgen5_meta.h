@@ -18,8 +18,12 @@ struct TCGEN5MMAMeta {
   bool enable_ws, enable_2cta;
 };
 
+// With use_2cta, M, N and K describe the per-CTA accumulator of a CTA pair
+// issuing cta_group::2 MMAs: each CTA holds M rows of A and D and N / 2
+// columns of B, and an atom spans 2 * atom_m rows.
 inline std::pair<bool, TCGEN5MMAMeta>
-GetTCGEN5MMAMeta(int M, int N, int K, DataType ab_dtype, DataType c_dtype) {
+GetTCGEN5MMAMeta(int M, int N, int K, DataType ab_dtype, DataType c_dtype,
+                 bool use_2cta = false) {
 // TODO (lei) Currently not all shapes / dtypes are supported for TCGEN5MMA.
 #define FAIL                                                                   \
   return {                                                                     \
@@ -29,6 +33,26 @@ GetTCGEN5MMAMeta(int M, int N, int K, DataType ab_dtype, DataType c_dtype) {
   return {                                                                     \
     true, TCGEN5MMAMeta { atom_m, atom_n, atom_k, use_ws, use_2cta }           \
   }
+  if (use_2cta) {
+    int atom_k = 0;
+    if ((ab_dtype.is_bfloat16() || ab_dtype.is_float16()) &&
+        (c_dtype.is_float() && c_dtype.bits() == 32)) {
+      atom_k = 16;
+    } else if ((ab_dtype.is_float8() || ab_dtype.is_float6_e2m3fn() ||
+                ab_dtype.is_float6_e3m2fn() || ab_dtype.is_float4_e2m1fn()) &&
+               ((c_dtype.is_float() && c_dtype.bits() == 32) ||
+                (c_dtype.is_float16() && c_dtype.bits() == 16))) {
+      atom_k = 32;
+    }
+    // Only the 256-row pair atom, whose accumulator uses all the 128 lanes
+    // of the tensor memory of each CTA.
+    if (atom_k == 0 || K % atom_k != 0 || M != 128)
+      FAIL;
+    for (int atom_n = 256; atom_n >= 32; atom_n -= 32)
+      if (N % atom_n == 0)
+        SUCCESS(128, atom_n, atom_k, false, true);
+    FAIL;
+  }
   std::vector<int> ws_valid_atom_ns = {256, 128, 64};
   if ((ab_dtype.is_bfloat16() || ab_dtype.is_float16()) &&
       (c_dtype.is_float() && c_dtype.bits() == 32)) {
@@ -91,6 +115,37 @@ GetTCGEN5MMAMeta(int M, int N, int K, DataType ab_dtype, DataType c_dtype) {
 #undef SUCCESS
 }
 
+// Block scaled MMAs (kind::mxf8f6f4 and kind::mxf4nvf4 with .block_scale),
+// every sf_vec_size consecutive elements of K sharing a scale factor: FP8 A/B
+// with UE8M0 scales per 32 elements (MXFP8), FP4 A/B with UE8M0 scales per 32
+// (MXFP4) or UE4M3 scales per 16 (NVFP4) elements. The scale factors are
+// copied into tensor memory 4 per row by tcgen05.cp, so K holds a multiple of
+// 4 * sf_vec_size elements.
+inline std::pair<bool, TCGEN5MMAMeta>
+GetTCGEN5BlockScaledMMAMeta(int M, int N, int K, DataType ab_dtype,
+                            DataType c_dtype, int sf_vec_size) {
+#define FAIL                                                                   \
+  return {                                                                     \
+    false, TCGEN5MMAMeta { 0, 0, 0, false, false }                             \
+  }
+  int atom_k = 0;
+  if (ab_dtype.is_float8() && sf_vec_size == 32) {
+    atom_k = 32;
+  } else if (ab_dtype.is_float4_e2m1fn() &&
+             (sf_vec_size == 32 || sf_vec_size == 16)) {
+    atom_k = 64;
+  }
+  if (atom_k == 0 || !(c_dtype.is_float() && c_dtype.bits() == 32))
+    FAIL;
+  // Accumulators of all the 128 lanes, B atoms of one or two 128-row chunks
+  // of scale factors.
+  if (M != 128 || N % 128 != 0 || K % (4 * sf_vec_size) != 0)
+    FAIL;
+  return {true, TCGEN5MMAMeta{128, N % 256 == 0 ? 256 : 128, atom_k, false,
+                              false}};
+#undef FAIL
+}
+
 inline uint32_t GetTCGEN5InstrDesc(int atom_m, int atom_n, int atom_k,
                                    DataType ab_dtype, DataType c_dtype,
                                    bool a_is_k_major, bool b_is_k_major,
@@ -171,6 +226,50 @@ inline uint32_t GetTCGEN5InstrDesc(int atom_m, int atom_n, int atom_k,
   return desc;
 }
 
+// The sf_id fields selecting the scale factors of an MMA within their tensor
+// memory column, bits [4, 6) for B and [29, 31) for A, are left zero and set
+// per MMA.
+inline uint32_t GetTCGEN5BlockScaledInstrDesc(int atom_m, int atom_n,
+                                              DataType ab_dtype,
+                                              bool a_is_k_major,
+                                              bool b_is_k_major,
+                                              int sf_vec_size) {
+  ICHECK(atom_m == 128) << "block scaled TCGEN5MMA requires atom_m == 128";
+  ICHECK(atom_n % 16 == 0) << "atom_n must be divisible by 16";
+  ICHECK(sf_vec_size == 16 || sf_vec_size == 32)
+      << "Unsupported scale factor vector size: " << sf_vec_size;
+
+  uint32_t format = 0;
+  if (ab_dtype.is_float8_e4m3fn() || ab_dtype.is_float8_e4m3fnuz() ||
+      ab_dtype.is_float8_e4m3()) {
+    format = 0;
+  } else if (ab_dtype.is_float8_e5m2fnuz() || ab_dtype.is_float8_e5m2()) {
+    format = 1;
+  } else if (ab_dtype.is_float4_e2m1fn()) {
+    // E2M1 of kind::mxf4nvf4
+    format = 1;
+  } else {
+    LOG(FATAL) << "Unsupported dtype for block scaled TCGEN5MMA descriptor: "
+               << ab_dtype;
+  }
+
+  auto set_bits = [](uint32_t value, int start, int width) -> uint32_t {
+    uint32_t mask = (width == 32) ? 0xFFFFFFFFu : ((1u << width) - 1);
+    return (value & mask) << start;
+  };
+
+  uint32_t desc = 0;
+  desc |= set_bits(format, 7, 3);
+  desc |= set_bits(format, 10, 3);
+  desc |= set_bits(a_is_k_major ? 0u : 1u, 15, 1);
+  desc |= set_bits(b_is_k_major ? 0u : 1u, 16, 1);
+  desc |= set_bits(static_cast<uint32_t>(atom_n >> 3), 17, 6);
+  // scale factor format, UE8M0 = 1, UE4M3 = 0
+  desc |= set_bits(sf_vec_size == 32 ? 1u : 0u, 23, 1);
+  desc |= set_bits(static_cast<uint32_t>(atom_m >> 4), 24, 5);
+  return desc;
+}
+
 } // namespace tl
 } // namespace tvm
 
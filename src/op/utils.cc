@@ -92,6 +92,32 @@ PrimExpr MakeAccessPtrFromRegion(const BufferRegion &region, int rw_mask,
   return Call(DataType::Handle(), builtin::tvm_access_ptr(), acc_args);
 }
 
+// Whether `region` has `shape`, after leading unit extents.
+bool RegionHasShape(const BufferRegion &region, const Array<PrimExpr> &shape) {
+  if (region->region.size() < shape.size())
+    return false;
+  arith::Analyzer analyzer;
+  size_t lead = region->region.size() - shape.size();
+  for (size_t d = 0; d < region->region.size(); ++d) {
+    PrimExpr expected = d < lead ? PrimExpr(1) : shape[d - lead];
+    if (!analyzer.CanProveEqual(region->region[d]->extent, expected))
+      return false;
+  }
+  return true;
+}
+
+// Indices into `region` of the element at `indices` of its trailing extents.
+Array<PrimExpr> RegionIndices(const BufferRegion &region,
+                              const Array<PrimExpr> &indices) {
+  Array<PrimExpr> result;
+  size_t lead = region->region.size() - indices.size();
+  for (size_t d = 0; d < region->region.size(); ++d) {
+    const PrimExpr &min = region->region[d]->min;
+    result.push_back(d < lead ? min : min + indices[d - lead]);
+  }
+  return result;
+}
+
 // Maps TVM DataType to CUDA's CUtensorMapDataType enum value.
 int to_CUtensorMapDataType(DataType dtype) {
   CUtensorMapDataType tp;
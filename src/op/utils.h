@@ -38,6 +38,14 @@ TVM_DLL BufferRegion NormalizeToBufferRegion(const PrimExpr &arg);
 TVM_DLL PrimExpr MakeAccessPtrFromRegion(const BufferRegion &region,
                                          int rw_mask, bool require_2d = false);
 
+// Whether `region` has `shape`, after leading unit extents.
+TVM_DLL bool RegionHasShape(const BufferRegion &region,
+                            const Array<PrimExpr> &shape);
+
+// Indices into `region` of the element at `indices` of its trailing extents.
+TVM_DLL Array<PrimExpr> RegionIndices(const BufferRegion &region,
+                                      const Array<PrimExpr> &indices);
+
 // Check if a buffer is a fragment buffer (scope == "local.fragment")
 inline bool IsFragmentBuffer(const Buffer &buffer) {
   return buffer.defined() && buffer.scope() == "local.fragment";
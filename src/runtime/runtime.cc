@@ -10,15 +10,13 @@
 #include <tvm/ffi/function.h>
 #include <tvm/node/node.h>
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 namespace tvm {
 namespace tl {
 
-#if 1
-// Thread-local storage for restoring the L2 persisting cache limit
-static thread_local size_t __tl_prev_persisting_l2_cache_size = 0;
-static thread_local bool __tl_prev_persisting_l2_cache_saved = false;
-#endif
-
 #if (CUDA_MAJOR_VERSION >= 12)
 template <typename T> static std::string ArrayToStr(const T *ptr, size_t n) {
   std::stringstream ss;
@@ -32,6 +30,99 @@ template <typename T> static std::string ArrayToStr(const T *ptr, size_t n) {
   return ss.str();
 }
 
+template <typename T> static void AppendKey(std::string *key, const T &value) {
+  key->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static void AppendKey(std::string *key, const T *ptr, size_t n) {
+  key->append(reinterpret_cast<const char *>(ptr), sizeof(T) * n);
+}
+
+/*!
+ * \brief Host-side cache of encoded TMA descriptors.
+ *
+ * Encoding a CUtensorMap goes through the driver on every launch, which shows
+ * up as CPU overhead for kernels that only run for a few microseconds.
+ * Entries are keyed on every encoding parameter except the global address, so
+ * a launch with the same layout but a different base pointer reuses the
+ * cached encoding and only patches the address.
+ */
+class TensorMapCache {
+public:
+  static TensorMapCache *Global() {
+    static TensorMapCache *inst = new TensorMapCache();
+    return inst;
+  }
+
+  /*!
+   * \brief Fill `map` from the cache.
+   * \return false if the layout has not been encoded before, or if the cached
+   *         descriptor could not be retargeted to `address`.
+   */
+  bool Lookup(const std::string &key, void *address, CUtensorMap *map) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      ++misses_;
+      return false;
+    }
+    if (it->second.address != address) {
+      CUtensorMap patched = it->second.map;
+      if (cuTensorMapReplaceAddress(&patched, address) != CUDA_SUCCESS) {
+        ++misses_;
+        return false;
+      }
+      it->second.map = patched;
+      it->second.address = address;
+      ++patches_;
+    } else {
+      ++hits_;
+    }
+    *map = it->second.map;
+    return true;
+  }
+
+  void Insert(const std::string &key, void *address, const CUtensorMap &map) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxEntries) {
+      entries_.clear();
+    }
+    entries_[key] = Entry{address, map};
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    hits_ = patches_ = misses_ = 0;
+  }
+
+  ffi::Map<ffi::String, int64_t> Stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ffi::Map<ffi::String, int64_t> stats;
+    stats.Set("hits", hits_);
+    stats.Set("address_patches", patches_);
+    stats.Set("misses", misses_);
+    stats.Set("entries", static_cast<int64_t>(entries_.size()));
+    return stats;
+  }
+
+private:
+  // Bound the footprint for workloads that sweep many shapes.
+  static constexpr size_t kMaxEntries = 4096;
+
+  struct Entry {
+    void *address;
+    CUtensorMap map;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  int64_t hits_{0};
+  int64_t patches_{0};
+  int64_t misses_{0};
+};
+
 struct TensorMapArgs {
   CUtensorMap *map;
   CUtensorMapDataType type;
@@ -76,6 +167,22 @@ struct TensorMapArgs {
     return T;
   }
 
+  // Every encoding parameter except `map` and `globalAddress`.
+  std::string CacheKey() const {
+    std::string key = "tiled";
+    AppendKey(&key, type);
+    AppendKey(&key, tensorRank);
+    AppendKey(&key, globalDim, tensorRank);
+    AppendKey(&key, globalStride, tensorRank);
+    AppendKey(&key, boxDim, tensorRank);
+    AppendKey(&key, elementStrides, tensorRank);
+    AppendKey(&key, interleave);
+    AppendKey(&key, swizzle);
+    AppendKey(&key, l2Promotion);
+    AppendKey(&key, oobFill);
+    return key;
+  }
+
   std::string ToDebugString() {
     std::stringstream ss;
     ss << "TMA Desc Addr:   " << map << '\n'
@@ -101,6 +208,11 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def_packed(
       tl::tvm_tensormap_create_tiled, [](PackedArgs args, Any *ret) {
         TensorMapArgs T = TensorMapArgs::Extract(args);
+        std::string key = T.CacheKey();
+        if (TensorMapCache::Global()->Lookup(key, T.globalAddress, T.map)) {
+          *ret = static_cast<int>(CUDA_SUCCESS);
+          return;
+        }
         CUresult result = cuTensorMapEncodeTiled(
             T.map, T.type, T.tensorRank, T.globalAddress, T.globalDim,
             T.globalStride + 1, T.boxDim, T.elementStrides, T.interleave,
@@ -110,6 +222,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                     << '\n'
                     << T.ToDebugString();
         }
+        TensorMapCache::Global()->Insert(key, T.globalAddress, *T.map);
         *ret = static_cast<int>(result);
       });
 }
@@ -165,6 +278,25 @@ struct TensorMapIm2ColArgs {
     return T;
   }
 
+  // Every encoding parameter except `map` and `globalAddress`.
+  std::string CacheKey() const {
+    std::string key = "im2col";
+    AppendKey(&key, type);
+    AppendKey(&key, tensorRank);
+    AppendKey(&key, globalDim, tensorRank);
+    AppendKey(&key, globalStride, tensorRank);
+    AppendKey(&key, elementStrides, tensorRank);
+    AppendKey(&key, pixelBoxLowerCorner, tensorRank - 2);
+    AppendKey(&key, pixelBoxUpperCorner, tensorRank - 2);
+    AppendKey(&key, smem_box_channel);
+    AppendKey(&key, smem_box_pixel);
+    AppendKey(&key, interleave);
+    AppendKey(&key, swizzle);
+    AppendKey(&key, l2Promotion);
+    AppendKey(&key, oobFill);
+    return key;
+  }
+
   std::string ToDebugString() {
     std::stringstream ss;
     ss << "TMA Desc Addr:   " << map << '\n'
@@ -193,6 +325,11 @@ TVM_FFI_STATIC_INIT_BLOCK() {
   refl::GlobalDef().def_packed(
       tl::tvm_tensormap_create_im2col, [](PackedArgs args, Any *ret) {
         TensorMapIm2ColArgs T = TensorMapIm2ColArgs::Extract(args);
+        std::string key = T.CacheKey();
+        if (TensorMapCache::Global()->Lookup(key, T.globalAddress, T.map)) {
+          *ret = static_cast<int>(CUDA_SUCCESS);
+          return;
+        }
         CUresult result = cuTensorMapEncodeIm2col(
             T.map, T.type, T.tensorRank, T.globalAddress, T.globalDim,
             T.globalStride + 1, T.pixelBoxLowerCorner, T.pixelBoxUpperCorner,
@@ -203,6 +340,7 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                     << '\n'
                     << T.ToDebugString();
         }
+        TensorMapCache::Global()->Insert(key, T.globalAddress, *T.map);
         *ret = static_cast<int>(result);
       });
 }
@@ -262,23 +400,23 @@ TVM_FFI_STATIC_INIT_BLOCK() {
           l2_limit_bytes = static_cast<size_t>(max_persisting);
         }
 
-        // Save current limit to restore later
-        size_t init_persisting_l2_cache_size = 0;
-        result = cuCtxGetLimit(&init_persisting_l2_cache_size,
+        // The set-aside only grows, so steady-state launches leave the
+        // context limit alone. Lines not used by persisting accesses remain
+        // available to normal accesses.
+        size_t persisting_l2_cache_size = 0;
+        result = cuCtxGetLimit(&persisting_l2_cache_size,
                                CU_LIMIT_PERSISTING_L2_CACHE_SIZE);
         if (result != CUDA_SUCCESS) {
           LOG_FATAL << "Failed to get current persisting L2 cache size limit: "
                     << result;
         }
-        __tl_prev_persisting_l2_cache_size = init_persisting_l2_cache_size;
-        __tl_prev_persisting_l2_cache_saved = true;
-
-        // Set new limit
-        result =
-            cuCtxSetLimit(CU_LIMIT_PERSISTING_L2_CACHE_SIZE, l2_limit_bytes);
-        if (result != CUDA_SUCCESS) {
-          LOG_FATAL << "Failed to set persisting L2 cache size limit: "
-                    << result;
+        if (persisting_l2_cache_size < l2_limit_bytes) {
+          result =
+              cuCtxSetLimit(CU_LIMIT_PERSISTING_L2_CACHE_SIZE, l2_limit_bytes);
+          if (result != CUDA_SUCCESS) {
+            LOG_FATAL << "Failed to set persisting L2 cache size limit: "
+                      << result;
+          }
         }
 
         // Apply access policy window to stream
@@ -302,7 +440,10 @@ TVM_FFI_STATIC_INIT_BLOCK() {
         *ret = static_cast<int>(result);
       });
 
-  // Reset stream access policy window and restore the previous L2 cache size
+  // Reset the stream access policy window. This is stream ordered: the
+  // persisting lines are not flushed with cuCtxResetPersistingL2Cache, which
+  // would serialize against the work in flight; they are replaced by the next
+  // window or demoted by normal accesses.
   // Args:
   //  [0]: void* stream (optional, default 0)
   refl::GlobalDef().def_packed(
@@ -326,21 +467,6 @@ TVM_FFI_STATIC_INIT_BLOCK() {
                     << result;
         }
 
-        result = cuCtxResetPersistingL2Cache();
-        if (result != CUDA_SUCCESS) {
-          LOG_FATAL << "Failed to reset persisting L2 cache lines: " << result;
-        }
-
-        if (__tl_prev_persisting_l2_cache_saved) {
-          result = cuCtxSetLimit(CU_LIMIT_PERSISTING_L2_CACHE_SIZE,
-                                 __tl_prev_persisting_l2_cache_size);
-          if (result != CUDA_SUCCESS) {
-            LOG_FATAL << "Failed to restore persisting L2 cache size limit: "
-                      << result;
-          }
-          __tl_prev_persisting_l2_cache_saved = false;
-        }
-
         *ret = static_cast<int>(result);
       });
 }
@@ -15,6 +15,9 @@ constexpr const char *tvm_tensormap_create_tiled =
     "__tvm_tensormap_create_tiled";
 constexpr const char *tvm_tensormap_create_im2col =
     "__tvm_tensormap_create_im2col";
+// Patch only the global address of an already encoded descriptor
+constexpr const char *tvm_tensormap_replace_address =
+    "__tvm_tensormap_replace_address";
 #endif // (CUDA_MAJOR_VERSION >= 12)
 
 // CUDA stream access policy window helpers
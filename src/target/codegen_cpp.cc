@@ -24,6 +24,7 @@
 
 #include <tvm/runtime/module.h>
 #include <tvm/target/codegen.h>
+#include <tvm/tir/stmt_functor.h>
 
 #include <string>
 #include <unordered_set>
@@ -31,6 +32,7 @@
 
 #include "../op/builtin.h"
 #include "../support/ffi_aliases.h"
+#include "../transform/common/attr.h"
 #include "support/str_escape.h"
 #include "target/build_common.h"
 #include "target/source/codegen_params.h"
@@ -164,19 +166,115 @@ void CodeGenTileLangCPP::PrintType(DataType t, std::ostream &os) { // NOLINT(*)
   LOG(FATAL) << "Cannot convert type " << t << " to C type";
 }
 
+void CodeGenTileLangCPP::PrintVecElemLoad(const std::string &vec, DataType t,
+                                          int i,
+                                          std::ostream &os) { // NOLINT(*)
+  os << vec << "[" << i << "]";
+}
+
+void CodeGenTileLangCPP::PrintVecElemStore(const std::string &vec, DataType t,
+                                           int i, const std::string &value) {
+  this->PrintIndent();
+  stream << vec << "[" << i << "] = " << value << ";\n";
+}
+
+void CodeGenTileLangCPP::PrintVecElemLoadExpr(DataType t, int i,
+                                              const std::string &value,
+                                              std::ostream &os) {
+  ICHECK_GT(t.lanes(), 1);
+  if (i == 0) {
+    os << "(";
+    PrintType(t, os);
+    os << "{";
+  }
+  os << value;
+  if (i != t.lanes() - 1) {
+    os << ", ";
+  } else {
+    os << "})";
+  }
+}
+
+std::string CodeGenTileLangCPP::CastFromTo(std::string value, DataType from,
+                                           DataType target) {
+  if (from == target || target.lanes() == 1) {
+    return CodeGenC::CastFromTo(value, from, target);
+  }
+  // A C-style cast between vector extension types reinterprets the bits.
+  std::ostringstream os;
+  os << "__builtin_convertvector(" << value << ", ";
+  PrintType(target, os);
+  os << ")";
+  return os.str();
+}
+
+void CodeGenTileLangCPP::PrintCallExtern(Type ret_type,
+                                         ffi::String global_symbol,
+                                         const ffi::Array<PrimExpr> &args,
+                                         bool skip_first_arg,
+                                         std::ostream &os) { // NOLINT(*)
+  DataType ret_dtype = GetRuntimeDataType(ret_type);
+  if (!ret_dtype.is_fixed_length_vector()) {
+    CodeGenC::PrintCallExtern(ret_type, global_symbol, args, skip_first_arg,
+                              os);
+    return;
+  }
+  // Math functions have no vector overloads, emit one scalar call per lane.
+  std::string sret = name_supply_->FreshName("_");
+  this->PrintIndent();
+  this->PrintType(ret_dtype, stream);
+  stream << ' ' << sret << ";\n";
+  std::vector<std::string> sargs;
+  size_t arg_begin = static_cast<size_t>(skip_first_arg);
+  for (size_t i = arg_begin; i < args.size(); ++i) {
+    sargs.push_back(SSAGetID(PrintExpr(args[i]), args[i].dtype()));
+  }
+  for (int i = 0; i < ret_dtype.lanes(); ++i) {
+    std::ostringstream scall;
+    scall << global_symbol << "(";
+    for (size_t j = 0; j < sargs.size(); ++j) {
+      if (j > 0)
+        scall << ", ";
+      if (args[arg_begin + j].dtype().is_scalar()) {
+        scall << sargs[j];
+      } else {
+        PrintVecElemLoad(sargs[j], args[arg_begin + j].dtype(), i, scall);
+      }
+    }
+    scall << ")";
+    PrintVecElemStore(sret, ret_dtype, i, scall.str());
+  }
+  os << sret;
+}
+
+void CodeGenTileLangCPP::VisitExpr_(const RampNode *op,
+                                    std::ostream &os) { // NOLINT(*)
+  int lanes = op->dtype.lanes();
+  os << "(";
+  PrintType(op->dtype, os);
+  os << "{";
+  for (int i = 0; i < lanes; ++i) {
+    if (i != 0)
+      os << ", ";
+    os << "(" << PrintExpr(op->base) << ")+(" << PrintExpr(op->stride) << "*"
+       << i << ")";
+  }
+  os << "})";
+}
+
 void CodeGenTileLangCPP::VisitExpr_(const BroadcastNode *op,
                                     std::ostream &os) { // NOLINT(*)
   std::string v = PrintExpr(op->value);
   int lanes = op->dtype.lanes();
-  os << "((";
+  os << "(";
   PrintType(op->dtype, os);
-  os << ")(";
+  os << "{";
   for (int i = 0; i < lanes; ++i) {
     if (i != 0)
       os << ", ";
     os << v;
   }
-  os << "))";
+  os << "})";
 }
 
 void CodeGenTileLangCPP::PrintGetFuncFromBackend(
@@ -256,6 +354,15 @@ void CodeGenTileLangCPP::AddFunction(const PrimFunc &f) {
   this->InitFuncState(f);
   // reserve keywords
   ReserveKeywordsAsUnique();
+  // Plan the scratch arena of the function: every allocation that does not
+  // stay on the stack gets its own cache-line aligned slot.
+  scratch_bytes_ = 0;
+  scratch_offset_ = 0;
+  PostOrderVisit(f->body, [&](const ObjectRef &obj) {
+    if (const auto *alloc = obj.as<AllocateNode>()) {
+      scratch_bytes_ += GetScratchBytes(alloc);
+    }
+  });
 
   auto global_symbol = f->GetAttr<ffi::String>(tvm::attr::kGlobalSymbol);
   ICHECK(global_symbol)
@@ -415,6 +522,13 @@ void CodeGenTileLangCPP::VisitExpr_(const CallNode *op,
   } else if (op->op.same_as(builtin::tvm_throw_last_error())) {
     this->PrintIndent();
     this->stream << "return -1;\n";
+  } else if (op->op.same_as(tl::tl_gemm())) {
+    ICHECK(op->args.size() == 4) << "tl_gemm expects 4 arguments <op_instance, "
+                                    "A_ptr, B_ptr, C_ptr>, but got "
+                                 << op->args.size();
+    auto op_instance = Downcast<StringImm>(op->args[0]);
+    this->PrintCallExtern(GetType(tvm::ffi::GetRef<PrimExpr>(op)),
+                          op_instance->value, op->args, true, os);
   } else {
     CodeGenC::VisitExpr_(op, os);
   }
@@ -450,12 +564,62 @@ void CodeGenTileLangCPP::VisitStmt_(const AllocateNode *op) {
   ICHECK_GT(constant_size, 0)
       << "Can only handle constant size stack allocation for now";
 
-  stream << ' ' << vid << '[' << constant_size << "];\n";
+  size_t scratch_bytes = GetScratchBytes(op);
+  if (scratch_bytes == 0) {
+    stream << ' ' << vid << '[' << constant_size << "];\n";
+  } else {
+    // Carve the buffer out of the per-thread arena, which the generated code
+    // reuses across launches instead of growing the stack on every call.
+    ICHECK_LE(scratch_offset_ + scratch_bytes, scratch_bytes_);
+    stream << "* __restrict__ " << vid << " = reinterpret_cast<";
+    PrintType(op->dtype, stream);
+    stream << "*>(tl::cpu_scratch_arena(" << scratch_bytes_ << ") + "
+           << scratch_offset_ << ");\n";
+    scratch_offset_ += scratch_bytes;
+  }
 
   RegisterHandleType(op->buffer_var.get(), op->dtype);
   this->PrintStmt(op->body);
 }
 
+size_t CodeGenTileLangCPP::GetScratchBytes(const AllocateNode *op) {
+  // Buffers up to a cache line are left on the stack, where the host
+  // compiler can still promote them to registers.
+  constexpr size_t kCacheLine = 64;
+  size_t bytes = op->ConstantAllocationSize() * op->dtype.bytes();
+  if (bytes <= kCacheLine) {
+    return 0;
+  }
+  return (bytes + kCacheLine - 1) / kCacheLine * kCacheLine;
+}
+
+void CodeGenTileLangCPP::VisitStmt_(const ForNode *op) {
+  if (!parallel_grid_ || in_parallel_grid_ ||
+      !op->annotations.count(tl::tilelang_cpu_grid_loop)) {
+    CodeGenC::VisitStmt_(op);
+    return;
+  }
+  // Collapse the directly nested block loops of the kernel frame into a
+  // single iteration space, which dynamic scheduling hands out to the
+  // workers. proc_bind(spread) pins the workers across OMP_PLACES, e.g.
+  // OMP_PLACES=cores, so that they spread over the NUMA nodes.
+  int depth = 1;
+  const ForNode *inner = op->body.as<ForNode>();
+  while (inner && inner->annotations.count(tl::tilelang_cpu_grid_loop)) {
+    ++depth;
+    inner = inner->body.as<ForNode>();
+  }
+  PrintIndent();
+  stream << "#pragma omp parallel for schedule(dynamic) proc_bind(spread)";
+  if (depth > 1) {
+    stream << " collapse(" << depth << ")";
+  }
+  stream << "\n";
+  in_parallel_grid_ = true;
+  CodeGenC::VisitStmt_(op);
+  in_parallel_grid_ = false;
+}
+
 void CodeGenTileLangCPP::VisitExpr_(const MinNode *op,
                                     std::ostream &os) { // NOLINT(*)
   PrintTernaryCondExpr(op, "<", os);
@@ -61,8 +61,21 @@ public:
   using CodeGenC::PrintType;
   void PrintType(DataType t, std::ostream &os) final; // NOLINT(*)
   void PrintFuncPrefix(std::ostream &os) final;       // NOLINT(*)
+  // vector types are GCC/Clang vector extensions, see tl_templates/cpp/common.h
+  void PrintVecElemLoad(const std::string &vec, DataType t, int i,
+                        std::ostream &os) final; // NOLINT(*)
+  void PrintVecElemStore(const std::string &vec, DataType t, int i,
+                         const std::string &value) final;
+  void PrintVecElemLoadExpr(DataType t, int i, const std::string &value,
+                            std::ostream &os) final;
+  std::string CastFromTo(std::string value, DataType from,
+                         DataType target) final;
+  void PrintCallExtern(Type ret_type, ffi::String global_symbol,
+                       const ffi::Array<PrimExpr> &args, bool skip_first_arg,
+                       std::ostream &os) final; // NOLINT(*)
 
   // overload visitor functions
+  void VisitExpr_(const RampNode *op, std::ostream &os) final;      // NOLINT(*)
   void VisitExpr_(const BroadcastNode *op, std::ostream &os) final; // NOLINT(*)
   void VisitExpr_(const CallNode *op, std::ostream &os) override;   // NOLINT(*)
   // overload min and max to use the ternary operator, so we don't rely on the
@@ -72,6 +85,13 @@ public:
 
   void VisitStmt_(const AssertStmtNode *op) final; // NOLINT(*)
   void VisitStmt_(const AllocateNode *op) final;   // NOLINT(*)
+  void VisitStmt_(const ForNode *op) final;        // NOLINT(*)
+
+  /*!
+   * \brief Run the block loops of CPU kernel frames on an OpenMP thread team.
+   * The generated source must then be compiled with -fopenmp.
+   */
+  void SetParallelGrid(bool parallel_grid) { parallel_grid_ = parallel_grid; }
 
   void GenerateForwardFunctionDeclarations(ffi::String global_symbol,
                                            const ffi::Array<Type> &arg_types,
@@ -98,6 +118,20 @@ private:
   /*! \brief whether to emit forward function declarations in the resulting C
    * code */
   bool emit_fwd_func_decl_;
+  /*! \brief bytes of the scratch arena planned for the current function */
+  size_t scratch_bytes_{0};
+  /*! \brief offset of the next allocation in the scratch arena */
+  size_t scratch_offset_{0};
+  /*! \brief whether to parallelize the block loops of CPU kernel frames */
+  bool parallel_grid_{false};
+  /*! \brief whether the printer is inside a parallelized block loop nest */
+  bool in_parallel_grid_{false};
+
+  /*!
+   * \brief Bytes an allocation takes in the scratch arena, rounded up to a
+   * cache line, or 0 if it stays on the stack.
+   */
+  static size_t GetScratchBytes(const AllocateNode *op);
 
   FunctionInfo GetFunctionInfo(const CallNode *op, bool has_resource_handle);
   std::string GetPackedName(const CallNode *op);
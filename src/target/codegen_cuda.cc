@@ -5,8 +5,10 @@
 #include "codegen_cuda.h"
 #include <tvm/arith/analyzer.h>
 #include <tvm/ffi/function.h>
+#include <tvm/ir/transform.h>
 #include <tvm/tir/index_map.h>
 #include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
 
 #include <cmath>
 #include <string>
@@ -207,6 +209,14 @@ std::string GetTileLangFP4Type(DataType type) {
   return stream.str();
 }
 
+// Number of CTAs a tcgen05 Call runs across, 2 for the Calls of 2-CTA gemms.
+static int GetTcgen05CtaGroup(const CallNode *op) {
+  if (auto cta_group = op->annotations.Get(tl::attr::kCtaGroup)) {
+    return Downcast<Integer>(cta_group.value())->value;
+  }
+  return 1;
+}
+
 CodeGenTileLangCUDA::CodeGenTileLangCUDA() {
   restrict_keyword_ = "__restrict__";
   vid_global_barrier_state_ =
@@ -214,6 +224,22 @@ CodeGenTileLangCUDA::CodeGenTileLangCUDA() {
   vid_global_barrier_expect_ = name_supply_->FreshName("__barrier_expect");
   ICHECK_EQ(vid_global_barrier_state_,
             runtime::symbol::tvm_global_barrier_state);
+  enable_profile_region_ = tvm::transform::PassContext::Current()
+                               ->GetConfig<Bool>(tl::kEnableProfileRegion,
+                                                 Bool(false))
+                               .value();
+  enable_device_log_ =
+      tvm::transform::PassContext::Current()
+          ->GetConfig<Bool>(tl::kEnableDeviceLog, Bool(false))
+          .value();
+  device_assert_mode_ =
+      tvm::transform::PassContext::Current()
+          ->GetConfig<String>(tl::kDeviceAssertMode, String("thread"))
+          .value();
+  ICHECK(device_assert_mode_ == "thread" || device_assert_mode_ == "warp" ||
+         device_assert_mode_ == "off")
+      << "Unknown " << tl::kDeviceAssertMode << " " << device_assert_mode_
+      << ", expected thread, warp or off";
 }
 
 void CodeGenTileLangCUDA::ReserveKeywordsAsUnique_() {
@@ -417,6 +443,14 @@ private:
                  iv->thread_tag == "threadIdx.z") {
         threadIdx_z_ext = op->value;
       }
+    } else if (op->attr_key == tl::attr::kClusterDims) {
+      if (const auto *dims = op->value.as<StringImmNode>()) {
+        cluster_dims = dims->value;
+      }
+    } else if (op->attr_key == tl::attr::kMinBlocksPerSM) {
+      if (const auto *blocks = op->value.as<IntImmNode>()) {
+        min_blocks_per_sm = std::max<int64_t>(blocks->value, 1);
+      }
     }
     StmtVisitor::VisitStmt_(op);
   }
@@ -425,11 +459,16 @@ public:
   PrimExpr threadIdx_x_ext = Integer(1);
   PrimExpr threadIdx_y_ext = Integer(1);
   PrimExpr threadIdx_z_ext = Integer(1);
+  std::string cluster_dims;
+  int64_t min_blocks_per_sm = 1;
 };
 
 void CodeGenTileLangCUDA::PrintExtraAttrs(const PrimFunc &f) {
   LaunchConfigExtractor extractor;
   extractor(f->body);
+  if (!extractor.cluster_dims.empty()) {
+    stream << " __cluster_dims__(" << extractor.cluster_dims << ")";
+  }
   arith::Analyzer analyzer;
   PrimExpr threadIdx_ext =
       analyzer.Simplify(extractor.threadIdx_x_ext * extractor.threadIdx_y_ext *
@@ -441,7 +480,8 @@ void CodeGenTileLangCUDA::PrintExtraAttrs(const PrimFunc &f) {
       // return
       return;
     }
-    stream << " __launch_bounds__(" << threadIdx_ext_int->value << ", 1)";
+    stream << " __launch_bounds__(" << threadIdx_ext_int->value << ", "
+           << extractor.min_blocks_per_sm << ")";
   }
 }
 
@@ -489,9 +529,19 @@ std::string CodeGenTileLangCUDA::Finish() {
   }
   decl_stream << "#include <tl_templates/cuda/copy.h>\n";
   decl_stream << "#include <tl_templates/cuda/reduce.h>\n";
+  decl_stream << "#include <tl_templates/cuda/dequantize.h>\n";
   decl_stream << "#include <tl_templates/cuda/ldsm.h>\n";
   decl_stream << "#include <tl_templates/cuda/threadblock_swizzle.h>\n";
   decl_stream << "#include <tl_templates/cuda/debug.h>\n";
+  if (need_symm_h_) {
+    decl_stream << "#include <tl_templates/cuda/symm.h>\n";
+  }
+  if (need_fast_math_h_) {
+    decl_stream << "#include <tl_templates/cuda/fast_math.h>\n";
+  }
+  if (need_random_h_) {
+    decl_stream << "#include <tl_templates/cuda/random.h>\n";
+  }
   decl_stream << "#ifdef ENABLE_BF16\n";
   decl_stream << "#include <tl_templates/cuda/cuda_bf16_fallbacks.cuh>\n";
   decl_stream << "#endif\n";
@@ -818,9 +868,35 @@ void CodeGenTileLangCUDA::PrintType(DataType t, std::ostream &os) { // NOLINT(*)
   LOG(FATAL) << "Cannot convert type " << t << " to CUDA type";
 }
 
+/*!
+ * \brief The cuda_fp16.h / cuda_bf16.h intrinsic computing a binary operator
+ * of the code generator on a pair of halves, nullptr when there is none.
+ */
+static const char *GetPackedHalfOp(const std::string &op) {
+  if (op == "+")
+    return "__hadd2";
+  if (op == "-")
+    return "__hsub2";
+  if (op == "*")
+    return "__hmul2";
+  if (op == "/")
+    return "__h2div";
+  if (op == "min")
+    return "__hmin2";
+  if (op == "max")
+    return "__hmax2";
+  return nullptr;
+}
+
 void CodeGenTileLangCUDA::PrintVecBinaryOp(const std::string &op, DataType t,
                                            PrimExpr lhs, PrimExpr rhs,
                                            std::ostream &os) { // NOLINT(*)
+  const char *packed_op = GetPackedHalfOp(op);
+  if ((t.is_float16() || t.is_bfloat16()) && t.lanes() % 2 == 0 &&
+      packed_op != nullptr && lhs.dtype() == t && rhs.dtype() == t) {
+    PrintPackedHalfBinaryOp(packed_op, t, lhs, rhs, os);
+    return;
+  }
   // Declare the result.
   std::string sret = name_supply_->FreshName("_");
   this->PrintIndent();
@@ -854,6 +930,100 @@ void CodeGenTileLangCUDA::PrintVecBinaryOp(const std::string &op, DataType t,
   os << sret;
 }
 
+void CodeGenTileLangCUDA::PrintPackedHalfBinaryOp(const char *op, DataType t,
+                                                  PrimExpr lhs, PrimExpr rhs,
+                                                  std::ostream &os) {
+  // a * b + c of halves is fused into __hfma2, as nvcc contracts the scalar
+  // form. The vectors of halves are stored with their lanes contiguous,
+  // which makes lane pair i the i-th half2 / nv_bfloat162 of the vector.
+  std::string pair_type = t.is_float16() ? "half2" : "nv_bfloat162";
+  const MulNode *mul = nullptr;
+  PrimExpr addend;
+  if (std::string(op) == "__hadd2") {
+    if ((mul = lhs.as<MulNode>()) != nullptr) {
+      addend = rhs;
+    } else if ((mul = rhs.as<MulNode>()) != nullptr) {
+      addend = lhs;
+    }
+  }
+  std::string sret = name_supply_->FreshName("_");
+  this->PrintIndent();
+  this->PrintType(t, stream);
+  stream << ' ' << sret << ";\n";
+  int ssa_scope = BeginScope();
+  {
+    std::vector<std::string> operands;
+    if (mul != nullptr) {
+      op = "__hfma2";
+      for (const PrimExpr &operand : {mul->a, mul->b, addend})
+        operands.push_back(SSAGetID(PrintExpr(operand), t));
+    } else {
+      operands.push_back(SSAGetID(PrintExpr(lhs), t));
+      operands.push_back(SSAGetID(PrintExpr(rhs), t));
+    }
+    auto pair = [&](const std::string &vec, int i) {
+      return "((" + pair_type + "*)(&" + vec + "))[" + std::to_string(i) +
+             "]";
+    };
+    for (int i = 0; i < t.lanes() / 2; ++i) {
+      this->PrintIndent();
+      stream << pair(sret, i) << " = " << op << "(";
+      for (size_t j = 0; j < operands.size(); ++j)
+        stream << (j == 0 ? "" : ", ") << pair(operands[j], i);
+      stream << ");\n";
+    }
+  }
+  EndScope(ssa_scope);
+  os << sret;
+}
+
+void CodeGenTileLangCUDA::PrintPhiloxRand(const CallNode *op,
+                                          std::ostream &os) { // NOLINT(*)
+  DataType t = op->dtype;
+  if (t.is_scalar()) {
+    os << "tl::philox_rand(" << PrintExpr(op->args[0]) << ", "
+       << PrintExpr(op->args[1]) << ", " << PrintExpr(op->args[2]) << ")";
+    return;
+  }
+  std::string sret = name_supply_->FreshName("_");
+  this->PrintIndent();
+  this->PrintType(t, stream);
+  stream << ' ' << sret << ";\n";
+  int ssa_scope = BeginScope();
+  const auto *seed = op->args[0].as<BroadcastNode>();
+  const auto *offset = op->args[1].as<BroadcastNode>();
+  const auto *ramp = op->args[2].as<RampNode>();
+  if (t.lanes() % 4 == 0 && seed && offset && ramp && is_one(ramp->stride)) {
+    // Consecutive indices: one Philox call per 4 lanes
+    std::string vseed = SSAGetID(PrintExpr(seed->value), seed->value.dtype());
+    std::string voffset =
+        SSAGetID(PrintExpr(offset->value), offset->value.dtype());
+    std::string vbase = SSAGetID(PrintExpr(ramp->base), ramp->base.dtype());
+    for (int i = 0; i < t.lanes() / 4; ++i) {
+      this->PrintIndent();
+      stream << "((uint4*)(&" << sret << "))[" << i << "] = tl::philox_rand4("
+             << vseed << ", " << voffset << ", " << vbase << " + " << i * 4
+             << ");\n";
+    }
+  } else {
+    std::vector<std::string> args;
+    for (const PrimExpr &arg : op->args)
+      args.push_back(SSAGetID(PrintExpr(arg), arg.dtype()));
+    for (int i = 0; i < t.lanes(); ++i) {
+      std::ostringstream value;
+      value << "tl::philox_rand(";
+      for (size_t j = 0; j < args.size(); ++j) {
+        value << (j == 0 ? "" : ", ");
+        PrintVecElemLoad(args[j], op->args[j].dtype(), i, value);
+      }
+      value << ")";
+      PrintVecElemStore(sret, t, i, value.str());
+    }
+  }
+  EndScope(ssa_scope);
+  os << sret;
+}
+
 void CodeGenTileLangCUDA::PrintVecElemLoad(const std::string &vec, DataType t,
                                            int i,
                                            std::ostream &os) { // NOLINT(*)
@@ -1547,6 +1717,14 @@ std::string CodeGenTileLangCUDA::GetVecLoad(DataType t,
     scope = GetPtrStorageScope(buffer->data);
   }
 
+  if (scope == "global" && t.bits() * t.lanes() <= 128) {
+    if (int hint = GetCacheHint(buffer_var)) {
+      std::ostringstream os;
+      os << "tl::ld_global_hint<" << hint << ">(&("
+         << this->GetBufferRef(t, buffer, base) << "))";
+      return os.str();
+    }
+  }
   if (scope != "global" || t.bits() * t.lanes() <= 128) {
     return this->CodeGenC::GetVecLoad(t, buffer, base);
   }
@@ -1570,6 +1748,15 @@ void CodeGenTileLangCUDA::PrintVecStore(const BufferNode *buffer, DataType t,
     scope = GetPtrStorageScope(buffer->data);
   }
 
+  if (scope == "global" && t.bits() * t.lanes() <= 128) {
+    if (int hint = GetCacheHint(buffer_var)) {
+      auto buffer_ref = this->GetBufferRef(t, buffer, base);
+      this->PrintIndent();
+      this->stream << "tl::st_global_hint<" << hint << ">(&(" << buffer_ref
+                   << "), " << value << ");\n";
+      return;
+    }
+  }
   if (scope != "global" || t.bits() * t.lanes() <= 128) {
     this->CodeGenC::PrintVecStore(buffer, t, base, value);
     return;
@@ -1656,15 +1843,20 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     std::string src = this->PrintExpr(op->args[1]);
     std::string size = this->PrintExpr(op->args[2]);
 
+    std::string tparams = size;
+    if (int hint = GetCacheHint(op->args[1])) {
+      tparams += ", " + std::to_string(hint);
+    }
+
     this->PrintIndent();
     if (op->args.size() == 3) {
       // Non-predicated version
-      this->stream << "tl::cp_async_gs<" << size << ">(" << dst << ", " << src
-                   << ");\n";
+      this->stream << "tl::cp_async_gs<" << tparams << ">(" << dst << ", "
+                   << src << ");\n";
     } else {
       // Predicated version
       std::string condition = this->PrintExpr(op->args[3]);
-      this->stream << "tl::cp_async_gs_conditional<" << size << ">(" << dst
+      this->stream << "tl::cp_async_gs_conditional<" << tparams << ">(" << dst
                    << ", " << src << ", " << condition << ");\n";
     }
   } else if (op->op.same_as(tl::ptx_cp_async())) {
@@ -1678,15 +1870,20 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     std::string src = this->PrintExpr(op->args[1]);
     std::string size = this->PrintExpr(op->args[2]);
 
+    std::string tparams = size;
+    if (int hint = GetCacheHint(op->args[1])) {
+      tparams += ", " + std::to_string(hint);
+    }
+
     this->PrintIndent();
     if (op->args.size() == 3) {
       // Non-predicated version
-      this->stream << "tl::cp_async_gs<" << size << ">(" << dst << ", " << src
-                   << ");\n";
+      this->stream << "tl::cp_async_gs<" << tparams << ">(" << dst << ", "
+                   << src << ");\n";
     } else {
       // Predicated version
       std::string condition = this->PrintExpr(op->args[3]);
-      this->stream << "tl::cp_async_gs_conditional<" << size << ">(" << dst
+      this->stream << "tl::cp_async_gs_conditional<" << tparams << ">(" << dst
                    << ", " << src << ", " << condition << ");\n";
     }
   } else if (op->op.same_as(builtin::ptx_commit_group())) {
@@ -1708,6 +1905,18 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     ICHECK_EQ(op->args.size(), 1);
     std::string barrier_id = this->PrintExpr(op->args[0]);
     os << mbarrier_name_ + "[" + barrier_id + "]";
+  } else if (op->op.same_as(tl::tma_descriptor_replace_address())) {
+    ICHECK(op->args.size() == 3 || op->args.size() % 2 == 0)
+        << "tma_descriptor_replace_address expects the address and optionally "
+           "rank extents and rank - 1 strides, got "
+        << op->args;
+    os << "tl::tma_descriptor_replace_address(";
+    for (size_t i = 0; i < op->args.size(); i++) {
+      if (i > 0)
+        os << ", ";
+      os << this->PrintExpr(op->args[i]);
+    }
+    os << ")";
   } else if (op->op.same_as(builtin::ptx_arrive_barrier())) {
     if (op->args.size() == 1) {
       this->PrintIndent();
@@ -1770,22 +1979,64 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     auto phase = this->PrintExpr(op->args[1]);
     this->stream << mbarrier_obj << ".wait(" << phase << ");\n";
   } else if (op->op.same_as(tl::ptx_init_tensor_memory())) {
-    print_extern_call_stmt("tl::tmem_allocate");
+    print_extern_call_stmt(GetTcgen05CtaGroup(op) == 2 ? "tl::tmem_allocate_2cta"
+                                                       : "tl::tmem_allocate");
   } else if (op->op.same_as(tl::ptx_deallocate_tensor_memory())) {
-    print_extern_call_stmt("tl::tmem_deallocate");
+    print_extern_call_stmt(GetTcgen05CtaGroup(op) == 2
+                               ? "tl::tmem_deallocate_2cta"
+                               : "tl::tmem_deallocate");
   } else if (op->op.same_as(tl::no_set_max_nreg())) {
     return;
+  } else if (op->op.same_as(tl::tma_load()) &&
+             op->annotations.count(tl::attr::kMulticastMask)) {
+    // Every CTA of the mask arrives on its own mbarrier with the full
+    // transaction bytes, the lowest rank alone issues the load for all.
+    std::ostringstream ss;
+    ICHECK_GE(op->args.size(), 4);
+    PrimExpr mask = Downcast<PrimExpr>(
+        op->annotations.Get(tl::attr::kMulticastMask).value());
+    std::string mask_str = "((uint16_t)" + this->PrintExpr(mask) + ")";
+    ss << "if (tl::is_multicast_leader(" << mask_str << ")) ";
+    bool is_1d_tma_load = op->args[0].as<CallNode>() != nullptr;
+    if (is_1d_tma_load) {
+      ss << "tl::tma_load_multicast(" << this->PrintExpr(op->args[0]) << ", "
+         << this->PrintExpr(op->args[1]) << ", "
+         << print_mbarrier_obj(op->args[2]) << ", "
+         << this->PrintExpr(op->args[3]) << ", " << mask_str << ");\n";
+    } else {
+      auto eviction_policy =
+          this->eviction_policy_names_
+              [op->args[op->args.size() - 1].as<IntImmNode>()->value];
+      if (eviction_policy != "EVICT_NORMAL") {
+        ss << "tl::tma_load_multicast<tl::CacheHintSm90::" << eviction_policy
+           << ">(";
+      } else {
+        ss << "tl::tma_load_multicast(";
+      }
+      ss << this->PrintExpr(op->args[0]) << ", "
+         << print_mbarrier_obj(op->args[1]) << ", "
+         << this->PrintExpr(op->args[2]) << ", " << mask_str;
+      for (size_t i = 3; i < op->args.size() - 1; i++) {
+        ss << ", " << this->PrintExpr(op->args[i]);
+      }
+      ss << ");\n";
+    }
+    this->PrintIndent();
+    this->stream << ss.str();
   } else if (op->op.same_as(tl::tma_load())) {
     std::ostringstream ss;
     ICHECK_GE(op->args.size(), 2);
     auto eviction_policy =
         this->eviction_policy_names_
             [op->args[op->args.size() - 1].as<IntImmNode>()->value];
+    std::string func_name = op->annotations.count(tl::attr::kTMAGather4)
+                                ? "tl::tma_load_gather4"
+                                : "tl::tma_load";
     // Simplify the code by using the default eviction policy
     if (eviction_policy != "EVICT_NORMAL") {
-      ss << "tl::tma_load<tl::CacheHintSm90::" << eviction_policy << ">(";
+      ss << func_name << "<tl::CacheHintSm90::" << eviction_policy << ">(";
     } else {
-      ss << "tl::tma_load(";
+      ss << func_name << "(";
     }
     auto desc = op->args[0];
     ss << this->PrintExpr(desc) << ", ";
@@ -1825,6 +2076,12 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
       ss << "tl::tma_store";
     }
     print_extern_call_stmt(ss.str(), 0, 2);
+  } else if (op->op.same_as(tl::tma_prefetch())) {
+    print_extern_call_stmt("tl::tma_prefetch");
+  } else if (op->op.same_as(tl::bulk_prefetch_l2())) {
+    print_extern_call_stmt("tl::bulk_prefetch_l2");
+  } else if (op->op.same_as(tl::prefetch_l2())) {
+    print_extern_call_stmt("tl::prefetch_l2");
   } else if (op->op.same_as(tl::ptx_ldmatrix())) {
     int trans = Downcast<IntImm>(op->args[0])->value;
     int num = Downcast<IntImm>(op->args[1])->value;
@@ -1839,12 +2096,19 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     if (trans == 1)
       func_name += "_trans";
     print_extern_call_stmt(func_name, 2);
+  } else if (op->op.same_as(tl::bulk_copy_g2g())) {
+    int64_t chunk = Downcast<IntImm>(op->args[4])->value;
+    print_extern_call_stmt("tl::bulk_copy_g2g<" + std::to_string(chunk) + ">",
+                           0, 1);
   } else if (op->op.same_as(tl::fence_proxy_async())) {
     print_extern_call_stmt("tl::fence_proxy_async");
   } else if (op->op.same_as(tl::tma_store_arrive())) {
     print_extern_call_stmt("tl::tma_store_arrive");
   } else if (op->op.same_as(tl::tma_store_wait())) {
-    print_extern_call_stmt("tl::tma_store_wait<0>");
+    int64_t count =
+        op->args.empty() ? 0 : Downcast<IntImm>(op->args[0])->value;
+    this->PrintIndent();
+    this->stream << "tl::tma_store_wait<" << count << ">();\n";
   } else if (op->op.same_as(tl::warpgroup_arrive())) {
     print_extern_call_stmt("tl::warpgroup_arrive");
   } else if (op->op.same_as(tl::warpgroup_commit_batch())) {
@@ -1881,6 +2145,12 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     this->PrintIndent();
     int num_mma = Downcast<IntImm>(op->args[0])->value;
     this->stream << "tl::wait_wgmma<" << std::to_string(num_mma) << ">();\n";
+  } else if (op->op.same_as(tl::named_barrier_sync())) {
+    os << "tl::named_barrier_sync(" << PrintExpr(op->args[0]) << ", "
+       << PrintExpr(op->args[1]) << ")";
+  } else if (op->op.same_as(tl::named_barrier_arrive())) {
+    os << "tl::named_barrier_arrive(" << PrintExpr(op->args[0]) << ", "
+       << PrintExpr(op->args[1]) << ")";
   } else if (op->op.same_as(tl::pack_b16())) {
     os << "__pack_half2(" << this->PrintExpr(op->args[0]) << ", "
        << this->PrintExpr(op->args[1]) << ")";
@@ -1888,6 +2158,11 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     this->need_cooperative_groups_ = true;
     this->PrintIndent();
     this->stream << "cooperative_groups::this_grid().sync();\n";
+  } else if (op->op.same_as(tl::cluster_rank())) {
+    os << "tl::cluster_ctarank()";
+  } else if (op->op.same_as(tl::cluster_sync())) {
+    this->PrintIndent();
+    this->stream << "tl::cluster_sync();\n";
   } else if (op->op.same_as(tl::sync_warp())) {
     this->PrintIndent();
     this->stream << "__syncwarp(";
@@ -1904,6 +2179,24 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
   } else if (op->op.same_as(tl::loop_break())) {
     this->PrintIndent();
     this->stream << "break;\n";
+  } else if (op->op.same_as(tl::symm_remote_ptr())) {
+    need_symm_h_ = true;
+    os << "tl::symm_remote_ptr(" << PrintExpr(op->args[0]) << ", "
+       << PrintExpr(op->args[1]) << ")";
+  } else if (op->op.same_as(tl::symm_signal()) ||
+             op->op.same_as(tl::symm_wait())) {
+    need_symm_h_ = true;
+    ICHECK(op->args.size() == 4U || op->args.size() == 6U);
+    this->PrintIndent();
+    this->stream << (op->op.same_as(tl::symm_signal()) ? "tl::symm_signal"
+                                                        : "tl::symm_wait");
+    if (op->args.size() == 6U) {
+      this->stream << "<" << PrintExpr(op->args[4]) << ", "
+                   << PrintExpr(op->args[5]) << ">";
+    }
+    this->stream << "(" << PrintExpr(op->args[0]) << ", "
+                 << PrintExpr(op->args[1]) << ", " << PrintExpr(op->args[2])
+                 << ", " << PrintExpr(op->args[3]) << ");\n";
   } else if (op->op.same_as(builtin::tvm_fill_fragment())) {
     need_mma_h_ = true;
     ICHECK_EQ(op->args.size(), 6U);
@@ -2109,6 +2402,44 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     replacer.register_rule("(C_ptr)", c_ref);
     replacer.register_rule("(C_offset)", c_bias);
     this->stream << replacer.rewrite(mma_call);
+  } else if (op->op.same_as(tl::ptx_mma_blockscaled())) {
+    // arg 0: A precision: e4m3, e5m2
+    // arg 1: B precision: e4m3, e5m2
+    // arg 2: A multiplicand
+    // arg 3: A multiplicand index
+    // arg 4: B multiplicand
+    // arg 5: B multiplicand index
+    // arg 6: C accumulator
+    // arg 7: C accumulator index
+    // arg 8: scale factor of A
+    // arg 9: scale factor of B
+    ICHECK_EQ(op->args.size(), 10U);
+    auto dtype_a_enum = tl::codegen::ptx::DTypeFromString(
+        Downcast<StringImm>(op->args[0])->value);
+    auto dtype_b_enum = tl::codegen::ptx::DTypeFromString(
+        Downcast<StringImm>(op->args[1])->value);
+
+    need_mma_instruction_h_ = true;
+    this->PrintIndent();
+    std::string mma_call =
+        "tl::mma_sync_blockscaled<(AType), (BType)>(reinterpret_cast<float*>("
+        "(C_ptr) + (C_offset)), reinterpret_cast<const unsigned*>((A_ptr) + "
+        "(A_offset)), reinterpret_cast<const unsigned*>((B_ptr) + "
+        "(B_offset)), (unsigned)(SFA), (unsigned)(SFB));\n";
+    tl::codegen::Replacer replacer;
+    replacer.register_rule("(AType)",
+                           tl::codegen::ptx::DTypeEnumToString(dtype_a_enum));
+    replacer.register_rule("(BType)",
+                           tl::codegen::ptx::DTypeEnumToString(dtype_b_enum));
+    replacer.register_rule("(A_ptr)", this->PrintExpr(op->args[2]));
+    replacer.register_rule("(A_offset)", this->PrintExpr(op->args[3]));
+    replacer.register_rule("(B_ptr)", this->PrintExpr(op->args[4]));
+    replacer.register_rule("(B_offset)", this->PrintExpr(op->args[5]));
+    replacer.register_rule("(C_ptr)", this->PrintExpr(op->args[6]));
+    replacer.register_rule("(C_offset)", this->PrintExpr(op->args[7]));
+    replacer.register_rule("(SFA)", this->PrintExpr(op->args[8]));
+    replacer.register_rule("(SFB)", this->PrintExpr(op->args[9]));
+    this->stream << replacer.rewrite(mma_call);
   } else if (op->op.same_as(builtin::ptx_mma_sp())) {
     // arg 0: shape: mXnXkX
     // arg 1: A layout: row/col
@@ -2310,6 +2641,9 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     std::string mask2 = this->PrintExpr(op->args[11]);
     std::string mask3 = this->PrintExpr(op->args[12]);
     bool enable_ws = Downcast<Bool>(op->args[13])->value;
+    bool enable_2cta = GetTcgen05CtaGroup(op) == 2;
+    ICHECK(!(enable_ws && enable_2cta))
+        << "tcgen05.mma.ws has no 2-CTA variant";
 
     auto dtype_c_enum = tl::codegen::ptx::DTypeFromString(C_dtype);
 
@@ -2331,7 +2665,9 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     replacer.register_rule("(C)", c_ref);
     replacer.register_rule("(C_offset)", c_offset);
     replacer.register_rule("(tcgen05_name)",
-                           enable_ws ? "tcgen05mma_ws_ss" : "tcgen05mma_ss");
+                           enable_ws     ? "tcgen05mma_ws_ss"
+                           : enable_2cta ? "tcgen05mma_2cta_ss"
+                                         : "tcgen05mma_ss");
     replacer.register_rule("(scale_out)", scale_out);
     replacer.register_rule("(desc_val)", this->PrintExpr(desc_expr));
     replacer.register_rule("(mask0)", mask0);
@@ -2386,12 +2722,60 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     replacer.register_rule("(mask3)", mask3);
     tcgen05_call = replacer.rewrite(tcgen05_call);
     this->stream << tcgen05_call;
+  } else if (op->op.same_as(tl::ptx_tcgen05_mma_blockscaled_ss())) {
+    ICHECK_EQ(op->args.size(), 14U)
+        << "ptx_tcgen05_mma_blockscaled_ss args is " << op->args;
+    std::string kind = Downcast<StringImm>(op->args[0])->value;
+    int scale_vec = Downcast<IntImm>(op->args[1])->value;
+    ICHECK((kind == "mxf8f6f4" && scale_vec == 1) ||
+           (kind == "mxf4nvf4" && (scale_vec == 2 || scale_vec == 4)))
+        << "Unsupported block scaled tcgen05.mma: kind::" << kind
+        << " with scale_vec::" << scale_vec << "X";
+
+    need_tcgen05mma_instruction_h_ = true;
+    this->PrintIndent();
+    std::string tcgen05_call =
+        "tl::tcgen05mma_(kind)_ss<(scale_vec)>(uint64_t((desc_a) + "
+        "(A_offset)), uint64_t((desc_b) + (B_offset)), "
+        "(*reinterpret_cast<uint32_t*>((C))) + (C_offset), "
+        "(*reinterpret_cast<uint32_t*>((SFA))) + (SFA_offset), "
+        "(*reinterpret_cast<uint32_t*>((SFB))) + (SFB_offset), (scale_out), "
+        "static_cast<uint32_t>((desc_val)));\n";
+    tl::codegen::Replacer replacer;
+    replacer.register_rule("(kind)", kind);
+    replacer.register_rule("(scale_vec)", std::to_string(scale_vec));
+    replacer.register_rule("(desc_a)", this->PrintExpr(op->args[2]));
+    replacer.register_rule("(A_offset)", this->PrintExpr(op->args[3]));
+    replacer.register_rule("(desc_b)", this->PrintExpr(op->args[4]));
+    replacer.register_rule("(B_offset)", this->PrintExpr(op->args[5]));
+    replacer.register_rule("(C)", this->PrintExpr(op->args[6]));
+    replacer.register_rule("(C_offset)", this->PrintExpr(op->args[7]));
+    replacer.register_rule("(SFA)", this->PrintExpr(op->args[8]));
+    replacer.register_rule("(SFA_offset)", this->PrintExpr(op->args[9]));
+    replacer.register_rule("(SFB)", this->PrintExpr(op->args[10]));
+    replacer.register_rule("(SFB_offset)", this->PrintExpr(op->args[11]));
+    replacer.register_rule("(desc_val)", this->PrintExpr(op->args[12]));
+    replacer.register_rule("(scale_out)", this->PrintExpr(op->args[13]));
+    tcgen05_call = replacer.rewrite(tcgen05_call);
+    this->stream << tcgen05_call;
+  } else if (op->op.same_as(tl::ptx_tcgen05_cp())) {
+    ICHECK_EQ(op->args.size(), 4U) << "ptx_tcgen05_cp args is " << op->args;
+    need_tcgen05_common_h_ = true;
+    this->PrintIndent();
+    this->stream << "tl::tcgen05_cp_32x128b_warpx4(uint64_t(("
+                 << this->PrintExpr(op->args[0]) << ") + ("
+                 << this->PrintExpr(op->args[1])
+                 << ")), (*reinterpret_cast<uint32_t*>(("
+                 << this->PrintExpr(op->args[2]) << "))) + ("
+                 << this->PrintExpr(op->args[3]) << "));\n";
   } else if (op->op.same_as(tl::tcgen05_mma_arrive())) {
     ICHECK_EQ(op->args.size(), 1U) << "tcgen05_mma_arrive expects 1 argument";
     need_tcgen05_common_h_ = true;
     this->PrintIndent();
-    this->stream << "tl::tcgen05_mma_arrive(" << this->PrintExpr(op->args[0])
-                 << ");\n";
+    this->stream << (GetTcgen05CtaGroup(op) == 2
+                         ? "tl::tcgen05_mma_arrive_2cta("
+                         : "tl::tcgen05_mma_arrive(")
+                 << this->PrintExpr(op->args[0]) << ");\n";
   } else if (op->op.same_as(builtin::ptx_ldmatrix())) {
     // arg 0: whether the matrix is loaded in column major format or not.
     // arg 1: number of matrices to load.
@@ -2821,6 +3205,16 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     CUDAFastMath math_func;
     std::string func_name = math_func(op->dtype, "sin");
     os << func_name << "(" << PrintExpr(op->args[0]) << ")";
+  } else if (op->op.same_as(tl::ex2_approx()) ||
+             op->op.same_as(tl::tanh_approx())) {
+    need_fast_math_h_ = true;
+    os << (op->op.same_as(tl::ex2_approx()) ? "tl::ex2_approx"
+                                             : "tl::tanh_approx");
+    // Half vectors are packed in 32-bit words of two lanes each
+    if (op->dtype.lanes() > 1) {
+      os << (op->dtype.is_float16() ? "_f16x2" : "_bf16x2");
+    }
+    os << "(" << PrintExpr(op->args[0]) << ")";
   } else if (op->op.same_as(tl::ieee_add())) {
     CUDAIEEEMath math_func;
     std::string rounding_mode = Downcast<StringImm>(op->args[2])->value;
@@ -2889,6 +3283,9 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
       os << "_double";
     }
     os << "(&" << this->curand_random_generator_state << ")";
+  } else if (op->op.same_as(tl::philox_rand())) {
+    this->need_random_h_ = true;
+    PrintPhiloxRand(op, os);
   } else if (op->op.same_as(tl::warp_reduce_sum())) {
     os << "tl::warp_reduce_sum(" << PrintExpr(op->args[0]) << ")";
   } else if (op->op.same_as(tl::warp_reduce_max())) {
@@ -2903,8 +3300,11 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     // atomic_add_elem_op(dst_ptr, src_value[, memory_order])
     std::string dst_ptr = PrintExpr(op->args[0]);
     std::string src_value = PrintExpr(op->args[1]);
+    const char *func = op->annotations.count(tl::attr::kWarpAggregate)
+                           ? "AtomicAddAggregated("
+                           : "AtomicAdd(";
     this->PrintIndent();
-    this->stream << "AtomicAdd(" << dst_ptr << ", " << src_value;
+    this->stream << func << dst_ptr << ", " << src_value;
     if (op->args.size() > 2) {
       this->stream << ", " << PrintExpr(op->args[2]);
     }
@@ -2938,6 +3338,16 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
       this->stream << ", " << PrintExpr(op->args[2]);
     }
     this->stream << ");\n";
+  } else if (op->op.same_as(tl::atomic_addx8_elem_op())) {
+    // atomic_addx8_elem_op(dst_ptr, src_ptr[, memory_order])
+    std::string dst_ptr = PrintExpr(op->args[0]);
+    std::string src_ptr = PrintExpr(op->args[1]);
+    this->PrintIndent();
+    this->stream << "AtomicAddx8(" << dst_ptr << ", " << src_ptr;
+    if (op->args.size() > 2) {
+      this->stream << ", " << PrintExpr(op->args[2]);
+    }
+    this->stream << ");\n";
   } else if (op->op.same_as(tl::atomic_load_elem_op())) {
     // atomic_load_elem_op(src_ptr, memory_order) -> returns loaded value
     os << "AtomicLoad(" << PrintExpr(op->args[0]) << ", "
@@ -2954,8 +3364,11 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     // atomic_max_elem_op(dst_ptr, src_value[, memory_order])
     std::string dst_ptr = PrintExpr(op->args[0]);
     std::string src_value = PrintExpr(op->args[1]);
+    const char *func = op->annotations.count(tl::attr::kWarpAggregate)
+                           ? "AtomicMaxAggregated("
+                           : "AtomicMax(";
     this->PrintIndent();
-    this->stream << "AtomicMax(" << dst_ptr << ", " << src_value;
+    this->stream << func << dst_ptr << ", " << src_value;
     if (op->args.size() > 2) {
       this->stream << ", " << PrintExpr(op->args[2]);
     }
@@ -2973,8 +3386,11 @@ void CodeGenTileLangCUDA::VisitExpr_(const CallNode *op, std::ostream &os) {
     // atomic_min_elem_op(dst_ptr, src_value[, memory_order])
     std::string dst_ptr = PrintExpr(op->args[0]);
     std::string src_value = PrintExpr(op->args[1]);
+    const char *func = op->annotations.count(tl::attr::kWarpAggregate)
+                           ? "AtomicMinAggregated("
+                           : "AtomicMin(";
     this->PrintIndent();
-    this->stream << "AtomicMin(" << dst_ptr << ", " << src_value;
+    this->stream << func << dst_ptr << ", " << src_value;
     if (op->args.size() > 2) {
       this->stream << ", " << PrintExpr(op->args[2]);
     }
@@ -3034,11 +3450,41 @@ void CodeGenTileLangCUDA::VisitStmt_(const AttrStmtNode *op) {
     const IntImmNode *factor = op->value.as<IntImmNode>();
     ICHECK(factor);
     unroll_factor[op->node.as<VarNode>()] = Downcast<IntImm>(factor);
+  } else if (op->attr_key == tl::attr::kCacheHint) {
+    const VarNode *buffer = op->node.as<VarNode>();
+    const IntImmNode *hint = op->value.as<IntImmNode>();
+    ICHECK(buffer && hint);
+    int prev = GetCacheHint(buffer);
+    cache_hints_[buffer] = static_cast<int>(hint->value);
+    this->VisitStmt(op->body);
+    if (prev != 0) {
+      cache_hints_[buffer] = prev;
+    } else {
+      cache_hints_.erase(buffer);
+    }
+    return;
   }
 
   CodeGenC::VisitStmt_(op);
 }
 
+int CodeGenTileLangCUDA::GetCacheHint(const VarNode *buffer_var) const {
+  auto it = cache_hints_.find(buffer_var);
+  return it == cache_hints_.end() ? 0 : it->second;
+}
+
+int CodeGenTileLangCUDA::GetCacheHint(const PrimExpr &ptr) const {
+  int hint = 0;
+  PostOrderVisit(ptr, [&](const ObjectRef &node) {
+    if (const auto *var = node.as<VarNode>()) {
+      if (hint == 0) {
+        hint = GetCacheHint(var);
+      }
+    }
+  });
+  return hint;
+}
+
 void CodeGenTileLangCUDA::VisitStmt_(const AllocateNode *op) {
   ICHECK(!is_zero(op->condition));
   std::string vid = AllocVarID(op->buffer_var.get());
@@ -3148,15 +3594,49 @@ void CodeGenTileLangCUDA::VisitStmt_(const EvaluateNode *op) {
     PrintIndent();
     stream << "}\n";
   }
-  if (call && (call->op.same_as(tvm::tl::device_assert()))) {
-    std::string cond = PrintExpr(call->args[0]);
-    this->PrintIndent();
-    stream << "device_assert(" << cond << ");\n";
-  } else if (call && call->op.same_as(tvm::tl::device_assert_with_msg())) {
+  if (call && (call->op.same_as(tvm::tl::device_assert()) ||
+               call->op.same_as(tvm::tl::device_assert_with_msg()))) {
+    if (device_assert_mode_ == "off")
+      return;
+    bool with_msg = call->op.same_as(tvm::tl::device_assert_with_msg());
     std::string cond = PrintExpr(call->args[0]);
-    std::string msg_expr = PrintExpr(call->args[1]);
     this->PrintIndent();
-    stream << "device_assert_with_msg(" << cond << ", " << msg_expr << ");\n";
+    if (device_assert_mode_ == "warp") {
+      std::string msg_expr = with_msg ? PrintExpr(call->args[1]) : "nullptr";
+      stream << "tl::device_assert_warp(" << cond << ", " << msg_expr
+             << ");\n";
+    } else if (with_msg) {
+      std::string msg_expr = PrintExpr(call->args[1]);
+      stream << "device_assert_with_msg(" << cond << ", " << msg_expr
+             << ");\n";
+    } else {
+      stream << "device_assert(" << cond << ");\n";
+    }
+  } else if (call && (call->op.same_as(tvm::tl::profile_begin()) ||
+                      call->op.same_as(tvm::tl::profile_end()))) {
+    // Profile regions compile to nothing unless explicitly enabled.
+    if (enable_profile_region_) {
+      bool is_end = call->op.same_as(tvm::tl::profile_end());
+      std::string buf = PrintExpr(call->args[0]);
+      std::string capacity = PrintExpr(call->args[1]);
+      std::string region = PrintExpr(call->args[2]);
+      this->PrintIndent();
+      stream << "tl::profile_region_record((uint64_t *)(" << buf << "), "
+             << capacity << ", " << region << ", "
+             << (is_end ? "true" : "false") << ");\n";
+    }
+  } else if (call && call->op.same_as(tvm::tl::device_log())) {
+    // Stripped entirely, values included, unless explicitly enabled.
+    if (enable_device_log_) {
+      ICHECK_GE(call->args.size(), 3);
+      ICHECK_LE(call->args.size(), 7) << "T.device_log takes at most 4 values";
+      std::string buf = PrintExpr(call->args[0]);
+      this->PrintIndent();
+      stream << "tl::device_log_record((uint64_t *)(" << buf << ")";
+      for (size_t i = 1; i < call->args.size(); ++i)
+        stream << ", " << PrintExpr(call->args[i]);
+      stream << ");\n";
+    }
   } else {
     CodeGenC::VisitStmt_(op);
   }
@@ -3208,6 +3688,10 @@ void CodeGenTileLangCUDA::VisitExpr_(const BufferLoadNode *op,
   // declare type.
   if (value_dtype.lanes() == element_dtype.lanes()) {
     std::string ref = GetBufferRef(op->dtype, op->buffer.get(), index);
+    if (int hint = GetCacheHint(buffer_var.get())) {
+      os << "tl::ld_global_hint<" << hint << ">(&(" << ref << "))";
+      return;
+    }
     HandleVolatileLoads(ref, op, os);
   } else {
     bool can_vector_load = false;
@@ -3284,7 +3768,12 @@ void CodeGenTileLangCUDA::VisitStmt_(const BufferStoreNode *op) {
     std::string ref =
         this->GetBufferRef(value_dtype, op->buffer.get(), index_expr);
     this->PrintIndent();
-    stream << ref << " = " << value << ";\n";
+    if (int hint = GetCacheHint(buffer_var.get())) {
+      stream << "tl::st_global_hint<" << hint << ">(&(" << ref << "), "
+             << value << ");\n";
+    } else {
+      stream << ref << " = " << value << ";\n";
+    }
   } else {
     arith::PVar<PrimExpr> base;
     int ramp_lanes = value_dtype.lanes() / element_dtype.lanes();
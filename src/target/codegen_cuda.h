@@ -81,11 +81,24 @@ private:
   // Whether scope such as "__shared__" or "__constant__"  is part of type.
   bool IsScopePartOfType() const final { return false; }
 
+  // Apply a packed intrinsic of halves, e.g. __hadd2, to every lane pair of
+  // a float16 / bfloat16 vector binary op.
+  void PrintPackedHalfBinaryOp(const char *op, DataType t, PrimExpr lhs,
+                               PrimExpr rhs, std::ostream &os); // NOLINT(*)
+  // Print T.philox_rand, in one tl::philox_rand4 per 4 consecutive lanes.
+  void PrintPhiloxRand(const CallNode *op, std::ostream &os); // NOLINT(*)
+
   friend void PrintConst(const FloatImmNode *op, std::ostream &os,
                          CodeGenTileLangCUDA *p);
 
   // Whether global barrier is needed.
   bool need_global_barrier_{false};
+  // Whether T.profile_begin/end are lowered to ring buffer records.
+  bool enable_profile_region_{false};
+  // Whether T.device_log is lowered to log ring buffer records.
+  bool enable_device_log_{false};
+  // How device asserts are lowered: "thread", "warp" or "off".
+  std::string device_assert_mode_{"thread"};
   // Global barrier state
   std::string vid_global_barrier_state_;
   // Global barrier expected node.
@@ -130,6 +143,12 @@ private:
   bool need_cooperative_groups_{false};
   // whether need curand_kernel.h
   bool need_curand_kernel_h_{false};
+  // whether need tl symmetric memory header
+  bool need_symm_h_{false};
+  // whether need tl fast math approximations header
+  bool need_fast_math_h_{false};
+  // whether need tl counter-based random number header
+  bool need_random_h_{false};
   // Op attribute map
   OpAttrMap<bool> op_need_warp_shuffle_ =
       Op::GetAttrMap<bool>("cuda.need_warp_shuffle");
@@ -158,6 +177,11 @@ private:
   int32_t GetWmmaFragmentSize(const std::string &scope, const VarNode *variable,
                               int32_t size);
 
+  // Cache policy of the global buffers under a tl.cache_hint attribute
+  std::unordered_map<const VarNode *, int> cache_hints_;
+  int GetCacheHint(const VarNode *buffer_var) const;
+  int GetCacheHint(const PrimExpr &ptr) const;
+
   std::vector<std::string> eviction_policy_names_ = {
       "EVICT_NORMAL", "EVICT_FIRST", "EVICT_LAST"};
   std::unordered_set<std::string> bf16_supported_ops_ = {
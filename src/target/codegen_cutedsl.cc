@@ -419,13 +419,7 @@ void CodeGenTileLangCuTeDSL::VisitExpr_(const CallNode *op,
     ICHECK_GE(pol->value, 0);
     ICHECK_LT(static_cast<size_t>(pol->value), eviction_policy_names_.size());
     auto eviction_policy = eviction_policy_names_[pol->value];
-    // Simplify the code by using the default eviction policy
-    if (eviction_policy != "EVICT_NORMAL") {
-      LOG(FATAL) << "Eviction policy " << eviction_policy
-                 << " is not supported currently";
-    } else {
-      ss << "tl.tma_load(";
-    }
+    ss << "tl.tma_load(";
     auto desc = op->args[0];
     ss << PrintExpr_(desc) << ", ";
     ss << print_mbarrier_obj(op->args[1]) << ", ";
@@ -435,7 +429,11 @@ void CodeGenTileLangCuTeDSL::VisitExpr_(const CallNode *op,
         ss << ", ";
       ss << PrintExpr_(op->args[i]);
     }
-    ss << "))\n";
+    ss << ")";
+    if (eviction_policy != "EVICT_NORMAL") {
+      ss << ", eviction_policy=\"" << eviction_policy << "\"";
+    }
+    ss << ")\n";
     PrintIndent();
     stream << ss.str();
   } else if (op->op.same_as(tl::tma_load_im2col())) {
@@ -484,7 +482,7 @@ void CodeGenTileLangCuTeDSL::VisitExpr_(const CallNode *op,
     }
     ss << ")";
     if (eviction_policy != "EVICT_NORMAL") {
-      ss << ", eviction_kind = nvvm.EvictKind." << eviction_policy.substr(6);
+      ss << ", eviction_policy=\"" << eviction_policy << "\"";
     }
     ss << ")\n";
     PrintIndent();
@@ -508,8 +506,10 @@ void CodeGenTileLangCuTeDSL::VisitExpr_(const CallNode *op,
   } else if (op->op.same_as(tl::tma_store_arrive())) {
     print_extern_call_stmt("tl.tma_store_arrive");
   } else if (op->op.same_as(tl::tma_store_wait())) {
+    int64_t count =
+        op->args.empty() ? 0 : Downcast<IntImm>(op->args[0])->value;
     PrintIndent();
-    stream << "tl.tma_store_wait(0)\n";
+    stream << "tl.tma_store_wait(" << count << ")\n";
   } else if (op->op.same_as(tl::warpgroup_arrive())) {
     LOG(FATAL) << "Currently unsupported op: " << op->op;
   } else if (op->op.same_as(tl::warpgroup_commit_batch())) {
@@ -7,7 +7,9 @@
 #include <tvm/ffi/function.h>
 #include <tvm/tir/index_map.h>
 #include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <utility>
@@ -19,6 +21,52 @@
 namespace tvm {
 namespace codegen {
 
+/*!
+ * \brief Count the asynchronous direct-to-LDS loads one commit group issues.
+ *
+ * Only 4-byte copies are lowered to `buffer_load_dword ... lds`; wider copies
+ * go through registers and complete before the group is committed. Returns -1
+ * if a loop extent or copy size is not a constant.
+ */
+class AsyncLDSLoadCounter : public tir::StmtExprVisitor {
+public:
+  static int Count(const tir::Stmt &stmt) {
+    AsyncLDSLoadCounter counter;
+    counter(stmt);
+    return counter.unknown_ ? -1 : static_cast<int>(counter.count_);
+  }
+
+private:
+  void VisitStmt_(const tir::ForNode *op) final {
+    auto extent = as_const_int(op->extent);
+    if (!extent) {
+      unknown_ = true;
+      return;
+    }
+    int64_t saved = multiplier_;
+    multiplier_ *= *extent;
+    tir::StmtExprVisitor::VisitStmt_(op);
+    multiplier_ = saved;
+  }
+
+  void VisitExpr_(const tir::CallNode *op) final {
+    if (op->op.same_as(tir::builtin::ptx_cp_async()) ||
+        op->op.same_as(tl::ptx_cp_async())) {
+      auto bytes = as_const_int(op->args[2]);
+      if (!bytes) {
+        unknown_ = true;
+      } else if (*bytes == 4) {
+        count_ += multiplier_;
+      }
+    }
+    tir::StmtExprVisitor::VisitExpr_(op);
+  }
+
+  int64_t multiplier_{1};
+  int64_t count_{0};
+  bool unknown_{false};
+};
+
 static std::string GetFP8Type(DataType type) {
   std::stringstream stream;
   int32_t lanes = type.lanes();
@@ -152,6 +200,7 @@ std::string CodeGenTileLangHIP::Finish() {
   decl_stream << "#include <tl_templates/hip/ldsm.h>\n";
   decl_stream << "#include <tl_templates/hip/threadblock_swizzle.h>\n";
   decl_stream << "#include <tl_templates/hip/debug.h>\n";
+  decl_stream << "#include <tl_templates/hip/random.h>\n";
   decl_stream << "\n";
   return CodeGenC::Finish();
 }
@@ -428,6 +477,20 @@ void CodeGenTileLangHIP::PrintType(DataType t, std::ostream &os) { // NOLINT(*)
   LOG(FATAL) << "Cannot convert type " << t << " to CUDA type";
 }
 
+/*!
+ * \brief The clang vector type of two lanes of t, empty when the lanes of t
+ * are not combined pairwise in packed instructions.
+ */
+static std::string GetPackedVecType(DataType t) {
+  if (t.is_scalar() || t.lanes() % 2 != 0 || t.lanes() > 8)
+    return "";
+  if (t.is_float16())
+    return "float16x2";
+  if (t.is_float() && t.bits() == 32)
+    return "float32x2";
+  return "";
+}
+
 void CodeGenTileLangHIP::PrintVecBinaryOp(const std::string &op, DataType t,
                                           PrimExpr lhs, PrimExpr rhs,
                                           std::ostream &os) { // NOLINT(*)
@@ -438,10 +501,26 @@ void CodeGenTileLangHIP::PrintVecBinaryOp(const std::string &op, DataType t,
   stream << ' ' << sret << ";\n";
   int ssa_scope = BeginScope();
   {
-    // Unpack into individual ops.
     std::string vlhs = SSAGetID(PrintExpr(lhs), lhs.dtype());
     std::string vrhs = SSAGetID(PrintExpr(rhs), rhs.dtype());
 
+    // Combine the lanes two at a time through the clang vector types, which
+    // lower to v_pk_{add,mul,fma}_f16 and, from CDNA2 on, v_pk_*_f32.
+    std::string packed = GetPackedVecType(t);
+    if (!packed.empty() && (op == "+" || op == "-" || op == "*") &&
+        lhs.dtype() == t && rhs.dtype() == t) {
+      for (int i = 0; i < t.lanes() / 2; ++i) {
+        this->PrintIndent();
+        stream << "((" << packed << "*)(&" << sret << "))[" << i << "] = (("
+               << packed << "*)(&" << vlhs << "))[" << i << "] " << op
+               << " ((" << packed << "*)(&" << vrhs << "))[" << i << "];\n";
+      }
+      EndScope(ssa_scope);
+      os << sret;
+      return;
+    }
+
+    // Unpack into individual ops.
     for (int i = 0, lanes = t.lanes(); i < lanes; ++i) {
       std::ostringstream value_temp;
       if (isalpha(op[0])) {
@@ -464,6 +543,53 @@ void CodeGenTileLangHIP::PrintVecBinaryOp(const std::string &op, DataType t,
   os << sret;
 }
 
+void CodeGenTileLangHIP::PrintPhiloxRand(const CallNode *op,
+                                         std::ostream &os) { // NOLINT(*)
+  DataType t = op->dtype;
+  if (t.is_scalar()) {
+    os << "tl::philox_rand(" << PrintExpr(op->args[0]) << ", "
+       << PrintExpr(op->args[1]) << ", " << PrintExpr(op->args[2]) << ")";
+    return;
+  }
+  std::string sret = name_supply_->FreshName("_");
+  this->PrintIndent();
+  this->PrintType(t, stream);
+  stream << ' ' << sret << ";\n";
+  int ssa_scope = BeginScope();
+  const auto *seed = op->args[0].as<BroadcastNode>();
+  const auto *offset = op->args[1].as<BroadcastNode>();
+  const auto *ramp = op->args[2].as<RampNode>();
+  if (t.lanes() % 4 == 0 && seed && offset && ramp && is_one(ramp->stride)) {
+    // Consecutive indices: one Philox call per 4 lanes
+    std::string vseed = SSAGetID(PrintExpr(seed->value), seed->value.dtype());
+    std::string voffset =
+        SSAGetID(PrintExpr(offset->value), offset->value.dtype());
+    std::string vbase = SSAGetID(PrintExpr(ramp->base), ramp->base.dtype());
+    for (int i = 0; i < t.lanes() / 4; ++i) {
+      this->PrintIndent();
+      stream << "((uint4*)(&" << sret << "))[" << i << "] = tl::philox_rand4("
+             << vseed << ", " << voffset << ", " << vbase << " + " << i * 4
+             << ");\n";
+    }
+  } else {
+    std::vector<std::string> args;
+    for (const PrimExpr &arg : op->args)
+      args.push_back(SSAGetID(PrintExpr(arg), arg.dtype()));
+    for (int i = 0; i < t.lanes(); ++i) {
+      std::ostringstream value;
+      value << "tl::philox_rand(";
+      for (size_t j = 0; j < args.size(); ++j) {
+        value << (j == 0 ? "" : ", ");
+        PrintVecElemLoad(args[j], op->args[j].dtype(), i, value);
+      }
+      value << ")";
+      PrintVecElemStore(sret, t, i, value.str());
+    }
+  }
+  EndScope(ssa_scope);
+  os << sret;
+}
+
 void CodeGenTileLangHIP::PrintVecElemLoad(const std::string &vec, DataType t,
                                           int i,
                                           std::ostream &os) { // NOLINT(*)
@@ -625,6 +751,22 @@ void CodeGenTileLangHIP::VisitExpr_(const CastNode *op, std::ostream &os) {
   stream << ' ' << sret << ";\n";
   {
     std::string src = SSAGetID(PrintExpr(op->value), from_ty);
+    // Convert fp16 from and to fp32 two lanes at a time, which lets the
+    // compiler pick the packed conversions of the target.
+    std::string packed_from = GetPackedVecType(from_ty);
+    std::string packed_to = GetPackedVecType(target_ty);
+    if (!packed_from.empty() && !packed_to.empty() &&
+        (from_ty.is_float16() || target_ty.is_float16()) &&
+        from_ty.code() != target_ty.code()) {
+      for (int i = 0; i < from_ty.lanes() / 2; ++i) {
+        this->PrintIndent();
+        stream << "((" << packed_to << "*)(&" << sret << "))[" << i
+               << "] = __builtin_convertvector(((" << packed_from << "*)(&"
+               << src << "))[" << i << "], " << packed_to << ");\n";
+      }
+      os << sret;
+      return;
+    }
     for (int i = 0, lanes = from_ty.lanes(); i < lanes; ++i) {
       std::ostringstream val;
       val << "(";
@@ -791,8 +933,13 @@ void CodeGenTileLangHIP::VisitExpr_(const CallNode *op, std::ostream &os) {
   } else if (op->op.same_as(builtin::ptx_commit_group())) {
     print_extern_call_stmt("tl::cp_async_commit");
   } else if (op->op.same_as(builtin::ptx_wait_group())) {
+    // s_waitcnt vmcnt counts outstanding load instructions rather than commit
+    // groups. Loads return in order, so leaving n groups of k loads in flight
+    // is vmcnt(n * k); with k = 1 every wait would drain the pipeline.
     int n = Downcast<IntImm>(op->args[0])->value;
-    std::string func_name = "tl::cp_async_wait<" + std::to_string(n) + ">";
+    int loads_per_group = async_group_loads_ > 0 ? async_group_loads_ : 1;
+    int vmcnt = std::min(n * loads_per_group, kMaxVmcnt);
+    std::string func_name = "tl::cp_async_wait<" + std::to_string(vmcnt) + ">";
     print_extern_call_stmt(func_name, 1);
   } else if (op->op.same_as(builtin::create_barriers())) {
     this->PrintIndent();
@@ -827,6 +974,8 @@ void CodeGenTileLangHIP::VisitExpr_(const CallNode *op, std::ostream &os) {
     this->PrintIndent();
     int num_mma = Downcast<IntImm>(op->args[0])->value;
     this->stream << "tl::wait_wgmma<" << std::to_string(num_mma) << ">();\n";
+  } else if (op->op.same_as(tl::philox_rand())) {
+    PrintPhiloxRand(op, os);
   } else if (op->op.same_as(tl::pack_b16())) {
     os << "__pack_half2(" << this->PrintExpr(op->args[0]) << ", "
        << this->PrintExpr(op->args[1]) << ")";
@@ -946,6 +1095,8 @@ void CodeGenTileLangHIP::VisitExpr_(const CallNode *op, std::ostream &os) {
         {"float8_e4m3fnuzx8", "long"},
         {"float8_e5m2fnuzx4", "fp8_e5_4_t"},
         {"float8_e5m2fnuzx8", "long"},
+        {"float8_e4m3fnx8", "long"},
+        {"float8_e5m2x8", "long"},
         {"float32x16", "float32x16"}};
     std::string call_mfma_code = R"({
       *((({C_dtype}*){c_ref}) + {c_bias}) = {mfma_buildin}(*((({A_dtype}*){a_ref}) + {a_bias}),
@@ -966,6 +1117,55 @@ void CodeGenTileLangHIP::VisitExpr_(const CallNode *op, std::ostream &os) {
     replacer.register_rule("{c_ref}", c_ref);
     replacer.register_rule("{c_bias}", c_bias);
     os << replacer.rewrite(call_mfma_code);
+  } else if (op->op.same_as(tl::tvm_rdna_wmma())) {
+    // arg 0: prefix: {otype}_{intrM}x{intrN}x{intrK}_{itype}_w32[_gfx12]
+    // arg 1-11: same as tvm_mfma
+    ICHECK(op->args.size() == 12U)
+        << "Invalid number of arguments for tvm_rdna_wmma";
+    std::string prefix = Downcast<StringImm>(op->args[0])->value;
+    std::string A_layout = Downcast<StringImm>(op->args[1])->value;
+    std::string B_layout = Downcast<StringImm>(op->args[2])->value;
+    std::string A_dtype = Downcast<StringImm>(op->args[3])->value;
+    std::string B_dtype = Downcast<StringImm>(op->args[4])->value;
+    std::string C_dtype = Downcast<StringImm>(op->args[5])->value;
+    std::string a_ref = this->PrintExpr(op->args[6]);
+    std::string a_bias = this->PrintExpr(op->args[7]);
+    std::string b_ref = this->PrintExpr(op->args[8]);
+    std::string b_bias = this->PrintExpr(op->args[9]);
+    std::string c_ref = this->PrintExpr(op->args[10]);
+    std::string c_bias = this->PrintExpr(op->args[11]);
+    ICHECK(A_layout == "row" || B_layout == "row")
+        << "Matrix core only support row major";
+    // RDNA3 operands hold 16 values per lane, RDNA4 ones 8
+    std::unordered_map<std::string, std::string> dtype_map = {
+        {"float16x8", "float16x8"},
+        {"float16x16", "float16x16"},
+        {"bfloat16x8", "bfloat16x8_vec"},
+        {"bfloat16x16", "bfloat16x16_vec"},
+        {"float32x8", "float32x8"}};
+    ICHECK(dtype_map.count(A_dtype) && dtype_map.count(B_dtype) &&
+           dtype_map.count(C_dtype))
+        << "Unsupported dtypes for tvm_rdna_wmma: " << A_dtype << ", "
+        << B_dtype << ", " << C_dtype;
+    std::string call_wmma_code = R"({
+      *((({C_dtype}*){c_ref}) + {c_bias}) = {wmma_buildin}(*((({A_dtype}*){a_ref}) + {a_bias}),
+                    *((({B_dtype}*){b_ref}) + {b_bias}),
+                    *((({C_dtype}*){c_ref}) + {c_bias}));
+    })";
+    std::string wmma_buildin = "__builtin_amdgcn_wmma_" + prefix;
+    Replacer replacer;
+
+    replacer.register_rule("{wmma_buildin}", wmma_buildin);
+    replacer.register_rule("{A_dtype}", dtype_map[A_dtype]);
+    replacer.register_rule("{B_dtype}", dtype_map[B_dtype]);
+    replacer.register_rule("{C_dtype}", dtype_map[C_dtype]);
+    replacer.register_rule("{a_ref}", a_ref);
+    replacer.register_rule("{a_bias}", a_bias);
+    replacer.register_rule("{b_ref}", b_ref);
+    replacer.register_rule("{b_bias}", b_bias);
+    replacer.register_rule("{c_ref}", c_ref);
+    replacer.register_rule("{c_bias}", c_bias);
+    os << replacer.rewrite(call_wmma_code);
   } else if (op->op.same_as(builtin::thread_return())) {
     os << "return";
   } else if (op->op.same_as(tl::tl_gemm())) {
@@ -1093,6 +1293,16 @@ void CodeGenTileLangHIP::VisitStmt_(const AttrStmtNode *op) {
     const IntImmNode *queue_id = op->value.as<IntImmNode>();
     ICHECK(queue_id && queue_id->value == 0)
         << "For CUDA, the index of an async queue must be 0.";
+    // The smallest group bounds how many loads the newest groups keep in
+    // flight; unknown groups fall back to waiting per instruction.
+    int loads = AsyncLDSLoadCounter::Count(op->body);
+    if (loads < 0) {
+      async_group_loads_ = 1;
+    } else if (loads > 0) {
+      async_group_loads_ = async_group_loads_ < 0
+                               ? loads
+                               : std::min(async_group_loads_, loads);
+    }
     this->VisitStmt(op->body);
     auto commit_group = Call(DataType::Void(), builtin::ptx_commit_group(), {});
     this->VisitExpr(commit_group, this->stream);
@@ -1117,10 +1327,75 @@ void CodeGenTileLangHIP::VisitStmt_(const AttrStmtNode *op) {
     this->stream << "const dim3 blockIdx = " << pattern->value << "();\n";
     this->VisitStmt(op->body);
     return;
+  } else if (op->attr_key == tl::attr::kCacheHint) {
+    const VarNode *buffer = op->node.as<VarNode>();
+    const IntImmNode *hint = op->value.as<IntImmNode>();
+    ICHECK(buffer && hint);
+    int prev = GetCacheHint(buffer);
+    cache_hints_[buffer] = static_cast<int>(hint->value);
+    this->VisitStmt(op->body);
+    if (prev != 0) {
+      cache_hints_[buffer] = prev;
+    } else {
+      cache_hints_.erase(buffer);
+    }
+    return;
   }
   CodeGenC::VisitStmt_(op);
 }
 
+void CodeGenTileLangHIP::VisitExpr_(const BufferLoadNode *op,
+                                    std::ostream &os) { // NOLINT(*)
+  int hint = GetCacheHint(op->buffer->data.get());
+  if (hint != 0 && op->indices.size() == 1 && !op->predicate.defined() &&
+      op->dtype.lanes() == op->buffer->dtype.lanes()) {
+    os << "tl::ld_global_hint<" << hint << ">(&("
+       << GetBufferRef(op->dtype, op->buffer.get(), op->indices[0]) << "))";
+    return;
+  }
+  CodeGenC::VisitExpr_(op, os);
+}
+
+void CodeGenTileLangHIP::VisitStmt_(const BufferStoreNode *op) {
+  int hint = GetCacheHint(op->buffer->data.get());
+  if (hint != 0 && op->indices.size() == 1 && !op->predicate.defined() &&
+      op->value.dtype().lanes() == op->buffer->dtype.lanes()) {
+    std::string value = PrintExpr(op->value);
+    std::string ref =
+        GetBufferRef(op->value.dtype(), op->buffer.get(), op->indices[0]);
+    this->PrintIndent();
+    stream << "tl::st_global_hint<" << hint << ">(&(" << ref << "), " << value
+           << ");\n";
+    return;
+  }
+  CodeGenC::VisitStmt_(op);
+}
+
+std::string CodeGenTileLangHIP::GetVecLoad(DataType t,
+                                           const BufferNode *buffer,
+                                           PrimExpr base) {
+  if (int hint = GetCacheHint(buffer->data.get())) {
+    std::ostringstream os;
+    os << "tl::ld_global_hint<" << hint << ">(&("
+       << GetBufferRef(t, buffer, base) << "))";
+    return os.str();
+  }
+  return CodeGenC::GetVecLoad(t, buffer, base);
+}
+
+void CodeGenTileLangHIP::PrintVecStore(const BufferNode *buffer, DataType t,
+                                       PrimExpr base,
+                                       const std::string &value) {
+  if (int hint = GetCacheHint(buffer->data.get())) {
+    std::string ref = GetBufferRef(t, buffer, base);
+    this->PrintIndent();
+    stream << "tl::st_global_hint<" << hint << ">(&(" << ref << "), " << value
+           << ");\n";
+    return;
+  }
+  CodeGenC::PrintVecStore(buffer, t, base, value);
+}
+
 void CodeGenTileLangHIP::VisitStmt_(const AllocateNode *op) {
   ICHECK(!is_zero(op->condition));
   std::string vid = AllocVarID(op->buffer_var.get());
@@ -1418,6 +1693,7 @@ void CodeGenTileLangHIP::PrintVecElemLoadExpr(DataType t, int i,
 void CodeGenTileLangHIP::AddFunction(const PrimFunc &f) {
   // clear previous generated state.
   this->InitFuncState(f);
+  async_group_loads_ = -1;
   // reserve keywords
   ReserveKeywordsAsUnique();
 
@@ -49,6 +49,8 @@ public:
   void VisitExpr_(const CastNode *op, std::ostream &os) final;
   void VisitStmt_(const AllocateNode *op) final;
   void VisitStmt_(const AttrStmtNode *op) final;
+  void VisitExpr_(const BufferLoadNode *op, std::ostream &os) final;
+  void VisitStmt_(const BufferStoreNode *op) final;
 
   // Override this as a work around for __grid_constant__ parameter
   void AddFunction(const PrimFunc &f);
@@ -56,6 +58,10 @@ public:
 protected:
   virtual std::string GetBufferRef(DataType t, const BufferNode *buffer,
                                    PrimExpr index) final;
+  std::string GetVecLoad(DataType t, const BufferNode *buffer,
+                         PrimExpr base) final;
+  void PrintVecStore(const BufferNode *buffer, DataType t, PrimExpr base,
+                     const std::string &value) final;
   void PrintCallExtern(Type ret_type, ffi::String global_symbol,
                        const ffi::Array<PrimExpr> &args, bool skip_first_arg,
                        std::ostream &os) final; // NOLINT(*)
@@ -68,6 +74,9 @@ private:
   // Whether scope such as "__shared__" or "__constant__"  is part of type.
   bool IsScopePartOfType() const final { return false; }
 
+  // Print T.philox_rand, in one tl::philox_rand4 per 4 consecutive lanes.
+  void PrintPhiloxRand(const CallNode *op, std::ostream &os); // NOLINT(*)
+
   friend void PrintConst(const FloatImmNode *op, std::ostream &os,
                          CodeGenTileLangHIP *p);
 
@@ -79,6 +88,16 @@ private:
   bool enable_fp8_{false};
   // The size of the barrier array in shared memory
   int barrier_count_ = -1;
+  // Cache policy of the global buffers under a tl.cache_hint attribute
+  std::unordered_map<const VarNode *, int> cache_hints_;
+  int GetCacheHint(const VarNode *buffer_var) const {
+    auto it = cache_hints_.find(buffer_var);
+    return it == cache_hints_.end() ? 0 : it->second;
+  }
+  // Direct-to-LDS loads of the smallest async commit group, -1 if none seen
+  int async_group_loads_ = -1;
+  // Largest vmcnt an s_waitcnt can encode on CDNA
+  static constexpr int kMaxVmcnt = 63;
   // whether need mma.h
   bool need_mma_h_{false};
   // whether need cast_smem_ptr_to_int helper function
@@ -213,6 +213,9 @@ struct MMAConfig {
  */
 const MMAConfig valid_mma_configs[] = {
     MMAConfig(8, 8, 4, DataType::kFloat64, false, false),
+    MMAConfig(16, 8, 4, DataType::kFloat64, false, false),
+    MMAConfig(16, 8, 8, DataType::kFloat64, false, false),
+    MMAConfig(16, 8, 16, DataType::kFloat64, false, false),
     MMAConfig(8, 8, 4, DataType::kFloat16, false, false),
     MMAConfig(16, 8, 8, DataType::kFloat16, false, false),
     MMAConfig(16, 8, 16, DataType::kFloat16, false, false),
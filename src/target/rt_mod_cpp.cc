@@ -2,6 +2,7 @@
 #include <tvm/ffi/extra/module.h>
 #include <tvm/ffi/reflection/registry.h>
 
+#include "../op/builtin.h"
 #include "../support/ffi_aliases.h"
 
 namespace tvm {
@@ -23,6 +24,10 @@ ffi::Module BuildCPPHost(IRModule mod, Target target) {
 
   CodeGenTileLangCPP cg;
   cg.Init(output_ssa, emit_asserts, emit_fwd_func_decl, target->str(), devices);
+  cg.SetParallelGrid(
+      tvm::transform::PassContext::Current()
+          ->GetConfig<Bool>(tl::kEnableCPUParallelGrid, Bool(false))
+          .value());
   cg.SetConstantsByteAlignment(
       target->GetAttr<Integer>("constants-byte-alignment").value_or(16));
 
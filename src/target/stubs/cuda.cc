@@ -263,6 +263,15 @@ CUresult cuTensorMapEncodeIm2col(
             channelsPerPixel, pixelsPerColumn, elementStrides, interleave,
             swizzle, l2Promotion, oobFill);
 }
+
+CUresult cuTensorMapReplaceAddress(CUtensorMap *tensorMap,
+                                   void *globalAddress) {
+  auto fn = CUDADriverAPI::get()->cuTensorMapReplaceAddress_;
+  if (fn == nullptr) {
+    return CUDA_ERROR_NOT_SUPPORTED;
+  }
+  return fn(tensorMap, globalAddress);
+}
 #endif
 
 } // extern "C"
@@ -76,7 +76,8 @@
 #if defined(CUDA_VERSION) && (CUDA_VERSION >= 12000)
 #define TILELANG_LIBCUDA_API_OPTIONAL(_)                                       \
   _(cuTensorMapEncodeTiled)                                                    \
-  _(cuTensorMapEncodeIm2col)
+  _(cuTensorMapEncodeIm2col)                                                   \
+  _(cuTensorMapReplaceAddress)
 #else
 #define TILELANG_LIBCUDA_API_OPTIONAL(_)
 #endif
@@ -210,6 +211,8 @@ TILELANG_CUDA_STUB_API CUresult cuTensorMapEncodeIm2col(
     cuuint32_t pixelsPerColumn, const cuuint32_t *elementStrides,
     CUtensorMapInterleave interleave, CUtensorMapSwizzle swizzle,
     CUtensorMapL2promotion l2Promotion, CUtensorMapFloatOOBfill oobFill);
+TILELANG_CUDA_STUB_API CUresult
+cuTensorMapReplaceAddress(CUtensorMap *tensorMap, void *globalAddress);
 #endif
 
 } // extern "C"
@@ -21,6 +21,9 @@ bool TargetIsRocm(Target target) {
 bool TargetIsMetal(Target target) {
   return target->GetTargetDeviceType() == kDLMetal;
 }
+bool TargetIsCPU(Target target) {
+  return target->GetTargetDeviceType() == kDLCPU;
+}
 
 int GetArchInt(Target target) {
   auto s = target->GetAttr<tvm::ffi::String>("arch");
@@ -85,6 +88,25 @@ bool TargetIsCDNA(Target target) {
   return false;
 }
 
+bool TargetIsCDNA4(Target target) {
+  if (!TargetIsCDNA(target))
+    return false;
+  std::string mcpu = Downcast<tvm::ffi::String>(target->attrs.at("mcpu"));
+  // gfx950 (MI350/MI355) adds the f8f6f4 and block scaled MFMAs
+  return mcpu.find("gfx950") == 0;
+}
+
+bool TargetIsRDNA(Target target) {
+  if (!TargetIsRocm(target))
+    return false;
+  if (target->attrs.count("mcpu")) {
+    std::string mcpu = Downcast<tvm::ffi::String>(target->attrs.at("mcpu"));
+    // gfx11 is RDNA3 and gfx12 is RDNA4, the generations with WMMA
+    return mcpu.find("gfx11") == 0 || mcpu.find("gfx12") == 0;
+  }
+  return false;
+}
+
 bool TargetHasAsyncCopy(Target target) {
   if (TargetIsCuda(target)) {
     int arch = GetArchInt(target);
@@ -145,6 +167,101 @@ bool TargetHasSMVersionGE(Target target, int version) {
   return arch >= version;
 }
 
+// Widest vectorized atomic addition of the target, in elements of dtype:
+// 16-bit floats use half2/bfloat162 atomics, and on sm90+ a single 128-bit
+// red.global.add.v4.{f16x2,bf16x2}; float32 uses red.global.add.v4.f32 on
+// sm90+.
+int TargetGetAtomicAddVectorSize(Target target, DataType dtype) {
+  bool sm90 = target.defined() && TargetHasSMVersionGE(target, 90);
+  if (dtype.is_float16() || dtype.is_bfloat16()) {
+    return sm90 ? 8 : 2;
+  }
+  if (dtype.is_float() && dtype.bits() == 32 && sm90) {
+    return 4;
+  }
+  return 1;
+}
+
+// Opt-in shared memory capacity of one thread block in bytes, following the
+// per-architecture limits of the CUDA C++ programming guide.
+int TargetGetMaxSharedMemoryPerBlock(Target target) {
+  if (TargetIsCuda(target)) {
+    int arch = GetArchInt(target);
+    if (arch >= 120)
+      return 99 * 1024;
+    if (arch >= 90)
+      return 227 * 1024;
+    if (arch == 86 || arch == 89)
+      return 99 * 1024;
+    if (arch >= 80)
+      return 163 * 1024;
+    if (arch >= 75)
+      return 64 * 1024;
+    if (arch >= 70)
+      return 96 * 1024;
+  }
+  if (auto max_smem = target->GetAttr<Integer>("max_shared_memory_per_block")) {
+    return static_cast<int>(max_smem.value()->value);
+  }
+  if (TargetIsRocm(target))
+    return 64 * 1024;
+  return 48 * 1024;
+}
+
+// SIMD register width in bits of a CPU target, from -mattr, then -mcpu, then
+// the -mtriple architecture. "-mcpu=native" and targets without any of them
+// query the host, since the kernels are compiled and run on it.
+int TargetGetCPUVectorBits(Target target) {
+  auto mattr =
+      target->GetAttr<Array<String>>("mattr").value_or(Array<String>());
+  auto has_attr = [&](const char *feature) {
+    for (const auto &attr : mattr) {
+      if (attr == feature)
+        return true;
+    }
+    return false;
+  };
+  if (has_attr("+avx512f"))
+    return 512;
+  if (has_attr("+avx2") || has_attr("+avx"))
+    return 256;
+  if (has_attr("+neon") || has_attr("+sve"))
+    return 128;
+
+  std::string mcpu = target->GetAttr<String>("mcpu").value_or("");
+  if (!mcpu.empty() && mcpu != "native") {
+    static const char *avx512_cpus[] = {
+        "skylake-avx512", "cascadelake", "cooperlake", "cannonlake",
+        "icelake-client", "icelake-server", "tigerlake", "sapphirerapids",
+        "emeraldrapids", "graniterapids", "znver4", "znver5", "x86-64-v4"};
+    static const char *avx2_cpus[] = {
+        "haswell", "broadwell", "skylake", "alderlake", "raptorlake",
+        "meteorlake", "znver1", "znver2", "znver3", "x86-64-v3"};
+    for (const char *cpu : avx512_cpus) {
+      if (mcpu == cpu)
+        return 512;
+    }
+    for (const char *cpu : avx2_cpus) {
+      if (mcpu == cpu)
+        return 256;
+    }
+  }
+  std::string mtriple = target->GetAttr<String>("mtriple").value_or("");
+  if (mtriple.rfind("aarch64", 0) == 0 || mtriple.rfind("arm", 0) == 0)
+    return 128;
+  if (mcpu.empty() || mcpu == "native") {
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return 512;
+    if (__builtin_cpu_supports("avx2"))
+      return 256;
+#endif
+  }
+  return 128;
+}
+
 int TargetGetWarpSize(Target target) {
   int res = 32;
   if (TargetIsCDNA(target))
@@ -193,6 +310,16 @@ bool IsCudaVectorizableCast(DataType from_ty, DataType target_ty) {
   return false;
 }
 
+// Element types the C++ backend can hold in GCC/Clang vector extension types.
+// half and bfloat16 are emulated classes and stay scalar.
+bool IsCPUVectorizableType(DataType dtype) {
+  if (dtype.is_float())
+    return dtype.bits() == 32 || dtype.bits() == 64;
+  if (dtype.is_int() || dtype.is_uint())
+    return dtype.bits() >= 8 && dtype.bits() <= 64;
+  return false;
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
   refl::GlobalDef()
@@ -214,6 +341,10 @@ TVM_FFI_STATIC_INIT_BLOCK() {
            [](Target target) { return TargetIsSM120(target); })
       .def("tl.TargetIsCDNA",
            [](Target target) { return TargetIsCDNA(target); })
+      .def("tl.TargetIsCDNA4",
+           [](Target target) { return TargetIsCDNA4(target); })
+      .def("tl.TargetIsRDNA",
+           [](Target target) { return TargetIsRDNA(target); })
       .def("tl.TargetHasAsyncCopy",
            [](Target target) { return TargetHasAsyncCopy(target); })
       .def("tl.TargetHasLdmatrix",
@@ -15,6 +15,7 @@ namespace tl {
 bool TargetIsCuda(Target target);
 bool TargetIsRocm(Target target);
 bool TargetIsMetal(Target target);
+bool TargetIsCPU(Target target);
 
 bool TargetIsVolta(Target target);
 bool TargetIsTuring(Target target);
@@ -23,6 +24,8 @@ bool TargetIsHopper(Target target);
 bool TargetIsSm100(Target target);
 bool TargetIsSM120(Target target);
 bool TargetIsCDNA(Target target);
+bool TargetIsCDNA4(Target target);
+bool TargetIsRDNA(Target target);
 
 bool TargetHasAsyncCopy(Target target);
 bool TargetHasLdmatrix(Target target);
@@ -31,10 +34,14 @@ bool TargetHasTmem(Target target);
 bool TargetHasBulkCopy(Target target);
 bool TargetSupportVectorize256(Target target);
 int TargetGetWarpSize(Target target);
+int TargetGetMaxSharedMemoryPerBlock(Target target);
+int TargetGetCPUVectorBits(Target target);
 bool TargetHasSMVersionGE(Target target, int version);
+int TargetGetAtomicAddVectorSize(Target target, DataType dtype);
 
 bool IsCudaVectorizableFP8(DataType dtype);
 bool IsCudaVectorizableCast(DataType from_ty, DataType target_ty);
+bool IsCPUVectorizableType(DataType dtype);
 
 } // namespace tl
 } // namespace tvm
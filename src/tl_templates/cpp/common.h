@@ -3,6 +3,63 @@
 #include "half.hpp"
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
 
 using half_float::half;
-// Not Implemented
+
+// Vector types of the vectorized loops, named like the scalar type followed
+// by the lane count (float4, int32_t8, ...). They are GCC/Clang vector
+// extension types, so element-wise arithmetic, comparisons and ?: map to SIMD
+// instructions of the ISA selected by the host compiler. The alignment is
+// lowered to the element type and the types may alias it, since vectorized
+// accesses go through casts of scalar buffer pointers at arbitrary offsets.
+#define TL_CPU_DEFINE_VECTOR_TYPE(T, N)                                        \
+  typedef T T##N __attribute__((vector_size((N) * sizeof(T)),                  \
+                                aligned(sizeof(T)), may_alias));
+
+#define TL_CPU_DEFINE_VECTOR_TYPES(T)                                          \
+  TL_CPU_DEFINE_VECTOR_TYPE(T, 2)                                              \
+  TL_CPU_DEFINE_VECTOR_TYPE(T, 4)                                              \
+  TL_CPU_DEFINE_VECTOR_TYPE(T, 8)                                              \
+  TL_CPU_DEFINE_VECTOR_TYPE(T, 16)
+
+TL_CPU_DEFINE_VECTOR_TYPES(float)
+TL_CPU_DEFINE_VECTOR_TYPES(double)
+TL_CPU_DEFINE_VECTOR_TYPES(int8_t)
+TL_CPU_DEFINE_VECTOR_TYPES(uint8_t)
+TL_CPU_DEFINE_VECTOR_TYPES(int16_t)
+TL_CPU_DEFINE_VECTOR_TYPES(uint16_t)
+TL_CPU_DEFINE_VECTOR_TYPES(int32_t)
+TL_CPU_DEFINE_VECTOR_TYPES(uint32_t)
+TL_CPU_DEFINE_VECTOR_TYPES(int64_t)
+TL_CPU_DEFINE_VECTOR_TYPES(uint64_t)
+
+#undef TL_CPU_DEFINE_VECTOR_TYPES
+#undef TL_CPU_DEFINE_VECTOR_TYPE
+
+namespace tl {
+
+// Per-thread scratch arena of the generated kernels. Buffers larger than a
+// cache line are carved out of it at the offsets planned by the code
+// generator, so repeated launches reuse the same memory, and each worker of
+// a parallel grid gets its own cache-line aligned arena.
+inline char *cpu_scratch_arena(size_t bytes) {
+  constexpr size_t kCacheLine = 64;
+  struct Arena {
+    char *data = nullptr;
+    size_t size = 0;
+    ~Arena() { free(data); }
+  };
+  static thread_local Arena arena;
+  if (arena.size < bytes) {
+    // Only grows at the first allocation of a launch: every allocation of a
+    // kernel asks for the same planned size.
+    free(arena.data);
+    arena.size = (bytes + kCacheLine - 1) / kCacheLine * kCacheLine;
+    arena.data = static_cast<char *>(aligned_alloc(kCacheLine, arena.size));
+  }
+  return arena.data;
+}
+
+} // namespace tl
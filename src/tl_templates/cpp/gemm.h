@@ -1,3 +1,201 @@
 #pragma once
 
-// Not Implemented
+#include "common.h"
+
+#include <string.h>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define TL_CPU_GEMM_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TL_CPU_GEMM_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Tile GEMM of local buffers for CPU targets, C[M, N] += A[M, K] * B[K, N].
+//
+// float/half inputs with a float accumulator are packed to float panels and
+// multiplied by register-blocked micro-kernels of 6 rows times two vectors:
+// AVX-512 or AVX2+FMA on x86, selected once at run time so that the kernels
+// do not depend on the -m flags of the host compiler, and NEON on AArch64.
+// Every other type combination, e.g. int8 inputs with an int32 accumulator,
+// uses the scalar loop nest.
+
+namespace tl {
+
+namespace cpu_detail {
+
+constexpr int kMicroRows = 6;
+
+// C[i_begin:i_end, j_begin:j_end] += A * B for packed row-major panels.
+inline void gemm_f32_scalar(const float *A, const float *B, float *C, int K,
+                            int N, int ldc, int i_begin, int i_end,
+                            int j_begin, int j_end) {
+  for (int i = i_begin; i < i_end; ++i) {
+    for (int k = 0; k < K; ++k) {
+      const float a = A[i * K + k];
+      for (int j = j_begin; j < j_end; ++j) {
+        C[i * ldc + j] += a * B[k * N + j];
+      }
+    }
+  }
+}
+
+// Defines NAME(A, B, C, M, N, K, ldc) on packed float panels. Full
+// kMicroRows x (2 * WIDTH) blocks of C are accumulated in registers over the
+// whole K extent, the remainder goes through gemm_f32_scalar.
+#define TL_CPU_DEFINE_GEMM_MICRO_KERNEL(NAME, ATTR, REG, WIDTH, LOAD, STORE,  \
+                                        FMA, SET1)                            \
+  ATTR inline void NAME(const float *A, const float *B, float *C, int M,      \
+                        int N, int K, int ldc) {                              \
+    constexpr int kCols = 2 * (WIDTH);                                        \
+    const int m_full = M / kMicroRows * kMicroRows;                           \
+    const int n_full = N / kCols * kCols;                                     \
+    for (int i0 = 0; i0 < m_full; i0 += kMicroRows) {                         \
+      for (int j0 = 0; j0 < n_full; j0 += kCols) {                            \
+        REG acc[kMicroRows][2];                                               \
+        for (int r = 0; r < kMicroRows; ++r) {                                \
+          acc[r][0] = LOAD(C + (i0 + r) * ldc + j0);                          \
+          acc[r][1] = LOAD(C + (i0 + r) * ldc + j0 + (WIDTH));                \
+        }                                                                     \
+        for (int k = 0; k < K; ++k) {                                         \
+          const REG b0 = LOAD(B + k * N + j0);                                \
+          const REG b1 = LOAD(B + k * N + j0 + (WIDTH));                      \
+          for (int r = 0; r < kMicroRows; ++r) {                              \
+            const REG a = SET1(A[(i0 + r) * K + k]);                          \
+            acc[r][0] = FMA(acc[r][0], a, b0);                                \
+            acc[r][1] = FMA(acc[r][1], a, b1);                                \
+          }                                                                   \
+        }                                                                     \
+        for (int r = 0; r < kMicroRows; ++r) {                                \
+          STORE(C + (i0 + r) * ldc + j0, acc[r][0]);                          \
+          STORE(C + (i0 + r) * ldc + j0 + (WIDTH), acc[r][1]);                \
+        }                                                                     \
+      }                                                                       \
+    }                                                                         \
+    gemm_f32_scalar(A, B, C, K, N, ldc, 0, m_full, n_full, N);                \
+    gemm_f32_scalar(A, B, C, K, N, ldc, m_full, M, 0, N);                     \
+  }
+
+#if defined(TL_CPU_GEMM_X86)
+
+#define TL_CPU_FMA_AVX512(acc, a, b) _mm512_fmadd_ps(a, b, acc)
+#define TL_CPU_FMA_AVX2(acc, a, b) _mm256_fmadd_ps(a, b, acc)
+
+TL_CPU_DEFINE_GEMM_MICRO_KERNEL(gemm_f32_avx512,
+                                __attribute__((target("avx512f"))), __m512,
+                                16, _mm512_loadu_ps, _mm512_storeu_ps,
+                                TL_CPU_FMA_AVX512, _mm512_set1_ps)
+TL_CPU_DEFINE_GEMM_MICRO_KERNEL(gemm_f32_avx2,
+                                __attribute__((target("avx2,fma"))), __m256,
+                                8, _mm256_loadu_ps, _mm256_storeu_ps,
+                                TL_CPU_FMA_AVX2, _mm256_set1_ps)
+
+#undef TL_CPU_FMA_AVX512
+#undef TL_CPU_FMA_AVX2
+
+enum class CpuIsa { kScalar, kAVX2, kAVX512 };
+
+inline CpuIsa detect_isa() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return CpuIsa::kAVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return CpuIsa::kAVX2;
+  return CpuIsa::kScalar;
+}
+
+inline void gemm_f32(const float *A, const float *B, float *C, int M, int N,
+                     int K, int ldc) {
+  static const CpuIsa isa = detect_isa();
+  if (isa == CpuIsa::kAVX512) {
+    gemm_f32_avx512(A, B, C, M, N, K, ldc);
+  } else if (isa == CpuIsa::kAVX2) {
+    gemm_f32_avx2(A, B, C, M, N, K, ldc);
+  } else {
+    gemm_f32_scalar(A, B, C, K, N, ldc, 0, M, 0, N);
+  }
+}
+
+#elif defined(TL_CPU_GEMM_NEON)
+
+#define TL_CPU_FMA_NEON(acc, a, b) vfmaq_f32(acc, a, b)
+
+TL_CPU_DEFINE_GEMM_MICRO_KERNEL(gemm_f32_neon, , float32x4_t, 4, vld1q_f32,
+                                vst1q_f32, TL_CPU_FMA_NEON, vdupq_n_f32)
+
+#undef TL_CPU_FMA_NEON
+
+inline void gemm_f32(const float *A, const float *B, float *C, int M, int N,
+                     int K, int ldc) {
+  gemm_f32_neon(A, B, C, M, N, K, ldc);
+}
+
+#else
+
+inline void gemm_f32(const float *A, const float *B, float *C, int M, int N,
+                     int K, int ldc) {
+  gemm_f32_scalar(A, B, C, K, N, ldc, 0, M, 0, N);
+}
+
+#endif
+
+#undef TL_CPU_DEFINE_GEMM_MICRO_KERNEL
+
+template <typename T>
+constexpr bool is_simd_input =
+    std::is_same<T, float>::value || std::is_same<T, half>::value;
+
+} // namespace cpu_detail
+
+template <int M, int N, int K, bool trans_A, bool trans_B, bool clear_accum,
+          int lda, int ldb, int ldc, typename A_type, typename B_type,
+          typename C_type>
+inline void gemm_ss(A_type *pA, B_type *pB, C_type *pC) {
+  auto a_at = [&](int i, int k) -> A_type {
+    return trans_A ? pA[k * lda + i] : pA[i * lda + k];
+  };
+  auto b_at = [&](int k, int j) -> B_type {
+    return trans_B ? pB[j * ldb + k] : pB[k * ldb + j];
+  };
+  if constexpr (std::is_same<C_type, float>::value &&
+                cpu_detail::is_simd_input<A_type> &&
+                cpu_detail::is_simd_input<B_type>) {
+    float a_pack[M * K];
+    float b_pack[K * N];
+    for (int i = 0; i < M; ++i) {
+      for (int k = 0; k < K; ++k) {
+        a_pack[i * K + k] = static_cast<float>(a_at(i, k));
+      }
+    }
+    for (int k = 0; k < K; ++k) {
+      for (int j = 0; j < N; ++j) {
+        b_pack[k * N + j] = static_cast<float>(b_at(k, j));
+      }
+    }
+    if constexpr (clear_accum) {
+      for (int i = 0; i < M; ++i) {
+        memset(pC + i * ldc, 0, N * sizeof(float));
+      }
+    }
+    cpu_detail::gemm_f32(a_pack, b_pack, pC, M, N, K, ldc);
+  } else {
+    for (int i = 0; i < M; ++i) {
+      if constexpr (clear_accum) {
+        for (int j = 0; j < N; ++j) {
+          pC[i * ldc + j] = C_type(0);
+        }
+      }
+      for (int k = 0; k < K; ++k) {
+        const C_type a = static_cast<C_type>(a_at(i, k));
+        for (int j = 0; j < N; ++j) {
+          pC[i * ldc + j] += a * static_cast<C_type>(b_at(k, j));
+        }
+      }
+    }
+  }
+}
+
+} // namespace tl
@@ -4,4 +4,3 @@
 #include <stdbool.h>
 
 // Not Implemented
-F
@@ -1,3 +1,4 @@
 #pragma once
 
-// Not Implemented
+// The CPU tile GEMM is shared with the C++ source backend.
+#include "../cpp/gemm.h"
@@ -725,6 +725,93 @@ AtomicAddx4Ret(dst_dtype *ref, ValType val,
 }
 #endif
 
+template <typename VecT, typename T> TL_DEVICE VecT ToPackedBits(T *val) {
+  return *reinterpret_cast<VecT *>(val);
+}
+
+template <typename VecT> TL_DEVICE VecT ToPackedBits(VecT val) { return val; }
+
+template <int lanes> struct packed16_bits {
+  using type = uint2;
+};
+
+template <> struct packed16_bits<8> {
+  using type = uint4;
+};
+
+// Vectorized atomic addition of 4 or 8 16-bit floats. On sm90+ this is a
+// single red.global.add.v{2,4}.{f16x2,bf16x2} (64 or 128 bits), older
+// targets split it into 32-bit half2/bfloat162 atomics.
+template <int lanes, bool is_half, typename dst_dtype, typename ValType>
+TL_DEVICE void AtomicAddPacked16(dst_dtype *ref, ValType val,
+                                 int memory_order) {
+  static_assert(lanes == 4 || lanes == 8, "Only 4 or 8 lanes are supported");
+  using VecT = typename packed16_bits<lanes>::type;
+  VecT bits = ToPackedBits<VecT>(val);
+  unsigned *words = reinterpret_cast<unsigned *>(&bits);
+#if (defined(__CUDA_ARCH_LIST__) && (__CUDA_ARCH_LIST__ >= 900))
+  // red has no acquire semantics, a fence in front of the relaxed reduction
+  // provides the ordering of the stronger memory orders.
+  if (memory_order != int(cuda::memory_order_relaxed)) {
+    __threadfence();
+  }
+  unsigned long long ref_addr = reinterpret_cast<unsigned long long>(ref);
+  if constexpr (lanes == 8 && is_half) {
+    asm volatile("red.relaxed.gpu.global.add.noftz.v4.f16x2 [%0], "
+                 "{%1,%2,%3,%4};"
+                 :
+                 : "l"(ref_addr), "r"(words[0]), "r"(words[1]), "r"(words[2]),
+                   "r"(words[3])
+                 : "memory");
+  } else if constexpr (lanes == 8) {
+    asm volatile("red.relaxed.gpu.global.add.noftz.v4.bf16x2 [%0], "
+                 "{%1,%2,%3,%4};"
+                 :
+                 : "l"(ref_addr), "r"(words[0]), "r"(words[1]), "r"(words[2]),
+                   "r"(words[3])
+                 : "memory");
+  } else if constexpr (is_half) {
+    asm volatile("red.relaxed.gpu.global.add.noftz.v2.f16x2 [%0], {%1,%2};"
+                 :
+                 : "l"(ref_addr), "r"(words[0]), "r"(words[1])
+                 : "memory");
+  } else {
+    asm volatile("red.relaxed.gpu.global.add.noftz.v2.bf16x2 [%0], {%1,%2};"
+                 :
+                 : "l"(ref_addr), "r"(words[0]), "r"(words[1])
+                 : "memory");
+  }
+#else
+  for (int i = 0; i < lanes / 2; i++) {
+    AtomicAddx2(ref + 2 * i, words + i, memory_order);
+  }
+#endif
+}
+
+template <typename ValType>
+TL_DEVICE void AtomicAddx4(half_t *ref, ValType val,
+                           int memory_order = int(cuda::memory_order_relaxed)) {
+  AtomicAddPacked16<4, true>(ref, val, memory_order);
+}
+
+template <typename ValType>
+TL_DEVICE void AtomicAddx4(bfloat16_t *ref, ValType val,
+                           int memory_order = int(cuda::memory_order_relaxed)) {
+  AtomicAddPacked16<4, false>(ref, val, memory_order);
+}
+
+template <typename ValType>
+TL_DEVICE void AtomicAddx8(half_t *ref, ValType val,
+                           int memory_order = int(cuda::memory_order_relaxed)) {
+  AtomicAddPacked16<8, true>(ref, val, memory_order);
+}
+
+template <typename ValType>
+TL_DEVICE void AtomicAddx8(bfloat16_t *ref, ValType val,
+                           int memory_order = int(cuda::memory_order_relaxed)) {
+  AtomicAddPacked16<8, false>(ref, val, memory_order);
+}
+
 template <typename T> TL_DEVICE T AtomicLoad(T *ref, int memory_order) {
 #if CUDART_VERSION >= 11080
   cuda::atomic_ref<T, cuda::thread_scope_device> aref(*ref);
@@ -744,3 +831,100 @@ TL_DEVICE void AtomicStore(T1 *ref, T2 value, int memory_order) {
   TL_NOT_IMPLEMENTED();
 #endif
 }
+
+// Warp aggregated atomics, emitted for the calls marked by the
+// AggregateAtomics pass: the active lanes updating the same address combine
+// their values with shuffles and only the lowest of them issues the atomic.
+template <typename T> struct aggregate_atomic_type {
+  using type = T;
+};
+
+template <> struct aggregate_atomic_type<half_t> {
+  using type = float;
+};
+
+template <> struct aggregate_atomic_type<bfloat16_t> {
+  using type = float;
+};
+
+struct AggregateAddOp {
+  template <typename T> TL_DEVICE T operator()(T a, T b) const {
+    return a + b;
+  }
+};
+
+struct AggregateMaxOp {
+  template <typename T> TL_DEVICE T operator()(T a, T b) const {
+    return b > a ? b : a;
+  }
+};
+
+struct AggregateMinOp {
+  template <typename T> TL_DEVICE T operator()(T a, T b) const {
+    return b < a ? b : a;
+  }
+};
+
+// Combines `val` over the active lanes whose `address` is the same, returns
+// whether this lane holds the result and must apply it.
+template <typename T, typename Op>
+TL_DEVICE bool WarpAggregate(const void *address, T &val, Op op) {
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 700)
+  unsigned mask = __activemask();
+  unsigned peers =
+      __match_any_sync(mask, reinterpret_cast<unsigned long long>(address));
+  unsigned lane;
+  asm volatile("mov.u32 %0, %%laneid;" : "=r"(lane));
+  unsigned below = peers & ((1u << lane) - 1);
+  // Pairwise tree over the peers ordered by lane: in round k, the peers of
+  // rank 2^k * (2j + 1) have handed their partial result to the next
+  // remaining peer below them and drop out.
+  unsigned rank = __popc(below);
+  unsigned above = peers & ~((2u << lane) - 1);
+  while (__any_sync(mask, above)) {
+    int next = __ffs(above);
+    T other = __shfl_sync(mask, val, next - 1);
+    if (next) {
+      val = op(val, other);
+    }
+    above &= ~__ballot_sync(mask, rank & 1);
+    rank >>= 1;
+  }
+  return below == 0;
+#else
+  return true;
+#endif
+}
+
+template <typename T1, typename T2>
+TL_DEVICE void
+AtomicAddAggregated(T1 *address, T2 val,
+                    int memory_order = int(cuda::memory_order_relaxed)) {
+  using AT = typename aggregate_atomic_type<T1>::type;
+  AT acc = static_cast<AT>(val);
+  if (WarpAggregate(address, acc, AggregateAddOp{})) {
+    AtomicAdd(address, acc, memory_order);
+  }
+}
+
+template <typename T1, typename T2>
+TL_DEVICE void
+AtomicMaxAggregated(T1 *address, T2 val,
+                    int memory_order = int(cuda::memory_order_relaxed)) {
+  using AT = typename aggregate_atomic_type<T1>::type;
+  AT acc = static_cast<AT>(val);
+  if (WarpAggregate(address, acc, AggregateMaxOp{})) {
+    AtomicMax(address, static_cast<T1>(acc), memory_order);
+  }
+}
+
+template <typename T1, typename T2>
+TL_DEVICE void
+AtomicMinAggregated(T1 *address, T2 val,
+                    int memory_order = int(cuda::memory_order_relaxed)) {
+  using AT = typename aggregate_atomic_type<T1>::type;
+  AT acc = static_cast<AT>(val);
+  if (WarpAggregate(address, acc, AggregateMinOp{})) {
+    AtomicMin(address, static_cast<T1>(acc), memory_order);
+  }
+}
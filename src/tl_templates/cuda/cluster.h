@@ -0,0 +1,109 @@
+#pragma once
+
+#include "common.h"
+
+// Thread block cluster primitives and reductions over distributed shared
+// memory (DSMEM). Kernels using them must be launched with a cluster, see
+// `T.Kernel(..., cluster_dims=...)`.
+
+namespace tl {
+
+#if (defined(__CUDA_ARCH_LIST__) && (__CUDA_ARCH_LIST__ >= 900))
+
+TL_DEVICE uint32_t cluster_ctarank() {
+  uint32_t rank;
+  asm volatile("mov.u32 %0, %%cluster_ctarank;\n" : "=r"(rank) :);
+  return rank;
+}
+
+TL_DEVICE uint32_t cluster_nctarank() {
+  uint32_t num_ranks;
+  asm volatile("mov.u32 %0, %%cluster_nctarank;\n" : "=r"(num_ranks) :);
+  return num_ranks;
+}
+
+// Barrier over all threads of the cluster. Shared memory writes before the
+// barrier are visible to every CTA of the cluster after it.
+TL_DEVICE void cluster_sync() {
+  asm volatile("barrier.cluster.arrive.release;\n"
+               "barrier.cluster.wait.acquire;\n" ::
+                   : "memory");
+}
+
+// Load the element at the same shared memory offset as `ptr` in the CTA of
+// rank `rank` of the cluster.
+template <typename T>
+TL_DEVICE T ld_shared_cluster(const T *ptr, uint32_t rank) {
+  static_assert(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+                "ld_shared_cluster supports 16, 32 and 64-bit elements");
+  uint32_t remote_addr;
+  asm volatile("mapa.shared::cluster.u32 %0, %1, %2;\n"
+               : "=r"(remote_addr)
+               : "r"(smem_ptr_to_uint(ptr)), "r"(rank));
+  T value;
+  if constexpr (sizeof(T) == 2) {
+    uint16_t bits;
+    asm volatile("ld.shared::cluster.b16 %0, [%1];\n"
+                 : "=h"(bits)
+                 : "r"(remote_addr)
+                 : "memory");
+    value = *reinterpret_cast<T *>(&bits);
+  } else if constexpr (sizeof(T) == 4) {
+    uint32_t bits;
+    asm volatile("ld.shared::cluster.b32 %0, [%1];\n"
+                 : "=r"(bits)
+                 : "r"(remote_addr)
+                 : "memory");
+    value = *reinterpret_cast<T *>(&bits);
+  } else {
+    uint64_t bits;
+    asm volatile("ld.shared::cluster.b64 %0, [%1];\n"
+                 : "=l"(bits)
+                 : "r"(remote_addr)
+                 : "memory");
+    value = *reinterpret_cast<T *>(&bits);
+  }
+  return value;
+}
+
+// Element-wise all-reduce of per-thread values across the CTAs of a cluster.
+//
+// Thread `t` of every CTA contributes `num_elems` values; afterwards each of
+// them holds the reduction of the values of thread `t` over all CTAs. The
+// values are staged through `workspace` (threads * chunk elements of shared
+// memory) `chunk` elements at a time, and every CTA reduces them in rank
+// order so that all CTAs obtain bitwise identical results.
+//
+// Must be called by all `threads` threads of every CTA of the cluster.
+template <class Reducer, int num_elems, int threads, int thread_offset = 0,
+          int chunk = num_elems>
+struct ClusterAllReduce {
+  static_assert(chunk > 0 && chunk <= num_elems);
+  template <typename T> static TL_DEVICE void run(T *vals, T *workspace) {
+    const int tid = threadIdx.x - thread_offset;
+    const uint32_t num_ranks = cluster_nctarank();
+#pragma unroll
+    for (int base = 0; base < num_elems; base += chunk) {
+#pragma unroll
+      for (int i = 0; i < chunk && base + i < num_elems; ++i) {
+        workspace[i * threads + tid] = vals[base + i];
+      }
+      cluster_sync();
+#pragma unroll
+      for (int i = 0; i < chunk && base + i < num_elems; ++i) {
+        T *slot = workspace + i * threads + tid;
+        T acc = ld_shared_cluster(slot, 0);
+        for (uint32_t rank = 1; rank < num_ranks; ++rank) {
+          acc = Reducer()(acc, ld_shared_cluster(slot, rank));
+        }
+        vals[base + i] = acc;
+      }
+      // The workspace of this CTA may still be read by its peers.
+      cluster_sync();
+    }
+  }
+};
+
+#endif
+
+} // namespace tl
@@ -509,6 +509,17 @@ TL_DEVICE void __sync_thread_partial() {
   asm volatile("bar.sync %0, %1;" : : "r"(barrier_id), "r"(thread_count));
 }
 
+// Named barriers whose id is only known at runtime, e.g. one per warpgroup
+TL_DEVICE void named_barrier_sync(int barrier_id, int thread_count) {
+  asm volatile("bar.sync %0, %1;" : : "r"(barrier_id), "r"(thread_count)
+               : "memory");
+}
+
+TL_DEVICE void named_barrier_arrive(int barrier_id, int thread_count) {
+  asm volatile("bar.arrive %0, %1;" : : "r"(barrier_id), "r"(thread_count)
+               : "memory");
+}
+
 template <int layout_type = 0, int leading_byte_offset = 0,
           int stride_byte_offset = 0, typename T>
 TL_DEVICE void initialize_wgmma_descriptor(GmmaDescriptor &descriptor,
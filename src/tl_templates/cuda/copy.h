@@ -11,6 +11,19 @@
 #endif
 #endif
 
+// Ask cp.async to also prefetch the rest of the 128-byte L2 segment of the
+// source. The hint never faults, and rows copied by consecutive threads then
+// reach L2 in one request instead of one per 16 bytes.
+#ifndef TL_ENABLE_L2_PREFETCH
+#define TL_ENABLE_L2_PREFETCH 1
+#endif
+
+#if TL_ENABLE_L2_PREFETCH
+#define TL_CP_ASYNC_L2_PREFETCH ".L2::128B"
+#else
+#define TL_CP_ASYNC_L2_PREFETCH ""
+#endif
+
 namespace tl {
 
 TL_DEVICE void cp_async_commit() {
@@ -25,57 +38,167 @@ template <int N> TL_DEVICE void cp_async_wait() {
   }
 }
 
-template <int N>
+// L2 access policies for the cache hint of SIMT copies (the eviction_policy
+// annotation: 1=evict_first, 2=evict_last, 3=no_allocate), in the encoding
+// produced by createpolicy.fractional with a fraction of 1.0.
+template <int kCacheHint> TL_DEVICE constexpr uint64_t cache_policy() {
+  return kCacheHint == 2 ? 0x14F0000000000000ull : 0x12F0000000000000ull;
+}
+
+// Bring the cache line holding `ptr` into L2.
+TL_DEVICE void prefetch_l2(void const *ptr) {
+  asm volatile("prefetch.global.L2 [%0];" ::"l"(ptr));
+}
+
+template <int N, int kCacheHint = 0>
 TL_DEVICE void cp_async_gs(void const *const smem_addr,
                            void const *global_ptr) {
   static_assert(N == 16 || N == 8 || N == 4);
   unsigned int addr = smem_ptr_to_uint(smem_addr);
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800)
+  if constexpr (kCacheHint != 0) {
+    if constexpr (N == 16) {
+      asm volatile(
+          "cp.async.cg.shared.global.L2::cache_hint" TL_CP_ASYNC_L2_PREFETCH
+          " [%0], [%1], %2, %3;" ::"r"(addr),
+          "l"((void const *)(global_ptr)), "n"(N),
+          "l"(cache_policy<kCacheHint>()));
+    } else {
+      asm volatile(
+          "cp.async.ca.shared.global.L2::cache_hint" TL_CP_ASYNC_L2_PREFETCH
+          " [%0], [%1], %2, %3;" ::"r"(addr),
+          "l"((void const *)(global_ptr)), "n"(N),
+          "l"(cache_policy<kCacheHint>()));
+    }
+    return;
+  }
+#endif
   if constexpr (N == 16) {
     asm volatile(
-#if TL_ENABLE_L2_PREFETCH
-        "cp.async.cg.shared.global.L2::128B [%0], [%1], %2;"
-#else
-        "cp.async.cg.shared.global [%0], [%1], %2;"
-#endif
-        ::"r"(addr),
+        "cp.async.cg.shared.global" TL_CP_ASYNC_L2_PREFETCH
+        " [%0], [%1], %2;" ::"r"(addr),
         "l"((void const *)(global_ptr)), "n"(N));
   } else {
     asm volatile(
-#if TL_ENABLE_L2_PREFETCH
-        "cp.async.ca.shared.global.L2::128B [%0], [%1], %2;"
-#else
-        "cp.async.ca.shared.global [%0], [%1], %2;"
-#endif
-        ::"r"(addr),
+        "cp.async.ca.shared.global" TL_CP_ASYNC_L2_PREFETCH
+        " [%0], [%1], %2;" ::"r"(addr),
         "l"((void const *)(global_ptr)), "n"(N));
   }
 }
 
-template <int N>
+template <int N, int kCacheHint = 0>
 TL_DEVICE void cp_async_gs_conditional(void const *const smem_addr,
                                        void const *global_ptr, bool cond) {
   static_assert(N == 16 || N == 8 || N == 4);
   int bytes = cond ? N : 0;
   unsigned int addr = smem_ptr_to_uint(smem_addr);
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800)
+  if constexpr (kCacheHint != 0) {
+    if constexpr (N == 16) {
+      asm volatile(
+          "cp.async.cg.shared.global.L2::cache_hint" TL_CP_ASYNC_L2_PREFETCH
+          " [%0], [%1], %2, %3, %4;" ::"r"(addr),
+          "l"((void const *)(global_ptr)), "n"(N), "r"(bytes),
+          "l"(cache_policy<kCacheHint>()));
+    } else {
+      asm volatile(
+          "cp.async.ca.shared.global.L2::cache_hint" TL_CP_ASYNC_L2_PREFETCH
+          " [%0], [%1], %2, %3, %4;" ::"r"(addr),
+          "l"((void const *)(global_ptr)), "n"(N), "r"(bytes),
+          "l"(cache_policy<kCacheHint>()));
+    }
+    return;
+  }
+#endif
   if constexpr (N == 16) {
     asm volatile(
-#if TL_ENABLE_L2_PREFETCH
-        "cp.async.cg.shared.global.L2::128B [%0], [%1], %2, %3;"
-#else
-        "cp.async.cg.shared.global [%0], [%1], %2, %3;"
-#endif
-        ::"r"(addr),
+        "cp.async.cg.shared.global" TL_CP_ASYNC_L2_PREFETCH
+        " [%0], [%1], %2, %3;" ::"r"(addr),
         "l"((void const *)(global_ptr)), "n"(N), "r"(bytes));
   } else {
     asm volatile(
-#if TL_ENABLE_L2_PREFETCH
-        "cp.async.ca.shared.global.L2::128B [%0], [%1], %2, %3;"
-#else
-        "cp.async.ca.shared.global [%0], [%1], %2, %3;"
-#endif
-        ::"r"(addr),
+        "cp.async.ca.shared.global" TL_CP_ASYNC_L2_PREFETCH
+        " [%0], [%1], %2, %3;" ::"r"(addr),
         "l"((void const *)(global_ptr)), "n"(N), "r"(bytes));
   }
 }
 
+#define TL_LD_GLOBAL_HINT(L1)                                                  \
+  if constexpr (sizeof(T) == 16) {                                             \
+    uint4 r;                                                                   \
+    asm volatile("ld.global" L1 ".L2::cache_hint.v4.u32 {%0, %1, %2, %3}, "    \
+                 "[%4], %5;"                                                   \
+                 : "=r"(r.x), "=r"(r.y), "=r"(r.z), "=r"(r.w)                  \
+                 : "l"(ptr), "l"(policy));                                     \
+    return *reinterpret_cast<T *>(&r);                                         \
+  } else if constexpr (sizeof(T) == 8) {                                       \
+    uint2 r;                                                                   \
+    asm volatile("ld.global" L1 ".L2::cache_hint.v2.u32 {%0, %1}, [%2], %3;"   \
+                 : "=r"(r.x), "=r"(r.y)                                        \
+                 : "l"(ptr), "l"(policy));                                     \
+    return *reinterpret_cast<T *>(&r);                                         \
+  } else if constexpr (sizeof(T) == 4) {                                       \
+    uint32_t r;                                                                \
+    asm volatile("ld.global" L1 ".L2::cache_hint.u32 %0, [%1], %2;"            \
+                 : "=r"(r)                                                     \
+                 : "l"(ptr), "l"(policy));                                     \
+    return *reinterpret_cast<T *>(&r);                                         \
+  } else if constexpr (sizeof(T) == 2) {                                       \
+    uint16_t r;                                                                \
+    asm volatile("ld.global" L1 ".L2::cache_hint.u16 %0, [%1], %2;"            \
+                 : "=h"(r)                                                     \
+                 : "l"(ptr), "l"(policy));                                     \
+    return *reinterpret_cast<T *>(&r);                                         \
+  }
+
+// Global load carrying the L2 policy of kCacheHint, no_allocate also skips
+// the L1 allocation. Falls back to a plain load before sm_80 and for sizes
+// without a matching ld variant.
+template <int kCacheHint, typename T>
+TL_DEVICE T ld_global_hint(const T *ptr) {
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800)
+  constexpr uint64_t policy = cache_policy<kCacheHint>();
+  if constexpr (kCacheHint == 3) {
+    TL_LD_GLOBAL_HINT(".L1::no_allocate")
+  } else {
+    TL_LD_GLOBAL_HINT("")
+  }
+#endif
+  return *ptr;
+}
+
+#undef TL_LD_GLOBAL_HINT
+
+// Global store carrying the L2 policy of kCacheHint.
+template <int kCacheHint, typename T, typename V>
+TL_DEVICE void st_global_hint(T *ptr, const V &value) {
+  T v = value;
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800)
+  constexpr uint64_t policy = cache_policy<kCacheHint>();
+  if constexpr (sizeof(T) == 16) {
+    const uint4 &r = *reinterpret_cast<const uint4 *>(&v);
+    asm volatile(
+        "st.global.L2::cache_hint.v4.u32 [%0], {%1, %2, %3, %4}, %5;" ::"l"(
+            ptr),
+        "r"(r.x), "r"(r.y), "r"(r.z), "r"(r.w), "l"(policy));
+    return;
+  } else if constexpr (sizeof(T) == 8) {
+    const uint2 &r = *reinterpret_cast<const uint2 *>(&v);
+    asm volatile("st.global.L2::cache_hint.v2.u32 [%0], {%1, %2}, %3;" ::"l"(
+                     ptr),
+                 "r"(r.x), "r"(r.y), "l"(policy));
+    return;
+  } else if constexpr (sizeof(T) == 4) {
+    asm volatile("st.global.L2::cache_hint.u32 [%0], %1, %2;" ::"l"(ptr),
+                 "r"(*reinterpret_cast<const uint32_t *>(&v)), "l"(policy));
+    return;
+  } else if constexpr (sizeof(T) == 2) {
+    asm volatile("st.global.L2::cache_hint.u16 [%0], %1, %2;" ::"l"(ptr),
+                 "h"(*reinterpret_cast<const uint16_t *>(&v)), "l"(policy));
+    return;
+  }
+#endif
+  *ptr = v;
+}
+
 } // namespace tl
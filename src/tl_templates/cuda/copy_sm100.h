@@ -1,10 +1,38 @@
 #pragma once
+#include "copy_sm90.h"
 #include "cuda_fp8.h"
 #include "tcgen_05.h"
 #include "tcgen_05_ld.h"
 
 namespace tl {
 
+// Loads the rows row0..row3 of a 2D tensor map, starting at column col, into
+// four consecutive box rows of shared memory.
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void
+tma_load_gather4(const CUtensorMap &descriptor, BarrierType &smem_mbar,
+                 void const *const smem_ptr, int32_t const &col,
+                 int32_t const &row0, int32_t const &row1, int32_t const &row2,
+                 int32_t const &row3) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar;
+  if constexpr (std::is_pointer_v<BarrierType>) {
+    smem_int_mbar = smem_ptr_to_uint(reinterpret_cast<uint64_t *>(smem_mbar));
+  } else {
+    smem_int_mbar = smem_ptr_to_uint(reinterpret_cast<uint64_t *>(&smem_mbar));
+  }
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.2d.shared::cluster.global.tile::gather4."
+               "mbarrier::complete_tx::bytes.L2::cache_hint"
+               " [%0], [%1, {%3, %4, %5, %6, %7}], [%2], %8;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "r"(col), "r"(row0), "r"(row1), "r"(row2), "r"(row3),
+                 "l"(cache_hint)
+               : "memory");
+}
+
 // 256-bit load for longlong4
 __device__ __forceinline__ longlong4 ld_global_256(const longlong4 *ptr) {
   longlong4 ret;
@@ -215,40 +243,46 @@ __device__ __forceinline__ void tcgen05_ld_core(uint32_t const &tmem_start_col,
   }
 }
 
-template <int N, bool pack16, typename dst_t>
+// Without `wait` the caller issues tcgen05.wait::ld itself, so that the load
+// overlaps whatever runs in between
+template <int N, bool pack16, bool wait = true, typename dst_t>
 __device__ __forceinline__ void
 tcgen05_ld_32dp32bNx(uint32_t const &tmem_start_col,
                      uint32_t const &tmem_col_offset, dst_t *dst_ptr) {
   tcgen05_ld_core<tl::tmem_ld_32dp32bNx<pack16>, 7, N>(
       tmem_start_col + tmem_col_offset, dst_ptr);
-  tl::fence_view_async_tmem_load();
+  if constexpr (wait)
+    tl::fence_view_async_tmem_load();
 }
 
-template <int N, bool pack16, typename dst_t>
+template <int N, bool pack16, bool wait = true, typename dst_t>
 __device__ __forceinline__ void
 tcgen05_ld_32dp64bNx(uint32_t const &tmem_start_col,
                      uint32_t const &tmem_col_offset, dst_t *dst_ptr) {
   tcgen05_ld_core<tl::tmem_ld_32dp64bNx<pack16>, 7, N>(
       tmem_start_col + tmem_col_offset, dst_ptr);
-  tl::fence_view_async_tmem_load();
+  if constexpr (wait)
+    tl::fence_view_async_tmem_load();
 }
 
-template <int N, bool pack16, typename dst_t>
+template <int N, bool pack16, bool wait = true, typename dst_t>
 __device__ __forceinline__ void
 tcgen05_ld_32dp128bNx(uint32_t const &tmem_start_col,
                       uint32_t const &tmem_col_offset, dst_t *dst_ptr) {
   tcgen05_ld_core<tl::tmem_ld_32dp128bNx<pack16>, 6, N>(
       tmem_start_col + tmem_col_offset, dst_ptr);
-  tl::fence_view_async_tmem_load();
+  if constexpr (wait)
+    tl::fence_view_async_tmem_load();
 }
 
-template <int N, bool pack16, typename dst_t>
+template <int N, bool pack16, bool wait = true, typename dst_t>
 __device__ __forceinline__ void
 tcgen05_ld_32dp256bNx(uint32_t const &tmem_start_col,
                       uint32_t const &tmem_col_offset, dst_t *dst_ptr) {
   tcgen05_ld_core<tl::tmem_ld_32dp256bNx<pack16>, 5, N>(
       tmem_start_col + tmem_col_offset, dst_ptr);
-  tl::fence_view_async_tmem_load();
+  if constexpr (wait)
+    tl::fence_view_async_tmem_load();
 }
 
 } // namespace tl
@@ -5,6 +5,7 @@
 #endif
 
 #include "barrier.h"
+#include "cluster.h"
 #include "common.h"
 
 namespace tl {
@@ -26,10 +27,29 @@ TL_DEVICE void tma_load(void *smem_ptr, void const *gmem_ptr,
                :);
 }
 
-TL_DEVICE void tma_load_multicast(void *smem_ptr, void *gmem_ptr,
-                                  uint64_t &smem_mbar, uint32_t size,
+// CTAs of a cluster issuing a multicast load elect the lowest rank of the
+// mask to issue it.
+TL_DEVICE bool is_multicast_leader(uint16_t mask) {
+  return cluster_ctarank() == static_cast<uint32_t>(__ffs(mask) - 1);
+}
+
+template <typename BarrierType>
+TL_DEVICE uint32_t mbarrier_smem_uint(BarrierType &smem_mbar) {
+  if constexpr (std::is_pointer_v<BarrierType>) {
+    return smem_ptr_to_uint(reinterpret_cast<uint64_t *>(smem_mbar));
+  } else {
+    return smem_ptr_to_uint(reinterpret_cast<uint64_t *>(&smem_mbar));
+  }
+}
+
+// Multicast load: the data is written to the same shared memory offset of
+// every CTA in `mask` and completes the transaction on the mbarrier at the
+// same offset of each of them.
+template <typename BarrierType = uint64_t>
+TL_DEVICE void tma_load_multicast(void *smem_ptr, void const *gmem_ptr,
+                                  BarrierType &smem_mbar, uint32_t size,
                                   uint16_t mask) {
-  uint32_t smem_int_mbar = smem_ptr_to_uint(&smem_mbar);
+  uint32_t smem_int_mbar = mbarrier_smem_uint(smem_mbar);
   uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
   asm volatile(
       "cp.async.bulk.shared::cluster.global.mbarrier::complete_tx::bytes."
@@ -149,6 +169,126 @@ TL_DEVICE void tma_load(const CUtensorMap &descriptor, BarrierType &smem_mbar,
                : "memory");
 }
 
+// Multicast variants of the tensor loads above, see tma_load_multicast for
+// the bulk copy.
+
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void tma_load_multicast(const CUtensorMap &descriptor,
+                                  BarrierType &smem_mbar,
+                                  void const *const smem_ptr, uint16_t mask,
+                                  int32_t const &crd0) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar = mbarrier_smem_uint(smem_mbar);
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.1d.shared::cluster.global.mbarrier::"
+               "complete_tx::bytes.multicast::cluster.L2::cache_hint"
+               " [%0], [%1, {%4}], [%2], %3, %5;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "h"(mask), "r"(crd0), "l"(cache_hint)
+               : "memory");
+}
+
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void tma_load_multicast(const CUtensorMap &descriptor,
+                                  BarrierType &smem_mbar,
+                                  void const *const smem_ptr, uint16_t mask,
+                                  int32_t const &crd0, int32_t const &crd1) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar = mbarrier_smem_uint(smem_mbar);
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.2d.shared::cluster.global.mbarrier::"
+               "complete_tx::bytes.multicast::cluster.L2::cache_hint"
+               " [%0], [%1, {%4, %5}], [%2], %3, %6;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "h"(mask), "r"(crd0), "r"(crd1), "l"(cache_hint)
+               : "memory");
+}
+
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void tma_load_multicast(const CUtensorMap &descriptor,
+                                  BarrierType &smem_mbar,
+                                  void const *const smem_ptr, uint16_t mask,
+                                  int32_t const &crd0, int32_t const &crd1,
+                                  int32_t const &crd2) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar = mbarrier_smem_uint(smem_mbar);
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.3d.shared::cluster.global.mbarrier::"
+               "complete_tx::bytes.multicast::cluster.L2::cache_hint"
+               " [%0], [%1, {%4, %5, %6}], [%2], %3, %7;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "h"(mask), "r"(crd0), "r"(crd1), "r"(crd2), "l"(cache_hint)
+               : "memory");
+}
+
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void tma_load_multicast(const CUtensorMap &descriptor,
+                                  BarrierType &smem_mbar,
+                                  void const *const smem_ptr, uint16_t mask,
+                                  int32_t const &crd0, int32_t const &crd1,
+                                  int32_t const &crd2, int32_t const &crd3) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar = mbarrier_smem_uint(smem_mbar);
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.4d.shared::cluster.global.mbarrier::"
+               "complete_tx::bytes.multicast::cluster.L2::cache_hint"
+               " [%0], [%1, {%4, %5, %6, %7}], [%2], %3, %8;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "h"(mask), "r"(crd0), "r"(crd1), "r"(crd2), "r"(crd3),
+                 "l"(cache_hint)
+               : "memory");
+}
+
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void tma_load_multicast(const CUtensorMap &descriptor,
+                                  BarrierType &smem_mbar,
+                                  void const *const smem_ptr, uint16_t mask,
+                                  int32_t const &crd0, int32_t const &crd1,
+                                  int32_t const &crd2, int32_t const &crd3,
+                                  int32_t const &crd4) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar = mbarrier_smem_uint(smem_mbar);
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.5d.shared::cluster.global.mbarrier::"
+               "complete_tx::bytes.multicast::cluster.L2::cache_hint"
+               " [%0], [%1, {%4, %5, %6, %7, %8}], [%2], %3, %9;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "h"(mask), "r"(crd0), "r"(crd1), "r"(crd2), "r"(crd3),
+                 "r"(crd4), "l"(cache_hint)
+               : "memory");
+}
+
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void
+tma_load_im2col(const CUtensorMap &descriptor, BarrierType &smem_mbar,
+                void const *const smem_ptr, int32_t const &coord_c,
+                int32_t const &coord_w, int32_t const &coord_n,
+                uint16_t const &offset_w) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar =
+      smem_ptr_to_uint(reinterpret_cast<uint64_t *>(&smem_mbar));
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.3d.shared::cluster.global.im2col.mbarrier:"
+               ":complete_tx::bytes.L2::cache_hint"
+               " [%0], [%1, {%3, %4, %5}], [%2], {%6}, %7;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "r"(coord_c), "r"(coord_w), "r"(coord_n), "h"(offset_w),
+                 "l"(cache_hint)
+               : "memory");
+}
+
 template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
           typename BarrierType = uint64_t>
 TL_DEVICE void
@@ -171,6 +311,30 @@ tma_load_im2col(const CUtensorMap &descriptor, BarrierType &smem_mbar,
                : "memory");
 }
 
+template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL,
+          typename BarrierType = uint64_t>
+TL_DEVICE void
+tma_load_im2col(const CUtensorMap &descriptor, BarrierType &smem_mbar,
+                void const *const smem_ptr, int32_t const &coord_c,
+                int32_t const &coord_w, int32_t const &coord_h,
+                int32_t const &coord_d, int32_t const &coord_n,
+                uint16_t const &offset_w, uint16_t const &offset_h,
+                uint16_t const &offset_d) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  uint32_t smem_int_mbar =
+      smem_ptr_to_uint(reinterpret_cast<uint64_t *>(&smem_mbar));
+  uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
+  asm volatile("cp.async.bulk.tensor.5d.shared::cluster.global.im2col.mbarrier:"
+               ":complete_tx::bytes.L2::cache_hint"
+               " [%0], [%1, {%3, %4, %5, %6, %7}], [%2], {%8, %9, %10}, %11;"
+               :
+               : "r"(smem_int_ptr), "l"(gmem_int_desc), "r"(smem_int_mbar),
+                 "r"(coord_c), "r"(coord_w), "r"(coord_h), "r"(coord_d),
+                 "r"(coord_n), "h"(offset_w), "h"(offset_h), "h"(offset_d),
+                 "l"(cache_hint)
+               : "memory");
+}
+
 template <CacheHintSm90 cache_hint = CacheHintSm90::EVICT_NORMAL>
 TL_DEVICE void tma_store(void *gmem_ptr, void *smem_ptr, uint32_t size) {
   uint32_t smem_int_ptr = smem_ptr_to_uint(smem_ptr);
@@ -330,9 +494,193 @@ TL_DEVICE void tma_store_add(const CUtensorMap &descriptor,
       : "memory");
 }
 
+// L2 prefetch of the box of a tensor descriptor at the given coordinates.
+// Nothing lands in shared memory and no mbarrier tracks it.
+TL_DEVICE void tma_prefetch(const CUtensorMap &descriptor,
+                            int32_t const &crd0) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  asm volatile("cp.async.bulk.prefetch.tensor.1d.L2.global.tile [%0, {%1}];"
+               :
+               : "l"(gmem_int_desc), "r"(crd0)
+               : "memory");
+}
+
+TL_DEVICE void tma_prefetch(const CUtensorMap &descriptor, int32_t const &crd0,
+                            int32_t const &crd1) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  asm volatile(
+      "cp.async.bulk.prefetch.tensor.2d.L2.global.tile [%0, {%1, %2}];"
+      :
+      : "l"(gmem_int_desc), "r"(crd0), "r"(crd1)
+      : "memory");
+}
+
+TL_DEVICE void tma_prefetch(const CUtensorMap &descriptor, int32_t const &crd0,
+                            int32_t const &crd1, int32_t const &crd2) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  asm volatile(
+      "cp.async.bulk.prefetch.tensor.3d.L2.global.tile [%0, {%1, %2, %3}];"
+      :
+      : "l"(gmem_int_desc), "r"(crd0), "r"(crd1), "r"(crd2)
+      : "memory");
+}
+
+TL_DEVICE void tma_prefetch(const CUtensorMap &descriptor, int32_t const &crd0,
+                            int32_t const &crd1, int32_t const &crd2,
+                            int32_t const &crd3) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  asm volatile("cp.async.bulk.prefetch.tensor.4d.L2.global.tile "
+               "[%0, {%1, %2, %3, %4}];"
+               :
+               : "l"(gmem_int_desc), "r"(crd0), "r"(crd1), "r"(crd2),
+                 "r"(crd3)
+               : "memory");
+}
+
+TL_DEVICE void tma_prefetch(const CUtensorMap &descriptor, int32_t const &crd0,
+                            int32_t const &crd1, int32_t const &crd2,
+                            int32_t const &crd3, int32_t const &crd4) {
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
+  asm volatile("cp.async.bulk.prefetch.tensor.5d.L2.global.tile "
+               "[%0, {%1, %2, %3, %4, %5}];"
+               :
+               : "l"(gmem_int_desc), "r"(crd0), "r"(crd1), "r"(crd2),
+                 "r"(crd3), "r"(crd4)
+               : "memory");
+}
+
+// L2 prefetch of `bytes` contiguous bytes, both multiples of 16.
+TL_DEVICE void bulk_prefetch_l2(void const *gmem_ptr, uint32_t bytes) {
+  asm volatile("cp.async.bulk.prefetch.L2.global [%0], %1;"
+               :
+               : "l"(gmem_ptr), "r"(bytes)
+               : "memory");
+}
+
 TL_DEVICE void prefetch_tma_descriptor(const CUtensorMap &descriptor) {
   uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(&descriptor);
   asm volatile("prefetch.tensormap [%0];" : : "l"(gmem_int_desc) : "memory");
 }
 
+template <int kOrd>
+TL_DEVICE void tensormap_replace_global_dim(uint64_t desc, int32_t extent) {
+  asm volatile(
+      "tensormap.replace.tile.global_dim.global.b1024.b32 [%0], %1, %2;"
+      :
+      : "l"(desc), "n"(kOrd), "r"(extent)
+      : "memory");
+}
+
+template <int kOrd>
+TL_DEVICE void tensormap_replace_global_stride(uint64_t desc, int64_t stride) {
+  asm volatile(
+      "tensormap.replace.tile.global_stride.global.b1024.b64 [%0], %1, %2;"
+      :
+      : "l"(desc), "n"(kOrd), "l"(stride)
+      : "memory");
+}
+
+// Copy a host-encoded descriptor into a 128-byte aligned global workspace and
+// patch its global base address on the device, given as a pointer or as an
+// integer address. Only the fields that change are rewritten, so the
+// host-side cuTensorMapEncode* call is not repeated. The optional `fields` are
+// the rank global extents, innermost first, followed by the rank - 1 byte
+// strides of the outer dimensions.
+template <typename AddrT, typename... Fields>
+TL_DEVICE const CUtensorMap &
+tma_descriptor_replace_address(void *workspace, const CUtensorMap &tmpl,
+                               AddrT global_address, Fields... fields) {
+  static_assert(sizeof(CUtensorMap) == 8 * sizeof(uint4));
+  constexpr int kRank = (sizeof...(Fields) + 1) / 2;
+  static_assert(sizeof...(Fields) == 0 || sizeof...(Fields) == 2 * kRank - 1,
+                "expects rank extents and rank - 1 strides");
+  const uint4 *src = reinterpret_cast<const uint4 *>(&tmpl);
+  uint4 *dst = reinterpret_cast<uint4 *>(workspace);
+#pragma unroll
+  for (int i = 0; i < 8; ++i) {
+    dst[i] = src[i];
+  }
+  uint64_t gmem_int_desc = reinterpret_cast<uint64_t>(workspace);
+  uint64_t new_addr = (uint64_t)(global_address);
+  asm volatile(
+      "tensormap.replace.tile.global_address.global.b1024.b64 [%0], %1;"
+      :
+      : "l"(gmem_int_desc), "l"(new_addr)
+      : "memory");
+  if constexpr (sizeof...(Fields) > 0) {
+    int64_t values[] = {static_cast<int64_t>(fields)...};
+    // The ordinal of a field must be an immediate, hence the unrolled chain.
+    tensormap_replace_global_dim<0>(gmem_int_desc, values[0]);
+    if constexpr (kRank > 1) {
+      tensormap_replace_global_dim<1>(gmem_int_desc, values[1]);
+      tensormap_replace_global_stride<0>(gmem_int_desc, values[kRank]);
+    }
+    if constexpr (kRank > 2) {
+      tensormap_replace_global_dim<2>(gmem_int_desc, values[2]);
+      tensormap_replace_global_stride<1>(gmem_int_desc, values[kRank + 1]);
+    }
+    if constexpr (kRank > 3) {
+      tensormap_replace_global_dim<3>(gmem_int_desc, values[3]);
+      tensormap_replace_global_stride<2>(gmem_int_desc, values[kRank + 2]);
+    }
+    if constexpr (kRank > 4) {
+      tensormap_replace_global_dim<4>(gmem_int_desc, values[4]);
+      tensormap_replace_global_stride<3>(gmem_int_desc, values[kRank + 3]);
+    }
+  }
+  asm volatile("fence.proxy.tensormap::generic.release.gpu;" ::: "memory");
+  asm volatile("fence.proxy.tensormap::generic.acquire.gpu [%0], 128;"
+               :
+               : "l"(gmem_int_desc)
+               : "memory");
+  return *reinterpret_cast<const CUtensorMap *>(workspace);
+}
+
+// Copies `bytes` bytes from `src` to `dst` in global memory through two
+// shared memory chunks of kChunkBytes: the load of chunk c + 1 is in flight
+// while chunk c is stored. Issued by a single thread. `smem` holds the two
+// mbarriers of the loads in its first 128 bytes, followed by the chunks.
+// Addresses and sizes are multiples of 16 bytes.
+template <int kChunkBytes>
+TL_DEVICE void bulk_copy_g2g(void *dst, void const *src, int64_t bytes,
+                             void *smem) {
+  uint64_t *bars = reinterpret_cast<uint64_t *>(smem);
+  char *chunks = reinterpret_cast<char *>(smem) + 128;
+  int64_t num_chunks = (bytes + kChunkBytes - 1) / kChunkBytes;
+  auto chunk_size = [&](int64_t c) {
+    int64_t rest = bytes - c * kChunkBytes;
+    return static_cast<uint32_t>(rest < kChunkBytes ? rest : kChunkBytes);
+  };
+  auto load = [&](int64_t c) {
+    mbarrier_arrive_expect_tx(bars[c & 1], chunk_size(c));
+    tma_load(chunks + (c & 1) * kChunkBytes,
+             reinterpret_cast<char const *>(src) + c * kChunkBytes,
+             bars[c & 1], chunk_size(c));
+  };
+  mbarrier_init(bars[0], 1);
+  mbarrier_init(bars[1], 1);
+  fence_barrier_init();
+  if (num_chunks > 0)
+    load(0);
+  for (int64_t c = 0; c < num_chunks; ++c) {
+    if (c + 1 < num_chunks) {
+      // The store of chunk c - 1 is done reading the chunk loaded next
+      tma_store_wait<0>();
+      load(c + 1);
+    }
+    mbarrier_wait(bars[c & 1], (c >> 1) & 1);
+    tma_store(reinterpret_cast<char *>(dst) + c * kChunkBytes,
+              chunks + (c & 1) * kChunkBytes, chunk_size(c));
+    tma_store_arrive();
+  }
+  // The stores have to be complete, not only done reading shared memory
+  asm volatile("cp.async.bulk.wait_group 0;" : : : "memory");
+  asm volatile("mbarrier.inval.shared.b64 [%0];"
+               :
+               : "r"(smem_ptr_to_uint(&bars[0])));
+  asm volatile("mbarrier.inval.shared.b64 [%0];"
+               :
+               : "r"(smem_ptr_to_uint(&bars[1])));
+}
+
 } // namespace tl
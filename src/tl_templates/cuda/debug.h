@@ -126,3 +126,117 @@ TL_DEVICE void device_assert_with_msg(bool cond, const char *msg) {
     assert(0);
   }
 }
+
+namespace tl {
+
+// Out of line, so that the printf arguments of the report do not take
+// registers in the kernel.
+static __device__ __noinline__ void
+device_assert_warp_report(uint32_t failing, const char *msg) {
+  uint32_t tid =
+      threadIdx.x + blockDim.x * (threadIdx.y + blockDim.y * threadIdx.z);
+  printf("Device assert failed in %d lane(s) of warp %u of block (%d, %d, "
+         "%d), first ThreadIdx=(%d, %d, %d): %s\n",
+         __popc(failing), tid / 32, blockIdx.x, blockIdx.y, blockIdx.z,
+         threadIdx.x, threadIdx.y, threadIdx.z, msg ? msg : "");
+}
+
+// Votes `cond` across the active lanes of the warp. The passing path is a
+// single vote and a uniform branch; when any lane fails, the first failing
+// lane reports for the whole warp and the warp traps.
+TL_DEVICE void device_assert_warp(bool cond, const char *msg) {
+  uint32_t mask = __activemask();
+  if (!__any_sync(mask, !cond)) {
+    return;
+  }
+  uint32_t failing = __ballot_sync(mask, !cond);
+  uint32_t lane;
+  asm volatile("mov.u32 %0, %%laneid;" : "=r"(lane));
+  if (lane == static_cast<uint32_t>(__ffs(failing) - 1)) {
+    device_assert_warp_report(failing, msg);
+  }
+  __syncwarp(mask);
+  __trap();
+}
+
+// Appends one record of the profile region `region` of the calling warp to the
+// ring buffer `buf` of `capacity` records. buf[0] counts the records ever
+// written (the host zeroes it before the launch) and record i occupies
+// buf[4 + 4 * (i % capacity)] as {globaltimer, clock64, header, block}, with
+// header = region | is_end << 32 | warp << 33 | smid << 48. Only lane 0 of the
+// warp writes, so calls must be warp uniform.
+TL_DEVICE void profile_region_record(uint64_t *buf, uint64_t capacity,
+                                     uint32_t region, bool is_end) {
+  uint32_t lane;
+  asm volatile("mov.u32 %0, %%laneid;" : "=r"(lane));
+  if (lane != 0) {
+    return;
+  }
+  uint64_t timer;
+  asm volatile("mov.u64 %0, %%globaltimer;" : "=l"(timer));
+  uint64_t cycles = clock64();
+  uint32_t smid;
+  asm volatile("mov.u32 %0, %%smid;" : "=r"(smid));
+  uint32_t tid =
+      threadIdx.x + blockDim.x * (threadIdx.y + blockDim.y * threadIdx.z);
+  uint32_t block =
+      blockIdx.x + gridDim.x * (blockIdx.y + gridDim.y * blockIdx.z);
+  uint64_t slot =
+      atomicAdd(reinterpret_cast<unsigned long long *>(buf), 1ull) % capacity;
+  uint64_t *record = buf + 4 + 4 * slot;
+  record[0] = timer;
+  record[1] = cycles;
+  record[2] = static_cast<uint64_t>(region) |
+              (static_cast<uint64_t>(is_end) << 32) |
+              (static_cast<uint64_t>((tid / 32) & 0x7fff) << 33) |
+              (static_cast<uint64_t>(smid & 0xffff) << 48);
+  record[3] = block;
+}
+
+TL_DEVICE uint64_t device_log_word(int64_t value) {
+  return static_cast<uint64_t>(value);
+}
+TL_DEVICE uint64_t device_log_word(uint64_t value) { return value; }
+TL_DEVICE uint64_t device_log_word(double value) {
+  return static_cast<uint64_t>(__double_as_longlong(value));
+}
+
+// Appends the record `id` of the calling thread to the log ring buffer `buf`
+// of `capacity` records. buf[0] counts the records ever written (the host
+// zeroes it before the launch) and record i occupies buf[4 + 6 * (i %
+// capacity)] as {header, block, values[4]}, with header = id |
+// threadIdx.x << 32 | threadIdx.y << 42 | threadIdx.z << 52 | nvalues << 58
+// and block = blockIdx.x | blockIdx.y << 32 | blockIdx.z << 48. The active
+// lanes of a warp reserve their slots with a single atomic, so logging from
+// divergent code costs one atomic per warp and no serialization.
+template <typename... Ts>
+TL_DEVICE void device_log_record(uint64_t *buf, uint64_t capacity,
+                                 uint32_t id, Ts... values) {
+  static_assert(sizeof...(Ts) <= 4, "device_log takes at most 4 values");
+  uint32_t mask = __activemask();
+  uint32_t lane;
+  asm volatile("mov.u32 %0, %%laneid;" : "=r"(lane));
+  int leader = __ffs(mask) - 1;
+  unsigned long long base = 0;
+  if (lane == static_cast<uint32_t>(leader)) {
+    base = atomicAdd(reinterpret_cast<unsigned long long *>(buf),
+                     static_cast<unsigned long long>(__popc(mask)));
+  }
+  base = __shfl_sync(mask, base, leader);
+  uint64_t rank = __popc(mask & ((1u << lane) - 1));
+  uint64_t *record = buf + 4 + 6 * ((base + rank) % capacity);
+  record[0] = static_cast<uint64_t>(id) |
+              (static_cast<uint64_t>(threadIdx.x & 0x3ff) << 32) |
+              (static_cast<uint64_t>(threadIdx.y & 0x3ff) << 42) |
+              (static_cast<uint64_t>(threadIdx.z & 0x3f) << 52) |
+              (static_cast<uint64_t>(sizeof...(Ts)) << 58);
+  record[1] = static_cast<uint64_t>(blockIdx.x) |
+              (static_cast<uint64_t>(blockIdx.y & 0xffff) << 32) |
+              (static_cast<uint64_t>(blockIdx.z & 0xffff) << 48);
+  uint64_t words[] = {device_log_word(values)..., 0};
+  for (int i = 0; i < static_cast<int>(sizeof...(Ts)); ++i) {
+    record[2 + i] = words[i];
+  }
+}
+
+} // namespace tl
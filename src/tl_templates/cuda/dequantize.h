@@ -0,0 +1,199 @@
+#pragma once
+
+#include "common.h"
+
+#ifndef __CUDACC_RTC__
+#include <cstdint>
+#endif
+
+// Register-level decoders of 4-bit weights, used by T.dequantize.
+//
+// Every decoder turns the 4 bytes at `in` into the 8 values at `out`. Byte b
+// holds element 2 * b in its low nibble and element 2 * b + 1 in its high
+// nibble, the order in which the packed elements are stored in memory. The
+// decoded values are neither scaled nor shifted.
+
+namespace tl {
+
+namespace dequant {
+
+template <typename T> struct Half2Traits;
+
+template <> struct Half2Traits<half_t> {
+  // 1024 + n for the nibble n in the low mantissa bits
+  static constexpr uint32_t kIntMagic = 0x64006400;
+  static constexpr uint32_t kOne = 0x3C003C00;
+  // e2m1 lands on the low exponent bits, 2^(15 - 1) undoes the bias
+  static constexpr int kFp4Shift = 9;
+  static constexpr uint32_t kFp4Mask = 0x0E000E00;
+  static constexpr uint32_t kFp4Bias = 0x74007400;
+
+  TL_DEVICE static uint32_t fma(uint32_t a, uint32_t b, uint32_t c) {
+    uint32_t d;
+    asm("fma.rn.f16x2 %0, %1, %2, %3;\n"
+        : "=r"(d)
+        : "r"(a), "r"(b), "r"(c));
+    return d;
+  }
+};
+
+template <> struct Half2Traits<bfloat16_t> {
+  // 128 + n for the nibble n in the low mantissa bits
+  static constexpr uint32_t kIntMagic = 0x43004300;
+  static constexpr uint32_t kOne = 0x3F803F80;
+  // e2m1 lands on the low exponent bits, 2^(127 - 1) undoes the bias
+  static constexpr int kFp4Shift = 6;
+  static constexpr uint32_t kFp4Mask = 0x01C001C0;
+  static constexpr uint32_t kFp4Bias = 0x7E807E80;
+
+  TL_DEVICE static uint32_t fma(uint32_t a, uint32_t b, uint32_t c) {
+    uint32_t d;
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800)
+    asm("fma.rn.bf16x2 %0, %1, %2, %3;\n"
+        : "=r"(d)
+        : "r"(a), "r"(b), "r"(c));
+#else
+    float2 fa = __bfloat1622float2(*reinterpret_cast<__nv_bfloat162 *>(&a));
+    float2 fb = __bfloat1622float2(*reinterpret_cast<__nv_bfloat162 *>(&b));
+    float2 fc = __bfloat1622float2(*reinterpret_cast<__nv_bfloat162 *>(&c));
+    __nv_bfloat162 r = __floats2bfloat162_rn(fa.x * fb.x + fc.x,
+                                             fa.y * fb.y + fc.y);
+    d = *reinterpret_cast<uint32_t *>(&r);
+#endif
+    return d;
+  }
+};
+
+// NF4 code book, the low and the high bytes of the 16 values
+template <typename T> struct NF4Table;
+
+template <> struct NF4Table<half_t> {
+  static constexpr uint32_t kLo0 = 0x52339200, kLo1 = 0x00D4EA8D,
+                            kLo2 = 0x68E02618, kLo3 = 0x00C9800D;
+  static constexpr uint32_t kHi0 = 0xB6B8B9BC, kHi1 = 0x00ADB1B4,
+                            kHi2 = 0x3533312D, kHi3 = 0x3C393837;
+};
+
+template <> struct NF4Table<bfloat16_t> {
+  static constexpr uint32_t kLo0 = 0xCA063280, kLo1 = 0x00BA3D92,
+                            kLo2 = 0xAD7C25A3, kLo3 = 0x803910E2;
+  static constexpr uint32_t kHi0 = 0xBEBFBFBF, kHi1 = 0x00BDBEBE,
+                            kHi2 = 0x3E3E3E3D, kHi3 = 0x3F3F3F3E;
+};
+
+template <uint32_t kLut>
+TL_DEVICE uint32_t lop3(uint32_t a, uint32_t b, uint32_t c) {
+  uint32_t d;
+  asm("lop3.b32 %0, %1, %2, %3, %4;\n"
+      : "=r"(d)
+      : "r"(a), "r"(b), "r"(c), "n"(kLut));
+  return d;
+}
+
+TL_DEVICE uint32_t prmt(uint32_t a, uint32_t b, uint32_t sel) {
+  uint32_t d;
+  asm("prmt.b32 %0, %1, %2, %3;\n" : "=r"(d) : "r"(a), "r"(b), "r"(sel));
+  return d;
+}
+
+// Lookup tables of lop3, for the inputs a = 0xF0, b = 0xCC and c = 0xAA
+constexpr uint32_t kAndOr = (0xF0 & 0xCC) | 0xAA;
+constexpr uint32_t kAndXor = (0xF0 & 0xCC) ^ 0xAA;
+
+template <typename In> TL_DEVICE uint32_t load_packed_x8(const In *in) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(in);
+  return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) |
+         (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+}
+
+// Writes the low half of `pair` to out[lo] and the high half to out[hi]
+template <typename T>
+TL_DEVICE void store_pair(T *out, int lo, int hi, uint32_t pair) {
+  out[lo] = T::bitcast(uint16_t(pair & 0xFFFF));
+  out[hi] = T::bitcast(uint16_t(pair >> 16));
+}
+
+// Integers: one lop3 ORs nibbles k and k + 4 into the mantissas of a magic
+// number, which one fma subtracts again. Shifting by 4 * k walks the pairs,
+// hence the outputs are written as (k, k + 4).
+template <bool kSigned, typename In, typename T>
+TL_DEVICE void decode_int4x8(const In *in, T *out) {
+  using Traits = Half2Traits<T>;
+  // XOR-ing the sign bit maps two's complement n to n + 8
+  constexpr uint32_t kMagic =
+      Traits::kIntMagic | (kSigned ? 0x00080008u : 0u);
+  uint32_t packed = load_packed_x8(in);
+#pragma unroll
+  for (int k = 0; k < 4; ++k) {
+    uint32_t pair =
+        kSigned ? lop3<kAndXor>(packed >> (4 * k), 0x000F000F, kMagic)
+                : lop3<kAndOr>(packed >> (4 * k), 0x000F000F, kMagic);
+    pair = Traits::fma(pair, Traits::kOne, kMagic ^ 0x80008000);
+    store_pair(out, k, k + 4, pair);
+  }
+}
+
+// e2m1: the exponent and the mantissa move under those of the output and
+// the sign onto its sign bit, then a multiply rebiases the exponent;
+// subnormals come out right as well.
+template <typename In, typename T>
+TL_DEVICE void decode_fp4_e2m1x8(const In *in, T *out) {
+  using Traits = Half2Traits<T>;
+  uint32_t packed = load_packed_x8(in);
+#pragma unroll
+  for (int k = 0; k < 4; ++k) {
+    uint32_t nibbles = packed >> (4 * k);
+    uint32_t pair = lop3<kAndOr>(nibbles << Traits::kFp4Shift,
+                                 Traits::kFp4Mask,
+                                 (nibbles << 12) & 0x80008000);
+    // Adding -0 keeps the sign of zeros
+    pair = Traits::fma(pair, Traits::kFp4Bias, 0x80008000);
+    store_pair(out, k, k + 4, pair);
+  }
+}
+
+// NF4: a nibble selects a byte of the code book with prmt. The low 3 bits
+// pick among 8 entries of a pair of registers, so each byte of the value is
+// looked up in both halves of the table, and a last prmt keeps the half
+// chosen by bit 3. Four values are decoded by every sequence.
+template <typename In, typename T>
+TL_DEVICE void decode_nf4x8(const In *in, T *out) {
+  using Table = NF4Table<T>;
+  uint32_t packed = load_packed_x8(in);
+#pragma unroll
+  for (int q = 0; q < 2; ++q) {
+    uint32_t nibbles = packed >> (16 * q);
+    uint32_t sel = nibbles & 0x7777;
+    uint32_t pick = 0x3210 | ((nibbles >> 1) & 0x4444);
+    uint32_t lo = prmt(prmt(Table::kLo0, Table::kLo1, sel),
+                       prmt(Table::kLo2, Table::kLo3, sel), pick);
+    uint32_t hi = prmt(prmt(Table::kHi0, Table::kHi1, sel),
+                       prmt(Table::kHi2, Table::kHi3, sel), pick);
+    store_pair(out, 4 * q, 4 * q + 1, prmt(lo, hi, 0x5140));
+    store_pair(out, 4 * q + 2, 4 * q + 3, prmt(lo, hi, 0x7362));
+  }
+}
+
+} // namespace dequant
+
+template <typename In, typename T>
+TL_DEVICE void dequantize_int4x8(const In *in, T *out) {
+  dequant::decode_int4x8<true>(in, out);
+}
+
+template <typename In, typename T>
+TL_DEVICE void dequantize_uint4x8(const In *in, T *out) {
+  dequant::decode_int4x8<false>(in, out);
+}
+
+template <typename In, typename T>
+TL_DEVICE void dequantize_fp4_e2m1x8(const In *in, T *out) {
+  dequant::decode_fp4_e2m1x8(in, out);
+}
+
+template <typename In, typename T>
+TL_DEVICE void dequantize_nf4x8(const In *in, T *out) {
+  dequant::decode_nf4x8(in, out);
+}
+
+} // namespace tl
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "common.h"
+
+// Approximations of the special function unit, selected by the LowerFastMath
+// pass within the ulp budget of a T.fastmath region. The f16 and f32 forms
+// need sm75, the bf16 ones sm90.
+
+namespace tl {
+
+TL_DEVICE float ex2_approx(float x) {
+  float y;
+  asm("ex2.approx.ftz.f32 %0, %1;" : "=f"(y) : "f"(x));
+  return y;
+}
+
+TL_DEVICE half_t ex2_approx(half_t x) {
+  uint16_t y;
+  asm("ex2.approx.f16 %0, %1;" : "=h"(y) : "h"(x.raw()));
+  return half_t::bitcast(y);
+}
+
+TL_DEVICE bfloat16_t ex2_approx(bfloat16_t x) {
+  uint16_t y;
+  asm("ex2.approx.ftz.bf16 %0, %1;" : "=h"(y) : "h"(x.raw()));
+  return bfloat16_t::bitcast(y);
+}
+
+TL_DEVICE float tanh_approx(float x) {
+  float y;
+  asm("tanh.approx.f32 %0, %1;" : "=f"(y) : "f"(x));
+  return y;
+}
+
+TL_DEVICE half_t tanh_approx(half_t x) {
+  uint16_t y;
+  asm("tanh.approx.f16 %0, %1;" : "=h"(y) : "h"(x.raw()));
+  return half_t::bitcast(y);
+}
+
+TL_DEVICE bfloat16_t tanh_approx(bfloat16_t x) {
+  uint16_t y;
+  asm("tanh.approx.bf16 %0, %1;" : "=h"(y) : "h"(x.raw()));
+  return bfloat16_t::bitcast(y);
+}
+
+// Vectors of halves, held in uint1 to ulonglong4, are processed one 32-bit
+// word of two lanes at a time.
+#define TL_DEFINE_PACKED_APPROX(name, instruction)                             \
+  template <typename T> TL_DEVICE T name(T x) {                                \
+    static_assert(sizeof(T) % 4 == 0, "expects whole pairs of halves");        \
+    uint32_t *words = reinterpret_cast<uint32_t *>(&x);                        \
+    _Pragma("unroll") for (int i = 0; i < int(sizeof(T) / 4); ++i) {           \
+      asm(instruction " %0, %1;" : "=r"(words[i]) : "r"(words[i]));            \
+    }                                                                          \
+    return x;                                                                  \
+  }
+
+TL_DEFINE_PACKED_APPROX(ex2_approx_f16x2, "ex2.approx.f16x2")
+TL_DEFINE_PACKED_APPROX(ex2_approx_bf16x2, "ex2.approx.ftz.bf16x2")
+TL_DEFINE_PACKED_APPROX(tanh_approx_f16x2, "tanh.approx.f16x2")
+TL_DEFINE_PACKED_APPROX(tanh_approx_bf16x2, "tanh.approx.bf16x2")
+
+#undef TL_DEFINE_PACKED_APPROX
+
+} // namespace tl
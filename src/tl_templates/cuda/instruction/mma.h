@@ -3,6 +3,7 @@
 #include "../common.h"
 #include <cute/arch/mma_sm80.hpp>
 #include <cute/arch/mma_sm89.hpp>
+#include <cute/arch/mma_sm90.hpp>
 
 #ifndef __CUDACC_RTC__
 #include <type_traits>
@@ -104,6 +105,10 @@ TL_DEFINE_MMA_DISPATCHER(kInt8, kInt8, kInt32, 16, 8, 32, false, true, false,
                          cute::SM80_16x8x32_S32S8S8S32_TN)
 TL_DEFINE_MMA_DISPATCHER(kUInt8, kUInt8, kInt32, 16, 8, 32, false, true, false,
                          cute::SM80_16x8x32_S32U8U8S32_TN)
+TL_DEFINE_MMA_DISPATCHER(kInt8, kUInt8, kInt32, 16, 8, 32, false, true, false,
+                         cute::SM80_16x8x32_S32S8U8S32_TN)
+TL_DEFINE_MMA_DISPATCHER(kUInt8, kInt8, kInt32, 16, 8, 32, false, true, false,
+                         cute::SM80_16x8x32_S32U8S8S32_TN)
 
 // INT4 inputs (k32)
 TL_DEFINE_MMA_DISPATCHER(kInt4, kInt4, kInt32, 16, 8, 32, false, true, false,
@@ -111,6 +116,12 @@ TL_DEFINE_MMA_DISPATCHER(kInt4, kInt4, kInt32, 16, 8, 32, false, true, false,
 TL_DEFINE_MMA_DISPATCHER(kUInt4, kUInt4, kInt32, 16, 8, 32, false, true, false,
                          cute::SM80_16x8x32_S32U4U4S32_TN)
 
+// INT4 inputs (k64): the packed registers match the ones of INT8 k32
+TL_DEFINE_MMA_DISPATCHER(kInt4, kInt4, kInt32, 16, 8, 64, false, true, false,
+                         cute::SM80_16x8x64_S32S4S4S32_TN)
+TL_DEFINE_MMA_DISPATCHER(kUInt4, kUInt4, kInt32, 16, 8, 64, false, true, false,
+                         cute::SM80_16x8x64_S32U4U4S32_TN)
+
 // FP8 inputs (k32)
 TL_DEFINE_MMA_DISPATCHER(kFloat8_e4m3, kFloat8_e4m3, kFloat16, 16, 8, 32, false,
                          true, false, cute::SM89_16x8x32_F16E4M3E4M3F16_TN)
@@ -142,6 +153,14 @@ TL_DEFINE_MMA_DISPATCHER(kTensorFloat32, kTensorFloat32, kFloat32, 16, 8, 8,
 TL_DEFINE_MMA_DISPATCHER(kFloat64, kFloat64, kFloat64, 8, 8, 4, false, true,
                          false, cute::SM80_8x8x4_F64F64F64F64_TN)
 
+// FP64 inputs (Hopper DMMA: m16n8k{4,8,16}, TN layout)
+TL_DEFINE_MMA_DISPATCHER(kFloat64, kFloat64, kFloat64, 16, 8, 4, false, true,
+                         false, cute::SM90_16x8x4_F64F64F64F64_TN)
+TL_DEFINE_MMA_DISPATCHER(kFloat64, kFloat64, kFloat64, 16, 8, 8, false, true,
+                         false, cute::SM90_16x8x8_F64F64F64F64_TN)
+TL_DEFINE_MMA_DISPATCHER(kFloat64, kFloat64, kFloat64, 16, 8, 16, false, true,
+                         false, cute::SM90_16x8x16_F64F64F64F64_TN)
+
 #undef TL_DEFINE_MMA_DISPATCHER
 
 } // namespace detail
@@ -162,4 +181,38 @@ TL_DEVICE void mma_sync(
   Dispatcher::exec(c, a, b, c);
 }
 
+// Block scaled FP8 mma.sync of sm120: m16n8k32 with float32 accumulation and
+// one UE8M0 scale factor per 32 elements of K. sfa carries the scale factor
+// of the row of A and sfb the one of the column of B the calling lane
+// provides, in their lowest byte.
+template <DataType AType, DataType BType>
+TL_DEVICE void mma_sync_blockscaled(float * /*c*/, const unsigned * /*a*/,
+                                    const unsigned * /*b*/, unsigned /*sfa*/,
+                                    unsigned /*sfb*/) {
+  static_assert(always_false_v<std::integral_constant<DataType, AType>>,
+                "tl::mma_sync_blockscaled: unsupported configuration");
+}
+
+#define TL_DEFINE_MMA_BLOCKSCALED(AType, BType, PtxA, PtxB)                    \
+  template <>                                                                  \
+  TL_DEVICE void mma_sync_blockscaled<DataType::AType, DataType::BType>(       \
+      float *c, const unsigned *a, const unsigned *b, unsigned sfa,            \
+      unsigned sfb) {                                                          \
+    const uint16_t zero = 0;                                                   \
+    asm volatile("mma.sync.aligned.kind::mxf8f6f4.block_scale.scale_vec::1X."  \
+                 "m16n8k32.row.col.f32." PtxA "." PtxB ".f32.ue8m0 "           \
+                 "{%0, %1, %2, %3}, {%4, %5, %6, %7}, {%8, %9}, "              \
+                 "{%0, %1, %2, %3}, {%10}, {%12, %13}, {%11}, {%12, %13};\n"   \
+                 : "+f"(c[0]), "+f"(c[1]), "+f"(c[2]), "+f"(c[3])              \
+                 : "r"(a[0]), "r"(a[1]), "r"(a[2]), "r"(a[3]), "r"(b[0]),      \
+                   "r"(b[1]), "r"(sfa), "r"(sfb), "h"(zero), "h"(zero));       \
+  }
+
+TL_DEFINE_MMA_BLOCKSCALED(kFloat8_e4m3, kFloat8_e4m3, "e4m3", "e4m3")
+TL_DEFINE_MMA_BLOCKSCALED(kFloat8_e4m3, kFloat8_e5m2, "e4m3", "e5m2")
+TL_DEFINE_MMA_BLOCKSCALED(kFloat8_e5m2, kFloat8_e4m3, "e5m2", "e4m3")
+TL_DEFINE_MMA_BLOCKSCALED(kFloat8_e5m2, kFloat8_e5m2, "e5m2", "e5m2")
+
+#undef TL_DEFINE_MMA_BLOCKSCALED
+
 } // namespace tl
@@ -334,4 +334,190 @@ TL_DEVICE void tcgen05mma_ws_ss<DataType::kFloat8_e5m2>(
       desc_a, desc_b, tmem_c, scalec, desc_val, mask0, mask1, mask2, mask3);
 }
 
+// 2-CTA variants: tcgen05.mma.cta_group::2.kind::xxx, issued by the even CTA
+// of a cluster pair. A and D are read from the same shared / tensor memory
+// offsets of both CTAs, each providing half of the rows, and B is split
+// along N between them. The disable-output-lane masks are not supported.
+template <DataType C_type>
+TL_DEVICE void
+tcgen05mma_2cta_ss(uint64_t const & /*desc_a*/, uint64_t const & /*desc_b*/,
+                   uint32_t const & /*tmem_c*/, uint32_t const & /*scalec*/,
+                   uint32_t const & /*desc_val*/, int const & /*mask0*/,
+                   int const & /*mask1*/, int const & /*mask2*/,
+                   int const & /*mask3*/) {
+  static_assert(
+      always_false_v<std::integral_constant<int, static_cast<int>(C_type)>>,
+      "tl::tcgen05mma_2cta_ss: unsupported accumulator type");
+}
+
+// F16/BF16 2-CTA
+template <>
+TL_DEVICE void tcgen05mma_2cta_ss<DataType::kFloat16>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &scalec, uint32_t const &desc_val, int const &mask0,
+    int const &mask1, int const &mask2, int const &mask3) {
+  if (cute::elect_one_sync()) {
+    asm volatile(
+        "{\n\t"
+        ".reg .pred p;\n\t"
+        "setp.ne.b32 p, %4, 0;\n\t"
+        "tcgen05.mma.cta_group::2.kind::f16 [%0], %1, %2, %3, p; \n\t"
+        "}\n"
+        :
+        : "r"(tmem_c), "l"(desc_a), "l"(desc_b), "r"(desc_val), "r"(scalec));
+  }
+}
+
+template <>
+TL_DEVICE void tcgen05mma_2cta_ss<DataType::kBFloat16>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &scalec, uint32_t const &desc_val, int const &mask0,
+    int const &mask1, int const &mask2, int const &mask3) {
+  tcgen05mma_2cta_ss<DataType::kFloat16>(desc_a, desc_b, tmem_c, scalec,
+                                         desc_val, mask0, mask1, mask2, mask3);
+}
+
+// TF32 2-CTA
+template <>
+TL_DEVICE void tcgen05mma_2cta_ss<DataType::kTensorFloat32>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &scalec, uint32_t const &desc_val, int const &mask0,
+    int const &mask1, int const &mask2, int const &mask3) {
+  if (cute::elect_one_sync()) {
+    asm volatile(
+        "{\n\t"
+        ".reg .pred p;\n\t"
+        "setp.ne.b32 p, %4, 0;\n\t"
+        "tcgen05.mma.cta_group::2.kind::tf32 [%0], %1, %2, %3, p; \n\t"
+        "}\n"
+        :
+        : "r"(tmem_c), "l"(desc_a), "l"(desc_b), "r"(desc_val), "r"(scalec));
+  }
+}
+
+// INT8 2-CTA
+template <>
+TL_DEVICE void tcgen05mma_2cta_ss<DataType::kInt8>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &scalec, uint32_t const &desc_val, int const &mask0,
+    int const &mask1, int const &mask2, int const &mask3) {
+  if (cute::elect_one_sync()) {
+    asm volatile(
+        "{\n\t"
+        ".reg .pred p;\n\t"
+        "setp.ne.b32 p, %4, 0;\n\t"
+        "tcgen05.mma.cta_group::2.kind::i8 [%0], %1, %2, %3, p; \n\t"
+        "}\n"
+        :
+        : "r"(tmem_c), "l"(desc_a), "l"(desc_b), "r"(desc_val), "r"(scalec));
+  }
+}
+
+// FP8 2-CTA (maps to f8f6f4)
+template <>
+TL_DEVICE void tcgen05mma_2cta_ss<DataType::kFloat8_e4m3>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &scalec, uint32_t const &desc_val, int const &mask0,
+    int const &mask1, int const &mask2, int const &mask3) {
+  if (cute::elect_one_sync()) {
+    asm volatile(
+        "{\n\t"
+        ".reg .pred p;\n\t"
+        "setp.ne.b32 p, %4, 0;\n\t"
+        "tcgen05.mma.cta_group::2.kind::f8f6f4 [%0], %1, %2, %3, p; \n\t"
+        "}\n"
+        :
+        : "r"(tmem_c), "l"(desc_a), "l"(desc_b), "r"(desc_val), "r"(scalec));
+  }
+}
+
+template <>
+TL_DEVICE void tcgen05mma_2cta_ss<DataType::kFloat8_e5m2>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &scalec, uint32_t const &desc_val, int const &mask0,
+    int const &mask1, int const &mask2, int const &mask3) {
+  tcgen05mma_2cta_ss<DataType::kFloat8_e4m3>(
+      desc_a, desc_b, tmem_c, scalec, desc_val, mask0, mask1, mask2, mask3);
+}
+
+// Block scaled variants: tcgen05.mma.cta_group::1.kind::xxx.block_scale
+// .scale_vec::NX, the scale factors of A and B being read from tensor memory.
+// Generic declarations fall back to static assert
+template <int ScaleVec>
+TL_DEVICE void tcgen05mma_mxf8f6f4_ss(
+    uint64_t const & /*desc_a*/, uint64_t const & /*desc_b*/,
+    uint32_t const & /*tmem_c*/, uint32_t const & /*tmem_sfa*/,
+    uint32_t const & /*tmem_sfb*/, uint32_t const & /*scalec*/,
+    uint32_t const & /*desc_val*/) {
+  static_assert(always_false_v<std::integral_constant<int, ScaleVec>>,
+                "tl::tcgen05mma_mxf8f6f4_ss: unsupported scale_vec");
+}
+
+template <int ScaleVec>
+TL_DEVICE void tcgen05mma_mxf4nvf4_ss(
+    uint64_t const & /*desc_a*/, uint64_t const & /*desc_b*/,
+    uint32_t const & /*tmem_c*/, uint32_t const & /*tmem_sfa*/,
+    uint32_t const & /*tmem_sfb*/, uint32_t const & /*scalec*/,
+    uint32_t const & /*desc_val*/) {
+  static_assert(always_false_v<std::integral_constant<int, ScaleVec>>,
+                "tl::tcgen05mma_mxf4nvf4_ss: unsupported scale_vec");
+}
+
+// MXFP8: one UE8M0 scale factor per 32 elements of K
+template <>
+TL_DEVICE void tcgen05mma_mxf8f6f4_ss<1>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &tmem_sfa, uint32_t const &tmem_sfb, uint32_t const &scalec,
+    uint32_t const &desc_val) {
+  if (cute::elect_one_sync()) {
+    asm volatile("{\n\t"
+                 ".reg .pred p;\n\t"
+                 "setp.ne.b32 p, %4, 0;\n\t"
+                 "tcgen05.mma.cta_group::1.kind::mxf8f6f4.block_scale.scale_"
+                 "vec::1X [%0], %1, %2, %3, [%5], [%6], p; \n\t"
+                 "}\n"
+                 :
+                 : "r"(tmem_c), "l"(desc_a), "l"(desc_b), "r"(desc_val),
+                   "r"(scalec), "r"(tmem_sfa), "r"(tmem_sfb));
+  }
+}
+
+// MXFP4: one UE8M0 scale factor per 32 elements of K
+template <>
+TL_DEVICE void tcgen05mma_mxf4nvf4_ss<2>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &tmem_sfa, uint32_t const &tmem_sfb, uint32_t const &scalec,
+    uint32_t const &desc_val) {
+  if (cute::elect_one_sync()) {
+    asm volatile("{\n\t"
+                 ".reg .pred p;\n\t"
+                 "setp.ne.b32 p, %4, 0;\n\t"
+                 "tcgen05.mma.cta_group::1.kind::mxf4nvf4.block_scale.scale_"
+                 "vec::2X [%0], %1, %2, %3, [%5], [%6], p; \n\t"
+                 "}\n"
+                 :
+                 : "r"(tmem_c), "l"(desc_a), "l"(desc_b), "r"(desc_val),
+                   "r"(scalec), "r"(tmem_sfa), "r"(tmem_sfb));
+  }
+}
+
+// NVFP4: one UE4M3 scale factor per 16 elements of K
+template <>
+TL_DEVICE void tcgen05mma_mxf4nvf4_ss<4>(
+    uint64_t const &desc_a, uint64_t const &desc_b, uint32_t const &tmem_c,
+    uint32_t const &tmem_sfa, uint32_t const &tmem_sfb, uint32_t const &scalec,
+    uint32_t const &desc_val) {
+  if (cute::elect_one_sync()) {
+    asm volatile("{\n\t"
+                 ".reg .pred p;\n\t"
+                 "setp.ne.b32 p, %4, 0;\n\t"
+                 "tcgen05.mma.cta_group::1.kind::mxf4nvf4.block_scale.scale_"
+                 "vec::4X [%0], %1, %2, %3, [%5], [%6], p; \n\t"
+                 "}\n"
+                 :
+                 : "r"(tmem_c), "l"(desc_a), "l"(desc_b), "r"(desc_val),
+                   "r"(scalec), "r"(tmem_sfa), "r"(tmem_sfb));
+  }
+}
+
 } // namespace tl
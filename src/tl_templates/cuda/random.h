@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common.h"
+
+// Stateless Philox4x32-10 keyed on the seed, drawing the random number of an
+// element from its index and an offset, e.g. the number of values a training
+// step consumed before. Every element of a block of 4 consecutive indices
+// comes from one Philox call on the counter (index / 4, offset), so
+// T.philox_rand over four aligned lanes costs a single call.
+
+namespace tl {
+
+TL_DEVICE uint4 philox4x32_10(uint4 ctr, uint2 key) {
+  constexpr uint32_t kM0 = 0xD2511F53u, kM1 = 0xCD9E8D57u;
+  constexpr uint32_t kW0 = 0x9E3779B9u, kW1 = 0xBB67AE85u;
+#pragma unroll
+  for (int round = 0; round < 10; ++round) {
+    uint32_t hi0 = __umulhi(kM0, ctr.x), lo0 = kM0 * ctr.x;
+    uint32_t hi1 = __umulhi(kM1, ctr.z), lo1 = kM1 * ctr.z;
+    ctr = make_uint4(hi1 ^ ctr.y ^ key.x, lo1, hi0 ^ ctr.w ^ key.y, lo0);
+    key.x += kW0;
+    key.y += kW1;
+  }
+  return ctr;
+}
+
+// The 4 random numbers of the elements 4 * block to 4 * block + 3
+TL_DEVICE uint4 philox_block(uint64_t seed, uint64_t offset, uint64_t block) {
+  uint4 ctr = make_uint4(uint32_t(block), uint32_t(block >> 32),
+                         uint32_t(offset), uint32_t(offset >> 32));
+  return philox4x32_10(ctr, make_uint2(uint32_t(seed), uint32_t(seed >> 32)));
+}
+
+TL_DEVICE uint32_t philox_rand(uint64_t seed, uint64_t offset,
+                               int64_t index) {
+  uint4 r = philox_block(seed, offset, uint64_t(index) >> 2);
+  switch (index & 3) {
+  case 0:
+    return r.x;
+  case 1:
+    return r.y;
+  case 2:
+    return r.z;
+  default:
+    return r.w;
+  }
+}
+
+// The random numbers of the elements index to index + 3, in one Philox call
+// when index is a multiple of 4
+TL_DEVICE uint4 philox_rand4(uint64_t seed, uint64_t offset, int64_t index) {
+  if ((index & 3) == 0)
+    return philox_block(seed, offset, uint64_t(index) >> 2);
+  return make_uint4(philox_rand(seed, offset, index),
+                    philox_rand(seed, offset, index + 1),
+                    philox_rand(seed, offset, index + 2),
+                    philox_rand(seed, offset, index + 3));
+}
+
+} // namespace tl
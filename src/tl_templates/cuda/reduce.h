@@ -1,5 +1,6 @@
 #pragma once
 
+#include "cluster.h"
 #include "common.h"
 
 #ifndef __CUDACC_RTC__
@@ -39,6 +40,12 @@ struct MinOp {
   }
 };
 
+struct ProdOp {
+  template <typename T> TL_DEVICE T operator()(T const &x, T const &y) {
+    return x * y;
+  }
+};
+
 struct BitAndOp {
   template <typename T> TL_DEVICE T operator()(T const &x, T const &y) {
     return x & y;
@@ -57,6 +64,57 @@ struct BitXorOp {
   }
 };
 
+// Single-instruction warp reductions (redux.sync) of 32-bit integers, sm_80+.
+template <class Reducer, typename T> struct WarpRedux {
+  static constexpr bool value = false;
+};
+
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 800)
+#define TL_DEFINE_WARP_REDUX(REDUCER, TYPE, INTRIN)                            \
+  template <> struct WarpRedux<REDUCER, TYPE> {                                \
+    static constexpr bool value = true;                                        \
+    static TL_DEVICE TYPE run(TYPE x) {                                        \
+      return static_cast<TYPE>(INTRIN(uint32_t(-1), x));                       \
+    }                                                                          \
+  };
+TL_DEFINE_WARP_REDUX(SumOp, int, __reduce_add_sync)
+TL_DEFINE_WARP_REDUX(SumOp, unsigned, __reduce_add_sync)
+TL_DEFINE_WARP_REDUX(MaxOp, int, __reduce_max_sync)
+TL_DEFINE_WARP_REDUX(MaxOp, unsigned, __reduce_max_sync)
+TL_DEFINE_WARP_REDUX(MinOp, int, __reduce_min_sync)
+TL_DEFINE_WARP_REDUX(MinOp, unsigned, __reduce_min_sync)
+TL_DEFINE_WARP_REDUX(BitAndOp, int, __reduce_and_sync)
+TL_DEFINE_WARP_REDUX(BitAndOp, unsigned, __reduce_and_sync)
+TL_DEFINE_WARP_REDUX(BitOrOp, int, __reduce_or_sync)
+TL_DEFINE_WARP_REDUX(BitOrOp, unsigned, __reduce_or_sync)
+TL_DEFINE_WARP_REDUX(BitXorOp, int, __reduce_xor_sync)
+TL_DEFINE_WARP_REDUX(BitXorOp, unsigned, __reduce_xor_sync)
+#undef TL_DEFINE_WARP_REDUX
+#endif
+
+// All-reduce of `x` over the groups of `threads` consecutive threads, every
+// `scale`-th of which holds a part of the same value.
+//
+// The part of the reduction within a warp is a redux.sync (full warps of
+// integers) or a chain of shfl.xor. Groups wider than a warp then exchange
+// their per-warp partials once through `red_buf` (`all_threads` elements of
+// shared memory): two barriers per call however wide the group, where every
+// thread reduces the partials of its group in the same order so that all of
+// them obtain the same result. `run_hopper` synchronizes the `all_threads`
+// threads with a named barrier instead of __syncthreads.
+//
+// `run_batch<num>` reduces `num` values at once through `num * all_threads`
+// elements of `red_buf`, sharing the two barriers between them.
+//
+// The `*_compact` variants only store the distinct partials of each warp,
+// `compact_size` elements of `red_buf` per value instead of `all_threads`.
+//
+// `run_fused<Others...>(x, ys...)` reduces `*x` with `Reducer` and each of
+// `*ys` with the reducer of the same position in `Others`, interleaving their
+// shuffles, for groups within a warp. `run_fused_smem` exchanges the partials
+// of all of them through one pair of barriers and `(1 + sizeof...(Others)) *
+// all_threads` elements of `red_buf`, and `run_batch_fused<num, Others...>`
+// does the same for arrays of `num` values each.
 template <class Reducer, int threads, int scale, int thread_offset = 0,
           int all_threads = threads>
 struct AllReduce {
@@ -64,41 +122,207 @@ struct AllReduce {
                 threads == 128 or threads == 64 or threads == 32 or
                 threads == 16 or threads == 8 or threads == 4 or threads == 2);
   static_assert(threads % scale == 0);
+
   template <typename T> static TL_DEVICE T run(T x, T *red_buf = nullptr) {
-    constexpr int offset = threads / 2;
-    if constexpr (offset >= 32) {
-      __syncthreads();
-      red_buf[threadIdx.x - thread_offset] = x;
-      __syncthreads();
-      x = Reducer()(x, red_buf[(threadIdx.x - thread_offset) ^ offset]);
-    } else {
-      x = Reducer()(x, tl::shfl_xor_sync(uint32_t(-1), x, offset));
-    }
-    if constexpr (offset == scale) {
-      return x;
-    } else {
-      return AllReduce<Reducer, offset, scale, thread_offset, all_threads>::run(
-          x, red_buf);
-    }
+    return reduce<false, false>(x, red_buf);
   }
 
   template <typename T>
   static TL_DEVICE T run_hopper(T x, T *red_buf = nullptr) {
-    constexpr int offset = threads / 2;
-    if constexpr (offset >= 32) {
+    return reduce<true, false>(x, red_buf);
+  }
+
+  template <int num, typename T>
+  static TL_DEVICE void run_batch(T *vals, T *red_buf = nullptr) {
+    reduce_batch<false, false, num>(vals, red_buf);
+  }
+
+  template <int num, typename T>
+  static TL_DEVICE void run_batch_hopper(T *vals, T *red_buf = nullptr) {
+    reduce_batch<true, false, num>(vals, red_buf);
+  }
+
+  template <typename T>
+  static TL_DEVICE T run_compact(T x, T *red_buf = nullptr) {
+    return reduce<false, true>(x, red_buf);
+  }
+
+  template <typename T>
+  static TL_DEVICE T run_compact_hopper(T x, T *red_buf = nullptr) {
+    return reduce<true, true>(x, red_buf);
+  }
+
+  template <int num, typename T>
+  static TL_DEVICE void run_batch_compact(T *vals, T *red_buf = nullptr) {
+    reduce_batch<false, true, num>(vals, red_buf);
+  }
+
+  template <int num, typename T>
+  static TL_DEVICE void run_batch_compact_hopper(T *vals,
+                                                 T *red_buf = nullptr) {
+    reduce_batch<true, true, num>(vals, red_buf);
+  }
+
+  template <class... Others, typename T, typename... Ts>
+  static TL_DEVICE void run_fused(T *x, Ts *...ys) {
+    static_assert(num_partials == 1, "groups wider than a warp need red_buf");
+    reduce_fused<false, 1, Others...>(static_cast<T *>(nullptr), x, ys...);
+  }
+
+  template <class... Others, typename T, typename... Ts>
+  static TL_DEVICE void run_fused_smem(T *red_buf, T *x, Ts *...ys) {
+    reduce_fused<false, 1, Others...>(red_buf, x, ys...);
+  }
+
+  template <class... Others, typename T, typename... Ts>
+  static TL_DEVICE void run_fused_smem_hopper(T *red_buf, T *x, Ts *...ys) {
+    reduce_fused<true, 1, Others...>(red_buf, x, ys...);
+  }
+
+  template <int num, class... Others, typename T, typename... Ts>
+  static TL_DEVICE void run_batch_fused(T *red_buf, T *x, Ts *...ys) {
+    reduce_fused<false, num, Others...>(red_buf, x, ys...);
+  }
+
+  template <int num, class... Others, typename T, typename... Ts>
+  static TL_DEVICE void run_batch_fused_hopper(T *red_buf, T *x, Ts *...ys) {
+    reduce_fused<true, num, Others...>(red_buf, x, ys...);
+  }
+
+private:
+  template <class, int, int, int, int> friend struct AllReduce;
+
+  // The same reduction with another reducer, for the fused values.
+  template <class Other>
+  using Peer = AllReduce<Other, threads, scale, thread_offset, all_threads>;
+
+  // Distance between the threads holding the partials after the warp stage.
+  static constexpr int stride = scale > 32 ? scale : 32;
+  static constexpr int num_partials = threads > 32 ? threads / stride : 1;
+  // Distinct partials of a warp after the warp stage.
+  static constexpr int warp_parts = scale < 32 ? scale : 32;
+
+public:
+  static constexpr int compact_size = all_threads / 32 * warp_parts;
+
+private:
+  // Element of `red_buf` holding the partial of thread `tid`.
+  template <bool compact> static TL_DEVICE int slot(int tid) {
+    if constexpr (compact) {
+      return tid / 32 * warp_parts + (tid & (warp_parts - 1));
+    } else {
+      return tid;
+    }
+  }
+
+  template <bool named_barrier> static TL_DEVICE void sync() {
+    if constexpr (named_barrier) {
       asm volatile("bar.sync %0, %1;" : : "r"(1), "r"(all_threads));
-      red_buf[threadIdx.x - thread_offset] = x;
-      // TODO(lei): maybe we can merge the two bar.sync into one?
-      asm volatile("bar.sync %0, %1;" : : "r"(2), "r"(all_threads));
-      x = Reducer()(x, red_buf[(threadIdx.x - thread_offset) ^ offset]);
     } else {
-      x = Reducer()(x, tl::shfl_xor_sync(uint32_t(-1), x, offset));
+      __syncthreads();
     }
-    if constexpr (offset == scale) {
-      return x;
+  }
+
+  template <typename T> static TL_DEVICE T warp_reduce(T x) {
+    constexpr int warp_threads = threads < 32 ? threads : 32;
+    if constexpr (scale == 1 && warp_threads == 32 &&
+                  WarpRedux<Reducer, T>::value) {
+      return WarpRedux<Reducer, T>::run(x);
     } else {
-      return AllReduce<Reducer, offset, scale, thread_offset,
-                       all_threads>::run_hopper(x, red_buf);
+#pragma unroll
+      for (int offset = warp_threads / 2; offset >= scale; offset /= 2) {
+        x = Reducer()(x, tl::shfl_xor_sync(uint32_t(-1), x, offset));
+      }
+      return x;
+    }
+  }
+
+  // Whether thread `tid` stores its partial, every thread unless compacted.
+  template <bool compact> static TL_DEVICE bool stores(int tid) {
+    return !compact || (tid & 31) < warp_parts;
+  }
+
+  // Reduction of the partials of the group of thread `tid`.
+  template <bool compact, typename T>
+  static TL_DEVICE T reduce_partials(const T *red_buf, int tid) {
+    const int base = (tid & ~(threads - 1)) | (tid & (stride - 1));
+    T x = red_buf[slot<compact>(base)];
+#pragma unroll
+    for (int i = 1; i < num_partials; ++i) {
+      x = Reducer()(x, red_buf[slot<compact>(base + i * stride)]);
+    }
+    return x;
+  }
+
+  template <bool named_barrier, bool compact, typename T>
+  static TL_DEVICE T reduce(T x, T *red_buf) {
+    x = warp_reduce(x);
+    if constexpr (num_partials > 1) {
+      const int tid = threadIdx.x - thread_offset;
+      // `red_buf` may still be read by the previous reduction.
+      sync<named_barrier>();
+      if (stores<compact>(tid)) {
+        red_buf[slot<compact>(tid)] = x;
+      }
+      sync<named_barrier>();
+      x = reduce_partials<compact>(red_buf, tid);
+    }
+    return x;
+  }
+
+  template <bool named_barrier, bool compact, int num, typename T>
+  static TL_DEVICE void reduce_batch(T *vals, T *red_buf) {
+    constexpr int size = compact ? compact_size : all_threads;
+#pragma unroll
+    for (int i = 0; i < num; ++i) {
+      vals[i] = warp_reduce(vals[i]);
+    }
+    if constexpr (num_partials > 1) {
+      const int tid = threadIdx.x - thread_offset;
+      sync<named_barrier>();
+      if (stores<compact>(tid)) {
+#pragma unroll
+        for (int i = 0; i < num; ++i) {
+          red_buf[i * size + slot<compact>(tid)] = vals[i];
+        }
+      }
+      sync<named_barrier>();
+#pragma unroll
+      for (int i = 0; i < num; ++i) {
+        vals[i] = reduce_partials<compact>(red_buf + i * size, tid);
+      }
+    }
+  }
+
+  template <bool named_barrier, int num, class... Others, typename T,
+            typename... Ts>
+  static TL_DEVICE void reduce_fused(T *red_buf, T *x, Ts *...ys) {
+    static_assert(sizeof...(Others) == sizeof...(Ts),
+                  "one reducer per fused value");
+#pragma unroll
+    for (int i = 0; i < num; ++i) {
+      x[i] = warp_reduce(x[i]);
+      ((ys[i] = Peer<Others>::warp_reduce(ys[i])), ...);
+    }
+    if constexpr (num_partials > 1) {
+      const int tid = threadIdx.x - thread_offset;
+      sync<named_barrier>();
+#pragma unroll
+      for (int i = 0; i < num; ++i) {
+        int k = 0;
+        red_buf[(k++ * num + i) * all_threads + tid] = x[i];
+        ((red_buf[(k++ * num + i) * all_threads + tid] = ys[i]), ...);
+      }
+      sync<named_barrier>();
+#pragma unroll
+      for (int i = 0; i < num; ++i) {
+        int k = 0;
+        x[i] = reduce_partials<false>(red_buf + (k++ * num + i) * all_threads,
+                                      tid);
+        ((ys[i] = Peer<Others>::template reduce_partials<false>(
+              red_buf + (k++ * num + i) * all_threads, tid)),
+         ...);
+      }
     }
   }
 };
@@ -250,6 +474,587 @@ template <int threads, int Axis = 0, bool reverse = false> struct CumSum2D {
   }
 };
 
+// Inclusive scan of `lanes` sequences of `len` elements of a tile, the
+// element `k` of lane `l` at `l * lane_stride + k * elem_stride`, each
+// scanned by one warp.
+//
+// With `segmented`, an element whose `reset` flag is set restarts the scan
+// of its lane. With `device`, the tile is tile `tile_id` of sequences split
+// over consecutive CTAs and the scan continues the one of tiles
+// 0..tile_id-1 with the decoupled look-back of Merrill and Garland: the warp
+// publishes the total of its lane in the status word `state[tile_id][l]`,
+// then reads the words of the preceding tiles 32 at a time, summing their
+// totals until it meets a tile that published its inclusive prefix, or one
+// that holds a reset, after which it publishes its own inclusive prefix.
+// The words pack the 32-bit total with its status and must be zero before
+// the launch. A CTA only waits on tiles of lower id, which must not wait on
+// it: tile ids follow the order the CTAs start in, e.g. blockIdx.x.
+template <int threads, bool reverse = false, bool segmented = false,
+          bool device = false>
+struct DeviceCumSum {
+  static_assert(threads % 32 == 0);
+
+  template <typename T, typename F, typename S>
+  static TL_DEVICE void run(const T *src, T *dst, const F *reset, S *state,
+                            int tile_id, int lanes, int len, int lane_stride,
+                            int elem_stride) {
+    static_assert(!device || sizeof(T) == 4);
+    static_assert(!device || sizeof(S) == 8);
+    constexpr unsigned MASK = 0xffffffff;
+    const int lane_id = threadIdx.x % 32;
+    for (int l = (threadIdx.x / 32) % kWarps; l < lanes; l += kWarps) {
+      const T *in = src + l * lane_stride;
+      T *out = dst + l * lane_stride;
+      auto offset = [&](int k) {
+        return (reverse ? len - 1 - k : k) * elem_stride;
+      };
+
+      // Segmented scan of the lane, 32 elements at a time.
+      T carry = T(0);
+      int first_reset = len;
+      for (int base = 0; base < len; base += 32) {
+        const int k = base + lane_id;
+        T val = k < len ? in[offset(k)] : T(0);
+        bool seg = false;
+        if constexpr (segmented) {
+          seg = k < len && reset[l * lane_stride + offset(k)] != F(0);
+          const unsigned heads = __ballot_sync(MASK, seg);
+          if (heads != 0 && first_reset == len)
+            first_reset = base + __ffs(heads) - 1;
+        }
+#pragma unroll
+        for (int off = 1; off < 32; off <<= 1) {
+          T n = tl::shfl_up_sync(MASK, val, off);
+          bool n_seg = __shfl_up_sync(MASK, seg, off);
+          if (lane_id >= off) {
+            if (!seg)
+              val += n;
+            seg = seg || n_seg;
+          }
+        }
+        if (!seg)
+          val += carry;
+        if (k < len)
+          out[offset(k)] = val;
+        carry = tl::shfl_sync(MASK, val, 31);
+      }
+
+      if constexpr (device) {
+        unsigned long long *words =
+            reinterpret_cast<unsigned long long *>(state) + l;
+        const int head = segmented ? first_reset : len;
+        T prefix = T(0);
+        if (tile_id == 0 || head < len) {
+          publish(words + tile_id * lanes, kPrefix, carry);
+        } else {
+          publish(words + tile_id * lanes, kAggregate, carry);
+          prefix = look_back<T>(words, tile_id, lanes);
+          publish(words + tile_id * lanes, kPrefix, prefix + carry);
+        }
+        // The prefix reaches the elements ahead of the first reset.
+        __syncwarp();
+        for (int k = lane_id; k < head; k += 32) {
+          out[offset(k)] += prefix;
+        }
+      }
+    }
+  }
+
+private:
+  static constexpr int kWarps = threads / 32;
+  static constexpr unsigned long long kStatusMask = 3ull << 32;
+  static constexpr unsigned long long kAggregate = 1ull << 32;
+  static constexpr unsigned long long kPrefix = 2ull << 32;
+
+  template <typename T>
+  static TL_DEVICE void publish(unsigned long long *word,
+                                unsigned long long status, T value) {
+    if (threadIdx.x % 32 == 0) {
+      unsigned bits;
+      memcpy(&bits, &value, sizeof(bits));
+      *reinterpret_cast<volatile unsigned long long *>(word) = status | bits;
+    }
+  }
+
+  // Exclusive prefix of tile `tile_id` from the status words of its lane.
+  template <typename T>
+  static TL_DEVICE T look_back(unsigned long long *words, int tile_id,
+                               int lanes) {
+    constexpr unsigned MASK = 0xffffffff;
+    const int lane_id = threadIdx.x % 32;
+    T prefix = T(0);
+    for (int pred = tile_id - 1;; pred -= 32) {
+      // Predecessor `pred - lane_id`; the ones before the first tile act as
+      // an empty inclusive prefix.
+      const int j = pred - lane_id;
+      unsigned long long word;
+      do {
+        word = j >= 0 ? *reinterpret_cast<volatile unsigned long long *>(
+                            words + j * lanes)
+                      : kPrefix;
+      } while (__any_sync(MASK, (word & kStatusMask) == 0));
+      const unsigned stops = __ballot_sync(MASK, (word & kPrefix) != 0);
+      const int last = stops != 0 ? __ffs(stops) - 1 : 31;
+      unsigned bits = static_cast<unsigned>(word);
+      T value;
+      memcpy(&value, &bits, sizeof(value));
+      value = lane_id <= last ? value : T(0);
+#pragma unroll
+      for (int off = 16; off >= 1; off >>= 1) {
+        value += tl::shfl_xor_sync(MASK, value, off);
+      }
+      prefix += value;
+      if (stops != 0)
+        return prefix;
+    }
+  }
+};
+
+// Order of the top-k selection: `a` comes before `b` when it is larger
+// (smaller unless `largest`), ties go to the lower column and empty slots,
+// marked by a negative column, come last.
+template <bool largest, typename T>
+TL_DEVICE bool topk_before(T const &a, int ia, T const &b, int ib) {
+  if (ib < 0)
+    return ia >= 0;
+  if (ia < 0)
+    return false;
+  if (a == b)
+    return ia < ib;
+  return largest ? a > b : a < b;
+}
+
+// Top-k of a row spread over `threads / scale` threads, each holding
+// `num_local` elements, for k <= 32. Every thread keeps a sorted list of its
+// best elements, the lists are merged with a butterfly: the better half of a
+// list and the reversed list of the partner is bitonic and gets sorted by a
+// half-cleaner network. The rows are written sorted.
+template <int k, int num_local, bool largest, int threads, int scale,
+          int thread_offset = 0, int all_threads = threads>
+struct TopK {
+  static_assert(k >= 1 && k <= 32);
+  static_assert(threads % scale == 0);
+  static constexpr int kSlots =
+      k <= 1 ? 1 : k <= 2 ? 2 : k <= 4 ? 4 : k <= 8 ? 8 : k <= 16 ? 16 : 32;
+  static constexpr int kGroup = threads / scale;
+
+  template <typename T>
+  static TL_DEVICE void run(const T *vals, const int *idx, T *out_vals,
+                            int *out_idx, T *red_vals = nullptr,
+                            int *red_idx = nullptr) {
+    select<false>(vals, idx, out_vals, out_idx, red_vals, red_idx);
+  }
+
+  template <typename T>
+  static TL_DEVICE void run_hopper(const T *vals, const int *idx, T *out_vals,
+                                   int *out_idx, T *red_vals = nullptr,
+                                   int *red_idx = nullptr) {
+    select<true>(vals, idx, out_vals, out_idx, red_vals, red_idx);
+  }
+
+private:
+  template <bool named_barrier, int id> static TL_DEVICE void sync() {
+    if constexpr (named_barrier) {
+      asm volatile("bar.sync %0, %1;" : : "r"(id), "r"(all_threads));
+    } else {
+      __syncthreads();
+    }
+  }
+
+  template <bool named_barrier, typename T>
+  static TL_DEVICE void select(const T *vals, const int *idx, T *out_vals,
+                               int *out_idx, T *red_vals, int *red_idx) {
+    T v[kSlots];
+    int id[kSlots];
+#pragma unroll
+    for (int j = 0; j < kSlots; ++j) {
+      v[j] = vals[0];
+      id[j] = -1;
+    }
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      T x = vals[i];
+      int ix = idx[i];
+#pragma unroll
+      for (int j = 0; j < kSlots; ++j) {
+        if (topk_before<largest>(x, ix, v[j], id[j])) {
+          T tv = v[j];
+          int ti = id[j];
+          v[j] = x;
+          id[j] = ix;
+          x = tv;
+          ix = ti;
+        }
+      }
+    }
+
+    const int tid = int(threadIdx.x) - thread_offset;
+#pragma unroll
+    for (int offset = scale; offset < threads; offset *= 2) {
+      T pv[kSlots];
+      int pi[kSlots];
+      if (offset >= 32) {
+        sync<named_barrier, 1>();
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          red_vals[j * all_threads + tid] = v[j];
+          red_idx[j * all_threads + tid] = id[j];
+        }
+        sync<named_barrier, 2>();
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          pv[j] = red_vals[j * all_threads + (tid ^ offset)];
+          pi[j] = red_idx[j * all_threads + (tid ^ offset)];
+        }
+      } else {
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          pv[j] = tl::shfl_xor_sync(uint32_t(-1), v[j], offset);
+          pi[j] = tl::shfl_xor_sync(uint32_t(-1), id[j], offset);
+        }
+      }
+#pragma unroll
+      for (int j = 0; j < kSlots; ++j) {
+        if (topk_before<largest>(pv[kSlots - 1 - j], pi[kSlots - 1 - j], v[j],
+                                 id[j])) {
+          v[j] = pv[kSlots - 1 - j];
+          id[j] = pi[kSlots - 1 - j];
+        }
+      }
+#pragma unroll
+      for (int s = kSlots / 2; s > 0; s /= 2) {
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          if ((j & s) == 0 &&
+              topk_before<largest>(v[j + s], id[j + s], v[j], id[j])) {
+            T tv = v[j];
+            int ti = id[j];
+            v[j] = v[j + s];
+            id[j] = id[j + s];
+            v[j + s] = tv;
+            id[j + s] = ti;
+          }
+        }
+      }
+    }
+
+    // All threads of the group hold the merged list, they share the stores.
+    const int rank = (tid / scale) % kGroup;
+#pragma unroll
+    for (int j = 0; j < k; ++j) {
+      if (j % kGroup == rank) {
+        out_vals[j] = v[j];
+        out_idx[j] = id[j];
+      }
+    }
+  }
+};
+
+// Unsigned key of a value whose order matches the order of the values.
+template <typename T> TL_DEVICE uint32_t topk_radix_key(T const &x) {
+  if constexpr (std::is_same_v<T, int>) {
+    return uint32_t(x) ^ 0x80000000u;
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    return x;
+  } else {
+    uint32_t bits = __float_as_uint(static_cast<float>(x));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  }
+}
+
+// Top-k of a row spread over `threads / scale` threads by radix select, for
+// any k. The key of the k-th element is found bit by bit, each pass counts
+// the candidates of the row with an AllReduce; the elements above it and the
+// first ties are then stored at positions given by a scan over the group.
+// The rows are written unsorted.
+template <int k, int num_local, bool largest, int threads, int scale,
+          int thread_offset = 0, int all_threads = threads>
+struct TopKRadix {
+  static_assert(threads % scale == 0);
+  static constexpr int kGroup = threads / scale;
+
+  template <typename T>
+  static TL_DEVICE void run(const T *vals, const int *idx, T *out_vals,
+                            int *out_idx, int *red_buf = nullptr) {
+    select<false>(vals, idx, out_vals, out_idx, red_buf);
+  }
+
+  template <typename T>
+  static TL_DEVICE void run_hopper(const T *vals, const int *idx, T *out_vals,
+                                   int *out_idx, int *red_buf = nullptr) {
+    select<true>(vals, idx, out_vals, out_idx, red_buf);
+  }
+
+private:
+  template <bool named_barrier>
+  static TL_DEVICE int group_sum(int x, int *red_buf) {
+    if constexpr (threads == 1) {
+      return x;
+    } else if constexpr (named_barrier) {
+      return AllReduce<SumOp, threads, scale, thread_offset,
+                       all_threads>::run_hopper(x, red_buf);
+    } else {
+      return AllReduce<SumOp, threads, scale, thread_offset, all_threads>::run(
+          x, red_buf);
+    }
+  }
+
+  // Sum of `x` over the threads of lower rank in the group.
+  template <bool named_barrier>
+  static TL_DEVICE int group_exclusive_sum(int x, int *red_buf) {
+    const int tid = int(threadIdx.x) - thread_offset;
+    const int rank = (tid / scale) % kGroup;
+    if constexpr (threads == 1) {
+      return 0;
+    } else if constexpr (threads <= 32) {
+      int sum = x;
+#pragma unroll
+      for (int d = 1; d < kGroup; d *= 2) {
+        int n = tl::shfl_up_sync(uint32_t(-1), sum, d * scale);
+        if (rank >= d)
+          sum += n;
+      }
+      return sum - x;
+    } else {
+      if constexpr (named_barrier) {
+        asm volatile("bar.sync %0, %1;" : : "r"(1), "r"(all_threads));
+      } else {
+        __syncthreads();
+      }
+      red_buf[tid] = x;
+      if constexpr (named_barrier) {
+        asm volatile("bar.sync %0, %1;" : : "r"(2), "r"(all_threads));
+      } else {
+        __syncthreads();
+      }
+      const int base = tid - rank * scale;
+      int sum = 0;
+      for (int r = 0; r < rank; ++r)
+        sum += red_buf[base + r * scale];
+      return sum;
+    }
+  }
+
+  template <bool named_barrier, typename T>
+  static TL_DEVICE void select(const T *vals, const int *idx, T *out_vals,
+                               int *out_idx, int *red_buf) {
+    uint32_t key[num_local];
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      key[i] = topk_radix_key(vals[i]);
+      if constexpr (!largest)
+        key[i] = ~key[i];
+    }
+
+    // `prefix` ends as the key of the k-th element, of which `ties` copies
+    // belong to the top-k.
+    uint32_t prefix = 0, mask = 0;
+    int ties = k;
+#pragma unroll 1
+    for (int bit = 31; bit >= 0; --bit) {
+      const uint32_t b = 1u << bit;
+      int count = 0;
+#pragma unroll
+      for (int i = 0; i < num_local; ++i)
+        count += ((key[i] & mask) == prefix && (key[i] & b)) ? 1 : 0;
+      count = group_sum<named_barrier>(count, red_buf);
+      if (count >= ties) {
+        prefix |= b;
+      } else {
+        ties -= count;
+      }
+      mask |= b;
+    }
+
+    int num_above = 0, num_ties = 0;
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      num_above += key[i] > prefix ? 1 : 0;
+      num_ties += key[i] == prefix ? 1 : 0;
+    }
+    int pos_above = group_exclusive_sum<named_barrier>(num_above, red_buf);
+    int pos_ties =
+        k - ties + group_exclusive_sum<named_barrier>(num_ties, red_buf);
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      if (key[i] > prefix) {
+        out_vals[pos_above] = vals[i];
+        out_idx[pos_above++] = idx[i];
+      } else if (key[i] == prefix && pos_ties < k) {
+        out_vals[pos_ties] = vals[i];
+        out_idx[pos_ties++] = idx[i];
+      }
+    }
+  }
+};
+
+// Merge of the online softmax statistics of rows held by groups of `threads`
+// consecutive threads, every `scale`-th of which holds a part of the row.
+//
+// Every thread passes the largest score `*m` of its part of the row and the
+// sum `*l` of exp2((x - *m) * softmax_scale) over its scores x; on return all
+// threads of the group hold the maximum of the row and the sum relative to
+// it. Both statistics travel together, so the row takes a single exchange
+// where a max and a sum reduction take one each. Groups wider than a warp
+// exchange through `red_buf`, 2 * all_threads floats of shared memory.
+template <int threads, int scale, int thread_offset = 0,
+          int all_threads = threads>
+struct OnlineSoftmaxReduce {
+  static_assert(threads == 1024 or threads == 512 or threads == 256 or
+                threads == 128 or threads == 64 or threads == 32 or
+                threads == 16 or threads == 8 or threads == 4 or threads == 2);
+  static_assert(threads % scale == 0);
+
+  static TL_DEVICE void run(float *m, float *l, float softmax_scale,
+                            float *red_buf = nullptr) {
+    reduce<false>(m, l, softmax_scale, red_buf);
+  }
+
+  static TL_DEVICE void run_hopper(float *m, float *l, float softmax_scale,
+                                   float *red_buf = nullptr) {
+    reduce<true>(m, l, softmax_scale, red_buf);
+  }
+
+private:
+  static constexpr int stride = scale > 32 ? scale : 32;
+  static constexpr int num_partials = threads > 32 ? threads / stride : 1;
+
+  template <bool named_barrier> static TL_DEVICE void sync() {
+    if constexpr (named_barrier) {
+      asm volatile("bar.sync %0, %1;" : : "r"(1), "r"(all_threads));
+    } else {
+      __syncthreads();
+    }
+  }
+
+  // Symmetric in its two operands, so that both ends of a shuffle agree.
+  static TL_DEVICE void merge(float &m, float &l, float om, float ol,
+                              float softmax_scale) {
+    const float mx = fmaxf(m, om);
+    l = (m == mx ? l : l * exp2f((m - mx) * softmax_scale)) +
+        (om == mx ? ol : ol * exp2f((om - mx) * softmax_scale));
+    m = mx;
+  }
+
+  template <bool named_barrier>
+  static TL_DEVICE void reduce(float *pm, float *pl, float softmax_scale,
+                               float *red_buf) {
+    float m = *pm, l = *pl;
+    constexpr int warp_threads = threads < 32 ? threads : 32;
+#pragma unroll
+    for (int offset = warp_threads / 2; offset >= scale; offset /= 2) {
+      float om = tl::shfl_xor_sync(uint32_t(-1), m, offset);
+      float ol = tl::shfl_xor_sync(uint32_t(-1), l, offset);
+      merge(m, l, om, ol, softmax_scale);
+    }
+    if constexpr (num_partials > 1) {
+      const int tid = threadIdx.x - thread_offset;
+      sync<named_barrier>();
+      red_buf[tid] = m;
+      red_buf[all_threads + tid] = l;
+      sync<named_barrier>();
+      const int base = (tid & ~(threads - 1)) | (tid & (stride - 1));
+      m = red_buf[base];
+      l = red_buf[all_threads + base];
+#pragma unroll
+      for (int i = 1; i < num_partials; ++i) {
+        merge(m, l, red_buf[base + i * stride],
+              red_buf[all_threads + base + i * stride], softmax_scale);
+      }
+    }
+    *pm = m;
+    *pl = l;
+  }
+};
+
+// Merge of the Welford statistics of rows held by groups of `threads`
+// consecutive threads, every `scale`-th of which holds a part of the row.
+//
+// Every thread passes the mean `*mean` and the sum of squared deviations
+// `*m2` of the `count` elements of its part of the row; on return all threads
+// of the group hold the mean and the sum of squared deviations of the row
+// (Chan et al.), from which the variance follows without the cancellation of
+// E[x^2] - E[x]^2. Groups wider than a warp exchange through `red_buf`,
+// 3 * all_threads floats of shared memory.
+template <int threads, int scale, int thread_offset = 0,
+          int all_threads = threads>
+struct WelfordReduce {
+  static_assert(threads == 1024 or threads == 512 or threads == 256 or
+                threads == 128 or threads == 64 or threads == 32 or
+                threads == 16 or threads == 8 or threads == 4 or threads == 2);
+  static_assert(threads % scale == 0);
+
+  static TL_DEVICE void run(float *mean, float *m2, float count,
+                            float *red_buf = nullptr) {
+    reduce<false>(mean, m2, count, red_buf);
+  }
+
+  static TL_DEVICE void run_hopper(float *mean, float *m2, float count,
+                                   float *red_buf = nullptr) {
+    reduce<true>(mean, m2, count, red_buf);
+  }
+
+private:
+  static constexpr int stride = scale > 32 ? scale : 32;
+  static constexpr int num_partials = threads > 32 ? threads / stride : 1;
+
+  template <bool named_barrier> static TL_DEVICE void sync() {
+    if constexpr (named_barrier) {
+      asm volatile("bar.sync %0, %1;" : : "r"(1), "r"(all_threads));
+    } else {
+      __syncthreads();
+    }
+  }
+
+  // Symmetric in its two operands, so that both ends of a shuffle agree; the
+  // explicit roundings keep the compiler from contracting one side only.
+  static TL_DEVICE void merge(float &mean, float &m2, float &n, float omean,
+                              float om2, float on) {
+    const float total = __fadd_rn(n, on);
+    const float delta = omean - mean;
+    const float weight = __fdiv_rn(__fmul_rn(n, on), total);
+    mean = __fdiv_rn(__fadd_rn(__fmul_rn(mean, n), __fmul_rn(omean, on)),
+                     total);
+    m2 = __fadd_rn(__fadd_rn(m2, om2),
+                   __fmul_rn(__fmul_rn(delta, delta), weight));
+    n = total;
+  }
+
+  template <bool named_barrier>
+  static TL_DEVICE void reduce(float *pmean, float *pm2, float count,
+                               float *red_buf) {
+    float mean = *pmean, m2 = *pm2, n = count;
+    constexpr int warp_threads = threads < 32 ? threads : 32;
+#pragma unroll
+    for (int offset = warp_threads / 2; offset >= scale; offset /= 2) {
+      float omean = tl::shfl_xor_sync(uint32_t(-1), mean, offset);
+      float om2 = tl::shfl_xor_sync(uint32_t(-1), m2, offset);
+      float on = tl::shfl_xor_sync(uint32_t(-1), n, offset);
+      merge(mean, m2, n, omean, om2, on);
+    }
+    if constexpr (num_partials > 1) {
+      const int tid = threadIdx.x - thread_offset;
+      sync<named_barrier>();
+      red_buf[tid] = mean;
+      red_buf[all_threads + tid] = m2;
+      red_buf[2 * all_threads + tid] = n;
+      sync<named_barrier>();
+      const int base = (tid & ~(threads - 1)) | (tid & (stride - 1));
+      mean = red_buf[base];
+      m2 = red_buf[all_threads + base];
+      n = red_buf[2 * all_threads + base];
+#pragma unroll
+      for (int i = 1; i < num_partials; ++i) {
+        const int other = base + i * stride;
+        merge(mean, m2, n, red_buf[other], red_buf[all_threads + other],
+              red_buf[2 * all_threads + other]);
+      }
+    }
+    *pmean = mean;
+    *pm2 = m2;
+  }
+};
+
 template <typename T, typename ReduceOp>
 TL_DEVICE T warp_reduce(T value, ReduceOp op) {
   constexpr uint32_t mask = 0xffffffff;
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "common.h"
+
+// Communication between the ranks of a node through symmetric tensors, see
+// `tilelang.jit.adapter.SymmetricHeap`. Every symmetric tensor is preceded
+// by a table holding, for each peer, the address at which the same tensor
+// of that peer is mapped into this process through CUDA IPC, so the address
+// of a peer tensor is one load away from the base of the local one.
+
+namespace tl {
+
+// Matches SymmetricHeap.MAX_PEERS
+constexpr int kSymmMaxPeers = 8;
+
+// Base of the symmetric tensor `base` of rank `peer`
+template <typename T> TL_DEVICE T *symm_remote_ptr(T *base, int peer) {
+  const unsigned long long *peers =
+      reinterpret_cast<const unsigned long long *>(base) - kSymmMaxPeers;
+  return reinterpret_cast<T *>(__ldg(peers + peer));
+}
+
+// Matches the ops of T.signal
+enum class SymmSignalOp : int { kSet = 0, kAdd = 1 };
+
+// Matches the comparisons of T.signal_wait
+enum class SymmCompare : int {
+  kEq = 0,
+  kNe = 1,
+  kGe = 2,
+  kGt = 3,
+  kLe = 4,
+  kLt = 5,
+};
+
+#if (defined(__CUDA_ARCH_LIST__) && (__CUDA_ARCH_LIST__ >= 700))
+
+// The threads of the block, or with a named barrier only those of the warp
+// specialized role issuing the operation
+template <int barrier_id, int thread_count> TL_DEVICE void symm_sync() {
+  if constexpr (barrier_id == 0) {
+    __syncthreads();
+  } else {
+    __sync_thread_partial<barrier_id, thread_count>();
+  }
+}
+
+// Set or add to the signal `addr` once every thread of the block is past
+// its transfers. The release at system scope makes the writes of the block
+// ordered by the barrier visible to the peer waiting for the signal.
+template <int barrier_id = 0, int thread_count = 0>
+TL_DEVICE void symm_signal(uint64_t *addr, uint64_t value, int op,
+                           bool leader) {
+  symm_sync<barrier_id, thread_count>();
+  if (!leader)
+    return;
+  if (op == static_cast<int>(SymmSignalOp::kSet)) {
+    asm volatile("st.release.sys.global.u64 [%0], %1;\n" ::"l"(addr),
+                 "l"(value)
+                 : "memory");
+  } else {
+    asm volatile("red.release.sys.global.add.u64 [%0], %1;\n" ::"l"(addr),
+                 "l"(value)
+                 : "memory");
+  }
+}
+
+TL_DEVICE bool symm_compare(uint64_t lhs, uint64_t rhs, int cmp) {
+  switch (static_cast<SymmCompare>(cmp)) {
+  case SymmCompare::kEq:
+    return lhs == rhs;
+  case SymmCompare::kNe:
+    return lhs != rhs;
+  case SymmCompare::kGe:
+    return lhs >= rhs;
+  case SymmCompare::kGt:
+    return lhs > rhs;
+  case SymmCompare::kLe:
+    return lhs <= rhs;
+  default:
+    return lhs < rhs;
+  }
+}
+
+// Block until the local signal `addr` compares to `value`. The leader spins
+// with acquire loads at system scope and the barrier releases the block, so
+// the peer writes ordered before the signal are visible to all its threads.
+template <int barrier_id = 0, int thread_count = 0>
+TL_DEVICE void symm_wait(const uint64_t *addr, uint64_t value, int cmp,
+                         bool leader) {
+  if (leader) {
+    uint64_t current;
+    do {
+      asm volatile("ld.acquire.sys.global.u64 %0, [%1];\n"
+                   : "=l"(current)
+                   : "l"(addr)
+                   : "memory");
+    } while (!symm_compare(current, value, cmp));
+  }
+  symm_sync<barrier_id, thread_count>();
+}
+
+#endif
+
+} // namespace tl
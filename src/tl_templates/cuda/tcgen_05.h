@@ -5,6 +5,7 @@
 #include <cuda.h>
 #endif
 
+#include "cluster.h"
 #include "common.h"
 #include <cute/arch/cluster_sm90.hpp>
 
@@ -26,6 +27,25 @@ TL_DEVICE void tmem_deallocate(uint32_t *tmem_ptr, int num_columns) {
                : "r"(*tmem_ptr), "r"(num_columns));
 }
 
+// Kernels issuing 2-CTA MMAs allocate tensor memory for both CTAs of a
+// cluster pair at once: one warp of each CTA executes the allocation, which
+// returns the same address to both, and likewise for the deallocation.
+TL_DEVICE void tmem_allocate_2cta(void *dst_ptr, int num_columns) {
+  uint32_t dst_intptr = smem_ptr_to_uint(dst_ptr);
+  asm volatile(
+      "tcgen05.alloc.cta_group::2.sync.aligned.shared::cta.b32 [%0], %1;"
+      :
+      : "r"(dst_intptr), "r"(num_columns));
+}
+
+TL_DEVICE void tmem_deallocate_2cta(uint32_t *tmem_ptr, int num_columns) {
+  asm volatile("{\n\t"
+               "tcgen05.dealloc.cta_group::2.sync.aligned.b32  %0, %1; \n\t"
+               "}"
+               :
+               : "r"(*tmem_ptr), "r"(num_columns));
+}
+
 inline void __device__ fence_view_async_tmem_load() {
   asm volatile("tcgen05.wait::ld.sync.aligned; " ::);
 }
@@ -34,6 +54,16 @@ inline void __device__ fence_view_async_tmem_store() {
   asm volatile("tcgen05.wait::st.sync.aligned; " ::);
 }
 
+// Order the tcgen05 operations of a thread around a thread barrier, e.g.
+// before the columns read by the threads are written by the next MMA.
+TL_DEVICE void tcgen05_before_thread_sync() {
+  asm volatile("tcgen05.fence::before_thread_sync;" ::: "memory");
+}
+
+TL_DEVICE void tcgen05_after_thread_sync() {
+  asm volatile("tcgen05.fence::after_thread_sync;" ::: "memory");
+}
+
 template <int M, int N>
 inline void __device__ amma_fp16bf16_ss(uint64_t const desc_a,
                                         uint64_t const desc_b,
@@ -60,6 +90,19 @@ inline void __device__ amma_fp16bf16_ss(uint64_t const desc_a,
                  "r"(mask[0]), "r"(mask[1]), "r"(mask[2]), "r"(mask[3]));
 }
 
+// Copy 32 rows of 16 bytes from shared memory, described by a no-swizzle
+// matrix descriptor, into 4 columns of the 32 lanes of each of the 4
+// sub-partitions of tensor memory. The tcgen05.mma issued after it by the
+// same thread observes the copy.
+TL_DEVICE void tcgen05_cp_32x128b_warpx4(uint64_t const &desc,
+                                         uint32_t const &tmem_addr) {
+  if (cute::elect_one_sync()) {
+    asm volatile("tcgen05.cp.cta_group::1.32x128b.warpx4 [%0], %1;"
+                 :
+                 : "r"(tmem_addr), "l"(desc));
+  }
+}
+
 // Wrapper for CUTLASS umma_arrive: elect one lane, then arrive the mbarrier
 TL_DEVICE void tcgen05_mma_arrive(void const *smem_ptr) {
   uint32_t bar_intptr = smem_ptr_to_uint(smem_ptr);
@@ -71,4 +114,18 @@ TL_DEVICE void tcgen05_mma_arrive(void const *smem_ptr) {
   }
 }
 
+// 2-CTA counterpart of tcgen05_mma_arrive, called by the CTA issuing the
+// MMAs: completion is signaled on the mbarrier at the same offset in both
+// CTAs of the pair, since the MMAs read and write the memory of both.
+TL_DEVICE void tcgen05_mma_arrive_2cta(void const *smem_ptr) {
+  uint32_t bar_intptr = smem_ptr_to_uint(smem_ptr);
+  uint16_t cta_mask = static_cast<uint16_t>(0x3u << (cluster_ctarank() & ~1u));
+  if (cute::elect_one_sync()) {
+    asm volatile("tcgen05.commit.cta_group::2.mbarrier::arrive::one.shared::"
+                 "cluster.multicast::cluster.b64 [%0], %1;"
+                 :
+                 : "r"(bar_intptr), "h"(cta_mask));
+  }
+}
+
 } // namespace tl
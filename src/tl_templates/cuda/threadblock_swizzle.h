@@ -40,4 +40,81 @@ template <int panel_width> TL_DEVICE dim3 rasterization2DColumn() {
   return {col_idx, row_idx, blockIdx.z};
 }
 
+namespace detail {
+
+// Decode a Morton (Z-order) index into coordinates of a square block.
+TL_DEVICE void mortonDecode(unsigned int d, unsigned int &x, unsigned int &y) {
+  x = 0;
+  y = 0;
+#pragma unroll
+  for (int i = 0; i < 16; ++i) {
+    x |= ((d >> (2 * i)) & 1u) << i;
+    y |= ((d >> (2 * i + 1)) & 1u) << i;
+  }
+}
+
+// Decode a Hilbert curve index into coordinates of an n x n block, where n is
+// a power of two.
+TL_DEVICE void hilbertDecode(unsigned int n, unsigned int d, unsigned int &x,
+                             unsigned int &y) {
+  x = 0;
+  y = 0;
+  for (unsigned int s = 1; s < n; s *= 2) {
+    const unsigned int rx = 1 & (d / 2);
+    const unsigned int ry = 1 & (d ^ rx);
+    if (ry == 0) {
+      if (rx == 1) {
+        x = s - 1 - x;
+        y = s - 1 - y;
+      }
+      const unsigned int t = x;
+      x = y;
+      y = t;
+    }
+    x += s * rx;
+    y += s * ry;
+    d /= 4;
+  }
+}
+
+// Walk the grid in bands of `group` rows, and each band in square tiles of
+// `group` x `group` blocks ordered along a space-filling curve. Partial tiles
+// at the right and bottom edges fall back to row-major order, so the mapping
+// stays a bijection for any grid shape.
+template <int group, bool use_hilbert> TL_DEVICE dim3 rasterizationCurve() {
+  static_assert(group > 0 && (group & (group - 1)) == 0,
+                "curve rasterization requires a power-of-two group");
+  const unsigned int block_idx = blockIdx.x + blockIdx.y * gridDim.x;
+  const unsigned int band_idx = block_idx / (group * gridDim.x);
+  const unsigned int band_offset = block_idx % (group * gridDim.x);
+  const unsigned int band_rows = gridDim.y - band_idx * group;
+  const unsigned int band_height = band_rows < group ? band_rows : group;
+  const unsigned int tile_idx = band_offset / (group * band_height);
+  const unsigned int tile_offset = band_offset % (group * band_height);
+  const unsigned int tile_cols = gridDim.x - tile_idx * group;
+  const unsigned int tile_width = tile_cols < group ? tile_cols : group;
+  unsigned int x, y;
+  if (tile_width == group && band_height == group) {
+    if (use_hilbert) {
+      hilbertDecode(group, tile_offset, x, y);
+    } else {
+      mortonDecode(tile_offset, x, y);
+    }
+  } else {
+    x = tile_offset % tile_width;
+    y = tile_offset / tile_width;
+  }
+  return {tile_idx * group + x, band_idx * group + y, blockIdx.z};
+}
+
+} // namespace detail
+
+template <int group> TL_DEVICE dim3 rasterizationMorton() {
+  return detail::rasterizationCurve<group, false>();
+}
+
+template <int group> TL_DEVICE dim3 rasterizationHilbert() {
+  return detail::rasterizationCurve<group, true>();
+}
+
 } // namespace tl
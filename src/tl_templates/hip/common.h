@@ -86,9 +86,16 @@ struct bfloat16x16 {
 
 typedef
     __attribute__((__vector_size__(4 * sizeof(short)))) short bfloat16x4_vec;
+typedef
+    __attribute__((__vector_size__(8 * sizeof(short)))) short bfloat16x8_vec;
+typedef
+    __attribute__((__vector_size__(16 * sizeof(short)))) short bfloat16x16_vec;
 
 using int32x4 = __attribute__((__vector_size__(4 * sizeof(int)))) int;
+using int32x8 = __attribute__((__vector_size__(8 * sizeof(int)))) int;
+using float32x2 = __attribute__((__vector_size__(2 * sizeof(float)))) float;
 using float32x4 = __attribute__((__vector_size__(4 * sizeof(float)))) float;
+using float32x8 = __attribute__((__vector_size__(8 * sizeof(float)))) float;
 using float32x16 = __attribute__((__vector_size__(16 * sizeof(float)))) float;
 
 using int8x4 = __attribute__((__vector_size__(4 * sizeof(int8_t)))) int8_t;
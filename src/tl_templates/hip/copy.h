@@ -72,9 +72,38 @@ CK_TILE_DEVICE void async_buffer_load_dword_v(void *smem, int32x4_t rsrc,
                : "memory");
 }
 
+#if defined(__gfx950__)
+using lds_ptr_t = __attribute__((address_space(3))) void *;
+using global_ptr_t = __attribute__((address_space(1))) void *;
+
+// CDNA4 loads up to 16 bytes per lane from global memory straight into LDS
+// (global_load_lds_dwordx4), skipping the VGPRs, lane i of the wave writing
+// M0 + N * i. Returns false, uniformly across the wave, when the lanes do not
+// write one contiguous run of LDS, as for the swizzled MFMA operand layouts:
+// the caller then goes through registers.
+template <int N>
+TL_DEVICE bool cp_async_gs_direct(void *lds_base_ptr,
+                                  void const *global_base_ptr) {
+  uint32_t lane = __lane_id();
+  uint32_t lds =
+      static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lds_base_ptr));
+  uint32_t run = __builtin_amdgcn_readfirstlane(lds - N * lane);
+  if (!__all(lds - N * lane == run))
+    return false;
+  __builtin_amdgcn_global_load_lds(
+      (global_ptr_t)(const_cast<void *>(global_base_ptr)),
+      (lds_ptr_t)(static_cast<size_t>(run)), N, 0, 0);
+  return true;
+}
+#endif
+
 template <int N>
 TL_DEVICE void cp_async_gs(void *lds_base_ptr, void const *global_base_ptr) {
   if constexpr (N == 16) {
+#if defined(__gfx950__)
+    if (cp_async_gs_direct<N>(lds_base_ptr, global_base_ptr))
+      return;
+#endif
     *(uint4 *)lds_base_ptr = *(const uint4 *)global_base_ptr;
   } else if constexpr (N == 8) {
     *(uint2 *)lds_base_ptr = *(const uint2 *)global_base_ptr;
@@ -91,6 +120,10 @@ template <int N>
 TL_DEVICE void cp_async_gs_conditional(void *lds_base_ptr,
                                        void const *global_base_ptr, bool cond) {
   if constexpr (N == 16) {
+#if defined(__gfx950__)
+    if (__all(cond) && cp_async_gs_direct<N>(lds_base_ptr, global_base_ptr))
+      return;
+#endif
     *(uint4 *)lds_base_ptr =
         cond ? *(const uint4 *)global_base_ptr : make_uint4(0, 0, 0, 0);
   } else if constexpr (N == 8) {
@@ -109,4 +142,31 @@ TL_DEVICE void cp_async_gs_conditional(void *lds_base_ptr,
   }
 }
 
+// Global accesses carrying the cache hint of SIMT copies (the
+// eviction_policy annotation: 1=evict_first, 2=evict_last, 3=no_allocate).
+// evict_first and no_allocate become non-temporal accesses (slc/nt), HIP has
+// no policy keeping a line resident so evict_last is a plain access.
+template <int kCacheHint, typename T>
+TL_DEVICE T ld_global_hint(const T *ptr) {
+  if constexpr (kCacheHint != 2 && sizeof(T) % 4 == 0 && sizeof(T) <= 16) {
+    using V = uint32_t __attribute__((ext_vector_type(sizeof(T) / 4)));
+    V r = __builtin_nontemporal_load(reinterpret_cast<const V *>(ptr));
+    return __builtin_bit_cast(T, r);
+  } else {
+    return *ptr;
+  }
+}
+
+template <int kCacheHint, typename T, typename V>
+TL_DEVICE void st_global_hint(T *ptr, const V &value) {
+  T v = value;
+  if constexpr (kCacheHint != 2 && sizeof(T) % 4 == 0 && sizeof(T) <= 16) {
+    using U = uint32_t __attribute__((ext_vector_type(sizeof(T) / 4)));
+    __builtin_nontemporal_store(__builtin_bit_cast(U, v),
+                                reinterpret_cast<U *>(ptr));
+  } else {
+    *ptr = v;
+  }
+}
+
 } // namespace tl
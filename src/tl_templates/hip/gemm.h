@@ -62,8 +62,62 @@ template <> struct MfmaTraits<fp8_e4_t> {
     *c = __builtin_amdgcn_mfma_f32_16x16x32_fp8_fp8(b_val, a_val, *c, 0, 0, 0);
   }
 };
+
+// Specialization for fp8_e5_t
+template <> struct MfmaTraits<fp8_e5_t> {
+  template <typename AccType>
+  static TL_DEVICE void mfma_op(const fp8_e5_t *b, const fp8_e5_t *a,
+                                AccType *c) {
+    int64_t a_val = *reinterpret_cast<const int64_t *>(a);
+    int64_t b_val = *reinterpret_cast<const int64_t *>(b);
+    *c = __builtin_amdgcn_mfma_f32_16x16x32_bf8_bf8(b_val, a_val, *c, 0, 0, 0);
+  }
+};
+#endif
+
+#if defined(__gfx950__)
+// f8f6f4 MFMA of CDNA4 (gfx950), c[16x16] += (a[16x128] * sa) * (b[128x16] *
+// sb). Lane l holds the 32 elements of K (l / 16) * 32 of row l % 16 of a and
+// b, in 32 (FP8), 24 (FP6) or 16 (FP4) bytes, and their UE8M0 scale factors
+// sa and sb. AFmt and BFmt are the operand formats: 0 e4m3, 1 e5m2, 2 e2m3,
+// 3 e3m2 and 4 e2m1, see MatrixCoreIntrinEmitter.f8f6f4_format.
+template <int AFmt, int BFmt>
+TL_DEVICE void mfma_scale_f32_16x16x128_f8f6f4(const void *a, const void *b,
+                                               float *c, int sa, int sb) {
+  constexpr int kBytesA = AFmt < 2 ? 32 : (AFmt < 4 ? 24 : 16);
+  constexpr int kBytesB = BFmt < 2 ? 32 : (BFmt < 4 ? 24 : 16);
+  int32x8 a_vec = {}, b_vec = {};
+  __builtin_memcpy(&a_vec, a, kBytesA);
+  __builtin_memcpy(&b_vec, b, kBytesB);
+  *((float32x4 *)c) = __builtin_amdgcn_mfma_scale_f32_16x16x128_f8f6f4(
+      a_vec, b_vec, *((float32x4 *)c), AFmt, BFmt, 0, sa, 0, sb);
+}
+
+// Unscaled f8f6f4 MFMA, the scale factors are 2^0
+template <int AFmt, int BFmt>
+TL_DEVICE void mfma_f32_16x16x128_f8f6f4(const void *a, const void *b,
+                                         float *c) {
+  mfma_scale_f32_16x16x128_f8f6f4<AFmt, BFmt>(a, b, c, 127, 127);
+}
 #endif
 
+// 2:4 structured-sparse MFMA of CDNA3 (gfx94x), c[16x16] += a[16x32] * b[32x16]
+// where a holds the 2 kept values of every 4 along K and idx their 2-bit
+// positions, see SparseMatrixCoreIntrinEmitter in mfma_macro_generator.py.
+TL_DEVICE void smfmac_f32_16x16x32_f16(const half_t *a, const half_t *b,
+                                       float *c, int idx) {
+  *((float32x4 *)c) = __builtin_amdgcn_smfmac_f32_16x16x32_f16(
+      *((float16x4 *)a), *((float16x8 *)b), *((float32x4 *)c), idx, 0, 0);
+}
+
+TL_DEVICE void smfmac_f32_16x16x32_bf16(const bfloat16_t *a,
+                                        const bfloat16_t *b, float *c,
+                                        int idx) {
+  *((float32x4 *)c) = __builtin_amdgcn_smfmac_f32_16x16x32_bf16(
+      *((bfloat16x4_vec *)a), *((bfloat16x8_vec *)b), *((float32x4 *)c), idx,
+      0, 0);
+}
+
 // ref to bitblas/tl/mfma_macro_generator.py::kPack
 template <int M, int N, int K, int num_warp_m, int num_warp_n, bool TransposeA,
           bool TransposeB, bool clear_accum, int kPack, typename A_type,
@@ -22,6 +22,12 @@ struct MinOp {
   }
 };
 
+struct ProdOp {
+  template <typename T> TL_DEVICE T operator()(T const &x, T const &y) {
+    return x * y;
+  }
+};
+
 struct BitAndOp {
   template <typename T> TL_DEVICE T operator()(T const &x, T const &y) {
     return x & y;
@@ -40,6 +46,42 @@ struct BitXorOp {
   }
 };
 
+// Value of `x` in lane `lane ^ offset` for offset < 16, through DPP moves
+// within rows of 16 lanes, which the compiler folds into the instruction
+// consuming them, rather than the ds_bpermute of __shfl_xor.
+template <int offset> TL_DEVICE int dpp_xor_b32(int x) {
+  static_assert(offset == 1 || offset == 2 || offset == 4 || offset == 8);
+  if constexpr (offset == 1) {
+    // quad_perm:[1,0,3,2]
+    return __builtin_amdgcn_mov_dpp(x, 0xB1, 0xF, 0xF, false);
+  } else if constexpr (offset == 2) {
+    // quad_perm:[2,3,0,1]
+    return __builtin_amdgcn_mov_dpp(x, 0x4E, 0xF, 0xF, false);
+  } else {
+    // The banks of 4 lanes below their partner read row_shl:offset, the
+    // others row_shr:offset
+    constexpr int low = offset == 4 ? 0x5 : 0x3;
+    int y = __builtin_amdgcn_update_dpp(0, x, 0x100 + offset, 0xF, low, false);
+    return __builtin_amdgcn_update_dpp(y, x, 0x110 + offset, 0xF, 0xF ^ low,
+                                       false);
+  }
+}
+
+// tl::shfl_xor with a constant offset, in DPP moves for the offsets within
+// a row and the values of 2 or 4 bytes.
+template <int offset, typename T> TL_DEVICE T shfl_xor_dpp(T x) {
+  if constexpr (offset < 16 && sizeof(T) == 4) {
+    return __builtin_bit_cast(
+        T, dpp_xor_b32<offset>(__builtin_bit_cast(int, x)));
+  } else if constexpr (offset < 16 && sizeof(T) == 2) {
+    int bits = __builtin_bit_cast(unsigned short, x);
+    return __builtin_bit_cast(
+        T, static_cast<unsigned short>(dpp_xor_b32<offset>(bits)));
+  } else {
+    return tl::shfl_xor(x, offset);
+  }
+}
+
 template <class Reducer, int Threads, bool UseAbs, bool NeedAccumulate>
 struct SharedReduceWarp {
   template <typename T>
@@ -104,7 +146,7 @@ struct AllReduce {
       __syncthreads();
       x = Reducer()(x, red_buf[threadIdx.x ^ offset]);
     } else {
-      x = Reducer()(x, tl::shfl_xor(x, offset));
+      x = Reducer()(x, tl::shfl_xor_dpp<offset>(x));
     }
     if constexpr (offset == scale) {
       return x;
@@ -114,6 +156,249 @@ struct AllReduce {
   }
 };
 
+// Order of the top-k selection: `a` comes before `b` when it is larger
+// (smaller unless `largest`), ties go to the lower column and empty slots,
+// marked by a negative column, come last.
+template <bool largest, typename T>
+TL_DEVICE bool topk_before(T const &a, int ia, T const &b, int ib) {
+  if (ib < 0)
+    return ia >= 0;
+  if (ia < 0)
+    return false;
+  if (a == b)
+    return ia < ib;
+  return largest ? a > b : a < b;
+}
+
+// Top-k of a row spread over `threads / scale` threads, each holding
+// `num_local` elements, for k <= 32; see the CUDA kernel, here the butterfly
+// shuffles within 64-wide wavefronts. The rows are written sorted.
+template <int k, int num_local, bool largest, int threads, int scale,
+          int thread_offset = 0, int all_threads = threads>
+struct TopK {
+  static_assert(k >= 1 && k <= 32);
+  static_assert(threads % scale == 0);
+  static constexpr int kSlots =
+      k <= 1 ? 1 : k <= 2 ? 2 : k <= 4 ? 4 : k <= 8 ? 8 : k <= 16 ? 16 : 32;
+  static constexpr int kGroup = threads / scale;
+
+  template <typename T>
+  static TL_DEVICE void run(const T *vals, const int *idx, T *out_vals,
+                            int *out_idx, T *red_vals = nullptr,
+                            int *red_idx = nullptr) {
+    select(vals, idx, out_vals, out_idx, red_vals, red_idx);
+  }
+
+
+private:
+  template <typename T>
+  static TL_DEVICE void select(const T *vals, const int *idx, T *out_vals,
+                               int *out_idx, T *red_vals, int *red_idx) {
+    T v[kSlots];
+    int id[kSlots];
+#pragma unroll
+    for (int j = 0; j < kSlots; ++j) {
+      v[j] = vals[0];
+      id[j] = -1;
+    }
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      T x = vals[i];
+      int ix = idx[i];
+#pragma unroll
+      for (int j = 0; j < kSlots; ++j) {
+        if (topk_before<largest>(x, ix, v[j], id[j])) {
+          T tv = v[j];
+          int ti = id[j];
+          v[j] = x;
+          id[j] = ix;
+          x = tv;
+          ix = ti;
+        }
+      }
+    }
+
+    const int tid = int(threadIdx.x) - thread_offset;
+#pragma unroll
+    for (int offset = scale; offset < threads; offset *= 2) {
+      T pv[kSlots];
+      int pi[kSlots];
+      if (offset >= 64) {
+        __syncthreads();
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          red_vals[j * all_threads + tid] = v[j];
+          red_idx[j * all_threads + tid] = id[j];
+        }
+        __syncthreads();
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          pv[j] = red_vals[j * all_threads + (tid ^ offset)];
+          pi[j] = red_idx[j * all_threads + (tid ^ offset)];
+        }
+      } else {
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          pv[j] = tl::shfl_xor(v[j], offset);
+          pi[j] = tl::shfl_xor(id[j], offset);
+        }
+      }
+#pragma unroll
+      for (int j = 0; j < kSlots; ++j) {
+        if (topk_before<largest>(pv[kSlots - 1 - j], pi[kSlots - 1 - j], v[j],
+                                 id[j])) {
+          v[j] = pv[kSlots - 1 - j];
+          id[j] = pi[kSlots - 1 - j];
+        }
+      }
+#pragma unroll
+      for (int s = kSlots / 2; s > 0; s /= 2) {
+#pragma unroll
+        for (int j = 0; j < kSlots; ++j) {
+          if ((j & s) == 0 &&
+              topk_before<largest>(v[j + s], id[j + s], v[j], id[j])) {
+            T tv = v[j];
+            int ti = id[j];
+            v[j] = v[j + s];
+            id[j] = id[j + s];
+            v[j + s] = tv;
+            id[j + s] = ti;
+          }
+        }
+      }
+    }
+
+    // All threads of the group hold the merged list, they share the stores.
+    const int rank = (tid / scale) % kGroup;
+#pragma unroll
+    for (int j = 0; j < k; ++j) {
+      if (j % kGroup == rank) {
+        out_vals[j] = v[j];
+        out_idx[j] = id[j];
+      }
+    }
+  }
+};
+
+// Unsigned key of a value whose order matches the order of the values.
+template <typename T> TL_DEVICE uint32_t topk_radix_key(T const &x) {
+  if constexpr (std::is_same_v<T, int>) {
+    return uint32_t(x) ^ 0x80000000u;
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    return x;
+  } else {
+    uint32_t bits = __float_as_uint(static_cast<float>(x));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+  }
+}
+
+// Top-k of a row spread over `threads / scale` threads by radix select, for
+// any k. The key of the k-th element is found bit by bit, each pass counts
+// the candidates of the row with an AllReduce; the elements above it and the
+// first ties are then stored at positions given by a scan over the group.
+// The rows are written unsorted.
+template <int k, int num_local, bool largest, int threads, int scale,
+          int thread_offset = 0, int all_threads = threads>
+struct TopKRadix {
+  static_assert(threads % scale == 0);
+  static constexpr int kGroup = threads / scale;
+
+  template <typename T>
+  static TL_DEVICE void run(const T *vals, const int *idx, T *out_vals,
+                            int *out_idx, int *red_buf = nullptr) {
+    select(vals, idx, out_vals, out_idx, red_buf);
+  }
+
+
+private:
+  static TL_DEVICE int group_sum(int x, int *red_buf) {
+    if constexpr (threads == 1) {
+      return x;
+    } else {
+      return AllReduce<SumOp, threads, scale, thread_offset>::run(x, red_buf);
+    }
+  }
+
+  // Sum of `x` over the threads of lower rank in the group.
+  static TL_DEVICE int group_exclusive_sum(int x, int *red_buf) {
+    const int tid = int(threadIdx.x) - thread_offset;
+    const int rank = (tid / scale) % kGroup;
+    if constexpr (threads == 1) {
+      return 0;
+    } else if constexpr (threads <= 64) {
+      int sum = x;
+#pragma unroll
+      for (int d = 1; d < kGroup; d *= 2) {
+        int n = tl::shfl_up(sum, d * scale);
+        if (rank >= d)
+          sum += n;
+      }
+      return sum - x;
+    } else {
+      __syncthreads();
+      red_buf[tid] = x;
+      __syncthreads();
+      const int base = tid - rank * scale;
+      int sum = 0;
+      for (int r = 0; r < rank; ++r)
+        sum += red_buf[base + r * scale];
+      return sum;
+    }
+  }
+
+  template <typename T>
+  static TL_DEVICE void select(const T *vals, const int *idx, T *out_vals,
+                               int *out_idx, int *red_buf) {
+    uint32_t key[num_local];
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      key[i] = topk_radix_key(vals[i]);
+      if constexpr (!largest)
+        key[i] = ~key[i];
+    }
+
+    // `prefix` ends as the key of the k-th element, of which `ties` copies
+    // belong to the top-k.
+    uint32_t prefix = 0, mask = 0;
+    int ties = k;
+#pragma unroll 1
+    for (int bit = 31; bit >= 0; --bit) {
+      const uint32_t b = 1u << bit;
+      int count = 0;
+#pragma unroll
+      for (int i = 0; i < num_local; ++i)
+        count += ((key[i] & mask) == prefix && (key[i] & b)) ? 1 : 0;
+      count = group_sum(count, red_buf);
+      if (count >= ties) {
+        prefix |= b;
+      } else {
+        ties -= count;
+      }
+      mask |= b;
+    }
+
+    int num_above = 0, num_ties = 0;
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      num_above += key[i] > prefix ? 1 : 0;
+      num_ties += key[i] == prefix ? 1 : 0;
+    }
+    int pos_above = group_exclusive_sum(num_above, red_buf);
+    int pos_ties =
+        k - ties + group_exclusive_sum(num_ties, red_buf);
+#pragma unroll
+    for (int i = 0; i < num_local; ++i) {
+      if (key[i] > prefix) {
+        out_vals[pos_above] = vals[i];
+        out_idx[pos_above++] = idx[i];
+      } else if (key[i] == prefix && pos_ties < k) {
+        out_vals[pos_ties] = vals[i];
+        out_idx[pos_ties++] = idx[i];
+      }
+    }
+  }
+};
+
 template <int threads, bool reverse = false> struct CumSum1D {
   static_assert(threads == 1024 or threads == 512 or threads == 256 or
                 threads == 128 or threads == 64);
@@ -261,12 +546,12 @@ template <int threads, int Axis = 0, bool reverse = false> struct CumSum2D {
 
 template <typename T, typename ReduceOp>
 TL_DEVICE T warp_reduce(T value, ReduceOp op) {
-  value = op(value, __shfl_xor(value, 32));
-  value = op(value, __shfl_xor(value, 16));
-  value = op(value, __shfl_xor(value, 8));
-  value = op(value, __shfl_xor(value, 4));
-  value = op(value, __shfl_xor(value, 2));
-  value = op(value, __shfl_xor(value, 1));
+  value = op(value, tl::shfl_xor_dpp<32>(value));
+  value = op(value, tl::shfl_xor_dpp<16>(value));
+  value = op(value, tl::shfl_xor_dpp<8>(value));
+  value = op(value, tl::shfl_xor_dpp<4>(value));
+  value = op(value, tl::shfl_xor_dpp<2>(value));
+  value = op(value, tl::shfl_xor_dpp<1>(value));
   return value;
 }
 
@@ -0,0 +1,152 @@
+/*!
+ * \file aggregate_atomics.cc
+ * \brief Combine the values of the lanes of a warp that atomically update
+ * the same global address before issuing the atomic.
+ *
+ * Histograms and scatter reductions, e.g. `T.atomic_add(hist[bins[i]], 1)`,
+ * send one atomic per element to a few hot addresses, and the memory system
+ * serializes them. When the destination of an atomic add, max or min is
+ * data dependent, or does not depend on threadIdx.x so that the whole warp
+ * updates one address, the call is marked with attr::kWarpAggregate. CUDA
+ * codegen then emits the Atomic*Aggregated templates: the lanes find their
+ * peers with match.any, combine their values with shuffles, and only one
+ * lane per distinct address issues the atomic.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+
+#include "../op/builtin.h"
+#include "../target/utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+namespace {
+
+bool IsAggregatableOp(const CallNode *op) {
+  return op->op.same_as(atomic_add_elem_op()) ||
+         op->op.same_as(atomic_max_elem_op()) ||
+         op->op.same_as(atomic_min_elem_op());
+}
+
+// The types the Atomic*Aggregated templates shuffle
+bool IsAggregatableType(DataType t) {
+  if (t.lanes() != 1) {
+    return false;
+  }
+  if (t.is_float() || t.is_bfloat16()) {
+    return t.bits() == 16 || t.bits() == 32 || t.bits() == 64;
+  }
+  return (t.is_int() || t.is_uint()) && (t.bits() == 32 || t.bits() == 64);
+}
+
+class AtomicAggregator : public StmtExprMutator {
+private:
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      if (iv->thread_tag == "threadIdx.x") {
+        Var outer = lane_var_;
+        lane_var_ = iv->var;
+        Stmt stmt = StmtExprMutator::VisitStmt_(op);
+        lane_var_ = outer;
+        return stmt;
+      }
+    }
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const EvaluateNode *op) final {
+    const auto *call = op->value.as<CallNode>();
+    if (call == nullptr || !IsAggregatableOp(call) || !Aggregatable(call)) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    auto annotations = call->annotations;
+    annotations.Set(attr::kWarpAggregate, IntImm(DataType::Int(32), 1));
+    return Evaluate(
+        Call(call->dtype, call->op, call->args, annotations, call->span));
+  }
+
+  bool Aggregatable(const CallNode *call) const {
+    if (!lane_var_.defined() || call->args.size() < 2 ||
+        call->annotations.count(attr::kWarpAggregate)) {
+      return false;
+    }
+    // Combining the values reorders the updates, which only relaxed
+    // atomics allow
+    if (call->args.size() > 2 && !is_zero(call->args[2])) {
+      return false;
+    }
+    const auto *ptr = call->args[0].as<CallNode>();
+    if (ptr == nullptr || !ptr->op.same_as(builtin::address_of()) ||
+        ptr->args.size() != 1) {
+      return false;
+    }
+    const auto *dst = ptr->args[0].as<BufferLoadNode>();
+    if (dst == nullptr || !IsAggregatableType(dst->buffer->dtype) ||
+        call->args[1].dtype().lanes() != 1) {
+      return false;
+    }
+    std::string scope = dst->buffer.scope();
+    if (scope != "global" && !scope.empty()) {
+      return false;
+    }
+    bool data_dependent = false;
+    for (const PrimExpr &index : dst->indices) {
+      PostOrderVisit(index, [&](const ObjectRef &node) {
+        if (node.as<BufferLoadNode>()) {
+          data_dependent = true;
+        }
+      });
+    }
+    Var lane = lane_var_;
+    bool per_lane = false;
+    for (const PrimExpr &index : dst->indices) {
+      per_lane = per_lane || UsesVar(index, [&](const VarNode *v) {
+                   return v == lane.get();
+                 });
+    }
+    return data_dependent || !per_lane;
+  }
+
+  Var lane_var_;
+};
+
+} // namespace
+
+using namespace tir::transform;
+
+tvm::transform::Pass AggregateAtomics() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    bool disabled =
+        ctx->GetConfig<Bool>(kDisableAtomicAggregation, Bool(false)).value();
+    auto target = f->GetAttr<Target>(tvm::attr::kTarget);
+    // match.any needs sm_70
+    if (disabled || !target || !TargetIsCuda(target.value()) ||
+        !TargetHasSMVersionGE(target.value(), 70)) {
+      return f;
+    }
+    Stmt body = AtomicAggregator()(f->body);
+    if (!body.same_as(f->body)) {
+      f.CopyOnWrite()->body = body;
+    }
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.AggregateAtomics", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.AggregateAtomics", AggregateAtomics);
+}
+
+} // namespace tl
+} // namespace tvm
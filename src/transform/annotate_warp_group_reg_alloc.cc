@@ -4,6 +4,8 @@
  */
 
 #include "warp_specialized_rewriter.h"
+#include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -80,14 +82,132 @@ private:
   bool has_simt_copy_{false};
 };
 
+/*!
+ * \brief Per-thread 32-bit registers held by the local buffers (lowered
+ *        fragments and local vars) of a function.
+ */
+class LocalRegisterCollector : public StmtExprVisitor {
+public:
+  static std::unordered_map<const VarNode *, int64_t>
+  Collect(const Stmt &stmt) {
+    LocalRegisterCollector collector;
+    collector(stmt);
+    return std::move(collector.regs_);
+  }
+
+private:
+  void VisitStmt_(const AllocateNode *op) final {
+    if (auto size = op->ConstantAllocationSize()) {
+      Record(op->buffer_var, op->dtype, size);
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BlockNode *op) final {
+    for (const auto &buffer : op->alloc_buffers) {
+      int64_t size = 1;
+      for (const auto &dim : buffer->shape) {
+        const auto *imm = dim.as<IntImmNode>();
+        if (!imm) {
+          size = -1;
+          break;
+        }
+        size *= imm->value;
+      }
+      if (size >= 0)
+        Record(buffer->data, buffer->dtype, size);
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void Record(const Var &var, DataType dtype, int64_t size) {
+    std::string scope = GetPtrStorageScope(var);
+    if (scope != "local" && scope != "local.var")
+      return;
+    int64_t bits = size * dtype.bits() * dtype.lanes();
+    regs_[var.get()] = (bits + 31) / 32;
+  }
+
+  std::unordered_map<const VarNode *, int64_t> regs_;
+};
+
+/*!
+ * \brief Registers per thread needed by the local buffers used in stmt.
+ */
+static int64_t
+LocalRegistersUsed(const Stmt &stmt,
+                   const std::unordered_map<const VarNode *, int64_t> &regs) {
+  std::unordered_set<const VarNode *> used;
+  PostOrderVisit(stmt, [&](const ObjectRef &node) {
+    if (const auto *var = node.as<VarNode>()) {
+      if (regs.count(var))
+        used.insert(var);
+    }
+  });
+  int64_t total = 0;
+  for (const VarNode *var : used)
+    total += regs.at(var);
+  return total;
+}
+
+/*!
+ * \brief Splits the register file between the producer and the consumer
+ *        warp groups.
+ *
+ * The producer keeps the registers its local buffers need on top of the
+ * minimum of setmaxnreg; the consumer warp groups share the rest of the
+ * registers a CTA may hold at the target occupancy. Both counts are
+ * multiples of 8 in [24, 240], and the producer must shrink and the
+ * consumer grow relative to the even split the kernel is launched with.
+ *
+ * \return {dec, inc}, or an empty array when no valid split exists.
+ */
+static Array<IntImm> ComputeRegisterBudget(int64_t producer_threads,
+                                           int64_t consumer_threads,
+                                           int64_t producer_local_regs,
+                                           int64_t consumer_local_regs,
+                                           int64_t occupancy) {
+  constexpr int64_t kRegistersPerSM = 64 * 1024;
+  constexpr int64_t kMinNReg = 24;
+  constexpr int64_t kMaxNReg = 240;
+  // Registers a consumer needs besides its fragments (addresses, indices,
+  // loop counters).
+  constexpr int64_t kConsumerBaseRegs = 32;
+  auto round_up = [](int64_t x) { return (x + 7) / 8 * 8; };
+  auto round_down = [](int64_t x) { return x / 8 * 8; };
+
+  if (producer_threads <= 0 || consumer_threads <= 0 || occupancy <= 0)
+    return {};
+  int64_t budget = kRegistersPerSM / occupancy;
+  int64_t even = std::min(
+      kMaxNReg, round_down(budget / (producer_threads + consumer_threads)));
+  int64_t dec =
+      std::min(kMaxNReg, round_up(kMinNReg + producer_local_regs));
+  int64_t inc = std::min(
+      kMaxNReg,
+      round_down((budget - producer_threads * dec) / consumer_threads));
+  if (dec > even || inc < even || inc < kMinNReg)
+    return {};
+  if (inc < kConsumerBaseRegs + consumer_local_regs) {
+    LOG(WARNING) << "The consumer fragments need "
+                 << kConsumerBaseRegs + consumer_local_regs
+                 << " registers per thread, but only " << inc
+                 << " fit in the register file at occupancy " << occupancy
+                 << "; the consumer may spill.";
+  }
+  return {IntImm(DataType::Int(32), dec), IntImm(DataType::Int(32), inc)};
+}
+
 class SetMaxNRegInjector : public StmtExprMutator {
 public:
-  static PrimFunc Inject(PrimFunc f) {
+  static PrimFunc Inject(PrimFunc f, int64_t occupancy) {
     auto T = SetMaxNRegInjector();
     T.nreg_ = SetMaxNRegCollector::Collect(f);
     if (T.nreg_.empty()) {
       return f;
     }
+    T.occupancy_ = occupancy;
+    T.local_regs_ = LocalRegisterCollector::Collect(f->body);
     f.CopyOnWrite()->body = T(f->body);
     return f;
   }
@@ -137,13 +257,23 @@ private:
       // Only inject if we have valid register hints and no SIMT copy
       bool has_simt_copy = SimtCopyDetector::Detect(producer_body);
 
-      if (dec_reg == 0 && inc_reg == 0 && !has_simt_copy) {
-        auto inc_reg_num = IntImm(DataType::Int(32), 240);
-        auto dec_reg_num = IntImm(DataType::Int(32), 24);
-        inc_reg_stmt = Evaluate(
-            Call(DataType::Handle(), set_max_nreg(), {inc_reg_num, 1}));
-        dec_reg_stmt = Evaluate(
-            Call(DataType::Handle(), set_max_nreg(), {dec_reg_num, 0}));
+      if (dec_reg == 0 && inc_reg == 0 && !has_simt_copy &&
+          !consumer_body.defined()) {
+        dec_reg_stmt = Evaluate(Call(DataType::Handle(), set_max_nreg(),
+                                     {IntImm(DataType::Int(32), 24), 0}));
+      } else if (dec_reg == 0 && inc_reg == 0 && !has_simt_copy) {
+        auto partition = Downcast<Array<IntImm>>(op->node);
+        Array<IntImm> budget = ComputeRegisterBudget(
+            partition[0]->value, partition[1]->value,
+            LocalRegistersUsed(producer_body, local_regs_),
+            LocalRegistersUsed(consumer_body.value(), local_regs_),
+            occupancy_);
+        if (!budget.empty()) {
+          dec_reg_stmt = Evaluate(
+              Call(DataType::Handle(), set_max_nreg(), {budget[0], 0}));
+          inc_reg_stmt = Evaluate(
+              Call(DataType::Handle(), set_max_nreg(), {budget[1], 1}));
+        }
       }
 
       // Inject register setting statements
@@ -173,6 +303,8 @@ private:
   }
 
   Array<IntImm> nreg_;
+  int64_t occupancy_ = 1;
+  std::unordered_map<const VarNode *, int64_t> local_regs_;
   IterVar thread_iv_;
   Optional<PrimExpr> updated_thread_extent_;
   bool need_update_thread_extent_ = false;
@@ -183,7 +315,11 @@ using namespace tir::transform;
 tvm::transform::Pass AnnotateWarpGroupRegAlloc() {
   auto pass_func = [](PrimFunc f, const IRModule &m,
                       const PassContext &ctx) -> PrimFunc {
-    return SetMaxNRegInjector::Inject(std::move(f));
+    int64_t occupancy =
+        ctx->GetConfig<Integer>(kWarpSpecializedOccupancy, Integer(1))
+            .value()
+            ->value;
+    return SetMaxNRegInjector::Inject(std::move(f), occupancy);
   };
   return CreatePrimFuncPass(pass_func, 0, "tl.AnnotateWarpGroupRegAlloc", {});
 }
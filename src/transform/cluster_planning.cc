@@ -10,6 +10,7 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include "../op/builtin.h"
 #include "../support/ffi_aliases.h"
 
 namespace tvm {
@@ -18,6 +19,18 @@ namespace tir {
 class ClusterPlanner {
 public:
   static PrimFunc Substitute(PrimFunc &f) {
+    // Kernels with an explicit cluster shape, such as the CTA pairs of 2-CTA
+    // tcgen05 gemms, keep it.
+    bool has_cluster_dims = false;
+    PostOrderVisit(f->body, [&](const ObjectRef &node) {
+      if (const auto *attr = node.as<AttrStmtNode>()) {
+        if (attr->attr_key == tl::attr::kClusterDims)
+          has_cluster_dims = true;
+      }
+    });
+    if (has_cluster_dims)
+      return f;
+
     // Step 1: Collect the read region of the function
     Map<Var, Buffer> buffer_data_to_buffer_;
     for (const auto &[_, buffer] : f->buffer_map) {
@@ -0,0 +1,206 @@
+/*!
+ * \file coalesce_tma_copies.cc
+ * \brief Merge consecutive T.copy from global into adjacent shared regions
+ * into one copy, so that they lower to one TMA load (sm90+).
+ *
+ * Every TMA load costs the producer an instruction issue and an expect_tx on
+ * the stage barrier, which bounds the throughput of pipelines whose stages
+ * are made of many small copies, e.g. per-head K/V slices of small head
+ * dimension:
+ *
+ *   T.copy(K[b, s:s + 64, h, :], K_shared[:, 0, :])
+ *   T.copy(K[b, s:s + 64, h + 1, :], K_shared[:, 1, :])
+ *   ->
+ *   T.copy(K[b, s:s + 64, h:h + 2, :], K_shared[:, 0:2, :])
+ *
+ * Two copies merge when they read the same global buffer and write the same
+ * shared buffer, their regions only differ in one dimension on each side,
+ * along which the second continues the first, and the merged dimensions
+ * correspond in the merged copy. The copy lowering then picks a TMA box of
+ * the merged extents, or a 1D bulk copy when both regions are contiguous, and
+ * the barrier injection accounts the bytes of the merged load. The innermost
+ * dimension, which sets the TMA box width and swizzle, is not merged, and the
+ * merged extent stays within the 256 elements of a box dimension.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../op/builtin.h"
+#include "../op/copy.h"
+#include "../op/region.h"
+#include "../op/utils.h"
+#include "../target/utils.h"
+#include "arith/ir_mutator_with_analyzer.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+class TmaCopyCoalescer : public arith::IRMutatorWithAnalyzer {
+public:
+  static PrimFunc Substitute(PrimFunc f) {
+    arith::Analyzer analyzer;
+    TmaCopyCoalescer coalescer(&analyzer);
+    f.CopyOnWrite()->body = coalescer(f->body);
+    return f;
+  }
+
+private:
+  using arith::IRMutatorWithAnalyzer::IRMutatorWithAnalyzer;
+  using arith::IRMutatorWithAnalyzer::VisitStmt_;
+
+  /// Maximum extent of a TMA box dimension
+  static constexpr int64_t kMaxBoxDim = 256;
+
+  Stmt VisitStmt_(const SeqStmtNode *op) final {
+    Array<Stmt> seq;
+    bool changed = false;
+    for (const Stmt &stmt : op->seq) {
+      Stmt new_stmt = VisitStmt(stmt);
+      changed |= !new_stmt.same_as(stmt);
+      if (!seq.empty()) {
+        if (auto merged = Merge(seq.back(), new_stmt)) {
+          seq.Set(seq.size() - 1, merged.value());
+          changed = true;
+          continue;
+        }
+      }
+      seq.push_back(new_stmt);
+    }
+    if (!changed)
+      return ffi::GetRef<Stmt>(op);
+    return seq.size() == 1 ? seq[0] : SeqStmt(seq);
+  }
+
+  static const CallNode *AsCopy(const Stmt &stmt) {
+    if (const auto *eval = stmt.as<EvaluateNode>()) {
+      const auto *call = eval->value.as<CallNode>();
+      if (call && call->op.same_as(Copy::Get()) && call->args.size() == 2)
+        return call;
+    }
+    return nullptr;
+  }
+
+  /*! \brief The copy of both a and b, if they merge into one TMA load */
+  ffi::Optional<Stmt> Merge(const Stmt &a, const Stmt &b) {
+    const CallNode *first = AsCopy(a);
+    const CallNode *second = AsCopy(b);
+    if (!first || !second ||
+        !StructuralEqual()(first->annotations, second->annotations) ||
+        first->annotations.count("disable_tma"))
+      return std::nullopt;
+    BufferRegion src = NormalizeToBufferRegion(first->args[0]);
+    BufferRegion dst = NormalizeToBufferRegion(first->args[1]);
+    BufferRegion next_src = NormalizeToBufferRegion(second->args[0]);
+    BufferRegion next_dst = NormalizeToBufferRegion(second->args[1]);
+    std::string dst_scope = dst->buffer.scope();
+    if (src->buffer.scope() != "global" ||
+        (dst_scope != "shared" && dst_scope != "shared.dyn"))
+      return std::nullopt;
+    int src_dim = AdjacentDim(src, next_src);
+    int dst_dim = AdjacentDim(dst, next_dst);
+    if (src_dim < 0 || dst_dim < 0 ||
+        src_dim + 1 == static_cast<int>(src->region.size()))
+      return std::nullopt;
+    BufferRegion merged_src = Extend(src, next_src, src_dim);
+    BufferRegion merged_dst = Extend(dst, next_dst, dst_dim);
+    const auto *box = as_const_int(merged_src->region[src_dim]->extent);
+    if (box == nullptr || *box > kMaxBoxDim)
+      return std::nullopt;
+
+    // The copy pairs the non-unit extents of both sides in order
+    int src_pos = 0, dst_pos = 0;
+    Array<PrimExpr> src_extents = NonUnitExtents(merged_src, src_dim, &src_pos);
+    Array<PrimExpr> dst_extents = NonUnitExtents(merged_dst, dst_dim, &dst_pos);
+    if (src_pos != dst_pos || src_extents.size() != dst_extents.size())
+      return std::nullopt;
+    for (size_t i = 0; i < src_extents.size(); ++i) {
+      if (!analyzer_->CanProveEqual(src_extents[i], dst_extents[i]))
+        return std::nullopt;
+    }
+
+    Call copy = ffi::GetRef<Call>(first);
+    copy.CopyOnWrite()->args = {MakeRegion(merged_src, 1),
+                                MakeRegion(merged_dst, 2)};
+    return Evaluate(copy);
+  }
+
+  /*! \brief The only dimension along which b continues a, -1 if none */
+  int AdjacentDim(const BufferRegion &a, const BufferRegion &b) {
+    if (!a->buffer.same_as(b->buffer))
+      return -1;
+    int dim = -1;
+    for (size_t i = 0; i < a->region.size(); ++i) {
+      const Range &x = a->region[i];
+      const Range &y = b->region[i];
+      if (analyzer_->CanProveEqual(x->min, y->min) &&
+          analyzer_->CanProveEqual(x->extent, y->extent))
+        continue;
+      if (dim >= 0 || !analyzer_->CanProveEqual(x->min + x->extent, y->min))
+        return -1;
+      dim = static_cast<int>(i);
+    }
+    return dim;
+  }
+
+  BufferRegion Extend(const BufferRegion &a, const BufferRegion &b, int dim) {
+    Array<Range> region = a->region;
+    PrimExpr extent =
+        analyzer_->Simplify(a->region[dim]->extent + b->region[dim]->extent);
+    region.Set(dim, Range::FromMinExtent(a->region[dim]->min, extent));
+    return BufferRegion(a->buffer, region);
+  }
+
+  /*! \brief Extents other than 1, with the position of dim among them */
+  static Array<PrimExpr> NonUnitExtents(const BufferRegion &region, int dim,
+                                        int *pos) {
+    Array<PrimExpr> extents;
+    for (int i = 0; i < static_cast<int>(region->region.size()); ++i) {
+      if (i == dim)
+        *pos = static_cast<int>(extents.size());
+      if (!is_one(region->region[i]->extent))
+        extents.push_back(region->region[i]->extent);
+    }
+    return extents;
+  }
+
+  static PrimExpr MakeRegion(const BufferRegion &region, int access_mask) {
+    Array<PrimExpr> mins;
+    for (const Range &r : region->region)
+      mins.push_back(r->min);
+    Array<PrimExpr> args{BufferLoad(region->buffer, mins),
+                         IntImm(DataType::Int(32), access_mask)};
+    for (const Range &r : region->region)
+      args.push_back(r->extent);
+    return Call(DataType::Handle(), RegionOp::Get(), args);
+  }
+};
+
+namespace transform {
+
+using namespace tir::transform;
+
+tvm::transform::Pass CoalesceTmaCopies() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    auto target = f->GetAttr<Target>(tvm::attr::kTarget);
+    if (!target || !TargetHasBulkCopy(target.value()) ||
+        ctx->GetConfig<Bool>(kDisableTMALower, Bool(false)).value() ||
+        ctx->GetConfig<Bool>(kDisableTmaCoalesce, Bool(false)).value())
+      return f;
+    return TmaCopyCoalescer::Substitute(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.CoalesceTmaCopies", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.CoalesceTmaCopies", CoalesceTmaCopies);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
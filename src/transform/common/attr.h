@@ -11,10 +11,16 @@ constexpr const char *MainBlockName = "tilelang_root";
 constexpr const char *tilelang_is_cpu_kernel_frame =
     "tilelang.is_cpu_kernel_frame";
 
+// Marks the block loops of a CPU kernel frame, whose iterations are
+// independent like the blocks of a GPU grid.
+constexpr const char *tilelang_cpu_grid_loop = "tilelang.cpu_grid_loop";
+
 namespace attr {
 // Attributes to mark CUDA sync calls
 constexpr const char *kHasTriggerLaunch = "has_cuda_pdl_trigger";
 constexpr const char *kHasGridSync = "has_cuda_pdl_sync";
+// Region of T.fastmath, its value is the ulp budget, -1 when unbounded
+constexpr const char *kFastMathUlp = "tl.fastmath_ulp";
 } // namespace attr
 
 } // namespace tl
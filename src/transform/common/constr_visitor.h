@@ -116,6 +116,25 @@ struct ConstrSet {
     Populate(analyzer);
     return analyzer.CanProve(expr);
   }
+  // The constraints as a ProofCache key; the three kinds map to distinct
+  // node types so that a binding never compares equal to a constraint.
+  Array<ObjectRef> ToKey() const {
+    Array<ObjectRef> key;
+    for (const auto &c : constrs_) {
+      switch (c.kind) {
+      case Constr::kConstr:
+        key.push_back(c.value);
+        break;
+      case Constr::kBindValue:
+        key.push_back(Array<ObjectRef>{c.var, c.value});
+        break;
+      case Constr::kBindRange:
+        key.push_back(Array<ObjectRef>{c.var, c.range});
+        break;
+      }
+    }
+    return key;
+  }
   template <typename... Args> void AddConstr(Args... args) {
     constrs_.push_back(Constr(args...));
   }
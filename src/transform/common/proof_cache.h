@@ -0,0 +1,94 @@
+/*!
+ * \file proof_cache.h
+ * \brief A per-PrimFunc cache of arithmetic proofs shared by the passes.
+ */
+
+#ifndef TVM_TL_TRANSFORM_COMMON_PROOF_CACHE_H_
+#define TVM_TL_TRANSFORM_COMMON_PROOF_CACHE_H_
+
+#include <tvm/ffi/extra/structural_equal.h>
+#include <tvm/ffi/extra/structural_hash.h>
+#include <tvm/ir/expr.h>
+
+#include <unordered_map>
+
+namespace tvm {
+namespace tl {
+
+/*!
+ * \brief Memoizes the result of self-contained proofs.
+ *
+ * A proof may opt in only if its result is a function of the key alone: it
+ * must run on a fresh arith::Analyzer populated solely from constraints that
+ * are part of the key. Keys are compared structurally with free variables
+ * mapped, so the same fact stated over fresh variables (e.g. the renamed
+ * thread indices of the sync planner) hits the cache.
+ *
+ * The cache lives as long as the outermost ProofCache::Scope of the calling
+ * thread, which the passes open once per PrimFunc. Without an open scope
+ * Prove() just runs the proof.
+ */
+class ProofCache {
+public:
+  class Scope {
+  public:
+    Scope() : owner_(current_ == nullptr) {
+      if (owner_)
+        current_ = new ProofCache();
+    }
+    ~Scope() {
+      if (owner_) {
+        delete current_;
+        current_ = nullptr;
+      }
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    bool owner_;
+  };
+
+  /*! \return The cache of the open scope, or nullptr. */
+  static ProofCache *Current() { return current_; }
+
+  /*!
+   * \brief Returns prove(), reusing the result recorded for an equal key.
+   * \param key Everything the proof depends on.
+   * \param prove The proof, run on a cache miss.
+   */
+  template <typename F>
+  static bool Prove(const Array<ObjectRef> &key, F prove) {
+    ProofCache *cache = Current();
+    if (cache == nullptr)
+      return prove();
+    auto it = cache->results_.find(key);
+    if (it != cache->results_.end())
+      return it->second;
+    bool result = prove();
+    cache->results_.emplace(key, result);
+    return result;
+  }
+
+private:
+  struct KeyHash {
+    size_t operator()(const Array<ObjectRef> &key) const {
+      return static_cast<size_t>(
+          ffi::StructuralHash::Hash(key, /*map_free_vars=*/true));
+    }
+  };
+  struct KeyEqual {
+    bool operator()(const Array<ObjectRef> &lhs,
+                    const Array<ObjectRef> &rhs) const {
+      return ffi::StructuralEqual::Equal(lhs, rhs, /*map_free_vars=*/true);
+    }
+  };
+
+  std::unordered_map<Array<ObjectRef>, bool, KeyHash, KeyEqual> results_;
+  static inline thread_local ProofCache *current_ = nullptr;
+};
+
+} // namespace tl
+} // namespace tvm
+
+#endif // TVM_TL_TRANSFORM_COMMON_PROOF_CACHE_H_
@@ -28,9 +28,18 @@ enum class ReservedNamedBarriers : uint8_t {
   kSyncThreads = 0,
   kReduce_0 = 1,
   kReduce_1 = 2,
-  kFirstUsedBarrier = kReduce_1 + 1
+  // Block syncs of T.signal/T.signal_wait in warp specialized roles
+  kSymmProducer = 3,
+  kSymmConsumer = 4,
+  // Turns of the two consumer warpgroups of a ping-pong schedule
+  kPingPongWG0 = 5,
+  kPingPongWG1 = 6,
+  kFirstUsedBarrier = kPingPongWG1 + 1
 };
 
+// Number of named barriers of a CTA
+constexpr int kNumNamedBarriers = 16;
+
 } // namespace tl
 } // namespace tvm
 
@@ -1,12 +1,20 @@
 #include "../op/builtin.h"
 #include "arith/ir_mutator_with_analyzer.h"
+#include "tir/transforms/ir_utils.h"
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/data_type_rewriter.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace tl {
 
@@ -70,18 +78,36 @@ protected:
   int _index_bitwidth_;
 };
 
+/*!
+ * \brief Promote to int64 the indices that may overflow their 32-bit type.
+ *
+ * An index is kept narrow when every sum and product in it provably fits,
+ * from the loop and thread ranges and the user assumptions (`T.assume`,
+ * which InjectAssumes turned into attributes). When the bounds of the index
+ * are only known symbolically, e.g. in terms of dynamic shapes, the kernel
+ * body is versioned instead: a narrow version runs when a check at kernel
+ * entry shows the bounds fit, and a version with the index promoted runs
+ * otherwise. Every other index that may overflow is promoted.
+ */
 class IndexLegalizer : public IRMutatorWithAnalyzer {
 
 public:
-  static Stmt Rewrite(const Stmt &stmt) {
+  static Stmt Rewrite(const Stmt &stmt, bool enable_dispatch,
+                      bool *dispatched) {
     Analyzer ana;
     auto pass = IndexLegalizer(&ana);
-    return pass.VisitStmt(stmt);
+    pass.enable_dispatch_ = enable_dispatch;
+    Stmt result = pass.VisitStmt(stmt);
+    *dispatched = pass.dispatched_;
+    return result;
   }
 
 private:
   explicit IndexLegalizer(arith::Analyzer *ana) : IRMutatorWithAnalyzer(ana) {}
 
+  using IRMutatorWithAnalyzer::VisitExpr_;
+  using IRMutatorWithAnalyzer::VisitStmt_;
+
   class Int64Promoter : public IndexDataTypeRewriter {
   public:
     using Parent = IndexDataTypeRewriter;
@@ -119,49 +145,165 @@ private:
     }
   };
 
-  Stmt VisitStmt_(const BufferStoreNode *op) final {
-    auto buffer_store =
-        Downcast<BufferStore>(IRMutatorWithAnalyzer::VisitStmt_(op));
-    auto indices = buffer_store->indices;
+  enum class Fit { kProven, kGuarded, kUnknown };
+
+  /*!
+   * \brief Whether `expr` provably fits its type, and otherwise the check at
+   * kernel entry that shows it does, if its bounds are finite and only use
+   * variables defined before the kernel body.
+   */
+  Fit CheckFits(const PrimExpr &expr, std::vector<PrimExpr> *guards) {
+    int bits = expr->dtype.bits();
+    int64_t max_value = (1LL << (bits - 1)) - 1;
+    int64_t min_value = -(1LL << (bits - 1));
+    auto int_bound = analyzer_->const_int_bound(expr);
+    if (int_bound->max_value < max_value && int_bound->min_value >= min_value)
+      return Fit::kProven;
+    if (!in_kernel_)
+      return Fit::kUnknown;
+    arith::IntSet bounds = analyzer_->int_set(expr);
+    if (!bounds.HasUpperBound() || !bounds.HasLowerBound())
+      return Fit::kUnknown;
+    Int64Promoter promoter;
+    PrimExpr guard =
+        promoter(bounds.max()) < IntImm(DataType::Int(64), max_value) &&
+        promoter(bounds.min()) >= IntImm(DataType::Int(64), min_value);
+    if (UsesVar(guard,
+                [&](const VarNode *v) { return kernel_defs_.count(v); }))
+      return Fit::kUnknown;
+    guards->push_back(guard);
+    return Fit::kGuarded;
+  }
+
+  /*! \brief The fit of `index` and of all the sums and products in it. */
+  Fit CheckIndexFits(const PrimExpr &index, std::vector<PrimExpr> *guards) {
+    Fit fit = Fit::kProven;
+    auto check = [&](const PrimExpr &expr) {
+      if (fit == Fit::kUnknown)
+        return;
+      Fit sub = CheckFits(expr, guards);
+      if (sub != Fit::kProven)
+        fit = sub;
+    };
+    check(index);
+    PostOrderVisit(index, [&](const ObjectRef &node) {
+      if (node.as<AddNode>() || node.as<SubNode>() || node.as<MulNode>()) {
+        PrimExpr expr = Downcast<PrimExpr>(node);
+        if (expr->dtype.is_int() && expr->dtype.bits() < 64 &&
+            expr->dtype.lanes() == 1)
+          check(expr);
+      }
+    });
+    return fit;
+  }
+
+  Array<PrimExpr> LegalizeIndices(const Array<PrimExpr> &indices) {
     Array<PrimExpr> new_indices;
     for (auto index : indices) {
       if (index->dtype.is_int() && index->dtype.bits() < 64) {
-        auto int_bound = analyzer_->const_int_bound(index);
-        if (int_bound->max_value >= (1LL << (index->dtype.bits() - 1)) - 1 ||
-            int_bound->min_value < -(1LL << (index->dtype.bits() - 1))) {
+        std::vector<PrimExpr> guards;
+        Fit fit = CheckIndexFits(index, &guards);
+        if (fit == Fit::kGuarded) {
+          for (const PrimExpr &guard : guards) {
+            bool seen = std::any_of(
+                guards_.begin(), guards_.end(), [&](const PrimExpr &g) {
+                  return StructuralEqual()(g, guard);
+                });
+            if (!seen)
+              guards_.push_back(guard);
+          }
+        } else if (fit != Fit::kProven) {
           Int64Promoter promoter;
           index = promoter(index);
-          new_indices.push_back(index);
-          continue;
         }
       }
       new_indices.push_back(index);
     }
-    buffer_store.CopyOnWrite()->indices = new_indices;
+    return new_indices;
+  }
+
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::tilelang_assume) {
+      With<arith::ConstraintContext> ctx(analyzer_,
+                                         Downcast<PrimExpr>(op->node));
+      return IRMutatorWithAnalyzer::VisitStmt_(op);
+    }
+    if (op->attr_key != tir::attr::thread_extent || in_kernel_ ||
+        !enable_dispatch_) {
+      return IRMutatorWithAnalyzer::VisitStmt_(op);
+    }
+    IterVar iv = Downcast<IterVar>(op->node);
+    kernel_defs_.insert(iv->var.get());
+    launch_ranges_.emplace_back(iv->var, Range::FromMinExtent(0, op->value));
+    const auto *inner = op->body.as<AttrStmtNode>();
+    if (inner && inner->attr_key == tir::attr::thread_extent)
+      return IRMutatorWithAnalyzer::VisitStmt_(op);
+
+    // The innermost launch attribute: version the kernel body beneath it
+    analyzer_->Bind(iv->var, Range::FromMinExtent(0, op->value), true);
+    PostOrderVisit(op->body, [&](const ObjectRef &node) {
+      if (const auto *loop = node.as<ForNode>()) {
+        kernel_defs_.insert(loop->loop_var.get());
+      } else if (const auto *let = node.as<LetStmtNode>()) {
+        kernel_defs_.insert(let->var.get());
+      } else if (const auto *let = node.as<LetNode>()) {
+        kernel_defs_.insert(let->var.get());
+      } else if (const auto *alloc = node.as<AllocateNode>()) {
+        kernel_defs_.insert(alloc->buffer_var.get());
+      } else if (const auto *attr = node.as<AttrStmtNode>()) {
+        if (attr->attr_key == tir::attr::thread_extent)
+          kernel_defs_.insert(Downcast<IterVar>(attr->node)->var.get());
+      }
+    });
+    in_kernel_ = true;
+    guards_.clear();
+    Stmt body = VisitStmt(op->body);
+    if (!guards_.empty()) {
+      PrimExpr narrow = guards_[0];
+      for (size_t i = 1; i < guards_.size(); ++i)
+        narrow = narrow && guards_[i];
+      // A fresh analyzer, as the let bindings of the body change with the
+      // indices in them; it only knows the launch ranges, which at worst
+      // promotes more indices of the wide version
+      Analyzer wide_ana;
+      for (const auto &[var, range] : launch_ranges_)
+        wide_ana.Bind(var, range);
+      IndexLegalizer wide(&wide_ana);
+      Stmt wide_body = wide.VisitStmt(op->body);
+      body = IfThenElse(analyzer_->Simplify(narrow), body, wide_body);
+      dispatched_ = true;
+    }
+    in_kernel_ = false;
+    kernel_defs_.clear();
+    launch_ranges_.clear();
+    return AttrStmt(op->node, op->attr_key, op->value, body, op->span);
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode *op) final {
+    auto buffer_store =
+        Downcast<BufferStore>(IRMutatorWithAnalyzer::VisitStmt_(op));
+    buffer_store.CopyOnWrite()->indices =
+        LegalizeIndices(buffer_store->indices);
     return std::move(buffer_store);
   }
 
   PrimExpr VisitExpr_(const BufferLoadNode *op) final {
     auto buffer_load =
         Downcast<BufferLoad>(IRMutatorWithAnalyzer::VisitExpr_(op));
-    auto indices = buffer_load->indices;
-    Array<PrimExpr> new_indices;
-    for (auto index : indices) {
-      if (index->dtype.is_int() && index->dtype.bits() < 64) {
-        auto int_bound = analyzer_->const_int_bound(index);
-        if (int_bound->max_value >= (1LL << (index->dtype.bits() - 1)) - 1 ||
-            int_bound->min_value < -(1LL << (index->dtype.bits() - 1))) {
-          Int64Promoter promoter;
-          index = promoter(index);
-          new_indices.push_back(index);
-          continue;
-        }
-      }
-      new_indices.push_back(index);
-    }
-    buffer_load.CopyOnWrite()->indices = new_indices;
+    buffer_load.CopyOnWrite()->indices = LegalizeIndices(buffer_load->indices);
     return std::move(buffer_load);
   }
+
+  bool enable_dispatch_{false};
+  bool dispatched_{false};
+  bool in_kernel_{false};
+  /*! \brief The ranges of the launch attributes enclosing the visit. */
+  std::vector<std::pair<Var, Range>> launch_ranges_;
+  /*! \brief The variables bound in the launch attributes or the kernel body,
+   * which a check at kernel entry cannot use. */
+  std::unordered_set<const VarNode *> kernel_defs_;
+  /*! \brief The checks under which the narrow kernel body runs. */
+  std::vector<PrimExpr> guards_;
 };
 
 tvm::transform::Pass ConfigIndexBitwidth() {
@@ -176,8 +318,15 @@ tvm::transform::Pass ConfigIndexBitwidth() {
       int config_index_bitwidth = opt_config_index_bitwidth.value()->value;
       n->body = ConfigIndexBitwidthRewriter(config_index_bitwidth)(n->body);
     }
+    bool enable_dispatch =
+        !ctx->GetConfig<Bool>(kDisableIndexBitwidthDispatch, Bool(false))
+             .value();
     // Legalize out-of-bound indices to be int64
-    n->body = IndexLegalizer::Rewrite(n->body);
+    bool dispatched = false;
+    n->body = IndexLegalizer::Rewrite(n->body, enable_dispatch, &dispatched);
+    // The two versions of a kernel body bind the same variables
+    if (dispatched)
+      n->body = ConvertSSA(n->body);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tl.ConfigIndexBitwidth", {});
@@ -0,0 +1,387 @@
+/*!
+ * \file defer_wgmma_wait.cc
+ * \brief Defer the waits of the asynchronous Hopper gemms to the statements
+ * that depend on them (sm90).
+ *
+ * A T.gemm on sm90 issues one batch of asynchronous WGMMAs and waits for it
+ * right away:
+ *
+ *   fence(C); warpgroup_arrive(); wgmma ...; warpgroup_commit_batch();
+ *   warpgroup_wait(0); fence(C);
+ *
+ * In the body of a loop the pass moves the wait in front of the first
+ * statement that touches the registers of the batch (the fenced accumulator
+ * and register operands), with the smallest depth N of wgmma.wait_group N
+ * that still completes the batch, so that independent work such as the
+ * softmax of the previous tile runs while the tensor cores compute the next
+ * one, as in the intra-warpgroup overlap of FlashAttention-3. The fences,
+ * which keep NVCC from moving register accesses across the asynchronous
+ * WGMMAs, follow the waits of the batches they complete.
+ *
+ * Statements that may let the shared operands be overwritten (shared stores,
+ * barriers, asynchronous copies and other gemms) wait for every batch in
+ * flight. The batches in flight at the end of the body complete there, or,
+ * when the body has no such statement and the same batches are in flight at
+ * the end of every iteration, after the loop.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../op/builtin.h"
+#include "runtime/thread_storage_scope.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+namespace {
+
+bool IsWgmmaOp(const CallNode *call) {
+  return call->op.same_as(ptx_wgmma_ss()) ||
+         call->op.same_as(ptx_wgmma_rs()) ||
+         call->op.same_as(warpgroup_arrive()) ||
+         call->op.same_as(warpgroup_commit_batch()) ||
+         call->op.same_as(warpgroup_fence_operand()) ||
+         call->op.same_as(initialize_wgmma_descriptor()) ||
+         call->op.same_as(increase_descriptor_offset());
+}
+
+const CallNode *AsCall(const Stmt &stmt, const Op &op) {
+  if (const auto *eval = stmt.as<EvaluateNode>()) {
+    if (const auto *call = eval->value.as<CallNode>()) {
+      if (call->op.same_as(op))
+        return call;
+    }
+  }
+  return nullptr;
+}
+
+bool IsShared(const Var &var) {
+  const auto *ptr = var->type_annotation.as<PointerTypeNode>();
+  if (ptr == nullptr)
+    return false;
+  auto scope = runtime::StorageScope::Create(ptr->storage_scope);
+  return scope.rank == runtime::StorageRank::kShared;
+}
+
+/*! \brief The accesses of a statement that order it after pending WGMMAs */
+class WgmmaHazardCollector : public StmtExprVisitor {
+public:
+  /// Buffers and pointers the statement reads or writes
+  std::unordered_set<const VarNode *> vars;
+  /// Whether the statement may let the shared operands be overwritten
+  bool barrier{false};
+
+private:
+  void VisitStmt_(const BufferStoreNode *op) final {
+    vars.insert(op->buffer->data.get());
+    barrier |= IsShared(op->buffer->data);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    vars.insert(op->buffer->data.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode *op) final {
+    vars.insert(op);
+    // A shared pointer handed to anything but a WGMMA, e.g. a copy
+    barrier |= !in_wgmma_ && IsShared(ffi::GetRef<Var>(op));
+  }
+
+  void VisitExpr_(const CallNode *op) final {
+    if (op->op.same_as(warpgroup_fence_operand()))
+      return;
+    if (IsWgmmaOp(op)) {
+      // The WGMMAs of the later batches accumulate in issue order, only the
+      // other operands conflict with the batches in flight
+      bool is_mma =
+          op->op.same_as(ptx_wgmma_ss()) || op->op.same_as(ptx_wgmma_rs());
+      size_t accum = is_mma ? op->args.size() - 5 : op->args.size();
+      bool outer = in_wgmma_;
+      in_wgmma_ = true;
+      for (size_t i = 0; i < op->args.size(); ++i) {
+        if (i != accum)
+          VisitExpr(op->args[i]);
+      }
+      in_wgmma_ = outer;
+      return;
+    }
+    barrier |= IsSyncLike(op);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  static bool IsSyncLike(const CallNode *op) {
+    std::string name;
+    if (op->op.same_as(builtin::call_extern()) ||
+        op->op.same_as(builtin::call_pure_extern())) {
+      if (const auto *str = op->args[0].as<StringImmNode>())
+        name = str->value;
+    } else if (const auto *node = op->op.as<OpNode>()) {
+      name = node->name;
+    }
+    // Waiting for a barrier phase releases nothing
+    if (name.find("wait_parity") != std::string::npos)
+      return false;
+    for (const char *key : {"barrier", "arrive", "sync", "fence", "tma",
+                            "async", "copy", "gemm", "wgmma"}) {
+      if (name.find(key) != std::string::npos)
+        return true;
+    }
+    return false;
+  }
+
+  bool in_wgmma_{false};
+};
+
+/*! \brief A statement of the loop body, which may issue a batch of WGMMAs */
+struct BodyStmt {
+  Stmt stmt;
+  bool issues_batch{false};
+  /// Registers of the batch, the operands of its trailing fences
+  std::unordered_set<const VarNode *> regs;
+  Array<Stmt> fences;
+  WgmmaHazardCollector hazards;
+};
+
+class WgmmaWaitDeferrer : public StmtExprMutator {
+private:
+  Stmt VisitStmt_(const ForNode *op) final {
+    For loop = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    if (loop->kind != ForKind::kSerial && loop->kind != ForKind::kUnrolled)
+      return loop;
+
+    std::vector<BodyStmt> body;
+    Array<Stmt> seq;
+    if (const auto *block = loop->body.as<SeqStmtNode>()) {
+      seq = block->seq;
+    } else {
+      seq.push_back(loop->body);
+    }
+    int num_batches = 0;
+    for (size_t i = 0; i < seq.size(); ++i) {
+      BodyStmt s;
+      s.stmt = seq[i];
+      if (AsCall(seq[i], warpgroup_commit_batch()) && i + 1 < seq.size() &&
+          IsWaitAll(seq[i + 1])) {
+        // warpgroup_commit_batch(); warpgroup_wait(0); fence...
+        s.issues_batch = true;
+        for (i += 2; i < seq.size() && AsCall(seq[i], fence_op()); ++i)
+          s.fences.push_back(seq[i]);
+        --i;
+      } else if (auto stripped = StripWait(seq[i], &s.fences)) {
+        s.stmt = stripped.value();
+        s.issues_batch = true;
+      }
+      if (s.issues_batch) {
+        ++num_batches;
+        for (const Stmt &fence : s.fences) {
+          PostOrderVisit(AsCall(fence, fence_op())->args[1],
+                         [&](const ObjectRef &node) {
+                           const auto *var = node.as<VarNode>();
+                           if (var && var->type_annotation
+                                          .as<PointerTypeNode>())
+                             s.regs.insert(var);
+                         });
+        }
+      }
+      s.hazards(s.stmt);
+      body.push_back(std::move(s));
+    }
+    // Leave the loops whose waits are not all those of whole gemms
+    int num_waits = 0;
+    PostOrderVisit(loop->body, [&](const ObjectRef &node) {
+      if (const auto *call = node.as<CallNode>())
+        num_waits += call->op.same_as(warpgroup_wait());
+    });
+    if (num_batches == 0 || num_batches != num_waits)
+      return loop;
+
+    bool any_barrier = false;
+    for (const BodyStmt &s : body)
+      any_barrier |= s.hazards.barrier;
+    std::vector<size_t> pending;
+    std::vector<Array<Stmt>> waits = Schedule(body, {}, &pending);
+    // Carry the batches in flight into the next iteration when every
+    // iteration ends with the same ones in flight
+    bool carried = false;
+    if (!any_barrier && !pending.empty()) {
+      std::vector<size_t> next;
+      std::vector<Array<Stmt>> steady = Schedule(body, pending, &next);
+      if (next == pending) {
+        waits = std::move(steady);
+        carried = true;
+      }
+    }
+    Array<Stmt> drain = Complete(body, pending, pending.size());
+
+    Array<Stmt> new_seq;
+    for (size_t i = 0; i < body.size(); ++i) {
+      for (const Stmt &wait : waits[i])
+        new_seq.push_back(wait);
+      new_seq.push_back(body[i].stmt);
+    }
+    if (!carried) {
+      for (const Stmt &stmt : drain)
+        new_seq.push_back(stmt);
+    }
+    loop.CopyOnWrite()->body = SeqStmt::Flatten(new_seq);
+    if (!carried)
+      return loop;
+    Array<Stmt> result{loop};
+    for (const Stmt &stmt : drain)
+      result.push_back(stmt);
+    return SeqStmt(result);
+  }
+
+  static const Op &fence_op() { return warpgroup_fence_operand(); }
+
+  static bool IsWaitAll(const Stmt &stmt) {
+    const CallNode *call = AsCall(stmt, warpgroup_wait());
+    return call && is_zero(call->args[0]);
+  }
+
+  /*!
+   * \brief A statement that ends in `warpgroup_commit_batch();
+   * warpgroup_wait(0); fence...` without the wait and the fences, which are
+   * collected into fences.
+   */
+  static ffi::Optional<Stmt> StripWait(const Stmt &stmt, Array<Stmt> *fences) {
+    if (const auto *seq = stmt.as<SeqStmtNode>()) {
+      int n = static_cast<int>(seq->seq.size());
+      int wait = n - 1;
+      while (wait >= 0 && AsCall(seq->seq[wait], fence_op()))
+        --wait;
+      if (wait >= 1 && IsWaitAll(seq->seq[wait]) &&
+          AsCall(seq->seq[wait - 1], warpgroup_commit_batch())) {
+        for (int i = wait + 1; i < n; ++i)
+          fences->push_back(seq->seq[i]);
+        return SeqStmt::Flatten(
+            Array<Stmt>(seq->seq.begin(), seq->seq.begin() + wait));
+      }
+      if (wait != n - 1)
+        return std::nullopt;
+      auto last = StripWait(seq->seq[n - 1], fences);
+      if (!last)
+        return std::nullopt;
+      Array<Stmt> stmts = seq->seq;
+      stmts.Set(n - 1, last.value());
+      return SeqStmt(stmts);
+    }
+    if (const auto *let = stmt.as<LetStmtNode>())
+      return StripBody<LetStmt>(let, fences);
+    if (const auto *attr = stmt.as<AttrStmtNode>())
+      return StripBody<AttrStmt>(attr, fences);
+    if (const auto *alloc = stmt.as<AllocateNode>())
+      return StripBody<Allocate>(alloc, fences);
+    if (const auto *decl = stmt.as<DeclBufferNode>())
+      return StripBody<DeclBuffer>(decl, fences);
+    return std::nullopt;
+  }
+
+  template <typename T, typename Node>
+  static ffi::Optional<Stmt> StripBody(const Node *op, Array<Stmt> *fences) {
+    auto body = StripWait(op->body, fences);
+    if (!body)
+      return std::nullopt;
+    T stmt = ffi::GetRef<T>(op);
+    stmt.CopyOnWrite()->body = body.value();
+    return stmt;
+  }
+
+  /*!
+   * \brief The waits to insert before every statement of the body, given the
+   * batches of the previous iteration still in flight, oldest first.
+   * \param pending The batches in flight at the end of the body.
+   */
+  static std::vector<Array<Stmt>> Schedule(const std::vector<BodyStmt> &body,
+                                           std::vector<size_t> carried,
+                                           std::vector<size_t> *pending) {
+    std::vector<Array<Stmt>> waits(body.size());
+    *pending = std::move(carried);
+    for (size_t i = 0; i < body.size(); ++i) {
+      const WgmmaHazardCollector &hazards = body[i].hazards;
+      // The newest batch the statement depends on, batches complete in order
+      size_t needed = 0;
+      for (size_t k = pending->size(); k > 0; --k) {
+        const BodyStmt &batch = body[(*pending)[k - 1]];
+        bool conflict = hazards.barrier;
+        for (const VarNode *reg : batch.regs)
+          conflict |= hazards.vars.count(reg) != 0;
+        if (conflict) {
+          needed = k;
+          break;
+        }
+      }
+      if (needed > 0) {
+        waits[i] = Complete(body, *pending, needed);
+        pending->erase(pending->begin(), pending->begin() + needed);
+      }
+      if (body[i].issues_batch)
+        pending->push_back(i);
+    }
+    return waits;
+  }
+
+  /*! \brief Wait for the oldest count batches in flight, then fence them */
+  static Array<Stmt> Complete(const std::vector<BodyStmt> &body,
+                              const std::vector<size_t> &pending,
+                              size_t count) {
+    Array<Stmt> stmts;
+    if (count == 0)
+      return stmts;
+    int depth = static_cast<int>(pending.size() - count);
+    stmts.push_back(Evaluate(Call(DataType::Handle(), warpgroup_wait(),
+                                  {IntImm(DataType::Int(32), depth)})));
+    // A batch of the previous iteration may be in flight again
+    std::unordered_set<size_t> fenced(pending.begin() + count, pending.end());
+    for (size_t k = 0; k < count; ++k) {
+      if (!fenced.insert(pending[k]).second)
+        continue;
+      for (const Stmt &fence : body[pending[k]].fences)
+        stmts.push_back(fence);
+    }
+    return stmts;
+  }
+
+public:
+  static PrimFunc Substitute(PrimFunc f) {
+    WgmmaWaitDeferrer deferrer;
+    f.CopyOnWrite()->body = deferrer(f->body);
+    return f;
+  }
+};
+
+} // namespace
+
+namespace transform {
+
+using namespace tir::transform;
+
+tvm::transform::Pass DeferWgmmaWait() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    if (ctx->GetConfig<Bool>(kDisableWgmmaWaitDeferral, Bool(false)).value())
+      return f;
+    return WgmmaWaitDeferrer::Substitute(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.DeferWgmmaWait", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.DeferWgmmaWait", DeferWgmmaWait);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,291 @@
+/*!
+ * \file demote_thread_private_shared.cc
+ * \brief Demote the shared buffers every thread only touches its own slice of
+ * to local buffers.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/pattern.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../layout/layout.h"
+#include "../op/builtin.h"
+#include "arith/ir_visitor_with_analyzer.h"
+
+#include <unordered_map>
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+using arith::IRVisitorWithAnalyzer;
+
+/// Largest slice of a thread kept in registers, in bytes
+constexpr int64_t kMaxThreadPrivateBytes = 256;
+
+/*!
+ * \brief Row-major position of `indices` in `buffer`, undefined for shapes
+ * that are not constant.
+ */
+static Optional<PrimExpr> FlatIndex(const Buffer &buffer,
+                                    const Array<PrimExpr> &indices) {
+  PrimExpr flat = make_const(DataType::Int(32), 0);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (!buffer->shape[i].as<IntImmNode>() || indices[i].as<RampNode>())
+      return std::nullopt;
+    flat = flat * buffer->shape[i] + indices[i];
+  }
+  return flat;
+}
+
+/*!
+ * \brief Find the shared buffers whose elements each belong to one thread.
+ *
+ * Every access must index the buffer, flattened, as `stride * tx + offset`
+ * with the same constant stride and an offset provably in [0, stride) that
+ * does not depend on tx: distinct threads then touch disjoint slices of
+ * `stride` elements, and the slice of a thread can live in its registers,
+ * without the shared memory traffic and the syncs around it. Buffers whose
+ * address escapes, e.g. into an access_ptr of a TMA copy or an MMA, and
+ * kernels binding more than threadIdx.x, are left alone.
+ */
+class ThreadPrivateSharedFinder : public IRVisitorWithAnalyzer {
+public:
+  /*! \brief The stride of the slices of the buffers to demote. */
+  static std::unordered_map<const VarNode *, int64_t> Find(const Stmt &body) {
+    ThreadPrivateSharedFinder finder;
+    finder(body);
+    std::unordered_map<const VarNode *, int64_t> result;
+    if (finder.multi_thread_axes_)
+      return result;
+    for (const auto &[data, stride] : finder.strides_) {
+      if (stride <= 0)
+        continue;
+      int64_t bytes = stride * finder.buffers_.at(data)->dtype.bytes();
+      if (bytes <= kMaxThreadPrivateBytes)
+        result[data] = stride;
+    }
+    return result;
+  }
+
+private:
+  using IRVisitorWithAnalyzer::VisitExpr_;
+  using IRVisitorWithAnalyzer::VisitStmt_;
+
+  void VisitStmt_(const BlockNode *op) final {
+    for (const Buffer &buffer : op->alloc_buffers) {
+      String scope = buffer.scope();
+      if (scope == "shared" || scope == "shared.dyn") {
+        buffers_[buffer->data.get()] = buffer;
+        strides_[buffer->data.get()] = 0;
+      }
+    }
+    for (const MatchBufferRegion &match : op->match_buffers) {
+      Invalidate(match->source->buffer->data.get());
+    }
+    IRVisitorWithAnalyzer::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      const auto *extent = iv->dom->extent.as<IntImmNode>();
+      if (iv->thread_tag == "threadIdx.x") {
+        tx_ = iv->var;
+      } else if (iv->thread_tag.rfind("threadIdx", 0) == 0 &&
+                 (!extent || extent->value > 1)) {
+        multi_thread_axes_ = true;
+      }
+    }
+    IRVisitorWithAnalyzer::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode *op) final {
+    CheckAccess(op->buffer, op->indices);
+    IRVisitorWithAnalyzer::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    CheckAccess(op->buffer, op->indices);
+    IRVisitorWithAnalyzer::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode *op) final {
+    // The address of the buffer escapes
+    Invalidate(op);
+  }
+
+  void VisitExpr_(const CallNode *op) final {
+    if (op->op.same_as(builtin::address_of())) {
+      if (const auto *load = op->args[0].as<BufferLoadNode>())
+        Invalidate(load->buffer->data.get());
+    }
+    IRVisitorWithAnalyzer::VisitExpr_(op);
+  }
+
+  void Invalidate(const VarNode *data) {
+    auto it = strides_.find(data);
+    if (it != strides_.end())
+      it->second = -1;
+  }
+
+  void CheckAccess(const Buffer &buffer, const Array<PrimExpr> &indices) {
+    auto it = strides_.find(buffer->data.get());
+    if (it == strides_.end() || it->second < 0)
+      return;
+    Optional<PrimExpr> flat = FlatIndex(buffer, indices);
+    if (!tx_.defined() || !flat.defined()) {
+      it->second = -1;
+      return;
+    }
+    Array<PrimExpr> coeffs =
+        arith::DetectLinearEquation(flat.value(), {tx_.value()});
+    const auto *stride =
+        coeffs.size() == 2 ? analyzer_.Simplify(coeffs[0]).as<IntImmNode>()
+                           : nullptr;
+    if (!stride || stride->value <= 0 ||
+        (it->second > 0 && it->second != stride->value) ||
+        UsesVar(coeffs[1],
+                [&](const VarNode *v) { return v == tx_.value().get(); }) ||
+        !analyzer_.CanProve(coeffs[1] >= 0) ||
+        !analyzer_.CanProve(coeffs[1] < stride->value)) {
+      it->second = -1;
+      return;
+    }
+    it->second = stride->value;
+  }
+
+  Optional<Var> tx_;
+  bool multi_thread_axes_{false};
+  std::unordered_map<const VarNode *, Buffer> buffers_;
+  /*! \brief Slice stride of each candidate, 0 if unseen and -1 if shared. */
+  std::unordered_map<const VarNode *, int64_t> strides_;
+};
+
+/*!
+ * \brief Replace the demoted shared buffers by local buffers holding the
+ * slice of the thread, indexed by the offset within the slice.
+ */
+class ThreadPrivateSharedDemoter : public StmtExprMutator {
+public:
+  static Stmt Demote(const Stmt &body) {
+    auto strides = ThreadPrivateSharedFinder::Find(body);
+    if (strides.empty())
+      return body;
+    ThreadPrivateSharedDemoter demoter;
+    demoter.strides_ = std::move(strides);
+    return demoter(body);
+  }
+
+private:
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      if (iv->thread_tag == "threadIdx.x")
+        tx_ = iv->var;
+    }
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const BlockNode *op) final {
+    Array<Buffer> alloc_buffers;
+    for (const Buffer &buffer : op->alloc_buffers) {
+      auto it = strides_.find(buffer->data.get());
+      if (it == strides_.end()) {
+        alloc_buffers.push_back(buffer);
+        continue;
+      }
+      Buffer local =
+          decl_buffer({IntImm(DataType::Int(32), it->second)}, buffer->dtype,
+                      buffer->name, "local");
+      buffer_remap_.Set(buffer, local);
+      alloc_buffers.push_back(local);
+    }
+    Block block = Downcast<Block>(StmtExprMutator::VisitStmt_(op));
+    auto *n = block.CopyOnWrite();
+    n->alloc_buffers = alloc_buffers;
+    n->reads = RemapRegions(block->reads);
+    n->writes = RemapRegions(block->writes);
+    // The layouts of the demoted buffers were already applied by LowerTileOp
+    if (auto layout_map = n->annotations.Get(attr::kLayoutMap)) {
+      if (auto layouts = layout_map->as<Map<Buffer, Layout>>()) {
+        Map<Buffer, Layout> kept;
+        for (const auto &[buffer, layout] : layouts.value()) {
+          if (!buffer_remap_.count(buffer))
+            kept.Set(buffer, layout);
+        }
+        n->annotations.Set(attr::kLayoutMap, kept);
+      }
+    }
+    return block;
+  }
+
+  Array<BufferRegion> RemapRegions(const Array<BufferRegion> &regions) {
+    Array<BufferRegion> result;
+    for (const BufferRegion &region : regions) {
+      if (auto local = buffer_remap_.Get(region->buffer)) {
+        result.push_back(BufferRegion::FullRegion(local.value()));
+      } else {
+        result.push_back(region);
+      }
+    }
+    return result;
+  }
+
+  PrimExpr SliceOffset(const Buffer &buffer, const Array<PrimExpr> &indices) {
+    int64_t stride = strides_.at(buffer->data.get());
+    PrimExpr flat = FlatIndex(buffer, indices).value();
+    return analyzer_.Simplify(
+        flat - make_const(flat.dtype(), stride) * tx_.value());
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode *op) final {
+    auto store = Downcast<BufferStore>(StmtExprMutator::VisitStmt_(op));
+    if (auto local = buffer_remap_.Get(store->buffer)) {
+      PrimExpr offset = SliceOffset(store->buffer, store->indices);
+      return BufferStore(local.value(), store->value, {offset});
+    }
+    return store;
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode *op) final {
+    auto load = Downcast<BufferLoad>(StmtExprMutator::VisitExpr_(op));
+    if (auto local = buffer_remap_.Get(load->buffer)) {
+      PrimExpr offset = SliceOffset(load->buffer, load->indices);
+      return BufferLoad(local.value(), {offset});
+    }
+    return load;
+  }
+
+  std::unordered_map<const VarNode *, int64_t> strides_;
+  Map<Buffer, Buffer> buffer_remap_;
+  Optional<Var> tx_;
+  arith::Analyzer analyzer_;
+};
+
+using namespace tir::transform;
+
+namespace transform {
+
+tvm::transform::Pass DemoteThreadPrivateShared() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    auto *n = f.CopyOnWrite();
+    n->body = ThreadPrivateSharedDemoter::Demote(n->body);
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.DemoteThreadPrivateShared", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.DemoteThreadPrivateShared",
+                        DemoteThreadPrivateShared);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,450 @@
+/*!
+ * \file eliminate_dead_fragment_stores.cc
+ * \brief Remove the writes of register buffers nothing reads, and fold the
+ * clear of an accumulator into the first gemm that overwrites it.
+ *
+ * The accumulator of a gemm is usually cleared right before the loop that
+ * accumulates into it:
+ *
+ *   T.clear(C_local)
+ *   for k in T.Pipelined(n):
+ *     ...
+ *     T.gemm(A_shared, B_shared, C_local)
+ *   ->
+ *   for k in T.Pipelined(n):
+ *     ...
+ *     T.gemm(A_shared, B_shared, C_local, clear_accum=k == 0)
+ *
+ * When the fill of zeros covers the whole fragment and the next statement
+ * touching it is a gemm accumulating into all of it, the fill is dropped and
+ * the gemm clears the accumulator instead: WGMMA and tcgen05 issue their
+ * first MMA with a zero scale of C, and no register is written twice. The
+ * gemm may be a statement of the body of a loop that runs at least once,
+ * which then clears it in its first iteration only.
+ *
+ * The stores, fills and copies into a "local" or "local.fragment" buffer
+ * that nothing reads, e.g. a scratch fragment left over from debugging or a
+ * value computed by a building block the kernel does not use, are removed
+ * together with the buffer, and so are the loops left empty. Every load,
+ * every other tile operation and every call that takes the buffer counts as
+ * a read, unless it only computes a value stored into a dead buffer, so that
+ * chains of dead buffers go at once; buffers with an annotated layout are
+ * kept.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../layout/layout.h"
+#include "../op/builtin.h"
+#include "../op/copy.h"
+#include "../op/fill.h"
+#include "../op/gemm.h"
+#include "../op/gemm_py.h"
+#include "../op/operator.h"
+#include "arith/ir_mutator_with_analyzer.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+namespace {
+
+using VarSet = std::unordered_set<const VarNode *>;
+
+bool IsRegisterScope(const Buffer &buffer) {
+  std::string scope = buffer.scope();
+  return scope == "local" || scope == "local.fragment";
+}
+
+bool CoversBuffer(const Buffer &buffer, const Array<Range> &region,
+                  arith::Analyzer *analyzer) {
+  if (region.size() != buffer->shape.size())
+    return false;
+  for (size_t i = 0; i < region.size(); ++i) {
+    if (!is_zero(region[i]->min) ||
+        !analyzer->CanProveEqual(region[i]->extent, buffer->shape[i]))
+      return false;
+  }
+  return true;
+}
+
+/*! \brief The buffer a fill or copy statement only writes */
+Optional<Buffer> WrittenBuffer(const Stmt &stmt) {
+  const auto *eval = stmt.as<EvaluateNode>();
+  const auto *call = eval ? eval->value.as<CallNode>() : nullptr;
+  if (!call ||
+      !(call->op.same_as(Fill::Get()) || call->op.same_as(Copy::Get())))
+    return std::nullopt;
+  TileOperator tile = ParseOperator(ffi::GetRef<Call>(call));
+  if (const auto *fill = tile.as<FillNode>())
+    return fill->dst;
+  if (const auto *copy = tile.as<CopyNode>())
+    return copy->dst;
+  return std::nullopt;
+}
+
+/*!
+ * \brief The buffers read by the writes of each buffer. The stored buffer of
+ * a store and the destination of a fill or copy are only written; the reads
+ * of any other statement are attributed to no buffer, i.e. they are live.
+ */
+class ReadCollector : public StmtExprVisitor {
+public:
+  std::unordered_map<const VarNode *, VarSet> reads;
+
+private:
+  void VisitStmt_(const BufferStoreNode *op) final {
+    const VarNode *outer = writer_;
+    writer_ = op->buffer->data.get();
+    StmtExprVisitor::VisitStmt_(op);
+    writer_ = outer;
+  }
+
+  void VisitStmt_(const EvaluateNode *op) final {
+    Optional<Buffer> dst = WrittenBuffer(ffi::GetRef<Stmt>(op));
+    if (!dst) {
+      StmtExprVisitor::VisitStmt_(op);
+      return;
+    }
+    const VarNode *outer = writer_;
+    writer_ = dst.value()->data.get();
+    const auto *call = op->value.as<CallNode>();
+    TileOperator tile = ParseOperator(ffi::GetRef<Call>(call));
+    if (const auto *fill = tile.as<FillNode>()) {
+      VisitExpr(fill->value);
+      for (const Range &r : fill->region) {
+        VisitExpr(r->min);
+        VisitExpr(r->extent);
+      }
+    } else if (const auto *copy = tile.as<CopyNode>()) {
+      VisitExpr(call->args[0]);
+      for (const Range &r : copy->dst_range) {
+        VisitExpr(r->min);
+        VisitExpr(r->extent);
+      }
+      for (const auto &[key, value] : copy->annotations) {
+        if (auto expr = value.as<PrimExpr>())
+          VisitExpr(expr.value());
+      }
+    }
+    writer_ = outer;
+  }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    reads[writer_].insert(op->buffer->data.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode *op) final {
+    if (op->dtype.is_handle())
+      reads[writer_].insert(op);
+  }
+
+  void VisitStmt_(const BlockNode *op) final {
+    // Keep the buffers whose layout is annotated
+    if (auto layout_map = op->annotations.Get(attr::kLayoutMap)) {
+      if (auto map = layout_map->as<Map<Var, Layout>>()) {
+        for (const auto &[var, _] : map.value())
+          reads[nullptr].insert(var.get());
+      }
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  const VarNode *writer_{nullptr};
+};
+
+/*! \brief Remove the writes of dead buffers and what they leave empty */
+class DeadStoreRemover : public StmtExprMutator {
+public:
+  explicit DeadStoreRemover(const VarSet &dead) : dead_(dead) {}
+
+private:
+  bool IsDead(const Buffer &buffer) const {
+    return dead_.count(buffer->data.get()) > 0;
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode *op) final {
+    if (IsDead(op->buffer))
+      return Evaluate(0);
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const EvaluateNode *op) final {
+    Stmt stmt = ffi::GetRef<Stmt>(op);
+    if (auto buffer = WrittenBuffer(stmt); buffer && IsDead(buffer.value()))
+      return Evaluate(0);
+    return stmt;
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode *op) final {
+    Array<Stmt> seq;
+    for (const Stmt &stmt : op->seq) {
+      Stmt new_stmt = VisitStmt(stmt);
+      if (!is_no_op(new_stmt))
+        seq.push_back(new_stmt);
+    }
+    return seq.empty() ? Evaluate(0) : SeqStmt::Flatten(seq);
+  }
+
+  Stmt VisitStmt_(const ForNode *op) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    const auto *loop = stmt.as<ForNode>();
+    return loop && is_no_op(loop->body) ? Evaluate(0) : stmt;
+  }
+
+  Stmt VisitStmt_(const IfThenElseNode *op) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    const auto *branch = stmt.as<IfThenElseNode>();
+    if (branch && is_no_op(branch->then_case) &&
+        (!branch->else_case || is_no_op(branch->else_case.value())))
+      return Evaluate(0);
+    return stmt;
+  }
+
+  Stmt VisitStmt_(const BlockNode *op) final {
+    Block block = Downcast<Block>(StmtExprMutator::VisitStmt_(op));
+    Array<Buffer> alloc_buffers;
+    for (const Buffer &buffer : block->alloc_buffers) {
+      if (!IsDead(buffer))
+        alloc_buffers.push_back(buffer);
+    }
+    if (alloc_buffers.size() == block->alloc_buffers.size())
+      return block;
+    auto live = [&](const Array<BufferRegion> &regions) {
+      Array<BufferRegion> kept;
+      for (const BufferRegion &region : regions) {
+        if (!IsDead(region->buffer))
+          kept.push_back(region);
+      }
+      return kept;
+    };
+    BlockNode *n = block.CopyOnWrite();
+    n->alloc_buffers = alloc_buffers;
+    n->reads = live(n->reads);
+    n->writes = live(n->writes);
+    return block;
+  }
+
+  const VarSet &dead_;
+};
+
+/*! \brief Fold the clear of an accumulator into the gemm overwriting it */
+class AccumulatorClearFolder : public arith::IRMutatorWithAnalyzer {
+public:
+  using arith::IRMutatorWithAnalyzer::IRMutatorWithAnalyzer;
+
+private:
+  using arith::IRMutatorWithAnalyzer::VisitStmt_;
+
+  static bool References(const Stmt &stmt, const Buffer &buffer) {
+    bool found = false;
+    const VarNode *data = buffer->data.get();
+    PostOrderVisit(stmt, [&](const ObjectRef &obj) {
+      if (const auto *load = obj.as<BufferLoadNode>())
+        found = found || load->buffer->data.get() == data;
+      else if (const auto *store = obj.as<BufferStoreNode>())
+        found = found || store->buffer->data.get() == data;
+      else
+        found = found || obj.get() == data;
+    });
+    return found;
+  }
+
+  /*! \brief The fragment a statement fills with zeros, all of it */
+  Optional<Buffer> ClearedFragment(const Stmt &stmt) {
+    const auto *eval = stmt.as<EvaluateNode>();
+    const auto *call = eval ? eval->value.as<CallNode>() : nullptr;
+    if (!call || !call->op.same_as(Fill::Get()))
+      return std::nullopt;
+    TileOperator tile = ParseOperator(ffi::GetRef<Call>(call));
+    const auto *fill = tile.as<FillNode>();
+    if (!fill || fill->dst.scope() != "local.fragment" ||
+        !is_zero(analyzer_->Simplify(fill->value)) ||
+        !CoversBuffer(fill->dst, fill->region, analyzer_))
+      return std::nullopt;
+    return fill->dst;
+  }
+
+  /*!
+   * \brief The gemm call of a statement accumulating into all of `c`
+   * without clearing it. `dynamic` requires a gemm that takes a clear flag
+   * known at run time only.
+   */
+  const CallNode *AccumulatingGemm(const Stmt &stmt, const Buffer &c,
+                                   bool dynamic) {
+    const auto *eval = stmt.as<EvaluateNode>();
+    const auto *call = eval ? eval->value.as<CallNode>() : nullptr;
+    if (!call || call->args.size() < 10)
+      return nullptr;
+    TileOperator tile = ParseOperator(ffi::GetRef<Call>(call));
+    BufferRegion c_region;
+    PrimExpr clear;
+    if (const auto *gemm = tile.as<GemmPyNode>()) {
+      c_region = gemm->cRegion_;
+      clear = gemm->clearAccum_;
+    } else if (const auto *gemm = tile.as<GemmNode>(); gemm && !dynamic) {
+      c_region = gemm->cRegion_;
+      clear = gemm->clearAccum_;
+    } else {
+      return nullptr;
+    }
+    if (!c_region->buffer.same_as(c) || !is_zero(clear) ||
+        !CoversBuffer(c, c_region->region, analyzer_))
+      return nullptr;
+    return call;
+  }
+
+  static Stmt WithClear(const CallNode *gemm, PrimExpr clear) {
+    Call call = ffi::GetRef<Call>(gemm);
+    call.CopyOnWrite()->args.Set(9, std::move(clear));
+    return Evaluate(call);
+  }
+
+  /*! \brief `stmt` with its first access to `c` clearing it, if it can */
+  Optional<Stmt> Fold(const Stmt &stmt, const Buffer &c) {
+    if (const CallNode *gemm = AccumulatingGemm(stmt, c, false))
+      return WithClear(gemm, Bool(true));
+    const auto *loop = stmt.as<ForNode>();
+    if (!loop || loop->kind != ForKind::kSerial ||
+        !analyzer_->CanProve(loop->extent > 0))
+      return std::nullopt;
+    Array<Stmt> body;
+    if (const auto *seq = loop->body.as<SeqStmtNode>())
+      body = seq->seq;
+    else
+      body = {loop->body};
+    for (size_t i = 0; i < body.size(); ++i) {
+      if (const CallNode *gemm = AccumulatingGemm(body[i], c, true)) {
+        body.Set(i, WithClear(gemm, loop->loop_var == loop->min));
+        For new_loop = ffi::GetRef<For>(loop);
+        new_loop.CopyOnWrite()->body = SeqStmt::Flatten(body);
+        return Stmt(new_loop);
+      }
+      if (References(body[i], c))
+        return std::nullopt;
+    }
+    return std::nullopt;
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode *op) final {
+    Array<Stmt> seq;
+    for (const Stmt &stmt : op->seq)
+      seq.push_back(VisitStmt(stmt));
+    bool changed = false;
+    for (size_t i = 0; i < seq.size(); ++i) {
+      Optional<Buffer> c = ClearedFragment(seq[i]);
+      if (!c)
+        continue;
+      for (size_t j = i + 1; j < seq.size(); ++j) {
+        if (!References(seq[j], c.value()))
+          continue;
+        if (auto folded = Fold(seq[j], c.value())) {
+          seq.Set(j, folded.value());
+          seq.Set(i, Evaluate(0));
+          changed = true;
+        }
+        break;
+      }
+    }
+    if (!changed) {
+      bool same = true;
+      for (size_t i = 0; i < seq.size(); ++i)
+        same = same && seq[i].same_as(op->seq[i]);
+      if (same)
+        return ffi::GetRef<Stmt>(op);
+    }
+    Array<Stmt> kept;
+    for (const Stmt &stmt : seq) {
+      if (!is_no_op(stmt))
+        kept.push_back(stmt);
+    }
+    return kept.empty() ? Evaluate(0) : SeqStmt::Flatten(kept);
+  }
+};
+
+/*!
+ * \brief The register buffers allocated in the body whose values reach no
+ * other buffer nor statement.
+ */
+VarSet DeadBuffers(const Stmt &body) {
+  VarSet candidates;
+  PostOrderVisit(body, [&](const ObjectRef &obj) {
+    if (const auto *block = obj.as<BlockNode>()) {
+      for (const Buffer &buffer : block->alloc_buffers) {
+        if (IsRegisterScope(buffer))
+          candidates.insert(buffer->data.get());
+      }
+    }
+  });
+  ReadCollector collector;
+  collector(body);
+  VarSet live;
+  std::vector<const VarNode *> worklist;
+  auto mark = [&](const VarSet &buffers) {
+    for (const VarNode *v : buffers) {
+      if (live.insert(v).second)
+        worklist.push_back(v);
+    }
+  };
+  for (const auto &[writer, read] : collector.reads) {
+    if (!candidates.count(writer))
+      mark(read);
+  }
+  while (!worklist.empty()) {
+    const VarNode *v = worklist.back();
+    worklist.pop_back();
+    auto it = collector.reads.find(v);
+    if (it != collector.reads.end())
+      mark(it->second);
+  }
+  VarSet dead;
+  for (const VarNode *v : candidates) {
+    if (!live.count(v))
+      dead.insert(v);
+  }
+  return dead;
+}
+
+} // namespace
+
+namespace transform {
+
+using namespace tir::transform;
+
+tvm::transform::Pass EliminateDeadFragmentStores() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    if (ctx->GetConfig<Bool>(kDisableDeadStoreElimination, Bool(false))
+            .value())
+      return f;
+    arith::Analyzer analyzer;
+    Stmt body = AccumulatorClearFolder(&analyzer)(f->body);
+    VarSet dead = DeadBuffers(body);
+    if (!dead.empty())
+      body = DeadStoreRemover(dead)(body);
+    if (!body.same_as(f->body))
+      f.CopyOnWrite()->body = body;
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.EliminateDeadFragmentStores",
+                            {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.EliminateDeadFragmentStores",
+                        EliminateDeadFragmentStores);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,331 @@
+/*!
+ * \file eliminate_redundant_copies.cc
+ * \brief Remove the T.copy from global memory that load a tile nothing has
+ * written since the same copy last loaded it, and hoist the copies that load
+ * the same tile in every iteration of a loop out of the loop.
+ *
+ * Kernels composed from smaller building blocks, or written after a
+ * reference implementation, often reload a tile they already hold, e.g. the
+ * query tile of an attention kernel copied again in each iteration of the
+ * key loop:
+ *
+ *   for k in T.Pipelined(n):
+ *     T.copy(Q[bx * 64:bx * 64 + 64, :], Q_shared)
+ *     T.copy(K[k * 64:k * 64 + 64, :], K_shared)
+ *     T.gemm(Q_shared, K_shared, S_local)
+ *   ->
+ *   T.copy(Q[bx * 64:bx * 64 + 64, :], Q_shared)
+ *   for k in T.Pipelined(n):
+ *     T.copy(K[k * 64:k * 64 + 64, :], K_shared)
+ *     T.gemm(Q_shared, K_shared, S_local)
+ *
+ * A copy from global into shared memory or a fragment is redundant when an
+ * identical copy precedes it in the same sequence and no statement in
+ * between may write its source, its destination or a buffer its indices
+ * read. A copy of a loop body is hoisted when its regions do not depend on
+ * the loop, no other statement of the body may write the buffers it depends
+ * on and none before it touches its destination. The writes of a statement
+ * are collected conservatively: stores, the destination of copies and fills,
+ * the accumulator of gemms, and any other opaque call may write everything.
+ * Global memory is assumed not to be written by other blocks while the
+ * kernel runs, which signals and waits, being opaque calls, also break.
+ *
+ * The pass runs on tile operations, before layout inference, so that the
+ * layouts, pipeline planning and barrier injection only see the copies that
+ * remain. Loops with an explicit pipeline order or stage assignment, one
+ * entry per statement of their body, are left alone.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/op_attr_types.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../op/builtin.h"
+#include "../op/copy.h"
+#include "../op/fill.h"
+#include "../op/gemm.h"
+#include "../op/gemm_py.h"
+#include "../op/operator.h"
+#include "../op/region.h"
+#include "arith/ir_mutator_with_analyzer.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+namespace {
+
+using VarSet = std::unordered_set<const VarNode *>;
+
+/*! \brief The data of every buffer and the handles an expression uses */
+void CollectBuffers(const ObjectRef &node, VarSet *out) {
+  PostOrderVisit(node, [&](const ObjectRef &obj) {
+    if (const auto *load = obj.as<BufferLoadNode>()) {
+      out->insert(load->buffer->data.get());
+    } else if (const auto *var = obj.as<VarNode>()) {
+      if (var->dtype.is_handle())
+        out->insert(var);
+    }
+  });
+}
+
+bool Intersects(const VarSet &a, const VarSet &b) {
+  for (const VarNode *v : a) {
+    if (b.count(v))
+      return true;
+  }
+  return false;
+}
+
+/*!
+ * \brief The buffers a statement may write, or all of them when it makes an
+ * opaque call.
+ */
+class WriteCollector : public StmtExprVisitor {
+public:
+  VarSet written;
+  bool writes_all{false};
+
+  bool MayWrite(const VarSet &buffers) const {
+    return writes_all || Intersects(written, buffers);
+  }
+
+private:
+  void VisitStmt_(const BufferStoreNode *op) final {
+    written.insert(op->buffer->data.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const CallNode *op) final {
+    if (op->op.same_as(RegionOp::Get())) {
+      StmtExprVisitor::VisitExpr_(op);
+      return;
+    }
+    TileOperator tile = ParseOperator(ffi::GetRef<Call>(op));
+    if (tile.defined()) {
+      if (const auto *copy = tile.as<CopyNode>()) {
+        written.insert(copy->dst->data.get());
+      } else if (const auto *fill = tile.as<FillNode>()) {
+        written.insert(fill->dst->data.get());
+      } else if (const auto *gemm = tile.as<GemmNode>()) {
+        written.insert(gemm->c_->data.get());
+      } else if (const auto *gemm = tile.as<GemmPyNode>()) {
+        written.insert(gemm->c_->data.get());
+      } else {
+        writes_all = true;
+      }
+      return;
+    }
+    if (const auto *call_op = op->op.as<OpNode>()) {
+      static auto effect_map =
+          Op::GetAttrMap<TCallEffectKind>("TCallEffectKind");
+      Integer opaque(static_cast<int>(CallEffectKind::kOpaque));
+      auto effect = static_cast<CallEffectKind>(
+          effect_map.get(ffi::GetRef<Op>(call_op), opaque)->value);
+      if (effect == CallEffectKind::kUpdateState ||
+          effect == CallEffectKind::kOpaque)
+        writes_all = true;
+    } else {
+      writes_all = true;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+};
+
+class RedundantCopyEliminator : public arith::IRMutatorWithAnalyzer {
+public:
+  static PrimFunc Substitute(PrimFunc f) {
+    arith::Analyzer analyzer;
+    RedundantCopyEliminator eliminator(&analyzer);
+    f.CopyOnWrite()->body = eliminator(f->body);
+    return f;
+  }
+
+private:
+  using arith::IRMutatorWithAnalyzer::IRMutatorWithAnalyzer;
+  using arith::IRMutatorWithAnalyzer::VisitStmt_;
+
+  /*! \brief A copy from global into shared memory or a fragment */
+  static const CallNode *AsCopy(const Stmt &stmt) {
+    const auto *eval = stmt.as<EvaluateNode>();
+    if (!eval)
+      return nullptr;
+    const auto *call = eval->value.as<CallNode>();
+    if (!call || !call->op.same_as(Copy::Get()) || call->args.size() != 2)
+      return nullptr;
+    TileOperator tile = ParseOperator(ffi::GetRef<Call>(call));
+    const auto *copy = tile.as<CopyNode>();
+    if (copy == nullptr)
+      return nullptr;
+    std::string src_scope = copy->src.scope();
+    std::string dst_scope = copy->dst.scope();
+    if ((src_scope != "global" && !src_scope.empty()) ||
+        dst_scope == "global" || dst_scope.empty())
+      return nullptr;
+    return call;
+  }
+
+  static bool MayWrite(const Stmt &stmt, const VarSet &buffers) {
+    WriteCollector collector;
+    collector(stmt);
+    return collector.MayWrite(buffers);
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode *op) final {
+    struct Available {
+      Stmt copy;
+      VarSet deps;
+    };
+    std::vector<Available> available;
+    Array<Stmt> seq;
+    bool changed = false;
+    for (const Stmt &stmt : op->seq) {
+      Stmt new_stmt = VisitStmt(stmt);
+      changed |= !new_stmt.same_as(stmt);
+      const CallNode *copy = AsCopy(new_stmt);
+      if (copy) {
+        bool redundant = false;
+        for (const Available &a : available)
+          redundant = redundant || StructuralEqual()(a.copy, new_stmt);
+        if (redundant) {
+          changed = true;
+          continue;
+        }
+      }
+      WriteCollector writes;
+      writes(new_stmt);
+      std::vector<Available> kept;
+      for (Available &a : available) {
+        if (!writes.MayWrite(a.deps))
+          kept.push_back(std::move(a));
+      }
+      available = std::move(kept);
+      if (copy) {
+        VarSet deps;
+        CollectBuffers(copy->args, &deps);
+        available.push_back({new_stmt, std::move(deps)});
+      }
+      seq.push_back(new_stmt);
+    }
+    if (!changed)
+      return ffi::GetRef<Stmt>(op);
+    return SeqStmt::Flatten(seq);
+  }
+
+  static bool HasExplicitSchedule(const ForNode *op) {
+    for (const char *key :
+         {"tl_pipeline_order", "tl_pipeline_stage", "tl_pipeline_group",
+          "software_pipeline_order", "software_pipeline_stage"}) {
+      if (op->annotations.count(key))
+        return true;
+    }
+    return false;
+  }
+
+  Stmt VisitStmt_(const ForNode *op) final {
+    Stmt stmt = arith::IRMutatorWithAnalyzer::VisitStmt_(op);
+    const auto *loop = stmt.as<ForNode>();
+    if (!loop ||
+        (loop->kind != ForKind::kSerial && loop->kind != ForKind::kUnrolled) ||
+        HasExplicitSchedule(loop))
+      return stmt;
+    Array<Stmt> body;
+    if (const auto *seq = loop->body.as<SeqStmtNode>())
+      body = seq->seq;
+    else
+      body = {loop->body};
+
+    // The variables whose value may change from one iteration to the next
+    VarSet varying{loop->loop_var.get()};
+    PostOrderVisit(loop->body, [&](const ObjectRef &obj) {
+      if (const auto *let = obj.as<LetStmtNode>())
+        varying.insert(let->var.get());
+      else if (const auto *let = obj.as<LetNode>())
+        varying.insert(let->var.get());
+      else if (const auto *f = obj.as<ForNode>())
+        varying.insert(f->loop_var.get());
+      else if (const auto *alloc = obj.as<AllocateNode>())
+        varying.insert(alloc->buffer_var.get());
+      else if (const auto *block = obj.as<BlockNode>()) {
+        for (const Buffer &buf : block->alloc_buffers)
+          varying.insert(buf->data.get());
+      }
+    });
+    auto is_varying = [&](const VarNode *v) { return varying.count(v) > 0; };
+
+    Array<Stmt> hoisted, remaining;
+    for (size_t i = 0; i < body.size(); ++i) {
+      const CallNode *copy = AsCopy(body[i]);
+      if (!copy || UsesVar(body[i], is_varying)) {
+        remaining.push_back(body[i]);
+        continue;
+      }
+      VarSet deps;
+      CollectBuffers(copy->args, &deps);
+      TileOperator tile = ParseOperator(ffi::GetRef<Call>(copy));
+      VarSet dst{tile.as<CopyNode>()->dst->data.get()};
+      bool hoistable = true;
+      for (size_t j = 0; j < body.size() && hoistable; ++j) {
+        if (j == i)
+          continue;
+        if (MayWrite(body[j], deps)) {
+          hoistable = false;
+        } else if (j < i) {
+          // An earlier statement would see the tile of the previous
+          // iteration in the destination
+          VarSet used;
+          CollectBuffers(body[j], &used);
+          hoistable = !Intersects(used, dst);
+        }
+      }
+      if (hoistable)
+        hoisted.push_back(body[i]);
+      else
+        remaining.push_back(body[i]);
+    }
+    if (hoisted.empty())
+      return stmt;
+
+    For new_loop = ffi::GetRef<For>(loop);
+    new_loop.CopyOnWrite()->body =
+        remaining.empty() ? Evaluate(0) : SeqStmt::Flatten(remaining);
+    Stmt prologue = SeqStmt::Flatten(hoisted);
+    PrimExpr runs = loop->extent > 0;
+    if (!analyzer_->CanProve(runs))
+      prologue = IfThenElse(runs, prologue);
+    return SeqStmt({prologue, new_loop});
+  }
+};
+
+} // namespace
+
+namespace transform {
+
+using namespace tir::transform;
+
+tvm::transform::Pass EliminateRedundantCopies() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    if (ctx->GetConfig<Bool>(kDisableCopyElimination, Bool(false)).value())
+      return f;
+    return RedundantCopyEliminator::Substitute(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.EliminateRedundantCopies", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.EliminateRedundantCopies",
+                        EliminateRedundantCopies);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
@@ -1,112 +1,441 @@
 /*!
  * \file eliminate_storage_sync_for_mbarrier.cc
+ * \brief Remove the block-wide syncs whose conflicts are already ordered.
  */
 #include "../op/builtin.h"
-#include "arith/ir_mutator_with_analyzer.h"
 #include "arith/ir_visitor_with_analyzer.h"
+#include "runtime/thread_storage_scope.h"
+#include "tir/transforms/ir_utils.h"
+#include <tvm/arith/int_set.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 namespace tvm {
 namespace tl {
 
 using namespace tir;
-using arith::IRMutatorWithAnalyzer;
 using arith::IRVisitorWithAnalyzer;
 
-class Eliminator : public IRMutatorWithAnalyzer {
+namespace {
+
+bool IsSharedMemory(const Var &var) {
+  auto scope = runtime::StorageScope::Create(GetPtrStorageScope(var));
+  return scope.rank == runtime::StorageRank::kShared;
+}
+
+bool IsBlockSync(const Stmt &stmt) {
+  const auto *eval = stmt.as<EvaluateNode>();
+  const auto *call = eval ? eval->value.as<CallNode>() : nullptr;
+  if (!call || !call->op.same_as(builtin::tvm_storage_sync()) ||
+      call->args.size() != 1)
+    return false;
+  const auto *scope = call->args[0].as<StringImmNode>();
+  return scope && (scope->value == "shared" || scope->value == "shared.dyn");
+}
+
+/*! \brief A shared memory access of a window between two syncs. */
+struct SyncAccess {
+  const VarNode *buffer{nullptr};
+  /*! \brief Bytes touched by all the threads, unknown when undefined. */
+  arith::IntSet bytes;
+  bool is_write{false};
+  /*! \brief The mbarrier whose wait completes a TMA write. */
+  PrimExpr tma_barrier;
+  /*! \brief Order of the access within the window. */
+  int position{0};
+};
+
+/*!
+ * \brief The accesses and ordering events of the statements of a window.
+ *
+ * The indices are relaxed over the threads and the loops inside the window,
+ * the loops enclosing the sync staying symbolic so that the stages of an
+ * unrolled pipeline touch distinct bytes.
+ */
+class WindowCollector : public StmtExprVisitor {
 public:
-  static Stmt Substitute(const Stmt &stmt, bool skip_thread_partition = false) {
-    arith::Analyzer analyzer;
-    Eliminator transformer(&analyzer);
-    return transformer.VisitStmt(stmt);
+  explicit WindowCollector(const Map<Var, arith::IntSet> &thread_dom)
+      : dom_(thread_dom) {}
+
+  std::vector<SyncAccess> accesses;
+  /*! \brief The mbarriers all threads waited on, with the wait position. */
+  std::vector<std::pair<PrimExpr, int>> waits;
+  /*! \brief Whether async writes completed without an mbarrier, visible to
+   * the other threads only after a block sync. */
+  bool has_async_completion{false};
+
+  void Collect(const Stmt &stmt) { VisitStmt(stmt); }
+
+private:
+  void VisitStmt_(const ForNode *op) final {
+    dom_.Set(op->loop_var, arith::IntSet::FromMinExtent(op->min, op->extent));
+    StmtExprVisitor::VisitStmt_(op);
+    dom_.erase(op->loop_var);
+  }
+
+  void VisitStmt_(const IfThenElseNode *op) final {
+    VisitExpr(op->condition);
+    ++cond_depth_;
+    VisitStmt(op->then_case);
+    if (op->else_case.defined())
+      VisitStmt(op->else_case.value());
+    --cond_depth_;
+  }
+
+  void VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::async_wait_queue_scope) {
+      has_async_completion = true;
+    }
+    if (op->attr_key == tir::attr::async_scope) {
+      // The copies complete at a wait of the queue
+      has_async_completion = true;
+    }
+    StmtExprVisitor::VisitStmt_(op);
   }
 
-  Eliminator(arith::Analyzer *analyzer) : IRMutatorWithAnalyzer(analyzer) {
-    im_mbarrier_for_ = false;
-    in_mbarrier_region_ = false;
+  void VisitStmt_(const BufferStoreNode *op) final {
+    AddElementAccess(op->buffer, op->indices, true);
+    StmtExprVisitor::VisitStmt_(op);
   }
 
-  Stmt VisitStmt_(const AttrStmtNode *op) final {
-    if (op->attr_key == "thread_extent") {
-      if (const auto *var = op->node.as<VarNode>()) {
-        if (var->name_hint == "threadIdx.x") {
-          thread_extent_ = op;
+  void VisitExpr_(const BufferLoadNode *op) final {
+    AddElementAccess(op->buffer, op->indices, false);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode *op) final {
+    // Shared memory handed over as a raw pointer
+    auto var = tvm::ffi::GetRef<Var>(op);
+    if (op->type_annotation.as<PointerTypeNode>() && IsSharedMemory(var)) {
+      AddAccess(op, arith::IntSet(), true);
+      AddAccess(op, arith::IntSet(), false);
+    }
+  }
+
+  void VisitExpr_(const CallNode *op) final {
+    if (op->op.same_as(builtin::tvm_access_ptr())) {
+      const auto *data = op->args[1].as<VarNode>();
+      const auto *flag = op->args[4].as<IntImmNode>();
+      if (data && IsSharedMemory(tvm::ffi::GetRef<Var>(data))) {
+        PrimExpr bytes =
+            make_const(op->args[2].dtype(), op->args[0].dtype().bytes());
+        arith::IntSet range = arith::EvalSet(
+            Range::FromMinExtent(op->args[2] * bytes, op->args[3] * bytes),
+            dom_);
+        int mask = flag ? static_cast<int>(flag->value) : 3;
+        if (mask & 1)
+          AddAccess(data, range, false);
+        if (mask & 2)
+          AddAccess(data, range, true);
+      }
+      for (size_t i = 2; i < op->args.size(); ++i)
+        VisitExpr(op->args[i]);
+      return;
+    }
+    if (op->op.same_as(builtin::address_of())) {
+      if (const auto *load = op->args[0].as<BufferLoadNode>()) {
+        // The extent behind the address is unknown
+        if (IsSharedMemory(load->buffer->data)) {
+          AddAccess(load->buffer->data.get(), arith::IntSet(), true);
+          AddAccess(load->buffer->data.get(), arith::IntSet(), false);
         }
+        for (const PrimExpr &index : load->indices)
+          VisitExpr(index);
+        return;
+      }
+    }
+    if (op->op.same_as(tl::tma_load()) ||
+        op->op.same_as(tl::tma_load_im2col())) {
+      size_t begin = accesses.size();
+      StmtExprVisitor::VisitExpr_(op);
+      for (size_t k = begin; k < accesses.size(); ++k) {
+        if (accesses[k].is_write)
+          accesses[k].tma_barrier = op->args[1];
+      }
+      return;
+    }
+    if (op->op.same_as(tl::mbarrier_wait_parity())) {
+      if (cond_depth_ == 0) {
+        waits.emplace_back(op->args[0], position_++);
+      } else {
+        // Some threads may read data they did not wait for
+        has_async_completion = true;
+      }
+    } else if (op->op.same_as(builtin::ptx_wait_group()) ||
+               op->op.same_as(builtin::ptx_wait_barrier())) {
+      has_async_completion = true;
+    } else if (op->op.same_as(builtin::call_extern())) {
+      const auto *name = op->args[0].as<StringImmNode>();
+      if (name && name->value.find("wait") != std::string::npos)
+        has_async_completion = true;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void AddElementAccess(const Buffer &buffer, const Array<PrimExpr> &indices,
+                        bool is_write) {
+    if (!IsSharedMemory(buffer->data))
+      return;
+    if (indices.size() != 1) {
+      AddAccess(buffer->data.get(), arith::IntSet(), is_write);
+      return;
+    }
+    PrimExpr base = indices[0];
+    int64_t lanes = 1;
+    if (const auto *ramp = base.as<RampNode>()) {
+      const auto *num_lanes = ramp->lanes.as<IntImmNode>();
+      if (!is_one(ramp->stride) || !num_lanes) {
+        AddAccess(buffer->data.get(), arith::IntSet(), is_write);
+        return;
       }
+      base = ramp->base;
+      lanes = num_lanes->value;
     }
-    return IRMutatorWithAnalyzer::VisitStmt_(op);
-  }
-
-  Stmt VisitStmt_(const EvaluateNode *op) final {
-    const CallNode *call = nullptr;
-    if (op->value->IsInstance<CallNode>()) {
-      call = op->value.as<CallNode>();
-      if (call->op.same_as(builtin::tvm_storage_sync())) {
-        // Skip storage sync if we're in a region with mbarrier operations
-        // and we're not in a for loop with mbarrier operations
-        if (in_mbarrier_region_ || im_mbarrier_for_) {
-          return Stmt();
+    int64_t bytes = buffer->dtype.bytes() * lanes;
+    PrimExpr lo = base * make_const(base.dtype(), buffer->dtype.bytes());
+    AddAccess(buffer->data.get(),
+              arith::EvalSet(
+                  Range::FromMinExtent(lo, make_const(base.dtype(), bytes)),
+                  dom_),
+              is_write);
+  }
+
+  void AddAccess(const VarNode *buffer, arith::IntSet bytes, bool is_write) {
+    SyncAccess access;
+    access.buffer = buffer;
+    access.bytes = std::move(bytes);
+    access.is_write = is_write;
+    access.position = position_++;
+    accesses.push_back(std::move(access));
+  }
+
+  Map<Var, arith::IntSet> dom_;
+  int cond_depth_{0};
+  int position_{0};
+};
+
+/*!
+ * \brief Remove the full syncs of a kernel that order no conflicting pair of
+ * shared memory accesses.
+ *
+ * For each block sync in program order the accesses since the previous sync
+ * are compared with those up to the next one, on both sides following the
+ * enclosing sequences outwards: a loop body wraps around to the iteration
+ * before or after, with the loop variable shifted, and also continues before
+ * or after the loop. A pair of accesses still needs the sync unless both
+ * read, or their bytes are disjoint for all threads, or a TMA write is read
+ * after every thread waited on the mbarrier it arrives on. Async copies
+ * completing at a cp.async wait, and mbarrier waits of only some threads,
+ * leave their data to the sync. Removed syncs no longer bound the windows of
+ * the following ones.
+ */
+class SyncElider : public IRVisitorWithAnalyzer {
+public:
+  static Stmt Elide(const Stmt &body, bool verbose) {
+    SyncElider elider;
+    elider.verbose_ = verbose;
+    elider(body);
+    if (elider.removed_.empty())
+      return body;
+    std::unordered_set<const Object *> removed = elider.removed_;
+    return StmtMutatorRemove(body, removed);
+  }
+
+private:
+  /*! \brief A sequence enclosing the sync, and the child leading to it. */
+  struct Frame {
+    const SeqStmtNode *seq;
+    size_t index;
+    /*! \brief The loop whose body the sequence is, if any. */
+    const ForNode *loop;
+  };
+
+  using IRVisitorWithAnalyzer::VisitStmt_;
+
+  void VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      if (iv->thread_tag.rfind("threadIdx", 0) == 0) {
+        thread_dom_.Set(iv->var, arith::IntSet::FromRange(iv->dom));
+      }
+    }
+    IRVisitorWithAnalyzer::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const ForNode *op) final {
+    const ForNode *outer = body_loop_;
+    body_loop_ = op;
+    IRVisitorWithAnalyzer::VisitStmt_(op);
+    body_loop_ = outer;
+  }
+
+  void VisitStmt_(const IfThenElseNode *op) final {
+    const ForNode *outer = body_loop_;
+    body_loop_ = nullptr;
+    IRVisitorWithAnalyzer::VisitStmt_(op);
+    body_loop_ = outer;
+  }
+
+  void VisitStmt_(const SeqStmtNode *op) final {
+    const ForNode *loop = body_loop_;
+    body_loop_ = nullptr;
+    for (size_t i = 0; i < op->seq.size(); ++i) {
+      frames_.push_back({op, i, loop});
+      if (IsBlockSync(op->seq[i])) {
+        if (IsRedundant()) {
+          removed_.insert(op->seq[i].get());
         }
-      } else if (call->op.same_as(builtin::ptx_arrive_barrier()) ||
-                 call->op.same_as(builtin::ptx_wait_barrier())) {
-        in_mbarrier_region_ = true;
+      } else {
+        VisitStmt(op->seq[i]);
       }
+      frames_.pop_back();
     }
-    return IRMutatorWithAnalyzer::VisitStmt_(op);
-  }
-
-  Stmt VisitStmt_(const IfThenElseNode *op) final {
-    bool old_in_mbarrier = in_mbarrier_region_;
-    Stmt then_case = VisitStmt(op->then_case);
-
-    Stmt ret;
-    if (op->else_case.defined()) {
-      in_mbarrier_region_ = old_in_mbarrier;
-      Stmt else_case = VisitStmt(op->else_case.value());
-      in_mbarrier_region_ = old_in_mbarrier || in_mbarrier_region_;
-      ret = IfThenElse(VisitExpr(op->condition), then_case, else_case);
-    } else {
-      in_mbarrier_region_ = old_in_mbarrier || in_mbarrier_region_;
-      ret = IfThenElse(VisitExpr(op->condition), then_case, Stmt());
+    body_loop_ = loop;
+  }
+
+  bool IsBound(const Stmt &stmt) const {
+    return IsBlockSync(stmt) && !removed_.count(stmt.get());
+  }
+
+  /*!
+   * \brief Collect the statements of `frame` from `begin` towards `end`,
+   * returning whether a sync bounds them.
+   */
+  bool CollectRange(WindowCollector *collector, const Frame &frame, int begin,
+                    int end, int step, const Map<Var, PrimExpr> &shift) {
+    for (int i = begin; i != end; i += step) {
+      Stmt stmt = frame.seq->seq[i];
+      if (IsBound(stmt))
+        return true;
+      collector->Collect(shift.empty() ? stmt : Substitute(stmt, shift));
     }
-    return ret;
+    return false;
   }
 
-  Stmt VisitStmt_(const ForNode *op) final {
-    PostOrderVisit(tvm::ffi::GetRef<For>(op), [&](const ObjectRef &node) {
-      if (const auto *call = node.as<CallNode>()) {
-        if (call->op.same_as(create_list_of_mbarrier()) ||
-            call->op.same_as(mbarrier_wait_parity()) ||
-            call->op.same_as(builtin::ptx_arrive_barrier()) ||
-            call->op.same_as(builtin::ptx_cp_async_barrier())) {
-          im_mbarrier_for_ = true;
+  /*! \brief The window of the sync before (step -1) or after (step 1) it. */
+  WindowCollector CollectWindow(int step) {
+    WindowCollector collector(thread_dom_);
+    for (size_t level = frames_.size(); level-- > 0;) {
+      const Frame &frame = frames_[level];
+      int n = static_cast<int>(frame.seq->seq.size());
+      int index = static_cast<int>(frame.index);
+      bool bounded = step < 0 ? CollectRange(&collector, frame, index - 1, -1,
+                                             -1, {})
+                              : CollectRange(&collector, frame, index + 1, n,
+                                             1, {});
+      if (bounded)
+        return collector;
+      if (frame.loop) {
+        // The neighbouring iteration, up to the sync itself
+        Var var = frame.loop->loop_var;
+        Map<Var, PrimExpr> shift;
+        shift.Set(var, step < 0 ? var - 1 : var + 1);
+        if (step < 0) {
+          CollectRange(&collector, frame, n - 1, index, -1, shift);
+        } else {
+          CollectRange(&collector, frame, 0, index, 1, shift);
         }
       }
-    });
-    auto stmt = IRMutatorWithAnalyzer::VisitStmt_(op);
-    im_mbarrier_for_ = false;
-    return stmt;
+    }
+    return collector;
   }
 
-private:
-  bool im_mbarrier_for_;
-  bool in_mbarrier_region_;
-  const AttrStmtNode *thread_extent_{nullptr};
+  bool Disjoint(const SyncAccess &a, const SyncAccess &b) {
+    if (!a.bytes.defined() || !b.bytes.defined())
+      return false;
+    if (!a.bytes.HasLowerBound() || !a.bytes.HasUpperBound() ||
+        !b.bytes.HasLowerBound() || !b.bytes.HasUpperBound())
+      return false;
+    return analyzer_.CanProve(a.bytes.max() < b.bytes.min()) ||
+           analyzer_.CanProve(b.bytes.max() < a.bytes.min());
+  }
+
+  bool IsRedundant() {
+    WindowCollector before = CollectWindow(-1);
+    WindowCollector after = CollectWindow(1);
+    bool redundant = true;
+    if (!after.accesses.empty() && before.has_async_completion)
+      redundant = false;
+    for (const SyncAccess &b : before.accesses) {
+      for (const SyncAccess &a : after.accesses) {
+        if (!redundant)
+          break;
+        if (a.buffer != b.buffer || (!a.is_write && !b.is_write))
+          continue;
+        if (b.tma_barrier.defined() && !a.is_write) {
+          bool waited = false;
+          for (const auto &[barrier, position] : after.waits) {
+            waited |= position < a.position &&
+                      StructuralEqual()(barrier, b.tma_barrier);
+          }
+          if (waited)
+            continue;
+        }
+        if (!Disjoint(a, b))
+          redundant = false;
+      }
+    }
+    if (redundant && verbose_) {
+      const Frame &frame = frames_.back();
+      LOG(INFO) << "Removed the sync at statement " << frame.index
+                << " of a sequence of " << frame.seq->seq.size()
+                << (frame.loop ? " in the body of loop " : "")
+                << (frame.loop ? frame.loop->loop_var->name_hint : String())
+                << ": " << before.accesses.size() << " accesses before and "
+                << after.accesses.size() << " after it do not conflict";
+    }
+    return redundant;
+  }
+
+  static Stmt StmtMutatorRemove(const Stmt &body,
+                                const std::unordered_set<const Object *> &rm) {
+    class Remover : public StmtMutator {
+    public:
+      explicit Remover(const std::unordered_set<const Object *> &rm)
+          : rm_(rm) {}
+      Stmt VisitStmt_(const EvaluateNode *op) final {
+        if (rm_.count(op))
+          return Evaluate(0);
+        return StmtMutator::VisitStmt_(op);
+      }
+
+    private:
+      const std::unordered_set<const Object *> &rm_;
+    };
+    return Remover(rm)(body);
+  }
+
+  std::vector<Frame> frames_;
+  const ForNode *body_loop_{nullptr};
+  Map<Var, arith::IntSet> thread_dom_;
+  std::unordered_set<const Object *> removed_;
+  bool verbose_{false};
 };
+
+} // namespace
+
 using namespace tir::transform;
 
 namespace transform {
 
 tvm::transform::Pass EliminateStorageSyncForMBarrier() {
   auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    if (ctx->GetConfig<Bool>(kDisableSyncElision, Bool(false)).value())
+      return f;
+    bool verbose =
+        ctx->GetConfig<Bool>(kEnableSyncElisionVerbose, Bool(false)).value();
     auto *n = f.CopyOnWrite();
-    n->body = Eliminator::Substitute(n->body);
+    n->body = SyncElider::Elide(n->body, verbose);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tl.EliminateStorageSyncForMBarrier",
@@ -0,0 +1,405 @@
+/*!
+ * \file fuse_sibling_parallel_loops.cc
+ * \brief Fuse consecutive elementwise T.Parallel loops over the same tile
+ * and keep the fragments passed between them in registers.
+ *
+ * Attention and dequantization kernels chain elementwise steps over one
+ * tile, each written as its own loop:
+ *
+ *   for i, j in T.Parallel(M, N):
+ *     S_scaled[i, j] = S[i, j] * scale
+ *   for i, j in T.Parallel(M, N):
+ *     P_cast[i, j] = T.exp2(S_scaled[i, j] - m[i])
+ *   ->
+ *   for i, j in T.Parallel(M, N):
+ *     S_scaled_val = S[i, j] * scale
+ *     P_cast[i, j] = T.exp2(S_scaled_val - m[i])
+ *
+ * Every loop is a ParallelOp of its own for layout inference and is lowered
+ * into its own thread loop, so the intermediate fragments live in registers
+ * across all of them. Two loop nests fuse into one when:
+ *
+ * - they follow each other, have the same extents and no annotation, and
+ *   their bodies only store and let bind values;
+ * - a fragment written by the first is read by the second, and the second
+ *   indexes the fragments both touch like the first does, so the fused loop
+ *   has the layout either would have had;
+ * - every buffer one of them writes and the other touches is accessed at
+ *   the same indices throughout, so an iteration only depends on itself.
+ *
+ * Inside the fused loop, a fragment stored once at the top of the body,
+ * read later in it and used nowhere else becomes a let bound scalar, and its
+ * allocation is removed.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../layout/layout.h"
+#include "../op/builtin.h"
+#include "../op/utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+namespace {
+
+using VarSet = std::unordered_set<const VarNode *>;
+
+/*! \brief A nest of parallel loops and the body inside it */
+struct ParallelNest {
+  std::vector<For> loops;
+  Stmt body;
+};
+
+/*! \brief The accesses of the body of a parallel loop nest */
+class AccessCollector : public StmtExprVisitor {
+public:
+  struct Access {
+    Buffer buffer;
+    Array<PrimExpr> indices;
+    bool write;
+  };
+
+  static std::optional<std::vector<Access>> Collect(const Stmt &body) {
+    AccessCollector collector;
+    collector(body);
+    if (collector.opaque_)
+      return std::nullopt;
+    return std::move(collector.accesses_);
+  }
+
+private:
+  void VisitStmt(const Stmt &stmt) final {
+    // Only elementwise bodies fuse
+    if (!stmt->IsInstance<BufferStoreNode>() &&
+        !stmt->IsInstance<SeqStmtNode>() &&
+        !stmt->IsInstance<IfThenElseNode>() &&
+        !stmt->IsInstance<LetStmtNode>()) {
+      opaque_ = true;
+      return;
+    }
+    StmtExprVisitor::VisitStmt(stmt);
+  }
+
+  void VisitStmt_(const BufferStoreNode *op) final {
+    accesses_.push_back({op->buffer, op->indices, true});
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    accesses_.push_back({op->buffer, op->indices, false});
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode *op) final {
+    // Pointers may alias any buffer
+    if (op->dtype.is_handle())
+      opaque_ = true;
+  }
+
+  void VisitExpr_(const CallNode *op) final {
+    if (SideEffect(ffi::GetRef<Call>(op)) > CallEffectKind::kReadState)
+      opaque_ = true;
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  std::vector<Access> accesses_;
+  bool opaque_{false};
+};
+
+/*! \brief Counts the accesses of every buffer of a function */
+class UseCounter : public StmtExprVisitor {
+public:
+  std::unordered_map<const VarNode *, int> uses;
+  std::unordered_map<const VarNode *, int> stores;
+  VarSet annotated;
+
+private:
+  void VisitStmt_(const BufferStoreNode *op) final {
+    ++uses[op->buffer->data.get()];
+    ++stores[op->buffer->data.get()];
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    ++uses[op->buffer->data.get()];
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode *op) final {
+    if (op->dtype.is_handle())
+      ++uses[op];
+  }
+
+  void VisitStmt_(const BlockNode *op) final {
+    // The buffers whose layout is annotated are kept
+    if (auto layout_map = op->annotations.Get(attr::kLayoutMap)) {
+      if (auto map = layout_map->as<Map<Var, Layout>>()) {
+        for (const auto &[var, _] : map.value())
+          annotated.insert(var.get());
+      }
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+};
+
+/*! \brief Replaces the loads of a buffer with a scalar */
+class LoadReplacer : public StmtExprMutator {
+public:
+  LoadReplacer(const Buffer &buffer, const Array<PrimExpr> &indices,
+               const Var &value)
+      : buffer_(buffer), indices_(indices), value_(value) {}
+
+private:
+  PrimExpr VisitExpr_(const BufferLoadNode *op) final {
+    if (op->buffer.same_as(buffer_) &&
+        StructuralEqual()(op->indices, indices_))
+      return value_;
+    return StmtExprMutator::VisitExpr_(op);
+  }
+
+  Buffer buffer_;
+  Array<PrimExpr> indices_;
+  Var value_;
+};
+
+bool SameIndices(const Array<PrimExpr> &a, const Array<PrimExpr> &b) {
+  return StructuralEqual()(a, b);
+}
+
+} // namespace
+
+class SiblingParallelLoopFuser : public StmtExprMutator {
+public:
+  static PrimFunc Substitute(PrimFunc f) {
+    SiblingParallelLoopFuser fuser;
+    fuser.counter_(f->body);
+    f.CopyOnWrite()->body = fuser(f->body);
+    return f;
+  }
+
+private:
+  static std::optional<ParallelNest> AsParallelNest(const Stmt &stmt) {
+    ParallelNest nest;
+    Stmt body = stmt;
+    while (const auto *loop = body.as<ForNode>()) {
+      if (loop->kind != ForKind::kParallel || !is_zero(loop->min) ||
+          !loop->annotations.empty())
+        break;
+      nest.loops.push_back(ffi::GetRef<For>(loop));
+      body = loop->body;
+    }
+    if (nest.loops.empty() || body->IsInstance<ForNode>())
+      return std::nullopt;
+    nest.body = body;
+    return nest;
+  }
+
+  /*! \brief The body of b on the loop variables of a, if they fuse */
+  ffi::Optional<Stmt> FusedBody(const ParallelNest &a,
+                                const ParallelNest &b) {
+    if (a.loops.size() != b.loops.size())
+      return std::nullopt;
+    Map<Var, PrimExpr> vmap;
+    for (size_t i = 0; i < a.loops.size(); ++i) {
+      if (!analyzer_.CanProveEqual(a.loops[i]->extent, b.loops[i]->extent))
+        return std::nullopt;
+      vmap.Set(b.loops[i]->loop_var, a.loops[i]->loop_var);
+    }
+    Stmt body = tir::Substitute(b.body, vmap);
+    auto first = AccessCollector::Collect(a.body);
+    auto second = AccessCollector::Collect(body);
+    if (!first || !second)
+      return std::nullopt;
+
+    std::unordered_map<const VarNode *, std::vector<Array<PrimExpr>>> seen;
+    VarSet written;
+    for (const auto &access : *first) {
+      seen[access.buffer->data.get()].push_back(access.indices);
+      if (access.write)
+        written.insert(access.buffer->data.get());
+    }
+    bool linked = false;
+    for (const auto &access : *second) {
+      const VarNode *data = access.buffer->data.get();
+      auto it = seen.find(data);
+      if (it == seen.end())
+        continue;
+      bool fragment = IsFragmentBuffer(access.buffer);
+      if (access.write || written.count(data)) {
+        // An iteration may only depend on the same iteration of the first
+        for (const auto &indices : it->second) {
+          if (!SameIndices(indices, access.indices))
+            return std::nullopt;
+        }
+        linked |= fragment && !access.write;
+      } else if (fragment &&
+                 std::none_of(it->second.begin(), it->second.end(),
+                              [&](const Array<PrimExpr> &indices) {
+                                return SameIndices(indices, access.indices);
+                              })) {
+        // A fragment indexed otherwise may ask for another loop layout
+        return std::nullopt;
+      }
+    }
+    if (!linked)
+      return std::nullopt;
+    return body;
+  }
+
+  /*! \brief The fragment stored by stmt that can be a scalar of the loop */
+  ffi::Optional<Buffer> ScalarCandidate(const Stmt &stmt,
+                                        const Array<Stmt> &before,
+                                        const UseCounter &local) const {
+    const auto *store = stmt.as<BufferStoreNode>();
+    if (!store || !IsFragmentBuffer(store->buffer))
+      return std::nullopt;
+    const VarNode *data = store->buffer->data.get();
+    auto uses = counter_.uses.find(data);
+    auto local_uses = local.uses.find(data);
+    if (uses == counter_.uses.end() || local_uses == local.uses.end() ||
+        uses->second != local_uses->second || local.stores.at(data) != 1 ||
+        local_uses->second < 2 || counter_.annotated.count(data))
+      return std::nullopt;
+    // A read before the store would see the value of another iteration
+    for (const Stmt &prev : before) {
+      UseCounter prev_uses;
+      prev_uses(prev);
+      if (prev_uses.uses.count(data))
+        return std::nullopt;
+    }
+    return store->buffer;
+  }
+
+  Stmt Scalarize(const Array<Stmt> &stmts, const UseCounter &local) {
+    for (size_t k = 0; k < stmts.size(); ++k) {
+      Array<Stmt> before(stmts.begin(), stmts.begin() + k);
+      auto buffer = ScalarCandidate(stmts[k], before, local);
+      if (!buffer)
+        continue;
+      const auto *store = stmts[k].as<BufferStoreNode>();
+      Var value(std::string(buffer.value()->name) + "_val",
+                buffer.value()->dtype);
+      LoadReplacer replacer(buffer.value(), store->indices, value);
+      Array<Stmt> rest;
+      for (size_t i = k + 1; i < stmts.size(); ++i)
+        rest.push_back(replacer(stmts[i]));
+      // Reads of other elements keep the fragment
+      UseCounter rest_uses;
+      rest_uses(SeqStmt::Flatten(rest));
+      if (rest_uses.uses.count(buffer.value()->data.get()))
+        continue;
+      scalarized_.insert(buffer.value()->data.get());
+      before.push_back(LetStmt(value, store->value, Scalarize(rest, local)));
+      return SeqStmt::Flatten(before);
+    }
+    return SeqStmt::Flatten(stmts);
+  }
+
+  Stmt Rebuild(const ParallelNest &nest) {
+    Stmt body = nest.body;
+    UseCounter local;
+    local(body);
+    Array<Stmt> stmts;
+    if (const auto *seq = body.as<SeqStmtNode>())
+      stmts = seq->seq;
+    else
+      stmts.push_back(body);
+    body = Scalarize(stmts, local);
+    for (auto it = nest.loops.rbegin(); it != nest.loops.rend(); ++it) {
+      For loop = *it;
+      loop.CopyOnWrite()->body = body;
+      body = loop;
+    }
+    return body;
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode *op) final {
+    Array<Stmt> seq;
+    std::optional<ParallelNest> current;
+    Stmt current_stmt;
+    bool fused = false, changed = false;
+    auto flush = [&]() {
+      if (current)
+        seq.push_back(fused ? Rebuild(current.value()) : current_stmt);
+      changed |= fused;
+      current.reset();
+      fused = false;
+    };
+    for (const Stmt &stmt : op->seq) {
+      Stmt new_stmt = VisitStmt(stmt);
+      changed |= !new_stmt.same_as(stmt);
+      auto nest = AsParallelNest(new_stmt);
+      if (current && nest) {
+        if (auto body = FusedBody(current.value(), nest.value())) {
+          current->body = SeqStmt::Flatten(current->body, body.value());
+          fused = true;
+          continue;
+        }
+      }
+      flush();
+      if (nest) {
+        current = nest;
+        current_stmt = new_stmt;
+      } else {
+        seq.push_back(new_stmt);
+      }
+    }
+    flush();
+    if (!changed)
+      return ffi::GetRef<Stmt>(op);
+    return seq.size() == 1 ? seq[0] : SeqStmt(seq);
+  }
+
+  Stmt VisitStmt_(const BlockNode *op) final {
+    Block block = Downcast<Block>(StmtExprMutator::VisitStmt_(op));
+    Array<Buffer> alloc_buffers;
+    for (const Buffer &buffer : block->alloc_buffers) {
+      if (!scalarized_.count(buffer->data.get()))
+        alloc_buffers.push_back(buffer);
+    }
+    if (alloc_buffers.size() != block->alloc_buffers.size())
+      block.CopyOnWrite()->alloc_buffers = alloc_buffers;
+    return block;
+  }
+
+  arith::Analyzer analyzer_;
+  UseCounter counter_;
+  VarSet scalarized_;
+};
+
+namespace transform {
+
+using namespace tir::transform;
+
+tvm::transform::Pass FuseSiblingParallelLoops() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    if (ctx->GetConfig<Bool>(kDisableParallelLoopFusion, Bool(false)).value())
+      return f;
+    return SiblingParallelLoopFuser::Substitute(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.FuseSiblingParallelLoops", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.FuseSiblingParallelLoops",
+                        FuseSiblingParallelLoops);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
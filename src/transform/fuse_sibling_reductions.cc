@@ -0,0 +1,133 @@
+/*!
+ * \file fuse_sibling_reductions.cc
+ * \brief Fuse consecutive reductions of the same fragment along the same
+ * dimension into one reduction with several outputs.
+ *
+ * Softmax, layernorm and quantization reduce the same tile more than once,
+ * e.g. its maximum and its sum, or its sum and absolute maximum:
+ *
+ *   T.reduce_max(S, m, dim=1)
+ *   T.reduce_sum(S, l, dim=1)
+ *
+ * Lowered on their own, each reduction reads the tile in its own
+ * thread-local loop and exchanges its partials across threads through its
+ * own shuffles and, for groups wider than a warp, its own pair of barriers.
+ * The second call is appended to the arguments of the first as a sibling,
+ * (dst, reduce_type, clear), so that ReduceOp lowers both in one loop and
+ * one `tl::AllReduce<...>::run_fused` exchange.
+ *
+ * Two reductions fuse when they follow each other, read the same region of
+ * the same fragment along the same dimension and write distinct fragments
+ * of the same shape and type. The lowering falls back to one reduction
+ * after the other when layout inference gives their outputs different
+ * layouts.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../op/builtin.h"
+#include "../op/reduce.h"
+#include "../op/utils.h"
+#include "../target/utils.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+class SiblingReductionFuser : public StmtExprMutator {
+public:
+  static PrimFunc Substitute(PrimFunc f) {
+    SiblingReductionFuser fuser;
+    f.CopyOnWrite()->body = fuser(f->body);
+    return f;
+  }
+
+private:
+  static const CallNode *AsReduce(const Stmt &stmt) {
+    if (const auto *eval = stmt.as<EvaluateNode>()) {
+      const auto *call = eval->value.as<CallNode>();
+      if (call && call->op.same_as(ReduceOp::Get()) && call->args.size() >= 5)
+        return call;
+    }
+    return nullptr;
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode *op) final {
+    Array<Stmt> seq;
+    bool changed = false;
+    for (const Stmt &stmt : op->seq) {
+      Stmt new_stmt = VisitStmt(stmt);
+      changed |= !new_stmt.same_as(stmt);
+      if (!seq.empty()) {
+        if (auto fused = Fuse(seq.back(), new_stmt)) {
+          seq.Set(seq.size() - 1, fused.value());
+          changed = true;
+          continue;
+        }
+      }
+      seq.push_back(new_stmt);
+    }
+    if (!changed)
+      return ffi::GetRef<Stmt>(op);
+    return seq.size() == 1 ? seq[0] : SeqStmt(seq);
+  }
+
+  /*! \brief The reduction a with b fused into it as a sibling, if they fuse */
+  static ffi::Optional<Stmt> Fuse(const Stmt &a, const Stmt &b) {
+    const CallNode *first = AsReduce(a);
+    const CallNode *second = AsReduce(b);
+    if (!first || !second || second->args.size() != 5 ||
+        !StructuralEqual()(first->args[0], second->args[0]) ||
+        !StructuralEqual()(first->args[3], second->args[3]))
+      return std::nullopt;
+    BufferRegion src = NormalizeToBufferRegion(first->args[0]);
+    Buffer dst = NormalizeToBufferRegion(first->args[1])->buffer;
+    Buffer next_dst = NormalizeToBufferRegion(second->args[1])->buffer;
+    if (!IsFragmentBuffer(src->buffer) || !IsFragmentBuffer(dst) ||
+        !IsFragmentBuffer(next_dst) ||
+        next_dst.same_as(src->buffer) || next_dst->dtype != dst->dtype ||
+        !StructuralEqual()(next_dst->shape, dst->shape))
+      return std::nullopt;
+    // The outputs of a fused reduction are distinct
+    for (size_t i = 1; i < first->args.size(); i += (i == 1 ? 4 : 3)) {
+      if (NormalizeToBufferRegion(first->args[i])->buffer.same_as(next_dst))
+        return std::nullopt;
+    }
+    Call fused = ffi::GetRef<Call>(first);
+    auto *n = fused.CopyOnWrite();
+    n->args.push_back(second->args[1]);
+    n->args.push_back(second->args[2]);
+    n->args.push_back(second->args[4]);
+    return Evaluate(fused);
+  }
+};
+
+namespace transform {
+
+using namespace tir::transform;
+
+tvm::transform::Pass FuseSiblingReductions() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    auto target = f->GetAttr<Target>(tvm::attr::kTarget);
+    // The fused exchange is only implemented by the CUDA templates
+    if (!target || !TargetIsCuda(target.value()) ||
+        ctx->GetConfig<Bool>(kDisableReduceFusion, Bool(false)).value())
+      return f;
+    return SiblingReductionFuser::Substitute(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.FuseSiblingReductions", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.FuseSiblingReductions",
+                        FuseSiblingReductions);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
@@ -83,7 +83,8 @@ bool IsAsyncIntrinsic(const CallNode *call) {
       call->op.same_as(tma_store()) || call->op.same_as(tma_store_arrive()) ||
       call->op.same_as(tma_store_wait()) ||
       call->op.same_as(ptx_cp_async_barrier_noinc()) ||
-      call->op.same_as(ptx_wgmma_ss()) || call->op.same_as(ptx_wgmma_rs())) {
+      call->op.same_as(ptx_wgmma_ss()) || call->op.same_as(ptx_wgmma_rs()) ||
+      call->op.same_as(ptx_tcgen05_cp())) {
     return true;
   }
 
@@ -128,7 +129,11 @@ ProxyKind ProxyFromAttrValue(const ObjectRef &value) {
 }
 
 // TMA stores must be followed by the arrive/wait pair. We rewrite them as part
-// of the pass to guarantee the proper synchronization semantics.
+// of the pass to guarantee the proper synchronization semantics. Stores marked
+// with attr::kTMAStoreAsync only commit their bulk group, so that they overlap
+// with the following work; the program waits for them before it rewrites the
+// source buffer, and a final wait keeps the shared memory alive until the
+// last of them has been read.
 class TMAStoreSyncInjector : public StmtExprMutator {
 public:
   static PrimFunc Apply(PrimFunc f) {
@@ -148,16 +153,39 @@ private:
     const auto *node = mutated.as<EvaluateNode>();
     if (const auto *call = node->value.as<CallNode>()) {
       if (call->op.same_as(tma_store())) {
+        bool is_async = call->annotations.count(attr::kTMAStoreAsync);
+        has_async_store_ |= is_async;
         Array<Stmt> seq;
         seq.push_back(mutated);
         seq.push_back(
             Evaluate(Call(DataType::Handle(), tma_store_arrive(), {})));
-        seq.push_back(Evaluate(Call(DataType::Handle(), tma_store_wait(), {})));
+        if (!is_async)
+          seq.push_back(
+              Evaluate(Call(DataType::Handle(), tma_store_wait(), {})));
         return SeqStmt(std::move(seq));
       }
     }
     return mutated;
   }
+
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key != tir::attr::thread_extent ||
+        Downcast<IterVar>(op->node)->thread_tag != "threadIdx.x" ||
+        in_thread_scope_) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    in_thread_scope_ = true;
+    Stmt body = VisitStmt(op->body);
+    in_thread_scope_ = false;
+    if (has_async_store_) {
+      body = SeqStmt(
+          {body, Evaluate(Call(DataType::Handle(), tma_store_wait(), {}))});
+    }
+    return AttrStmt(op->node, op->attr_key, op->value, body);
+  }
+
+  bool in_thread_scope_{false};
+  bool has_async_store_{false};
 };
 
 // Main pass: track the proxy state while walking the IR and inject fences when
@@ -11,6 +11,7 @@
 #include <unordered_set>
 #include <utility>
 
+#include "../op/builtin.h"
 #include "support/utils.h"
 #include "tir/schedule/utils.h"
 #include "tir/transforms/ir_utils.h"
@@ -377,19 +378,36 @@ public:
       }
     }
 
-    // Step 2: Emit the pipeline prologue, body and epilogue.
-    Stmt prologue =
-        EmitImpl(pipeline_loop_->min, pipeline_loop_->min + max_stage_, true,
-                 true, false);
-    Stmt body = EmitImpl(pipeline_loop_->min + max_stage_,
-                         pipeline_loop_->min + pipeline_loop_->extent, false,
-                         false, false);
-
-    Stmt epilogue =
-        EmitImpl(pipeline_loop_->min + pipeline_loop_->extent,
-                 pipeline_loop_->min + pipeline_loop_->extent + max_stage_,
-                 true, true, true);
-    SeqStmt stmt = SeqStmt({prologue, body, epilogue});
+    // Step 2: Emit the pipeline prologue, body and epilogue. When the trip
+    // count is dynamic, dispatch at runtime between a path assuming at least
+    // max_stage_ iterations, whose prologue and epilogue only check the bound
+    // their stage can cross, and the fully predicated path, which skips the
+    // steady-state loop it never enters.
+    PrimExpr full_trip_count =
+        pipeline_loop_->extent >=
+        make_const(pipeline_loop_->extent.dtype(), max_stage_);
+    bool dispatch =
+        max_stage_ > 0 && !pipeline_loop_->extent.as<IntImmNode>() &&
+        !analyzer_.CanProve(full_trip_count) &&
+        !tvm::transform::PassContext::Current()
+             ->GetConfig<Bool>(kDisablePipelineTripCountDispatch, Bool(false))
+             .value();
+    Stmt stmt;
+    if (dispatch) {
+      std::map<int, AsyncStateGlobal> saved_async_states = async_states;
+      Stmt short_path = EmitPipeline(/*with_steady_state=*/false);
+      async_states = std::move(saved_async_states);
+      Stmt long_path;
+      {
+        With<arith::ConstraintContext> ctx(&analyzer_, full_trip_count);
+        full_trip_count_ = true;
+        long_path = EmitPipeline(/*with_steady_state=*/true);
+        full_trip_count_ = false;
+      }
+      stmt = IfThenElse(full_trip_count, long_path, short_path);
+    } else {
+      stmt = EmitPipeline(/*with_steady_state=*/true);
+    }
 
     // Step 3: Make a new block that contains new buffer allocations after
     // pipeline rewriting.
@@ -664,55 +682,73 @@ private:
         continue;
       }
 
-      // 3. Compute wait = max_g max(0, t_consumer - committed_before[g])
+      // 3. Count the commit groups allowed in flight. The groups of an async
+      // stage are committed iteration by iteration, in program order within
+      // an iteration, so the groups committed after group g of producer
+      // iteration t_consumer are, for each group g' of the stage, those of
+      // the iterations in (t_consumer, committed_before[g']], plus the one of
+      // t_consumer itself when g' comes after g. The wait must retire the
+      // oldest dependent group, hence the minimum over the dependent groups.
       PrimExpr t_consumer = new_blocks[i].access_index;
-      PrimExpr wait_expr = make_zero(t_consumer.dtype());
 
       PrimExpr current_head = dep_local_state.producer_head.defined()
                                   ? dep_local_state.producer_head.value()
                                   : state.producer_head;
       int consumer_order = new_blocks[i].order;
 
-      for (int g : dependent_groups) {
+      // The latest producer iteration whose group g has been committed at
+      // the consumer, undefined if none is known.
+      auto committed_before = [&](int g) -> Optional<PrimExpr> {
         const auto &group = state.commit_groups[g];
         if (group.empty())
-          continue;
+          return std::nullopt;
         int commit_order = group.back();
         bool commit_present = present_orders.count(commit_order) > 0;
-
-        PrimExpr committed_before;
+        auto commit_predicate = dep_local_state.commit_predicate;
         if (commit_present && commit_order <= consumer_order) {
           // Commit point is in this iteration and earlier than the current
           // consumer; this iteration's head is visible
-          auto commit_predicate = dep_local_state.commit_predicate;
           if (analyzer_.CanProve(!commit_predicate,
                                  arith::ProofStrength::kSymbolicBound)) {
             // it means the commit block is not executed in this iteration
-            committed_before = new_blocks[i].start - 1;
+            return new_blocks[i].start - 1;
           } else if (is_epilogue) {
-            committed_before = new_blocks[i].start - 1;
-          } else {
-            committed_before = order_to_access_index.at(commit_order);
-          }
-        } else {
-          // Commit point is later than the current consumer or not in this
-          // iteration; only the previous iteration's head is visible
-          if (dep_local_state.producer_head.defined()) {
-            auto commit_predicate = dep_local_state.commit_predicate;
-            if (analyzer_.CanProve(!commit_predicate,
-                                   arith::ProofStrength::kSymbolicBound)) {
-              committed_before = new_blocks[i].start - 1;
-            } else if (is_epilogue) {
-              committed_before = new_blocks[i].start - 1;
-            } else {
-              committed_before = current_head - 1;
-            }
+            return new_blocks[i].start - 1;
           }
+          return order_to_access_index.at(commit_order);
+        }
+        // Commit point is later than the current consumer or not in this
+        // iteration; only the previous iteration's head is visible
+        if (!dep_local_state.producer_head.defined())
+          return std::nullopt;
+        if (analyzer_.CanProve(!commit_predicate,
+                               arith::ProofStrength::kSymbolicBound) ||
+            is_epilogue) {
+          return new_blocks[i].start - 1;
         }
+        return current_head - 1;
+      };
 
-        wait_expr = analyzer_.Simplify(committed_before - t_consumer);
+      PrimExpr wait_expr;
+      for (int g : dependent_groups) {
+        if (!committed_before(g).defined()) {
+          // Nothing is known to be committed yet, wait for all of it
+          wait_expr = make_zero(t_consumer.dtype());
+          break;
+        }
+        PrimExpr in_flight = make_zero(t_consumer.dtype());
+        for (int other = 0;
+             other < static_cast<int>(state.commit_groups.size()); ++other) {
+          Optional<PrimExpr> head = committed_before(other);
+          if (!head.defined())
+            continue;
+          PrimExpr after = head.value() - t_consumer;
+          if (other > g)
+            after = after + 1;
+          in_flight = in_flight + max(after, 0);
+        }
+        wait_expr = wait_expr.defined() ? min(wait_expr, in_flight) : in_flight;
       }
-
       wait_expr = analyzer_.Simplify(wait_expr);
       dep_local_state.pending_waits.push_back({static_cast<int>(i), wait_expr});
     }
@@ -759,6 +795,25 @@ private:
     return stmts;
   }
 
+  /*!
+   * \brief Emit the prologue, the steady-state loop and the epilogue.
+   * \param with_steady_state Whether to keep the steady-state loop, which
+   * runs no iteration when the trip count is below max_stage_.
+   */
+  Stmt EmitPipeline(bool with_steady_state) {
+    const PrimExpr &min = pipeline_loop_->min;
+    const PrimExpr &extent = pipeline_loop_->extent;
+    Stmt prologue = EmitImpl(min, min + max_stage_, true, true, false);
+    // Emitted in any case since it advances the async producer heads.
+    Stmt body = EmitImpl(min + max_stage_, min + extent, false, false, false);
+    Stmt epilogue =
+        EmitImpl(min + extent, min + extent + max_stage_, true, true, true);
+    if (!with_steady_state) {
+      return SeqStmt({prologue, epilogue});
+    }
+    return SeqStmt({prologue, body, epilogue});
+  }
+
   /*!
    * \brief Emit the pipeline loop in the given range.
    * \param start The start of the range
@@ -806,10 +861,18 @@ private:
 
       PrimExpr inbound = Bool(true);
       PrimExpr skewed_loop_var = new_loop_var - stage;
-      if (need_bound_check)
-        inbound = And(
-            pipeline_loop_->min <= skewed_loop_var,
-            (skewed_loop_var < pipeline_loop_->min + pipeline_loop_->extent));
+      if (need_bound_check) {
+        PrimExpr lower = pipeline_loop_->min <= skewed_loop_var;
+        PrimExpr upper =
+            skewed_loop_var < pipeline_loop_->min + pipeline_loop_->extent;
+        // With at least max_stage_ iterations, the prologue never runs past
+        // the last iteration and the epilogue never before the first one.
+        if (full_trip_count_) {
+          inbound = is_epilogue ? upper : lower;
+        } else {
+          inbound = And(lower, upper);
+        }
+      }
 
       Block new_block = Downcast<Block>(
           PipelineBodyRewriter(buffer_data_to_buffer_, buffer_remap_,
@@ -924,6 +987,8 @@ private:
   Array<Block> ordered_stmts_;
   std::map<int, AsyncStateGlobal> async_states;
   std::vector<LetWrapper> loop_var_let_wrappers_;
+  // Whether the pipeline being emitted assumes at least max_stage_ iterations.
+  bool full_trip_count_ = false;
 };
 
 /*!
@@ -961,11 +1026,113 @@ void BuildDependencyGraph(const Array<Block> &blocks,
   }
 }
 
+/*!
+ * \brief Add L2 prefetches next to the TMA loads of a pipeline stage.
+ *
+ * Each load of iteration `i` is followed by a prefetch of the tile it loads
+ * at iteration `i + distance`, which the pipeline itself only fetches
+ * `distance` iterations later. Inside a T.Persistent loop, the last
+ * iterations prefetch the first tiles of the next work item of the CTA
+ * instead. Prefetches carry no barrier and write nothing, so they do not
+ * change the dependencies of the pipeline.
+ */
+class L2PrefetchInserter : public StmtExprMutator {
+public:
+  L2PrefetchInserter(const For &loop, int distance, Optional<For> persistent,
+                     std::unordered_map<const VarNode *, PrimExpr> let_values)
+      : loop_(loop), distance_(distance), persistent_(std::move(persistent)),
+        let_values_(std::move(let_values)) {}
+
+private:
+  Stmt VisitStmt_(const EvaluateNode *op) final {
+    const auto *call = op->value.as<CallNode>();
+    if (!call || !call->op.same_as(tma_load()) ||
+        call->annotations.count(attr::kMulticastMask) ||
+        call->annotations.count(attr::kTMAGather4)) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    Call prefetch;
+    bool is_tensor = false;
+    if (const auto *desc = call->args[0].as<CallNode>();
+        desc && IsTMADescriptorCall(desc)) {
+      // tma_load(descriptor, mbarrier, smem, coords..., eviction_policy)
+      Array<PrimExpr> args{call->args[0]};
+      for (size_t i = 3; i + 1 < call->args.size(); ++i) {
+        args.push_back(InlineLets(call->args[i]));
+      }
+      prefetch = Call(DataType::Handle(), tma_prefetch(), args);
+      is_tensor = true;
+    } else {
+      // tma_load(smem_addr, global_addr, mbarrier, bytes, eviction_policy)
+      prefetch = Call(DataType::Handle(), bulk_prefetch_l2(),
+                      {InlineLets(call->args[1]), call->args[3]});
+    }
+
+    PrimExpr end = loop_->min + loop_->extent;
+    PrimExpr ahead = loop_->loop_var + distance_;
+    Stmt next = Evaluate(Shift(prefetch, {{loop_->loop_var, ahead}}));
+    Optional<Stmt> next_item;
+    // Box coordinates past the tensor are dropped by TMA, so only tensor
+    // prefetches are safe to issue for the work item after the last one.
+    if (persistent_.defined() && is_tensor &&
+        UsesVar(prefetch, [&](const VarNode *v) {
+          return v == persistent_.value()->loop_var.get();
+        })) {
+      const Var &w = persistent_.value()->loop_var;
+      next_item = IfThenElse(
+          ahead < end + loop_->extent,
+          Evaluate(Shift(prefetch, {{loop_->loop_var, ahead - loop_->extent},
+                                    {w, w + 1}})));
+    }
+    Stmt guarded = IfThenElse(ahead < end, next, next_item);
+    return SeqStmt({GetRef<Stmt>(op), guarded});
+  }
+
+  PrimExpr InlineLets(PrimExpr expr) const {
+    // Bounded by the nesting depth of the let bindings.
+    for (size_t i = 0; i <= let_values_.size(); ++i) {
+      bool uses_let = UsesVar(expr, [&](const VarNode *v) {
+        return let_values_.count(v) > 0;
+      });
+      if (!uses_let) {
+        break;
+      }
+      expr = Substitute(expr, [&](const Var &v) -> Optional<PrimExpr> {
+        auto it = let_values_.find(v.get());
+        if (it != let_values_.end()) {
+          return it->second;
+        }
+        return std::nullopt;
+      });
+    }
+    return expr;
+  }
+
+  static PrimExpr Shift(const PrimExpr &expr,
+                        const std::vector<std::pair<Var, PrimExpr>> &vmap) {
+    Map<Var, PrimExpr> map;
+    for (const auto &[var, value] : vmap) {
+      map.Set(var, value);
+    }
+    return Substitute(expr, map);
+  }
+
+  For loop_;
+  int distance_;
+  Optional<For> persistent_;
+  std::unordered_map<const VarNode *, PrimExpr> let_values_;
+};
+
 class PipelineInjector : private StmtExprMutator {
 public:
   static Stmt Inject(const PrimFunc &func) {
     auto global_symbol = func->GetAttr<String>(tvm::attr::kGlobalSymbol);
     PipelineInjector injector(global_symbol);
+    injector.prefetch_distance_ =
+        tvm::transform::PassContext::Current()
+            ->GetConfig<Integer>(kPipelinePrefetchDistance, Integer(0))
+            .value()
+            ->value;
     for (const auto &kv : func->buffer_map) {
       const Buffer &buffer = kv.second;
       injector.buffer_data_to_buffer_.Set(buffer->data, buffer);
@@ -1024,9 +1191,23 @@ private:
     }
   }
 
+  Stmt VisitStmt_(const LetStmtNode *op) final {
+    let_values_[op->var.get()] = op->value;
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    let_values_.erase(op->var.get());
+    return stmt;
+  }
+
   Stmt VisitStmt_(const ForNode *op) final {
     // Step 1: Recursively rewrite the children first.
+    bool is_persistent = op->annotations.count(attr::kPersistentLoop);
+    if (is_persistent) {
+      persistent_loops_.push_back(GetRef<For>(op));
+    }
     For for_node = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    if (is_persistent) {
+      persistent_loops_.pop_back();
+    }
     if (!HasPipelineAnnotation(op)) {
       return for_node;
     }
@@ -1138,8 +1319,24 @@ private:
     auto f_add_child = [&](const Stmt &child) {
       original_order.push_back(MakeBlock(child, buffer_data_to_buffer_));
     };
+    auto stages = Downcast<Array<Integer>>(
+        op->annotations.at(tir::attr::software_pipeline_stage));
     for (size_t i = 0; i < pipeline_body_seq->seq.size(); i++) {
-      const Stmt &child = pipeline_body_seq->seq[i];
+      Stmt child = pipeline_body_seq->seq[i];
+      if (prefetch_distance_ > 0 && i < stages.size() &&
+          stages[i]->value == 0) {
+        std::unordered_map<const VarNode *, PrimExpr> let_values =
+            let_values_;
+        for (const auto &lw : loop_var_let_wrappers) {
+          let_values[lw.var.get()] = lw.value;
+        }
+        Optional<For> persistent;
+        if (!persistent_loops_.empty()) {
+          persistent = persistent_loops_.back();
+        }
+        child = L2PrefetchInserter(GetRef<For>(op), prefetch_distance_,
+                                   persistent, std::move(let_values))(child);
+      }
       const auto *nested_block_realize = child.as<BlockRealizeNode>();
       if (nested_block_realize && is_one(nested_block_realize->predicate) &&
           nested_block_realize->block->body->IsInstance<SeqStmtNode>()) {
@@ -1350,6 +1547,12 @@ private:
   std::unordered_set<Buffer, ObjectPtrHash, ObjectPtrEqual>
       buffers_used_in_pipeline_;
   Optional<String> global_symbol_;
+  // Iterations ahead of the pipelined TMA loads prefetched into L2, 0 if off
+  int prefetch_distance_{0};
+  // Enclosing T.Persistent wave loops, innermost last
+  std::vector<For> persistent_loops_;
+  // Bindings of the enclosing LetStmts
+  std::unordered_map<const VarNode *, PrimExpr> let_values_;
 };
 } // namespace software_pipeline
 
@@ -66,7 +66,7 @@ private:
     if (call->op.same_as(tma_load()) || call->op.same_as(tma_load_im2col())) {
       auto arg0 = call->args[0].as<Call>();
       if (call->op.same_as(tma_load()) && arg0 &&
-          !arg0.value()->op.same_as(create_tma_descriptor())) {
+          !IsTMADescriptorCall(arg0.value().get())) {
         // 1D TMA load has tvm_access_ptr of shared tensor in its args[0]
         bulk_copy_bytes = call->args[3] * loop_extents;
       } else {
@@ -166,7 +166,7 @@ private:
     if (op->op.same_as(tma_load()) || op->op.same_as(tma_load_im2col())) {
       auto arg0 = op->args[0].as<Call>();
       bool is_1d_tma_load =
-          arg0 && !arg0.value()->op.same_as(create_tma_descriptor()) &&
+          arg0 && !IsTMADescriptorCall(arg0.value().get()) &&
           op->op.same_as(tma_load());
       visited_tma_load_ = true;
       Array<PrimExpr> new_args = op->args;
@@ -513,8 +513,7 @@ private:
         // producer-only kernels where no arrive() is seen and mapping is empty.
         auto arg0 = op->args[0].as<Call>();
         bool is_1d_tma_load =
-            arg0 && !arg0.value()->op.same_as(create_tma_descriptor()) &&
-            !arg0.value()->op.same_as(create_tma_im2col_descriptor());
+            arg0 && !IsTMADescriptorCall(arg0.value().get());
         if (is_1d_tma_load && op->args.size() >= 3) {
           if (const auto *imm = op->args[2].as<IntImmNode>()) {
             Array<PrimExpr> new_args = op->args;
@@ -530,8 +529,7 @@ private:
       auto new_args = op->args;
       auto arg0 = op->args[0].as<Call>();
       auto is_1d_tma_load =
-          arg0 && !arg0.value()->op.same_as(create_tma_descriptor()) &&
-          !arg0.value()->op.same_as(create_tma_im2col_descriptor());
+          arg0 && !IsTMADescriptorCall(arg0.value().get());
       if (is_1d_tma_load) {
         new_args.Set(2, barrier_id);
       } else {
@@ -13,10 +13,14 @@
 
 #include <algorithm>
 #include <deque>
+#include <iomanip>
 #include <memory>
 #include <queue>
+#include <unordered_set>
 
+#include "../layout/bank_conflict.h"
 #include "../layout/utils.h"
+#include "../op/builtin.h"
 #include "../op/copy.h"
 #include "../op/parallel.h"
 #include "../op/region.h"
@@ -26,6 +30,7 @@
 #include "arith/ir_mutator_with_analyzer.h"
 #include "arith/ir_visitor_with_analyzer.h"
 #include "common/loop_fusion_utils.h"
+#include "common/proof_cache.h"
 #include "common/union_find.h"
 #include "layout_reducer.h"
 #include "parallel_loop_layout_validator.h"
@@ -197,9 +202,22 @@ public:
                 dst_layout->InputShape()[i] - src_layout->InputShape()[i])));
             inner_analyzer.Bind(x, Range(0, dst_layout->InputShape()[i]));
           }
-          if (ProveFragmentContains(src_layout, dst_layout, indices, indices,
-                                    inner_analyzer)) {
+          // inner_analyzer only knows the placeholder ranges, which are
+          // part of the layouts.
+          bool contains = ProofCache::Prove({src_layout, dst_layout}, [&]() {
+            return ProveFragmentContains(src_layout, dst_layout, indices,
+                                         indices, inner_analyzer);
+          });
+          if (contains) {
             layout_map.Set(buffer, layout);
+            // The users are not re-enqueued for a widened layout, but they
+            // must not count as up to date in the free mode search either.
+            if (!free_visited_.empty() && use_list_.count(buffer)) {
+              for (int idx : use_list_[buffer]) {
+                if (idx != cur_infer_id)
+                  free_visited_[idx] = false;
+              }
+            }
             // Propagate to alias buffers as well
             propagate_alias(buffer, layout);
             continue;
@@ -258,6 +276,9 @@ public:
       in_queue[cur_infer_id] = false;
       RunInferStep(cur_infer_id, level, true, layout_map, strict_layout_map, q,
                    in_queue);
+      if (!free_visited_.empty()) {
+        free_visited_[cur_infer_id] = true;
+      }
     }
   };
 
@@ -383,6 +404,9 @@ public:
       }
     }
 
+    // step 5: swizzle the shared buffers no operator laid out
+    InferSharedSwizzle(layout_map);
+
     // Collect layout info for For nodes
     Map<For, Fragment> for_map;
     Map<For, PrimExpr> predicate_map;
@@ -414,6 +438,160 @@ public:
     return {layout_map, for_map, predicate_map};
   }
 
+  /*!
+   * \brief Estimate the bank conflicts of the shared buffers, and swizzle the
+   * ones no operator laid out when tl.enable_shared_swizzle_inference is set.
+   *
+   * The accesses of parallel loops and SIMT copies are evaluated through their
+   * loop layouts; shared operands of other operators (e.g. GEMM) are modeled
+   * as ldmatrix reads in the report. Buffers addressed by other operators or
+   * through raw pointers, and aliased buffers, keep their layout. A swizzle is
+   * only taken when it issues strictly fewer wavefronts than the linear
+   * layout; the candidates are the bank swizzles TMA also supports.
+   */
+  void InferSharedSwizzle(LayoutMap &layout_map) {
+    auto ctxt = tvm::transform::PassContext::Current();
+    bool enable =
+        ctxt->GetConfig<Bool>(kEnableSharedSwizzleInference, Bool(false))
+            .value();
+    bool report =
+        ctxt->GetConfig<Bool>(kEnableBankConflictReport, Bool(false)).value();
+    if ((!enable && !report) ||
+        !(TargetIsCuda(target_) || TargetIsRocm(target_)))
+      return;
+
+    struct SharedAccess {
+      Array<PrimExpr> indices;
+      For root;
+      Fragment loop_layout;
+    };
+    std::unordered_map<Buffer, std::vector<SharedAccess>, ObjectPtrHash,
+                       ObjectPtrEqual>
+        accesses;
+    std::vector<Buffer> accessed; // In program order, for the report
+    std::unordered_set<const VarNode *> pinned;
+    auto record = [&](const ParallelOpNode *par) {
+      if (!par->GetLoopLayout().defined())
+        return;
+      for (const auto &[buffer, indices] : par->GetIndiceMap()) {
+        if (!IsSharedBuffer(buffer))
+          continue;
+        if (!accesses.count(buffer))
+          accessed.push_back(buffer);
+        accesses[buffer].push_back(
+            {indices, par->GetRoot(), par->GetLoopLayout()});
+      }
+    };
+    std::unordered_set<const Object *> nodes_in_tileops;
+    for (size_t i = 0; i < infer_list_.size(); ++i) {
+      PostOrderVisit(infer_list_stmt_[i], [&](const ObjectRef &node) {
+        nodes_in_tileops.insert(node.get());
+      });
+      if (const auto *par = infer_list_[i].as<ParallelOpNode>()) {
+        record(par);
+      } else if (const auto *copy = infer_list_[i].as<CopyNode>()) {
+        if (copy->par_op_.defined())
+          record(copy->par_op_.get());
+      } else {
+        PostOrderVisit(infer_list_stmt_[i], [&](const ObjectRef &node) {
+          if (const auto *load = node.as<BufferLoadNode>()) {
+            pinned.insert(load->buffer->data.get());
+          } else if (const auto *var = node.as<VarNode>()) {
+            pinned.insert(var);
+          }
+        });
+      }
+    }
+    PostOrderVisit(func_body_, [&](const ObjectRef &node) {
+      const auto *call = node.as<CallNode>();
+      if (call == nullptr || nodes_in_tileops.count(node.get()))
+        return;
+      if (call->op.same_as(builtin::tvm_access_ptr())) {
+        if (const auto *var = call->args[1].as<VarNode>())
+          pinned.insert(var);
+      } else if (call->op.same_as(builtin::address_of())) {
+        if (const auto *load = call->args[0].as<BufferLoadNode>())
+          pinned.insert(load->buffer->data.get());
+      }
+    });
+
+    auto format = [](const BankConflictCost &cost) {
+      std::ostringstream os;
+      os << std::fixed << std::setprecision(2) << cost.Degree() << "x ("
+         << cost.wavefronts << "/" << cost.ideal << " wavefronts)";
+      return os.str();
+    };
+
+    for (const Buffer &buffer : accessed) {
+      bool has_layout = layout_map.count(buffer);
+      bool aliased = buffer_data_to_buffers_.count(buffer->data) &&
+                     buffer_data_to_buffers_[buffer->data].size() > 1;
+      bool free = !has_layout && !aliased && !pinned.count(buffer->data.get());
+      std::vector<std::pair<std::string, Layout>> candidates;
+      if (free) {
+        candidates = SharedSwizzleCandidates(buffer);
+      } else if (has_layout) {
+        candidates = {{"inferred", layout_map[buffer]}};
+      } else {
+        candidates = {{"linear", makeLinearLayout(buffer->shape)}};
+      }
+      std::vector<BankConflictCost> costs;
+      for (const auto &[_, layout] : candidates) {
+        BankConflictCost cost;
+        for (const SharedAccess &access : accesses[buffer]) {
+          cost += EstimateLoopBankConflicts(layout, buffer, access.indices,
+                                            access.root, access.loop_layout);
+        }
+        costs.push_back(cost);
+      }
+      if (!costs[0].analyzed)
+        continue;
+      size_t best = 0;
+      for (size_t i = 1; i < costs.size(); ++i) {
+        if (costs[i].wavefronts < costs[best].wavefronts)
+          best = i;
+      }
+      if (enable && best != 0) {
+        layout_map.Set(buffer, candidates[best].second);
+      }
+      if (report) {
+        std::ostringstream os;
+        os << "[BankConflict] " << buffer->name << buffer->shape << " "
+           << buffer->dtype << ":";
+        for (size_t i = 0; i < candidates.size(); ++i) {
+          os << (i ? ", " : " ") << candidates[i].first << " "
+             << format(costs[i]);
+        }
+        if (free) {
+          os << " -> "
+             << (enable ? candidates[best].first : std::string("linear"));
+        } else if (!has_layout) {
+          os << " (pinned by a tile operator or pointer access)";
+        }
+        LOG(INFO) << os.str();
+      }
+    }
+
+    if (!report)
+      return;
+    for (const auto &[var, buffers] : buffer_data_to_buffers_) {
+      for (const Buffer &buffer : buffers) {
+        if (!IsSharedBuffer(buffer) || accesses.count(buffer) ||
+            !layout_map.count(buffer))
+          continue;
+        BankConflictCost linear = EstimateLdmatrixBankConflicts(
+            makeLinearLayout(buffer->shape), buffer);
+        BankConflictCost inferred =
+            EstimateLdmatrixBankConflicts(layout_map[buffer], buffer);
+        if (!inferred.analyzed)
+          continue;
+        LOG(INFO) << "[BankConflict] " << buffer->name << buffer->shape << " "
+                  << buffer->dtype << " as ldmatrix operand: linear "
+                  << format(linear) << ", inferred " << format(inferred);
+      }
+    }
+  }
+
   void Collect(const PrimFunc &f) {
     for (const auto &[_, buffer] : f->buffer_map) {
       if (buffer_data_to_buffers_.count(buffer->data)) {
@@ -431,6 +609,7 @@ public:
     this->operator()(f->body);
     // Compute floating fragment buffers after collection
     ComputeFloatingFragmentBuffers(f->body);
+    func_body_ = f->body;
   }
 
 private:
@@ -980,17 +1159,31 @@ private:
   std::vector<bool> buffer_oob_vec_;
   Target target_;
   LayoutMap annotated_layout_map_;
+  Stmt func_body_;
   bool skip_thread_partition_{false};
+  // Operators that ran since the last update of their buffers in the current
+  // free mode attempt; empty outside of InferInFreeMode.
+  std::vector<bool> free_visited_;
 
-  std::vector<TileOperator> BackupInferList() {
+  // Clones the operators of one component; inference started from a member
+  // only reaches operators of the same component.
+  std::vector<TileOperator> BackupInferList(const std::vector<int> &members) {
     std::vector<TileOperator> back_infer_list;
-    back_infer_list.reserve(infer_list_.size());
-    for (auto &&p : infer_list_) {
-      back_infer_list.push_back(p->Clone());
+    back_infer_list.reserve(members.size());
+    for (int idx : members) {
+      back_infer_list.push_back(infer_list_[idx]->Clone());
     }
     return back_infer_list;
   }
 
+  void RestoreInferList(const std::vector<int> &members,
+                        std::vector<TileOperator> &&back_infer_list) {
+    ICHECK_EQ(members.size(), back_infer_list.size());
+    for (size_t i = 0; i < members.size(); ++i) {
+      infer_list_[members[i]] = std::move(back_infer_list[i]);
+    }
+  }
+
   void InferInFreeMode(LayoutMap &layout_map,
                        const LayoutMap &strict_layout_map) {
 
@@ -1042,19 +1235,36 @@ private:
       int root = uf.Find(i);
       components[root].push_back(i);
     }
-    // Create a map from root to buffers
+    // Create a map from root to buffers, including the aliases of those
+    // buffers: an attempt only changes the layouts of these, so they suffice
+    // to rank the attempts of a component.
     std::unordered_map<int, std::vector<Buffer>> components_buffers;
     for (const auto &[buffer, infer_indices] : use_list_) {
+      if (infer_indices.empty())
+        continue;
       int root = uf.Find(infer_indices[0]);
       components_buffers[root].push_back(buffer);
     }
-    // Keep components_buffers for debug purpose
-    (void)components_buffers;
+    for (auto &[root, buffers] : components_buffers) {
+      std::unordered_set<Buffer, ObjectPtrHash, ObjectPtrEqual> seen(
+          buffers.begin(), buffers.end());
+      size_t num_used = buffers.size();
+      for (size_t i = 0; i < num_used; ++i) {
+        auto it = buffer_data_to_buffers_.find(buffers[i]->data);
+        if (it == buffer_data_to_buffers_.end())
+          continue;
+        for (const auto &sib : (*it).second) {
+          if (seen.insert(sib).second)
+            buffers.push_back(sib);
+        }
+      }
+    }
 
     // For each component, try each op as root, and determine the least
     // replicated one
     std::deque<int> q;
     std::vector<bool> in_queue(infer_list_.size(), false);
+    free_visited_.assign(infer_list_.size(), false);
 
     for (auto &&[root, members] : components) {
       DLOG(INFO) << "======================= processing component " << root
@@ -1069,7 +1279,7 @@ private:
         DLOG(INFO) << "----------------------- try root " << attempt_infer_root
                    << " members " << members.size() << '\n';
         // Backup the current infer_list_ state
-        auto back_infer_list = BackupInferList();
+        auto back_infer_list = BackupInferList(members);
         // Copy the current layout_map for temporary use
         LayoutMap tmp_layout_map = layout_map;
         bool do_update = true;
@@ -1077,18 +1287,21 @@ private:
           // Run inference starting from attempt_infer_root
           RunInferStep(attempt_infer_root, InferLevel::kFree, true,
                        tmp_layout_map, strict_layout_map, q, in_queue);
+          free_visited_[attempt_infer_root] = true;
           FinishInferQueue(InferLevel::kFree, tmp_layout_map, strict_layout_map,
                            q, in_queue);
 
           // After the first search, run inference for all other members in
-          // order
+          // order. Members already visited by this attempt are up to date:
+          // the queue is drained, so they ran after their last buffer update.
           for (int other_infer_root : members) {
-            if (other_infer_root != attempt_infer_root) {
-              RunInferStep(other_infer_root, InferLevel::kFree, true,
-                           tmp_layout_map, strict_layout_map, q, in_queue);
-              FinishInferQueue(InferLevel::kFree, tmp_layout_map,
-                               strict_layout_map, q, in_queue);
-            }
+            if (free_visited_[other_infer_root])
+              continue;
+            RunInferStep(other_infer_root, InferLevel::kFree, true,
+                         tmp_layout_map, strict_layout_map, q, in_queue);
+            free_visited_[other_infer_root] = true;
+            FinishInferQueue(InferLevel::kFree, tmp_layout_map,
+                             strict_layout_map, q, in_queue);
           }
         } catch (const LayoutConflictException &e) {
           do_update = false;
@@ -1104,11 +1317,22 @@ private:
                      << e.what() << '\n';
         }
 
+        // Reset the worklist for the next attempt; an aborted attempt may
+        // leave it non-empty.
+        for (int idx : members) {
+          free_visited_[idx] = false;
+          in_queue[idx] = false;
+        }
+        q.clear();
+
         if (do_update) {
           // Compute the total register number for this layout
           int64_t reg_num = 0;
-          for (const auto &[buffer, layout] : tmp_layout_map) {
-            if (auto frag = layout.as<Fragment>()) {
+          for (const auto &buffer : components_buffers[root]) {
+            auto layout = tmp_layout_map.Get(buffer);
+            if (!layout.defined())
+              continue;
+            if (auto frag = layout.value().as<Fragment>()) {
               int64_t frag_reg_num = 1;
               for (auto i : frag.value()->OutputShape()) {
                 auto pci = as_const_int(i);
@@ -1128,23 +1352,24 @@ private:
           if (reg_num < min_reg_num ||
               (reg_num == min_reg_num &&
                attempt_infer_root < min_reg_num_infer_root)) {
-            best_infer_list =
-                BackupInferList(); // Use backup to avoid moving out infer_list_
+            best_infer_list = BackupInferList(
+                members); // Use backup to avoid moving out infer_list_
             best_layout_map = tmp_layout_map;
             min_reg_num = reg_num;
             min_reg_num_infer_root = attempt_infer_root;
           }
         }
         // Restore infer_list_ state for the next attempt
-        infer_list_ = std::move(back_infer_list);
+        RestoreInferList(members, std::move(back_infer_list));
       }
       ICHECK(min_reg_num < INT64_MAX) << "no available layout found" << '\n';
       // Apply the best plan for this component
-      infer_list_ = std::move(best_infer_list);
+      RestoreInferList(members, std::move(best_infer_list));
       layout_map = best_layout_map;
       DLOG(INFO) << "[InferInFreeMode] Final selection is attempt_infer_root = "
                  << min_reg_num_infer_root << '\n';
     }
+    free_visited_.clear();
   }
 };
 
@@ -1156,6 +1381,9 @@ public:
     fptr->body = ParallelLoopFuser::Fuse(f->body);
     BufferUseDefCollector collector(skip_thread_partition);
     collector.Collect(f);
+    // Operators sharing a buffer invert the same fragments over and over.
+    LayoutMemoScope memo_scope;
+    ProofCache::Scope proof_scope;
     auto result = collector.Run();
     LayoutInferencer substituter(result, &analyzer);
     fptr->body = substituter.VisitStmt(f->body);
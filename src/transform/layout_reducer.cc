@@ -29,8 +29,10 @@ using arith::IRMutatorWithAnalyzer;
  * @brief Construct a ReducerInfoNode from textual op and replication
  * descriptors.
  *
- * Maps op_str to a ReducerOpType ("sum" → SUM, "max" → MAX, "min" → MIN) and
- * rep_str to a ReducerRepType ("all" → ALL, "none" → NONE).
+ * Maps op_str to a ReducerOpType ("sum" → SUM, "max" → MAX, "min" → MIN,
+ * "prod" → PROD, "absmax" → ABSMAX, "bitand" → BITAND, "bitor" → BITOR,
+ * "bitxor" → BITXOR, "argmax" → ARGMAX, "argmin" → ARGMIN) and rep_str to a
+ * ReducerRepType ("all" → ALL, "none" → NONE).
  *
  * @param op_str String identifying the reducer operation.
  * @param rep_str String identifying the replication behavior.
@@ -44,6 +46,20 @@ ReducerInfoNode::ReducerInfoNode(const String &op_str, const String &rep_str) {
     op = ReducerOpType::MAX;
   else if (op_str == "min")
     op = ReducerOpType::MIN;
+  else if (op_str == "prod")
+    op = ReducerOpType::PROD;
+  else if (op_str == "absmax")
+    op = ReducerOpType::ABSMAX;
+  else if (op_str == "bitand")
+    op = ReducerOpType::BITAND;
+  else if (op_str == "bitor")
+    op = ReducerOpType::BITOR;
+  else if (op_str == "bitxor")
+    op = ReducerOpType::BITXOR;
+  else if (op_str == "argmax")
+    op = ReducerOpType::ARGMAX;
+  else if (op_str == "argmin")
+    op = ReducerOpType::ARGMIN;
   else
     ICHECK(false) << "Unrecognized reducer_info op: " << op_str;
 
@@ -253,7 +269,8 @@ private:
    * records their reducer metadata in inside_reducer_range_ until the matching
    * T.finalize_reducer is seen. When a FinalizeReducerOp call is encountered,
    * this method appends the reducer operation enum value to the call arguments
-   * and removes the corresponding entry from inside_reducer_range_.
+   * and removes the entries of the reducer, and of the index paired with an
+   * argmax/argmin reducer, from inside_reducer_range_.
    *
    * Side effects:
    * - Inserts and removes entries in inside_reducer_range_.
@@ -313,27 +330,42 @@ private:
         }
       }
     } else if (op->op.same_as(FinalizeReducerOp::Get())) {
-      ICHECK(op->args.size() == 1);
-      Var var;
-      if (auto bl = op->args[0].as<BufferLoadNode>()) {
-        var = bl->buffer->data;
-      } else if (auto reg_call = op->args[0].as<Call>()) {
-        if (reg_call.value()->op.same_as(RegionOp::Get())) {
-          if (auto bl2 = reg_call.value()->args[0].as<BufferLoadNode>()) {
-            var = bl2->buffer->data;
-          } else {
-            LOG(FATAL) << "tl.region expects BufferLoad as first arg";
+      // The reducer, then the index paired with an argmax/argmin reducer
+      ICHECK(op->args.size() == 1 || op->args.size() == 2);
+      auto get_var = [](const PrimExpr &arg) -> Var {
+        if (auto bl = arg.as<BufferLoadNode>()) {
+          return bl->buffer->data;
+        }
+        if (auto reg_call = arg.as<Call>()) {
+          if (reg_call.value()->op.same_as(RegionOp::Get())) {
+            auto bl2 = reg_call.value()->args[0].as<BufferLoadNode>();
+            if (!bl2) {
+              LOG(FATAL) << "tl.region expects BufferLoad as first arg";
+            }
+            return bl2->buffer->data;
           }
-        } else {
-          var = GetVarFromAccessPtr(op->args[0]);
         }
-      } else {
-        var = GetVarFromAccessPtr(op->args[0]);
-      }
+        return GetVarFromAccessPtr(arg);
+      };
+      Var var = get_var(op->args[0]);
       ICHECK(inside_reducer_range_.count(var) == 1)
           << "T.finalize_reducer must have a pairing T.fill ahead of it, "
              "enclosing a reduction range.";
-      op->args.push_back((int)inside_reducer_range_.Get(var).value()->op);
+      ReducerOpType reducer_op = inside_reducer_range_.Get(var).value()->op;
+      bool is_arg = reducer_op == ReducerOpType::ARGMAX ||
+                    reducer_op == ReducerOpType::ARGMIN;
+      ICHECK_EQ(is_arg, op->args.size() == 2)
+          << "T.finalize_reducer takes the index of an argmax or argmin "
+             "reducer, and only of those.";
+      if (is_arg) {
+        Var index = get_var(op->args[1]);
+        ICHECK(inside_reducer_range_.count(index) == 1 &&
+               inside_reducer_range_.Get(index).value()->op == reducer_op)
+            << "The index of an argmax or argmin reducer must be its "
+               "paired index reducer, filled ahead of the reduction range.";
+        inside_reducer_range_.erase(index);
+      }
+      op->args.push_back((int)reducer_op);
       inside_reducer_range_.erase(var);
     }
     return op_ref;
@@ -13,9 +13,14 @@ namespace tvm {
 /**
  * Types of reduction operations supported by TL transforms.
  *
- * SUM   - arithmetic sum reduction.
- * MAX   - elementwise maximum reduction.
- * MIN   - elementwise minimum reduction.
+ * SUM    - arithmetic sum reduction.
+ * MAX    - elementwise maximum reduction.
+ * MIN    - elementwise minimum reduction.
+ * PROD   - arithmetic product reduction.
+ * ABSMAX - maximum of absolute values, the updates store absolute values.
+ * BITAND, BITOR, BITXOR - bitwise reductions of integers.
+ * ARGMAX, ARGMIN - maximum or minimum together with a paired index reducer,
+ *          ties resolve to the smallest index.
  */
 
 /**
@@ -36,7 +41,7 @@ namespace tvm {
  * Construct a ReducerInfoNode from textual identifiers.
  *
  * @param op_str  String identifier for the reduction operation (e.g., "sum",
- * "max", "min").
+ * "max", "argmax").
  * @param rep_str String identifier for the representation semantics (e.g.,
  * "all", "none").
  */
@@ -47,7 +52,7 @@ namespace tvm {
  * Constructed from string identifiers for operation and representation.
  *
  * @param op_str  String identifier for the reduction operation (e.g., "sum",
- * "max", "min").
+ * "max", "argmax").
  * @param rep_str String identifier for the representation semantics (e.g.,
  * "all", "none").
  */
@@ -57,7 +62,18 @@ namespace tvm {
  */
 namespace tl {
 
-enum class ReducerOpType { SUM, MAX, MIN };
+enum class ReducerOpType {
+  SUM,
+  MAX,
+  MIN,
+  PROD,
+  ABSMAX,
+  BITAND,
+  BITOR,
+  BITXOR,
+  ARGMAX,
+  ARGMIN
+};
 enum class ReducerRepType { ALL, NONE };
 
 struct ReducerInfoNode : Object {
@@ -230,6 +230,7 @@ private:
   bool IsAtomicOp(const Op &op) {
     return op == atomic_add_elem_op() || op == atomic_add_ret_elem_op() ||
            op == atomic_addx2_elem_op() || op == atomic_addx4_elem_op() ||
+           op == atomic_addx8_elem_op() ||
            op == atomic_load_elem_op() || op == atomic_store_elem_op() ||
            op == atomic_max_elem_op() || op == atomic_max_ret_elem_op() ||
            op == atomic_min_elem_op() || op == atomic_min_ret_elem_op();
@@ -264,6 +265,16 @@ private:
     return evaluate;
   }
 
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::tilelang_assume) {
+      // Accesses proven in bounds under the user assumptions need no guard.
+      With<arith::ConstraintContext> ctx(analyzer_,
+                                         Downcast<PrimExpr>(op->node));
+      return IRMutatorWithAnalyzer::VisitStmt_(op);
+    }
+    return IRMutatorWithAnalyzer::VisitStmt_(op);
+  }
+
   Stmt VisitStmt_(const BlockNode *op) final {
     for (auto buffer : op->alloc_buffers) {
       buffer_data_to_buffer_.Set(buffer->data, buffer);
@@ -72,8 +72,9 @@ private:
     }
     // Change the loop kind from vectorized to serial
     for_node.CopyOnWrite()->kind = ForKind::kSerial;
-    // Apply vectorization transformation to the loop
-    return VectorizeLoop(for_node, analyzer_);
+    // Apply vectorization transformation to the loop, at full width for the
+    // bulk of an extent that is not a multiple of the vector width
+    return VectorizeLoopWithTail(for_node, analyzer_);
   }
 };
 
@@ -292,16 +292,19 @@ Stmt LowerParallelLoop(For loop, const Fragment &loop_layout, Var thread_var,
     result_loop = PartitionLoop(result_loop, thread_var, analyzer, loop_layout);
   }
 
-  // Step 2: Vectorize the loop (if requested)
+  // Step 2: Vectorize the loop (if requested), peeling a tail off the
+  // innermost loop rather than narrowing the vector for all of it
+  Stmt result = result_loop;
   if (should_vectorize) {
-    result_loop = VectorizeLoop(result_loop, saved_analyzer.get(), layout_map);
+    result =
+        VectorizeLoopWithTail(result_loop, saved_analyzer.get(), layout_map);
   }
   // Step 3: Wrap with predicate if provided and this is a parallel loop
   if (predicate.defined() && parallel_loop) {
-    return IfThenElse(predicate.value(), result_loop);
+    return IfThenElse(predicate.value(), result);
   }
 
-  return result_loop;
+  return result;
 }
 
 } // namespace tl
@@ -0,0 +1,330 @@
+/*!
+ * \file loop_unswitching.cc
+ * \brief Hoist the boundary predicates of a loop nest out of it, so that
+ * interior tiles run the nest without them.
+ *
+ * LegalizeSafeMemoryAccess guards each global access that may fall out of
+ * bounds, e.g. `if (bx * 128 + tx / 8 * 4 + i < M)`. Such a predicate holds
+ * for every thread and iteration of the nest when it holds at the extreme
+ * of its range, `bx * 128 + 127 < M`, which only depends on the block index
+ * and the problem size. The nest is rewritten into
+ *
+ *   if (bx * 128 + 127 < M) { nest without the predicates }
+ *   else { nest }
+ *
+ * The hoisted condition does not depend on the thread index, so every
+ * thread of a block takes the same branch. Loops of software pipelines are
+ * left alone, their planning expects the loop body as written.
+ */
+
+#include <tvm/arith/int_set.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../op/builtin.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+namespace {
+
+void SplitConjuncts(const PrimExpr &cond, std::vector<PrimExpr> *out) {
+  if (const auto *op = cond.as<AndNode>()) {
+    SplitConjuncts(op->a, out);
+    SplitConjuncts(op->b, out);
+  } else {
+    out->push_back(cond);
+  }
+}
+
+bool IsPipelined(const ForNode *op) {
+  return op->annotations.count("num_stages") ||
+         op->annotations.count("software_pipeline_stage");
+}
+
+/*!
+ * \brief Collect the predicates of a loop nest and the variables it defines.
+ */
+class NestCollector : public StmtExprVisitor {
+public:
+  std::vector<PrimExpr> conditions;
+  std::vector<const ForNode *> loops;
+  std::unordered_set<const VarNode *> defined;
+  bool unsupported{false};
+
+private:
+  void VisitStmt_(const ForNode *op) final {
+    if (IsPipelined(op)) {
+      unsupported = true;
+      return;
+    }
+    loops.push_back(op);
+    defined.insert(op->loop_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const IfThenElseNode *op) final {
+    SplitConjuncts(op->condition, &conditions);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const CallNode *op) final {
+    if (op->op.same_as(builtin::if_then_else())) {
+      SplitConjuncts(op->args[0], &conditions);
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const LetStmtNode *op) final {
+    defined.insert(op->var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const LetNode *op) final {
+    defined.insert(op->var.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const AllocateNode *op) final {
+    defined.insert(op->buffer_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BlockRealizeNode *op) final { unsupported = true; }
+
+  void VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      unsupported = true;
+      return;
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+};
+
+/*!
+ * \brief Replace the hoisted predicates of a nest with true.
+ */
+class PredicateStripper : public StmtExprMutator {
+public:
+  explicit PredicateStripper(const std::vector<PrimExpr> &hoisted)
+      : hoisted_(hoisted) {}
+
+private:
+  PrimExpr Strip(const PrimExpr &cond) {
+    std::vector<PrimExpr> conjuncts;
+    SplitConjuncts(cond, &conjuncts);
+    PrimExpr result;
+    for (const PrimExpr &c : conjuncts) {
+      bool hoisted = false;
+      for (const PrimExpr &h : hoisted_) {
+        if (ExprDeepEqual()(c, h)) {
+          hoisted = true;
+          break;
+        }
+      }
+      if (!hoisted) {
+        result = result.defined() ? And(result, c) : c;
+      }
+    }
+    return result.defined() ? result : const_true();
+  }
+
+  Stmt VisitStmt_(const IfThenElseNode *op) final {
+    auto node = Downcast<IfThenElse>(StmtExprMutator::VisitStmt_(op));
+    PrimExpr cond = Strip(node->condition);
+    if (is_one(cond)) {
+      return node->then_case;
+    }
+    return IfThenElse(cond, node->then_case, node->else_case);
+  }
+
+  PrimExpr VisitExpr_(const CallNode *op) final {
+    auto call = Downcast<Call>(StmtExprMutator::VisitExpr_(op));
+    if (!call->op.same_as(builtin::if_then_else())) {
+      return call;
+    }
+    PrimExpr cond = Strip(call->args[0]);
+    if (is_one(cond)) {
+      return call->args[1];
+    }
+    return if_then_else(cond, call->args[1], call->args[2]);
+  }
+
+  const std::vector<PrimExpr> &hoisted_;
+};
+
+class LoopUnswitcher : public StmtExprMutator {
+public:
+  static PrimFunc Substitute(PrimFunc f) {
+    LoopUnswitcher unswitcher;
+    f.CopyOnWrite()->body = unswitcher(f->body);
+    return f;
+  }
+
+private:
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      if (std::string(iv->thread_tag).rfind("threadIdx", 0) == 0) {
+        thread_dom_.Set(iv->var, arith::IntSet::FromRange(
+                                     Range::FromMinExtent(0, op->value)));
+      }
+    }
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const ForNode *op) final {
+    if (IsPipelined(op)) {
+      ++pipeline_depth_;
+      Stmt stmt = StmtExprMutator::VisitStmt_(op);
+      --pipeline_depth_;
+      return stmt;
+    }
+    if (pipeline_depth_ == 0) {
+      if (auto unswitched = Unswitch(tvm::ffi::GetRef<For>(op))) {
+        return unswitched.value();
+      }
+    }
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  // A condition under which the predicate holds for every thread and every
+  // iteration of the nest, undefined when its range cannot be bounded.
+  static Optional<PrimExpr> Universal(const PrimExpr &cond,
+                                      const Map<Var, arith::IntSet> &dom) {
+    auto upper = [&](const PrimExpr &a, const PrimExpr &b,
+                     bool strict) -> Optional<PrimExpr> {
+      if (!a.dtype().is_int() && !a.dtype().is_uint()) {
+        return std::nullopt;
+      }
+      // a < b for all iterations iff max(a - b) < 0
+      arith::IntSet set = arith::EvalSet(a - b, dom);
+      if (!set.HasUpperBound()) {
+        return std::nullopt;
+      }
+      PrimExpr zero = make_zero(set.max().dtype());
+      return strict ? set.max() < zero : set.max() <= zero;
+    };
+    if (const auto *op = cond.as<LTNode>()) {
+      return upper(op->a, op->b, true);
+    }
+    if (const auto *op = cond.as<LENode>()) {
+      return upper(op->a, op->b, false);
+    }
+    if (const auto *op = cond.as<GTNode>()) {
+      return upper(op->b, op->a, true);
+    }
+    if (const auto *op = cond.as<GENode>()) {
+      return upper(op->b, op->a, false);
+    }
+    return std::nullopt;
+  }
+
+  Optional<Stmt> Unswitch(const For &loop) {
+    NestCollector collector;
+    collector(loop);
+    if (collector.unsupported || collector.conditions.empty()) {
+      return std::nullopt;
+    }
+    Map<Var, arith::IntSet> dom = thread_dom_;
+    for (const ForNode *op : collector.loops) {
+      auto defined_in_nest = [&](const VarNode *v) {
+        return collector.defined.count(v) > 0;
+      };
+      if (UsesVar(op->min, defined_in_nest) ||
+          UsesVar(op->extent, defined_in_nest)) {
+        return std::nullopt;
+      }
+      dom.Set(op->loop_var,
+              arith::IntSet::FromRange(Range::FromMinExtent(op->min,
+                                                            op->extent)));
+    }
+    auto varies = [&](const VarNode *v) {
+      return collector.defined.count(v) > 0 ||
+             thread_dom_.count(tvm::ffi::GetRef<Var>(v)) > 0;
+    };
+
+    arith::Analyzer analyzer;
+    std::vector<PrimExpr> hoisted;
+    PrimExpr interior;
+    for (const PrimExpr &cond : collector.conditions) {
+      if (!UsesVar(cond, varies)) {
+        continue;
+      }
+      bool reads_memory = false;
+      PostOrderVisit(cond, [&](const ObjectRef &node) {
+        if (node.as<BufferLoadNode>()) {
+          reads_memory = true;
+        }
+      });
+      if (reads_memory) {
+        continue;
+      }
+      Optional<PrimExpr> universal = Universal(cond, dom);
+      if (!universal.defined()) {
+        continue;
+      }
+      PrimExpr simplified = analyzer.Simplify(universal.value());
+      if (is_zero(simplified) || UsesVar(simplified, varies)) {
+        continue;
+      }
+      bool duplicate = false;
+      for (const PrimExpr &h : hoisted) {
+        duplicate = duplicate || ExprDeepEqual()(h, cond);
+      }
+      if (duplicate) {
+        continue;
+      }
+      hoisted.push_back(cond);
+      if (!is_one(simplified)) {
+        interior = interior.defined() ? And(interior, simplified) : simplified;
+      }
+    }
+    if (hoisted.empty()) {
+      return std::nullopt;
+    }
+    Stmt fast = PredicateStripper(hoisted)(loop);
+    if (!interior.defined()) {
+      // the predicates hold everywhere, nothing is left to guard
+      return fast;
+    }
+    return Stmt(IfThenElse(interior, fast, loop));
+  }
+
+  Map<Var, arith::IntSet> thread_dom_;
+  int pipeline_depth_{0};
+};
+
+} // namespace
+
+using namespace tir::transform;
+tvm::transform::Pass LoopUnswitching() {
+  auto pass_func = [=](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    bool disabled =
+        ctx->GetConfig<Bool>(kDisableLoopUnswitching, Bool(false)).value();
+    if (disabled) {
+      return f;
+    }
+    return LoopUnswitcher::Substitute(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.LoopUnswitching", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.LoopUnswitching", LoopUnswitching);
+}
+
+} // namespace tl
+} // namespace tvm
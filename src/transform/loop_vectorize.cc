@@ -32,6 +32,7 @@
 #include "common/loop_vectorization_utils.h"
 #include "tvm/tir/analysis.h"
 #include "tvm/tir/var.h"
+#include <algorithm>
 #include <iostream>
 #include <tvm/arith/iter_affine_map.h>
 #include <tvm/tir/builtin.h>
@@ -170,8 +171,17 @@ public:
     bool disable_vectorize_256 = tl_config::Vectorize256Disabled();
     bool verbose = tl_config::VectorizePlannerVerboseEnabled();
 
-    if (TargetSupportVectorize256(Target::Current(false)) &&
-        !disable_vectorize_256 &&
+    Target target = Target::Current(false);
+    cpu_vector_bits_ = 0;
+    cpu_max_elem_bits_ = 0;
+    cpu_scalar_only_ = false;
+    if (target.defined() && TargetIsCPU(target)) {
+      // Plan against the SIMD registers of the host ISA instead of the
+      // 128/256-bit GPU memory transactions.
+      cpu_vector_bits_ = TargetGetCPUVectorBits(target);
+      vector_load_bits_max_ = initial_vector_size_ = loop_extent_vector_size_ =
+          cpu_vector_bits_;
+    } else if (TargetSupportVectorize256(target) && !disable_vectorize_256 &&
         VectorizeFindMemoryAccess::MaySupportVectorize256(node)) {
       vector_load_bits_max_ = initial_vector_size_ = loop_extent_vector_size_ =
           256;
@@ -317,6 +327,22 @@ public:
     // GCD with loop extent to ensure vector_size divides the loop extent
     vector_size_ = arith::ZeroAwareGCD(loop_extent_vector_size_, vector_size_);
 
+    if (cpu_vector_bits_ > 0) {
+      // One SIMD register of the widest element type, and at most the 16
+      // lanes of the vector types defined by the C++ backend.
+      int cpu_lanes = 1;
+      if (!cpu_scalar_only_ && cpu_max_elem_bits_ > 0) {
+        cpu_lanes = std::max(1, cpu_vector_bits_ / cpu_max_elem_bits_);
+        cpu_lanes = std::min(cpu_lanes, 16);
+      }
+      vector_size_ = arith::ZeroAwareGCD(vector_size_, cpu_lanes);
+      if (verbose) {
+        std::cerr << "  [CPU] vector_bits=" << cpu_vector_bits_
+                  << ", max_elem_bits=" << cpu_max_elem_bits_
+                  << " -> vector_size=" << vector_size_ << "\n";
+      }
+    }
+
     if (verbose) {
       std::cerr << "=== Final vector_size: " << vector_size_ << " ===" << "\n";
     }
@@ -395,14 +421,8 @@ private:
       auto buffer_load = address_of_call->args[0].as<BufferLoadNode>();
       ICHECK(buffer_load) << "address_of arg must be BufferLoad";
 
-      DataType dtype = buffer_load->buffer->dtype;
-      int vectorize_length = 1;
-      if (dtype.is_float16() || dtype.is_bfloat16()) {
-        vectorize_length = 2;
-      } else if (dtype.is_float() && dtype.bits() == 32 &&
-                 TargetHasSMVersionGE(Target::Current(false), 90)) {
-        vectorize_length = 4;
-      }
+      int vectorize_length = TargetGetAtomicAddVectorSize(
+          Target::Current(false), buffer_load->buffer->dtype);
 
       buffer_vector_infos_.push_back({Buffer(), vectorize_length, false, {}});
       return arith::IRMutatorWithAnalyzer::VisitExpr_(node);
@@ -516,6 +536,7 @@ private:
   }
 
   PrimExpr VisitExpr_(const CastNode *node) final {
+    RecordCPUElemType(node->dtype);
     int cast_vector_size = arith::ZeroAwareGCD(
         vector_load_bits_max_ / node->dtype.bits(), initial_vector_size_);
     // Record cast constraint (use empty buffer to indicate cast)
@@ -586,8 +607,20 @@ private:
     return buffer_vec_size;
   }
 
+  void RecordCPUElemType(DataType dtype) {
+    if (cpu_vector_bits_ == 0)
+      return;
+    if (!IsCPUVectorizableType(dtype.element_of())) {
+      cpu_scalar_only_ = true;
+      return;
+    }
+    cpu_max_elem_bits_ =
+        std::max(cpu_max_elem_bits_, dtype.bits() * dtype.lanes());
+  }
+
   void UpdateVectorSize(const Array<PrimExpr> &indices, const Buffer &buffer,
                         bool is_store) {
+    RecordCPUElemType(buffer->dtype);
     int buffer_vec_size = ComputeBufferVectorSize(indices, buffer, is_store);
     buffer_vector_infos_.push_back(
         {buffer, buffer_vec_size, is_store, indices});
@@ -625,6 +658,12 @@ private:
   const ForNode *inner_for_{};
   bool has_nonlocal_memory_access_ = false;
   int vector_size_ = 128;
+  // SIMD width of the CPU target in bits, 0 for other targets.
+  int cpu_vector_bits_ = 0;
+  // Widest element accessed by the loop on a CPU target.
+  int cpu_max_elem_bits_ = 0;
+  // Whether the loop touches a type the C++ backend cannot vectorize.
+  bool cpu_scalar_only_ = false;
   std::vector<BufferVectorInfo> buffer_vector_infos_;
   LayoutMap layout_map_;
 };
@@ -803,5 +842,96 @@ For VectorizeLoop(const For &loop, arith::Analyzer *analyzer,
   return Downcast<For>(rewriter(loop));
 }
 
+/*!
+ * \brief Replace the innermost loop of a nest, or change its extent.
+ */
+class InnermostLoopReplacer : public StmtMutator {
+public:
+  InnermostLoopReplacer(const ForNode *target, Optional<Stmt> replacement,
+                        Optional<PrimExpr> extent)
+      : target_(target), replacement_(std::move(replacement)),
+        extent_(std::move(extent)) {}
+
+private:
+  Stmt VisitStmt_(const ForNode *node) final {
+    if (node != target_)
+      return StmtMutator::VisitStmt_(node);
+    if (replacement_.defined())
+      return replacement_.value();
+    For loop = ffi::GetRef<For>(node);
+    loop.CopyOnWrite()->extent = extent_.value();
+    return loop;
+  }
+
+  const ForNode *target_;
+  Optional<Stmt> replacement_;
+  Optional<PrimExpr> extent_;
+};
+
+Stmt VectorizeLoopWithTail(const For &loop, arith::Analyzer *analyzer,
+                           const LayoutMap &layout_map) {
+  std::vector<const ForNode *> innermost;
+  PostOrderVisit(loop, [&](const ObjectRef &obj) {
+    const auto *node = obj.as<ForNode>();
+    if (!node)
+      return;
+    bool has_nested_for = false;
+    PostOrderVisit(node->body, [&](const ObjectRef &inner) {
+      has_nested_for |= inner.as<ForNode>() != nullptr;
+    });
+    if (!has_nested_for)
+      innermost.push_back(node);
+  });
+  int vector_size = VectorizePlanner(analyzer->Clone().get(), layout_map)
+                        .Plan(loop);
+  const auto *extent_ptr =
+      innermost.size() == 1 ? as_const_int(innermost[0]->extent) : nullptr;
+  if (!extent_ptr || !is_zero(innermost[0]->min))
+    return VectorizeLoop(loop, analyzer, layout_map, vector_size);
+  int64_t extent = *extent_ptr;
+  const ForNode *inner = innermost[0];
+
+  // The extent only limits the vector size of the loop when a wider vector
+  // still fits most of it: vectorize that bulk at full width and leave the
+  // remainder to a tail loop planned on its own.
+  for (int wide = 64; wide > vector_size; wide /= 2) {
+    int64_t bulk = extent - extent % wide;
+    if (bulk == 0 || bulk == extent)
+      continue;
+    PrimExpr bulk_extent = make_const(inner->extent.dtype(), bulk);
+    For bulk_nest = Downcast<For>(
+        InnermostLoopReplacer(inner, std::nullopt, bulk_extent)(loop));
+    int bulk_size = VectorizePlanner(analyzer->Clone().get(), layout_map)
+                        .Plan(bulk_nest);
+    if (bulk_size < wide)
+      continue;
+
+    For bulk_loop = ffi::GetRef<For>(inner);
+    bulk_loop.CopyOnWrite()->extent = bulk_extent;
+    Var tail_var = inner->loop_var.copy_with_suffix("_tail");
+    For tail_loop = ffi::GetRef<For>(inner);
+    {
+      auto *n = tail_loop.CopyOnWrite();
+      n->loop_var = tail_var;
+      n->extent = make_const(inner->extent.dtype(), extent - bulk);
+      n->body = Substitute(inner->body, {{inner->loop_var,
+                                          tail_var + bulk_extent}});
+    }
+    For tail_nest = Downcast<For>(
+        InnermostLoopReplacer(inner, tail_loop, std::nullopt)(loop));
+    int tail_size = VectorizePlanner(analyzer->Clone().get(), layout_map)
+                        .Plan(tail_nest);
+
+    Stmt bulk_vectorized = VectorizeRewriter(bulk_size)(bulk_loop);
+    Stmt tail_vectorized = tail_size > 1
+                               ? VectorizeRewriter(tail_size)(tail_loop)
+                               : Stmt(tail_loop);
+    return InnermostLoopReplacer(
+        inner, SeqStmt({bulk_vectorized, tail_vectorized}),
+        std::nullopt)(loop);
+  }
+  return VectorizeLoop(loop, analyzer, layout_map, vector_size);
+}
+
 } // namespace tl
 } // namespace tvm
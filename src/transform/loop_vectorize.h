@@ -45,6 +45,14 @@ For VectorizeLoop(const For &loop, const LayoutMap &layout_map = {},
 For VectorizeLoop(const For &loop, arith::Analyzer *analyzer,
                   const LayoutMap &layout_map = {}, int vectorize_hint = -1);
 
+/*!
+ * \brief Vectorize a loop nest, splitting its innermost loop into a bulk at
+ * full vector width and a tail when its extent is not a multiple of the
+ * vector width, instead of narrowing the vector for the whole loop.
+ */
+Stmt VectorizeLoopWithTail(const For &loop, arith::Analyzer *analyzer,
+                           const LayoutMap &layout_map = {});
+
 // Can prove expr is independent with var, i.e. the value of expr doesn't change
 // when var changes
 bool CanProveIndependent(const PrimExpr &expr, Var var,
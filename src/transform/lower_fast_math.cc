@@ -0,0 +1,171 @@
+/*!
+ * \file lower_fast_math.cc
+ * \brief Replace exp2, exp and tanh in T.fastmath regions by approximations
+ * of the special function unit whose error fits the ulp budget of the region.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../op/builtin.h"
+#include "../target/utils.h"
+#include "common/attr.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/*
+ * Maximum errors, in ulps of the result type, from the PTX ISA. The exp
+ * rewrite 2**(x * log2(e)) adds the error of rounding the product, which
+ * grows with |x| up to the overflow and underflow points of the type.
+ */
+/// ex2.approx.ftz.f32 across its full range
+constexpr int64_t kEx2F32Ulp = 2;
+/// ex2.approx.{f16,bf16}, maximum relative errors of 2^-9.9 and 2^-7
+constexpr int64_t kEx2HalfUlp = 2;
+/// tanh.approx.f32, maximum relative error of 2^-11
+constexpr int64_t kTanhF32Ulp = 1 << 13;
+/// tanh.approx.{f16,bf16}
+constexpr int64_t kTanhHalfUlp = 2;
+/// A half result computed in float32 and rounded: the float32 error is
+/// well below that rounding, except for tanh in float16 where it is 1 ulp
+constexpr int64_t kViaF32Ulp = 1;
+constexpr int64_t kTanhF16ViaF32Ulp = 2;
+/// exp(x) from ex2.approx.ftz.f32, |x| <= 89 before float32 overflows
+constexpr int64_t kExpF32Ulp = kEx2F32Ulp + 89;
+/// exp(x) from packed halves: |x| <= 18 for float16, 89 for bfloat16
+constexpr int64_t kExpF16Ulp = kEx2HalfUlp + 18;
+constexpr int64_t kExpBF16Ulp = kEx2HalfUlp + 89;
+
+class FastMathLowerer : public StmtExprMutator {
+public:
+  explicit FastMathLowerer(Target target)
+      : sm75_(target.defined() && TargetHasSMVersionGE(target, 75)),
+        sm90_(target.defined() && TargetHasSMVersionGE(target, 90)) {}
+
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key != attr::kFastMathUlp)
+      return StmtExprMutator::VisitStmt_(op);
+    int64_t ulp = Downcast<Integer>(op->value)->value;
+    int64_t outer = budget_;
+    budget_ = ulp < 0 ? std::numeric_limits<int64_t>::max() : ulp;
+    Stmt body = VisitStmt(op->body);
+    budget_ = outer;
+    return body;
+  }
+
+  PrimExpr VisitExpr_(const CallNode *op) final {
+    static const Op &exp2_op = Op::Get("tir.exp2");
+    static const Op &exp_op = Op::Get("tir.exp");
+    static const Op &tanh_op = Op::Get("tir.tanh");
+    PrimExpr expr = StmtExprMutator::VisitExpr_(op);
+    const CallNode *call = expr.as<CallNode>();
+    if (budget_ == 0 || !sm75_ || call == nullptr || call->args.size() != 1)
+      return expr;
+    DataType t = call->dtype;
+    if (!t.is_float() && !t.is_bfloat16())
+      return expr;
+    ffi::Optional<PrimExpr> fast;
+    if (call->op.same_as(exp2_op)) {
+      fast = Approximate(ex2_approx(), call->args[0], 1.0, kEx2F32Ulp,
+                         kEx2HalfUlp, kViaF32Ulp, kViaF32Ulp);
+    } else if (call->op.same_as(tanh_op)) {
+      fast = Approximate(tanh_approx(), call->args[0], 1.0, kTanhF32Ulp,
+                         kTanhHalfUlp, kTanhF16ViaF32Ulp, kViaF32Ulp);
+    } else if (call->op.same_as(exp_op)) {
+      int64_t half_ulp = t.is_float16() ? kExpF16Ulp : kExpBF16Ulp;
+      fast = Approximate(ex2_approx(), call->args[0], kLog2E, kExpF32Ulp,
+                         half_ulp, kViaF32Ulp, kViaF32Ulp);
+    }
+    return fast ? fast.value() : expr;
+  }
+
+private:
+  static constexpr double kLog2E = 1.4426950408889634;
+
+  /*!
+   * \brief `fn(x * scale)` in the most direct form whose error fits the
+   * budget: float32 natively; halves natively, packed in pairs when
+   * vectorized (bfloat16 needs sm90), or as scalars in float32.
+   */
+  ffi::Optional<PrimExpr> Approximate(const Op &fn, const PrimExpr &x,
+                                      double scale, int64_t f32_ulp,
+                                      int64_t half_ulp,
+                                      int64_t f16_via_f32_ulp,
+                                      int64_t bf16_via_f32_ulp) const {
+    DataType t = x.dtype();
+    if (t.is_float() && t.bits() == 32) {
+      if (t.lanes() == 1 && f32_ulp <= budget_)
+        return Call(t, fn, {Scale(x, scale)});
+      return std::nullopt;
+    }
+    bool is_half = (t.is_float16() || t.is_bfloat16()) &&
+                   (t.lanes() == 1 || (t.lanes() % 2 == 0 && t.lanes() <= 16));
+    if (!is_half)
+      return std::nullopt;
+    bool native = t.is_float16() || sm90_;
+    if (native && half_ulp <= budget_)
+      return Call(t, fn, {Scale(x, scale)});
+    int64_t via_f32_ulp = t.is_float16() ? f16_via_f32_ulp : bf16_via_f32_ulp;
+    if (t.lanes() == 1 && via_f32_ulp <= budget_) {
+      DataType f32 = DataType::Float(32);
+      return Cast(t, Call(f32, fn, {Scale(Cast(f32, x), scale)}));
+    }
+    return std::nullopt;
+  }
+
+  static PrimExpr Scale(const PrimExpr &x, double scale) {
+    if (scale == 1.0)
+      return x;
+    DataType t = x.dtype();
+    PrimExpr factor = FloatImm(t.element_of(), scale);
+    return x * (t.lanes() == 1 ? factor : Broadcast(factor, t.lanes()));
+  }
+
+  bool sm75_;
+  bool sm90_;
+  /// Ulp budget of the innermost T.fastmath region, 0 outside of any
+  int64_t budget_{0};
+};
+
+namespace transform {
+
+tvm::transform::Pass LowerFastMath() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    auto target = f->GetAttr<Target>(tvm::attr::kTarget);
+    // The regions are dropped on every target, and only lowered for the
+    // CUDA C++ code generator
+    Target cuda;
+    if (target && TargetIsCuda(target.value())) {
+      const auto &keys = target.value()->keys;
+      bool cutedsl = std::any_of(keys.begin(), keys.end(),
+                                 [](const ffi::String &key) {
+                                   return key == "cutedsl";
+                                 });
+      if (!cutedsl)
+        cuda = target.value();
+    }
+    FastMathLowerer lowerer(cuda);
+    Stmt body = lowerer(f->body);
+    if (!body.same_as(f->body))
+      f.CopyOnWrite()->body = body;
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.LowerFastMath", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.LowerFastMath", LowerFastMath);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
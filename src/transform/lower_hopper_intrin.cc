@@ -24,6 +24,14 @@ public:
   static PrimFunc Substitute(PrimFunc &f, bool disable_shuffle_elect) {
     PrimFuncNode *fptr = f.CopyOnWrite();
     LowerHopperIntrin substituter(disable_shuffle_elect);
+    PostOrderVisit(f->body, [&](const ObjectRef &node) {
+      if (const auto *call = node.as<CallNode>()) {
+        if (call->op.same_as(tma_load()) &&
+            call->annotations.count(attr::kMulticastMask)) {
+          substituter.has_multicast_ = true;
+        }
+      }
+    });
     fptr->body = substituter.VisitStmt(f->body);
     Map<Var, Array<PrimExpr>> init_desc_arg_map;
     // Collect prologue/epilogue statements for host-side setup/teardown
@@ -151,10 +159,7 @@ public:
             Stmt mem_fence = Evaluate(Call(
                 DataType::Handle(), tvm::tl::ptx_fence_barrier_init(), {}));
             stmt_seq.push_back(mem_fence);
-            Stmt mem_sync =
-                Evaluate(Call(DataType::Handle(), builtin::tvm_storage_sync(),
-                              {StringImm("shared")}));
-            stmt_seq.push_back(mem_sync);
+            stmt_seq.push_back(MakeBarrierInitSync());
           }
           stmt_seq.push_back(body);
 
@@ -167,6 +172,20 @@ public:
     return StmtExprMutator::VisitStmt_(op);
   }
 
+  Stmt VisitStmt_(const SeqStmtNode *op) final {
+    SeqStmt seq = Downcast<SeqStmt>(StmtExprMutator::VisitStmt_(op));
+    if (!has_multicast_)
+      return seq;
+    // Barriers initialized through T.alloc_barrier are followed by a block
+    // level sync, which must cover the cluster as well.
+    Array<Stmt> stmts = seq->seq;
+    for (size_t i = 1; i < stmts.size(); ++i) {
+      if (IsSharedSync(stmts[i]) && InitsBarrier(stmts[i - 1]))
+        stmts.Set(i, MakeBarrierInitSync());
+    }
+    return SeqStmt(stmts);
+  }
+
   PrimExpr VisitExpr_(const CallNode *call) final {
     if (call->op.same_as(create_tma_descriptor()) ||
         call->op.same_as(create_tma_im2col_descriptor())) {
@@ -200,6 +219,41 @@ public:
   }
 
 private:
+  /*!
+   * \brief The sync publishing the mbarrier initialization. Multicast loads
+   * complete transactions on the mbarriers of peer CTAs, so those must be
+   * initialized cluster-wide before any CTA issues one.
+   */
+  Stmt MakeBarrierInitSync() const {
+    if (has_multicast_)
+      return Evaluate(Call(DataType::Handle(), cluster_sync(), {}));
+    return Evaluate(Call(DataType::Handle(), builtin::tvm_storage_sync(),
+                         {StringImm("shared")}));
+  }
+
+  static bool IsSharedSync(const Stmt &stmt) {
+    const auto *eval = stmt.as<EvaluateNode>();
+    const auto *call = eval ? eval->value.as<CallNode>() : nullptr;
+    if (!call || !call->op.same_as(builtin::tvm_storage_sync()) ||
+        call->args.size() != 1)
+      return false;
+    const auto *scope = call->args[0].as<StringImmNode>();
+    return scope && scope->value == "shared";
+  }
+
+  static bool InitsBarrier(const Stmt &stmt) {
+    if (!stmt.as<IfThenElseNode>())
+      return false;
+    bool found = false;
+    PostOrderVisit(stmt, [&](const ObjectRef &node) {
+      if (const auto *call = node.as<CallNode>()) {
+        found |= call->op.same_as(builtin::ptx_init_barrier_thread_count());
+      }
+    });
+    return found;
+  }
+
+  bool has_multicast_{false};
   Array<Stmt> prefetch_calls_;
   Array<Stmt> init_mbarrier_calls_;
   std::unordered_map<Call, Var, StructuralHash, ExprDeepEqual> desc_map_;
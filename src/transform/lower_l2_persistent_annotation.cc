@@ -4,6 +4,7 @@
  */
 
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/target/target.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/stmt_functor.h>
@@ -12,6 +13,8 @@
 #include "../op/builtin.h"
 #include "../runtime/runtime.h"
 
+#include <unordered_set>
+
 namespace tvm {
 namespace tl {
 
@@ -23,9 +26,174 @@ constexpr const char *kL2PersistentMap = "l2_persistent_map";
 
 using namespace tir;
 
+/*!
+ * \brief Chooses the buffer to pin in the persisting L2 window.
+ *
+ * A CTA reading a global buffer at indices that do not depend on a blockIdx
+ * shares those lines with every CTA along that grid dimension, e.g. the A
+ * operand of a GEMM with blockIdx.x or a KV cache read by all query tiles.
+ * The reuse of a buffer is the product of the extents of the grid dimensions
+ * none of its loads depend on. A stream has a single access policy window, so
+ * the planner picks the read-only parameter with the largest reuse weighted
+ * by the bytes that fit in the persisting L2 size.
+ */
+class L2PersistentPlanner : public StmtExprVisitor {
+public:
+  static Optional<Buffer> Plan(const PrimFunc &f) {
+    L2PersistentPlanner planner;
+    for (const auto &[_, buffer] : f->buffer_map) {
+      planner.param_buffers_[buffer->data.get()] = buffer;
+    }
+    planner(f->body);
+
+    // The persisting L2 cache is at most 75% of the L2 cache.
+    int64_t persisting_bytes = -1;
+    if (auto target = f->GetAttr<Target>(tvm::attr::kTarget)) {
+      if (auto l2_size = target.value()->GetAttr<Integer>("l2_cache_size_bytes"))
+        persisting_bytes = l2_size.value()->value * 3 / 4;
+    }
+
+    Optional<Buffer> best;
+    double best_score = 0;
+    for (const auto &[data, buffer] : planner.param_buffers_) {
+      if (planner.written_.count(data) || !planner.read_vars_.count(data))
+        continue;
+      const auto &used = planner.read_vars_.at(data);
+      double reuse = 1;
+      for (const auto &[block_var, extent] : planner.block_extents_) {
+        if (!used.count(block_var))
+          reuse *= extent;
+      }
+      if (reuse <= 1)
+        continue;
+      double bytes = buffer->dtype.bytes();
+      for (const auto &dim : buffer->shape) {
+        const auto *imm = dim.as<IntImmNode>();
+        bytes = imm ? bytes * imm->value : -1;
+        if (bytes < 0)
+          break;
+      }
+      if (persisting_bytes > 0 && (bytes < 0 || bytes > persisting_bytes))
+        bytes = static_cast<double>(persisting_bytes);
+      // Unknown sizes are assumed to fill the window.
+      double score = (reuse - 1) * (bytes < 0 ? 1.0 : bytes);
+      if (score > best_score) {
+        best_score = score;
+        best = buffer;
+      }
+    }
+    return best;
+  }
+
+private:
+  void VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      const auto *extent = op->value.as<IntImmNode>();
+      if (extent && extent->value > 1 &&
+          std::string(iv->thread_tag).rfind("blockIdx", 0) == 0) {
+        block_extents_[iv->var.get()] = extent->value;
+      }
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const LetStmtNode *op) final {
+    let_values_[op->var.get()] = op->value;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const LetNode *op) final {
+    let_values_[op->var.get()] = op->value;
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode *op) final {
+    written_.insert(op->buffer->data.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    const VarNode *data = op->buffer->data.get();
+    if (param_buffers_.count(data)) {
+      auto &used = read_vars_[data];
+      for (const auto &index : op->indices)
+        CollectVars(index, &used);
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const CallNode *op) final {
+    if (op->op.same_as(builtin::tvm_access_ptr())) {
+      // Pinning only affects performance, a write through an access pointer
+      // merely disqualifies the buffer.
+      const auto *rw_mask = op->args[4].as<IntImmNode>();
+      if (const auto *data = op->args[1].as<VarNode>()) {
+        if (!rw_mask || (rw_mask->value & 2))
+          written_.insert(data);
+      }
+    } else if (op->op.same_as(tma_load()) ||
+               op->op.same_as(tma_load_im2col()) ||
+        op->op.same_as(tma_store())) {
+      // The coordinates follow the descriptor, whose global address names
+      // the buffer.
+      if (const VarNode *data = DescriptorBuffer(op->args[0])) {
+        if (op->op.same_as(tma_store())) {
+          written_.insert(data);
+        } else {
+          auto &used = read_vars_[data];
+          for (size_t i = 1; i < op->args.size(); ++i)
+            CollectVars(op->args[i], &used);
+        }
+      }
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  const VarNode *DescriptorBuffer(PrimExpr desc) const {
+    while (const auto *var = desc.as<VarNode>()) {
+      auto it = let_values_.find(var);
+      if (it == let_values_.end())
+        return nullptr;
+      desc = it->second;
+    }
+    const auto *call = desc.as<CallNode>();
+    if (!call || !call->op.same_as(create_tma_descriptor()) ||
+        call->args.size() < 3)
+      return nullptr;
+    std::unordered_set<const VarNode *> vars;
+    CollectVars(call->args[2], &vars);
+    for (const VarNode *var : vars) {
+      if (param_buffers_.count(var))
+        return var;
+    }
+    return nullptr;
+  }
+
+  // Collects the variables of expr, looking through let bindings.
+  void CollectVars(const PrimExpr &expr,
+                   std::unordered_set<const VarNode *> *vars) const {
+    PostOrderVisit(expr, [&](const ObjectRef &node) {
+      const auto *var = node.as<VarNode>();
+      if (!var || !vars->insert(var).second)
+        return;
+      auto it = let_values_.find(var);
+      if (it != let_values_.end())
+        CollectVars(it->second, vars);
+    });
+  }
+
+  std::unordered_map<const VarNode *, Buffer> param_buffers_;
+  std::unordered_map<const VarNode *, int64_t> block_extents_;
+  std::unordered_map<const VarNode *, PrimExpr> let_values_;
+  std::unordered_map<const VarNode *, std::unordered_set<const VarNode *>>
+      read_vars_;
+  std::unordered_set<const VarNode *> written_;
+};
+
 class LowerL2Persistent : public StmtExprMutator {
 public:
-  static PrimFunc Substitute(PrimFunc &f) {
+  static PrimFunc Substitute(PrimFunc &f, bool auto_plan) {
     PrimFuncNode *fptr = f.CopyOnWrite();
     LowerL2Persistent substituter;
     // Trace the buffer map for tvm_access_ptr
@@ -34,6 +202,12 @@ public:
       substituter.buffer_data_to_buffer_.Set(buffer->data, buffer);
     }
     fptr->body = substituter.VisitStmt(f->body);
+    if (auto_plan && substituter.hit_ratio_map_.empty()) {
+      if (auto buffer = L2PersistentPlanner::Plan(f)) {
+        substituter.hit_ratio_map_.Set(buffer.value(),
+                                       FloatImm(DataType::Float(32), 1.0));
+      }
+    }
     Map<String, Array<PrimExpr>> init_l2_persistent_map;
     for (auto [buffer, hit_ratio] : substituter.hit_ratio_map_) {
       Array<PrimExpr> l2_persistent_arguments;
@@ -93,7 +267,9 @@ using namespace tir::transform;
 
 tvm::transform::Pass LowerL2Persistent() {
   auto pass_func = [=](PrimFunc f, const IRModule &m, const PassContext &ctx) {
-    return LowerL2Persistent::Substitute(f);
+    bool auto_plan =
+        ctx->GetConfig<Bool>(kEnableAutoL2Persistent, Bool(false)).value();
+    return LowerL2Persistent::Substitute(f, auto_plan);
   };
   return CreatePrimFuncPass(pass_func, 0, "tl.LowerL2Persistent", {});
 }
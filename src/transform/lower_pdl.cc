@@ -16,6 +16,8 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+
 namespace tvm {
 namespace tl {
 
@@ -72,8 +74,132 @@ private:
   MarkCudaSyncCalls() = default;
 };
 
+class ContainsCall : public StmtExprVisitor {
+public:
+  static bool Find(const Stmt &stmt, const Op &op) {
+    ContainsCall visitor(op);
+    visitor(stmt);
+    return visitor.found_;
+  }
+
+private:
+  explicit ContainsCall(const Op &op) : op_(op) {}
+
+  void VisitExpr_(const tir::CallNode *op) final {
+    if (op->op.same_as(op_)) {
+      found_ = true;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  const Op &op_;
+  bool found_ = false;
+};
+
+// Collect the device kernels launched by a host function in launch order.
+class KernelLaunchOrderCollector : public StmtExprVisitor {
+public:
+  static Array<GlobalVar> Collect(const PrimFunc &host_func,
+                                  const IRModule &mod) {
+    KernelLaunchOrderCollector collector(mod);
+    collector(host_func->body);
+    return collector.kernels_;
+  }
+
+private:
+  explicit KernelLaunchOrderCollector(const IRModule &mod) : mod_(mod) {}
+
+  void VisitExpr_(const tir::CallNode *op) final {
+    if (auto gvar = op->op.as<GlobalVar>()) {
+      if (auto func = mod_->functions.Get(gvar.value())) {
+        if (func.value()->HasNonzeroAttr(tir::attr::kIsGlobalFunc) &&
+            std::find(kernels_.begin(), kernels_.end(), gvar.value()) ==
+                kernels_.end()) {
+          kernels_.push_back(gvar.value());
+        }
+      }
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  const IRModule &mod_;
+  Array<GlobalVar> kernels_;
+};
+
+// Place `stmt` right after the leading thread extent bindings of a kernel.
+Stmt InsertAfterThreadBindings(const Stmt &body, const Stmt &stmt) {
+  if (const auto *attr = body.as<AttrStmtNode>()) {
+    if (attr->attr_key == tir::attr::thread_extent) {
+      auto new_attr = tvm::ffi::GetRef<AttrStmt>(attr);
+      new_attr.CopyOnWrite()->body =
+          InsertAfterThreadBindings(attr->body, stmt);
+      return new_attr;
+    }
+  }
+  return SeqStmt::Flatten(stmt, body);
+}
+
+/*!
+ * \brief Chain consecutive kernels of one host function with PDL.
+ *
+ * Every kernel but the first waits for its predecessor with pdl_sync before
+ * touching memory, and every kernel but the last issues pdl_trigger as soon as
+ * it starts. Together with the launch attribute emitted for kernels carrying
+ * kHasGridSync this lets a kernel be scheduled while the previous one drains
+ * its last wave. Kernels that already use PDL explicitly are left alone.
+ */
+IRModule ChainCudaKernelLaunches(IRModule mod) {
+  IRModule updates = IRModule(Map<GlobalVar, BaseFunc>({}));
+  for (const auto &[gvar, base_func] : mod->functions) {
+    auto host_func = base_func.as<PrimFunc>();
+    if (!host_func ||
+        host_func.value()->HasNonzeroAttr(tir::attr::kIsGlobalFunc))
+      continue;
+    Array<GlobalVar> kernels =
+        KernelLaunchOrderCollector::Collect(host_func.value(), mod);
+    if (kernels.size() < 2)
+      continue;
+    for (size_t i = 0; i < kernels.size(); ++i) {
+      PrimFunc kernel = Downcast<PrimFunc>(mod->Lookup(kernels[i]));
+      bool has_sync = ContainsCall::Find(kernel->body, pdl_sync());
+      bool has_trigger = ContainsCall::Find(kernel->body, pdl_trigger());
+      if (has_sync || has_trigger)
+        continue;
+      Stmt body = kernel->body;
+      // __ldg cannot be combined with pdl_sync, see CheckLDGCalls.
+      if (i > 0 && !ContainsCall::Find(body, tl::__ldg())) {
+        body = InsertAfterThreadBindings(
+            body, Evaluate(Call(DataType::Void(), pdl_sync(), {})));
+      }
+      if (i + 1 < kernels.size()) {
+        body = InsertAfterThreadBindings(
+            body, Evaluate(Call(DataType::Void(), pdl_trigger(), {})));
+      }
+      if (!body.same_as(kernel->body)) {
+        kernel.CopyOnWrite()->body = body;
+        updates->Add(kernels[i], kernel);
+      }
+    }
+  }
+  mod->Update(updates);
+  return mod;
+}
+
 using namespace tir::transform;
 
+tvm::transform::Pass ChainCudaKernelLaunchesPass(bool support_pdl) {
+  auto pass_func = [=](IRModule mod, const PassContext &ctx) {
+    bool enable_chaining =
+        ctx->GetConfig<Bool>(kEnablePDLChaining, Bool(false)).value();
+    if (!support_pdl || !enable_chaining)
+      return mod;
+    return ChainCudaKernelLaunches(std::move(mod));
+  };
+
+  return tvm::transform::CreateModulePass(pass_func, 0,
+                                          "tl.ChainCudaKernelLaunches", {});
+}
+
 tvm::transform::Pass MarkCudaSyncCallsPass(bool support_pdl) {
   auto pass_func = [=](PrimFunc f, const IRModule &m, const PassContext &ctx) {
     return MarkCudaSyncCalls::Substitute(f, support_pdl);
@@ -84,8 +210,10 @@ tvm::transform::Pass MarkCudaSyncCallsPass(bool support_pdl) {
 
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("tl.transform.MarkCudaSyncCalls",
-                        MarkCudaSyncCallsPass);
+  refl::GlobalDef()
+      .def("tl.transform.MarkCudaSyncCalls", MarkCudaSyncCallsPass)
+      .def("tl.transform.ChainCudaKernelLaunches",
+           ChainCudaKernelLaunchesPass);
 }
 
 } // namespace tl
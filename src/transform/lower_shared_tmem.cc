@@ -16,15 +16,112 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <unordered_set>
+
 namespace tvm {
 namespace tl {
 
 using namespace tir;
 
+/*!
+ * \brief Columns of the tensor memory allocation given to the tmem buffers.
+ */
+struct TmemPlan {
+  /// First column of every buffer
+  std::vector<int> col_offsets;
+  /// Columns of the allocation in use, at most
+  int num_cols{0};
+  /// The buffer placed at column 0, which holds the allocation
+  int base{0};
+  /// Phases before which the columns of an earlier phase are reused
+  std::unordered_set<int> reuse_phases;
+};
+
+/*!
+ * \brief Pack the tmem buffers into the columns of one allocation.
+ *
+ * As storage_rewrite does for the other scopes, the statements of the block
+ * body are the phases of the kernel, and a buffer is live from the first to
+ * the last phase accessing it. Buffers live at once are packed side by side,
+ * in 32-column granules, rather than each rounded up to a power of two, e.g.
+ * two 192-column accumulators double buffering the MMA and the epilogue of
+ * consecutive tiles fit together. A buffer whose phases all follow those of
+ * another one reuses its columns, the larger buffers being placed first at
+ * the lowest free columns.
+ */
+static TmemPlan PlanTmemColumns(const Array<Buffer> &buffers,
+                                const std::vector<int> &num_cols,
+                                const Array<Stmt> &phases) {
+  constexpr int kColumnGranule = 32;
+  size_t n = buffers.size();
+  std::vector<int> first(n, 0), last(n, static_cast<int>(phases.size()) - 1);
+  for (size_t k = 0; k < n; ++k) {
+    const VarNode *data = buffers[k]->data.get();
+    bool seen = false;
+    for (size_t p = 0; p < phases.size(); ++p) {
+      if (!UsesVar(phases[p], [&](const VarNode *v) { return v == data; }))
+        continue;
+      if (!seen)
+        first[k] = static_cast<int>(p);
+      last[k] = static_cast<int>(p);
+      seen = true;
+    }
+  }
+  std::vector<int> widths(n);
+  for (size_t k = 0; k < n; ++k) {
+    widths[k] = (num_cols[k] + kColumnGranule - 1) / kColumnGranule *
+                kColumnGranule;
+  }
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return widths[a] > widths[b];
+  });
+
+  TmemPlan plan;
+  plan.col_offsets.assign(n, 0);
+  plan.base = static_cast<int>(order[0]);
+  std::vector<size_t> placed;
+  for (size_t k : order) {
+    auto live_together = [&](size_t other) {
+      return first[k] <= last[other] && first[other] <= last[k];
+    };
+    // Lowest offset clear of the columns of the buffers live together
+    int offset = 0;
+    bool moved = true;
+    while (moved) {
+      moved = false;
+      for (size_t other : placed) {
+        if (live_together(other) &&
+            offset < plan.col_offsets[other] + widths[other] &&
+            plan.col_offsets[other] < offset + widths[k]) {
+          offset = plan.col_offsets[other] + widths[other];
+          moved = true;
+        }
+      }
+    }
+    for (size_t other : placed) {
+      if (!live_together(other) &&
+          offset < plan.col_offsets[other] + widths[other] &&
+          plan.col_offsets[other] < offset + widths[k]) {
+        plan.reuse_phases.insert(std::max(first[k], first[other]));
+      }
+    }
+    plan.col_offsets[k] = offset;
+    plan.num_cols = std::max(plan.num_cols, offset + widths[k]);
+    placed.push_back(k);
+  }
+  return plan;
+}
+
 class SharedTmemRewriter : public StmtExprMutator {
 public:
-  static Stmt Rewrite(Stmt body) {
+  static Stmt Rewrite(Stmt body, bool use_2cta) {
     SharedTmemRewriter rewriter;
+    rewriter.use_2cta_ = use_2cta;
     return rewriter(body);
   }
 
@@ -125,13 +222,10 @@ private:
       return StmtExprMutator::VisitStmt_(op);
     }
 
-    // 3. create init & dealloc calls for new buffers
-    std::vector<Stmt> init_mtmem_calls_;
-    std::vector<Stmt> dealloc_tmem_calls_;
+    // 3. plan the columns of the buffers, a single allocation holds them all
+    std::vector<int> num_cols;
     for (auto buffer : tmem_buffers) {
-      auto data = buffer->data;
-      auto old_buffer = buffer_data_to_buffer_.at(data);
-      auto new_buffer = buffer_remap_.at(old_buffer);
+      auto old_buffer = buffer_data_to_buffer_.at(buffer->data);
 
       // Tmem physical coord range analysis
       ICHECK(old_buffer->shape.size() == 2);
@@ -144,30 +238,55 @@ private:
           << "The number of columns required for tmem buffer "
           << old_buffer->name << " is " << num_cols_required
           << ", which exceeds the maximum of 512 columns";
+      num_cols.push_back(num_cols_required);
+    }
+    Array<Stmt> phases;
+    if (const auto *seq = op->body.as<SeqStmtNode>()) {
+      phases = seq->seq;
+    } else {
+      phases.push_back(op->body);
+    }
+    TmemPlan plan = PlanTmemColumns(tmem_buffers, num_cols, phases);
+    int num_cols_allocated = 32; // Align num_cols_allocated to power of 2
+    for (; num_cols_allocated < plan.num_cols; num_cols_allocated *= 2)
+      ;
+    if (num_cols_allocated > 512) {
+      std::ostringstream os;
+      for (size_t k = 0; k < tmem_buffers.size(); ++k) {
+        os << " " << tmem_buffers[k]->name << " (" << num_cols[k]
+           << " columns)";
+      }
+      LOG(FATAL) << "The tmem buffers" << os.str() << " need "
+                 << plan.num_cols
+                 << " columns at once, which exceeds the maximum of 512";
+    }
 
-      int num_cols_allocated = 32; // Align num_cols_allocated to power of 2
-      for (; num_cols_allocated < num_cols_required; num_cols_allocated *= 2)
-        ;
-
-      auto new_buffer_access = new_buffer.access_ptr(1, DataType::Handle(), 1,
-                                                     PrimExpr(0), PrimExpr(1));
-      auto alloc_call = Call(DataType::Handle(), tl::ptx_init_tensor_memory(),
-                             {new_buffer_access, PrimExpr(num_cols_allocated)});
-      init_mtmem_calls_.push_back(Evaluate(alloc_call));
-      auto dealloc_call =
-          Call(DataType::Handle(), tl::ptx_deallocate_tensor_memory(),
-               {new_buffer_access, PrimExpr(num_cols_allocated)});
-      dealloc_tmem_calls_.push_back(Evaluate(dealloc_call));
+    // 4. create init & dealloc calls for the allocation, which the buffer at
+    // column 0 holds, and publish the addresses of the other buffers
+    Buffer base = buffer_remap_.at(tmem_buffers[plan.base]);
+    auto base_access =
+        base.access_ptr(1, DataType::Handle(), 1, PrimExpr(0), PrimExpr(1));
+    // All the tcgen05 instructions of a kernel share their cta_group, the
+    // allocations of a 2-CTA kernel are made for the CTA pair.
+    Map<String, ObjectRef> cta_group_annotations;
+    if (use_2cta_)
+      cta_group_annotations.Set(attr::kCtaGroup, Integer(2));
+    auto alloc_call = Call(DataType::Handle(), tl::ptx_init_tensor_memory(),
+                           {base_access, PrimExpr(num_cols_allocated)},
+                           cta_group_annotations);
+    auto dealloc_call =
+        Call(DataType::Handle(), tl::ptx_deallocate_tensor_memory(),
+             {base_access, PrimExpr(num_cols_allocated)},
+             cta_group_annotations);
+    Array<Stmt> publish_addrs;
+    for (size_t k = 0; k < tmem_buffers.size(); ++k) {
+      if (static_cast<int>(k) == plan.base)
+        continue;
+      Buffer slot = buffer_remap_.at(tmem_buffers[k]);
+      PrimExpr addr = BufferLoad(base, {0}) +
+                      make_const(tmem_dtype_, plan.col_offsets[k]);
+      publish_addrs.push_back(BufferStore(slot, addr, {0}));
     }
-    auto compare_by_buffer_name = [&](const Stmt &a, const Stmt &b) {
-      auto call_a = a.as<EvaluateNode>()->value.as<CallNode>();
-      auto call_b = b.as<EvaluateNode>()->value.as<CallNode>();
-      auto num_cols_a = call_a->args[1].as<IntImmNode>()->value;
-      auto num_cols_b = call_b->args[1].as<IntImmNode>()->value;
-      return num_cols_a > num_cols_b;
-    };
-    std::sort(init_mtmem_calls_.begin(), init_mtmem_calls_.end(),
-              compare_by_buffer_name);
 
     Array<Stmt> new_body;
     auto target = Target::Current();
@@ -175,19 +294,37 @@ private:
     auto thread_var_div_warp_size =
         FloorDiv(thread_var_->var, IntImm(thread_var_->var->dtype, warp_size));
     new_body.push_back(IfThenElse(EQ(thread_var_div_warp_size, 0),
-                                  init_mtmem_calls_.size() > 1
-                                      ? SeqStmt(init_mtmem_calls_)
-                                      : init_mtmem_calls_.back(),
-                                  Stmt()));
-    new_body.push_back(
-        Evaluate(Call(DataType::Handle(), builtin::tvm_storage_sync(),
-                      {StringImm("shared")})));
-    new_body.push_back(block->body);
+                                  Evaluate(alloc_call), Stmt()));
+    new_body.push_back(MakeAllocSync());
+    if (!publish_addrs.empty()) {
+      new_body.push_back(
+          IfThenElse(EQ(thread_var_->var, 0),
+                     publish_addrs.size() > 1 ? SeqStmt(publish_addrs)
+                                              : publish_addrs.back(),
+                     Stmt()));
+      new_body.push_back(Evaluate(Call(DataType::Handle(),
+                                       builtin::tvm_storage_sync(),
+                                       {StringImm("shared")})));
+    }
+    if (plan.reuse_phases.empty()) {
+      new_body.push_back(block->body);
+    } else {
+      // The columns a buffer reuses are no longer accessed by the phases
+      // before it, whose tcgen05 operations complete before the barrier.
+      for (size_t p = 0; p < phases.size(); ++p) {
+        if (plan.reuse_phases.count(static_cast<int>(p))) {
+          new_body.push_back(MakeTmemReuseSync());
+        }
+        new_body.push_back(phases[p]);
+      }
+    }
+    if (use_2cta_) {
+      // Both CTAs of the pair share the allocation, release it once neither
+      // CTA reads its accumulator anymore.
+      new_body.push_back(MakeAllocSync());
+    }
     new_body.push_back(IfThenElse(EQ(thread_var_div_warp_size, 0),
-                                  dealloc_tmem_calls_.size() > 1
-                                      ? SeqStmt(dealloc_tmem_calls_)
-                                      : dealloc_tmem_calls_.back(),
-                                  Stmt()));
+                                  Evaluate(dealloc_call), Stmt()));
 
     auto block_ptr = block.CopyOnWrite();
     block_ptr->annotations.erase(attr::kLayoutMap);
@@ -196,6 +333,32 @@ private:
     return StmtExprMutator::VisitStmt_(block.get());
   }
 
+  /*!
+   * \brief The sync publishing the tensor memory address. The 2-CTA MMAs of
+   * the even CTA of a pair write the tensor memory of the odd one, so the
+   * allocation must be complete cluster-wide.
+   */
+  Stmt MakeAllocSync() const {
+    if (use_2cta_)
+      return Evaluate(Call(DataType::Handle(), cluster_sync(), {}));
+    return Evaluate(Call(DataType::Handle(), builtin::tvm_storage_sync(),
+                         {StringImm("shared")}));
+  }
+
+  /*!
+   * \brief The barrier before a phase reusing the columns of an earlier one,
+   * fenced so that the tcgen05 operations of the earlier phase are ordered
+   * before those issued after the barrier.
+   */
+  Stmt MakeTmemReuseSync() const {
+    auto fence = [](const char *name) {
+      return Evaluate(Call(DataType::Handle(), builtin::call_extern(),
+                           {StringImm(name)}));
+    };
+    return SeqStmt({fence("tl::tcgen05_before_thread_sync"), MakeAllocSync(),
+                    fence("tl::tcgen05_after_thread_sync")});
+  }
+
   PrimExpr GetTmemOffset(const Buffer &buffer, const Array<PrimExpr> &indices) {
     ICHECK(buffer->shape.size() == 2);
     ICHECK(indices.size() == 2);
@@ -282,6 +445,8 @@ private:
 
   // Datatypes for tmem
   const DataType tmem_dtype_ = DataType::UInt(32);
+  // Whether the kernel issues 2-CTA tcgen05 MMAs
+  bool use_2cta_ = false;
   // This is a workaround for cpu backend,
   // we need to define a thread_var for the serial loop.
   IterVar thread_var_;
@@ -296,8 +461,39 @@ private:
 PrimFunc LowerSharedTmem(PrimFunc f) {
   auto target = f->GetAttr<Target>(tvm::attr::kTarget);
   ICHECK(target.defined()) << "LowerSharedTmem: Require the target attribute";
-  SharedTmemRewriter rewriter;
-  f.CopyOnWrite()->body = rewriter.Rewrite(f->body);
+  bool has_1cta_mma = false, has_2cta_mma = false;
+  int64_t cluster_size = 1;
+  PostOrderVisit(f->body, [&](const ObjectRef &node) {
+    if (const auto *call = node.as<CallNode>()) {
+      if (call->op.same_as(ptx_tcgen05_mma_ss()) ||
+          call->op.same_as(ptx_tcgen05_mma_ts())) {
+        bool is_2cta = call->annotations.count(attr::kCtaGroup) &&
+                       Downcast<Integer>(call->annotations.at(
+                           attr::kCtaGroup))->value == 2;
+        (is_2cta ? has_2cta_mma : has_1cta_mma) = true;
+      }
+    } else if (const auto *attr = node.as<AttrStmtNode>()) {
+      if (attr->attr_key == attr::kClusterDims) {
+        if (const auto *dims = attr->value.as<StringImmNode>()) {
+          std::istringstream ss(dims->value);
+          std::string dim;
+          while (std::getline(ss, dim, ','))
+            cluster_size *= std::stoll(dim);
+        }
+      }
+    }
+  });
+  if (has_2cta_mma) {
+    ICHECK(!has_1cta_mma)
+        << "LowerSharedTmem: a kernel cannot mix 2-CTA and single CTA "
+           "tcgen05 MMAs, all its tcgen05 instructions share the cta_group";
+    ICHECK(cluster_size % 2 == 0)
+        << "LowerSharedTmem: 2-CTA tcgen05 MMAs run on the CTA pairs of a "
+           "cluster, launch the kernel with T.Kernel(..., cluster_dims=...) "
+           "of an even size, got a cluster of "
+        << cluster_size << " CTAs";
+  }
+  f.CopyOnWrite()->body = SharedTmemRewriter::Rewrite(f->body, has_2cta_mma);
   return f;
 }
 
@@ -32,6 +32,7 @@
 #include <unordered_set>
 #include <utility>
 
+#include "../target/utils.h"
 #include "runtime/thread_storage_scope.h"
 #include "tir/transforms/ir_utils.h"
 #include "tir/transforms/update_pointer_storage_scope.h"
@@ -597,6 +598,23 @@ private:
       local_bufs.push_back(mask_buffer.value());
     }
 
+    // A full warp of 32-bit integers reduces in a single redux.sync, which
+    // leaves the result in every lane.
+    if (reduce_extent == warp_size_ && !predicate.defined()) {
+      if (auto redux = WarpReduxIntrinsic(combiner, dtypes)) {
+        PrimExpr active = mask_buffer.defined()
+                              ? BufferLoad(mask_buffer.value(), zero_indices)
+                              : mask;
+        PrimExpr val = BufferLoad(shared_bufs[0], zero_indices);
+        seq->push_back(BufferStore(
+            shared_bufs[0],
+            Call(dtypes[0], builtin::call_extern(),
+                 {StringImm(redux.value()), active, val}),
+            zero_indices));
+        return {{BufferLoad(shared_bufs[0], zero_indices)}, local_bufs};
+      }
+    }
+
     // Emit reductions within a warp.
     int start_offset = 1;
     while (start_offset * 2 < reduce_extent) {
@@ -669,6 +687,47 @@ private:
     return {reduce_results, local_bufs};
   }
 
+  // The CUDA intrinsic reducing a 32-bit integer over a warp with redux.sync
+  // (sm_80+) for `combiner`, if there is one.
+  Optional<String>
+  WarpReduxIntrinsic(const CommReducerNode *combiner,
+                     const std::vector<DataType> &dtypes) const {
+    if (target_->kind->name != "cuda" || dtypes.size() != 1 ||
+        combiner->result.size() != 1)
+      return std::nullopt;
+    if (!target_->GetAttr<String>("arch").has_value() ||
+        !TargetHasSMVersionGE(ffi::GetRef<Target>(target_), 80))
+      return std::nullopt;
+    if (dtypes[0] != DataType::Int(32) && dtypes[0] != DataType::UInt(32))
+      return std::nullopt;
+    const Var &x = combiner->lhs[0];
+    const Var &y = combiner->rhs[0];
+    auto is_operands = [&](const PrimExpr &a, const PrimExpr &b) {
+      return (a.same_as(x) && b.same_as(y)) || (a.same_as(y) && b.same_as(x));
+    };
+    const PrimExpr &result = combiner->result[0];
+    if (const auto *op = result.as<AddNode>()) {
+      if (is_operands(op->a, op->b))
+        return String("__reduce_add_sync");
+    } else if (const auto *op = result.as<MinNode>()) {
+      if (is_operands(op->a, op->b))
+        return String("__reduce_min_sync");
+    } else if (const auto *op = result.as<MaxNode>()) {
+      if (is_operands(op->a, op->b))
+        return String("__reduce_max_sync");
+    } else if (const auto *op = result.as<CallNode>()) {
+      if (op->args.size() != 2 || !is_operands(op->args[0], op->args[1]))
+        return std::nullopt;
+      if (op->op.same_as(builtin::bitwise_and()))
+        return String("__reduce_and_sync");
+      if (op->op.same_as(builtin::bitwise_or()))
+        return String("__reduce_or_sync");
+      if (op->op.same_as(builtin::bitwise_xor()))
+        return String("__reduce_xor_sync");
+    }
+    return std::nullopt;
+  }
+
   // make allreduce.
   Stmt MakeBufAllreduce(const CommReducerNode *combiner,
                         const std::vector<DataType> &types,
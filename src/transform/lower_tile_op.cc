@@ -652,7 +652,7 @@ private:
 
     auto lowered = tile_op->Lower(
         LowerArgs{target_, thread_bounds, thread_var_->var, callback,
-                  layout_map_, buffer_remap_, let_var_to_expr},
+                  layout_map_, buffer_remap_, let_var_to_expr, block_vars_},
         analyzer_);
     return IRMutatorWithAnalyzer::VisitStmt(lowered);
   }
@@ -665,7 +665,16 @@ private:
         thread_var_ = iv;
         ICHECK(iv->dom->extent.as<IntImmNode>());
         thread_block_size_ = iv->dom->extent.as<IntImmNode>()->value;
+      } else if (iv->thread_tag.rfind("blockIdx.", 0) == 0 &&
+                 !is_one(iv->dom->extent)) {
+        block_vars_.push_back(iv->var);
       }
+    } else if (op->attr_key == tir::attr::tilelang_assume) {
+      // User assumptions (e.g. divisible dynamic extents) let the tile ops
+      // drop boundary predicates and widen vectorized accesses.
+      With<arith::ConstraintContext> ctx(analyzer_,
+                                         Downcast<PrimExpr>(op->node));
+      return arith::IRMutatorWithAnalyzer::VisitStmt_(op);
     }
     return arith::IRMutatorWithAnalyzer::VisitStmt_(op);
   }
@@ -841,6 +850,8 @@ private:
   IterVar thread_var_ = IterVar(Range::FromMinExtent(0, 1), Var("v_thread"),
                                 IterVarType::kDataPar);
   size_t thread_block_size_ = 0;
+  // blockIdx launch variables with an extent > 1
+  Array<Var> block_vars_;
   // Stack of per-Block workspace buffers gathered while visiting children
   std::vector<Array<Buffer>> workspace_stack_;
   // For ptx Node, we need to remap the buffer and indices
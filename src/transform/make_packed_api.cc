@@ -177,6 +177,132 @@ private:
   bool made_change_{false};
 };
 
+/*!
+ * \brief Guard the value checks of the packed arguments by a signature.
+ *
+ * The checks ArgBinder places in `asserts()` only depend on the values
+ * their conditions read: DLTensor fields, shape and stride elements and
+ * scalar arguments. The signature is a hash of these values, each read
+ * under the conditions enclosing it (e.g. the strides may be NULL), and the
+ * checks only run when it differs from the signature of the last call that
+ * passed them, kept in a function local static slot. The checks the loads
+ * of the binder depend on (type indices, NULL handles and ndim) are in
+ * `init_nest()` and keep running on every call.
+ */
+class SignatureGuard : public StmtExprVisitor {
+public:
+  static ffi::Optional<ffi::Array<Stmt>>
+  Apply(const std::vector<Stmt> &asserts, const std::string &name_hint) {
+    SignatureGuard guard;
+    for (const Stmt &stmt : asserts) {
+      guard(stmt);
+    }
+    if (!guard.supported_ || guard.leaves_.empty()) {
+      return std::nullopt;
+    }
+
+    // FNV-1a over the 64 bit words of the leaves
+    DataType u64 = DataType::UInt(64);
+    PrimExpr hash = make_const(u64, 0x2545F4914F6CDD1DLL);
+    for (const PrimExpr &leaf : guard.leaves_) {
+      hash = (hash ^ leaf) * make_const(u64, 0x100000001b3LL);
+    }
+    Var signature(name_hint + ".signature", u64);
+    Buffer slot = decl_buffer({1}, u64, name_hint + ".last_signature");
+    PrimExpr zero = IntImm(DataType::Int(32), 0);
+    Stmt checks = MergeNest(asserts, BufferStore(slot, signature, {zero}));
+    Stmt nop = Evaluate(0);
+    return ffi::Array<Stmt>{
+        LetStmt(slot->data,
+                Call(DataType::Handle(), builtin::tvm_static_handle(), {}),
+                nop),
+        DeclBuffer(slot, nop), LetStmt(signature, hash, nop),
+        SeqStmt({IfThenElse(BufferLoad(slot, {zero}) != signature, checks),
+                 nop})};
+  }
+
+private:
+  void VisitStmt(const Stmt &stmt) final {
+    if (const auto *op = stmt.as<IfThenElseNode>()) {
+      VisitCondition(op->condition);
+      guards_.push_back(op->condition);
+      VisitStmt(op->then_case);
+      guards_.pop_back();
+      if (op->else_case) {
+        guards_.push_back(Not(op->condition));
+        VisitStmt(op->else_case.value());
+        guards_.pop_back();
+      }
+    } else if (const auto *op = stmt.as<AssertStmtNode>()) {
+      VisitCondition(op->condition);
+      VisitStmt(op->body);
+    } else if (const auto *op = stmt.as<SeqStmtNode>()) {
+      for (const Stmt &s : op->seq) {
+        VisitStmt(s);
+      }
+    } else if (const auto *op = stmt.as<EvaluateNode>()) {
+      // Error reports only, whose arguments do not decide the checks
+      const auto *call = op->value.as<CallNode>();
+      if (!is_const_int(op->value) &&
+          !(call && call->op.same_as(builtin::tvm_call_packed()))) {
+        supported_ = false;
+      }
+    } else {
+      supported_ = false;
+    }
+  }
+
+  void VisitCondition(const PrimExpr &cond) {
+    in_condition_ = true;
+    VisitExpr(cond);
+    in_condition_ = false;
+  }
+
+  void VisitExpr_(const VarNode *op) final { AddLeaf(ffi::GetRef<Var>(op)); }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    AddLeaf(ffi::GetRef<BufferLoad>(op));
+  }
+
+  void VisitExpr_(const LetNode *op) final { supported_ = false; }
+
+  void VisitExpr_(const CallNode *op) final {
+    // Lazily evaluated or reading the arguments, taken as a whole
+    if (op->op.same_as(builtin::if_then_else()) ||
+        op->op.same_as(builtin::isnullptr()) ||
+        op->op.same_as(builtin::tvm_struct_get())) {
+      AddLeaf(ffi::GetRef<Call>(op));
+    } else {
+      StmtExprVisitor::VisitExpr_(op);
+    }
+  }
+
+  void AddLeaf(const PrimExpr &leaf) {
+    ICHECK(in_condition_);
+    DataType dtype = leaf.dtype();
+    if (!dtype.is_scalar() ||
+        !(dtype.is_int() || dtype.is_uint() || dtype.is_bool())) {
+      supported_ = false;
+      return;
+    }
+    PrimExpr value = Cast(DataType::UInt(64), leaf);
+    for (auto it = guards_.rbegin(); it != guards_.rend(); ++it) {
+      value = if_then_else(*it, value, make_zero(DataType::UInt(64)));
+    }
+    for (const PrimExpr &seen : leaves_) {
+      if (ExprDeepEqual()(seen, value)) {
+        return;
+      }
+    }
+    leaves_.push_back(value);
+  }
+
+  std::vector<PrimExpr> guards_;
+  std::vector<PrimExpr> leaves_;
+  bool in_condition_{false};
+  bool supported_{true};
+};
+
 } // namespace
 
 inline Stmt MakeAssertEQ(PrimExpr lhs, PrimExpr rhs, std::string msg) {
@@ -213,7 +339,7 @@ Optional<String> RequiresPackedAPI(const PrimFunc &func) {
   return global_symbol;
 }
 
-PrimFunc MakePackedAPI(PrimFunc func) {
+PrimFunc MakePackedAPI(PrimFunc func, bool cache_signature) {
   auto global_symbol = RequiresPackedAPI(func);
   if (!global_symbol) {
     return func;
@@ -551,7 +677,14 @@ PrimFunc MakePackedAPI(PrimFunc func) {
   // Return error code of zero on success
   body = SeqStmt({body, Evaluate(ret(Integer(0)))});
 
-  body = MergeNest({seq_init, binder.init_nest(), seq_check, binder.asserts(),
+  // The signature slot is a static of the LLVM host module
+  std::vector<Stmt> asserts = binder.asserts();
+  if (cache_signature && target_host->kind->name == "llvm") {
+    if (auto guarded = SignatureGuard::Apply(asserts, name_hint)) {
+      asserts.assign(guarded.value().begin(), guarded.value().end());
+    }
+  }
+  body = MergeNest({seq_init, binder.init_nest(), seq_check, asserts,
                     arg_buffer_declarations},
                    body);
   func_ptr->body = body;
@@ -572,6 +705,8 @@ PrimFunc MakePackedAPI(PrimFunc func) {
 tvm::transform::Pass MakePackedAPI() {
   using tvm::transform::Pass;
   auto pass_func = [](IRModule mod, const tvm::transform::PassContext &ctx) {
+    bool cache_signature =
+        ctx->GetConfig<Bool>(kEnableHostSignatureCache, Bool(false)).value();
     Map<GlobalVar, String> packed_func_methods;
     for (const auto &[gvar, base_func] : mod->functions) {
       if (auto opt = base_func.as<PrimFunc>()) {
@@ -594,7 +729,7 @@ tvm::transform::Pass MakePackedAPI() {
                                                       func->body)) {
           func.CopyOnWrite()->body = body.value();
         }
-        func = MakePackedAPI(std::move(func));
+        func = MakePackedAPI(std::move(func), cache_signature);
         func = MergeIfStmtSubstitute(func);
 
         if (!func.same_as(orig_func)) {
@@ -34,6 +34,7 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <numeric>
 #include <optional>
 #include <queue>
 #include <sstream>
@@ -417,9 +418,10 @@ public:
   explicit SharedMemoryRewriter(
       const std::unordered_map<const VarNode *, const AllocateNode *>
           &shmem_allocs,
-      bool is_dynamic = true, bool verbose = false, int align_bytes = 0)
+      bool is_dynamic = true, bool verbose = false, int align_bytes = 0,
+      bool optimal_packing = false)
       : is_dynamic_{is_dynamic}, shmem_allocs_{shmem_allocs}, verbose_{verbose},
-        align_bytes_{align_bytes} {
+        optimal_packing_{optimal_packing}, align_bytes_{align_bytes} {
     if (!is_dynamic) {
       merged_buf_var_ =
           Var("buf_shmem", PointerType(PrimType(DataType::UInt(8)), "shared"));
@@ -810,6 +812,138 @@ private:
     return ArenaPlan{arena_top, std::move(offsets)};
   }
 
+  static bool LiveTogether(const Interval &a, const Interval &b) {
+    return a.start < b.end && b.start < a.end;
+  }
+
+  /*!
+   * \brief Lowest offset honouring the alignment of `interval` at which it
+   * overlaps none of the placed buffers live at the same time.
+   */
+  static size_t LowestFit(const Interval &interval,
+                          const std::vector<Interval> &placed,
+                          const std::vector<size_t> &placed_offsets) {
+    size_t offset = AlignUpSize(0, interval.alignment);
+    bool moved = true;
+    while (moved) {
+      moved = false;
+      for (size_t k = 0; k < placed.size(); ++k) {
+        size_t end = placed_offsets[k] + placed[k].size_bytes;
+        if (LiveTogether(interval, placed[k]) && offset < end &&
+            placed_offsets[k] < offset + interval.size_bytes) {
+          offset = AlignUpSize(end, interval.alignment);
+          moved = true;
+        }
+      }
+    }
+    return offset;
+  }
+
+  /*!
+   * \brief Largest total size of the buffers live at the same time, which no
+   * packing can go below.
+   */
+  static size_t FootprintLowerBound(const std::vector<Interval> &intervals) {
+    size_t bound = 0;
+    for (const Interval &at : intervals) {
+      size_t live = 0;
+      for (const Interval &other : intervals) {
+        if (other.start <= at.start && at.start < other.end)
+          live += other.size_bytes;
+      }
+      bound = std::max(bound, live);
+    }
+    return bound;
+  }
+
+  /*!
+   * \brief Pack the buffers into the smallest arena, solving the time x offset
+   * packing rather than scanning the buffers in program order.
+   *
+   * Sliding every buffer of a packing down to its lowest aligned offset clear
+   * of the buffers live together keeps it valid, so some order of placing the
+   * buffers at their lowest fit reaches the optimum. Up to kMaxExactBuffers
+   * buffers the orders are searched by branch and bound, pruning the partial
+   * placements already as high as the best arena, within a budget of
+   * kMaxSearchNodes placements. Larger sets keep the best of the greedy
+   * orders, and the linear scan result when it is smaller.
+   */
+  static ArenaPlan OptimalPack(const std::vector<Interval> &intervals) {
+    constexpr size_t kMaxExactBuffers = 12;
+    constexpr int64_t kMaxSearchNodes = 1 << 20;
+    size_t n = intervals.size();
+    ArenaPlan best = LinearScanPack(intervals);
+
+    std::vector<Interval> placed;
+    std::vector<size_t> placed_offsets;
+    auto try_order = [&](const std::vector<size_t> &order) {
+      placed.clear();
+      placed_offsets.clear();
+      size_t top = 0;
+      for (size_t k : order) {
+        size_t offset = LowestFit(intervals[k], placed, placed_offsets);
+        placed.push_back(intervals[k]);
+        placed_offsets.push_back(offset);
+        top = std::max(top, offset + intervals[k].size_bytes);
+      }
+      if (top < best.arena_size) {
+        best.arena_size = top;
+        for (size_t k = 0; k < n; ++k)
+          best.offsets[placed[k].var] = placed_offsets[k];
+      }
+    };
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    auto sorted_by = [&](auto key) {
+      std::vector<size_t> sorted = order;
+      std::stable_sort(sorted.begin(), sorted.end(),
+                       [&](size_t a, size_t b) { return key(a) > key(b); });
+      return sorted;
+    };
+    try_order(sorted_by([&](size_t k) { return intervals[k].size_bytes; }));
+    try_order(sorted_by([&](size_t k) {
+      return intervals[k].size_bytes *
+             static_cast<size_t>(intervals[k].end - intervals[k].start);
+    }));
+    try_order(sorted_by([&](size_t k) { return intervals[k].alignment; }));
+    if (n > kMaxExactBuffers)
+      return best;
+
+    size_t lower_bound = FootprintLowerBound(intervals);
+    std::vector<bool> used(n, false);
+    int64_t nodes = 0;
+    std::function<void(size_t)> search = [&](size_t top) {
+      if (best.arena_size <= lower_bound || nodes > kMaxSearchNodes)
+        return;
+      if (placed.size() == n) {
+        best.arena_size = top;
+        for (size_t k = 0; k < n; ++k)
+          best.offsets[placed[k].var] = placed_offsets[k];
+        return;
+      }
+      for (size_t k = 0; k < n; ++k) {
+        if (used[k])
+          continue;
+        size_t offset = LowestFit(intervals[k], placed, placed_offsets);
+        size_t new_top = std::max(top, offset + intervals[k].size_bytes);
+        ++nodes;
+        if (new_top >= best.arena_size)
+          continue;
+        used[k] = true;
+        placed.push_back(intervals[k]);
+        placed_offsets.push_back(offset);
+        search(new_top);
+        placed.pop_back();
+        placed_offsets.pop_back();
+        used[k] = false;
+      }
+    };
+    placed.clear();
+    placed_offsets.clear();
+    search(0);
+    return best;
+  }
+
   PrimExpr AlignPrimExpr(const PrimExpr &value, int alignment) const {
     if (alignment <= 1) {
       return value;
@@ -1209,7 +1343,19 @@ private:
       intervals.push_back(interval);
     }
 
-    ArenaPlan plan = LinearScanPack(std::move(intervals));
+    ArenaPlan plan;
+    if (optimal_packing_) {
+      size_t lower_bound = FootprintLowerBound(intervals);
+      size_t linear_scan = LinearScanPack(intervals).arena_size;
+      plan = OptimalPack(intervals);
+      LOG(INFO) << "Packed " << intervals.size() << " constant-sized "
+                << (is_dynamic_ ? "dynamic" : "static")
+                << " shared memory buffers into " << plan.arena_size
+                << " bytes, lower bound " << lower_bound
+                << " bytes, linear scan " << linear_scan << " bytes";
+    } else {
+      plan = LinearScanPack(std::move(intervals));
+    }
     size_t arena_size_const = plan.arena_size;
 
     if (verbose_) {
@@ -1327,6 +1473,8 @@ private:
 
   // Whether enable verbose logging.
   bool verbose_{false};
+  // Whether search for the smallest packing instead of the linear scan.
+  bool optimal_packing_{false};
   // The alignment bytes for the merged buffer
   int align_bytes_{16};
   // The var for the merged buffer
@@ -1351,18 +1499,19 @@ private:
 
 Stmt MergeSharedMemoryAllocations(Stmt stmt, bool merge_static_smem,
                                   bool enable_aggressive_merge,
-                                  int align_bytes = 16, bool verbose = false) {
+                                  int align_bytes = 16, bool verbose = false,
+                                  bool optimal_packing = false) {
   AllocateCollector collector;
   collector(stmt);
   if (collector.dyn_shmem_allocs_.size() > 1) {
     SharedMemoryRewriter rewriter(collector.dyn_shmem_allocs_, true, verbose,
-                                  align_bytes);
+                                  align_bytes, optimal_packing);
     rewriter.PlanReuse(stmt, true, enable_aggressive_merge);
     stmt = rewriter(std::move(stmt));
   }
   if (merge_static_smem && collector.static_shmem_allocs_.size() > 1) {
     SharedMemoryRewriter rewriter(collector.static_shmem_allocs_, false,
-                                  verbose, align_bytes);
+                                  verbose, align_bytes, optimal_packing);
     rewriter.PlanReuse(stmt, false, enable_aggressive_merge);
     stmt = rewriter(std::move(stmt));
   }
@@ -1382,10 +1531,15 @@ Pass MergeSharedMemoryAllocations(bool enable_aggressive_merge = false,
     bool debug_merge_shared_memory_allocations =
         ctx->GetConfig<Bool>(kDebugMergeSharedMemoryAllocations, Bool(false))
             .value();
+    // The offline packing search is not worth its time in fast compiles
+    bool optimal_packing =
+        ctx->GetConfig<Bool>(kEnableOptimalSharedMemoryPacking, Bool(false))
+            .value() &&
+        !ctx->GetConfig<Bool>(kFastCompile, Bool(false)).value();
     auto *n = f.CopyOnWrite();
     n->body = tl::MergeSharedMemoryAllocations(
         std::move(n->body), merge_static_smem, enable_aggressive_merge,
-        align_bytes, debug_merge_shared_memory_allocations);
+        align_bytes, debug_merge_shared_memory_allocations, optimal_packing);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tl.MergeSharedMemoryAllocations",
@@ -8,6 +8,7 @@
 
 #include "../op/builtin.h"
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "../target/utils.h"
@@ -38,6 +39,15 @@ bool MayConflict(const Region &region1, const Region &region2) {
   return true;
 }
 
+/*!
+ * \brief Check whether a statement waits for the signal of a peer.
+ */
+static bool IsSymmWait(const Stmt &stmt) {
+  const auto *eval = stmt.as<EvaluateNode>();
+  const auto *call = eval ? eval->value.as<CallNode>() : nullptr;
+  return call && call->op.same_as(symm_wait());
+}
+
 class TmemLoadCollector : public StmtExprVisitor {
 public:
   TmemLoadCollector() {}
@@ -282,6 +292,163 @@ private:
   bool within_condition_expr_ = false;
 };
 
+/*!
+ * \brief Resolve `num_stages = -1` (``T.Pipelined(..., num_stages="auto")``)
+ *        to a concrete pipeline depth.
+ *
+ * The shared memory buffers filled from global memory inside the loop are
+ * multi-buffered by the pipeline, every other shared allocation of the kernel
+ * is paid once. The depth is the largest one whose footprint fits the shared
+ * memory capacity of the target, capped by the trip count of the loop and by
+ * the depth beyond which extra stages no longer hide load latency.
+ */
+class PipelineStageSelector : public StmtExprMutator {
+public:
+  static Stmt Substitute(const PrimFunc &f, const Target &target) {
+    PipelineStageSelector selector(target);
+    PostOrderVisit(f->body, [&](const ObjectRef &obj) {
+      if (const auto *block = obj.as<BlockNode>()) {
+        for (const auto &buffer : block->alloc_buffers) {
+          if (IsSharedBuffer(buffer)) {
+            selector.shared_buffers_.push_back(buffer);
+          }
+        }
+      }
+    });
+    return selector.VisitStmt(f->body);
+  }
+
+  /*! \brief Marker of the automatic depth in the `num_stages` annotation. */
+  static constexpr int kAutoStages = -1;
+
+private:
+  explicit PipelineStageSelector(Target target) : target_(std::move(target)) {}
+
+  static bool IsSharedBuffer(const Buffer &buffer) {
+    String scope = buffer.scope();
+    return scope == "shared" || scope == "shared.dyn";
+  }
+
+  // Allocated bytes of a buffer, rounded up to the 128-byte alignment of the
+  // shared memory planner, or -1 if its shape is symbolic.
+  static int64_t BufferBytes(const Buffer &buffer) {
+    int64_t elems = 1;
+    for (const auto &dim : buffer->shape) {
+      const auto *imm = dim.as<IntImmNode>();
+      if (imm == nullptr)
+        return -1;
+      elems *= imm->value;
+    }
+    int64_t bytes = (elems * buffer->dtype.bits() * buffer->dtype.lanes() + 7) /
+                    8;
+    return (bytes + 127) / 128 * 128;
+  }
+
+  // Shared buffers written from global memory in a loop body, either by
+  // element-wise stores, by not yet lowered T.copy or by TMA loads.
+  std::unordered_set<const VarNode *> CollectStagedBuffers(const Stmt &body) {
+    static const Op &copy_op = Op::Get("tl.tileop.copy");
+    static const Op &region_op = Op::Get("tl.tileop.region");
+    std::unordered_set<const VarNode *> staged;
+    auto region_buffer = [&](const PrimExpr &arg) -> Optional<Buffer> {
+      if (const auto *call = arg.as<CallNode>()) {
+        if (call->op.same_as(region_op)) {
+          if (const auto *load = call->args[0].as<BufferLoadNode>())
+            return load->buffer;
+        }
+      }
+      if (const auto *load = arg.as<BufferLoadNode>())
+        return load->buffer;
+      return std::nullopt;
+    };
+    PostOrderVisit(body, [&](const ObjectRef &obj) {
+      if (const auto *store = obj.as<BufferStoreNode>()) {
+        if (!IsSharedBuffer(store->buffer))
+          return;
+        bool reads_global = false;
+        PostOrderVisit(store->value, [&](const ObjectRef &node) {
+          if (const auto *load = node.as<BufferLoadNode>()) {
+            reads_global |= load->buffer.scope() == "global";
+          }
+        });
+        if (reads_global)
+          staged.insert(store->buffer->data.get());
+      } else if (const auto *call = obj.as<CallNode>()) {
+        if (call->op.same_as(copy_op) && call->args.size() >= 2) {
+          auto src = region_buffer(call->args[0]);
+          auto dst = region_buffer(call->args[1]);
+          if (src && dst && src.value().scope() == "global" &&
+              IsSharedBuffer(dst.value())) {
+            staged.insert(dst.value()->data.get());
+          }
+        } else if (call->op.same_as(tma_load()) ||
+                   call->op.same_as(tma_load_im2col())) {
+          for (const auto &arg : call->args) {
+            const auto *ptr = arg.as<CallNode>();
+            if (ptr && ptr->op.same_as(builtin::tvm_access_ptr())) {
+              if (const auto *var = ptr->args[1].as<VarNode>())
+                staged.insert(var);
+            } else if (ptr && ptr->op.same_as(builtin::address_of())) {
+              if (const auto *load = ptr->args[0].as<BufferLoadNode>())
+                staged.insert(load->buffer->data.get());
+            }
+          }
+        }
+      }
+    });
+    return staged;
+  }
+
+  int SelectNumStages(const ForNode *loop) {
+    // Without asynchronous copies the prefetch goes through registers and
+    // only double buffering pays off.
+    const int max_stages = TargetHasAsyncCopy(target_) ? 4 : 2;
+    const int default_stages = 2;
+    auto staged = CollectStagedBuffers(loop->body);
+    if (staged.empty())
+      return 1;
+    int64_t per_stage = 0, fixed = 0;
+    for (const auto &buffer : shared_buffers_) {
+      int64_t bytes = BufferBytes(buffer);
+      if (bytes < 0)
+        return default_stages;
+      if (staged.count(buffer->data.get()))
+        per_stage += bytes;
+      else
+        fixed += bytes;
+    }
+    // Slack for barriers and the alignment of the merged allocation.
+    const int64_t budget = TargetGetMaxSharedMemoryPerBlock(target_) - 1024;
+    int num_stages = max_stages;
+    if (per_stage > 0) {
+      num_stages = static_cast<int>(
+          std::min<int64_t>(max_stages, (budget - fixed) / per_stage));
+    }
+    if (const auto *extent = loop->extent.as<IntImmNode>()) {
+      num_stages = static_cast<int>(
+          std::min<int64_t>(num_stages, std::max<int64_t>(extent->value, 1)));
+    }
+    return std::max(num_stages, 1);
+  }
+
+  Stmt VisitStmt_(const ForNode *op) final {
+    For loop = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    auto num_stages_anno = loop->annotations.Get("num_stages");
+    if (!num_stages_anno)
+      return loop;
+    const auto *imm = num_stages_anno->as<IntImmNode>();
+    if (imm == nullptr || imm->value != kAutoStages)
+      return loop;
+    int num_stages = SelectNumStages(loop.get());
+    loop.CopyOnWrite()->annotations.Set("num_stages",
+                                        IntImm(DataType::Int(32), num_stages));
+    return loop;
+  }
+
+  Target target_;
+  std::vector<Buffer> shared_buffers_;
+};
+
 class PipelinePlanner : public StmtExprMutator {
 public:
   static Stmt Substitute(const PrimFunc &f, bool use_async_copy = true) {
@@ -293,7 +460,8 @@ public:
     ICHECK(target.defined())
         << "Pipeline_Planning: Require the target attribute";
     substituter.target_ = target.value();
-    return substituter.VisitStmt(f->body);
+    return substituter.VisitStmt(
+        PipelineStageSelector::Substitute(f, target.value()));
   }
 
 private:
@@ -610,6 +778,18 @@ private:
       }
     }
 
+    // A wait for the signal of a peer right before a copy waits for the peer
+    // tile fetched by the copy, and is issued along with it
+    for (size_t i = 0; i + 1 < pipeline_stage_infos.size(); ++i) {
+      auto &pinfo = pipeline_stage_infos[i];
+      const auto &next = pipeline_stage_infos[i + 1];
+      if (!IsSymmWait(pipeline_body_seq->seq[i]) || !next.is_copy_stage() ||
+          !next.is_last_use_stmt_index_valid())
+        continue;
+      pinfo.producer_for_copy = true;
+      pinfo.last_use_stmt_index = next.last_use_stmt_index;
+    }
+
     // Making stages and orders
     int order_idx = 0;
     // Stage 1. Create pipeline stages and assign order
@@ -728,9 +908,24 @@ tvm::transform::Pass PipelinePlanning() {
   return CreatePrimFuncPass(pass_func, 0, "tl.PipelinePlanning", {});
 }
 
+tvm::transform::Pass PipelineStageSelection() {
+  using namespace tir::transform;
+  auto pass_func = [=](PrimFunc f, const IRModule &m, PassContext ctx) {
+    auto target = f->GetAttr<Target>(tvm::attr::kTarget);
+    ICHECK(target.defined())
+        << "PipelineStageSelection: Require the target attribute";
+    PrimFuncNode *fptr = f.CopyOnWrite();
+    fptr->body = PipelineStageSelector::Substitute(f, target.value());
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.PipelineStageSelection", {});
+}
+
 TVM_FFI_STATIC_INIT_BLOCK() {
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("tl.transform.PipelinePlanning", PipelinePlanning);
+  refl::GlobalDef()
+      .def("tl.transform.PipelinePlanning", PipelinePlanning)
+      .def("tl.transform.PipelineStageSelection", PipelineStageSelection);
 }
 
 } // namespace tl
@@ -0,0 +1,303 @@
+/*!
+ * \file predict_register_pressure.cc
+ * \brief Estimate the registers each thread keeps live, rematerialize cheap
+ * values where the estimate exceeds the budget and report what remains.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../op/builtin.h"
+#include "tir/transforms/ir_utils.h"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+/// Registers a thread may use at most
+constexpr int64_t kMaxRegistersPerThread = 255;
+/// Registers of a streaming multiprocessor shared by the threads of a block
+constexpr int64_t kRegistersPerBlock = 65536;
+
+/*! \brief Number of 32-bit registers holding `elements` values of `dtype`. */
+static int64_t RegisterCount(DataType dtype, int64_t elements) {
+  int64_t bits = static_cast<int64_t>(dtype.bits()) * dtype.lanes() * elements;
+  return std::max<int64_t>(1, (bits + 31) / 32);
+}
+
+/*!
+ * \brief Whether recomputing `value` at each use is cheaper than keeping it
+ * in a register: index math and broadcasts of variables and constants.
+ */
+static bool IsCheapToRematerialize(const PrimExpr &value) {
+  if (value.dtype().is_handle() || value.dtype().lanes() != 1)
+    return false;
+  bool cheap = true;
+  PostOrderVisit(value, [&](const ObjectRef &node) {
+    if (node.as<BufferLoadNode>() || node.as<CallNode>() ||
+        node.as<LetNode>()) {
+      cheap = false;
+    }
+  });
+  return cheap;
+}
+
+/*!
+ * \brief Live register estimate at each leaf statement of a function.
+ *
+ * Statements are linearized the way storage_rewrite linearizes them: every
+ * store and evaluate is one point. A local buffer or let-bound value is live
+ * from its first to its last touch, and through a whole loop when it is
+ * touched inside the loop but defined before it, since it is then carried
+ * from one iteration to the next.
+ */
+class RegisterPressureEstimator : public StmtExprVisitor {
+public:
+  struct Interval {
+    int64_t first{-1};
+    int64_t last{-1};
+    int64_t registers{0};
+  };
+
+  void Estimate(const Stmt &body) {
+    VisitStmt(body);
+    pressure_.assign(points_.size(), 0);
+    for (const auto &[_, interval] : intervals_) {
+      for (int64_t i = std::max<int64_t>(interval.first, 0);
+           i <= interval.last && i < static_cast<int64_t>(points_.size());
+           ++i) {
+        pressure_[i] += interval.registers;
+      }
+    }
+  }
+
+  /*! \brief Index of the point with the highest estimate, -1 if none. */
+  int64_t PeakPoint() const {
+    if (pressure_.empty())
+      return -1;
+    return std::max_element(pressure_.begin(), pressure_.end()) -
+           pressure_.begin();
+  }
+
+  int64_t PressureAt(int64_t point) const { return pressure_[point]; }
+
+  /*! \brief The innermost loop enclosing a point, null if none. */
+  const ForNode *LoopAt(int64_t point) const { return points_[point]; }
+
+  /*! \brief Whether the value bound by `var` is live at some point over
+   * `budget` registers. */
+  bool LiveOverBudget(const VarNode *var, int64_t budget) const {
+    auto it = intervals_.find(var);
+    if (it == intervals_.end())
+      return false;
+    int64_t last = std::min<int64_t>(it->second.last, pressure_.size() - 1);
+    for (int64_t i = std::max<int64_t>(it->second.first, 0); i <= last; ++i) {
+      if (pressure_[i] > budget)
+        return true;
+    }
+    return false;
+  }
+
+  /*! \brief Product of the threadIdx extents. */
+  int64_t num_threads{1};
+
+private:
+  void Define(const VarNode *var, int64_t registers) {
+    Interval &interval = intervals_[var];
+    interval.registers = registers;
+    interval.first = static_cast<int64_t>(points_.size());
+    interval.last = interval.first - 1;
+  }
+
+  void Touch(const VarNode *var) {
+    auto it = intervals_.find(var);
+    if (it == intervals_.end())
+      return;
+    int64_t point = static_cast<int64_t>(points_.size());
+    it->second.last = std::max(it->second.last, point);
+    for (auto &loop : loops_) {
+      if (it->second.first < loop.begin)
+        loop.carried.insert(var);
+    }
+  }
+
+  void AddPoint() {
+    points_.push_back(loops_.empty() ? nullptr : loops_.back().loop);
+  }
+
+  void VisitStmt_(const AllocateNode *op) final {
+    String scope = GetPtrStorageScope(op->buffer_var);
+    int64_t elements = op->ConstantAllocationSize();
+    if (scope.rfind("local", 0) == 0 && elements > 0) {
+      Define(op->buffer_var.get(), RegisterCount(op->dtype, elements));
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const LetStmtNode *op) final {
+    VisitExpr(op->value);
+    if (!op->value.dtype().is_handle()) {
+      Define(op->var.get(), RegisterCount(op->value.dtype(), 1));
+    }
+    VisitStmt(op->body);
+  }
+
+  void VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      const auto *extent = op->value.as<IntImmNode>();
+      if (iv->thread_tag.rfind("threadIdx", 0) == 0 && extent)
+        num_threads *= extent->value;
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const ForNode *op) final {
+    loops_.push_back({op, static_cast<int64_t>(points_.size()), {}});
+    StmtExprVisitor::VisitStmt_(op);
+    LoopFrame frame = std::move(loops_.back());
+    loops_.pop_back();
+    int64_t end = static_cast<int64_t>(points_.size()) - 1;
+    for (const VarNode *var : frame.carried)
+      intervals_[var].last = std::max(intervals_[var].last, end);
+  }
+
+  void VisitStmt_(const BufferStoreNode *op) final {
+    Touch(op->buffer->data.get());
+    StmtExprVisitor::VisitStmt_(op);
+    AddPoint();
+  }
+
+  void VisitStmt_(const EvaluateNode *op) final {
+    StmtExprVisitor::VisitStmt_(op);
+    AddPoint();
+  }
+
+  void VisitExpr_(const BufferLoadNode *op) final {
+    Touch(op->buffer->data.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode *op) final { Touch(op); }
+
+  struct LoopFrame {
+    const ForNode *loop;
+    int64_t begin;
+    std::unordered_set<const VarNode *> carried;
+  };
+
+  std::vector<LoopFrame> loops_;
+  /*! \brief Innermost loop of each point. */
+  std::vector<const ForNode *> points_;
+  std::vector<int64_t> pressure_;
+  std::unordered_map<const VarNode *, Interval> intervals_;
+};
+
+/*!
+ * \brief Inline the cheap let-bound values live where the estimate exceeds
+ * the budget, so they are recomputed at their uses instead of held.
+ */
+class CheapValueRematerializer : public StmtExprMutator {
+public:
+  CheapValueRematerializer(const RegisterPressureEstimator &estimator,
+                           int64_t budget)
+      : estimator_(estimator), budget_(budget) {}
+
+  int num_rematerialized{0};
+
+private:
+  Stmt VisitStmt_(const LetStmtNode *op) final {
+    PrimExpr value = VisitExpr(op->value);
+    if (IsCheapToRematerialize(value) &&
+        estimator_.LiveOverBudget(op->var.get(), budget_)) {
+      ++num_rematerialized;
+      bindings_.Set(op->var, value);
+      return VisitStmt(op->body);
+    }
+    Stmt body = VisitStmt(op->body);
+    if (value.same_as(op->value) && body.same_as(op->body))
+      return tvm::ffi::GetRef<Stmt>(op);
+    return LetStmt(op->var, value, body, op->span);
+  }
+
+  PrimExpr VisitExpr_(const VarNode *op) final {
+    if (auto value = bindings_.Get(tvm::ffi::GetRef<Var>(op)))
+      return value.value();
+    return tvm::ffi::GetRef<PrimExpr>(op);
+  }
+
+  const RegisterPressureEstimator &estimator_;
+  int64_t budget_;
+  Map<Var, PrimExpr> bindings_;
+};
+
+using namespace tir::transform;
+
+namespace transform {
+
+tvm::transform::Pass PredictRegisterPressure() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    RegisterPressureEstimator estimator;
+    estimator.Estimate(f->body);
+    int64_t budget =
+        ctx->GetConfig<Integer>(kRegisterBudget, Integer(0)).value()->value;
+    if (budget <= 0) {
+      budget = std::min(kMaxRegistersPerThread,
+                        kRegistersPerBlock / estimator.num_threads);
+    }
+    int64_t peak = estimator.PeakPoint();
+    if (peak < 0 || estimator.PressureAt(peak) <= budget)
+      return f;
+
+    bool disable_remat =
+        ctx->GetConfig<Bool>(kDisableRematerialization, Bool(false)).value();
+    if (!disable_remat) {
+      CheapValueRematerializer remat(estimator, budget);
+      Stmt body = remat(f->body);
+      if (remat.num_rematerialized > 0) {
+        f.CopyOnWrite()->body = body;
+        estimator = RegisterPressureEstimator();
+        estimator.Estimate(f->body);
+        peak = estimator.PeakPoint();
+      }
+    }
+    if (estimator.PressureAt(peak) <= budget)
+      return f;
+
+    std::ostringstream os;
+    os << "Estimated " << estimator.PressureAt(peak)
+       << " live registers per thread exceed the budget of " << budget;
+    if (const ForNode *loop = estimator.LoopAt(peak)) {
+      os << " in the loop over " << loop->loop_var;
+      if (loop->span.defined()) {
+        os << " at " << loop->span->source_name->name << ":"
+           << loop->span->line;
+      }
+    }
+    os << "; the kernel is likely to spill. Smaller fragments per thread or "
+          "more threads reduce the pressure.";
+    LOG(WARNING) << os.str();
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.PredictRegisterPressure", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.PredictRegisterPressure",
+                        PredictRegisterPressure);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
@@ -0,0 +1,254 @@
+/*!
+ * \file reduce_index_strength.cc
+ * \brief Hoist the loop-invariant parts of flattened buffer indices and divide
+ * known non-negative indices as unsigned.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "../op/builtin.h"
+#include "arith/ir_mutator_with_analyzer.h"
+
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+using arith::IRMutatorWithAnalyzer;
+
+/*! \brief Append the summands of `expr` to `terms`. */
+static void CollectTerms(const PrimExpr &expr, std::vector<PrimExpr> *terms) {
+  if (const auto *add = expr.as<AddNode>()) {
+    CollectTerms(add->a, terms);
+    CollectTerms(add->b, terms);
+  } else {
+    terms->push_back(expr);
+  }
+}
+
+static PrimExpr SumTerms(const std::vector<PrimExpr> &terms) {
+  PrimExpr sum = terms[0];
+  for (size_t i = 1; i < terms.size(); ++i)
+    sum = sum + terms[i];
+  return sum;
+}
+
+/*!
+ * \brief Move the summands of the indices in a loop that no iteration changes
+ * into let bindings in front of the loop.
+ *
+ * An index `bx * 4096 + tx * 16 + i * 128 + 3` in a loop over `i` becomes
+ * `base + i * 128 + 3`, with `base = bx * 4096 + tx * 16` computed once: the
+ * iterations, unrolled or not, then only add a stride multiple and a
+ * constant to the base, which the device compiler folds into the address
+ * offsets of the memory instructions. Accesses sharing a base share the
+ * binding. The bindings this pass introduced in inner loops are reduced the
+ * same way, so the invariant part of a nest climbs it loop by loop.
+ */
+class LoopInvariantIndexHoister : public StmtExprMutator {
+public:
+  static Stmt Hoist(const For &loop,
+                    std::unordered_set<const VarNode *> *hoisted_vars) {
+    LoopInvariantIndexHoister hoister(loop, hoisted_vars);
+    Stmt body = hoister(loop->body);
+    if (hoister.bindings_.empty())
+      return loop;
+    For hoisted = loop;
+    hoisted.CopyOnWrite()->body = body;
+    Stmt result = hoisted;
+    for (auto it = hoister.bindings_.rbegin(); it != hoister.bindings_.rend();
+         ++it) {
+      hoisted_vars->insert(it->second.get());
+      result = LetStmt(it->second, it->first, result);
+    }
+    return result;
+  }
+
+private:
+  LoopInvariantIndexHoister(const For &loop,
+                            std::unordered_set<const VarNode *> *hoisted_vars)
+      : loop_(loop), hoisted_vars_(*hoisted_vars) {
+    defined_.insert(loop->loop_var.get());
+    PostOrderVisit(loop->body, [&](const ObjectRef &node) {
+      if (const auto *inner = node.as<ForNode>()) {
+        defined_.insert(inner->loop_var.get());
+      } else if (const auto *let = node.as<LetStmtNode>()) {
+        defined_.insert(let->var.get());
+      } else if (const auto *let = node.as<LetNode>()) {
+        defined_.insert(let->var.get());
+      }
+    });
+  }
+
+  bool IsInvariant(const PrimExpr &term) const {
+    if (UsesVar(term, [&](const VarNode *v) { return defined_.count(v); }))
+      return false;
+    bool pure = true;
+    PostOrderVisit(term, [&](const ObjectRef &node) {
+      if (node.as<BufferLoadNode>() || node.as<CallNode>())
+        pure = false;
+    });
+    return pure;
+  }
+
+  PrimExpr Reduce(const PrimExpr &index) {
+    if (const auto *ramp = index.as<RampNode>())
+      return Ramp(Reduce(ramp->base), ramp->stride, ramp->lanes);
+    if (!index.dtype().is_int() || index.dtype().lanes() != 1)
+      return index;
+    std::vector<PrimExpr> terms, invariant, varying;
+    CollectTerms(index, &terms);
+    for (const PrimExpr &term : terms) {
+      if (!is_const_int(term) && IsInvariant(term)) {
+        invariant.push_back(term);
+      } else {
+        varying.push_back(term);
+      }
+    }
+    // A lone variable is already as cheap as its binding would be
+    if (invariant.empty() ||
+        (invariant.size() == 1 && invariant[0].as<VarNode>()) ||
+        varying.empty()) {
+      return index;
+    }
+    PrimExpr base = SumTerms(invariant);
+    varying.insert(varying.begin(), BaseVar(base));
+    return SumTerms(varying);
+  }
+
+  Var BaseVar(const PrimExpr &base) {
+    for (const auto &[value, var] : bindings_) {
+      if (StructuralEqual()(value, base))
+        return var;
+    }
+    Var var(loop_->loop_var->name_hint + "_base", base.dtype());
+    bindings_.emplace_back(base, var);
+    return var;
+  }
+
+  Array<PrimExpr> ReduceIndices(const Array<PrimExpr> &indices) {
+    return indices.Map([&](const PrimExpr &index) { return Reduce(index); });
+  }
+
+  Stmt VisitStmt_(const LetStmtNode *op) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    if (!hoisted_vars_.count(op->var.get()))
+      return stmt;
+    LetStmt let = Downcast<LetStmt>(stmt);
+    let.CopyOnWrite()->value = Reduce(let->value);
+    return let;
+  }
+
+  Stmt VisitStmt_(const BufferStoreNode *op) final {
+    BufferStore store = Downcast<BufferStore>(StmtExprMutator::VisitStmt_(op));
+    store.CopyOnWrite()->indices = ReduceIndices(store->indices);
+    return store;
+  }
+
+  PrimExpr VisitExpr_(const BufferLoadNode *op) final {
+    BufferLoad load = Downcast<BufferLoad>(StmtExprMutator::VisitExpr_(op));
+    load.CopyOnWrite()->indices = ReduceIndices(load->indices);
+    return load;
+  }
+
+  const For &loop_;
+  const std::unordered_set<const VarNode *> &hoisted_vars_;
+  /*! \brief The variables bound inside the loop, the loop variable included. */
+  std::unordered_set<const VarNode *> defined_;
+  std::vector<std::pair<PrimExpr, Var>> bindings_;
+};
+
+/*!
+ * \brief Reduce the strength of the integer index math of a device function.
+ *
+ * Besides hoisting the loop-invariant parts of the indices, a signed 32-bit
+ * division or modulo by a constant is done as unsigned when the dividend is
+ * provably non-negative. Both lower to a multiply-high and a shift, but the
+ * signed form also needs a sign correction the device compiler cannot drop
+ * without knowing the sign of the dividend. Powers of two are left alone:
+ * LowerIntrin already turned them into shifts and masks.
+ */
+class IndexStrengthReducer : public IRMutatorWithAnalyzer {
+public:
+  static Stmt Reduce(const Stmt &body) {
+    arith::Analyzer analyzer;
+    IndexStrengthReducer reducer(&analyzer);
+    return reducer(body);
+  }
+
+private:
+  using IRMutatorWithAnalyzer::IRMutatorWithAnalyzer;
+  using IRMutatorWithAnalyzer::VisitExpr_;
+  using IRMutatorWithAnalyzer::VisitStmt_;
+
+  Stmt VisitStmt_(const ForNode *op) final {
+    For loop = Downcast<For>(IRMutatorWithAnalyzer::VisitStmt_(op));
+    if (loop->kind != ForKind::kSerial && loop->kind != ForKind::kUnrolled)
+      return loop;
+    return LoopInvariantIndexHoister::Hoist(loop, &hoisted_vars_);
+  }
+
+  /*! \brief Whether `op` divides a non-negative int32 by a constant. */
+  template <typename T> bool IsUnsignedDivisible(const T *op) {
+    const auto *divisor = op->b.template as<IntImmNode>();
+    if (op->dtype != DataType::Int(32) || !divisor || divisor->value <= 1)
+      return false;
+    if ((divisor->value & (divisor->value - 1)) == 0)
+      return false;
+    return analyzer_->CanProveGreaterEqual(op->a, 0);
+  }
+
+  PrimExpr VisitExpr_(const DivNode *op) final {
+    PrimExpr expr = IRMutatorWithAnalyzer::VisitExpr_(op);
+    op = expr.as<DivNode>();
+    if (!op || !IsUnsignedDivisible(op))
+      return expr;
+    DataType u32 = DataType::UInt(32);
+    return cast(op->dtype, div(cast(u32, op->a), cast(u32, op->b)));
+  }
+
+  PrimExpr VisitExpr_(const ModNode *op) final {
+    PrimExpr expr = IRMutatorWithAnalyzer::VisitExpr_(op);
+    op = expr.as<ModNode>();
+    if (!op || !IsUnsignedDivisible(op))
+      return expr;
+    DataType u32 = DataType::UInt(32);
+    return cast(op->dtype, truncmod(cast(u32, op->a), cast(u32, op->b)));
+  }
+
+  std::unordered_set<const VarNode *> hoisted_vars_;
+};
+
+using namespace tir::transform;
+
+namespace transform {
+
+tvm::transform::Pass ReduceIndexStrength() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    if (ctx->GetConfig<Bool>(kDisableIndexStrengthReduction, Bool(false))
+            .value()) {
+      return f;
+    }
+    auto *n = f.CopyOnWrite();
+    n->body = IndexStrengthReducer::Reduce(n->body);
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.ReduceIndexStrength", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.ReduceIndexStrength",
+                        ReduceIndexStrength);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
@@ -22,10 +22,12 @@
  */
 #include "../op/builtin.h"
 #include "./common/constr_visitor.h"
+#include "./common/proof_cache.h"
 #include "./common/thread_sync_types.h"
 #include "arith/ir_mutator_with_analyzer.h"
 #include "runtime/thread_storage_scope.h"
 #include "tir/transforms/ir_utils.h"
+#include <algorithm>
 #include <string>
 #include <tvm/arith/analyzer.h>
 #include <tvm/arith/int_set.h>
@@ -269,17 +271,49 @@ private:
   PrimExpr is_lead_;
 };
 
+/*!
+ * \brief Lower the syncs of a subset of the threads to named barriers.
+ *
+ * A first walk collects the thread groups synchronizing together and the span
+ * of their sync points, a group synchronizing inside a loop being live over
+ * the whole outermost loop. The groups are then given the hardware barriers
+ * by liveness: a group reuses the barrier of an earlier group whose syncs are
+ * all behind it, provided all its threads belong to that group, as each of
+ * them has then passed the last sync of the earlier group before arriving at
+ * the barrier again. Groups running concurrently, e.g. the warp-specialized
+ * roles, thus keep distinct barriers. Once the hardware barriers run out, the
+ * remaining groups synchronize on mbarriers in shared memory.
+ */
 class ThreadPartialSyncRewriter : public IRMutatorWithAnalyzer {
 public:
   static Stmt Rewrite(Stmt stmt) {
+    arith::Analyzer plan_analyzer;
+    ThreadPartialSyncRewriter planner(&plan_analyzer, true);
+    planner(stmt);
+    planner.PlanBarriers();
     arith::Analyzer analyzer;
-    ThreadPartialSyncRewriter rewriter(&analyzer);
+    ThreadPartialSyncRewriter rewriter(&analyzer, false);
+    rewriter.groups_ = std::move(planner.groups_);
+    rewriter.group_index_ = std::move(planner.group_index_);
+    rewriter.num_mbarriers_ = planner.num_mbarriers_;
     return rewriter(std::move(stmt));
   }
 
 private:
-  explicit ThreadPartialSyncRewriter(arith::Analyzer *analyzer)
-      : IRMutatorWithAnalyzer(analyzer) {}
+  /*! \brief The threads synchronizing at a set of sync points. */
+  struct SyncGroup {
+    ThreadBoundKey key;
+    size_t thread_count{0};
+    /*! \brief Positions of the first and last sync points of the group. */
+    int first{0}, last{0};
+    /*! \brief The named barrier of the group, or -1 for an mbarrier. */
+    int barrier_id{-1};
+    /*! \brief The mbarrier of the group, when it has no named barrier. */
+    int mbarrier_index{-1};
+  };
+
+  ThreadPartialSyncRewriter(arith::Analyzer *analyzer, bool planning)
+      : IRMutatorWithAnalyzer(analyzer), planning_(planning) {}
 
   Stmt VisitStmt_(const EvaluateNode *op) final {
     const CallNode *call = nullptr;
@@ -293,6 +327,12 @@ private:
         const std::string &scope = scope_node->value;
 
         if (args.size() != 1 || (scope != "shared" && scope != "shared.dyn")) {
+          // Barriers given out before, e.g. by the ThreadSync of another
+          // scope, stay reserved
+          if (planning_ && args.size() > 1) {
+            if (const auto *id = args[1].as<IntImmNode>())
+              reserved_ids_.insert(static_cast<int>(id->value));
+          }
           return IRMutatorWithAnalyzer::VisitStmt_(op);
         }
 
@@ -320,13 +360,10 @@ private:
     auto extent_ty = CalculateThreadExtent(ty_, bound_ty);
     auto extent_tz = CalculateThreadExtent(tz_, bound_tz);
 
-    // Create or get barrier info
     ThreadBoundKey key{bound_tx->min_value, bound_tx->max_value,
                        bound_ty->min_value, bound_ty->max_value,
                        bound_tz->min_value, bound_tz->max_value};
-
-    auto [barrier_id, thread_count] =
-        GetOrCreateBarrier(key, extent_tx, extent_ty, extent_tz);
+    size_t thread_count = extent_tx * extent_ty * extent_tz;
     if (thread_count % 32 != 0) {
       // TODO(lei): This is a workaround for the case where the thread count is
       // not a multiple of 32. we should enhance the pass to analysis index
@@ -334,30 +371,111 @@ private:
       return Stmt();
     }
 
+    if (planning_) {
+      RecordSync(key, thread_count);
+      return Evaluate(tvm::ffi::GetRef<Call>(op));
+    }
+    const SyncGroup &group = groups_.at(group_index_.at(key));
+    if (group.barrier_id < 0) {
+      return Evaluate(Call(DataType::Handle(), builtin::call_extern(),
+                           {StringImm("tl::syncthreads_partial"),
+                            BufferLoad(GetMBarrierBuffer(),
+                                       {group.mbarrier_index})}));
+    }
     // Create new sync call with barrier info
     Array<PrimExpr> new_args = {StringImm(scope),
-                                IntImm(DataType::Int(32), barrier_id),
+                                IntImm(DataType::Int(32), group.barrier_id),
                                 IntImm(DataType::Int(32), thread_count)};
     return Evaluate(Call(op->dtype, op->op, new_args));
   }
 
-  std::pair<size_t, size_t> GetOrCreateBarrier(const ThreadBoundKey &key,
-                                               size_t extent_tx,
-                                               size_t extent_ty,
-                                               size_t extent_tz) {
-    if (barrier_id_map_.count(key)) {
-      return {barrier_id_map_[key], thread_count_map_[key]};
+  void RecordSync(const ThreadBoundKey &key, size_t thread_count) {
+    int pos = num_sync_points_++;
+    auto it = group_index_.find(key);
+    if (it == group_index_.end()) {
+      it = group_index_.emplace(key, groups_.size()).first;
+      SyncGroup group;
+      group.key = key;
+      group.thread_count = thread_count;
+      group.first = pos;
+      groups_.push_back(group);
     }
+    groups_[it->second].last = pos;
+    if (loop_depth_ > 0)
+      loop_groups_.insert(it->second);
+  }
 
-    size_t barrier_id =
-        barrier_id_map_.size() +
-        static_cast<size_t>(ReservedNamedBarriers::kFirstUsedBarrier);
-    size_t thread_count = extent_tx * extent_ty * extent_tz;
+  static bool ContainsThreads(const ThreadBoundKey &outer,
+                              const ThreadBoundKey &inner) {
+    return outer.tx_min <= inner.tx_min && inner.tx_max <= outer.tx_max &&
+           outer.ty_min <= inner.ty_min && inner.ty_max <= outer.ty_max &&
+           outer.tz_min <= inner.tz_min && inner.tz_max <= outer.tz_max;
+  }
+
+  void PlanBarriers() {
+    std::vector<size_t> order(groups_.size());
+    for (size_t k = 0; k < order.size(); ++k)
+      order[k] = k;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return groups_[a].first < groups_[b].first;
+    });
+    std::vector<std::vector<size_t>> users(kNumNamedBarriers);
+    for (size_t k : order) {
+      SyncGroup &group = groups_[k];
+      for (int id = static_cast<int>(ReservedNamedBarriers::kFirstUsedBarrier);
+           id < kNumNamedBarriers && group.barrier_id < 0; ++id) {
+        if (reserved_ids_.count(id))
+          continue;
+        bool reusable = true;
+        for (size_t user : users[id]) {
+          const SyncGroup &earlier = groups_[user];
+          reusable &= earlier.last < group.first &&
+                      ContainsThreads(earlier.key, group.key);
+        }
+        if (reusable) {
+          group.barrier_id = id;
+          users[id].push_back(k);
+        }
+      }
+      if (group.barrier_id < 0)
+        group.mbarrier_index = num_mbarriers_++;
+    }
+  }
 
-    barrier_id_map_[key] = barrier_id;
-    thread_count_map_[key] = thread_count;
+  Buffer GetMBarrierBuffer() {
+    if (!mbarrier_buf_.defined()) {
+      mbarrier_buf_ = decl_buffer({IntImm(DataType::Int(32), num_mbarriers_)},
+                                  DataType::UInt(64),
+                                  "partial_sync_mbarrier", "shared");
+    }
+    return mbarrier_buf_.value();
+  }
 
-    return {barrier_id, thread_count};
+  /*!
+   * \brief Allocate the mbarriers of the groups left without a named barrier,
+   * initialized by the first thread before the body.
+   */
+  Stmt AllocateMBarriers(Stmt body) {
+    Buffer buf = GetMBarrierBuffer();
+    Array<Stmt> init;
+    for (const SyncGroup &group : groups_) {
+      if (group.barrier_id >= 0)
+        continue;
+      init.push_back(Evaluate(
+          Call(DataType::Handle(), builtin::call_extern(),
+               {StringImm("tl::mbarrier_init"),
+                BufferLoad(buf, {group.mbarrier_index}),
+                IntImm(DataType::Int(32), group.thread_count)})));
+    }
+    PrimExpr is_first_thread = const_true();
+    for (const IterVar &iv : thread_ivs_) {
+      is_first_thread = is_first_thread && iv->var == iv->dom->min;
+    }
+    Stmt sync = Evaluate(Call(DataType::Handle(), builtin::tvm_storage_sync(),
+                              {StringImm("shared")}));
+    Stmt seq = SeqStmt({IfThenElse(is_first_thread, SeqStmt::Flatten(init)),
+                        sync, std::move(body)});
+    return Allocate(buf->data, buf->dtype, buf->shape, const_true(), seq);
   }
 
   size_t CalculateThreadExtent(const IterVar &iv,
@@ -378,10 +496,49 @@ private:
       } else if (iv->thread_tag == "threadIdx.z") {
         tz_ = iv;
       }
+      if (iv->thread_tag.rfind("threadIdx", 0) == 0)
+        thread_ivs_.push_back(iv);
+      const auto *inner = op->body.as<AttrStmtNode>();
+      bool innermost =
+          !inner || inner->attr_key != tvm::tir::attr::thread_extent;
+      if (!planning_ && innermost && num_mbarriers_ > 0 &&
+          !mbarriers_allocated_ && !thread_ivs_.empty()) {
+        mbarriers_allocated_ = true;
+        auto attr = Downcast<AttrStmt>(IRMutatorWithAnalyzer::VisitStmt_(op));
+        return AttrStmt(attr->node, attr->attr_key, attr->value,
+                        AllocateMBarriers(attr->body), attr->span);
+      }
     }
     return IRMutatorWithAnalyzer::VisitStmt_(op);
   }
 
+  Stmt VisitStmt_(const ForNode *op) final {
+    return VisitLoop([&]() { return IRMutatorWithAnalyzer::VisitStmt_(op); });
+  }
+
+  Stmt VisitStmt_(const WhileNode *op) final {
+    return VisitLoop([&]() { return IRMutatorWithAnalyzer::VisitStmt_(op); });
+  }
+
+  /*!
+   * \brief Visit a loop, the groups synchronizing inside the outermost loop
+   * being live over all of its sync points.
+   */
+  template <typename FVisit> Stmt VisitLoop(FVisit visit) {
+    int loop_start = num_sync_points_;
+    ++loop_depth_;
+    Stmt stmt = visit();
+    --loop_depth_;
+    if (planning_ && loop_depth_ == 0) {
+      for (size_t k : loop_groups_) {
+        groups_[k].first = std::min(groups_[k].first, loop_start);
+        groups_[k].last = std::max(groups_[k].last, num_sync_points_ - 1);
+      }
+      loop_groups_.clear();
+    }
+    return stmt;
+  }
+
   bool IsFullThreadExtent(const IterVar &iv,
                           const arith::ConstIntBound &bound) {
     if (!analyzer_->const_int_bound.IsBound(iv->var)) {
@@ -409,8 +566,21 @@ private:
       IterVar(Range::FromMinExtent(0, 1), Var("ty"), IterVarType::kDataPar);
   IterVar tz_ =
       IterVar(Range::FromMinExtent(0, 1), Var("tz"), IterVarType::kDataPar);
-  std::unordered_map<ThreadBoundKey, size_t> barrier_id_map_;
-  std::unordered_map<ThreadBoundKey, size_t> thread_count_map_;
+  // The threadIdx axes bound so far
+  std::vector<IterVar> thread_ivs_;
+  // Whether only collecting the sync groups
+  bool planning_{false};
+  std::vector<SyncGroup> groups_;
+  std::unordered_map<ThreadBoundKey, size_t> group_index_;
+  // Named barriers already in use
+  std::unordered_set<int> reserved_ids_;
+  // Groups synchronizing within the current outermost loop
+  std::unordered_set<size_t> loop_groups_;
+  int num_sync_points_{0};
+  int loop_depth_{0};
+  int num_mbarriers_{0};
+  Optional<Buffer> mbarrier_buf_;
+  bool mbarriers_allocated_{false};
 };
 
 struct TileLangThreadSyncPlanner : public ConstrVisitor {
@@ -1117,18 +1287,16 @@ private:
       rhs_max = Substitute(rhs_max, {{old_curr_var, curr_var}});
       curr_cset = curr_cset.Substitute({{old_curr_var, curr_var}});
     }
-    prev_cset.Populate(analyzer);
-    curr_cset.Populate(analyzer);
-
-    if (analyzer.CanProve(lhs_max < rhs_min,
-                          arith::ProofStrength::kSymbolicBound)) {
-      return true;
-    }
-    if (analyzer.CanProve(rhs_max < lhs_min,
-                          arith::ProofStrength::kSymbolicBound)) {
-      return true;
-    }
-    return false;
+    Array<ObjectRef> key{lhs_max < rhs_min, rhs_max < lhs_min,
+                         prev_cset.ToKey(), curr_cset.ToKey()};
+    return ProofCache::Prove(key, [&]() {
+      prev_cset.Populate(analyzer);
+      curr_cset.Populate(analyzer);
+      return analyzer.CanProve(lhs_max < rhs_min,
+                               arith::ProofStrength::kSymbolicBound) ||
+             analyzer.CanProve(rhs_max < lhs_min,
+                               arith::ProofStrength::kSymbolicBound);
+    });
   }
   void print_access_tentry(const AccessEntry &access,
                            bool print_constr = false) {
@@ -1327,8 +1495,13 @@ private:
         curr_sub.Set(old_curr_var, curr_var);
       }
       analyzer.EnterConstraint(thread_condition);
-      prev_cset.Substitute(prev_sub).Populate(analyzer);
-      curr_cset.Substitute(curr_sub).Populate(analyzer);
+      ConstrSet prev_sub_cset = prev_cset.Substitute(prev_sub);
+      ConstrSet curr_sub_cset = curr_cset.Substitute(curr_sub);
+      prev_sub_cset.Populate(analyzer);
+      curr_sub_cset.Populate(analyzer);
+      // Everything the analyzer knows, for the ProofCache key.
+      Array<ObjectRef> analyzer_key{thread_condition, prev_sub_cset.ToKey(),
+                                    curr_sub_cset.ToKey()};
       bool provably_disjoint = false;
 
       prev_indice_bytes =
@@ -1342,6 +1515,8 @@ private:
         // Create index variable for prev Ramp
         Var prev_idx("prev_idx", DataType::Int(32));
         analyzer.Bind(prev_idx, Range::FromMinExtent(0, prev_ramp->lanes));
+        analyzer_key.push_back(Array<ObjectRef>{
+            prev_idx, Range::FromMinExtent(0, prev_ramp->lanes)});
         prev_indice_bytes = prev_ramp->base + prev_idx * prev_ramp->stride;
       }
 
@@ -1350,6 +1525,8 @@ private:
         // Create index variable for curr Ramp
         Var curr_idx("curr_idx", DataType::Int(32));
         analyzer.Bind(curr_idx, Range::FromMinExtent(0, curr_ramp->lanes));
+        analyzer_key.push_back(Array<ObjectRef>{
+            curr_idx, Range::FromMinExtent(0, curr_ramp->lanes)});
         curr_indice_bytes = curr_ramp->base + curr_idx * curr_ramp->stride;
       }
 
@@ -1367,8 +1544,10 @@ private:
           }
         }
         ICHECK(prev_indice_bytes.dtype() == curr_indice_bytes.dtype());
-        provably_disjoint =
-            analyzer.CanProve(tir::NE(prev_indice_bytes, curr_indice_bytes));
+        PrimExpr disjoint = tir::NE(prev_indice_bytes, curr_indice_bytes);
+        analyzer_key.push_back(disjoint);
+        provably_disjoint = ProofCache::Prove(
+            analyzer_key, [&]() { return analyzer.CanProve(disjoint); });
         if (!provably_disjoint) {
           // LOG(WARNING) << analyzer.z3_prover.GetModel(
           //     tir::EQ(prev_indice_bytes, curr_indice_bytes));
@@ -1446,6 +1625,8 @@ PrimFunc TileLangThreadSync(PrimFunc func, const std::string &storage_scope) {
   if (sync_scope.rank == StorageRank::kShared && sync_scope.tag.empty()) {
     stmt = ThreadSyncAfterWaitQueueInserter(sync_scope)(stmt);
   }
+  // The planner re-proves the same disjointness facts for many access pairs.
+  ProofCache::Scope proof_scope;
   TileLangThreadSyncPlanner planner(sync_scope);
   for (const auto &[_, buffer] : func->buffer_map) {
     planner.SetBufferDataToBuffer(buffer->data, buffer);
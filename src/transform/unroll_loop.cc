@@ -30,8 +30,11 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
 #include <unordered_set>
 
+#include "../op/builtin.h"
+#include "../target/utils.h"
 #include "runtime/thread_storage_scope.h"
 #include "tir/transforms/ir_utils.h"
 
@@ -97,6 +100,75 @@ private:
   std::unordered_set<Var> *var_touched_local_;
 };
 
+/*!
+ * \brief Estimated number of machine instructions of a statement once
+ * generated: one per store, evaluate and non-leaf expression node. A loop
+ * left rolled counts once, plus its compare and branch, a partially unrolled
+ * one as many times as its unroll factor.
+ */
+class CodeSizeEstimator : public StmtExprVisitor {
+public:
+  static int64_t Estimate(const Stmt &stmt) {
+    CodeSizeEstimator estimator;
+    estimator(stmt);
+    return estimator.size_;
+  }
+
+private:
+  void VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == "pragma_unroll_factor") {
+      if (const auto *factor = op->value.as<IntImmNode>()) {
+        int64_t size = Estimate(op->body);
+        size_ += size * std::max<int64_t>(factor->value, 1);
+        return;
+      }
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const ForNode *op) final {
+    size_ += 2;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode *op) final {
+    ++size_;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const EvaluateNode *op) final {
+    ++size_;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr(const PrimExpr &expr) final {
+    if (!expr.as<VarNode>() && !expr.as<IntImmNode>() &&
+        !expr.as<FloatImmNode>() && !expr.as<StringImmNode>()) {
+      ++size_;
+    }
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  int64_t size_{0};
+};
+
+/*!
+ * \brief Instructions the unrolled loops of a kernel may expand into: the
+ * instruction cache of the target divided by the instruction size, so a
+ * steady-state loop nest keeps fitting in it. Negative when unbounded.
+ */
+static int64_t DefaultCodeSizeBudget(const Optional<Target> &target) {
+  if (!target.defined())
+    return -1;
+  // 128 KiB L1.5 instruction cache, 16-byte instructions since Volta
+  if (TargetIsCuda(target.value()))
+    return 128 * 1024 / 16;
+  // 64 KiB instruction cache shared by two CUs, instructions up to 8 bytes
+  if (TargetIsRocm(target.value()))
+    return 64 * 1024 / 8;
+  return -1;
+}
+
 // The Visitor is used to check whether var is used as write index in a local
 // memory If a loop var is used as indices to a local memory, it must be
 // unrolled so the local memory access can be turned into register access.
@@ -104,10 +176,15 @@ class LoopUnroller : public StmtExprMutator {
 public:
   explicit LoopUnroller(int auto_max_step, int auto_max_depth,
                         int auto_max_extent, bool explicit_unroll,
-                        bool unroll_local_access)
+                        bool unroll_local_access,
+                        int64_t code_size_budget = -1)
       : auto_max_step_(auto_max_step), auto_max_depth_(auto_max_depth),
         auto_max_extent_(auto_max_extent), explicit_unroll_(explicit_unroll),
-        unroll_local_access_(unroll_local_access) {}
+        unroll_local_access_(unroll_local_access),
+        code_size_budget_(code_size_budget) {}
+
+  /*! \brief The loops unrolled, fully or partially, for the telemetry. */
+  ffi::Array<ffi::Map<ffi::String, ffi::Any>> decisions;
 
   Stmt VisitStmt_(const AttrStmtNode *op) final {
     if (op->attr_key == "pragma_auto_unroll_max_step") {
@@ -122,6 +199,11 @@ public:
       Stmt ret = this->VisitStmt(op->body);
       std::swap(explicit_unroll, explicit_unroll_);
       return ret;
+    } else if (op->attr_key == "pragma_unroll_factor") {
+      // The factor was chosen by the user, leave the loop to it
+      if (const auto *var = op->node.as<VarNode>())
+        factored_loops_.insert(var);
+      return StmtExprMutator::VisitStmt_(op);
     } else {
       return StmtExprMutator::VisitStmt_(op);
     }
@@ -155,6 +237,17 @@ public:
       auto_unroll = true;
     }
 
+    int64_t factor = auto_unroll ? UnrollFactor(op, value) : value;
+    if (auto_unroll && factor < value) {
+      // Over the code size budget: let the device compiler unroll the loop
+      // `factor` times instead, which also keeps the outer loops rolled.
+      normal_loop_depth_ += 1;
+      auto n = CopyOnWrite(op);
+      n->kind = ForKind::kUnrolled;
+      return AttrStmt(op->loop_var, "pragma_unroll_factor",
+                      IntImm(DataType::Int(32), factor), For(n));
+    }
+
     if (auto_unroll) {
       step_count_ *= value;
       unroll_depth_ += 1;
@@ -179,7 +272,7 @@ public:
   }
 
   PrimExpr VisitExpr_(const BufferLoadNode *op) final {
-    if (unroll_local_access_) {
+    {
       auto storage_scope =
           runtime::StorageScope::Create(GetPtrStorageScope(op->buffer->data));
       if (storage_scope.rank == runtime::StorageRank::kLocal ||
@@ -195,7 +288,7 @@ public:
 
   Stmt VisitStmt_(const BufferStoreNode *op) final {
     ++step_count_;
-    if (unroll_local_access_) {
+    {
       auto storage_scope =
           runtime::StorageScope::Create(GetPtrStorageScope(op->buffer->data));
       if (storage_scope.rank == runtime::StorageRank::kLocal ||
@@ -249,6 +342,40 @@ public:
   }
 
 private:
+  /*!
+   * \brief How many times to unroll a loop about to be unrolled, `extent`
+   * for completely.
+   *
+   * The copies of the body beyond the first are charged to the code size
+   * budget of the kernel, in program order; the first loop that does not fit
+   * is unrolled as many times as the rest of the budget allows, at least
+   * once. Loops indexing local memory are always unrolled completely: rolled,
+   * the local buffers they index could not be kept in registers and would
+   * spill to local memory, which costs more than the code size saved.
+   */
+  int64_t UnrollFactor(const ForNode *op, int extent) {
+    if (extent <= 1 || factored_loops_.count(op->loop_var.get()))
+      return extent;
+    int64_t body_size = CodeSizeEstimator::Estimate(op->body);
+    int64_t factor = extent;
+    bool budgeted = code_size_budget_ >= 0 &&
+                    !var_touched_local_.count(op->loop_var);
+    if (budgeted &&
+        code_size_ + (extent - 1) * body_size > code_size_budget_) {
+      int64_t left = std::max<int64_t>(code_size_budget_ - code_size_, 0);
+      factor = std::min<int64_t>(left / std::max<int64_t>(body_size, 1) + 1,
+                                 extent - 1);
+    }
+    code_size_ += (factor - 1) * body_size;
+    ffi::Map<ffi::String, ffi::Any> decision;
+    decision.Set("loop", op->loop_var->name_hint);
+    decision.Set("extent", static_cast<int64_t>(extent));
+    decision.Set("factor", factor);
+    decision.Set("body_instructions", body_size);
+    decisions.push_back(decision);
+    return factor;
+  }
+
   // returns the extent of the loop if it's a constant integer, otherwise return
   // -1
   int GetExtent(const ForNode *op) {
@@ -281,14 +408,26 @@ private:
   int step_count_{0};
   // set of indices touched during visit local memory
   std::unordered_set<Var> var_touched_local_;
+  // Estimated instructions the unrolled loops may add, negative if unbounded
+  int64_t code_size_budget_;
+  // Estimated instructions the unrolled loops added so far
+  int64_t code_size_{0};
+  // Loops whose unroll factor is given by a pragma_unroll_factor
+  std::unordered_set<const VarNode *> factored_loops_;
   // analyzer
   arith::Analyzer analyzer_;
 };
 
-Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
-  Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth,
-                          cfg->auto_max_extent, cfg->explicit_unroll,
-                          cfg->unroll_local_access)(stmt);
+Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg,
+                int64_t code_size_budget = -1,
+                ffi::Array<ffi::Map<ffi::String, ffi::Any>> *decisions =
+                    nullptr) {
+  LoopUnroller unroller(cfg->auto_max_step, cfg->auto_max_depth,
+                        cfg->auto_max_extent, cfg->explicit_unroll,
+                        cfg->unroll_local_access, code_size_budget);
+  Stmt ret = unroller(stmt);
+  if (decisions)
+    *decisions = unroller.decisions;
   if (!ret.same_as(stmt)) {
     return ConvertSSA(ret);
   } else {
@@ -307,7 +446,20 @@ Pass UnrollLoop() {
     if (!cfg.defined()) {
       cfg = AttrsWithDefaultValues<UnrollLoopConfig>();
     }
-    n->body = tl::UnrollLoop(f->body, cfg.value());
+    int64_t budget =
+        ctx->GetConfig<Integer>(kUnrollCodeSizeBudget, Integer(0))
+            .value()
+            ->value;
+    if (budget == 0) {
+      Optional<Target> target = f->GetAttr<Target>(tvm::attr::kTarget);
+      if (!target.defined())
+        target = Target::Current(/*allow_not_defined=*/true);
+      budget = DefaultCodeSizeBudget(target);
+    }
+    ffi::Array<ffi::Map<ffi::String, ffi::Any>> decisions;
+    n->body = tl::UnrollLoop(f->body, cfg.value(), budget, &decisions);
+    if (!decisions.empty())
+      f = WithAttr(std::move(f), attr::kUnrollDecisions, decisions);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tl.UnrollLoop", {});
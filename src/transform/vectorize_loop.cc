@@ -144,6 +144,8 @@ inline Optional<BufferLoad> ExtractBufferLoadForAtomic(const PrimExpr &expr) {
  */
 inline Op GetVectorizedAtomicOp(int vector_size) {
   switch (vector_size) {
+  case 8:
+    return atomic_addx8_elem_op();
   case 4:
     return atomic_addx4_elem_op();
   case 2:
@@ -157,14 +159,7 @@ inline Op GetVectorizedAtomicOp(int vector_size) {
  * \brief Get the max vector size supported by the given dtype for atomic ops.
  */
 inline int GetMaxAtomicVectorSize(DataType dtype, Target target) {
-  if (dtype.is_float16() || dtype.is_bfloat16()) {
-    return 2;
-  }
-  if (dtype.is_float() && dtype.bits() == 32 &&
-      TargetHasSMVersionGE(target, 90)) {
-    return 4;
-  }
-  return 1;
+  return TargetGetAtomicAddVectorSize(target, dtype);
 }
 
 // Rewrite vectorized allocation access
@@ -568,8 +563,12 @@ public:
       return tvm::ffi::GetRef<PrimExpr>(op);
     }
 
-    // Return the vectorized atomic op
-    return Call(op->dtype, GetVectorizedAtomicOp(vector_size), {dst, src});
+    // Return the vectorized atomic op, keeping the memory order if any
+    Array<PrimExpr> new_args{dst, src};
+    for (size_t i = 2; i < op->args.size(); i++) {
+      new_args.push_back(op->args[i]);
+    }
+    return Call(op->dtype, GetVectorizedAtomicOp(vector_size), new_args);
   }
   // Call
   PrimExpr VisitExpr_(const CallNode *op) final {
@@ -0,0 +1,134 @@
+/*!
+ * \file warp_group_pingpong.cc
+ * \brief Ping-pong schedule of the two consumer warpgroups of a warp
+ * specialized kernel (sm90+).
+ *
+ * Both consumer warpgroups run the pipelined loop on their own rows of the
+ * tiles. In a ping-pong schedule they take turns at the tensor cores: a
+ * warpgroup waits at the named barrier of its turn before its first gemm of
+ * the iteration, and hands the turn to the other warpgroup after its last
+ * one, so that one runs its softmax or epilogue while the other runs its
+ * gemms, as in the FlashAttention-3 and CUTLASS ping-pong kernels.
+ *
+ *   if (wg == 1) named_barrier_arrive(kPingPongWG0, 256);  // wg 0 goes first
+ *   for (k ...) {
+ *     named_barrier_sync(kPingPongWG0 + wg, 256);
+ *     gemms ...
+ *     if (wg == 0 || k < last) named_barrier_arrive(kPingPongWG1 - wg, 256);
+ *     softmax ...
+ *   }
+ *
+ * The second warpgroup skips its last hand-off, which no sync would consume.
+ * The pass runs after InjectSoftwarePipeline, on the loops marked with
+ * attr::kWarpGroupPingPong by WarpSpecialized, so that the turns follow the
+ * pipelined order of the statements.
+ */
+
+#include "warp_specialized_rewriter.h"
+
+namespace tvm {
+namespace tl {
+
+using namespace tir;
+
+class WarpGroupPingPongScheduler : public StmtExprMutator {
+private:
+  static constexpr int kWarpGroupThreads = 128;
+  static constexpr int kConsumerThreads = 2 * kWarpGroupThreads;
+
+  static bool HasGemm(const Stmt &stmt) {
+    bool has_gemm = false;
+    PostOrderVisit(stmt, [&](const ObjectRef &node) {
+      if (const auto *call = node.as<CallNode>())
+        has_gemm |= IsTensorCoreGemm(call);
+    });
+    return has_gemm;
+  }
+
+  static Stmt NamedBarrier(const Op &op, PrimExpr barrier_id) {
+    return Evaluate(Call(DataType::Handle(), op,
+                         {std::move(barrier_id),
+                          IntImm(DataType::Int(32), kConsumerThreads)}));
+  }
+
+  Stmt VisitStmt_(const AttrStmtNode *op) final {
+    if (op->attr_key == tir::attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      if (iv->thread_tag == "threadIdx.x")
+        thread_var_ = iv->var;
+    }
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const ForNode *op) final {
+    if (!op->annotations.count(attr::kWarpGroupPingPong))
+      return StmtExprMutator::VisitStmt_(op);
+    ICHECK(thread_var_.defined())
+        << "The ping-pong schedule expects a threadIdx.x binding";
+    For loop = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    loop.CopyOnWrite()->annotations.erase(attr::kWarpGroupPingPong);
+
+    Array<Stmt> seq;
+    if (const auto *body = loop->body.as<SeqStmtNode>()) {
+      seq = body->seq;
+    } else {
+      seq.push_back(loop->body);
+    }
+    int first = -1, last = -1;
+    for (int i = 0; i < static_cast<int>(seq.size()); ++i) {
+      if (HasGemm(seq[i])) {
+        first = first < 0 ? i : first;
+        last = i;
+      }
+    }
+    if (first < 0)
+      return loop;
+
+    PrimExpr wg = FloorDiv(thread_var_, kWarpGroupThreads);
+    int wg0 = static_cast<int>(ReservedNamedBarriers::kPingPongWG0);
+    int wg1 = static_cast<int>(ReservedNamedBarriers::kPingPongWG1);
+    Stmt sync = NamedBarrier(named_barrier_sync(), wg0 + wg);
+    PrimExpr is_last = EQ(loop->loop_var, loop->min + loop->extent - 1);
+    Stmt hand_off =
+        IfThenElse(Or(EQ(wg, 0), Not(is_last)),
+                   NamedBarrier(named_barrier_arrive(), wg1 - wg));
+
+    Array<Stmt> new_seq;
+    for (int i = 0; i < static_cast<int>(seq.size()); ++i) {
+      if (i == first)
+        new_seq.push_back(sync);
+      new_seq.push_back(seq[i]);
+      if (i == last)
+        new_seq.push_back(hand_off);
+    }
+    loop.CopyOnWrite()->body = SeqStmt(new_seq);
+    // The first turn goes to warpgroup 0
+    Stmt start = IfThenElse(And(EQ(wg, 1), GT(loop->extent, 0)),
+                            NamedBarrier(named_barrier_arrive(), wg0));
+    return SeqStmt({start, loop});
+  }
+
+  Var thread_var_;
+};
+
+namespace transform {
+
+using namespace tir::transform;
+
+tvm::transform::Pass ScheduleWarpGroupPingPong() {
+  auto pass_func = [](PrimFunc f, const IRModule &m, const PassContext &ctx) {
+    f.CopyOnWrite()->body = WarpGroupPingPongScheduler()(f->body);
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tl.ScheduleWarpGroupPingPong", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK() {
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("tl.transform.ScheduleWarpGroupPingPong",
+                        ScheduleWarpGroupPingPong);
+}
+
+} // namespace transform
+} // namespace tl
+} // namespace tvm
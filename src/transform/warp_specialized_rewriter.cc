@@ -136,6 +136,12 @@ private:
   std::unordered_map<const VarNode *, PrimExpr> let_var_to_expr_;
 };
 
+static bool IsSymmWait(const Stmt &stmt) {
+  const auto *eval = stmt.as<EvaluateNode>();
+  const auto *call = eval ? eval->value.as<CallNode>() : nullptr;
+  return call && call->op.same_as(symm_wait());
+}
+
 class WarpSpecializedRoleMarker : public StmtVisitor {
 public:
   WarpSpecializedRoleMarker(Map<Var, Buffer> buffer_data_to_buffer)
@@ -167,6 +173,11 @@ public:
       if (call->op.same_as(pdl_sync()) || call->op.same_as(pdl_trigger())) {
         role = Role::kBoth;
       }
+      // Both roles wait for the signals of peers, unless the wait guards a
+      // producer copy, see the SeqStmt
+      if (call->op.same_as(symm_wait())) {
+        role = Role::kBoth;
+      }
     }
     SetRole(op, role);
   }
@@ -204,6 +215,14 @@ public:
 
   void VisitStmt_(const SeqStmtNode *op) final {
     StmtVisitor::VisitStmt_(op);
+    // A wait for the signal of a peer right before a producer copy waits for
+    // the peer tile fetched by the copy: the producer polls it, and the
+    // consumers wait for the copy instead
+    for (size_t i = 0; i + 1 < op->seq.size(); ++i) {
+      if (IsSymmWait(op->seq[i]) &&
+          GetRole(op->seq[i + 1]) == Role::kProducer)
+        SetRole(op->seq[i].get(), Role::kProducer);
+    }
     auto role = GetRole(op->seq[0]);
     for (auto stmt : op->seq) {
       if (role != GetRole(stmt)) {
@@ -339,7 +358,7 @@ private:
       auto arg0 = call->args[0].as<Call>();
       // Check if this is a 1D TMA load
       auto is_1d_tma_load =
-          arg0 && !arg0.value()->op.same_as(create_tma_descriptor()) &&
+          arg0 && !IsTMADescriptorCall(arg0.value().get()) &&
           call->op.same_as(tma_load());
       if (is_1d_tma_load) {
         call.CopyOnWrite()->args.Set(2, mbar);
@@ -526,6 +545,61 @@ struct PipelineInfo {
   }
 };
 
+/*!
+ * \brief Restrict the block syncs of T.signal/T.signal_wait to the threads
+ * of a warp specialized role, through the named barrier of the role.
+ */
+class SymmSyncRewriter : public StmtExprMutator {
+public:
+  static Stmt Rewrite(const Stmt &stmt, ReservedNamedBarriers barrier,
+                      PrimExpr thread_count) {
+    SymmSyncRewriter rewriter;
+    rewriter.barrier_id_ = static_cast<int>(barrier);
+    rewriter.thread_count_ = std::move(thread_count);
+    return rewriter(stmt);
+  }
+
+private:
+  PrimExpr VisitExpr_(const CallNode *op) final {
+    auto call = Downcast<Call>(StmtExprMutator::VisitExpr_(op));
+    if ((call->op.same_as(symm_signal()) || call->op.same_as(symm_wait())) &&
+        call->args.size() == 4) {
+      Array<PrimExpr> args = call->args;
+      args.push_back(IntImm(DataType::Int(32), barrier_id_));
+      args.push_back(thread_count_);
+      return Call(call->dtype, call->op, args);
+    }
+    return call;
+  }
+
+  int barrier_id_{0};
+  PrimExpr thread_count_;
+};
+
+/*!
+ * \brief Mark the outermost consumer loops issuing tensor core gemms for the
+ * ping-pong schedule of ScheduleWarpGroupPingPong, which orders them once
+ * they are software pipelined.
+ */
+class PingPongLoopMarker : public StmtMutator {
+public:
+  static Stmt Mark(const Stmt &stmt) { return PingPongLoopMarker()(stmt); }
+
+private:
+  Stmt VisitStmt_(const ForNode *op) final {
+    bool has_gemm = false;
+    PostOrderVisit(op->body, [&](const ObjectRef &node) {
+      if (const auto *call = node.as<CallNode>())
+        has_gemm |= IsTensorCoreGemm(call);
+    });
+    if (!has_gemm || op->kind != ForKind::kSerial)
+      return StmtMutator::VisitStmt_(op);
+    For loop = tvm::ffi::GetRef<For>(op);
+    loop.CopyOnWrite()->annotations.Set(attr::kWarpGroupPingPong, Integer(1));
+    return loop;
+  }
+};
+
 class GroupOpRewriter : public StmtExprMutator {
 public:
   GroupOpRewriter(const PipelineInfo &pipeline_info)
@@ -748,8 +822,10 @@ private:
         // We should still emit the (optionally guarded) statement without
         // inserting any mbarrier for it instead of failing.
         if (map.release[i].empty()) {
-          LOG(WARNING) << "Producer doesn't have corresponding consumer: "
-                       << seq_transformed[i];
+          // The wait for a peer signal guarding the next copy has none
+          if (!IsSymmWait(op->seq[i]))
+            LOG(WARNING) << "Producer doesn't have corresponding consumer: "
+                         << seq_transformed[i];
           block_stmt.push_back(seq_transformed[i]);
           new_body.push_back(
               MakeGroupBlock(block_stmt.size() == 1
@@ -1271,6 +1347,23 @@ private:
     consumer_code = ThreadIdxRewriter::Rewrite(
         consumer_code, thread_iv_->var, thread_iv_->var, consumer_thread_extent,
         !disable_shuffle_elect_);
+    producer_code = SymmSyncRewriter::Rewrite(
+        producer_code, ReservedNamedBarriers::kSymmProducer,
+        producer_thread_extent);
+    consumer_code = SymmSyncRewriter::Rewrite(
+        consumer_code, ReservedNamedBarriers::kSymmConsumer,
+        consumer_thread_extent);
+    if (block->annotations.count(attr::kWarpGroupPingPong)) {
+      // Each consumer warpgroup computes its own rows of the tiles, two of
+      // them take turns at the tensor cores
+      if (is_const_int(consumer_thread_extent, 256)) {
+        consumer_code = PingPongLoopMarker::Mark(consumer_code);
+      } else {
+        LOG(WARNING) << "The ping-pong schedule needs two consumer "
+                        "warpgroups (256 threads) but the kernel has "
+                     << consumer_thread_extent << ", it is ignored";
+      }
+    }
     need_update_thread_extent_ = true;
 
     ICHECK(producer.num_barriers_ == consumer.num_barriers_)
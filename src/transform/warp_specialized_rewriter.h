@@ -18,6 +18,7 @@
 
 #include "../op/builtin.h"
 #include "./common/collector.h"
+#include "./common/thread_sync_types.h"
 #include "runtime/thread_storage_scope.h"
 #include "tir/transforms/ir_utils.h"
 
@@ -95,5 +96,18 @@ private:
   bool has_warp_specialization_{false};
 };
 
+/*!
+ * \brief Whether the call issues a tensor core gemm, as lowered by T.gemm
+ */
+inline bool IsTensorCoreGemm(const CallNode *call) {
+  if (call->op.same_as(tl_gemm()) || call->op.same_as(tl_gemm_sp()) ||
+      call->op.same_as(ptx_wgmma_ss()) || call->op.same_as(ptx_wgmma_rs()))
+    return true;
+  if (!call->op.same_as(builtin::call_extern()) || call->args.empty())
+    return false;
+  const auto *name = call->args[0].as<StringImmNode>();
+  return name != nullptr && name->value.rfind("tl::gemm", 0) == 0;
+}
+
 } // namespace tl
 } // namespace tvm
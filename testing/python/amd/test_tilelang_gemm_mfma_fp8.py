@@ -0,0 +1,129 @@
+import pytest
+import torch
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+from tilelang.intrinsics.mfma_macro_generator import MatrixCoreIntrinEmitter
+from tilelang.utils.tensor import map_torch_type
+
+tilelang.testing.set_random_seed(0)
+
+
+@pytest.mark.parametrize(
+    "a_dtype, b_dtype, is_gfx950, k_dim, suffix",
+    [
+        (T.float8_e4m3fnuz, T.float8_e4m3fnuz, False, 32, "f32_16x16x32_fp8_fp8"),
+        (T.float8_e5m2fnuz, T.float8_e5m2fnuz, False, 32, "f32_16x16x32_bf8_bf8"),
+        (T.float8_e4m3fnuz, T.float8_e5m2fnuz, False, 32, "f32_16x16x32_bf8_fp8"),
+        (T.float8_e4m3fn, T.float8_e4m3fn, False, 32, "f32_16x16x32_fp8_fp8"),
+        (T.float8_e4m3fn, T.float8_e5m2, True, 128, "f32_16x16x128_f8f6f4"),
+    ],
+)
+def test_mfma_fp8_variant(a_dtype, b_dtype, is_gfx950, k_dim, suffix):
+    emitter = MatrixCoreIntrinEmitter(
+        a_dtype=str(a_dtype),
+        b_dtype=str(b_dtype),
+        accum_dtype=T.float32,
+        b_transposed=True,
+        warp_row_tiles=32,
+        warp_col_tiles=32,
+        chunk=128,
+        is_gfx950=is_gfx950,
+    )
+    assert emitter.k_dim == k_dim
+    assert emitter.mfma_suffix == suffix
+    assert emitter.local_size_a == k_dim * 16 // 64
+    if is_gfx950:
+        assert emitter._f8f6f4_name(scaled=True) == "tl::mfma_scale_f32_16x16x128_f8f6f4<1, 0>"
+
+
+def _require_gfx950():
+    arch = torch.cuda.get_device_properties(0).gcnArchName
+    if not arch.startswith("gfx950"):
+        pytest.skip(f"the f8f6f4 mfma requires CDNA4 (gfx950), got {arch}")
+
+
+def matmul(M, N, K, block_M, block_N, block_K, in_dtype, threads=256):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), in_dtype),
+        B: T.Tensor((N, K), in_dtype),
+        C: T.Tensor((M, N), T.float32),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), in_dtype)
+            B_shared = T.alloc_shared((block_N, block_K), in_dtype)
+            C_frag = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_frag)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[bx * block_N, k * block_K], B_shared)
+                T.gemm(A_shared, B_shared, C_frag, transpose_B=True)
+            T.copy(C_frag, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_rocm
+@pytest.mark.parametrize("in_dtype", [T.float8_e4m3fn, T.float8_e5m2])
+def test_gemm_f8f6f4(in_dtype):
+    _require_gfx950()
+    M, N, K = 256, 256, 512
+    kernel = tilelang.compile(matmul(M, N, K, 128, 128, 128, in_dtype), out_idx=[2])
+    assert "mfma_f32_16x16x128_f8f6f4" in kernel.get_kernel_source()
+
+    torch_dtype = map_torch_type(in_dtype)
+    A = torch.randn(M, K, device="cuda").to(torch_dtype)
+    B = torch.randn(N, K, device="cuda").to(torch_dtype)
+    ref = A.float() @ B.float().T
+    torch.testing.assert_close(kernel(A, B), ref, rtol=1e-2, atol=1e-2)
+
+
+def matmul_blockscaled(M, N, K, block_M, block_N, block_K, in_dtype, threads=256):
+    num_sf = block_K // 32
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), in_dtype),
+        B: T.Tensor((N, K), in_dtype),
+        SFA: T.Tensor((M, K // 32), T.uint8),
+        SFB: T.Tensor((N, K // 32), T.uint8),
+        C: T.Tensor((M, N), T.float32),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), in_dtype)
+            B_shared = T.alloc_shared((block_N, block_K), in_dtype)
+            SFA_shared = T.alloc_shared((block_M, num_sf), T.uint8)
+            SFB_shared = T.alloc_shared((block_N, num_sf), T.uint8)
+            C_frag = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_frag)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[bx * block_N, k * block_K], B_shared)
+                T.copy(SFA[by * block_M, k * num_sf], SFA_shared)
+                T.copy(SFB[bx * block_N, k * num_sf], SFB_shared)
+                T.gemm_blockscaled(A_shared, B_shared, C_frag, SFA_shared, SFB_shared)
+            T.copy(C_frag, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_rocm
+def test_gemm_blockscaled_gfx950():
+    _require_gfx950()
+    M, N, K = 256, 256, 512
+    kernel = tilelang.compile(matmul_blockscaled(M, N, K, 128, 128, 128, T.float8_e4m3fn), out_idx=[4])
+    assert "mfma_scale_f32_16x16x128_f8f6f4" in kernel.get_kernel_source()
+
+    A = torch.randn(M, K, device="cuda").to(torch.float8_e4m3fn)
+    B = torch.randn(N, K, device="cuda").to(torch.float8_e4m3fn)
+    SFA = torch.randint(124, 131, (M, K // 32), device="cuda", dtype=torch.uint8)
+    SFB = torch.randint(124, 131, (N, K // 32), device="cuda", dtype=torch.uint8)
+    scale_a = torch.exp2(SFA.float() - 127).repeat_interleave(32, dim=1)
+    scale_b = torch.exp2(SFB.float() - 127).repeat_interleave(32, dim=1)
+    ref = (A.float() * scale_a) @ (B.float() * scale_b).T
+    torch.testing.assert_close(kernel(A, B, SFA, SFB), ref, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,92 @@
+import pytest
+import torch
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+from tilelang.layout import make_cdna_metadata_layout
+from tilelang.intrinsics.mfma_macro_generator import SparseMatrixCoreIntrinEmitter
+from tilelang.utils.sparse import compress, randn_semi_sparse
+from tilelang.utils.tensor import map_torch_type
+
+tilelang.testing.set_random_seed(0)
+
+
+def matmul_sp(M, N, K, block_M, block_N, block_K, trans_A, trans_B, in_dtype, accum_dtype, metadata_dtype, num_stages, threads):
+    E_factor = SparseMatrixCoreIntrinEmitter.E_FACTOR_MAP[in_dtype][metadata_dtype]
+    A_sparse_shape = (M, K // 2) if not trans_A else (K // 2, M)
+    B_shape = (N, K) if trans_B else (K, N)
+    A_shared_shape = (block_M, block_K // 2) if not trans_A else (block_K // 2, block_M)
+    B_shared_shape = (block_N, block_K) if trans_B else (block_K, block_N)
+
+    @T.prim_func
+    def main(
+        A_sparse: T.Tensor(A_sparse_shape, in_dtype),
+        E: T.Tensor((M, K // E_factor), metadata_dtype),
+        B: T.Tensor(B_shape, in_dtype),
+        C: T.Tensor((M, N), accum_dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared(A_shared_shape, in_dtype)
+            B_shared = T.alloc_shared(B_shared_shape, in_dtype)
+            E_shared = T.alloc_shared((block_M, block_K // E_factor), metadata_dtype)
+            C_frag = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.annotate_layout(
+                {
+                    E: make_cdna_metadata_layout(E, mma_dtype=in_dtype),
+                    E_shared: make_cdna_metadata_layout(E_shared, mma_dtype=in_dtype),
+                }
+            )
+            T.clear(C_frag)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(E[by * block_M, k * block_K // E_factor], E_shared)
+                if trans_A:
+                    T.copy(A_sparse[k * block_K // 2, by * block_M], A_shared)
+                else:
+                    T.copy(A_sparse[by * block_M, k * block_K // 2], A_shared)
+                if trans_B:
+                    T.copy(B[bx * block_N, k * block_K], B_shared)
+                else:
+                    T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm_sp_v2(A_shared, E_shared, B_shared, C_frag, trans_A, trans_B)
+            T.copy(C_frag, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def run_gemm_sp_mfma(M, N, K, trans_A, trans_B, in_dtype, metadata_dtype, block_M, block_N, block_K, num_stages=2, threads=256):
+    arch = torch.cuda.get_device_properties(0).gcnArchName
+    if not arch.startswith(("gfx94", "gfx95")):
+        pytest.skip(f"sparse mfma requires CDNA3, got {arch}")
+
+    program = matmul_sp(M, N, K, block_M, block_N, block_K, trans_A, trans_B, in_dtype, T.float32, metadata_dtype, num_stages, threads)
+    kernel = tilelang.compile(program, out_idx=[3])
+    assert "tl::smfmac_f32_16x16x32" in kernel.get_kernel_source()
+
+    torch_dtype = map_torch_type(in_dtype)
+    A = randn_semi_sparse(M, K, dtype=torch_dtype, device="cuda", transposed=trans_A)
+    B = torch.randn((N, K) if trans_B else (K, N), device="cuda", dtype=torch.float32).to(torch_dtype)
+    A_sparse, E = compress(A, transposed=trans_A, arch=arch, e_dtype=map_torch_type(metadata_dtype))
+    C = kernel(A_sparse, E, B)
+
+    A_ref = A.T if trans_A else A
+    B_ref = B.T if trans_B else B
+    ref = torch.matmul(A_ref.to(torch.float32), B_ref.to(torch.float32))
+    torch.testing.assert_close(C, ref, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_rocm
+@pytest.mark.parametrize(
+    "M, N, K, trans_A, trans_B, in_dtype, metadata_dtype",
+    [
+        (256, 256, 256, False, False, T.float16, T.uint8),
+        (256, 256, 256, False, True, T.float16, T.int16),
+        (256, 256, 256, True, False, T.float16, T.uint8),
+        (256, 256, 256, False, True, T.bfloat16, T.int32),
+    ],
+)
+def test_gemm_sp_mfma(M, N, K, trans_A, trans_B, in_dtype, metadata_dtype):
+    run_gemm_sp_mfma(M, N, K, trans_A, trans_B, in_dtype, metadata_dtype, 128, 128, 64)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,90 @@
+import pytest
+import torch
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+from tilelang.utils.tensor import map_torch_type
+
+tilelang.testing.set_random_seed(0)
+
+
+def matmul(M, N, K, block_M, block_N, block_K, trans_A, trans_B, in_dtype, accum_dtype, num_stages, threads, a_in_fragment=False):
+    A_shape = (K, M) if trans_A else (M, K)
+    B_shape = (N, K) if trans_B else (K, N)
+    A_shared_shape = (block_K, block_M) if trans_A else (block_M, block_K)
+    B_shared_shape = (block_N, block_K) if trans_B else (block_K, block_N)
+
+    @T.prim_func
+    def main(
+        A: T.Tensor(A_shape, in_dtype),
+        B: T.Tensor(B_shape, in_dtype),
+        C: T.Tensor((M, N), accum_dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared(A_shared_shape, in_dtype)
+            B_shared = T.alloc_shared(B_shared_shape, in_dtype)
+            A_frag = T.alloc_fragment(A_shared_shape, in_dtype)
+            C_frag = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_frag)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                if trans_A:
+                    T.copy(A[k * block_K, by * block_M], A_shared)
+                else:
+                    T.copy(A[by * block_M, k * block_K], A_shared)
+                if trans_B:
+                    T.copy(B[bx * block_N, k * block_K], B_shared)
+                else:
+                    T.copy(B[k * block_K, bx * block_N], B_shared)
+                if a_in_fragment:
+                    T.copy(A_shared, A_frag)
+                    T.gemm(A_frag, B_shared, C_frag, trans_A, trans_B)
+                else:
+                    T.gemm(A_shared, B_shared, C_frag, trans_A, trans_B)
+            T.copy(C_frag, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def run_gemm_wmma(M, N, K, trans_A, trans_B, in_dtype, block_M, block_N, block_K, num_stages=2, threads=128, a_in_fragment=False):
+    arch = torch.cuda.get_device_properties(0).gcnArchName
+    if not arch.startswith(("gfx11", "gfx12")):
+        pytest.skip(f"wmma requires RDNA3 or RDNA4, got {arch}")
+
+    program = matmul(
+        M, N, K, block_M, block_N, block_K, trans_A, trans_B, in_dtype, T.float32, num_stages, threads, a_in_fragment=a_in_fragment
+    )
+    kernel = tilelang.compile(program, out_idx=[2])
+    assert "__builtin_amdgcn_wmma_f32_16x16x16" in kernel.get_kernel_source()
+
+    torch_dtype = map_torch_type(in_dtype)
+    A = torch.randn((K, M) if trans_A else (M, K), device="cuda", dtype=torch.float32).to(torch_dtype)
+    B = torch.randn((N, K) if trans_B else (K, N), device="cuda", dtype=torch.float32).to(torch_dtype)
+    C = kernel(A, B)
+
+    A_ref = A.T if trans_A else A
+    B_ref = B.T if trans_B else B
+    ref = torch.matmul(A_ref.to(torch.float32), B_ref.to(torch.float32))
+    torch.testing.assert_close(C, ref, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_rocm
+@pytest.mark.parametrize(
+    "M, N, K, trans_A, trans_B, in_dtype",
+    [
+        (256, 256, 256, False, False, T.float16),
+        (256, 256, 256, False, True, T.float16),
+        (256, 256, 256, True, False, T.float16),
+        (256, 256, 256, False, True, T.bfloat16),
+    ],
+)
+def test_gemm_wmma(M, N, K, trans_A, trans_B, in_dtype):
+    run_gemm_wmma(M, N, K, trans_A, trans_B, in_dtype, 128, 128, 32)
+
+
+@tilelang.testing.requires_rocm
+def test_gemm_wmma_rs():
+    run_gemm_wmma(256, 256, 256, False, True, T.float16, 128, 128, 32, a_in_fragment=True)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,47 @@
+import torch
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+
+
+def axpy_norm(M, N, dtype=T.float16, threads=128):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+        C: T.Tensor((M, N), dtype),
+        S: T.Tensor((M,), T.float32),
+    ):
+        with T.Kernel(M, threads=threads) as bx:
+            x = T.alloc_fragment((N,), dtype)
+            y = T.alloc_fragment((N,), T.float32)
+            s = T.alloc_fragment((1,), T.float32)
+            for j in T.Parallel(N):
+                x[j] = A[bx, j] * B[bx, j] + A[bx, j]
+            for j in T.Parallel(N):
+                y[j] = x[j] * x[j]
+            T.reduce_sum(y, s, dim=0)
+            T.copy(x, C[bx, :])
+            S[bx] = s[0]
+
+    return main
+
+
+@tilelang.testing.requires_rocm
+def test_packed_fp16_math():
+    M, N = 64, 1024
+    kernel = tilelang.compile(axpy_norm(M, N), out_idx=[2, 3])
+    source = kernel.get_kernel_source()
+    assert "float16x2" in source
+    assert "__builtin_convertvector" in source
+
+    a = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    b = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    c, s = kernel(a, b)
+    ref = a * b + a
+    torch.testing.assert_close(c, ref, rtol=1e-2, atol=1e-2)
+    torch.testing.assert_close(s, ref.float().pow(2).sum(1), rtol=1e-2, atol=1e-1)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,49 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+from tilelang.engine import analyze_resources
+
+
+def matmul(M, N, K, block_M, block_N, block_K, threads, num_stages=2, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_analyze_resources_matmul():
+    with tilelang.transform.PassContext(config={tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True}):
+        (info,) = analyze_resources(matmul(1024, 1024, 1024, 128, 128, 32, threads=128), target="cuda")
+    assert info.threads_per_block == 128
+    # Two pipeline stages of the A and B tiles in fp16.
+    assert info.smem_bytes >= 2 * (128 * 32 + 32 * 128) * 2
+    # 128 x 128 fp32 accumulators spread over 128 threads.
+    assert info.local_bytes_per_thread >= 128 * 128 * 4 // 128
+    assert info.feasible
+
+
+@tilelang.testing.requires_cuda
+def test_analyze_resources_infeasible():
+    # 256 x 256 fp32 accumulators over 128 threads need 512 registers per thread.
+    (info,) = analyze_resources(matmul(1024, 1024, 1024, 256, 256, 32, threads=128), target="cuda")
+    assert info.spills
+    assert not info.feasible
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,79 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+from tilelang.engine import analyze_traffic
+from tilelang.engine.traffic import KernelTrafficReport, OperandTraffic
+
+
+def matmul(M, N, K, block_M, block_N, block_K, threads, num_stages=2, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def test_traffic_report_roofline():
+    report = KernelTrafficReport(
+        name="main",
+        grid_blocks=4,
+        flops=8000,
+        mma_flops=8000,
+        operands={
+            "A": OperandTraffic("A", "float16", bytes_read=400, footprint_bytes=100),
+            "C": OperandTraffic("C", "float16", bytes_written=100, footprint_bytes=100),
+        },
+        peak_flops=1000.0,
+        peak_bandwidth=10.0,
+    )
+    assert report.global_bytes == 500
+    assert report.dram_bytes == 200
+    assert report.operands["A"].reuse == 4.0
+    assert report.arithmetic_intensity == 40.0
+    assert report.ridge_point == 100.0
+    assert report.bound == "memory"
+    assert report.predicted_time_s == 20.0
+    assert KernelTrafficReport("main", 1, 0, 0).bound is None
+
+
+@tilelang.testing.requires_cuda
+def test_analyze_traffic_matmul():
+    M, N, K, block_M, block_N, block_K = 1024, 512, 256, 128, 64, 32
+    (report,) = analyze_traffic(matmul(M, N, K, block_M, block_N, block_K, threads=128), target="cuda")
+    assert report.exact
+    assert report.grid_blocks == (M // block_M) * (N // block_N)
+    assert report.mma_flops == 2 * M * N * K
+    # Every block streams its rows of A and columns of B through shared memory
+    assert report.operands["A"].bytes_read == M * K * 2 * (N // block_N)
+    assert report.operands["B"].bytes_read == K * N * 2 * (M // block_M)
+    assert report.operands["C"].bytes_written == M * N * 2
+    assert report.operands["A"].reuse == N // block_N
+    assert report.dram_bytes == (M * K + K * N + M * N) * 2
+    assert report.shared_bytes >= 2 * report.global_bytes_read
+
+
+@tilelang.testing.requires_cuda
+def test_jit_kernel_traffic_report():
+    kernel = tilelang.compile(matmul(512, 512, 512, 128, 128, 32, threads=128))
+    (report,) = kernel.traffic_report()
+    assert report is kernel.traffic_report()[0]
+    assert report.mma_flops == 2 * 512**3
+    assert report.bound in ("compute", "memory")
+    assert report.predicted_time_s > 0
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
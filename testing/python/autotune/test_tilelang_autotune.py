@@ -3,7 +3,7 @@ import logging
 
 import tilelang.testing
 import tilelang.language as T
-from tilelang.autotuner import AutoTuner
+from tilelang.autotuner import AutoTuner, BudgetObjective, ModelGuidedSearch, SMTimeObjective
 
 # Configure logger
 logger = logging.getLogger(__name__)
@@ -117,7 +117,7 @@ def get_configs(M, N, K, with_roller=False):
     return configs
 
 
-def matmul(M, N, K, with_roller):
+def matmul(M, N, K, with_roller, pipeline=False, search=None, prune_ratio=None, objective=None):
     """
     Create an autotuned matrix multiplication kernel for matrices of shape:
       - A: (M, K)
@@ -255,6 +255,9 @@ def matmul(M, N, K, with_roller):
         .set_profile_args(
             ref_prog=ref_program,
         )
+        .set_pipeline(pipeline)
+        .set_search(search, prune_ratio)
+        .set_objective(objective)
     )
     return autotuner.run(warmup=3, rep=20)
 
@@ -271,5 +274,50 @@ def test_autotune_matmul():
     matmul(1024, 1024, 1024, with_roller=False)
 
 
+@tilelang.testing.requires_cuda
+def test_autotune_matmul_pipelined():
+    result = matmul(1024, 1024, 1024, with_roller=False, pipeline=True)
+    assert result.config is not None
+
+
+@tilelang.testing.requires_cuda
+def test_autotune_matmul_model_guided():
+    result = matmul(1024, 1024, 1024, with_roller=False, search=ModelGuidedSearch(max_trials=4), prune_ratio=1.5)
+    assert result.config is not None
+
+
+@tilelang.testing.requires_cuda
+def test_autotune_matmul_budget_objective():
+    budget = 32 * 1024
+    result = matmul(1024, 1024, 1024, with_roller=False, objective=BudgetObjective(max_smem_bytes=budget))
+    assert result.objective == "budget"
+    assert result.metrics["smem_bytes"] <= budget
+    assert result.score == result.latency
+
+
+def test_objective_scores():
+    budget = BudgetObjective(max_smem_bytes=48 * 1024, min_blocks_per_sm=2)
+    assert budget.score(1.0, {"smem_bytes": 64 * 1024, "registers_per_thread": 96, "blocks_per_sm": 2}) == float("inf")
+    assert budget.score(1.0, {"smem_bytes": 32 * 1024, "registers_per_thread": 96, "blocks_per_sm": 1}) == float("inf")
+    assert budget.score(1.0, {"smem_bytes": 32 * 1024, "registers_per_thread": 96, "blocks_per_sm": 2}) == 1.0
+    # a launch on half of the SMs may be 1.5x slower and still win when co-scheduled
+    sm_time = SMTimeObjective(num_sms=132)
+    assert sm_time.score(1.5, {"sms": 66, "num_sms": 132}) < sm_time.score(1.0, {"sms": 132, "num_sms": 132})
+
+
+def test_model_guided_search_budget():
+    configs = [{"block_M": m, "block_N": n, "enable_rasteration": r} for m in (32, 64, 128, 256) for n in (32, 64, 128, 256) for r in (True, False)]
+    strategy = ModelGuidedSearch(max_trials=12)
+    strategy.reset(configs)
+    evaluated = []
+    while batch := strategy.propose(4):
+        for i in batch:
+            config = configs[i]
+            latency = abs(config["block_M"] - 128) + abs(config["block_N"] - 128) + (0 if config["enable_rasteration"] else 1) + 1
+            strategy.update(i, latency)
+            evaluated.append(i)
+    assert len(evaluated) == len(set(evaluated)) == 12
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
@@ -0,0 +1,59 @@
+import multiprocessing
+import os
+import tempfile
+
+import tilelang.testing
+from tilelang.autotuner.database import TuningDatabase, op_signature, shape_distance, shape_of
+
+
+def _write_records(path, worker, count):
+    database = TuningDatabase(path)
+    for i in range(count):
+        database.put("op", "dev", {"M": 64 * (worker * count + i + 1)}, [({"block_M": 64}, 1.0)])
+
+
+def test_shape_distance():
+    assert shape_distance({"M": 1024, "N": 1024}, {"M": 1024, "N": 1024}) == 0.0
+    assert shape_distance({"M": 1024}, {"M": 2048}) == shape_distance({"M": 64}, {"M": 128})
+    # shapes naming other dimensions are never neighbors
+    assert shape_distance({"M": 1024}, {"N": 1024}) == float("inf")
+    params = {"M": 1024, "N": 512, "dtype": "float16", "trans_b": True}
+    assert shape_of(params) == {"M": 1024, "N": 512}
+    # the shape does not change the op, its dtype does
+    assert op_signature("src", params) == op_signature("src", dict(params, M=4096))
+    assert op_signature("src", params) != op_signature("src", dict(params, dtype="bfloat16"))
+
+
+def test_nearest_candidates():
+    with tempfile.TemporaryDirectory() as tmp:
+        database = TuningDatabase(os.path.join(tmp, "db.jsonl"))
+        assert database.nearest("op", "dev", {"M": 1024}) == []
+        database.put("op", "dev", {"M": 1024, "N": 1024}, [({"block_M": 128}, 1.0), ({"block_M": 64}, 2.0)])
+        database.put("op", "dev", {"M": 8192, "N": 8192}, [({"block_M": 256}, 3.0), ({"block_M": 128}, 4.0)])
+        database.put("op", "other", {"M": 2048, "N": 2048}, [({"block_M": 32}, 1.0)])
+        ranked = database.nearest("op", "dev", {"M": 2048, "N": 1024})
+        assert [record["shape"]["M"] for _, record in ranked] == [1024, 8192]
+        assert database.lookup("op", "dev", {"M": 1024, "N": 1024})["configs"][0]["latency"] == 1.0
+        assert database.lookup("op", "dev", {"M": 2048, "N": 1024}) is None
+        # best configs of the closest shape first, no repeats
+        configs = database.candidates("op", "dev", {"M": 2048, "N": 1024}, neighbors=2, top_configs=2)
+        assert configs == [{"block_M": 128}, {"block_M": 64}, {"block_M": 256}]
+        # a retuned shape replaces its previous record
+        database.put("op", "dev", {"M": 1024, "N": 1024}, [({"block_M": 32}, 0.5)])
+        assert TuningDatabase(database.path).candidates("op", "dev", {"M": 1024, "N": 1024}, 1, 1) == [{"block_M": 32}]
+
+
+def test_concurrent_writers():
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "db.jsonl")
+        workers = [multiprocessing.Process(target=_write_records, args=(path, w, 50)) for w in range(4)]
+        for worker in workers:
+            worker.start()
+        for worker in workers:
+            worker.join()
+        ranked = TuningDatabase(path).nearest("op", "dev", {"M": 64}, k=1000)
+        assert len(ranked) == 200
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
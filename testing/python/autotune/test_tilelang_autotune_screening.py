@@ -0,0 +1,73 @@
+import itertools
+
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+from tilelang.autotuner import AutoTuner
+
+
+def matmul(M, N, K, block_M=64, block_N=64, block_K=32, num_stages=0, threads=128):
+    dtype = T.float16
+    accum_dtype = T.float32
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((N, K), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_N, block_K), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[bx * block_N, k * block_K], B_shared)
+                T.gemm(A_shared, B_shared, C_local, transpose_B=True)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def get_configs():
+    iter_params = dict(block_M=[64, 128], block_N=[64, 128], num_stages=[0, 2])
+    return [dict(zip(iter_params, values)) for values in itertools.product(*iter_params.values())]
+
+
+@tilelang.testing.requires_cuda
+def test_fast_compile_matmul():
+    import torch
+
+    kernel = tilelang.compile(matmul(1000, 1024, 512), out_idx=[-1], pass_configs={tilelang.PassConfigKey.TL_FAST_COMPILE: True})
+    a = torch.randn(1000, 512, dtype=torch.float16, device="cuda")
+    b = torch.randn(1024, 512, dtype=torch.float16, device="cuda")
+    torch.testing.assert_close(kernel(a, b), a @ b.T, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_autotune_screening():
+    import torch
+
+    M = N = K = 1024
+
+    def kernel(block_M=None, block_N=None, num_stages=None):
+        return matmul(M, N, K, block_M=block_M, block_N=block_N, num_stages=num_stages)
+
+    result = (
+        AutoTuner.from_kernel(kernel=kernel, configs=get_configs())
+        .set_compile_args(out_idx=[-1])
+        .set_profile_args(ref_prog=lambda A, B: A @ B.T)
+        .set_screening(top_k=2)
+        .run(warmup=3, rep=20)
+    )
+    assert result.config in get_configs()
+    # The returned kernel is compiled with every optimization
+    assert tilelang.PassConfigKey.TL_FAST_COMPILE not in (result.kernel.pass_configs or {})
+    a = torch.randn(M, K, dtype=torch.float16, device="cuda")
+    b = torch.randn(N, K, dtype=torch.float16, device="cuda")
+    torch.testing.assert_close(result.kernel(a, b), a @ b.T, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
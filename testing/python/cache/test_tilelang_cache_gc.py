@@ -0,0 +1,73 @@
+import os
+import time
+
+import pytest
+import tilelang.testing
+from tilelang.cache.gc import DEVICE_BINARY_DIR, cache_stats, collect_garbage, parse_size
+from tilelang.cache.index import CacheIndex
+
+
+def _make_kernel(cache_dir, key, size, accessed):
+    path = cache_dir / key
+    path.mkdir()
+    (path / "kernel.so").write_bytes(b"\0" * size)
+    os.utime(path, (accessed, accessed))
+    return path
+
+
+def test_parse_size():
+    assert parse_size("512") == 512
+    assert parse_size("4K") == 4096
+    assert parse_size("1.5m") == 3 << 19
+    assert parse_size("20GiB") == 20 << 30
+    assert parse_size("0") is None
+    assert parse_size(None) is None
+    with pytest.raises(ValueError):
+        parse_size("big")
+
+
+def test_index_records_accesses_and_evicts(tmp_path):
+    index = CacheIndex(str(tmp_path))
+    keys = [f"{i:064x}" for i in range(3)]
+    for key in keys:
+        index.put(key, "__global__ void k() {}" * 64, "host", b"params")
+    before = index.last_access()
+    index.touch(keys[0])
+    assert index.last_access()[keys[0]] >= before[keys[0]]
+
+    index.evict([keys[1]])
+    assert index.get(keys[1]) is None
+    # Another process still holding the old pack rescans the new one
+    reader = CacheIndex(str(tmp_path))
+    assert reader.get(keys[0]) == ("__global__ void k() {}" * 64, "host", b"params")
+    assert reader.get(keys[2]) is not None
+    assert set(reader.last_access()) == {keys[0], keys[2]}
+
+
+def test_collect_garbage_evicts_least_recently_used(tmp_path):
+    now = time.time()
+    kernels = [_make_kernel(tmp_path, f"{i:064x}", 1000, now - 100 * (4 - i)) for i in range(4)]
+    binaries = tmp_path / DEVICE_BINARY_DIR
+    binaries.mkdir()
+    cubin = binaries / "kernel.cubin"
+    cubin.write_bytes(b"\0" * 1000)
+    os.utime(cubin, (now - 1000, now - 1000))
+    CacheIndex(str(tmp_path)).touch(kernels[0].name)
+
+    stats = cache_stats(str(tmp_path))
+    assert (stats.num_kernels, stats.num_device_binaries) == (4, 1)
+    assert stats.kernel_bytes == 4000
+
+    assert collect_garbage(str(tmp_path), max_size=10000) == []
+    planned = collect_garbage(str(tmp_path), max_size=4000, dry_run=True)
+    assert cubin.exists() and all(kernel.exists() for kernel in kernels)
+    evicted = collect_garbage(str(tmp_path), max_size=4000)
+    assert [entry.path for entry in evicted] == [entry.path for entry in planned]
+    # Down to 80% of the budget, the touched kernel is the most recent one
+    assert [entry.path for entry in evicted] == [str(cubin), str(kernels[1])]
+    assert not cubin.exists() and not kernels[1].exists()
+    assert all(kernels[i].exists() for i in (0, 2, 3))
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
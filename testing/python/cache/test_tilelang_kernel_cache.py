@@ -15,10 +15,14 @@
 # - os.replace() requires source and dest on same filesystem (atomic rename)
 #
 # Technical Details:
-# - Cache key is based on func.script(show_meta=True) hash
+# - Cache key is based on the structural hash of the PrimFunc
 # - Python comments do NOT affect cache key (not in TIR)
 # - Must use .with_attr("global_symbol", ...) to create unique cache keys
 
+import concurrent.futures
+import threading
+import time
+
 import pytest
 import tilelang
 import tilelang.language as T
@@ -28,6 +32,8 @@ import uuid
 from pathlib import Path
 from tilelang.env import env
 from tilelang.cache import _dispatch_map
+from tilelang.cache.index import INDEX_FILE_NAME, get_cache_index
+from tilelang.jit.adapter.shared_module import num_shared_modules
 
 BACKENDS = [
     "tvm_ffi",
@@ -286,5 +292,128 @@ def test_cache_isolation_between_tests(clean_cache_env, backend):
     assert len(cache_files_after) > 0, f"Cache files should be created, found: {cache_files_after}"
 
 
+@tilelang.testing.requires_cuda
+@pytest.mark.parametrize("backend", ["tvm_ffi", "cython", "nvrtc"])
+def test_cache_hit_from_index(clean_cache_env, backend):
+    """A cache hit only needs the kernel library once the index holds the record."""
+    counter = PostProcCounter()
+    counter.register_callback(backend)
+
+    unique_id = uuid.uuid4().hex[:8]
+
+    @T.prim_func
+    def simple(A: T.Tensor((128,), T.float32), B: T.Tensor((128,), T.float32)):
+        with T.Kernel(128, threads=128) as i:
+            B[i] = A[i] * 2.0
+
+    kernel_func = simple.with_attr("global_symbol", f"simple_{backend}_{unique_id}")
+    tilelang.compile(kernel_func, out_idx=[1], execution_backend=backend)
+    assert counter.count == 1
+    assert (Path(clean_cache_env) / INDEX_FILE_NAME).exists()
+
+    # Drop the per-kernel files that the index replaces.
+    cache = _dispatch_map[backend]
+    for name in (cache.params_path, cache.device_kernel_path, cache.host_kernel_path):
+        for path in Path(clean_cache_env).rglob(name + "*"):
+            path.unlink()
+    cache._memory_cache.clear()
+    get_cache_index(str(clean_cache_env)).reset()
+
+    kernel = tilelang.compile(kernel_func, out_idx=[1], execution_backend=backend)
+    assert counter.count == 1, "Expected a cache hit served by the index"
+    a = torch.randn(128, dtype=torch.float32).cuda()
+    torch.testing.assert_close(kernel(a), a * 2.0)
+
+
+@tilelang.testing.requires_cuda
+@pytest.mark.parametrize("backend", ["tvm_ffi", "cython"])
+def test_lazy_loading_from_cache(clean_cache_env, backend):
+    """A kernel restored from the cache loads its library on its first call, once per process."""
+    unique_id = uuid.uuid4().hex[:8]
+
+    @T.prim_func
+    def simple(A: T.Tensor((128,), T.float32), B: T.Tensor((128,), T.float32)):
+        with T.Kernel(128, threads=128) as i:
+            B[i] = A[i] + 1.0
+
+    kernel_func = simple.with_attr("global_symbol", f"lazy_{backend}_{unique_id}")
+    tilelang.compile(kernel_func, out_idx=[1], execution_backend=backend)
+
+    cache = _dispatch_map[backend]
+    loaded = num_shared_modules()
+    kernels = []
+    for _ in range(2):
+        cache._memory_cache.clear()
+        kernels.append(tilelang.compile(kernel_func, out_idx=[1], execution_backend=backend))
+    assert num_shared_modules() == loaded, "Restoring a kernel should not load its library"
+    if backend == "cython":
+        assert all(kernel.adapter.lib is None for kernel in kernels)
+    else:
+        assert all(kernel.adapter.executable is None for kernel in kernels)
+
+    a = torch.randn(128, dtype=torch.float32).cuda()
+    for kernel in kernels:
+        torch.testing.assert_close(kernel(a), a + 1.0)
+    assert num_shared_modules() == loaded + 1, "Both kernels should share one loaded library"
+
+
+def test_cache_key_structural():
+    """Functions built separately share a key when they are structurally equal."""
+
+    def build(scale, name="scale"):
+        @T.prim_func
+        def kernel(A: T.Tensor((128,), T.float32), B: T.Tensor((128,), T.float32)):
+            with T.Kernel(128, threads=128) as i:
+                B[i] = A[i] * scale
+
+        return kernel.with_attr("global_symbol", name)
+
+    cache = _dispatch_map["cython"]
+
+    def key(func):
+        return cache._generate_key(func, out_idx=[1], execution_backend="cython", args=(), target="cuda")
+
+    assert key(build(2.0)) == key(build(2.0))
+    assert key(build(2.0)) != key(build(3.0))
+    assert key(build(2.0)) != key(build(2.0, name="other"))
+
+
+@pytest.mark.parametrize("backend", ["cython"])
+def test_concurrent_requests_compile_once(clean_cache_env, backend, monkeypatch):
+    """Threads requesting the same kernel at once share a single compilation."""
+
+    @T.prim_func
+    def simple(A: T.Tensor((128,), T.float32), B: T.Tensor((128,), T.float32)):
+        with T.Kernel(128, threads=128) as i:
+            B[i] = A[i] - 1.0
+
+    kernel_func = simple.with_attr("global_symbol", f"concurrent_{uuid.uuid4().hex[:8]}")
+    cache = _dispatch_map[backend]
+    calls = []
+    started = threading.Event()
+
+    def load_or_compile(key, *args):
+        calls.append(key)
+        started.set()
+        time.sleep(0.2)
+        kernel = object()
+        cache._memory_cache[key] = kernel
+        return kernel
+
+    monkeypatch.setattr(cache, "_load_or_compile", load_or_compile)
+
+    def request():
+        return cache.cached(kernel_func, [1], target="cuda", execution_backend=backend, verbose=False)
+
+    with concurrent.futures.ThreadPoolExecutor(8) as executor:
+        first = executor.submit(request)
+        started.wait()
+        results = [first] + [executor.submit(request) for _ in range(7)]
+        kernels = [result.result() for result in results]
+    assert len(calls) == 1
+    assert all(kernel is kernels[0] for kernel in kernels)
+    assert not cache._inflight
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v"])
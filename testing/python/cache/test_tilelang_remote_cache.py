@@ -0,0 +1,88 @@
+import os
+import time
+import uuid
+
+import pytest
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+import tvm_ffi
+from tilelang.cache import _dispatch_map
+from tilelang.cache.remote import MANIFEST_NAME, FileSystemRemoteCache, set_remote_cache
+from tilelang.env import env
+
+
+def _write_entry(path, files):
+    path.mkdir()
+    for name, data in files.items():
+        (path / name).write_bytes(data)
+
+
+def test_remote_entry_roundtrip(tmp_path):
+    remote = FileSystemRemoteCache(str(tmp_path / "remote"))
+    files = {"kernel_lib.so": b"\x7fELF", "params.pkl": b"params"}
+    _write_entry(tmp_path / "entry", files)
+    assert remote.download("key") is None
+    remote.upload("key", str(tmp_path / "entry"))
+    assert remote.download("key") == files
+    # a file that does not match its digest rejects the whole entry
+    (tmp_path / "remote" / "key" / "params.pkl").write_bytes(b"corrupted")
+    assert remote.download("key") is None
+    assert (tmp_path / "remote" / "key" / MANIFEST_NAME).exists()
+
+
+def test_remote_lease(tmp_path):
+    remote = FileSystemRemoteCache(str(tmp_path))
+    assert remote.acquire("key", "first", timeout=60)
+    assert not remote.acquire("key", "second", timeout=60)
+    # only the holder releases its lease
+    remote.release("key", "second")
+    assert not remote.acquire("key", "second", timeout=60)
+    remote.release("key", "first")
+    assert remote.acquire("key", "second", timeout=60)
+    # the lease of a crashed holder expires
+    lease = tmp_path / "key" / ".lease"
+    os.utime(lease, (time.time() - 120, time.time() - 120))
+    assert remote.acquire("key", "third", timeout=60)
+
+
+@tilelang.testing.requires_cuda
+def test_remote_cache_hit(tmp_path):
+    """A second machine with an empty disk cache fetches the kernel instead of compiling it."""
+    compiled = []
+
+    def callback(code, _):
+        compiled.append(code)
+        return code
+
+    tvm_ffi.register_global_func("tilelang_callback_cuda_postproc", f=callback, override=True)
+    original_cache_dir, original_tmp_dir = env.TILELANG_CACHE_DIR, env.TILELANG_TMP_DIR
+    tilelang.enable_cache()
+    set_remote_cache(FileSystemRemoteCache(str(tmp_path / "remote")))
+
+    @T.prim_func
+    def simple(A: T.Tensor((128,), T.float32), B: T.Tensor((128,), T.float32)):
+        with T.Kernel(128, threads=128) as i:
+            B[i] = A[i] * 3.0
+
+    kernel_func = simple.with_attr("global_symbol", f"remote_{uuid.uuid4().hex[:8]}")
+    try:
+        for machine in ("first", "second"):
+            for name in ("cache", "tmp"):
+                (tmp_path / machine / name).mkdir(parents=True)
+            env.TILELANG_CACHE_DIR = str(tmp_path / machine / "cache")
+            env.TILELANG_TMP_DIR = str(tmp_path / machine / "tmp")
+            _dispatch_map["cython"]._memory_cache.clear()
+            kernel = tilelang.compile(kernel_func, out_idx=[1], execution_backend="cython")
+        assert len(compiled) == 1, "The second machine should fetch the kernel from the remote cache"
+        a = torch.randn(128, dtype=torch.float32).cuda()
+        torch.testing.assert_close(kernel(a), a * 3.0)
+    finally:
+        set_remote_cache(None)
+        env.TILELANG_CACHE_DIR, env.TILELANG_TMP_DIR = original_cache_dir, original_tmp_dir
+        tvm_ffi.register_global_func("tilelang_callback_cuda_postproc", f=lambda code, _: code, override=True)
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
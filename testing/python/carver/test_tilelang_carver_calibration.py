@@ -0,0 +1,62 @@
+import os
+import tempfile
+
+import tilelang.testing
+from tilelang.env import env
+from tilelang.carver.arch import calibration
+
+
+def test_cost_params_from_measurements():
+    measurements = {
+        "dram_bandwidth": 3.0e12,
+        "l2_bandwidth": 1.0e13,
+        "smem_bandwidth": 3.0e13,
+        "load_latency": 5.0e-7,
+        "tensor_flops": {"float16": 6.6e14, "int8": 1.3e15},
+    }
+    params = calibration.cost_params_from_measurements(measurements, num_sms=132, clock_hz=1.0e9)
+    assert params["dram_bandwidth"] == 3.0e12
+    assert params["l2_bytes_per_clock"] == 1.0e4
+    assert abs(params["smem_bytes_per_sm_clock"] - 3.0e13 / 132e9) < 1e-6
+    assert params["dram_latency_cycles"] == 500
+    assert abs(params["tensor_flops_per_sm_clock"] - 6.6e14 / 132e9) < 1e-6
+    # nothing is implied by the missing measurements
+    assert calibration.cost_params_from_measurements({}, num_sms=132, clock_hz=1.0e9) == {"clock_hz": 1.0e9}
+
+
+def test_profile_round_trip():
+    profile = {
+        "version": calibration.PROFILE_VERSION,
+        "key": "some-other-device",
+        "measurements": {"dram_bandwidth": 2.0e12},
+        "cost_params": {"dram_bandwidth": 2.0e12},
+    }
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "profiles", "device.json")
+        calibration.save_profile(profile, path)
+        env.TILELANG_DEVICE_PROFILE = path
+        try:
+            assert calibration.profile_path() == path
+            # an explicit profile applies whatever device recorded it
+            assert calibration.load_profile() == profile
+            calibration.save_profile(dict(profile, version=calibration.PROFILE_VERSION + 1), path)
+            assert calibration.load_profile() is None
+        finally:
+            env.TILELANG_DEVICE_PROFILE = None
+
+
+@tilelang.testing.requires_cuda
+def test_calibrate_device():
+    from tilelang.carver.arch import CUDA
+
+    profile = calibration.calibrate_device(benchmarks=["dram_bandwidth", "smem_bandwidth"], save=False)
+    assert profile["key"] == calibration.profile_key()
+    assert profile["measurements"]["dram_bandwidth"] > 0
+    assert profile["measurements"]["smem_bandwidth"] > profile["measurements"]["dram_bandwidth"]
+    arch = CUDA("cuda")
+    arch.calibrate(profile["cost_params"])
+    assert arch.cost_params["dram_bandwidth"] == profile["measurements"]["dram_bandwidth"]
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,69 @@
+import tilelang
+import tilelang.testing
+import torch
+from tilelang import carver
+from tilelang.carver.arch import auto_infer_current_arch
+
+
+def ref_chunk_scan(q, k, v, g, h0, scale, chunk_size):
+    """Step by step recurrence, ``g`` holding the chunk-local cumulative log decays."""
+    B, S, H, _ = q.shape
+    q, k, v = q.float(), k.float(), v.float()
+    # Per-step log decays from the chunk-local cumulative sums
+    inside = torch.arange(S, device=g.device) % chunk_size != 0
+    step = torch.where(inside, g - g.roll(1, dims=-1), g)
+    h = h0.clone()
+    o = torch.empty(B, S, H, v.shape[-1], device=q.device)
+    for t in range(S):
+        h = h * step[:, :, t].exp()[..., None, None] + k[:, t, :, :, None] * v[:, t, :, None, :]
+        o[:, t] = torch.einsum("bhk,bhkv->bhv", q[:, t] * scale, h)
+    return o, h
+
+
+def run_chunk_scan(B, S, H, DK, DV, chunk_size=64, gated=False, use_initial_state=False):
+    template = carver.ChunkScanTemplate(
+        batch_size=B,
+        num_heads=H,
+        seq_length=S,
+        head_dim_k=DK,
+        head_dim_v=DV,
+        chunk_size=chunk_size,
+        gated=gated,
+        use_initial_state=use_initial_state,
+    ).with_arch(auto_infer_current_arch())
+    configs = template.get_autotune_configs()
+    assert len(configs) > 0, "No autotune configs"
+    for config in configs:
+        assert set(config) == {"block_DV", "num_stages", "threads"}
+        assert DV % config["block_DV"] == 0
+
+    kernel = tilelang.compile(template.chunk_scan_program(**configs[0]), out_idx=[5, 6])
+    q = torch.randn(B, S, H, DK, device="cuda", dtype=torch.float16) * 0.5
+    k = torch.randn(B, S, H, DK, device="cuda", dtype=torch.float16) * 0.5
+    v = torch.randn(B, S, H, DV, device="cuda", dtype=torch.float16)
+    g = -torch.rand(B, H, S, device="cuda") * 0.1
+    g = g.view(B, H, S // chunk_size, chunk_size).cumsum(-1).view(B, H, S)
+    if not gated:
+        g.zero_()
+    h0 = torch.randn(B, H, DK, DV, device="cuda") if use_initial_state else torch.zeros(B, H, DK, DV, device="cuda")
+
+    o, ht = kernel(q, k, v, g, h0)
+    ref_o, ref_ht = ref_chunk_scan(q, k, v, g, h0, template.scale, chunk_size)
+    torch.testing.assert_close(o.float(), ref_o, rtol=2e-2, atol=2e-2)
+    torch.testing.assert_close(ht, ref_ht, rtol=2e-2, atol=2e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_chunk_scan_linear_attention():
+    run_chunk_scan(1, 256, 2, 64, 64)
+    run_chunk_scan(2, 128, 2, 64, 128, use_initial_state=True)
+
+
+@tilelang.testing.requires_cuda
+def test_chunk_scan_gated():
+    run_chunk_scan(1, 256, 2, 64, 64, gated=True)
+    run_chunk_scan(1, 256, 2, 128, 64, gated=True, use_initial_state=True)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
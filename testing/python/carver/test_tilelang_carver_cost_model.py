@@ -0,0 +1,80 @@
+import tilelang.testing
+from tilelang import carver
+from tilelang.carver.arch import TileDevice, auto_infer_current_arch
+from tilelang.carver.roller.cost_model import TileCostModel, TileWorkload
+from tilelang.language import dtypes as T
+
+
+def _hopper_like() -> TileDevice:
+    arch = TileDevice()
+    arch.compute_max_core = 132
+    arch.cost_params = dict(
+        tensor_flops_per_sm_clock=4096,
+        cuda_core_flops_per_sm_clock=256,
+        smem_bytes_per_sm_clock=128,
+        l2_bytes_per_clock=8192,
+        dram_latency_cycles=800,
+        mma_sync_efficiency=0.6,
+        max_cluster_size=8,
+        clock_hz=1.755e9,
+        dram_bandwidth=3.35e12,
+    )
+    return arch
+
+
+def _gemm_workload(M, N, K, block_M, block_N, **kwargs) -> TileWorkload:
+    grid_size = (M // block_M) * (N // block_N)
+    return TileWorkload(
+        flops=2.0 * block_M * block_N * K,
+        traffic=2.0 * (block_M + block_N) * K,
+        grid_size=grid_size,
+        block_per_SM=1,
+        compulsory_bytes=2.0 * (M * K + K * N + M * N),
+        tensor_core_dtype="float16",
+        tile_m=block_M,
+        **kwargs,
+    )
+
+
+def test_cost_model_without_parameters():
+    assert TileCostModel.from_arch(TileDevice()) is None
+
+
+def test_cost_model_wave_quantization():
+    model = TileCostModel.from_arch(_hopper_like())
+    # 132 tiles fill one wave, 144 tiles need a second one of 12 blocks
+    one_wave = model.estimate(_gemm_workload(1408, 3072, 4096, 128, 256, num_stages=4))
+    two_waves = model.estimate(_gemm_workload(1536, 3072, 4096, 128, 256, num_stages=4))
+    assert two_waves > 1.6 * one_wave
+
+
+def test_cost_model_pipeline_and_instruction():
+    model = TileCostModel.from_arch(_hopper_like())
+    serial = model.estimate(_gemm_workload(4096, 4096, 4096, 128, 256))
+    pipelined = model.estimate(_gemm_workload(4096, 4096, 4096, 128, 256, num_stages=3))
+    assert pipelined < serial
+    # a 96 row tile cannot be issued as wgmma
+    wgmma = model.estimate(_gemm_workload(4608, 4608, 4096, 128, 128, num_stages=3))
+    mma = model.estimate(_gemm_workload(4608, 4608, 4096, 96, 128, num_stages=3))
+    assert wgmma < mma
+
+
+def test_cost_model_cluster():
+    model = TileCostModel.from_arch(_hopper_like())
+    # small tiles are bound by L2, which the multicast of a cluster relieves
+    single = model.estimate(_gemm_workload(8192, 8192, 1024, 64, 64, num_stages=3))
+    clustered = model.estimate(_gemm_workload(8192, 8192, 1024, 64, 64, num_stages=3, cluster_size=2))
+    assert clustered < single
+
+
+@tilelang.testing.requires_cuda
+def test_matmul_hints_ranked_by_cost_model():
+    arch = auto_infer_current_arch()
+    assert arch.cost_params["clock_hz"] > 0
+    template = carver.MatmulTemplate(M=4096, N=4096, K=4096, in_dtype=T.float16, out_dtype=T.float16, accum_dtype=T.float32).with_arch(arch)
+    hints = template.recommend_hints(topk=10)
+    assert len(hints) > 0
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,52 @@
+import tilelang
+import tilelang.testing
+import torch
+from tilelang import carver
+from tilelang.carver.arch import auto_infer_current_arch
+
+
+def run_elementwise_program(shape, dtype="float16", out_dtype=None, num_inputs=2):
+    template = carver.ElementwiseTemplate(shape=shape, dtype=dtype).with_arch(auto_infer_current_arch())
+    config = template.get_launch_config([dtype, out_dtype or dtype])
+    assert config["tile"] % config["vec"] == 0
+    assert 1 <= config["num_blocks"] <= template.arch.compute_max_core * 8
+
+    if num_inputs == 1:
+        program = template.elementwise_program(lambda a: a * 2, num_inputs=1, out_dtype=out_dtype)
+    else:
+        program = template.elementwise_program(lambda a, b: a + b, num_inputs=2, out_dtype=out_dtype)
+    kernel = tilelang.compile(program, out_idx=[-1])
+    inputs = [torch.randn(*shape, device="cuda", dtype=getattr(torch, dtype)) for _ in range(num_inputs)]
+    ref = inputs[0] * 2 if num_inputs == 1 else inputs[0] + inputs[1]
+    out = kernel(*inputs)
+    torch.testing.assert_close(out, ref.to(getattr(torch, out_dtype or dtype)), rtol=1e-2, atol=1e-2)
+
+
+def run_cast_program(M, N, dtype="bfloat16", group_size=128):
+    template = carver.ElementwiseTemplate(shape=[M, N], dtype=dtype).with_arch(auto_infer_current_arch())
+    kernel = tilelang.compile(template.cast_program(group_size=group_size), out_idx=[1, 2])
+    x = torch.randn(M, N, device="cuda", dtype=getattr(torch, dtype))
+    x_q, x_s = kernel(x)
+
+    x_view = x.float().view(M, -1, group_size)
+    ref_s = x_view.abs().amax(dim=2).clamp(1e-4) / 448.0
+    ref_q = (x_view / ref_s.unsqueeze(2)).clamp(-448.0, 448.0).to(torch.float8_e4m3fn).view(M, N)
+    torch.testing.assert_close(x_s, ref_s)
+    torch.testing.assert_close(x_q.float(), ref_q.float(), rtol=0.125, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_elementwise_program():
+    run_elementwise_program([4096, 4096])
+    run_elementwise_program([1000, 333], dtype="float32", num_inputs=1)
+    run_elementwise_program([8192], dtype="bfloat16", out_dtype="float32")
+
+
+@tilelang.testing.requires_cuda
+def test_cast_program():
+    run_cast_program(1024, 4096)
+    run_cast_program(1000, 256, dtype="float32")
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
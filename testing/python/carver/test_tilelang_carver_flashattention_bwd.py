@@ -0,0 +1,150 @@
+import tilelang
+import tilelang.testing
+import torch
+from tilelang import carver
+from tilelang.carver.arch import auto_infer_current_arch
+
+
+def ref_attention(q, k, v, scale, is_causal):
+    """Attention over [B, S, H, D] tensors, with KV heads repeated for GQA, and its LSE as [B, H, S]."""
+    group = q.shape[2] // k.shape[2]
+    k = k.repeat_interleave(group, dim=2)
+    v = v.repeat_interleave(group, dim=2)
+    scores = torch.einsum("bqhd,bkhd->bhqk", q, k) * scale
+    if is_causal:
+        S, S_kv = q.shape[1], k.shape[1]
+        # Bottom right aligned, as in the template
+        mask = torch.ones(S, S_kv, dtype=torch.bool, device=q.device).tril(S_kv - S)
+        scores = scores.masked_fill(~mask, float("-inf"))
+    lse = scores.logsumexp(dim=-1)
+    o = torch.einsum("bhqk,bkhd->bqhd", scores.softmax(dim=-1), v)
+    return o, lse
+
+
+def ref_backward(q, k, v, do, scale, is_causal):
+    q, k, v = (x.detach().float().requires_grad_() for x in (q, k, v))
+    o, lse = ref_attention(q, k, v, scale, is_causal)
+    o.backward(do.float())
+    return o.detach(), lse.detach(), q.grad, k.grad, v.grad
+
+
+def run_flashattention_bwd(B, H, S, S_kv, D, num_kv_heads=None, is_causal=False, dq_mode="atomic"):
+    template = carver.FlashAttentionBwdTemplate(
+        batch_size=B,
+        num_heads=H,
+        num_kv_heads=num_kv_heads,
+        head_dim=D,
+        seq_length=S,
+        seq_kv_length=S_kv,
+        is_causal=is_causal,
+        dq_mode=dq_mode,
+    ).with_arch(auto_infer_current_arch())
+    configs = template.get_autotune_configs()
+    assert len(configs) > 0, "No autotune configs"
+    for config in configs:
+        assert set(config) == {"block_M", "block_N", "num_stages", "threads"}
+    config = configs[0]
+
+    H_kv = template.num_kv_heads
+    q = torch.randn(B, S, H, D, device="cuda", dtype=torch.float16)
+    k = torch.randn(B, S_kv, H_kv, D, device="cuda", dtype=torch.float16)
+    v = torch.randn(B, S_kv, H_kv, D, device="cuda", dtype=torch.float16)
+    do = torch.randn(B, S, H, D, device="cuda", dtype=torch.float16)
+    o, lse, ref_dq, ref_dk, ref_dv = ref_backward(q, k, v, do, template.sm_scale, is_causal)
+
+    preprocess = tilelang.compile(template.preprocess_program(), out_idx=[2])
+    delta = preprocess(o.half(), do)
+    torch.testing.assert_close(delta, (o.half().float() * do.float()).sum(-1).transpose(1, 2), rtol=1e-2, atol=1e-2)
+
+    dkdv = tilelang.compile(template.dkdv_program(**config), out_idx=[7, 8])
+    if dq_mode == "atomic":
+        dq_accum = torch.zeros(B, S, H, D, device="cuda", dtype=torch.float32)
+        dk, dv = dkdv(q, k, v, do, lse, delta, dq_accum)
+        postprocess = tilelang.compile(template.postprocess_program(), out_idx=[1])
+        dq = postprocess(dq_accum)
+    else:
+        dk, dv = dkdv(q, k, v, do, lse, delta, torch.zeros(1, device="cuda"))
+        dq_kernel = tilelang.compile(template.dq_program(**config), out_idx=[6])
+        dq = dq_kernel(q, k, v, do, lse, delta)
+        # The dQ pass is free of atomics, its result is reproducible
+        torch.testing.assert_close(dq_kernel(q, k, v, do, lse, delta), dq, rtol=0, atol=0)
+
+    torch.testing.assert_close(dq.float(), ref_dq, rtol=2e-2, atol=2e-2)
+    torch.testing.assert_close(dk.float(), ref_dk, rtol=2e-2, atol=2e-2)
+    torch.testing.assert_close(dv.float(), ref_dv, rtol=2e-2, atol=2e-2)
+
+
+def run_flashattention_bwd_varlen(seqlens_q, seqlens_k, H, D, is_causal=False, dq_mode="atomic"):
+    B = len(seqlens_q)
+    template = carver.FlashAttentionBwdTemplate(
+        batch_size=B,
+        num_heads=H,
+        head_dim=D,
+        seq_length=max(seqlens_q),
+        seq_kv_length=max(seqlens_k),
+        is_causal=is_causal,
+        varlen=True,
+        dq_mode=dq_mode,
+    ).with_arch(auto_infer_current_arch())
+    config = template.get_autotune_configs()[0]
+
+    def cumulative(seqlens):
+        return torch.tensor([0] + seqlens, device="cuda", dtype=torch.int32).cumsum(0, dtype=torch.int32)
+
+    cu_seqlens_q, cu_seqlens_k = cumulative(seqlens_q), cumulative(seqlens_k)
+    total_q, total_kv = sum(seqlens_q), sum(seqlens_k)
+    q = torch.randn(total_q, H, D, device="cuda", dtype=torch.float16)
+    k = torch.randn(total_kv, H, D, device="cuda", dtype=torch.float16)
+    v = torch.randn(total_kv, H, D, device="cuda", dtype=torch.float16)
+    do = torch.randn(total_q, H, D, device="cuda", dtype=torch.float16)
+
+    refs = []
+    for b in range(B):
+        qs, qe, ks, ke = cu_seqlens_q[b], cu_seqlens_q[b + 1], cu_seqlens_k[b], cu_seqlens_k[b + 1]
+        refs.append(ref_backward(q[None, qs:qe], k[None, ks:ke], v[None, ks:ke], do[None, qs:qe], template.sm_scale, is_causal))
+    o = torch.cat([r[0][0] for r in refs])
+    lse = torch.cat([r[1][0] for r in refs], dim=-1).contiguous()
+    ref_dq, ref_dk, ref_dv = (torch.cat([r[i][0] for r in refs]) for i in (2, 3, 4))
+
+    delta = tilelang.compile(template.preprocess_program(), out_idx=[3])(o.half(), do, cu_seqlens_q)
+    dkdv = tilelang.compile(template.dkdv_program(**config), out_idx=[9, 10])
+    if dq_mode == "atomic":
+        dq_accum = torch.zeros(total_q, H, D, device="cuda", dtype=torch.float32)
+        dk, dv = dkdv(q, k, v, do, lse, delta, cu_seqlens_q, cu_seqlens_k, dq_accum)
+        dq = tilelang.compile(template.postprocess_program(), out_idx=[2])(dq_accum, cu_seqlens_q)
+    else:
+        dk, dv = dkdv(q, k, v, do, lse, delta, cu_seqlens_q, cu_seqlens_k, torch.zeros(1, device="cuda"))
+        dq_kernel = tilelang.compile(template.dq_program(**config), out_idx=[8])
+        dq = dq_kernel(q, k, v, do, lse, delta, cu_seqlens_q, cu_seqlens_k)
+
+    torch.testing.assert_close(dq.float(), ref_dq, rtol=2e-2, atol=2e-2)
+    torch.testing.assert_close(dk.float(), ref_dk, rtol=2e-2, atol=2e-2)
+    torch.testing.assert_close(dv.float(), ref_dv, rtol=2e-2, atol=2e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_flashattention_bwd_atomic():
+    run_flashattention_bwd(1, 2, 256, 256, 64)
+    run_flashattention_bwd(1, 2, 200, 256, 64, is_causal=True)
+
+
+@tilelang.testing.requires_cuda
+def test_flashattention_bwd_deterministic():
+    run_flashattention_bwd(1, 2, 256, 256, 64, dq_mode="deterministic")
+    run_flashattention_bwd(1, 2, 256, 256, 128, is_causal=True, dq_mode="deterministic")
+
+
+@tilelang.testing.requires_cuda
+def test_flashattention_bwd_gqa():
+    run_flashattention_bwd(1, 4, 128, 128, 64, num_kv_heads=2, is_causal=True)
+    run_flashattention_bwd(1, 4, 128, 128, 64, num_kv_heads=1, dq_mode="deterministic")
+
+
+@tilelang.testing.requires_cuda
+def test_flashattention_bwd_varlen():
+    run_flashattention_bwd_varlen([100, 256], [128, 256], 2, 64, is_causal=True)
+    run_flashattention_bwd_varlen([100, 256], [128, 200], 2, 64, dq_mode="deterministic")
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
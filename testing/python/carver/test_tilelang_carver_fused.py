@@ -0,0 +1,67 @@
+import tilelang
+import tilelang.testing
+import torch
+from tilelang import carver
+from tilelang.carver.arch import auto_infer_current_arch
+
+
+def run_fused_mlp(M, K, hidden, N, activation="gelu", with_bias=True):
+    template = carver.FusedMLPTemplate(M=M, K=K, hidden=hidden, N=N, activation=activation, with_bias=with_bias).with_arch(
+        auto_infer_current_arch()
+    )
+    configs = template.get_autotune_configs()
+    assert len(configs) > 0, "No autotune configs"
+    for config in configs:
+        assert hidden % config["block_H"] == 0 and N % config["block_N"] == 0
+        traffic = template.dram_traffic(**config)
+        assert traffic["saved"] == traffic["unfused"] - traffic["fused"]
+    # the intermediate stays on chip when one block covers the columns of Y
+    assert configs[0]["block_N"] == N
+    assert template.dram_traffic(**configs[0])["saved"] > 0
+
+    kernel = tilelang.compile(template.fused_mlp_program(**configs[0]), out_idx=[4])
+    x = torch.randn(M, K, device="cuda", dtype=torch.float16) * 0.5
+    w1 = torch.randn(K, hidden, device="cuda", dtype=torch.float16) / K**0.5
+    b1 = torch.randn(hidden, device="cuda", dtype=torch.float16) * 0.1
+    w2 = torch.randn(hidden, N, device="cuda", dtype=torch.float16) / hidden**0.5
+    h = x.float() @ w1.float()
+    if with_bias:
+        h = h + b1.float()
+    h = {"gelu": lambda t: torch.nn.functional.gelu(t, approximate="tanh"), "relu": torch.relu, "silu": torch.nn.functional.silu}[activation](h)
+    ref = h.half().float() @ w2.float()
+    torch.testing.assert_close(kernel(x, w1, b1, w2).float(), ref, rtol=2e-2, atol=2e-2)
+
+
+def run_fused_norm_matmul(M, N, K, norm_type):
+    template = carver.FusedNormMatmulTemplate(M=M, N=N, K=K, norm_type=norm_type).with_arch(auto_infer_current_arch())
+    configs = template.get_autotune_configs()
+    assert len(configs) > 0, "No autotune configs"
+    # the normalized activations are never written back
+    assert template.dram_traffic(**configs[0])["saved"] >= M * K * 2
+
+    kernel = tilelang.compile(template.fused_norm_matmul_program(**configs[0]), out_idx=[4])
+    x = torch.randn(M, K, device="cuda", dtype=torch.float16) + 0.5
+    gamma = torch.rand(K, device="cuda", dtype=torch.float16) + 0.5
+    beta = torch.randn(K, device="cuda", dtype=torch.float16) * 0.1
+    w = torch.randn(K, N, device="cuda", dtype=torch.float16) / K**0.5
+    if norm_type == "rmsnorm":
+        xn = x.float() * torch.rsqrt(x.float().pow(2).mean(-1, keepdim=True) + template.eps) * gamma.float()
+    else:
+        xn = torch.nn.functional.layer_norm(x.float(), (K,), gamma.float(), beta.float(), eps=template.eps)
+    torch.testing.assert_close(kernel(x, gamma, beta, w).float(), xn @ w.float(), rtol=2e-2, atol=2e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_fused_mlp():
+    run_fused_mlp(256, 128, 512, 128)
+    run_fused_mlp(200, 256, 256, 64, activation="relu", with_bias=False)
+
+
+@tilelang.testing.requires_cuda
+def test_fused_norm_matmul():
+    run_fused_norm_matmul(256, 256, 512, "rmsnorm")
+    run_fused_norm_matmul(128, 128, 256, "layernorm")
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
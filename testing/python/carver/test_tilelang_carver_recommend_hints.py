@@ -77,6 +77,30 @@ def test_matmul_recommend_hints():
     run_matmul_recommend_hints(1024, 1024, 1024, T.float16, T.float32, T.float16)
 
 
+def run_grouped_matmul_recommend_hints(problems, in_dtype: T.dtype = T.float16, out_dtype: T.dtype = T.float16, accum_dtype: T.dtype = T.float32):
+    arch = auto_infer_current_arch()
+    carve_template = carver.GroupedMatmulTemplate(
+        problems=problems,
+        in_dtype=in_dtype,
+        out_dtype=out_dtype,
+        accum_dtype=accum_dtype,
+    ).with_arch(arch)
+
+    func = carve_template.equivalent_function()
+    assert func is not None, "Function is None"
+    assert carve_template.M == sum(m for m, _, _ in problems)
+
+    hints = carve_template.recommend_hints(topk=20)
+    assert len(hints) > 0, "Hints length is zero"
+    block_m, block_n = hints[0].block
+    assert carve_template.num_tiles(block_m, block_n) > 0
+
+
+def test_grouped_matmul_recommend_hints():
+    run_grouped_matmul_recommend_hints(((256, 1024, 1024), (1000, 1024, 1024), (77, 1024, 1024)))
+    run_grouped_matmul_recommend_hints(((128, 2048, 512), (512, 1024, 2048)))
+
+
 def run_gemv_recommend_hints(
     N: int = 1024, K: int = 1024, in_dtype: T.dtype = T.float16, out_dtype: T.dtype = T.float16, accum_dtype: T.dtype = T.float16
 ):
@@ -139,5 +163,44 @@ def test_fmha_recommend_hints():
     run_fmha_recommend_hints(4, 32, 512, 512, 128, T.int8, T.int32, T.int32)
 
 
+def run_fmha_autotune_configs(mode: str, num_heads: int, num_kv_heads: int, seq_length: int, seq_kv_length: int, is_causal: bool = True):
+    arch = auto_infer_current_arch()
+    carve_template = carver.FlashAttentionTemplate(
+        batch_size=1,
+        num_heads=num_heads,
+        num_kv_heads=num_kv_heads,
+        seq_length=seq_length,
+        seq_kv_length=seq_kv_length,
+        head_dim=128,
+        is_causal=is_causal,
+        mode=mode,
+        in_dtype=T.float16,
+        accum_dtype=T.float32,
+        out_dtype=T.float16,
+    ).with_arch(arch)
+
+    configs = carve_template.get_autotune_configs(topk=10)
+    assert len(configs) > 0, "No autotune configs"
+    for config in configs:
+        assert set(config) == {"block_M", "block_N", "num_stages", "threads", "num_split"}
+        assert config["num_split"] >= 1
+    if mode != "decode":
+        assert all(config["num_split"] == 1 for config in configs)
+    if is_causal:
+        # The last query sees every key, the first one only the cached keys and itself
+        assert carve_template.causal_kv_end(carve_template.packed_rows) == seq_kv_length
+        assert carve_template.causal_kv_end(1) == seq_kv_length - seq_length + 1
+    return carve_template
+
+
+@tilelang.testing.requires_cuda
+def test_fmha_autotune_configs():
+    run_fmha_autotune_configs("prefill", 32, 8, 2048, 2048)
+    run_fmha_autotune_configs("chunked_prefill", 32, 8, 512, 4096)
+    decode = run_fmha_autotune_configs("decode", 32, 8, 1, 8192)
+    assert decode.pack_gqa and decode.packed_rows == 4
+    assert max(config["num_split"] for config in decode.get_autotune_configs()) > 1
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
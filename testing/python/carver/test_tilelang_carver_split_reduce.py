@@ -0,0 +1,72 @@
+import tilelang
+import tilelang.testing
+import torch
+from tilelang import carver
+from tilelang.carver.arch import auto_infer_current_arch
+
+
+def make_inputs(op, M, N, dtype):
+    x = torch.randn(M, N, device="cuda", dtype=dtype) * 4
+    if op == "softmax":
+        return [x]
+    if op == "cross_entropy":
+        labels = torch.randint(0, N, (M,), device="cuda")
+        labels[0] = -100
+        return [x, labels]
+    return [x, torch.randn(N, device="cuda", dtype=dtype)]
+
+
+def ref_program(op, *inputs):
+    x = inputs[0].float()
+    if op == "softmax":
+        return [x.softmax(-1)]
+    if op == "cross_entropy":
+        labels = inputs[1]
+        loss = torch.nn.functional.cross_entropy(x, labels, reduction="none", ignore_index=-100)
+        grad = x.softmax(-1) - torch.nn.functional.one_hot(labels.clamp(0), x.shape[-1]).float()
+        grad[labels == -100] = 0
+        return [loss, grad]
+    return [x * torch.rsqrt(x.pow(2).mean(-1, keepdim=True) + 1e-6) * inputs[1].float()]
+
+
+def run_split_reduce(op, M, N, dtype="float16"):
+    template = carver.SplitRowReductionTemplate(op=op, num_rows=M, row_length=N, dtype=dtype).with_arch(auto_infer_current_arch())
+    configs = template.get_autotune_configs()
+    assert len(configs) > 0, "No autotune configs"
+    inputs = make_inputs(op, M, N, getattr(torch, dtype))
+    refs = ref_program(op, *inputs)
+    num_outputs = len(refs)
+    num_inputs = len(inputs)
+
+    for config in configs[:2]:
+        block_M, block_N, splits = config["block_M"], config["block_N"], config["num_splits"]
+        if config["use_cluster"]:
+            program = template.cluster_program(block_M, block_N, splits, config["threads"])
+            outputs = tilelang.compile(program, out_idx=list(range(num_inputs, num_inputs + num_outputs)))(*inputs)
+        else:
+            stats, normalize = template.partial_programs(block_M, block_N, splits, config["threads"])
+            partials = tilelang.compile(stats, out_idx=[1])(inputs[0])
+            outputs = tilelang.compile(normalize, out_idx=list(range(num_inputs + 1, num_inputs + 1 + num_outputs)))(*inputs, partials)
+        outputs = outputs if isinstance(outputs, (list, tuple)) else [outputs]
+        for out, ref in zip(outputs, refs):
+            torch.testing.assert_close(out.float(), ref, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_split_softmax():
+    run_split_reduce("softmax", 4, 131072)
+    run_split_reduce("softmax", 3, 50257, dtype="bfloat16")
+
+
+@tilelang.testing.requires_cuda
+def test_split_cross_entropy():
+    run_split_reduce("cross_entropy", 8, 128256)
+
+
+@tilelang.testing.requires_cuda
+def test_split_rms_norm():
+    run_split_reduce("rms_norm", 2, 65536)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,38 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+from tilelang import tvm as tvm
+
+
+def _scale(N, factor, name):
+    @T.prim_func
+    def kernel(x: T.Tensor((N,), T.float32), y: T.Tensor((N,), T.float32)):
+        with T.Kernel(T.ceildiv(N, 128), threads=128) as bx:
+            for i in T.Parallel(128):
+                y[bx * 128 + i] = x[bx * 128 + i] * factor
+
+    return kernel.with_attr("global_symbol", name)
+
+
+def _module(num_kernels):
+    return tvm.IRModule({f"scale_{i}": _scale(1024, float(i + 1), f"scale_{i}") for i in range(num_kernels)})
+
+
+@tilelang.testing.requires_cuda
+def test_parallel_lower_matches_serial():
+    serial = tilelang.lower(_module(4), target="cuda")
+    with tvm.transform.PassContext(config={tilelang.PassConfigKey.TL_PARALLEL_LOWER_WORKERS: 4}):
+        parallel = tilelang.lower(_module(4), target="cuda")
+
+    for i in range(4):
+        assert f"scale_{i}_kernel" in parallel.kernel_source
+    assert sorted(gv.name_hint for gv in parallel.device_mod.get_global_vars()) == sorted(
+        gv.name_hint for gv in serial.device_mod.get_global_vars()
+    )
+    assert sorted(gv.name_hint for gv in parallel.host_mod.get_global_vars()) == sorted(
+        gv.name_hint for gv in serial.host_mod.get_global_vars()
+    )
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
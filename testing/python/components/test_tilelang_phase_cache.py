@@ -0,0 +1,50 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+from tilelang import tvm as tvm
+from tilelang.engine.phase_cache import clear_phase_cache, get_phase_cache
+
+
+def _scale(N, factor):
+    @T.prim_func
+    def kernel(x: T.Tensor((N,), T.float32), y: T.Tensor((N,), T.float32)):
+        with T.Kernel(T.ceildiv(N, 128), threads=128) as bx:
+            for i in T.Parallel(128):
+                y[bx * 128 + i] = x[bx * 128 + i] * factor
+
+    return kernel
+
+
+def _lower(func, **config):
+    with tvm.transform.PassContext(opt_level=3, config=config):
+        return tilelang.lower(func, target="cuda")
+
+
+@tilelang.testing.requires_cuda
+def test_phase_cache_resumes_from_checkpoints():
+    tilelang.enable_cache()
+    clear_phase_cache()
+    cache = get_phase_cache()
+    reference = _lower(_scale(1024, 2.0))
+    assert len(cache) == 2
+
+    # Device compiler flags reuse both checkpoints
+    flags = _lower(_scale(1024, 2.0), **{tilelang.PassConfigKey.TL_PTXAS_REGISTER_USAGE_LEVEL: 5})
+    assert len(cache) == 2
+    assert flags.kernel_source == reference.kernel_source
+
+    # A config of OptimizeForTarget only re-runs that phase
+    _lower(_scale(1024, 2.0), **{tilelang.PassConfigKey.TL_DISABLE_THREAD_STORAGE_SYNC: True})
+    assert len(cache) == 3
+
+    # Another program misses both
+    other = _lower(_scale(1024, 3.0))
+    assert len(cache) == 5
+    assert other.kernel_source != reference.kernel_source
+
+    _lower(_scale(1024, 2.0), **{tilelang.PassConfigKey.TL_DISABLE_PHASE_CACHE: True})
+    assert len(cache) == 5
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -113,5 +113,68 @@ def test_matmul_compile():
     tilelang.testing.torch_assert_close(C, C_torch, atol=1e-2, rtol=1e-2, max_mismatched_ratio=0.05)
 
 
+def tile_gemm(M, N, K, block_M, block_N, block_K, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), accum_dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), is_cpu=True) as (bx, by):
+            A_local = T.alloc_local((block_M, block_K), dtype)
+            B_local = T.alloc_local((block_K, block_N), dtype)
+            C_local = T.alloc_local((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for ko in T.serial(K // block_K):
+                T.copy(A[by * block_M, ko * block_K], A_local)
+                T.copy(B[ko * block_K, bx * block_N], B_local)
+                T.gemm(A_local, B_local, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def test_tile_gemm_micro_kernel():
+    M, N, K = 256, 256, 128
+    with tvm.target.Target("c"):
+        kernel = tilelang.compile(tile_gemm(M, N, K, 64, 64, 32), out_idx=[2], execution_backend="cython")
+    assert "tl::gemm_ss<" in kernel.get_kernel_source()
+
+    A = torch.randn(M, K, dtype=torch.float16)
+    B = torch.randn(K, N, dtype=torch.float16)
+    C = kernel(A, B)
+    tilelang.testing.torch_assert_close(C, A.float() @ B.float(), atol=1e-2, rtol=1e-2)
+
+
+def test_tile_gemm_scratch_arena():
+    M, N, K = 128, 128, 64
+    with tvm.target.Target("c"):
+        kernel = tilelang.compile(tile_gemm(M, N, K, 64, 64, 32), out_idx=[2], execution_backend="cython")
+    assert "tl::cpu_scratch_arena(" in kernel.get_kernel_source()
+
+    # The arena is reused across launches, each launch must see its own data.
+    for _ in range(2):
+        A = torch.randn(M, K, dtype=torch.float16)
+        B = torch.randn(K, N, dtype=torch.float16)
+        C = kernel(A, B)
+        tilelang.testing.torch_assert_close(C, A.float() @ B.float(), atol=1e-2, rtol=1e-2)
+
+
+def test_tile_gemm_parallel_grid():
+    M, N, K = 256, 256, 128
+    with tvm.target.Target("c"):
+        kernel = tilelang.compile(
+            tile_gemm(M, N, K, 64, 64, 32),
+            out_idx=[2],
+            execution_backend="cython",
+            pass_configs={tilelang.PassConfigKey.TL_ENABLE_CPU_PARALLEL_GRID: True},
+        )
+    assert "#pragma omp parallel for" in kernel.get_kernel_source()
+
+    A = torch.randn(M, K, dtype=torch.float16)
+    B = torch.randn(K, N, dtype=torch.float16)
+    C = kernel(A, B)
+    tilelang.testing.torch_assert_close(C, A.float() @ B.float(), atol=1e-2, rtol=1e-2)
+
 if __name__ == "__main__":
     tilelang.testing.main()
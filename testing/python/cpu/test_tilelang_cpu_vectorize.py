@@ -0,0 +1,69 @@
+import re
+
+import tilelang
+import tilelang.testing
+from tilelang import tvm as tvm
+import tilelang.language as T
+import torch
+
+
+def scale_add_relu(M, N, block_M, block_N, dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), is_cpu=True) as (bx, by):
+            for i, j in T.Parallel(block_M, block_N):
+                C[by * block_M + i, bx * block_N + j] = T.max(
+                    A[by * block_M + i, bx * block_N + j] * 2.0 + B[by * block_M + i, bx * block_N + j], 0.0
+                )
+
+    return main
+
+
+def column_sum(M, N, dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        S: T.Tensor((N,), dtype),
+    ):
+        with T.Kernel(1, is_cpu=True) as _:
+            S_local = T.alloc_local((N,), dtype)
+            for j in T.Parallel(N):
+                S_local[j] = 0.0
+            for i in T.serial(M):
+                for j in T.Parallel(N):
+                    S_local[j] += A[i, j]
+            for j in T.Parallel(N):
+                S[j] = S_local[j]
+
+    return main
+
+
+def test_elementwise_vectorized():
+    M, N = 256, 256
+    with tvm.target.Target("c"):
+        kernel = tilelang.compile(scale_add_relu(M, N, 32, 64), out_idx=[2], execution_backend="cython")
+    assert re.search(r"\bfloat(4|8|16)\b", kernel.get_kernel_source())
+
+    A = torch.randn(M, N, dtype=torch.float32)
+    B = torch.randn(M, N, dtype=torch.float32)
+    C = kernel(A, B)
+    torch.testing.assert_close(C, torch.relu(A * 2.0 + B))
+
+
+def test_column_reduction_vectorized():
+    M, N = 64, 128
+    with tvm.target.Target("c"):
+        kernel = tilelang.compile(column_sum(M, N), out_idx=[1], execution_backend="cython")
+    assert re.search(r"\bfloat(4|8|16)\b", kernel.get_kernel_source())
+
+    A = torch.randn(M, N, dtype=torch.float32)
+    S = kernel(A)
+    torch.testing.assert_close(S, A.sum(dim=0), rtol=1e-4, atol=1e-4)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -30,5 +30,34 @@ def test_device_assert_no_trigger():
     profiler.run_once()
 
 
+def _assert_program():
+    @T.prim_func
+    def program(A: T.Tensor((128,), T.float32)):
+        with T.Kernel(threads=128):
+            tid = T.get_thread_binding()
+            T.device_assert(A[tid] == A[tid], "A is nan")
+            T.device_assert(tid < 128, no_stack_info=True)
+
+    return program
+
+
+@tilelang.testing.requires_cuda
+def test_device_assert_modes():
+    import torch
+
+    a = torch.randn(128, device="cuda")
+    source = tilelang.compile(_assert_program()).get_kernel_source()
+    assert "device_assert_with_msg(" in source and "device_assert(" in source
+
+    kernel = tilelang.compile(_assert_program(), pass_configs={tilelang.PassConfigKey.TL_DEVICE_ASSERT_MODE: "warp"})
+    source = kernel.get_kernel_source()
+    assert source.count("tl::device_assert_warp(") == 2
+    kernel(a)
+
+    kernel = tilelang.compile(_assert_program(), pass_configs={tilelang.PassConfigKey.TL_DEVICE_ASSERT_MODE: "off"})
+    assert "device_assert" not in kernel.get_kernel_source()
+    kernel(a)
+
+
 if __name__ == "__main__":
     _manual_device_assert_triggered()
@@ -0,0 +1,59 @@
+import pytest
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def shift(N, block=128):
+    @T.prim_func
+    def main(A: T.Tensor((N,), T.float32), B: T.Tensor((N,), T.float32)):
+        with T.Kernel(T.ceildiv(N, block), threads=block) as bx:
+            for i in T.Parallel(block):
+                B[bx * block + i] = A[bx * block + i] + 1.0
+
+    return main
+
+
+def shift_in_place(N, block=128):
+    @T.prim_func
+    def main(A: T.Tensor((N,), T.float32), B: T.Tensor((N,), T.float32)):
+        T.annotate_restrict_buffers(A, B)
+        with T.Kernel(T.ceildiv(N, block), threads=block) as bx:
+            for i in T.Parallel(block):
+                B[bx * block + i] = A[bx * block + i] + 1.0
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@pytest.mark.parametrize("backend", ["tvm_ffi", "cython"])
+def test_alias_check(backend):
+    kernel = tilelang.compile(shift(1024), execution_backend=backend)
+    assert kernel.params[0].restrict and not kernel.params[0].written
+    assert kernel.params[1].restrict and kernel.params[1].written
+    x = torch.zeros(2048, device="cuda")
+    kernel(x[:1024], x[1024:])
+    torch.testing.assert_close(x[1024:], torch.ones(1024, device="cuda"))
+    with pytest.raises(Exception, match="overlap"):
+        kernel(x[:1024], x[512:1536])
+
+
+@tilelang.testing.requires_cuda
+def test_alias_check_non_restrict():
+    kernel = tilelang.compile(shift_in_place(1024))
+    assert not kernel.params[0].restrict and not kernel.params[1].restrict
+    x = torch.zeros(1024, device="cuda")
+    kernel(x, x)
+    torch.testing.assert_close(x, torch.ones(1024, device="cuda"))
+
+
+@tilelang.testing.requires_cuda
+def test_alias_check_disabled():
+    kernel = tilelang.compile(shift(1024), pass_configs={tilelang.PassConfigKey.TL_DISABLE_ALIAS_CHECK: True})
+    x = torch.zeros(1024, device="cuda")
+    kernel(x, x)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,69 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+@tilelang.jit
+def add_one(A, B, block_N=128):
+    N = T.const("N")
+    A: T.Tensor[[N], T.float32]
+    B: T.Tensor[[N], T.float32]
+    with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+        for i in T.Parallel(block_N):
+            B[bx * block_N + i] = A[bx * block_N + i] + 1
+
+
+def copy(N, block_N=128, dtype=T.float32):
+    @T.prim_func
+    def main(A: T.Tensor((N,), dtype), B: T.Tensor((N,), dtype)):
+        with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+            T.copy(A[bx * block_N], B[bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_background_jit_eager():
+    fallback_calls = []
+
+    def fallback(A, B, **kwargs):
+        fallback_calls.append(A.shape)
+        B.copy_(A + 1)
+
+    fast_add_one = tilelang.jit.BackgroundJIT(add_one, fallback)
+    a = torch.randn(1024, device="cuda")
+    b = torch.empty_like(a)
+    fast_add_one(a, b)
+    torch.testing.assert_close(b, a + 1)
+    assert fallback_calls == [a.shape]
+
+    fast_add_one.wait()
+    b.zero_()
+    fast_add_one(a, b)
+    torch.testing.assert_close(b, a + 1)
+    assert len(fallback_calls) == 1
+    fast_add_one.shutdown()
+
+
+@tilelang.testing.requires_cuda
+def test_background_jit_lazy():
+    lazy_copy = tilelang.jit(copy)
+    fast_copy = tilelang.jit.BackgroundJIT(lazy_copy, lambda A, B: B.copy_(A))
+    pending = fast_copy(1024)
+    assert isinstance(pending, tilelang.jit.BackgroundKernel)
+    a = torch.randn(1024, device="cuda")
+    b = torch.empty_like(a)
+    pending(a, b)
+    torch.testing.assert_close(b, a)
+
+    kernel = pending.wait()
+    assert pending.ready()
+    assert fast_copy(1024) is kernel
+    # Once the worker is done, the kernel is in the cache of the JIT
+    fast_copy.shutdown()
+    assert lazy_copy(1024) is kernel
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
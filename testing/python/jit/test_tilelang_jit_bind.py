@@ -0,0 +1,84 @@
+import pytest
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def scale_add(M, N, block_M, dtype=T.float16):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+        alpha: T.float32,
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(M, block_M), threads=128) as bx:
+            for i, j in T.Parallel(block_M, N):
+                C[bx * block_M + i, j] = A[bx * block_M + i, j] * T.cast(alpha, dtype) + B[bx * block_M + i, j]
+
+    return main
+
+
+def run_bound_call(execution_backend):
+    M, N = 256, 128
+    kernel = tilelang.compile(scale_add(M, N, 32), out_idx=[3], execution_backend=execution_backend)
+    make = lambda: torch.randn(M, N, device="cuda", dtype=torch.float16)  # noqa: E731
+    call = kernel.bind(make(), make(), 1.0)
+
+    # New pointers and scalars with the bound metadata
+    for alpha in (0.5, 2.0):
+        a, b = make(), make()
+        torch.testing.assert_close(call(a, b, alpha), a * alpha + b, rtol=1e-2, atol=1e-2)
+        c = call(a, b, alpha, skip_tensor_validation=True)
+        torch.testing.assert_close(c, a * alpha + b, rtol=1e-2, atol=1e-2)
+    return call
+
+
+@tilelang.testing.requires_cuda
+def test_bound_call_tvm_ffi():
+    run_bound_call("tvm_ffi")
+
+
+@tilelang.testing.requires_cuda
+def test_bound_call_cython():
+    call = run_bound_call("cython")
+    M, N = 256, 128
+    a = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    # Metadata other than the bound one asks for a new bind
+    with pytest.raises(ValueError, match="bind it again"):
+        call(a.t().contiguous().t(), a, 1.0)
+    with pytest.raises(ValueError, match="bind it again"):
+        call(a.float(), a, 1.0)
+
+
+def run_kernel_batch(execution_backend):
+    M, N = 256, 128
+    kernel = tilelang.compile(scale_add(M, N, 32), out_idx=[3], execution_backend=execution_backend)
+    a, b, c = (torch.randn(M, N, device="cuda", dtype=torch.float16) for _ in range(3))
+    batch = tilelang.jit.KernelBatch([(kernel, (a, b, 2.0)), (kernel, (b, c, -1.0))])
+    x, y = batch()
+    torch.testing.assert_close(x, a * 2 + b, rtol=1e-2, atol=1e-2)
+    torch.testing.assert_close(y, c - b, rtol=1e-2, atol=1e-2)
+
+    # New inputs for the first launch only, on a side stream
+    stream = torch.cuda.Stream()
+    with torch.cuda.stream(stream):
+        x, y = batch([(c, a, 0.5), None], stream=stream)
+    stream.synchronize()
+    torch.testing.assert_close(x, c * 0.5 + a, rtol=1e-2, atol=1e-2)
+    torch.testing.assert_close(y, c - b, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_kernel_batch_tvm_ffi():
+    run_kernel_batch("tvm_ffi")
+
+
+@tilelang.testing.requires_cuda
+def test_kernel_batch_cython():
+    run_kernel_batch("cython")
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
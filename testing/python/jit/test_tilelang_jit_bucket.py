@@ -0,0 +1,51 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def matmul(M, N, K, block_M, block_N, block_K, num_stages, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_bucketed_matmul():
+    N = K = 256
+    kernel = tilelang.jit.compile_buckets(
+        lambda block_M, num_stages: matmul(T.dynamic("m"), N, K, block_M, 64, 32, num_stages),
+        dim="m",
+        buckets={
+            16: dict(block_M=16, num_stages=3),
+            64: dict(block_M=32, num_stages=2),
+            None: dict(block_M=64, num_stages=2),
+        },
+        out_idx=[2],
+    )
+    assert kernel.bounds == [16, 64]
+    for M, bucket in ((1, 0), (16, 0), (17, 1), (64, 1), (300, None)):
+        expected = kernel.fallback if bucket is None else kernel.kernels[bucket]
+        assert kernel.select(M) is expected
+        a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+        b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+        torch.testing.assert_close(kernel(a, b), a @ b, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,77 @@
+import os
+import subprocess
+import sys
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tilelang.bundle import export_bundle, load_bundle, specialization_key
+
+
+def matmul(M, N, K, block_M, block_N, block_K, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def build_bundle(path, N=256, K=256):
+    kernels = {}
+    for M, block_M in ((16, 16), (256, 64)):
+        kernels[specialization_key(M=M)] = tilelang.compile(matmul(M, N, K, block_M, 64, 32), out_idx=[2], execution_backend="cython")
+    kernels[specialization_key(M="dynamic")] = tilelang.compile(
+        matmul(T.symbolic("m"), N, K, 64, 64, 32), out_idx=[2], execution_backend="cython"
+    )
+    export_bundle(kernels, path)
+
+
+@tilelang.testing.requires_cuda
+def test_bundle_roundtrip(tmp_path):
+    path = str(tmp_path / "matmul.tlb")
+    build_bundle(path)
+    bundle = load_bundle(path)
+    assert len(bundle) == 3
+    for M in (16, 256):
+        a = torch.randn(M, 256, device="cuda", dtype=torch.float16)
+        b = torch.randn(256, 256, device="cuda", dtype=torch.float16)
+        c = bundle.dispatch(M=M)(a, b)
+        torch.testing.assert_close(c, a @ b, rtol=1e-2, atol=1e-2)
+    a = torch.randn(100, 256, device="cuda", dtype=torch.float16)
+    b = torch.randn(256, 256, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(bundle.dispatch(M="dynamic")(a, b), a @ b, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_bundle_light_import(tmp_path):
+    path = str(tmp_path / "matmul.tlb")
+    build_bundle(path)
+    script = f"""
+import sys
+import torch
+import tilelang.bundle
+bundle = tilelang.bundle.load_bundle({path!r})
+a = torch.randn(16, 256, device="cuda", dtype=torch.float16)
+b = torch.randn(256, 256, device="cuda", dtype=torch.float16)
+torch.testing.assert_close(bundle["M=16"](a, b), a @ b, rtol=1e-2, atol=1e-2)
+assert "tvm" not in sys.modules, "loading a bundle must not import the compiler"
+"""
+    subprocess.run([sys.executable, "-c", script], check=True, env={**os.environ, "TILELANG_LIGHT_IMPORT": "1"})
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,63 @@
+import json
+
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+from tilelang.engine.compile_profile import _parse_nvcc_time
+
+
+def elementwise_add(M, N, block_M, block_N, dtype=T.float16):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_N), dtype)
+            T.copy(A[by * block_M, bx * block_N], A_shared)
+            for i, j in T.Parallel(block_M, block_N):
+                C[by * block_M + i, bx * block_N + j] = A_shared[i, j] + B[by * block_M + i, bx * block_N + j]
+
+    return main
+
+
+def test_parse_nvcc_time(tmp_path):
+    table = tmp_path / "time.csv"
+    table.write_text(
+        "source file name , phase name , arch , tool, metric , unit\n"
+        "k.cu , cicc , compute_90 , nvcc , 120.5 , ms\n"
+        "k.cu , ptxas , sm_90 , nvcc , 40.25 , ms\n"
+        "k.cu , ptxas , sm_90 , nvcc , 9.75 , ms\n"
+    )
+    assert _parse_nvcc_time(str(table)) == {"cicc": 120.5, "ptxas": 50.0}
+    assert not table.exists()
+
+
+@tilelang.testing.requires_cuda
+def test_compile_profile():
+    func = elementwise_add(256, 256, 64, 64)
+    tilelang.disable_cache()
+    kernel = tilelang.compile(func, out_idx=[2])
+    assert kernel.compile_profile is None
+    kernel = tilelang.compile(func, out_idx=[2], pass_configs={tilelang.PassConfigKey.TL_ENABLE_COMPILE_PROFILE: True})
+    tilelang.enable_cache()
+
+    profile = kernel.compile_profile
+    assert profile is not None and profile.kernel_name == "main" and profile.cache is None
+    for stage in ("lower_and_legalize", "optimize_for_target", "device_codegen"):
+        assert profile.stages[stage] > 0
+    assert profile.total_ms >= sum(profile.stages[s] for s in ("lower_and_legalize", "optimize_for_target"))
+
+    layout_inference = [p for p in profile.passes if p.name == "tl.LayoutInference"]
+    assert layout_inference and layout_inference[0].ir_nodes_before > 0
+
+    assert profile.device_compile and profile.device_compile[0].time_ms > 0
+    # The cubin is built by the device codegen of the default backend
+    assert profile.device_compile[0].stage == "device_codegen"
+    assert json.loads(profile.to_json())["passes"][0]["name"] == profile.passes[0].name
+    assert "tl.LayoutInference" in profile.summary(top=100)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,80 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def matmul(M, N, K, block_M, block_N, block_K, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def run_cuda_graph_replay(execution_backend):
+    M = N = K = 256
+    kernel = tilelang.compile(matmul(M, N, K, 64, 64, 32), out_idx=[2], execution_backend=execution_backend)
+    graph = kernel.graph()
+
+    # The first call records the graph, the following ones replay it with new pointers.
+    for _ in range(3):
+        a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+        b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+        c = graph(a, b)
+        torch.testing.assert_close(c, a @ b, rtol=1e-2, atol=1e-2)
+    assert graph.misses == 1
+    assert graph.hits == 2
+    assert graph.num_graphs == 1
+
+    graph.clear()
+    assert graph.num_graphs == 0
+
+
+@tilelang.testing.requires_cuda
+def test_cuda_graph_replay_tvm_ffi():
+    run_cuda_graph_replay("tvm_ffi")
+
+
+@tilelang.testing.requires_cuda
+def test_cuda_graph_replay_cython():
+    run_cuda_graph_replay("cython")
+
+
+@tilelang.testing.requires_rocm
+def test_hip_graph_replay():
+    M = N = K = 256
+    kernel = tilelang.compile(matmul(M, N, K, 64, 64, 32), out_idx=[2])
+    graph = kernel.graph()
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+
+    # hipGraphs are recorded per input pointers, the replays see the new contents
+    for _ in range(3):
+        a.normal_()
+        c = graph(a, b)
+        torch.testing.assert_close(c, a @ b, rtol=1e-2, atol=1e-2)
+    assert graph.misses == 1
+    assert graph.hits == 2
+
+    graph(a.clone(), b)
+    assert graph.num_graphs == 2
+    graph.clear()
+    assert graph.num_graphs == 0
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
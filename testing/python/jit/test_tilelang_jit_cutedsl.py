@@ -311,6 +311,29 @@ def test_cutedsl_dynamic_shape():
     )
 
 
+def tma_copy_with_eviction(M, N, block_M, block_N, dtype=T.float16):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), dtype), B: T.Tensor((M, N), dtype)):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_N), dtype)
+            T.copy(A[by * block_M, bx * block_N], A_shared, eviction_policy="evict_first")
+            T.copy(A_shared, B[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version(9, 0)
+def test_cutedsl_tma_eviction_policy():
+    M, N = 512, 256
+    kernel = tilelang.compile(tma_copy_with_eviction(M, N, 64, 64), out_idx=-1, target="cutedsl")
+    source = kernel.get_kernel_source()
+    assert 'eviction_policy="EVICT_FIRST"' in source
+
+    A = torch.randn(M, N, dtype=torch.float16).cuda()
+    torch.testing.assert_close(kernel(A), A)
+
+
 def check_hopper():
     if not torch.cuda.is_available():
         return False
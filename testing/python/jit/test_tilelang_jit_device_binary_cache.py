@@ -0,0 +1,32 @@
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+
+
+def elementwise_add(M, N, block_M, block_N, dtype=T.float16):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            for i, j in T.Parallel(block_M, block_N):
+                C[by * block_M + i, bx * block_N + j] = A[by * block_M + i, bx * block_N + j] + B[by * block_M + i, bx * block_N + j]
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_device_binary_shared_across_host_variants():
+    func = elementwise_add(256, 256, 64, 64)
+    pass_configs = {tilelang.PassConfigKey.TL_ENABLE_COMPILE_PROFILE: True}
+    tilelang.compile(func, out_idx=[2], pass_configs=pass_configs)
+    # Only the host side differs, the device source is compiled once
+    kernel = tilelang.compile(func, out_idx=None, pass_configs=pass_configs)
+    assert kernel.compile_profile is not None
+    assert not kernel.compile_profile.device_compile
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,45 @@
+import os
+
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+import torch
+from tilelang.jit.adapter.nvrtc import is_nvrtc_available
+
+
+def elementwise_add(M, N, block_M, block_N, dtype=T.float16):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            for i, j in T.Parallel(block_M, block_N):
+                C[by * block_M + i, bx * block_N + j] = A[by * block_M + i, bx * block_N + j] + B[by * block_M + i, bx * block_N + j]
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_device_compile_pch():
+    if not is_nvrtc_available:
+        return
+    from tilelang.contrib import nvrtc
+
+    if not nvrtc.supports_pch():
+        return
+    pass_configs = {tilelang.PassConfigKey.TL_ENABLE_DEVICE_COMPILE_PCH: True}
+    tilelang.disable_cache()
+    kernels = [tilelang.compile(elementwise_add(256, 256, 64, block_N), out_idx=[2], pass_configs=pass_configs) for block_N in (32, 64)]
+    tilelang.enable_cache()
+    assert os.listdir(os.path.dirname(nvrtc.get_pch_dir(["x"])))
+
+    a = torch.randn(256, 256, dtype=torch.float16, device="cuda")
+    b = torch.randn(256, 256, dtype=torch.float16, device="cuda")
+    for kernel in kernels:
+        torch.testing.assert_close(kernel(a, b), a + b)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
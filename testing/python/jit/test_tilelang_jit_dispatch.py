@@ -0,0 +1,58 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tilelang.jit.dispatch import KernelDispatchTable
+
+
+def test_dispatch_table_lru():
+    evicted = []
+    table = KernelDispatchTable(2, on_evict=lambda key, kernel: evicted.append(key))
+    table["a"] = 1
+    table["b"] = 2
+    assert table.get("a") == 1
+    table["c"] = 3
+    # "b" is the least recently used entry once "a" was looked up
+    assert evicted == ["b"]
+    assert "b" not in table and "a" in table and "c" in table
+    assert table.get("b") is None
+
+    stats = table.stats()
+    assert (stats.hits, stats.misses, stats.evictions, stats.size) == (1, 1, 1, 2)
+    assert stats.hit_rate == 0.5
+    table.reset_stats()
+    assert table.stats().hits == 0
+
+
+def test_dispatch_table_unbounded():
+    table = KernelDispatchTable(0)
+    for i in range(100):
+        table[i] = i
+    assert len(table) == 100
+    assert table.stats().evictions == 0
+
+
+@tilelang.testing.requires_cuda
+def test_jit_kernel_cache_capacity():
+    @tilelang.jit(kernel_cache_capacity=2)
+    def add_one(A, B):
+        N = T.const("N")
+        A: T.Tensor[[N], T.float32]
+        B: T.Tensor[[N], T.float32]
+        with T.Kernel(T.ceildiv(N, 128), threads=128) as bx:
+            for i in T.Parallel(128):
+                B[bx * 128 + i] = A[bx * 128 + i] + 1
+
+    for N in (128, 256, 128, 384, 256):
+        a = torch.randn(N, device="cuda")
+        b = torch.empty_like(a)
+        add_one(a, b)
+        torch.testing.assert_close(b, a + 1)
+
+    stats = add_one.cache_stats()
+    # 256 was evicted by 384, 128 being used more recently
+    assert (stats.hits, stats.misses, stats.evictions, stats.size) == (1, 4, 2, 2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,54 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def scale_add(N, block_N=128, dtype=T.float16):
+    @T.prim_func
+    def main(A: T.Tensor((N,), dtype), B: T.Tensor((N,), dtype), C: T.Tensor((N,), dtype)):
+        with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+            for i in T.Parallel(block_N):
+                C[bx * block_N + i] = A[bx * block_N + i] * 2 + B[bx * block_N + i]
+
+    return main
+
+
+class ForeignTensor:
+    """A tensor of another framework, only known through DLPack"""
+
+    def __init__(self, tensor):
+        self._tensor = tensor
+        self.streams = []
+
+    def __dlpack__(self, stream=None):
+        self.streams.append(stream)
+        return self._tensor.__dlpack__(stream=stream)
+
+    def __dlpack_device__(self):
+        return self._tensor.__dlpack_device__()
+
+
+@tilelang.testing.requires_cuda
+def test_call_dlpack():
+    N = 1024
+    kernel = tilelang.compile(scale_add(N), out_idx=[2], execution_backend="tvm_ffi")
+    a = torch.randn(N, device="cuda", dtype=torch.float16)
+    b = torch.randn(N, device="cuda", dtype=torch.float16)
+    fa, fb = ForeignTensor(a), ForeignTensor(b)
+
+    out = kernel.call_dlpack(fa, fb)
+    c = torch.from_dlpack(out)
+    torch.testing.assert_close(c, a * 2 + b)
+    # The producers are handed the legacy default stream the kernel runs on
+    assert fa.streams == [1] and fb.streams == [1]
+
+    stream = torch.cuda.Stream()
+    out = kernel.call_dlpack(fa, fb, stream=stream.cuda_stream)
+    stream.synchronize()
+    assert fa.streams[-1] == stream.cuda_stream
+    torch.testing.assert_close(torch.from_dlpack(out), a * 2 + b)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,41 @@
+import ctypes
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def scale(M, N, block_M=64, dtype=T.float16):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), dtype), B: T.Tensor((M, N), dtype)):
+        with T.Kernel(T.ceildiv(M, block_M), threads=128) as bx:
+            for i, j in T.Parallel(block_M, N):
+                B[bx * block_M + i, j] = A[bx * block_M + i, j] * 2.0
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_export_c_dynamic(tmp_path):
+    kernel = tilelang.compile(scale(T.dynamic("m"), 256), out_idx=[1], execution_backend="cython")
+    paths = kernel.export_c(str(tmp_path), name="scale")
+    with open(paths["header"]) as f:
+        header = f.read()
+    assert "int scale_launch(half* A, half* B, int m, cudaStream_t stream);" in header
+    with open(paths["source"]) as f:
+        source = f.read()
+    assert 'extern "C" int call(' not in source
+
+    lib = ctypes.CDLL(paths["library"])
+    lib.scale_get_last_error.restype = ctypes.c_char_p
+    assert lib.scale_init() == 0, lib.scale_get_last_error()
+    a = torch.randn(1000, 256, device="cuda", dtype=torch.float16)
+    b = torch.empty_like(a)
+    stream = torch.cuda.current_stream().cuda_stream
+    assert lib.scale_launch(ctypes.c_void_p(a.data_ptr()), ctypes.c_void_p(b.data_ptr()), 1000, ctypes.c_void_p(stream)) == 0
+    torch.testing.assert_close(b, a * 2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
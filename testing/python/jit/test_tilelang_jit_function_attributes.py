@@ -0,0 +1,62 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def matmul(M, N, K, block_M, block_N, block_K, num_stages, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(8, 0)
+def test_function_attributes_per_device():
+    M = N = K = 512
+    # 96KB of dynamic shared memory, above the 48KB allowed without the attribute
+    kernel = tilelang.compile(matmul(M, N, K, 128, 128, 64, 3), out_idx=[2], execution_backend="cython")
+    source = kernel.get_host_source()
+    assert "cudaFuncAttributeMaxDynamicSharedMemorySize" in source
+    assert "cudaFuncAttributePreferredSharedMemoryCarveout" in source
+    assert "ensure_attributes()" in source
+    # the attributes are set on every device the kernel runs on, not only the one current at load time
+    for device in range(torch.cuda.device_count()):
+        with torch.cuda.device(device):
+            a = torch.randn(M, K, device=f"cuda:{device}", dtype=torch.float16)
+            b = torch.randn(K, N, device=f"cuda:{device}", dtype=torch.float16)
+            torch.testing.assert_close(kernel(a, b), a @ b, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_function_attributes_without_shared_memory():
+    @T.prim_func
+    def add_one(A: T.Tensor((1024,), T.float32), B: T.Tensor((1024,), T.float32)):
+        with T.Kernel(8, threads=128) as bx:
+            for i in T.Parallel(128):
+                B[bx * 128 + i] = A[bx * 128 + i] + 1
+
+    kernel = tilelang.compile(add_one, out_idx=[1], execution_backend="cython")
+    # the carveout of a kernel without shared memory leaves the whole L1
+    assert "cudaFuncAttributePreferredSharedMemoryCarveout, 0)" in kernel.get_host_source()
+    a = torch.randn(1024, device="cuda")
+    torch.testing.assert_close(kernel(a), a + 1)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,66 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tilelang.bundle import export_bundle, load_bundle, select_arch
+
+
+def matmul(M, N, K, block_M, block_N, block_K, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def test_select_arch():
+    archs = ["sm_80", "sm_90a", "sm_100a"]
+    assert select_arch(archs, (8, 0)) == "sm_80"
+    # SASS runs on later minor versions of its major version
+    assert select_arch(archs, (8, 9)) == "sm_80"
+    assert select_arch(archs, (9, 0)) == "sm_90a"
+    assert select_arch(archs, (10, 0)) == "sm_100a"
+    # neither across major versions nor for arch specific targets
+    assert select_arch(archs, (12, 0)) is None
+    assert select_arch(["sm_90a"], (9, 1)) is None
+    assert select_arch(["sm_100f", "sm_100a"], (10, 3)) == "sm_100f"
+    assert select_arch(["sm_80", "sm_86"], (8, 9)) == "sm_86"
+
+
+def _current_arch():
+    major, minor = torch.cuda.get_device_capability()
+    return f"sm_{major}{minor}" + ("a" if major >= 9 else "")
+
+
+@tilelang.testing.requires_cuda
+def test_multi_arch_kernel(tmp_path):
+    M = N = K = 256
+    archs = list(dict.fromkeys(["sm_80", _current_arch()]))
+    kernel = tilelang.jit.compile_multi_arch(matmul(M, N, K, 64, 64, 32), archs=archs, out_idx=[2])
+    assert kernel.archs == archs
+    assert kernel.select() is kernel.kernels[_current_arch()]
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(a, b), a @ b, rtol=1e-2, atol=1e-2)
+
+    path = str(tmp_path / "matmul.tlb")
+    export_bundle({"matmul": kernel}, path)
+    bundled = load_bundle(path)["matmul"]
+    torch.testing.assert_close(bundled(a, b), a @ b, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,56 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def matmul(M, N, K, block_M, block_N, block_K, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def test_assume_divisible():
+    func = matmul(T.dynamic("m"), 128, T.dynamic("k"), 64, 64, 32)
+    assumed = tilelang.jit.multiversion.assume_divisible(func, {"m": 64, "k": 32})
+    script = assumed.script()
+    assert script.count("T.assume") == 2
+    assert "T.assume" not in func.script()
+
+
+@tilelang.testing.requires_cuda
+def test_multiversion_matmul():
+    N = 128
+    kernel = tilelang.jit.compile_multiversion(
+        matmul(T.dynamic("m"), N, T.dynamic("k"), 64, 64, 32),
+        divisible={"m": 64, "k": 32},
+        out_idx=[2],
+    )
+    for M, K, fast in ((128, 64, True), (100, 64, False), (128, 48, False)):
+        a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+        b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+        assert (kernel.select(a, b) is kernel.fast) == fast
+        torch.testing.assert_close(kernel(a, b), a @ b, rtol=1e-2, atol=1e-2)
+
+    a = torch.empty(128 * 64 + 1, device="cuda", dtype=torch.float16)[1:].view(128, 64)
+    b = torch.randn(64, N, device="cuda", dtype=torch.float16)
+    assert kernel.select(a, b) is kernel.checked
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -173,6 +173,29 @@ def test_gemm_jit_kernel():
     )
 
 
+@tilelang.testing.requires_cuda
+def test_nvrtc_in_memory_cubin():
+    program = matmul(512, 1024, 768, 128, 256, 32, False, False, T.float16, T.float16, T.float16, 2, 128)
+    tilelang.disable_cache()
+    matmul_kernel = tilelang.compile(program, out_idx=-1, execution_backend="nvrtc")
+    tilelang.enable_cache()
+
+    lib_generator = matmul_kernel.adapter.lib_generator
+    # Loaded straight from memory, nothing was written to disk
+    assert lib_generator.cubin and lib_generator.libpath is None
+
+    a = torch.randn(512, 768, dtype=torch.float16).cuda()
+    b = torch.randn(768, 1024, dtype=torch.float16).cuda()
+    tilelang.testing.torch_assert_close(matmul_kernel(a, b), a @ b, atol=1e-2, rtol=1e-2, max_mismatched_ratio=0.05)
+
+    # The files are written on demand
+    libpath = matmul_kernel.adapter.libpath
+    with open(libpath, "rb") as f:
+        assert f.read() == lib_generator.cubin
+    with open(libpath.replace(".cubin", ".py")) as f:
+        assert f.read() == lib_generator.host_func
+
+
 def run_nvrtc_kernel_do_bench(
     M, N, K, trans_A, trans_B, in_dtype, out_dtype, dtypeAccum, block_M, block_N, block_K, num_stages=3, num_threads=128
 ):
@@ -0,0 +1,91 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tilelang.jit.online import OnlineTunedKernel
+
+
+class _Timing:
+    """Completed pair of events measuring a fixed latency."""
+
+    def __init__(self, latency):
+        self.latency = latency
+
+    def query(self):
+        return True
+
+    def elapsed_time(self, end):
+        return end.latency
+
+
+def _feed(kernel, key, latencies, rounds):
+    for _ in range(rounds):
+        for variant, latency in latencies.items():
+            kernel._pending.append((key, variant, _Timing(0), _Timing(latency)))
+    kernel._harvest()
+
+
+def test_online_promotion():
+    kernel = OnlineTunedKernel(["slow", "fast", "worse"], configs=[{"v": 0}, {"v": 1}, {"v": 2}], min_samples=4)
+    key = ((128, 128),)
+    state = kernel._state(key)
+    _feed(kernel, key, {0: 1.0, 1: 0.5}, 3)
+    # not enough samples to compare yet
+    assert state.active == 0
+    _feed(kernel, key, {0: 1.0, 1: 0.5, 2: 1.2}, 4)
+    state = kernel._state(key)
+    assert state.active == 1 and kernel.promotions == 1
+    assert state.retired == {0}
+    # a slower alternative is retired and never sampled again
+    _feed(kernel, key, {1: 0.5, 2: 1.2}, 4)
+    assert 2 in state.retired
+    assert state.candidate(3) is None
+    # shadow launches of slow alternatives stretch the period
+    assert kernel.period >= 1.2 / (0.5 * kernel.max_overhead)
+
+
+def matmul(M, N, K, block_M, block_N, block_K=32, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_online_matmul():
+    N = K = 512
+    kernel = tilelang.jit.compile_online(
+        lambda block_M, block_N: matmul(T.dynamic("m"), N, K, block_M, block_N),
+        configs=[dict(block_M=16, block_N=32), dict(block_M=128, block_N=128)],
+        period=1,
+        min_samples=3,
+        max_overhead=1.0,
+        out_idx=[2],
+    )
+    a = torch.randn(1024, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    for _ in range(20):
+        torch.testing.assert_close(kernel(a, b), a @ b, rtol=1e-2, atol=1e-2)
+    torch.cuda.synchronize()
+    kernel(a, b)
+    assert kernel.shadow_launches > 0
+    # the tiny tiles lose on a large problem
+    assert kernel.active_config(a, b) == dict(block_M=128, block_N=128)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,59 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tilelang.engine.lower import extrac_params
+from tilelang.jit.adapter.workspace import WorkspaceLayout, get_workspace_pool
+
+
+def accumulate(M, N, block_N=128):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), T.float32),
+        Partial: T.Workspace((N,), T.float32, zero_init=True),
+        Scratch: T.Workspace((M,), T.float32),
+        B: T.Tensor((N,), T.float32),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+            for i in T.serial(M):
+                for j in T.Parallel(block_N):
+                    Partial[bx * block_N + j] += A[i, bx * block_N + j]
+            for j in T.Parallel(block_N):
+                B[bx * block_N + j] = Partial[bx * block_N + j]
+
+    return main
+
+
+def test_workspace_params():
+    params = extrac_params(accumulate(64, 256))
+    assert [(p.workspace, p.zero_init) for p in params] == [(False, False), (True, True), (True, False), (False, False)]
+
+
+def test_workspace_layout():
+    n = T.dynamic("n")
+    params = extrac_params(accumulate(n, 256))
+    layout = WorkspaceLayout(params, [3], lambda: torch.device("cpu"), lambda: 0)
+    assert layout.num_inputs == 1 and layout.positions == [0, None, None]
+    # The zeroed workspace first, 256 byte aligned
+    a = torch.randn(5, 256)
+    _, partial, scratch = layout.insert([a])
+    assert partial.shape == (256,) and scratch.shape == (5,)
+    assert partial.dtype == scratch.dtype == torch.float32
+    assert scratch.data_ptr() - partial.data_ptr() == 1024
+    partial.fill_(1.0)
+    assert layout.insert([a])[1].eq(0).all()
+
+
+@tilelang.testing.requires_cuda
+def test_workspace_call():
+    M, N = 64, 256
+    kernel = tilelang.compile(accumulate(M, N), out_idx=[3])
+    a = torch.randn(M, N, device="cuda")
+    # Every call starts from a zeroed workspace
+    for _ in range(2):
+        torch.testing.assert_close(kernel(a), a.sum(0), rtol=1e-4, atol=1e-4)
+    assert get_workspace_pool().nbytes() >= 2 * N * 4
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
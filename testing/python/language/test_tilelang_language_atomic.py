@@ -487,6 +487,19 @@ def test_atomic_add_auto_vectorized():
     run_atomic_add_auto_vectorized(8, 128, 128, 32, 32)
 
 
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_tile_atomic_add_half_vectorized():
+    # 16-bit tile atomics lower to a single 128-bit red per 8 elements on sm90+
+    for dtype in (T.float16, T.bfloat16):
+        kernel = tile_atomic_add_program(8, 128, 128, 32, 32, dtype=dtype)
+        assert "AtomicAddx8" in kernel.get_kernel_source()
+        A = torch.randn(8, 128, 128, dtype=getattr(torch, dtype)).cuda()
+        B = torch.zeros(128, 128, dtype=getattr(torch, dtype)).cuda()
+        kernel(A, B)
+        torch.testing.assert_close(B, A.float().sum(0).to(B.dtype), atol=1e-1, rtol=1e-2)
+
+
 @tilelang.jit
 def atomic_add_complicated_parallel_program(K, M, N, block_M, block_N, dtype=T.float32):
     @T.prim_func
@@ -514,5 +527,41 @@ def test_atomic_add_complicated_parallel():
     run_atomic_add_complicated_parallel(8, 128, 128, 32, 32)
 
 
+@tilelang.jit
+def histogram_program(N, bins, block=256):
+    @T.prim_func
+    def histogram(
+        X: T.Tensor((N,), T.int32),
+        W: T.Tensor((N,), T.float32),
+        H: T.Tensor((bins,), T.float32),
+        M: T.Tensor((bins,), T.float32),
+    ):
+        with T.Kernel(T.ceildiv(N, block), threads=block) as bx:
+            for i in T.Parallel(block):
+                T.atomic_add(H[X[bx * block + i]], W[bx * block + i])
+                T.atomic_max(M[X[bx * block + i]], W[bx * block + i])
+
+    return histogram
+
+
+@tilelang.testing.requires_cuda
+def test_atomic_warp_aggregated():
+    N, bins = 8192, 4
+    kernel = histogram_program(N, bins)
+    source = kernel.get_kernel_source()
+    assert "AtomicAddAggregated(" in source and "AtomicMaxAggregated(" in source
+    # the destinations of the other kernels are distinct per lane
+    assert "Aggregated" not in atomic_add_program(2, 64, 64, 32, 32).get_kernel_source()
+    X = torch.randint(0, bins, (N,), dtype=torch.int32).cuda()
+    W = torch.rand(N).cuda()
+    H = torch.zeros(bins).cuda()
+    M = torch.zeros(bins).cuda()
+    kernel(X, W, H, M)
+    ref_H = torch.zeros(bins).cuda().index_add_(0, X.long(), W)
+    ref_M = torch.zeros(bins).cuda().index_reduce_(0, X.long(), W, "amax")
+    torch.testing.assert_close(H, ref_H, atol=1e-2, rtol=1e-4)
+    torch.testing.assert_close(M, ref_M)
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
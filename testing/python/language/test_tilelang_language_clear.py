@@ -1,5 +1,6 @@
 import tilelang
 import tilelang.language as T
+import tilelang.testing
 
 
 # add decorator @tilelang.jit if you want to return a torch function
@@ -55,5 +56,29 @@ def test_matmul():
     run_matmul(1024, 1024, 1024, 128, 128, 32)
 
 
+def fill_staging(M, N, dtype=T.float16):
+    @T.prim_func
+    def main(B: T.Tensor((2, M, N), dtype)):
+        with T.Kernel(1, threads=128):
+            S = T.alloc_shared((2, M, N), dtype)
+            T.fill(S[0, :, :], 1.0)
+            T.fill(S[1, :, :], 2.0)
+            T.copy(S, B)
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_fill_shared_vectorized():
+    import torch
+
+    kernel = tilelang.compile(fill_staging(64, 96), out_idx=[0], pass_configs={"tl.disable_tma_lower": True})
+    # each slice is filled with 128-bit stores
+    assert "uint4" in kernel.get_kernel_source()
+    b = kernel()
+    torch.testing.assert_close(b[0], torch.full_like(b[0], 1.0))
+    torch.testing.assert_close(b[1], torch.full_like(b[1], 2.0))
+
+
 if __name__ == "__main__":
-    test_matmul()
+    tilelang.testing.main()
@@ -0,0 +1,147 @@
+import math
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+import torch.nn.functional as F
+
+
+def _out_shape(spatial, kernel, stride, dilation, pad):
+    return [(s + 2 * p - d * (k - 1) - 1) // st + 1 for s, k, st, d, p in zip(spatial, kernel, stride, dilation, pad)]
+
+
+def conv_fprop(N, spatial, C, Fo, kernel, stride, dilation, pad, groups, block_M=64, block_N=64, block_K=32, dtype=T.float16):
+    Cg, Fg = C // groups, Fo // groups
+    M = N * math.prod(_out_shape(spatial, kernel, stride, dilation, pad))
+    KV = math.prod(kernel) * Cg
+
+    @T.prim_func
+    def main(
+        data: T.Tensor((N, *spatial, C), dtype),
+        weight: T.Tensor((groups, KV, Fg), dtype),
+        out: T.Tensor((groups, M, Fg), dtype),
+    ):
+        with T.Kernel(T.ceildiv(Fg, block_N), T.ceildiv(M, block_M), groups, threads=128) as (bx, by, g):
+            data_shared = T.alloc_shared((block_M, block_K), dtype)
+            weight_shared = T.alloc_shared((block_K, block_N), dtype)
+            acc = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(acc)
+            for k in T.Pipelined(T.ceildiv(KV, block_K), num_stages=2):
+                T.conv_im2col(data, data_shared, by, k, kernel, stride, dilation, pad, groups=groups, group=g)
+                T.copy(weight[g, k * block_K, bx * block_N], weight_shared)
+                T.gemm(data_shared, weight_shared, acc)
+            T.copy(acc, out[g, by * block_M, bx * block_N])
+
+    return main
+
+
+def run_conv_fprop(N, spatial, C, Fo, kernel, stride, dilation, pad, groups):
+    R = len(spatial)
+    kernel_fn = tilelang.compile(conv_fprop(N, spatial, C, Fo, kernel, stride, dilation, pad, groups), out_idx=[2])
+    Cg, Fg = C // groups, Fo // groups
+    x = torch.randn(N, *spatial, C, device="cuda", dtype=torch.float16)
+    w = torch.randn(groups, *kernel, Cg, Fg, device="cuda", dtype=torch.float16)
+    out = kernel_fn(x, w.reshape(groups, -1, Fg))
+
+    conv = {1: F.conv1d, 2: F.conv2d, 3: F.conv3d}[R]
+    x_ref = x.permute(0, R + 1, *range(1, R + 1)).float()
+    # [groups, *kernel, Cg, Fg] -> [groups * Fg, Cg, *kernel]
+    w_ref = w.permute(0, R + 2, R + 1, *range(1, R + 1)).reshape(Fo, Cg, *kernel).float()
+    ref = conv(x_ref, w_ref, stride=stride, padding=pad, dilation=dilation, groups=groups)
+    ref = ref.permute(0, *range(2, R + 2), 1).reshape(-1, groups, Fg).permute(1, 0, 2)
+    torch.testing.assert_close(out.float(), ref, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_conv_im2col_2d_non_square():
+    run_conv_fprop(2, (18, 20), 64, 64, (3, 5), (2, 1), (1, 2), (1, 2), groups=1)
+
+
+@tilelang.testing.requires_cuda
+def test_conv_im2col_3d_grouped():
+    run_conv_fprop(2, (6, 10, 10), 64, 128, (3, 3, 3), (1, 2, 2), (1, 1, 1), (1, 1, 1), groups=2)
+
+
+@tilelang.testing.requires_cuda
+def test_conv_im2col_1d():
+    run_conv_fprop(4, (100,), 32, 64, (5,), (2,), (1,), (2,), groups=1)
+
+
+def conv_dgrad(N, spatial, C, Fo, kernel, stride, pad, phases, taps, block_M=64, block_N=64, block_K=32, dtype=T.float16):
+    """dX of a stride-s 2D convolution, one grid z per stride phase when `phases` is set."""
+    s = stride
+    if phases:
+        pixels = [x // s for x in spatial]
+        num_phases = s * s
+    else:
+        pixels = list(spatial)
+        num_phases = 1
+    out_spatial = _out_shape(spatial, (kernel, kernel), (s, s), (1, 1), (pad, pad))
+    M = N * math.prod(pixels)
+    KV = taps * Fo
+
+    @T.prim_func
+    def main(
+        dy: T.Tensor((N, *out_spatial, Fo), dtype),
+        weight: T.Tensor((num_phases, KV, C), dtype),
+        dx: T.Tensor((num_phases, M, C), dtype),
+    ):
+        with T.Kernel(T.ceildiv(C, block_N), T.ceildiv(M, block_M), num_phases, threads=128) as (bx, by, ph):
+            dy_shared = T.alloc_shared((block_M, block_K), dtype)
+            weight_shared = T.alloc_shared((block_K, block_N), dtype)
+            acc = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(acc)
+            for k in T.Pipelined(T.ceildiv(KV, block_K), num_stages=2):
+                if phases:
+                    T.conv_im2col(dy, dy_shared, by, k, kernel, s, 1, pad, mode="dgrad", input_shape=spatial, phase=(ph // s, ph % s))
+                else:
+                    T.conv_im2col(dy, dy_shared, by, k, kernel, s, 1, pad, mode="dgrad", input_shape=spatial)
+                T.copy(weight[ph, k * block_K, bx * block_N], weight_shared)
+                T.gemm(dy_shared, weight_shared, acc)
+            T.copy(acc, dx[ph, by * block_M, bx * block_N])
+
+    return main
+
+
+def run_conv_dgrad(phases):
+    N, H, W, C, Fo, K, S, P = 2, 16, 16, 64, 64, 3, 2, 1
+    x = torch.randn(N, C, H, W, device="cuda", requires_grad=True)
+    w = torch.randn(K, K, C, Fo, device="cuda", dtype=torch.float16)
+    y = F.conv2d(x, w.permute(3, 2, 0, 1).float(), stride=S, padding=P)
+    dy = torch.randn_like(y)
+    y.backward(dy)
+    dy = dy.permute(0, 2, 3, 1).contiguous().half()
+
+    def taps_weight(first_h, count_h, first_w, count_w, rows):
+        # Rows (tap, f) of the im2col tile, columns c; zero rows pad the taps a phase does not have
+        packed = [w[first_h + S * th, first_w + S * tw].t() for th in range(count_h) for tw in range(count_w)]
+        packed = torch.cat(packed) if packed else w.new_zeros(0, C)
+        return torch.cat([packed, packed.new_zeros(rows - packed.shape[0], C)])
+
+    if not phases:
+        weight = taps_weight(0, K, 0, K, K * K * Fo)[None]
+        kernel = tilelang.compile(conv_dgrad(N, (H, W), C, Fo, K, S, P, False, K * K), out_idx=[2])
+        dx = kernel(dy, weight).reshape(N, H, W, C)
+    else:
+        phase_taps = [T.conv_dgrad_phase_taps(K, S, P, p) for p in range(S)]
+        taps = max(ch * cw for _, ch in phase_taps for _, cw in phase_taps)
+        weight = torch.stack([taps_weight(*phase_taps[ph], *phase_taps[pw], taps * Fo) for ph in range(S) for pw in range(S)])
+        kernel = tilelang.compile(conv_dgrad(N, (H, W), C, Fo, K, S, P, True, taps), out_idx=[2])
+        out = kernel(dy, weight).reshape(S, S, N, H // S, W // S, C)
+        dx = out.permute(2, 3, 0, 4, 1, 5).reshape(N, H, W, C)
+    torch.testing.assert_close(dx.float(), x.grad.permute(0, 2, 3, 1), rtol=1e-2, atol=1e-1)
+
+
+@tilelang.testing.requires_cuda
+def test_conv_im2col_strided_dgrad():
+    run_conv_dgrad(phases=False)
+
+
+@tilelang.testing.requires_cuda
+def test_conv_im2col_strided_dgrad_phases():
+    run_conv_dgrad(phases=True)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
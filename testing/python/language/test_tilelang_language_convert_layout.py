@@ -0,0 +1,58 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def convert(N, M, dst_fn, dtype=T.float32):
+    # N rows over 32 threads, row i held by thread i in src
+    @T.prim_func
+    def main(A: T.Tensor((N, M), dtype), B: T.Tensor((N, M), dtype)):
+        with T.Kernel(1, threads=32):
+            src = T.alloc_fragment((N, M), dtype)
+            dst = T.alloc_fragment((N, M), dtype)
+            T.annotate_layout(
+                {
+                    src: T.Fragment((N, M), forward_fn=lambda i, j: (i, j)),
+                    dst: T.Fragment((N, M), forward_fn=dst_fn),
+                }
+            )
+            T.copy(A, src)
+            T.convert_layout(src, dst)
+            T.copy(dst, B)
+
+    return main
+
+
+def run_convert(N, M, dst_fn, dtype=T.float32):
+    kernel = tilelang.compile(convert(N, M, dst_fn, dtype), out_idx=[1])
+    a = torch.randn(N, M, device="cuda", dtype={T.float32: torch.float32, T.float16: torch.float16}[dtype])
+    torch.testing.assert_close(kernel(a), a)
+    return kernel.get_kernel_source()
+
+
+@tilelang.testing.requires_cuda
+def test_convert_layout_registers():
+    # Same thread, other local index
+    source = run_convert(32, 8, lambda i, j: (i, 7 - j))
+    assert "shfl_sync" not in source
+    assert "__shared__" not in source
+
+
+@tilelang.testing.requires_cuda
+def test_convert_layout_shuffle():
+    # Row i moves to lane 31 - i at the same local index
+    for dtype in (T.float32, T.float16):
+        source = run_convert(32, 8, lambda i, j: (31 - i, j), dtype)
+        assert "shfl_sync" in source
+        assert "__shared__" not in source
+
+
+@tilelang.testing.requires_cuda
+def test_convert_layout_shared():
+    # A transpose reads every lane at a different local index
+    run_convert(32, 32, lambda i, j: (j, i))
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
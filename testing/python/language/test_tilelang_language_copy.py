@@ -183,5 +183,257 @@ def test_tilelang_copy_fp4():
     run_tilelang_copy_fp4(src_dtype=T.float4_e2m1fn, dst_dtype=T.bfloat16)
 
 
+def tilelang_copy_tma_replace_address(M, N, block_M, block_N, dtype=T.float16):
+    num_ctas = T.ceildiv(N, block_N) * T.ceildiv(M, block_M)
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        A_actual: T.Tensor((M, N), dtype),
+        Workspace: T.Tensor((num_ctas, 128), T.uint8),
+        B: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_N), dtype)
+            # The descriptor is encoded for A on the host and retargeted to A_actual on device.
+            T.copy(
+                A[by * block_M, bx * block_N],
+                A_shared,
+                tma_global_address=T.address_of(A_actual[0, 0]),
+                tma_desc_workspace=Workspace[by * T.ceildiv(N, block_N) + bx, 0],
+            )
+            T.copy(A_shared, B[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_tilelang_copy_tma_replace_address():
+    M, N, block_M, block_N = 1024, 1024, 128, 64
+    program = tilelang_copy_tma_replace_address(M, N, block_M, block_N)
+    kernel = tilelang.compile(program, out_idx=[3], pass_configs={tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True})
+    assert "tl::tma_descriptor_replace_address" in kernel.get_kernel_source()
+    a = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    a_actual = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    workspace = torch.empty((M // block_M) * (N // block_N), 128, device="cuda", dtype=torch.uint8)
+    b = kernel(a, a_actual, workspace)
+    torch.testing.assert_close(b, a_actual)
+
+
+def tilelang_copy_tma_multicast(M, N, block_M, block_N, dtype=T.float16):
+    # Both blocks of a (1, 2) cluster copy the same tile of A.
+    @T.prim_func
+    def main(
+        A: T.Tensor((M // 2, N), dtype),
+        B: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128, cluster_dims=(1, 2)) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_N), dtype)
+            T.copy(A[(by // 2) * block_M, bx * block_N], A_shared, multicast=0b11)
+            T.copy(A_shared, B[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_tilelang_copy_tma_multicast():
+    M, N, block_M, block_N = 1024, 1024, 128, 64
+    program = tilelang_copy_tma_multicast(M, N, block_M, block_N)
+    kernel = tilelang.compile(program, out_idx=[1], pass_configs={tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True})
+    source = kernel.get_kernel_source()
+    assert "tl::tma_load_multicast" in source
+    assert "__cluster_dims__(1, 2, 1)" in source
+    a = torch.randn(M // 2, N, device="cuda", dtype=torch.float16)
+    b = kernel(a)
+    ref = a.view(M // 2 // block_M, block_M, N).repeat_interleave(2, dim=0).view(M, N)
+    torch.testing.assert_close(b, ref)
+
+
+def tilelang_copy_cache_hint(M, N, block_M, block_N, load_hint=None, store_hint=None, dtype=T.float16):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_frag = T.alloc_fragment((block_M, block_N), dtype)
+            T.copy(A[by * block_M, bx * block_N], A_frag, cache_hint=load_hint)
+            T.copy(A_frag, B[by * block_M, bx * block_N], cache_hint=store_hint)
+
+    return main
+
+
+def run_tilelang_copy_cache_hint(load_hint=None, store_hint=None, infer=True):
+    M, N, block_M, block_N = 1024, 1024, 64, 64
+    program = tilelang_copy_cache_hint(M, N, block_M, block_N, load_hint, store_hint)
+    kernel = tilelang.compile(
+        program,
+        out_idx=[1],
+        pass_configs={
+            tilelang.PassConfigKey.TL_DISABLE_TMA_LOWER: True,
+            tilelang.PassConfigKey.TL_DISABLE_CACHE_HINT_INFERENCE: not infer,
+        },
+    )
+    a = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(a), a)
+    return kernel.get_kernel_source()
+
+
+@tilelang.testing.requires_cuda
+def test_tilelang_copy_cache_hint():
+    source = run_tilelang_copy_cache_hint(load_hint="evict_last", store_hint="evict_first")
+    assert "tl::ld_global_hint<2>" in source
+    assert "tl::st_global_hint<1>" in source
+
+    # Each tile of A is read by one block only: streamed with no_allocate.
+    source = run_tilelang_copy_cache_hint()
+    assert "tl::ld_global_hint<3>" in source
+    assert "tl::st_global_hint" not in source
+
+    source = run_tilelang_copy_cache_hint(infer=False)
+    assert "tl::ld_global_hint" not in source
+
+
+@tilelang.testing.requires_cuda
+def test_tilelang_prefetch():
+    M, N, block_M, block_N = 1024, 1024, 64, 64
+
+    @T.prim_func
+    def main(A: T.Tensor((M, N), T.float16), B: T.Tensor((M, N), T.float16)):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_frag = T.alloc_fragment((block_M, block_N), T.float16)
+            T.prefetch(A[by * block_M : (by + 1) * block_M, bx * block_N : (bx + 1) * block_N])
+            T.copy(A[by * block_M, bx * block_N], A_frag)
+            T.copy(A_frag, B[by * block_M, bx * block_N])
+
+    kernel = tilelang.compile(main, out_idx=[1], pass_configs={tilelang.PassConfigKey.TL_DISABLE_TMA_LOWER: True})
+    assert "prefetch_l2(" in kernel.get_kernel_source()
+    a = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(a), a)
+
+
+@tilelang.testing.requires_cuda
+def test_tilelang_gather_copy():
+    num_pages, page_size, D, block_N, batch = 16, 32, 64, 64, 4
+    pages_per_seq = num_pages // batch
+
+    @T.prim_func
+    def main(
+        KV: T.Tensor((num_pages * page_size, D), T.float16),
+        block_table: T.Tensor((batch, pages_per_seq), T.int32),
+        Out: T.Tensor((batch, pages_per_seq * page_size, D), T.float16),
+    ):
+        with T.Kernel(pages_per_seq * page_size // block_N, batch, threads=128) as (bx, by):
+            KV_shared = T.alloc_shared((block_N, D), T.float16)
+            T.gather_copy(KV, block_table[by, :], KV_shared, page_size=page_size, offset=bx * block_N)
+            T.copy(KV_shared, Out[by, bx * block_N, 0])
+
+    kernel = tilelang.compile(main, out_idx=[2])
+    kv = torch.randn(num_pages * page_size, D, device="cuda", dtype=torch.float16)
+    table = torch.randperm(num_pages, device="cuda", dtype=torch.int32).view(batch, pages_per_seq)
+    rows = (table[:, :, None] * page_size + torch.arange(page_size, device="cuda")).view(batch, -1)
+    torch.testing.assert_close(kernel(kv, table), kv[rows.long()])
+
+
+@tilelang.testing.requires_cuda
+def test_tilelang_gather_scatter():
+    M, D, block_M = 256, 128, 64
+
+    @T.prim_func
+    def permute(
+        X: T.Tensor((M, D), T.float16),
+        src_ids: T.Tensor((M,), T.int32),
+        dst_ids: T.Tensor((M,), T.int32),
+        Y: T.Tensor((M, D), T.float16),
+    ):
+        with T.Kernel(M // block_M, threads=128) as bx:
+            X_shared = T.alloc_shared((block_M, D), T.float16)
+            T.gather(X, src_ids[bx * block_M :], X_shared)
+            T.scatter(X_shared, dst_ids[bx * block_M :], Y)
+
+    @T.prim_func
+    def combine(
+        X: T.Tensor((M, D), T.float32),
+        dst_ids: T.Tensor((M,), T.int32),
+        Y: T.Tensor((M // 2, D), T.float32),
+    ):
+        with T.Kernel(M // block_M, threads=128) as bx:
+            X_frag = T.alloc_fragment((block_M, D), T.float32)
+            T.copy(X[bx * block_M, 0], X_frag)
+            T.scatter(X_frag, dst_ids[bx * block_M :], Y, reduce="add")
+
+    x = torch.randn(M, D, device="cuda", dtype=torch.float16)
+    src_ids = torch.randperm(M, device="cuda", dtype=torch.int32)
+    dst_ids = torch.randperm(M, device="cuda", dtype=torch.int32)
+    y = torch.empty_like(x)
+    tilelang.compile(permute)(x, src_ids, dst_ids, y)
+    ref = torch.empty_like(x)
+    ref[dst_ids.long()] = x[src_ids.long()]
+    torch.testing.assert_close(y, ref)
+
+    x = torch.randn(M, D, device="cuda", dtype=torch.float32)
+    dst_ids = torch.arange(M, device="cuda", dtype=torch.int32) // 2
+    y = torch.zeros(M // 2, D, device="cuda", dtype=torch.float32)
+    tilelang.compile(combine)(x, dst_ids, y)
+    torch.testing.assert_close(y, x[0::2] + x[1::2])
+
+
+def tilelang_gemm_stmatrix_epilogue(M, N, K, block_M, block_N, block_K, dtype=T.float16):
+    # The accumulator is written to one stage of a staging buffer
+    @T.prim_func
+    def main(A: T.Tensor((M, K), dtype), B: T.Tensor((K, N), dtype), C: T.Tensor((M, N), dtype)):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_shared = T.alloc_shared((2, block_M, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C_shared[1, :, :])
+            T.copy(C_shared[1, :, :], C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_tilelang_copy_stmatrix_epilogue():
+    M, N, K = 256, 512, 128
+    kernel = tilelang.compile(tilelang_gemm_stmatrix_epilogue(M, N, K, 128, 256, 32), out_idx=[2])
+    assert "tl::ptx_stmatrix_x4" in kernel.get_kernel_source()
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(a, b), (a.float() @ b.float()).half(), rtol=1e-2, atol=1e-2)
+
+
+def tilelang_copy_g2g(num_pages, page_size, dim, dtype=T.float16):
+    @T.prim_func
+    def main(
+        src: T.Tensor((num_pages, page_size, dim), dtype),
+        order: T.Tensor((num_pages,), T.int32),
+        dst: T.Tensor((num_pages, page_size, dim), dtype),
+    ):
+        with T.Kernel(num_pages, threads=32) as bx:
+            T.copy(src[order[bx], :, :], dst[bx, :, :])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_tilelang_copy_bulk_g2g():
+    num_pages, page_size, dim = 16, 64, 512
+    kernel = tilelang.compile(tilelang_copy_g2g(num_pages, page_size, dim), out_idx=[2])
+    assert "tl::bulk_copy_g2g<16384>" in kernel.get_kernel_source()
+    src = torch.randn(num_pages, page_size, dim, device="cuda", dtype=torch.float16)
+    order = torch.randperm(num_pages, device="cuda", dtype=torch.int32)
+    torch.testing.assert_close(kernel(src, order), src[order.long()])
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
@@ -307,5 +307,70 @@ def test_cumsum_region_2d():
     run_cumsum_region_2d(1000, 1000, 128, 128, dim=1)
 
 
+def cumsum_device_test(M, N, block_N, reverse=False, segmented=False, dtype=T.int32, threads=128):
+    num_tiles = N // block_N
+
+    @T.prim_func
+    def cumsum(
+        A: T.Tensor((M, N), dtype),
+        Reset: T.Tensor((M, N), T.int8),
+        State: T.Tensor((num_tiles, M), T.int64),
+        B: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(num_tiles, threads=threads) as bx:
+            A_shared = T.alloc_shared((M, block_N), dtype)
+            reset_shared = T.alloc_shared((M, block_N), T.int8)
+            # Reverse scans count the tiles from the end of the rows.
+            col = (num_tiles - 1 - bx) * block_N if reverse else bx * block_N
+            T.copy(A[0, col], A_shared)
+            if segmented:
+                T.copy(Reset[0, col], reset_shared)
+                T.cumsum(A_shared, dim=1, reverse=reverse, reset=reset_shared, scan_state=State, tile_id=bx)
+            else:
+                T.cumsum(A_shared, dim=1, reverse=reverse, scan_state=State, tile_id=bx)
+            T.copy(A_shared, B[0, col])
+
+    return cumsum
+
+
+def run_cumsum_device(M, N, block_N, reverse=False, segmented=False, dtype=T.int32):
+    jit_kernel = tl.compile(cumsum_device_test(M, N, block_N, reverse, segmented, dtype), out_idx=-1)
+    if dtype == T.int32:
+        A = torch.randint(-8, 8, (M, N), dtype=torch.int32).cuda()
+    else:
+        A = torch.randn(M, N, dtype=getattr(torch, dtype)).cuda()
+    Reset = (torch.rand(M, N) < 0.001).to(torch.int8).cuda() if segmented else torch.zeros(M, N, dtype=torch.int8).cuda()
+    State = torch.zeros(N // block_N, M, dtype=torch.int64).cuda()
+    B = jit_kernel(A, Reset, State)
+
+    a, flags = A.double(), Reset.bool()
+    if reverse:
+        a, flags = a.flip(1), flags.flip(1)
+    total = a.cumsum(1)
+    # Drop the total accumulated before the last reset up to every element.
+    columns = torch.arange(N, device=a.device).expand(M, N)
+    last_reset = torch.cummax(torch.where(flags, columns, -1), 1).values
+    base = (total - a).gather(1, last_reset.clamp(min=0))
+    ref = total - torch.where(last_reset >= 0, base, torch.zeros_like(base))
+    if reverse:
+        ref = ref.flip(1)
+    if dtype == T.int32:
+        torch.testing.assert_close(B, ref.to(torch.int32))
+    else:
+        torch.testing.assert_close(B.double(), ref, atol=1e-2, rtol=1e-3)
+
+
+@tilelang.testing.requires_cuda
+def test_cumsum_device():
+    run_cumsum_device(1, 1 << 20, 1024)
+    run_cumsum_device(4, 1 << 16, 256, reverse=True)
+    run_cumsum_device(1, 1 << 16, 1024, dtype=T.float32)
+
+
+@tilelang.testing.requires_cuda
+def test_cumsum_segmented():
+    run_cumsum_device(1, 1 << 20, 1024, segmented=True)
+    run_cumsum_device(8, 1 << 16, 128, segmented=True, reverse=True)
+
 if __name__ == "__main__":
     tilelang.testing.main()
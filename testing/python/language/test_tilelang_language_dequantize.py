@@ -0,0 +1,166 @@
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+import torch
+
+NF4_CODE_BOOK = [
+    -1.0,
+    -0.6961928009986877,
+    -0.5250730514526367,
+    -0.39491748809814453,
+    -0.28444138169288635,
+    -0.18477343022823334,
+    -0.09105003625154495,
+    0.0,
+    0.07958029955625534,
+    0.16093020141124725,
+    0.24611230194568634,
+    0.33791524171829224,
+    0.44070982933044434,
+    0.5626170039176941,
+    0.7229568362236023,
+    1.0,
+]
+FP4_E2M1_VALUES = [0.0, 0.5, 1.0, 1.5, 2.0, 3.0, 4.0, 6.0, -0.0, -0.5, -1.0, -1.5, -2.0, -3.0, -4.0, -6.0]
+
+
+def ref_dequantize(packed, scales, zeros, fmt, group_size):
+    codes = torch.stack([packed & 15, packed >> 4], dim=-1).view(packed.shape[0], -1).long()
+    if fmt == "int4":
+        values = ((codes ^ 8) - 8).float()
+    elif fmt == "uint4":
+        values = codes.float()
+    elif fmt == "nf4":
+        values = torch.tensor(NF4_CODE_BOOK, device=codes.device)[codes]
+    else:
+        values = torch.tensor(FP4_E2M1_VALUES, device=codes.device)[codes]
+    if zeros is not None:
+        values = values - zeros.float().repeat_interleave(group_size, dim=1)
+    if scales is not None:
+        factor = torch.exp2(scales.float() - 127) if fmt == "mxfp4" else scales.float()
+        values = values * factor.repeat_interleave(group_size, dim=1)
+    return values
+
+
+def dequantize_program(N, K, block_N, block_K, fmt, group_size, out_dtype, with_scale, with_zero, packed_scope):
+    scale_dtype = T.uint8 if fmt == "mxfp4" else out_dtype
+
+    @T.prim_func
+    def main(
+        B: T.Tensor((N, K // 2), T.uint8),
+        S: T.Tensor((N, K // group_size), scale_dtype),
+        Z: T.Tensor((N, K // group_size), out_dtype),
+        D: T.Tensor((N, K), out_dtype),
+    ):
+        with T.Kernel(N // block_N, threads=128) as bx:
+            B_dequant = T.alloc_fragment((block_N, block_K), out_dtype)
+            if packed_scope == "fragment":
+                B_packed = T.alloc_fragment((block_N, block_K // 2), T.uint8)
+            else:
+                B_packed = T.alloc_shared((block_N, block_K // 2), T.uint8)
+            for k in T.serial(K // block_K):
+                T.copy(B[bx * block_N, k * block_K // 2], B_packed)
+                if with_zero:
+                    T.dequantize(
+                        B_packed,
+                        S[bx * block_N, k * block_K // group_size],
+                        Z[bx * block_N, k * block_K // group_size],
+                        B_dequant,
+                        format=fmt,
+                        group_size=group_size,
+                    )
+                elif with_scale:
+                    T.dequantize(B_packed, S[bx * block_N, k * block_K // group_size], None, B_dequant, format=fmt, group_size=group_size)
+                else:
+                    T.dequantize(B_packed, None, None, B_dequant, format=fmt)
+                T.copy(B_dequant, D[bx * block_N, k * block_K])
+
+    return main
+
+
+def run_dequantize(
+    fmt, N=256, K=512, block_N=64, block_K=128, group_size=None, out_dtype=T.float16, with_scale=True, with_zero=False, packed_scope="fragment"
+):
+    group_size = group_size or (32 if fmt == "mxfp4" else 128)
+    program = dequantize_program(N, K, block_N, block_K, fmt, group_size, out_dtype, with_scale, with_zero, packed_scope)
+    kernel = tilelang.compile(program, out_idx=[3])
+    torch_dtype = getattr(torch, out_dtype)
+    packed = torch.randint(0, 256, (N, K // 2), device="cuda", dtype=torch.uint8)
+    if fmt == "mxfp4":
+        scales = torch.randint(120, 134, (N, K // group_size), device="cuda", dtype=torch.uint8)
+    else:
+        scales = torch.rand(N, K // group_size, device="cuda").to(torch_dtype) + 0.5
+    zeros = torch.randint(0, 16, (N, K // group_size), device="cuda").to(torch_dtype)
+    out = kernel(packed, scales, zeros)
+    ref = ref_dequantize(packed, scales if with_scale else None, zeros if with_zero else None, fmt, group_size)
+    torch.testing.assert_close(out.float(), ref.to(torch_dtype).float(), rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_dequantize_int4():
+    run_dequantize("int4")
+    run_dequantize("uint4", with_zero=True)
+    run_dequantize("int4", out_dtype=T.bfloat16, group_size=64)
+
+
+@tilelang.testing.requires_cuda
+def test_dequantize_nf4():
+    run_dequantize("nf4")
+    run_dequantize("nf4", out_dtype=T.bfloat16, with_scale=False)
+
+
+@tilelang.testing.requires_cuda
+def test_dequantize_fp4():
+    run_dequantize("fp4_e2m1", with_scale=False)
+    run_dequantize("fp4_e2m1", out_dtype=T.bfloat16)
+    run_dequantize("mxfp4", out_dtype=T.bfloat16)
+
+
+@tilelang.testing.requires_cuda
+def test_dequantize_shared_packed():
+    run_dequantize("int4", packed_scope="shared")
+    run_dequantize("nf4", out_dtype=T.float32, packed_scope="shared")
+
+
+@tilelang.jit(out_idx=[3])
+def w4a16_gemm(M, N, K, group_size=128, block_M=64, block_N=64, block_K=64):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), T.float16),
+        B: T.Tensor((N, K // 2), T.uint8),
+        S: T.Tensor((N, K // group_size), T.float16),
+        C: T.Tensor((M, N), T.float16),
+    ):
+        with T.Kernel(N // block_N, M // block_M, threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), T.float16)
+            B_packed = T.alloc_fragment((block_N, block_K // 2), T.uint8)
+            # Laid out as the B operand of the MMA by T.gemm
+            B_dequant = T.alloc_fragment((block_N, block_K), T.float16)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(K // block_K, num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[bx * block_N, k * block_K // 2], B_packed)
+                T.dequantize(B_packed, S[bx * block_N, k * block_K // group_size], None, B_dequant, format="int4", group_size=group_size)
+                T.gemm(A_shared, B_dequant, C_local, transpose_B=True)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(8, 0)
+def test_dequantize_w4a16_gemm():
+    M, N, K, group_size = 256, 256, 512, 128
+    kernel = w4a16_gemm(M, N, K, group_size)
+    assert "tl::dequantize_int4x8" in kernel.get_kernel_source()
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    packed = torch.randint(0, 256, (N, K // 2), device="cuda", dtype=torch.uint8)
+    scales = (torch.rand(N, K // group_size, device="cuda") * 0.1).half()
+    c = kernel(a, packed, scales)
+    b = ref_dequantize(packed, scales, None, "int4", group_size)
+    torch.testing.assert_close(c.float(), a.float() @ b.T, rtol=1e-2, atol=1e-1)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -1,6 +1,7 @@
 import tilelang.testing
 import tilelang
 import tilelang.language as T
+from tilelang import tvm as tvm
 from itertools import product
 import torch
 
@@ -237,6 +238,58 @@ def test_jit2_compile_with_consts():
     transpose.compile(M=1024, N=1024, block_M=64, block_N=64)
 
 
+def test_trace_cache():
+    def copy(N, block_N, dtype=T.float32):
+        @T.prim_func
+        def main(A: T.Tensor((N,), dtype), B: T.Tensor((N,), dtype)):
+            with T.Kernel(T.ceildiv(N, block_N), threads=128) as bx:
+                T.copy(A[bx * block_N], B[bx * block_N])
+
+        return main
+
+    # Same code and closure: the traced PrimFunc is reused
+    assert copy(1024, 128) is copy(1024, 128)
+    assert copy(1024, 128) is not copy(2048, 128)
+    assert copy(1024, 128) is not copy(1024, 128, T.float16)
+
+    def copy_listed(shape):
+        @T.prim_func
+        def main(A: T.Tensor(shape, T.float32), B: T.Tensor(shape, T.float32)):
+            with T.Kernel(1, threads=128):
+                T.copy(A, B)
+
+        return main
+
+    # Values that may be mutated in place are not keyed
+    assert copy_listed([128]) is not copy_listed([128])
+    assert copy_listed((128,)) is copy_listed((128,))
+
+
+def test_trace_template():
+    from tilelang.language.eager.builder import clear_trace_cache
+
+    def copy(N, block_N):
+        @T.prim_func
+        def main(A: T.Tensor((N,), T.float32), B: T.Tensor((N,), T.float32)):
+            with T.Kernel(T.ceildiv(N, block_N), threads=128) as bx:
+                for i in T.Parallel(block_N):
+                    B[bx * block_N + i] = A[bx * block_N + i]
+                B[N - 1] = A[0]
+
+        return main
+
+    # The second size validates the trace over `N`, the next ones specialize it
+    clear_trace_cache()
+    copy(1024, 128)
+    copy(2048, 128)
+    specialized = [copy(4096, 128), copy(1, 128)]
+    clear_trace_cache()
+    traced = [copy(4096, 128), copy(1, 128)]
+    for a, b in zip(specialized, traced):
+        assert a is not b
+        tvm.ir.assert_structural_equal(a, b)
+
+
 if __name__ == "__main__":
     # tilelang.testing.main()
     test_jit2_return()
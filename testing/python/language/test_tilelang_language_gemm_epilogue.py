@@ -0,0 +1,60 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def persistent_gemm_bias_relu(M, N, K, block_M, block_N, block_K, num_programs, dtype=T.float16, accum_dtype=T.float32):
+    num_tiles = T.ceildiv(M, block_M) * T.ceildiv(N, block_N)
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        Bias: T.Tensor((N,), accum_dtype),
+        D: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(num_programs, threads=128) as pid:
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            D_shared = T.alloc_shared((block_M, block_N), dtype)
+            for tile_id in T.serial(T.ceildiv(num_tiles - pid, num_programs)):
+                bm = (tile_id * num_programs + pid) // T.ceildiv(N, block_N)
+                bn = (tile_id * num_programs + pid) % T.ceildiv(N, block_N)
+                T.clear(C_local)
+                for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                    T.copy(A[bm * block_M, k * block_K], A_shared)
+                    T.copy(B[k * block_K, bn * block_N], B_shared)
+                    T.gemm(A_shared, B_shared, C_local)
+                T.gemm_epilogue(
+                    C_local,
+                    D[bm * block_M, bn * block_N],
+                    lambda x, i, j: T.max(x + Bias[bn * block_N + j], 0),
+                    staging=D_shared,
+                )
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_gemm_epilogue_bias_relu():
+    M, N, K = 512, 512, 256
+    kernel = tilelang.compile(
+        persistent_gemm_bias_relu(M, N, K, 128, 128, 32, num_programs=8),
+        out_idx=[3],
+        pass_configs={tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True},
+    )
+    source = kernel.get_kernel_source()
+    assert "tl::tma_store" in source
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    bias = torch.randn(N, device="cuda", dtype=torch.float32)
+    d = kernel(a, b, bias)
+    ref = torch.relu(a.float() @ b.float() + bias).half()
+    torch.testing.assert_close(d, ref, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,62 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def dequant_gemm(M, N, K, block_M, block_N, block_K, scale_b=False):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), T.int8),
+        Scale: T.Tensor((M,), T.float16),
+        B: T.Tensor((K, N), T.float16),
+        D: T.Tensor((M, N), T.float16),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), T.int8)
+            B_shared = T.alloc_shared((block_K, block_N), T.float16)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                # dequantize A per row while loading it into the mma fragment
+                T.gemm_prologue(
+                    A_shared,
+                    B_shared,
+                    C_local,
+                    a_fn=lambda x, i, j: T.cast(x, T.float16) * Scale[by * block_M + i],
+                    b_fn=(lambda x, i, j: x * 0.5) if scale_b else None,
+                )
+            T.copy(C_local, D[by * block_M, bx * block_N])
+
+    return main
+
+
+def run_dequant_gemm(M, N, K, scale_b=False):
+    kernel = tilelang.compile(dequant_gemm(M, N, K, 128, 128, 32, scale_b=scale_b), out_idx=[3])
+    a = torch.randint(-8, 8, (M, K), device="cuda", dtype=torch.int8)
+    scale = torch.rand(M, device="cuda", dtype=torch.float16) * 0.1
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    ref = (a.float() * scale.float()[:, None]) @ (b.float() * (0.5 if scale_b else 1.0))
+    torch.testing.assert_close(kernel(a, scale, b).float(), ref, rtol=1e-2, atol=1e-2)
+    return kernel.get_kernel_source()
+
+
+@tilelang.testing.requires_cuda
+def test_gemm_prologue_dequant():
+    run_dequant_gemm(256, 256, 128)
+    run_dequant_gemm(256, 256, 128, scale_b=True)
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+@tilelang.testing.requires_cuda_compute_version_lt(10, 0)
+def test_gemm_prologue_wgmma_rs():
+    source = run_dequant_gemm(256, 256, 128)
+    # the dequantized A feeds the wgmma straight from registers
+    assert "tl::wgmma_rs<" in source
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
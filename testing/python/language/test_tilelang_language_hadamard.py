@@ -0,0 +1,99 @@
+import math
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def ref_hadamard(x):
+    """Sylvester Hadamard transform of the last dimension."""
+    n = x.shape[-1]
+    y = x.float()
+    h = 1
+    while h < n:
+        y = y.reshape(*x.shape[:-1], n // (2 * h), 2, h)
+        y = torch.stack((y[..., 0, :] + y[..., 1, :], y[..., 0, :] - y[..., 1, :]), dim=-2)
+        h *= 2
+    return y.reshape(x.shape)
+
+
+def hadamard_rows(M, N, block_M, threads, dtype=T.float32, scale=None):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), dtype), B: T.Tensor((M, N), dtype)):
+        with T.Kernel(T.ceildiv(M, block_M), threads=threads) as bx:
+            A_local = T.alloc_fragment((block_M, N), dtype)
+            T.copy(A[bx * block_M, 0], A_local)
+            T.hadamard(A_local, dim=1, scale=scale)
+            T.copy(A_local, B[bx * block_M, 0])
+
+    return main
+
+
+def run_hadamard_rows(M, N, block_M, threads, dtype=T.float32, scale=None):
+    kernel = tilelang.compile(hadamard_rows(M, N, block_M, threads, dtype, scale), out_idx=[1])
+    a = torch.randn(M, N, device="cuda", dtype={T.float32: torch.float32, T.float16: torch.float16}[dtype])
+    b = kernel(a)
+    ref = ref_hadamard(a) * (1 if scale is None else scale)
+    tol = 1e-3 * math.sqrt(N) if dtype == T.float32 else 3e-2 * math.sqrt(N)
+    torch.testing.assert_close(b.float(), ref, rtol=tol, atol=tol)
+    return kernel
+
+
+@tilelang.testing.requires_cuda
+def test_hadamard_within_warp():
+    # A warp covers the 128 columns of a row: registers and shuffles only
+    kernel = run_hadamard_rows(64, 128, 16, 128)
+    source = kernel.get_kernel_source()
+    assert "shfl_xor_sync" in source
+    assert "__shared__" not in source
+
+
+@tilelang.testing.requires_cuda
+def test_hadamard_across_warps():
+    run_hadamard_rows(8, 4096, 1, 256, scale=1 / math.sqrt(4096))
+
+
+@tilelang.testing.requires_cuda
+def test_hadamard_exchange_rounds():
+    # 128 KB of float32 per block, exchanged through shared memory in rounds
+    run_hadamard_rows(2, 32768, 1, 256)
+
+
+@tilelang.testing.requires_cuda
+def test_hadamard_half():
+    run_hadamard_rows(32, 256, 4, 128, dtype=T.float16, scale=1 / 16)
+
+
+def gemm_hadamard(M, N, K, block_M=64, block_N=128, block_K=32, dtype=T.float16):
+    @T.prim_func
+    def main(A: T.Tensor((M, K), dtype), B: T.Tensor((K, N), dtype), C: T.Tensor((M, N), T.float32)):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            # Transformed in the accumulator layout of the gemm
+            T.hadamard(C_local, dim=1)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_hadamard_gemm_epilogue():
+    M, N, K = 128, 256, 64
+    kernel = tilelang.compile(gemm_hadamard(M, N, K), out_idx=[2])
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    c = kernel(a, b)
+    ref = ref_hadamard((a.float() @ b.float()).reshape(M, N // 128, 128)).reshape(M, N)
+    torch.testing.assert_close(c, ref, rtol=1e-2, atol=1e-1)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,71 @@
+import re
+
+import pytest
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def matmul(M, N, K, block_M, block_N, block_K, min_blocks_per_sm=None, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128, min_blocks_per_sm=min_blocks_per_sm) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def _min_blocks(source):
+    match = re.search(r"__launch_bounds__\((\d+), (\d+)\)", source)
+    assert match is not None, source
+    return int(match.group(2))
+
+
+def run_launch_bounds(min_blocks_per_sm, M=512, N=512, K=512, block_M=64, block_N=64, block_K=32):
+    kernel = tilelang.compile(matmul(M, N, K, block_M, block_N, block_K, min_blocks_per_sm), out_idx=[2])
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(a, b), a @ b, rtol=1e-2, atol=1e-2)
+    return _min_blocks(kernel.get_kernel_source())
+
+
+@tilelang.testing.requires_cuda
+def test_launch_bounds_default():
+    assert run_launch_bounds(None) == 1
+
+
+@tilelang.testing.requires_cuda
+def test_launch_bounds_explicit():
+    assert run_launch_bounds(2) == 2
+
+
+@tilelang.testing.requires_cuda
+def test_launch_bounds_auto():
+    blocks = run_launch_bounds("auto")
+    # 12KB of shared memory per block leave room for several blocks on every arch
+    assert blocks > 1
+    # larger tiles leave fewer blocks per SM
+    assert run_launch_bounds("auto", block_M=128, block_N=128, block_K=64) <= blocks
+
+
+def test_launch_bounds_invalid():
+    # asserted by T.Kernel while the program is parsed
+    with pytest.raises(Exception, match="min_blocks_per_sm"):
+        matmul(512, 512, 512, 64, 64, 32, min_blocks_per_sm=0)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,89 @@
+import tilelang.testing
+import tilelang as tl
+import torch
+import tilelang.language as T
+
+
+def norm_test(M, N, block_M, norm_type, residual, out_dtype, out_scale=None, threads=128):
+    dtype = T.float16
+
+    @T.prim_func
+    def main(
+        X: T.Tensor((M, N), dtype),
+        R: T.Tensor((M, N), dtype),
+        W: T.Tensor((N,), dtype),
+        B: T.Tensor((N,), dtype),
+        Y: T.Tensor((M, N), out_dtype),
+    ):
+        with T.Kernel(T.ceildiv(M, block_M), threads=threads) as bx:
+            x = T.alloc_fragment((block_M, N), T.float32)
+            T.copy(X[bx * block_M, 0], x)
+            T.norm(
+                x,
+                Y[bx * block_M, 0],
+                weight=W,
+                bias=B if norm_type == "layer" else None,
+                residual=R[bx * block_M, 0] if residual else None,
+                eps=1e-5,
+                norm_type=norm_type,
+                out_scale=out_scale,
+            )
+            if residual:
+                T.copy(x, R[bx * block_M, 0])
+
+    return main
+
+
+def run_norm(M, N, block_M, norm_type="rms", residual=False, out_dtype=T.float16, out_scale=None, threads=128):
+    kernel = tl.compile(norm_test(M, N, block_M, norm_type, residual, out_dtype, out_scale, threads), out_idx=[4])
+    # An offset mean stresses the variance of the LayerNorm rows.
+    X = (torch.randn(M, N) + 4).half().cuda()
+    R = torch.randn(M, N, dtype=torch.float16).cuda()
+    W = torch.randn(N, dtype=torch.float16).cuda()
+    B = torch.randn(N, dtype=torch.float16).cuda()
+    h = X.float() + R.float() if residual else X.float()
+    R_ref = h.half()
+    Y = kernel(X, R, W, B)
+
+    if norm_type == "rms":
+        ref = h * torch.rsqrt(h.pow(2).mean(-1, keepdim=True) + 1e-5) * W.float()
+    else:
+        ref = torch.nn.functional.layer_norm(h, (N,), W.float(), B.float(), eps=1e-5)
+    if out_scale is not None:
+        ref = (ref * out_scale).clamp(-448.0, 448.0)
+        torch.testing.assert_close(Y.float(), ref.to(torch.float8_e4m3fn).float(), rtol=0.125, atol=0.125)
+    else:
+        torch.testing.assert_close(Y.float(), ref, rtol=1e-2, atol=1e-2)
+    if residual:
+        torch.testing.assert_close(R, R_ref, rtol=1e-3, atol=1e-3)
+
+
+@tilelang.testing.requires_cuda
+def test_rms_norm():
+    run_norm(256, 1024, 1)
+    run_norm(256, 512, 4, threads=256)
+    run_norm(256, 64, 8)
+
+
+@tilelang.testing.requires_cuda
+def test_layer_norm():
+    run_norm(256, 1024, 1, norm_type="layer")
+    run_norm(256, 4096, 2, norm_type="layer", threads=256)
+    run_norm(256, 64, 8, norm_type="layer")
+
+
+@tilelang.testing.requires_cuda
+def test_fused_add_norm():
+    run_norm(256, 1024, 1, residual=True)
+    run_norm(256, 1024, 2, norm_type="layer", residual=True)
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(8, 9)
+def test_norm_fp8_output():
+    run_norm(256, 1024, 1, out_dtype=T.float8_e4m3fn, out_scale=8.0)
+    run_norm(256, 1024, 1, norm_type="layer", residual=True, out_dtype=T.float8_e4m3fn, out_scale=8.0)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,75 @@
+import tilelang.testing
+import tilelang as tl
+import torch
+import tilelang.language as T
+
+
+def attention_test(seq_len, dim, block_M, block_N, threads=128, masked=False):
+    scale = (1.0 / dim) ** 0.5 * 1.44269504  # log2(e)
+    dtype = T.float16
+    accum_dtype = T.float32
+
+    @T.prim_func
+    def main(
+        Q: T.Tensor((seq_len, dim), dtype),
+        K: T.Tensor((seq_len, dim), dtype),
+        V: T.Tensor((seq_len, dim), dtype),
+        Output: T.Tensor((seq_len, dim), dtype),
+    ):
+        with T.Kernel(T.ceildiv(seq_len, block_M), threads=threads) as bx:
+            Q_shared = T.alloc_shared((block_M, dim), dtype)
+            K_shared = T.alloc_shared((block_N, dim), dtype)
+            V_shared = T.alloc_shared((block_N, dim), dtype)
+            acc_s = T.alloc_fragment((block_M, block_N), accum_dtype)
+            acc_s_cast = T.alloc_fragment((block_M, block_N), dtype)
+            acc_o = T.alloc_fragment((block_M, dim), accum_dtype)
+            scores_max = T.alloc_fragment((block_M,), accum_dtype)
+            logsum = T.alloc_fragment((block_M,), accum_dtype)
+
+            T.copy(Q[bx * block_M, 0], Q_shared)
+            T.fill(acc_o, 0)
+            T.fill(logsum, 0)
+            T.fill(scores_max, -T.infinity(accum_dtype))
+            for k in T.serial(T.ceildiv(seq_len, block_N)):
+                T.copy(K[k * block_N, 0], K_shared)
+                T.copy(V[k * block_N, 0], V_shared)
+                T.clear(acc_s)
+                T.gemm(Q_shared, K_shared, acc_s, transpose_B=True, policy=T.GemmWarpPolicy.FullRow)
+                if masked:
+                    # Causal mask: whole parts of the first rows are -inf.
+                    for i, j in T.Parallel(block_M, block_N):
+                        acc_s[i, j] = T.if_then_else(bx * block_M + i >= k * block_N + j, acc_s[i, j], -T.infinity(accum_dtype))
+                T.online_softmax(acc_s, scores_max, logsum, acc_o, scale=scale)
+                T.copy(acc_s, acc_s_cast)
+                T.gemm(acc_s_cast, V_shared, acc_o, policy=T.GemmWarpPolicy.FullRow)
+            for i, j in T.Parallel(block_M, dim):
+                acc_o[i, j] /= logsum[i]
+            T.copy(acc_o, Output[bx * block_M, 0])
+
+    return main
+
+
+def run_online_softmax(seq_len, dim, block_M, block_N, threads=128, masked=False):
+    kernel = tl.compile(attention_test(seq_len, dim, block_M, block_N, threads, masked), out_idx=[3])
+    Q, K, V = (torch.randn(seq_len, dim, dtype=torch.float16).cuda() for _ in range(3))
+    scores = (Q.float() @ K.float().T) / dim**0.5
+    if masked:
+        mask = torch.tril(torch.ones(seq_len, seq_len, device=scores.device, dtype=torch.bool))
+        scores = scores.masked_fill(~mask, float("-inf"))
+    ref = (torch.softmax(scores, dim=-1) @ V.float()).half()
+    torch.testing.assert_close(kernel(Q, K, V), ref, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_online_softmax():
+    run_online_softmax(512, 64, 64, 64)
+    run_online_softmax(512, 128, 128, 64, threads=256)
+
+
+@tilelang.testing.requires_cuda
+def test_online_softmax_masked():
+    run_online_softmax(512, 64, 64, 64, masked=True)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
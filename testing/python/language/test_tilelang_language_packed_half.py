@@ -0,0 +1,59 @@
+import pytest
+import torch
+import tilelang.testing
+import tilelang.language as T
+
+
+@tilelang.jit
+def packed_binary_kernel(M: int, dtype: str, op: str):
+    @T.prim_func
+    def main(
+        A: T.Tensor[(M,), dtype],  # noqa: F821
+        B: T.Tensor[(M,), dtype],  # noqa: F821
+        C: T.Tensor[(M,), dtype],  # noqa: F821
+        D: T.Tensor[(M,), dtype],  # noqa: F821
+    ):
+        with T.Kernel(1, threads=128):
+            for i in T.vectorized(M):
+                if op == "fma":
+                    D[i] = A[i] * B[i] + C[i]
+                elif op == "mul":
+                    D[i] = A[i] * B[i]
+                elif op == "max":
+                    D[i] = T.max(A[i], B[i])
+                else:
+                    D[i] = T.min(A[i], B[i])
+
+    return main
+
+
+def reference(op, A, B, C):
+    if op == "fma":
+        return (A.float() * B.float() + C.float()).to(A.dtype)
+    if op == "mul":
+        return A * B
+    if op == "max":
+        return torch.maximum(A, B)
+    return torch.minimum(A, B)
+
+
+@tilelang.testing.requires_cuda
+@pytest.mark.parametrize("dtype", [T.float16, T.bfloat16])
+@pytest.mark.parametrize(
+    "op, intrinsic",
+    [("fma", "__hfma2"), ("mul", "__hmul2"), ("max", "__hmax2"), ("min", "__hmin2")],
+)
+@pytest.mark.parametrize("lanes", [2, 8])
+def test_packed_half_binary_op(dtype, op, intrinsic, lanes):
+    kernel = packed_binary_kernel(lanes, dtype, op)
+    code = kernel.get_kernel_source()
+    assert intrinsic in code, f"{op} of {lanes} x {dtype} is not packed!"
+
+    A, B, C = (torch.randn(lanes, device="cuda").to(dtype.as_torch()) for _ in range(3))
+    D = torch.empty_like(A)
+    kernel(A, B, C, D)
+    torch.testing.assert_close(D, reference(op, A, B, C), rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -39,6 +39,22 @@ def parallel_elementwise_dynamic(max_len=512, threads=256, dtype=T.float32):
     return main
 
 
+@tilelang.jit(out_idx=[1])
+def parallel_mixed_dtype_shared(M=64, N=128, threads=128):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), T.float16),
+        B: T.Tensor((M, N), T.float32),
+    ):
+        with T.Kernel(1, threads=threads) as _:
+            A_shared = T.alloc_shared((M, N), T.float16)
+            T.copy(A, A_shared)
+            for i, j in T.Parallel(M, N):
+                B[i, j] = A_shared[i, j] * 2.0
+
+    return main
+
+
 def _require_cuda_tensor(shape, dtype=torch.float32):
     if not torch.cuda.is_available():
         pytest.skip("CUDA not available")
@@ -66,5 +82,13 @@ def test_parallel_dynamic_extent():
         torch.testing.assert_close(out, reference, atol=1e-5, rtol=1e-5)
 
 
+
+def test_parallel_mixed_dtype_shared():
+    kernel = parallel_mixed_dtype_shared(M=64, N=128)
+    data = _require_cuda_tensor((64, 128), torch.float16)
+    result = kernel(data)
+    torch.testing.assert_close(result, data.float() * 2.0, atol=1e-3, rtol=1e-3)
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
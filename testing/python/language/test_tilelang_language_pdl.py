@@ -54,5 +54,49 @@ def test_pdl_sync():
     assert "__restrict__" not in code
 
 
+def chained_kernels(N, block_size=256, dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((N,), dtype),
+        B: T.Tensor((N,), dtype),
+        C: T.Tensor((N,), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_size), threads=block_size) as (bx,):
+            for i in T.Parallel(block_size):
+                idx = bx * block_size + i
+                if idx < N:
+                    B[idx] = A[idx] + 1.0
+        with T.Kernel(T.ceildiv(N, block_size), threads=block_size) as (bx2,):
+            for i in T.Parallel(block_size):
+                idx = bx2 * block_size + i
+                if idx < N:
+                    C[idx] = B[idx] * 2.0
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_pdl_chaining():
+    import torch
+
+    N = 1024
+    kernel = tilelang.compile(
+        chained_kernels(N),
+        execution_backend="cython",
+        pass_configs={tilelang.PassConfigKey.TL_ENABLE_PDL_CHAINING: True},
+    )
+    code = kernel.get_kernel_source()
+    assert code.count("cudaTriggerProgrammaticLaunchCompletion") == 1
+    assert code.count("cudaGridDependencySynchronize") == 1
+    assert "cudaLaunchKernelEx" in kernel.get_host_source()
+
+    a = torch.randn(N, device="cuda")
+    b = torch.empty_like(a)
+    c = torch.empty_like(a)
+    kernel(a, b, c)
+    torch.testing.assert_close(c, (a + 1.0) * 2.0)
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
@@ -0,0 +1,127 @@
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+import torch
+
+
+def quantize_program(M, N, block_M, granularity, in_dtype=T.bfloat16, out_dtype=T.float8_e4m3fn, stochastic=False, threads=128):
+    if granularity == "token":
+        scale_shape = (M,)
+    elif granularity == "tensor":
+        scale_shape = (M // block_M,)
+    else:
+        scale_shape = (M, N // int(granularity[5:]))
+
+    @T.prim_func
+    def main(
+        X: T.Tensor((M, N), in_dtype),
+        Y: T.Tensor((M, N), out_dtype),
+        S: T.Tensor(scale_shape, T.float32),
+    ):
+        with T.Kernel(M // block_M, threads=threads) as bx:
+            x = T.alloc_fragment((block_M, N), T.float32)
+            if stochastic:
+                T.rng_init(42)
+            T.copy(X[bx * block_M, 0], x)
+            if granularity == "tensor":
+                T.quantize(x, Y[bx * block_M, 0], S[bx], granularity=granularity, stochastic_rounding=stochastic)
+            elif granularity == "token":
+                T.quantize(x, Y[bx * block_M, 0], S[bx * block_M], granularity=granularity, stochastic_rounding=stochastic)
+            else:
+                T.quantize(x, Y[bx * block_M, 0], S[bx * block_M, 0], granularity=granularity, stochastic_rounding=stochastic)
+
+    return main
+
+
+def ref_quantize(x, block_M, granularity):
+    M, N = x.shape
+    x = x.float()
+    if granularity == "token":
+        groups = x.view(M, 1, N)
+    elif granularity == "tensor":
+        groups = x.view(M // block_M, 1, block_M * N)
+    else:
+        group = int(granularity[5:])
+        groups = x.view(M, N // group, group)
+    amax = groups.abs().amax(dim=-1, keepdim=True).clamp(min=1e-4)
+    y = (groups * (448.0 / amax)).clamp(-448.0, 448.0).to(torch.float8_e4m3fn).view(M, N)
+    return y, (amax / 448.0).view(-1)
+
+
+def run_quantize(M, N, block_M, granularity, in_dtype=T.bfloat16):
+    kernel = tilelang.compile(quantize_program(M, N, block_M, granularity, in_dtype), out_idx=[1, 2])
+    x = torch.randn(M, N, device="cuda", dtype=getattr(torch, in_dtype))
+    y, s = kernel(x)
+    ref_y, ref_s = ref_quantize(x, block_M, granularity)
+    torch.testing.assert_close(s.view(-1), ref_s)
+    torch.testing.assert_close(y.float(), ref_y.float(), rtol=0.125, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_quantize_token():
+    run_quantize(256, 512, 16, "token")
+    run_quantize(128, 128, 8, "token", in_dtype=T.float32)
+
+
+@tilelang.testing.requires_cuda
+def test_quantize_block128():
+    run_quantize(256, 512, 16, "block128")
+    run_quantize(64, 256, 8, "block64", in_dtype=T.float16)
+
+
+@tilelang.testing.requires_cuda
+def test_quantize_tensor():
+    run_quantize(256, 256, 32, "tensor")
+
+
+@tilelang.testing.requires_cuda
+def test_quantize_stochastic_rounding():
+    M, N, block_M = 128, 512, 16
+    kernel = tilelang.compile(quantize_program(M, N, block_M, "token", stochastic=True), out_idx=[1, 2])
+    # With a unit scale, 1.0625 lies halfway between the float8 values 1 and 1.125
+    x = torch.full((M, N), 1.0625, device="cuda", dtype=torch.bfloat16)
+    x[:, 0] = 448.0
+    y, s = kernel(x)
+    torch.testing.assert_close(s, torch.ones_like(s))
+    rounded = y.float()[:, 1:]
+    assert set(rounded.unique().tolist()) == {1.0, 1.125}
+    assert abs(rounded.mean().item() - 1.0625) < 1e-2
+
+
+@tilelang.jit(out_idx=[2, 3])
+def gemm_quantize(M, N, K, block_M=128, block_N=128, block_K=32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), T.float16),
+        B: T.Tensor((K, N), T.float16),
+        Y: T.Tensor((M, N), T.float8_e4m3fn),
+        S: T.Tensor((M, N // 128), T.float32),
+    ):
+        with T.Kernel(N // block_N, M // block_M, threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), T.float16)
+            B_shared = T.alloc_shared((block_K, block_N), T.float16)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(K // block_K, num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                # Warps split the rows, so a 128-column group is spread over the lanes of one warp
+                T.gemm(A_shared, B_shared, C_local, policy=T.GemmWarpPolicy.FullRow)
+            T.quantize(C_local, Y[by * block_M, bx * block_N], S[by * block_M, bx * (block_N // 128)], granularity="block128")
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_quantize_gemm_epilogue():
+    M = N = K = 256
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    y, s = gemm_quantize(M, N, K)(a, b)
+    ref_y, ref_s = ref_quantize(a.float() @ b.float(), 1, "block128")
+    torch.testing.assert_close(s.view(-1), ref_s, rtol=1e-3, atol=1e-3)
+    torch.testing.assert_close(y.float(), ref_y.float(), rtol=0.125, atol=1e-1)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -65,6 +65,58 @@ def test_rand_1d(M, seed, generator):
     kernel(A, B, C, D, E)
 
 
+
+@tilelang.jit
+def tilelang_philox_1d(M=1024, seed=42, offset=0):
+    num_per_thread = 8
+    threads = 128
+
+    @T.prim_func
+    def philox_kernel(
+        A: T.Tensor((M,), "uint32"),
+        B: T.Tensor((M,), "float32"),
+    ):
+        with T.Kernel(T.ceildiv(M, threads * num_per_thread), threads=threads) as bx:
+            tx = T.get_thread_binding()
+            base = (bx * threads + tx) * num_per_thread
+            for j in T.vectorized(num_per_thread):
+                A[base + j] = T.philox_rand(seed, offset, base + j)
+            for j in T.serial(num_per_thread):
+                B[base + j] = T.philox_rand_float(seed, offset, base + j)
+
+    return philox_kernel
+
+
+def philox_reference(M, seed, offset):
+    """Philox4x32-10 of the counters (i // 4, offset), element i is lane i % 4"""
+    mask = (1 << 32) - 1
+    out = []
+    for block in range((M + 3) // 4):
+        ctr = [block & mask, block >> 32, offset & mask, offset >> 32]
+        key = [seed & mask, seed >> 32]
+        for _ in range(10):
+            p0, p1 = 0xD2511F53 * ctr[0], 0xCD9E8D57 * ctr[2]
+            ctr = [(p1 >> 32) ^ ctr[1] ^ key[0], p1 & mask, (p0 >> 32) ^ ctr[3] ^ key[1], p0 & mask]
+            key = [(key[0] + 0x9E3779B9) & mask, (key[1] + 0xBB67AE85) & mask]
+        out.extend(ctr)
+    return out[:M]
+
+
+@tilelang.testing.requires_cuda
+@pytest.mark.parametrize("M, seed, offset", [(1024, 42, 0), (2048, 7, 12), (1024, (1 << 40) + 3, 1 << 33)])
+def test_philox_1d(M, seed, offset):
+    kernel = tilelang_philox_1d(M, seed, offset)
+    assert "tl::philox_rand4" in kernel.get_kernel_source()
+    A = torch.empty(M, dtype=torch.uint32, device="cuda")
+    B = torch.empty(M, dtype=torch.float32, device="cuda")
+    kernel(A, B)
+
+    ref = torch.tensor(philox_reference(M, seed, offset), dtype=torch.int64)
+    torch.testing.assert_close(A.cpu().to(torch.int64), ref, rtol=0, atol=0)
+    ref_float = ((ref >> 8).to(torch.float64) + 0.5) * 2.0**-24
+    torch.testing.assert_close(B.cpu(), ref_float.to(torch.float32), rtol=0, atol=0)
+    assert B.min() > 0 and B.max() < 1
+
 if __name__ == "__main__":
     tilelang.testing.main()
     # test_rand_1d(1024, 42, "curandStateMRG32k3a_t")
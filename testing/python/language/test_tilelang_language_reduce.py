@@ -219,5 +219,160 @@ def test_reduce_max_clear():
     run_reduce_max_clear(256, 256, T.float16)
 
 
+def reduce_wide_rows_test(M, N, reduce_type, dtype, threads):
+    import tilelang.language as T
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M,), dtype),
+    ):
+        with T.Kernel(1, threads=threads) as _:
+            A_local = T.alloc_fragment((M, N), dtype)
+            B_local = T.alloc_fragment((M,), dtype)
+
+            T.copy(A, A_local)
+            T.reduce(A_local, B_local, reduce_type, dim=1, clear=True)
+            T.copy(B_local, B)
+
+    return main
+
+
+def run_reduce_wide_rows(M, N, reduce_type, dtype, threads=256):
+    import torch
+
+    jit_kernel = tl.compile(reduce_wide_rows_test(M, N, reduce_type, dtype, threads), out_idx=-1)
+    if dtype == T.int32:
+        A = torch.randint(-1000, 1000, (M, N), dtype=torch.int32).cuda()
+    else:
+        A = torch.randn((M, N), dtype=getattr(torch, dtype)).cuda()
+    ref = A.sum(dim=1) if reduce_type == "sum" else A.max(dim=1).values
+    torch.testing.assert_close(jit_kernel(A), ref.to(A.dtype), atol=1e-3, rtol=1e-3)
+
+
+def test_reduce_wide_rows():
+    # Rows spread over several warps; integer rows reduce with redux.sync.
+    run_reduce_wide_rows(4, 2048, "sum", T.float32)
+    run_reduce_wide_rows(4, 2048, "max", T.float32)
+    run_reduce_wide_rows(4, 2048, "sum", T.int32)
+    run_reduce_wide_rows(8, 1024, "max", T.int32, threads=128)
+
+
+def reducer_ops_test(M, N, op, dtype, threads=128):
+    import tilelang.language as T
+
+    init = {"prod": 1, "absmax": 0, "bitxor": 0}[op]
+    update = {
+        "prod": lambda r, x: r * x,
+        "absmax": lambda r, x: T.max(r, T.abs(x)),
+        "bitxor": lambda r, x: r ^ x,
+    }[op]
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((N,), dtype),
+    ):
+        with T.Kernel(1, threads=threads) as _:
+            r = T.alloc_reducer((N,), dtype, op=op, replication="all")
+            T.fill(r, init)
+            for i, j in T.Parallel(M, N):
+                r[j] = update(r[j], A[i, j])
+            T.finalize_reducer(r)
+            T.copy(r, B)
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_reducer_ops():
+    import functools
+    import torch
+
+    M, N = 128, 16
+    # Replicated over 128 threads, partials are exchanged one per warp.
+    kernel = tl.compile(reducer_ops_test(M, N, "prod", T.float32), out_idx=-1)
+    assert "run_batch_compact" in kernel.get_kernel_source()
+    A = (1 + 0.01 * torch.randn((M, N))).cuda()
+    torch.testing.assert_close(kernel(A), A.prod(dim=0), atol=1e-3, rtol=1e-3)
+
+    kernel = tl.compile(reducer_ops_test(M, N, "absmax", T.float32), out_idx=-1)
+    A = torch.randn((M, N)).cuda()
+    torch.testing.assert_close(kernel(A), A.abs().amax(dim=0))
+
+    kernel = tl.compile(reducer_ops_test(M, N, "bitxor", T.int32), out_idx=-1)
+    A = torch.randint(0, 1 << 30, (M, N), dtype=torch.int32).cuda()
+    ref = functools.reduce(torch.bitwise_xor, A.unbind(0))
+    torch.testing.assert_close(kernel(A), ref)
+
+
+def reducer_argmax_test(M, N, dtype=T.float32, threads=128):
+    import tilelang.language as T
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((N,), T.int32),
+    ):
+        with T.Kernel(1, threads=threads) as _:
+            val, idx = T.alloc_reducer((N,), dtype, op="argmax", replication="all")
+            T.fill(val, -T.infinity(dtype))
+            T.fill(idx, 0)
+            for i, j in T.Parallel(M, N):
+                if A[i, j] > val[j]:
+                    val[j] = A[i, j]
+                    idx[j] = i
+            T.finalize_reducer(val, idx)
+            T.copy(idx, B)
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_reducer_argmax():
+    import torch
+
+    M, N = 256, 16
+    kernel = tl.compile(reducer_argmax_test(M, N), out_idx=-1)
+    # Few distinct values, so that ties resolve to the first index.
+    A = torch.randint(0, 8, (M, N)).float().cuda()
+    torch.testing.assert_close(kernel(A), A.argmax(dim=0).int())
+
+
+def cluster_split_k_sum_test(M, K, block_M, splits, dtype=T.float32):
+    import tilelang.language as T
+
+    block_K = K // splits
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((M,), dtype),
+    ):
+        with T.Kernel(M // block_M, splits, threads=128, cluster_dims=(1, splits)) as (bx, by):
+            A_local = T.alloc_fragment((block_M, block_K), dtype)
+            B_local = T.alloc_fragment((block_M,), dtype)
+
+            T.copy(A[bx * block_M, by * block_K], A_local)
+            T.reduce_sum(A_local, B_local, dim=1)
+            T.cluster_allreduce(B_local, "sum")
+            if T.cluster_rank() == 0:
+                T.copy(B_local, B[bx * block_M])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_cluster_split_k_sum():
+    import torch
+
+    M, K = 256, 512
+    jit_kernel = tl.compile(cluster_split_k_sum_test(M, K, block_M=64, splits=4), out_idx=-1)
+    assert "__cluster_dims__(1, 4, 1)" in jit_kernel.get_kernel_source()
+    A = torch.randn((M, K), dtype=torch.float32).cuda()
+    torch.testing.assert_close(jit_kernel(A), A.sum(dim=1), atol=1e-3, rtol=1e-3)
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
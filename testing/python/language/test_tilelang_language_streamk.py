@@ -0,0 +1,52 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def streamk_gemm(M, N, K, block_M, block_N, block_K, num_programs, dtype=T.float16, accum_dtype=T.float32):
+    num_tiles = T.ceildiv(M, block_M) * T.ceildiv(N, block_N)
+    iters_per_tile = T.ceildiv(K, block_K)
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), accum_dtype),
+    ):
+        with T.Kernel(num_programs, threads=128) as pid:
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            for tile_id, k_begin, k_end in T.StreamK(num_tiles, iters_per_tile, num_programs, pid):
+                bm = tile_id // T.ceildiv(N, block_N)
+                bn = tile_id % T.ceildiv(N, block_N)
+                T.clear(C_local)
+                for k in T.Pipelined(k_end - k_begin, num_stages=2):
+                    T.copy(A[bm * block_M, (k_begin + k) * block_K], A_shared)
+                    T.copy(B[(k_begin + k) * block_K, bn * block_N], B_shared)
+                    T.gemm(A_shared, B_shared, C_local)
+                T.streamk_store(C_local, C[bm * block_M, bn * block_N], k_begin, k_end, iters_per_tile)
+
+    return main
+
+
+def run_streamk_gemm(M, N, K, num_programs, block_M=64, block_N=64, block_K=32):
+    kernel = tilelang.compile(streamk_gemm(M, N, K, block_M, block_N, block_K, num_programs))
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    c = torch.zeros(M, N, device="cuda", dtype=torch.float32)
+    kernel(a, b, c)
+    torch.testing.assert_close(c, a.float() @ b.float(), rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+def test_streamk_gemm():
+    # 3 x 3 tiles of 8 K iterations over 4 programs: every program splits tiles.
+    run_streamk_gemm(192, 192, 256, num_programs=4)
+    # Evenly divisible work degenerates to data-parallel tiles.
+    run_streamk_gemm(128, 128, 128, num_programs=4)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
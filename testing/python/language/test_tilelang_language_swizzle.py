@@ -0,0 +1,66 @@
+import pytest
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def swizzled_gemm(M, N, K, block_M, block_N, block_K, panel_size, order, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.use_swizzle(panel_size, order=order)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+def run_swizzled_gemm(order, panel_size, M, N, K=64):
+    kernel = tilelang.compile(swizzled_gemm(M, N, K, 32, 32, 32, panel_size, order), out_idx=[2])
+    assert f"rasterization{order.capitalize()}<{panel_size}>" in kernel.get_kernel_source()
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    c = kernel(a, b)
+    torch.testing.assert_close(c, a @ b, rtol=1e-2, atol=1e-2)
+
+
+@tilelang.testing.requires_cuda
+@pytest.mark.parametrize("order", ["morton", "hilbert"])
+def test_curve_swizzle(order):
+    # A grid of 7 x 5 blocks leaves partial groups on both edges.
+    run_swizzled_gemm(order, 4, 5 * 32, 7 * 32)
+    run_swizzled_gemm(order, 2, 8 * 32, 8 * 32)
+
+
+def test_curve_swizzle_requires_power_of_two():
+    with pytest.raises(ValueError):
+        T.use_swizzle(3, order="hilbert")
+    with pytest.raises(ValueError):
+        T.use_swizzle(4, order="diagonal")
+
+
+def test_rasterization_candidates():
+    from tilelang.carver.roller import NoRasterization, RasterizationHilbert, get_rasterization_candidates
+
+    candidates = get_rasterization_candidates(panel_widths=(4, 6))
+    assert isinstance(candidates[0], NoRasterization)
+    assert candidates[0].to_swizzle() is None
+    assert {"panel_size": 4, "order": "hilbert"} in [c.to_swizzle() for c in candidates]
+    # Curve orders are only emitted for power-of-two panels.
+    assert not any(isinstance(c, RasterizationHilbert) and c.panel_width == 6 for c in candidates)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
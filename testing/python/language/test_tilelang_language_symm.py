@@ -0,0 +1,69 @@
+import socket
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+import torch.distributed as dist
+from tilelang.jit.adapter import SymmetricHeap
+
+
+def _init_single_rank():
+    # A group of one rank: peer 0 is the current rank, reached through its
+    # own peer table like any other
+    if dist.is_initialized():
+        return
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        port = s.getsockname()[1]
+    dist.init_process_group("gloo", init_method=f"tcp://127.0.0.1:{port}", rank=0, world_size=1)
+
+
+def ring_put(M, N, block_M, world_size, dtype=T.float16):
+    num_blocks = M // block_M
+
+    @T.prim_func
+    def main(
+        X: T.Tensor((M, N), dtype),
+        Y: T.Tensor((world_size, M, N), dtype),
+        flags: T.Tensor((world_size,), T.uint64),
+        rank: T.int32,
+    ):
+        with T.Kernel(num_blocks, threads=128) as bx:
+            X_shared = T.alloc_shared((block_M, N), dtype)
+            peer = (rank + 1) % world_size
+            T.copy(X[bx * block_M, 0], X_shared)
+            T.put(X_shared, Y[rank, bx * block_M, 0], peer)
+            T.signal(flags[rank], 1, peer, op="add")
+            T.signal_wait(flags[(rank + world_size - 1) % world_size], num_blocks, cmp="ge")
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_symm_ring_put():
+    _init_single_rank()
+    M, N, block_M = 256, 128, 64
+    world_size, rank = dist.get_world_size(), dist.get_rank()
+    kernel = tilelang.compile(ring_put(M, N, block_M, world_size))
+    source = kernel.get_kernel_source()
+    assert "tl::symm_remote_ptr" in source
+    assert "tl::symm_signal" in source
+    assert "tl::symm_wait" in source
+
+    heap = SymmetricHeap(1 << 24)
+    y = heap.tensor((world_size, M, N), torch.float16)
+    flags = heap.tensor((world_size,), torch.uint64)
+    heap.barrier()
+    x = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    kernel(x, y, flags, rank)
+    heap.barrier()
+    assert int(flags[rank].view(torch.int64).item()) == M // block_M
+    # Y[r] holds the X of the previous rank r, ours with a single rank
+    if world_size == 1:
+        torch.testing.assert_close(y[rank], x)
+    heap.close()
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
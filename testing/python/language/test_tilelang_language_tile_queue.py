@@ -0,0 +1,52 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def tile_queue_gemm(M, N, K, block_M, block_N, block_K, num_ctas, dtype=T.float16, accum_dtype=T.float32):
+    num_tiles = T.ceildiv(M, block_M) * T.ceildiv(N, block_N)
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor((K, N), dtype),
+        C: T.Tensor((M, N), dtype),
+        Counter: T.Tensor((1,), T.int32),
+    ):
+        with T.Kernel(num_ctas, threads=128) as _:
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            for tile_id in T.TileQueue(num_tiles, Counter):
+                bm = tile_id // T.ceildiv(N, block_N)
+                bn = tile_id % T.ceildiv(N, block_N)
+                T.clear(C_local)
+                for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                    T.copy(A[bm * block_M, k * block_K], A_shared)
+                    T.copy(B[k * block_K, bn * block_N], B_shared)
+                    T.gemm(A_shared, B_shared, C_local)
+                T.copy(C_local, C[bm * block_M, bn * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_tile_queue_gemm():
+    M, N, K, num_ctas = 512, 512, 128, 3
+    kernel = tilelang.compile(
+        tile_queue_gemm(M, N, K, 64, 64, 32, num_ctas),
+        pass_configs={tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True},
+    )
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    c = torch.empty(M, N, device="cuda", dtype=torch.float16)
+    counter = torch.zeros(1, device="cuda", dtype=torch.int32)
+    kernel(a, b, c, counter)
+    torch.testing.assert_close(c, a @ b, rtol=1e-2, atol=1e-2)
+    # Every CTA claims one index past the end before exiting.
+    assert counter.item() == (M // 64) * (N // 64) + num_ctas
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,90 @@
+import tilelang.testing
+import tilelang as tl
+import torch
+import tilelang.language as T
+
+
+def topk_test(M, N, k, block_M, largest=True, dtype=T.float32, threads=128):
+    @T.prim_func
+    def topk(
+        A: T.Tensor((M, N), dtype),
+        Vals: T.Tensor((M, k), dtype),
+        Idx: T.Tensor((M, k), T.int32),
+    ):
+        with T.Kernel(T.ceildiv(M, block_M), threads=threads) as bx:
+            A_fragment = T.alloc_fragment((block_M, N), dtype)
+            T.copy(A[bx * block_M, 0], A_fragment)
+            T.topk(
+                A_fragment,
+                Vals[bx * block_M : (bx + 1) * block_M, :],
+                Idx[bx * block_M : (bx + 1) * block_M, :],
+                k=k,
+                largest=largest,
+            )
+
+    return topk
+
+
+def topk_fragment_test(M, N, k, block_M, dtype=T.float32, threads=128):
+    @T.prim_func
+    def topk(
+        A: T.Tensor((M, N), dtype),
+        Vals: T.Tensor((M, k), dtype),
+        Idx: T.Tensor((M, k), T.int32),
+    ):
+        with T.Kernel(T.ceildiv(M, block_M), threads=threads) as bx:
+            A_fragment = T.alloc_fragment((block_M, N), dtype)
+            vals_fragment = T.alloc_fragment((block_M, k), dtype)
+            idx_fragment = T.alloc_fragment((block_M, k), T.int32)
+            T.copy(A[bx * block_M, 0], A_fragment)
+            T.topk(A_fragment, vals_fragment, idx_fragment, k=k)
+            T.copy(vals_fragment, Vals[bx * block_M, 0])
+            T.copy(idx_fragment, Idx[bx * block_M, 0])
+
+    return topk
+
+
+def run_topk(M, N, k, block_M, largest=True, dtype=T.float32, threads=128, scope="global"):
+    if scope == "global":
+        program = topk_test(M, N, k, block_M, largest, dtype, threads)
+    else:
+        program = topk_fragment_test(M, N, k, block_M, dtype, threads)
+    kernel = tl.compile(program, out_idx=[1, 2])
+
+    A = torch.randn(M, N, dtype=getattr(torch, dtype)).cuda()
+    vals, idx = kernel(A)
+    ref_vals, ref_idx = A.topk(k, dim=1, largest=largest)
+
+    if k > 32:
+        # The radix select leaves the rows unsorted.
+        vals, order = vals.sort(dim=1, descending=largest)
+        idx = idx.gather(1, order)
+    torch.testing.assert_close(vals, ref_vals)
+    if dtype == T.float32:
+        # Half precision rows may hold ties, which torch orders arbitrarily.
+        torch.testing.assert_close(idx, ref_idx.to(torch.int32))
+    torch.testing.assert_close(A.gather(1, idx.long()), vals)
+
+
+@tilelang.testing.requires_cuda
+def test_topk_bitonic():
+    run_topk(256, 128, 8, 64)
+    run_topk(256, 64, 1, 64)
+    run_topk(256, 256, 32, 32, threads=256)
+    run_topk(256, 128, 6, 64, largest=False)
+    run_topk(256, 128, 8, 64, dtype=T.float16)
+
+
+@tilelang.testing.requires_cuda
+def test_topk_radix():
+    run_topk(128, 512, 64, 16)
+    run_topk(128, 1024, 256, 8, threads=256, largest=False)
+
+
+@tilelang.testing.requires_cuda
+def test_topk_fragment_output():
+    run_topk(256, 128, 8, 64, scope="fragment")
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
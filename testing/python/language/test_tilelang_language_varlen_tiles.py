@@ -0,0 +1,88 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tilelang.utils.varlen import cu_seqlens_to_cu_tiles
+
+
+def varlen_tile_visits(batch, num_programs):
+    @T.prim_func
+    def main(
+        cu_tiles: T.Tensor((batch + 1,), T.int32),
+        Visits: T.Tensor((1024, 3), T.int32),
+    ):
+        with T.Kernel(num_programs, threads=32) as pid:
+            for seq_id, tile_id in T.VarlenTiles(cu_tiles, num_programs, pid):
+                if T.get_thread_binding() == 0:
+                    Visits[cu_tiles[seq_id] + tile_id, 0] = seq_id
+                    Visits[cu_tiles[seq_id] + tile_id, 1] = tile_id
+                    Visits[cu_tiles[seq_id] + tile_id, 2] = pid
+
+    return main
+
+
+def varlen_grouped_gemm(batch, K, N, block_M, block_K, num_programs, dtype=T.float16, accum_dtype=T.float32):
+    total = T.dynamic("total")
+
+    @T.prim_func
+    def main(
+        X: T.Tensor((total, K), dtype),
+        W: T.Tensor((batch, K, N), dtype),
+        cu_seqlens: T.Tensor((batch + 1,), T.int32),
+        cu_tiles: T.Tensor((batch + 1,), T.int32),
+        Y: T.Tensor((total, N), dtype),
+    ):
+        with T.Kernel(num_programs, threads=128) as pid:
+            X_shared = T.alloc_shared((block_M, block_K), dtype)
+            W_shared = T.alloc_shared((block_K, N), dtype)
+            C_local = T.alloc_fragment((block_M, N), accum_dtype)
+            for seq_id, tile_id in T.VarlenTiles(cu_tiles, num_programs, pid):
+                row = cu_seqlens[seq_id] + tile_id * block_M
+                T.clear(C_local)
+                for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                    T.copy(X[row, k * block_K], X_shared)
+                    T.copy(W[seq_id, k * block_K, 0], W_shared)
+                    T.gemm(X_shared, W_shared, C_local)
+                # The rows past the sequence belong to the next one
+                for i, j in T.Parallel(block_M, N):
+                    if row + i < cu_seqlens[seq_id + 1]:
+                        Y[row + i, j] = C_local[i, j]
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_varlen_tiles_visit_every_tile_once():
+    seqlens = [100, 0, 1, 64, 300, 0, 65]
+    block_M, num_programs = 64, 3
+    cu_seqlens = torch.tensor([0] + seqlens, device="cuda", dtype=torch.int32).cumsum(0, dtype=torch.int32)
+    cu_tiles = cu_seqlens_to_cu_tiles(cu_seqlens, block_M)
+    expected = [(b, t) for b, n in enumerate(seqlens) for t in range((n + block_M - 1) // block_M)]
+    assert cu_tiles[-1].item() == len(expected)
+
+    kernel = tilelang.compile(varlen_tile_visits(len(seqlens), num_programs))
+    visits = torch.full((1024, 3), -1, device="cuda", dtype=torch.int32)
+    kernel(cu_tiles, visits)
+    visits = visits[: len(expected)].tolist()
+    assert [(seq, tile) for seq, tile, _ in visits] == expected
+    # Tiles are strided across the programs
+    assert [pid for _, _, pid in visits] == [i % num_programs for i in range(len(expected))]
+
+
+@tilelang.testing.requires_cuda
+def test_varlen_grouped_gemm():
+    seqlens = [100, 7, 256, 0, 129]
+    K, N, block_M = 128, 64, 64
+    cu_seqlens = torch.tensor([0] + seqlens, device="cuda", dtype=torch.int32).cumsum(0, dtype=torch.int32)
+    cu_tiles = cu_seqlens_to_cu_tiles(cu_seqlens, block_M)
+    kernel = tilelang.compile(varlen_grouped_gemm(len(seqlens), K, N, block_M, 32, num_programs=4))
+    x = torch.randn(sum(seqlens), K, device="cuda", dtype=torch.float16)
+    w = torch.randn(len(seqlens), K, N, device="cuda", dtype=torch.float16)
+    y = torch.empty(sum(seqlens), N, device="cuda", dtype=torch.float16)
+    kernel(x, w, cu_seqlens, cu_tiles, y)
+    ref = torch.cat([x[s:e].float() @ w[b].float() for b, (s, e) in enumerate(zip(cu_seqlens[:-1].tolist(), cu_seqlens[1:].tolist()))])
+    torch.testing.assert_close(y.float(), ref, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
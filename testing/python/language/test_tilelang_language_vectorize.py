@@ -198,5 +198,37 @@ def test_vectorize_call_bitwise_logical():
     assert "float4" in kernel.get_kernel_source()
 
 
+@tilelang.jit(pass_configs={tilelang.PassConfigKey.TL_DISABLE_VECTORIZE_256: True})
+def vectorize_test_tail(M, N, stride):
+    @T.prim_func
+    def main(
+        A: T.StridedTensor[(M, N), (stride, 1), T.float32],  # noqa: F821
+        B: T.StridedTensor[(M, N), (stride, 1), T.float32],  # noqa: F821
+    ):
+        with T.Kernel(M // 128, threads=128) as (bx):
+            tx = T.get_thread_binding(0)
+            row = bx * 128 + tx
+
+            for col in T.vectorized(N):
+                B[row, col] = A[row, col]
+
+    return main
+
+
+def test_vectorize_tail():
+    # 98 columns: the first 96 stay at full width, only the last 2 are narrowed
+    M, N, stride = 256, 98, 100
+    kernel = vectorize_test_tail(M, N, stride)
+    base_a = torch.randn(M, stride, device="cuda", dtype=torch.float32)
+    base_b = torch.zeros(M, stride, device="cuda", dtype=torch.float32)
+    a = torch.as_strided(base_a, size=(M, N), stride=(stride, 1))
+    b = torch.as_strided(base_b, size=(M, N), stride=(stride, 1))
+    kernel(a, b)
+    torch.testing.assert_close(a, b, atol=1e-8, rtol=1e-8)
+    code = kernel.get_kernel_source()
+    assert "float4" in code
+    assert "float2" in code
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
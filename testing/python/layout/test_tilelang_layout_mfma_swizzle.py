@@ -0,0 +1,38 @@
+import pytest
+import tilelang
+import tilelang.testing
+from tilelang.layout import make_mfma_swizzled_layout
+from tilelang import tvm as tvm
+
+
+@pytest.mark.parametrize(
+    "rows, cols, dtype, vec_bytes",
+    [
+        (128, 32, "float16", 8),
+        (128, 32, "float16", 16),
+        (128, 64, "float16", 16),
+        (64, 128, "float8_e4m3fn", 16),
+        (64, 32, "float32", 16),
+    ],
+)
+def test_mfma_swizzled_layout_bank_conflict_free(rows, cols, dtype, vec_bytes):
+    buffer = tvm.tir.decl_buffer((rows, cols), dtype, scope="shared")
+    layout = make_mfma_swizzled_layout(buffer, vec_bytes=vec_bytes)
+    elem_bytes = tvm.DataType(dtype).bits // 8
+    vec = vec_bytes // elem_bytes
+    # The LDS serves 128 bytes per clock, the lanes of one clock read the same
+    # K of consecutive rows
+    lanes = 128 // vec_bytes
+    for row0 in range(0, rows, lanes):
+        for k in range(0, cols, vec):
+            banks = set()
+            for row in range(row0, row0 + lanes):
+                r, c = (int(x) for x in layout.map_forward_index([row, k]))
+                assert r == row and c % vec == 0
+                start = (r * cols + c) * elem_bytes % 128 // 4
+                banks.update(range(start, start + vec_bytes // 4))
+            assert len(banks) == 32
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
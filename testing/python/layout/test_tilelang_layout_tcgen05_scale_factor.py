@@ -0,0 +1,29 @@
+import tilelang
+import tilelang.testing
+from tilelang.layout import make_tcgen05_scale_factor_layout, make_tcgen05_scale_factor_tmem_layout
+from tilelang import tvm as tvm
+
+
+def _check_scale_factor_layouts(rows, num_sf):
+    buffer = tvm.tir.decl_buffer((rows, num_sf), "uint8", scope="shared")
+    smem_layout = make_tcgen05_scale_factor_layout(buffer)
+    tmem_layout = make_tcgen05_scale_factor_tmem_layout(rows, num_sf)
+    seen = set()
+    for i in range(rows):
+        for j in range(num_sf):
+            chunk, offset = (int(x) for x in smem_layout.map_forward_index([i, j]))
+            lane, column, byte = (int(x) for x in tmem_layout.map_forward_index([i, j]))
+            seen.add(chunk * 512 + offset)
+            # tcgen05.cp.32x128b.warpx4 moves the 16 bytes of row l of a chunk
+            # into the 4 columns of lane l
+            assert (lane, column, byte) == (offset // 16, chunk * 4 + offset % 16 // 4, offset % 4)
+    assert seen == set(range(rows * num_sf))
+
+
+def test_tcgen05_scale_factor_layout():
+    _check_scale_factor_layouts(128, 4)
+    _check_scale_factor_layouts(256, 8)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -316,5 +316,49 @@ def test_fastmath_versions():
         print(f"✓ {name} test passed")
 
 
+def fastmath_region(M, N, ulp, op, dtype, block_M=32, block_N=32):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, N), dtype),
+        B: T.Tensor((M, N), dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            with T.fastmath(ulp=ulp):
+                for i, j in T.Parallel(block_M, block_N):
+                    B[by * block_M + i, bx * block_N + j] = op(A[by * block_M + i, bx * block_N + j])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(7, 5)
+def test_fastmath_region_budget():
+    M = N = 128
+    # ex2.approx.f32 is within 2 ulp, tanh.approx.f32 far from it
+    source = tilelang.compile(fastmath_region(M, N, 2, T.exp2, T.float32), out_idx=[1]).get_kernel_source()
+    assert "tl::ex2_approx(" in source
+    source = tilelang.compile(fastmath_region(M, N, 2, T.tanh, T.float32), out_idx=[1]).get_kernel_source()
+    assert "tl::tanh_approx" not in source
+    source = tilelang.compile(fastmath_region(M, N, None, T.tanh, T.float32), out_idx=[1]).get_kernel_source()
+    assert "tl::tanh_approx(" in source
+    # Outside of a region, or with a null budget, the calls are exact
+    source = tilelang.compile(fastmath_region(M, N, 0, T.exp2, T.float32), out_idx=[1]).get_kernel_source()
+    assert "tl::ex2_approx" not in source
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(7, 5)
+def test_fastmath_region_packed_half():
+    M = N = 128
+    kernel = tilelang.compile(fastmath_region(M, N, 2, T.exp2, T.float16), out_idx=[1])
+    assert "tl::ex2_approx_f16x2(" in kernel.get_kernel_source()
+    a = torch.randn(M, N, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(a), torch.exp2(a), rtol=2e-3, atol=2e-3)
+
+    kernel = tilelang.compile(fastmath_region(M, N, 2, T.tanh, T.float16), out_idx=[1])
+    assert "tl::tanh_approx_f16x2(" in kernel.get_kernel_source()
+    torch.testing.assert_close(kernel(a), torch.tanh(a), rtol=2e-3, atol=2e-3)
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
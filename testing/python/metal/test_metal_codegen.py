@@ -78,6 +78,14 @@ def test_gemm_int32():
     assert_gemm(1024, 1024, 1024, 16, 16, 16, dtype=T.int32, atol=1)
 
 
+@tilelang.testing.requires_metal
+def test_shader_library_shared():
+    from tilelang.jit.adapter.torch.metal import compile_shader_library
+
+    source = matmul(256, 256, 256, 16, 16, 16).kernel_source
+    assert compile_shader_library(source) is compile_shader_library(source)
+
+
 if __name__ == "__main__":
     if torch.mps.is_available():
         tilelang.testing.main()
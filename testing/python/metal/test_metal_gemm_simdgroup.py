@@ -0,0 +1,62 @@
+import pytest
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+import torch
+
+
+@tilelang.jit
+def matmul(M, N, K, block_M, block_N, block_K, dtype, accum_dtype, trans_B=False, threads=128):
+    B_shape = (N, K) if trans_B else (K, N)
+    B_shared_shape = (block_N, block_K) if trans_B else (block_K, block_N)
+
+    @T.prim_func
+    def gemm(
+        A: T.Tensor((M, K), dtype),
+        B: T.Tensor(B_shape, dtype),
+        C: T.Tensor((M, N), accum_dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            # simdgroup matrices multiply operands of the accumulator dtype
+            A_shared = T.alloc_shared((block_M, block_K), accum_dtype)
+            B_shared = T.alloc_shared(B_shared_shape, accum_dtype)
+            C_shared = T.alloc_shared((block_M, block_N), accum_dtype)
+            T.clear(C_shared)
+            for ko in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, ko * block_K], A_shared)
+                if trans_B:
+                    T.copy(B[bx * block_N, ko * block_K], B_shared)
+                else:
+                    T.copy(B[ko * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_shared, transpose_B=trans_B)
+            T.copy(C_shared, C[by * block_M, bx * block_N])
+
+    return gemm
+
+
+@tilelang.testing.requires_metal
+@pytest.mark.parametrize(
+    "dtype, accum_dtype, trans_B, atol",
+    [
+        (T.float32, T.float32, False, 1e-3),
+        (T.float32, T.float32, True, 1e-3),
+        (T.float16, T.float16, False, 1),
+        (T.float16, T.float32, False, 1e-2),
+    ],
+)
+def test_gemm_simdgroup(dtype, accum_dtype, trans_B, atol):
+    M = N = K = 512
+    kernel = matmul(M, N, K, 64, 64, 32, dtype, accum_dtype, trans_B=trans_B)
+    assert "simdgroup_multiply_accumulate" in kernel.get_kernel_source()
+
+    a = torch.randn(M, K, dtype=dtype.as_torch(), device="mps")
+    b = torch.randn(N, K, dtype=dtype.as_torch(), device="mps")
+    c = torch.zeros(M, N, dtype=accum_dtype.as_torch(), device="mps")
+    kernel(a, b if trans_B else b.T.contiguous(), c)
+    ref = a.float() @ b.float().T
+    torch.testing.assert_close(c.float(), ref, rtol=1e-2, atol=atol)
+
+
+if __name__ == "__main__":
+    if torch.mps.is_available():
+        tilelang.testing.main()
@@ -50,5 +50,19 @@ def test_profiler():
     print(f"event Latency: {event_latency}ms")
 
 
+def test_profiler_bench_modes():
+    kernel = matmul(2048, 2048, 2048, 128, 128, 32)
+    profiler = kernel.get_profiler()
+
+    stats = profiler.bench_modes(rep=50)
+    assert list(stats) == ["cold", "warm", "weights", "loaded"]
+    for mode in stats.values():
+        assert len(mode.times) > 0
+        assert mode.min <= mode.p50 <= mode.p99
+    # a bandwidth hog on the side only slows the kernel down
+    assert stats["loaded"].p50 >= 0.9 * stats["warm"].p50
+    print(stats)
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
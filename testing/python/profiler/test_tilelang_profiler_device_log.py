@@ -0,0 +1,77 @@
+import struct
+
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+from tilelang.language.device_log import _log_id
+from tilelang.profiler.device_log import decode_device_log, format_device_log
+
+
+def logged_copy(N, block_N, capacity):
+    @T.prim_func
+    def main(
+        A: T.Tensor((N,), T.float32),
+        B: T.Tensor((N,), T.float32),
+        L: T.Tensor(T.device_log_buffer_shape(capacity), T.int64),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+            tx = T.get_thread_binding()
+            B[bx * block_N + tx] = A[bx * block_N + tx]
+            if A[bx * block_N + tx] < 0:
+                T.device_log("negative", L, bx * block_N + tx, A[bx * block_N + tx])
+            T.print(bx, msg="block", log_buffer=L)
+
+    return main
+
+
+def _record(log_id, thread, block, values):
+    header = log_id | (thread[0] << 32) | (thread[1] << 42) | (thread[2] << 52) | (len(values) << 58)
+    return [header, block[0] | (block[1] << 32) | (block[2] << 48)] + values + [0] * (4 - len(values))
+
+
+def test_decode_device_log():
+    pair = _log_id("pair", ("i", "f"))
+    bits = struct.unpack("<q", struct.pack("<d", -1.5))[0]
+    records = [
+        _record(pair, (3, 1, 0), (7, 2, 1), [-4, bits]),
+        _record(_log_id("empty", ()), (0, 0, 0), (0, 0, 0), []),
+    ]
+    buffer = [len(records), 0, 0, 0] + sum(records, [])
+    decoded = decode_device_log(buffer)
+    assert decoded == [
+        {"msg": "pair", "block": (7, 2, 1), "thread": (3, 1, 0), "values": [-4, -1.5]},
+        {"msg": "empty", "block": (0, 0, 0), "thread": (0, 0, 0), "values": []},
+    ]
+    assert format_device_log(decoded[:1]) == "msg='pair' BlockIdx=(7, 2, 1), ThreadIdx=(3, 1, 0): values=[-4, -1.5]"
+
+
+@tilelang.testing.requires_cuda
+def test_device_log_codegen():
+    func = logged_copy(1024, 128, 4096)
+    kernel = tilelang.compile(func)
+    assert "device_log_record" not in kernel.get_kernel_source()
+
+    kernel = tilelang.compile(func, pass_configs={tilelang.PassConfigKey.TL_ENABLE_DEVICE_LOG: True})
+    source = kernel.get_kernel_source()
+    assert source.count("tl::device_log_record") == 2
+    assert "printf" not in source
+
+    import torch
+
+    a = torch.randn(1024, device="cuda")
+    b = torch.empty_like(a)
+    buffer = tilelang.profiler.alloc_device_log_buffer(4096)
+    kernel(a, b, buffer)
+    torch.testing.assert_close(a, b)
+    records = kernel.get_profiler().decode_device_log(buffer)
+    negative = sorted((r["values"][0], r["values"][1]) for r in records if r["msg"] == "negative")
+    expected = sorted((i, v) for i, v in enumerate(a.tolist()) if v < 0)
+    assert [i for i, _ in negative] == [i for i, _ in expected]
+    assert all(abs(v - w) < 1e-6 for (_, v), (_, w) in zip(negative, expected))
+    blocks = [r for r in records if r["msg"] == "block"]
+    assert len(blocks) == 1024
+    assert all(r["values"] == [r["block"][0]] and r["thread"][0] < 128 for r in blocks)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,59 @@
+import pytest
+
+import tilelang
+import tilelang.testing
+from tilelang.carver.arch.arch_base import TileDevice
+from tilelang.profiler.metrics import DEFAULT_METRICS, KernelMetrics, parse_metric_trace, roofline
+
+
+class _FakeDevice(TileDevice):
+    def peak_memory_bandwidth(self):
+        return 2e12
+
+    def peak_tensor_flops(self, dtype="float16"):
+        return 1e15 if dtype == "float16" else None
+
+
+def test_parse_metric_trace():
+    trace = {
+        "traceEvents": [
+            {"cat": "kernel", "name": "main_kernel", "dur": 10},
+            {
+                "cat": "cuda_profiler_range",
+                "name": "main_kernel",
+                "args": {
+                    DEFAULT_METRICS["time_ns"]: 10000,
+                    DEFAULT_METRICS["dram_bytes_read"]: "3000000",
+                    DEFAULT_METRICS["dram_bytes_write"]: 1000000,
+                    DEFAULT_METRICS["achieved_occupancy"]: 45.5,
+                    "sm__cycles_elapsed.max": 21000,
+                    "note": "not a counter",
+                },
+            },
+        ]
+    }
+    (kernel,) = parse_metric_trace(trace)
+    assert kernel.name == "main_kernel"
+    assert kernel.time_ns == 10000 and kernel.dram_bytes == 4e6 and kernel.achieved_occupancy == 45.5
+    assert kernel.tensor_pipe_utilization is None
+    assert kernel.raw["sm__cycles_elapsed.max"] == 21000 and "note" not in kernel.raw
+
+
+def test_roofline():
+    kernel = KernelMetrics(name="k", time_ns=1e6, dram_bytes_read=1e9, dram_bytes_write=0.0)
+    # 100 FLOP/B is below the ridge point of 500 FLOP/B
+    memory_bound = roofline(kernel, flops=1e11, arch=_FakeDevice())
+    assert memory_bound.bound == "memory" and memory_bound.ridge_point == 500
+    assert memory_bound.achieved_bandwidth == pytest.approx(1e12)
+    assert memory_bound.fraction_of_roof == pytest.approx(0.5)
+
+    compute_bound = roofline(kernel, flops=8e11, arch=_FakeDevice())
+    assert compute_bound.bound == "compute"
+    assert compute_bound.fraction_of_roof == pytest.approx(0.8)
+
+    unknown = roofline(kernel, flops=1e11, arch=_FakeDevice(), dtype="int4")
+    assert unknown.bound is None and unknown.arithmetic_intensity == 100
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,75 @@
+import tilelang
+import tilelang.testing
+import tilelang.language as T
+from tilelang.language.profile import profile_region_id
+from tilelang.profiler.region import decode_profile_regions, profile_regions_to_trace
+
+
+def profiled_copy(N, block_N, capacity):
+    @T.prim_func
+    def main(
+        A: T.Tensor((N,), T.float32),
+        B: T.Tensor((N,), T.float32),
+        P: T.Tensor(T.profile_buffer_shape(capacity), T.int64),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+            T.profile_begin("copy", P)
+            for i in T.Parallel(block_N):
+                B[bx * block_N + i] = A[bx * block_N + i]
+            T.profile_end("copy", P)
+
+    return main
+
+
+def _record(timer, cycles, region, is_end, warp, sm, block):
+    return [timer, cycles, region | (is_end << 32) | (warp << 33) | (sm << 48), block]
+
+
+def test_decode_profile_regions():
+    load = profile_region_id("load")
+    mma = profile_region_id("mma")
+    records = [
+        _record(100, 1000, load, 0, 0, 3, 7),
+        _record(150, 1100, mma, 0, 4, 3, 7),
+        _record(180, 1200, load, 1, 0, 3, 7),
+        _record(400, 1900, mma, 1, 4, 3, 7),
+        # an end whose begin was overwritten is dropped
+        _record(500, 2000, mma, 1, 4, 5, 8),
+    ]
+    buffer = [len(records), 0, 0, 0] + sum(records, [])
+    regions = decode_profile_regions(buffer, warp_roles={0: "producer", 4: "consumer"})
+    assert [(r["name"], r["role"], r["sm"], r["duration_ns"], r["cycles"]) for r in regions] == [
+        ("load", "producer", 3, 80, 200),
+        ("mma", "consumer", 3, 250, 800),
+    ]
+
+    trace = profile_regions_to_trace(regions)
+    slices = [e for e in trace["traceEvents"] if e["ph"] == "X"]
+    assert [(e["name"], e["pid"], e["ts"], e["dur"]) for e in slices] == [("load", 3, 0.0, 0.08), ("mma", 3, 0.05, 0.25)]
+    assert slices[0]["tid"] != slices[1]["tid"]
+
+
+@tilelang.testing.requires_cuda
+def test_profile_region_codegen():
+    func = profiled_copy(1024, 128, 64)
+    kernel = tilelang.compile(func)
+    assert "profile_region_record" not in kernel.get_kernel_source()
+
+    kernel = tilelang.compile(func, pass_configs={tilelang.PassConfigKey.TL_ENABLE_PROFILE_REGION: True})
+    assert kernel.get_kernel_source().count("tl::profile_region_record") == 2
+
+    import torch
+
+    a = torch.randn(1024, device="cuda")
+    b = torch.empty_like(a)
+    buffer = tilelang.profiler.alloc_profile_buffer(64)
+    kernel(a, b, buffer)
+    torch.testing.assert_close(a, b)
+    regions = kernel.get_profiler().decode_profile_regions(buffer)
+    # 8 blocks of 4 warps each
+    assert len(regions) == 32
+    assert all(r["name"] == "copy" and r["duration_ns"] >= 0 for r in regions)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
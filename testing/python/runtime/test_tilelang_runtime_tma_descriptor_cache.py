@@ -0,0 +1,48 @@
+import torch
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+from tilelang.utils.tma import clear_tma_descriptor_cache, get_tma_descriptor_cache_stats
+
+
+@tilelang.jit(out_idx=[-1], execution_backend="tvm_ffi")
+def tma_copy(M, N, block_M, block_N, dtype=T.float16):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), dtype), B: T.Tensor((M, N), dtype)):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_N), dtype)
+            T.copy(A[by * block_M, bx * block_N], A_shared)
+            T.copy(A_shared, B[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_tma_descriptor_cache_reuse_and_patch():
+    kernel = tma_copy(256, 256, 64, 64)
+    assert "CUtensorMap" in kernel.get_kernel_source()
+
+    clear_tma_descriptor_cache()
+    a = torch.randn(256, 256, dtype=torch.float16, device="cuda")
+    torch.testing.assert_close(kernel(a), a)
+    misses = get_tma_descriptor_cache_stats()["misses"]
+    assert misses > 0
+
+    # Same tensor: descriptors are served from the cache without re-encoding.
+    torch.testing.assert_close(kernel(a), a)
+    stats = get_tma_descriptor_cache_stats()
+    assert stats["misses"] == misses
+    assert stats["hits"] > 0
+
+    # New allocation with the same layout: only the global address is patched.
+    b = torch.randn(256, 256, dtype=torch.float16, device="cuda")
+    torch.testing.assert_close(kernel(b), b)
+    stats = get_tma_descriptor_cache_stats()
+    assert stats["misses"] == misses
+    assert stats["address_patches"] > 0
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -18,6 +18,7 @@ def matmul(
     accum_dtype,
     num_stages,
     threads,
+    fragment_double_buffer=False,
 ):
     A_shape = (K, M) if trans_A else (M, K)
     B_shape = (N, K) if trans_B else (K, N)
@@ -44,7 +45,7 @@ def matmul(
                     T.copy(B[bx * block_N, k * block_K], B_shared)
                 else:
                     T.copy(B[k * block_K, bx * block_N], B_shared)
-                T.gemm_v2(A_shared, B_shared, C_local, trans_A, trans_B)
+                T.gemm_v2(A_shared, B_shared, C_local, trans_A, trans_B, fragment_double_buffer=fragment_double_buffer)
                 # T.gemm(A_shared, B_shared, C_local, trans_A, trans_B)
             T.copy(C_local, C[by * block_M, bx * block_N])
 
@@ -65,6 +66,7 @@ def run_gemm_ss(
     block_K,
     num_stages=3,
     num_threads=128,
+    fragment_double_buffer=False,
 ):
     program = matmul(
         M,
@@ -80,6 +82,7 @@ def run_gemm_ss(
         dtypeAccum,
         num_stages,
         num_threads,
+        fragment_double_buffer,
     )
 
     kernel = tilelang.compile(
@@ -130,6 +133,13 @@ def test_gemm_ss(M, N, K, trans_A, trans_B, in_dtype, out_dtype, dtypeAccum, blo
     run_gemm_ss(M, N, K, trans_A, trans_B, in_dtype, out_dtype, dtypeAccum, block_M, block_N, block_K, num_stages, num_threads)
 
 
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(8, 0)
+@pytest.mark.parametrize("trans_A, trans_B", [(False, False), (False, True), (True, False)])
+def test_gemm_ss_fragment_double_buffer(trans_A, trans_B):
+    run_gemm_ss(512, 1024, 768, trans_A, trans_B, T.float16, T.float16, T.float32, 128, 128, 64, 2, 128, fragment_double_buffer=True)
+
+
 @pytest.mark.skip(reason="Temporarily disabling until GEMM SS issues are resolved")
 @tilelang.testing.requires_cuda
 @pytest.mark.parametrize(
@@ -142,6 +152,103 @@ def test_gemm_ss_fp8_cuda(M, N, K, trans_A, trans_B, in_dtype, out_dtype, dtypeA
     run_gemm_ss(M, N, K, trans_A, trans_B, in_dtype, out_dtype, dtypeAccum, block_M, block_N, block_K, num_stages, num_threads)
 
 
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_eq(9, 0)
+@pytest.mark.parametrize(
+    "trans_A, trans_B, in_dtype, accum_dtype",
+    [
+        (False, False, T.float8_e4m3fn, T.float32),
+        (True, True, T.float8_e4m3fn, T.float32),
+        (True, False, T.float8_e5m2, T.float32),
+        (False, False, T.int8, T.int32),
+    ],
+)
+def test_gemm_ss_wgmma_kmajor_staging(trans_A, trans_B, in_dtype, accum_dtype):
+    import torch
+
+    M, N, K = 256, 256, 256
+    program = matmul(M, N, K, 128, 128, 64, trans_A, trans_B, in_dtype, accum_dtype, accum_dtype, 2, 128)
+    kernel = tilelang.compile(program, out_idx=[2])
+    # the operands that are not K-major are copied into K-major tiles
+    assert "wgmma" in kernel.get_kernel_source()
+
+    A_shape = (K, M) if trans_A else (M, K)
+    B_shape = (N, K) if trans_B else (K, N)
+    A = torch.randint(-4, 4, A_shape, device="cuda").to(torch.__getattribute__(str(in_dtype)))
+    B = torch.randint(-4, 4, B_shape, device="cuda").to(torch.__getattribute__(str(in_dtype)))
+    ref = (A.T if trans_A else A).to(torch.float) @ (B.T if trans_B else B).to(torch.float)
+    torch.testing.assert_close(kernel(A, B).to(torch.float), ref)
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_eq(9, 0)
+@pytest.mark.parametrize("trans_A, trans_B", [(False, False), (False, True), (True, False)])
+def test_gemm_ss_dmma_sm90(trans_A, trans_B):
+    import torch
+
+    M, N, K = 256, 256, 128
+    program = matmul(M, N, K, 64, 64, 32, trans_A, trans_B, T.float64, T.float64, T.float64, 2, 128)
+    kernel = tilelang.compile(program, out_idx=[2])
+    # Hopper issues the m16n8k8 DMMA instead of the m8n8k4 one
+    assert "kFloat64, 16, 8, 8" in kernel.get_kernel_source()
+
+    A = torch.randn((K, M) if trans_A else (M, K), device="cuda", dtype=torch.float64)
+    B = torch.randn((N, K) if trans_B else (K, N), device="cuda", dtype=torch.float64)
+    ref = (A.T if trans_A else A) @ (B.T if trans_B else B)
+    torch.testing.assert_close(kernel(A, B), ref)
+
+
+def matmul_blockscaled(M, N, K, block_M, block_N, block_K, in_dtype, num_stages, threads, sf_vec_size=32):
+    num_sf = block_K // sf_vec_size
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), in_dtype),
+        B: T.Tensor((N, K), in_dtype),
+        SFA: T.Tensor((M, K // sf_vec_size), T.uint8),
+        SFB: T.Tensor((N, K // sf_vec_size), T.uint8),
+        C: T.Tensor((M, N), T.float32),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), in_dtype)
+            B_shared = T.alloc_shared((block_N, block_K), in_dtype)
+            SFA_shared = T.alloc_shared((block_M, num_sf), T.uint8)
+            SFB_shared = T.alloc_shared((block_N, num_sf), T.uint8)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=num_stages):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[bx * block_N, k * block_K], B_shared)
+                T.copy(SFA[by * block_M, k * num_sf], SFA_shared)
+                T.copy(SFB[bx * block_N, k * num_sf], SFB_shared)
+                T.gemm_blockscaled(A_shared, B_shared, C_local, SFA_shared, SFB_shared, sf_vec_size=sf_vec_size)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_eq(12, 0)
+@pytest.mark.parametrize("in_dtype", [T.float8_e4m3fn, T.float8_e5m2])
+def test_gemm_ss_blockscaled_sm120(in_dtype):
+    import torch
+
+    M, N, K = 256, 256, 256
+    program = matmul_blockscaled(M, N, K, 128, 128, 64, in_dtype, 2, 128)
+    kernel = tilelang.compile(program, out_idx=[4])
+    assert "mma_sync_blockscaled" in kernel.get_kernel_source()
+
+    torch_dtype = torch.float8_e4m3fn if in_dtype == T.float8_e4m3fn else torch.float8_e5m2
+    A = torch.randn(M, K, device="cuda").to(torch_dtype)
+    B = torch.randn(N, K, device="cuda").to(torch_dtype)
+    SFA = torch.randint(124, 131, (M, K // 32), device="cuda", dtype=torch.uint8)
+    SFB = torch.randint(124, 131, (N, K // 32), device="cuda", dtype=torch.uint8)
+    scale_a = torch.exp2(SFA.float() - 127).repeat_interleave(32, dim=1)
+    scale_b = torch.exp2(SFB.float() - 127).repeat_interleave(32, dim=1)
+    ref = (A.float() * scale_a) @ (B.float() * scale_b).T
+    torch.testing.assert_close(kernel(A, B, SFA, SFB), ref, rtol=1e-2, atol=1e-2)
+
+
 @pytest.mark.skip(reason="Temporarily disabling until GEMM SS issues are resolved")
 @tilelang.testing.requires_rocm
 @pytest.mark.parametrize(
@@ -0,0 +1,71 @@
+import tilelang.language as T
+from tilelang import tvm as tvm
+import tilelang.testing
+import torch
+
+
+def skinny_matmul(M, N, K, block_N, block_K, trans_B, in_dtype, accum_dtype, threads=128):
+    """Decode-shaped GEMM: the M rows of A in one tile against a column tile of B."""
+    B_shape = (N, K) if trans_B else (K, N)
+    B_shared_shape = (block_N, block_K) if trans_B else (block_K, block_N)
+
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), in_dtype),
+        B: T.Tensor(B_shape, in_dtype),
+        C: T.Tensor((M, N), accum_dtype),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), threads=threads) as bx:
+            A_shared = T.alloc_shared((M, block_K), in_dtype)
+            B_shared = T.alloc_shared(B_shared_shape, in_dtype)
+            C_local = T.alloc_fragment((M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[0, k * block_K], A_shared)
+                if trans_B:
+                    T.copy(B[bx * block_N, k * block_K], B_shared)
+                else:
+                    T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local, transpose_B=trans_B)
+            T.copy(C_local, C[0, bx * block_N])
+
+    return main
+
+
+def run_skinny_gemm(M, N, K, block_N, block_K, trans_B, in_dtype=T.float16, accum_dtype=T.float32):
+    kernel = tilelang.compile(skinny_matmul(M, N, K, block_N, block_K, trans_B, in_dtype, accum_dtype), out_idx=[2])
+    a = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    b = torch.randn(N, K, device="cuda", dtype=torch.float16)
+    c = kernel(a, b if trans_B else b.T.contiguous())
+    torch.testing.assert_close(c, a.float() @ b.float().T, rtol=1e-2, atol=1e-2)
+    return kernel
+
+
+@tilelang.testing.requires_cuda
+def test_gemv():
+    source = run_skinny_gemm(1, 1024, 1024, 128, 128, trans_B=True).get_kernel_source()
+    # Split K merged by shuffles, no tensor core operand loads
+    assert "shfl_xor" in source
+    assert "ldmatrix" not in source
+
+
+@tilelang.testing.requires_cuda
+def test_skinny_gemm_rows():
+    for M in (2, 4, 8):
+        run_skinny_gemm(M, 512, 512, 64, 64, trans_B=True)
+
+
+@tilelang.testing.requires_cuda
+def test_skinny_gemm_nn():
+    run_skinny_gemm(4, 256, 256, 64, 32, trans_B=False)
+
+
+@tilelang.testing.requires_cuda
+def test_gemm_m16_keeps_mma():
+    # M = 16 fills an MMA tile, so T.gemm keeps the tensor cores
+    source = run_skinny_gemm(16, 256, 256, 64, 64, trans_B=True).get_kernel_source()
+    assert "ldmatrix" in source
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
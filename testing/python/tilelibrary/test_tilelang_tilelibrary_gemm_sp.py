@@ -327,6 +327,18 @@ def test_gemm_sp_sm90(M, N, K, in_dtype, out_dtype, accum_dtype, block_M, block_
     run_gemm_sp_sm90(M, N, K, in_dtype, out_dtype, accum_dtype, block_M, block_N, block_K, num_stages, num_threads, trans_A, trans_B)
 
 
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version(9, 0)
+@pytest.mark.parametrize("block_M, block_K", [(64, 64), (128, 128)])
+def test_gemm_sp_sm90_metadata_tma(block_M, block_K):
+    # the metadata tile is stored like E_shared, so it is loaded by TMA
+    # together with A and B in the producer of the pipeline
+    program = matmul_sp_sm90(512, 1024, 768, block_M, 64, block_K, T.float16, T.float32, T.float32, 2, 128, False, False)
+    kernel = tilelang.compile(program, out_idx=[-1])
+    assert kernel.get_kernel_source().count("tl::tma_load") == 3
+    run_gemm_sp(program, 512, 1024, 768, T.float16, T.float32, block_K, False, False)
+
+
 @tilelang.testing.requires_cuda
 @tilelang.testing.requires_cuda_compute_version_ge(8, 0)
 @tilelang.testing.requires_cuda_compute_version_le(8, 9)
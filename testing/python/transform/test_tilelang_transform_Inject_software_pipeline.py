@@ -44,5 +44,116 @@ def test_trival_pipeline():
     _check(before, expected)
 
 
+def test_async_wait_counts_commit_groups():
+    # Copies of A and B in stage 0 separated by a consumer of A form two commit
+    # groups per iteration, and cp.async.wait_group counts groups, not
+    # iterations: the consumer of A may leave the B of its own iteration and
+    # the A of the next one in flight.
+    @T.prim_func
+    def before(A: T.Tensor((4, 16), T.float32), B: T.Tensor((4, 16), T.float32), C: T.Tensor((4, 16), T.float32)):
+        for tx in T.thread_binding(0, 16, thread="threadIdx.x"):
+            for i in T.serial(
+                0,
+                4,
+                annotations={
+                    "software_pipeline_stage": [0, 1, 0, 1],
+                    "software_pipeline_order": [0, 1, 2, 3],
+                    "software_pipeline_async_stages": [0],
+                },
+            ):
+                with T.block():
+                    T.reads(A[i, tx], B[i, tx])
+                    T.writes(C[i, tx])
+                    A_shared = T.alloc_buffer((16,), dtype=T.float32, scope="shared")
+                    B_shared = T.alloc_buffer((16,), dtype=T.float32, scope="shared")
+                    with T.block():
+                        T.reads(A[i, tx])
+                        T.writes(A_shared[tx])
+                        A_shared[tx] = A[i, tx]
+                    with T.block():
+                        T.reads(A_shared[tx])
+                        T.writes(C[i, tx])
+                        C[i, tx] = A_shared[tx]
+                    with T.block():
+                        T.reads(B[i, tx])
+                        T.writes(B_shared[tx])
+                        B_shared[tx] = B[i, tx]
+                    with T.block():
+                        T.reads(A_shared[tx], B_shared[tx], C[i, tx])
+                        T.writes(C[i, tx])
+                        C[i, tx] = C[i, tx] + A_shared[tx] * B_shared[tx]
+
+    mod = tvm.IRModule.from_expr(before.with_attr("global_symbol", "main"))
+    mod = tl.transform.InjectSoftwarePipeline()(mod)
+    mod = tl.transform.Simplify()(mod)
+
+    body_waits = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.For) and node.kind == tvm.tir.ForKind.SERIAL:
+            tvm.tir.stmt_functor.post_order_visit(node.body, collect)
+
+    def collect(node):
+        if isinstance(node, tvm.tir.AttrStmt) and node.attr_key == "async_wait_inflight_count":
+            body_waits.append(int(node.value))
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, visit)
+    # Sequence committed before the consumers of iteration i - 1:
+    # A[i-1], B[i-1], A[i] (B[i] too for the second one)
+    assert body_waits == [2, 2]
+
+
+def _dynamic_pipeline():
+    n = T.dynamic("n")
+
+    @T.prim_func
+    def main(A: T.Tensor((n, 16), T.float32), C: T.Tensor((n, 16), T.float32)):
+        for tx in T.thread_binding(0, 16, thread="threadIdx.x"):
+            for i in T.serial(0, n, annotations={"software_pipeline_stage": [0, 2], "software_pipeline_order": [0, 1]}):
+                with T.block():
+                    T.reads(A[i, tx])
+                    T.writes(C[i, tx])
+                    B = T.alloc_buffer((16,), dtype=T.float32, scope="shared")
+                    with T.block():
+                        T.reads(A[i, tx])
+                        T.writes(B[tx])
+                        B[tx] = A[i, tx]
+                    with T.block():
+                        T.reads(B[tx])
+                        T.writes(C[i, tx])
+                        C[i, tx] = B[tx]
+
+    return main
+
+
+def _trip_count_dispatch(func, **config):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config=config):
+        mod = tl.transform.InjectSoftwarePipeline()(mod)
+    mod = tl.transform.Simplify()(mod)
+    branches = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.IfThenElse) and "n" in str(node.condition) and node.else_case is not None:
+            branches.append(node)
+
+    def count_serial_loops(stmt):
+        loops = []
+        tvm.tir.stmt_functor.post_order_visit(
+            stmt, lambda node: loops.append(node) if isinstance(node, tvm.tir.For) and node.kind == tvm.tir.ForKind.SERIAL else None
+        )
+        return len(loops)
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, visit)
+    return [(count_serial_loops(b.then_case), count_serial_loops(b.else_case)) for b in branches]
+
+
+def test_dynamic_trip_count_dispatch():
+    # The long path keeps the steady-state loop, the short one drops it
+    assert _trip_count_dispatch(_dynamic_pipeline()) == [(1, 0)]
+    disabled = {tl.PassConfigKey.TL_DISABLE_PIPELINE_TRIP_COUNT_DISPATCH: True}
+    assert _trip_count_dispatch(_dynamic_pipeline(), **disabled) == []
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
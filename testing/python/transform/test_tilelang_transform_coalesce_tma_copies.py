@@ -0,0 +1,84 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def _coalesce(func, arch="sm_90"):
+    target = tvm.target.Target(f"cuda -arch={arch}")
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main").with_attr("target", target))
+    return tl.transform.CoalesceTmaCopies()(mod)["main"]
+
+
+def _copy_extents(func):
+    """The extents of the source and destination of every copy of func"""
+    copies = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Call) and node.op.name == "tl.tileop.copy":
+            copies.append(tuple([int(e) for e in region.args[2:]] for region in node.args))
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, visit)
+    return copies
+
+
+def test_coalesce_head_slices():
+    @T.prim_func
+    def before(K: T.Tensor((2, 256, 8, 64), T.float16)):
+        with T.Kernel(8, 2) as (bx, by):
+            K_shared = T.alloc_shared((64, 4, 64), T.float16)
+            for h in T.serial(4):
+                T.copy(K[by, bx * 32 : bx * 32 + 64, h, :], K_shared[:, h, :])
+            for s in T.serial(2):
+                T.copy(K[by, s * 64 : s * 64 + 64, 0, :], K_shared[:, 0, :])
+                T.copy(K[by, s * 64 : s * 64 + 64, 1, :], K_shared[:, 1, :])
+                T.copy(K[by, s * 64 : s * 64 + 64, 2, :], K_shared[:, 2, :])
+
+    assert _copy_extents(_coalesce(before)) == [
+        ([1, 64, 1, 64], [64, 1, 64]),
+        ([1, 64, 3, 64], [64, 3, 64]),
+    ]
+    # Without TMA the copies stay as written
+    assert len(_copy_extents(_coalesce(before, arch="sm_80"))) == 4
+
+
+def test_coalesce_keeps_transposed_slices():
+    @T.prim_func
+    def before(K: T.Tensor((2, 256, 8, 64), T.float16)):
+        with T.Kernel(8, 2) as (bx, by):
+            K_shared = T.alloc_shared((2, 64, 64), T.float16)
+            # Merging the heads would interleave them in shared memory
+            T.copy(K[by, bx * 64 : bx * 64 + 64, 0, :], K_shared[0, :, :])
+            T.copy(K[by, bx * 64 : bx * 64 + 64, 1, :], K_shared[1, :, :])
+            # Neither the innermost dimension
+            T.copy(K[by, 0:64, 2, 0:32], K_shared[0, :, 0:32])
+            T.copy(K[by, 0:64, 2, 32:64], K_shared[0, :, 32:64])
+
+    assert len(_copy_extents(_coalesce(before))) == 4
+
+
+@tilelang.jit(out_idx=[-1])
+def gather_heads(S, H, D, block_S):
+    @T.prim_func
+    def main(K: T.Tensor((S, H, D), T.float16), O: T.Tensor((S, 2, D), T.float16)):
+        with T.Kernel(T.ceildiv(S, block_S), threads=128) as bx:
+            K_shared = T.alloc_shared((block_S, 2, D), T.float16)
+            T.copy(K[bx * block_S : bx * block_S + block_S, 0, :], K_shared[:, 0, :])
+            T.copy(K[bx * block_S : bx * block_S + block_S, 1, :], K_shared[:, 1, :])
+            T.copy(K_shared, O[bx * block_S, 0, 0])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(9, 0)
+def test_coalesced_tma_load():
+    kernel = gather_heads(256, 8, 64, 64)
+    assert kernel.get_kernel_source().count("tl::tma_load") == 1
+    K = torch.randn(256, 8, 64, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(K), K[:, :2])
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -2,6 +2,8 @@ import math
 
 import tilelang
 import tilelang.language as T
+import tilelang.testing
+import torch
 
 
 def blocksparse_flashattn(batch, heads, seq_len, dim, downsample_len, is_causal):
@@ -163,5 +165,49 @@ def test_sta_attention():
     assert "int64_t" in cuda_source
 
 
+def dynamic_copy(block_M=64, block_N=128, assume_rows=None):
+    M = T.dynamic("M")
+    N = T.dynamic("N")
+
+    @T.prim_func
+    def main(A: T.Tensor((M, N), T.float16), B: T.Tensor((M, N), T.float16)):
+        if assume_rows is not None:
+            T.assume(M <= assume_rows)
+            T.assume(N <= assume_rows)
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_N), T.float16)
+            T.copy(A[by * block_M, bx * block_N], A_shared)
+            T.copy(A_shared, B[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_dynamic_shape_index_dispatch():
+    # M * N is unbounded: a narrow kernel body runs when it fits in int32
+    kernel = tilelang.compile(dynamic_copy(), out_idx=[1])
+    source = kernel.get_kernel_source()
+    assert "int64_t" in source
+    assert "2147483647" in source
+    A = torch.randn(200, 300, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(A), A)
+
+
+@tilelang.testing.requires_cuda
+def test_assumed_bounds_keep_int32():
+    kernel = tilelang.compile(dynamic_copy(assume_rows=4096), out_idx=[1])
+    assert "int64_t" not in kernel.get_kernel_source()
+
+
+@tilelang.testing.requires_cuda
+def test_disable_index_dispatch():
+    kernel = tilelang.compile(
+        dynamic_copy(),
+        out_idx=[1],
+        pass_configs={tilelang.PassConfigKey.TL_DISABLE_INDEX_BITWIDTH_DISPATCH: True},
+    )
+    assert "2147483647" not in kernel.get_kernel_source()
+
+
 if __name__ == "__main__":
-    test_sta_attention()
+    tilelang.testing.main()
@@ -0,0 +1,98 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+
+
+def _defer(func, config=None):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config=config or {}):
+        return tl.transform.DeferWgmmaWait()(mod)["main"]
+
+
+def _calls(func):
+    """The waits and fences of func in program order, with the stores"""
+    calls = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Call):
+            name = str(node.op.name)
+            if name == "tl.warpgroup_wait":
+                calls.append(f"wait({node.args[0]})")
+            elif name == "tl.warpgroup_fence_operand":
+                calls.append(f"fence({node.args[1].name})")
+            elif name == "tl.warpgroup_commit_batch":
+                calls.append("commit")
+        elif isinstance(node, tvm.tir.BufferStore):
+            calls.append(f"store({node.buffer.name})")
+
+    tvm.tir.stmt_functor.pre_order_visit(func.body, lambda node: visit(node) or True)
+    return calls
+
+
+@T.macro
+def _gemm(C):
+    T.warpgroup_fence_operand(C, num_regs=8)
+    T.warpgroup_arrive()
+    T.warpgroup_commit_batch()
+    T.warpgroup_wait(0)
+    T.warpgroup_fence_operand(C, num_regs=8)
+
+
+def test_defer_wait_past_independent_work():
+    @T.prim_func
+    def before(A: T.Tensor((8,), T.float32)):
+        with T.Kernel(1, threads=128):
+            S = T.alloc_local((8,), T.float32)
+            O = T.alloc_local((8,), T.float32)
+            P = T.alloc_local((8,), T.float32)
+            for _ in T.serial(4):
+                _gemm(S)
+                P[0] = P[0] * 2.0
+                _gemm(O)
+                P[1] = S[1]
+            A[0] = O[0]
+
+    # The first gemm completes before its accumulator is read, with the
+    # second one still in flight, which completes after the loop
+    assert _calls(_defer(before)) == [
+        "fence(S)",
+        "commit",
+        "store(P)",
+        "fence(O)",
+        "commit",
+        "wait(1)",
+        "fence(S)",
+        "store(P)",
+        "wait(0)",
+        "fence(O)",
+        "store(A)",
+    ]
+
+
+def test_defer_wait_before_shared_store():
+    @T.prim_func
+    def before(A: T.Tensor((8,), T.float32)):
+        with T.Kernel(1, threads=128):
+            S = T.alloc_local((8,), T.float32)
+            P = T.alloc_local((8,), T.float32)
+            B_shared = T.alloc_shared((8,), T.float32)
+            for _ in T.serial(4):
+                _gemm(S)
+                P[0] = P[0] * 2.0
+                B_shared[0] = A[0]
+
+    assert _calls(_defer(before)) == [
+        "fence(S)",
+        "commit",
+        "store(P)",
+        "wait(0)",
+        "fence(S)",
+        "store(B_shared)",
+    ]
+    disabled = _defer(before, {tl.PassConfigKey.TL_DISABLE_WGMMA_WAIT_DEFERRAL: True})
+    assert _calls(disabled) == ["fence(S)", "commit", "wait(0)", "fence(S)", "store(P)", "store(B_shared)"]
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,58 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def private_scratch_kernel(N, block=128, width=8):
+    # Each thread stages its own row of S, which never leaves the thread.
+    @T.prim_func
+    def main(X: T.Tensor((N, width), T.float32), Y: T.Tensor((N, width), T.float32)):
+        with T.Kernel(N // block, threads=block) as bx:
+            tx = T.get_thread_binding()
+            S = T.alloc_shared((block, width), T.float32)
+            for j in T.serial(width):
+                S[tx, j] = X[bx * block + tx, j] * 2
+            for j in T.serial(width):
+                Y[bx * block + tx, j] = S[tx, j] + S[tx, width - 1 - j]
+
+    return main
+
+
+def exchanged_scratch_kernel(N, block=128, width=8):
+    # Each thread reads back the row another thread staged.
+    @T.prim_func
+    def main(X: T.Tensor((N, width), T.float32), Y: T.Tensor((N, width), T.float32)):
+        with T.Kernel(N // block, threads=block) as bx:
+            tx = T.get_thread_binding()
+            S = T.alloc_shared((block, width), T.float32)
+            for j in T.serial(width):
+                S[tx, j] = X[bx * block + tx, j] * 2
+            for j in T.serial(width):
+                Y[bx * block + tx, j] = S[block - 1 - tx, j]
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_demote_thread_private_shared():
+    N = 256
+    kernel = tilelang.compile(private_scratch_kernel(N), out_idx=[1])
+    assert "__shared__" not in kernel.get_kernel_source()
+    X = torch.randn(N, 8, device="cuda")
+    ref = X * 2 + (X * 2).flip(1)
+    torch.testing.assert_close(kernel(X), ref)
+
+
+@tilelang.testing.requires_cuda
+def test_keep_exchanged_shared():
+    N = 256
+    kernel = tilelang.compile(exchanged_scratch_kernel(N), out_idx=[1])
+    assert "__shared__" in kernel.get_kernel_source()
+    X = torch.randn(N, 8, device="cuda")
+    ref = (X * 2).view(-1, 128, 8).flip(1).reshape(N, 8)
+    torch.testing.assert_close(kernel(X), ref)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,150 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tvm import tir
+
+
+def _eliminate(func):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    return tl.transform.EliminateDeadFragmentStores()(mod)["main"]
+
+
+def _calls(stmt, name):
+    calls = []
+
+    def visit(node):
+        if isinstance(node, tir.Call) and isinstance(node.op, tvm.ir.Op) and node.op.name == name:
+            calls.append(node)
+
+    tir.stmt_functor.post_order_visit(stmt, visit)
+    return calls
+
+
+def _gemms(stmt):
+    return _calls(stmt, "tl.tileop.gemm_py") + _calls(stmt, "tl.tileop.gemm")
+
+
+def _allocated(func):
+    names = []
+
+    def visit(node):
+        if isinstance(node, tir.Block):
+            names.extend(buf.name for buf in node.alloc_buffers)
+
+    tir.stmt_functor.post_order_visit(func.body, visit)
+    return names
+
+
+def _loops(stmt):
+    loops = []
+    tir.stmt_functor.post_order_visit(stmt, lambda node: loops.append(node) if isinstance(node, tir.For) else None)
+    return loops
+
+
+def test_fold_clear_into_loop_gemm():
+    @T.prim_func
+    def before(A: T.Tensor((128, 256), T.float16), B: T.Tensor((256, 128), T.float16), C: T.Tensor((128, 128), T.float32)):
+        with T.Kernel(1, threads=128):
+            A_shared = T.alloc_shared((128, 64), T.float16)
+            B_shared = T.alloc_shared((64, 128), T.float16)
+            C_local = T.alloc_fragment((128, 128), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(4, num_stages=2):
+                T.copy(A[0, k * 64], A_shared)
+                T.copy(B[k * 64, 0], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C)
+
+    after = _eliminate(before)
+    assert not _calls(after.body, "tl.tileop.fill")
+    (gemm,) = _gemms(after.body)
+    assert isinstance(gemm.args[9], tir.EQ)
+
+
+def test_keep_clear_read_before_gemm():
+    @T.prim_func
+    def before(A: T.Tensor((128, 64), T.float16), B: T.Tensor((64, 128), T.float16), C: T.Tensor((128, 128), T.float32)):
+        with T.Kernel(1, threads=128):
+            A_shared = T.alloc_shared((128, 64), T.float16)
+            B_shared = T.alloc_shared((64, 128), T.float16)
+            C_local = T.alloc_fragment((128, 128), T.float32)
+            T.clear(C_local)
+            for i, j in T.Parallel(128, 128):
+                C_local[i, j] = C_local[i, j] + 1
+            T.copy(A, A_shared)
+            T.copy(B, B_shared)
+            T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C)
+
+    after = _eliminate(before)
+    assert len(_calls(after.body, "tl.tileop.fill")) == 1
+    (gemm,) = _gemms(after.body)
+    assert not gemm.args[9]
+
+
+def test_remove_dead_fragment():
+    @T.prim_func
+    def before(A: T.Tensor((128, 64), T.float16), B: T.Tensor((128, 64), T.float16)):
+        with T.Kernel(1, threads=128):
+            A_local = T.alloc_fragment((128, 64), T.float16)
+            scratch = T.alloc_fragment((128, 64), T.float32)
+            T.copy(A, A_local)
+            T.clear(scratch)
+            for i, j in T.Parallel(128, 64):
+                scratch[i, j] = scratch[i, j] + A_local[i, j]
+            T.copy(A_local, B)
+
+    after = _eliminate(before)
+    assert "scratch" in _allocated(before)
+    assert "scratch" not in _allocated(after)
+    assert len(_calls(after.body, "tl.tileop.copy")) == 2
+    assert not _calls(after.body, "tl.tileop.fill")
+    assert not any(isinstance(node, tir.For) for node in _loops(after.body))
+
+
+def test_dead_store_elimination_disabled():
+    @T.prim_func
+    def before(A: T.Tensor((128, 64), T.float16), B: T.Tensor((128, 64), T.float16)):
+        with T.Kernel(1, threads=128):
+            A_local = T.alloc_fragment((128, 64), T.float16)
+            scratch = T.alloc_fragment((128, 64), T.float32)
+            T.copy(A, A_local)
+            T.clear(scratch)
+            T.copy(A_local, B)
+
+    mod = tvm.IRModule.from_expr(before.with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config={tl.PassConfigKey.TL_DISABLE_DEAD_STORE_ELIMINATION: True}):
+        transformed = tl.transform.EliminateDeadFragmentStores()(mod)
+    tvm.ir.assert_structural_equal(transformed, mod)
+
+
+@tilelang.jit(out_idx=[-1])
+def cleared_matmul(M, N, K, block_M, block_N, block_K):
+    @T.prim_func
+    def main(A: T.Tensor((M, K), T.float16), B: T.Tensor((K, N), T.float16), C: T.Tensor((M, N), T.float32)):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), T.float16)
+            B_shared = T.alloc_shared((block_K, block_N), T.float16)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=2):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_folded_clear_correctness():
+    kernel = cleared_matmul(256, 256, 256, 128, 128, 32)
+    a = torch.randn(256, 256, device="cuda", dtype=torch.float16)
+    b = torch.randn(256, 256, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(a, b), a.float() @ b.float(), rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,143 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tvm import tir
+
+
+def _eliminate(func):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    return tl.transform.EliminateRedundantCopies()(mod)["main"]
+
+
+def _copies(stmt):
+    copies = []
+
+    def visit(node):
+        if isinstance(node, tir.Call) and node.op.name == "tl.tileop.copy":
+            copies.append(node)
+
+    tir.stmt_functor.post_order_visit(stmt, visit)
+    return copies
+
+
+def _loops(stmt):
+    loops = []
+    tir.stmt_functor.post_order_visit(stmt, lambda node: loops.append(node) if isinstance(node, tir.For) else None)
+    return loops
+
+
+def test_eliminate_repeated_copy():
+    @T.prim_func
+    def before(A: T.Tensor((128, 64), T.float16), B: T.Tensor((128, 64), T.float16)):
+        with T.Kernel(2, threads=128) as bx:
+            A_shared = T.alloc_shared((64, 64), T.float16)
+            T.copy(A[bx * 64 : bx * 64 + 64, :], A_shared)
+            T.copy(A_shared, B[bx * 64 : bx * 64 + 64, :])
+            T.copy(A[bx * 64 : bx * 64 + 64, :], A_shared)
+            T.copy(A_shared, B[bx * 64 : bx * 64 + 64, :])
+
+    assert len(_copies(_eliminate(before).body)) == 3
+
+
+def test_keep_copy_after_write():
+    @T.prim_func
+    def before(A: T.Tensor((128, 64), T.float16), B: T.Tensor((128, 64), T.float16)):
+        with T.Kernel(2, threads=128) as bx:
+            A_shared = T.alloc_shared((64, 64), T.float16)
+            T.copy(A[bx * 64 : bx * 64 + 64, :], A_shared)
+            for i, j in T.Parallel(64, 64):
+                A_shared[i, j] = A_shared[i, j] * 2
+            T.copy(A_shared, B[bx * 64 : bx * 64 + 64, :])
+            T.copy(A[bx * 64 : bx * 64 + 64, :], A_shared)
+            T.copy(A_shared, B[bx * 64 : bx * 64 + 64, :])
+
+    assert len(_copies(_eliminate(before).body)) == 4
+
+
+def test_hoist_loop_invariant_copy():
+    @T.prim_func
+    def before(
+        Q: T.Tensor((128, 64), T.float16),
+        K: T.Tensor((512, 64), T.float16),
+        S: T.Tensor((128, 64), T.float32),
+    ):
+        with T.Kernel(2, threads=128) as bx:
+            Q_shared = T.alloc_shared((64, 64), T.float16)
+            K_shared = T.alloc_shared((64, 64), T.float16)
+            S_local = T.alloc_fragment((64, 64), T.float32)
+            T.clear(S_local)
+            for k in T.Pipelined(8, num_stages=2):
+                T.copy(Q[bx * 64 : bx * 64 + 64, :], Q_shared)
+                T.copy(K[k * 64 : k * 64 + 64, :], K_shared)
+                T.gemm(Q_shared, K_shared, S_local, transpose_B=True)
+            T.copy(S_local, S[bx * 64 : bx * 64 + 64, :])
+
+    after = _eliminate(before)
+    assert len(_copies(after.body)) == 3
+    (loop,) = [loop for loop in _loops(after.body) if loop.loop_var.name == "k"]
+    (inner,) = _copies(loop.body)
+    assert inner.args[0].args[0].buffer.name == "K"
+
+
+def test_keep_copy_clobbered_in_loop():
+    @T.prim_func
+    def before(Q: T.Tensor((128, 64), T.float16), O: T.Tensor((128, 64), T.float16)):
+        with T.Kernel(2, threads=128) as bx:
+            Q_shared = T.alloc_shared((64, 64), T.float16)
+            for k in T.serial(4):
+                T.copy(Q[bx * 64 : bx * 64 + 64, :], Q_shared)
+                for i, j in T.Parallel(64, 64):
+                    Q_shared[i, j] = Q_shared[i, j] + k
+                T.copy(Q_shared, O[bx * 64 : bx * 64 + 64, :])
+
+    after = _eliminate(before)
+    (loop,) = [loop for loop in _loops(after.body) if loop.loop_var.name == "k"]
+    assert len(_copies(loop.body)) == 2
+
+
+def test_eliminate_disabled():
+    @T.prim_func
+    def before(A: T.Tensor((128, 64), T.float16), B: T.Tensor((128, 64), T.float16)):
+        with T.Kernel(2, threads=128) as bx:
+            A_shared = T.alloc_shared((64, 64), T.float16)
+            T.copy(A[bx * 64 : bx * 64 + 64, :], A_shared)
+            T.copy(A[bx * 64 : bx * 64 + 64, :], A_shared)
+            T.copy(A_shared, B[bx * 64 : bx * 64 + 64, :])
+
+    mod = tvm.IRModule.from_expr(before.with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config={tl.PassConfigKey.TL_DISABLE_COPY_ELIMINATION: True}):
+        transformed = tl.transform.EliminateRedundantCopies()(mod)
+    tvm.ir.assert_structural_equal(transformed, mod)
+
+
+@tilelang.jit(out_idx=[-1])
+def repeated_query(M, N, D, block):
+    @T.prim_func
+    def main(Q: T.Tensor((M, D), T.float16), K: T.Tensor((N, D), T.float16), S: T.Tensor((M, block), T.float32)):
+        with T.Kernel(T.ceildiv(M, block), threads=128) as bx:
+            Q_shared = T.alloc_shared((block, D), T.float16)
+            K_shared = T.alloc_shared((block, D), T.float16)
+            S_local = T.alloc_fragment((block, block), T.float32)
+            T.clear(S_local)
+            for k in T.Pipelined(T.ceildiv(N, block), num_stages=2):
+                T.copy(Q[bx * block, 0], Q_shared)
+                T.copy(K[k * block, 0], K_shared)
+                T.gemm(Q_shared, K_shared, S_local, transpose_B=True)
+            T.copy(S_local, S[bx * block, 0])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_hoisted_copy_correctness():
+    kernel = repeated_query(128, 256, 64, 64)
+    Q = torch.randn(128, 64, device="cuda", dtype=torch.float16)
+    K = torch.randn(256, 64, device="cuda", dtype=torch.float16)
+    ref = sum(Q.float() @ K[k * 64 : k * 64 + 64].float().T for k in range(4))
+    torch.testing.assert_close(kernel(Q, K), ref, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,60 @@
+# ruff: noqa
+
+from tilelang import tvm as tvm
+import tilelang
+import tilelang.testing
+from tvm.script import tir as T
+
+
+def _num_syncs(func):
+    mod = tvm.IRModule({"main": func})
+    mod = tilelang.transform.EliminateStorageSyncForMBarrier()(mod)
+    return str(mod).count("T.tvm_storage_sync")
+
+
+def test_eliminate_sync_between_disjoint_stages():
+    @T.prim_func(check_well_formed=False)
+    def func(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+        tx = T.launch_thread("threadIdx.x", 128)
+        S = T.alloc_buffer((256,), "float32", scope="shared")
+        S[tx] = A[tx]
+        # The stages filled on both sides are disjoint
+        T.tvm_storage_sync("shared")
+        S[tx + 128] = A[tx]
+        T.tvm_storage_sync("shared")
+        B[tx] = S[127 - tx] + S[255 - tx]
+
+    assert _num_syncs(func) == 1
+
+
+def test_eliminate_sync_between_reads():
+    @T.prim_func(check_well_formed=False)
+    def func(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+        tx = T.launch_thread("threadIdx.x", 128)
+        S = T.alloc_buffer((128,), "float32", scope="shared")
+        S[tx] = A[tx]
+        T.tvm_storage_sync("shared")
+        B[tx] = S[127 - tx]
+        T.tvm_storage_sync("shared")
+        B[tx] = B[tx] + S[tx]
+
+    assert _num_syncs(func) == 1
+
+
+def test_keep_sync_between_conflicts():
+    @T.prim_func(check_well_formed=False)
+    def func(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+        tx = T.launch_thread("threadIdx.x", 128)
+        S = T.alloc_buffer((128,), "float32", scope="shared")
+        for k in range(4):
+            S[tx] = A[tx] + T.Cast("float32", k)
+            T.tvm_storage_sync("shared")
+            B[tx] = B[tx] + S[127 - tx]
+            # The next iteration overwrites what this one read
+            T.tvm_storage_sync("shared")
+
+    assert _num_syncs(func) == 2
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,116 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tvm import tir
+
+
+def _fuse(func):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    return tl.transform.FuseSiblingParallelLoops()(mod)["main"]
+
+
+def _parallel_nests(func):
+    loops = []
+
+    def visit(node):
+        if isinstance(node, tir.For) and node.kind == tir.ForKind.PARALLEL and not isinstance(node.body, tir.For):
+            loops.append(node)
+
+    tir.stmt_functor.post_order_visit(func.body, visit)
+    return loops
+
+
+def _allocated(func):
+    names = []
+
+    def visit(node):
+        if isinstance(node, tir.Block):
+            names.extend(buf.name for buf in node.alloc_buffers)
+
+    tir.stmt_functor.post_order_visit(func.body, visit)
+    return names
+
+
+def scale_exp_cast(M, N, threads=128):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), T.float32), B: T.Tensor((M,), T.float32), C: T.Tensor((M, N), T.float16)):
+        with T.Kernel(1, threads=threads):
+            S = T.alloc_fragment((M, N), T.float32)
+            S_scaled = T.alloc_fragment((M, N), T.float32)
+            m = T.alloc_fragment((M,), T.float32)
+            P = T.alloc_fragment((M, N), T.float32)
+            P_cast = T.alloc_fragment((M, N), T.float16)
+            T.copy(A, S)
+            T.copy(B, m)
+            for i, j in T.Parallel(M, N):
+                S_scaled[i, j] = S[i, j] * 0.5
+            for i, j in T.Parallel(M, N):
+                P[i, j] = T.exp2(S_scaled[i, j] - m[i])
+            for i, j in T.Parallel(M, N):
+                P_cast[i, j] = P[i, j]
+            T.copy(P_cast, C)
+
+    return main
+
+
+def test_fuse_scale_exp_cast():
+    fused = _fuse(scale_exp_cast(64, 64))
+    assert len(_parallel_nests(fused)) == 1
+    allocated = _allocated(fused)
+    # The intermediates only live in the fused loop
+    assert "S_scaled" not in allocated and "P" not in allocated
+    assert "P_cast" in allocated and "S" in allocated
+
+
+def test_keep_loops_reading_other_elements():
+    @T.prim_func
+    def before(A: T.Tensor((64, 64), T.float32), B: T.Tensor((64, 64), T.float32)):
+        with T.Kernel(1, threads=128):
+            S = T.alloc_fragment((64, 64), T.float32)
+            E = T.alloc_fragment((64, 64), T.float32)
+            T.copy(A, S)
+            for i, j in T.Parallel(64, 64):
+                E[i, j] = T.exp(S[i, j])
+            for i, j in T.Parallel(64, 64):
+                S[i, j] = E[j, i]
+            T.copy(S, B)
+
+    assert len(_parallel_nests(_fuse(before))) == 2
+
+
+def test_keep_loops_of_other_shapes():
+    @T.prim_func
+    def before(A: T.Tensor((64, 64), T.float32), B: T.Tensor((64, 32), T.float32)):
+        with T.Kernel(1, threads=128):
+            S = T.alloc_fragment((64, 64), T.float32)
+            E = T.alloc_fragment((64, 32), T.float32)
+            T.copy(A, S)
+            for i, j in T.Parallel(64, 32):
+                E[i, j] = S[i, j]
+            for i, j in T.Parallel(64, 64):
+                S[i, j] = S[i, j] * 2.0
+            T.copy(E, B)
+
+    assert len(_parallel_nests(_fuse(before))) == 2
+
+
+def test_fusion_disabled():
+    mod = tvm.IRModule.from_expr(scale_exp_cast(64, 64).with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config={tl.PassConfigKey.TL_DISABLE_PARALLEL_LOOP_FUSION: True}):
+        transformed = tl.transform.FuseSiblingParallelLoops()(mod)
+    tvm.ir.assert_structural_equal(transformed, mod)
+
+
+@tilelang.testing.requires_cuda
+def test_fused_loops_correctness():
+    kernel = tl.compile(scale_exp_cast(64, 64), out_idx=[2])
+    a = torch.randn(64, 64, device="cuda")
+    b = torch.randn(64, device="cuda")
+    c = kernel(a, b)
+    torch.testing.assert_close(c, torch.exp2(a * 0.5 - b[:, None]).half(), rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,88 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tvm import tir
+
+
+def _fuse(func, target="cuda"):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main").with_attr("target", tvm.target.Target(target)))
+    return tl.transform.FuseSiblingReductions()(mod)["main"]
+
+
+def _reduces(func):
+    calls = []
+
+    def visit(node):
+        if isinstance(node, tir.Call) and isinstance(node.op, tvm.ir.Op) and node.op.name == "tl.tileop.reduce":
+            calls.append(node)
+
+    tir.stmt_functor.post_order_visit(func.body, visit)
+    return calls
+
+
+def max_and_sum(M, N, threads=128, dtype=T.float32):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), dtype), B: T.Tensor((M,), dtype), C: T.Tensor((M,), dtype)):
+        with T.Kernel(1, threads=threads):
+            A_local = T.alloc_fragment((M, N), dtype)
+            m_local = T.alloc_fragment((M,), dtype)
+            l_local = T.alloc_fragment((M,), dtype)
+            T.copy(A, A_local)
+            T.reduce_max(A_local, m_local, dim=1)
+            T.reduce_sum(A_local, l_local, dim=1)
+            T.copy(m_local, B)
+            T.copy(l_local, C)
+
+    return main
+
+
+def test_fuse_max_and_sum():
+    (fused,) = _reduces(_fuse(max_and_sum(64, 64)))
+    assert len(fused.args) == 8
+    assert fused.args[2].value == "max" and fused.args[6].value == "sum"
+    # The fused exchange only exists in the CUDA templates
+    assert len(_reduces(_fuse(max_and_sum(64, 64), target="hip"))) == 2
+
+
+def test_keep_reductions_of_other_sources():
+    @T.prim_func
+    def before(A: T.Tensor((64, 64), T.float32), B: T.Tensor((64,), T.float32)):
+        with T.Kernel(1, threads=128):
+            A_local = T.alloc_fragment((64, 64), T.float32)
+            E_local = T.alloc_fragment((64, 64), T.float32)
+            m_local = T.alloc_fragment((64,), T.float32)
+            l_local = T.alloc_fragment((64,), T.float32)
+            T.copy(A, A_local)
+            T.reduce_max(A_local, m_local, dim=1)
+            for i, j in T.Parallel(64, 64):
+                E_local[i, j] = T.exp(A_local[i, j] - m_local[i])
+            T.reduce_sum(E_local, l_local, dim=1)
+            T.reduce_sum(A_local, m_local, dim=0)
+            T.copy(l_local, B)
+
+    assert len(_reduces(_fuse(before))) == 3
+
+
+def test_fusion_disabled():
+    mod = tvm.IRModule.from_expr(max_and_sum(64, 64).with_attr("global_symbol", "main").with_attr("target", tvm.target.Target("cuda")))
+    with tvm.transform.PassContext(config={tl.PassConfigKey.TL_DISABLE_REDUCE_FUSION: True}):
+        transformed = tl.transform.FuseSiblingReductions()(mod)
+    tvm.ir.assert_structural_equal(transformed, mod)
+
+
+@tilelang.testing.requires_cuda
+def test_fused_reduction_correctness():
+    # 32 threads per row reduce within a warp, 256 across warps
+    for M, N, threads in [(64, 64, 128), (4, 512, 256)]:
+        kernel = tl.compile(max_and_sum(M, N, threads), out_idx=[1, 2])
+        assert "_fused" in kernel.get_kernel_source()
+        a = torch.randn(M, N, device="cuda")
+        m, l = kernel(a)
+        torch.testing.assert_close(m, a.max(dim=1).values)
+        torch.testing.assert_close(l, a.sum(dim=1), rtol=1e-4, atol=1e-4)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,80 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+from tvm import tir
+
+
+def scale(N, block_N, threads, factor):
+    @T.prim_func
+    def main(A: T.Tensor((N,), T.float32), B: T.Tensor((N,), T.float32)):
+        with T.Kernel(T.ceildiv(N, block_N), threads=threads) as bx:
+            A_shared = T.alloc_shared((block_N,), T.float32)
+            T.copy(A[bx * block_N], A_shared)
+            for i in T.Parallel(block_N):
+                B[bx * block_N + i] = A_shared[i] * factor
+
+    return main
+
+
+def add_rows(M, N, block_M, threads):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), T.float32), B: T.Tensor((M, N), T.float32), C: T.Tensor((M, N), T.float32)):
+        with T.Kernel(T.ceildiv(N, 32), T.ceildiv(M, block_M), threads=threads) as (bx, by):
+            for i, j in T.Parallel(block_M, 32):
+                C[by * block_M + i, bx * 32 + j] = A[by * block_M + i, bx * 32 + j] + B[by * block_M + i, bx * 32 + j]
+
+    return main
+
+
+def _launch(func):
+    extents = {}
+
+    def visit(node):
+        if isinstance(node, tir.AttrStmt) and node.attr_key == "thread_extent":
+            extents[node.node.thread_tag] = node.value
+
+    tir.stmt_functor.post_order_visit(func.body, visit)
+    return extents
+
+
+def test_fuse_kernels_launch():
+    fused = tl.transform.fuse_kernels([scale(1024, 128, 128, 2.0), add_rows(256, 64, 16, 256)], name="decode_step")
+    assert fused.attrs["global_symbol"] == "decode_step"
+    assert len(fused.params) == 5
+    launch = _launch(fused)
+    # 8 blocks of the first kernel, then 2 x 16 of the second
+    assert int(launch["blockIdx.x"]) == 8 + 32
+    assert int(launch["threadIdx.x"]) == 256
+    assert "blockIdx.y" not in launch
+
+
+def test_fuse_kernel_with_itself():
+    func = scale(1024, 128, 128, 2.0)
+    fused = tl.transform.fuse_kernels([func, func])
+    assert len(fused.params) == 4
+    assert not any(p.same_as(q) for p in fused.params[:2] for q in fused.params[2:])
+
+
+@tilelang.testing.requires_cuda
+def test_fused_kernels_correctness():
+    import torch
+
+    fused = tl.transform.fuse_kernels([scale(1024, 128, 128, 2.0), add_rows(256, 64, 16, 256), scale(512, 64, 64, -1.0)])
+    kernel = tl.compile(fused)
+    assert kernel.get_kernel_source().count("__global__") == 1
+    a = torch.randn(1024, device="cuda")
+    b = torch.empty_like(a)
+    x = torch.randn(256, 64, device="cuda")
+    y = torch.randn(256, 64, device="cuda")
+    z = torch.empty_like(x)
+    c = torch.randn(512, device="cuda")
+    d = torch.empty_like(c)
+    kernel(a, b, x, y, z, c, d)
+    torch.testing.assert_close(b, a * 2.0)
+    torch.testing.assert_close(z, x + y)
+    torch.testing.assert_close(d, -c)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
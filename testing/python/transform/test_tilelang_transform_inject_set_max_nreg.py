@@ -134,6 +134,50 @@ def test_inject_set_max_nreg_no_set_max_nreg():
     print("InjectSetMaxNReg with no_set_max_nreg test passed!")
 
 
+def _auto_set_max_nreg(consumer_threads, occupancy=1):
+    @T.prim_func
+    def before(A: T.Tensor((512, 512), T.float16)):
+        bx = T.launch_thread("blockIdx.x", 8)
+        v = T.launch_thread("threadIdx.x", 128 + consumer_threads)
+
+        with T.block(""):
+            T.reads(A[bx * 64, 0:64])
+            T.writes()
+            C_local = T.alloc_buffer((64,), scope="local")
+
+            T.create_list_of_mbarrier(128, 128)
+            T.attr([128, consumer_threads], "kWarpSpecializationScope", 0)
+
+            if v >= consumer_threads:
+                T.evaluate(0)
+            else:
+                C_local[0] = T.float32(0)
+
+    mod = tvm.IRModule.from_expr(before.with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config={tl.PassConfigKey.TL_WARP_SPECIALIZED_OCCUPANCY: occupancy}):
+        mod = tl.transform.AnnotateWarpGroupRegAlloc()(mod)
+
+    hints = {}
+
+    def collect_set_max_nreg(stmt):
+        if isinstance(stmt, tvm.tir.Evaluate) and isinstance(stmt.value, tvm.tir.Call) and stmt.value.op.name == "tl.set_max_nreg":
+            hints[int(stmt.value.args[1])] = int(stmt.value.args[0])
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, collect_set_max_nreg)
+    return hints
+
+
+def test_auto_set_max_nreg_fits_register_file():
+    # One producer and one consumer warp group keep the usual split.
+    assert _auto_set_max_nreg(128) == {0: 24, 1: 240}
+    # Three consumer warp groups cannot all hold 240 registers.
+    assert _auto_set_max_nreg(384) == {0: 24, 1: 160}
+    # Two CTAs per SM halve the budget of each.
+    assert _auto_set_max_nreg(128, occupancy=2) == {0: 24, 1: 232}
+    # At 8 CTAs per SM even the producer minimum exceeds the even share.
+    assert _auto_set_max_nreg(384, occupancy=8) == {}
+
+
 if __name__ == "__main__":
     # tilelang.testing.main()
     test_inject_set_max_nreg()
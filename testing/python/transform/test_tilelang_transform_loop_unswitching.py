@@ -0,0 +1,68 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tvm import tir
+
+
+def ragged_copy(N: int = 1000, block: int = 128, threads: int = 32):
+    dtype = T.float32
+
+    @T.prim_func
+    def main(A: T.Tensor((N,), dtype), B: T.Tensor((N,), dtype)):
+        with T.Kernel(T.ceildiv(N, block), threads=threads) as bx:
+            tx = T.get_thread_binding()
+            for i in T.serial(block // threads):
+                B[bx * block + tx * (block // threads) + i] = A[bx * block + tx * (block // threads) + i] + 1.0
+
+    return main
+
+
+def _collect(stmt, node_type):
+    nodes = []
+    tir.stmt_functor.post_order_visit(stmt, lambda node: nodes.append(node) if isinstance(node, node_type) else None)
+    return nodes
+
+
+def _predicates(stmt):
+    calls = [c for c in _collect(stmt, tir.Call) if c.op.same_as(tvm.ir.Op.get("tir.if_then_else"))]
+    return len(_collect(stmt, tir.IfThenElse)) + len(calls)
+
+
+def test_unswitch_boundary_checks():
+    mod = tvm.IRModule({"main": ragged_copy()})
+    mod = tl.transform.LegalizeSafeMemoryAccess()(mod)
+    transformed = tl.transform.LoopUnswitching()(mod)
+    unswitched = [s for s in _collect(transformed["main"].body, tir.IfThenElse) if s.else_case is not None]
+    assert len(unswitched) == 1
+    interior = unswitched[0]
+    # the hoisted condition does not depend on the thread index
+    threads = [
+        attr.node.var
+        for attr in _collect(transformed["main"].body, tir.AttrStmt)
+        if attr.attr_key == "thread_extent" and attr.node.thread_tag.startswith("threadIdx")
+    ]
+    assert threads
+    assert not any(var.same_as(t) for var in _collect(interior.condition, tir.Var) for t in threads)
+    assert _predicates(interior.then_case) == 0
+    assert _predicates(interior.else_case) > 0
+
+
+def test_unswitch_disabled():
+    mod = tvm.IRModule({"main": ragged_copy()})
+    mod = tl.transform.LegalizeSafeMemoryAccess()(mod)
+    with tvm.transform.PassContext(config={tl.PassConfigKey.TL_DISABLE_LOOP_UNSWITCHING: True}):
+        transformed = tl.transform.LoopUnswitching()(mod)
+    tvm.ir.assert_structural_equal(transformed, mod)
+
+
+@tilelang.testing.requires_cuda
+def test_unswitch_ragged_correctness():
+    kernel = tl.compile(ragged_copy(N=1000), out_idx=[1])
+    a = torch.randn(1000, device="cuda")
+    torch.testing.assert_close(kernel(a), a + 1.0)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,53 @@
+from tilelang import tvm as tvm
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+
+
+def _matmul(M, N, K, block_M=64, block_N=64, annotate=False):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), T.float16),
+        B: T.Tensor((K, N), T.float16),
+        C: T.Tensor((M, N), T.float32),
+    ):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=128) as (bx, by):
+            if annotate:
+                T.annotate_l2_hit_ratio({B: 0.5})
+            for i, j in T.Parallel(block_M, block_N):
+                for k in T.serial(K):
+                    C[by * block_M + i, bx * block_N + j] += A[by * block_M + i, k] * B[k, bx * block_N + j]
+
+    return tvm.IRModule({"main": main})
+
+
+def _l2_persistent_map(mod, auto):
+    with tvm.transform.PassContext(config={tilelang.PassConfigKey.TL_ENABLE_AUTO_L2_PERSISTENT: auto}):
+        mod = tilelang.transform.LowerL2Persistent()(mod)
+    return mod["main"].attrs.get("l2_persistent_map", None) if mod["main"].attrs else None
+
+
+def test_auto_l2_persistent_picks_most_reused_operand():
+    # A is read by the 64 CTAs of a row, B by the 4 CTAs of a column.
+    l2_map = _l2_persistent_map(_matmul(256, 4096, 512), auto=True)
+    assert l2_map is not None and list(l2_map.keys()) == ["A"]
+    hit_ratio, size_in_bytes = l2_map["A"]
+    assert float(hit_ratio.value) == 1.0
+    assert int(size_in_bytes) == 256 * 512 * 2
+
+    l2_map = _l2_persistent_map(_matmul(4096, 256, 512), auto=True)
+    assert list(l2_map.keys()) == ["B"]
+
+
+def test_auto_l2_persistent_disabled_by_default():
+    assert _l2_persistent_map(_matmul(256, 4096, 512), auto=False) is None
+
+
+def test_auto_l2_persistent_keeps_manual_annotation():
+    l2_map = _l2_persistent_map(_matmul(256, 4096, 512, annotate=True), auto=True)
+    assert list(l2_map.keys()) == ["B"]
+    assert abs(float(l2_map["B"][0].value) - 0.5) < 1e-6
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
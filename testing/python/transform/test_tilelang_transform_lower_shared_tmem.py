@@ -0,0 +1,137 @@
+import re
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+
+PASS_CONFIGS = {
+    tilelang.PassConfigKey.TL_DISABLE_TMA_LOWER: True,
+    tilelang.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True,
+}
+
+
+def _lower(func):
+    with tilelang.transform.PassContext(config=PASS_CONFIGS):
+        return tilelang.lower(func, target="cuda -arch=sm_100a").kernel_source
+
+
+def _allocations(source):
+    return [int(cols) for cols in re.findall(r"tl::tmem_allocate\([^;]*?,\s*(\d+)\)", source)]
+
+
+def _packed_accumulators(M, N, K, block_M=128, block_K=64, widths=(192, 192, 128)):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), T.bfloat16),
+        B: T.Tensor((N, K), T.bfloat16),
+        C: T.Tensor((M, N), T.float32),
+    ):
+        with T.Kernel(M // block_M, threads=128) as bx:
+            A_shared = T.alloc_shared((block_M, block_K), T.bfloat16)
+            B0_shared = T.alloc_shared((widths[0], block_K), T.bfloat16)
+            B1_shared = T.alloc_shared((widths[1], block_K), T.bfloat16)
+            B2_shared = T.alloc_shared((widths[2], block_K), T.bfloat16)
+            C0_tmem = T.alloc_tmem([block_M, widths[0]], T.float32)
+            C1_tmem = T.alloc_tmem([block_M, widths[1]], T.float32)
+            C2_tmem = T.alloc_tmem([block_M, widths[2]], T.float32)
+            mbar = T.alloc_barrier(1)
+            for k in T.serial(K // block_K):
+                T.copy(A[bx * block_M, k * block_K], A_shared)
+                T.copy(B[0, k * block_K], B0_shared)
+                T.copy(B[widths[0], k * block_K], B1_shared)
+                T.copy(B[widths[0] + widths[1], k * block_K], B2_shared)
+                T.gemm(A_shared, B0_shared, C0_tmem, transpose_B=True, mbar=mbar, wg_wait=-1, clear_accum=k == 0)
+                T.gemm(A_shared, B1_shared, C1_tmem, transpose_B=True, mbar=mbar, wg_wait=-1, clear_accum=k == 0)
+                T.gemm(A_shared, B2_shared, C2_tmem, transpose_B=True, mbar=mbar, wg_wait=-1, clear_accum=k == 0)
+                T.mbarrier_wait_parity(mbar, k % 2)
+            C0_local = T.alloc_fragment((block_M, widths[0]), T.float32)
+            T.copy(C0_tmem, C0_local)
+            T.copy(C0_local, C[bx * block_M, 0])
+
+    return main
+
+
+def _consecutive_phases(M, N, K, block_M=128, block_N=256, block_K=64):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), T.bfloat16),
+        B: T.Tensor((N, K), T.bfloat16),
+        C: T.Tensor((M, N), T.float32),
+    ):
+        with T.Kernel(M // block_M, threads=128) as bx:
+            A_shared = T.alloc_shared((block_M, block_K), T.bfloat16)
+            B_shared = T.alloc_shared((block_N, block_K), T.bfloat16)
+            C0_tmem = T.alloc_tmem([block_M, block_N], T.float32)
+            C1_tmem = T.alloc_tmem([block_M, block_N], T.float32)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            mbar = T.alloc_barrier(1)
+            for k in T.serial(K // block_K):
+                T.copy(A[bx * block_M, k * block_K], A_shared)
+                T.copy(B[0, k * block_K], B_shared)
+                T.gemm(A_shared, B_shared, C0_tmem, transpose_B=True, mbar=mbar, wg_wait=-1, clear_accum=k == 0)
+                T.mbarrier_wait_parity(mbar, k % 2)
+            T.copy(C0_tmem, C_local)
+            T.copy(C_local, C[bx * block_M, 0])
+            for k in T.serial(K // block_K):
+                T.copy(A[bx * block_M, k * block_K], A_shared)
+                T.copy(B[block_N, k * block_K], B_shared)
+                T.gemm(A_shared, B_shared, C1_tmem, transpose_B=True, mbar=mbar, wg_wait=-1, clear_accum=k == 0)
+                T.mbarrier_wait_parity(mbar, (K // block_K + k) % 2)
+            T.copy(C1_tmem, C_local)
+            T.copy(C_local, C[bx * block_M, block_N])
+
+    return main
+
+
+def _drained(M, N, K, block_M=128, block_N=128, block_K=64, threads=128):
+    @T.prim_func
+    def main(
+        A: T.Tensor((M, K), T.bfloat16),
+        B: T.Tensor((N, K), T.bfloat16),
+        C: T.Tensor((M, N), T.bfloat16),
+    ):
+        with T.Kernel(M // block_M, threads=threads) as bx:
+            A_shared = T.alloc_shared((block_M, block_K), T.bfloat16)
+            B_shared = T.alloc_shared((block_N, block_K), T.bfloat16)
+            C_tmem = T.alloc_tmem([block_M, block_N], T.float32)
+            C_shared = T.alloc_shared((block_M, block_N), T.bfloat16)
+            mbar = T.alloc_barrier(1)
+            for k in T.serial(K // block_K):
+                T.copy(A[bx * block_M, k * block_K], A_shared)
+                T.copy(B[0, k * block_K], B_shared)
+                T.gemm(A_shared, B_shared, C_tmem, transpose_B=True, mbar=mbar, wg_wait=-1, clear_accum=k == 0)
+                T.mbarrier_wait_parity(mbar, k % 2)
+            T.copy(C_tmem, C_shared)
+            T.copy(C_shared, C[bx * block_M, 0])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_tmem_accumulators_share_one_allocation():
+    # 192 + 192 + 128 columns fit, rounding each buffer up to a power of two would not
+    source = _lower(_packed_accumulators(256, 512, 256))
+    assert _allocations(source) == [512]
+    assert "tcgen05_before_thread_sync" not in source
+
+
+@tilelang.testing.requires_cuda
+def test_tmem_reused_across_phases():
+    source = _lower(_consecutive_phases(256, 512, 256))
+    assert _allocations(source) == [256]
+    assert "tl::tcgen05_before_thread_sync" in source
+
+
+@tilelang.testing.requires_cuda
+def test_tmem_drain_to_shared():
+    # 128 columns per thread, x32 chunks: every load but the first is issued after the previous wait
+    source = _lower(_drained(256, 128, 256))
+    assert source.count("tl::tcgen05_ld_32dp32bNx<32, false, false>") == 4
+    assert source.count("tl::fence_view_async_tmem_load()") == 4
+    # Two warpgroups split the columns
+    source = _lower(_drained(256, 128, 256, threads=256))
+    assert source.count("tl::tcgen05_ld_32dp32bNx<32, false, false>") == 2
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -158,6 +158,43 @@ def test_subroutine_call_to_externally_visible_subroutine():
     )
 
 
+def _calls(func, op_name):
+    calls = []
+
+    def _visitor(node):
+        if isinstance(node, tir.Call) and isinstance(node.op, tvm.ir.Op) and node.op.name == op_name:
+            calls.append(node)
+
+    tir.stmt_functor.post_order_visit(func.body, _visitor)
+    return calls
+
+
+def test_host_signature_cache():
+    """The value checks only run when the signature of the arguments changes"""
+
+    n = tir.Var("n", "int32")
+
+    @I.ir_module
+    class before:
+        @T.prim_func
+        def main(a: T.handle, b: T.handle):
+            T.func_attr({"global_symbol": "main", "target": T.target("cuda", host="llvm")})
+            A = T.match_buffer(a, (n, 16), "float16")
+            B = T.match_buffer(b, (n, 16), "float16")
+            T.evaluate(0)
+
+    def lower(enable):
+        with tvm.transform.PassContext(config={tilelang.PassConfigKey.TL_ENABLE_HOST_SIGNATURE_CACHE: enable}):
+            return tilelang.transform.MakePackedAPI()(before)["main"]
+
+    plain, cached = lower(False), lower(True)
+    # One slot holding the signature of the last call that passed the checks
+    assert not _calls(plain, "tir.tvm_static_handle")
+    assert len(_calls(cached, "tir.tvm_static_handle")) == 1
+    # The same checks are emitted, guarded by the signature compare
+    assert len(_calls(cached, "tir.tvm_call_packed")) == len(_calls(plain, "tir.tvm_call_packed"))
+
+
 @tilelang.testing.requires_llvm
 def test_function_call_with_wrong_argument_count():
     """Argument counts must be checked before accessing the type codes"""
@@ -0,0 +1,74 @@
+import pytest
+
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+from tvm import tir
+
+
+def axpy(N, block_N, alpha):
+    @T.prim_func
+    def main(X: T.Tensor((N,), T.float32), Y: T.Tensor((N,), T.float32)):
+        with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+            for i in T.Parallel(block_N):
+                Y[bx * block_N + i] = X[bx * block_N + i] * alpha + 1.0
+
+    return main
+
+
+def reverse_sum(N, block_N):
+    @T.prim_func
+    def main(X: T.Tensor((N,), T.float32), Y: T.Tensor((N,), T.float32)):
+        with T.Kernel(T.ceildiv(N, block_N), threads=block_N) as bx:
+            # Reads the blocks of other producers, so it waits for all of them
+            for i in T.Parallel(block_N):
+                Y[bx * block_N + i] = X[N - 1 - bx * block_N - i]
+
+    return main
+
+
+def _while_loops(func):
+    loops = []
+    tir.stmt_functor.post_order_visit(func.body, lambda node: loops.append(node) if isinstance(node, tir.While) else None)
+    return loops
+
+
+def test_task_graph_structure():
+    funcs = [axpy(1024, 128, 2.0), axpy(1024, 128, 3.0), reverse_sum(1024, 256)]
+    fused = tl.transform.fuse_task_graph(funcs, deps={1: [(0, "tile")], 2: [1]}, num_workers=4)
+    assert len(fused.params) == 7
+    workspace = fused.buffer_map[fused.params[-1]]
+    assert int(workspace.shape[0]) == tl.transform.task_graph_workspace_size(funcs) == 1 + 3 + 8 + 8 + 4
+    # One flag wait for the tile dependency, one counter wait for the other
+    assert len(_while_loops(fused)) == 2
+
+
+def test_task_graph_rejects_backward_edges():
+    with pytest.raises(ValueError):
+        tl.transform.fuse_task_graph([axpy(256, 128, 1.0), axpy(256, 128, 1.0)], deps={0: [1]}, num_workers=1)
+    with pytest.raises(ValueError):
+        tl.transform.fuse_task_graph([axpy(256, 128, 1.0), reverse_sum(256, 64)], deps={1: [(0, "tile")]}, num_workers=1)
+
+
+@tilelang.testing.requires_cuda
+def test_task_graph_correctness():
+    import torch
+
+    N = 1 << 16
+    funcs = [axpy(N, 128, 2.0), axpy(N, 128, 3.0), reverse_sum(N, 256)]
+    fused = tl.transform.fuse_task_graph(funcs, deps={1: [(0, "tile")], 2: [1]})
+    kernel = tl.compile(fused, pass_configs={tl.PassConfigKey.TL_DISABLE_WARP_SPECIALIZED: True})
+    x = torch.randn(N, device="cuda")
+    y = torch.empty_like(x)
+    z = torch.empty_like(x)
+    w = torch.empty_like(x)
+    workspace = torch.zeros(tl.transform.task_graph_workspace_size(funcs), dtype=torch.int32, device="cuda")
+    for _ in range(3):
+        workspace.zero_()
+        kernel(x, y, y, z, z, w, workspace)
+        torch.testing.assert_close(w, ((x * 2 + 1) * 3 + 1).flip(0))
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
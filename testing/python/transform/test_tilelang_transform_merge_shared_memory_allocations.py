@@ -0,0 +1,64 @@
+import re
+
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def staged_kernel(N, block=128):
+    # Five phases whose shared buffers of various sizes come and go, which the
+    # linear scan packs in program order.
+    @T.prim_func
+    def main(X: T.Tensor((N, block), T.float32), Y: T.Tensor((N, block), T.float32)):
+        with T.Kernel(N // block, threads=128) as bx:
+            A = T.alloc_shared((block, block // 4), T.float32)
+            B = T.alloc_shared((block, block // 2), T.float32)
+            C = T.alloc_shared((block, block // 4), T.float32)
+            D = T.alloc_shared((block, block), T.float32)
+            E = T.alloc_shared((block, block // 2), T.float32)
+            T.copy(X[bx * block, 0], A)
+            T.copy(X[bx * block, block // 4], B)
+            for i, j in T.Parallel(block, block // 4):
+                C[i, j] = A[i, j] + B[i, j * 2]
+            for i, j in T.Parallel(block, block):
+                D[i, j] = C[i, j % (block // 4)] * 2
+            for i, j in T.Parallel(block, block // 2):
+                E[i, j] = D[i, j] + D[i, j + block // 2] - B[i, j]
+            T.copy(E, Y[bx * block, 0])
+            T.copy(D[0:block, 0 : block // 2], Y[bx * block, block // 2])
+
+    return main
+
+
+def ref_staged(X, block=128):
+    A = X[:, : block // 4]
+    B = X[:, block // 4 : block // 4 + block // 2]
+    C = A + B[:, ::2]
+    D = (C * 2).repeat(1, 4)
+    E = D[:, : block // 2] + D[:, block // 2 :] - B
+    return torch.cat([E, D[:, : block // 2]], dim=1)
+
+
+def _report(text):
+    match = re.search(r"into (\d+) bytes, lower bound (\d+) bytes, linear scan (\d+) bytes", text)
+    assert match is not None, text
+    return [int(x) for x in match.groups()]
+
+
+@tilelang.testing.requires_cuda
+def test_optimal_shared_memory_packing(capfd):
+    N = 256
+    kernel = tilelang.compile(
+        staged_kernel(N),
+        out_idx=[1],
+        pass_configs={tilelang.PassConfigKey.TL_ENABLE_OPTIMAL_SHARED_MEMORY_PACKING: True},
+    )
+    packed, lower_bound, linear_scan = _report(capfd.readouterr().err)
+    assert lower_bound <= packed <= linear_scan
+    X = torch.randn(N, 128, device="cuda")
+    torch.testing.assert_close(kernel(X), ref_staged(X))
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
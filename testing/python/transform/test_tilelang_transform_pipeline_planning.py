@@ -62,5 +62,42 @@ def test_simple_pipeline():
     _check(before, after)
 
 
+def _auto_stages(block_M, block_N, block_K, target):
+    @T.prim_func
+    def main(A: T.Tensor((1024, 1024), T.float16), B: T.Tensor((1024, 1024), T.float16), C: T.Tensor((1024, 1024), T.float32)):
+        with T.Kernel(T.ceildiv(1024, block_N), T.ceildiv(1024, block_M), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block_M, block_K), T.float16)
+            B_shared = T.alloc_shared((block_K, block_N), T.float16)
+            C_local = T.alloc_fragment((block_M, block_N), T.float32)
+            T.clear(C_local)
+            for ko in T.Pipelined(T.ceildiv(1024, block_K), num_stages="auto"):
+                T.copy(A[by * block_M, ko * block_K], A_shared)
+                T.copy(B[ko * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    mod = tvm.IRModule.from_expr(main.with_attr("global_symbol", "main"))
+    mod = tvm.tir.transform.BindTarget(tvm.target.Target(target))(mod)
+    mod = tl.transform.PipelineStageSelection()(mod)
+    stages = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.For) and "num_stages" in node.annotations:
+            stages.append(int(node.annotations["num_stages"]))
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, visit)
+    assert len(stages) == 1
+    return stages[0]
+
+
+def test_auto_num_stages():
+    # 16 KiB per stage fits the deepest pipeline on sm_80.
+    assert _auto_stages(128, 128, 32, "cuda -arch=sm_80") == 4
+    # 64 KiB per stage leaves room for two stages only.
+    assert _auto_stages(256, 256, 64, "cuda -arch=sm_80") == 2
+    # Without asynchronous copies only double buffering is selected.
+    assert _auto_stages(128, 128, 32, "cuda -arch=sm_75") == 2
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
@@ -0,0 +1,58 @@
+from tilelang import tvm as tvm
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+
+
+def _pipelined_tma_load():
+    @T.prim_func
+    def main(A: T.Tensor((8, 64), T.float16), C: T.Tensor((8, 64), T.float16)):
+        for tx in T.thread_binding(0, 64, thread="threadIdx.x"):
+            for k in T.serial(0, 8, annotations={"software_pipeline_stage": [0, 1], "software_pipeline_order": [0, 1]}):
+                with T.block():
+                    B = T.alloc_buffer((64,), dtype=T.float16, scope="shared")
+                    with T.block():
+                        T.evaluate(
+                            T.tma_load(
+                                T.create_tma_descriptor(A.data),
+                                T.get_mbarrier(0),
+                                T.tvm_access_ptr(T.type_annotation(T.float16), B.data, 0, 64, 2),
+                                0,
+                                k,
+                                0,
+                            )
+                        )
+                    with T.block():
+                        C[k, tx] = B[tx]
+
+    return main
+
+
+def _prefetch_coords(func, distance):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config={tilelang.PassConfigKey.TL_PIPELINE_PREFETCH_DISTANCE: distance}):
+        mod = tilelang.transform.InjectSoftwarePipeline()(mod)
+    mod = tilelang.transform.Simplify()(mod)
+    coords = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Call) and node.op.same_as(tvm.ir.Op.get("tl.tma_prefetch")):
+            coords.append(node.args[2])
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, visit)
+    return coords
+
+
+def test_pipeline_prefetch_tma_load():
+    coords = _prefetch_coords(_pipelined_tma_load(), distance=2)
+    # The prologue load of k = 0 prefetches the tile of k = 2.
+    assert any(isinstance(c, tvm.tir.IntImm) and c.value == 2 for c in coords)
+    assert any(not isinstance(c, tvm.tir.IntImm) for c in coords)
+
+
+def test_pipeline_prefetch_disabled_by_default():
+    assert _prefetch_coords(_pipelined_tma_load(), distance=0) == []
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
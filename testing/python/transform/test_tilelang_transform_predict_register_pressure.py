@@ -0,0 +1,42 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+
+
+def row_scale_kernel(M, N, block_M, threads=128):
+    @T.prim_func
+    def main(X: T.Tensor((M, N), T.float32), Y: T.Tensor((M, N), T.float32)):
+        with T.Kernel(M // block_M, threads=threads) as bx:
+            X_local = T.alloc_fragment((block_M, N), T.float32)
+            T.copy(X[bx * block_M, 0], X_local)
+            for i, j in T.Parallel(block_M, N):
+                X_local[i, j] = X_local[i, j] * 2
+            T.copy(X_local, Y[bx * block_M, 0])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_register_pressure_within_budget(capfd):
+    # 16 floats per thread
+    tilelang.lower(row_scale_kernel(1024, 64, 32), target="cuda")
+    assert "exceed the budget" not in capfd.readouterr().err
+
+
+@tilelang.testing.requires_cuda
+def test_register_pressure_exceeds_budget(capfd):
+    # 512 floats per thread, at least twice what a thread can hold
+    tilelang.lower(row_scale_kernel(1024, 512, 128), target="cuda")
+    err = capfd.readouterr().err
+    assert "exceed the budget of 255" in err
+
+
+@tilelang.testing.requires_cuda
+def test_register_budget_config(capfd):
+    with tilelang.transform.PassContext(config={tilelang.PassConfigKey.TL_REGISTER_BUDGET: 8}):
+        tilelang.lower(row_scale_kernel(1024, 64, 32), target="cuda")
+    assert "exceed the budget of 8" in capfd.readouterr().err
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,65 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+
+
+def _check(original, transformed):
+    mod = tvm.IRModule.from_expr(original.with_attr("global_symbol", "main"))
+    mod = tl.transform.ReduceIndexStrength()(mod)
+    transformed = tvm.IRModule.from_expr(transformed.with_attr("global_symbol", "main"))
+    tvm.ir.assert_structural_equal(mod["main"], transformed["main"], True)
+
+
+def test_hoist_loop_invariant_index():
+    @T.prim_func
+    def before(A: T.Buffer((4096,), T.float32), B: T.Buffer((4096,), T.float32)):
+        with T.Kernel(8, threads=128) as bx:
+            tx = T.get_thread_binding()
+            for i in T.serial(4):
+                B[bx * 512 + tx * 4 + i] = A[bx * 512 + tx * 4 + i] * T.float32(2)
+
+    @T.prim_func
+    def after(A: T.Buffer((4096,), T.float32), B: T.Buffer((4096,), T.float32)):
+        with T.Kernel(8, threads=128) as bx:
+            tx = T.get_thread_binding()
+            i_base: T.int32 = bx * 512 + tx * 4
+            for i in T.serial(4):
+                B[i_base + i] = A[i_base + i] * T.float32(2)
+
+    _check(before, after)
+
+
+def test_keep_lone_variable_index():
+    @T.prim_func
+    def before(A: T.Buffer((4096,), T.float32), B: T.Buffer((4096,), T.float32)):
+        with T.Kernel(8, threads=128) as bx:
+            tx = T.get_thread_binding()
+            for i in T.serial(4):
+                B[tx + i * 128] = A[tx + i * 128]
+
+    _check(before, before)
+
+
+def test_unsigned_division_by_constant():
+    @T.prim_func
+    def before(A: T.Buffer((4096,), T.float32), B: T.Buffer((4096,), T.float32)):
+        with T.Kernel(8, threads=128) as bx:
+            tx = T.get_thread_binding()
+            for i in T.serial(4):
+                B[T.truncdiv(tx * 4 + i, 3)] = A[T.truncmod(tx * 4 + i, 3)]
+
+    @T.prim_func
+    def after(A: T.Buffer((4096,), T.float32), B: T.Buffer((4096,), T.float32)):
+        with T.Kernel(8, threads=128) as bx:
+            tx = T.get_thread_binding()
+            for i in T.serial(4):
+                B[T.Cast("int32", T.truncdiv(T.Cast("uint32", tx * 4 + i), T.uint32(3)))] = A[
+                    T.Cast("int32", T.truncmod(T.Cast("uint32", tx * 4 + i), T.uint32(3)))
+                ]
+
+    _check(before, after)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
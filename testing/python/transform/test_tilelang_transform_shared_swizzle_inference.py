@@ -0,0 +1,37 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+@tilelang.jit(
+    out_idx=[1],
+    pass_configs={
+        tilelang.PassConfigKey.TL_ENABLE_SHARED_SWIZZLE_INFERENCE: True,
+        tilelang.PassConfigKey.TL_ENABLE_BANK_CONFLICT_REPORT: True,
+    },
+)
+def transpose(M, N, block, dtype=T.float32):
+    @T.prim_func
+    def main(A: T.Tensor((M, N), dtype), B: T.Tensor((N, M), dtype)):
+        with T.Kernel(T.ceildiv(N, block), T.ceildiv(M, block), threads=128) as (bx, by):
+            A_shared = T.alloc_shared((block, block), dtype)
+            for i, j in T.Parallel(block, block):
+                A_shared[i, j] = A[by * block + i, bx * block + j]
+            # Column reads of a linear tile conflict on every bank.
+            for j, i in T.Parallel(block, block):
+                B[bx * block + j, by * block + i] = A_shared[i, j]
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_shared_swizzle_inference_transpose():
+    for dtype in [T.float32, T.float16]:
+        kernel = transpose(256, 512, 64, dtype)
+        A = torch.randn(256, 512, dtype=getattr(torch, dtype)).cuda()
+        torch.testing.assert_close(kernel(A), A.T.contiguous())
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
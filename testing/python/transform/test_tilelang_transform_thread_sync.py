@@ -1,5 +1,7 @@
 # ruff: noqa
 
+import re
+
 from tilelang import tvm as tvm
 import tilelang.testing
 from tvm.script import tir as T
@@ -234,5 +236,44 @@ def test_sync_shared_dyn_stmatrix_loop_hoist():
     assert s.index('T.tvm_storage_sync("shared.dyn")') < s.index("for i in T.unroll(8)")
 
 
+def _partial_syncs(groups, loop_groups=(), num_threads=512):
+    tx = tvm.tir.Var("tx", "int32")
+    iv = tvm.tir.IterVar(tvm.ir.Range(0, num_threads), tx, tvm.tir.IterVar.ThreadIndex, "threadIdx.x")
+
+    def sync_in(lo, hi):
+        sync = tvm.tir.Evaluate(tvm.tir.call_intrin("int32", "tir.tvm_storage_sync", "shared"))
+        return tvm.tir.IfThenElse(tvm.tir.all(tx >= lo, tx < hi), sync, None)
+
+    stmts = [sync_in(lo, hi) for lo, hi in groups]
+    if loop_groups:
+        loop_body = tvm.tir.SeqStmt([sync_in(lo, hi) for lo, hi in loop_groups])
+        stmts.append(tvm.tir.For(tvm.tir.Var("k", "int32"), 0, 4, tvm.tir.ForKind.SERIAL, loop_body))
+    body = tvm.tir.AttrStmt(iv, "thread_extent", num_threads, tvm.tir.SeqStmt(stmts))
+    mod = tvm.IRModule({"main": tvm.tir.PrimFunc([], body)})
+    return str(tilelang.transform.ThreadSync("shared")(mod))
+
+
+def _named_barrier_ids(s):
+    return [int(x) for x in re.findall(r'T.tvm_storage_sync\("shared", (\d+), \d+\)', s)]
+
+
+def test_sync_named_barrier_reuse():
+    # [0, 64) syncs after every thread of [0, 128) left its barrier, [64, 128)
+    # could still meet the threads of [0, 64) at theirs
+    s = _partial_syncs([(0, 128), (0, 64), (64, 128)])
+    assert _named_barrier_ids(s) == [3, 3, 4]
+    # Syncs within a loop are live over all of its iterations
+    s = _partial_syncs([], loop_groups=[(0, 128), (0, 64)])
+    assert _named_barrier_ids(s) == [3, 4]
+
+
+def test_sync_named_barrier_mbarrier_fallback():
+    # 16 concurrent warps, 13 named barriers left after the reserved ones
+    s = _partial_syncs([(w * 32, w * 32 + 32) for w in range(16)])
+    assert sorted(_named_barrier_ids(s)) == list(range(3, 16))
+    assert s.count("tl::syncthreads_partial") == 3
+    assert s.count("tl::mbarrier_init") == 3
+
+
 if __name__ == "__main__":
     tilelang.testing.main()
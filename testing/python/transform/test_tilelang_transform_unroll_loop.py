@@ -0,0 +1,77 @@
+import re
+
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+
+
+def unrolled_scale(extent):
+    @T.prim_func
+    def main(A: T.Buffer((8, 128, extent), T.float32), B: T.Buffer((8, 128, extent), T.float32)):
+        with T.Kernel(8, threads=128) as bx:
+            tx = T.get_thread_binding()
+            for i in T.unroll(extent):
+                B[bx, tx, i] = A[bx, tx, i] * T.float32(2)
+
+    return main
+
+
+def _unroll(func, budget):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    with tvm.transform.PassContext(config={tl.PassConfigKey.TL_UNROLL_CODE_SIZE_BUDGET: budget}):
+        mod = tl.transform.UnrollLoop()(mod)
+    return mod["main"]
+
+
+def _loops(func):
+    loops, factors = [], []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.For):
+            loops.append(node)
+        elif isinstance(node, tvm.tir.AttrStmt) and node.attr_key == "pragma_unroll_factor":
+            factors.append(int(node.value))
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, visit)
+    return loops, factors
+
+
+def test_unroll_within_budget():
+    func = _unroll(unrolled_scale(16), budget=-1)
+    loops, factors = _loops(func)
+    assert not loops and not factors
+    (decision,) = func.attrs["tl.unroll_decisions"]
+    assert int(decision["extent"]) == int(decision["factor"]) == 16
+
+
+def test_partial_unroll_over_budget():
+    func = _unroll(unrolled_scale(64), budget=32)
+    loops, factors = _loops(func)
+    assert len(loops) == 1 and loops[0].kind == tvm.tir.ForKind.UNROLLED
+    (decision,) = func.attrs["tl.unroll_decisions"]
+    body_instructions = int(decision["body_instructions"])
+    # The copies beyond the first fit in the budget
+    assert factors == [int(decision["factor"])]
+    assert 1 <= factors[0] < 64 and (factors[0] - 1) * body_instructions <= 32
+
+
+@tilelang.testing.requires_cuda
+def test_partial_unroll_codegen():
+    tilelang.disable_cache()
+    kernel = tilelang.compile(
+        unrolled_scale(256),
+        out_idx=[1],
+        pass_configs={
+            tl.PassConfigKey.TL_UNROLL_CODE_SIZE_BUDGET: 64,
+            tl.PassConfigKey.TL_ENABLE_COMPILE_PROFILE: True,
+        },
+    )
+    tilelang.enable_cache()
+    assert re.search(r"#pragma unroll \d+", kernel.get_kernel_source())
+    partial = [u for u in kernel.compile_profile.unroll if u.factor < u.extent]
+    assert partial and partial[0].extent == 256
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -0,0 +1,94 @@
+from tilelang import tvm as tvm
+import tilelang as tl
+import tilelang.language as T
+import tilelang.testing
+import torch
+
+
+def _schedule(func):
+    mod = tvm.IRModule.from_expr(func.with_attr("global_symbol", "main"))
+    return tl.transform.ScheduleWarpGroupPingPong()(mod)["main"]
+
+
+def _calls(func):
+    """Names of the calls of func in program order, with the barrier ids"""
+    calls = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Call):
+            name = str(node.op.name)
+            if name == "tir.call_extern":
+                calls.append(node.args[0].value)
+            elif name.startswith("tl.named_barrier"):
+                calls.append(f"{name}({node.args[0]})")
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, visit)
+    return calls
+
+
+def test_pingpong_turns():
+    @T.prim_func
+    def before(A: T.Tensor((64, 64), T.float16), C: T.Tensor((64, 64), T.float32)):
+        v = T.launch_thread("threadIdx.x", 384)
+        if v < 256:
+            for k in T.serial(4, annotations={"tl.warp_group_pingpong": 1}):
+                T.call_extern("handle", "tl::gemm_ss<64, 64, 32, 2, 1, 0, 0>", A.data, A.data, C.data)
+                T.call_extern("handle", "softmax", C.data)
+
+    after = _schedule(before)
+    assert "tl.warp_group_pingpong" not in after.script()
+    # The first turn is given to warpgroup 0 before the loop, then every
+    # warpgroup takes its turn before the gemm and hands it off after it
+    assert _calls(after) == [
+        "tl.named_barrier_arrive(5)",
+        "tl.named_barrier_sync(5 + v // 128)",
+        "tl::gemm_ss<64, 64, 32, 2, 1, 0, 0>",
+        "tl.named_barrier_arrive(6 - v // 128)",
+        "softmax",
+    ]
+
+
+def test_pingpong_unmarked_loop():
+    @T.prim_func
+    def before(A: T.Tensor((64, 64), T.float16), C: T.Tensor((64, 64), T.float32)):
+        v = T.launch_thread("threadIdx.x", 256)
+        for k in T.serial(4):
+            T.call_extern("handle", "tl::gemm_ss<64, 64, 32, 2, 1, 0, 0>", A.data, A.data, C.data)
+
+    assert _calls(_schedule(before)) == ["tl::gemm_ss<64, 64, 32, 2, 1, 0, 0>"]
+
+
+@tilelang.jit(out_idx=[-1])
+def pingpong_gemm(M, N, K, block_M, block_N, block_K, pingpong, dtype=T.float16, accum_dtype=T.float32):
+    @T.prim_func
+    def main(A: T.Tensor((M, K), dtype), B: T.Tensor((K, N), dtype), C: T.Tensor((M, N), dtype)):
+        with T.Kernel(T.ceildiv(N, block_N), T.ceildiv(M, block_M), threads=256) as (bx, by):
+            T.annotate_pingpong(pingpong)
+            A_shared = T.alloc_shared((block_M, block_K), dtype)
+            B_shared = T.alloc_shared((block_K, block_N), dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.clear(C_local)
+            for k in T.Pipelined(T.ceildiv(K, block_K), num_stages=3):
+                T.copy(A[by * block_M, k * block_K], A_shared)
+                T.copy(B[k * block_K, bx * block_N], B_shared)
+                T.gemm(A_shared, B_shared, C_local)
+            T.copy(C_local, C[by * block_M, bx * block_N])
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_eq(9, 0)
+def test_pingpong_gemm():
+    M = N = K = 1024
+    kernel = pingpong_gemm(M, N, K, 128, 128, 64, pingpong=True)
+    assert "tl::named_barrier_sync" in kernel.get_kernel_source()
+    assert "tl::named_barrier_sync" not in pingpong_gemm(M, N, K, 128, 128, 64, pingpong=False).get_kernel_source()
+
+    A = torch.randn(M, K, device="cuda", dtype=torch.float16)
+    B = torch.randn(K, N, device="cuda", dtype=torch.float16)
+    torch.testing.assert_close(kernel(A, B), A @ B, rtol=1e-2, atol=1e-2)
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
@@ -2,7 +2,7 @@ import torch
 import tilelang
 import tilelang.testing
 
-from tilelang.utils.sparse import compress_sm90, randn_semi_sparse
+from tilelang.utils.sparse import compress, compress_block_mask, compress_on_device, compress_sm90, randint_semi_sparse, randn_semi_sparse
 
 
 def _test_compress_sm90(M, K, block_k, dtype):
@@ -34,6 +34,74 @@ def test_compress_sm90():
     _test_compress_sm90(1024, 1024, 64, torch.float8_e5m2)
 
 
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(8, 0)
+def test_compress_on_device_sm80():
+    for dtype in [torch.float16, torch.bfloat16, torch.int8]:
+        if dtype == torch.int8:
+            # two non-zeros in every group, whose positions the metadata then encodes unambiguously
+            A = randint_semi_sparse(256, 512, 1, 100, dtype=torch.int32, device="cuda").to(torch.int8)
+        else:
+            A = randn_semi_sparse(256, 512, dtype=dtype, device="cuda")
+        A_sparse, E = compress_on_device(A, arch="8.0")
+        A_ref, E_ref = compress(A, transposed=False, arch="8.0")
+        torch.testing.assert_close(A_sparse, A_ref, rtol=0, atol=0)
+        assert torch.equal(E.view(E_ref.dtype), E_ref)
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version(9, 0)
+def test_compress_on_device_sm90():
+    for block_k in [32, 64, 128]:
+        A = randn_semi_sparse(256, 512, dtype=torch.float16, device="cuda")
+        A_sparse, E = compress_on_device(A, arch="9.0", block_k=block_k)
+        A_ref, E_ref = compress_sm90(A, block_k, False)
+        torch.testing.assert_close(A_sparse, A_ref, rtol=0, atol=0)
+        assert torch.equal(E.view(E_ref.dtype), E_ref)
+
+
+@tilelang.testing.requires_cuda
+@tilelang.testing.requires_cuda_compute_version_ge(8, 0)
+def test_compress_on_device_prunes():
+    # A dense operand keeps the two largest magnitudes of each group of 4
+    A = torch.randn(128, 256, dtype=torch.float16, device="cuda")
+    A_sparse, _ = compress_on_device(A, arch="8.0")
+    groups = A.view(128, 64, 4)
+    pos = groups.abs().topk(2, dim=-1).indices.sort(dim=-1).values
+    torch.testing.assert_close(A_sparse, groups.gather(-1, pos).view(128, 128), rtol=0, atol=0)
+
+    # a K-major operand compresses like its transpose
+    A_t_sparse, E_t = compress_on_device(A.t().contiguous(), transposed=True, arch="8.0")
+    _, E = compress_on_device(A, arch="8.0")
+    torch.testing.assert_close(A_t_sparse, A_sparse.t(), rtol=0, atol=0)
+    assert torch.equal(E_t, E)
+
+
+def test_compress_block_mask():
+    torch.manual_seed(0)
+    block_mask = torch.rand(2, 3, 8, 8) > 0.7
+    block_mask[0, 0, 5] = False
+    layout = compress_block_mask(block_mask)
+    rows = block_mask.reshape(-1, 8)
+    assert layout.num_rows == rows.shape[0]
+    for r in range(rows.shape[0]):
+        cols = layout.col_idx[layout.row_ptr[r] : layout.row_ptr[r + 1]].tolist()
+        assert cols == rows[r].nonzero().flatten().tolist()
+    # Rows sorted by decreasing number of active blocks
+    nnz = (layout.row_ptr[1:] - layout.row_ptr[:-1])[layout.row_order.long()]
+    assert torch.all(nnz[:-1] >= nnz[1:])
+    assert layout.max_row_nnz == int(rows.sum(-1).max())
+
+    # A static mask is shared by every batch and head
+    static = compress_block_mask(block_mask[0, 0], batch=2, heads=3)
+    assert static.num_rows == 2 * 3 * 8
+    assert static.row_ptr[-1] == 6 * block_mask[0, 0].sum()
+
+
 if __name__ == "__main__":
+    test_compress_block_mask()
     test_compress_sm90()
+    test_compress_on_device_sm80()
+    test_compress_on_device_sm90()
+    test_compress_on_device_prunes()
     print("All tests passed.")
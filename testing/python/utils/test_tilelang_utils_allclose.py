@@ -0,0 +1,66 @@
+import tilelang
+import tilelang.language as T
+import tilelang.testing
+import torch
+from tilelang.utils.allclose import gpu_allclose, gpu_assert_close
+
+
+@tilelang.testing.requires_cuda
+def test_gpu_allclose():
+    a = torch.randn(3, 1000, 777, device="cuda", dtype=torch.float16)
+    b = a.clone()
+    report = gpu_allclose(a, b)
+    assert report.num_mismatched == 0 and report.first_index is None
+    b[1, 2, 3] += 1.0
+    b[2, 999, 776] += 4.0
+    b[0, 0, 5] = float("nan")
+    report = gpu_allclose(a, b, rtol=1e-2, atol=1e-2)
+    assert report.num_mismatched == 3
+    assert report.first_index == (0, 0, 5)
+    assert abs(report.max_abs_error - 4.0) < 0.1
+    # matching NaNs only count with equal_nan=False
+    a[0, 0, 5] = float("nan")
+    assert gpu_allclose(a, b, rtol=1e-2, atol=1e-2).num_mismatched == 2
+    assert gpu_allclose(a, b, rtol=1e-2, atol=1e-2, equal_nan=False).num_mismatched == 3
+    try:
+        gpu_assert_close(a, b, max_mismatched_ratio=0.0)
+    except AssertionError as e:
+        assert "First mismatch at index [1, 2, 3]" in str(e)
+    else:
+        raise AssertionError("gpu_assert_close accepted mismatching tensors")
+
+
+def add_one(M, N, block=128, off_by_one=False):
+    # error added to the last row of every tile
+    last_row_error = 0.5 if off_by_one else 0.0
+
+    @T.prim_func
+    def main(A: T.Tensor((M, N), T.float16), B: T.Tensor((M, N), T.float16)):
+        with T.Kernel(T.ceildiv(M, block), threads=128) as bx:
+            for i, j in T.Parallel(block, N):
+                if bx * block + i < M:
+                    B[bx * block + i, j] = A[bx * block + i, j] + T.float16(1.0) + T.if_then_else(i == block - 1, T.float16(last_row_error), T.float16(0.0))
+
+    return main
+
+
+@tilelang.testing.requires_cuda
+def test_fuzz_shapes():
+    dims = {"M": (1, 1000), "N": [16, 64]}
+    shapes = tilelang.testing.sample_shapes(dims, num_cases=10)
+    assert len(shapes) == 10
+    # the extremes of every dimension come first
+    assert shapes[:4] == [{"M": 1, "N": 16}, {"M": 1, "N": 64}, {"M": 1000, "N": 16}, {"M": 1000, "N": 64}]
+
+    report = tilelang.testing.fuzz_shapes(lambda M, N: tilelang.compile(add_one(M, N), out_idx=[1]), lambda a: a + 1, dims, num_cases=6)
+    assert all(case.passed for case in report), [case for case in report if not case.passed]
+    # the last row of every tile is wrong, which only the shapes covering it reveal
+    report = tilelang.testing.fuzz_shapes(
+        lambda M, N: tilelang.compile(add_one(M, N, off_by_one=True), out_idx=[1]), lambda a: a + 1, dims, num_cases=6
+    )
+    failed = [case.shape for case in report if not case.passed]
+    assert {"M": 1000, "N": 16} in failed and {"M": 1, "N": 16} not in failed
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
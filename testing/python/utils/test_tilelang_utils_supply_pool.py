@@ -0,0 +1,45 @@
+import tilelang.testing
+from tilelang import tvm
+from tilelang.engine.param import KernelParam
+from tilelang.utils.tensor import TensorSupplyPool, TensorSupplyType
+
+
+def _param(shape, dtype="float16"):
+    return KernelParam(tvm.DataType(dtype), list(shape))
+
+
+@tilelang.testing.requires_cuda
+def test_supply_pool_reuse():
+    pool = TensorSupplyPool()
+    q, k, v = _param((2, 128, 64)), _param((2, 128, 64)), _param((2, 128, 64))
+    first = pool.get_inputs([q, k, v], TensorSupplyType.Auto)
+    # parameters of the same signature are never aliased
+    assert len({t.data_ptr() for t in first}) == 3
+    second = pool.get_inputs([q, k, v], TensorSupplyType.Auto)
+    assert [t.data_ptr() for t in first] == [t.data_ptr() for t in second]
+    assert pool.hits == 3 and pool.misses == 3
+    # another dtype or supply type is another signature
+    assert pool.get_inputs([_param((2, 128, 64), "float32")], TensorSupplyType.Auto)[0].data_ptr() != first[0].data_ptr()
+    assert pool.get_inputs([q], TensorSupplyType.One)[0].data_ptr() != first[0].data_ptr()
+
+
+@tilelang.testing.requires_cuda
+def test_supply_pool_capacity():
+    nbytes = 1024 * 1024 * 2
+    pool = TensorSupplyPool(capacity_bytes=2 * nbytes + 8 * 1024)
+    a, b, c = _param((1024, 1024)), _param((1024, 1025)), _param((1024, 1026))
+    pool.get_inputs([a], TensorSupplyType.Auto)
+    pool.get_inputs([b], TensorSupplyType.Auto)
+    pool.get_inputs([a], TensorSupplyType.Auto)
+    # b is the least recently used tensor
+    pool.get_inputs([c], TensorSupplyType.Auto)
+    assert pool.nbytes <= pool.capacity_bytes
+    misses = pool.misses
+    pool.get_inputs([a], TensorSupplyType.Auto)
+    assert pool.misses == misses
+    pool.get_inputs([b], TensorSupplyType.Auto)
+    assert pool.misses == misses + 1
+
+
+if __name__ == "__main__":
+    tilelang.testing.main()
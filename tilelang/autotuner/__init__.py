@@ -6,3 +6,18 @@ from .capture import (
     set_autotune_inputs,  # noqa: F401
     get_autotune_inputs,  # noqa: F401
 )
+from .search import (
+    SearchStrategy,  # noqa: F401
+    ExhaustiveSearch,  # noqa: F401
+    ModelGuidedSearch,  # noqa: F401
+)
+from .database import (
+    TuningDatabase,  # noqa: F401
+    get_database,  # noqa: F401
+)
+from .objective import (
+    Objective,  # noqa: F401
+    EnergyObjective,  # noqa: F401
+    BudgetObjective,  # noqa: F401
+    SMTimeObjective,  # noqa: F401
+)
@@ -0,0 +1,210 @@
+"""Shared tuning database of the auto-tuner.
+
+The exact-key results saved under ``<TILELANG_CACHE_DIR>/autotuner`` only answer
+a rerun of the very same tuning problem. The database additionally records the
+best configurations of every tuning run indexed by ``(op, device, shape)``:
+
+* ``op`` hashes everything that fixes the kernel except its sizes: the source
+  of the kernel function, its non-numeric parameters (dtypes, flags, layouts)
+  and the compile arguments.
+* ``device`` is the calibration profile key of the GPU the run was measured on.
+* ``shape`` maps the numeric parameters of the kernel to their values.
+
+A shape that was never tuned is answered by the records of the same op and
+device whose shapes are closest in log space; their best configurations are a
+short candidate list to re-validate instead of sweeping the whole space.
+
+The database is a JSON-lines file that is only ever appended to, so it can be
+shared by many tuning jobs, e.g. on a network file system. Every record is
+written with a single ``write`` on an ``O_APPEND`` descriptor under an
+exclusive ``flock``, readers parse the lines appended since their last scan.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import json
+import logging
+import math
+import os
+import threading
+from typing import Any
+
+from tilelang.env import env
+
+logger = logging.getLogger(__name__)
+
+try:
+    import fcntl
+except ImportError:  # Windows
+    fcntl = None
+
+DATABASE_VERSION = 1
+DATABASE_FILE_NAME = "tuning_database.jsonl"
+
+
+def op_signature(func_source: str, parameters: dict[str, Any], compile_args: Any = None) -> str:
+    """Hash the parts of a tuning problem that are not its shape."""
+    data = {
+        "func_source": func_source,
+        "parameters": {name: value for name, value in parameters.items() if not is_shape_value(value)},
+        "compile_args": hash(compile_args) if compile_args is not None else None,
+    }
+    return hashlib.sha256(json.dumps(data, sort_keys=True, default=str).encode()).hexdigest()
+
+
+def is_shape_value(value: Any) -> bool:
+    return isinstance(value, (int, float)) and not isinstance(value, bool)
+
+
+def shape_of(parameters: dict[str, Any]) -> dict[str, int | float]:
+    """The numeric parameters of a tuning problem."""
+    return {name: value for name, value in parameters.items() if is_shape_value(value)}
+
+
+def shape_distance(a: dict[str, int | float], b: dict[str, int | float]) -> float:
+    """Distance of two shapes, infinite when they do not name the same dimensions.
+
+    Dimensions are compared by the log of their ratio, so that going from 1024
+    to 2048 counts as much as going from 64 to 128.
+    """
+    if a.keys() != b.keys():
+        return math.inf
+    distance = 0.0
+    for name, x in a.items():
+        y = b[name]
+        if x == y:
+            continue
+        if x <= 0 or y <= 0:
+            # sizes of zero or less are matched exactly
+            return math.inf
+        distance += abs(math.log2(x) - math.log2(y))
+    return distance
+
+
+class TuningDatabase:
+    """Append-only, multi-writer store of the best configurations per tuned shape."""
+
+    def __init__(self, path: str):
+        self.path = path
+        # (op, device) -> list of records, later records of a shape win
+        self._records: dict[tuple[str, str], list[dict[str, Any]]] = {}
+        self._scanned = 0
+        self._scan_lock = threading.Lock()
+
+    def _scan(self) -> None:
+        with self._scan_lock:
+            try:
+                with open(self.path, "rb") as f:
+                    f.seek(self._scanned)
+                    data = f.read()
+            except OSError:
+                return
+            # a writer may be in the middle of a record, keep it for the next scan
+            end = data.rfind(b"\n") + 1
+            for line in data[:end].splitlines():
+                try:
+                    record = json.loads(line)
+                except ValueError:
+                    logger.warning(f"Skipping corrupted record in tuning database {self.path}")
+                    continue
+                if record.get("version") != DATABASE_VERSION:
+                    continue
+                self._records.setdefault((record["op"], record["device"]), []).append(record)
+            self._scanned += end
+
+    def put(
+        self,
+        op: str,
+        device: str | None,
+        shape: dict[str, int | float],
+        results: list[tuple[dict[str, Any], float]],
+        top_k: int = 8,
+    ) -> None:
+        """Record the `top_k` fastest of the measured `(config, latency)` pairs of a shape."""
+        results = sorted((r for r in results if r[1] is not None), key=lambda r: r[1])[:top_k]
+        if not results:
+            return
+        record = {
+            "version": DATABASE_VERSION,
+            "op": op,
+            "device": str(device),
+            "shape": shape,
+            "configs": [{"config": config, "latency": latency} for config, latency in results],
+        }
+        line = (json.dumps(record, sort_keys=True, default=str) + "\n").encode()
+        os.makedirs(os.path.dirname(os.path.abspath(self.path)), exist_ok=True)
+        fd = os.open(self.path, os.O_WRONLY | os.O_APPEND | os.O_CREAT, 0o644)
+        try:
+            if fcntl is not None:
+                fcntl.flock(fd, fcntl.LOCK_EX)
+            # A single write on an O_APPEND descriptor keeps the record contiguous.
+            os.write(fd, line)
+        finally:
+            if fcntl is not None:
+                fcntl.flock(fd, fcntl.LOCK_UN)
+            os.close(fd)
+
+    def nearest(
+        self, op: str, device: str | None, shape: dict[str, int | float], k: int = 2
+    ) -> list[tuple[float, dict[str, Any]]]:
+        """The records of the `k` tuned shapes closest to `shape`, as `(distance, record)`."""
+        self._scan()
+        latest: dict[str, dict[str, Any]] = {}
+        for record in self._records.get((op, str(device)), []):
+            latest[json.dumps(record["shape"], sort_keys=True)] = record
+        ranked = []
+        for record in latest.values():
+            distance = shape_distance(shape, record["shape"])
+            if distance != math.inf:
+                ranked.append((distance, record))
+        ranked.sort(key=lambda r: r[0])
+        return ranked[:k]
+
+    def lookup(self, op: str, device: str | None, shape: dict[str, int | float]) -> dict[str, Any] | None:
+        """The record of exactly `shape`, if it was tuned."""
+        ranked = self.nearest(op, device, shape, k=1)
+        if ranked and ranked[0][0] == 0.0:
+            return ranked[0][1]
+        return None
+
+    def candidates(
+        self,
+        op: str,
+        device: str | None,
+        shape: dict[str, int | float],
+        neighbors: int = 2,
+        top_configs: int = 4,
+    ) -> list[dict[str, Any]]:
+        """The best configurations of the closest tuned shapes, best first and without repeats."""
+        configs = []
+        for _, record in self.nearest(op, device, shape, k=neighbors):
+            for entry in record["configs"][:top_configs]:
+                if entry["config"] not in configs:
+                    configs.append(entry["config"])
+        return configs
+
+    def reset(self) -> None:
+        with self._scan_lock:
+            self._records = {}
+            self._scanned = 0
+
+
+_databases: dict[str, TuningDatabase] = {}
+_databases_lock = threading.Lock()
+
+
+def database_path() -> str:
+    """`TILELANG_AUTO_TUNING_DATABASE`, or the database of the local cache directory."""
+    if env.TILELANG_AUTO_TUNING_DATABASE:
+        return env.TILELANG_AUTO_TUNING_DATABASE
+    return os.path.join(env.TILELANG_CACHE_DIR, "autotuner", DATABASE_FILE_NAME)
+
+
+def get_database(path: str | None = None) -> TuningDatabase:
+    """The process-wide database at `path`, see `database_path` for the default."""
+    path = os.path.abspath(path or database_path())
+    with _databases_lock:
+        if path not in _databases:
+            _databases[path] = TuningDatabase(path)
+        return _databases[path]
@@ -0,0 +1,239 @@
+"""Objectives ranking the configurations of a tuning run.
+
+By default the auto-tuner keeps the configuration with the lowest latency
+measured in isolation. That is not always the configuration that performs best
+in a deployment: under a power cap the fastest configuration may throttle, a
+kernel co-scheduled with others may be limited to part of the SMs or of the
+shared memory. An :class:`Objective` turns the latency of a candidate, plus
+whatever it measures itself, into a score; the candidate with the lowest score
+wins and its measurements are kept in ``AutotuneResult.metrics``::
+
+    @tilelang.autotune(configs=..., objective="energy")
+    @tilelang.jit(out_idx=[-1])
+    def matmul(M, N, K, block_M=128, block_N=128, num_stages=3):
+        ...
+
+Objectives:
+    latency: the latency measured by the profiler (default)
+    energy: energy per launch, from NVML power samples over a sustained run
+    budget: latency, rejecting kernels over a shared memory or register budget
+    sm_time: latency times the fraction of the SMs the launch occupies, the
+        inverse of the throughput per SM when kernels are co-scheduled
+"""
+
+from __future__ import annotations
+
+import math
+import threading
+import time
+from typing import TYPE_CHECKING, Any
+
+if TYPE_CHECKING:
+    from tilelang.jit.kernel import JITKernel
+    from tilelang.profiler import Profiler
+
+
+class Objective:
+    """Latency objective, the base of every objective.
+
+    Subclasses override ``measure`` to collect their own measurements of a
+    candidate and ``score`` to rank it, lower is better. A score of
+    ``math.inf`` rejects the candidate.
+    """
+
+    name = "latency"
+
+    def measure(self, jit_kernel: JITKernel, profiler: Profiler, input_tensors: list, latency: float) -> dict[str, Any]:
+        return {}
+
+    def score(self, latency: float, metrics: dict[str, Any]) -> float:
+        return latency
+
+    def __repr__(self) -> str:
+        return f"{type(self).__name__}()"
+
+
+class PowerSampler:
+    """Samples the board power of a GPU with NVML on a background thread."""
+
+    def __init__(self, device: int | None = None, interval: float = 0.005):
+        import pynvml
+        import torch
+
+        pynvml.nvmlInit()
+        self._nvml = pynvml
+        device = torch.cuda.current_device() if device is None else device
+        uuid = getattr(torch.cuda.get_device_properties(device), "uuid", None)
+        if uuid is not None:
+            # NVML ignores CUDA_VISIBLE_DEVICES, match the device by its UUID
+            self._handle = pynvml.nvmlDeviceGetHandleByUUID(f"GPU-{uuid}")
+        else:
+            self._handle = pynvml.nvmlDeviceGetHandleByIndex(device)
+        self.interval = interval
+        self.samples: list[float] = []
+        self._stop = threading.Event()
+        self._thread: threading.Thread | None = None
+
+    def _run(self):
+        while not self._stop.is_set():
+            self.samples.append(self._nvml.nvmlDeviceGetPowerUsage(self._handle) / 1000.0)
+            time.sleep(self.interval)
+
+    def __enter__(self) -> PowerSampler:
+        self.samples = []
+        self._stop.clear()
+        self._thread = threading.Thread(target=self._run, daemon=True)
+        self._thread.start()
+        return self
+
+    def __exit__(self, *_):
+        self._stop.set()
+        self._thread.join()
+
+    @property
+    def mean_watts(self) -> float | None:
+        return sum(self.samples) / len(self.samples) if self.samples else None
+
+
+class EnergyObjective(Objective):
+    """Energy per launch, in millijoules.
+
+    The candidate runs for ``duration_ms`` while NVML samples the board power,
+    long enough for the clocks to settle to the power limit. The latency of
+    that sustained run, which includes any throttling, is reported as
+    ``sustained_latency`` and multiplied with the mean power.
+
+    Args:
+        duration_ms: Length of the sustained run.
+        latency_weight: Exponent of the sustained latency in the score; 0
+            ranks by energy alone, 1 by the energy-delay product.
+    """
+
+    name = "energy"
+
+    def __init__(self, duration_ms: float = 1000.0, latency_weight: float = 0.0):
+        self.duration_ms = duration_ms
+        self.latency_weight = latency_weight
+
+    def measure(self, jit_kernel, profiler, input_tensors, latency):
+        from tilelang.profiler.bench import do_bench
+
+        with PowerSampler() as sampler:
+            # back to back runs without L2 flushes, whose power would be counted too
+            sustained_latency = do_bench(lambda: profiler.func(*input_tensors), warmup=1, rep=self.duration_ms, flush_l2=False)
+        power = sampler.mean_watts
+        if power is None:
+            return {"sustained_latency": sustained_latency}
+        return {"sustained_latency": sustained_latency, "power_w": power, "energy_mj": power * sustained_latency}
+
+    def score(self, latency, metrics):
+        if "energy_mj" not in metrics:
+            return math.inf
+        return metrics["energy_mj"] * metrics["sustained_latency"] ** self.latency_weight
+
+    def __repr__(self) -> str:
+        return f"EnergyObjective(duration_ms={self.duration_ms}, latency_weight={self.latency_weight})"
+
+
+def _resources(jit_kernel: JITKernel):
+    from tilelang import tvm
+    from tilelang.engine.resource import analyze_resources
+
+    with tvm.transform.PassContext(opt_level=3, config=jit_kernel.pass_configs or {}):
+        return analyze_resources(jit_kernel.prim_func, target=jit_kernel.target, target_host=jit_kernel.target_host)
+
+
+class BudgetObjective(Objective):
+    """Latency of the kernels within a shared memory and register budget.
+
+    Args:
+        max_smem_bytes: Shared memory per block left to the kernel, e.g. when
+            another kernel shares the SMs.
+        max_registers: Registers per thread, as estimated by
+            `tilelang.engine.resource.analyze_resources`.
+        min_blocks_per_sm: Resident blocks per SM the kernel must allow.
+    """
+
+    name = "budget"
+
+    def __init__(self, max_smem_bytes: int | None = None, max_registers: int | None = None, min_blocks_per_sm: int | None = None):
+        self.max_smem_bytes = max_smem_bytes
+        self.max_registers = max_registers
+        self.min_blocks_per_sm = min_blocks_per_sm
+
+    def measure(self, jit_kernel, profiler, input_tensors, latency):
+        infos = _resources(jit_kernel)
+        return {
+            "smem_bytes": max((info.smem_bytes for info in infos), default=0),
+            "registers_per_thread": max((info.registers_per_thread for info in infos), default=0),
+            "blocks_per_sm": min((info.blocks_per_sm for info in infos if info.blocks_per_sm is not None), default=None),
+        }
+
+    def score(self, latency, metrics):
+        if self.max_smem_bytes is not None and metrics["smem_bytes"] > self.max_smem_bytes:
+            return math.inf
+        if self.max_registers is not None and metrics["registers_per_thread"] > self.max_registers:
+            return math.inf
+        blocks = metrics["blocks_per_sm"]
+        if self.min_blocks_per_sm is not None and blocks is not None and blocks < self.min_blocks_per_sm:
+            return math.inf
+        return latency
+
+    def __repr__(self) -> str:
+        return (
+            f"BudgetObjective(max_smem_bytes={self.max_smem_bytes}, max_registers={self.max_registers}, "
+            f"min_blocks_per_sm={self.min_blocks_per_sm})"
+        )
+
+
+class SMTimeObjective(Objective):
+    """Latency weighted by the fraction of the SMs a launch occupies.
+
+    A kernel whose grid fills a fraction of the GPU leaves the other SMs to
+    co-scheduled kernels, so a slower launch on fewer SMs can raise the
+    throughput of the whole GPU. Kernels with a dynamic grid count as
+    occupying every SM.
+    """
+
+    name = "sm_time"
+
+    def __init__(self, num_sms: int | None = None):
+        self.num_sms = num_sms
+
+    def measure(self, jit_kernel, profiler, input_tensors, latency):
+        if self.num_sms is None:
+            import torch
+
+            self.num_sms = torch.cuda.get_device_properties(torch.cuda.current_device()).multi_processor_count
+        sms = 0
+        for info in _resources(jit_kernel):
+            if info.grid_blocks is None or not info.blocks_per_sm:
+                sms = self.num_sms
+                break
+            sms = max(sms, min(self.num_sms, math.ceil(info.grid_blocks / info.blocks_per_sm)))
+        return {"sms": sms, "num_sms": self.num_sms}
+
+    def score(self, latency, metrics):
+        return latency * max(metrics["sms"], 1) / metrics["num_sms"]
+
+    def __repr__(self) -> str:
+        return f"SMTimeObjective(num_sms={self.num_sms})"
+
+
+_OBJECTIVES = {
+    Objective.name: Objective,
+    EnergyObjective.name: EnergyObjective,
+    BudgetObjective.name: BudgetObjective,
+    SMTimeObjective.name: SMTimeObjective,
+}
+
+
+def get_objective(objective: str | Objective | None) -> Objective:
+    """Resolve the `objective` argument of the auto-tuner."""
+    if objective is None:
+        return Objective()
+    if isinstance(objective, Objective):
+        return objective
+    if objective not in _OBJECTIVES:
+        raise ValueError(f"Unknown autotune objective {objective!r}, expected one of {sorted(_OBJECTIVES)} or an Objective")
+    return _OBJECTIVES[objective]()
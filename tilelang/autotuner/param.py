@@ -139,6 +139,9 @@ class AutotuneResult:
         libcode: Generated library code.
         func: Optimized function.
         kernel: Compiled kernel function.
+        objective: Name of the objective the configuration minimizes.
+        score: Value of the objective for the configuration.
+        metrics: Measurements of the objective, e.g. the power of the energy objective.
     """
 
     latency: float | None = None
@@ -147,6 +150,9 @@ class AutotuneResult:
     libcode: str | None = None
     func: Callable | None = None
     kernel: Callable | None = None
+    objective: str | None = None
+    score: float | None = None
+    metrics: dict | None = None
 
     @staticmethod
     def _load_binary(path: str):
@@ -226,18 +232,17 @@ class AutotuneResult:
             kernel_lib_path = os.path.join(cache_path, kernel_lib_file)
 
             if kernel.execution_backend == "nvrtc":
-                # Save cubin and python helper file
-                src_lib_path = kernel.adapter.libpath
+                # Save cubin and python helper file, both kept in memory
+                lib_generator = kernel.adapter.lib_generator
                 kernel_py_path = os.path.join(cache_path, KERNEL_PY_PATH)
-                py_src_path = src_lib_path.replace(".cubin", ".py")
                 if verbose:
                     logger.debug(f"Saving kernel nvrtc python code to file: {kernel_py_path}")
-                self._safe_write_file(kernel_py_path, "wb", lambda f: f.write(self._load_binary(py_src_path)))
+                self._safe_write_file(kernel_py_path, "w", lambda f: f.write(lib_generator.host_func))
                 if verbose:
                     logger.debug(f"Saving kernel library to file: {kernel_lib_path}")
-                self._safe_write_file(kernel_lib_path, "wb", lambda f: f.write(self._load_binary(src_lib_path)))
+                self._safe_write_file(kernel_lib_path, "wb", lambda f: f.write(lib_generator.cubin))
             elif kernel.execution_backend == "tvm_ffi":
-                executable = kernel.adapter.executable
+                executable = kernel.adapter._load_executable()
                 if verbose:
                     logger.debug(f"Saving kernel executable to file: {kernel_lib_path}")
                 self._safe_write_executable(executable, kernel_lib_path)
@@ -379,6 +384,9 @@ class AutotuneResult:
                 {
                     "latency": self.latency,
                     "ref_latency": self.ref_latency,
+                    "objective": self.objective,
+                    "score": self.score,
+                    "metrics": self.metrics,
                 },
                 f,
             ),
@@ -417,6 +425,7 @@ class AutotuneResult:
             logger.debug(f"Loading latency from file: {path / LATENCY_PATH}")
         with open(path / LATENCY_PATH) as f:
             latency = json.load(f)
+            objective, score, metrics = latency.get("objective"), latency.get("score"), latency.get("metrics")
             latency, ref_latency = latency["latency"], latency["ref_latency"]
 
         kernel = cls._load_kernel_from_disk(
@@ -444,5 +453,8 @@ class AutotuneResult:
             libcode=kernel.get_kernel_source(),
             latency=latency,
             ref_latency=ref_latency,
+            objective=objective,
+            score=score,
+            metrics=metrics,
         )
         return result
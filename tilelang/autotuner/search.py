@@ -0,0 +1,160 @@
+"""Search strategies for the auto-tuner.
+
+A strategy decides which configurations of the tuning space are compiled and
+benchmarked, and in which order. ``ExhaustiveSearch`` evaluates every
+configuration, ``ModelGuidedSearch`` fits a cheap surrogate on the latencies
+measured so far and only evaluates the most promising candidates.
+"""
+
+from __future__ import annotations
+
+import math
+from typing import Any, Callable
+
+
+class SearchStrategy:
+    """Propose configurations to evaluate and learn from their latencies.
+
+    The tuner calls :meth:`reset` once with the full configuration list, then
+    alternates :meth:`propose` (a batch of indices to compile and benchmark)
+    and :meth:`update` (one call per evaluated index) until :meth:`propose`
+    returns an empty batch.
+    """
+
+    def reset(self, configs: list[dict[str, Any]]) -> None:
+        self.configs = configs
+
+    def propose(self, batch_size: int) -> list[int]:
+        raise NotImplementedError()
+
+    def update(self, index: int, latency: float | None) -> None:
+        """Record the latency of a configuration, None if it failed."""
+
+
+class ExhaustiveSearch(SearchStrategy):
+    """Evaluate every configuration, in order."""
+
+    def reset(self, configs: list[dict[str, Any]]) -> None:
+        super().reset(configs)
+        self._proposed = False
+
+    def propose(self, batch_size: int) -> list[int]:
+        if self._proposed:
+            return []
+        self._proposed = True
+        return list(range(len(self.configs)))
+
+
+class ModelGuidedSearch(SearchStrategy):
+    """Adaptive search driven by a nearest-neighbour latency model.
+
+    The first ``num_initial`` trials follow ``prior``, a score where lower is
+    better (the order of the configuration list by default, which for configs
+    derived from carver roller hints is the roller's own ranking). Every
+    following batch is chosen by an acquisition that combines the latency
+    predicted from the measured neighbours of a candidate with a bonus for
+    candidates far away from anything measured. The search stops after
+    ``max_trials`` evaluations.
+
+    Parameters
+    ----------
+    max_trials : int, optional
+        Evaluation budget, defaults to a quarter of the space (at least 8).
+    num_initial : int, optional
+        Number of trials taken from the prior before the model is used,
+        defaults to a quarter of the budget (at least 2).
+    exploration : float
+        Weight of the distance bonus in the acquisition.
+    prior : Callable[[dict], float], optional
+        Score of a configuration before any measurement, lower is better.
+    """
+
+    def __init__(
+        self,
+        max_trials: int | None = None,
+        num_initial: int | None = None,
+        exploration: float = 0.1,
+        prior: Callable[[dict[str, Any]], float] | None = None,
+    ):
+        self.max_trials = max_trials
+        self.num_initial = num_initial
+        self.exploration = exploration
+        self.prior = prior
+
+    def reset(self, configs: list[dict[str, Any]]) -> None:
+        super().reset(configs)
+        num_configs = len(configs)
+        self._budget = min(num_configs, self.max_trials or max(8, num_configs // 4))
+        self._num_initial = min(self._budget, self.num_initial or max(2, self._budget // 4))
+        self._features = [self._encode(config) for config in configs]
+        if self.prior is not None:
+            self._prior_order = sorted(range(num_configs), key=lambda i: self.prior(configs[i]))
+        else:
+            self._prior_order = list(range(num_configs))
+        self._pending: set[int] = set()
+        self._observed: dict[int, float | None] = {}
+
+    @staticmethod
+    def _encode(config: dict[str, Any]) -> dict[str, Any]:
+        # Tile sizes and stage counts matter by ratio, so compare them in log space.
+        features = {}
+        for key, value in config.items():
+            if isinstance(value, bool) or not isinstance(value, (int, float)):
+                features[key] = value
+            else:
+                features[key] = math.log2(value) if value > 0 else float(value)
+        return features
+
+    def _distance(self, i: int, j: int) -> float:
+        a, b = self._features[i], self._features[j]
+        distance = 0.0
+        for key in a.keys() | b.keys():
+            x, y = a.get(key), b.get(key)
+            if isinstance(x, float) and isinstance(y, float):
+                distance += abs(x - y)
+            else:
+                distance += 0.0 if x == y else 1.0
+        return distance
+
+    def _acquisition(self, index: int) -> float:
+        measured = [(self._distance(index, j), latency) for j, latency in self._observed.items()]
+        valid = [latency for _, latency in measured if latency is not None]
+        # A failed configuration counts as twice the worst measured latency,
+        # which steers the search away from its neighbourhood.
+        penalty = 2.0 * max(valid) if valid else 1.0
+        weight_sum, log_latency = 0.0, 0.0
+        for distance, latency in measured:
+            weight = 1.0 / (distance + 1e-3) ** 2
+            weight_sum += weight
+            log_latency += weight * math.log(max(latency if latency is not None else penalty, 1e-9))
+        nearest = min(distance for distance, _ in measured)
+        return log_latency / weight_sum - self.exploration * nearest
+
+    def propose(self, batch_size: int) -> list[int]:
+        remaining = self._budget - len(self._observed) - len(self._pending)
+        if remaining <= 0:
+            return []
+        batch_size = min(batch_size, remaining)
+        candidates = [i for i in self._prior_order if i not in self._observed and i not in self._pending]
+        num_observed = len(self._observed) + len(self._pending)
+        if num_observed < self._num_initial or not self._observed:
+            batch = candidates[: max(1, min(batch_size, self._num_initial - num_observed))]
+        else:
+            batch = sorted(candidates, key=self._acquisition)[:batch_size]
+        self._pending.update(batch)
+        return batch
+
+    def update(self, index: int, latency: float | None) -> None:
+        self._pending.discard(index)
+        self._observed[index] = latency
+
+
+def get_search_strategy(search: str | SearchStrategy | None) -> SearchStrategy | None:
+    """Resolve the ``search`` argument of the auto-tuner."""
+    if search is None or isinstance(search, SearchStrategy):
+        return search
+    if search == "exhaustive":
+        return ExhaustiveSearch()
+    if search == "model":
+        return ModelGuidedSearch()
+    raise ValueError(f"Unknown search strategy {search!r}, expected 'exhaustive', 'model' or a SearchStrategy")
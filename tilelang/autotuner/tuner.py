@@ -5,13 +5,14 @@ and performance optimization through configuration search.
 """
 
 from __future__ import annotations
-from dataclasses import dataclass
+from dataclasses import dataclass, replace
 
 import tilelang
 from tilelang import tvm as tvm
 from tilelang import env
 from tilelang.jit import JITImpl
 from tilelang.jit.kernel import JITKernel
+from tilelang.transform import PassConfigKey
 from tvm.tir import PrimFunc, Var
 from tvm.target import Target
 import inspect
@@ -38,8 +39,14 @@ from pathlib import Path
 
 from tilelang.autotuner.param import CompileArgs, ProfileArgs, AutotuneResult
 from tilelang.utils.language import get_prim_func_name
+from tilelang.utils.tensor import get_supply_pool
 from tilelang.autotuner.capture import get_autotune_inputs
+from tilelang.autotuner.search import SearchStrategy, get_search_strategy
+from tilelang.autotuner.objective import Objective, get_objective
+from tilelang.autotuner.database import TuningDatabase, get_database, op_signature, shape_of
+from tilelang.engine.resource import analyze_resources
 from tilelang.utils.target import determine_target
+from tilelang.carver.arch.calibration import profile_key
 from tilelang import __version__
 
 
@@ -126,6 +133,17 @@ class AutoTuner:
         self.jit_input_tensors = None
         self.ref_input_tensors = None
         self.jit_compile = None
+        self.pipeline = env.is_autotune_pipeline_enabled()
+        self.search_strategy: SearchStrategy | None = None
+        self.prune_ratio: float | None = None
+        self.resource_filter = False
+        # Elaborates a config into a PrimFunc without compiling it, used by the resource filter
+        self.jit_elaborate = None
+        self.database: TuningDatabase | None = None
+        self.database_neighbors = 0
+        self.database_top_configs = 4
+        self.objective: Objective = Objective()
+        self.screening_top_k: int | None = None
 
     @classmethod
     def from_kernel(cls, kernel: Callable, configs):
@@ -257,6 +275,156 @@ class AutoTuner:
 
         return self
 
+    def set_pipeline(self, enable: bool = True):
+        """Benchmark each configuration as soon as its compilation finishes.
+
+        By default all configurations are compiled before the first one is
+        benchmarked. In pipelined mode the GPU measures finished kernels while
+        the compile pool works on the remaining ones. Defaults to the
+        `TILELANG_AUTO_TUNING_PIPELINE` environment variable.
+
+        Returns:
+            AutoTuner: Self for method chaining.
+        """
+        self.pipeline = enable
+        return self
+
+    def set_search(self, strategy: str | SearchStrategy | None = None, prune_ratio: float | None = None):
+        """Configure how the tuning space is explored.
+
+        Args:
+            strategy: "exhaustive", "model" (a `ModelGuidedSearch` with default
+                settings) or a `SearchStrategy` instance. None keeps the default
+                sweep that compiles every configuration up front.
+            prune_ratio: Abort a candidate whose short probe run is slower than
+                `prune_ratio` times the best latency found so far; its probe
+                latency is reported instead of a full measurement.
+
+        Returns:
+            AutoTuner: Self for method chaining.
+        """
+        self.search_strategy = get_search_strategy(strategy)
+        if prune_ratio is not None and prune_ratio < 1.0:
+            raise ValueError(f"prune_ratio must be at least 1.0, got {prune_ratio}")
+        self.prune_ratio = prune_ratio
+        return self
+
+    def set_resource_filter(self, enable: bool = True):
+        """Discard configurations whose lowered kernels cannot run before compiling them.
+
+        Each configuration is lowered without device compilation and analyzed
+        with `tilelang.engine.resource.analyze_resources`. Configurations that
+        exceed the shared memory or thread limits, or whose register estimate
+        implies spilling, are skipped.
+
+        Returns:
+            AutoTuner: Self for method chaining.
+        """
+        self.resource_filter = enable
+        return self
+
+    def set_objective(self, objective: str | Objective | None = None):
+        """Rank the configurations by another objective than their latency.
+
+        Args:
+            objective: "latency", "energy", "budget", "sm_time" or an
+                `Objective` instance, see `tilelang.autotuner.objective`.
+
+        Returns:
+            AutoTuner: Self for method chaining.
+        """
+        self.objective = get_objective(objective)
+        return self
+
+    def set_screening(self, top_k: int | None = 4):
+        """Screen the configurations with fast compiles before compiling the best ones fully.
+
+        Every configuration is first compiled with `tl.fast_compile`, which
+        skips the passes that mostly cost compile time and lowers the ptxas
+        optimization level, and benchmarked to rank it. Only the `top_k` best
+        ranked configurations are then compiled with every optimization and
+        benchmarked again, the best of them is the result. The fast kernels
+        rank close to the fully optimized ones, so wide sweeps compile several
+        times faster for a small risk of missing the best configuration.
+
+        Args:
+            top_k: Configurations re-compiled with every optimization, None
+                compiles every configuration fully.
+
+        Returns:
+            AutoTuner: Self for method chaining.
+        """
+        if top_k is not None and top_k < 1:
+            raise ValueError(f"top_k must be at least 1, got {top_k}")
+        self.screening_top_k = top_k
+        return self
+
+    def set_database(self, database: str | TuningDatabase | None = None, neighbors: int = 2, top_configs: int = 4):
+        """Answer untuned shapes from the configurations of similar tuned shapes.
+
+        The best configurations of every tuning run are recorded in a shared
+        `TuningDatabase`. With `neighbors` > 0, a shape missing from the cache
+        only benchmarks the best `top_configs` configurations of each of the
+        `neighbors` closest shapes tuned for the same op and device, and falls
+        back to the full space when none of them is usable.
+
+        Args:
+            database: Path or instance of the database, defaults to
+                `TILELANG_AUTO_TUNING_DATABASE` or one in the cache directory.
+            neighbors: Number of closest tuned shapes to take configurations
+                from, 0 always tunes the full space.
+            top_configs: Configurations re-validated per neighboring shape.
+
+        Returns:
+            AutoTuner: Self for method chaining.
+        """
+        self.database = database if isinstance(database, TuningDatabase) else get_database(database)
+        self.database_neighbors = neighbors
+        self.database_top_configs = top_configs
+        return self
+
+    def _tuning_problem(self, extra_parameters: dict[str, Any]) -> tuple[str, str | None, dict[str, Any]]:
+        """The `(op, device, shape)` a tuning run is recorded under in the database."""
+        named_parameters = dict(extra_parameters)
+        if self._kernel_parameters is not None:
+            key_args_tuple, key_kwargs_tuple = self._kernel_parameters
+            names = list(self._function_parameters.keys()) if self._function_parameters else []
+            for i, value in enumerate(key_args_tuple):
+                named_parameters[names[i] if i < len(names) else f"arg{i}"] = value
+            named_parameters.update(key_kwargs_tuple)
+        named_parameters = {
+            name: str(value) if isinstance(value, Var) else value for name, value in named_parameters.items()
+        }
+        # scores of different objectives are not comparable
+        named_parameters["__objective__"] = repr(self.objective)
+        op = op_signature(inspect.getsource(self.fn), named_parameters, self.compile_args)
+        device = profile_key(torch.cuda.current_device()) if torch.cuda.is_available() else None
+        return op, device, shape_of(named_parameters)
+
+    def _filter_infeasible(self, config_args: list[dict[str, Any]], pool: concurrent.futures.Executor) -> list[dict[str, Any]]:
+        compile_args = self.compile_args
+        elaborate = self.jit_elaborate if self.jit_elaborate is not None else self.fn
+
+        def analyze(config_arg):
+            with tvm.transform.PassContext(opt_level=3, config=compile_args.pass_configs or {}):
+                return analyze_resources(elaborate(**config_arg), target=compile_args.target, target_host=compile_args.target_host)
+
+        futures = [pool.submit(analyze, config_arg) for config_arg in config_args]
+        feasible_configs = []
+        for config_arg, future in zip(config_args, futures):
+            try:
+                infos = future.result()
+            except Exception as e:
+                logger.debug(f"Lowering failed for config {config_arg} with error: {e}")
+                continue
+            infeasible = [info for info in infos if not info.feasible]
+            if infeasible:
+                logger.debug(f"Skipping infeasible config {config_arg}: {infeasible}")
+                continue
+            feasible_configs.append(config_arg)
+        logger.info(f"Resource filter kept {len(feasible_configs)} of {len(config_args)} configurations")
+        return feasible_configs
+
     def set_kernel_parameters(self, k_parameters: tuple[str, ...], f_parameters: dict[str, Any]):
         # for cache key generation
         self._kernel_parameters = k_parameters
@@ -292,6 +460,9 @@ class AutoTuner:
             "configs": self.configs,
             "compile_args": hash(self.compile_args),
             "profile_args": hash(self.profile_args),
+            "objective": repr(self.objective),
+            # results tuned on one SKU or clock do not carry over to another
+            "device": profile_key(torch.cuda.current_device()) if torch.cuda.is_available() else None,
         }
         # Sort keys to ensure consistency
         key_string = json.dumps(key_data, sort_keys=True)
@@ -390,6 +561,8 @@ class AutoTuner:
             max_mismatched_ratio = profile_args.max_mismatched_ratio
 
             profiler = jit_kernel.get_profiler(tensor_supply_type=supply_type)
+            if env.is_autotune_supply_pool_enabled():
+                profiler.supply_pool = get_supply_pool()
 
             # Factory functions for generating input tensors.
             # This encapsulates the logic of using either a custom supply program (`supply_prog`)
@@ -448,13 +621,21 @@ class AutoTuner:
                     profiler.assert_allclose(
                         ref_prog, input_tensors=self.jit_input_tensors, rtol=rtol, atol=atol, max_mismatched_ratio=max_mismatched_ratio
                     )
+            # the best score is only a latency to compare with for the latency objective
+            if self.prune_ratio is not None and best_kernel is not None and type(self.objective) is Objective:
+                # A few timed iterations are enough to reject a clearly slower candidate.
+                probe_latency = profiler.do_bench(warmup=1, rep=max(1, rep // 10), input_tensors=self.jit_input_tensors)
+                if probe_latency > self.prune_ratio * best_latency:
+                    logger.debug(f"Pruned candidate with probe latency {probe_latency}, best latency {best_latency}")
+                    return probe_latency, self.ref_latency_cache, {}
             latency = profiler.do_bench(warmup=warmup, rep=rep, input_tensors=self.jit_input_tensors)
+            metrics = self.objective.measure(jit_kernel, profiler, self.jit_input_tensors, latency)
 
             if self.ref_latency_cache is None and ref_prog is not None:
                 self.ref_input_tensors = ref_input_tensors_supply()
                 self.ref_latency_cache = profiler.do_bench(ref_prog, n_warmup=warmup, n_repeat=rep, input_tensors=self.ref_input_tensors)
 
-            return latency, self.ref_latency_cache
+            return latency, self.ref_latency_cache, metrics
 
         config_args = []
         for config in self.configs:
@@ -520,6 +701,44 @@ class AutoTuner:
         futures = []
         future_to_index = {}
 
+        use_database = self.database is not None or (env.is_cache_enabled() and not env.is_autotune_cache_disabled())
+        database = (self.database or get_database()) if use_database else None
+        if database is not None:
+            problem = self._tuning_problem(extra_parameters)
+        transferred = False
+        if database is not None and self.database_neighbors > 0:
+            candidates = {
+                json.dumps(config, sort_keys=True, default=str)
+                for config in database.candidates(*problem, self.database_neighbors, self.database_top_configs)
+            }
+            # the database holds configs as JSON, match them by their serialization
+            transferred_configs = [
+                config for config in config_args if json.dumps(config, sort_keys=True, default=str) in candidates
+            ]
+            if transferred_configs:
+                logger.info(
+                    f"Re-validating {len(transferred_configs)} configurations of similar tuned shapes "
+                    f"instead of {len(config_args)}"
+                )
+                config_args = transferred_configs
+                transferred = True
+
+        if self.resource_filter:
+            config_args = self._filter_infeasible(config_args, pool)
+
+        candidate_compile = self.jit_compile
+        # Screening only pays off when it leaves configurations out
+        screening = self.screening_top_k is not None and len(config_args) > self.screening_top_k
+        if screening:
+            screening_args = replace(
+                self.compile_args, pass_configs={**(self.compile_args.pass_configs or {}), PassConfigKey.TL_FAST_COMPILE: True}
+            )
+            elaborate = self.jit_elaborate if self.jit_elaborate is not None else self.fn
+
+            # Not through jit_compile, whose kernels are cached without the pass configs
+            def candidate_compile(**config_arg) -> tilelang.JITKernel:
+                return screening_args.compile_program(elaborate(**config_arg))
+
         def cuda_device_wrapper(func, device):
             def inner(**config_arg):
                 torch.cuda.set_device(device)
@@ -527,64 +746,168 @@ class AutoTuner:
 
             return inner
 
-        for i, config_arg in enumerate(config_args):
-            compile_func = self.jit_compile
-
+        def submit(i: int, compile_func: Callable = candidate_compile) -> concurrent.futures.Future:
             if torch.cuda.is_available():
                 device = torch.cuda.current_device()
 
-                compile_func = cuda_device_wrapper(self.jit_compile, device)
+                compile_func = cuda_device_wrapper(compile_func, device)
 
             future = pool.submit(
                 compile_func,
-                **config_arg,
+                **config_args[i],
             )
             futures.append(future)
             future_to_index[future] = i
+            return future
 
-        results_with_configs = []
-        for future in tqdm(concurrent.futures.as_completed(futures), total=len(futures), desc="Compiling configurations"):
-            idx = future_to_index[future]
-            config = config_args[idx]
-            try:
-                result = future.result()
-                results_with_configs.append((result, config))
-            except Exception as e:
-                logger.debug(f"Compilation failed for config {config} at index {idx} with error: {e}")
-                continue
+        if self.search_strategy is None:
+            for i in range(len(config_args)):
+                submit(i)
 
         ref_latency = None
-        progress_bar = tqdm(range(len(results_with_configs)), desc="Bench configurations")
-        for i in progress_bar:
-            jit_kernel, config = results_with_configs[i]
+        # every successful measurement, recorded in the tuning database
+        measured: list[tuple[dict[str, Any], float]] = []
+        # latency and objective metrics of every benchmarked kernel, by id
+        kernel_measurements: dict[int, tuple[float, dict[str, Any]]] = {}
+
+        def bench(jit_kernel: tilelang.JITKernel, config: dict[str, Any], idx: int) -> float | None:
+            nonlocal ref_latency
             try:
                 # Cannot ThreadPoolExecutor to enforce timeout on target_fn execution
                 # Because tma init may behave strangely with one thread
                 # latency, ref_latency = target_fn(jit_kernel)
-                latency, ref_latency = run_with_timeout(target_fn, timeout, jit_kernel)
+                latency, ref_latency, metrics = run_with_timeout(target_fn, timeout, jit_kernel)
             except TimeoutException:
                 logger.warning(f"A timeout occurred while testing config {config}, checkout autotuner.log for more details")
-                continue
+                return None
             except Exception:
                 logger.warning(f"An error occurred while testing config {config}, checkout autotuner.log for more details")
                 logger.debug(f"Error: {traceback.format_exc()}")
-                continue
-
-            if latency < best_latency:
-                best_latency = latency
-                best_config = config
-                best_kernel = jit_kernel
+                return None
+            score = self.objective.score(latency, metrics)
+            if type(self.objective) is Objective:
+                tqdm.write(f"Tuned Latency {latency} with config {config} at index {idx}")
+            else:
+                tqdm.write(f"Tuned {self.objective.name} {score} (latency {latency}, {metrics}) with config {config} at index {idx}")
+            if score == float("inf"):
+                logger.debug(f"Config {config} rejected by the {self.objective.name} objective: {metrics}")
+                return None
+            kernel_measurements[id(jit_kernel)] = (latency, metrics)
+            measured.append((config, score))
+            return score
+
+        if self.search_strategy is not None:
+            # The strategy proposes one batch per round, and learns from its
+            # latencies before proposing the next one.
+            strategy = self.search_strategy
+            strategy.reset(config_args)
+            progress_bar = tqdm(desc="Searching configurations")
+            while batch := strategy.propose(num_workers):
+                for future in concurrent.futures.as_completed([submit(i) for i in batch]):
+                    idx = future_to_index[future]
+                    config = config_args[idx]
+                    try:
+                        jit_kernel = future.result()
+                    except Exception as e:
+                        logger.debug(f"Compilation failed for config {config} at index {idx} with error: {e}")
+                        strategy.update(idx, None)
+                        progress_bar.update()
+                        continue
+                    latency = bench(jit_kernel, config, idx)
+                    strategy.update(idx, latency)
+                    if latency is not None and latency < best_latency:
+                        best_latency = latency
+                        best_config = config
+                        best_kernel = jit_kernel
+                    progress_bar.update()
+                    progress_bar.set_postfix({"best_latency": best_latency})
+            progress_bar.close()
+        elif self.pipeline:
+            # Benchmark every kernel as soon as it is compiled, the remaining
+            # configurations keep compiling in the pool in the meantime.
+            progress_bar = tqdm(concurrent.futures.as_completed(futures), total=len(futures), desc="Compiling and benching configurations")
+            for future in progress_bar:
+                idx = future_to_index[future]
+                config = config_args[idx]
+                try:
+                    jit_kernel = future.result()
+                except Exception as e:
+                    logger.debug(f"Compilation failed for config {config} at index {idx} with error: {e}")
+                    continue
+                latency = bench(jit_kernel, config, idx)
+                if latency is not None and latency < best_latency:
+                    best_latency = latency
+                    best_config = config
+                    best_kernel = jit_kernel
+                progress_bar.set_postfix({"best_latency": best_latency})
+        else:
+            results_with_configs = []
+            for future in tqdm(concurrent.futures.as_completed(futures), total=len(futures), desc="Compiling configurations"):
+                idx = future_to_index[future]
+                config = config_args[idx]
+                try:
+                    result = future.result()
+                    results_with_configs.append((result, config))
+                except Exception as e:
+                    logger.debug(f"Compilation failed for config {config} at index {idx} with error: {e}")
+                    continue
 
-            progress_bar.set_postfix({"best_latency": best_latency})
-            tqdm.write(f"Tuned Latency {latency} with config {config} at index {i}")
+            progress_bar = tqdm(range(len(results_with_configs)), desc="Bench configurations")
+            for i in progress_bar:
+                jit_kernel, config = results_with_configs[i]
+                latency = bench(jit_kernel, config, i)
+                if latency is not None and latency < best_latency:
+                    best_latency = latency
+                    best_config = config
+                    best_kernel = jit_kernel
+                progress_bar.set_postfix({"best_latency": best_latency})
+
+        if screening and best_kernel is not None:
+            # Rank by the screening scores, measure the finalists fully optimized
+            config_args = [config for config, _ in sorted(measured, key=lambda m: m[1])[: self.screening_top_k]]
+            measured.clear()
+            best_latency, best_config, best_kernel = 1e8, None, None
+            futures.clear()
+            future_to_index.clear()
+            for i in range(len(config_args)):
+                submit(i, self.jit_compile)
+            progress_bar = tqdm(
+                concurrent.futures.as_completed(futures), total=len(futures), desc="Compiling and benching the screened configurations"
+            )
+            for future in progress_bar:
+                idx = future_to_index[future]
+                config = config_args[idx]
+                try:
+                    jit_kernel = future.result()
+                except Exception as e:
+                    logger.debug(f"Compilation failed for config {config} at index {idx} with error: {e}")
+                    continue
+                latency = bench(jit_kernel, config, idx)
+                if latency is not None and latency < best_latency:
+                    best_latency = latency
+                    best_config = config
+                    best_kernel = jit_kernel
+                progress_bar.set_postfix({"best_latency": best_latency})
 
         pool.shutdown()
 
+        if best_kernel is None and transferred:
+            logger.warning("None of the configurations of similar tuned shapes is usable, tuning the full space")
+            neighbors, self.database_neighbors = self.database_neighbors, 0
+            try:
+                return AutoTuner.run(self, warmup, rep, timeout)
+            finally:
+                self.database_neighbors = neighbors
+
         if best_kernel is None:
             error_msg = "Auto-tuning failed: No configuration successfully compiled and passed benchmarking/validation."
             logger.error(error_msg)
             raise RuntimeError(error_msg)
 
+        # the loops above ranked the kernels by their score
+        best_score = best_latency
+        best_latency, best_metrics = kernel_measurements[id(best_kernel)]
+
         best_kernel: tilelang.JITKernel = best_kernel.update_tuner_result(
             latency=best_latency,
             config=best_config,
@@ -598,6 +921,9 @@ class AutoTuner:
             libcode=best_kernel.get_kernel_source(),
             func=best_kernel.prim_func,
             kernel=best_kernel,
+            objective=self.objective.name,
+            score=best_score,
+            metrics=best_metrics,
         )
 
         if self.compile_args.execution_backend in ("torch"):
@@ -607,6 +933,12 @@ class AutoTuner:
                 if env.is_cache_enabled() and not env.is_autotune_cache_disabled():
                     self._save_result_to_disk(key, autotuner_result)
 
+        if database is not None:
+            try:
+                database.put(*problem, measured, top_k=max(self.database_top_configs, 8))
+            except OSError as e:
+                logger.warning(f"Failed to record the tuning results in {database.path}: {e}")
+
         self._memory_cache[key] = autotuner_result
 
         return autotuner_result
@@ -641,6 +973,13 @@ class AutoTuneImpl(Generic[_P, _T]):
     skip_check: bool = False
     manual_check_prog: Callable = None
     cache_input_tensors: bool = False
+    pipeline: bool | None = None
+    search: str | SearchStrategy | None = None
+    prune_ratio: float | None = None
+    resource_filter: bool = False
+    database_neighbors: int = 0
+    objective: str | Objective | None = None
+    screening_top_k: int | None = None
 
     def __post_init__(self):
         self._tuner_cache = {}
@@ -668,6 +1007,14 @@ class AutoTuneImpl(Generic[_P, _T]):
                 pass_configs=self.jit_impl.pass_configs,
             )
         )
+        if self.pipeline is not None:
+            autotuner.set_pipeline(self.pipeline)
+        autotuner.set_search(self.search, self.prune_ratio)
+        autotuner.set_resource_filter(self.resource_filter)
+        if self.database_neighbors > 0:
+            autotuner.set_database(neighbors=self.database_neighbors)
+        autotuner.set_objective(self.objective)
+        autotuner.set_screening(self.screening_top_k)
         autotuner.run = partial(autotuner.run, self.warmup, self.rep, self.timeout)
         return autotuner
 
@@ -680,8 +1027,12 @@ class AutoTuneImpl(Generic[_P, _T]):
             def jit_compile(**config_arg):
                 return self.jit_impl(*args, **kwargs, __tune_params=config_arg)
 
+            def jit_elaborate(**config_arg):
+                return self.jit_impl.get_tir(*args, **kwargs, **config_arg)
+
             autotuner = self.get_tunner()
             autotuner.jit_compile = jit_compile
+            autotuner.jit_elaborate = jit_elaborate
             autotuner.set_kernel_parameters(key, self.jit_impl.signature.parameters)
             artifact = autotuner.run()
             self._tuner_cache[key] = artifact.kernel
@@ -706,6 +1057,13 @@ def autotune(  # This is the new public interface
     skip_check: bool = False,
     manual_check_prog: Callable = None,
     cache_input_tensors: bool = False,
+    pipeline: bool | None = None,
+    search: str | SearchStrategy | None = None,
+    prune_ratio: float | None = None,
+    resource_filter: bool = False,
+    database_neighbors: int = 0,
+    objective: str | Objective | None = None,
+    screening_top_k: int | None = None,
 ):
     """
     Just-In-Time (JIT) compiler decorator for TileLang functions.
@@ -736,6 +1094,30 @@ def autotune(  # This is the new public interface
     rep : int, optional
         Number of repetitions for timing measurements.
     timeout : int, optional
+    pipeline : bool, optional
+        Benchmark each configuration as soon as it is compiled, overlapping the
+        remaining compilations with GPU measurement. Defaults to the
+        `TILELANG_AUTO_TUNING_PIPELINE` environment variable.
+    search : Union[str, SearchStrategy], optional
+        Search strategy over `configs`: "exhaustive", "model" or a
+        `SearchStrategy` instance. Defaults to evaluating every configuration.
+    prune_ratio : float, optional
+        Abort candidates whose short probe run is slower than `prune_ratio`
+        times the current best latency. Defaults to None (no pruning).
+    resource_filter : bool, optional
+        Lower every configuration first and skip those exceeding shared memory,
+        thread or register limits before invoking the device compiler.
+    database_neighbors : int, optional
+        On a cache miss, only re-validate the best configurations of this many
+        closest shapes tuned for the same kernel in the tuning database
+        (`TILELANG_AUTO_TUNING_DATABASE`). Defaults to 0 (tune the full space).
+    objective : Union[str, Objective], optional
+        What the best configuration minimizes: "latency" (default), "energy",
+        "budget", "sm_time" or an `Objective` instance.
+    screening_top_k : int, optional
+        Rank every configuration compiled with `tl.fast_compile` and only
+        compile the best `screening_top_k` ones fully. Defaults to None
+        (compile every configuration fully).
     target : Union[str, Target], optional
         Compilation target for TVM (e.g., "cuda", "llvm"). Defaults to "auto".
     target_host : Union[str, Target], optional
@@ -781,6 +1163,13 @@ def autotune(  # This is the new public interface
                 skip_check=skip_check,
                 manual_check_prog=manual_check_prog,
                 cache_input_tensors=cache_input_tensors,
+                pipeline=pipeline,
+                search=search,
+                prune_ratio=prune_ratio,
+                resource_filter=resource_filter,
+                database_neighbors=database_neighbors,
+                objective=objective,
+                screening_top_k=screening_top_k,
             )
 
         return decorator
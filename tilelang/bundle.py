@@ -0,0 +1,283 @@
+"""Ahead-of-time kernel bundles.
+
+A bundle packs many compiled kernels into one file together with a dispatch
+table keyed by specialization, e.g. ``"M=16"`` or ``"M=4096,dtype=bf16"``::
+
+    # build machine
+    kernels = {specialization_key(M=m): matmul(m, N, K) for m in (16, 64, 256)}
+    tilelang.bundle.export_bundle(kernels, "matmul.tlb")
+
+    # serving container
+    bundle = tilelang.bundle.load_bundle("matmul.tlb")
+    C = bundle[specialization_key(M=16)](A, B)
+
+Kernels must be compiled with the ``cython`` execution backend, whose host
+library is a self-contained C ABI (``init``/``call``) with the device binary
+embedded. The bundle is an uncompressed zip archive holding those libraries
+and a JSON manifest with the parameter metadata of every kernel.
+
+A kernel may also be a :class:`tilelang.jit.MultiArchKernel`: the bundle then
+holds the library of every architecture it was compiled for and loads the
+one matching the compute capability of the current device, so a single
+bundle built on a CPU-only machine serves a mixed fleet of GPUs.
+
+Loading only depends on the standard library and torch: set
+``TILELANG_LIGHT_IMPORT=1`` before importing ``tilelang.bundle`` to skip
+loading TVM and the compiler. Libraries are opened lazily, on the first call
+of each specialization.
+"""
+
+from __future__ import annotations
+
+import ctypes
+import json
+import os
+import re
+import tempfile
+import threading
+import zipfile
+from collections.abc import Mapping, Sequence
+from typing import TYPE_CHECKING, Any
+
+if TYPE_CHECKING:
+    from tilelang.jit.kernel import JITKernel
+
+BUNDLE_FORMAT_VERSION = 2
+# Version 1 bundles hold a single library per kernel.
+_SUPPORTED_FORMAT_VERSIONS = (1, 2)
+_MANIFEST_NAME = "manifest.json"
+
+# The architecture helpers of tilelang.jit.multi_arch live here, so that loading
+# a bundle does not import the compiler.
+_ARCH_PATTERN = re.compile(r"^sm_(\d+)(\d)([af]?)$")
+
+
+def parse_arch(arch: str) -> tuple[int, int, str]:
+    """Split an architecture such as ``"sm_90a"`` into ``(9, 0, "a")``."""
+    match = _ARCH_PATTERN.match(arch)
+    if match is None:
+        raise ValueError(f"Invalid CUDA architecture {arch!r}, expected e.g. 'sm_80' or 'sm_90a'")
+    return int(match.group(1)), int(match.group(2)), match.group(3)
+
+
+def arch_runs_on(arch: str, capability: tuple[int, int]) -> bool:
+    """Whether the SASS of `arch` runs on a device of the given compute capability.
+
+    SASS is compatible with later minor versions of the same major version.
+    Architecture specific targets (``sm_90a``) only run on their exact
+    capability, family specific ones (``sm_100f``) on every minor version of
+    their family from their own on.
+    """
+    major, minor, suffix = parse_arch(arch)
+    if suffix == "a":
+        return (major, minor) == tuple(capability)
+    return major == capability[0] and minor <= capability[1]
+
+
+def select_arch(archs: Sequence[str], capability: tuple[int, int]) -> str | None:
+    """The most specific of `archs` that runs on `capability`, None if none does."""
+
+    def specificity(arch):
+        major, minor, suffix = parse_arch(arch)
+        return (major, minor, {"a": 2, "f": 1}.get(suffix, 0))
+
+    candidates = [arch for arch in archs if arch_runs_on(arch, capability)]
+    return max(candidates, key=specificity) if candidates else None
+
+
+def specialization_key(**values: Any) -> str:
+    """Canonical dispatch key of a specialization, ``k=v`` pairs sorted by name."""
+    return ",".join(f"{name}={values[name]}" for name in sorted(values))
+
+
+def _describe_kernel(kernel: JITKernel) -> dict[str, Any]:
+    from tvm import tir
+
+    adapter = kernel.adapter
+    if kernel.execution_backend != "cython":
+        raise ValueError(f"Only kernels compiled with execution_backend='cython' can be bundled, got {kernel.execution_backend!r}")
+
+    params = []
+    for param in kernel.params:
+        shape = [int(dim) if isinstance(dim, (int, tir.IntImm)) else str(dim) for dim in param.shape]
+        params.append({"dtype": str(param.torch_dtype()).replace("torch.", ""), "shape": shape})
+    # Dynamic symbols are appended to the call arguments in this order.
+    dynamic_symbolic = [[str(var), ref_id, buffer_idx, dim] for var, (ref_id, buffer_idx, dim) in adapter.dynamic_symbolic_map.items()]
+    return {
+        "name": kernel.prim_func.attrs["global_symbol"],
+        "params": params,
+        "result_idx": list(adapter.result_idx),
+        "ptr_params": sorted(adapter.ptr_map),
+        "dynamic_symbolic": dynamic_symbolic,
+    }
+
+
+def export_bundle(kernels: Mapping[str, JITKernel], path: str) -> None:
+    """Write compiled kernels into a bundle.
+
+    Parameters
+    ----------
+    kernels : Mapping[str, JITKernel]
+        Kernels keyed by specialization, see :func:`specialization_key`.
+    path : str
+        Output bundle file.
+    """
+    if not kernels:
+        raise ValueError("Cannot export an empty bundle")
+    manifest = {"version": BUNDLE_FORMAT_VERSION, "kernels": {}}
+    dir_path = os.path.dirname(path)
+    if dir_path:
+        os.makedirs(dir_path, exist_ok=True)
+    with zipfile.ZipFile(path, "w", compression=zipfile.ZIP_STORED) as archive:
+        for i, (key, kernel) in enumerate(kernels.items()):
+            variants = getattr(kernel, "kernels", None)
+            if variants is None:
+                entry = _describe_kernel(kernel)
+                entry["lib"] = f"kernels/{i}.so"
+                archive.write(kernel.adapter.libpath, entry["lib"])
+            else:
+                # the variants share the host signature of the program
+                entry = _describe_kernel(next(iter(variants.values())))
+                entry["libs"] = {}
+                for arch, variant in variants.items():
+                    entry["libs"][arch] = f"kernels/{i}.{arch}.so"
+                    archive.write(variant.adapter.libpath, entry["libs"][arch])
+            manifest["kernels"][key] = entry
+        archive.writestr(_MANIFEST_NAME, json.dumps(manifest, indent=2))
+
+
+class BundledKernel:
+    """A precompiled kernel of a bundle, callable like a JITKernel."""
+
+    def __init__(self, bundle: KernelBundle, key: str, entry: dict[str, Any]):
+        import torch
+
+        self.key = key
+        self.name = entry["name"]
+        self._bundle = bundle
+        self._entry = entry
+        self._lib = None
+        self._lock = threading.Lock()
+        self.result_idx = entry["result_idx"]
+        self._ptr_params = set(entry["ptr_params"])
+        self._dtypes = [getattr(torch, param["dtype"]) for param in entry["params"]]
+        self._shapes = [param["shape"] for param in entry["params"]]
+        self._dynamic_symbolic = entry["dynamic_symbolic"]
+        self._symbol_refs = {name: (buffer_idx, dim) for name, ref_id, buffer_idx, dim in self._dynamic_symbolic if ref_id == 0}
+
+    def _lib_member(self) -> str:
+        if "libs" not in self._entry:
+            return self._entry["lib"]
+        import torch
+
+        capability = torch.cuda.get_device_capability()
+        arch = select_arch(list(self._entry["libs"]), capability)
+        if arch is None:
+            raise RuntimeError(
+                f"Bundled kernel {self.key!r} has no variant for compute capability {capability[0]}.{capability[1]}, "
+                f"compiled for {list(self._entry['libs'])}"
+            )
+        return self._entry["libs"][arch]
+
+    def _load(self):
+        if self._lib is None:
+            with self._lock:
+                if self._lib is None:
+                    lib = ctypes.CDLL(self._bundle._extract(self._lib_member()))
+                    lib.get_last_error.restype = ctypes.c_char_p
+                    if lib.init() != 0:
+                        raise RuntimeError(f"Initialization of bundled kernel {self.key!r} failed: {lib.get_last_error().decode()}")
+                    self._lib = lib
+        return self._lib
+
+    def __call__(self, *inputs: Any, stream: int | None = None) -> Any:
+        import torch
+
+        lib = self._load()
+        num_params = len(self._dtypes)
+        if num_params != len(inputs) + len(self.result_idx):
+            raise ValueError(f"Expected {num_params - len(self.result_idx)} inputs, got {len(inputs)}")
+        if stream is None:
+            stream = torch.cuda.current_stream().cuda_stream if torch.cuda.is_available() else 0
+
+        args: list[Any] = []
+        inputs_iter = iter(inputs)
+        device = next((t.device for t in inputs if isinstance(t, torch.Tensor)), None)
+        for i in range(num_params):
+            if i in self.result_idx:
+                shape = [dim if isinstance(dim, int) else args[self._symbol_refs[dim][0]].shape[self._symbol_refs[dim][1]] for dim in self._shapes[i]]
+                args.append(torch.empty(*shape, dtype=self._dtypes[i], device=device))
+            else:
+                args.append(next(inputs_iter))
+
+        call_args = []
+        for i, arg in enumerate(args):
+            if isinstance(arg, torch.Tensor):
+                call_args.append(ctypes.c_void_p(arg.data_ptr()))
+            elif arg is None or i in self._ptr_params:
+                call_args.append(ctypes.c_void_p(arg or 0))
+            elif self._dtypes[i].is_floating_point:
+                call_args.append(ctypes.c_double(arg) if self._dtypes[i] == torch.float64 else ctypes.c_float(arg))
+            elif self._dtypes[i] == torch.bool:
+                call_args.append(ctypes.c_bool(arg))
+            else:
+                call_args.append(ctypes.c_int64(arg) if self._dtypes[i] == torch.int64 else ctypes.c_int32(arg))
+        for _, ref_id, buffer_idx, dim in self._dynamic_symbolic:
+            tensor = args[buffer_idx]
+            call_args.append(ctypes.c_int64(tensor.shape[dim] if ref_id == 0 else tensor.stride(dim)))
+        call_args.append(ctypes.c_void_p(stream))
+
+        if lib.call(*call_args) != 0:
+            raise RuntimeError(f"Bundled kernel {self.key!r} failed: {lib.get_last_error().decode()}")
+        outputs = [args[i] for i in self.result_idx]
+        return outputs[0] if len(outputs) == 1 else outputs
+
+    def __repr__(self) -> str:
+        return f"BundledKernel({self.key!r}, name={self.name!r})"
+
+
+class KernelBundle(Mapping):
+    """Dispatch table of a bundle file, mapping specialization keys to kernels."""
+
+    def __init__(self, path: str):
+        self.path = os.path.abspath(path)
+        self._archive = zipfile.ZipFile(self.path)
+        manifest = json.loads(self._archive.read(_MANIFEST_NAME))
+        if manifest.get("version") not in _SUPPORTED_FORMAT_VERSIONS:
+            raise ValueError(f"Unsupported bundle format version {manifest.get('version')} in {path}")
+        self._kernels = {key: BundledKernel(self, key, entry) for key, entry in manifest["kernels"].items()}
+        self._extract_dir: str | None = None
+        self._extract_lock = threading.Lock()
+
+    def _extract(self, member: str) -> str:
+        data = self._archive.read(member)
+        # dlopen needs a path, an anonymous memory file avoids touching the disk.
+        if hasattr(os, "memfd_create"):
+            fd = os.memfd_create(os.path.basename(member))
+            os.write(fd, data)
+            return f"/proc/self/fd/{fd}"
+        with self._extract_lock:
+            if self._extract_dir is None:
+                self._extract_dir = tempfile.mkdtemp(prefix="tilelang_bundle_")
+        lib_path = os.path.join(self._extract_dir, member.replace("/", "_"))
+        with open(lib_path, "wb") as f:
+            f.write(data)
+        return lib_path
+
+    def __getitem__(self, key: str) -> BundledKernel:
+        return self._kernels[key]
+
+    def __iter__(self):
+        return iter(self._kernels)
+
+    def __len__(self) -> int:
+        return len(self._kernels)
+
+    def dispatch(self, **values: Any) -> BundledKernel:
+        """Look up the kernel of a specialization given as keyword arguments."""
+        return self._kernels[specialization_key(**values)]
+
+
+def load_bundle(path: str) -> KernelBundle:
+    """Open a bundle written by :func:`export_bundle`."""
+    return KernelBundle(path)
@@ -4,27 +4,33 @@ from __future__ import annotations
 
 import logging
 from typing import TYPE_CHECKING, Literal
-from tvm.target import Target
-from tvm.tir import PrimFunc
-from tilelang.jit import JITKernel
 from tilelang import env
-from tilelang.jit.adapter.cutedsl.kernel_cache import CuTeDSLKernelCache
-from tilelang.jit.adapter.cython.kernel_cache import CythonKernelCache
-from tilelang.jit.adapter.nvrtc.kernel_cache import NVRTCKernelCache
-from tilelang.jit.adapter.torch.kernel_cache import TorchKernelCache
-from tilelang.jit.adapter.kernel_cache import TVMFFIKernelCache
+from tilelang.cache.gc import cache_stats, collect_garbage  # noqa: F401
 
 if TYPE_CHECKING:
+    from tvm.target import Target
+    from tvm.tir import PrimFunc
+    from tilelang.jit import JITKernel
     from .kernel_cache import KernelCache
 
-# Create a map of singleton instance of KernelCaches
-_dispatch_map: dict[str, KernelCache] = {
-    "tvm_ffi": TVMFFIKernelCache(),
-    "cython": CythonKernelCache(),
-    "nvrtc": NVRTCKernelCache(),
-    "cutedsl": CuTeDSLKernelCache(),
-    "torch": TorchKernelCache(),
-}
+# `python -m tilelang.cache` only needs the disk cache maintenance helpers
+if not env.is_light_import():
+    from tvm.target import Target
+    from tilelang.jit.adapter.cutedsl.kernel_cache import CuTeDSLKernelCache
+    from tilelang.jit.adapter.cython.kernel_cache import CythonKernelCache
+    from tilelang.jit.adapter.nvrtc.kernel_cache import NVRTCKernelCache
+    from tilelang.jit.adapter.torch.kernel_cache import TorchKernelCache
+    from tilelang.jit.adapter.kernel_cache import TVMFFIKernelCache
+    from tilelang.cache.remote import RemoteCache, set_remote_cache, get_remote_cache  # noqa: F401
+
+    # Create a map of singleton instance of KernelCaches
+    _dispatch_map: dict[str, KernelCache] = {
+        "tvm_ffi": TVMFFIKernelCache(),
+        "cython": CythonKernelCache(),
+        "nvrtc": NVRTCKernelCache(),
+        "cutedsl": CuTeDSLKernelCache(),
+        "torch": TorchKernelCache(),
+    }
 
 
 def cached(
@@ -0,0 +1,35 @@
+"""Inspect and trim the kernel disk cache without importing the compiler.
+
+    python -m tilelang.cache stats
+    python -m tilelang.cache gc --max-size 20G [--dry-run]
+"""
+
+from __future__ import annotations
+
+from argparse import ArgumentParser
+
+from tilelang.cache.gc import cache_stats, collect_garbage, format_size
+
+
+def main(argv: list[str] | None = None) -> None:
+    parser = ArgumentParser(prog="python -m tilelang.cache", description="Manage the TileLang kernel disk cache")
+    parser.add_argument("--cache-dir", default=None, help="cache directory, TILELANG_CACHE_DIR by default")
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("stats", help="print the size of the parts of the cache")
+    gc = commands.add_parser("gc", help="evict the least recently used entries")
+    gc.add_argument("--max-size", default=None, help="budget such as 20G, TILELANG_CACHE_MAX_SIZE by default")
+    gc.add_argument("--dry-run", action="store_true", help="only list the entries that would be evicted")
+    args = parser.parse_args(argv)
+
+    if args.command == "stats":
+        print(cache_stats(args.cache_dir).summary())
+        return
+    evicted = collect_garbage(args.cache_dir, max_size=args.max_size, dry_run=args.dry_run)
+    for entry in evicted if args.dry_run else ():
+        print(f"{format_size(entry.size):>10}  {entry.path}")
+    freed = format_size(sum(entry.size for entry in evicted))
+    print(f"{'would evict' if args.dry_run else 'evicted'} {len(evicted)} entries ({freed})")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,236 @@
+"""Size budget and garbage collection of the kernel disk cache.
+
+``TILELANG_CACHE_MAX_SIZE`` (e.g. ``20G``) bounds the size of
+``TILELANG_CACHE_DIR``. Once a save takes the cache over its budget, the least
+recently used entries are evicted until it is back under
+``_LOW_WATERMARK`` times the budget, so that the following saves do not
+collect again right away. The entries are:
+
+- the directories of the kernels, last used at their latest write or disk
+  cache hit recorded in the cache index (``tilelang.cache.index``), or at
+  their modification time for kernels the index does not know;
+- the cubins of the device binary cache, last used at their modification
+  time, which their hits refresh.
+
+The index itself, the autotuner results and the temporary files are counted
+in the size but never evicted. Evicted kernels are also dropped from the
+index. One process at a time collects, under a lock next to the index, and
+each process checks the budget at most once every ``_COLLECTION_INTERVAL``
+seconds.
+
+``python -m tilelang.cache stats`` and ``python -m tilelang.cache gc`` report
+and collect from the command line without importing the compiler.
+"""
+
+from __future__ import annotations
+
+import os
+import shutil
+import string
+import threading
+import time
+from dataclasses import dataclass, field
+
+from tilelang import env
+from tilelang.cache.index import INDEX_FILE_NAME, get_cache_index
+
+try:
+    import fcntl
+except ImportError:  # Windows
+    fcntl = None
+
+DEVICE_BINARY_DIR = "device_binary"
+_LOCK_FILE_NAME = "gc.lock"
+_LOW_WATERMARK = 0.8
+_COLLECTION_INTERVAL = 60.0
+_SIZE_UNITS = {"": 1, "K": 1 << 10, "M": 1 << 20, "G": 1 << 30, "T": 1 << 40}
+
+_last_collection = 0.0
+_last_collection_lock = threading.Lock()
+
+
+def parse_size(size: str | int | None) -> int | None:
+    """Bytes of a size such as ``512M`` or ``20G``, None for no limit."""
+    if size is None:
+        return None
+    if isinstance(size, int):
+        return size or None
+    text = size.strip().upper().rstrip("B").rstrip("I")
+    unit = text[-1] if text and text[-1] in _SIZE_UNITS else ""
+    number = text[: len(text) - len(unit)]
+    try:
+        value = int(float(number) * _SIZE_UNITS[unit])
+    except ValueError:
+        raise ValueError(f"Invalid cache size {size!r}, expected e.g. 512M or 20G") from None
+    return value or None
+
+
+def format_size(size: float) -> str:
+    if size < 1024:
+        return f"{int(size)} B"
+    for unit in ("KiB", "MiB", "GiB", "TiB"):
+        size /= 1024
+        if size < 1024 or unit == "TiB":
+            return f"{size:.1f} {unit}"
+
+
+@dataclass
+class CacheEntry:
+    """An evictable entry of the disk cache."""
+
+    path: str
+    size: int
+    last_access: float
+    # key of a kernel directory, None for a device binary
+    key: str | None = None
+
+
+@dataclass
+class CacheStats:
+    """Sizes in bytes of the parts of a disk cache."""
+
+    cache_dir: str
+    num_kernels: int = 0
+    kernel_bytes: int = 0
+    num_device_binaries: int = 0
+    device_binary_bytes: int = 0
+    index_bytes: int = 0
+    other_bytes: int = 0
+    max_size: int | None = None
+    entries: list[CacheEntry] = field(default_factory=list, repr=False)
+
+    @property
+    def total_bytes(self) -> int:
+        return self.kernel_bytes + self.device_binary_bytes + self.index_bytes + self.other_bytes
+
+    def summary(self) -> str:
+        budget = format_size(self.max_size) if self.max_size else "unlimited"
+        lines = [
+            f"cache directory  {self.cache_dir}",
+            f"kernels          {self.num_kernels} ({format_size(self.kernel_bytes)})",
+            f"device binaries  {self.num_device_binaries} ({format_size(self.device_binary_bytes)})",
+            f"index            {format_size(self.index_bytes)}",
+            f"other            {format_size(self.other_bytes)}",
+            f"total            {format_size(self.total_bytes)} of {budget}",
+        ]
+        if self.entries:
+            oldest = min(entry.last_access for entry in self.entries)
+            lines.append(f"least recent use {time.strftime('%Y-%m-%d %H:%M', time.localtime(oldest))}")
+        return "\n".join(lines)
+
+
+def _is_kernel_key(name: str) -> bool:
+    return len(name) == 64 and all(c in string.hexdigits for c in name)
+
+
+def _tree_size(path: str) -> int:
+    size = 0
+    for root, _, files in os.walk(path):
+        for name in files:
+            try:
+                size += os.lstat(os.path.join(root, name)).st_size
+            except OSError:
+                pass
+    return size
+
+
+def cache_stats(cache_dir: str | None = None) -> CacheStats:
+    """Scans the disk cache, cheap enough to run on every collection."""
+    cache_dir = cache_dir or env.TILELANG_CACHE_DIR
+    stats = CacheStats(cache_dir=cache_dir, max_size=parse_size(env.TILELANG_CACHE_MAX_SIZE))
+    if not os.path.isdir(cache_dir):
+        return stats
+    last_access = get_cache_index(cache_dir).last_access()
+    with os.scandir(cache_dir) as it:
+        for item in it:
+            try:
+                if _is_kernel_key(item.name) and item.is_dir(follow_symlinks=False):
+                    size = _tree_size(item.path)
+                    accessed = max(last_access.get(item.name, 0.0), item.stat(follow_symlinks=False).st_mtime)
+                    stats.entries.append(CacheEntry(item.path, size, accessed, key=item.name))
+                    stats.num_kernels += 1
+                    stats.kernel_bytes += size
+                elif item.name == DEVICE_BINARY_DIR and item.is_dir(follow_symlinks=False):
+                    with os.scandir(item.path) as binaries:
+                        for binary in binaries:
+                            info = binary.stat(follow_symlinks=False)
+                            stats.entries.append(CacheEntry(binary.path, info.st_size, info.st_mtime))
+                            stats.num_device_binaries += 1
+                            stats.device_binary_bytes += info.st_size
+                elif item.name == INDEX_FILE_NAME:
+                    stats.index_bytes += item.stat(follow_symlinks=False).st_size
+                elif item.is_dir(follow_symlinks=False):
+                    stats.other_bytes += _tree_size(item.path)
+                else:
+                    stats.other_bytes += item.stat(follow_symlinks=False).st_size
+            except OSError:
+                # removed by a concurrent collection
+                continue
+    return stats
+
+
+def collect_garbage(cache_dir: str | None = None, max_size: str | int | None = None, dry_run: bool = False) -> list[CacheEntry]:
+    """Evicts the least recently used entries until the cache fits its budget.
+
+    Args:
+        cache_dir: The cache directory, `TILELANG_CACHE_DIR` by default.
+        max_size: The budget, `TILELANG_CACHE_MAX_SIZE` by default. The cache is
+            shrunk to `_LOW_WATERMARK` times the budget once it exceeds it.
+        dry_run: Only return the entries that would be evicted.
+
+    Returns:
+        The evicted entries, empty when the cache fits or another process is
+        collecting it.
+    """
+    cache_dir = cache_dir or env.TILELANG_CACHE_DIR
+    budget = parse_size(max_size if max_size is not None else env.TILELANG_CACHE_MAX_SIZE)
+    if not budget or not os.path.isdir(cache_dir):
+        return []
+    fd = os.open(os.path.join(cache_dir, _LOCK_FILE_NAME), os.O_RDWR | os.O_CREAT, 0o644)
+    try:
+        if fcntl is not None:
+            try:
+                fcntl.flock(fd, fcntl.LOCK_EX | fcntl.LOCK_NB)
+            except BlockingIOError:
+                return []
+        stats = cache_stats(cache_dir)
+        total = stats.total_bytes
+        if total <= budget:
+            return []
+        evicted = []
+        for entry in sorted(stats.entries, key=lambda entry: entry.last_access):
+            if total <= budget * _LOW_WATERMARK:
+                break
+            evicted.append(entry)
+            total -= entry.size
+        if dry_run:
+            return evicted
+        for entry in evicted:
+            if entry.key is not None:
+                shutil.rmtree(entry.path, ignore_errors=True)
+            else:
+                try:
+                    os.remove(entry.path)
+                except OSError:
+                    pass
+        keys = [entry.key for entry in evicted if entry.key is not None]
+        if keys and os.path.exists(os.path.join(cache_dir, INDEX_FILE_NAME)):
+            get_cache_index(cache_dir).evict(keys)
+        return evicted
+    finally:
+        if fcntl is not None:
+            fcntl.flock(fd, fcntl.LOCK_UN)
+        os.close(fd)
+
+
+def maybe_collect_garbage(cache_dir: str | None = None) -> None:
+    """Collects after a save when a budget is set, at most once per interval."""
+    global _last_collection
+    if parse_size(env.TILELANG_CACHE_MAX_SIZE) is None:
+        return
+    with _last_collection_lock:
+        now = time.monotonic()
+        if _last_collection and now - _last_collection < _COLLECTION_INTERVAL:
+            return
+        _last_collection = now
+    collect_garbage(cache_dir)
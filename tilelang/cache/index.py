@@ -0,0 +1,219 @@
+"""Single-file index of the kernel disk cache.
+
+Every kernel saved by ``KernelCache`` is also appended as one record to
+``<TILELANG_CACHE_DIR>/kernel_index.pack``. A record holds the device source,
+the host source and the pickled parameters of a kernel, so a lookup only needs
+the shared library of the kernel itself instead of three more file opens.
+
+The pack is append-only and memory-mapped by readers. Records are located
+once per process by a scan over the mapping that builds a ``key -> offsets``
+dictionary; lookups read that dictionary without taking a lock and slice the
+mapping. New records appended by other processes are picked up by an
+incremental rescan on a miss.
+
+Records store their sources zlib-compressed with the time they were written,
+and every disk cache hit appends a small access record, so that the scan also
+yields when each kernel was last used, the order the size budget of
+``tilelang.cache.gc`` evicts kernels in. Eviction rewrites the pack without
+the evicted keys and replaces it, readers notice the new file and rescan it.
+"""
+
+from __future__ import annotations
+
+import logging
+import mmap
+import os
+import struct
+import threading
+import time
+import zlib
+
+logger = logging.getLogger(__name__)
+
+try:
+    import fcntl
+except ImportError:  # Windows
+    fcntl = None
+
+_MAGIC = b"TLKI"
+# magic, key (sha256 hex digest), device source, host source and params lengths
+_HEADER = struct.Struct("<4s64sQQQ")
+# the same with compressed sources, followed by the time of the write
+_COMPRESSED_MAGIC = b"TLKZ"
+_COMPRESSED_HEADER = struct.Struct("<4s64sQQQd")
+# magic, key and time of a disk cache hit
+_ACCESS_MAGIC = b"TLKA"
+_ACCESS = struct.Struct("<4s64sd")
+INDEX_FILE_NAME = "kernel_index.pack"
+
+
+class CacheIndex:
+    """Memory-mapped index over the records of one cache directory."""
+
+    def __init__(self, cache_dir: str):
+        self.path = os.path.join(cache_dir, INDEX_FILE_NAME)
+        # key -> (payload offset, device source length, host source length, params length, compressed)
+        self._entries: dict[str, tuple[int, int, int, int, bool]] = {}
+        # key -> time of the last write or disk cache hit, 0 when unknown
+        self._access: dict[str, float] = {}
+        self._mmap: mmap.mmap | None = None
+        self._inode: int | None = None
+        self._scanned = 0
+        self._scan_lock = threading.Lock()
+
+    def _map(self) -> mmap.mmap | None:
+        try:
+            stat = os.stat(self.path)
+        except OSError:
+            return None
+        if stat.st_size == 0:
+            return None
+        if stat.st_ino != self._inode:
+            # The pack was rewritten by an eviction, rescan it from the start
+            self._entries, self._access, self._mmap, self._scanned = {}, {}, None, 0
+        if self._mmap is None or len(self._mmap) < stat.st_size:
+            with open(self.path, "rb") as f:
+                mapping = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+                self._inode = os.fstat(f.fileno()).st_ino
+            # The previous mapping may still be referenced by a concurrent reader.
+            self._mmap = mapping
+        return self._mmap
+
+    def _scan(self) -> None:
+        with self._scan_lock:
+            mapping = self._map()
+            if mapping is None:
+                return
+            entries = dict(self._entries)
+            access = dict(self._access)
+            offset = self._scanned
+            while offset + _ACCESS.size <= len(mapping):
+                magic = mapping[offset : offset + 4]
+                if magic == _ACCESS_MAGIC:
+                    _, key, accessed = _ACCESS.unpack_from(mapping, offset)
+                    access[key.decode()] = accessed
+                    offset += _ACCESS.size
+                    continue
+                if magic not in (_MAGIC, _COMPRESSED_MAGIC):
+                    logger.warning(f"Corrupted kernel cache index {self.path} at offset {offset}, ignoring the remaining records")
+                    break
+                compressed = magic == _COMPRESSED_MAGIC
+                header = _COMPRESSED_HEADER if compressed else _HEADER
+                if offset + header.size > len(mapping):
+                    break
+                _, key, device_len, host_len, params_len, *written = header.unpack_from(mapping, offset)
+                payload = offset + header.size
+                end = payload + device_len + host_len + params_len
+                if end > len(mapping):
+                    break
+                key = key.decode()
+                entries[key] = (payload, device_len, host_len, params_len, compressed)
+                access[key] = max(access.get(key, 0.0), written[0] if written else 0.0)
+                offset = end
+            self._scanned = offset
+            # Publish the new dictionaries at once so that lookups never lock.
+            self._entries = entries
+            self._access = access
+
+    def get(self, key: str) -> tuple[str, str, bytes] | None:
+        """Return the device source, host source and pickled params of a key."""
+        entry = self._entries.get(key)
+        if entry is None:
+            self._scan()
+            entry = self._entries.get(key)
+            if entry is None:
+                return None
+        payload, device_len, host_len, params_len, compressed = entry
+        mapping = self._mmap
+        device_source = mapping[payload : payload + device_len]
+        payload += device_len
+        host_source = mapping[payload : payload + host_len]
+        payload += host_len
+        params = mapping[payload : payload + params_len]
+        if compressed:
+            device_source, host_source = zlib.decompress(device_source), zlib.decompress(host_source)
+        return device_source.decode(), host_source.decode(), params
+
+    def put(self, key: str, device_source: str, host_source: str, params: bytes) -> None:
+        """Append the record of a key, later records of the same key win."""
+        self._append(self._record(key, (device_source or "").encode(), (host_source or "").encode(), params, time.time()))
+
+    def touch(self, key: str) -> None:
+        """Record a disk cache hit of a key."""
+        self._append(_ACCESS.pack(_ACCESS_MAGIC, key.encode(), time.time()))
+
+    def last_access(self) -> dict[str, float]:
+        """Time of the last write or disk cache hit of every key, 0 when unknown."""
+        self._scan()
+        return dict(self._access)
+
+    def evict(self, keys) -> None:
+        """Rewrite the pack without the records of ``keys``."""
+        keys = set(keys)
+        if not keys:
+            return
+        fd = os.open(self.path, os.O_RDWR | os.O_CREAT, 0o644)
+        try:
+            if fcntl is not None:
+                fcntl.flock(fd, fcntl.LOCK_EX)
+            self.reset()
+            self._scan()
+            temp_path = f"{self.path}.{os.getpid()}.tmp"
+            with open(temp_path, "wb") as f:
+                for key, accessed in self._access.items():
+                    if key in keys:
+                        continue
+                    if key not in self._entries:
+                        # Kernels of backends without records only have their accesses
+                        f.write(_ACCESS.pack(_ACCESS_MAGIC, key.encode(), accessed))
+                        continue
+                    device_source, host_source, params = self.get(key)
+                    f.write(self._record(key, device_source.encode(), host_source.encode(), params, accessed))
+            # Records appended meanwhile to the old pack by processes that
+            # opened it before the replace are lost, their kernels are still
+            # served from their own files.
+            os.replace(temp_path, self.path)
+        finally:
+            if fcntl is not None:
+                fcntl.flock(fd, fcntl.LOCK_UN)
+            os.close(fd)
+        self.reset()
+
+    @staticmethod
+    def _record(key: str, device_bytes: bytes, host_bytes: bytes, params: bytes, written: float) -> bytes:
+        device_bytes, host_bytes = zlib.compress(device_bytes), zlib.compress(host_bytes)
+        header = _COMPRESSED_HEADER.pack(_COMPRESSED_MAGIC, key.encode(), len(device_bytes), len(host_bytes), len(params), written)
+        return header + device_bytes + host_bytes + params
+
+    def _append(self, record: bytes) -> None:
+        fd = os.open(self.path, os.O_WRONLY | os.O_APPEND | os.O_CREAT, 0o644)
+        try:
+            if fcntl is not None:
+                fcntl.flock(fd, fcntl.LOCK_EX)
+            # A single write on an O_APPEND descriptor keeps the record contiguous.
+            os.write(fd, record)
+        finally:
+            if fcntl is not None:
+                fcntl.flock(fd, fcntl.LOCK_UN)
+            os.close(fd)
+
+    def reset(self) -> None:
+        with self._scan_lock:
+            self._entries = {}
+            self._access = {}
+            self._mmap = None
+            self._inode = None
+            self._scanned = 0
+
+
+_indices: dict[str, CacheIndex] = {}
+_indices_lock = threading.Lock()
+
+
+def get_cache_index(cache_dir: str) -> CacheIndex:
+    """Return the process-wide index of a cache directory."""
+    index = _indices.get(cache_dir)
+    if index is None:
+        with _indices_lock:
+            index = _indices.setdefault(cache_dir, CacheIndex(cache_dir))
+    return index
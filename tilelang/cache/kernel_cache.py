@@ -2,46 +2,81 @@
 
 from __future__ import annotations
 
+import concurrent.futures
 import functools
+import gzip
 import json
 import logging
 import os
 import shutil
 import threading
+import time
 import uuid
 import sys
 from hashlib import sha256
 from typing import Callable, Literal
 
 import cloudpickle
+from tvm.ir import structural_hash
 from tvm.target import Target
 from tvm.tir import PrimFunc
 from tvm.runtime import Executable
+from tilelang.cache.gc import maybe_collect_garbage
+from tilelang.cache.index import get_cache_index
+from tilelang.cache.remote import RemoteCache, get_remote_cache, lease_token
 from tilelang.engine.param import KernelParam
+from tilelang.engine.compile_profile import CompileProfile, is_compile_profile_enabled
 from tilelang.utils.language import get_prim_func_name
 from tilelang import env
 from tilelang.jit import JITKernel
+from tilelang.jit.dispatch import KernelCacheStats, KernelDispatchTable
 from tilelang import __version__
 
 
+@functools.lru_cache(maxsize=4096)
+def _func_fingerprint(func: PrimFunc) -> str:
+    """Fingerprint of a function in the cache key, memoized per function object.
+
+    The structural hash is computed by TVM in C++ and does not print the
+    function, which dominated the lookups of large kernels. It covers the
+    body, buffers and attributes, ``global_symbol`` included, but not the
+    names of variables, which do not change the compiled kernel.
+    """
+    try:
+        return f"shash-{structural_hash(func) & 0xFFFFFFFFFFFFFFFF:016x}"
+    except Exception:
+        # e.g. a node that does not define its structural hash
+        return sha256(func.script(show_meta=True).encode()).hexdigest()
+
+
 class KernelCache:
     """
     Caches compiled kernels using a class and database persistence to avoid redundant compilation.
     Cache files:
-        kernel.cu: The compiled kernel source code
-        wrapped_kernel.cu: The compiled wrapped kernel source code
+        device_kernel.cu.gz: The compiled kernel source code
+        host_kernel.cu.gz: The compiled wrapped kernel source code
         kernel_lib.so: The compiled kernel library
         params.pkl: The compiled kernel parameters
+    The sources and parameters are also appended to the shared cache index
+    (see `tilelang.cache.index`), which serves later lookups without reading
+    the individual files. Only the library loaded on a hit is stored
+    uncompressed. The disk cache is kept within `TILELANG_CACHE_MAX_SIZE` by
+    evicting the least recently used kernels, see `tilelang.cache.gc`.
     """
 
     _instance = None  # For implementing singleton pattern
     _lock = threading.Lock()  # For thread safety
     _memory_cache = {}  # In-memory cache dictionary
+    _inflight: dict[str, concurrent.futures.Future] = {}  # Keys being loaded or compiled, by thread
     execution_backend: Literal["tvm_ffi", "cython", "nvrtc", "torch", "cutedsl"] = "tvm_ffi"
     device_kernel_path = "device_kernel.cu"
     host_kernel_path = "host_kernel.cu"
     kernel_lib_path = "kernel_lib.so"
     params_path = "params.pkl"
+    # Whether the sources and params of this backend are stored in the cache index
+    use_cache_index = True
+    # Whether the source files are stored gzip-compressed
+    compress_sources = True
 
     @staticmethod
     @functools.cache
@@ -77,7 +112,8 @@ class KernelCache:
                     KernelCache._create_dirs()
                     instance.logger = logging.getLogger(__name__)
                     instance.logger.setLevel(logging.DEBUG)
-                    instance._memory_cache = {}  # Initialize memory cache
+                    instance._memory_cache = KernelDispatchTable(env.get_kernel_cache_capacity())
+                    instance._inflight = {}
                     cls._instance = instance
         return cls._instance
 
@@ -112,9 +148,8 @@ class KernelCache:
             str: SHA256 hash key for the kernel configuration.
         """
         self.execution_backend = execution_backend
-        func_binary = func.script(show_meta=True).encode()
         key_data = {
-            "func": sha256(func_binary).hexdigest(),  # Use SHA256 to generate hash key
+            "func": _func_fingerprint(func),
             "out_idx": (tuple(out_idx) if isinstance(out_idx, (list, tuple)) else [out_idx]),
             "args_repr": tuple(repr(arg) for arg in args),  # Use repr to serialize arguments, may need more robust serialization
             "target": str(target),
@@ -172,7 +207,7 @@ class KernelCache:
         if not env.is_cache_enabled():
             if verbose:
                 self.logger.info("Cache is disabled; compiling kernel without caching.")
-            return JITKernel(
+            kernel = JITKernel(
                 func,
                 out_idx=out_idx,
                 execution_backend=execution_backend,
@@ -182,6 +217,9 @@ class KernelCache:
                 pass_configs=pass_configs,
                 compile_flags=compile_flags,
             )
+            if kernel.compile_profile is not None:
+                kernel.compile_profile.dump_if_requested()
+            return kernel
 
         key = self._generate_key(
             func=func,
@@ -197,53 +235,145 @@ class KernelCache:
             self.logger.info(f"Generated cache key: {key} for kernel {get_prim_func_name(func, '<unknown>')}")
         with self._lock:
             # First check in-memory cache
-            if key in self._memory_cache:
+            kernel = self._memory_cache.get(key)
+            if kernel is not None:
                 # Include kernel name for easier debugging when hitting memory cache
                 kernel_name = get_prim_func_name(func, "<unknown>")
                 self.logger.warning(
                     "Found kernel '%s' in memory cache. For better performance, consider using `@tilelang.jit` instead of direct kernel caching.",
                     kernel_name,
                 )
-                return self._memory_cache[key]
+                return kernel
 
+            # Another thread is loading or compiling the same kernel, wait for it
+            inflight = self._inflight.get(key)
+            owner = inflight is None
+            if owner:
+                inflight = self._inflight[key] = concurrent.futures.Future()
+        if not owner:
             if verbose:
-                self.logger.debug(f"Checking disk cache for kernel {get_prim_func_name(func, '<unknown>')}")
+                self.logger.debug(f"Waiting for kernel {get_prim_func_name(func, '<unknown>')} compiled by another thread")
+            return inflight.result()
 
-            # Then check disk cache
-            kernel = self._load_kernel_from_disk(
-                key, target, target_host, out_idx, execution_backend, pass_configs, compile_flags, func, verbose
+        try:
+            kernel = self._load_or_compile(
+                key, func, out_idx, target, target_host, execution_backend, verbose, pass_configs, compile_flags
+            )
+        except BaseException as e:
+            inflight.set_exception(e)
+            raise
+        else:
+            inflight.set_result(kernel)
+            return kernel
+        finally:
+            with self._lock:
+                del self._inflight[key]
+
+    def _load_or_compile(
+        self,
+        key: str,
+        func: PrimFunc,
+        out_idx: list[int] | None,
+        target: str | Target,
+        target_host: str | Target | None,
+        execution_backend: Literal["tvm_ffi", "cython", "nvrtc", "torch", "cutedsl"],
+        verbose: bool,
+        pass_configs: dict | None,
+        compile_flags: list[str] | str | None,
+    ) -> JITKernel:
+        """Loads a kernel missing from memory from the disk or remote cache, or compiles it.
+
+        Runs in one thread per key at a time, other threads requesting the
+        key wait for its result in `cached`.
+        """
+        if verbose:
+            self.logger.debug(f"Checking disk cache for kernel {get_prim_func_name(func, '<unknown>')}")
+
+        # Then check disk cache
+        load_start = time.perf_counter()
+        kernel = self._load_kernel_from_disk(
+            key, target, target_host, out_idx, execution_backend, pass_configs, compile_flags, func, verbose
+        )
+        if kernel is not None:
+            if verbose:
+                self.logger.debug(f"Found kernel in disk cache for {get_prim_func_name(func, '<unknown>')}")
+            self._record_access(key)
+            if is_compile_profile_enabled(pass_configs):
+                load_ms = (time.perf_counter() - load_start) * 1e3
+                kernel.compile_profile = CompileProfile(
+                    kernel_name=get_prim_func_name(func, ""),
+                    target=str(kernel.target),
+                    cache="disk_hit",
+                    total_ms=load_ms,
+                    stages={"cache_load": load_ms},
+                )
+                kernel.compile_profile.dump_if_requested()
+            # Populate memory cache with disk result
+            self._memory_cache[key] = kernel
+            return kernel
+
+        # Then check the remote cache, or wait for the process compiling the kernel
+        remote = get_remote_cache()
+        lease = None
+        if remote is not None:
+            kernel, lease = self._load_kernel_from_remote(
+                remote, key, target, target_host, out_idx, execution_backend, pass_configs, compile_flags, func, verbose
             )
             if kernel is not None:
-                if verbose:
-                    self.logger.debug(f"Found kernel in disk cache for {get_prim_func_name(func, '<unknown>')}")
-                # Populate memory cache with disk result
                 self._memory_cache[key] = kernel
                 return kernel
 
         if verbose:
             self.logger.debug(f"No cached kernel for {get_prim_func_name(func, '<unknown>')}")
-        # Compile kernel if cache miss; leave critical section
-        kernel = JITKernel(
-            func,
-            out_idx=out_idx,
-            execution_backend=execution_backend,
-            target=target,
-            target_host=target_host,
-            verbose=verbose,
-            pass_configs=pass_configs,
-            compile_flags=compile_flags,
-        )
-        with self._lock:
+        try:
+            # Compile kernel if cache miss; leave critical section
+            kernel = JITKernel(
+                func,
+                out_idx=out_idx,
+                execution_backend=execution_backend,
+                target=target,
+                target_host=target_host,
+                verbose=verbose,
+                pass_configs=pass_configs,
+                compile_flags=compile_flags,
+            )
+            with self._lock:
+                if env.is_cache_enabled():
+                    save_start = time.perf_counter()
+                    cache_path = self._get_cache_path(key)
+                    self._save_kernel_to_disk(key, kernel, func, verbose)
+                    # Set cache path on adapter so it can save cubin after first execution
+                    self._set_adapter_cache_path(kernel, cache_path)
+                    if kernel.compile_profile is not None:
+                        kernel.compile_profile.stages["cache_save"] = (time.perf_counter() - save_start) * 1e3
             if env.is_cache_enabled():
-                cache_path = self._get_cache_path(key)
-                self._save_kernel_to_disk(key, kernel, func, verbose)
-                # Set cache path on adapter so it can save cubin after first execution
-                self._set_adapter_cache_path(kernel, cache_path)
+                try:
+                    maybe_collect_garbage(env.TILELANG_CACHE_DIR)
+                except Exception:
+                    self.logger.exception("Error collecting the disk cache garbage")
+            if remote is not None:
+                try:
+                    remote.upload(key, self._get_cache_path(key))
+                except Exception:
+                    self.logger.exception("Error uploading kernel to the remote cache")
+        finally:
+            if lease is not None:
+                try:
+                    remote.release(key, lease)
+                except Exception:
+                    self.logger.exception("Error releasing the remote cache lease")
+        if kernel.compile_profile is not None:
+            kernel.compile_profile.cache = "miss"
+            kernel.compile_profile.dump_if_requested()
 
         # Store in memory cache after compilation
         self._memory_cache[key] = kernel
         return kernel
 
+    def memory_cache_stats(self) -> KernelCacheStats:
+        """Hits, misses and evictions of the in-memory kernels of this backend."""
+        return self._memory_cache.stats()
+
     def clear_cache(self):
         """
         Clears the entire kernel cache, including both in-memory and disk cache.
@@ -252,6 +382,16 @@ class KernelCache:
             self._memory_cache.clear()  # Clear in-memory cache
             self._clear_disk_cache()  # Clear disk cache
 
+    def _record_access(self, key: str):
+        """Marks a disk cache hit, the kernels used least recently are evicted first."""
+        try:
+            if self.use_cache_index and env.is_cache_index_enabled():
+                get_cache_index(env.TILELANG_CACHE_DIR).touch(key)
+            else:
+                os.utime(self._get_cache_path(key))
+        except OSError:
+            self.logger.debug(f"Failed to record the access of kernel {key}")
+
     def _get_cache_path(self, key: str) -> str:
         """
         Gets the filesystem path for a cached kernel.
@@ -264,6 +404,21 @@ class KernelCache:
         """
         return os.path.join(env.TILELANG_CACHE_DIR, key)
 
+    def _write_source(self, path: str, source: str):
+        if self.compress_sources:
+            KernelCache._safe_write_file(path + ".gz", "wb", lambda file: file.write(gzip.compress(source.encode())))
+        else:
+            KernelCache._safe_write_file(path, "w", lambda file: file.write(source))
+
+    @staticmethod
+    def _read_source(path: str) -> str:
+        # Also reads the uncompressed files of earlier versions
+        if os.path.exists(path + ".gz"):
+            with open(path + ".gz", "rb") as file:
+                return gzip.decompress(file.read()).decode()
+        with open(path) as file:
+            return file.read()
+
     @staticmethod
     def _load_binary(path: str):
         with open(path, "rb") as file:
@@ -335,6 +490,15 @@ class KernelCache:
         except Exception:
             self.logger.exception("Error saving kernel parameters to disk")
 
+        # Append the record to the cache index
+        if self.use_cache_index and env.is_cache_index_enabled():
+            try:
+                get_cache_index(env.TILELANG_CACHE_DIR).put(
+                    key, kernel.kernel_source, self._get_host_kernel_source(kernel), cloudpickle.dumps(kernel.params)
+                )
+            except Exception:
+                self.logger.exception("Error saving kernel to the cache index")
+
     def _load_kernel_from_disk(
         self,
         key: str,
@@ -369,6 +533,13 @@ class KernelCache:
         kernel_lib_path = os.path.join(cache_path, self.kernel_lib_path)
         params_path = os.path.join(cache_path, self.params_path)
 
+        if self.use_cache_index and env.is_cache_index_enabled():
+            kernel = self._load_kernel_from_index(
+                key, target, target_host, out_idx, execution_backend, pass_configs, compile_flags, func, verbose
+            )
+            if kernel is not None:
+                return kernel
+
         required_files = self._get_required_files(cache_path)
 
         if not all([os.path.exists(file) for file in required_files]):
@@ -401,6 +572,102 @@ class KernelCache:
             compile_flags=compile_flags,
         )
 
+    def _load_kernel_from_index(
+        self,
+        key: str,
+        target: str | Target,
+        target_host: str | Target | None,
+        out_idx: list[int] | None,
+        execution_backend: Literal["tvm_ffi", "cython", "nvrtc", "torch", "cutedsl"],
+        pass_configs: dict | None,
+        compile_flags: list[str] | str | None,
+        func: Callable | None,
+        verbose: bool,
+    ) -> JITKernel | None:
+        """Loads a kernel whose sources and parameters are stored in the cache index."""
+        try:
+            record = get_cache_index(env.TILELANG_CACHE_DIR).get(key)
+        except Exception:
+            self.logger.exception("Error reading the cache index")
+            return None
+        kernel_lib_path = os.path.join(self._get_cache_path(key), self.kernel_lib_path)
+        if record is None or not os.path.exists(kernel_lib_path):
+            return None
+        if verbose:
+            self.logger.debug(f"Loading kernel {key} from the cache index")
+        device_kernel_source, host_kernel_source, params = record
+        try:
+            kernel_params = cloudpickle.loads(params)
+        except Exception:
+            self.logger.exception("Error loading kernel parameters from the cache index")
+            return None
+        return self._build_kernel(
+            func=func,
+            host_kernel_source=host_kernel_source,
+            device_kernel_source=device_kernel_source,
+            kernel_lib_path=kernel_lib_path,
+            kernel_params=kernel_params,
+            target=target,
+            target_host=target_host,
+            out_idx=out_idx,
+            execution_backend=execution_backend,
+            pass_configs=pass_configs,
+            compile_flags=compile_flags,
+        )
+
+    def _load_kernel_from_remote(
+        self,
+        remote: RemoteCache,
+        key: str,
+        target: str | Target,
+        target_host: str | Target | None,
+        out_idx: list[int] | None,
+        execution_backend: Literal["tvm_ffi", "cython", "nvrtc", "torch", "cutedsl"],
+        pass_configs: dict | None,
+        compile_flags: list[str] | str | None,
+        func: Callable | None,
+        verbose: bool,
+    ) -> tuple[JITKernel | None, str | None]:
+        """Fetches a kernel from the remote cache into the disk cache.
+
+        Returns the kernel, or on a miss the lease on its key, held while this
+        process compiles and uploads it. When another process holds the
+        lease, waits for its upload until the lease expires.
+        """
+        timeout = env.get_remote_cache_lease_timeout()
+        token = lease_token()
+        deadline = time.monotonic() + timeout
+        while True:
+            try:
+                files = remote.download(key)
+                if files is None and remote.acquire(key, token, timeout):
+                    # the holder may have uploaded between the two calls
+                    files = remote.download(key)
+                    if files is None:
+                        return None, token
+                    remote.release(key, token)
+            except Exception:
+                self.logger.exception("Error reading the remote cache")
+                return None, None
+            if files is not None:
+                break
+            if time.monotonic() > deadline:
+                self.logger.warning(f"Timed out waiting for kernel {key} in the remote cache, compiling it")
+                return None, None
+            time.sleep(0.5)
+
+        if verbose:
+            self.logger.debug(f"Fetched kernel {key} from the remote cache")
+        cache_path = self._get_cache_path(key)
+        os.makedirs(cache_path, exist_ok=True)
+        for name, data in files.items():
+            KernelCache._safe_write_file(os.path.join(cache_path, name), "wb", lambda file, data=data: file.write(data))
+        with self._lock:
+            kernel = self._load_kernel_from_disk(
+                key, target, target_host, out_idx, execution_backend, pass_configs, compile_flags, func, verbose
+            )
+        return kernel, None
+
     def _clear_disk_cache(self):
         """
         Removes all cached kernels from disk.
@@ -412,6 +679,7 @@ class KernelCache:
         try:
             # Delete the entire cache directory
             shutil.rmtree(env.TILELANG_CACHE_DIR)
+            get_cache_index(env.TILELANG_CACHE_DIR).reset()
 
             # Re-create the cache directory
             KernelCache._create_dirs()
@@ -423,13 +691,16 @@ class KernelCache:
         if verbose:
             self.logger.debug(f"Saving kernel source code to file: {device_kernel_path}")
         if kernel.kernel_source is not None:
-            KernelCache._safe_write_file(device_kernel_path, "w", lambda file: file.write(kernel.kernel_source))
+            self._write_source(device_kernel_path, kernel.kernel_source)
+
+    def _get_host_kernel_source(self, kernel: JITKernel) -> str:
+        return kernel.adapter.get_kernel_source()
 
     def _save_wrapper_kernel_code_to_disk(self, kernel: JITKernel, cache_path: str, verbose: bool = False):
         host_kernel_path = os.path.join(cache_path, self.host_kernel_path)
         if verbose:
             self.logger.debug(f"Saving wrapped kernel source code to file: {host_kernel_path}")
-        KernelCache._safe_write_file(host_kernel_path, "w", lambda file: file.write(kernel.adapter.get_kernel_source()))
+        self._write_source(host_kernel_path, self._get_host_kernel_source(kernel))
 
     def _save_so_cubin_to_disk(self, kernel: JITKernel, cache_path: str, verbose: bool = False):
         kernel_lib_path = os.path.join(cache_path, self.kernel_lib_path)
@@ -447,16 +718,14 @@ class KernelCache:
         try:
             if verbose:
                 self.logger.debug(f"Loading kernel source code from file: {device_kernel_path}")
-            with open(device_kernel_path) as f:
-                device_kernel_source = f.read()
+            device_kernel_source = self._read_source(device_kernel_path)
         except Exception:
             device_kernel_source = None
             self.logger.exception("Error loading kernel source code from disk")
         try:
             if verbose:
                 self.logger.debug(f"Loading wrapped kernel source code from file: {host_kernel_path}")
-            with open(host_kernel_path) as f:
-                host_kernel_source = f.read()
+            host_kernel_source = self._read_source(host_kernel_path)
         except Exception:
             host_kernel_source = None
             self.logger.exception("Error loading host kernel source code from disk")
@@ -0,0 +1,266 @@
+"""Remote tier of the kernel cache, shared by the machines of a deployment.
+
+When many processes start at once, e.g. the pods of a rollout, each of them
+would compile the same kernels into its own disk cache. With a remote cache
+configured, a miss of the disk cache first fetches the entry of the kernel
+from the remote store, addressed by the same key as the disk cache. Only one
+process compiles a kernel missing remotely: it holds a lease on the key
+while it compiles and uploads the entry, the others wait for the upload and
+fetch it instead::
+
+    TILELANG_REMOTE_CACHE=file:///mnt/nfs/tilelang   # shared filesystem
+    TILELANG_REMOTE_CACHE=s3://bucket/prefix          # needs boto3
+    TILELANG_REMOTE_CACHE=redis://host:6379/0         # needs redis
+
+An entry is the files of the disk cache entry plus a manifest holding their
+SHA256 digests, uploaded last, so a reader never sees a partial entry and
+rejects files that do not match their digest. A lease expires after
+``TILELANG_REMOTE_CACHE_LEASE_TIMEOUT`` seconds, so the crash of the
+compiling process only delays the others.
+"""
+
+from __future__ import annotations
+
+import json
+import logging
+import os
+import socket
+import threading
+import time
+import uuid
+from hashlib import sha256
+from urllib.parse import urlparse
+
+from tilelang import env
+
+logger = logging.getLogger(__name__)
+
+MANIFEST_NAME = "manifest.json"
+_LEASE_NAME = ".lease"
+
+
+class RemoteCache:
+    """Store of cache entries, one blob per file of an entry.
+
+    Subclasses implement the blob operations and a lease, acquired by at most
+    one process at a time per key until it is released or expires.
+    """
+
+    def get(self, key: str, name: str) -> bytes | None:
+        raise NotImplementedError
+
+    def put(self, key: str, name: str, data: bytes) -> None:
+        raise NotImplementedError
+
+    def acquire(self, key: str, token: str, timeout: float) -> bool:
+        raise NotImplementedError
+
+    def release(self, key: str, token: str) -> None:
+        raise NotImplementedError
+
+    def upload(self, key: str, cache_path: str) -> None:
+        """Upload the files of the disk cache entry at `cache_path`, then its manifest."""
+        digests = {}
+        for name in sorted(os.listdir(cache_path)):
+            path = os.path.join(cache_path, name)
+            if name == MANIFEST_NAME or not os.path.isfile(path):
+                continue
+            with open(path, "rb") as f:
+                data = f.read()
+            self.put(key, name, data)
+            digests[name] = sha256(data).hexdigest()
+        self.put(key, MANIFEST_NAME, json.dumps({"files": digests}, sort_keys=True).encode())
+
+    def download(self, key: str) -> dict[str, bytes] | None:
+        """Fetch the files of an entry, None when it is missing or fails its digests."""
+        manifest = self.get(key, MANIFEST_NAME)
+        if manifest is None:
+            return None
+        files = {}
+        for name, digest in json.loads(manifest)["files"].items():
+            data = self.get(key, name)
+            if data is None or sha256(data).hexdigest() != digest:
+                logger.warning(f"Remote cache entry {key} has a missing or corrupted {name}, ignoring it")
+                return None
+            files[name] = data
+        return files
+
+
+class FileSystemRemoteCache(RemoteCache):
+    """Entries in a directory shared by the machines, e.g. over NFS.
+
+    The lease is a file created exclusively, which NFSv3 and later honor.
+    """
+
+    def __init__(self, root: str):
+        self.root = root
+
+    def _path(self, key: str, name: str) -> str:
+        return os.path.join(self.root, key, name)
+
+    def get(self, key, name):
+        try:
+            with open(self._path(key, name), "rb") as f:
+                return f.read()
+        except FileNotFoundError:
+            return None
+
+    def put(self, key, name, data):
+        path = self._path(key, name)
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        temp_path = f"{path}.{os.getpid()}_{uuid.uuid4().hex}"
+        with open(temp_path, "wb") as f:
+            f.write(data)
+        os.replace(temp_path, path)
+
+    def acquire(self, key, token, timeout):
+        path = self._path(key, _LEASE_NAME)
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        for _ in range(2):
+            try:
+                fd = os.open(path, os.O_CREAT | os.O_EXCL | os.O_WRONLY)
+            except FileExistsError:
+                try:
+                    expired = time.time() - os.path.getmtime(path) > timeout
+                except FileNotFoundError:
+                    continue
+                if not expired:
+                    return False
+                # the holder died, break its lease once
+                try:
+                    os.remove(path)
+                except FileNotFoundError:
+                    pass
+                continue
+            with os.fdopen(fd, "w") as f:
+                f.write(token)
+            return True
+        return False
+
+    def release(self, key, token):
+        path = self._path(key, _LEASE_NAME)
+        try:
+            with open(path) as f:
+                owned = f.read() == token
+            if owned:
+                os.remove(path)
+        except FileNotFoundError:
+            pass
+
+
+class S3RemoteCache(RemoteCache):
+    """Entries in an S3 bucket, the lease is an object written conditionally."""
+
+    def __init__(self, bucket: str, prefix: str = ""):
+        import boto3
+
+        self.client = boto3.client("s3")
+        self.bucket = bucket
+        self.prefix = prefix.strip("/")
+
+    def _object(self, key: str, name: str) -> str:
+        return f"{self.prefix}/{key}/{name}" if self.prefix else f"{key}/{name}"
+
+    def get(self, key, name):
+        try:
+            return self.client.get_object(Bucket=self.bucket, Key=self._object(key, name))["Body"].read()
+        except self.client.exceptions.NoSuchKey:
+            return None
+
+    def put(self, key, name, data):
+        self.client.put_object(Bucket=self.bucket, Key=self._object(key, name), Body=data)
+
+    def acquire(self, key, token, timeout):
+        from botocore.exceptions import ClientError
+
+        lease = self._object(key, _LEASE_NAME)
+        for _ in range(2):
+            try:
+                self.client.put_object(Bucket=self.bucket, Key=lease, Body=token.encode(), IfNoneMatch="*")
+                return True
+            except ClientError as e:
+                if e.response["Error"]["Code"] not in ("PreconditionFailed", "ConditionalRequestConflict"):
+                    raise
+            try:
+                head = self.client.head_object(Bucket=self.bucket, Key=lease)
+            except ClientError:
+                continue
+            if time.time() - head["LastModified"].timestamp() <= timeout:
+                return False
+            self.client.delete_object(Bucket=self.bucket, Key=lease)
+        return False
+
+    def release(self, key, token):
+        lease = self._object(key, _LEASE_NAME)
+        if self.get(key, _LEASE_NAME) == token.encode():
+            self.client.delete_object(Bucket=self.bucket, Key=lease)
+
+
+class RedisRemoteCache(RemoteCache):
+    """Entries in Redis, the lease is a key set if absent with an expiry."""
+
+    # delete the lease only if it is still ours
+    _RELEASE = "if redis.call('get', KEYS[1]) == ARGV[1] then return redis.call('del', KEYS[1]) end return 0"
+
+    def __init__(self, url: str, prefix: str = "tilelang:"):
+        import redis
+
+        self.client = redis.Redis.from_url(url)
+        self.prefix = prefix
+
+    def _name(self, key: str, name: str) -> str:
+        return f"{self.prefix}{key}/{name}"
+
+    def get(self, key, name):
+        return self.client.get(self._name(key, name))
+
+    def put(self, key, name, data):
+        self.client.set(self._name(key, name), data)
+
+    def acquire(self, key, token, timeout):
+        return bool(self.client.set(self._name(key, _LEASE_NAME), token, nx=True, ex=max(int(timeout), 1)))
+
+    def release(self, key, token):
+        self.client.eval(self._RELEASE, 1, self._name(key, _LEASE_NAME), token)
+
+
+def create_remote_cache(url: str) -> RemoteCache:
+    """Create the remote cache of a ``file://``, ``s3://`` or ``redis://`` URL, or of a path."""
+    parsed = urlparse(url)
+    if parsed.scheme in ("", "file"):
+        return FileSystemRemoteCache(parsed.path if parsed.scheme else url)
+    if parsed.scheme == "s3":
+        return S3RemoteCache(parsed.netloc, parsed.path)
+    if parsed.scheme in ("redis", "rediss"):
+        return RedisRemoteCache(url)
+    raise ValueError(f"Unsupported remote cache {url!r}, expected a file://, s3:// or redis:// URL")
+
+
+_remote: tuple[str | None, RemoteCache | None] = (None, None)
+_override: RemoteCache | None = None
+_remote_lock = threading.Lock()
+
+
+def set_remote_cache(cache: RemoteCache | str | None) -> None:
+    """Use `cache` as the remote cache instead of ``TILELANG_REMOTE_CACHE``, None to stop overriding it."""
+    global _override
+    _override = create_remote_cache(cache) if isinstance(cache, str) else cache
+
+
+def get_remote_cache() -> RemoteCache | None:
+    """The remote cache in use, None when none is configured."""
+    global _remote
+    if _override is not None:
+        return _override
+    url = env.TILELANG_REMOTE_CACHE
+    if not url:
+        return None
+    with _remote_lock:
+        if _remote[0] != url:
+            _remote = (url, create_remote_cache(url))
+        return _remote[1]
+
+
+def lease_token() -> str:
+    """Identify the holder of a lease, unique per process and call."""
+    return f"{socket.gethostname()}:{os.getpid()}:{uuid.uuid4().hex}"
@@ -45,9 +45,12 @@ __all__ = [
     "is_ampere_arch",
     "is_ada_arch",
     "is_hopper_arch",
+    "is_blackwell_arch",
+    "is_consumer_blackwell_arch",
     "is_tensorcore_supported_precision",
     "has_mma_support",
     "is_cdna_arch",
+    "is_cdna4_arch",
     "is_metal_arch",
     "CUDA",
     "CDNA",
@@ -1,3 +1,6 @@
+from __future__ import annotations
+
+
 class TileDevice:
     """
     Represents the architecture of a computing device, capturing various hardware specifications.
@@ -25,6 +28,16 @@ class TileDevice:
         self.transaction_size: list[int] = [0, 0]  # in bytes
         # bandwidth in MB/s, will be used for recommend basic tile size
         self.bandwidth: list[int] = [0, 0]
+        # parameters of the analytical cost model of the policies, empty when unknown
+        self.cost_params: dict = {}
 
     def get_avaliable_tensorintrin_shapes(self):
         raise NotImplementedError()
+
+    def peak_memory_bandwidth(self) -> float | None:
+        """Peak DRAM bandwidth in bytes per second, None when unknown."""
+        return None
+
+    def peak_tensor_flops(self, dtype: str = "float16") -> float | None:
+        """Peak dense tensor core throughput for ``dtype`` inputs in FLOP/s, None when unknown."""
+        return None
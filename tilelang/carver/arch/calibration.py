@@ -0,0 +1,411 @@
+"""Micro-benchmark calibration of the CUDA device parameters.
+
+The nominal figures of ``CUDA.cost_params`` differ from what a device
+actually sustains: SKUs of the same architecture (H100 SXM and PCIe) have
+different clocks and memory systems, and power-capped nodes run below their
+boost clock. ``calibrate_device`` runs TileLang micro-kernels that measure
+
+    dram_bandwidth      streaming copy of a buffer much larger than the L2
+    l2_bandwidth        repeated reads of a buffer resident in the L2
+    smem_bandwidth      repeated reads of a shared memory tile
+    ldmatrix_bandwidth  repeated ldmatrix.x4 of a shared memory tile
+    load_latency        dependent global to shared loads of one block, TMA
+                        on sm90 and later
+    tensor_flops        T.gemm on resident shared operands, per input type
+    atomic_throughput   float32 atomic adds to global memory
+
+and stores them as a profile, JSON in ``$TILELANG_CACHE_DIR/device_profiles``
+keyed by the device name, compute capability and clocks, or at the path of
+``TILELANG_DEVICE_PROFILE``. The ``CUDA`` arch loads the profile of its
+device, which calibrates the cost model of the carver policies and the peaks
+the profiler reports, and the auto-tuner keys its cache by the profile key:
+
+    python -m tilelang.carver.arch.calibration --device 0
+"""
+
+from __future__ import annotations
+import json
+import logging
+import os
+import re
+import time
+
+from .driver import cuda_driver
+
+logger = logging.getLogger(__name__)
+
+PROFILE_VERSION = 1
+
+BENCHMARKS = (
+    "dram_bandwidth",
+    "l2_bandwidth",
+    "smem_bandwidth",
+    "ldmatrix_bandwidth",
+    "load_latency",
+    "tensor_flops",
+    "atomic_throughput",
+)
+
+
+def profile_key(device_id: int = 0) -> str | None:
+    """Identity of the device a profile is valid for, None without a device"""
+    name = cuda_driver.get_device_name(device_id)
+    if name is None:
+        return None
+    prop = cuda_driver.get_cuda_device_properties(device_id)
+    clock_khz = cuda_driver.get_clock_rate_khz(device_id) or 0
+    memory_clock_khz = cuda_driver.get_device_attribute(cuda_driver.cudaDeviceAttrNames.cudaDevAttrMemoryClockRate, device_id) or 0
+    name = re.sub(r"[^0-9A-Za-z]+", "_", name).strip("_")
+    return f"{name}-sm{prop.major}{prop.minor}-{clock_khz // 1000}MHz-{memory_clock_khz // 1000}MHz"
+
+
+def profile_path(device_id: int = 0) -> str | None:
+    """Where the profile of the device is stored"""
+    from tilelang.env import env
+
+    override = env.TILELANG_DEVICE_PROFILE
+    if override:
+        return override
+    key = profile_key(device_id)
+    if key is None:
+        return None
+    return os.path.join(env.TILELANG_CACHE_DIR, "device_profiles", f"{key}.json")
+
+
+def save_profile(profile: dict, path: str) -> None:
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    # write then rename, so that concurrent loads never see a partial profile
+    tmp_path = f"{path}.{os.getpid()}.tmp"
+    with open(tmp_path, "w") as f:
+        json.dump(profile, f, indent=2, sort_keys=True)
+    os.replace(tmp_path, path)
+
+
+def load_profile(device_id: int = 0, path: str | None = None) -> dict | None:
+    """The stored profile of the device, None if it has not been calibrated"""
+    path = path or profile_path(device_id)
+    if path is None or not os.path.exists(path):
+        return None
+    try:
+        with open(path) as f:
+            profile = json.load(f)
+    except (OSError, ValueError) as e:
+        logger.warning(f"Ignoring unreadable device profile {path}: {e}")
+        return None
+    if profile.get("version") != PROFILE_VERSION:
+        logger.warning(f"Ignoring device profile {path} of version {profile.get('version')}, expected {PROFILE_VERSION}")
+        return None
+    from tilelang.env import env
+
+    # a profile given explicitly applies to whatever device it is given for
+    if not env.TILELANG_DEVICE_PROFILE and profile.get("key") != profile_key(device_id):
+        logger.warning(f"Ignoring device profile {path} recorded on {profile.get('key')}")
+        return None
+    return profile
+
+
+def cost_params_from_measurements(measurements: dict, num_sms: int, clock_hz: float) -> dict:
+    """Parameters of CUDA.cost_params implied by the measurements.
+
+    Throughputs are divided by the nominal clock, so that a device running
+    below it, e.g. under a power cap, is modeled by lower per-clock figures.
+    """
+    params = {"clock_hz": clock_hz}
+    if "dram_bandwidth" in measurements:
+        params["dram_bandwidth"] = measurements["dram_bandwidth"]
+    if "l2_bandwidth" in measurements:
+        params["l2_bytes_per_clock"] = measurements["l2_bandwidth"] / clock_hz
+    if "smem_bandwidth" in measurements:
+        params["smem_bytes_per_sm_clock"] = measurements["smem_bandwidth"] / (num_sms * clock_hz)
+    if "load_latency" in measurements:
+        params["dram_latency_cycles"] = measurements["load_latency"] * clock_hz
+    flops = measurements.get("tensor_flops", {})
+    if "float16" in flops:
+        params["tensor_flops_per_sm_clock"] = flops["float16"] / (num_sms * clock_hz)
+    return params
+
+
+def _bench(kernel, *args) -> float:
+    """Time of one call in seconds"""
+    from tilelang.profiler.bench import do_bench
+
+    return do_bench(lambda: kernel(*args), warmup=10, rep=50, return_mode="median") * 1e-3
+
+
+def _measure_dram_bandwidth(device, num_sms, l2_bytes):
+    import torch
+    import tilelang
+    import tilelang.language as T
+
+    # large enough for the L2 to hold a negligible part of it
+    n = max(64 * l2_bytes, 1 << 28) // 4
+    block = 4096
+
+    @T.prim_func
+    def stream(A: T.Tensor((n,), T.float32), B: T.Tensor((n,), T.float32)):
+        with T.Kernel(T.ceildiv(n, block), threads=256) as bx:
+            A_local = T.alloc_fragment((block,), T.float32)
+            T.copy(A[bx * block], A_local)
+            T.copy(A_local, B[bx * block])
+
+    kernel = tilelang.compile(stream)
+    a = torch.ones(n, device=device, dtype=torch.float32)
+    b = torch.empty_like(a)
+    return 2 * n * 4 / _bench(kernel, a, b)
+
+
+def _measure_l2_bandwidth(device, num_sms, l2_bytes):
+    import torch
+    import tilelang
+    import tilelang.language as T
+
+    num_blocks, block, repeats = 4 * num_sms, 1024, 64
+    # a quarter of the L2, so that it stays resident across the repeats
+    chunks = max(1, l2_bytes // 4 // (4 * block * num_blocks))
+    n = chunks * block * num_blocks
+
+    @T.prim_func
+    def l2_read(A: T.Tensor((n,), T.float32), O: T.Tensor((num_blocks, block), T.float32)):
+        with T.Kernel(num_blocks, threads=256) as bx:
+            A_local = T.alloc_fragment((block,), T.float32)
+            acc = T.alloc_fragment((block,), T.float32)
+            T.clear(acc)
+            for r in T.serial(repeats):
+                for c in T.serial(chunks):
+                    # rotate through the chunks, keeping every read distinct
+                    T.copy(A[(bx * chunks + (c + r) % chunks) * block], A_local)
+                    for i in T.Parallel(block):
+                        acc[i] += A_local[i]
+            T.copy(acc, O[bx, 0])
+
+    kernel = tilelang.compile(l2_read, out_idx=[1])
+    a = torch.ones(n, device=device, dtype=torch.float32)
+    return repeats * n * 4 / _bench(kernel, a)
+
+
+def _measure_smem_bandwidth(device, num_sms, l2_bytes):
+    import torch
+    import tilelang
+    import tilelang.language as T
+
+    num_blocks, block, repeats = 4 * num_sms, 4096, 1024
+
+    @T.prim_func
+    def smem_read(A: T.Tensor((block,), T.float32), O: T.Tensor((num_blocks, block), T.float32)):
+        with T.Kernel(num_blocks, threads=256) as bx:
+            A_shared = T.alloc_shared((block,), T.float32)
+            acc = T.alloc_fragment((block,), T.float32)
+            T.copy(A, A_shared)
+            T.clear(acc)
+            for r in T.serial(repeats):
+                # the loads depend on r, so that they cannot be hoisted
+                for i in T.Parallel(block):
+                    acc[i] += A_shared[(i + r * 4) % block]
+            T.copy(acc, O[bx, 0])
+
+    kernel = tilelang.compile(smem_read, out_idx=[1])
+    a = torch.ones(block, device=device, dtype=torch.float32)
+    return num_blocks * repeats * block * 4 / _bench(kernel, a)
+
+
+def _measure_ldmatrix_bandwidth(device, num_sms, l2_bytes):
+    import torch
+    import tilelang
+    import tilelang.language as T
+
+    num_blocks, warps, repeats = 4 * num_sms, 8, 1024
+    # every warp loads four 8x8 b16 matrices of its own 16x16 tile
+    rows = 16 * warps
+
+    @T.prim_func
+    def ldmatrix(A: T.Tensor((rows, 16), T.float16), O: T.Tensor((num_blocks, 32 * warps, 8), T.float16)):
+        with T.Kernel(num_blocks, threads=32 * warps) as bx:
+            A_shared = T.alloc_shared((rows, 16), T.float16)
+            frag = T.alloc_local((8,), T.float16)
+            acc = T.alloc_local((8,), T.float16)
+            tx = T.get_thread_binding()
+            T.copy(A, A_shared)
+            for i in T.serial(8):
+                acc[i] = 0
+            for r in T.serial(repeats):
+                T.ptx_ldmatrix(
+                    T.float16,
+                    T.bool(False),
+                    4,
+                    ".b16",
+                    frag.data,
+                    0,
+                    T.address_of(A_shared[(tx // 32) * 16 + tx % 16, (tx % 32) // 16 * 8]),
+                    0,
+                )
+                for i in T.serial(8):
+                    acc[i] += frag[i]
+            for i in T.serial(8):
+                O[bx, tx, i] = acc[i]
+
+    kernel = tilelang.compile(ldmatrix, out_idx=[1])
+    a = torch.ones(rows, 16, device=device, dtype=torch.float16)
+    return num_blocks * warps * repeats * 512 / _bench(kernel, a)
+
+
+def _measure_load_latency(device, num_sms, l2_bytes):
+    import torch
+    import tilelang
+    import tilelang.language as T
+
+    repeats, rows, cols = 2048, 8, 64
+
+    @T.prim_func
+    def chase(A: T.Tensor((repeats * rows, cols), T.float16), O: T.Tensor((rows, cols), T.float16)):
+        with T.Kernel(1, threads=128):
+            A_shared = T.alloc_shared((rows, cols), T.float16)
+            # each load overwrites the tile of the previous one and waits
+            for r in T.serial(repeats):
+                T.copy(A[r * rows, 0], A_shared)
+            T.copy(A_shared, O)
+
+    kernel = tilelang.compile(chase, out_idx=[1])
+    a = torch.ones(repeats * rows, cols, device=device, dtype=torch.float16)
+    return _bench(kernel, a) / repeats
+
+
+def _tensor_core_dtypes(sm_version: int) -> list[tuple[str, str]]:
+    dtypes = [("float16", "float32"), ("bfloat16", "float32"), ("int8", "int32")]
+    if sm_version >= 89:
+        dtypes.append(("float8_e4m3", "float32"))
+    return dtypes
+
+
+def _measure_tensor_flops(device, num_sms, l2_bytes, in_dtype, accum_dtype):
+    import torch
+    import tilelang
+    import tilelang.language as T
+    from tilelang.utils.tensor import map_torch_type
+
+    block_M, block_N, block_K, repeats = 128, 128, 64, 256
+    num_blocks = 2 * num_sms
+
+    @T.prim_func
+    def mma(
+        A: T.Tensor((block_M, block_K), in_dtype),
+        B: T.Tensor((block_N, block_K), in_dtype),
+        C: T.Tensor((num_blocks * block_M, block_N), accum_dtype),
+    ):
+        with T.Kernel(num_blocks, threads=128) as bx:
+            A_shared = T.alloc_shared((block_M, block_K), in_dtype)
+            B_shared = T.alloc_shared((block_N, block_K), in_dtype)
+            C_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+            T.copy(A, A_shared)
+            T.copy(B, B_shared)
+            T.clear(C_local)
+            for _ in T.serial(repeats):
+                T.gemm(A_shared, B_shared, C_local, transpose_B=True)
+            T.copy(C_local, C[bx * block_M, 0])
+
+    kernel = tilelang.compile(mma, out_idx=[2])
+    torch_dtype = map_torch_type(in_dtype)
+    if in_dtype == "int8":
+        a = torch.randint(-4, 4, (block_M, block_K), device=device, dtype=torch_dtype)
+        b = torch.randint(-4, 4, (block_N, block_K), device=device, dtype=torch_dtype)
+    else:
+        # random operands, the tensor cores draw less power on zeros
+        a = torch.randn(block_M, block_K, device=device).to(torch_dtype)
+        b = torch.randn(block_N, block_K, device=device).to(torch_dtype)
+    return 2.0 * block_M * block_N * block_K * repeats * num_blocks / _bench(kernel, a, b)
+
+
+def _measure_atomic_throughput(device, num_sms, l2_bytes):
+    import torch
+    import tilelang
+    import tilelang.language as T
+
+    num_blocks, threads, repeats, slots = 4 * num_sms, 256, 256, 1 << 16
+
+    @T.prim_func
+    def atomics(O: T.Tensor((slots,), T.float32)):
+        with T.Kernel(num_blocks, threads=threads) as bx:
+            for r in T.serial(repeats):
+                for i in T.Parallel(threads):
+                    T.atomic_add(O[(bx * threads + i + r * 32) % slots], 1.0)
+
+    kernel = tilelang.compile(atomics)
+    o = torch.zeros(slots, device=device, dtype=torch.float32)
+    return num_blocks * threads * repeats / _bench(kernel, o)
+
+
+_MEASURES = {
+    "dram_bandwidth": _measure_dram_bandwidth,
+    "l2_bandwidth": _measure_l2_bandwidth,
+    "smem_bandwidth": _measure_smem_bandwidth,
+    "ldmatrix_bandwidth": _measure_ldmatrix_bandwidth,
+    "load_latency": _measure_load_latency,
+    "atomic_throughput": _measure_atomic_throughput,
+}
+
+
+def calibrate_device(device_id: int = 0, benchmarks: list[str] | None = None, save: bool = True) -> dict:
+    """Measure the device and return its profile, stored unless save is False.
+
+    Only the given benchmarks run when benchmarks is set, the measurements
+    of the others are kept from the stored profile.
+    """
+    import torch
+
+    benchmarks = list(BENCHMARKS) if benchmarks is None else benchmarks
+    unknown = set(benchmarks) - set(BENCHMARKS)
+    if unknown:
+        raise ValueError(f"Unknown benchmarks {sorted(unknown)}, expected a subset of {BENCHMARKS}")
+    key = profile_key(device_id)
+    if key is None:
+        raise RuntimeError(f"Cannot find cuda device {device_id}.")
+    torch.cuda.set_device(device_id)
+    device = torch.device("cuda", device_id)
+    prop = cuda_driver.get_cuda_device_properties(device_id)
+    num_sms = cuda_driver.get_num_sms(device_id)
+    clock_hz = float(cuda_driver.get_clock_rate_khz(device_id)) * 1e3
+    l2_bytes = int(prop.L2_cache_size)
+
+    previous = load_profile(device_id)
+    measurements = dict(previous["measurements"]) if previous else {}
+    for name in benchmarks:
+        start = time.time()
+        try:
+            if name == "tensor_flops":
+                flops = dict(measurements.get("tensor_flops", {}))
+                for in_dtype, accum_dtype in _tensor_core_dtypes(prop.major * 10 + prop.minor):
+                    flops[in_dtype] = _measure_tensor_flops(device, num_sms, l2_bytes, in_dtype, accum_dtype)
+                measurements[name] = flops
+            else:
+                measurements[name] = _MEASURES[name](device, num_sms, l2_bytes)
+        except Exception as e:  # noqa: BLE001
+            # a failing micro-kernel leaves the nominal parameter in place
+            logger.warning(f"Calibration benchmark {name} failed on {key}: {e}")
+            continue
+        logger.info(f"{name} = {measurements[name]} ({time.time() - start:.1f}s)")
+
+    profile = {
+        "version": PROFILE_VERSION,
+        "key": key,
+        "device": cuda_driver.get_device_name(device_id),
+        "num_sms": num_sms,
+        "clock_hz": clock_hz,
+        "created": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "measurements": measurements,
+        "cost_params": cost_params_from_measurements(measurements, num_sms, clock_hz),
+    }
+    if save:
+        save_profile(profile, profile_path(device_id))
+    return profile
+
+
+if __name__ == "__main__":
+    from argparse import ArgumentParser
+
+    parser = ArgumentParser(description="Calibrate the TileLang device parameters of a GPU with micro-benchmarks")
+    parser.add_argument("--device", type=int, default=0, help="CUDA device to calibrate")
+    parser.add_argument("--benchmarks", type=str, default=None, help=f"comma separated subset of {','.join(BENCHMARKS)}")
+    parser.add_argument("--dry-run", action="store_true", help="print the profile without storing it")
+    args = parser.parse_args()
+    logging.basicConfig(level=logging.INFO)
+    result = calibrate_device(args.device, args.benchmarks.split(",") if args.benchmarks else None, save=not args.dry_run)
+    print(json.dumps(result, indent=2, sort_keys=True))
@@ -8,6 +8,32 @@ def is_cdna_arch(arch: TileDevice) -> bool:
     return isinstance(arch, CDNA)
 
 
+def is_cdna4_arch(arch: TileDevice) -> bool:
+    return is_cdna_arch(arch) and arch.mcpu.startswith("gfx950")
+
+
+# (in_dtype, accum_dtype) of the MFMAs of CDNA3, which reads the fnuz FP8
+# encodings, and of CDNA4, which reads the OCP ones
+cdna3_matrix_core_supported = [
+    ("float16", "float32"),
+    ("bfloat16", "float32"),
+    ("int8", "int32"),
+    ("float8_e4m3fnuz", "float32"),
+    ("float8_e5m2fnuz", "float32"),
+]
+cdna4_matrix_core_supported = cdna3_matrix_core_supported[:3] + [
+    ("float8_e4m3fn", "float32"),
+    ("float8_e5m2", "float32"),
+]
+
+# Dense MFMA FLOP per CU per clock for 16-bit inputs, 8-bit inputs run at
+# twice the rate and the FP6/FP4 f8f6f4 MFMAs of CDNA4 at four times
+_MFMA_FLOPS_PER_CU_CLOCK = {
+    "gfx942": 2048,
+    "gfx950": 4096,
+}
+
+
 class CDNA(TileDevice):
     def __init__(self, target: Target | str):
         if isinstance(target, str):
@@ -29,9 +55,40 @@ class CDNA(TileDevice):
         self.transaction_size: list[int] = [32, 128]  # in bytes
 
         self.bandwidth: list[int] = [1300, 14000]
+        self.mcpu: str = str(target.attrs.get("mcpu", ""))
+
+    @property
+    def matrix_core_supported(self) -> list[tuple[str, str]]:
+        return cdna4_matrix_core_supported if is_cdna4_arch(self) else cdna3_matrix_core_supported
+
+    def get_avaliable_tensorintrin_shapes(self):
+        return [[16, 16]]
+
+    def get_mfma_k(self, in_dtype: str) -> int:
+        """K of one MFMA of ``in_dtype`` inputs, the granularity of block_K."""
+        in_dtype = str(in_dtype)
+        if in_dtype in ("float8_e4m3fn", "float8_e5m2") and is_cdna4_arch(self):
+            # v_mfma_f32_16x16x128_f8f6f4
+            return 128
+        return 32 if "float8" in in_dtype or in_dtype == "int8" else 16
+
+    def peak_tensor_flops(self, dtype: str = "float16") -> float | None:
+        flops_per_cu_clock = _MFMA_FLOPS_PER_CU_CLOCK.get(self.mcpu.split(":")[0])
+        clock_khz = getattr(self.device, "max_clock_rate", None)
+        if flops_per_cu_clock is None or not clock_khz:
+            return None
+        dtype = str(dtype)
+        if dtype.startswith("float8") or dtype in ("int8", "uint8"):
+            flops_per_cu_clock *= 2
+        elif dtype.startswith(("float6", "float4")) and is_cdna4_arch(self):
+            flops_per_cu_clock *= 4
+        elif dtype not in ("float16", "bfloat16"):
+            return None
+        return float(flops_per_cu_clock) * self.compute_max_core * clock_khz * 1e3
 
 
 __all__ = [
     "is_cdna_arch",
+    "is_cdna4_arch",
     "CDNA",
 ]
@@ -2,11 +2,13 @@ from __future__ import annotations
 import tvm
 from tvm.target import Target
 from .arch_base import TileDevice
+from .cdna import is_cdna_arch
 from .driver import cuda_driver
+from . import calibration
 
 
 def check_sm_version(arch: str) -> int:
-    sm_version = arch.replace("sm_", "")
+    sm_version = arch.replace("sm_", "").rstrip("af")
     return int(sm_version) if sm_version.isdigit() else -1
 
 
@@ -43,6 +45,20 @@ def is_hopper_arch(arch: TileDevice) -> bool:
     return all(conditions)
 
 
+def is_blackwell_arch(arch: TileDevice) -> bool:
+    conditions = [True]
+    conditions.append(is_cuda_arch(arch))
+    conditions.append(arch.sm_version >= 100 and arch.sm_version <= 110)
+    return all(conditions)
+
+
+def is_consumer_blackwell_arch(arch: TileDevice) -> bool:
+    conditions = [True]
+    conditions.append(is_cuda_arch(arch))
+    conditions.append(arch.sm_version >= 120 and arch.sm_version < 130)
+    return all(conditions)
+
+
 def has_mma_support(arch: TileDevice) -> bool:
     conditions = [True]
     conditions.append(is_cuda_arch(arch))
@@ -72,6 +88,9 @@ ada_tensorcore_supported = [
     ("float8_e4m3", "float32"),
 ]
 hopper_tensorcore_supported = ada_tensorcore_supported
+blackwell_tensorcore_supported = ada_tensorcore_supported
+# sm120 has no wgmma nor tcgen05, its warp level mma covers the types of ada
+consumer_blackwell_tensorcore_supported = ada_tensorcore_supported
 
 
 # TODO(lei): we should consider the dtype of the input a and b
@@ -86,6 +105,12 @@ def is_tensorcore_supported_precision(in_dtype: str, accum_dtype: str, arch: Til
         return (in_dtype, accum_dtype) in ada_tensorcore_supported
     elif is_hopper_arch(arch):
         return (in_dtype, accum_dtype) in hopper_tensorcore_supported
+    elif is_blackwell_arch(arch):
+        return (in_dtype, accum_dtype) in blackwell_tensorcore_supported
+    elif is_consumer_blackwell_arch(arch):
+        return (in_dtype, accum_dtype) in consumer_blackwell_tensorcore_supported
+    elif is_cdna_arch(arch):
+        return (in_dtype, accum_dtype) in arch.matrix_core_supported
     else:
         raise ValueError(f"Unsupported architecture: {arch}")
 
@@ -101,6 +126,62 @@ class TensorInstruction:
         self.shape: list[int] = shape
 
 
+# Dense fp16 tensor core FLOP per SM per clock of each architecture.
+_TENSOR_FLOPS_PER_SM_CLOCK = {
+    70: 1024,
+    75: 1024,
+    80: 2048,
+    86: 1024,
+    89: 1024,
+    90: 4096,
+    100: 8192,
+    120: 1024,
+}
+
+# Analytical cost model parameters of each architecture, per SM and per clock
+# unless noted. These are nominal figures, the tilelang.carver calibration
+# replaces them with measured ones via CUDA.calibrate.
+#   cuda_core_flops_per_sm_clock: fp32 FMA throughput, in FLOP
+#   smem_bytes_per_sm_clock: shared memory bandwidth of one SM
+#   l2_bytes_per_clock: L2 bandwidth of the whole device
+#   dram_latency_cycles: latency of a global load, paid by every pipeline fill
+#   mma_sync_efficiency: fraction of the tensor core peak reached by warp
+#       level mma when the wider wgmma/tcgen05 instructions cannot be used
+#   max_cluster_size: largest portable thread block cluster
+_ARCH_COST_PARAMS = {
+    70: dict(cuda_core_flops_per_sm_clock=128, smem_bytes_per_sm_clock=128, l2_bytes_per_clock=2048, dram_latency_cycles=600),
+    75: dict(cuda_core_flops_per_sm_clock=128, smem_bytes_per_sm_clock=128, l2_bytes_per_clock=1536, dram_latency_cycles=600),
+    80: dict(cuda_core_flops_per_sm_clock=128, smem_bytes_per_sm_clock=128, l2_bytes_per_clock=5120, dram_latency_cycles=700),
+    86: dict(cuda_core_flops_per_sm_clock=256, smem_bytes_per_sm_clock=128, l2_bytes_per_clock=2048, dram_latency_cycles=700),
+    89: dict(cuda_core_flops_per_sm_clock=256, smem_bytes_per_sm_clock=128, l2_bytes_per_clock=2560, dram_latency_cycles=700),
+    90: dict(
+        cuda_core_flops_per_sm_clock=256,
+        smem_bytes_per_sm_clock=128,
+        l2_bytes_per_clock=8192,
+        dram_latency_cycles=800,
+        mma_sync_efficiency=0.6,
+        max_cluster_size=8,
+    ),
+    100: dict(
+        cuda_core_flops_per_sm_clock=256,
+        smem_bytes_per_sm_clock=128,
+        l2_bytes_per_clock=12288,
+        dram_latency_cycles=800,
+        mma_sync_efficiency=0.3,
+        max_cluster_size=8,
+    ),
+    # sm120 has neither wgmma nor tcgen05, mma.sync is its widest MMA
+    120: dict(
+        cuda_core_flops_per_sm_clock=256,
+        smem_bytes_per_sm_clock=128,
+        l2_bytes_per_clock=4096,
+        dram_latency_cycles=700,
+        mma_sync_efficiency=1.0,
+        max_cluster_size=8,
+    ),
+}
+
+
 class CUDA(TileDevice):
     def __init__(self, target: Target | str):
         if isinstance(target, str):
@@ -132,6 +213,36 @@ class CUDA(TileDevice):
         # get the available tensor instructions during runtime to avoid
         # the dependency of the tensor intrinsics registration
         self.available_tensor_instructions: list[TensorInstruction] = None
+        # asynchronous copy and tensor core features of the device
+        device_sm = int(self.compute_capability) if self.compute_capability.isdigit() else self.sm_version
+        self.has_tma: bool = device_sm >= 90
+        self.has_wgmma: bool = device_sm // 10 == 9
+        # tensor memory is exclusive to the datacenter Blackwell parts
+        self.has_tmem: bool = 100 <= device_sm <= 110
+        # tensor memory of an SM: 128 lanes of 512 32-bit columns
+        self.tmem_bytes: int = 128 * 512 * 4 if self.has_tmem else 0
+        self.cost_params: dict = self._default_cost_params(device_sm)
+        # measured parameters of the device, see tilelang.carver.arch.calibration
+        self.profile: dict | None = calibration.load_profile()
+        if self.profile is not None:
+            self.calibrate(self.profile["cost_params"])
+
+    def _default_cost_params(self, device_sm: int) -> dict:
+        known = [v for v in _ARCH_COST_PARAMS if v <= device_sm]
+        params = dict(mma_sync_efficiency=1.0, max_cluster_size=1)
+        params.update(_ARCH_COST_PARAMS[max(known) if known else min(_ARCH_COST_PARAMS)])
+        tensor_known = [v for v in _TENSOR_FLOPS_PER_SM_CLOCK if v <= device_sm]
+        params["tensor_flops_per_sm_clock"] = _TENSOR_FLOPS_PER_SM_CLOCK[max(tensor_known)] if tensor_known else 0
+        params["clock_hz"] = float(cuda_driver.get_clock_rate_khz() or 0) * 1e3
+        params["dram_bandwidth"] = float(cuda_driver.get_dram_bandwidth() or 0)
+        return params
+
+    def calibrate(self, params: dict) -> None:
+        """Replace cost model parameters with measured values, see _ARCH_COST_PARAMS."""
+        unknown = set(params) - set(self.cost_params)
+        if unknown:
+            raise ValueError(f"Unknown cost model parameters: {sorted(unknown)}")
+        self.cost_params.update(params)
 
     def get_avaliable_tensorintrin_shapes(self):
         self.available_tensor_instructions = (
@@ -140,6 +251,39 @@ class CUDA(TileDevice):
         )
         return [t.shape for t in self.available_tensor_instructions]
 
+    def peak_memory_bandwidth(self) -> float | None:
+        if self.profile is not None and "dram_bandwidth" in self.profile["measurements"]:
+            return self.profile["measurements"]["dram_bandwidth"]
+        return cuda_driver.get_dram_bandwidth()
+
+    def peak_tensor_flops(self, dtype: str = "float16") -> float | None:
+        if self.profile is not None:
+            measured = self.profile["measurements"].get("tensor_flops", {})
+            if str(dtype) in measured:
+                return measured[str(dtype)]
+        # Dense tensor core FLOP per SM per clock for 16-bit inputs; other input
+        # types scale by their width, fp8 only where the hardware supports it.
+        known = [v for v in _TENSOR_FLOPS_PER_SM_CLOCK if v <= self.sm_version]
+        if not known:
+            return None
+        flops_per_sm_clock = _TENSOR_FLOPS_PER_SM_CLOCK[max(known)]
+        dtype = str(dtype)
+        if dtype in ("float8_e4m3", "float8_e5m2", "float8_e4m3fn", "float8_e5m2fnuz", "float8_e4m3fnuz"):
+            if self.sm_version < 89:
+                return None
+            flops_per_sm_clock *= 2
+        elif dtype in ("int8", "uint8"):
+            flops_per_sm_clock *= 2
+        elif dtype == "float32":
+            # tf32
+            flops_per_sm_clock //= 2
+        elif dtype not in ("float16", "bfloat16"):
+            return None
+        clock_khz = cuda_driver.get_clock_rate_khz()
+        if not clock_khz:
+            return None
+        return float(flops_per_sm_clock) * self.compute_max_core * clock_khz * 1e3
+
     def __repr__(self):
         return f"CUDA({self.target})"
 
@@ -150,6 +294,8 @@ __all__ = [
     "is_ampere_arch",
     "is_ada_arch",
     "is_hopper_arch",
+    "is_blackwell_arch",
+    "is_consumer_blackwell_arch",
     "is_tensorcore_supported_precision",
     "has_mma_support",
     "CUDA",
@@ -7,4 +7,6 @@ from .cuda_driver import (
     get_persisting_l2_cache_max_size,  # noqa: F401
     get_num_sms,  # noqa: F401
     get_registers_per_block,  # noqa: F401
+    get_clock_rate_khz,  # noqa: F401
+    get_dram_bandwidth,  # noqa: F401
 )
@@ -15,6 +15,9 @@ class cudaDeviceAttrNames:
 
     cudaDevAttrMaxThreadsPerBlock: int = 1
     cudaDevAttrMaxRegistersPerBlock: int = 12
+    cudaDevAttrClockRate: int = 13
+    cudaDevAttrMemoryClockRate: int = 36
+    cudaDevAttrGlobalMemoryBusWidth: int = 37
     cudaDevAttrMaxSharedMemoryPerMultiprocessor: int = 81
     cudaDevAttrMaxPersistingL2CacheSize: int = 108
 
@@ -127,3 +130,22 @@ def get_registers_per_block(device_id: int = 0) -> int:
         device_id,
     )
     return prop
+
+
+def get_clock_rate_khz(device_id: int = 0) -> int | None:
+    """
+    Get the peak SM clock frequency in kHz.
+    """
+    return get_device_attribute(cudaDeviceAttrNames.cudaDevAttrClockRate, device_id)
+
+
+def get_dram_bandwidth(device_id: int = 0) -> float | None:
+    """
+    Get the theoretical peak DRAM bandwidth in bytes per second, from the
+    memory clock (double data rate) and the memory bus width.
+    """
+    clock_khz = get_device_attribute(cudaDeviceAttrNames.cudaDevAttrMemoryClockRate, device_id)
+    bus_width = get_device_attribute(cudaDeviceAttrNames.cudaDevAttrGlobalMemoryBusWidth, device_id)
+    if not clock_khz or not bus_width:
+        return None
+    return 2.0 * clock_khz * 1e3 * bus_width / 8
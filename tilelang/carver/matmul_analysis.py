@@ -537,7 +537,7 @@ def get_tensorized_func_and_tags(
 
     # step2. transform function to tensorcore matmul (e.g. conv2d with im2col)
     def check_sm_version(arch: str) -> int:
-        sm_version = arch.replace("sm_", "")
+        sm_version = arch.replace("sm_", "").rstrip("af")
         return int(sm_version) if sm_version.isdigit() else -1
 
     def analysis_tensorcore_tags(sch: tir.Schedule, block: BlockRV, target: Target) -> bool | dict:
@@ -557,14 +557,14 @@ def get_tensorized_func_and_tags(
         # analysis pipeline stage
         # todo(lei): maybe we can integrate this into policy in the future
         tags["pipeline_stage"] = 1
-        if target.kind.name == "cuda" and check_sm_version(target.arch) in {80, 90}:
-            # enable pipeline stage only for sm_80 devices
+        if target.kind.name == "cuda" and check_sm_version(target.arch) in {80, 90, 120}:
+            # enable pipeline stage only for devices with cp.async and enough shared memory
             tags["pipeline_stage"] = 2
 
         # analysis async copy
         # todo(lei): maybe we can integrate this into policy in the future
         tags["use_async_copy"] = False
-        if tags["pipeline_stage"] == 2 and check_sm_version(target.arch) in {80, 90}:
+        if tags["pipeline_stage"] == 2 and check_sm_version(target.arch) in {80, 90, 120}:
             # async copy only works in software pipeline.
             tags["use_async_copy"] = True
 
@@ -1,5 +1,12 @@
 from .node import PrimFuncNode, OutputNode, Edge  # noqa: F401
-from .rasterization import NoRasterization, Rasterization2DRow, Rasterization2DColumn  # noqa: F401
+from .rasterization import (
+    NoRasterization,  # noqa: F401
+    Rasterization2DRow,  # noqa: F401
+    Rasterization2DColumn,  # noqa: F401
+    RasterizationMorton,  # noqa: F401
+    RasterizationHilbert,  # noqa: F401
+    get_rasterization_candidates,  # noqa: F401
+)
 from .hint import Hint  # noqa: F401
 from .policy import DefaultPolicy, TensorCorePolicy  # noqa: F401
 from ..arch import TileDevice, CUDA  # noqa: F401
@@ -0,0 +1,127 @@
+"""Analytical latency model used to rank the tiles of a policy"""
+
+from __future__ import annotations
+import math
+from dataclasses import dataclass
+
+from ..arch import TileDevice
+
+
+def _dtype_rate_scale(dtype: str | None) -> float | None:
+    """Tensor core throughput of dtype inputs relative to 16-bit inputs"""
+    if dtype is None or dtype in ("float16", "bfloat16"):
+        return 1.0
+    if dtype.startswith("float8") or dtype in ("int8", "uint8"):
+        return 2.0
+    if dtype == "float32":
+        # tf32
+        return 0.5
+    return None
+
+
+@dataclass
+class TileWorkload:
+    """The work of one thread block of a tiled kernel.
+
+    flops: arithmetic of the block
+    traffic: bytes the block moves between global and shared memory
+    grid_size: number of blocks of the kernel
+    block_per_SM: blocks resident on an SM at once
+    compulsory_bytes: size of the inputs and outputs, the traffic every
+        schedule pays to DRAM
+    num_stages: depth of the software pipeline that overlaps copies and
+        compute, 1 when they are serialized
+    tensor_core_dtype: input type of the tensor core instruction, None for
+        CUDA core arithmetic
+    tile_m: row extent of the block tile, wgmma and tcgen05 need multiples
+        of 64
+    cluster_size: blocks of a cluster that share their loads by multicast
+    """
+
+    flops: float
+    traffic: float
+    grid_size: int
+    block_per_SM: int
+    compulsory_bytes: float
+    num_stages: int = 1
+    tensor_core_dtype: str | None = None
+    tile_m: int | None = None
+    cluster_size: int = 1
+
+
+class TileCostModel:
+    """Roofline of a tiled kernel with wave quantization and pipelining.
+
+    Every resource an SM or the device offers (tensor or CUDA cores, shared
+    memory, L2, DRAM) bounds the kernel time by its load divided by its
+    throughput. Resources local to an SM are charged per wave, so that the
+    last partial wave costs a full one. A pipeline of S stages hides all but
+    1/S of the non-bottleneck time, and pays one DRAM latency per fill, i.e.
+    once per wave. Loads multicast across a cluster are fetched from L2 once
+    per cluster, while the clusters must be scheduled on whole groups of SMs.
+    """
+
+    def __init__(self, params: dict, num_sms: int):
+        self.params = params
+        self.num_sms = num_sms
+
+    @classmethod
+    def from_arch(cls, arch: TileDevice) -> TileCostModel | None:
+        """The model of arch, None when the arch lacks the parameters of one"""
+        params = getattr(arch, "cost_params", None)
+        if not params or not params.get("clock_hz") or not params.get("dram_bandwidth") or not arch.compute_max_core:
+            return None
+        return cls(params, arch.compute_max_core)
+
+    def compute_throughput(self, work: TileWorkload) -> float | None:
+        """FLOP per second of one SM on work"""
+        clock = self.params["clock_hz"]
+        if work.tensor_core_dtype is None or not self.params["tensor_flops_per_sm_clock"]:
+            return self.params["cuda_core_flops_per_sm_clock"] * clock
+        scale = _dtype_rate_scale(work.tensor_core_dtype)
+        if scale is None:
+            return None
+        rate = self.params["tensor_flops_per_sm_clock"] * scale * clock
+        if work.tile_m is not None and work.tile_m % 64 != 0:
+            # falls back from wgmma/tcgen05 to warp level mma
+            rate *= self.params["mma_sync_efficiency"]
+        return rate
+
+    def estimate(self, work: TileWorkload) -> float | None:
+        """Estimated latency of the kernel in seconds, None when unknown"""
+        compute_rate = self.compute_throughput(work)
+        if compute_rate is None or work.grid_size <= 0:
+            return None
+        params = self.params
+        clock = params["clock_hz"]
+        cluster = max(1, min(work.cluster_size, params["max_cluster_size"]))
+        usable_sms = (self.num_sms // cluster) * cluster
+        block_per_SM = max(1, work.block_per_SM)
+        num_wave = math.ceil(work.grid_size / (block_per_SM * usable_sms))
+
+        # Resources of an SM, charged per wave
+        sm_blocks = num_wave * block_per_SM
+        compute_time = sm_blocks * work.flops / compute_rate
+        smem_time = sm_blocks * work.traffic / (params["smem_bytes_per_sm_clock"] * clock)
+
+        # Shared resources, charged for the traffic of the whole grid. Half
+        # the loads of a block are assumed shared with its cluster, as the
+        # operand along the clustered dimension of a GEMM.
+        total_traffic = work.grid_size * work.traffic
+        l2_traffic = total_traffic * (1 + 1 / cluster) / 2
+        l2_time = l2_traffic / (params["l2_bytes_per_clock"] * clock)
+        # The blocks of a wave advance through their reduction together and
+        # the rasterization keeps their operands resident, so that the L2
+        # captures the reuse across blocks and DRAM only sees the tensors
+        dram_bytes = min(work.compulsory_bytes, l2_traffic)
+        dram_time = dram_bytes / params["dram_bandwidth"]
+
+        times = [compute_time, smem_time, l2_time, dram_time]
+        bound = max(times)
+        stages = max(1, work.num_stages)
+        exposed = (sum(times) - bound) / stages
+        fill = num_wave * params["dram_latency_cycles"] / clock
+        return bound + exposed + fill
+
+
+__all__ = ["TileWorkload", "TileCostModel"]
@@ -11,6 +11,7 @@ import tvm
 
 from ...arch import TileDevice
 from ..bestfit import BestFit
+from ..cost_model import TileCostModel, TileWorkload
 from ..hint import Hint, Stride, TileDict
 from .common import coalesced_factor, coalesced_tensor_shape, factorize, get_all_factors
 from ..node import PrimFuncNode, OutputNode, find_topo_sort
@@ -35,6 +36,7 @@ class DefaultPolicy:
         self.arch = arch
         self.tags = tags
         self.rasterization = NoRasterization()
+        self.cost_model = TileCostModel.from_arch(arch)
 
     @classmethod
     def from_prim_func(cls, func: tvm.tir.PrimFunc, arch: TileDevice, tags: dict | None = None, name: str = "PrimFuncNode"):
@@ -130,8 +132,47 @@ class DefaultPolicy:
                     add_to_queue(new_tile)
 
         visited_tiles = filter(lambda td: td.valid, visited_tiles.values())
-        sorted_tiles = sorted(visited_tiles, key=lambda td: prio(td))
-        return sorted_tiles
+        if self.cost_model is None:
+            return sorted(visited_tiles, key=lambda td: prio(td))
+        # rank the explored tiles by their modeled latency, which accounts for
+        # the compute and bandwidth bounds the traffic heuristic ignores
+        ranked = []
+        for td in visited_tiles:
+            latency = self.estimate_latency(td)
+            ranked.append((math.inf if latency is None else latency, prio(td), td))
+        return [td for _, _, td in sorted(ranked, key=lambda x: x[:2])]
+
+    def _compulsory_bytes(self) -> float:
+        nbytes = 0
+        for node in self.ordered_nodes:
+            for edge in node.inputs:
+                if edge.src_node.is_placeholder():
+                    nbytes += int(np.prod(edge.src_node.get_shape())) * ((edge.src_node.get_dtype().bits + 7) // 8)
+            for edge in node.outputs:
+                if edge.dst_node.is_output():
+                    nbytes += int(np.prod(node.get_shape(edge.src_id))) * ((node.get_dtype(edge.src_id).bits + 7) // 8)
+        return float(nbytes)
+
+    def make_workload(self, td: TileDict) -> TileWorkload:
+        """The work of one block of td, for the cost model"""
+        flops = 0
+        for node in self.ordered_nodes:
+            reduce_size = int(np.prod([node.extent_wrapper(ax.dom.extent) for ax in node.raxis])) if node.raxis else 1
+            # a multiply and an add per reduction step
+            flops += int(np.prod(td.get_tile(node))) * (2 * reduce_size if node.raxis else 1)
+        return TileWorkload(
+            flops=float(flops),
+            traffic=float(td.traffic),
+            grid_size=td.grid_size,
+            block_per_SM=td.block_per_SM,
+            compulsory_bytes=self._compulsory_bytes(),
+        )
+
+    def estimate_latency(self, td: TileDict) -> float | None:
+        """Modeled latency of td in seconds, None without a cost model"""
+        if self.cost_model is None:
+            return None
+        return self.cost_model.estimate(self.make_workload(td))
 
     def get_base_tile(self):
         """
@@ -31,7 +31,7 @@ class TensorCorePolicy(DefaultPolicy):
         if pipleline_stage:
             self.pipeline_stage = pipleline_stage
         else:
-            if self.arch.compute_capability in {"sm_80", "sm_90", "sm_90a"}:
+            if self.arch.compute_capability in {"sm_80", "sm_90", "sm_90a", "sm_120", "sm_120a"}:
                 self.pipeline_stage = 2
             else:
                 self.pipeline_stage = 1
@@ -39,7 +39,7 @@ class TensorCorePolicy(DefaultPolicy):
         if use_async_copy:
             self.use_async_copy = use_async_copy
         else:
-            if self.arch.compute_capability in {"sm_80", "sm_90", "sm_90a"}:
+            if self.arch.compute_capability in {"sm_80", "sm_90", "sm_90a", "sm_120", "sm_120a"}:
                 self.use_async_copy = True
             else:
                 self.use_async_copy = False
@@ -80,6 +80,18 @@ class TensorCorePolicy(DefaultPolicy):
         value *= self.pipeline_stage
         return value, cached_tensors
 
+    def make_workload(self, td: TileDict):
+        work = super().make_workload(td)
+        node = self.prim_func_node
+        if node.get_tag("tensorcore_config"):
+            ax_m, _ = node.get_tag("tensorcore_config")
+            in_dtypes = list(node.get_reduce_inputs_dtype().values())
+            work.tensor_core_dtype = str(in_dtypes[0]) if in_dtypes else None
+            work.tile_m = td.get_tile(node)[ax_m]
+        work.num_stages = self.pipeline_stage if self.use_async_copy else 1
+        work.cluster_size = node.get_tag("cluster_size") or 1
+        return work
+
     def _assign_reduce_step(self, node):
         if not node.get_tag("tensorcore_config"):
             return super()._assign_reduce_step(node)
@@ -331,7 +343,12 @@ class TensorCorePolicy(DefaultPolicy):
         conditions.append(_check_memory_size())
         if any(conditions):
             return NoRasterization()
-        # otherwise, simply provide a block rasterization factor
-        raster_factor = int(self.arch.compute_max_core**0.5)
+        # A column panel of width p keeps p tiles of A and about
+        # compute_max_core / p tiles of B resident per wave, the L2 footprint
+        # p * tile_m + compute_max_core / p * tile_n is minimal for
+        # p = sqrt(compute_max_core * tile_n / tile_m).
+        tile_m, tile_n = td.output_tile[-2:] if len(td.output_tile) >= 2 else (1, 1)
+        raster_factor = (self.arch.compute_max_core * tile_n / max(tile_m, 1)) ** 0.5
+        raster_factor = max(1, min(int(round(raster_factor)), self.arch.compute_max_core))
 
         return Rasterization2DColumn(raster_factor)
@@ -1,8 +1,12 @@
 """Rasteration Plan For L2 Cache Locality"""
 
+from __future__ import annotations
+
 
 class Rasterization:
     panel_width_ = None
+    # ``order`` argument of ``T.use_swizzle``, None if no swizzle is applied
+    swizzle_order_ = None
 
     def __init__(self) -> None:
         pass
@@ -10,6 +14,12 @@ class Rasterization:
     def get_code(self) -> list[str]:
         raise NotImplementedError()
 
+    def to_swizzle(self) -> dict | None:
+        """Keyword arguments of ``T.use_swizzle`` realizing this plan."""
+        if self.swizzle_order_ is None:
+            return None
+        return {"panel_size": self.panel_width, "order": self.swizzle_order_}
+
     @property
     def panel_width(self):
         assert self.panel_width_ is not None
@@ -36,6 +46,8 @@ class Rasterization2DRow(Rasterization):
         __________|
     """
 
+    swizzle_order_ = "row"
+
     def __init__(self, panel_width=4) -> None:
         super().__init__()
         self.panel_width_ = panel_width
@@ -56,6 +68,8 @@ class Rasterization2DColumn(Rasterization):
          |_| |_|
     """
 
+    swizzle_order_ = "column"
+
     def __init__(self, panel_width=4) -> None:
         super().__init__()
         self.panel_width_ = panel_width
@@ -87,3 +101,67 @@ __device__ __inline__ dim3 rasterization2DColumn(const int panel_width) {
             self.get_device_function(),
             f"const dim3 blockIdx = rasterization2DColumn({panel_width});\n",
         ]
+
+
+class RasterizationMorton(Rasterization):
+    """
+    Rasterization along a Z-order curve inside square groups of
+    panel_width x panel_width blocks, groups are visited row by row
+         _ _
+         _/ _/
+         _ _
+         _/ _/
+    """
+
+    swizzle_order_ = "morton"
+
+    def __init__(self, panel_width=4) -> None:
+        super().__init__()
+        assert panel_width > 0 and panel_width & (panel_width - 1) == 0, "panel_width must be a power of two"
+        self.panel_width_ = panel_width
+
+    def __repr__(self) -> str:
+        return f"<RasterizationMorton({self.panel_width_})>"
+
+    def get_code(self) -> list[str]:
+        raise NotImplementedError()
+
+
+class RasterizationHilbert(Rasterization):
+    """
+    Rasterization along a Hilbert curve inside square groups of
+    panel_width x panel_width blocks, groups are visited row by row
+         _   _
+        | |_| |
+        |_   _|
+         _| |_
+    """
+
+    swizzle_order_ = "hilbert"
+
+    def __init__(self, panel_width=4) -> None:
+        super().__init__()
+        assert panel_width > 0 and panel_width & (panel_width - 1) == 0, "panel_width must be a power of two"
+        self.panel_width_ = panel_width
+
+    def __repr__(self) -> str:
+        return f"<RasterizationHilbert({self.panel_width_})>"
+
+    def get_code(self) -> list[str]:
+        raise NotImplementedError()
+
+
+def get_rasterization_candidates(panel_widths: tuple[int, ...] = (2, 4, 8, 16), include_curves: bool = True) -> list[Rasterization]:
+    """Enumerate rasterization plans to be used as a tunable choice.
+
+    Each candidate maps onto ``T.use_swizzle(**plan.to_swizzle())``, while
+    ``NoRasterization`` keeps the default launch order.
+    """
+    candidates: list[Rasterization] = [NoRasterization()]
+    for panel_width in panel_widths:
+        candidates.append(Rasterization2DRow(panel_width))
+        candidates.append(Rasterization2DColumn(panel_width))
+        if include_curves and panel_width & (panel_width - 1) == 0:
+            candidates.append(RasterizationMorton(panel_width))
+            candidates.append(RasterizationHilbert(panel_width))
+    return candidates
@@ -5,5 +5,10 @@ from .matmul import MatmulTemplate  # noqa: F401
 from .gemv import GEMVTemplate  # noqa: F401
 from .elementwise import ElementwiseTemplate  # noqa: F401
 from .general_reduce import GeneralReductionTemplate  # noqa: F401
+from .split_reduce import SplitRowReductionTemplate  # noqa: F401
 from .flashattention import FlashAttentionTemplate  # noqa: F401
+from .flashattention_bwd import FlashAttentionBwdTemplate  # noqa: F401
 from .conv import ConvTemplate  # noqa: F401
+from .grouped_matmul import GroupedMatmulTemplate  # noqa: F401
+from .chunk_scan import ChunkScanTemplate  # noqa: F401
+from .fused import FusedMLPTemplate, FusedNormMatmulTemplate  # noqa: F401
@@ -0,0 +1,318 @@
+from dataclasses import dataclass
+from .base import BaseTemplate
+from tvm import DataType, te
+from ..arch import TileDevice
+from ..roller import Hint
+from ..roller import PrimFuncNode, OutputNode
+from ..utils import get_roller_hints_from_output_nodes, get_tensorized_func_and_tags
+
+
+@dataclass
+class ChunkScanTemplate(BaseTemplate):
+    """
+    A template for chunked linear recurrences with a carried state.
+
+    Linear attention, gated linear attention and the SSD form of Mamba2 all
+    compute, per (batch, head) and time step ``t``::
+
+        h_t = exp(g_t) * h_{t-1} + k_t^T v_t      # h is [head_dim_k, head_dim_v]
+        o_t = scale * q_t h_t
+
+    The sequence is cut into chunks of ``chunk_size`` steps. With ``G`` the
+    cumulative log decay inside a chunk (``dA_cumsum`` of Mamba2), a chunk
+    takes the state ``h`` of the previous one and computes::
+
+        S = (q k^T * exp(G_i - G_j)) masked to j <= i   # intra-chunk
+        o = S v + (q * exp(G)) h                         # plus inter-chunk
+        h = exp(G_last) h + (k * exp(G_last - G))^T v    # carried state
+
+    ``chunk_scan_program`` emits the kernel: one block per (head_dim_v block,
+    batch * head) walks the chunks in a software pipelined loop, so the loads
+    of the next chunk overlap the GEMMs of the current one, while ``h`` stays
+    in a register fragment for the whole sequence. Without gating the decay
+    terms vanish and the kernel is plain causal linear attention.
+
+    Attributes:
+        batch_size (int): Batch size.
+        num_heads (int): Number of heads.
+        seq_length (int): Sequence length, a multiple of ``chunk_size``.
+        head_dim_k (int): Head dimension of q and k (``dstate`` of Mamba2).
+        head_dim_v (int): Head dimension of v and o.
+        chunk_size (int): Time steps of a chunk.
+        gated (bool): Whether the state decays by ``exp(g_t)`` every step.
+        scale (float): Scale of q, ``head_dim_k ** -0.5`` when None.
+        use_initial_state (bool): Whether the scan starts from a given state.
+    """
+
+    _output_nodes: list[OutputNode] = None
+
+    # Operation-related configuration parameters
+    batch_size: int = 1
+    num_heads: int = 1
+    seq_length: int = 1
+    head_dim_k: int = 1
+    head_dim_v: int = 1
+    chunk_size: int = 64
+
+    gated: bool = False
+    scale: float = None
+    use_initial_state: bool = False
+
+    in_dtype: str = "float16"
+    out_dtype: str = "float16"
+    accum_dtype: str = "float32"
+
+    @property
+    def num_chunks(self) -> int:
+        """Number of chunks of a sequence."""
+        return self.seq_length // self.chunk_size
+
+    def shared_memory_bytes(self, block_DV: int, num_stages: int) -> int:
+        """
+        Returns the shared memory a configuration of the kernel allocates.
+
+        Args:
+            block_DV (int): Columns of ``head_dim_v`` a block owns.
+            num_stages (int): Pipeline stages of the chunk loop.
+
+        Returns:
+            int: Bytes of shared memory.
+        """
+        C, DK = self.chunk_size, self.head_dim_k
+        in_bytes = (DataType(str(self.in_dtype)).bits + 7) // 8
+        # q, k and v of every stage, the masked scores and the state operand
+        elems = num_stages * (2 * C * DK + C * block_DV) + C * C + DK * block_DV
+        nbytes = elems * in_bytes
+        if self.gated:
+            # The decayed q and k, and the log decays of every stage
+            nbytes += 2 * C * DK * in_bytes + num_stages * C * 4
+        return nbytes
+
+    def get_autotune_configs(self, topk: int = 10) -> list[dict]:
+        """
+        Returns autotuner configurations of ``chunk_scan_program``.
+
+        Every configuration holds ``block_DV``, ``num_stages`` and ``threads``.
+        ``block_DV`` comes from the columns of the roller hints of the
+        intra-chunk matmul, rounded to a divisor of ``head_dim_v``; stages
+        that exceed the shared memory of the architecture are dropped.
+
+        Args:
+            topk (int, optional): Number of roller hints to consider.
+
+        Returns:
+            List[dict]: Distinct configurations, the preferred one first.
+        """
+        divisors = [b for b in (128, 64, 32, 16) if self.head_dim_v % b == 0] or [self.head_dim_v]
+        block_DVs = []
+        for hint in self.recommend_hints(topk=topk) or []:
+            block_DV = next((b for b in divisors if b <= hint.block[-1]), divisors[-1])
+            block_DVs.append(block_DV)
+        block_DVs = list(dict.fromkeys(block_DVs + [next((b for b in divisors if b <= 64), divisors[-1])]))
+
+        smem_cap = getattr(self.arch, "smem_cap", None) if self.arch is not None else None
+        configs = []
+        for block_DV in block_DVs:
+            for num_stages in (2, 1):
+                if smem_cap is not None and self.shared_memory_bytes(block_DV, num_stages) > smem_cap:
+                    continue
+                # Four warps cover a 64-row chunk, larger chunks take eight
+                threads = 128 if self.chunk_size <= 64 else 256
+                config = {"block_DV": block_DV, "num_stages": num_stages, "threads": threads}
+                if config not in configs:
+                    configs.append(config)
+        return configs
+
+    def get_hardware_aware_configs(self, arch: TileDevice = None, topk: int = 10) -> list[Hint]:
+        """
+        Retrieves optimized hardware-aware configurations.
+
+        Args:
+            arch (TileDevice, optional): The target hardware architecture.
+            topk (int, optional): Number of top configurations to consider.
+
+        Returns:
+            List[Hint]: A list of optimization hints for hardware acceleration.
+        """
+        roller_hints = get_roller_hints_from_output_nodes(self.output_nodes, arch=arch, topk=topk)
+        return roller_hints
+
+    def initialize_function(self) -> None:
+        """
+        Defines the intra-chunk matmul ``o = S v`` of every chunk for the roller.
+
+        The state pass has the same operand tiles, so the tile of ``S v`` is
+        taken for the whole kernel.
+
+        Raises:
+            AssertionError: If the sequence is not made of whole chunks.
+        """
+        assert self.chunk_size > 0 and self.seq_length % self.chunk_size == 0, (
+            f"seq_length ({self.seq_length}) must be a multiple of chunk_size ({self.chunk_size})"
+        )
+        if self.scale is None:
+            self.scale = self.head_dim_k**-0.5
+
+        B = self.batch_size * self.num_heads * self.num_chunks
+        M, N, K = self.chunk_size, self.head_dim_v, self.chunk_size
+        in_dtype, accum_dtype, out_dtype = self.in_dtype, self.accum_dtype, self.out_dtype
+
+        A = te.placeholder((B, M, K), name="A", dtype=in_dtype)
+        W = te.placeholder((B, K, N), name="B", dtype=in_dtype)
+        k = te.reduce_axis((0, K), name="k")
+        C = te.compute(
+            (B, M, N),
+            lambda b, i, j: te.sum(A[b, i, k].astype(accum_dtype) * W[b, k, j].astype(accum_dtype), axis=k),
+            name="C",
+        )
+        if out_dtype != accum_dtype:
+            C = te.compute((B, M, N), lambda b, i, j: C[b, i, j].astype(out_dtype), name="D")
+        func = te.create_prim_func([A, W, C])
+        self.set_function(func)
+
+        tensorized_func, tags = get_tensorized_func_and_tags(func, self.arch.target)
+        assert tags is not None
+        self.set_output_nodes([OutputNode(PrimFuncNode(tensorized_func, name="ChunkMMA", tags=tags))])
+
+    def chunk_scan_program(self, block_DV: int = 64, num_stages: int = 2, threads: int = 128):
+        """
+        Builds the pipelined chunk scan kernel.
+
+        The program reads ``Q [B, S, H, DK]``, ``K [B, S, H, DK]``, ``V [B, S, H, DV]``,
+        the chunk-local cumulative log decays ``G [B, H, S]`` and the initial
+        state ``H0 [B, H, DK, DV]``, and writes ``O [B, S, H, DV]`` and the final
+        state ``HT [B, H, DK, DV]``. ``G`` is only read when ``gated`` and ``H0``
+        only with ``use_initial_state``.
+
+        Args:
+            block_DV (int, optional): Columns of ``head_dim_v`` a block owns.
+            num_stages (int, optional): Pipeline stages of the chunk loop.
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        if self.scale is None:
+            self.scale = self.head_dim_k**-0.5
+        assert self.seq_length % self.chunk_size == 0, "seq_length must be a multiple of chunk_size"
+        assert self.head_dim_v % block_DV == 0, "head_dim_v must be a multiple of block_DV"
+
+        Bs, H, S = self.batch_size, self.num_heads, self.seq_length
+        DK, DV, C = self.head_dim_k, self.head_dim_v, self.chunk_size
+        NT, NV = self.num_chunks, DV // block_DV
+        gated, use_initial_state, scale = self.gated, self.use_initial_state, self.scale
+        dtype, out_dtype, accum_dtype = self.in_dtype, self.out_dtype, self.accum_dtype
+
+        @T.prim_func
+        def main(
+            Q: T.Tensor((Bs, S, H, DK), dtype),
+            K: T.Tensor((Bs, S, H, DK), dtype),
+            V: T.Tensor((Bs, S, H, DV), dtype),
+            G: T.Tensor((Bs, H, S), T.float32),
+            H0: T.Tensor((Bs, H, DK, DV), accum_dtype),
+            O: T.Tensor((Bs, S, H, DV), out_dtype),
+            HT: T.Tensor((Bs, H, DK, DV), accum_dtype),
+        ):
+            with T.Kernel(NV, Bs * H, threads=threads) as (i_v, i_bh):
+                i_b = i_bh // H
+                i_h = i_bh % H
+
+                q = T.alloc_shared((C, DK), dtype)
+                k = T.alloc_shared((C, DK), dtype)
+                v = T.alloc_shared((C, block_DV), dtype)
+                g = T.alloc_shared((C,), T.float32)
+                q_decay = T.alloc_shared((C, DK), dtype)
+                k_decay = T.alloc_shared((C, DK), dtype)
+                s = T.alloc_fragment((C, C), accum_dtype)
+                s_shared = T.alloc_shared((C, C), dtype)
+                o = T.alloc_fragment((C, block_DV), accum_dtype)
+                h = T.alloc_fragment((DK, block_DV), accum_dtype)
+                h_shared = T.alloc_shared((DK, block_DV), dtype)
+
+                if use_initial_state:
+                    T.copy(H0[i_b, i_h, :, i_v * block_DV : (i_v + 1) * block_DV], h)
+                else:
+                    T.clear(h)
+
+                for i in T.Pipelined(NT, num_stages=num_stages):
+                    for r, c in T.Parallel(C, DK):
+                        q[r, c] = Q[i_b, i * C + r, i_h, c] * scale
+                    T.copy(K[i_b, i * C : (i + 1) * C, i_h, :], k)
+                    T.copy(V[i_b, i * C : (i + 1) * C, i_h, i_v * block_DV : (i_v + 1) * block_DV], v)
+                    if gated:
+                        T.copy(G[i_b, i_h, i * C : (i + 1) * C], g)
+
+                    # Intra-chunk: causal, decayed scores times v
+                    T.gemm(q, k, s, clear_accum=True, transpose_B=True)
+                    if gated:
+                        for r, c in T.Parallel(C, C):
+                            s_shared[r, c] = T.if_then_else(r >= c, s[r, c] * T.exp(g[r] - g[c]), 0)
+                    else:
+                        for r, c in T.Parallel(C, C):
+                            s_shared[r, c] = T.if_then_else(r >= c, s[r, c], 0)
+                    T.gemm(s_shared, v, o, clear_accum=True)
+
+                    # Inter-chunk: the state of the previous chunks, then the carried update
+                    T.copy(h, h_shared)
+                    if gated:
+                        for r, c in T.Parallel(C, DK):
+                            q_decay[r, c] = q[r, c] * T.exp(g[r])
+                            k_decay[r, c] = k[r, c] * T.exp(g[C - 1] - g[r])
+                        T.gemm(q_decay, h_shared, o)
+                        for r, c in T.Parallel(DK, block_DV):
+                            h[r, c] = h[r, c] * T.exp(g[C - 1])
+                        T.gemm(k_decay, v, h, transpose_A=True)
+                    else:
+                        T.gemm(q, h_shared, o)
+                        T.gemm(k, v, h, transpose_A=True)
+                    T.copy(o, O[i_b, i * C : (i + 1) * C, i_h, i_v * block_DV : (i_v + 1) * block_DV])
+
+                T.copy(h, HT[i_b, i_h, :, i_v * block_DV : (i_v + 1) * block_DV])
+
+        return main
+
+    def params_as_dict(self):
+        """
+        Returns the template parameters as a dictionary.
+
+        Returns:
+            dict: Dictionary containing template parameter values.
+        """
+        return {
+            "batch_size": self.batch_size,
+            "num_heads": self.num_heads,
+            "seq_length": self.seq_length,
+            "head_dim_k": self.head_dim_k,
+            "head_dim_v": self.head_dim_v,
+            "chunk_size": self.chunk_size,
+            "gated": self.gated,
+            "scale": self.scale,
+            "use_initial_state": self.use_initial_state,
+            "in_dtype": self.in_dtype,
+            "out_dtype": self.out_dtype,
+            "accum_dtype": self.accum_dtype,
+        }
+
+    @property
+    def class_attributes(self):
+        """
+        Returns the class attributes in dictionary form.
+
+        Returns:
+            dict: Dictionary of class attributes.
+        """
+        return self.params_as_dict()
+
+    def __repr__(self) -> str:
+        """
+        Returns a string representation of the class instance.
+
+        Returns:
+            str: A formatted string representation of the class.
+        """
+        cls_name = self.__class__.__name__
+        fields = self.class_attributes
+        field_str = ", ".join(f"{key}={value!r}" for key, value in fields.items())
+        return f"{cls_name}({field_str})"
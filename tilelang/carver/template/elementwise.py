@@ -1,7 +1,8 @@
 # Import necessary modules
 from dataclasses import dataclass  # Used for defining data classes
+import math
 from .base import BaseTemplate  # Importing the base class for templates
-from tvm import te  # Importing TVM's tensor expression module
+from tvm import DataType, te, tir  # Importing TVM's tensor expression module
 from ..arch import TileDevice  # Importing TileDevice for hardware-specific configurations
 from ..roller import Hint  # Importing Hint for optimization hints
 from ..utils import get_roller_hints_from_func  # Function to obtain optimization hints
@@ -12,6 +13,13 @@ class ElementwiseTemplate(BaseTemplate):
     """
     A template for element-wise operations using TVM.
 
+    Besides the roller hints, the template generates bandwidth-bound kernels
+    directly (``elementwise_program`` and ``cast_program``): every thread
+    moves the widest vector the target supports (256 bits from sm_100 on,
+    which needs the loops to touch global memory only, so no shared memory
+    staging), and a persistent grid sized to the SM count walks the tiles
+    in a grid-stride loop.
+
     Attributes:
         shape (List[int]): The shape of the tensor.
         dtype (str): The data type of the tensor (default: "float16").
@@ -64,6 +72,183 @@ class ElementwiseTemplate(BaseTemplate):
         # Create and set the computation function
         self.set_function(te.create_prim_func(args))
 
+    @property
+    def num_elements(self) -> int:
+        """Number of elements of the tensor."""
+        return math.prod(self.shape)
+
+    def vector_bits(self) -> int:
+        """
+        Returns the widest global load/store of a thread, in bits.
+
+        sm_100 and later issue 256-bit accesses (e.g. ``ld.global.v8.f32``),
+        earlier targets 128-bit ones.
+        """
+        return 256 if getattr(self.arch, "sm_version", 0) >= 100 else 128
+
+    def persistent_blocks(self, num_tiles: int, threads: int) -> int:
+        """
+        Returns the block count of a persistent grid over ``num_tiles`` tiles.
+
+        The grid holds as many blocks as stay resident on the SMs, and at most
+        one per tile.
+        """
+        num_sms = getattr(self.arch, "compute_max_core", 1) if self.arch is not None else 1
+        # 2048 resident threads per SM on every CUDA architecture since Volta
+        blocks_per_sm = max(1, 2048 // threads)
+        return max(1, min(num_tiles, num_sms * blocks_per_sm))
+
+    def get_launch_config(self, dtypes: list[str] = None, threads: int = 256, unroll: int = 4) -> dict:
+        """
+        Returns the launch configuration of a persistent bandwidth-bound kernel.
+
+        A tile holds ``unroll`` vectors per thread, so every thread keeps
+        several independent accesses in flight, and the grid is persistent
+        (see ``persistent_blocks``).
+
+        Args:
+            dtypes (List[str], optional): Data types the kernel moves, the widest one
+                bounds the vector length. Defaults to ``[dtype]``.
+            threads (int, optional): Threads of a block.
+            unroll (int, optional): Vectors a thread moves per tile.
+
+        Returns:
+            dict: ``threads``, ``vec`` (elements of a vector), ``tile`` (elements of a
+            tile) and ``num_blocks``.
+        """
+        dtypes = dtypes or [self.dtype]
+        vec = max(1, self.vector_bits() // max(DataType(str(dtype)).bits for dtype in dtypes))
+        tile = threads * vec * unroll
+        num_blocks = self.persistent_blocks(math.ceil(self.num_elements / tile), threads)
+        return {"threads": threads, "vec": vec, "tile": tile, "num_blocks": num_blocks}
+
+    def elementwise_program(self, fcompute, num_inputs: int = 1, out_dtype: str = None, threads: int = 256, unroll: int = 4):
+        """
+        Builds a persistent, vectorized kernel of ``C = fcompute(A[, B])``.
+
+        The tensors are walked as flat arrays: the full tiles are distributed
+        over the blocks in a grid-stride loop and the remaining elements form
+        one predicated tail tile.
+
+        Args:
+            fcompute (Callable): Maps the input values of an element to its output value.
+            num_inputs (int, optional): 1 or 2 inputs of ``shape`` and ``dtype``.
+            out_dtype (str, optional): Data type of the output, ``dtype`` by default.
+            threads (int, optional): Threads of a block.
+            unroll (int, optional): Vectors a thread moves per tile.
+
+        Returns:
+            PrimFunc: The TileLang program, the output being the last argument.
+        """
+        import tilelang.language as T
+
+        assert num_inputs in (1, 2), f"num_inputs must be 1 or 2, got {num_inputs}"
+        shape, in_dtype = list(self.shape), self.dtype
+        out_dtype = out_dtype or self.dtype
+        config = self.get_launch_config([in_dtype, out_dtype], threads, unroll)
+        tile, num_blocks = config["tile"], config["num_blocks"]
+        numel = self.num_elements
+        num_full = numel // tile
+        tail_block = num_full % num_blocks
+        has_tail = numel % tile != 0
+
+        if num_inputs == 1:
+
+            @T.prim_func
+            def main(A: T.Tensor(shape, in_dtype), C: T.Tensor(shape, out_dtype)):
+                with T.Kernel(num_blocks, threads=threads) as bx:
+                    a = T.reshape(A, [numel])
+                    c = T.reshape(C, [numel])
+                    for it in T.serial((num_full - bx + num_blocks - 1) // num_blocks):
+                        base = (bx + it * num_blocks) * tile
+                        for i in T.Parallel(tile):
+                            c[base + i] = T.Cast(out_dtype, fcompute(a[base + i]))
+                    if has_tail:
+                        if bx == tail_block:
+                            for i in T.Parallel(tile):
+                                if num_full * tile + i < numel:
+                                    c[num_full * tile + i] = T.Cast(out_dtype, fcompute(a[num_full * tile + i]))
+
+            return main
+
+        @T.prim_func
+        def main(A: T.Tensor(shape, in_dtype), B: T.Tensor(shape, in_dtype), C: T.Tensor(shape, out_dtype)):
+            with T.Kernel(num_blocks, threads=threads) as bx:
+                a = T.reshape(A, [numel])
+                b = T.reshape(B, [numel])
+                c = T.reshape(C, [numel])
+                for it in T.serial((num_full - bx + num_blocks - 1) // num_blocks):
+                    base = (bx + it * num_blocks) * tile
+                    for i in T.Parallel(tile):
+                        c[base + i] = T.Cast(out_dtype, fcompute(a[base + i], b[base + i]))
+                if has_tail:
+                    if bx == tail_block:
+                        for i in T.Parallel(tile):
+                            if num_full * tile + i < numel:
+                                c[num_full * tile + i] = T.Cast(out_dtype, fcompute(a[num_full * tile + i], b[num_full * tile + i]))
+
+        return main
+
+    def cast_program(self, out_dtype: str = "float8_e4m3fn", group_size: int = 128, threads: int = 128, unroll: int = 2):
+        """
+        Builds a fused quantizing cast with per-group scales.
+
+        A 2D input ``X [M, N]`` is cast to ``X_q = X / s`` in ``out_dtype``,
+        where every group of ``group_size`` consecutive elements of a row gets
+        the scale ``s = max(amax, 1e-4) / max(out_dtype)``, written to
+        ``X_s [M, N / group_size]`` in float32. Both outputs come from a single
+        read of ``X``; the tiles of ``block_M`` rows by one group are walked by
+        a persistent grid.
+
+        Args:
+            out_dtype (str, optional): Data type of the cast, e.g. an fp8 type.
+            group_size (int, optional): Elements of a row sharing a scale.
+            threads (int, optional): Threads of a block.
+            unroll (int, optional): Vectors a thread loads per tile.
+
+        Returns:
+            PrimFunc: The TileLang program ``(X, X_q, X_s)``.
+        """
+        import tilelang.language as T
+
+        assert len(self.shape) == 2, "cast_program expects a 2D tensor"
+        M, N = self.shape
+        assert N % group_size == 0, f"N ({N}) must be a multiple of group_size ({group_size})"
+        in_dtype, accum_dtype = self.dtype, T.float32
+        out_max = float(tir.max_value(out_dtype).value)
+        vec = self.get_launch_config([in_dtype], threads, unroll)["vec"]
+        block_M = max(1, threads * vec * unroll // group_size)
+        num_groups = N // group_size
+        num_tiles = math.ceil(M / block_M) * num_groups
+        num_blocks = self.persistent_blocks(num_tiles, threads)
+
+        @T.prim_func
+        def main(
+            X: T.Tensor((M, N), in_dtype),
+            X_q: T.Tensor((M, N), out_dtype),
+            X_s: T.Tensor((M, num_groups), accum_dtype),
+        ):
+            with T.Kernel(num_blocks, threads=threads) as bx:
+                x = T.alloc_fragment((block_M, group_size), accum_dtype)
+                x_q = T.alloc_fragment((block_M, group_size), out_dtype)
+                scale = T.alloc_fragment((block_M,), accum_dtype)
+                for it in T.serial((num_tiles - bx + num_blocks - 1) // num_blocks):
+                    # Consecutive blocks take consecutive groups of a row block
+                    t = bx + it * num_blocks
+                    row, g = t // num_groups, t % num_groups
+                    T.copy(X[row * block_M : (row + 1) * block_M, g * group_size : (g + 1) * group_size], x)
+                    T.reduce_absmax(x, scale, dim=1)
+                    for i in T.Parallel(block_M):
+                        scale[i] = T.max(scale[i], 1e-4) / out_max
+                    for i, j in T.Parallel(block_M, group_size):
+                        x_q[i, j] = T.clamp(x[i, j] / scale[i], -out_max, out_max)
+                    T.copy(x_q, X_q[row * block_M : (row + 1) * block_M, g * group_size : (g + 1) * group_size])
+                    for i in T.Parallel(block_M):
+                        if row * block_M + i < M:
+                            X_s[row * block_M + i, g] = scale[i]
+
+        return main
+
     def params_as_dict(self):
         """
         Returns the parameters of the template as a dictionary.
@@ -1,14 +1,51 @@
 from dataclasses import dataclass
+import math
 from .base import BaseTemplate
-from tvm import te
+from tvm import te, tir
 from ..arch import TileDevice
 from ..roller import Hint
 from ..roller import PrimFuncNode, OutputNode, Edge
 from ..utils import get_roller_hints_from_output_nodes, get_tensorized_func_and_tags
 
 
+_ATTENTION_MODES = ("prefill", "chunked_prefill", "decode")
+
+
 @dataclass
 class FlashAttentionTemplate(BaseTemplate):
+    """
+    A template for flash attention, ``O = softmax(Q K^T / sqrt(d)) V``.
+
+    The attention is modeled as its two chained matmuls for the roller, and the
+    template derives the launch-level decisions shared by the attention kernels:
+
+    - ``mode``: ``"prefill"`` attends a whole sequence, ``"chunked_prefill"`` the
+      last ``seq_length`` queries of ``seq_kv_length`` keys (the cache holds the
+      previous chunks) and ``"decode"`` a few queries against a long cache.
+    - Causal masks are aligned to the bottom right, query ``i`` sees keys up
+      to ``i + seq_kv_length - seq_length``, and key blocks past the diagonal
+      are skipped (see ``causal_kv_end``).
+    - GQA/MQA: with ``num_kv_heads < num_heads`` the query heads sharing a KV
+      head can be packed into the rows of one tile (``pack_gqa``), so K and V
+      are loaded once per group. Packing defaults to on for decode, where a
+      few queries per head would leave the tile mostly empty.
+    - Split-KV: decode splits the keys over ``num_splits`` blocks, each writing
+      a partial output and its log-sum-exp, which a combine kernel reduces.
+      ``num_splits=None`` picks the split count from the SM count.
+
+    Attributes:
+        batch_size (int): Batch size.
+        num_heads (int): Number of query heads.
+        head_dim (int): Head dimension of Q, K and V.
+        seq_length (int): Number of queries per sequence.
+        seq_kv_length (int): Number of keys per sequence.
+        num_kv_heads (int): Number of KV heads, ``num_heads`` for MHA.
+        is_causal (bool): Whether the attention is causal.
+        mode (str): One of ``"prefill"``, ``"chunked_prefill"`` or ``"decode"``.
+        pack_gqa (bool): Whether to pack the query heads of a KV head into rows.
+        num_splits (int): Number of KV splits, None to choose it.
+    """
+
     _output_nodes: list[OutputNode] = None
 
     # Operation-related configuration parameters
@@ -17,13 +54,147 @@ class FlashAttentionTemplate(BaseTemplate):
     head_dim: int = 1
     seq_length: int = 1
     seq_kv_length: int = 1
+    num_kv_heads: int = None  # Defaults to num_heads (MHA)
 
     is_causal: bool = False
+    mode: str = "prefill"  # "prefill", "chunked_prefill" or "decode"
+    pack_gqa: bool = None  # Pack query heads of a KV head into rows, None for auto
+    num_splits: int = None  # KV splits, None to pick from the SM count in decode
 
     in_dtype: str = "float16"
     out_dtype: str = "float16"
     accum_dtype: str = "float16"
 
+    @property
+    def group_size(self) -> int:
+        """Number of query heads sharing a KV head."""
+        return self.num_heads // self.num_kv_heads
+
+    @property
+    def causal_offset(self) -> int:
+        """Distance of the causal diagonal from the main one, in keys."""
+        return self.seq_kv_length - self.seq_length
+
+    @property
+    def packed_heads(self) -> int:
+        """Number of (batch, head) problems a kernel launches tiles for."""
+        return self.batch_size * (self.num_kv_heads if self.pack_gqa else self.num_heads)
+
+    @property
+    def packed_rows(self) -> int:
+        """Number of query rows of a (batch, head) problem."""
+        return self.seq_length * (self.group_size if self.pack_gqa else 1)
+
+    def causal_kv_end(self, row_end):
+        """
+        Returns the exclusive end of the keys visible to the packed rows ``[.., row_end)``.
+
+        Key blocks at or past the end hold no visible key and are skipped. Rows
+        past ``packed_rows`` only pad the last tile.
+
+        Args:
+            row_end (int | PrimExpr): Exclusive end of the packed query rows of a tile.
+
+        Returns:
+            int | PrimExpr: The key bound, ``seq_kv_length`` when not causal.
+        """
+        if not self.is_causal:
+            return self.seq_kv_length
+        pack = self.group_size if self.pack_gqa else 1
+        end = (row_end - 1) // pack + 1 + self.causal_offset
+        if isinstance(end, tir.PrimExpr):
+            return tir.min(end, self.seq_kv_length)
+        return min(end, self.seq_kv_length)
+
+    def resolve_num_splits(self, block_M: int, block_N: int, max_splits: int = 128) -> int:
+        """
+        Returns the number of KV splits of a tile shape.
+
+        Splitting only pays off when the (batch, head, row block) tiles leave
+        SMs idle: the smallest split count whose wave efficiency is within 85%
+        of the best one is chosen, as flash-attention does.
+
+        Args:
+            block_M (int): Query rows of a tile.
+            block_N (int): Keys of a tile.
+            max_splits (int, optional): Upper bound of the split count.
+
+        Returns:
+            int: ``num_splits`` when set, 1 outside of decode.
+        """
+        if self.num_splits is not None:
+            return self.num_splits
+        if self.mode != "decode":
+            return 1
+        num_sms = self.arch.compute_max_core if self.arch is not None else 1
+        num_tiles = self.packed_heads * math.ceil(self.packed_rows / block_M)
+        num_n_blocks = math.ceil(self.seq_kv_length / block_N)
+        if num_tiles >= 0.8 * num_sms:
+            return 1
+        max_splits = max(1, min(max_splits, num_sms, num_n_blocks))
+
+        def efficiency(splits):
+            n_waves = num_tiles * splits / num_sms
+            return n_waves / math.ceil(n_waves)
+
+        def eligible(splits):
+            # Splits that do not change the blocks per split are redundant
+            return splits == 1 or math.ceil(num_n_blocks / splits) != math.ceil(num_n_blocks / (splits - 1))
+
+        best = max(efficiency(s) for s in range(1, max_splits + 1) if eligible(s))
+        return next(s for s in range(1, max_splits + 1) if eligible(s) and efficiency(s) >= 0.85 * best)
+
+    def estimated_flops(self) -> int:
+        """
+        Returns the number of flops of the attention, without the skipped causal blocks.
+
+        Returns:
+            int: Flops of both matmuls.
+        """
+        if self.is_causal:
+            # Query i sees causal_offset + i + 1 keys
+            visible = self.seq_length * (self.causal_offset + 1) + self.seq_length * (self.seq_length - 1) // 2
+        else:
+            visible = self.seq_length * self.seq_kv_length
+        return 4 * self.batch_size * self.num_heads * visible * self.head_dim
+
+    def get_autotune_configs(self, topk: int = 10) -> list[dict]:
+        """
+        Returns autotuner configurations derived from the roller hints.
+
+        Every configuration holds ``block_M``, ``block_N``, ``num_stages``,
+        ``threads`` and ``num_split``. Decode also tries the unsplit kernel.
+        When the roller finds no hint, a default tiling of the architecture is
+        returned.
+
+        Args:
+            topk (int, optional): Number of roller hints to consider.
+
+        Returns:
+            List[dict]: Distinct configurations, the preferred one first.
+        """
+        tiles = []
+        for hint in self.recommend_hints(topk=topk) or []:
+            # Tensor core tiles of 4 warps need at least 64 rows
+            block_M = max(64, hint.block[-2])
+            block_N = max(32, min(hint.rstep[0], 256))
+            num_stages = hint.pipeline_stage if hint.pipeline_stage > 1 else 1
+            tiles.append((block_M, block_N, num_stages))
+        if not tiles:
+            sm_version = getattr(self.arch, "sm_version", 80)
+            # sm120 has the 99KB of shared memory of sm86/sm89, not the 227KB of sm90/sm100
+            tiles = [(128, 128, 2)] if 90 <= sm_version < 120 else [(64, 64, 1), (128, 64, 2)]
+
+        configs = []
+        for block_M, block_N, num_stages in tiles:
+            threads = 128 if block_M <= 64 else 256
+            splits = self.resolve_num_splits(block_M, block_N)
+            for num_split in dict.fromkeys([splits, 1] if self.mode == "decode" else [splits]):
+                config = {"block_M": block_M, "block_N": block_N, "num_stages": num_stages, "threads": threads, "num_split": num_split}
+                if config not in configs:
+                    configs.append(config)
+        return configs
+
     def get_hardware_aware_configs(self, arch: TileDevice = None, topk: int = 10) -> list[Hint]:
         """
         Retrieves optimized hardware-aware configurations.
@@ -40,20 +211,28 @@ class FlashAttentionTemplate(BaseTemplate):
 
     def initialize_function(self) -> None:
         """
-        Defines and initializes the matrix multiplication computation.
+        Defines the two matmuls of the attention for the roller.
 
-        This method sets up placeholders for input matrices, computes
-        the matrix multiplication using TVM's compute API,
-        and optionally applies bias and type casting.
+        With packed GQA heads the rows of a problem hold every query head of a
+        KV head, and with split-KV each problem only spans the keys of a split.
 
         Raises:
-            AssertionError: If M, N, or K are not positive integers.
+            AssertionError: If the heads, sequence lengths or mode are inconsistent.
         """
+        if self.num_kv_heads is None:
+            self.num_kv_heads = self.num_heads
+        assert self.mode in _ATTENTION_MODES, f"mode must be one of {_ATTENTION_MODES}, got {self.mode}"
+        assert self.num_heads % self.num_kv_heads == 0, "num_heads must be a multiple of num_kv_heads"
+        assert not self.is_causal or self.causal_offset >= 0, "causal attention needs seq_kv_length >= seq_length"
+        assert self.num_splits is None or self.num_splits >= 1, "num_splits must be positive"
+        if self.pack_gqa is None:
+            self.pack_gqa = self.mode == "decode" and self.group_size > 1
+
         batch_size = self.batch_size
-        num_heads = self.num_heads
+        num_heads = self.num_kv_heads if self.pack_gqa else self.num_heads
         head_dim = self.head_dim
-        seq_length = self.seq_length
-        seq_kv_length = self.seq_kv_length
+        seq_length = self.packed_rows
+        seq_kv_length = math.ceil(self.seq_kv_length / (self.num_splits or 1))
 
         in_dtype = self.in_dtype
         out_dtype = self.out_dtype
@@ -139,15 +318,19 @@ class FlashAttentionTemplate(BaseTemplate):
             dict: Dictionary containing template parameter values.
         """
         return {
-            "M": self.M,
-            "N": self.N,
-            "K": self.K,
-            "trans_A": self.trans_A,
-            "trans_B": self.trans_B,
+            "batch_size": self.batch_size,
+            "num_heads": self.num_heads,
+            "num_kv_heads": self.num_kv_heads,
+            "head_dim": self.head_dim,
+            "seq_length": self.seq_length,
+            "seq_kv_length": self.seq_kv_length,
+            "is_causal": self.is_causal,
+            "mode": self.mode,
+            "pack_gqa": self.pack_gqa,
+            "num_splits": self.num_splits,
             "in_dtype": self.in_dtype,
             "out_dtype": self.out_dtype,
             "accum_dtype": self.accum_dtype,
-            "with_bias": self.with_bias,
         }
 
     @property
@@ -0,0 +1,693 @@
+from dataclasses import dataclass
+from .base import BaseTemplate
+from tvm import DataType, te, tir
+from tvm.ir import Range
+from ..arch import TileDevice
+from ..roller import Hint
+from ..roller import PrimFuncNode, OutputNode
+from ..utils import get_roller_hints_from_output_nodes, get_tensorized_func_and_tags
+
+
+_DQ_MODES = ("atomic", "deterministic")
+_LOG2E = 1.44269504
+
+
+@dataclass
+class FlashAttentionBwdTemplate(BaseTemplate):
+    """
+    A template for the backward pass of flash attention, ``O = softmax(Q K^T * scale) V``.
+
+    Given ``dO`` and the log-sum-exp ``LSE`` of the forward pass, the
+    probabilities ``P = exp(Q K^T * scale - LSE)`` are recomputed on the fly
+    and never stored:
+
+        dV = P^T dO,  dS = P * (dO V^T - Delta),  dK = scale * dS^T Q,  dQ = scale * dS K
+
+    with ``Delta = rowsum(O * dO)`` computed by ``preprocess_program``. One
+    block per (key block, KV head, batch) walks the query blocks of every query
+    head of its group in a software pipelined loop, keeping ``dK`` and ``dV``
+    in register fragments until the end, so they are written once and without
+    atomics. ``dQ`` is accumulated across key blocks according to ``dq_mode``:
+
+    - ``"atomic"``: every block adds its ``dS K`` to a zero-initialized float32
+      ``dQaccum`` with the tile ``T.atomic_add``, which issues vectorized
+      float4 reductions (``red.global.add.v4.f32``) on sm90 and later, and
+      ``postprocess_program`` casts ``dQaccum`` into ``dQ``.
+    - ``"deterministic"``: ``dq_program`` computes ``dQ`` in a second pass, one
+      block per query block recomputing ``P`` and ``dS`` over the key blocks,
+      so the summation order is fixed and no float32 buffer is needed.
+
+    Masks follow ``FlashAttentionTemplate``: causal masks are aligned to the
+    bottom right, query ``i`` sees keys up to ``i + seq_kv_length - seq_length``,
+    and blocks past the diagonal are skipped. With ``varlen`` the sequences of
+    a batch are packed along their first dimension, sequence ``b`` spanning
+    ``cu_seqlens[b]:cu_seqlens[b + 1]``, and ``seq_length``/``seq_kv_length``
+    are the longest sequence lengths.
+
+    Layouts: ``Q``, ``O``, ``dO`` and ``dQ`` are ``[B, S, H, D]``, ``K``, ``V``,
+    ``dK`` and ``dV`` are ``[B, S_kv, H_kv, D]``, and ``LSE`` (natural log) and
+    ``Delta`` are ``[B, H, S]``. With ``varlen`` they are ``[total_q, H, D]``,
+    ``[total_kv, H_kv, D]`` and ``[H, total_q]``.
+
+    Attributes:
+        batch_size (int): Batch size.
+        num_heads (int): Number of query heads.
+        head_dim (int): Head dimension of Q, K and V.
+        seq_length (int): Number of queries per sequence, the maximum with varlen.
+        seq_kv_length (int): Number of keys per sequence, the maximum with varlen.
+        num_kv_heads (int): Number of KV heads, ``num_heads`` for MHA.
+        is_causal (bool): Whether the attention is causal.
+        varlen (bool): Whether the sequences are packed with ``cu_seqlens``.
+        dq_mode (str): ``"atomic"`` or ``"deterministic"``.
+        sm_scale (float): Scale of the scores, ``head_dim ** -0.5`` when None.
+    """
+
+    _output_nodes: list[OutputNode] = None
+
+    # Operation-related configuration parameters
+    batch_size: int = 1
+    num_heads: int = 1
+    head_dim: int = 1
+    seq_length: int = 1
+    seq_kv_length: int = 1
+    num_kv_heads: int = None  # Defaults to num_heads (MHA)
+
+    is_causal: bool = False
+    varlen: bool = False
+    dq_mode: str = "atomic"  # "atomic" or "deterministic"
+    sm_scale: float = None
+
+    in_dtype: str = "float16"
+    accum_dtype: str = "float32"
+
+    @property
+    def group_size(self) -> int:
+        """Number of query heads sharing a KV head."""
+        return self.num_heads // self.num_kv_heads
+
+    def shared_memory_bytes(self, block_M: int, block_N: int, num_stages: int) -> int:
+        """
+        Returns the shared memory the dK/dV kernel of a configuration allocates.
+
+        Args:
+            block_M (int): Queries of a step of the pipelined loop.
+            block_N (int): Keys a block owns.
+            num_stages (int): Pipeline stages of the query loop.
+
+        Returns:
+            int: Bytes of shared memory.
+        """
+        M, N, D = block_M, block_N, self.head_dim
+        in_bytes = (DataType(str(self.in_dtype)).bits + 7) // 8
+        # K and V, q and dO of every stage, and the staged dK and dV
+        nbytes = (2 * N * D + num_stages * 2 * M * D + 2 * N * D) * in_bytes
+        # LSE and Delta of every stage
+        nbytes += num_stages * 2 * M * 4
+        if self.dq_mode == "atomic":
+            # dS for the dQ gemm and the float32 dQ tile being reduced
+            nbytes += N * M * in_bytes + M * D * 4
+        return nbytes
+
+    def estimated_flops(self) -> int:
+        """
+        Returns the number of flops of the backward pass, without the skipped causal blocks.
+
+        The recomputed ``Q K^T`` and the four gradient matmuls are counted, plus
+        the second ``Q K^T`` and ``dO V^T`` of the deterministic dQ pass.
+
+        Returns:
+            int: Flops of the matmuls.
+        """
+        offset = self.seq_kv_length - self.seq_length
+        if self.is_causal:
+            visible = sum(max(0, min(self.seq_kv_length, i + offset + 1)) for i in range(self.seq_length))
+        else:
+            visible = self.seq_length * self.seq_kv_length
+        num_matmuls = 7 if self.dq_mode == "deterministic" else 5
+        return 2 * num_matmuls * self.batch_size * self.num_heads * visible * self.head_dim
+
+    def get_autotune_configs(self, topk: int = 10) -> list[dict]:
+        """
+        Returns autotuner configurations of the backward programs.
+
+        Every configuration holds ``block_M``, ``block_N``, ``num_stages`` and
+        ``threads``. ``block_N`` comes from the rows of the roller hints of the
+        ``dK`` matmul; configurations that exceed the shared memory of the
+        architecture are dropped.
+
+        Args:
+            topk (int, optional): Number of roller hints to consider.
+
+        Returns:
+            List[dict]: Distinct configurations, the preferred one first.
+        """
+        block_Ns = []
+        for hint in self.recommend_hints(topk=topk) or []:
+            block_Ns.append(128 if hint.block[-2] >= 128 else 64)
+        block_Ns = list(dict.fromkeys(block_Ns + [64]))
+
+        smem_cap = getattr(self.arch, "smem_cap", None) if self.arch is not None else None
+        configs = []
+        for block_N in block_Ns:
+            for block_M in (64, 32):
+                for num_stages in (2, 1):
+                    if smem_cap is not None and self.shared_memory_bytes(block_M, block_N, num_stages) > smem_cap:
+                        continue
+                    threads = 256 if block_N >= 128 else 128
+                    config = {"block_M": block_M, "block_N": block_N, "num_stages": num_stages, "threads": threads}
+                    if config not in configs:
+                        configs.append(config)
+        return configs
+
+    def get_hardware_aware_configs(self, arch: TileDevice = None, topk: int = 10) -> list[Hint]:
+        """
+        Retrieves optimized hardware-aware configurations.
+
+        Args:
+            arch (TileDevice, optional): The target hardware architecture.
+            topk (int, optional): Number of top configurations to consider.
+
+        Returns:
+            List[Hint]: A list of optimization hints for hardware acceleration.
+        """
+        roller_hints = get_roller_hints_from_output_nodes(self.output_nodes, arch=arch, topk=topk)
+        return roller_hints
+
+    def initialize_function(self) -> None:
+        """
+        Defines the ``dK = dS^T Q`` matmul of every KV head for the roller.
+
+        The tile of a block is a block of keys against the queries of its group,
+        the other matmuls of the block share its operand tiles.
+
+        Raises:
+            AssertionError: If the heads or the dQ mode are inconsistent.
+        """
+        if self.num_kv_heads is None:
+            self.num_kv_heads = self.num_heads
+        assert self.dq_mode in _DQ_MODES, f"dq_mode must be one of {_DQ_MODES}, got {self.dq_mode}"
+        assert self.num_heads % self.num_kv_heads == 0, "num_heads must be a multiple of num_kv_heads"
+        if self.sm_scale is None:
+            self.sm_scale = self.head_dim**-0.5
+
+        B = self.batch_size * self.num_kv_heads
+        M, N, K = self.seq_kv_length, self.head_dim, self.group_size * self.seq_length
+        in_dtype, accum_dtype = self.in_dtype, self.accum_dtype
+
+        A = te.placeholder((B, K, M), name="A", dtype=in_dtype)
+        W = te.placeholder((B, K, N), name="B", dtype=in_dtype)
+        k = te.reduce_axis((0, K), name="k")
+        C = te.compute(
+            (B, M, N),
+            lambda b, i, j: te.sum(A[b, k, i].astype(accum_dtype) * W[b, k, j].astype(accum_dtype), axis=k),
+            name="C",
+        )
+        func = te.create_prim_func([A, W, C])
+        self.set_function(func)
+
+        tensorized_func, tags = get_tensorized_func_and_tags(func, self.arch.target)
+        assert tags is not None
+        self.set_output_nodes([OutputNode(PrimFuncNode(tensorized_func, name="dKMMA", tags=tags))])
+
+    def _seq_tile(self, buf, b, row, rows, h):
+        """The ``[rows, head_dim]`` tile of head ``h`` starting at token ``row``."""
+        lead = [] if self.varlen else [Range.from_min_extent(b, 1)]
+        region = [Range.from_min_extent(row, rows), Range.from_min_extent(h, 1), Range.from_min_extent(0, self.head_dim)]
+        return tir.BufferRegion(buf, lead + region)
+
+    def _stat_tile(self, buf, b, h, row, rows):
+        """The ``[rows]`` tile of head ``h`` of LSE or Delta starting at token ``row``."""
+        lead = [] if self.varlen else [Range.from_min_extent(b, 1)]
+        return tir.BufferRegion(buf, lead + [Range.from_min_extent(h, 1), Range.from_min_extent(row, rows)])
+
+    def _seq_shapes(self):
+        B, S, S_kv, D = self.batch_size, self.seq_length, self.seq_kv_length, self.head_dim
+        H, H_kv = self.num_heads, self.num_kv_heads
+        if self.varlen:
+            import tilelang.language as T
+
+            total_q, total_kv = T.dynamic("total_q"), T.dynamic("total_kv")
+            return [total_q, H, D], [total_kv, H_kv, D], [H, total_q]
+        return [B, S, H, D], [B, S_kv, H_kv, D], [B, H, S]
+
+    def preprocess_program(self, block_M: int = 64, threads: int = 128):
+        """
+        Builds the kernel computing ``Delta = rowsum(O * dO)``.
+
+        The program reads ``O`` and ``dO`` (and ``cu_seqlens_q`` with varlen) and
+        writes ``Delta``.
+
+        Args:
+            block_M (int, optional): Queries of a block.
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        B, S, H, D = self.batch_size, self.seq_length, self.num_heads, self.head_dim
+        q_shape, _, stat_shape = self._seq_shapes()
+        dtype, accum_dtype, varlen = self.in_dtype, self.accum_dtype, self.varlen
+        seq_tile, stat_tile = self._seq_tile, self._stat_tile
+
+        @T.macro
+        def body(O, dO, Delta, bx, by, bz, q_start, q_len):
+            o = T.alloc_fragment((block_M, D), dtype)
+            do = T.alloc_fragment((block_M, D), dtype)
+            acc = T.alloc_fragment((block_M, D), accum_dtype)
+            delta = T.alloc_fragment((block_M,), accum_dtype)
+            T.copy(seq_tile(O, bz, q_start + bx * block_M, block_M, by), o)
+            T.copy(seq_tile(dO, bz, q_start + bx * block_M, block_M, by), do)
+            for i, d in T.Parallel(block_M, D):
+                acc[i, d] = T.Cast(accum_dtype, o[i, d]) * T.Cast(accum_dtype, do[i, d])
+            T.reduce_sum(acc, delta, dim=1)
+            for i in T.Parallel(block_M):
+                if bx * block_M + i < q_len:
+                    if varlen:
+                        Delta[by, q_start + bx * block_M + i] = delta[i]
+                    else:
+                        Delta[bz, by, bx * block_M + i] = delta[i]
+
+        if varlen:
+
+            @T.prim_func
+            def main(
+                O: T.Tensor(q_shape, dtype),
+                dO: T.Tensor(q_shape, dtype),
+                cu_seqlens_q: T.Tensor((B + 1,), T.int32),
+                Delta: T.Tensor(stat_shape, accum_dtype),
+            ):
+                with T.Kernel(T.ceildiv(S, block_M), H, B, threads=threads) as (bx, by, bz):
+                    body(O, dO, Delta, bx, by, bz, cu_seqlens_q[bz], cu_seqlens_q[bz + 1] - cu_seqlens_q[bz])
+
+        else:
+
+            @T.prim_func
+            def main(
+                O: T.Tensor(q_shape, dtype),
+                dO: T.Tensor(q_shape, dtype),
+                Delta: T.Tensor(stat_shape, accum_dtype),
+            ):
+                with T.Kernel(T.ceildiv(S, block_M), H, B, threads=threads) as (bx, by, bz):
+                    body(O, dO, Delta, bx, by, bz, 0, S)
+
+        return main
+
+    def dkdv_program(self, block_M: int = 64, block_N: int = 64, num_stages: int = 2, threads: int = 128):
+        """
+        Builds the kernel computing ``dK`` and ``dV``, and accumulating ``dQ`` in atomic mode.
+
+        The program reads ``Q``, ``K``, ``V``, ``dO``, ``LSE`` and ``Delta`` (and
+        ``cu_seqlens_q``, ``cu_seqlens_k`` with varlen), then, in atomic mode,
+        the zero-initialized float32 ``dQaccum`` it adds into, and writes ``dK``
+        and ``dV``.
+
+        Args:
+            block_M (int, optional): Queries of a step of the pipelined loop.
+            block_N (int, optional): Keys a block owns.
+            num_stages (int, optional): Pipeline stages of the query loop.
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        B, S, S_kv, D = self.batch_size, self.seq_length, self.seq_kv_length, self.head_dim
+        H_kv, group = self.num_kv_heads, self.group_size
+        q_shape, kv_shape, stat_shape = self._seq_shapes()
+        dtype, accum_dtype = self.in_dtype, self.accum_dtype
+        is_causal, varlen, atomic = self.is_causal, self.varlen, self.dq_mode == "atomic"
+        sm_scale = self.sm_scale
+        scale = sm_scale * _LOG2E
+        seq_tile, stat_tile = self._seq_tile, self._stat_tile
+        # The dQ buffers are only used in atomic mode
+        dsT_shape = (block_N, block_M) if atomic else (1,)
+        dq_shape = (block_M, D) if atomic else (1,)
+
+        @T.macro
+        def body(Q, K, V, dO, LSE, Delta, dQaccum, dK, dV, bx, by, bz, q_start, q_len, k_start, k_len):
+            K_shared = T.alloc_shared((block_N, D), dtype)
+            V_shared = T.alloc_shared((block_N, D), dtype)
+            q = T.alloc_shared((block_M, D), dtype)
+            do = T.alloc_shared((block_M, D), dtype)
+            lse = T.alloc_shared((block_M,), accum_dtype)
+            delta = T.alloc_shared((block_M,), accum_dtype)
+            pT = T.alloc_fragment((block_N, block_M), accum_dtype)
+            dpT = T.alloc_fragment((block_N, block_M), accum_dtype)
+            pT_cast = T.alloc_fragment((block_N, block_M), dtype)
+            dsT_cast = T.alloc_fragment((block_N, block_M), dtype)
+            dk = T.alloc_fragment((block_N, D), accum_dtype)
+            dv = T.alloc_fragment((block_N, D), accum_dtype)
+            dk_shared = T.alloc_shared((block_N, D), dtype)
+            dv_shared = T.alloc_shared((block_N, D), dtype)
+            dsT_shared = T.alloc_shared(dsT_shape, dtype)
+            dq = T.alloc_fragment(dq_shape, accum_dtype)
+            dq_shared = T.alloc_shared(dq_shape, accum_dtype)
+
+            T.copy(seq_tile(K, bz, k_start + bx * block_N, block_N, by), K_shared)
+            T.copy(seq_tile(V, bz, k_start + bx * block_N, block_N, by), V_shared)
+            T.clear(dk)
+            T.clear(dv)
+            offset = k_len - q_len
+            # Queries before the first one seeing the block are skipped
+            loop_st = T.max(bx * block_N - offset, 0) // block_M if is_causal else 0
+            loop_ed = T.ceildiv(q_len, block_M)
+            for g in T.serial(group):
+                h = by * group + g
+                for t in T.Pipelined(loop_st, loop_ed, num_stages=num_stages):
+                    T.copy(seq_tile(Q, bz, q_start + t * block_M, block_M, h), q)
+                    T.copy(stat_tile(LSE, bz, h, q_start + t * block_M, block_M), lse)
+                    T.gemm(K_shared, q, pT, transpose_B=True, clear_accum=True, policy=T.GemmWarpPolicy.FullRow)
+                    # Recompute P^T, zero outside of the sequences and the causal mask
+                    for i, j in T.Parallel(block_N, block_M):
+                        if is_causal:
+                            pT[i, j] = T.if_then_else(
+                                (t * block_M + j < q_len) and (bx * block_N + i < k_len) and (bx * block_N + i <= t * block_M + j + offset),
+                                T.exp2(pT[i, j] * scale - lse[j] * _LOG2E),
+                                0,
+                            )
+                        else:
+                            pT[i, j] = T.if_then_else(
+                                (t * block_M + j < q_len) and (bx * block_N + i < k_len),
+                                T.exp2(pT[i, j] * scale - lse[j] * _LOG2E),
+                                0,
+                            )
+                    T.copy(seq_tile(dO, bz, q_start + t * block_M, block_M, h), do)
+                    T.copy(stat_tile(Delta, bz, h, q_start + t * block_M, block_M), delta)
+                    T.gemm(V_shared, do, dpT, transpose_B=True, clear_accum=True, policy=T.GemmWarpPolicy.FullRow)
+                    T.copy(pT, pT_cast)
+                    T.gemm(pT_cast, do, dv, policy=T.GemmWarpPolicy.FullRow)
+                    for i, j in T.Parallel(block_N, block_M):
+                        dsT_cast[i, j] = pT[i, j] * (dpT[i, j] - delta[j]) * sm_scale
+                    T.gemm(dsT_cast, q, dk, policy=T.GemmWarpPolicy.FullRow)
+                    if atomic:
+                        # Rows of dS outside of the sequence are zero, their dQ adds nothing
+                        T.copy(dsT_cast, dsT_shared)
+                        T.gemm(dsT_shared, K_shared, dq, transpose_A=True, clear_accum=True)
+                        T.copy(dq, dq_shared)
+                        T.atomic_add(seq_tile(dQaccum, bz, q_start + t * block_M, block_M, h), dq_shared)
+
+            T.copy(dk, dk_shared)
+            T.copy(dv, dv_shared)
+            for i, d in T.Parallel(block_N, D):
+                if bx * block_N + i < k_len:
+                    if varlen:
+                        dK[k_start + bx * block_N + i, by, d] = dk_shared[i, d]
+                        dV[k_start + bx * block_N + i, by, d] = dv_shared[i, d]
+                    else:
+                        dK[bz, bx * block_N + i, by, d] = dk_shared[i, d]
+                        dV[bz, bx * block_N + i, by, d] = dv_shared[i, d]
+
+        # dQaccum is only read in atomic mode, a placeholder of one element otherwise
+        dq_accum_shape = q_shape if atomic else [1]
+
+        if varlen:
+
+            @T.prim_func
+            def main(
+                Q: T.Tensor(q_shape, dtype),
+                K: T.Tensor(kv_shape, dtype),
+                V: T.Tensor(kv_shape, dtype),
+                dO: T.Tensor(q_shape, dtype),
+                LSE: T.Tensor(stat_shape, accum_dtype),
+                Delta: T.Tensor(stat_shape, accum_dtype),
+                cu_seqlens_q: T.Tensor((B + 1,), T.int32),
+                cu_seqlens_k: T.Tensor((B + 1,), T.int32),
+                dQaccum: T.Tensor(dq_accum_shape, accum_dtype),
+                dK: T.Tensor(kv_shape, dtype),
+                dV: T.Tensor(kv_shape, dtype),
+            ):
+                with T.Kernel(T.ceildiv(S_kv, block_N), H_kv, B, threads=threads) as (bx, by, bz):
+                    body(
+                        Q,
+                        K,
+                        V,
+                        dO,
+                        LSE,
+                        Delta,
+                        dQaccum,
+                        dK,
+                        dV,
+                        bx,
+                        by,
+                        bz,
+                        cu_seqlens_q[bz],
+                        cu_seqlens_q[bz + 1] - cu_seqlens_q[bz],
+                        cu_seqlens_k[bz],
+                        cu_seqlens_k[bz + 1] - cu_seqlens_k[bz],
+                    )
+
+        else:
+
+            @T.prim_func
+            def main(
+                Q: T.Tensor(q_shape, dtype),
+                K: T.Tensor(kv_shape, dtype),
+                V: T.Tensor(kv_shape, dtype),
+                dO: T.Tensor(q_shape, dtype),
+                LSE: T.Tensor(stat_shape, accum_dtype),
+                Delta: T.Tensor(stat_shape, accum_dtype),
+                dQaccum: T.Tensor(dq_accum_shape, accum_dtype),
+                dK: T.Tensor(kv_shape, dtype),
+                dV: T.Tensor(kv_shape, dtype),
+            ):
+                with T.Kernel(T.ceildiv(S_kv, block_N), H_kv, B, threads=threads) as (bx, by, bz):
+                    body(Q, K, V, dO, LSE, Delta, dQaccum, dK, dV, bx, by, bz, 0, S, 0, S_kv)
+
+        return main
+
+    def dq_program(self, block_M: int = 64, block_N: int = 64, num_stages: int = 2, threads: int = 128):
+        """
+        Builds the deterministic dQ kernel.
+
+        One block per (query block, head, batch) walks the visible key blocks,
+        recomputing ``P`` and ``dS``, and accumulates ``dQ = scale * dS K`` in a
+        register fragment. The program reads ``Q``, ``K``, ``V``, ``dO``, ``LSE``
+        and ``Delta`` (and ``cu_seqlens_q``, ``cu_seqlens_k`` with varlen) and
+        writes ``dQ``.
+
+        Args:
+            block_M (int, optional): Queries a block owns.
+            block_N (int, optional): Keys of a step of the pipelined loop.
+            num_stages (int, optional): Pipeline stages of the key loop.
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        B, S, S_kv, D = self.batch_size, self.seq_length, self.seq_kv_length, self.head_dim
+        H, group = self.num_heads, self.group_size
+        q_shape, kv_shape, stat_shape = self._seq_shapes()
+        dtype, accum_dtype = self.in_dtype, self.accum_dtype
+        is_causal, varlen = self.is_causal, self.varlen
+        sm_scale = self.sm_scale
+        scale = sm_scale * _LOG2E
+        seq_tile, stat_tile = self._seq_tile, self._stat_tile
+
+        @T.macro
+        def body(Q, K, V, dO, LSE, Delta, dQ, bx, by, bz, q_start, q_len, k_start, k_len):
+            q = T.alloc_shared((block_M, D), dtype)
+            do = T.alloc_shared((block_M, D), dtype)
+            K_shared = T.alloc_shared((block_N, D), dtype)
+            V_shared = T.alloc_shared((block_N, D), dtype)
+            lse = T.alloc_fragment((block_M,), accum_dtype)
+            delta = T.alloc_fragment((block_M,), accum_dtype)
+            p = T.alloc_fragment((block_M, block_N), accum_dtype)
+            dp = T.alloc_fragment((block_M, block_N), accum_dtype)
+            ds_cast = T.alloc_fragment((block_M, block_N), dtype)
+            dq = T.alloc_fragment((block_M, D), accum_dtype)
+            dq_shared = T.alloc_shared((block_M, D), dtype)
+
+            T.copy(seq_tile(Q, bz, q_start + bx * block_M, block_M, by), q)
+            T.copy(seq_tile(dO, bz, q_start + bx * block_M, block_M, by), do)
+            T.copy(stat_tile(LSE, bz, by, q_start + bx * block_M, block_M), lse)
+            T.copy(stat_tile(Delta, bz, by, q_start + bx * block_M, block_M), delta)
+            T.clear(dq)
+            offset = k_len - q_len
+            # Key blocks past the diagonal of the last query are skipped
+            loop_ed = (
+                T.ceildiv(T.max(T.min(k_len, (bx + 1) * block_M + offset), 0), block_N) if is_causal else T.ceildiv(k_len, block_N)
+            )
+            for kb in T.Pipelined(loop_ed, num_stages=num_stages):
+                T.copy(seq_tile(K, bz, k_start + kb * block_N, block_N, by // group), K_shared)
+                T.copy(seq_tile(V, bz, k_start + kb * block_N, block_N, by // group), V_shared)
+                T.gemm(q, K_shared, p, transpose_B=True, clear_accum=True, policy=T.GemmWarpPolicy.FullRow)
+                for i, j in T.Parallel(block_M, block_N):
+                    if is_causal:
+                        p[i, j] = T.if_then_else(
+                            (bx * block_M + i < q_len) and (kb * block_N + j < k_len) and (kb * block_N + j <= bx * block_M + i + offset),
+                            T.exp2(p[i, j] * scale - lse[i] * _LOG2E),
+                            0,
+                        )
+                    else:
+                        p[i, j] = T.if_then_else(
+                            (bx * block_M + i < q_len) and (kb * block_N + j < k_len),
+                            T.exp2(p[i, j] * scale - lse[i] * _LOG2E),
+                            0,
+                        )
+                T.gemm(do, V_shared, dp, transpose_B=True, clear_accum=True, policy=T.GemmWarpPolicy.FullRow)
+                for i, j in T.Parallel(block_M, block_N):
+                    ds_cast[i, j] = p[i, j] * (dp[i, j] - delta[i]) * sm_scale
+                T.gemm(ds_cast, K_shared, dq, policy=T.GemmWarpPolicy.FullRow)
+
+            T.copy(dq, dq_shared)
+            for i, d in T.Parallel(block_M, D):
+                if bx * block_M + i < q_len:
+                    if varlen:
+                        dQ[q_start + bx * block_M + i, by, d] = dq_shared[i, d]
+                    else:
+                        dQ[bz, bx * block_M + i, by, d] = dq_shared[i, d]
+
+        if varlen:
+
+            @T.prim_func
+            def main(
+                Q: T.Tensor(q_shape, dtype),
+                K: T.Tensor(kv_shape, dtype),
+                V: T.Tensor(kv_shape, dtype),
+                dO: T.Tensor(q_shape, dtype),
+                LSE: T.Tensor(stat_shape, accum_dtype),
+                Delta: T.Tensor(stat_shape, accum_dtype),
+                cu_seqlens_q: T.Tensor((B + 1,), T.int32),
+                cu_seqlens_k: T.Tensor((B + 1,), T.int32),
+                dQ: T.Tensor(q_shape, dtype),
+            ):
+                with T.Kernel(T.ceildiv(S, block_M), H, B, threads=threads) as (bx, by, bz):
+                    body(
+                        Q,
+                        K,
+                        V,
+                        dO,
+                        LSE,
+                        Delta,
+                        dQ,
+                        bx,
+                        by,
+                        bz,
+                        cu_seqlens_q[bz],
+                        cu_seqlens_q[bz + 1] - cu_seqlens_q[bz],
+                        cu_seqlens_k[bz],
+                        cu_seqlens_k[bz + 1] - cu_seqlens_k[bz],
+                    )
+
+        else:
+
+            @T.prim_func
+            def main(
+                Q: T.Tensor(q_shape, dtype),
+                K: T.Tensor(kv_shape, dtype),
+                V: T.Tensor(kv_shape, dtype),
+                dO: T.Tensor(q_shape, dtype),
+                LSE: T.Tensor(stat_shape, accum_dtype),
+                Delta: T.Tensor(stat_shape, accum_dtype),
+                dQ: T.Tensor(q_shape, dtype),
+            ):
+                with T.Kernel(T.ceildiv(S, block_M), H, B, threads=threads) as (bx, by, bz):
+                    body(Q, K, V, dO, LSE, Delta, dQ, bx, by, bz, 0, S, 0, S_kv)
+
+        return main
+
+    def postprocess_program(self, block_M: int = 64, threads: int = 128):
+        """
+        Builds the kernel casting the float32 ``dQaccum`` of atomic mode into ``dQ``.
+
+        The program reads ``dQaccum`` (and ``cu_seqlens_q`` with varlen) and
+        writes ``dQ``.
+
+        Args:
+            block_M (int, optional): Queries of a block.
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        B, S, H, D = self.batch_size, self.seq_length, self.num_heads, self.head_dim
+        q_shape, _, _ = self._seq_shapes()
+        dtype, accum_dtype, varlen = self.in_dtype, self.accum_dtype, self.varlen
+        seq_tile = self._seq_tile
+
+        @T.macro
+        def body(dQaccum, dQ, bx, by, bz, q_start, q_len):
+            dq = T.alloc_fragment((block_M, D), accum_dtype)
+            dq_shared = T.alloc_shared((block_M, D), dtype)
+            T.copy(seq_tile(dQaccum, bz, q_start + bx * block_M, block_M, by), dq)
+            T.copy(dq, dq_shared)
+            for i, d in T.Parallel(block_M, D):
+                if bx * block_M + i < q_len:
+                    if varlen:
+                        dQ[q_start + bx * block_M + i, by, d] = dq_shared[i, d]
+                    else:
+                        dQ[bz, bx * block_M + i, by, d] = dq_shared[i, d]
+
+        if varlen:
+
+            @T.prim_func
+            def main(
+                dQaccum: T.Tensor(q_shape, accum_dtype),
+                cu_seqlens_q: T.Tensor((B + 1,), T.int32),
+                dQ: T.Tensor(q_shape, dtype),
+            ):
+                with T.Kernel(T.ceildiv(S, block_M), H, B, threads=threads) as (bx, by, bz):
+                    body(dQaccum, dQ, bx, by, bz, cu_seqlens_q[bz], cu_seqlens_q[bz + 1] - cu_seqlens_q[bz])
+
+        else:
+
+            @T.prim_func
+            def main(
+                dQaccum: T.Tensor(q_shape, accum_dtype),
+                dQ: T.Tensor(q_shape, dtype),
+            ):
+                with T.Kernel(T.ceildiv(S, block_M), H, B, threads=threads) as (bx, by, bz):
+                    body(dQaccum, dQ, bx, by, bz, 0, S)
+
+        return main
+
+    def params_as_dict(self):
+        """
+        Returns the template parameters as a dictionary.
+
+        Returns:
+            dict: Dictionary containing template parameter values.
+        """
+        return {
+            "batch_size": self.batch_size,
+            "num_heads": self.num_heads,
+            "num_kv_heads": self.num_kv_heads,
+            "head_dim": self.head_dim,
+            "seq_length": self.seq_length,
+            "seq_kv_length": self.seq_kv_length,
+            "is_causal": self.is_causal,
+            "varlen": self.varlen,
+            "dq_mode": self.dq_mode,
+            "sm_scale": self.sm_scale,
+            "in_dtype": self.in_dtype,
+            "accum_dtype": self.accum_dtype,
+        }
+
+    @property
+    def class_attributes(self):
+        """
+        Returns the class attributes in dictionary form.
+
+        Returns:
+            dict: Dictionary of class attributes.
+        """
+        return self.params_as_dict()
+
+    def __repr__(self) -> str:
+        """
+        Returns a string representation of the class instance.
+
+        Returns:
+            str: A formatted string representation of the class.
+        """
+        cls_name = self.__class__.__name__
+        fields = self.class_attributes
+        field_str = ", ".join(f"{key}={value!r}" for key, value in fields.items())
+        return f"{cls_name}({field_str})"
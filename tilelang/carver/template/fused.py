@@ -0,0 +1,562 @@
+from dataclasses import dataclass
+from .base import BaseTemplate
+from tvm import DataType, te
+from ..arch import TileDevice
+from ..roller import Hint
+from ..roller import PrimFuncNode, OutputNode
+from ..utils import get_roller_hints_from_output_nodes, get_tensorized_func_and_tags
+
+# Accumulator elements a thread may keep in registers, leaving room for the
+# addresses and the operand fragments of the tensor core instructions
+_MAX_ACCUM_PER_THREAD = 128
+
+
+def _nbytes(dtype) -> int:
+    return (DataType(str(dtype)).bits + 7) // 8
+
+
+def _ceildiv(a: int, b: int) -> int:
+    return (a + b - 1) // b
+
+
+def _largest_divisor(n: int, limit: int, candidates=(256, 128, 64, 32, 16)) -> int:
+    """The largest candidate that divides n and does not exceed limit, n itself as a last resort"""
+    return next((c for c in candidates if c <= limit and n % c == 0), n)
+
+
+def _gemm_traffic(M: int, N: int, K: int, block_M: int, block_N: int, a_bytes: int, b_bytes: int, c_bytes: int) -> int:
+    """DRAM bytes of a tiled GEMM that fetches its operand panels once per tile, without L2 reuse"""
+    return M * K * a_bytes * _ceildiv(N, block_N) + K * N * b_bytes * _ceildiv(M, block_M) + M * N * c_bytes
+
+
+def _matmul_output_nodes(M: int, N: int, K: int, in_dtype: str, accum_dtype: str, arch: TileDevice, name: str):
+    """Roller nodes and function of the tensorized (M, K) x (K, N) matmul"""
+    A = te.placeholder((M, K), name="A", dtype=in_dtype)
+    B = te.placeholder((K, N), name="B", dtype=in_dtype)
+    k = te.reduce_axis((0, K), name="k")
+    C = te.compute(
+        (M, N),
+        lambda i, j: te.sum(A[i, k].astype(accum_dtype) * B[k, j].astype(accum_dtype), axis=k),
+        name="C",
+    )
+    func = te.create_prim_func([A, B, C])
+    tensorized_func, tags = get_tensorized_func_and_tags(func, arch.target)
+    assert tags is not None
+    return func, [OutputNode(PrimFuncNode(tensorized_func, name=name, tags=tags))]
+
+
+def _activation(x, activation, accum_dtype):
+    import tilelang.language as T
+
+    if activation is None:
+        return x
+    if activation == "relu":
+        return T.max(x, T.cast(0, accum_dtype))
+    if activation == "silu":
+        return x / (1 + T.exp(-x))
+    if activation == "gelu":
+        # tanh approximation
+        return 0.5 * x * (1 + T.tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)))
+    raise ValueError(f"Unsupported activation {activation!r}, expected None, 'relu', 'silu' or 'gelu'")
+
+
+@dataclass
+class FusedMLPTemplate(BaseTemplate):
+    """
+    A template for the GEMM -> bias -> activation -> GEMM chain of an MLP::
+
+        H = act(X W1 + b1)      # X [M, K], W1 [K, hidden], b1 [hidden]
+        Y = H W2                # W2 [hidden, N], Y [M, N]
+
+    ``fused_mlp_program`` emits one kernel in which a block owns ``block_M``
+    rows of ``Y`` and ``block_N`` of its columns, and walks the hidden
+    dimension in chunks of ``block_H``: the pipelined K loop accumulates a
+    chunk of ``X W1`` in registers, the bias and the activation write it to
+    shared memory, and the second GEMM accumulates its product with the rows
+    of ``W2`` into ``Y``. The intermediate ``H`` never reaches DRAM, at the
+    price of recomputing it for every column block of ``Y``, which is why
+    the configurations prefer a ``block_N`` covering ``N``.
+
+    Attributes:
+        M (int): Rows of X and Y (tokens).
+        K (int): Columns of X.
+        hidden (int): Columns of H.
+        N (int): Columns of Y.
+        activation (str): None, "relu", "silu" or "gelu" (tanh approximation).
+        with_bias (bool): Whether b1 is added before the activation.
+    """
+
+    _output_nodes: list[OutputNode] = None
+
+    # Operation-related configuration parameters
+    M: int = None
+    K: int = None
+    hidden: int = None
+    N: int = None
+    activation: str = "gelu"
+    with_bias: bool = True
+
+    in_dtype: str = "float16"
+    out_dtype: str = "float16"
+    accum_dtype: str = "float32"
+
+    def shared_memory_bytes(self, block_M: int, block_N: int, block_H: int, block_K: int, num_stages: int) -> int:
+        """
+        Returns the shared memory a configuration of the kernel allocates.
+
+        Returns:
+            int: Bytes of the pipelined X and W1 tiles, the H chunk and the W2 tile.
+        """
+        elems = num_stages * (block_M * block_K + block_K * block_H) + block_M * block_H + block_H * block_N
+        return elems * _nbytes(self.in_dtype)
+
+    def dram_traffic(self, block_M: int, block_N: int, block_H: int, **kwargs) -> dict:
+        """
+        Returns the modeled DRAM traffic of a configuration and of the unfused chain.
+
+        The unfused chain runs the first GEMM with the same tiles, a bias and
+        activation kernel and the second GEMM, and moves ``H`` four times
+        through DRAM. The fused kernel rereads ``X`` and ``W1`` for every
+        column block of ``Y`` instead. Both ignore the reuse of the L2.
+
+        Returns:
+            dict: ``fused``, ``unfused`` and ``saved`` bytes.
+        """
+        M, K, Hd, N = self.M, self.K, self.hidden, self.N
+        ib, ob = _nbytes(self.in_dtype), _nbytes(self.out_dtype)
+        unfused = _gemm_traffic(M, Hd, K, block_M, block_H, ib, ib, ib)
+        if self.with_bias or self.activation is not None:
+            unfused += 2 * M * Hd * ib + (Hd * ib if self.with_bias else 0)
+        unfused += _gemm_traffic(M, N, Hd, block_M, block_N, ib, ib, ob)
+
+        column_blocks, row_blocks = _ceildiv(N, block_N), _ceildiv(M, block_M)
+        fused = M * K * ib * column_blocks * _ceildiv(Hd, block_H)
+        fused += K * Hd * ib * row_blocks * column_blocks
+        fused += Hd * N * ib * row_blocks + M * N * ob
+        if self.with_bias:
+            fused += Hd * ib * row_blocks * column_blocks
+        return {"fused": fused, "unfused": unfused, "saved": unfused - fused}
+
+    def get_autotune_configs(self, topk: int = 10) -> list[dict]:
+        """
+        Returns configurations of ``fused_mlp_program``, the least DRAM traffic first.
+
+        ``block_M`` and ``block_H`` come from the roller hints of the first
+        GEMM. A configuration is kept only when the intermediate fits: the
+        H chunk and the Y accumulator within the registers of the block, and
+        every tile within the shared memory of the architecture.
+
+        Args:
+            topk (int, optional): Number of roller hints to consider.
+
+        Returns:
+            List[dict]: Configurations holding ``block_M``, ``block_N``, ``block_H``,
+            ``block_K``, ``num_stages`` and ``threads``.
+        """
+        block_K = _largest_divisor(self.K, 64)
+        tiles = [(min(hint.block[-2], 128), hint.block[-1]) for hint in self.recommend_hints(topk=topk) or []]
+        tiles.append((64, 64))
+        smem_cap = getattr(self.arch, "smem_cap", None) if self.arch is not None else None
+
+        configs = []
+        for block_M, block_H in tiles:
+            block_M = _largest_divisor(block_M, 128, (128, 64))
+            block_H = _largest_divisor(self.hidden, block_H)
+            threads = 256 if block_M == 128 else 128
+            # the widest column block whose accumulator fits next to the H chunk
+            register_room = _MAX_ACCUM_PER_THREAD * threads // block_M - block_H
+            if register_room < 16:
+                continue
+            block_N = self.N if self.N <= register_room and self.N % 16 == 0 else _largest_divisor(self.N, register_room)
+            if block_M * (block_N + block_H) > _MAX_ACCUM_PER_THREAD * threads:
+                continue
+            for num_stages in (3, 2, 1):
+                if smem_cap is not None and self.shared_memory_bytes(block_M, block_N, block_H, block_K, num_stages) > smem_cap:
+                    continue
+                config = {
+                    "block_M": block_M,
+                    "block_N": block_N,
+                    "block_H": block_H,
+                    "block_K": block_K,
+                    "num_stages": num_stages,
+                    "threads": threads,
+                }
+                if config not in configs:
+                    configs.append(config)
+                break
+        return sorted(configs, key=lambda c: self.dram_traffic(**c)["fused"])
+
+    def get_hardware_aware_configs(self, arch: TileDevice = None, topk: int = 10) -> list[Hint]:
+        """
+        Retrieves the roller hints of the first GEMM.
+
+        Args:
+            arch (TileDevice, optional): The target hardware architecture.
+            topk (int, optional): Number of top configurations to consider.
+
+        Returns:
+            List[Hint]: A list of optimization hints for hardware acceleration.
+        """
+        return get_roller_hints_from_output_nodes(self.output_nodes, arch=arch, topk=topk)
+
+    def initialize_function(self) -> None:
+        """
+        Defines the first GEMM ``X W1`` for the roller, whose tile sets the
+        rows of a block and the width of the hidden chunks.
+
+        Raises:
+            AssertionError: If a dimension is not set.
+        """
+        assert all(d is not None and d > 0 for d in (self.M, self.K, self.hidden, self.N)), "M, K, hidden and N must be positive"
+        func, output_nodes = _matmul_output_nodes(self.M, self.hidden, self.K, self.in_dtype, self.accum_dtype, self.arch, "MLPUp")
+        self.set_function(func)
+        self.set_output_nodes(output_nodes)
+
+    def fused_mlp_program(
+        self, block_M: int = 64, block_N: int = 128, block_H: int = 64, block_K: int = 32, num_stages: int = 2, threads: int = 128
+    ):
+        """
+        Builds the fused MLP kernel.
+
+        The program reads ``X [M, K]``, ``W1 [K, hidden]``, ``B1 [hidden]`` and
+        ``W2 [hidden, N]`` and writes ``Y [M, N]``; ``B1`` is only read when
+        ``with_bias``.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        assert self.hidden % block_H == 0, "hidden must be a multiple of block_H"
+        assert self.N % block_N == 0, "N must be a multiple of block_N"
+        assert self.K % block_K == 0, "K must be a multiple of block_K"
+
+        M, K, Hd, N = self.M, self.K, self.hidden, self.N
+        activation, with_bias = self.activation, self.with_bias
+        dtype, out_dtype, accum_dtype = self.in_dtype, self.out_dtype, self.accum_dtype
+
+        @T.prim_func
+        def main(
+            X: T.Tensor((M, K), dtype),
+            W1: T.Tensor((K, Hd), dtype),
+            B1: T.Tensor((Hd,), dtype),
+            W2: T.Tensor((Hd, N), dtype),
+            Y: T.Tensor((M, N), out_dtype),
+        ):
+            with T.Kernel(N // block_N, T.ceildiv(M, block_M), threads=threads) as (bx, by):
+                x_shared = T.alloc_shared((block_M, block_K), dtype)
+                w1_shared = T.alloc_shared((block_K, block_H), dtype)
+                h_local = T.alloc_fragment((block_M, block_H), accum_dtype)
+                h_shared = T.alloc_shared((block_M, block_H), dtype)
+                w2_shared = T.alloc_shared((block_H, block_N), dtype)
+                y_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+
+                T.clear(y_local)
+                for h in T.serial(Hd // block_H):
+                    T.clear(h_local)
+                    for k in T.Pipelined(K // block_K, num_stages=num_stages):
+                        T.copy(X[by * block_M, k * block_K], x_shared)
+                        T.copy(W1[k * block_K, h * block_H], w1_shared)
+                        T.gemm(x_shared, w1_shared, h_local)
+                    # The chunk of H only lives in shared memory
+                    for i, j in T.Parallel(block_M, block_H):
+                        if with_bias:
+                            h_shared[i, j] = _activation(h_local[i, j] + B1[h * block_H + j], activation, accum_dtype)
+                        else:
+                            h_shared[i, j] = _activation(h_local[i, j], activation, accum_dtype)
+                    T.copy(W2[h * block_H, bx * block_N], w2_shared)
+                    T.gemm(h_shared, w2_shared, y_local)
+
+                T.copy(y_local, Y[by * block_M, bx * block_N])
+
+        return main
+
+    def params_as_dict(self):
+        """
+        Returns the template parameters as a dictionary.
+
+        Returns:
+            dict: Dictionary containing template parameter values.
+        """
+        return {
+            "M": self.M,
+            "K": self.K,
+            "hidden": self.hidden,
+            "N": self.N,
+            "activation": self.activation,
+            "with_bias": self.with_bias,
+            "in_dtype": self.in_dtype,
+            "out_dtype": self.out_dtype,
+            "accum_dtype": self.accum_dtype,
+        }
+
+    @property
+    def class_attributes(self):
+        """
+        Returns the class attributes in dictionary form.
+
+        Returns:
+            dict: Dictionary of class attributes.
+        """
+        return self.params_as_dict()
+
+    def __repr__(self) -> str:
+        """
+        Returns a string representation of the class instance.
+
+        Returns:
+            str: A formatted string representation of the class.
+        """
+        cls_name = self.__class__.__name__
+        fields = self.class_attributes
+        field_str = ", ".join(f"{key}={value!r}" for key, value in fields.items())
+        return f"{cls_name}({field_str})"
+
+
+@dataclass
+class FusedNormMatmulTemplate(BaseTemplate):
+    """
+    A template for a row normalization followed by a GEMM, ``Y = norm(X) W``.
+
+    The normalization of a row is a per-row scale around per-column factors,
+    so it commutes with the GEMM. With ``r`` the reciprocal RMS (or standard
+    deviation) of a row and ``mu`` its mean::
+
+        rmsnorm:   Y = r * ((X * gamma) W)
+        layernorm: Y = r * ((X * gamma) W - mu * (gamma W)) + beta W
+
+    where ``gamma W`` and ``beta W`` are column sums over the rows of ``W``.
+    ``fused_norm_matmul_program`` accumulates ``(X * gamma) W`` together with
+    the row statistics of ``X`` and the column sums of ``W`` in one pipelined
+    K loop, and applies the normalization to the output tile, so that the
+    normalized activations are never written to DRAM.
+
+    Attributes:
+        M (int): Rows of X and Y (tokens).
+        K (int): Columns of X, the normalized dimension.
+        N (int): Columns of Y.
+        norm_type (str): "rmsnorm" or "layernorm".
+        eps (float): Added to the variance before the reciprocal square root.
+    """
+
+    _output_nodes: list[OutputNode] = None
+
+    # Operation-related configuration parameters
+    M: int = None
+    N: int = None
+    K: int = None
+    norm_type: str = "rmsnorm"
+    eps: float = 1e-6
+
+    in_dtype: str = "float16"
+    out_dtype: str = "float16"
+    accum_dtype: str = "float32"
+
+    def shared_memory_bytes(self, block_M: int, block_N: int, block_K: int, num_stages: int) -> int:
+        """
+        Returns the shared memory a configuration of the kernel allocates.
+
+        Returns:
+            int: Bytes of the pipelined X and W tiles and the scaled X tile.
+        """
+        elems = num_stages * (block_M * block_K + block_K * block_N) + block_M * block_K
+        return elems * _nbytes(self.in_dtype)
+
+    def dram_traffic(self, block_M: int, block_N: int, **kwargs) -> dict:
+        """
+        Returns the modeled DRAM traffic of a configuration and of the unfused pair.
+
+        The unfused pair writes the normalized ``X`` and reads it back for
+        every column block of the GEMM. Both ignore the reuse of the L2.
+
+        Returns:
+            dict: ``fused``, ``unfused`` and ``saved`` bytes.
+        """
+        M, N, K = self.M, self.N, self.K
+        ib, ob = _nbytes(self.in_dtype), _nbytes(self.out_dtype)
+        num_params = 2 if self.norm_type == "layernorm" else 1
+        unfused = 2 * M * K * ib + num_params * K * ib + _gemm_traffic(M, N, K, block_M, block_N, ib, ib, ob)
+        blocks = _ceildiv(M, block_M) * _ceildiv(N, block_N)
+        fused = _gemm_traffic(M, N, K, block_M, block_N, ib, ib, ob) + num_params * K * ib * blocks
+        return {"fused": fused, "unfused": unfused, "saved": unfused - fused}
+
+    def get_autotune_configs(self, topk: int = 10) -> list[dict]:
+        """
+        Returns configurations of ``fused_norm_matmul_program``, the least DRAM traffic first.
+
+        The tiles come from the roller hints of the GEMM. A configuration is
+        kept only when the output accumulator and the squared X tile fit the
+        registers of the block, and every tile the shared memory.
+
+        Args:
+            topk (int, optional): Number of roller hints to consider.
+
+        Returns:
+            List[dict]: Configurations holding ``block_M``, ``block_N``, ``block_K``,
+            ``num_stages`` and ``threads``.
+        """
+        block_K = _largest_divisor(self.K, 64)
+        tiles = [(hint.block[-2], hint.block[-1]) for hint in self.recommend_hints(topk=topk) or []]
+        tiles.append((64, 64))
+        smem_cap = getattr(self.arch, "smem_cap", None) if self.arch is not None else None
+
+        configs = []
+        for block_M, block_N in tiles:
+            block_M = _largest_divisor(block_M, 128, (128, 64))
+            block_N = _largest_divisor(self.N, block_N)
+            threads = 256 if block_M == 128 else 128
+            if block_M * (block_N + block_K) > _MAX_ACCUM_PER_THREAD * threads:
+                continue
+            for num_stages in (3, 2, 1):
+                if smem_cap is not None and self.shared_memory_bytes(block_M, block_N, block_K, num_stages) > smem_cap:
+                    continue
+                config = {"block_M": block_M, "block_N": block_N, "block_K": block_K, "num_stages": num_stages, "threads": threads}
+                if config not in configs:
+                    configs.append(config)
+                break
+        return sorted(configs, key=lambda c: self.dram_traffic(**c)["fused"])
+
+    def get_hardware_aware_configs(self, arch: TileDevice = None, topk: int = 10) -> list[Hint]:
+        """
+        Retrieves the roller hints of the GEMM.
+
+        Args:
+            arch (TileDevice, optional): The target hardware architecture.
+            topk (int, optional): Number of top configurations to consider.
+
+        Returns:
+            List[Hint]: A list of optimization hints for hardware acceleration.
+        """
+        return get_roller_hints_from_output_nodes(self.output_nodes, arch=arch, topk=topk)
+
+    def initialize_function(self) -> None:
+        """
+        Defines the GEMM ``X W`` for the roller; the normalization only adds
+        elementwise work to its tiles.
+
+        Raises:
+            AssertionError: If a dimension is not set or the norm is unknown.
+        """
+        assert all(d is not None and d > 0 for d in (self.M, self.N, self.K)), "M, N and K must be positive"
+        assert self.norm_type in ("rmsnorm", "layernorm"), f"Unsupported norm_type {self.norm_type!r}"
+        func, output_nodes = _matmul_output_nodes(self.M, self.N, self.K, self.in_dtype, self.accum_dtype, self.arch, "NormMatmul")
+        self.set_function(func)
+        self.set_output_nodes(output_nodes)
+
+    def fused_norm_matmul_program(
+        self, block_M: int = 64, block_N: int = 64, block_K: int = 32, num_stages: int = 2, threads: int = 128
+    ):
+        """
+        Builds the fused normalization and GEMM kernel.
+
+        The program reads ``X [M, K]``, ``Gamma [K]``, ``Beta [K]`` and
+        ``W [K, N]`` and writes ``Y [M, N]``; ``Beta`` is only read by the
+        layernorm.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        assert self.N % block_N == 0, "N must be a multiple of block_N"
+        assert self.K % block_K == 0, "K must be a multiple of block_K"
+
+        M, N, K = self.M, self.N, self.K
+        layernorm, eps = self.norm_type == "layernorm", self.eps
+        dtype, out_dtype, accum_dtype = self.in_dtype, self.out_dtype, self.accum_dtype
+
+        @T.prim_func
+        def main(
+            X: T.Tensor((M, K), dtype),
+            Gamma: T.Tensor((K,), dtype),
+            Beta: T.Tensor((K,), dtype),
+            W: T.Tensor((K, N), dtype),
+            Y: T.Tensor((M, N), out_dtype),
+        ):
+            with T.Kernel(N // block_N, T.ceildiv(M, block_M), threads=threads) as (bx, by):
+                x_shared = T.alloc_shared((block_M, block_K), dtype)
+                xg_shared = T.alloc_shared((block_M, block_K), dtype)
+                w_shared = T.alloc_shared((block_K, block_N), dtype)
+                y_local = T.alloc_fragment((block_M, block_N), accum_dtype)
+                x_local = T.alloc_fragment((block_M, block_K), accum_dtype)
+                sum_sq = T.alloc_fragment((block_M,), accum_dtype)
+                row_sum = T.alloc_fragment((block_M,), accum_dtype)
+                w_local = T.alloc_fragment((block_K, block_N), accum_dtype)
+                gamma_w = T.alloc_fragment((block_N,), accum_dtype)
+                beta_w = T.alloc_fragment((block_N,), accum_dtype)
+
+                T.clear(y_local)
+                T.clear(sum_sq)
+                T.clear(row_sum)
+                T.clear(gamma_w)
+                T.clear(beta_w)
+                for k in T.Pipelined(K // block_K, num_stages=num_stages):
+                    T.copy(X[by * block_M, k * block_K], x_shared)
+                    T.copy(W[k * block_K, bx * block_N], w_shared)
+                    for i, j in T.Parallel(block_M, block_K):
+                        xg_shared[i, j] = x_shared[i, j] * Gamma[k * block_K + j]
+                    if layernorm:
+                        T.copy(x_shared, x_local)
+                        T.reduce_sum(x_local, row_sum, dim=1, clear=False)
+                        for i, j in T.Parallel(block_K, block_N):
+                            w_local[i, j] = Gamma[k * block_K + i] * w_shared[i, j]
+                        T.reduce_sum(w_local, gamma_w, dim=0, clear=False)
+                        for i, j in T.Parallel(block_K, block_N):
+                            w_local[i, j] = Beta[k * block_K + i] * w_shared[i, j]
+                        T.reduce_sum(w_local, beta_w, dim=0, clear=False)
+                    for i, j in T.Parallel(block_M, block_K):
+                        x_local[i, j] = x_shared[i, j] * x_shared[i, j]
+                    T.reduce_sum(x_local, sum_sq, dim=1, clear=False)
+                    T.gemm(xg_shared, w_shared, y_local)
+
+                if layernorm:
+                    for i, j in T.Parallel(block_M, block_N):
+                        y_local[i, j] = (y_local[i, j] - row_sum[i] / K * gamma_w[j]) * T.rsqrt(
+                            sum_sq[i] / K - (row_sum[i] / K) * (row_sum[i] / K) + eps
+                        ) + beta_w[j]
+                else:
+                    for i, j in T.Parallel(block_M, block_N):
+                        y_local[i, j] = y_local[i, j] * T.rsqrt(sum_sq[i] / K + eps)
+                T.copy(y_local, Y[by * block_M, bx * block_N])
+
+        return main
+
+    def params_as_dict(self):
+        """
+        Returns the template parameters as a dictionary.
+
+        Returns:
+            dict: Dictionary containing template parameter values.
+        """
+        return {
+            "M": self.M,
+            "N": self.N,
+            "K": self.K,
+            "norm_type": self.norm_type,
+            "eps": self.eps,
+            "in_dtype": self.in_dtype,
+            "out_dtype": self.out_dtype,
+            "accum_dtype": self.accum_dtype,
+        }
+
+    @property
+    def class_attributes(self):
+        """
+        Returns the class attributes in dictionary form.
+
+        Returns:
+            dict: Dictionary of class attributes.
+        """
+        return self.params_as_dict()
+
+    def __repr__(self) -> str:
+        """
+        Returns a string representation of the class instance.
+
+        Returns:
+            str: A formatted string representation of the class.
+        """
+        cls_name = self.__class__.__name__
+        fields = self.class_attributes
+        field_str = ", ".join(f"{key}={value!r}" for key, value in fields.items())
+        return f"{cls_name}({field_str})"
@@ -0,0 +1,61 @@
+from dataclasses import dataclass
+from .matmul import MatmulTemplate
+
+
+@dataclass
+class GroupedMatmulTemplate(MatmulTemplate):
+    """
+    A template for grouped matrix multiplication, e.g. the experts of a MoE layer.
+
+    Every problem ``i`` computes ``C_i = A_i @ B_i`` with its own ``(M_i, N_i, K_i)``.
+    A persistent grouped kernel walks the tiles of all problems as one stream,
+    so a single tile shape serves every group. It is chosen for the equivalent
+    matmul with the rows of all problems stacked (``M = sum(M_i)``) and the
+    largest ``N`` and ``K``.
+
+    Attributes:
+        problems (tuple): ``(M, N, K)`` of every problem of the group.
+    """
+
+    problems: tuple = None  # (M, N, K) of every problem
+
+    def initialize_function(self) -> None:
+        """
+        Define the equivalent stacked matmul of the problems.
+
+        Raises:
+            AssertionError: If no problem is given or a problem is not a positive (M, N, K).
+        """
+        assert self.problems, "GroupedMatmulTemplate needs at least one problem"
+        for problem in self.problems:
+            assert len(problem) == 3 and all(isinstance(x, int) and x > 0 for x in problem), (
+                f"Problems must be positive integer (M, N, K), got {problem}"
+            )
+        self.M = sum(m for m, _, _ in self.problems)
+        self.N = max(n for _, n, _ in self.problems)
+        self.K = max(k for _, _, k in self.problems)
+        super().initialize_function()
+
+    def num_tiles(self, block_M: int, block_N: int) -> int:
+        """
+        Returns the number of output tiles of all problems for a tile shape.
+
+        Args:
+            block_M (int): Rows of a tile.
+            block_N (int): Columns of a tile.
+
+        Returns:
+            int: Total number of tiles a persistent kernel schedules.
+        """
+        return sum(((m + block_M - 1) // block_M) * ((n + block_N - 1) // block_N) for m, n, _ in self.problems)
+
+    def params_as_dict(self):
+        """
+        Returns the template parameters as a dictionary.
+
+        Returns:
+            dict: Dictionary containing template parameter values.
+        """
+        params = super().params_as_dict()
+        params["problems"] = self.problems
+        return params
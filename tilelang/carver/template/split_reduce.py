@@ -0,0 +1,467 @@
+from __future__ import annotations
+
+import math
+from dataclasses import dataclass
+
+from tvm import DataType, te, tir
+
+from .base import BaseTemplate
+from ..arch import TileDevice
+from ..roller import Hint
+from ..utils import get_roller_hints_from_func
+
+_OPS = ("softmax", "cross_entropy", "rms_norm")
+_LOG2E = 1.44269504
+# Largest cluster every sm_90 part launches without opting in
+_MAX_CLUSTER_SIZE = 8
+_MAX_SPLITS = 64
+
+
+@dataclass
+class SplitRowReductionTemplate(BaseTemplate):
+    """
+    A template for row reductions over rows too long for one block.
+
+    Softmax over a large vocabulary, the LM head cross-entropy and the norms
+    of wide hidden states reduce rows of hundreds of thousands of elements,
+    often for a handful of rows only. One block per row then leaves most SMs
+    idle. Here ``num_splits`` blocks share every row, each owning a
+    contiguous run of its ``block_N`` column tiles:
+
+    1. every block reduces its run in a first read: the online max and sum of
+       exponentials for ``softmax`` and ``cross_entropy``, the sum of
+       squares for ``rms_norm``;
+    2. the partial statistics of the blocks of a row are combined;
+    3. every block reads its run again and writes the normalized output, so
+       a row is read twice from HBM and written once.
+
+    ``cluster_program`` makes the blocks of a row a thread block cluster and
+    combines through distributed shared memory (``T.cluster_allreduce``,
+    sm_90 and later, up to ``_MAX_CLUSTER_SIZE`` blocks). ``partial_programs``
+    splits the work into two kernels combining through a global buffer of
+    partials instead, for any architecture and split count.
+
+    The operations, on ``X [num_rows, row_length]``:
+
+    - ``softmax``: ``Y = softmax(X, dim=-1)``;
+    - ``cross_entropy``: ``Loss [num_rows]`` (float32) for the ``Labels
+      [num_rows]`` (int64) and its gradient ``DX = softmax(X) - onehot(Labels)``;
+      rows labelled ``ignore_index`` have a zero loss and gradient;
+    - ``rms_norm``: ``Y = X * rsqrt(mean(X ** 2) + eps) * W`` for ``W [row_length]``.
+
+    Attributes:
+        op (str): One of ``softmax``, ``cross_entropy`` and ``rms_norm``.
+        num_rows (int): Rows of ``X``.
+        row_length (int): Columns of ``X``.
+        dtype (str): Data type of ``X``, ``W``, ``Y`` and ``DX``.
+        eps (float): Epsilon of ``rms_norm``.
+        ignore_index (int): Label of the rows ``cross_entropy`` skips.
+    """
+
+    op: str = "softmax"
+    num_rows: int = None
+    row_length: int = None
+    dtype: str = "float16"
+    eps: float = 1e-6
+    ignore_index: int = -100
+
+    accum_dtype: str = "float32"
+
+    def get_hardware_aware_configs(self, arch: TileDevice = None, topk: int = 10) -> list[Hint]:
+        """
+        Retrieves hardware-aware optimization configurations.
+
+        Args:
+            arch (TileDevice, optional): The target hardware architecture.
+            topk (int, optional): Number of top configurations to consider.
+
+        Returns:
+            List[Hint]: A list of optimization hints for hardware acceleration.
+        """
+        return get_roller_hints_from_func(self._func, arch=arch, topk=topk, allow_gemv=False)
+
+    def initialize_function(self) -> None:
+        """
+        Defines the row sum of ``X`` for the roller.
+
+        Raises:
+            ValueError: If the operation or the shape is invalid.
+        """
+        if self.op not in _OPS:
+            raise ValueError(f"Unknown op {self.op!r}, expected one of {_OPS}")
+        if not all(isinstance(s, int) and s > 0 for s in (self.num_rows, self.row_length)):
+            raise ValueError("`num_rows` and `row_length` must be positive integers.")
+
+        M, N = self.num_rows, self.row_length
+        A = te.placeholder((M, N), name="A", dtype=self.dtype)
+        k = te.reduce_axis((0, N), name="k")
+        C = te.compute((M,), lambda i: te.sum(A[i, k].astype(self.accum_dtype), axis=k), name="C")
+        self.set_function(te.create_prim_func([A, C]))
+
+    def num_splits(self, block_M: int, block_N: int, max_splits: int = _MAX_SPLITS) -> int:
+        """
+        Returns the blocks sharing a row, a power of two.
+
+        The splits double until the blocks cover every SM, a block owns at
+        least one tile or ``max_splits`` is reached.
+        """
+        num_sms = getattr(self.arch, "compute_max_core", 1) if self.arch is not None else 1
+        row_blocks = math.ceil(self.num_rows / block_M)
+        num_tiles = math.ceil(self.row_length / block_N)
+        splits = 1
+        while row_blocks * splits < num_sms and splits * 2 <= min(num_tiles, max_splits):
+            splits *= 2
+        return splits
+
+    def get_autotune_configs(self, threads: int = 256) -> list[dict]:
+        """
+        Returns configurations of ``cluster_program`` and ``partial_programs``.
+
+        A tile holds 4 or 2 128-bit vectors per thread, over 1 to 8 rows.
+        Every configuration holds ``block_M``, ``block_N``, ``num_splits``,
+        ``threads`` and ``use_cluster``. On sm_90 and later the cluster
+        configuration of a tile comes first, its splits capped to a cluster;
+        the partials one follows with as many splits as fill the SMs.
+
+        Args:
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            List[dict]: Distinct configurations, the preferred one first.
+        """
+        vec = max(1, 128 // DataType(str(self.dtype)).bits)
+        cluster = getattr(self.arch, "sm_version", 0) >= 90
+        configs = []
+        for unroll in (4, 2):
+            for block_M in (1, 2, 4, 8):
+                if block_M > max(1, self.num_rows):
+                    break
+                block_N = threads * vec * unroll // block_M
+                candidates = [(False, self.num_splits(block_M, block_N))]
+                if cluster:
+                    candidates.insert(0, (True, self.num_splits(block_M, block_N, _MAX_CLUSTER_SIZE)))
+                for use_cluster, splits in candidates:
+                    # A single split needs no combine
+                    use_cluster = use_cluster and splits > 1
+                    config = {"block_M": block_M, "block_N": block_N, "num_splits": splits, "threads": threads, "use_cluster": use_cluster}
+                    if config not in configs:
+                        configs.append(config)
+        return configs
+
+    def _row_kernels(self, block_M: int, block_N: int, num_splits: int):
+        """The macros shared by the programs of a configuration."""
+        import tilelang.language as T
+
+        op, dtype, accum_dtype = self.op, self.dtype, self.accum_dtype
+        M, N, eps, ignore_index = self.num_rows, self.row_length, self.eps, self.ignore_index
+        num_tiles = math.ceil(N / block_N)
+        tiles_per_split = math.ceil(num_tiles / num_splits)
+        # Whether the tiles of the splits cover X exactly, without predicates
+        exact_rows, exact_cols = M % block_M == 0, N % block_N == 0
+        exact_splits = num_tiles % num_splits == 0
+        pad = tir.const(0, accum_dtype) if op == "rms_norm" else -T.infinity(accum_dtype)
+
+        @T.macro
+        def load(X, x, tile, by):
+            for i, j in T.Parallel(block_M, block_N):
+                row, col = by * block_M + i, tile * block_N + j
+                if exact_rows and exact_cols:
+                    x[i, j] = T.Cast(accum_dtype, X[row, col])
+                else:
+                    x[i, j] = T.if_then_else((row < M) & (col < N), T.Cast(accum_dtype, X[row, col]), pad)
+
+        @T.macro
+        def reduce_tile(x, stat_max, stat_sum, stat_prev):
+            if op == "rms_norm":
+                for i, j in T.Parallel(block_M, block_N):
+                    x[i, j] = x[i, j] * x[i, j]
+                T.reduce_sum(x, stat_sum, dim=1, clear=False)
+            else:
+                # Online max and sum of exponentials, the tiles of a valid row
+                # always hold a valid column so the max stays finite
+                T.copy(stat_max, stat_prev)
+                T.reduce_max(x, stat_max, dim=1, clear=False)
+                for i in T.Parallel(block_M):
+                    stat_sum[i] *= T.exp2((stat_prev[i] - stat_max[i]) * _LOG2E)
+                for i, j in T.Parallel(block_M, block_N):
+                    x[i, j] = T.exp2((x[i, j] - stat_max[i]) * _LOG2E)
+                T.reduce_sum(x, stat_sum, dim=1, clear=False)
+
+        @T.macro
+        def first_pass(X, x, stat_max, stat_sum, stat_prev, split, by):
+            T.fill(stat_max, -T.infinity(accum_dtype))
+            T.fill(stat_sum, 0)
+            for t in T.serial(tiles_per_split):
+                tile = split * tiles_per_split + t
+                if exact_splits:
+                    load(X, x, tile, by)
+                    reduce_tile(x, stat_max, stat_sum, stat_prev)
+                elif tile < num_tiles:
+                    load(X, x, tile, by)
+                    reduce_tile(x, stat_max, stat_sum, stat_prev)
+
+        def output(x, W, label, stat_max, stat_sum, i, j, col):
+            if op == "softmax":
+                return T.exp2((x[i, j] - stat_max[i]) * _LOG2E) * stat_sum[i]
+            if op == "cross_entropy":
+                prob = T.exp2((x[i, j] - stat_max[i]) * _LOG2E) * stat_sum[i]
+                return T.if_then_else(label[i] == ignore_index, 0, prob - T.if_then_else(col == label[i], 1, 0))
+            return x[i, j] * stat_sum[i] * T.Cast(accum_dtype, W[col])
+
+        @T.macro
+        def store(Y, x, W, label, stat_max, stat_sum, tile, by):
+            for i, j in T.Parallel(block_M, block_N):
+                row, col = by * block_M + i, tile * block_N + j
+                if exact_rows and exact_cols:
+                    Y[row, col] = T.Cast(dtype, output(x, W, label, stat_max, stat_sum, i, j, col))
+                elif (row < M) & (col < N):
+                    # W is only read in bounds
+                    Y[row, col] = T.Cast(dtype, output(x, W, label, stat_max, stat_sum, i, j, col))
+
+        @T.macro
+        def second_pass(X, W, Labels, Loss, Y, x, label, stat_max, stat_sum, split, by):
+            if op == "cross_entropy":
+                for i in T.Parallel(block_M):
+                    row = by * block_M + i
+                    label[i] = T.if_then_else(row < M, T.Cast(T.int32, Labels[row]), ignore_index)
+                # loss = logsumexp(x) - x[label], written by the first split
+                if split == 0:
+                    for i in T.Parallel(block_M):
+                        row = by * block_M + i
+                        if row < M:
+                            Loss[row] = T.if_then_else(
+                                label[i] == ignore_index,
+                                0,
+                                stat_max[i] + T.log(stat_sum[i]) - T.Cast(accum_dtype, X[row, label[i]]),
+                            )
+            for i in T.Parallel(block_M):
+                if op == "rms_norm":
+                    stat_sum[i] = T.rsqrt(stat_sum[i] / N + eps)
+                else:
+                    stat_sum[i] = 1.0 / stat_sum[i]
+            for t in T.serial(tiles_per_split):
+                tile = split * tiles_per_split + t
+                if exact_splits:
+                    load(X, x, tile, by)
+                    store(Y, x, W, label, stat_max, stat_sum, tile, by)
+                elif tile < num_tiles:
+                    load(X, x, tile, by)
+                    store(Y, x, W, label, stat_max, stat_sum, tile, by)
+
+        return first_pass, second_pass
+
+    def cluster_program(self, block_M: int = 1, block_N: int = 4096, num_splits: int = 4, threads: int = 256):
+        """
+        Builds the single kernel combining the splits of a row in a cluster.
+
+        The ``num_splits`` blocks of a row block form a cluster (none for a
+        single split) and exchange their statistics through distributed
+        shared memory between the two passes.
+
+        The arguments are ``(X, Y)`` for ``softmax``, ``(X, Labels, Loss,
+        DX)`` for ``cross_entropy`` and ``(X, W, Y)`` for ``rms_norm``.
+
+        Args:
+            block_M (int, optional): Rows of a tile.
+            block_N (int, optional): Columns of a tile.
+            num_splits (int, optional): Blocks sharing a row, at most ``_MAX_CLUSTER_SIZE``.
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            PrimFunc: The TileLang program.
+        """
+        import tilelang.language as T
+
+        assert 1 <= num_splits <= _MAX_CLUSTER_SIZE, f"num_splits ({num_splits}) must fit in a cluster of {_MAX_CLUSTER_SIZE}"
+        op, dtype, accum_dtype = self.op, self.dtype, self.accum_dtype
+        M, N = self.num_rows, self.row_length
+        row_blocks = math.ceil(M / block_M)
+        cluster_dims = (num_splits, 1, 1) if num_splits > 1 else None
+        first_pass, second_pass = self._row_kernels(block_M, block_N, num_splits)
+
+        @T.macro
+        def body(X, W, Labels, Loss, Y):
+            with T.Kernel(num_splits, row_blocks, threads=threads, cluster_dims=cluster_dims) as (bx, by):
+                x = T.alloc_fragment((block_M, block_N), accum_dtype)
+                stat_max = T.alloc_fragment((block_M,), accum_dtype)
+                stat_sum = T.alloc_fragment((block_M,), accum_dtype)
+                stat_prev = T.alloc_fragment((block_M,), accum_dtype)
+                label = T.alloc_fragment((block_M,), T.int32)
+
+                first_pass(X, x, stat_max, stat_sum, stat_prev, bx, by)
+                if num_splits > 1:
+                    if op == "rms_norm":
+                        T.cluster_allreduce(stat_sum, "sum")
+                    else:
+                        T.copy(stat_max, stat_prev)
+                        T.cluster_allreduce(stat_max, "max")
+                        for i in T.Parallel(block_M):
+                            stat_sum[i] *= T.exp2((stat_prev[i] - stat_max[i]) * _LOG2E)
+                        T.cluster_allreduce(stat_sum, "sum")
+                second_pass(X, W, Labels, Loss, Y, x, label, stat_max, stat_sum, bx, by)
+
+        if op == "softmax":
+
+            @T.prim_func
+            def main(X: T.Tensor((M, N), dtype), Y: T.Tensor((M, N), dtype)):
+                body(X, None, None, None, Y)
+
+        elif op == "cross_entropy":
+
+            @T.prim_func
+            def main(
+                X: T.Tensor((M, N), dtype),
+                Labels: T.Tensor((M,), T.int64),
+                Loss: T.Tensor((M,), accum_dtype),
+                DX: T.Tensor((M, N), dtype),
+            ):
+                body(X, None, Labels, Loss, DX)
+
+        else:
+
+            @T.prim_func
+            def main(X: T.Tensor((M, N), dtype), W: T.Tensor((N,), dtype), Y: T.Tensor((M, N), dtype)):
+                body(X, W, None, None, Y)
+
+        return main
+
+    def partial_programs(self, block_M: int = 1, block_N: int = 4096, num_splits: int = 16, threads: int = 256):
+        """
+        Builds the two kernels combining the splits of a row in global memory.
+
+        The first kernel ``(X, Partials)`` writes the statistics of every
+        split to ``Partials [2, num_rows, num_splits]`` (float32, the running
+        maxima then the sums); the second one takes the arguments of
+        ``cluster_program`` with ``Partials`` after the inputs, combines the
+        statistics of its row block and makes the second pass.
+
+        Args:
+            block_M (int, optional): Rows of a tile.
+            block_N (int, optional): Columns of a tile.
+            num_splits (int, optional): Blocks sharing a row.
+            threads (int, optional): Threads of a block.
+
+        Returns:
+            Tuple[PrimFunc, PrimFunc]: The statistics and the normalization programs.
+        """
+        import tilelang.language as T
+
+        op, dtype, accum_dtype = self.op, self.dtype, self.accum_dtype
+        M, N = self.num_rows, self.row_length
+        row_blocks = math.ceil(M / block_M)
+        first_pass, second_pass = self._row_kernels(block_M, block_N, num_splits)
+
+        @T.prim_func
+        def stats(X: T.Tensor((M, N), dtype), Partials: T.Tensor((2, M, num_splits), accum_dtype)):
+            with T.Kernel(num_splits, row_blocks, threads=threads) as (bx, by):
+                x = T.alloc_fragment((block_M, block_N), accum_dtype)
+                stat_max = T.alloc_fragment((block_M,), accum_dtype)
+                stat_sum = T.alloc_fragment((block_M,), accum_dtype)
+                stat_prev = T.alloc_fragment((block_M,), accum_dtype)
+
+                first_pass(X, x, stat_max, stat_sum, stat_prev, bx, by)
+                for i in T.Parallel(block_M):
+                    if by * block_M + i < M:
+                        Partials[0, by * block_M + i, bx] = stat_max[i]
+                        Partials[1, by * block_M + i, bx] = stat_sum[i]
+
+        @T.macro
+        def body(X, W, Labels, Partials, Loss, Y):
+            with T.Kernel(num_splits, row_blocks, threads=threads) as (bx, by):
+                x = T.alloc_fragment((block_M, block_N), accum_dtype)
+                parts = T.alloc_fragment((block_M, num_splits), accum_dtype)
+                stat_max = T.alloc_fragment((block_M,), accum_dtype)
+                stat_sum = T.alloc_fragment((block_M,), accum_dtype)
+                label = T.alloc_fragment((block_M,), T.int32)
+
+                if op == "rms_norm":
+                    for i, s in T.Parallel(block_M, num_splits):
+                        row = by * block_M + i
+                        parts[i, s] = T.if_then_else(row < M, Partials[1, row, s], 0)
+                    T.reduce_sum(parts, stat_sum, dim=1)
+                else:
+                    for i, s in T.Parallel(block_M, num_splits):
+                        row = by * block_M + i
+                        parts[i, s] = T.if_then_else(row < M, Partials[0, row, s], -T.infinity(accum_dtype))
+                    T.reduce_max(parts, stat_max, dim=1)
+                    for i, s in T.Parallel(block_M, num_splits):
+                        row = by * block_M + i
+                        parts[i, s] = T.if_then_else(
+                            row < M, Partials[1, row, s] * T.exp2((Partials[0, row, s] - stat_max[i]) * _LOG2E), 0
+                        )
+                    T.reduce_sum(parts, stat_sum, dim=1)
+                second_pass(X, W, Labels, Loss, Y, x, label, stat_max, stat_sum, bx, by)
+
+        if op == "softmax":
+
+            @T.prim_func
+            def normalize(
+                X: T.Tensor((M, N), dtype),
+                Partials: T.Tensor((2, M, num_splits), accum_dtype),
+                Y: T.Tensor((M, N), dtype),
+            ):
+                body(X, None, None, Partials, None, Y)
+
+        elif op == "cross_entropy":
+
+            @T.prim_func
+            def normalize(
+                X: T.Tensor((M, N), dtype),
+                Labels: T.Tensor((M,), T.int64),
+                Partials: T.Tensor((2, M, num_splits), accum_dtype),
+                Loss: T.Tensor((M,), accum_dtype),
+                DX: T.Tensor((M, N), dtype),
+            ):
+                body(X, None, Labels, Partials, Loss, DX)
+
+        else:
+
+            @T.prim_func
+            def normalize(
+                X: T.Tensor((M, N), dtype),
+                W: T.Tensor((N,), dtype),
+                Partials: T.Tensor((2, M, num_splits), accum_dtype),
+                Y: T.Tensor((M, N), dtype),
+            ):
+                body(X, W, None, Partials, None, Y)
+
+        return stats, normalize
+
+    def params_as_dict(self):
+        """
+        Returns the template parameters as a dictionary.
+
+        Returns:
+            dict: Dictionary containing template parameter values.
+        """
+        return {
+            "op": self.op,
+            "num_rows": self.num_rows,
+            "row_length": self.row_length,
+            "dtype": self.dtype,
+            "eps": self.eps,
+            "ignore_index": self.ignore_index,
+            "accum_dtype": self.accum_dtype,
+        }
+
+    @property
+    def class_attributes(self):
+        """
+        Returns the class attributes in dictionary form.
+
+        Returns:
+            dict: Dictionary of class attributes.
+        """
+        return self.params_as_dict()
+
+    def __repr__(self) -> str:
+        """
+        Returns a string representation of the class instance.
+
+        Returns:
+            str: A formatted string representation of the class.
+        """
+        cls_name = self.__class__.__name__
+        fields = self.class_attributes
+        field_str = ", ".join(f"{key}={value!r}" for key, value in fields.items())
+        return f"{cls_name}({field_str})"
@@ -8,7 +8,7 @@ import cutlass._mlir.dialects.cute as _cute_ir
 import cutlass._mlir.dialects.cute_nvgpu as _cute_nvgpu_ir
 
 import cutlass.cute as cute
-from cutlass.cute.typing import Int, Boolean, Int32, Int16, Uint64, Union  # noqa: F401
+from cutlass.cute.typing import Int, Boolean, Int32, Int16, Int64, Uint64, Union  # noqa: F401
 from cutlass.impl_utils import check_value_in
 
 from cutlass.cute.arch import cp_async_commit_group as cp_async_commit  # noqa: F401
@@ -17,6 +17,21 @@ from cutlass.cute.arch import cp_async_wait_group as cp_async_wait  # noqa: F401
 BYTES_PER_TENSORMAP = 128
 BYTES_PER_POINTER = 8
 
+# L2 cache policies of the TMA copies, the createpolicy encodings of the
+# CUDA backend (CacheHintSm90)
+L2_CACHE_HINTS = {
+    "EVICT_NORMAL": 0x1000000000000000,
+    "EVICT_FIRST": 0x12F0000000000000,
+    "EVICT_LAST": 0x14F0000000000000,
+}
+
+
+def _l2_cache_hint(eviction_policy: str, loc=None, ip=None):
+    check_value_in(eviction_policy, list(L2_CACHE_HINTS), "eviction_policy")
+    if eviction_policy == "EVICT_NORMAL":
+        return None
+    return Int64(L2_CACHE_HINTS[eviction_policy]).ir_value(loc=loc, ip=ip)
+
 
 def cp_async_gs(size, dst, dst_offset, src, src_offset):
     assert size in [16, 8, 4]
@@ -57,7 +72,16 @@ def extract_tensormap_ptr(tma_atom: cute.CopyAtom, *, loc=None, ip=None) -> cute
 
 
 @dsl_user_op
-def tma_load(tma_desc, mbar: cute.Pointer, smem_ptr: cute.Pointer, crd: Int | tuple[Int, ...], *, loc=None, ip=None) -> None:
+def tma_load(
+    tma_desc,
+    mbar: cute.Pointer,
+    smem_ptr: cute.Pointer,
+    crd: Int | tuple[Int, ...],
+    *,
+    eviction_policy: str = "EVICT_NORMAL",
+    loc=None,
+    ip=None,
+) -> None:
     """
     Load data from global memory to shared memory using TMA (Tensor Memory Access).
 
@@ -69,9 +93,12 @@ def tma_load(tma_desc, mbar: cute.Pointer, smem_ptr: cute.Pointer, crd: Int | tu
     :type smem_ptr:                  Pointer
     :param crd:                      Coordinates tuple for the tensor access
     :type crd:                       tuple[Int, ...]
+    :param eviction_policy:          L2 eviction policy of the loaded data
+    :type eviction_policy:           str
     """
     arch = CuTeDSL._get_dsl().envar.arch
     check_value_in(arch, ["sm_90", "sm_90a", "sm_100a"], "arch")
+    l2_cache_hint = _l2_cache_hint(eviction_policy, loc=loc, ip=ip)
 
     if not isinstance(crd, tuple) and isinstance(tma_desc, cute.Pointer):
         # Legacy signature: tma_load(smem_ptr, gmem_ptr, mbar, size)
@@ -83,6 +110,7 @@ def tma_load(tma_desc, mbar: cute.Pointer, smem_ptr: cute.Pointer, crd: Int | tu
             src_mem=_gmem_ptr.llvm_ptr,
             mbar=_mbar.llvm_ptr,
             size=Int32(crd).ir_value(loc=loc, ip=ip),
+            l2_cache_hint=l2_cache_hint,
             loc=loc,
             ip=ip,
         )
@@ -101,6 +129,7 @@ def tma_load(tma_desc, mbar: cute.Pointer, smem_ptr: cute.Pointer, crd: Int | tu
             im2col_offsets=[],
             load_mode=nvvm.CpAsyncBulkTensorLoadMode.TILE,
             group=nvvm.Tcgen05GroupKind.CTA_1,
+            l2_cache_hint=l2_cache_hint,
             use_intrinsic=False,  # set to True would lead to compile error
             loc=loc,
             ip=ip,
@@ -108,7 +137,15 @@ def tma_load(tma_desc, mbar: cute.Pointer, smem_ptr: cute.Pointer, crd: Int | tu
 
 
 @dsl_user_op
-def tma_store(tma_desc, smem_ptr: cute.Pointer, crd: Int | tuple[Int, ...], *, loc=None, ip=None) -> None:
+def tma_store(
+    tma_desc,
+    smem_ptr: cute.Pointer,
+    crd: Int | tuple[Int, ...],
+    *,
+    eviction_policy: str = "EVICT_NORMAL",
+    loc=None,
+    ip=None,
+) -> None:
     """
     Store data from shared memory to global memory using TMA (Tensor Memory Access).
 
@@ -118,9 +155,12 @@ def tma_store(tma_desc, smem_ptr: cute.Pointer, crd: Int | tuple[Int, ...], *, l
     :type smem_ptr:                  Pointer
     :param crd:                      Coordinates tuple for the tensor access
     :type crd:                       tuple[Int, ...]
+    :param eviction_policy:          L2 eviction policy of the stored data
+    :type eviction_policy:           str
     """
     arch = CuTeDSL._get_dsl().envar.arch
     check_value_in(arch, ["sm_90", "sm_90a", "sm_100a"], "arch")
+    l2_cache_hint = _l2_cache_hint(eviction_policy, loc=loc, ip=ip)
     if not isinstance(crd, tuple):
         if arch not in ("sm_90", "sm_90a"):
             raise NotImplementedError("tma_store(size) path is only implemented for sm_90/sm_90a")
@@ -143,6 +183,7 @@ def tma_store(tma_desc, smem_ptr: cute.Pointer, crd: Int | tuple[Int, ...], *, l
             tma_descriptor=tma_desc_ptr.llvm_ptr,
             src_mem=smem_ptr.llvm_ptr,
             coordinates=[Int32(i).ir_value(loc=loc, ip=ip) for i in crd],
+            l2_cache_hint=l2_cache_hint,
             predicate=None,
             loc=loc,
             ip=ip,
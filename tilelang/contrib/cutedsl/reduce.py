@@ -66,6 +66,14 @@ class MinOp:
         return min(x, y)
 
 
+class ProdOp:
+    """Product reduction operator"""
+
+    @staticmethod
+    def __call__(x, y):
+        return x * y
+
+
 class BitAndOp:
     """Bitwise AND reduction operator"""
 
@@ -183,4 +191,65 @@ def AllReduce(reducer, threads, scale, thread_offset, all_threads=None):
                 else AllReduce(self.reducer, offset, self.scale, self.thread_offset, self.all_threads).run_hopper(x, red_buf)
             )
 
+        def run_batch(self, num, vals: cute.Pointer, red_buf: cute.Pointer = None):
+            """
+            Element-wise all-reduce of the ``num`` values at ``vals``.
+            Based on tl::AllReduce<...>::run_batch from reduce.h, one value at a time.
+            """
+            for i in cutlass.range(num):
+                val = cute.make_tensor(vals + i, (1,))
+                val[0] = self.run(val[0], red_buf)
+
+        def run_batch_hopper(self, num, vals: cute.Pointer, red_buf: cute.Pointer = None):
+            """
+            Element-wise all-reduce of the ``num`` values at ``vals`` using bar.sync.
+            Based on tl::AllReduce<...>::run_batch_hopper from reduce.h, one value at a time.
+            """
+            for i in cutlass.range(num):
+                val = cute.make_tensor(vals + i, (1,))
+                val[0] = self.run_hopper(val[0], red_buf)
+
+        def _reduce_compact(self, x, red_buf, sync):
+            """
+            Warp stage, then one partial per warp and part through ``red_buf``.
+            Based on tl::AllReduce<...>::run_compact from reduce.h
+            """
+            warp_threads = min(self.threads, 32)
+            if warp_threads > self.scale:
+                x = AllReduce(self.reducer, warp_threads, self.scale, self.thread_offset, self.all_threads).run(x)
+            if self.threads > 32:
+                parts = min(self.scale, 32)
+                stride = max(self.scale, 32)
+
+                def slot(t):
+                    return t // 32 * parts + t % parts
+
+                tidx, _, _ = cute.arch.thread_idx()
+                tid = tidx - self.thread_offset
+                sync()
+                # the lanes of a part store the same value
+                cute.make_tensor(red_buf + slot(tid), (1,))[0] = x
+                sync()
+                base = (tid // self.threads * self.threads) + tid % stride
+                x = cute.make_tensor(red_buf + slot(base), (1,))[0]
+                for i in range(1, self.threads // stride):
+                    x = self.reducer()(x, cute.make_tensor(red_buf + slot(base + i * stride), (1,))[0])
+            return x
+
+        def run_compact(self, x, red_buf: cute.Pointer = None):
+            return self._reduce_compact(x, red_buf, cute.arch.sync_threads)
+
+        def run_compact_hopper(self, x, red_buf: cute.Pointer = None):
+            return self._reduce_compact(x, red_buf, lambda: bar_sync_ptx(1, self.all_threads))
+
+        def run_batch_compact(self, num, vals: cute.Pointer, red_buf: cute.Pointer = None):
+            for i in cutlass.range(num):
+                val = cute.make_tensor(vals + i, (1,))
+                val[0] = self.run_compact(val[0], red_buf)
+
+        def run_batch_compact_hopper(self, num, vals: cute.Pointer, red_buf: cute.Pointer = None):
+            for i in cutlass.range(num):
+                val = cute.make_tensor(vals + i, (1,))
+                val[0] = self.run_compact_hopper(val[0], red_buf)
+
     return AllReduceInstance(reducer, threads, scale, thread_offset, all_threads)
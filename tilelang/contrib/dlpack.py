@@ -16,6 +16,8 @@
 # under the License.
 """Wrapping functions to bridge frameworks with DLPack support to TVM"""
 
+from __future__ import annotations
+
 from tvm import runtime
 
 
@@ -56,3 +58,46 @@ def convert_func(tvm_func, tensor_type, to_dlpack_func):
         return tvm_func(*args)
 
     return _wrapper
+
+
+# DLDeviceType of the devices whose producers take the consumer stream
+_kDLCUDA, _kDLROCM = 2, 10
+
+
+def dlpack_device(obj) -> tuple[int, int] | None:
+    """The (DLDeviceType, device id) of an object implementing DLPack, None otherwise."""
+    if not hasattr(obj, "__dlpack_device__"):
+        return None
+    device_type, device_id = obj.__dlpack_device__()
+    return int(device_type), int(device_id)
+
+
+def to_tvm_tensor(obj, stream: int | None = None):
+    """Wrap an object implementing ``__dlpack__`` as a TVM tensor sharing its memory.
+
+    Follows the stream protocol of DLPack: a producer on CUDA or ROCm is given
+    the stream the tensor is consumed on, and orders its pending work before
+    it on that stream rather than synchronizing.
+
+    Parameters
+    ----------
+    obj: Any
+        A tensor of any framework implementing DLPack, e.g. JAX, CuPy or numpy.
+
+    stream: int | None
+        Raw handle of the consuming stream, None or 0 for the default one.
+    """
+    device = dlpack_device(obj)
+    if device is None or device[0] not in (_kDLCUDA, _kDLROCM):
+        return runtime.from_dlpack(obj.__dlpack__())
+    if device[0] == _kDLCUDA:
+        # 0 is reserved by the protocol, 1 is the legacy default stream
+        dl_stream = 1 if not stream else stream
+    else:
+        dl_stream = 0 if not stream else stream
+    try:
+        capsule = obj.__dlpack__(stream=dl_stream)
+    except TypeError:
+        # Producers predating the stream argument
+        capsule = obj.__dlpack__()
+    return runtime.from_dlpack(capsule)
@@ -92,7 +92,7 @@ def compile_hip(code, target_format="hsaco", arch=None, options=None, path_targe
 
 
 @tvm_ffi.register_global_func("tilelang_callback_hip_compile", override=True)
-def tilelang_callback_hip_compile(code, target):
+def tilelang_callback_hip_compile(code, target, pass_config=None):
     """use hipcc to generate fatbin code for better optimization"""
     hsaco = compile_hip(code, target_format="hsaco")
     return hsaco
@@ -0,0 +1,96 @@
+"""In-memory compilation of HIP code with hipRTC.
+
+hipcc writes the kernel source to a temporary file, spawns the clang driver and
+reads the code object back from disk. hipRTC runs the same compiler (through
+comgr) inside the process and hands the code object over in memory, which
+saves the process start-up and the file round trips of every kernel.
+"""
+
+from __future__ import annotations
+
+import os
+
+from tilelang.contrib.rocm import find_rocm_path, get_rocm_arch
+
+try:
+    from hip import hiprtc
+
+    is_hiprtc_available = True
+except ImportError:
+    is_hiprtc_available = False
+
+
+def _check(result):
+    """Unpack a hip-python hipRTC call and raise on error."""
+    err, *values = result
+    if err != hiprtc.hiprtcResult.HIPRTC_SUCCESS:
+        raise RuntimeError(f"hipRTC error: {err}")
+    if not values:
+        return None
+    return values[0] if len(values) == 1 else tuple(values)
+
+
+def get_include_options() -> list[str]:
+    """Include paths and macros hipRTC needs to compile TileLang kernels."""
+    rocm_path = find_rocm_path()
+    return [
+        f"-I{os.path.join(rocm_path, 'include')}",
+        "-D__HIP_PLATFORM_AMD__",
+    ]
+
+
+def compile_hip(code: str, arch: str | None = None, options: list[str] | None = None, verbose: bool = False) -> bytearray:
+    """Compile HIP code to a code object with hipRTC.
+
+    Parameters
+    ----------
+    code : str
+        The HIP code.
+
+    arch : str, optional
+        The AMD GPU architecture, such as gfx942. Defaults to the one of the
+        installed device.
+
+    options : list of str, optional
+        The additional options.
+
+    verbose : bool
+        Whether to print the compile log.
+
+    Return
+    ------
+    hsaco : bytearray
+        The bytearray of the code object.
+    """
+    if not is_hiprtc_available:
+        raise RuntimeError("hipRTC requires hip-python, install it via `pip install hip-python`.")
+    if arch is None:
+        arch = get_rocm_arch(find_rocm_path())
+
+    final_options = ["-O3", f"--offload-arch={arch}"]
+    if options:
+        final_options += options
+    final_options = [opt.encode() for opt in final_options]
+
+    prog = _check(hiprtc.hiprtcCreateProgram(code.encode(), b"tvm_kernels.cc", 0, [], []))
+    try:
+        (err,) = hiprtc.hiprtcCompileProgram(prog, len(final_options), final_options)
+        log_size = _check(hiprtc.hiprtcGetProgramLogSize(prog))
+        log = ""
+        if log_size > 1:
+            buf = bytearray(log_size)
+            _check(hiprtc.hiprtcGetProgramLog(prog, buf))
+            log = buf.decode(errors="replace").rstrip("\0")
+        if err != hiprtc.hiprtcResult.HIPRTC_SUCCESS:
+            raise RuntimeError(f"{code}\nCompilation error:\n{log}")
+        if verbose and log:
+            print(log)
+
+        code_size = _check(hiprtc.hiprtcGetCodeSize(prog))
+        hsaco = bytearray(code_size)
+        _check(hiprtc.hiprtcGetCode(prog, hsaco))
+    finally:
+        hiprtc.hiprtcDestroyProgram(prog.createRef())
+    if not hsaco:
+        raise RuntimeError("Compilation error: empty result is generated")
+    return hsaco
@@ -1,6 +1,9 @@
 from __future__ import annotations
+import hashlib
+import os
+import platform
 import cuda.bindings.nvrtc as nvrtc
-from typing import Literal
+from typing import Literal, Sequence
 from tvm.target import Target
 from .nvcc import get_target_compute_version, parse_compute_version
 
@@ -11,12 +14,76 @@ def get_nvrtc_version() -> tuple[int, int]:
     return (major, minor)
 
 
+def supports_pch() -> bool:
+    """Whether NVRTC can create and reuse precompiled headers automatically."""
+    return get_nvrtc_version() >= (12, 8)
+
+
+def get_pch_dir(key: Sequence[str] = ()) -> str:
+    """Directory of the persistent NVRTC precompiled header cache.
+
+    The precompiled headers are specific to the NVRTC version, so each version
+    keeps its own directory under the TileLang cache directory. ``key`` (e.g. the
+    target arch and the user compile flags, which change what the headers
+    expand to) selects a subdirectory of its own.
+    """
+    from tilelang.env import env
+
+    major, minor = get_nvrtc_version()
+    pch_dir = os.path.join(env.TILELANG_CACHE_DIR, "nvrtc_pch", f"{major}.{minor}")
+    if key:
+        pch_dir = os.path.join(pch_dir, hashlib.sha256("\0".join(key).encode()).hexdigest()[:16])
+    return pch_dir
+
+
+def get_include_options() -> list[str]:
+    """Include paths and macros NVRTC needs to compile TileLang kernels."""
+    import cuda.bindings.driver as cuda
+    from tilelang.env import CUDA_HOME, CUTLASS_INCLUDE_DIR, TILELANG_TEMPLATE_PATH
+
+    project_root = os.path.join(os.path.dirname(__file__), "..")
+    if CUTLASS_INCLUDE_DIR is None:
+        cutlass_path = os.path.abspath(os.path.join(project_root, "3rdparty/cutlass/include"))
+    else:
+        cutlass_path = CUTLASS_INCLUDE_DIR
+
+    if TILELANG_TEMPLATE_PATH is None:
+        tl_template_path = os.path.abspath(os.path.join(project_root, "src"))
+    else:
+        tl_template_path = TILELANG_TEMPLATE_PATH
+
+    cuda_home = CUDA_HOME if CUDA_HOME else "/usr/local/cuda"
+    __CUDACC_VER_MAJOR__ = cuda.CUDA_VERSION // 1000
+
+    # ARM64 servers (SBSA) have different header paths than x86_64.
+    machine = platform.machine()
+    target_arch = "sbsa-linux" if machine in ("aarch64", "arm64") else "x86_64-linux"
+
+    options = [
+        f"-I{tl_template_path}",
+        f"-I{cutlass_path}",
+        f"-I{cuda_home}/include",
+        f"-I{cuda_home}/targets/{target_arch}/include",
+        f"-I{cuda_home}/targets/{target_arch}/include/cccl",
+        f"-D__CUDACC_VER_MAJOR__={__CUDACC_VER_MAJOR__}",
+    ]
+
+    # Add CUDA C++ standard library include path.
+    # CUDA 13+ uses the CCCL-based cuda::std layout, while older versions use the legacy path.
+    if __CUDACC_VER_MAJOR__ >= 13:
+        options += [f"-I{cuda_home}/targets/{target_arch}/include/cccl/cuda/std"]
+    else:
+        options += [f"-I{cuda_home}/targets/{target_arch}/include/cuda/std"]
+    return options
+
+
 def compile_cuda(
     code: str,
     target_format: Literal["ptx", "cubin"] = "ptx",
     arch: int | None = None,
     options: str | list[str] | None = None,
     verbose: bool = False,
+    pch_dir: str | None = None,
 ) -> bytearray:
     """Compile cuda code with NVRTC.
 
@@ -37,6 +104,11 @@ def compile_cuda(
     verbose : bool
         Whether to print the verbose output.
 
+    pch_dir : Optional[str]
+        Directory where the precompiled header of the include prefix of `code`
+        (nvrtc_std.h and tl_templates) is stored and reused across processes.
+        Without it the precompiled header only lives as long as the process.
+
     Return
     ------
     result_bytes : bytearray
@@ -56,8 +128,11 @@ def compile_cuda(
         raise ValueError("target_format must be cubin or ptx")
 
     final_options = ["-default-device"]
-    if get_nvrtc_version() >= (12, 8):
+    if supports_pch():
         final_options += ["-pch"]
+        if pch_dir:
+            os.makedirs(pch_dir, exist_ok=True)
+            final_options += [f"--pch-dir={pch_dir}"]
     if arch is not None:
         final_options += [arch_option]
 
@@ -1,5 +1,7 @@
 from .lower import lower, is_device_call  # noqa: F401
 from .param import KernelParam  # noqa: F401
+from .resource import analyze_resources, KernelResourceInfo  # noqa: F401
+from .traffic import analyze_traffic, KernelTrafficReport, OperandTraffic  # noqa: F401
 from .callback import (
     register_cuda_postproc,  # noqa: F401
     register_hip_postproc,  # noqa: F401
@@ -0,0 +1,281 @@
+"""Compile time telemetry of the TileLang lowering pipeline.
+
+A ``CompileProfile`` records where the compile time of a kernel goes: the wall
+time of every pass run by the lowering pipeline together with the IR size before
+and after it, the wall time of the coarse stages (lowering phases, codegen, the
+device compiler) with the per phase breakdown reported by ``nvcc --time``, the
+loops unrolled and how many times, and whether the kernel came from the kernel
+cache.
+
+Profiling is enabled per kernel with the ``tl.enable_compile_profile`` pass
+config or globally with ``TILELANG_COMPILE_PROFILE=1``. The profile is attached to
+the kernel as ``JITKernel.compile_profile``; when ``TILELANG_COMPILE_PROFILE_DIR``
+is set each profile is also written there as JSON.
+"""
+
+from __future__ import annotations
+
+import contextlib
+import csv
+import json
+import os
+import threading
+import time
+from dataclasses import asdict, dataclass, field
+from typing import Any
+
+from tilelang import env
+from tilelang import tvm as tvm
+from tilelang.transform import PassConfigKey
+
+_ACTIVE = threading.local()
+
+
+@dataclass
+class PassRecord:
+    """Wall time of one pass and the IR size (in TIR nodes) around it."""
+
+    name: str
+    depth: int
+    time_ms: float
+    ir_nodes_before: int
+    ir_nodes_after: int
+
+
+@dataclass
+class DeviceCompileRecord:
+    """One invocation of the device compiler."""
+
+    tool: str
+    time_ms: float
+    # Per phase wall time (cicc, ptxas, fatbinary, ...) reported by the compiler.
+    phases: dict[str, float] = field(default_factory=dict)
+    # Innermost stage the compiler ran in, None outside of every stage (e.g.
+    # the build of the host library by the adapter).
+    stage: str | None = None
+
+
+@dataclass
+class UnrollRecord:
+    """A loop UnrollLoop unrolled ``factor`` times, ``extent`` when completely."""
+
+    loop: str
+    extent: int
+    factor: int
+    # Estimated instructions of one copy of the body.
+    body_instructions: int
+
+
+@dataclass
+class CompileProfile:
+    """Structured compile time profile of a kernel, see the module docstring."""
+
+    kernel_name: str = ""
+    target: str = ""
+    # "miss", "disk_hit", or None when the kernel cache was bypassed.
+    cache: str | None = None
+    total_ms: float = 0.0
+    stages: dict[str, float] = field(default_factory=dict)
+    passes: list[PassRecord] = field(default_factory=list)
+    device_compile: list[DeviceCompileRecord] = field(default_factory=list)
+    unroll: list[UnrollRecord] = field(default_factory=list)
+
+    def __post_init__(self):
+        self._open_stages: list[str] = []
+
+    def to_dict(self) -> dict[str, Any]:
+        return asdict(self)
+
+    def to_json(self, indent: int | None = 2) -> str:
+        return json.dumps(self.to_dict(), indent=indent)
+
+    def save(self, path: str) -> None:
+        with open(path, "w") as f:
+            f.write(self.to_json())
+
+    def summary(self, top: int = 10) -> str:
+        """Human readable summary: the stages and the ``top`` slowest leaf passes."""
+        lines = [f"Compile profile of `{self.kernel_name}` ({self.target}): {self.total_ms:.1f} ms, cache={self.cache}"]
+        for name, ms in self.stages.items():
+            lines.append(f"  {name:<32} {ms:10.2f} ms")
+        leaves = [p for i, p in enumerate(self.passes) if i + 1 == len(self.passes) or self.passes[i + 1].depth <= p.depth]
+        if leaves:
+            lines.append("  slowest passes (ms, IR nodes before -> after):")
+            for p in sorted(leaves, key=lambda p: p.time_ms, reverse=True)[:top]:
+                lines.append(f"    {p.name:<40} {p.time_ms:10.2f}   {p.ir_nodes_before} -> {p.ir_nodes_after}")
+        partial = [u for u in self.unroll if u.factor < u.extent]
+        if self.unroll:
+            lines.append(f"  unrolled loops: {len(self.unroll)}, {len(partial)} partially over the code size budget")
+        for u in partial:
+            lines.append(f"    {u.loop:<40} unroll {u.factor} of {u.extent} ({u.body_instructions} instructions per copy)")
+        for record in self.device_compile:
+            phases = ", ".join(f"{name}={ms:.1f}" for name, ms in record.phases.items())
+            lines.append(f"  {record.tool}: {record.time_ms:.1f} ms" + (f" ({phases})" if phases else ""))
+        return "\n".join(lines)
+
+    @contextlib.contextmanager
+    def activate(self):
+        """Makes this profile the target of ``profile_stage`` and the device compile hooks."""
+        stack = _active_stack()
+        stack.append(self)
+        try:
+            yield self
+        finally:
+            stack.pop()
+
+    @contextlib.contextmanager
+    def stage(self, name: str):
+        start = time.perf_counter()
+        self._open_stages.append(name)
+        try:
+            yield
+        finally:
+            self._open_stages.pop()
+            self.stages[name] = self.stages.get(name, 0.0) + (time.perf_counter() - start) * 1e3
+
+    def instrument(self):
+        """A PassInstrument recording every pass run under the PassContext."""
+        return _PassProfileInstrument(self)
+
+    def dump_if_requested(self) -> None:
+        out_dir = env.TILELANG_COMPILE_PROFILE_DIR
+        if not out_dir:
+            return
+        os.makedirs(out_dir, exist_ok=True)
+        name = f"{self.kernel_name or 'kernel'}_{os.getpid()}_{time.time_ns()}.json"
+        self.save(os.path.join(out_dir, name))
+
+
+def _active_stack() -> list[CompileProfile]:
+    if not hasattr(_ACTIVE, "stack"):
+        _ACTIVE.stack = []
+    return _ACTIVE.stack
+
+
+def current_compile_profile() -> CompileProfile | None:
+    """The profile being recorded by the calling thread, if any."""
+    stack = _active_stack()
+    return stack[-1] if stack else None
+
+
+@contextlib.contextmanager
+def profile_stage(name: str):
+    """Accounts the enclosed block to stage ``name`` of the active profile, if any."""
+    profile = current_compile_profile()
+    if profile is None:
+        yield
+        return
+    with profile.stage(name):
+        yield
+
+
+def is_compile_profile_enabled(pass_configs: dict[str, Any] | None = None) -> bool:
+    if (pass_configs or {}).get(PassConfigKey.TL_ENABLE_COMPILE_PROFILE, False):
+        return True
+    return env.is_compile_profile_enabled()
+
+
+def count_ir_nodes(mod: tvm.IRModule) -> int:
+    """Number of TIR statement and expression nodes of the PrimFuncs of ``mod``."""
+    count = 0
+
+    def visit(_):
+        nonlocal count
+        count += 1
+
+    for func in mod.functions.values():
+        if isinstance(func, tvm.tir.PrimFunc):
+            tvm.tir.stmt_functor.post_order_visit(func.body, visit)
+    return count
+
+
+@tvm.ir.instrument.pass_instrument
+class _PassProfileInstrument:
+    # The IR is measured outside of the timed interval of the pass itself, so
+    # only the enclosing (Sequential) passes include the measuring overhead.
+
+    def __init__(self, profile: CompileProfile):
+        self.profile = profile
+        self.stack = []
+
+    def run_before_pass(self, mod, info):
+        # Records are kept in execution order, enclosing passes first.
+        record = PassRecord(name=info.name, depth=len(self.stack), time_ms=0.0, ir_nodes_before=count_ir_nodes(mod), ir_nodes_after=0)
+        self.profile.passes.append(record)
+        self.stack.append((record, time.perf_counter()))
+
+    def run_after_pass(self, mod, info):
+        end = time.perf_counter()
+        record, start = self.stack.pop()
+        record.time_ms = (end - start) * 1e3
+        record.ir_nodes_after = count_ir_nodes(mod)
+
+
+def record_unroll_decisions(mod: tvm.IRModule) -> None:
+    """Adds the unroll decisions attached by UnrollLoop to the active profile, if any."""
+    profile = current_compile_profile()
+    if profile is None:
+        return
+    for func in mod.functions.values():
+        if not isinstance(func, tvm.tir.PrimFunc) or func.attrs is None:
+            continue
+        for decision in func.attrs.get("tl.unroll_decisions", []):
+            profile.unroll.append(
+                UnrollRecord(
+                    loop=str(decision["loop"]),
+                    extent=int(decision["extent"]),
+                    factor=int(decision["factor"]),
+                    body_instructions=int(decision["body_instructions"]),
+                )
+            )
+
+
+def add_nvcc_time_option(options: list[str]) -> str | None:
+    """Requests the ``nvcc --time`` phase table when a profile is active.
+
+    Returns the path of the table to pass to ``record_device_compile``.
+    """
+    if current_compile_profile() is None:
+        return None
+    import tempfile
+
+    fd, path = tempfile.mkstemp(suffix=".csv", prefix="tilelang_nvcc_time_")
+    os.close(fd)
+    options += ["--time", path]
+    return path
+
+
+def _parse_nvcc_time(path: str) -> dict[str, float]:
+    # nvcc appends a "source file name, phase name, arch, tool, metric, unit"
+    # table to the file; the layout is not a stable interface, so be lenient.
+    phases: dict[str, float] = {}
+    try:
+        with open(path) as f:
+            rows = [[c.strip() for c in row] for row in csv.reader(f) if row]
+    except OSError:
+        return phases
+    finally:
+        with contextlib.suppress(OSError):
+            os.remove(path)
+    if not rows:
+        return phases
+    header = [c.lower() for c in rows[0]]
+    if "phase name" not in header or "metric" not in header:
+        return phases
+    phase_col, metric_col = header.index("phase name"), header.index("metric")
+    for row in rows[1:]:
+        if len(row) <= max(phase_col, metric_col):
+            continue
+        with contextlib.suppress(ValueError):
+            phases[row[phase_col]] = phases.get(row[phase_col], 0.0) + float(row[metric_col])
+    return phases
+
+
+def record_device_compile(tool: str, time_ms: float, time_table: str | None = None) -> None:
+    """Adds a device compiler invocation to the active profile, if any."""
+    profile = current_compile_profile()
+    if profile is None:
+        return
+    phases = _parse_nvcc_time(time_table) if time_table else {}
+    stage = profile._open_stages[-1] if profile._open_stages else None
+    profile.device_compile.append(DeviceCompileRecord(tool=tool, time_ms=time_ms, phases=phases, stage=stage))
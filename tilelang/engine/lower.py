@@ -3,7 +3,15 @@
 from __future__ import annotations
 
 from typing import Callable
+import concurrent.futures
+import contextlib
+import functools
+import hashlib
+import logging
+import os
 import sys
+import threading
+import time
 import tilelang.transform
 from tilelang import tvm as tvm
 from tvm import tir
@@ -14,13 +22,23 @@ from tilelang.contrib import hipcc, nvcc
 from tilelang.env import COMPOSABLE_KERNEL_INCLUDE_DIR, CUTLASS_INCLUDE_DIR, TILELANG_TEMPLATE_PATH
 from tilelang.transform import PassConfigKey
 from tilelang.transform.metal import MarkHostMetalContext
-from tilelang.engine.param import KernelParam, CompiledArtifact
+from tilelang.engine.param import KernelParam, CompiledArtifact, analyze_param_aliasing
+from tilelang.engine.compile_profile import (
+    add_nvcc_time_option,
+    current_compile_profile,
+    profile_stage,
+    record_device_compile,
+    record_unroll_decisions,
+)
 from tilelang.utils.target import determine_target
 from tilelang.engine.phase import (
     PreLowerSemanticCheck,
     LowerAndLegalize,
     OptimizeForTarget,
 )
+from tilelang.engine.phase_cache import LOWER_AND_LEGALIZE, OPTIMIZE_FOR_TARGET, PhaseCache, get_phase_cache
+
+logger = logging.getLogger(__name__)
 
 
 def is_cpu_device_backend(target: Target):
@@ -68,7 +86,8 @@ def tilelang_callback_cuda_compile(code, target, pass_config=None):
     enable_fast_math = bool(cfg.get(PassConfigKey.TL_ENABLE_FAST_MATH, False))
 
     ptxas_usage_level = cfg.get(PassConfigKey.TL_PTXAS_REGISTER_USAGE_LEVEL, None)
-    verbose_ptxas_output = bool(cfg.get(PassConfigKey.TL_ENABLE_PTXAS_VERBOSE_OUTPUT, False))
+    fast_compile = bool(cfg.get(PassConfigKey.TL_FAST_COMPILE, False))
+    verbose_ptxas_output = bool(cfg.get(PassConfigKey.TL_ENABLE_PTXAS_VERBOSE_OUTPUT, False)) and not fast_compile
 
     options = [
         "-std=c++17",
@@ -96,43 +115,194 @@ def tilelang_callback_cuda_compile(code, target, pass_config=None):
         options.append("--use_fast_math")
     if ptxas_usage_level is not None:
         options.append(f"--ptxas-options=--register-usage-level={ptxas_usage_level}")
+    if fast_compile:
+        # A cubin has no host code, ptxas is where the time goes
+        options.append("--ptxas-options=-O1")
     if verbose_ptxas_output:
         options.append("--ptxas-options=--verbose")
         options.append("-w")  # Suppress warnings to make ptxas output more readable
         verbose = True
 
-    ptx = nvcc.compile_cuda(
-        code,
-        compile_format,
-        arch,
-        options=options,
-        verbose=verbose,
-    )
+    # Verbose ptxas output is wanted on every compile, so it bypasses the cache.
+    cache_path = None if verbose else _device_binary_cache_path(code, target_arch, options)
+    if cache_path is not None and os.path.exists(cache_path):
+        with open(cache_path, "rb") as f:
+            cubin = f.read()
+        # Refresh the last use the disk cache budget evicts by
+        with contextlib.suppress(OSError):
+            os.utime(cache_path)
+        return cubin
+
+    cubin = None
+    if cfg.get(PassConfigKey.TL_ENABLE_DEVICE_COMPILE_PCH, False):
+        start = time.perf_counter()
+        cubin = _compile_cuda_with_pch(code, target_arch, options, verbose)
+        if cubin is not None:
+            record_device_compile("nvrtc", (time.perf_counter() - start) * 1e3)
+
+    if cubin is None:
+        time_table = add_nvcc_time_option(options)
+        start = time.perf_counter()
+        cubin = nvcc.compile_cuda(
+            code,
+            compile_format,
+            arch,
+            options=options,
+            verbose=verbose,
+        )
+        record_device_compile("nvcc", (time.perf_counter() - start) * 1e3, time_table)
+
+    if cache_path is not None:
+        _store_device_binary(cache_path, cubin)
+    return cubin
+
+
+def _device_binary_cache_path(
+    code: str, target_arch: str, options: list[str], toolkit_version: str | None = None, suffix: str = ".cubin"
+) -> str | None:
+    """Path of the cached cubin of ``code``, None when the kernel cache is disabled.
+
+    Kernels whose lowering yields the same device source, such as autotuning
+    candidates that only differ on the host side or compiles that only differ in
+    host-only pass configs, share one device compile. The key covers everything
+    that affects the binary: the source, arch, options, CUDA (``toolkit_version``
+    for the other toolkits) and TileLang versions (the latter covering the bundled
+    tl_templates).
+    """
+    from tilelang import __version__
+    from tilelang.env import env
 
-    return ptx
+    if not env.is_cache_enabled():
+        return None
+    if toolkit_version is None:
+        toolkit_version = str(_cuda_version())
+    key = "\0".join([__version__, toolkit_version, target_arch, *options, code])
+    return os.path.join(env.TILELANG_CACHE_DIR, "device_binary", hashlib.sha256(key.encode()).hexdigest() + suffix)
 
 
-@tvm_ffi.register_global_func("tilelang_callback_hip_compile", override=True)
-def tilelang_callback_hip_compile(code, target):
-    hsaco = hipcc.compile_hip(
-        code,
-        target_format="hsaco",
-        options=[
-            "-std=c++17",
-            "-I" + TILELANG_TEMPLATE_PATH,
-            "-I" + COMPOSABLE_KERNEL_INCLUDE_DIR,
-        ],
-        verbose=False,
-    )
+@functools.lru_cache(maxsize=None)
+def _cuda_version() -> tuple[int, ...]:
+    return nvcc.get_cuda_version()
+
+
+@functools.lru_cache(maxsize=None)
+def _rocm_version() -> str:
+    from tilelang.contrib.rocm import find_rocm_path
+
+    try:
+        with open(os.path.join(find_rocm_path(), ".info", "version")) as f:
+            return "rocm-" + f.read().strip()
+    except (OSError, RuntimeError):
+        return "rocm-unknown"
+
+
+def _store_device_binary(path: str, binary: bytes) -> None:
+    # Atomic replace, so concurrent compiles never read a partial binary.
+    try:
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        temp_path = f"{path}.{os.getpid()}.{threading.get_ident()}.tmp"
+        with open(temp_path, "wb") as f:
+            f.write(binary)
+        os.replace(temp_path, path)
+    except OSError as e:
+        logger.warning(f"Failed to cache the device binary at {path}: {e}")
+
+
+def _compile_cuda_with_pch(code: str, target_arch: str, options: list[str], verbose: bool) -> bytes | None:
+    """Compiles ``code`` to a cubin with NVRTC, reusing precompiled headers.
+
+    nvcc re-parses tl_templates and CUTLASS/CuTe for every kernel, while NVRTC
+    keeps them precompiled in a persistent cache keyed on the arch and the
+    compile options. Returns None when NVRTC (or its PCH support) is missing or
+    rejects the kernel, so that the caller falls back to nvcc.
+    """
+    from tilelang.jit.adapter.nvrtc import is_nvrtc_available
+
+    if not is_nvrtc_available:
+        return None
+    from tilelang.contrib import nvrtc as nvrtc_compiler
+
+    if not nvrtc_compiler.supports_pch():
+        return None
+    options = nvrtc_compiler.get_include_options() + options
+    try:
+        return nvrtc_compiler.compile_cuda(
+            code,
+            target_format="cubin",
+            arch=int(target_arch.rstrip("a")),
+            options=options,
+            verbose=verbose,
+            pch_dir=nvrtc_compiler.get_pch_dir([target_arch, *options]),
+        )
+    except RuntimeError as e:
+        logger.warning(f"NVRTC failed to compile the kernel, falling back to nvcc: {e}")
+        return None
 
+
+@tvm_ffi.register_global_func("tilelang_callback_hip_compile", override=True)
+def tilelang_callback_hip_compile(code, target, pass_config=None):
+    cfg = pass_config or {}
+    options = [
+        "-std=c++17",
+        "-I" + TILELANG_TEMPLATE_PATH,
+        "-I" + COMPOSABLE_KERNEL_INCLUDE_DIR,
+    ]
+    mcpu = target.attrs.get("mcpu") if target is not None else None
+    arch = str(mcpu) if mcpu else None
+
+    cache_path = _device_binary_cache_path(code, arch or "", options, toolkit_version=_rocm_version(), suffix=".hsaco")
+    if cache_path is not None and os.path.exists(cache_path):
+        with open(cache_path, "rb") as f:
+            hsaco = f.read()
+        with contextlib.suppress(OSError):
+            os.utime(cache_path)
+        return hsaco
+
+    hsaco = None
+    if cfg.get(PassConfigKey.TL_ENABLE_DEVICE_COMPILE_PCH, False):
+        start = time.perf_counter()
+        hsaco = _compile_hip_in_memory(code, arch, options)
+        if hsaco is not None:
+            record_device_compile("hiprtc", (time.perf_counter() - start) * 1e3)
+
+    if hsaco is None:
+        start = time.perf_counter()
+        hsaco = hipcc.compile_hip(code, target_format="hsaco", arch=arch, options=options, verbose=False)
+        record_device_compile("hipcc", (time.perf_counter() - start) * 1e3)
+
+    if cache_path is not None:
+        _store_device_binary(cache_path, hsaco)
     return hsaco
 
 
+def _compile_hip_in_memory(code: str, arch: str | None, options: list[str]) -> bytes | None:
+    """Compiles ``code`` to a code object with hipRTC, without temporary files.
+
+    Returns None when hipRTC is missing or rejects the kernel, so that the
+    caller falls back to hipcc.
+    """
+    from tilelang.contrib import hiprtc
+
+    if not hiprtc.is_hiprtc_available:
+        return None
+    try:
+        return hiprtc.compile_hip(code, arch=arch, options=hiprtc.get_include_options() + options)
+    except RuntimeError as e:
+        logger.warning(f"hipRTC failed to compile the kernel, falling back to hipcc: {e}")
+        return None
+
+
 def extrac_params(func: tir.PrimFunc) -> list[KernelParam]:
     tensor_types = []
+    workspaces = func.attrs.get("tl.workspace_params", {}) if func.attrs else {}
+    workspaces = {str(k): bool(v) for k, v in workspaces.items()}
     for var in func.params:
         if var in func.buffer_map:
-            tensor_types.append(KernelParam.from_buffer(func.buffer_map[var]))
+            buffer = func.buffer_map[var]
+            param = KernelParam.from_buffer(buffer)
+            if buffer.name in workspaces:
+                param.workspace, param.zero_init = True, workspaces[buffer.name]
+            tensor_types.append(param)
         else:
             if var.dtype == "handle":
                 raise ValueError(
@@ -143,6 +313,16 @@ def extrac_params(func: tir.PrimFunc) -> list[KernelParam]:
     return tensor_types
 
 
+def annotate_param_aliasing(params: list[KernelParam] | None, func: tir.PrimFunc, device_mod: tvm.IRModule):
+    """Record on ``params`` which buffers the kernels of ``device_mod`` declare restrict and write."""
+    if params is None:
+        return
+    restrict, written = analyze_param_aliasing(func, device_mod)
+    for i, param in enumerate(params):
+        param.restrict = i in restrict
+        param.written = i in written
+
+
 def canon_target_host(target: str | Target, target_host: str | Target | None):
     if not target_host:
         target_host = "llvm" if tvm.runtime.enabled("llvm") else "c"
@@ -175,8 +355,10 @@ def device_codegen(device_mod: tvm.IRModule, target: Target) -> tvm.IRModule:
     device_mod = tilelang.transform.LowerIntrin()(device_mod)
     device_mod = tir.transform.Simplify()(device_mod)
     device_mod = tilelang.transform.HoistBroadcastValues()(device_mod)
+    device_mod = tilelang.transform.ReduceIndexStrength()(device_mod)
 
     if target.kind.name == "cuda":
+        device_mod = tilelang.transform.ResolveMinBlocksPerSM(target)(device_mod)
         global_func = "target.build.tilelang_" + ("cutedsl" if "cutedsl" in target.keys else "cuda")
         device_mod = tvm.ffi.get_global_func(global_func)(device_mod, target)
     elif target.kind.name == "hip":
@@ -194,8 +376,10 @@ def device_codegen_without_compile(device_mod: tvm.IRModule, target: Target) ->
     device_mod = tilelang.transform.LowerIntrin()(device_mod)
     device_mod = tir.transform.Simplify()(device_mod)
     device_mod = tilelang.transform.HoistBroadcastValues()(device_mod)
+    device_mod = tilelang.transform.ReduceIndexStrength()(device_mod)
 
     if target.kind.name == "cuda":
+        device_mod = tilelang.transform.ResolveMinBlocksPerSM(target)(device_mod)
         global_func = "target.build.tilelang_" + ("cutedsl" if "cutedsl" in target.keys else "cuda") + "_without_compile"
         device_mod = tvm.ffi.get_global_func(global_func)(device_mod, target)
     elif target.kind.name == "hip":
@@ -247,23 +431,135 @@ def lower(
     _is_host_call = get_host_call(is_device_c=is_cpu_device_backend(target))
     _is_device_call = get_device_call(is_device_c=is_cpu_device_backend(target))
 
-    # Before lowering, do semantic check
-    PreLowerSemanticCheck(mod)
+    workers = _parallel_lower_workers(mod)
+    if workers > 1:
+        return _lower_parallel(mod, target, target_host, params, workers, enable_host_codegen, enable_device_compile)
 
-    # Phase 1: Lower and legalize the IR
-    mod = LowerAndLegalize(mod, target)
+    # Before lowering, do semantic check
+    with profile_stage("semantic_check"):
+        PreLowerSemanticCheck(mod)
 
-    # Phase 2: Optimize the IR for the target
-    mod = OptimizeForTarget(mod, target)
+    mod = _run_phases(mod, target)
+    record_unroll_decisions(mod)
 
     host_mod = tir.transform.Filter(_is_host_call)(mod)
     device_mod = tir.transform.Filter(_is_device_call)(mod)
+    if isinstance(func_or_mod, tir.PrimFunc):
+        annotate_param_aliasing(params, func_or_mod, device_mod)
 
-    codegen_mod = device_codegen(device_mod, target) if enable_device_compile else device_codegen_without_compile(device_mod, target)
+    with profile_stage("device_codegen"):
+        codegen_mod = device_codegen(device_mod, target) if enable_device_compile else device_codegen_without_compile(device_mod, target)
 
     if enable_host_codegen:
-        host_mod = host_codegen(host_mod, target_host)
+        with profile_stage("host_codegen"):
+            host_mod = host_codegen(host_mod, target_host)
         host_mod.import_module(codegen_mod)
         return CompiledArtifact(host_mod, device_mod, params, codegen_mod.inspect_source(), rt_mod=host_mod)
 
     return CompiledArtifact(host_mod, device_mod, params, codegen_mod.inspect_source())
+
+
+def _run_phases(mod: tvm.IRModule, target: Target) -> tvm.IRModule:
+    """Runs ``LowerAndLegalize`` and ``OptimizeForTarget``, resuming from the latest valid checkpoint."""
+    cache = get_phase_cache() if PhaseCache.enabled() else None
+    if cache is not None:
+        optimized_key = cache.key(OPTIMIZE_FOR_TARGET, mod, target)
+        optimized = cache.get(optimized_key, mod)
+        if optimized is not None:
+            return optimized
+        legalized_key = cache.key(LOWER_AND_LEGALIZE, mod, target)
+        legalized = cache.get(legalized_key, mod)
+    else:
+        legalized = None
+
+    # Phase 1: Lower and legalize the IR
+    if legalized is None:
+        with profile_stage("lower_and_legalize"):
+            legalized = LowerAndLegalize(mod, target)
+        if cache is not None:
+            cache.put(legalized_key, mod, legalized)
+
+    # Phase 2: Optimize the IR for the target
+    with profile_stage("optimize_for_target"):
+        optimized = OptimizeForTarget(legalized, target)
+    if cache is not None:
+        cache.put(optimized_key, mod, optimized)
+    return optimized
+
+
+def _parallel_lower_workers(mod: tvm.IRModule) -> int:
+    """Number of threads to lower ``mod`` with, 1 when it must be lowered serially."""
+    pass_ctx = tvm.transform.PassContext.current()
+    workers = int(pass_ctx.config.get(PassConfigKey.TL_PARALLEL_LOWER_WORKERS, 0))
+    if workers < 0:
+        workers = os.cpu_count() or 1
+    funcs = list(mod.functions.values())
+    if workers <= 1 or len(funcs) <= 1:
+        return 1
+    # Pass instruments and the compile profile are not made for concurrent passes.
+    if pass_ctx.instruments or current_compile_profile() is not None:
+        return 1
+    if not all(isinstance(func, tir.PrimFunc) for func in funcs) or _has_global_calls(funcs):
+        return 1
+    return min(workers, len(funcs))
+
+
+def _has_global_calls(funcs: list[tir.PrimFunc]) -> bool:
+    found = False
+
+    def visit(node):
+        nonlocal found
+        if isinstance(node, tir.Call) and isinstance(node.op, tvm.ir.GlobalVar):
+            found = True
+
+    for func in funcs:
+        tvm.tir.stmt_functor.post_order_visit(func.body, visit)
+    return found
+
+
+def _lower_parallel(
+    mod: tvm.IRModule,
+    target: Target,
+    target_host: Target,
+    params: list[KernelParam] | None,
+    workers: int,
+    enable_host_codegen: bool,
+    enable_device_compile: bool,
+) -> CompiledArtifact:
+    """Lowers the PrimFuncs of ``mod``, which do not call each other, in a thread pool.
+
+    Each PrimFunc goes through the whole pipeline and device codegen (and thus
+    its own NVCC invocation) as a module of its own; the results are merged.
+    """
+    _is_host_call = get_host_call(is_device_c=is_cpu_device_backend(target))
+    _is_device_call = get_device_call(is_device_c=is_cpu_device_backend(target))
+    # The PassContext is thread local, so each worker enters the caller's one.
+    pass_ctx = tvm.transform.PassContext.current()
+
+    def lower_one(gvar: tvm.ir.GlobalVar, func: tir.PrimFunc):
+        with pass_ctx:
+            sub_mod = tvm.IRModule({gvar: func}, attrs=mod.attrs)
+            PreLowerSemanticCheck(sub_mod)
+            sub_mod = _run_phases(sub_mod, target)
+            host_mod = tir.transform.Filter(_is_host_call)(sub_mod)
+            device_mod = tir.transform.Filter(_is_device_call)(sub_mod)
+            codegen = device_codegen if enable_device_compile else device_codegen_without_compile
+            return host_mod, device_mod, codegen(device_mod, target)
+
+    with concurrent.futures.ThreadPoolExecutor(workers, "tl-lower") as executor:
+        results = list(executor.map(lambda item: lower_one(*item), mod.functions.items()))
+
+    host_mod = tvm.IRModule(attrs=results[0][0].attrs)
+    device_mod = tvm.IRModule(attrs=results[0][1].attrs)
+    for sub_host, sub_device, _ in results:
+        host_mod.update(sub_host)
+        device_mod.update(sub_device)
+    kernel_source = "\n".join(codegen_mod.inspect_source() for _, _, codegen_mod in results)
+
+    if enable_host_codegen:
+        host_mod = host_codegen(host_mod, target_host)
+        for _, _, codegen_mod in results:
+            host_mod.import_module(codegen_mod)
+        return CompiledArtifact(host_mod, device_mod, params, kernel_source, rt_mod=host_mod)
+
+    return CompiledArtifact(host_mod, device_mod, params, kernel_source)
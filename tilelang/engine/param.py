@@ -22,6 +22,12 @@ class KernelParam:
     # This avoids information loss when converting from TVM buffer types
     dtype: tvm.DataType  # Data type from buffer.dtype (supports all TVM types)
     shape: list[int | Var]  # List of dimensions, can be integers or TVM variables
+    # Set after lowering, see analyze_param_aliasing
+    restrict: bool = False  # The kernels assume the buffer does not alias the other restrict buffers
+    written: bool = False  # Some kernel writes the buffer
+    # A T.Workspace parameter, served by the adapter instead of the caller
+    workspace: bool = False
+    zero_init: bool = False  # The workspace is zeroed before every call
 
     @classmethod
     def from_buffer(cls, buffer: Buffer):
@@ -150,6 +156,45 @@ class KernelParam:
         return T.dtype(self.dtype)
 
 
+def analyze_param_aliasing(func: tvm.tir.PrimFunc, device_mod: tvm.IRModule) -> tuple[set[int], set[int]]:
+    """Find the buffer parameters of ``func`` its kernels assume do not alias.
+
+    Device codegen declares the pointer parameters of a kernel ``__restrict__``,
+    unless they are listed by ``T.annotate_restrict_buffers`` or the kernel uses
+    PDL, and ``const`` when AnnotateReadOnlyParams found no write to them, so
+    their loads take the read-only non-coherent path.
+
+    Returns:
+        tuple[set[int], set[int]]: Indices in ``func.params`` of the buffers
+        declared ``__restrict__`` by every kernel using them, and of the buffers
+        that some kernel writes
+    """
+    index = {func.buffer_map[p].data.name: i for i, p in enumerate(func.params) if p in func.buffer_map}
+    restrict, aliasing, written = set(), set(), set()
+    for _, kernel in device_mod.functions.items():
+        attrs = kernel.attrs
+        no_alias = "tir.noalias" in attrs and bool(attrs["tir.noalias"]) and "has_cuda_pdl_sync" not in attrs
+        non_restrict = list(attrs["tl.non_restrict_params"]) if "tl.non_restrict_params" in attrs else []
+        readonly = {int(i) for i in attrs["tl.readonly_param_indices"]} if "tl.readonly_param_indices" in attrs else set()
+        for i, param in enumerate(kernel.params):
+            if param.name not in index:
+                continue
+            j = index[param.name]
+            if no_alias and not any(param.same_as(v) for v in non_restrict):
+                restrict.add(j)
+            else:
+                aliasing.add(j)
+            if i not in readonly:
+                written.add(j)
+    return restrict - aliasing, written
+
+
+def alias_check_pairs(restrict: set[int], written: set[int]) -> list[tuple[int, int]]:
+    """Pairs of restrict buffers, one of them written, that must not overlap at runtime."""
+    order = sorted(restrict)
+    return [(i, j) for i in order for j in order if i < j and (i in written or j in written)]
+
+
 @dataclass
 class CompiledArtifact:
     """
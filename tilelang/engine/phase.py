@@ -45,10 +45,19 @@ def allow_global_thread_synchronization(pass_ctx: PassContext | None = None) ->
     return enable_global_thread_sync
 
 
+def should_fast_compile(pass_ctx: PassContext | None = None) -> bool:
+    if pass_ctx is None:
+        pass_ctx = tilelang.transform.get_pass_context()
+    return bool(pass_ctx and pass_ctx.config.get(tilelang.PassConfigKey.TL_FAST_COMPILE, False))
+
+
 def should_enable_aggressive_merge(pass_ctx: PassContext | None = None, target: Target | None = None) -> bool:
     if pass_ctx is None:
         pass_ctx = tilelang.transform.get_pass_context()
     enable_aggressive_merge = bool(pass_ctx.config.get(tilelang.PassConfigKey.TL_ENABLE_AGGRESSIVE_SHARED_MEMORY_MERGE, False))
+    if should_fast_compile(pass_ctx):
+        # Only saves shared memory, the kernels screened are compared without it
+        enable_aggressive_merge = False
     if allow_warp_specialized(pass_ctx=pass_ctx, target=target):
         # This is a workaround to avoid the bug in the MergeSharedMemoryAllocations pass
         # when warp specialization is enabled, as different warp threads may access different
@@ -134,27 +143,20 @@ def PreLowerSemanticCheck(mod: IRModule) -> None:
     tilelang.analysis.FragmentLoopChecker()(mod)
 
 
-def LowerAndLegalize(mod: IRModule, target: Target) -> IRModule:
-    # Bind the target device information to the module
+def LegalizeTileOps(mod: IRModule, target: Target) -> IRModule:
     """
-    Bind target information and progressively legalize and lower frontend Tile IR into a form suitable for downstream optimization and codegen.
+    Bind the target and legalize frontend Tile IR up to layout inference.
 
-    This pass pipeline:
-    - Binds the provided target to the module.
-    - Legalizes frontend Tile IR into TVM-compatible constructs.
-    - Simplifies expressions.
-    - Configures reducer layouts and performs layout inference for fragments and shared memory.
-    - Lowers high-level tile operations and L2 persistent maps.
-    - Legalizes vectorized loops and inserts safety checks for memory accesses.
-    - Re-simplifies to remove redundancies introduced by safety checks.
-    - Attempts loop vectorization for dynamic-shaped loops.
+    The tile operators are still intact afterwards, with the layouts of their
+    fragments and shared buffers inferred, which is the level static analyses
+    such as ``tilelang.engine.traffic`` read.
 
     Parameters:
         mod (IRModule): The input IR module containing frontend Tile IR.
         target (Target): Target device information to bind into the module.
 
     Returns:
-        IRModule: The transformed module, ready for target-specific optimization passes.
+        IRModule: The legalized module, ready for ``LowerTileOp``.
     """
     mod = tir.transform.BindTarget(target)(mod)
 
@@ -172,14 +174,52 @@ def LowerAndLegalize(mod: IRModule, target: Target) -> IRModule:
     mod = tilelang.transform.InjectAssumes()(mod)
     # Simplify the IR expressions
     mod = tilelang.transform.Simplify()(mod)
+    # Drop the copies that reload a tile already held, hoist loop invariant ones
+    mod = tilelang.transform.EliminateRedundantCopies()(mod)
+    # Drop the stores nothing reads, let the first gemm clear its accumulator
+    mod = tilelang.transform.EliminateDeadFragmentStores()(mod)
+    # Reduce the same fragment along the same dimension in a single pass
+    mod = tilelang.transform.FuseSiblingReductions()(mod)
+    # Run chained elementwise loops over one tile as one loop
+    mod = tilelang.transform.FuseSiblingParallelLoops()(mod)
+    # Issue the small copies into adjacent shared regions as one TMA load
+    mod = tilelang.transform.CoalesceTmaCopies()(mod)
     # Set layouts for reducers
     mod = tilelang.transform.LayoutReducer()(mod)
     # Infer memory layouts for fragments and shared memory
     mod = tilelang.transform.LayoutInference()(mod)
+    return mod
+
+
+def LowerAndLegalize(mod: IRModule, target: Target) -> IRModule:
+    # Bind the target device information to the module
+    """
+    Bind target information and progressively legalize and lower frontend Tile IR into a form suitable for downstream optimization and codegen.
+
+    This pass pipeline:
+    - Binds the provided target to the module.
+    - Legalizes frontend Tile IR into TVM-compatible constructs.
+    - Simplifies expressions.
+    - Configures reducer layouts and performs layout inference for fragments and shared memory.
+    - Lowers high-level tile operations and L2 persistent maps.
+    - Legalizes vectorized loops and inserts safety checks for memory accesses.
+    - Re-simplifies to remove redundancies introduced by safety checks.
+    - Attempts loop vectorization for dynamic-shaped loops.
+
+    Parameters:
+        mod (IRModule): The input IR module containing frontend Tile IR.
+        target (Target): Target device information to bind into the module.
+
+    Returns:
+        IRModule: The transformed module, ready for target-specific optimization passes.
+    """
+    mod = LegalizeTileOps(mod, target)
     # Visualize the layout
     LayoutVisual(mod)
     # Lower high-level tile operations to low-level operations
     mod = tilelang.transform.LowerTileOp()(mod)
+    # Keep the shared buffers each thread only touches its own slice of in registers
+    mod = tilelang.transform.DemoteThreadPrivateShared()(mod)
     # Lower l2 persistent map
     mod = tilelang.transform.LowerL2Persistent()(mod)
     # Decouple type cast vectorization constraints before vectorization
@@ -188,6 +228,10 @@ def LowerAndLegalize(mod: IRModule, target: Target) -> IRModule:
     mod = tilelang.transform.LegalizeVectorizedLoop()(mod)
     # Add safety checks for memory accesses
     mod = tilelang.transform.LegalizeSafeMemoryAccess()(mod)
+    # Run the loop nests of interior tiles without these checks, which
+    # duplicates them and is left out of fast compiles
+    if not should_fast_compile():
+        mod = tilelang.transform.LoopUnswitching()(mod)
     # Simplify again to clean up any duplicated conditions
     # that may have been introduced by safety checks
     # use an enhanced pass to simplify the dynamic symbolics
@@ -201,6 +245,8 @@ def LowerAndLegalize(mod: IRModule, target: Target) -> IRModule:
 
 def OptimizeForTarget(mod: IRModule, target: Target) -> IRModule:
     pass_ctx = tilelang.transform.get_pass_context()
+    # Resolve automatic pipeline depths before buffers get multi-versioned
+    mod = tilelang.transform.PipelineStageSelection()(mod)
     # Lower the barrier.arrive into specific initialization slot
     mod = tilelang.transform.LowerSharedBarrier()(mod)
     # Lower the shared.tmem into specific initialization slot
@@ -218,6 +264,9 @@ def OptimizeForTarget(mod: IRModule, target: Target) -> IRModule:
         # warp_specialized pass will pack the if stmt into the block
         # so we need to lower the opaque block first
         mod = tilelang.transform.LowerOpaqueBlock()(mod)
+        # Order the consumer warpgroups of T.annotate_pingpong kernels in
+        # their final, pipelined statements
+        mod = tilelang.transform.ScheduleWarpGroupPingPong()(mod)
         if is_hopper(target):
             mod = tilelang.transform.RewriteWgmmaSync()(mod)
     else:
@@ -228,6 +277,10 @@ def OptimizeForTarget(mod: IRModule, target: Target) -> IRModule:
 
     mod = tilelang.transform.LowerOpaqueBlock()(mod)
     mod = tilelang.transform.Simplify()(mod)
+    if is_hopper(target):
+        # Overlap the asynchronous gemms with the independent statements
+        # that follow them in the final, pipelined loop bodies
+        mod = tilelang.transform.DeferWgmmaWait()(mod)
     mod = tir.transform.NarrowDataType(32)(mod)
     mod = tilelang.transform.FlattenBuffer()(mod)
     # ConfigIndexBitwidth must be applied after FlattenBuffer
@@ -235,10 +288,18 @@ def OptimizeForTarget(mod: IRModule, target: Target) -> IRModule:
     mod = tilelang.transform.ConfigIndexBitwidth()(mod)
     mod = tir.transform.Simplify()(mod)
     mod = tilelang.transform.VectorizeLoop(enable_vectorize=allow_vectorize(pass_ctx=pass_ctx))(mod)
+    # After vectorization, so that vectorized calls on halves use packed ops
+    mod = tilelang.transform.LowerFastMath()(mod)
+    # Combine the atomics of the lanes of a warp that update the same address
+    mod = tilelang.transform.AggregateAtomics()(mod)
     mod = tilelang.transform.StorageRewrite()(mod)
+    # Estimate register pressure, rematerializing cheap values over the budget
+    mod = tilelang.transform.PredictRegisterPressure()(mod)
     mod = tilelang.transform.UnrollLoop()(mod)
-    mod = tir.transform.RenormalizeSplitPattern()(mod)
-    mod = tir.transform.Simplify()(mod)
+    if not should_fast_compile(pass_ctx):
+        # Final index cleanups, mostly redone by the device compiler
+        mod = tir.transform.RenormalizeSplitPattern()(mod)
+        mod = tir.transform.Simplify()(mod)
     mod = tir.transform.RemoveNoOp()(mod)
     mod = tir.transform.HoistIfThenElse()(mod)
 
@@ -264,7 +325,9 @@ def OptimizeForTarget(mod: IRModule, target: Target) -> IRModule:
     mod = tilelang.transform.AnnotateDeviceRegions()(mod)
     mod = tilelang.transform.SplitHostDevice()(mod)
 
-    # Mark the function contains pdl_sync or pdl_trigger
+    # Optionally chain multi-kernel functions with PDL, then mark the
+    # functions that contain pdl_sync or pdl_trigger
+    mod = tilelang.transform.ChainCudaKernelLaunches(have_pdl(target))(mod)
     mod = tilelang.transform.MarkCudaSyncCalls(have_pdl(target))(mod)
 
     mod = tilelang.transform.AnnotateReadOnlyParams()(mod)
@@ -281,6 +344,8 @@ def OptimizeForTarget(mod: IRModule, target: Target) -> IRModule:
             mod = tilelang.transform.InjectFenceProxy()(mod)
     mod = tilelang.transform.ThreadSync("shared")(mod)
     mod = tilelang.transform.ThreadSync("shared.dyn")(mod)
+    # Drop the syncs that order no conflicting shared memory accesses
+    mod = tilelang.transform.EliminateStorageSyncForMBarrier()(mod)
     mod = tilelang.transform.MergeIfStmt()(mod)
     # Inject PTX async copy must behind the thread sync pass
     # as ptx async copy won't be recognized as a valid buffer load
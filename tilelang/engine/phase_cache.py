@@ -0,0 +1,134 @@
+"""In-memory checkpoints of the lowering pipeline between its phases.
+
+Compiling the same program again with different device compiler flags, such
+as an autotuning sweep over ``tl.device_compile_flags`` or
+``tl.ptxas_register_usage_level``, would otherwise re-run every pass from the
+front end. ``lower`` stores the module after ``LowerAndLegalize`` and after
+``OptimizeForTarget``, keyed by the structural hash of the input module, the
+target and the pass configs the phase reads, and resumes from the latest
+checkpoint still valid for the current configs:
+
+- configs only read by codegen and the device compiler leave both checkpoints
+  valid, so only device codegen runs again;
+- configs only read by ``OptimizeForTarget`` leave the ``LowerAndLegalize``
+  one valid.
+
+The cache is bypassed when the kernel cache is disabled, with
+``tl.disable_phase_cache``, and while passes are instrumented or profiled, since
+a checkpoint skips them.
+"""
+
+from __future__ import annotations
+
+import threading
+from collections import OrderedDict
+
+from tilelang import env
+from tilelang import tvm as tvm
+from tilelang.engine.compile_profile import current_compile_profile
+from tilelang.transform import PassConfigKey
+
+LOWER_AND_LEGALIZE = "lower_and_legalize"
+OPTIMIZE_FOR_TARGET = "optimize_for_target"
+
+# Configs no pass reads, only codegen and the device compiler
+_CODEGEN_CONFIGS = frozenset(
+    {
+        PassConfigKey.TL_DEVICE_COMPILE_FLAGS,
+        PassConfigKey.TL_PTXAS_REGISTER_USAGE_LEVEL,
+        PassConfigKey.TL_ENABLE_PTXAS_VERBOSE_OUTPUT,
+        PassConfigKey.TL_ENABLE_FAST_MATH,
+        PassConfigKey.TL_ENABLE_DEVICE_COMPILE_PCH,
+        PassConfigKey.TL_ENABLE_PROFILE_REGION,
+        PassConfigKey.TL_ENABLE_DEVICE_LOG,
+        PassConfigKey.TL_DEVICE_ASSERT_MODE,
+        PassConfigKey.TL_PARALLEL_LOWER_WORKERS,
+        PassConfigKey.TL_DISABLE_PHASE_CACHE,
+    }
+)
+
+# Configs only the passes of OptimizeForTarget read
+_OPTIMIZE_CONFIGS = frozenset(
+    {
+        PassConfigKey.TL_DISABLE_WARP_SPECIALIZED,
+        PassConfigKey.TL_REGISTER_BUDGET,
+        PassConfigKey.TL_DISABLE_REMATERIALIZATION,
+        PassConfigKey.TL_CONFIG_INDEX_BITWIDTH,
+        PassConfigKey.TL_DISABLE_ATOMIC_AGGREGATION,
+        PassConfigKey.TL_ENABLE_AGGRESSIVE_SHARED_MEMORY_MERGE,
+        PassConfigKey.TL_ENABLE_OPTIMAL_SHARED_MEMORY_PACKING,
+        PassConfigKey.TL_DEBUG_MERGE_SHARED_MEMORY_ALLOCATIONS,
+        PassConfigKey.TL_DISABLE_THREAD_STORAGE_SYNC,
+    }
+)
+
+_IGNORED_CONFIGS = {
+    LOWER_AND_LEGALIZE: _CODEGEN_CONFIGS | _OPTIMIZE_CONFIGS,
+    OPTIMIZE_FOR_TARGET: _CODEGEN_CONFIGS,
+}
+
+# Configs whose passes have side effects a checkpoint would skip
+_SIDE_EFFECT_CONFIGS = (PassConfigKey.TL_LAYOUT_VISUALIZATION_ENABLE,)
+
+
+class PhaseCache:
+    """A bounded LRU map from a phase and its inputs to the module it produced."""
+
+    def __init__(self, capacity: int = 128):
+        self.capacity = capacity
+        self._entries: OrderedDict[tuple, tuple[tvm.IRModule, tvm.IRModule]] = OrderedDict()
+        self._lock = threading.Lock()
+
+    @staticmethod
+    def enabled(pass_ctx: tvm.transform.PassContext | None = None) -> bool:
+        if pass_ctx is None:
+            pass_ctx = tvm.transform.PassContext.current()
+        if not env.is_cache_enabled() or pass_ctx.config.get(PassConfigKey.TL_DISABLE_PHASE_CACHE, False):
+            return False
+        if pass_ctx.instruments or current_compile_profile() is not None:
+            return False
+        return not any(pass_ctx.config.get(key, False) for key in _SIDE_EFFECT_CONFIGS)
+
+    @staticmethod
+    def key(phase: str, mod: tvm.IRModule, target, pass_ctx: tvm.transform.PassContext | None = None) -> tuple:
+        if pass_ctx is None:
+            pass_ctx = tvm.transform.PassContext.current()
+        ignored = _IGNORED_CONFIGS[phase]
+        configs = tuple(sorted((str(k), str(v)) for k, v in pass_ctx.config.items() if str(k) not in ignored))
+        return phase, tvm.ir.structural_hash(mod), str(target), pass_ctx.opt_level, configs
+
+    def get(self, key: tuple, mod: tvm.IRModule) -> tvm.IRModule | None:
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is None:
+                return None
+            self._entries.move_to_end(key)
+        source, result = entry
+        # Guard against hash collisions
+        return result if tvm.ir.structural_equal(source, mod) else None
+
+    def put(self, key: tuple, mod: tvm.IRModule, result: tvm.IRModule) -> None:
+        with self._lock:
+            self._entries[key] = (mod, result)
+            self._entries.move_to_end(key)
+            while len(self._entries) > self.capacity:
+                self._entries.popitem(last=False)
+
+    def clear(self) -> None:
+        with self._lock:
+            self._entries.clear()
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+
+_phase_cache = PhaseCache()
+
+
+def get_phase_cache() -> PhaseCache:
+    return _phase_cache
+
+
+def clear_phase_cache() -> None:
+    """Drops every checkpoint, e.g. after changing a pass outside of the pass configs."""
+    _phase_cache.clear()
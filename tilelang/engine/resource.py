@@ -0,0 +1,276 @@
+"""Static resource analysis of lowered kernels.
+
+``analyze_resources`` runs the TileLang lowering pipeline up to the device
+module, without generating or compiling device code, and reports per kernel
+the shared memory footprint, an estimate of the registers used per thread and
+the resulting occupancy. It is meant to discard infeasible configurations
+(e.g. during auto-tuning) before paying for an ``nvcc`` invocation.
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+
+from tilelang import tvm as tvm
+from tvm import tir
+from tvm.target import Target
+
+from tilelang.engine.lower import canon_target_host, get_device_call, is_cpu_device_backend
+from tilelang.engine.phase import LowerAndLegalize, OptimizeForTarget, PreLowerSemanticCheck
+from tilelang.utils.target import determine_target
+
+# Registers reserved for addressing, loop counters and predicates on top of
+# the per-thread local buffers.
+_BASE_REGISTERS = 32
+_MAX_REGISTERS_PER_THREAD = 255
+_MAX_THREADS_PER_BLOCK = 1024
+# Fewest registers per thread the automatic launch bounds may leave to ptxas.
+_MIN_AUTO_REGISTERS = 64
+# Shared memory the CUDA runtime reserves for every resident block (sm_80+).
+_RESERVED_SMEM_PER_BLOCK = 1024
+
+
+@dataclass(frozen=True)
+class SMLimits:
+    """Per-SM resource limits of a CUDA architecture."""
+
+    smem_per_sm: int
+    smem_per_block: int
+    max_threads_per_sm: int
+    max_blocks_per_sm: int
+    registers_per_sm: int = 65536
+
+
+# Keyed by compute capability, see the CUDA C++ programming guide.
+_SM_LIMITS = {
+    (7, 0): SMLimits(96 * 1024, 96 * 1024, 2048, 32),
+    (7, 5): SMLimits(64 * 1024, 64 * 1024, 1024, 16),
+    (8, 0): SMLimits(164 * 1024, 163 * 1024, 2048, 32),
+    (8, 6): SMLimits(100 * 1024, 99 * 1024, 1536, 16),
+    (8, 7): SMLimits(164 * 1024, 163 * 1024, 2048, 32),
+    (8, 9): SMLimits(100 * 1024, 99 * 1024, 1536, 24),
+    (9, 0): SMLimits(228 * 1024, 227 * 1024, 2048, 32),
+    (10, 0): SMLimits(228 * 1024, 227 * 1024, 2048, 32),
+    (12, 0): SMLimits(100 * 1024, 99 * 1024, 1536, 32),
+}
+
+
+def get_sm_limits(target: Target) -> SMLimits | None:
+    """Return the SM limits of a CUDA target, None for other targets."""
+    if target.kind.name != "cuda" or "arch" not in target.attrs:
+        return None
+    arch = str(target.attrs["arch"]).replace("sm_", "").rstrip("af")
+    major, minor = int(arch[:-1]), int(arch[-1])
+    candidates = [cc for cc in _SM_LIMITS if cc <= (major, minor)]
+    return _SM_LIMITS[max(candidates)] if candidates else None
+
+
+@dataclass
+class KernelResourceInfo:
+    """Resource usage of one device kernel.
+
+    Attributes:
+        name: Global symbol of the device kernel.
+        threads_per_block: Product of the ``threadIdx`` extents.
+        static_smem_bytes: Bytes of ``shared`` allocations.
+        dynamic_smem_bytes: Bytes of ``shared.dyn`` allocations.
+        local_bytes_per_thread: Bytes of per-thread ``local`` allocations,
+            including lowered fragments.
+        registers_per_thread: Estimated registers per thread.
+        blocks_per_sm: Resident blocks per SM, None if the target limits are
+            unknown.
+        occupancy: Resident threads over the SM thread capacity, or None.
+        limits: SM limits used for the occupancy computation.
+        grid_blocks: Product of the ``blockIdx`` extents, None when one of
+            them is dynamic.
+    """
+
+    name: str
+    threads_per_block: int
+    static_smem_bytes: int
+    dynamic_smem_bytes: int
+    local_bytes_per_thread: int
+    registers_per_thread: int
+    blocks_per_sm: int | None = None
+    occupancy: float | None = None
+    limits: SMLimits | None = None
+    grid_blocks: int | None = None
+
+    @property
+    def smem_bytes(self) -> int:
+        return self.static_smem_bytes + self.dynamic_smem_bytes
+
+    @property
+    def spills(self) -> bool:
+        """Whether the register estimate exceeds the per-thread limit."""
+        return self.registers_per_thread > _MAX_REGISTERS_PER_THREAD
+
+    @property
+    def feasible(self) -> bool:
+        """Whether the kernel can be launched and is not expected to spill."""
+        if self.threads_per_block > _MAX_THREADS_PER_BLOCK or self.spills:
+            return False
+        if self.limits is not None and self.smem_bytes > self.limits.smem_per_block:
+            return False
+        return self.blocks_per_sm is None or self.blocks_per_sm > 0
+
+
+def _allocation_bytes(op: tir.Allocate) -> int | None:
+    num_elements = 1
+    for extent in op.extents:
+        if not isinstance(extent, tir.IntImm):
+            return None
+        num_elements *= extent.value
+    dtype = tvm.DataType(op.dtype)
+    return num_elements * ((dtype.bits * dtype.lanes + 7) // 8)
+
+
+def _analyze_kernel(name: str, func: tir.PrimFunc, limits: SMLimits | None) -> KernelResourceInfo:
+    thread_extents: dict[str, int] = {}
+    block_extents: dict[str, int | None] = {}
+    smem = {"shared": 0, "shared.dyn": 0}
+    local_bytes = 0
+
+    def fvisit(node):
+        nonlocal local_bytes
+        if isinstance(node, tir.AttrStmt) and node.attr_key == "thread_extent":
+            tag = node.node.thread_tag
+            if tag.startswith("threadIdx") and isinstance(node.value, tir.IntImm):
+                thread_extents[tag] = max(thread_extents.get(tag, 1), node.value.value)
+            elif tag.startswith("blockIdx"):
+                block_extents[tag] = node.value.value if isinstance(node.value, tir.IntImm) else None
+        elif isinstance(node, tir.Allocate):
+            scope = node.buffer_var.type_annotation.storage_scope
+            num_bytes = _allocation_bytes(node)
+            if num_bytes is None:
+                return
+            if scope in smem:
+                smem[scope] += num_bytes
+            elif scope.startswith("local"):
+                local_bytes += num_bytes
+
+    tir.stmt_functor.post_order_visit(func.body, fvisit)
+
+    threads = 1
+    for extent in thread_extents.values():
+        threads *= extent
+    registers = _BASE_REGISTERS + (local_bytes + 3) // 4
+    grid_blocks = 1
+    for extent in block_extents.values():
+        grid_blocks = None if grid_blocks is None or extent is None else grid_blocks * extent
+    info = KernelResourceInfo(
+        name=name,
+        threads_per_block=threads,
+        static_smem_bytes=smem["shared"],
+        dynamic_smem_bytes=smem["shared.dyn"],
+        local_bytes_per_thread=local_bytes,
+        registers_per_thread=registers,
+        limits=limits,
+        grid_blocks=grid_blocks,
+    )
+    if limits is not None:
+        # Registers are allocated per warp in units of 256.
+        warps = (threads + 31) // 32
+        regs_per_warp = (min(registers, _MAX_REGISTERS_PER_THREAD) * 32 + 255) // 256 * 256
+        blocks = min(
+            limits.max_blocks_per_sm,
+            limits.max_threads_per_sm // max(threads, 1),
+            limits.registers_per_sm // max(regs_per_warp * warps, 1),
+        )
+        if info.smem_bytes > 0:
+            blocks = min(blocks, limits.smem_per_sm // info.smem_bytes)
+        info.blocks_per_sm = blocks
+        info.occupancy = blocks * threads / limits.max_threads_per_sm
+    return info
+
+
+def auto_min_blocks_per_sm(func: tir.PrimFunc, target: Target) -> int:
+    """Pick the ``minBlocksPerSM`` of the launch bounds of a device kernel.
+
+    Targets the residency allowed by the shared memory plan and the thread
+    count, lowered until the register budget it implies, ``65536 / (blocks *
+    threads)``, covers the register estimate of the kernel and at least
+    `_MIN_AUTO_REGISTERS`. Returns 1, the default of the code generator, when
+    the limits of the target are unknown.
+    """
+    limits = get_sm_limits(target)
+    if limits is None:
+        return 1
+    info = _analyze_kernel("", func, limits)
+    threads = max(info.threads_per_block, 1)
+    blocks = min(limits.max_blocks_per_sm, limits.max_threads_per_sm // threads)
+    if info.smem_bytes > 0:
+        blocks = min(blocks, limits.smem_per_sm // info.smem_bytes)
+    # Registers are allocated per warp, round the threads up to whole warps.
+    threads = (threads + 31) // 32 * 32
+    registers = max(info.registers_per_thread, _MIN_AUTO_REGISTERS)
+    while blocks > 1 and limits.registers_per_sm // (blocks * threads) < registers:
+        blocks -= 1
+    return max(blocks, 1)
+
+
+def preferred_smem_carveout(func: tir.PrimFunc, target: Target, dynamic_smem_bytes: int = 0) -> int | None:
+    """Pick the shared memory carveout of a device kernel, in percent.
+
+    The carveout is the share of the unified L1/shared memory of an SM set
+    aside as shared memory. The smallest carveout holding every block the
+    kernel can keep resident leaves the rest to L1; a kernel without shared
+    memory gets the whole L1. Returns None when the limits of the target are
+    unknown.
+    """
+    limits = get_sm_limits(target)
+    if limits is None:
+        return None
+    info = _analyze_kernel("", func, limits)
+    smem_bytes = max(info.smem_bytes, dynamic_smem_bytes)
+    if smem_bytes == 0:
+        return 0
+    blocks = min(limits.max_blocks_per_sm, limits.smem_per_sm // (smem_bytes + _RESERVED_SMEM_PER_BLOCK))
+    if info.blocks_per_sm is not None:
+        blocks = min(blocks, info.blocks_per_sm)
+    needed = max(blocks, 1) * (smem_bytes + _RESERVED_SMEM_PER_BLOCK)
+    return min(100, -(-100 * needed // limits.smem_per_sm))
+
+
+def analyze_resources(
+    func_or_mod: tir.PrimFunc | tvm.IRModule,
+    target: str | Target = "auto",
+    target_host: str | Target | None = None,
+) -> list[KernelResourceInfo]:
+    """Lower a program and report the resources used by its device kernels.
+
+    Runs the same passes as :func:`tilelang.lower` under the current
+    ``PassContext`` but stops before device code generation, so no external
+    compiler is invoked.
+
+    Parameters
+    ----------
+    func_or_mod : PrimFunc or IRModule
+        The TileLang program to analyze.
+    target : str or Target
+        Compilation target, "auto" by default.
+    target_host : str or Target, optional
+        Host target.
+
+    Returns
+    -------
+    list[KernelResourceInfo]
+        One entry per device kernel.
+    """
+    mod = func_or_mod
+    if isinstance(func_or_mod, tir.PrimFunc):
+        mod = tvm.IRModule({func_or_mod.attrs["global_symbol"]: func_or_mod})
+
+    if isinstance(target, str):
+        target = determine_target(target)
+    target_host = tvm.target.Target.canon_target(canon_target_host(target, target_host))
+    target = tvm.target.Target(target, target_host)
+
+    PreLowerSemanticCheck(mod)
+    with target:
+        mod = LowerAndLegalize(mod, target)
+        mod = OptimizeForTarget(mod, target)
+    device_mod = tir.transform.Filter(get_device_call(is_device_c=is_cpu_device_backend(target)))(mod)
+
+    limits = get_sm_limits(target)
+    return [_analyze_kernel(str(gvar.name_hint), func, limits) for gvar, func in device_mod.functions.items() if isinstance(func, tir.PrimFunc)]
@@ -0,0 +1,369 @@
+"""Static roofline and memory traffic analysis of kernels.
+
+``analyze_traffic`` legalizes a program up to layout inference, where the tile
+operators are still intact, and walks their kernels counting per thread block
+the matmul and elementwise flops, the global bytes read and written per
+operand and the shared memory bytes moved. Loop trip counts multiply the
+counts of their bodies, so a copy hoisted out of a loop by
+``EliminateRedundantCopies`` is counted once. Against the peaks of a
+``TileDevice`` the report predicts whether the kernel is compute or memory
+bound, which lets the autotuner and kernel reviews sanity check a
+configuration before benchmarking it.
+
+Data dependent trip counts (e.g. causal loops) and dynamic shapes are bounded
+from above with the integer bounds of the surrounding loop and block
+variables; ``exact`` tells whether every count was static.
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass, field
+
+from tilelang import tvm as tvm
+from tvm import arith, tir
+from tvm.ir import Range
+from tvm.target import Target
+
+from tilelang.engine.lower import canon_target_host
+from tilelang.engine.phase import LegalizeTileOps, PreLowerSemanticCheck
+from tilelang.utils.target import determine_target
+
+_ACCESS_READ = 1
+_ACCESS_WRITE = 2
+# Bounds past this many iterations are taken as unbounded.
+_MAX_BOUND = 1 << 40
+
+
+@dataclass
+class OperandTraffic:
+    """Global memory traffic of one kernel operand, summed over the grid.
+
+    Attributes:
+        name: Name of the global buffer.
+        dtype: Element type of the buffer.
+        bytes_read: Bytes loaded by all thread blocks.
+        bytes_written: Bytes stored by all thread blocks.
+        footprint_bytes: Size of the buffer, the traffic with perfect reuse
+            across thread blocks in L2.
+    """
+
+    name: str
+    dtype: str
+    bytes_read: int = 0
+    bytes_written: int = 0
+    footprint_bytes: int = 0
+
+    @property
+    def reuse(self) -> float:
+        """How many times every byte of the operand is moved on average."""
+        moved = self.bytes_read + self.bytes_written
+        return moved / self.footprint_bytes if self.footprint_bytes else 0.0
+
+
+@dataclass
+class KernelTrafficReport:
+    """Static flop and byte counts of one kernel and its predicted bound.
+
+    Attributes:
+        name: Global symbol of the kernel.
+        grid_blocks: Product of the ``blockIdx`` extents.
+        flops: Matmul flops (``2 * M * N * K`` per gemm) plus the floating
+            point operations of elementwise loops and reductions.
+        mma_flops: The matmul part of ``flops``.
+        operands: Global traffic per buffer.
+        shared_bytes: Shared memory bytes read and written by tile operators
+            and elementwise loops.
+        exact: Whether every trip count and extent was static.
+        peak_flops: Peak tensor throughput of the architecture, if known.
+        peak_bandwidth: Peak DRAM bandwidth of the architecture, if known.
+    """
+
+    name: str
+    grid_blocks: int
+    flops: int
+    mma_flops: int
+    operands: dict[str, OperandTraffic] = field(default_factory=dict)
+    shared_bytes: int = 0
+    exact: bool = True
+    peak_flops: float | None = None
+    peak_bandwidth: float | None = None
+
+    @property
+    def global_bytes_read(self) -> int:
+        return sum(op.bytes_read for op in self.operands.values())
+
+    @property
+    def global_bytes_written(self) -> int:
+        return sum(op.bytes_written for op in self.operands.values())
+
+    @property
+    def global_bytes(self) -> int:
+        """Bytes requested from global memory by all thread blocks."""
+        return self.global_bytes_read + self.global_bytes_written
+
+    @property
+    def dram_bytes(self) -> int:
+        """Compulsory DRAM traffic: every operand moved at most once per direction."""
+        total = 0
+        for op in self.operands.values():
+            total += min(op.bytes_read, op.footprint_bytes) + min(op.bytes_written, op.footprint_bytes)
+        return total
+
+    @property
+    def arithmetic_intensity(self) -> float:
+        """Flops per byte of compulsory DRAM traffic."""
+        return self.flops / self.dram_bytes if self.dram_bytes else float("inf")
+
+    @property
+    def l2_arithmetic_intensity(self) -> float:
+        """Flops per byte requested from global memory, without reuse across blocks."""
+        return self.flops / self.global_bytes if self.global_bytes else float("inf")
+
+    @property
+    def ridge_point(self) -> float | None:
+        if not self.peak_flops or not self.peak_bandwidth:
+            return None
+        return self.peak_flops / self.peak_bandwidth
+
+    @property
+    def bound(self) -> str | None:
+        """Either "compute" or "memory", None when the peaks of the architecture are unknown."""
+        ridge = self.ridge_point
+        if ridge is None:
+            return None
+        return "memory" if self.arithmetic_intensity < ridge else "compute"
+
+    @property
+    def predicted_time_s(self) -> float | None:
+        """Roofline time of the kernel, the larger of its compute and DRAM time."""
+        if not self.peak_flops or not self.peak_bandwidth:
+            return None
+        return max(self.flops / self.peak_flops, self.dram_bytes / self.peak_bandwidth)
+
+    def summary(self) -> str:
+        lines = [
+            f"{self.name}: {self.grid_blocks} blocks, {self.flops / 1e9:.3f} GFLOP, "
+            f"{self.global_bytes / 1e6:.3f} MB global ({self.dram_bytes / 1e6:.3f} MB compulsory), "
+            f"{self.shared_bytes / 1e6:.3f} MB shared, intensity {self.arithmetic_intensity:.1f} FLOP/B"
+            + (f", {self.bound} bound" if self.bound else "")
+            + ("" if self.exact else " (upper bounds)")
+        ]
+        for op in self.operands.values():
+            lines.append(
+                f"  {op.name} ({op.dtype}): read {op.bytes_read / 1e6:.3f} MB, written {op.bytes_written / 1e6:.3f} MB, "
+                f"footprint {op.footprint_bytes / 1e6:.3f} MB, reuse {op.reuse:.1f}x"
+            )
+        return "\n".join(lines)
+
+
+def _elem_bytes(dtype) -> int:
+    dtype = tvm.DataType(str(dtype))
+    return (dtype.bits * dtype.lanes + 7) // 8
+
+
+def _is_op(node, prefix: str) -> bool:
+    return isinstance(node, tir.Call) and isinstance(node.op, tvm.ir.Op) and node.op.name.startswith(prefix)
+
+
+def _is_float(dtype) -> bool:
+    return str(dtype).startswith(("float", "bfloat"))
+
+
+class _TrafficCollector:
+    """Counts the flops and bytes of one kernel, per thread block."""
+
+    _ARITH = (tir.Add, tir.Sub, tir.Mul, tir.Div, tir.Min, tir.Max)
+
+    def __init__(self):
+        self.analyzer = arith.Analyzer()
+        self.grid_blocks = 1
+        self.flops = 0
+        self.mma_flops = 0
+        self.shared_bytes = 0
+        self.exact = True
+        self.operands: dict[tir.Var, list] = {}
+
+    def extent(self, expr: tir.PrimExpr) -> int:
+        if isinstance(expr, tir.IntImm):
+            return expr.value
+        self.exact = False
+        bound = self.analyzer.const_int_bound(expr)
+        if 0 <= bound.max_value < _MAX_BOUND:
+            return bound.max_value
+        return 1
+
+    def access(self, buffer: tir.Buffer, num_bytes: int, mask: int) -> None:
+        scope = buffer.scope()
+        if scope == "global":
+            entry = self.operands.setdefault(buffer.data, [buffer, 0, 0])
+            if mask & _ACCESS_READ:
+                entry[1] += num_bytes
+            if mask & _ACCESS_WRITE:
+                entry[2] += num_bytes
+        elif scope.startswith("shared"):
+            # A read-write access moves the bytes both ways
+            self.shared_bytes += num_bytes * (bool(mask & _ACCESS_READ) + bool(mask & _ACCESS_WRITE))
+
+    def expr(self, expr: tir.PrimExpr, trips: int) -> None:
+        def fvisit(node):
+            if isinstance(node, tir.BufferLoad):
+                self.access(node.buffer, _elem_bytes(node.dtype) * trips, _ACCESS_READ)
+            elif isinstance(node, self._ARITH) and _is_float(node.dtype):
+                self.flops += trips
+            elif _is_op(node, "tir.") and _is_float(node.dtype):
+                # Math intrinsics count as one operation
+                self.flops += trips
+
+        tir.stmt_functor.post_order_visit(expr, fvisit)
+
+    def region(self, call: tir.Call, trips: int) -> None:
+        load, mask = call.args[0], int(call.args[1])
+        elems = 1
+        for extent in call.args[2:]:
+            elems *= self.extent(extent)
+        self.access(load.buffer, elems * _elem_bytes(load.buffer.dtype) * trips, mask)
+
+    def tile_op(self, call: tir.Call, trips: int) -> None:
+        name = call.op.name
+        regions = [arg for arg in call.args if _is_op(arg, "tl.tileop.region")]
+        for region in regions:
+            self.region(region, trips)
+        if name.startswith("tl.tileop.gemm"):
+            M, N, K = (self.extent(call.args[i]) for i in (5, 6, 7))
+            self.mma_flops += 2 * M * N * K * trips
+            self.flops += 2 * M * N * K * trips
+        elif name == "tl.tileop.reduce" and regions:
+            elems = 1
+            for extent in regions[0].args[2:]:
+                elems *= self.extent(extent)
+            self.flops += elems * trips
+
+    def visit(self, stmt: tir.Stmt, trips: int) -> None:
+        if isinstance(stmt, tir.SeqStmt):
+            for s in stmt.seq:
+                self.visit(s, trips)
+        elif isinstance(stmt, tir.For):
+            extent = self.extent(stmt.extent)
+            self.analyzer.bind(stmt.loop_var, Range.from_min_extent(stmt.min, stmt.extent))
+            self.visit(stmt.body, trips * extent)
+        elif isinstance(stmt, tir.AttrStmt):
+            if stmt.attr_key == "thread_extent" and isinstance(stmt.node, tir.IterVar):
+                self.analyzer.bind(stmt.node.var, Range.from_min_extent(0, stmt.value))
+                if stmt.node.thread_tag.startswith("blockIdx"):
+                    self.grid_blocks *= self.extent(stmt.value)
+            self.visit(stmt.body, trips)
+        elif isinstance(stmt, tir.LetStmt):
+            self.analyzer.bind(stmt.var, stmt.value)
+            self.expr(stmt.value, trips)
+            self.visit(stmt.body, trips)
+        elif isinstance(stmt, tir.BlockRealize):
+            self.visit(stmt.block.body, trips)
+        elif isinstance(stmt, tir.Block):
+            self.visit(stmt.body, trips)
+        elif isinstance(stmt, tir.IfThenElse):
+            # Both branches are counted, as upper bounds
+            self.expr(stmt.condition, trips)
+            self.visit(stmt.then_case, trips)
+            if stmt.else_case is not None:
+                self.visit(stmt.else_case, trips)
+        elif isinstance(stmt, tir.While):
+            self.exact = False
+            self.visit(stmt.body, trips)
+        elif isinstance(stmt, tir.BufferStore):
+            self.access(stmt.buffer, _elem_bytes(stmt.value.dtype) * trips, _ACCESS_WRITE)
+            self.expr(stmt.value, trips)
+            for index in stmt.indices:
+                self.expr(index, trips)
+        elif isinstance(stmt, tir.Evaluate):
+            call = stmt.value
+            if _is_op(call, "tl.tileop."):
+                self.tile_op(call, trips)
+            else:
+                self.expr(call, trips)
+        elif isinstance(stmt, (tir.Allocate, tir.DeclBuffer, tir.AssertStmt, tir.AllocateConst)):
+            self.visit(stmt.body, trips)
+
+
+def _analyze_kernel(name: str, func: tir.PrimFunc, arch, dtype: str) -> KernelTrafficReport:
+    collector = _TrafficCollector()
+    collector.visit(func.body, 1)
+    grid = collector.grid_blocks
+    operands = {}
+    for buffer, read, written in collector.operands.values():
+        footprint = _elem_bytes(buffer.dtype)
+        for extent in buffer.shape:
+            footprint *= collector.extent(extent)
+        operands[buffer.name] = OperandTraffic(buffer.name, str(buffer.dtype), read * grid, written * grid, footprint)
+    return KernelTrafficReport(
+        name=name,
+        grid_blocks=grid,
+        flops=collector.flops * grid,
+        mma_flops=collector.mma_flops * grid,
+        operands=operands,
+        shared_bytes=collector.shared_bytes * grid,
+        exact=collector.exact,
+        peak_flops=arch.peak_tensor_flops(dtype) if arch is not None else None,
+        peak_bandwidth=arch.peak_memory_bandwidth() if arch is not None else None,
+    )
+
+
+def _mma_dtype(func: tir.PrimFunc) -> str:
+    """The input type of the first gemm of ``func``, selecting the tensor core peak."""
+    dtypes = []
+
+    def fvisit(node):
+        if not dtypes and _is_op(node, "tl.tileop.gemm"):
+            a = node.args[0]
+            if _is_op(a, "tl.tileop.region"):
+                dtypes.append(str(a.args[0].buffer.dtype))
+
+    tir.stmt_functor.post_order_visit(func.body, fvisit)
+    return dtypes[0] if dtypes else "float16"
+
+
+def analyze_traffic(
+    func_or_mod: tir.PrimFunc | tvm.IRModule,
+    target: str | Target = "auto",
+    target_host: str | Target | None = None,
+    arch=None,
+) -> list[KernelTrafficReport]:
+    """Report the static flops and memory traffic of the kernels of a program.
+
+    Runs the passes of :func:`tilelang.lower` up to layout inference under the
+    current ``PassContext``, so nothing is generated or compiled.
+
+    Parameters
+    ----------
+    func_or_mod : PrimFunc or IRModule
+        The TileLang program to analyze.
+    target : str or Target
+        Compilation target, "auto" by default.
+    target_host : str or Target, optional
+        Host target.
+    arch : TileDevice, optional
+        Architecture providing the peaks of the roofline, e.g.
+        ``tilelang.carver.arch.get_arch(target)``. Without it the report has
+        no predicted bound.
+
+    Returns
+    -------
+    list[KernelTrafficReport]
+        One entry per PrimFunc of the program.
+    """
+    mod = func_or_mod
+    if isinstance(func_or_mod, tir.PrimFunc):
+        mod = tvm.IRModule({func_or_mod.attrs["global_symbol"]: func_or_mod})
+
+    if isinstance(target, str):
+        target = determine_target(target)
+    target_host = tvm.target.Target.canon_target(canon_target_host(target, target_host))
+    target = tvm.target.Target(target, target_host)
+
+    PreLowerSemanticCheck(mod)
+    with target:
+        mod = LegalizeTileOps(mod, target)
+    return [
+        _analyze_kernel(str(gvar.name_hint), func, arch, _mma_dtype(func))
+        for gvar, func in mod.functions.items()
+        if isinstance(func, tir.PrimFunc)
+    ]
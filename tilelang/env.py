@@ -52,21 +52,26 @@ def _get_package_version(pkg: str) -> str | None:
         return None
 
 
-def _is_running_autodd() -> bool:
-    """Detect if we are running under `python -m tilelang.autodd`."""
+def _is_running_module(module: str) -> bool:
+    """Detect if we are running under `python -m <module>`."""
     orig_argv = getattr(sys, "orig_argv", None)
     if orig_argv is None:
         return False
-    if "-mtilelang.autodd" in orig_argv:
+    if f"-m{module}" in orig_argv:
         return True
     pos = orig_argv.index("-m") if "-m" in orig_argv else -1
     if pos != -1 and pos + 1 < len(orig_argv):
         module_name = orig_argv[pos + 1]
-        if module_name == "tilelang.autodd" or module_name.startswith("tilelang.autodd."):
+        if module_name == module or module_name.startswith(f"{module}."):
             return True
     return False
 
 
+def _is_running_autodd() -> bool:
+    """Detect if we are running under `python -m tilelang.autodd`."""
+    return _is_running_module("tilelang.autodd")
+
+
 def _find_cuda_home() -> str:
     """Find the CUDA install path.
 
@@ -261,6 +266,8 @@ class Environment:
     TILELANG_TEMPLATE_PATH = EnvVar("TL_TEMPLATE_PATH", None)
     TILELANG_CACHE_DIR = EnvVar("TILELANG_CACHE_DIR", os.path.expanduser("~/.tilelang/cache"))
     TILELANG_TMP_DIR = EnvVar("TILELANG_TMP_DIR", os.path.join(TILELANG_CACHE_DIR.get(), "tmp"))
+    # device profile of the carver calibration, looked up in TILELANG_CACHE_DIR when unset
+    TILELANG_DEVICE_PROFILE = EnvVar("TILELANG_DEVICE_PROFILE", None)
 
     # Kernel Build options
     TILELANG_PRINT_ON_COMPILATION = EnvVar("TILELANG_PRINT_ON_COMPILATION", "1")  # print kernel name on compile
@@ -268,6 +275,15 @@ class Environment:
         "TILELANG_DISABLE_CACHE", "0"
     )  # disable kernel cache, usually for unit testing / debugging, high priority
     TILELANG_CLEAR_CACHE = EnvVar("TILELANG_CLEAR_CACHE", "0")  # DEPRECATED! clear cache automatically if set
+    TILELANG_CACHE_INDEX = EnvVar("TILELANG_CACHE_INDEX", "1")  # serve cache lookups from the single-file index
+    TILELANG_CACHE_MAX_SIZE = EnvVar("TILELANG_CACHE_MAX_SIZE", "0")  # disk cache budget such as 20G, 0 means no limit
+    TILELANG_COMPILE_PROFILE = EnvVar("TILELANG_COMPILE_PROFILE", "0")  # record a compile profile of every kernel
+    TILELANG_COMPILE_PROFILE_DIR = EnvVar("TILELANG_COMPILE_PROFILE_DIR", None)  # write compile profiles there as JSON
+    TILELANG_KERNEL_CACHE_CAPACITY = EnvVar("TILELANG_KERNEL_CACHE_CAPACITY", "0")  # kernels kept in memory per cache, 0 means no limit
+    TILELANG_LAZY_LOADING = EnvVar("TILELANG_LAZY_LOADING", "1")  # load cached kernel libraries on their first call
+    TILELANG_PRIM_FUNC_TEMPLATE = EnvVar("TILELANG_PRIM_FUNC_TEMPLATE", "1")  # trace a prim_func once for all its shape constants
+    TILELANG_REMOTE_CACHE = EnvVar("TILELANG_REMOTE_CACHE", None)  # file://, s3:// or redis:// URL of a shared kernel cache
+    TILELANG_REMOTE_CACHE_LEASE_TIMEOUT = EnvVar("TILELANG_REMOTE_CACHE_LEASE_TIMEOUT", "600")  # seconds a compiling process holds a key
 
     # Kernel selection options
     # Default to GEMM v2; set to "1"/"true"/"yes"/"on" to force v1
@@ -278,6 +294,12 @@ class Environment:
     TILELANG_AUTO_TUNING_CPU_UTILITIES = EnvVar("TILELANG_AUTO_TUNING_CPU_UTILITIES", "0.9")  # percent of CPUs used
     TILELANG_AUTO_TUNING_CPU_COUNTS = EnvVar("TILELANG_AUTO_TUNING_CPU_COUNTS", "-1")  # -1 means auto
     TILELANG_AUTO_TUNING_MAX_CPU_COUNT = EnvVar("TILELANG_AUTO_TUNING_MAX_CPU_COUNT", "-1")  # -1 means no limit
+    # benchmark each config as soon as it is compiled instead of after all compilations
+    TILELANG_AUTO_TUNING_PIPELINE = EnvVar("TILELANG_AUTO_TUNING_PIPELINE", "0")
+    # generate the inputs of a shape once and reuse them for every config
+    TILELANG_AUTO_TUNING_SUPPLY_POOL = EnvVar("TILELANG_AUTO_TUNING_SUPPLY_POOL", "1")
+    # tuning database shared across jobs, defaults to one under TILELANG_CACHE_DIR
+    TILELANG_AUTO_TUNING_DATABASE = EnvVar("TILELANG_AUTO_TUNING_DATABASE", None)
 
     # Compilation defaults (for jit, autotune, compile)
     # These allow overriding default compilation parameters via environment variables
@@ -286,6 +308,8 @@ class Environment:
     TILELANG_DEFAULT_VERBOSE = EnvVar("TILELANG_VERBOSE", "0")
 
     # TVM integration
+    # skip loading TVM and the compiler on `import tilelang`
+    TILELANG_LIGHT_IMPORT = EnvVar("TILELANG_LIGHT_IMPORT", "0")
     SKIP_LOADING_TILELANG_SO = EnvVar("SKIP_LOADING_TILELANG_SO", "0")
     TVM_IMPORT_PYTHON_PATH = EnvVar("TVM_IMPORT_PYTHON_PATH", None)
 
@@ -315,9 +339,27 @@ class Environment:
     def is_cache_globally_disabled(self) -> bool:
         return self.TILELANG_DISABLE_CACHE.lower() in ("1", "true", "yes", "on")
 
+    def is_cache_index_enabled(self) -> bool:
+        return self.TILELANG_CACHE_INDEX.lower() in ("1", "true", "yes", "on")
+
     def is_autotune_cache_disabled(self) -> bool:
         return self.TILELANG_AUTO_TUNING_DISABLE_CACHE.lower() in ("1", "true", "yes", "on")
 
+    def is_autotune_pipeline_enabled(self) -> bool:
+        return self.TILELANG_AUTO_TUNING_PIPELINE.lower() in ("1", "true", "yes", "on")
+
+    def is_autotune_supply_pool_enabled(self) -> bool:
+        return self.TILELANG_AUTO_TUNING_SUPPLY_POOL.lower() in ("1", "true", "yes", "on")
+
+    def is_lazy_loading_enabled(self) -> bool:
+        return self.TILELANG_LAZY_LOADING.lower() in ("1", "true", "yes", "on")
+
+    def is_prim_func_template_enabled(self) -> bool:
+        return self.TILELANG_PRIM_FUNC_TEMPLATE.lower() in ("1", "true", "yes", "on")
+
+    def is_compile_profile_enabled(self) -> bool:
+        return self.TILELANG_COMPILE_PROFILE.lower() in ("1", "true", "yes", "on")
+
     def is_print_on_compilation_enabled(self) -> bool:
         return self.TILELANG_PRINT_ON_COMPILATION.lower() in ("1", "true", "yes", "on")
 
@@ -329,6 +371,14 @@ class Environment:
         """
         return str(self.TILELANG_USE_GEMM_V1).lower() in ("1", "true", "yes", "on")
 
+    def get_remote_cache_lease_timeout(self) -> float:
+        """Get the seconds after which the lease of a process compiling a kernel for the remote cache expires."""
+        return float(self.TILELANG_REMOTE_CACHE_LEASE_TIMEOUT)
+
+    def get_kernel_cache_capacity(self) -> int | None:
+        """Get the number of kernels kept in memory by each kernel cache, None for no limit."""
+        return int(self.TILELANG_KERNEL_CACHE_CAPACITY) or None
+
     def get_default_target(self) -> str:
         """Get default compilation target from environment."""
         return self.TILELANG_DEFAULT_TARGET
@@ -348,9 +398,15 @@ class Environment:
 
     def is_light_import(self) -> bool:
         """Return True if we are running in light import mode."""
-        # means we are running under `python -m tilelang.autodd` or some
-        # other scripts that only require the minimal environment variables.
-        return self.is_running_autodd()
+        # means we are running under `python -m tilelang.autodd`, the
+        # `python -m tilelang.cache` maintenance commands or some other
+        # scripts that only require the minimal environment variables,
+        # e.g. serving precompiled kernels through `tilelang.bundle`.
+        return (
+            self.is_running_autodd()
+            or _is_running_module("tilelang.cache")
+            or self.TILELANG_LIGHT_IMPORT.lower() in ("1", "true", "yes", "on")
+        )
 
 
 # Instantiate as a global configuration object
@@ -0,0 +1,184 @@
+from __future__ import annotations
+
+import tilelang.language as T
+from tvm import tir
+from tvm.ir import Range
+from tvm.tir import PrimExpr, Buffer, BufferRegion
+
+
+class SimdgroupIntrinEmitter:
+    """
+    Emits the simdgroup_matrix 8x8 multiply-accumulates of Metal.
+
+    Every simdgroup (32 threads) owns a warp_row_tiles x warp_col_tiles block of
+    C, held in warp_rows x warp_cols simdgroup matrices over one gemm, and loads
+    the 8x8 tiles of A and B from threadgroup memory, transposing them in the
+    load when they are stored MN-major.
+    """
+
+    WARP_SIZE = 32
+    micro_size = 8
+    supported_dtypes = ("float16", "float32", "bfloat16")
+
+    def __init__(
+        self,
+        a_dtype: str = "float16",
+        b_dtype: str = "float16",
+        accum_dtype: str = "float16",
+        a_transposed: bool = False,
+        b_transposed: bool = False,
+        block_row_warps: int = 2,
+        block_col_warps: int = 2,
+        warp_row_tiles: int = 16,
+        warp_col_tiles: int = 16,
+        chunk: int = 16,
+        thread_var: tir.Var | None = None,
+    ):
+        a_dtype, b_dtype, accum_dtype = str(a_dtype), str(b_dtype), str(accum_dtype)
+        # simdgroup_multiply_accumulate takes the three matrices in one type
+        assert a_dtype == b_dtype == accum_dtype, (
+            f"simdgroup_matrix gemm expects A, B and C of one dtype, got {a_dtype}, {b_dtype}, {accum_dtype}; "
+            "allocate the shared operands in the accumulator dtype, T.copy converts on the way in"
+        )
+        assert accum_dtype in self.supported_dtypes, f"simdgroup_matrix does not support {accum_dtype}"
+        self.dtype = accum_dtype
+        self.a_transposed = a_transposed
+        self.b_transposed = b_transposed
+        self.block_row_warps = block_row_warps
+        self.block_col_warps = block_col_warps
+        self.warp_row_tiles = warp_row_tiles
+        self.warp_col_tiles = warp_col_tiles
+        self.chunk = chunk
+        self.thread_var = thread_var
+        micro = self.micro_size
+        assert warp_row_tiles % micro == 0 and warp_col_tiles % micro == 0, (
+            f"warp tiles ({warp_row_tiles}, {warp_col_tiles}) must be multiples of {micro}"
+        )
+        assert chunk % micro == 0, f"block_K ({chunk}) must be a multiple of {micro}"
+        self.warp_rows = warp_row_tiles // micro
+        self.warp_cols = warp_col_tiles // micro
+
+    def get_thread_binding(self):
+        if self.thread_var is None:
+            current_frame = T.KernelLaunchFrame.Current()
+            assert current_frame is not None, "Must be called in a T.Kernel Frame"
+            return current_frame.get_thread_binding()
+        else:
+            return self.thread_var
+
+    def extract_warp_binding(self, thread_id) -> tuple[PrimExpr, PrimExpr]:
+        """(warp_m, warp_n) of the simdgroup of ``thread_id``, uniform across it."""
+        warp_id = thread_id // self.WARP_SIZE
+        return warp_id % self.block_row_warps, (warp_id // self.block_row_warps) % self.block_col_warps
+
+    @staticmethod
+    def _legalize_to_buffer_region(obj: Buffer | BufferRegion) -> BufferRegion:
+        if isinstance(obj, BufferRegion):
+            return obj
+        return BufferRegion(obj, [Range.from_min_extent(0, e) for e in obj.shape])
+
+    @staticmethod
+    def _tile_ptr(region: BufferRegion, row: PrimExpr, col: PrimExpr, access_mask: str):
+        """Pointer to element (row, col) of the matrix in the last two dims of
+        ``region``, and the row stride of the buffer, in elements."""
+        buf = region.buffer
+        indices = [r.min for r in region.region]
+        indices[-2] = indices[-2] + row
+        indices[-1] = indices[-1] + col
+        offset = 0
+        for index, extent in zip(indices, buf.shape):
+            offset = offset * extent + index
+        return buf.access_ptr(access_mask, offset=offset), buf.shape[-1]
+
+    def alloc_a(self):
+        return T.alloc_buffer((self.warp_rows * 64,), self.dtype, scope="metal.simdgroup")
+
+    def alloc_b(self):
+        return T.alloc_buffer((self.warp_cols * 64,), self.dtype, scope="metal.simdgroup")
+
+    def alloc_c(self):
+        return T.alloc_buffer((self.warp_rows * self.warp_cols * 64,), self.dtype, scope="metal.simdgroup")
+
+    def fill_c(self, C_sg: Buffer, value: PrimExpr = 0):
+        warp_rows, warp_cols = self.warp_rows, self.warp_cols
+        dtype = self.dtype
+
+        @T.macro
+        def _fill_c(C_sg):
+            for i in T.unroll(warp_rows):
+                for j in T.unroll(warp_cols):
+                    T.evaluate(tir.make_filled_simdgroup_matrix(C_sg.data, i * warp_cols + j, T.cast(value, dtype), 8, 8))
+
+        return _fill_c(C_sg)
+
+    def _c_tiles(self, C_sg: Buffer, C_buf: Buffer | BufferRegion, store: bool):
+        warp_rows, warp_cols = self.warp_rows, self.warp_cols
+        warp_row_tiles, warp_col_tiles = self.warp_row_tiles, self.warp_col_tiles
+        micro = self.micro_size
+        C_region = self._legalize_to_buffer_region(C_buf)
+        thread_binding = self.get_thread_binding()
+        op = tir.simdgroup_store if store else tir.simdgroup_load
+        access_mask = "w" if store else "r"
+
+        @T.macro
+        def _c_tiles(C_sg, thread_binding):
+            warp_m, warp_n = T.meta_var(self.extract_warp_binding(thread_binding))
+            for i in T.unroll(warp_rows):
+                for j in T.unroll(warp_cols):
+                    m, n = warp_m * warp_row_tiles + i * micro, warp_n * warp_col_tiles + j * micro
+                    ptr, stride = T.meta_var(self._tile_ptr(C_region, m, n, access_mask))
+                    T.evaluate(op(C_sg.data, i * warp_cols + j, ptr, stride, 8, 8, False))
+
+        return _c_tiles(C_sg, thread_binding)
+
+    def load_c(self, C_sg: Buffer, C_buf: Buffer | BufferRegion):
+        return self._c_tiles(C_sg, C_buf, store=False)
+
+    def store_c(self, C_sg: Buffer, C_buf: Buffer | BufferRegion):
+        return self._c_tiles(C_sg, C_buf, store=True)
+
+    def load_a(self, A_sg: Buffer, A_buf: Buffer | BufferRegion, ki: PrimExpr):
+        warp_rows, warp_row_tiles = self.warp_rows, self.warp_row_tiles
+        micro = self.micro_size
+        is_transposed = self.a_transposed
+        A_region = self._legalize_to_buffer_region(A_buf)
+        thread_binding = self.get_thread_binding()
+
+        @T.macro
+        def _load_a(A_sg, ki, thread_binding):
+            warp_m, _ = T.meta_var(self.extract_warp_binding(thread_binding))
+            for i in T.unroll(warp_rows):
+                m, k = warp_m * warp_row_tiles + i * micro, ki * micro
+                ptr, stride = T.meta_var(self._tile_ptr(A_region, k, m, "r") if is_transposed else self._tile_ptr(A_region, m, k, "r"))
+                T.evaluate(tir.simdgroup_load(A_sg.data, i, ptr, stride, 8, 8, is_transposed))
+
+        return _load_a(A_sg, ki, thread_binding)
+
+    def load_b(self, B_sg: Buffer, B_buf: Buffer | BufferRegion, ki: PrimExpr):
+        warp_cols, warp_col_tiles = self.warp_cols, self.warp_col_tiles
+        micro = self.micro_size
+        is_transposed = self.b_transposed
+        B_region = self._legalize_to_buffer_region(B_buf)
+        thread_binding = self.get_thread_binding()
+
+        @T.macro
+        def _load_b(B_sg, ki, thread_binding):
+            _, warp_n = T.meta_var(self.extract_warp_binding(thread_binding))
+            for j in T.unroll(warp_cols):
+                n, k = warp_n * warp_col_tiles + j * micro, ki * micro
+                ptr, stride = T.meta_var(self._tile_ptr(B_region, n, k, "r") if is_transposed else self._tile_ptr(B_region, k, n, "r"))
+                T.evaluate(tir.simdgroup_load(B_sg.data, j, ptr, stride, 8, 8, is_transposed))
+
+        return _load_b(B_sg, ki, thread_binding)
+
+    def mma(self, A_sg: Buffer, B_sg: Buffer, C_sg: Buffer):
+        warp_rows, warp_cols = self.warp_rows, self.warp_cols
+
+        @T.macro
+        def _mma(A_sg, B_sg, C_sg):
+            for i in T.unroll(warp_rows):
+                for j in T.unroll(warp_cols):
+                    c = i * warp_cols + j
+                    T.evaluate(tir.simdgroup_multiply_accumulate(C_sg.data, c, A_sg.data, i, B_sg.data, j, C_sg.data, c))
+
+        return _mma(A_sg, B_sg, C_sg)
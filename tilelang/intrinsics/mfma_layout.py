@@ -128,6 +128,32 @@ def shared_16x64_to_local_64x16_layout_B(i, j):
     return thread_id, local
 
 
+# 32 consecutive elements of K per lane, the operands of the 16x16x128 FP8 MFMA
+# of CDNA4 and of the 16x16x32 FP8 MFMA with k_pack = 4
+def thread_id_shared_access_64x32_to_16x128_layout_A(thread_id, local_id):
+    i = thread_id % 16
+    j = local_id + (thread_id // 16) * 32
+    return i, j
+
+
+def shared_16x128_to_local_64x32_layout_A(i, j):
+    thread_id = i + 16 * (j // 32)
+    local = j % 32
+    return thread_id, local
+
+
+def thread_id_shared_access_64x32_to_16x128_layout_B(thread_id, local_id):
+    i = local_id + (thread_id // 16) * 32
+    j = thread_id % 16
+    return i, j
+
+
+def shared_16x128_to_local_64x32_layout_B(i, j):
+    thread_id = j + (i // 32) * 16
+    local = i % 32
+    return thread_id, local
+
+
 def make_mfma_swizzle_layout(shared_buf, vecSize=8):
     dtype = shared_buf.dtype
     shape = shared_buf.shape
@@ -28,6 +28,11 @@ from .mfma_layout import (
     thread_id_shared_access_64x8_to_16x32_layout_B,
     thread_id_shared_access_64x16_to_16x64_layout_A,
     thread_id_shared_access_64x16_to_16x64_layout_B,
+    shared_16x128_to_local_64x32_layout_A,
+    shared_16x128_to_local_64x32_layout_B,
+    thread_id_shared_access_64x32_to_16x128_layout_A,
+    thread_id_shared_access_64x32_to_16x128_layout_B,
+    thread_id_shared_access_64x4_to_16x16_layout_C_m_n,
 )
 
 lift = convert
@@ -48,10 +53,27 @@ class MatrixCoreIntrinEmitter:
         "int8": "int8",
         "int32": "int32",
         "float8_e4m3": "e4m3",
+        "float8_e4m3fn": "e4m3",
         "float8_e5m2": "e5m2",
         "float8_e4m3fnuz": "e4m3fnuz",
         "float8_e5m2fnuz": "e5m2fnuz",
     }
+    # Operand type of the FP8 MFMA variants, fp8 for e4m3 and bf8 for e5m2.
+    # CDNA3 (gfx942) reads the fnuz encodings, CDNA4 (gfx950) the OCP ones.
+    fp8_abbrv = {
+        "float8_e4m3": "fp8",
+        "float8_e4m3fn": "fp8",
+        "float8_e4m3fnuz": "fp8",
+        "float8_e5m2": "bf8",
+        "float8_e5m2fnuz": "bf8",
+    }
+    # Operand format of the f8f6f4 MFMA of CDNA4 (cbsz / blgp): 2 and 3 are
+    # the FP6 e2m3 and e3m2 and 4 the FP4 e2m1 ones, see tl_templates/hip/gemm.h
+    f8f6f4_format = {
+        "float8_e4m3": 0,
+        "float8_e4m3fn": 0,
+        "float8_e5m2": 1,
+    }
 
     # k_pack represents the number of elements in a vectorized instruction
     # Detail information can be found in the triton documentation
@@ -59,6 +81,8 @@ class MatrixCoreIntrinEmitter:
     k_pack = 1
     # Represent the thread binding in the form of (tx, warp_n, warp_m)
     is_m_first = False
+    # A and B are swapped at the mfma call, so each lane holds a column of C
+    store_index_map = staticmethod(mfma_store_index_map)
 
     def __init__(
         self,
@@ -78,6 +102,7 @@ class MatrixCoreIntrinEmitter:
         is_m_first: bool | None = False,
         b_preshuffle: bool | None = False,
         thread_var: Var | None = None,
+        is_gfx950: bool = False,
     ):
         self.a_dtype = a_dtype
         self.b_dtype = b_dtype
@@ -90,6 +115,9 @@ class MatrixCoreIntrinEmitter:
         self.warp_row_tiles = warp_row_tiles
         self.warp_col_tiles = warp_col_tiles
         self.chunk = chunk
+        # CDNA4 runs FP8 on the 16x16x128 f8f6f4 MFMA, twice the rate of the
+        # 16x16x32 one of CDNA3
+        self.is_gfx950 = is_gfx950
         self._initialize_k_dim(a_dtype)
         self._initialize_abbrev(a_dtype, b_dtype, accum_dtype)
         self._initialize_local_size(self.M_DIM, self.N_DIM, self.k_dim, self.WARP_SIZE)
@@ -108,7 +136,10 @@ class MatrixCoreIntrinEmitter:
 
     def _initialize_k_dim(self, a_dtype=T.float16):
         if isinstance(a_dtype, str):
-            if a_dtype in ["float8_e4m3fnuz", "float8_e5m2fnuz", T.int8]:
+            if a_dtype in self.fp8_abbrv:
+                self.k_dim = 128 if self.is_gfx950 and a_dtype in self.f8f6f4_format else 32
+                return
+            if a_dtype == T.int8:
                 self.k_dim = 32
                 return
             a_dtype = DataType(a_dtype)
@@ -141,12 +172,15 @@ class MatrixCoreIntrinEmitter:
             "float32": "f32",
             "int8": "i8",
             "int32": "i32",
-            "float8_e4m3fnuz": "fp8",
-            "float8_e5m2fnuz": "fp8",
+            **self.fp8_abbrv,
         }[in_dtype]
 
-        if in_dtype_abbrv == "fp8":
-            self.mfma_suffix = f"{out_dtype_abbrv}_{M_DIM}x{N_DIM}x{k_dim}_fp8_fp8"
+        if k_dim == 128:
+            self.mfma_suffix = f"{out_dtype_abbrv}_{M_DIM}x{N_DIM}x{k_dim}_f8f6f4"
+        elif in_dtype_abbrv in ("fp8", "bf8"):
+            # B is the first operand of the mfma call, see mfma
+            b_dtype_abbrv = self.fp8_abbrv[self.b_dtype]
+            self.mfma_suffix = f"{out_dtype_abbrv}_{M_DIM}x{N_DIM}x{k_dim}_{b_dtype_abbrv}_{in_dtype_abbrv}"
         elif in_dtype_abbrv == "i8":
             self.mfma_suffix = f"{out_dtype_abbrv}_{M_DIM}x{N_DIM}x{k_dim}_i8"
         elif in_dtype_abbrv == "bf16":
@@ -218,14 +252,25 @@ class MatrixCoreIntrinEmitter:
                 reverse_index_map = (
                     thread_id_shared_access_64x16_to_16x64_layout_A if transposed else thread_id_shared_access_64x16_to_16x64_layout_B
                 )
+        elif k_dim == 128:
+            index_map = shared_16x128_to_local_64x32_layout_B if transposed else shared_16x128_to_local_64x32_layout_A
+            reverse_index_map = (
+                thread_id_shared_access_64x32_to_16x128_layout_B if transposed else thread_id_shared_access_64x32_to_16x128_layout_A
+            )
+
+            if is_b:
+                index_map = shared_16x128_to_local_64x32_layout_A if transposed else shared_16x128_to_local_64x32_layout_B
+                reverse_index_map = (
+                    thread_id_shared_access_64x32_to_16x128_layout_A if transposed else thread_id_shared_access_64x32_to_16x128_layout_B
+                )
         else:
-            raise ValueError("k_dim must be 4 or 16 or 32 or 64 currently")
+            raise ValueError("k_dim must be 4 or 16 or 32 or 64 or 128 currently")
 
         return index_map, reverse_index_map
 
     def get_store_index_map(self, inverse: bool = False) -> IndexMap:
         warp_size, local_size_c = self.WARP_SIZE, self.local_size_out
-        index_map = IndexMap.from_func(mfma_store_index_map, index_dtype=T.int32)
+        index_map = IndexMap.from_func(self.store_index_map, index_dtype=T.int32)
         if not inverse:
             return index_map
         inverse_index_map = index_map.inverse([warp_size, local_size_c])
@@ -377,6 +422,9 @@ class MatrixCoreIntrinEmitter:
         a_local_stride: PrimExpr = k_inner * warp_rows * k_pack * local_size_a if a_is_fragment else 0
         b_local_stride: PrimExpr = k_inner * warp_cols * k_pack * local_size_b if b_is_fragment else 0
 
+        if self.k_dim == 128:
+            return self._mfma_f8f6f4(A_local_buf, B_local_buf, C_local_buf, a_local_stride, b_local_stride)
+
         @T.macro
         def _warp_mfma(A_local_buf, B_local_buf, C_local_buf):
             for kp, i, j in T.grid(k_pack, warp_rows, warp_cols):
@@ -398,6 +446,95 @@ class MatrixCoreIntrinEmitter:
 
         return _warp_mfma(A_local_buf, B_local_buf, C_local_buf)
 
+    def _f8f6f4_name(self, scaled: bool) -> str:
+        assert self.k_pack == 1, f"the 16x16x128 mfma of CDNA4 does not take k_pack, got {self.k_pack}"
+        kind = "mfma_scale" if scaled else "mfma"
+        # B is the first operand, as for tvm_mfma
+        fmt_b, fmt_a = self.f8f6f4_format[self.b_dtype], self.f8f6f4_format[self.a_dtype]
+        return f"tl::{kind}_{self.mfma_suffix}<{fmt_b}, {fmt_a}>"
+
+    def _mfma_f8f6f4(self, A_local_buf, B_local_buf, C_local_buf, a_local_stride, b_local_stride):
+        warp_rows = self.warp_rows
+        warp_cols = self.warp_cols
+        local_size_a = self.local_size_a
+        local_size_b = self.local_size_b
+        local_size_out = self.local_size_out
+        mfma_name = self._f8f6f4_name(scaled=False)
+
+        @T.macro
+        def _warp_mfma_f8f6f4(A_local_buf, B_local_buf, C_local_buf):
+            for i, j in T.grid(warp_rows, warp_cols):
+                T.call_extern(
+                    "handle",
+                    mfma_name,
+                    T.address_of(B_local_buf[b_local_stride + j * local_size_b]),
+                    T.address_of(A_local_buf[a_local_stride + i * local_size_a]),
+                    T.address_of(C_local_buf[i * warp_cols * local_size_out + j * local_size_out]),
+                )
+
+        return _warp_mfma_f8f6f4(A_local_buf, B_local_buf, C_local_buf)
+
+    def mfma_blockscaled(
+        self,
+        A_local_buf: Buffer,
+        B_local_buf: Buffer,
+        C_local_buf: Buffer,
+        SFA_shared_buf: Buffer | BufferRegion,
+        SFB_shared_buf: Buffer | BufferRegion,
+        ki: PrimExpr,
+    ):
+        """Block scaled FP8 mfma of the K-slice ki, for CDNA4.
+
+        Every 16x16x128 mfma scales its 128 elements of K by four UE8M0 scale
+        factors per row of A and per column of B, read from the [M, K // 32]
+        and [N, K // 32] scale factor tiles. Lane l holds the 32 elements
+        of K (l // 16) * 32 of row l % 16 of the A and B micro tiles, it
+        provides their scale factor.
+        """
+        assert self.k_dim == 128, f"block scaled mfma expects FP8 operands on gfx950, got {self.a_dtype}"
+        warp_rows = self.warp_rows
+        warp_cols = self.warp_cols
+        warp_row_tiles = self.warp_row_tiles
+        warp_col_tiles = self.warp_col_tiles
+        micro_size_x = self.micro_size_x
+        micro_size_y = self.micro_size_y
+        local_size_a = self.local_size_a
+        local_size_b = self.local_size_b
+        local_size_out = self.local_size_out
+        blocks_per_slice = self.micro_size_k // 32
+        mfma_name = self._f8f6f4_name(scaled=True)
+        thread_binding = self.get_thread_binding()
+
+        SFA_region = self._legalize_to_buffer_region(SFA_shared_buf)
+        SFB_region = self._legalize_to_buffer_region(SFB_shared_buf)
+        SFA_buf, SFB_buf = SFA_region.buffer, SFB_region.buffer
+        SFA_base0, SFA_base1 = SFA_region.region[-2].min, SFA_region.region[-1].min
+        SFB_base0, SFB_base1 = SFB_region.region[-2].min, SFB_region.region[-1].min
+
+        def scale_factor(value):
+            if value.dtype != "uint8":
+                value = tir.reinterpret("uint8", value)
+            return tir.Cast("int32", value)
+
+        @T.macro
+        def _warp_mfma_blockscaled(A_local_buf, B_local_buf, C_local_buf, thread_binding):
+            tx, warp_n, warp_m = self.extract_thread_binding(thread_binding)
+            k_block = ki * blocks_per_slice + tx // 16
+            for i, j in T.grid(warp_rows, warp_cols):
+                wi = warp_m * warp_row_tiles + i * micro_size_x
+                wj = warp_n * warp_col_tiles + j * micro_size_y
+                T.call_extern(
+                    "handle",
+                    mfma_name,
+                    T.address_of(B_local_buf[j * local_size_b]),
+                    T.address_of(A_local_buf[i * local_size_a]),
+                    T.address_of(C_local_buf[i * warp_cols * local_size_out + j * local_size_out]),
+                    scale_factor(SFB_buf[SFB_base0 + wj + tx % 16, SFB_base1 + k_block]),
+                    scale_factor(SFA_buf[SFA_base0 + wi + tx % 16, SFA_base1 + k_block]),
+                )
+
+        return _warp_mfma_blockscaled(A_local_buf, B_local_buf, C_local_buf, thread_binding)
+
     def stmatrix(self, C_local_buf, C_buf, pid_m=None, pid_n=None):
         block_row_warps = self.block_row_warps
         block_col_warps = self.block_col_warps
@@ -421,7 +558,7 @@ class MatrixCoreIntrinEmitter:
             tx, warp_n, warp_m = self.extract_thread_binding(thread_binding)
             for i, j in T.grid(warp_rows, warp_cols):
                 for local_id in T.vectorized(local_size_out):
-                    row, col = T.meta_var(mfma_store_index_map(tx, local_id))
+                    row, col = T.meta_var(self.store_index_map(tx, local_id))
                     if C_buf_dims == 2:
                         C_buf[(warp_m * warp_rows + i) * M_DIM + row, (warp_n * warp_cols + j) * N_DIM + col] = C_local_buf[
                             i * (warp_cols * local_size_out) + j * local_size_out + local_id
@@ -436,7 +573,7 @@ class MatrixCoreIntrinEmitter:
             tx, warp_n, warp_m = self.extract_thread_binding(thread_binding)
             for i, j in T.grid(warp_rows, warp_cols):
                 for local_id in T.vectorized(local_size_out):
-                    row, col = T.meta_var(mfma_store_index_map(tx, local_id))
+                    row, col = T.meta_var(self.store_index_map(tx, local_id))
                     C_buf[
                         (pid_m * BLOCK_M + warp_m * warp_rows + i) * M_DIM + row, (pid_n * BLOCK_N + warp_n * warp_cols + j) * N_DIM + col
                     ] = C_local_buf[i * warp_cols * local_size_out + j * local_size_out + local_id]
@@ -497,8 +634,11 @@ class MatrixCoreIntrinEmitter:
         elif k_dim == 64:
             transform_func_sr_a = shared_16x64_to_local_64x16_layout_A
             transform_func_sr_b = shared_16x64_to_local_64x16_layout_A
+        elif k_dim == 128:
+            transform_func_sr_a = shared_16x128_to_local_64x32_layout_A
+            transform_func_sr_b = shared_16x128_to_local_64x32_layout_A
         else:
-            raise ValueError("k_dim must be 4 or 16 or 32 or 64 currently")
+            raise ValueError("k_dim must be 4 or 16 or 32 or 64 or 128 currently")
 
         is_sr_conditions = [False]
         is_sr_conditions.append(matrix_is_a and not transposed)
@@ -868,3 +1008,188 @@ class MatrixCorePreshuffleIntrinEmitter(MatrixCoreIntrinEmitter):
             if is_global
             else _warp_ldmatrix_b_shared(B_local_buf, B_buf, ki, thread_binding, rk)
         )
+
+
+class SparseMatrixCoreIntrinEmitter(MatrixCoreIntrinEmitter):
+    """
+    Emitter of the 2:4 structured-sparse MFMA (v_smfmac) of CDNA3.
+
+    A is the compressed operand, holding 2 of every 4 values along K, and each
+    lane of the wave feeds the instruction with one byte of E: two 2-bit
+    positions per group of 4, covering the 8 dense K values of its A slice.
+    E is stored row-major with shape (M, K // E_factor), see
+    `tilelang.layout.make_cdna_metadata_layout`.
+    """
+
+    # dense K of a single v_smfmac_f32_16x16x32_{f16,bf16}
+    SPARSE_K_DIM = 32
+    # dense K values covered by the per-lane metadata byte
+    E_K_PER_BYTE = 8
+    E_FACTOR_MAP = {  # e_dtype: dense K values covered by one metadata element
+        "float16": {"int8": 8, "uint8": 8, "int16": 16, "uint16": 16, "int32": 32, "uint32": 32},
+        "bfloat16": {"int8": 8, "uint8": 8, "int16": 16, "uint16": 16, "int32": 32, "uint32": 32},
+    }
+    # the sparse operand is the first source of the instruction, so each lane
+    # holds a row of C, unlike the dense emitter
+    store_index_map = staticmethod(thread_id_shared_access_64x4_to_16x16_layout_C_m_n)
+
+    def __init__(
+        self,
+        a_dtype: str = T.float16,
+        e_dtype: str = T.uint8,
+        b_dtype: str = T.float16,
+        accum_dtype: str = T.float32,
+        a_transposed: bool = False,
+        b_transposed: bool = False,
+        e_transposed: bool = False,
+        block_row_warps: int = 2,
+        block_col_warps: int = 2,
+        warp_row_tiles: int = 8,
+        warp_col_tiles: int = 8,
+        warp_k: int = 32,
+        is_m_first: bool | None = False,
+        thread_var: Var | None = None,
+    ):
+        if a_dtype not in self.E_FACTOR_MAP:
+            raise ValueError(f"Unsupported sparse mfma a_dtype = {a_dtype}")
+        if e_dtype not in self.E_FACTOR_MAP[a_dtype]:
+            raise ValueError(f"Unsupported metadata dtype {e_dtype} for {a_dtype}")
+        if accum_dtype != T.float32:
+            raise ValueError(f"Sparse mfma only accumulates into float32, got {accum_dtype}")
+        if e_transposed:
+            raise NotImplementedError("Transposed metadata is not supported by the sparse mfma emitter")
+        super().__init__(
+            a_dtype=a_dtype,
+            b_dtype=b_dtype,
+            accum_dtype=accum_dtype,
+            a_transposed=a_transposed,
+            b_transposed=b_transposed,
+            block_row_warps=block_row_warps,
+            block_col_warps=block_col_warps,
+            warp_row_tiles=warp_row_tiles,
+            warp_col_tiles=warp_col_tiles,
+            chunk=warp_k,
+            k_pack=1,
+            is_m_first=is_m_first,
+            thread_var=thread_var,
+        )
+        self.e_dtype = e_dtype
+        self.e_transposed = e_transposed
+        self.e_factor = self.E_FACTOR_MAP[a_dtype][e_dtype]
+
+    def _initialize_k_dim(self, a_dtype=T.float16):
+        self.k_dim = self.SPARSE_K_DIM
+
+    def _initialize_local_size(self, m_dim=16, n_dim=16, k_dim=32, warp_size=64):
+        super()._initialize_local_size(m_dim, n_dim, k_dim, warp_size)
+        # A is compressed to half of the dense K
+        self.local_size_a = (m_dim * k_dim // 2) // warp_size
+        # one metadata index per lane and instruction
+        self.local_size_e = 1
+
+    def _initialize_mfma_prefix(self, k_dim=32):
+        in_dtype_abbrv = {"float16": "f16", "bfloat16": "bf16"}[self.a_dtype]
+        self.mfma_suffix = f"f32_{self.M_DIM}x{self.N_DIM}x{k_dim}_{in_dtype_abbrv}"
+
+    def ldmatrix_a(self, A_local_buf, A_shared_buf: Buffer | BufferRegion, ki, rk=0):
+        warp_row_tiles = self.warp_row_tiles
+        warp_rows = self.warp_rows
+        micro_size_x = self.micro_size_x
+        # K extent of a compressed micro tile
+        micro_size_k = self.micro_size_k // 2
+        local_size_a = self.local_size_a
+        is_transposed = self.a_transposed
+        thread_binding = self.get_thread_binding()
+
+        A_region = self._legalize_to_buffer_region(A_shared_buf)
+        A_buf = A_region.buffer
+        A_base0 = A_region.region[-2].min
+        A_base1 = A_region.region[-1].min
+
+        @T.macro
+        def _warp_ldmatrix_a(
+            A_local_buf,
+            A_shared_buf,
+            ki,
+            thread_binding,
+            rk=0,
+        ):
+            tx, _, warp_m = self.extract_thread_binding(thread_binding)
+            for i in T.serial(warp_rows):
+                for local_id in T.vectorized(local_size_a):
+                    row, col = T.meta_var(thread_id_shared_access_64x4_to_16x16_layout_A(tx, local_id))
+                    m = warp_m * warp_row_tiles + i * micro_size_x + row
+                    k = ki * micro_size_k + col
+                    if is_transposed:
+                        A_local_buf[i * local_size_a + local_id] = A_buf[A_base0 + k, A_base1 + m]
+                    else:
+                        A_local_buf[i * local_size_a + local_id] = A_buf[A_base0 + m, A_base1 + k]
+
+        return _warp_ldmatrix_a(A_local_buf, A_shared_buf, ki, thread_binding, rk)
+
+    def ldmatrix_e(self, E_local_buf, E_shared_buf: Buffer | BufferRegion, ki):
+        warp_row_tiles = self.warp_row_tiles
+        warp_rows = self.warp_rows
+        micro_size_x = self.micro_size_x
+        micro_size_k = self.micro_size_k
+        e_factor = self.e_factor
+        e_bytes = DataType(self.e_dtype).bits // 8
+        e_k_per_byte = self.E_K_PER_BYTE
+        local_e_dtype = E_local_buf.dtype
+        thread_binding = self.get_thread_binding()
+
+        E_region = self._legalize_to_buffer_region(E_shared_buf)
+        E_buf = E_region.buffer
+        E_base0 = E_region.region[-2].min
+        E_base1 = E_region.region[-1].min
+
+        @T.macro
+        def _warp_ldmatrix_e(
+            E_local_buf,
+            E_shared_buf,
+            ki,
+            thread_binding,
+        ):
+            tx, _, warp_m = self.extract_thread_binding(thread_binding)
+            for i in T.serial(warp_rows):
+                # lane tx covers the dense K values [8 * (tx // 16), 8 * (tx // 16) + 8) of row tx % 16
+                m = warp_m * warp_row_tiles + i * micro_size_x + tx % micro_size_x
+                k = ki * micro_size_k + (tx // micro_size_x) * e_k_per_byte
+                meta = T.Cast(local_e_dtype, E_buf[E_base0 + m, E_base1 + k // e_factor])
+                if e_bytes == 1:
+                    E_local_buf[i] = meta & 0xFF
+                else:
+                    E_local_buf[i] = (meta >> (((k // e_k_per_byte) % e_bytes) * 8)) & 0xFF
+
+        return _warp_ldmatrix_e(E_local_buf, E_shared_buf, ki, thread_binding)
+
+    def mfma_sp(self, A_local_buf: Buffer, E_local_buf: Buffer, B_local_buf: Buffer, C_local_buf: Buffer, k_inner: PrimExpr | None = 0):
+        warp_rows = self.warp_rows
+        warp_cols = self.warp_cols
+        local_size_a = self.local_size_a
+        local_size_b = self.local_size_b
+        local_size_out = self.local_size_out
+        smfmac_name = f"tl::smfmac_{self.mfma_suffix}"
+
+        b_is_fragment = is_fragment(B_local_buf)
+        b_local_stride: PrimExpr = k_inner * warp_cols * local_size_b if b_is_fragment else 0
+
+        @T.macro
+        def _warp_mfma_sp(A_local_buf, E_local_buf, B_local_buf, C_local_buf):
+            for i, j in T.grid(warp_rows, warp_cols):
+                T.call_extern(
+                    "handle",
+                    smfmac_name,
+                    T.address_of(A_local_buf[i * local_size_a]),
+                    T.address_of(B_local_buf[b_local_stride + j * local_size_b]),
+                    T.address_of(C_local_buf[i * warp_cols * local_size_out + j * local_size_out]),
+                    E_local_buf[i],
+                )
+
+        return _warp_mfma_sp(A_local_buf, E_local_buf, B_local_buf, C_local_buf)
+
+    def make_mfma_load_layout(self, local_buf: Buffer, matrix: Literal["A", "B"] = "A") -> T.Fragment:
+        if matrix == "A":
+            # TODO: register resident compressed A
+            raise NotImplementedError("Sparse mfma expects the compressed A operand in shared memory")
+        return super().make_mfma_load_layout(local_buf, matrix)
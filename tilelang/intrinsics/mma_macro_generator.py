@@ -8,11 +8,13 @@ from tvm.ir import Range
 from tvm.tir import PrimExpr, IndexMap, Buffer, Var, BufferRegion, BufferLoad
 from tilelang import tvm as tvm
 from tvm.runtime import convert
+from tvm.target import Target
 from .utils import (
     mma_store_index_map,
     get_ldmatrix_offset,
 )
 from tilelang.utils import is_fragment, get_buffer_region_from_load
+from tilelang.utils.target import target_is_hopper
 from tilelang.intrinsics.mma_layout import (
     shared_16x8_to_mma_32x4_layout_sr_a,
     shared_16x8_to_mma_32x4_layout_sr_b,
@@ -46,7 +48,10 @@ class TensorCoreIntrinEmitter:
         "bfloat16": "bf16",
         "float32": "fp32",
         "float64": "fp64",
+        "int4": "int4",
+        "uint4": "uint4",
         "int8": "int8",
+        "uint8": "uint8",
         "int32": "int32",
         "float8_e4m3": "e4m3",
         "float8_e4m3fn": "e4m3",
@@ -76,6 +81,7 @@ class TensorCoreIntrinEmitter:
         num_elems_per_byte: int = 1,
         is_m_first: bool | None = False,
         thread_var: Var | None = None,
+        target: Target | None = None,
     ):
         self.a_dtype = a_dtype
         self.b_dtype = b_dtype
@@ -89,11 +95,15 @@ class TensorCoreIntrinEmitter:
         self.warp_col_tiles = warp_col_tiles
         self.chunk = chunk
         self._initialize_k_dim(a_dtype)
-        # For FP64, MMA shape is m8n8k4; adjust instance dims early
         if DataType(a_dtype).bits == 64:
-            # Override default M/N dims for fp64 MMA
-            self.M_DIM = 8
-            # n_dim will be set to 8 in _initialize_micro_size via k_dim==4
+            if target is not None and target_is_hopper(target):
+                # Hopper DMMA: m16n8k8, with the fragments of tf32 m16n8k8
+                self.k_dim = 8
+            else:
+                # For FP64, MMA shape is m8n8k4; adjust instance dims early
+                # Override default M/N dims for fp64 MMA
+                self.M_DIM = 8
+                # n_dim will be set to 8 in _initialize_micro_size via k_dim==4
         self._initialize_abbrev(a_dtype, b_dtype, accum_dtype)
         self._initialize_micro_size(self.M_DIM, self.k_dim)
         self._initialize_local_size(self.M_DIM, self.n_dim, self.k_dim, self.WARP_SIZE)
@@ -144,6 +154,9 @@ class TensorCoreIntrinEmitter:
         elif k_dim == 32:
             # typically used for int8/fp8
             self.mma_prefix = "m16n8k32"
+        elif k_dim == 64:
+            # int4
+            self.mma_prefix = "m16n8k64"
         else:
             raise ValueError("Unsupported k_dim")
 
@@ -195,7 +208,7 @@ class TensorCoreIntrinEmitter:
         from .utils import mma_store_index_map, mma_store_index_map_fp64
 
         warp_size, local_size_c = self.WARP_SIZE, self.local_size_out
-        if DataType(self.accum_dtype).bits == 64:
+        if self.M_DIM == 8:
             index_map = IndexMap.from_func(mma_store_index_map_fp64, index_dtype=T.int32)
         else:
             index_map = IndexMap.from_func(mma_store_index_map, index_dtype=T.int32)
@@ -234,8 +247,8 @@ class TensorCoreIntrinEmitter:
             return lane_id, warp_n, warp_m
 
     def ldmatrix_a(self, A_local_buf: Buffer, A_shared_buf: Buffer | BufferRegion, ki: PrimExpr, rk: PrimExpr | None = 0):
-        # Fast path for fp64: no ldmatrix support, do direct per-lane loads
-        if DataType(self.a_dtype).bits == 64:
+        # Fast path for fp64 m8n8k4: no ldmatrix support, do direct per-lane loads
+        if self.M_DIM == 8:
             warp_row_tiles = self.warp_row_tiles
             warp_rows = self.warp_rows
             chunk = self.chunk
@@ -280,8 +293,8 @@ class TensorCoreIntrinEmitter:
         local_size_a = self.local_size_a
         a_dtype = self.a_dtype
         a_transposed = self.a_transposed
-        # ldmatrix cannot be used for int8 + trans case.
-        ldmatrix_available = not (DataType(a_dtype).bits != 16 and a_transposed)
+        # ldmatrix cannot be used for int8 + trans case, nor for fp64.
+        ldmatrix_available = not (DataType(a_dtype).bits != 16 and a_transposed) and DataType(a_dtype).bits != 64
 
         def mma_load_layout(i, j):
             return i, j
@@ -291,7 +304,7 @@ class TensorCoreIntrinEmitter:
                 mma_load_layout = mma_load_a_32x16_to_shared_16x32_layout
             elif DataType(a_dtype).bits == 16:
                 mma_load_layout = mma_load_a_32x8_to_shared_16x16_layout
-            elif DataType(a_dtype).bits == 32:
+            elif DataType(a_dtype).bits in (32, 64):
                 mma_load_layout = mma_load_a_32x4_to_shared_16x8_layout
             else:
                 raise ValueError(f"Unsupported dtype: {a_dtype}")
@@ -344,8 +357,8 @@ class TensorCoreIntrinEmitter:
         return _warp_ldmatrix_a(A_local_buf, A_region, ki, thread_binding, rk)
 
     def ldmatrix_b(self, B_local_buf: Buffer, B_shared_buf: Buffer | BufferRegion, ki: PrimExpr, rk: PrimExpr | None = 0):
-        # Fast path for fp64: no ldmatrix support, do direct per-lane loads
-        if DataType(self.b_dtype).bits == 64:
+        # Fast path for fp64 m8n8k4: no ldmatrix support, do direct per-lane loads
+        if self.M_DIM == 8:
             warp_col_tiles = self.warp_col_tiles
             warp_cols = self.warp_cols
             chunk = self.chunk
@@ -399,8 +412,8 @@ class TensorCoreIntrinEmitter:
         B_base1 = B_region.region[-1].min
         B_stride_last = B_buf.shape[-1]
         replicate_b = self.n_dim == 16
-        # ldmatrix cannot be used for int8 + trans case.
-        ldmatrix_available = not (DataType(b_dtype).bits != 16 and not b_transposed)
+        # ldmatrix cannot be used for int8 + trans case, nor for fp64.
+        ldmatrix_available = not (DataType(b_dtype).bits != 16 and not b_transposed) and DataType(b_dtype).bits != 64
 
         def mma_load_layout(i, j):
             return i, j
@@ -410,7 +423,7 @@ class TensorCoreIntrinEmitter:
                 mma_load_layout = mma_load_b_32x16_to_shared_16x32_layout
             elif DataType(b_dtype).bits == 16:
                 mma_load_layout = mma_load_b_32x8_to_shared_16x16_layout
-            elif DataType(b_dtype).bits == 32:
+            elif DataType(b_dtype).bits in (32, 64):
                 mma_load_layout = mma_load_b_32x4_to_shared_16x8_layout
             else:
                 raise ValueError(f"Unsupported dtype: {b_dtype}")
@@ -517,6 +530,86 @@ class TensorCoreIntrinEmitter:
 
         return _warp_mma(A_local_buf, B_local_buf, C_local_buf)
 
+    def mma_blockscaled(
+        self,
+        A_local_buf: Buffer,
+        B_local_buf: Buffer,
+        C_local_buf: Buffer,
+        SFA_shared_buf: Buffer | BufferRegion,
+        SFB_shared_buf: Buffer | BufferRegion,
+        ki: PrimExpr,
+    ):
+        """Block scaled FP8 mma of the K-slice ki, for sm120.
+
+        Every m16n8k32 mma scales its 32 elements of K by one UE8M0 scale
+        factor per row of A and per column of B, read from the [M, K // 32]
+        and [N, K // 32] scale factor tiles. Following the scale factor
+        fragments of mma.sync block_scale, lane l provides the scale factor of
+        row l // 4 + 8 * (l % 2) of the A micro tile and of column l // 4 of
+        the B micro tile.
+        """
+        assert self.micro_size_k == 32, f"block scaled mma expects FP8 operands, got {self.a_dtype}"
+        warp_rows = self.warp_rows
+        warp_cols = self.warp_cols
+        warp_row_tiles = self.warp_row_tiles
+        warp_col_tiles = self.warp_col_tiles
+        micro_size_x = self.micro_size_x
+        micro_size_y = self.micro_size_y
+        local_size_a = self.local_size_a
+        local_size_b = self.local_size_b
+        local_size_out = self.local_size_out
+        a_dtype_abbrv = self.a_dtype_abbrv
+        b_dtype_abbrv = self.b_dtype_abbrv
+        replicate_b = self.n_dim == 16
+        thread_binding = self.get_thread_binding()
+
+        SFA_region = self._legalize_to_buffer_region(SFA_shared_buf)
+        SFB_region = self._legalize_to_buffer_region(SFB_shared_buf)
+        SFA_buf, SFB_buf = SFA_region.buffer, SFB_region.buffer
+        SFA_base0, SFA_base1 = SFA_region.region[-2].min, SFA_region.region[-1].min
+        SFB_base0, SFB_base1 = SFB_region.region[-2].min, SFB_region.region[-1].min
+
+        def scale_factor(value):
+            if value.dtype != "uint8":
+                value = tir.reinterpret("uint8", value)
+            return tir.Cast("uint32", value)
+
+        @T.macro
+        def _warp_mma_blockscaled(A_local_buf, B_local_buf, C_local_buf, thread_binding):
+            tx, warp_n, warp_m = self.extract_thread_binding(thread_binding)
+            row = tx // 4 + 8 * (tx % 2)
+            col = tx // 4
+            for i, j in T.grid(warp_rows, warp_cols):
+                wi = warp_m * warp_row_tiles + i * micro_size_x
+                wj = warp_n * warp_col_tiles + j * micro_size_y
+                T.ptx_mma_blockscaled(
+                    a_dtype_abbrv,
+                    b_dtype_abbrv,
+                    A_local_buf.data,
+                    i * local_size_a,
+                    B_local_buf.data,
+                    j * local_size_b,
+                    C_local_buf.data,
+                    i * warp_cols * local_size_out + j * local_size_out,
+                    scale_factor(SFA_buf[SFA_base0 + wi + row, SFA_base1 + ki]),
+                    scale_factor(SFB_buf[SFB_base0 + wj + col, SFB_base1 + ki]),
+                )
+                if replicate_b:
+                    T.ptx_mma_blockscaled(
+                        a_dtype_abbrv,
+                        b_dtype_abbrv,
+                        A_local_buf.data,
+                        i * local_size_a,
+                        B_local_buf.data,
+                        j * local_size_b + lift(local_size_b) // 2,
+                        C_local_buf.data,
+                        i * warp_cols * local_size_out + j * local_size_out + lift(local_size_out) // 2,
+                        scale_factor(SFA_buf[SFA_base0 + wi + row, SFA_base1 + ki]),
+                        scale_factor(SFB_buf[SFB_base0 + wj + 8 + col, SFB_base1 + ki]),
+                    )
+
+        return _warp_mma_blockscaled(A_local_buf, B_local_buf, C_local_buf, thread_binding)
+
     def stmatrix(self, C_local_buf, C_buf, pid_m=None, pid_n=None):
         block_row_warps = self.block_row_warps
         block_col_warps = self.block_col_warps
@@ -612,7 +705,7 @@ class TensorCoreIntrinEmitter:
         # then rs also can represent a transposed basic layout
         transform_func_sr_a: Callable = None
         transform_func_sr_b: Callable = None
-        if dtype_bits == 32:
+        if dtype_bits == 32 or (dtype_bits == 64 and self.M_DIM == 16):
             transform_func_sr_a = shared_16x8_to_mma_32x4_layout_sr_a
             transform_func_sr_b = shared_16x8_to_mma_32x4_layout_sr_b
         elif dtype_bits == 16:
@@ -1167,7 +1260,7 @@ class INT4TensorCoreIntrinEmitter(TensorCoreIntrinEmitter):
         b_dtype_abbrv = "int4"
         accum_dtype = self.accum_dtype
         accum_dtype_abbrv = accum_dtype
-        mma_prefix = "m16n8k32"
+        mma_prefix = "m16n8k64"
 
         @T.macro
         def _warp_mma(A_local_buf, B_local_buf, C_local_buf):
@@ -1177,13 +1270,15 @@ class INT4TensorCoreIntrinEmitter(TensorCoreIntrinEmitter):
                 A_local_size -> 16
                 B_local_size -> 16
                 C_local_size -> 8
-                For each m16n8k32 inst
-                For A: m16k32 consume 16 int4 elements -> 8 A_local_size
-                For A: n8k32 consume 8 int4 elements -> 4 B_local_size
+                For each m16n8k64 inst
+                For A: m16k64 consume 32 int4 elements -> 16 A_local_size
+                For B: n8k64 consume 16 int4 elements -> 8 B_local_size
                 For C: m16n8 consume 4 int32 elements -> 4 C_local_size
+                The packed registers of m16n8k64 int4 are laid out as the
+                ones of m16n8k32 int8, so both halves of K take one inst.
                 """
 
-                # A[0:16, 0:16] * B[0:8, 0:16] -> C[0:16, 0:8]
+                # A[0:16, 0:32] * B[0:8, 0:32] -> C[0:16, 0:8]
                 T.ptx_mma(
                     accum_dtype,
                     mma_prefix,
@@ -1201,7 +1296,7 @@ class INT4TensorCoreIntrinEmitter(TensorCoreIntrinEmitter):
                     T.bool(False),
                 )
 
-                # A[0:16, 0:16] * B[8:16, 0:16] -> C[0:16, 8:16]
+                # A[0:16, 0:32] * B[8:16, 0:32] -> C[0:16, 8:16]
                 T.ptx_mma(
                     accum_dtype,
                     mma_prefix,
@@ -1219,42 +1314,6 @@ class INT4TensorCoreIntrinEmitter(TensorCoreIntrinEmitter):
                     T.bool(False),
                 )
 
-                # A[0:16, 16:32] * B[0:8, 16:32] -> C[0:16, 0:8]
-                T.ptx_mma(
-                    accum_dtype,
-                    mma_prefix,
-                    "row",
-                    "col",
-                    a_dtype_abbrv,
-                    b_dtype_abbrv,
-                    accum_dtype_abbrv,
-                    A_local_buf.data,
-                    i * local_size_a + lift(local_size_a) // 2,
-                    B_local_buf.data,
-                    j * local_size_b + lift(local_size_b) // 4,
-                    C_local_buf.data,
-                    i * warp_cols * local_size_out + j * local_size_out,
-                    T.bool(False),
-                )
-
-                # A[0:16, 16:32] * B[8:16, 16:32] -> C[0:16, 8:16]
-                T.ptx_mma(
-                    accum_dtype,
-                    mma_prefix,
-                    "row",
-                    "col",
-                    a_dtype_abbrv,
-                    b_dtype_abbrv,
-                    accum_dtype_abbrv,
-                    A_local_buf.data,
-                    i * local_size_a + lift(local_size_b) // 2,
-                    B_local_buf.data,
-                    j * local_size_b + lift(local_size_b) // 2 + lift(local_size_b) // 4,
-                    C_local_buf.data,
-                    i * warp_cols * local_size_out + j * local_size_out + lift(local_size_out) // 2,
-                    T.bool(False),
-                )
-
         return _warp_mma(A_local_buf, B_local_buf, C_local_buf)
 
 
@@ -1269,7 +1328,7 @@ class INT4TensorCoreIntrinEmitterWithLadderTransform(TensorCoreIntrinEmitterWith
         b_dtype_abbrv = "int4"
         accum_dtype = self.accum_dtype
         accum_dtype_abbrv = T.int32
-        mma_prefix = "m16n8k32"
+        mma_prefix = "m16n8k64"
 
         @T.macro
         def _warp_mma(A_local_buf, B_local_buf, C_local_buf):
@@ -1279,13 +1338,15 @@ class INT4TensorCoreIntrinEmitterWithLadderTransform(TensorCoreIntrinEmitterWith
                 A_local_size -> 16
                 B_local_size -> 16
                 C_local_size -> 8
-                For each m16n8k32 inst
-                For A: m16k32 consume 16 int4 elements -> 8 A_local_size
-                For A: n8k32 consume 8 int4 elements -> 4 B_local_size
+                For each m16n8k64 inst
+                For A: m16k64 consume 32 int4 elements -> 16 A_local_size
+                For B: n8k64 consume 16 int4 elements -> 8 B_local_size
                 For C: m16n8 consume 4 int32 elements -> 4 C_local_size
+                The packed registers of m16n8k64 int4 are laid out as the
+                ones of m16n8k32 int8, so both halves of K take one inst.
                 """
 
-                # A[0:16, 0:16] * B[0:8, 0:16] -> C[0:16, 0:8]
+                # A[0:16, 0:32] * B[0:8, 0:32] -> C[0:16, 0:8]
                 T.ptx_mma(
                     accum_dtype,
                     mma_prefix,
@@ -1303,7 +1364,7 @@ class INT4TensorCoreIntrinEmitterWithLadderTransform(TensorCoreIntrinEmitterWith
                     T.bool(False),
                 )
 
-                # A[0:16, 0:16] * B[8:16, 0:16] -> C[0:16, 8:16]
+                # A[0:16, 0:32] * B[8:16, 0:32] -> C[0:16, 8:16]
                 T.ptx_mma(
                     accum_dtype,
                     mma_prefix,
@@ -1321,40 +1382,4 @@ class INT4TensorCoreIntrinEmitterWithLadderTransform(TensorCoreIntrinEmitterWith
                     T.bool(False),
                 )
 
-                # A[0:16, 16:32] * B[0:8, 16:32] -> C[0:16, 0:8]
-                T.ptx_mma(
-                    accum_dtype,
-                    mma_prefix,
-                    "row",
-                    "col",
-                    a_dtype_abbrv,
-                    b_dtype_abbrv,
-                    accum_dtype_abbrv,
-                    A_local_buf.data,
-                    i * local_size_a + lift(local_size_a) // 2,
-                    B_local_buf.data,
-                    j * local_size_b + lift(local_size_b) // 4,
-                    C_local_buf.data,
-                    i * warp_cols * local_size_out + j * local_size_out,
-                    T.bool(False),
-                )
-
-                # A[0:16, 16:32] * B[8:16, 16:32] -> C[0:16, 8:16]
-                T.ptx_mma(
-                    accum_dtype,
-                    mma_prefix,
-                    "row",
-                    "col",
-                    a_dtype_abbrv,
-                    b_dtype_abbrv,
-                    accum_dtype_abbrv,
-                    A_local_buf.data,
-                    i * local_size_a + lift(local_size_b) // 2,
-                    B_local_buf.data,
-                    j * local_size_b + lift(local_size_b) // 2 + lift(local_size_b) // 4,
-                    C_local_buf.data,
-                    i * warp_cols * local_size_out + j * local_size_out + lift(local_size_out) // 2,
-                    T.bool(False),
-                )
-
         return _warp_mma(A_local_buf, B_local_buf, C_local_buf)
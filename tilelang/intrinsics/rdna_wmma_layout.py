@@ -0,0 +1,40 @@
+# Lane layouts of the wave32 v_wmma_f32_16x16x16_{f16,bf16} instructions, see
+# https://github.com/ROCm/amd_matrix_instruction_calculator
+# On RDNA3 (gfx11) both half-waves hold the whole K extent of A and B, on
+# RDNA4 (gfx12) each half-wave holds 8 consecutive K values.
+
+
+def thread_id_shared_access_32x16_to_16x16_layout_A_gfx11(thread_id, local_id):
+    i = thread_id % 16
+    j = local_id
+    return i, j
+
+
+def thread_id_shared_access_32x16_to_16x16_layout_B_gfx11(thread_id, local_id):
+    i = local_id
+    j = thread_id % 16
+    return i, j
+
+
+def thread_id_shared_access_32x8_to_16x16_layout_C_gfx11(thread_id, local_id):
+    i = local_id * 2 + thread_id // 16
+    j = thread_id % 16
+    return i, j
+
+
+def thread_id_shared_access_32x8_to_16x16_layout_A_gfx12(thread_id, local_id):
+    i = thread_id % 16
+    j = (thread_id // 16) * 8 + local_id
+    return i, j
+
+
+def thread_id_shared_access_32x8_to_16x16_layout_B_gfx12(thread_id, local_id):
+    i = (thread_id // 16) * 8 + local_id
+    j = thread_id % 16
+    return i, j
+
+
+def thread_id_shared_access_32x8_to_16x16_layout_C_gfx12(thread_id, local_id):
+    i = (thread_id // 16) * 8 + local_id
+    j = thread_id % 16
+    return i, j
@@ -0,0 +1,161 @@
+from __future__ import annotations
+import tilelang.language as T
+from tvm import DataType
+from tvm.tir import PrimExpr, Buffer, Var
+from typing import Literal
+
+from tilelang import _ffi_api
+from tilelang.utils import is_fragment
+from .mfma_macro_generator import MatrixCoreIntrinEmitter
+from .rdna_wmma_layout import (
+    thread_id_shared_access_32x16_to_16x16_layout_A_gfx11,
+    thread_id_shared_access_32x16_to_16x16_layout_B_gfx11,
+    thread_id_shared_access_32x8_to_16x16_layout_C_gfx11,
+    thread_id_shared_access_32x8_to_16x16_layout_A_gfx12,
+    thread_id_shared_access_32x8_to_16x16_layout_B_gfx12,
+    thread_id_shared_access_32x8_to_16x16_layout_C_gfx12,
+)
+
+
+class RDNAWMMAIntrinEmitter(MatrixCoreIntrinEmitter):
+    """
+    Emitter of the wave32 WMMA instructions of RDNA3 (gfx11) and RDNA4 (gfx12).
+
+    The fragment loads and the C stores are shared with the MFMA emitter, only
+    the lane layouts, the fragment sizes and the instruction differ. The
+    fragment layouts of A, B and C come from gemm_layouts.cc.
+    """
+
+    M_DIM = 16
+    N_DIM = 16
+    WARP_SIZE = 32
+
+    def __init__(
+        self,
+        a_dtype: str = T.float16,
+        b_dtype: str = T.float16,
+        accum_dtype: str = T.float32,
+        a_transposed: bool = False,
+        b_transposed: bool = False,
+        block_row_warps: int = 2,
+        block_col_warps: int = 2,
+        warp_row_tiles: int = 16,
+        warp_col_tiles: int = 16,
+        chunk: int = 16,
+        is_gfx12: bool = False,
+        thread_var: Var | None = None,
+    ):
+        self.is_gfx12 = is_gfx12
+        super().__init__(
+            a_dtype=a_dtype,
+            b_dtype=b_dtype,
+            accum_dtype=accum_dtype,
+            a_transposed=a_transposed,
+            b_transposed=b_transposed,
+            block_row_warps=block_row_warps,
+            block_col_warps=block_col_warps,
+            warp_row_tiles=warp_row_tiles,
+            warp_col_tiles=warp_col_tiles,
+            chunk=chunk,
+            k_pack=1,
+            is_m_first=False,
+            thread_var=thread_var,
+        )
+        self.store_index_map = (
+            thread_id_shared_access_32x8_to_16x16_layout_C_gfx12 if is_gfx12 else thread_id_shared_access_32x8_to_16x16_layout_C_gfx11
+        )
+
+    def _initialize_k_dim(self, a_dtype=T.float16):
+        if a_dtype not in [T.float16, T.bfloat16] or DataType(a_dtype).bits != 16:
+            raise ValueError(f"Unsupported a_dtype for RDNA wmma = {a_dtype}")
+        self.k_dim = 16
+
+    def _initialize_local_size(self, m_dim=16, n_dim=16, k_dim=16, warp_size=32):
+        super()._initialize_local_size(m_dim, n_dim, k_dim, warp_size)
+        if not self.is_gfx12:
+            # the two half-waves of RDNA3 hold a copy of the whole tile
+            self.local_size_a = m_dim * k_dim // (warp_size // 2)
+            self.local_size_b = n_dim * k_dim // (warp_size // 2)
+
+    def _initialize_mfma_prefix(self, k_dim=16):
+        if self.accum_dtype != T.float32:
+            raise ValueError(f"RDNA wmma only accumulates into float32, got {self.accum_dtype}")
+        in_dtype_abbrv = {"float16": "f16", "bfloat16": "bf16"}[self.a_dtype]
+        self.mfma_suffix = f"f32_{self.M_DIM}x{self.N_DIM}x{k_dim}_{in_dtype_abbrv}_w32"
+        if self.is_gfx12:
+            self.mfma_suffix += "_gfx12"
+
+    def get_ldmatrix_index_map(self, is_b=False):
+        transposed = self.b_transposed if is_b else self.a_transposed
+        if self.is_gfx12:
+            reverse_index_map = (
+                thread_id_shared_access_32x8_to_16x16_layout_B_gfx12 if is_b else thread_id_shared_access_32x8_to_16x16_layout_A_gfx12
+            )
+        else:
+            reverse_index_map = (
+                thread_id_shared_access_32x16_to_16x16_layout_B_gfx11 if is_b else thread_id_shared_access_32x16_to_16x16_layout_A_gfx11
+            )
+        # the maps are (m, k) for A and (k, n) for B, swap them for the transposed buffers
+        if transposed:
+            non_transposed_map = reverse_index_map
+
+            def reverse_index_map(thread_id, local_id):
+                i, j = non_transposed_map(thread_id, local_id)
+                return j, i
+
+        return None, reverse_index_map
+
+    def wmma(self, A_local_buf: Buffer, B_local_buf: Buffer, C_local_buf: Buffer, k_inner: PrimExpr | None = 0):
+        warp_rows = self.warp_rows
+        warp_cols = self.warp_cols
+        local_size_a = self.local_size_a
+        local_size_b = self.local_size_b
+        local_size_out = self.local_size_out
+        wmma_suffix = self.mfma_suffix
+        a_dtype, b_dtype, out_dtype = self.a_dtype, self.b_dtype, self.accum_dtype
+        compute_a_dtype = f"{a_dtype}x{local_size_a}"
+        compute_b_dtype = f"{b_dtype}x{local_size_b}"
+        compute_out_dtype = f"{out_dtype}x{local_size_out}"
+
+        a_local_stride: PrimExpr = k_inner * warp_rows * local_size_a if is_fragment(A_local_buf) else 0
+        b_local_stride: PrimExpr = k_inner * warp_cols * local_size_b if is_fragment(B_local_buf) else 0
+
+        @T.macro
+        def _warp_wmma(A_local_buf, B_local_buf, C_local_buf):
+            for i, j in T.grid(warp_rows, warp_cols):
+                T.tvm_rdna_wmma(
+                    wmma_suffix,
+                    "row",
+                    "row",
+                    compute_a_dtype,
+                    compute_b_dtype,
+                    compute_out_dtype,
+                    A_local_buf.data,
+                    (a_local_stride + i * local_size_a) // local_size_a,
+                    B_local_buf.data,
+                    (b_local_stride + j * local_size_b) // local_size_b,
+                    C_local_buf.data,
+                    i * warp_cols + j,
+                    dtype=compute_out_dtype,
+                )
+
+        return _warp_wmma(A_local_buf, B_local_buf, C_local_buf)
+
+    def make_wmma_load_layout(self, local_buf: Buffer, matrix: Literal["A", "B"] = "A") -> T.Fragment:
+        assert matrix in ["A", "B"], "matrix should be either A or B"
+        assert is_fragment(local_buf), f"local_buf must be a fragment, but got {local_buf.scope()}"
+        block_m = self.block_row_warps * self.warp_row_tiles
+        block_n = self.block_col_warps * self.warp_col_tiles
+        make_fragment = _ffi_api.make_rdna_wmma_fragment_a if matrix == "A" else _ffi_api.make_rdna_wmma_fragment_b
+        transposed = self.a_transposed if matrix == "A" else self.b_transposed
+        return make_fragment(
+            block_m, block_n, self.chunk, self.warp_row_tiles, self.warp_col_tiles, transposed, self.is_gfx12
+        )
+
+    def make_wmma_store_layout(self, local_buf: Buffer) -> T.Fragment:
+        assert is_fragment(local_buf), "local_buf must be a fragment"
+        block_m = self.block_row_warps * self.warp_row_tiles
+        block_n = self.block_col_warps * self.warp_col_tiles
+        return _ffi_api.make_rdna_wmma_fragment_c(
+            block_m, block_n, self.warp_row_tiles, self.warp_col_tiles, DataType(self.accum_dtype).bits, self.is_gfx12
+        )
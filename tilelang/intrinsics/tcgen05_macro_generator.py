@@ -7,12 +7,14 @@ from tvm.tir import PrimExpr, Buffer, Var, BufferLoad, BufferRegion
 from tilelang import tvm as tvm
 from tilelang import _ffi_api
 from tilelang.utils import is_tensor_memory
+from tilelang.utils.language import _get_buffer
 from tilelang.layout import (
     Layout,
     make_full_bank_swizzled_layout,
     make_half_bank_swizzled_layout,
     make_quarter_bank_swizzled_layout,
     make_linear_layout,
+    make_tcgen05_scale_factor_tmem_layout,
 )
 from tvm.runtime import convert
 
@@ -59,6 +61,36 @@ class SwizzleMode(IntEnum):
             return 1
 
 
+# Helper to allow BufferRegion/BufferLoad as inputs
+def access_ptr_from(buffer_or_load_or_region, access_type: str = "r"):
+    if isinstance(buffer_or_load_or_region, Buffer):
+        return buffer_or_load_or_region.access_ptr(access_type)
+    elif isinstance(buffer_or_load_or_region, BufferLoad):
+        buffer_load = buffer_or_load_or_region
+        offset, stride = 0, 1
+        buffer = buffer_load.buffer
+        for i, shape in enumerate(reversed(buffer.shape)):
+            indice = buffer_load.indices[len(buffer_load.indices) - i - 1]
+            if isinstance(indice, (tvm.tir.IntImm, tvm.tir.PrimExpr)):
+                offset += indice * stride
+            elif isinstance(indice, tvm.tir.Ramp):
+                offset += indice.base * stride
+            else:
+                raise ValueError(f"Unsupported index type: {type(indice)}")
+            stride *= shape
+        return buffer.access_ptr(access_type, offset=offset)
+    elif isinstance(buffer_or_load_or_region, BufferRegion):
+        buffer_region = buffer_or_load_or_region
+        buffer = buffer_region.buffer
+        offset, stride = 0, 1
+        for i, shape in enumerate(reversed(buffer.shape)):
+            offset += buffer_region.region[len(buffer_region.region) - i - 1].min * stride
+            stride *= shape
+        return buffer.access_ptr(access_type, offset=offset)
+    else:
+        raise ValueError(f"Unsupported buffer type: {type(buffer_or_load_or_region)}")
+
+
 # derive from MMAIntrinEmitter as some layouts are the same
 class TensorCoreIntrinEmitter(MMAIntrinEmitter):
     """
@@ -131,14 +163,21 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
         else:
             raise ValueError(f"Unsupported swizzle mode: {layout}")
 
-    def tcgen05mma(self, A_buf: Buffer, B_buf: Buffer, C_local_buf: Buffer, mbar, clear_accum: PrimExpr = False):
+    def tcgen05mma(
+        self, A_buf: Buffer, B_buf: Buffer, C_local_buf: Buffer, mbar, clear_accum: PrimExpr = False, cta_group: int = 1
+    ):
+        """Issue the MMAs of the tile, ``cta_group=2`` issues the 2-CTA MMAs of a
+        cluster CTA pair, where this CTA holds N / 2 columns of B."""
         if is_tensor_memory(A_buf):
+            assert cta_group == 1, "2-CTA TCGEN5MMA requires A in shared memory"
             return self.tcgen05mma_rs(A_buf, B_buf, C_local_buf, clear_accum)
 
         accum_dtype = self.accum_dtype
         m_dim = self.block_row_warps * self.warp_row_tiles
         micro_size_k = self.micro_size_k
         k_dim, n_dim = self.chunk, self.block_col_warps * self.warp_col_tiles
+        # columns of B held in the shared memory of this CTA
+        b_n_dim = n_dim // cta_group
         scale_in_a = 1
         scale_in_b = 1
 
@@ -152,16 +191,18 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
         elems_in_bits = DataType(self.a_dtype).bits
         elems_in_bytes = elems_in_bits // 8
         a_swizzle_atom_elems = a_swizzle_mode.swizzle_byte_size() // elems_in_bytes
-        b_swizzle_atom_elems = n_dim if b_swizzle_mode.is_none() else b_swizzle_mode.swizzle_byte_size() // elems_in_bytes
+        b_swizzle_atom_elems = b_n_dim if b_swizzle_mode.is_none() else b_swizzle_mode.swizzle_byte_size() // elems_in_bytes
         accum_dtype_in_bits = DataType(accum_dtype).bits
 
-        meta = self.get_tcgen5_mma_meta(m_dim, n_dim, k_dim)
+        meta = self.get_tcgen5_mma_meta(m_dim, n_dim, k_dim, use_2cta=cta_group == 2)
         if len(meta) != 5:
             raise ValueError(
-                f"Unsupported TCGEN5MMA configuration for desc generation: M={m_dim}, N={n_dim}, "
+                f"Unsupported TCGEN5MMA configuration for desc generation: M={m_dim}, N={n_dim}, cta_group={cta_group}, "
                 f"K={k_dim}, A dtype={self.a_dtype}, accum dtype={self.accum_dtype}"
             )
         atom_m, atom_n, atom_k, enable_ws, enable_2cta = (int(x) for x in meta)
+        # columns of an atom taken from the B of this CTA
+        b_atom_n = atom_n // cta_group
 
         # by default, we utilize non-swizzle layout offset
         a_leading_byte_offset = (8 * 8 * elems_in_bytes) if a_is_k_major else (8 * m_dim * elems_in_bytes)
@@ -188,8 +229,8 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
                 else:
                     a_stride_byte_offset = 8 * elems_in_bytes * a_swizzle_atom_elems
 
-        b_leading_byte_offset = (8 * 8 * elems_in_bytes) if b_is_k_major else (8 * n_dim * elems_in_bytes)
-        b_stride_byte_offset = (8 * k_dim * elems_in_bytes) if b_is_k_major else (0 if n_dim == 8 else (8 * 8 * elems_in_bytes))
+        b_leading_byte_offset = (8 * 8 * elems_in_bytes) if b_is_k_major else (8 * b_n_dim * elems_in_bytes)
+        b_stride_byte_offset = (8 * k_dim * elems_in_bytes) if b_is_k_major else (0 if b_n_dim == 8 else (8 * 8 * elems_in_bytes))
         if not b_swizzle_mode.is_none():
             # swizzle mode doesn't require LBO/SBO to be 1
             # https://docs.nvidia.com/cuda/parallel-thread-execution/#asynchronous-warpgroup-level-leading-dimension-byte-offset
@@ -200,13 +241,13 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
                 # MN Major, K * N
                 # LBO represents the distance between two atoms along the N dimension
                 # SBO represents the distance between two atoms along the K dimension
-                b_n_axis_atoms = n_dim // b_swizzle_atom_elems
+                b_n_axis_atoms = b_n_dim // b_swizzle_atom_elems
                 if b_n_axis_atoms <= 1:
                     b_leading_byte_offset = 0
                 else:
                     b_leading_byte_offset = 8 * 8 * elems_in_bytes * k_dim
                 if b_n_axis_atoms <= 1:
-                    b_stride_byte_offset = 8 * elems_in_bytes * n_dim
+                    b_stride_byte_offset = 8 * elems_in_bytes * b_n_dim
                 else:
                     b_stride_byte_offset = 8 * elems_in_bytes * b_swizzle_atom_elems
 
@@ -215,8 +256,9 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
         ak_atom_size = max(a_swizzle_atom_elems // micro_size_k, 1)
         bk_atom_size = max(b_swizzle_atom_elems // micro_size_k, 1)
 
+        # a 2-CTA atom spans the rows of both CTAs
         instr_desc = self.get_tcgen5_instr_desc(
-            atom_m,
+            atom_m * cta_group,
             atom_n,
             atom_k,
             a_is_k_major,
@@ -233,35 +275,6 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
         num_inst_m = self.block_row_warps * self.warp_row_tiles // atom_m
         num_inst_n = self.block_col_warps * self.warp_col_tiles // atom_n
 
-        # Helper to allow BufferRegion/BufferLoad as inputs
-        def access_ptr_from(buffer_or_load_or_region, access_type: str = "r"):
-            if isinstance(buffer_or_load_or_region, Buffer):
-                return buffer_or_load_or_region.access_ptr(access_type)
-            elif isinstance(buffer_or_load_or_region, BufferLoad):
-                buffer_load = buffer_or_load_or_region
-                offset, stride = 0, 1
-                buffer = buffer_load.buffer
-                for i, shape in enumerate(reversed(buffer.shape)):
-                    indice = buffer_load.indices[len(buffer_load.indices) - i - 1]
-                    if isinstance(indice, (tvm.tir.IntImm, tvm.tir.PrimExpr)):
-                        offset += indice * stride
-                    elif isinstance(indice, tvm.tir.Ramp):
-                        offset += indice.base * stride
-                    else:
-                        raise ValueError(f"Unsupported index type: {type(indice)}")
-                    stride *= shape
-                return buffer.access_ptr(access_type, offset=offset)
-            elif isinstance(buffer_or_load_or_region, BufferRegion):
-                buffer_region = buffer_or_load_or_region
-                buffer = buffer_region.buffer
-                offset, stride = 0, 1
-                for i, shape in enumerate(reversed(buffer.shape)):
-                    offset += buffer_region.region[len(buffer_region.region) - i - 1].min * stride
-                    stride *= shape
-                return buffer.access_ptr(access_type, offset=offset)
-            else:
-                raise ValueError(f"Unsupported buffer type: {type(buffer_or_load_or_region)}")
-
         @T.macro
         def _warp_mma(A_buf, B_buf, C_local_buf, mbar):
             # Allocate SMEM descriptors for A and B
@@ -303,12 +316,13 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
                         )
 
                         B_elem_offset = (
-                            (ki // bk_atom_size) * n_dim * b_swizzle_atom_elems
+                            (ki // bk_atom_size) * b_n_dim * b_swizzle_atom_elems
                             + (ki % bk_atom_size) * micro_size_k
-                            + j * atom_n * b_swizzle_atom_elems
+                            + j * b_atom_n * b_swizzle_atom_elems
                             if b_is_k_major
                             else (
-                                ki * b_swizzle_atom_elems * micro_size_k + j * atom_n * (k_dim if n_dim // b_swizzle_atom_elems > 1 else 1)
+                                ki * b_swizzle_atom_elems * micro_size_k
+                                + j * b_atom_n * (k_dim if b_n_dim // b_swizzle_atom_elems > 1 else 1)
                             )
                         )
 
@@ -331,11 +345,136 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
                             mask2,
                             mask3,
                             enable_ws,
+                            cta_group=cta_group,
                         )
-            T.tcgen05_mma_arrive(mbar)
+            T.tcgen05_mma_arrive(mbar, cta_group=cta_group)
 
         return _warp_mma(A_buf, B_buf, C_local_buf, mbar)
 
+    def tcgen05mma_blockscaled(
+        self,
+        A_buf: Buffer,
+        B_buf: Buffer,
+        C_local_buf: Buffer,
+        SFA_buf: Buffer,
+        SFB_buf: Buffer,
+        SFA_tmem: Buffer,
+        SFB_tmem: Buffer,
+        mbar,
+        clear_accum: PrimExpr = False,
+        sf_vec_size: int = 32,
+    ):
+        """Issue the block scaled MMAs of the tile, every ``sf_vec_size``
+        elements of K of a row of A (column of B) sharing the scale factor in
+        ``SFA_buf`` (``SFB_buf``). The scale factors are first copied from
+        shared memory, in the layout of make_tcgen05_scale_factor_layout, into
+        ``SFA_tmem`` and ``SFB_tmem`` with tcgen05.cp.
+
+        A and B are K-major and swizzled, FP8 A/B lower to kind::mxf8f6f4 and
+        FP4 A/B to kind::mxf4nvf4.
+        """
+        m_dim = self.block_row_warps * self.warp_row_tiles
+        k_dim, n_dim = self.chunk, self.block_col_warps * self.warp_col_tiles
+        if self.a_transposed or not self.b_transposed:
+            raise ValueError("Block scaled TCGEN5MMA requires K-major A and B (transpose_A=False, transpose_B=True)")
+
+        meta = self.get_tcgen5_blockscaled_mma_meta(m_dim, n_dim, k_dim, sf_vec_size)
+        if len(meta) != 5:
+            raise ValueError(
+                f"Unsupported block scaled TCGEN5MMA configuration: M={m_dim}, N={n_dim}, K={k_dim}, "
+                f"A dtype={self.a_dtype}, accum dtype={self.accum_dtype}, sf_vec_size={sf_vec_size}, "
+                f"it requires M == 128, N % 128 == 0 and K % {4 * sf_vec_size} == 0"
+            )
+        atom_m, atom_n, atom_k, _, _ = (int(x) for x in meta)
+        is_fp4 = DataType(self.a_dtype).bits == 4
+        kind = "mxf4nvf4" if is_fp4 else "mxf8f6f4"
+        # scale factors of a row of an MMA
+        scale_vec = atom_k // sf_vec_size
+
+        a_swizzle_mode = self._determinate_swizzle_mode(A_buf, self.a_shared_layout)
+        b_swizzle_mode = self._determinate_swizzle_mode(B_buf, self.b_shared_layout)
+        if a_swizzle_mode.is_none() or b_swizzle_mode.is_none():
+            raise ValueError("Block scaled TCGEN5MMA requires swizzled A and B, K must span at least 32 bytes")
+
+        elems_in_bits = DataType(self.a_dtype).bits
+        a_swizzle_atom_elems = a_swizzle_mode.swizzle_byte_size() * 8 // elems_in_bits
+        b_swizzle_atom_elems = b_swizzle_mode.swizzle_byte_size() * 8 // elems_in_bits
+        ak_atom_size = max(a_swizzle_atom_elems // atom_k, 1)
+        bk_atom_size = max(b_swizzle_atom_elems // atom_k, 1)
+
+        num_sf = k_dim // sf_vec_size
+        for sf, rows in ((SFA_buf, m_dim), (SFB_buf, n_dim)):
+            sf_buf = _get_buffer(sf)
+            if [int(x) for x in sf_buf.shape] != [rows, num_sf] or DataType(sf_buf.dtype).bits != 8:
+                raise ValueError(
+                    f"Expected 8-bit scale factors of shape ({rows}, {num_sf}) in {sf_buf.name}, got {sf_buf.dtype} {list(sf_buf.shape)}"
+                )
+        # a chunk of 128 rows x 4 scale factors, 512 bytes of shared memory
+        # and 4 tensor memory columns
+        num_sfa_chunks = num_sf // 4 * (m_dim // 128)
+        num_sfb_chunks = num_sf // 4 * (n_dim // 128)
+        for sf_tmem, num_chunks in ((SFA_tmem, num_sfa_chunks), (SFB_tmem, num_sfb_chunks)):
+            if not is_tensor_memory(sf_tmem) or int(sf_tmem.shape[1]) < num_chunks * 4:
+                raise ValueError(f"{sf_tmem.name} must be a tensor memory buffer of at least {num_chunks * 4} columns")
+        sfa_tmem_layout = make_tcgen05_scale_factor_tmem_layout(m_dim, num_sf)
+        sfb_tmem_layout = make_tcgen05_scale_factor_tmem_layout(n_dim, num_sf)
+
+        instr_desc = self.get_tcgen5_blockscaled_instr_desc(atom_m, atom_n, sf_vec_size)
+        num_inst_n = n_dim // atom_n
+
+        @T.macro
+        def _warp_mma_blockscaled(A_buf, B_buf, C_local_buf, SFA_buf, SFB_buf, SFA_tmem, SFB_tmem, mbar):
+            desc_a = T.alloc_tcgen05_smem_desc()
+            desc_b = T.alloc_tcgen05_smem_desc()
+            desc_sfa = T.alloc_tcgen05_smem_desc()
+            desc_sfb = T.alloc_tcgen05_smem_desc()
+            T.initialize_tcgen05_descriptor(
+                desc_a, access_ptr_from(A_buf, "r"), 1, int(8 * a_swizzle_mode.swizzle_byte_size()) >> 4, 0, False, int(a_swizzle_mode)
+            )
+            T.initialize_tcgen05_descriptor(
+                desc_b, access_ptr_from(B_buf, "r"), 1, int(8 * b_swizzle_mode.swizzle_byte_size()) >> 4, 0, False, int(b_swizzle_mode)
+            )
+            # 32 rows of 16 bytes, 8-row core matrices 128 bytes apart
+            T.initialize_tcgen05_descriptor(desc_sfa, access_ptr_from(SFA_buf, "r"), 0, 128 >> 4, 0, False, int(SwizzleMode.NONE))
+            T.initialize_tcgen05_descriptor(desc_sfb, access_ptr_from(SFB_buf, "r"), 0, 128 >> 4, 0, False, int(SwizzleMode.NONE))
+            for c in T.unroll(num_sfa_chunks):
+                T.ptx_tcgen05_cp(desc_sfa.data, c * 512, SFA_tmem.data, c * 4)
+            for c in T.unroll(num_sfb_chunks):
+                T.ptx_tcgen05_cp(desc_sfb.data, c * 512, SFB_tmem.data, c * 4)
+
+            for j in T.unroll(num_inst_n):
+                for ki in T.unroll(0, k_dim // atom_k):
+                    scale_out = T.Select(ki != 0, 1, T.Select(clear_accum, 0, 1))
+                    A_elem_offset = (ki % ak_atom_size) * atom_k + (ki // ak_atom_size) * m_dim * a_swizzle_atom_elems
+                    B_elem_offset = (
+                        (ki // bk_atom_size) * n_dim * b_swizzle_atom_elems
+                        + (ki % bk_atom_size) * atom_k
+                        + j * atom_n * b_swizzle_atom_elems
+                    )
+                    # first scale factor of the MMA, the sf_id selecting it in
+                    # its 32-bit tensor memory column
+                    _, sfa_col, sf_id = sfa_tmem_layout.map_forward_index([0, ki * scale_vec])
+                    _, sfb_col, _ = sfb_tmem_layout.map_forward_index([j * atom_n, ki * scale_vec])
+                    T.ptx_tcgen05_mma_blockscaled_ss(
+                        kind,
+                        scale_vec,
+                        desc_a.data,
+                        A_elem_offset * elems_in_bits // 8,
+                        desc_b.data,
+                        B_elem_offset * elems_in_bits // 8,
+                        C_local_buf.data,
+                        j * atom_n,
+                        SFA_tmem.data,
+                        sfa_col,
+                        SFB_tmem.data,
+                        sfb_col,
+                        instr_desc + (sf_id << 4) + (sf_id << 29),
+                        scale_out,
+                    )
+            T.tcgen05_mma_arrive(mbar)
+
+        return _warp_mma_blockscaled(A_buf, B_buf, C_local_buf, SFA_buf, SFB_buf, SFA_tmem, SFB_tmem, mbar)
+
     def make_mma_load_layout(self, local_buf: Buffer, matrix: str = "A") -> T.Fragment:
         raise NotImplementedError
 
@@ -407,8 +546,26 @@ class TensorCoreIntrinEmitter(MMAIntrinEmitter):
 
         return Layout([m, n], forward)
 
-    def get_tcgen5_mma_meta(self, m: int, n: int, k: int):
-        return _ffi_api.get_tcgen5_mma_meta(int(m), int(n), int(k), DataType(self.a_dtype), DataType(self.accum_dtype))
+    def get_tcgen5_mma_meta(self, m: int, n: int, k: int, use_2cta: bool = False):
+        return _ffi_api.get_tcgen5_mma_meta(
+            int(m), int(n), int(k), DataType(self.a_dtype), DataType(self.accum_dtype), bool(use_2cta)
+        )
+
+    def get_tcgen5_blockscaled_mma_meta(self, m: int, n: int, k: int, sf_vec_size: int):
+        return _ffi_api.get_tcgen5_blockscaled_mma_meta(
+            int(m), int(n), int(k), DataType(self.a_dtype), DataType(self.accum_dtype), int(sf_vec_size)
+        )
+
+    def get_tcgen5_blockscaled_instr_desc(self, atom_m: int, atom_n: int, sf_vec_size: int) -> PrimExpr:
+        desc = _ffi_api.get_tcgen5_blockscaled_instr_desc(
+            atom_m,
+            atom_n,
+            DataType(self.a_dtype),
+            not self.a_transposed,
+            self.b_transposed,
+            sf_vec_size,
+        )
+        return lift(desc)
 
     def get_tcgen5_instr_desc(
         self, atom_m: int, atom_n: int, atom_k: int, a_is_k_major: bool, b_is_k_major: bool, scale_in_a: int, scale_in_b: int
@@ -19,8 +19,8 @@ class AtomicAdd(Node, Scriptable): ...
 class Copy(Node, Scriptable): ...
 
 
-@tvm_ffi.register_object("tl.Conv2DIm2Col")
-class Conv2DIm2ColOp(Node, Scriptable): ...
+@tvm_ffi.register_object("tl.ConvIm2Col")
+class ConvIm2ColOp(Node, Scriptable): ...
 
 
 @tvm_ffi.register_object("tl.GemmWarpPolicy")
@@ -32,6 +32,14 @@ from tilelang.cache import cached
 from os import path, makedirs
 from logging import getLogger
 from tilelang.jit.param import Kernel
+from tilelang.jit.bucket import BucketedKernel, compile_buckets  # noqa: F401
+from tilelang.jit.multiversion import MultiVersionKernel, compile_multiversion  # noqa: F401
+from tilelang.jit.batch import KernelBatch  # noqa: F401
+from tilelang.jit.background import BackgroundJIT, BackgroundKernel  # noqa: F401
+from tilelang.jit.online import OnlineTunedKernel, compile_online  # noqa: F401
+from tilelang.jit.multi_arch import MultiArchKernel, compile_multi_arch  # noqa: F401
+from tilelang.jit.dispatch import KernelCacheStats, KernelDispatchTable
+from tilelang import env
 import concurrent.futures
 
 from tqdm.auto import tqdm
@@ -253,6 +261,9 @@ class JITImpl(Generic[_P, _KP, _T, _Ret]):
         Directory to save compiled kernel source for debugging.
     compile_flags : list[str] | str | None
         Additional compiler flags.
+    kernel_cache_capacity : int | None
+        Maximum number of compiled kernels kept, the least recently used one
+        being dropped past it. Defaults to TILELANG_KERNEL_CACHE_CAPACITY.
     func_source : str
         Original Python source code of the decorated function.
     signature : inspect.Signature
@@ -271,6 +282,7 @@ class JITImpl(Generic[_P, _KP, _T, _Ret]):
     pass_configs: dict[str, Any] | None
     debug_root_path: str | None
     compile_flags: list[str] | str | None
+    kernel_cache_capacity: int | None
     func_source: str
     signature: inspect.Signature
     mode: Literal["auto", "lazy", "eager"]
@@ -284,9 +296,15 @@ class JITImpl(Generic[_P, _KP, _T, _Ret]):
                 self.debug_root_path = path.join(base_path, self.debug_root_path)
             except NameError:
                 self.debug_root_path = path.abspath(self.debug_root_path)
-        self._kernel_cache: dict[tuple, Kernel] = {}
+        if self.kernel_cache_capacity is None:
+            self.kernel_cache_capacity = env.get_kernel_cache_capacity()
+        self._kernel_cache: KernelDispatchTable = KernelDispatchTable(self.kernel_cache_capacity)
         self._tuner_cache: dict[tuple, Kernel] = {}
 
+    def cache_stats(self) -> KernelCacheStats:
+        """Hits, misses and evictions of the compiled kernels of this function."""
+        return self._kernel_cache.stats()
+
     def get_tir(self, *args: _P.args, **kwargs: _P.kwargs) -> PrimFunc[_KP, _T]:
         """
         Retrieve a TIR (Tensor Intermediate Representation) PrimFunc from the stored callable or object.
@@ -371,7 +389,14 @@ class JITImpl(Generic[_P, _KP, _T, _Ret]):
         )
 
     def compile(self, *args: _P.args, **kwargs: _P.kwargs) -> _Ret:
-        prim_func = self.get_tir(*args, **kwargs)
+        return self.compile_tir(self.get_tir(*args, **kwargs))
+
+    def compile_tir(self, prim_func: PrimFunc[_KP, _T]) -> _Ret:
+        """Compile a PrimFunc obtained from ``get_tir`` with the options of this JIT.
+
+        Unlike ``get_tir``, which traces the decorated function, this does not
+        touch the state of the function and may run off the calling thread.
+        """
         kernel_result = compile(
             prim_func,
             out_idx=self.out_idx,
@@ -462,6 +487,7 @@ def jit(
     pass_configs: dict[str, Any] | None = None,
     debug_root_path: str | None = None,
     compile_flags: list[str] | str | None = None,
+    kernel_cache_capacity: int | None = None,
 ) -> Callable[[Callable[_KP, _T]], JITImpl[_KP, _KP, _T, _T]]: ...
 
 
@@ -476,6 +502,7 @@ def jit(
     pass_configs: dict[str, Any] | None = None,
     debug_root_path: str | None = None,
     compile_flags: list[str] | str | None = None,
+    kernel_cache_capacity: int | None = None,
 ) -> Callable[[Callable[_P, _T]], JITImpl[_KP, _KP, _T, _T]]:
     """
     JIT compiler decorator for TileLang functions.
@@ -502,6 +529,10 @@ def jit(
         Directory to save compiled kernel source for debugging.
     compile_flags : list[str] | str | None
         Additional compiler flags.
+    kernel_cache_capacity : int | None
+        Maximum number of compiled kernels kept by the function, e.g. with
+        dynamic shapes in long-running services. Defaults to
+        TILELANG_KERNEL_CACHE_CAPACITY, no limit when 0.
     """
 
     compile_args = dict(
@@ -513,6 +544,7 @@ def jit(
         pass_configs=pass_configs,
         debug_root_path=debug_root_path,
         compile_flags=compile_flags,
+        kernel_cache_capacity=kernel_cache_capacity,
     )
 
     def decorator(func: Callable[_P, _T]):
@@ -4,3 +4,4 @@ from .cython import CythonKernelAdapter  # noqa: F401
 from .nvrtc import NVRTCKernelAdapter  # noqa: F401
 from .torch import MetalKernelAdapter  # noqa: F401
 from .cutedsl import CuTeDSLKernelAdapter  # noqa: F401
+from .symmetric import SymmetricHeap  # noqa: F401
@@ -5,11 +5,14 @@ from __future__ import annotations
 from abc import ABC, abstractmethod
 from typing import Any, Callable
 from tilelang.engine.param import KernelParam
+from tilelang.jit.adapter.workspace import WorkspaceLayout, make_workspace_layout
 import torch
 
 
 class BaseKernelAdapter(ABC):
     func: Callable | None = None
+    # Serves the T.Workspace parameters of the calls, None without any
+    workspace_layout: WorkspaceLayout | None = None
 
     def __init__(self, mod, params: list[KernelParam], result_idx: list[int]) -> None:
         self.mod = mod
@@ -86,6 +89,26 @@ class BaseKernelAdapter(ABC):
     def __call__(self, *args: Any, **kwds: Any) -> Any:
         return self.func(*args, **kwds)
 
+    def bind(self, *args: Any) -> Callable:
+        """Return a call of the kernel prepared for inputs shaped like ``args``.
+
+        Adapters without a cheaper path for known metadata run the regular
+        call; see ``JITKernel.bind``.
+        """
+        # Called with the workspaces already in place, see JITKernel.bind
+        func = self._inner_func
+
+        def bound(*inputs: Any, **kwds: Any) -> Any:
+            kwds.pop("skip_tensor_validation", None)
+            return func(*inputs, **kwds)
+
+        return bound
+
+    def call_dlpack(self, *inputs: Any, stream: int | None = None) -> Any:
+        """Run the kernel on tensors of any framework implementing DLPack,
+        see ``JITKernel.call_dlpack``."""
+        raise NotImplementedError(f"{type(self).__name__} only takes torch tensors, use the tvm_ffi execution backend")
+
     def get_kernel_source(self, kernel_only: bool = True) -> str:
         if kernel_only:
             return self.mod.imports[0].inspect_source()
@@ -93,4 +116,10 @@ class BaseKernelAdapter(ABC):
             return self.mod.inspect_source() + "\n\n" + self.mod.imports[0].inspect_source()
 
     def _post_init(self):
-        self.func = self._convert_torch_func()
+        self._inner_func = self._convert_torch_func()
+        self.func = self._inner_func
+        self.workspace_layout = make_workspace_layout(
+            self.params, self.result_idx, self.get_current_device_functor(), self.get_current_stream_functor()
+        )
+        if self.workspace_layout is not None:
+            self.func = self.workspace_layout.wrap(self._inner_func)
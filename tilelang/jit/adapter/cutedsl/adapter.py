@@ -243,7 +243,7 @@ class CuTeDSLKernelAdapter(BaseKernelAdapter):
             return
 
         import os
-        import shutil
+        from tilelang.cache.kernel_cache import KernelCache
 
         # Source cubin path (in temp directory)
         src_py_path = self.libpath
@@ -260,9 +260,9 @@ class CuTeDSLKernelAdapter(BaseKernelAdapter):
         if os.path.exists(dst_cubin_path):
             return
 
-        # Copy cubin to cache
+        # Copy cubin to cache, atomically as other processes may load it
         try:
-            shutil.copy2(src_cubin_path, dst_cubin_path)
+            KernelCache._safe_write_file(dst_cubin_path, "wb", lambda file: file.write(KernelCache._load_binary(src_cubin_path)))
             logger.debug(f"Saved CuTeDSL cubin to cache: {dst_cubin_path}")
         except Exception as e:
             logger.warning(f"Failed to save cubin to cache: {e}", exc_info=True)
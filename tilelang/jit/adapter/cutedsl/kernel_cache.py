@@ -14,6 +14,9 @@ class CuTeDSLKernelCache(KernelCache):
     host_kernel_path = "kernel.py"
     launcher_lib_path = "launcher_lib.so"
     launcher_cpp_path = "launcher.cpp"
+    # Sources live in the python launcher module, which is loaded from disk
+    use_cache_index = False
+    compress_sources = False
 
     @override
     def _save_kernel_source_code_to_disk(self, kernel: JITKernel, cache_path: str, verbose: bool = False):
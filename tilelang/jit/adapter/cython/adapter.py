@@ -3,6 +3,7 @@
 from __future__ import annotations
 import ctypes
 import logging
+import threading
 import torch
 
 from typing import Callable, Any
@@ -15,15 +16,17 @@ from tvm.relax import TensorType
 from tilelang.jit.adapter.base import BaseKernelAdapter
 from tilelang.jit.adapter.wrapper import TLWrapper
 from tilelang.jit.adapter.libgen import LibraryGenerator
+from tilelang.jit.adapter.shared_module import load_shared_module
 from tilelang.jit.adapter.utils import is_cuda_target, is_hip_target, is_cpu_target, is_metal_target
 from tilelang.utils.target import determine_target
 from tilelang.utils.language import retrieve_func_from_module
 from tilelang.utils.tensor import map_torch_type
+from tilelang import env
 
 logger = logging.getLogger(__name__)
 
 try:
-    from tilelang_cython_wrapper import CythonKernelWrapper
+    from tilelang_cython_wrapper import CythonKernelWrapper, BoundKernelCall, launch_bound_calls  # noqa: F401
 except ImportError:
     raise
 
@@ -190,26 +193,43 @@ class CythonKernelAdapter(BaseKernelAdapter):
         adapter.lib_generator = LibraryGenerator(adapter.target, verbose=verbose)
         adapter.lib_generator.assign_pass_configs(pass_configs)
         adapter.lib_generator.assign_compile_flags(compile_flags)
-        adapter.lib = adapter.lib_generator.load_lib(lib_path=kernel_lib_path)
-
-        adapter.lib.get_last_error.restype = ctypes.c_char_p
-        result = adapter.lib.init()
-        if result != 0:
-            error_msg = adapter.lib.get_last_error().decode("utf-8")
-            raise RuntimeError(f"Initialization failed: {error_msg}")
-
-        adapter.cython_wrapper = CythonKernelWrapper(adapter.result_idx, adapter.params, adapter.lib)
-        adapter.cython_wrapper.set_dynamic_symbolic_map(adapter.dynamic_symbolic_map)
-        adapter.cython_wrapper.set_buffer_dtype_map(adapter.buffer_dtype_map)
-        adapter.cython_wrapper.set_static_shape_map(adapter.static_shape_map)
-        adapter.cython_wrapper.set_static_strides_map(adapter.static_strides_map)
-        adapter.cython_wrapper.set_static_contiguous_list(adapter.static_contiguous_list)
-        adapter.cython_wrapper.set_buffer_device_map(adapter.buffer_device_map)
-        adapter.cython_wrapper.set_ptr_map(adapter.ptr_map)
+        adapter.lib_generator.libpath = kernel_lib_path
+        adapter.lib = None
+        adapter.cython_wrapper = None
+        adapter._load_lock = threading.Lock()
+        if not env.is_lazy_loading_enabled():
+            adapter._load()
 
         adapter._post_init()
         return adapter
 
+    @staticmethod
+    def _open_lib(lib_path: str) -> ctypes.CDLL:
+        lib = ctypes.CDLL(lib_path)
+        lib.get_last_error.restype = ctypes.c_char_p
+        result = lib.init()
+        if result != 0:
+            error_msg = lib.get_last_error().decode("utf-8")
+            raise RuntimeError(f"Initialization failed: {error_msg}")
+        return lib
+
+    def _load(self) -> CythonKernelWrapper:
+        """Load the library of a kernel restored from the cache, on its first call."""
+        with self._load_lock:
+            if self.cython_wrapper is None:
+                lib = load_shared_module(self.libpath, self._open_lib)
+                cython_wrapper = CythonKernelWrapper(self.result_idx, self.params, lib)
+                cython_wrapper.set_dynamic_symbolic_map(self.dynamic_symbolic_map)
+                cython_wrapper.set_buffer_dtype_map(self.buffer_dtype_map)
+                cython_wrapper.set_static_shape_map(self.static_shape_map)
+                cython_wrapper.set_static_strides_map(self.static_strides_map)
+                cython_wrapper.set_static_contiguous_list(self.static_contiguous_list)
+                cython_wrapper.set_buffer_device_map(self.buffer_device_map)
+                cython_wrapper.set_ptr_map(self.ptr_map)
+                self.lib = lib
+                self.cython_wrapper = cython_wrapper
+        return self.cython_wrapper
+
     def _process_dynamic_symbolic(self) -> dict[tir.Var, tuple[int, int, int]]:
         """Extract information about dynamic shapes from the TIR function.
 
@@ -335,6 +355,8 @@ class CythonKernelAdapter(BaseKernelAdapter):
         """
         ctypes_args = [ctypes.c_void_p(arr.data_ptr()) if not isinstance(arr, int) else arr for arr in args]
         ctypes_args.append(ctypes.c_void_p(stream))
+        if self.lib is None:
+            self._load()
         self.lib.call(*ctypes_args)
 
     def _convert_torch_func(self) -> Callable:
@@ -348,10 +370,23 @@ class CythonKernelAdapter(BaseKernelAdapter):
                 skip_tensor_validation: Whether to skip tensor attributes validation which
                 includes shape, dtype, device, etc.
             """
-            return self.cython_wrapper.forward([*args], stream=stream, skip_tensor_validation=skip_tensor_validation)
+            cython_wrapper = self.cython_wrapper
+            if cython_wrapper is None:
+                cython_wrapper = self._load()
+            return cython_wrapper.forward([*args], stream=stream, skip_tensor_validation=skip_tensor_validation)
 
         return lambda_forward
 
+    def bind(self, *args) -> Callable:
+        """Validate ``args`` once and return a call relaunching with only pointer updates.
+
+        See ``BoundKernelCall`` in cython_wrapper.pyx.
+        """
+        cython_wrapper = self.cython_wrapper
+        if cython_wrapper is None:
+            cython_wrapper = self._load()
+        return cython_wrapper.bind([*args])
+
     @property
     def prim_func(self) -> tir.PrimFunc:
         """Returns the primary TIR function from the IR module."""
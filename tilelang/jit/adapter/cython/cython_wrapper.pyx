@@ -25,6 +25,7 @@ cdef class CythonKernelWrapper:
         list param_dtypes              # Cache for parameter dtypes
         list param_shapes              # Cache for parameter shapes as native Python lists
         object get_current_device
+        readonly int64_t version       # Bumped on every reconfiguration, invalidates bound calls
 
     def __cinit__(self, result_idx, params, lib):
         # Initialize wrapper with kernel configuration
@@ -50,30 +51,37 @@ cdef class CythonKernelWrapper:
 
     def set_dynamic_symbolic_map(self, dynamic_symbolic_map):
         self.dynamic_symbolic_map = dynamic_symbolic_map
+        self.version += 1
         return self
 
     def set_buffer_dtype_map(self, buffer_dtype_map):
         self.buffer_dtype_map = buffer_dtype_map
+        self.version += 1
         return self
 
     def set_static_shape_map(self, static_shape_map):
         self.static_shape_map = static_shape_map
+        self.version += 1
         return self
 
     def set_static_strides_map(self, static_strides_map):
         self.static_strides_map = static_strides_map
+        self.version += 1
         return self
 
     def set_static_contiguous_list(self, static_contiguous_list):
         self.static_contiguous_list = static_contiguous_list
+        self.version += 1
         return self
 
     def set_ptr_map(self, ptr_map):
         self.ptr_map = ptr_map
+        self.version += 1
         return self
 
     def set_buffer_device_map(self, buffer_device_map):
         self.buffer_device_map = buffer_device_map
+        self.version += 1
         return self
 
     cpdef void _check_buffer_device(self, list tensor_list):
@@ -162,12 +170,23 @@ cdef class CythonKernelWrapper:
                 return tensor.device
         return torch.cuda.current_device()
 
-    cpdef forward(self, list inputs, int64_t stream = -1, bint skip_tensor_validation = False):
+    cdef int64_t _current_stream(self, int64_t stream):
+        # Use current CUDA stream if none specified
+        if stream == -1:
+            if torch.cuda.is_available():
+                try:
+                    stream = torch._C._cuda_getCurrentRawStream(torch.cuda.current_device())
+                except ImportError:
+                    stream = torch.cuda.current_stream().cuda_stream
+            else:
+                stream = 0
+        return stream
+
+    cdef list _build_tensor_list(self, list inputs):
         # Validate input dimensions and prepare for kernel execution
         cdef int total_params = len(self.params)
         cdef int total_inputs = len(inputs)
         cdef int total_result_idx = len(self.result_idx)
-        cdef int total_dynamic_symbolics = len(self.dynamic_symbolic_map)
 
         # Ensure the number of inputs matches expected parameter count
         if total_params != total_inputs + total_result_idx:
@@ -175,16 +194,6 @@ cdef class CythonKernelWrapper:
                 f"Expected {len(self.params)} inputs, got {len(inputs) + len(self.result_idx)} with {len(inputs)} inputs and {len(self.result_idx)} outputs"
             )
 
-        # Use current CUDA stream if none specified
-        if stream == -1:
-            if torch.cuda.is_available():
-                try:
-                    stream = torch._C._cuda_getCurrentRawStream(torch.cuda.current_device())
-                except ImportError:
-                    stream = torch.cuda.current_stream().cuda_stream
-            else:
-                stream = 0
-
         cdef int ins_idx = 0
         cdef list tensor_list = []
         device = None
@@ -227,7 +236,9 @@ cdef class CythonKernelWrapper:
                                      f"overlap={torch._debug_has_internal_overlap(base_tensor)}) as the kernel input")
             '''
             tensor_list.append(tensor)
+        return tensor_list
 
+    cdef list _make_call_args(self, list tensor_list, int64_t stream):
         # Convert tensor pointers to C void pointers for kernel call
         cdef dict dtype_to_ctype = {
             torch.float16: ctypes.c_float,
@@ -257,14 +268,6 @@ cdef class CythonKernelWrapper:
             else:
                 raise ValueError(f"Unsupported tensor type: {type(tensor)}")
 
-        # Check buffer device
-        if not skip_tensor_validation:
-            self._check_buffer_device(tensor_list)
-            self._check_buffer_dtype(tensor_list)
-            self._check_static_shape(tensor_list)
-            self._check_static_strides(tensor_list)
-            self._check_static_contiguous(tensor_list)
-
         # Add dynamic dimension values to kernel arguments
         for _, (ref_id, buffer_idx, shape_idx) in self.dynamic_symbolic_map.items():
             if ref_id == 0:
@@ -274,15 +277,136 @@ cdef class CythonKernelWrapper:
 
         # Add CUDA stream to kernel arguments
         call_args.append(ctypes.c_void_p(stream))
+        return call_args
+
+    cdef void _validate(self, list tensor_list):
+        self._check_buffer_device(tensor_list)
+        self._check_buffer_dtype(tensor_list)
+        self._check_static_shape(tensor_list)
+        self._check_static_strides(tensor_list)
+        self._check_static_contiguous(tensor_list)
 
+    cdef object _launch(self, list call_args):
         # Execute the kernel
         result = self.lib.call(*call_args)
         if result != 0:
             error_msg = self.lib.get_last_error().decode('utf-8')
             raise RuntimeError(f"Kernel call failed: {error_msg}")
 
+    cpdef forward(self, list inputs, int64_t stream = -1, bint skip_tensor_validation = False):
+        stream = self._current_stream(stream)
+        cdef list tensor_list = self._build_tensor_list(inputs)
+        cdef list call_args = self._make_call_args(tensor_list, stream)
+
+        # Check buffer device
+        if not skip_tensor_validation:
+            self._validate(tensor_list)
+
+        self._launch(call_args)
+
         # Return output tensor(s)
         if len(self.result_idx) == 1:
             return tensor_list[self.result_idx[0]]
         else:
             return [tensor_list[i] for i in self.result_idx]
+
+    cpdef bind(self, list inputs):
+        """Validate the metadata of `inputs` once and return a BoundKernelCall."""
+        cdef list tensor_list = self._build_tensor_list(inputs)
+        self._validate(tensor_list)
+        return BoundKernelCall(self, tensor_list, self._make_call_args(tensor_list, 0))
+
+
+cdef tuple _tensor_signature(tensor):
+    return (tensor.dtype, tensor.device, tuple(tensor.shape), tensor.stride())
+
+
+cdef class BoundKernelCall:
+    """A kernel call whose arguments were validated and packed once.
+
+    Re-launching only rewrites the data pointers and scalars of the packed
+    arguments in place. Unless `skip_tensor_validation` is set, the inputs
+    are checked against the metadata validated at bind time, a tuple
+    comparison per tensor instead of the full validation of `forward`. The
+    version stamp of the wrapper is checked on every call, so a bound call
+    never outlives a reconfiguration of its kernel.
+    """
+    cdef:
+        CythonKernelWrapper wrapper
+        int64_t version
+        list call_args      # Packed arguments, updated in place
+        list input_params   # Param index of each input
+        list signatures     # Metadata of each input, None for scalars
+        list outputs        # (param index, shape, dtype, device) of each output
+        int stream_idx      # Position of the stream in call_args
+
+    def __cinit__(self, CythonKernelWrapper wrapper, list tensor_list, list call_args):
+        self.wrapper = wrapper
+        self.version = wrapper.version
+        self.call_args = call_args
+        self.stream_idx = len(call_args) - 1
+        self.input_params = []
+        self.signatures = []
+        self.outputs = []
+        for i, tensor in enumerate(tensor_list):
+            if i in wrapper.result_idx:
+                self.outputs.append((i, tuple(tensor.shape), tensor.dtype, tensor.device))
+                continue
+            self.input_params.append(i)
+            self.signatures.append(_tensor_signature(tensor) if isinstance(tensor, torch.Tensor) else None)
+
+    def __call__(self, *inputs, int64_t stream = -1, bint skip_tensor_validation = False):
+        return self.launch(inputs, self.wrapper._current_stream(stream), skip_tensor_validation)
+
+    cpdef object launch(self, tuple inputs, int64_t stream, bint skip_tensor_validation):
+        """Launch on the raw `stream` handle, -1 not being resolved here."""
+        if self.wrapper.version != self.version:
+            raise RuntimeError("The kernel was reconfigured after this call was bound, bind it again")
+        if len(inputs) != len(self.input_params):
+            raise ValueError(f"Expected {len(self.input_params)} inputs, got {len(inputs)}")
+        cdef list call_args = self.call_args
+        cdef int k
+        for k in range(len(inputs)):
+            tensor = inputs[k]
+            signature = self.signatures[k]
+            if signature is None:
+                call_args[self.input_params[k]].value = tensor
+                continue
+            if not skip_tensor_validation and _tensor_signature(tensor) != signature:
+                raise ValueError(
+                    f"Input {k} has metadata {_tensor_signature(tensor)}, but the call was bound "
+                    f"for {signature}, bind it again"
+                )
+            call_args[self.input_params[k]].value = tensor.data_ptr()
+
+        cdef list results = []
+        for i, shape, dtype, device in self.outputs:
+            tensor = torch.empty(shape, dtype=dtype, device=device)
+            call_args[i].value = tensor.data_ptr()
+            results.append(tensor)
+        call_args[self.stream_idx].value = stream
+        self.wrapper._launch(call_args)
+
+        if len(results) == 1:
+            return results[0]
+        return results
+
+
+def launch_bound_calls(list calls, list inputs, int64_t stream = -1, bint skip_tensor_validation = False):
+    """Launch `calls[k](*inputs[k])` in order on one stream, in a single call from Python.
+
+    The stream is resolved once for the whole batch, -1 standing for the
+    current stream. Returns the outputs of every call.
+    """
+    if len(calls) != len(inputs):
+        raise ValueError(f"Got {len(calls)} bound calls but {len(inputs)} argument lists")
+    if not calls:
+        return []
+    cdef BoundKernelCall call = calls[0]
+    stream = call.wrapper._current_stream(stream)
+    cdef list results = []
+    cdef int k
+    for k in range(len(calls)):
+        call = calls[k]
+        results.append(call.launch(tuple(inputs[k]), stream, skip_tensor_validation))
+    return results
@@ -2,8 +2,10 @@ from __future__ import annotations
 import ctypes
 import logging
 import os
+import platform
 import subprocess
 import tempfile
+import time
 from typing import Any
 
 from tvm.target import Target
@@ -12,6 +14,7 @@ from tilelang import tvm as tvm
 from tilelang.transform import PassConfigKey
 from tilelang.contrib.nvcc import get_nvcc_compiler, get_target_arch, get_target_compute_version
 from tilelang.contrib.rocm import find_rocm_path, get_rocm_arch
+from tilelang.engine.compile_profile import add_nvcc_time_option, record_device_compile
 from tilelang.env import TILELANG_TEMPLATE_PATH
 
 from .utils import is_cpu_target, is_cuda_target, is_hip_target
@@ -62,7 +65,8 @@ class LibraryGenerator:
             enable_fast_math = self.pass_configs.get(PassConfigKey.TL_ENABLE_FAST_MATH, False)
 
             ptxas_usage_level = self.pass_configs.get(PassConfigKey.TL_PTXAS_REGISTER_USAGE_LEVEL, None)
-            verbose_ptxas_output = self.pass_configs.get(PassConfigKey.TL_ENABLE_PTXAS_VERBOSE_OUTPUT, False)
+            fast_compile = self.pass_configs.get(PassConfigKey.TL_FAST_COMPILE, False)
+            verbose_ptxas_output = self.pass_configs.get(PassConfigKey.TL_ENABLE_PTXAS_VERBOSE_OUTPUT, False) and not fast_compile
 
             command = [
                 get_nvcc_compiler(),
@@ -72,13 +76,16 @@ class LibraryGenerator:
                 "--diag_suppress=177",
                 "--compiler-options",
                 "-fPIC",
-                "-lineinfo",
                 "--shared",
                 src.name,
                 "-lcuda",
                 "-gencode",
                 f"arch=compute_{target_arch},code=sm_{target_arch}",
             ]
+            if fast_compile:
+                command += ["-O1", "--ptxas-options=-O1"]
+            else:
+                command += ["-lineinfo"]
             if enable_fast_math:
                 command += ["--use_fast_math"]
             if ptxas_usage_level is not None:
@@ -113,7 +120,13 @@ class LibraryGenerator:
             src = tempfile.NamedTemporaryFile(mode="w", suffix=".cpp", delete=False)  # noqa: SIM115
             libpath = src.name.replace(".cpp", ".so")
 
-            command = [get_cplus_compiler(), "-std=c++17", "-fPIC", "-shared", src.name]
+            command = [get_cplus_compiler(), "-std=c++17", "-O3", "-fPIC", "-shared", src.name]
+            if (self.pass_configs or {}).get(PassConfigKey.TL_ENABLE_CPU_PARALLEL_GRID, False):
+                command += ["-fopenmp"]
+            mcpu = target.attrs.get("mcpu", "")
+            if mcpu:
+                # Compile for the ISA the vectorize planner sized the loops for.
+                command += [("-march=" if platform.machine() in ("x86_64", "AMD64", "i686") else "-mcpu=") + mcpu]
             command += [
                 "-I" + TILELANG_TEMPLATE_PATH,
             ]
@@ -132,12 +145,15 @@ class LibraryGenerator:
         src.write(self.lib_code)
         src.flush()
 
+        time_table = add_nvcc_time_option(command) if is_cuda_target(target) else None
         try:
             if verbose:
                 print(f"compile_lib compilation command: {' '.join(command)}")
+            start = time.perf_counter()
             ret = subprocess.run(command, timeout=timeout)
         except Exception as e:
             raise RuntimeError(f"Compile kernel failed because of {e}") from e
+        record_device_compile(os.path.basename(command[0]), (time.perf_counter() - start) * 1e3, time_table)
 
         if ret.returncode != 0:
             raise RuntimeError(f"Compilation Failed! {command}\n {self.lib_code}")
@@ -86,7 +86,6 @@ class NVRTCKernelAdapter(BaseKernelAdapter):
         self.lib_generator.assign_compile_flags(compile_flags)
         self.lib_generator.compile_lib()
         self.lib_generator.load_lib()
-        self.libpath = self.lib_generator.libpath
         self.pymodule = self.lib_generator.pymodule
         culib = self.lib_generator.culib
         for name in self.function_names:
@@ -154,6 +153,19 @@ class NVRTCKernelAdapter(BaseKernelAdapter):
         adapter._post_init()
         return adapter
 
+    @property
+    def libpath(self) -> str:
+        """Path of the cubin, with its .py launcher next to it.
+
+        A fresh compile is loaded from memory, so the files are only written
+        on first access.
+        """
+        return self.lib_generator.save_files()
+
+    @property
+    def cubin(self) -> bytes:
+        return self.lib_generator.cubin
+
     def _process_dynamic_symbolic(self) -> dict[tir.Var, tuple[int, int]]:
         """Extract information about dynamic shapes from the TIR function.
 
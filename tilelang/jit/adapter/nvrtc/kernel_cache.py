@@ -9,10 +9,13 @@ class NVRTCKernelCache(KernelCache):
     kernel_py_path = "kernel.py"
 
     def _save_so_cubin_to_disk(self, kernel: JITKernel, cache_path: str, verbose: bool = False):
-        src_lib_path = kernel.adapter.libpath
+        # Written from memory, the adapter never put them in a temp file.
+        lib_generator = kernel.adapter.lib_generator
         kernel_py_path = os.path.join(cache_path, self.kernel_py_path)
-        src_lib_path = src_lib_path.replace(".cubin", ".py")
         if verbose:
             self.logger.debug(f"Saving kernel nvrtc python code to file: {kernel_py_path}")
-        KernelCache._safe_write_file(kernel_py_path, "wb", lambda file: file.write(KernelCache._load_binary(src_lib_path)))
-        super()._save_so_cubin_to_disk(kernel, cache_path, verbose)
+        KernelCache._safe_write_file(kernel_py_path, "w", lambda file: file.write(lib_generator.host_func))
+        kernel_lib_path = os.path.join(cache_path, self.kernel_lib_path)
+        if verbose:
+            self.logger.debug(f"Saving kernel library to file: {kernel_lib_path}")
+        KernelCache._safe_write_file(kernel_lib_path, "wb", lambda file: file.write(lib_generator.cubin))
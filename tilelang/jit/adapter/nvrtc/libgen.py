@@ -12,13 +12,18 @@ Key responsibilities:
 - Generate accompanying Python launcher code
 - Load compiled cubin and extract kernel handles
 - Manage library lifecycle (load/unload)
+
+A fresh compile never touches the filesystem: the cubin is loaded from memory
+and the launcher is executed from its source. The headers are precompiled once
+into a persistent cache (see `tilelang.contrib.nvrtc.get_pch_dir`), so only the
+kernel itself is parsed on a cold JIT.
 """
 
 from __future__ import annotations
 import importlib
 import logging
+import os
 import os.path as osp
-import platform
 import tempfile
 from types import ModuleType
 
@@ -33,7 +38,7 @@ logger = logging.getLogger(__name__)
 
 if is_nvrtc_available:
     import cuda.bindings.driver as cuda
-    from tilelang.contrib.nvrtc import compile_cuda
+    from tilelang.contrib.nvrtc import compile_cuda, get_include_options, get_pch_dir
 else:
     raise ImportError(NVRTC_UNAVAILABLE_MESSAGE)
 
@@ -47,18 +52,22 @@ class NVRTCLibraryGenerator(LibraryGenerator):
         3. pymodule.call(): Execute kernels via Python launcher
         4. __del__: Cleanup (unload library)
 
-    Why three files (cu, cubin, py):
-        - .cu: Source for debugging, kept in temp directory
+    Artifacts are kept in memory. The (cu, cubin, py) files are only written
+    by save_files(), when a consumer asks for a path (kernel cache, bundles,
+    debugging):
+        - .cu: Source for debugging
         - .cubin: Compiled binary, loaded by CUDA driver
         - .py: Launch code, imported as Python module
 
     Attributes:
         host_func: Generated Python launch code (from wrapper)
+        cubin: Compiled binary
         culib: CUDA library handle (CUlibrary)
         pymodule: Imported Python module containing call() function
     """
 
     host_func: str | None = None
+    cubin: bytes | None = None
     culib: cuda.CUlibrary | None = None
     pymodule: ModuleType | None = None
     pypath: str | None = None
@@ -93,6 +102,13 @@ class NVRTCLibraryGenerator(LibraryGenerator):
         spec.loader.exec_module(module)
         return module
 
+    @staticmethod
+    def import_from_source(module_name, source):
+        """Executes the generated launcher code as a module, without a file."""
+        module = ModuleType(module_name)
+        exec(compile(source, f"<{module_name}>", "exec"), module.__dict__)
+        return module
+
     def update_host_func(self, host_func: str):
         """Store generated Python launch code for later file write.
 
@@ -115,19 +131,25 @@ class NVRTCLibraryGenerator(LibraryGenerator):
         If not, use torch.cuda.synchronize() to establish context.
 
         Args:
-            lib_path: Path to .cubin file (optional, uses self.libpath if None)
+            lib_path: Path to a .cubin file with its .py launcher next to it,
+                e.g. in the kernel cache. If None, the artifacts of
+                compile_lib() are loaded from memory.
 
         Side effects:
             - Sets self.pymodule to imported Python module
             - Sets self.culib to CUDA library handle
         """
-        if lib_path is None:
-            lib_path = self.libpath
-        else:
+        if lib_path is not None:
             self.libpath = lib_path
+            self.pypath = lib_path.replace(".cubin", ".py")
+            with open(lib_path, "rb") as f:
+                self.cubin = f.read()
+            with open(self.pypath) as f:
+                self.host_func = f.read()
+        if self.cubin is None or self.host_func is None:
+            raise RuntimeError("No cubin to load, please call compile_lib() first or pass lib_path.")
 
-        self.pypath = lib_path.replace(".cubin", ".py")
-        self.pymodule = self.import_from_file("kernel", self.pypath)
+        self.pymodule = self.import_from_source("kernel", self.host_func)
 
         # Ensure the context is valid
         ctx = cuda.cuCtxGetCurrent()[1]
@@ -136,92 +158,56 @@ class NVRTCLibraryGenerator(LibraryGenerator):
 
             torch.cuda.synchronize()
 
-        result, self.culib = cuda.cuLibraryLoadFromFile(bytes(lib_path, "utf-8"), [], [], 0, [], [], 0)
+        result, self.culib = cuda.cuLibraryLoadData(self.cubin, [], [], 0, [], [], 0)
         if result != cuda.CUresult.CUDA_SUCCESS:
-            raise RuntimeError(f"Failed to load library: {lib_path}, error: {result}")
+            raise RuntimeError(f"Failed to load library: {lib_path or '<memory>'}, error: {result}")
+
+    def save_files(self) -> str:
+        """Writes the .cu, .cubin and .py artifacts once and returns the .cubin path."""
+        if self.libpath is not None and osp.exists(self.libpath):
+            return self.libpath
+        if self.cubin is None or self.host_func is None:
+            raise RuntimeError("No cubin to save, please call compile_lib() first.")
+        fd, srcpath = tempfile.mkstemp(suffix=".cu")
+        with os.fdopen(fd, "w") as f:
+            f.write(self.lib_code or "")
+        self.srcpath = srcpath
+        self.libpath = srcpath.replace(".cu", ".cubin")
+        self.pypath = srcpath.replace(".cu", ".py")
+        with open(self.libpath, "wb") as f:
+            f.write(self.cubin)
+        with open(self.pypath, "w") as f:
+            f.write(self.host_func)
+        return self.libpath
 
     def compile_lib(self, timeout: float | None = None):
-        """Compile CUDA source to cubin using NVRTC and write output files.
+        """Compile CUDA source to an in-memory cubin using NVRTC.
 
-        Output artifacts (all in temp directory):
-            - .cu: Source code (for debugging)
-            - .cubin: Compiled binary (for execution)
-            - .py: Python launcher (for calling kernels)
+        Nothing is written to disk, see save_files().
 
-        Include paths setup:
+        Include paths setup (see `tilelang.contrib.nvrtc.get_include_options`):
             - TileLang templates: kernel primitives and utilities
             - CUTLASS: optimized GEMM/tensor ops
             - CUDA headers: driver/runtime APIs
 
-        Why architecture detection:
-            ARM64 servers (SBSA) have different header paths than x86_64.
-
         Args:
             timeout: Compilation timeout in seconds (currently unsupported by NVRTC compiler)
 
         Side effects:
-            - Writes .cu, .cubin, .py files to temp directory
-            - Sets self.srcpath, self.libpath, self.pypath
+            - Sets self.cubin
         """
         target = self.target
         verbose = self.verbose
         if is_cuda_target(target):
-            from tilelang.env import CUDA_HOME, CUTLASS_INCLUDE_DIR, TILELANG_TEMPLATE_PATH
-
-            src = tempfile.NamedTemporaryFile(mode="w", suffix=".cu", delete=False)
-            libpath = src.name.replace(".cu", ".cubin")
-
-            project_root = osp.join(osp.dirname(__file__), "..", "..")
-            if CUTLASS_INCLUDE_DIR is None:
-                cutlass_path = osp.abspath(osp.join(project_root, "3rdparty/cutlass/include"))
-            else:
-                cutlass_path = CUTLASS_INCLUDE_DIR
-
-            if TILELANG_TEMPLATE_PATH is None:
-                tl_template_path = osp.abspath(osp.join(project_root, "src"))
-            else:
-                tl_template_path = TILELANG_TEMPLATE_PATH
-
-            cuda_home = CUDA_HOME if CUDA_HOME else "/usr/local/cuda"
-            __CUDACC_VER_MAJOR__ = cuda.CUDA_VERSION // 1000
-
-            # Determine target architecture
-            machine = platform.machine()
-            target_arch = "sbsa-linux" if machine in ("aarch64", "arm64") else "x86_64-linux"
-
-            options = [
-                f"-I{tl_template_path}",
-                f"-I{cutlass_path}",
-                f"-I{cuda_home}/include",
-                f"-I{cuda_home}/targets/{target_arch}/include",
-                f"-I{cuda_home}/targets/{target_arch}/include/cccl",
-                f"-D__CUDACC_VER_MAJOR__={__CUDACC_VER_MAJOR__}",
-            ]
-
-            # Add CUDA C++ standard library include path.
-            # CUDA 13+ uses the CCCL-based cuda::std layout, while older versions use the legacy path.
-            if __CUDACC_VER_MAJOR__ >= 13:
-                options += [f"-I{cuda_home}/targets/{target_arch}/include/cccl/cuda/std"]
-            else:
-                options += [f"-I{cuda_home}/targets/{target_arch}/include/cuda/std"]
+            options = get_include_options()
 
             if self.compile_flags:
                 options += [item for flag in self.compile_flags for item in flag.split() if item not in options]
 
-            cubin_bytes = compile_cuda(self.lib_code, target_format="cubin", options=options, verbose=verbose)
-            with open(libpath, "wb") as f:
-                f.write(cubin_bytes)
-
-            src.write(self.lib_code)
-            src.flush()
-
-            self.srcpath = src.name
-            self.libpath = libpath
-            self.pypath = src.name.replace(".cu", ".py")
             if self.host_func is None:
                 raise RuntimeError("Host function is not set, please call update_host_func() first.")
-            with open(self.pypath, "w") as f:
-                f.write(self.host_func)
+            self.cubin = compile_cuda(self.lib_code, target_format="cubin", options=options, verbose=verbose, pch_dir=get_pch_dir([str(target), *options]))
+            self.srcpath = self.libpath = self.pypath = None
         else:
             raise ValueError(f"Unsupported target: {target}")
 
@@ -48,6 +48,8 @@ from cuda.bindings.driver import (
 import ctypes
 
 _function_names = {}
+# (kernel, device) pairs whose function attributes are set
+_configured_attributes = set()
 
 def call({}):
     {}
@@ -130,11 +132,10 @@ L2_PERSISTENT_MAP_CREATE_HANDLE_PY = """
         cuCtxGetLimit,
         cuCtxSetLimit,
         cuStreamSetAttribute,
-        cuCtxResetPersistingL2Cache,
     )
 
     stream_attribute = CUstreamAttrValue()
-    res, init_persisting_l2_cache_size = cuCtxGetLimit(CUlimit.CU_LIMIT_PERSISTING_L2_CACHE_SIZE)
+    res, persisting_l2_cache_size = cuCtxGetLimit(CUlimit.CU_LIMIT_PERSISTING_L2_CACHE_SIZE)
     if res != CUresult.CUDA_SUCCESS:
         raise RuntimeError(f"Failed to get L2 cache size limit: {{res}}")
 """
@@ -144,9 +145,11 @@ L2_PERSISTENT_MAP_INIT_FUNC_PY = """
     stream_attribute.accessPolicyWindow.hitProp = CUaccessProperty.CU_ACCESS_PROPERTY_PERSISTING
     stream_attribute.accessPolicyWindow.missProp = CUaccessProperty.CU_ACCESS_PROPERTY_STREAMING
 
-    res = cuCtxSetLimit(CUlimit.CU_LIMIT_PERSISTING_L2_CACHE_SIZE, {2})[0]
-    if res != CUresult.CUDA_SUCCESS:
-        raise RuntimeError(f"Failed to set L2 cache size limit: {{res}}")
+    if persisting_l2_cache_size < {2}:
+        persisting_l2_cache_size = {2}
+        res = cuCtxSetLimit(CUlimit.CU_LIMIT_PERSISTING_L2_CACHE_SIZE, persisting_l2_cache_size)[0]
+        if res != CUresult.CUDA_SUCCESS:
+            raise RuntimeError(f"Failed to set L2 cache size limit: {{res}}")
 
     stream_attribute.accessPolicyWindow.base_ptr = {0}.data_ptr()
     stream_attribute.accessPolicyWindow.num_bytes = {2}
@@ -161,14 +164,6 @@ L2_PERSISTENT_MAP_RESET_HANDLE_PY = """
     res = cuStreamSetAttribute(stream, CUstreamAttrID.CU_LAUNCH_ATTRIBUTE_ACCESS_POLICY_WINDOW, stream_attribute)[0]
     if res != CUresult.CUDA_SUCCESS:
         raise RuntimeError(f"Failed to reset stream L2 access policy: {{res}}")
-
-    res = cuCtxResetPersistingL2Cache()[0]
-    if res != CUresult.CUDA_SUCCESS:
-        raise RuntimeError(f"Failed to reset L2 cache: {{res}}")
-
-    res = cuCtxSetLimit(CUlimit.CU_LIMIT_PERSISTING_L2_CACHE_SIZE, init_persisting_l2_cache_size)[0]
-    if res != CUresult.CUDA_SUCCESS:
-        raise RuntimeError(f"Failed to restore L2 cache size limit: {{res}}")
 """
 
 PDL_SYNC_PY = """
@@ -182,14 +177,12 @@ PDL_SYNC_PY = """
 """
 
 KERNEL_LAUNCH_FUNC_PY = """
-    res = cuKernelSetAttribute(
-        CUfunction_attribute.CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES,
-        {7},
-        kernels["{0}"],
-        CUdevice({10})
-    )[0]
-    if res != CUresult.CUDA_SUCCESS:
-        raise RuntimeError(f"Failed to set max dynamic shared memory size to {7} for kernel {0}: {{res}}")
+    if ("{0}", {10}) not in _configured_attributes:
+        for attribute, value in {12}:
+            res = cuKernelSetAttribute(getattr(CUfunction_attribute, attribute), value, kernels["{0}"], CUdevice({10}))[0]
+            if res != CUresult.CUDA_SUCCESS:
+                raise RuntimeError(f"Failed to set {{attribute}} to {{value}} for kernel {0}: {{res}}")
+        _configured_attributes.add(("{0}", {10}))
 
     config = CUlaunchConfig()
     config.gridDimX = {1}
@@ -432,6 +425,7 @@ class TLNVRTCSourceWrapper(TLCUDASourceWrapper):
                 arg_types,
                 device_index,
                 pdl_sync_code,
+                repr(self.get_kernel_attributes(function_name)),
             )
 
         # Reset L2 persistent map after all kernel execution
@@ -442,6 +436,17 @@ class TLNVRTCSourceWrapper(TLCUDASourceWrapper):
         host_func = PREDEF_HOST_FUNC_PY.format(repr(list(function_informations.keys())), def_args, kernel_launch_code)
         return host_func
 
+    def get_kernel_attributes(self, function_name: str) -> list[tuple[str, int]]:
+        """Function attributes of a kernel, set once per device before its first launch."""
+        dynamic_smem_buf = self.dynamic_smem_buf[function_name]
+        attributes = [("CU_FUNC_ATTRIBUTE_MAX_DYNAMIC_SHARED_SIZE_BYTES", 0 if dynamic_smem_buf is None else dynamic_smem_buf)]
+        if self._cluster_size(function_name) > 8:
+            attributes.append(("CU_FUNC_ATTRIBUTE_NON_PORTABLE_CLUSTER_SIZE_ALLOWED", 1))
+        carveout = self._preferred_carveout(function_name)
+        if carveout is not None:
+            attributes.append(("CU_FUNC_ATTRIBUTE_PREFERRED_SHARED_MEMORY_CARVEOUT", carveout))
+        return attributes
+
     def generate_l2_persistent_map(self, function_name: str) -> str:
         """Generate Python code to configure L2 cache persistence for a kernel.
 
@@ -0,0 +1,46 @@
+"""Kernel libraries shared by the adapters of a process.
+
+Adapters restored from the kernel cache do not load their library when they
+are created but on their first call, so that the startup time and the host
+and device memory of a process grow with the kernels it runs rather than the
+kernels it ships. With ``CUDA_MODULE_LOADING=LAZY``, the default of recent
+CUDA runtimes and set by torch, the device code of a library is itself only
+loaded on a device when one of its kernels first runs there, and the
+function attributes are set on that first launch as well.
+
+A library is loaded once per process: every ``JITKernel`` restored from the
+same cache entry shares the loaded module, e.g. across the kernel caches of
+several ``@tilelang.jit`` functions.
+"""
+
+from __future__ import annotations
+
+import os
+import threading
+from typing import Any, Callable
+
+_modules: dict[tuple[str, int], Any] = {}
+_lock = threading.Lock()
+
+
+def load_shared_module(path: str, loader: Callable[[str], Any]) -> Any:
+    """Load the library at `path` with `loader`, once per process and artifact.
+
+    The artifact is identified by the real path and the modification time of
+    the file, a rewritten cache entry is loaded again.
+    """
+    real_path = os.path.realpath(path)
+    key = (real_path, os.stat(real_path).st_mtime_ns)
+    module = _modules.get(key)
+    if module is None:
+        with _lock:
+            module = _modules.get(key)
+            if module is None:
+                module = loader(real_path)
+                _modules[key] = module
+    return module
+
+
+def num_shared_modules() -> int:
+    """Number of kernel libraries loaded through `load_shared_module`."""
+    return len(_modules)
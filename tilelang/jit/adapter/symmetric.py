@@ -0,0 +1,93 @@
+"""Symmetric tensors shared between the ranks of a node through CUDA IPC.
+
+A ``SymmetricHeap`` is one device allocation per rank, mapped into every
+other rank of the process group. Tensors are carved out of it at the same
+offset on every rank, each preceded by the table of the addresses of the
+same tensor on all ranks, as mapped into this process, which
+``T.put``/``T.get``/``T.signal`` read on the device
+(``tl_templates/cuda/symm.h``). Kernels thus take symmetric tensors as plain
+tensors and need nothing from the launcher.
+"""
+
+from __future__ import annotations
+
+import torch
+import torch.distributed as dist
+
+
+class SymmetricHeap:
+    """Bump allocator of symmetric tensors over a heap mapped on every rank.
+
+    Every rank must allocate the same tensors in the same order, and pass the
+    tensors themselves (not views at an offset) to kernels, which find the
+    peer table right before their data.
+
+    Example:
+        >>> heap = SymmetricHeap(1 << 26)
+        >>> y = heap.tensor((world_size, M, N), torch.float16)
+        >>> flags = heap.tensor((world_size,), torch.uint64)
+        >>> heap.barrier()
+        >>> kernel(x, y, flags, rank)
+    """
+
+    # Bytes before the data of a tensor, holding its peer table and keeping
+    # the data 128-byte aligned
+    HEADER_BYTES = 128
+    # Entries of a peer table, see tl::kSymmMaxPeers
+    MAX_PEERS = 8
+    ALIGNMENT = 128
+
+    def __init__(self, size: int, group: dist.ProcessGroup | None = None, device: torch.device | None = None):
+        if not dist.is_initialized():
+            raise RuntimeError("SymmetricHeap requires an initialized torch.distributed process group")
+        self.group = group
+        self.rank = dist.get_rank(group)
+        self.world_size = dist.get_world_size(group)
+        if self.world_size > self.MAX_PEERS:
+            raise ValueError(f"SymmetricHeap supports up to {self.MAX_PEERS} ranks, got {self.world_size}")
+        self.device = torch.device("cuda", torch.cuda.current_device()) if device is None else torch.device(device)
+        self.size = size
+        self._heap = torch.zeros(size, dtype=torch.uint8, device=self.device)
+        handle = self._heap.untyped_storage()._share_cuda_()
+        handles = [None] * self.world_size
+        dist.all_gather_object(handles, (handle, self._heap.storage_offset()), group=group)
+        # Keep the mappings of the peers alive as long as the heap
+        self._peers = []
+        self.bases = []
+        for peer, (peer_handle, storage_offset) in enumerate(handles):
+            if peer == self.rank:
+                self.bases.append(self._heap.data_ptr())
+                continue
+            storage = torch.UntypedStorage._new_shared_cuda(*peer_handle)
+            self._peers.append(storage)
+            self.bases.append(storage.data_ptr() + storage_offset)
+        self._cursor = 0
+
+    def tensor(self, shape, dtype: torch.dtype) -> torch.Tensor:
+        """Zero-initialized symmetric tensor, at the same offset on every rank."""
+        shape = (shape,) if isinstance(shape, int) else tuple(shape)
+        numel = 1
+        for extent in shape:
+            numel *= extent
+        nbytes = numel * torch.empty((), dtype=dtype).element_size()
+        offset = self._cursor + self.HEADER_BYTES
+        offset = (offset + self.ALIGNMENT - 1) // self.ALIGNMENT * self.ALIGNMENT
+        if offset + nbytes > self.size:
+            raise MemoryError(f"SymmetricHeap of {self.size} bytes cannot fit {nbytes} more bytes at offset {offset}")
+        self._cursor = offset + nbytes
+        table = [base + offset for base in self.bases]
+        table += [0] * (self.MAX_PEERS - len(table))
+        table_bytes = self.MAX_PEERS * 8
+        self._heap[offset - table_bytes : offset].view(torch.int64).copy_(torch.tensor(table, dtype=torch.int64))
+        return self._heap[offset : offset + nbytes].view(dtype).view(shape)
+
+    def barrier(self):
+        """Wait for the device work of every rank, e.g. before reading what peers wrote."""
+        torch.cuda.synchronize(self.device)
+        dist.barrier(group=self.group)
+
+    def close(self):
+        """Release the mappings of the peers, once no rank uses the heap anymore."""
+        self.barrier()
+        self._peers.clear()
+        self.bases.clear()
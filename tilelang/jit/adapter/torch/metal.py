@@ -1,6 +1,8 @@
 from __future__ import annotations
+import hashlib
+import threading
 from functools import wraps
-from typing import Callable
+from typing import Any, Callable
 
 import torch
 from tvm import tir
@@ -11,6 +13,28 @@ from ..base import BaseKernelAdapter
 from tilelang.engine.param import KernelParam
 
 
+_shader_library_cache: dict[str, Any] = {}
+_shader_library_lock = threading.Lock()
+
+
+def compile_shader_library(source: str):
+    """Compile Metal source into a shader library, once per process.
+
+    The library keeps the pipeline-state objects of its kernels, so adapters of
+    identical kernels, e.g. reloaded from the kernel cache or re-instantiated by
+    the autotuner, share them instead of compiling the source again.
+    """
+    key = hashlib.sha256(source.encode()).hexdigest()
+    library = _shader_library_cache.get(key)
+    if library is None:
+        with _shader_library_lock:
+            library = _shader_library_cache.get(key)
+            if library is None:
+                library = torch.mps.compile_shader(source)
+                _shader_library_cache[key] = library
+    return library
+
+
 class MetalKernelAdapter(BaseKernelAdapter):
     def __init__(
         self,
@@ -55,16 +79,17 @@ class MetalKernelAdapter(BaseKernelAdapter):
 
     def _convert_torch_func(self) -> Callable:
         if self._kernel is None:
-            _kernel = getattr(torch.mps.compile_shader(self.kernel_global_source), self.kernel_name)
-            _threads = [x * y for (x, y) in zip(self.block_info, self.grid_info)]
+            _kernel = getattr(compile_shader_library(self.kernel_global_source), self.kernel_name)
+            # Launch dimensions are static, build them once instead of per call.
+            _threads = [int(x) * int(y) for (x, y) in zip(self.block_info, self.grid_info)]
+            _group_size = [int(x) for x in self.block_info]
 
+            # Dispatches are encoded on torch's current MPS stream, which batches
+            # consecutive launches into one command buffer until a synchronization
+            # point, so the launcher must not synchronize itself.
             @wraps(_kernel)
             def launcher(*args: torch.Tensor):
-                return _kernel(
-                    *args,
-                    threads=_threads,
-                    group_size=self.block_info,
-                )
+                return _kernel(*args, threads=_threads, group_size=_group_size)
 
             self._kernel = launcher
 
@@ -12,15 +12,19 @@ from typing import Callable, Any
 import sys
 
 import torch
-from tilelang import tvm
+import tvm_ffi
+from tilelang import env, tvm
 from tvm import runtime, tir
 from tvm.target import Target
 from tvm.relax import TensorType
 from tilelang.utils.target import determine_target
 from tilelang.jit.adapter.base import BaseKernelAdapter
+from tilelang.jit.adapter.shared_module import load_shared_module
 from tilelang.utils.language import retrieve_func_from_module
-from tilelang.engine.param import KernelParam
+from tilelang.engine.param import KernelParam, alias_check_pairs
+from tilelang.transform import PassConfigKey
 from tilelang.language.dtypes import dtype
+from tilelang.contrib.dlpack import to_tvm_tensor
 
 
 COMPILE_ARGS = {}
@@ -31,6 +35,18 @@ if sys.platform == "darwin":
     COMPILE_ARGS["options"] = ["-x", "objective-c++", "-g", "-std=gnu++17"] + ["-I" + i for i in cpp_extension.include_paths()]
 
 
+def _tensors_overlap(a: torch.Tensor, b: torch.Tensor) -> bool:
+    if a.numel() == 0 or b.numel() == 0:
+        return False
+
+    def span(t: torch.Tensor) -> tuple[int, int]:
+        elements = 1 + sum((size - 1) * stride for size, stride in zip(t.shape, t.stride()))
+        return t.data_ptr(), t.data_ptr() + elements * t.element_size()
+
+    (a_begin, a_end), (b_begin, b_end) = span(a), span(b)
+    return a_begin < b_end and b_begin < a_end
+
+
 class TVMFFIKernelAdapter(BaseKernelAdapter):
     """Adapter that runs a TVM runtime.Executable with Torch tensors.
 
@@ -59,6 +75,8 @@ class TVMFFIKernelAdapter(BaseKernelAdapter):
     device_mod: tvm.IRModule | None = None
     # rt_mod
     rt_mod: tvm.runtime.Module | None = None
+    # library of a kernel restored from the cache, loaded on its first call
+    kernel_lib_path: str | None = None
     # Maps symbolic variables to their corresponding buffer and shape indices
     dynamic_symbolic_map: dict[tir.Var, tuple[int, int, int]] | None = None
 
@@ -167,7 +185,7 @@ class TVMFFIKernelAdapter(BaseKernelAdapter):
                 native_shape[-1] = native_shape[-1] * tl_dtype.bits * tl_dtype.lanes // (stroage_dtype.bits * stroage_dtype.lanes)
             param_shapes.append(native_shape)
 
-        if self.executable is None:
+        if self.executable is None and self.rt_mod is not None:
             self.executable = runtime.Executable(self.rt_mod)
             if COMPILE_ARGS:
                 # Precompile jit module with extra arguments
@@ -192,7 +210,19 @@ class TVMFFIKernelAdapter(BaseKernelAdapter):
                 expected_dtype_strs.append(None)
                 is_buffer_param.append(False)
 
-        def func(*inputs: torch.Tensor | Any):
+        alias_pairs = self._alias_check_pairs()
+
+        def check_aliasing(tensor_list: list[torch.Tensor | Any]):
+            for i, j in alias_pairs:
+                a, b = tensor_list[i], tensor_list[j]
+                if isinstance(a, torch.Tensor) and isinstance(b, torch.Tensor) and _tensors_overlap(a, b):
+                    raise ValueError(
+                        f"The buffers {buffer_map[params[i]].name} and {buffer_map[params[j]].name} overlap, "
+                        "but the kernel assumes that they do not alias. Pass tensors that do not share memory, "
+                        "or list the buffers in T.annotate_restrict_buffers."
+                    )
+
+        def build_tensor_list(inputs) -> list[torch.Tensor | Any]:
             # Validate input count strictly
             expected_inputs = len(self.params) - len(self.result_idx)
             if len(inputs) != expected_inputs:
@@ -240,7 +270,14 @@ class TVMFFIKernelAdapter(BaseKernelAdapter):
                     tensor = inputs[ins_idx]
                     ins_idx += 1
                 tensor_list.append(tensor)
+            check_aliasing(tensor_list)
+            return tensor_list
 
+        def func(*inputs: torch.Tensor | Any):
+            nonlocal executable
+            tensor_list = build_tensor_list(inputs)
+            if executable is None:
+                executable = self._load_executable()
             executable(*tensor_list)
 
             # Return outputs in the requested form
@@ -248,8 +285,107 @@ class TVMFFIKernelAdapter(BaseKernelAdapter):
                 return tensor_list[self.result_idx[0]]
             return [tensor_list[i] for i in self.result_idx]
 
+        self._build_tensor_list = build_tensor_list
+        self._check_aliasing = check_aliasing
         return func
 
+    def _alias_check_pairs(self) -> list[tuple[int, int]]:
+        """Pairs of input buffers a call must not pass overlapping, the outputs are allocated here."""
+        if self.pass_configs and self.pass_configs.get(PassConfigKey.TL_DISABLE_ALIAS_CHECK, False):
+            return []
+        restrict = {i for i, param in enumerate(self.params) if param.restrict and i not in self.result_idx}
+        written = {i for i, param in enumerate(self.params) if param.written}
+        return alias_check_pairs(restrict, written)
+
+    def bind(self, *args: Any) -> Callable[..., Any]:
+        """Resolve the outputs for inputs shaped like ``args`` once.
+
+        The returned call only places the inputs and allocates the outputs
+        with the shapes resolved here before running the executable, whose
+        host function still checks the arguments.
+        """
+        tensor_list = self._build_tensor_list(args)
+        input_idx = [i for i in range(len(tensor_list)) if i not in self.result_idx]
+        outputs = [(i, tuple(tensor_list[i].shape), tensor_list[i].dtype, tensor_list[i].device) for i in self.result_idx]
+        single_output = len(outputs) == 1
+        executable = self._load_executable()
+        check_aliasing = self._check_aliasing
+
+        def bound(*inputs: torch.Tensor | Any, skip_tensor_validation: bool = False):
+            if len(inputs) != len(input_idx):
+                raise ValueError(f"Kernel expected {len(input_idx)} inputs, but {len(inputs)} are provided.")
+            for i, tensor in zip(input_idx, inputs):
+                tensor_list[i] = tensor
+            results = [torch.empty(shape, dtype=dtype, device=device) for _, shape, dtype, device in outputs]
+            for (i, *_), tensor in zip(outputs, results):
+                tensor_list[i] = tensor
+            try:
+                check_aliasing(tensor_list)
+                executable(*tensor_list)
+            finally:
+                # Do not keep the tensors of the call alive
+                for i in range(len(tensor_list)):
+                    tensor_list[i] = None
+            return results[0] if single_output else results
+
+        return bound
+
+    def call_dlpack(self, *inputs: Any, stream: int | None = None) -> Any:
+        """Run the kernel on tensors of any framework implementing DLPack.
+
+        Inputs are passed to the executable as views of their memory, without
+        going through torch, and outputs are allocated as TVM tensors, which
+        the caller's framework imports without a copy (e.g.
+        ``jax.dlpack.from_dlpack``). Producers order their pending work before
+        ``stream`` as per the DLPack stream protocol, and the kernel is
+        launched on it.
+        """
+        expected_inputs = len(self.params) - len(self.result_idx)
+        if len(inputs) != expected_inputs:
+            raise ValueError(f"Kernel expected {expected_inputs} inputs, but {len(inputs)} are provided.")
+        self._load_executable()
+
+        tensor_list: list[Any] = []
+        device = None
+        ins = iter(inputs)
+        for i, param in enumerate(self.params):
+            if i in self.result_idx:
+                tensor_list.append(None)
+                continue
+            arg = next(ins)
+            if hasattr(arg, "__dlpack__"):
+                arg = to_tvm_tensor(arg, stream)
+                if device is None:
+                    device = arg.device
+            tensor_list.append(arg)
+        if device is None:
+            device = runtime.device(self.target.kind.name, 0)
+
+        symbols = {str(var): ref for var, ref in self.dynamic_symbolic_map.items()}
+        for i in self.result_idx:
+            shape = []
+            for dim in self.params[i].shape:
+                if not isinstance(dim, tir.Var):
+                    shape.append(int(dim))
+                    continue
+                ref_id, ref_idx, ref_dim = symbols[str(dim)]
+                if ref_id == 2:
+                    shape.append(int(tensor_list[ref_idx]))
+                elif ref_id == 0:
+                    shape.append(tensor_list[ref_idx].shape[ref_dim])
+                else:
+                    shape.append(tensor_list[ref_idx].strides[ref_dim])
+            tensor_list[i] = runtime.empty(shape, str(self.params[i].dtype), device)
+
+        if stream is None:
+            self.executable(*tensor_list)
+        else:
+            with tvm_ffi.use_raw_stream(device, stream):
+                self.executable(*tensor_list)
+        if len(self.result_idx) == 1:
+            return tensor_list[self.result_idx[0]]
+        return [tensor_list[i] for i in self.result_idx]
+
     @classmethod
     def from_database(
         cls,
@@ -281,10 +417,21 @@ class TVMFFIKernelAdapter(BaseKernelAdapter):
         adapter.target = Target.canon_target(determine_target(target))
 
         adapter.verbose = verbose
-        adapter.executable = runtime.load_module(kernel_lib_path)
+        adapter.kernel_lib_path = kernel_lib_path
+        if not env.is_lazy_loading_enabled():
+            adapter.executable = load_shared_module(kernel_lib_path, runtime.load_module)
         adapter._post_init()
         return adapter
 
+    def _load_executable(self):
+        """The executable of the kernel, a kernel restored from the cache loads its library here."""
+        if self.executable is None:
+            if self.rt_mod is not None:
+                self.executable = runtime.Executable(self.rt_mod)
+            else:
+                self.executable = load_shared_module(self.kernel_lib_path, runtime.load_module)
+        return self.executable
+
     def get_host_source(self):
         """Returns the source code of the host module."""
         if self.host_kernel_source is not None:
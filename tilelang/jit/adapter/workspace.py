@@ -0,0 +1,167 @@
+"""Pooled device memory of the ``T.Workspace`` parameters of a kernel.
+
+Workspace parameters are not passed by the caller. A call instead takes them
+from one block of memory per device and stream, grown as needed and reused by
+every kernel launched on that stream: the launches of a stream run one after
+the other, so they can share the same scratch memory without allocating it
+on every call. The workspaces of a call are carved out of the block at
+``_ALIGNMENT`` byte boundaries, the ``zero_init`` ones first, so that a
+single asynchronous memset on the stream zeroes all of them.
+"""
+
+from __future__ import annotations
+
+import threading
+from typing import Any, Callable
+
+import torch
+from tvm import tir
+
+from tilelang.engine.param import KernelParam
+
+_ALIGNMENT = 256
+
+
+def _align(size: int) -> int:
+    return (size + _ALIGNMENT - 1) // _ALIGNMENT * _ALIGNMENT
+
+
+class WorkspacePool:
+    """One growable block of device memory per (device, stream)."""
+
+    def __init__(self):
+        self._blocks: dict[tuple[torch.device, int], torch.Tensor] = {}
+        self._lock = threading.Lock()
+
+    def acquire(self, device: torch.device, stream: int, size: int) -> torch.Tensor:
+        """A uint8 tensor of at least ``size`` bytes, only valid on ``stream``."""
+        key = (device, stream)
+        with self._lock:
+            block = self._blocks.get(key)
+            if block is None or block.numel() < size:
+                # Grow geometrically, the old block is released to the caching
+                # allocator once the work queued on the stream is done with it
+                old = 0 if block is None else block.numel()
+                block = torch.empty(_align(max(size, 2 * old)), dtype=torch.uint8, device=device)
+                self._blocks[key] = block
+            return block
+
+    def nbytes(self) -> int:
+        with self._lock:
+            return sum(block.numel() for block in self._blocks.values())
+
+    def clear(self) -> None:
+        with self._lock:
+            self._blocks.clear()
+
+
+_pool = WorkspacePool()
+
+
+def get_workspace_pool() -> WorkspacePool:
+    return _pool
+
+
+class WorkspaceLayout:
+    """Where the workspaces of a kernel go among its inputs and in the pool block.
+
+    Args:
+        params: The parameters of the kernel.
+        result_idx: The indices of its outputs, allocated by the adapter.
+        device_functor: Yields the device of the calls without tensor inputs.
+        stream_functor: Yields the raw handle of the stream of a call.
+    """
+
+    def __init__(
+        self,
+        params: list[KernelParam],
+        result_idx: list[int],
+        device_functor: Callable[[], torch.device],
+        stream_functor: Callable[[], int],
+    ):
+        self.device_functor = device_functor
+        self.stream_functor = stream_functor
+        # The inputs of the adapter, outputs excluded
+        input_params = [param for i, param in enumerate(params) if i not in result_idx]
+        self.num_inputs = sum(not param.workspace for param in input_params)
+        # Index in the caller inputs of every adapter input, None for workspaces
+        self.positions: list[int | None] = []
+        workspaces: list[tuple[int, KernelParam]] = []
+        for position, param in enumerate(input_params):
+            if param.workspace:
+                self.positions.append(None)
+                workspaces.append((position, param))
+            else:
+                self.positions.append(len(self.positions) - len(workspaces))
+        # The zeroed workspaces first, one memset covers them
+        workspaces.sort(key=lambda item: not item[1].zero_init)
+        callers = [param for param in input_params if not param.workspace]
+        self.workspaces = [
+            (position, param.torch_dtype(), param.dtype.bits * param.dtype.lanes // 8, param.zero_init, self._resolve_dims(param, callers))
+            for position, param in workspaces
+        ]
+
+    @staticmethod
+    def _resolve_dims(param: KernelParam, callers: list[KernelParam]) -> list[int | tuple[int, int]]:
+        """The static extents, and (caller input, dim) for the symbolic ones."""
+        if param.dtype.bits * param.dtype.lanes % 8:
+            raise ValueError(f"Workspace of sub-byte dtype {param.dtype} is not supported")
+        dims: list[int | tuple[int, int]] = []
+        for dim in param.shape:
+            if isinstance(dim, int):
+                dims.append(dim)
+                continue
+            source = None
+            if isinstance(dim, tir.Var):
+                extents = ((k, j, s) for k, other in enumerate(callers) for j, s in enumerate(other.shape))
+                source = next(((k, j) for k, j, s in extents if isinstance(s, tir.Var) and str(s) == str(dim)), None)
+            if source is None:
+                raise ValueError(f"Workspace extent {dim} is neither static nor an extent of an input tensor")
+            dims.append(source)
+        return dims
+
+    def insert(self, inputs: tuple | list) -> list[Any]:
+        """The adapter inputs of a call, ``inputs`` with its workspaces served from the pool."""
+        if len(inputs) != self.num_inputs:
+            raise ValueError(f"Kernel expected {self.num_inputs} inputs, but {len(inputs)} are provided.")
+        views, size, zeroed = [], 0, 0
+        for _, _, itemsize, zero_init, dims in self.workspaces:
+            shape = [d if isinstance(d, int) else inputs[d[0]].shape[d[1]] for d in dims]
+            nbytes = itemsize
+            for d in shape:
+                nbytes *= d
+            views.append((size, nbytes, shape))
+            size += _align(nbytes)
+            if zero_init:
+                zeroed = size
+        device = next((x.device for x in inputs if isinstance(x, torch.Tensor)), None)
+        if device is None:
+            device = self.device_functor()
+        block = _pool.acquire(device, self.stream_functor(), size)
+        if zeroed:
+            block[:zeroed].zero_()
+        args = [None if p is None else inputs[p] for p in self.positions]
+        for (position, dtype, *_), (offset, nbytes, shape) in zip(self.workspaces, views):
+            args[position] = block[offset : offset + nbytes].view(dtype).view(shape)
+        return args
+
+    def wrap(self, func: Callable[..., Any]) -> Callable[..., Any]:
+        """``func`` taking the inputs without the workspaces."""
+        insert = self.insert
+
+        def call(*inputs: Any, **kwds: Any) -> Any:
+            return func(*insert(inputs), **kwds)
+
+        return call
+
+
+def make_workspace_layout(
+    params: list[KernelParam] | None,
+    result_idx: list[int],
+    device_functor: Callable[[], torch.device],
+    stream_functor: Callable[[], int],
+) -> WorkspaceLayout | None:
+    """The workspace layout of a kernel, None when it has no workspace."""
+    if not params or not any(param.workspace for param in params):
+        return None
+    return WorkspaceLayout(params, result_idx, device_functor, stream_functor)
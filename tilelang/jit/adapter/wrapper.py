@@ -4,6 +4,8 @@ from tilelang import tvm as tvm
 from typing import Any
 from tvm import IRModule
 from tvm.target import Target
+from tilelang.engine.param import alias_check_pairs, analyze_param_aliasing
+from tilelang.transform import PassConfigKey
 
 from .utils import (
     is_metal_target,
@@ -31,6 +33,22 @@ PREDEF_ATTRIBUTE_SET_DYNAMIC_MEMORY = """
     }}
 """
 
+PREDEF_ATTRIBUTE_SET_NON_PORTABLE_CLUSTER = """
+    cudaError_t result_{0}_cluster = cudaFuncSetAttribute({0}, cudaFuncAttributeNonPortableClusterSizeAllowed, 1);
+    if (result_{0}_cluster != cudaSuccess) {{
+        snprintf(error_buf, ERROR_BUF_SIZE, "Failed to allow the cluster size %d with error: %s", {1}, cudaGetErrorString(result_{0}_cluster));
+        return -1;
+    }}
+"""
+
+PREDEF_ATTRIBUTE_SET_CARVEOUT = """
+    cudaError_t result_{0}_carveout = cudaFuncSetAttribute({0}, cudaFuncAttributePreferredSharedMemoryCarveout, {1});
+    if (result_{0}_carveout != cudaSuccess) {{
+        snprintf(error_buf, ERROR_BUF_SIZE, "Failed to set the shared memory carveout to %d with error: %s", {1}, cudaGetErrorString(result_{0}_carveout));
+        return -1;
+    }}
+"""
+
 PREDEF_ATTRIBUTE_SET_DYNAMIC_MEMORY_HIP = """
     if ({1} > 65536) {{
         snprintf(error_buf, ERROR_BUF_SIZE, "Failed to set the allowed dynamic shared memory size for {0} to %d", {1});
@@ -54,6 +72,69 @@ extern "C" int init() {{
 }}
 """
 
+# Function attributes are per device state: they are set the first time the
+# module runs on a device, init() covers the device current at load time.
+# Without a device (e.g. a build machine) there is nothing to configure yet.
+PREDEF_INIT_FUNC_ATTRIBUTES = """
+#include <atomic>
+
+#define ERROR_BUF_SIZE 1024
+#define TL_MAX_DEVICES 64
+static char error_buf[ERROR_BUF_SIZE];
+static std::atomic<bool> attributes_configured[TL_MAX_DEVICES];
+
+extern "C" const char* get_last_error() {{
+    return error_buf;
+}}
+
+static int configure_attributes() {{
+    {0}
+    return 0;
+}}
+
+static int ensure_attributes() {{
+    int device = 0;
+    if (cudaGetDevice(&device) != cudaSuccess) {{
+        cudaGetLastError();
+        return 0;
+    }}
+    if (device < 0 || device >= TL_MAX_DEVICES) {{
+        return configure_attributes();
+    }}
+    if (!attributes_configured[device].load(std::memory_order_acquire)) {{
+        if (configure_attributes() != 0) {{
+            return -1;
+        }}
+        attributes_configured[device].store(true, std::memory_order_release);
+    }}
+    return 0;
+}}
+
+extern "C" int init() {{
+    error_buf[0] = '\\0';
+    int device_count = 0;
+    if (cudaGetDeviceCount(&device_count) != cudaSuccess || device_count == 0) {{
+        cudaGetLastError();
+        return 0;
+    }}
+    return ensure_attributes();
+}}
+"""
+
+PREDEF_ENSURE_ATTRIBUTES = """
+\tif (ensure_attributes() != 0) {
+\t\treturn -1;
+\t}
+"""
+
+# The kernels declare the two buffers __restrict__ and write one of them
+PREDEF_ALIAS_CHECK = """
+\tif (({2}) > 0 && ({3}) > 0 && (uintptr_t)({0}) < (uintptr_t)({1}) + ({3}) && (uintptr_t)({1}) < (uintptr_t)({0}) + ({2})) {{
+\t\tsnprintf(error_buf, ERROR_BUF_SIZE, "Error: the buffers {0} and {1} overlap, but the kernel assumes that they do not alias");
+\t\treturn -1;
+\t}}
+"""
+
 PREDEF_HOST_FUNC = """
 extern "C" int call({}) {{
 {}
@@ -63,15 +144,18 @@ extern "C" int call({}) {{
 
 L2_PERSISTENT_MAP_CREATE_HANDLE = """
 \tcudaStreamAttrValue stream_attribute;
-\tsize_t init_persisting_l2_cache_size;
-\tcudaDeviceGetLimit(&init_persisting_l2_cache_size, cudaLimitPersistingL2CacheSize);
+\tsize_t persisting_l2_cache_size;
+\tcudaDeviceGetLimit(&persisting_l2_cache_size, cudaLimitPersistingL2CacheSize);
 """
 
 L2_PERSISTENT_MAP_INIT_FUNC = """
 \tstream_attribute.accessPolicyWindow.hitRatio = {1};
 \tstream_attribute.accessPolicyWindow.hitProp = cudaAccessPropertyPersisting;
 \tstream_attribute.accessPolicyWindow.missProp = cudaAccessPropertyStreaming;
-\tcudaDeviceSetLimit(cudaLimitPersistingL2CacheSize, {2});
+\tif (persisting_l2_cache_size < (size_t)({2})) {{
+\t\tpersisting_l2_cache_size = {2};
+\t\tcudaDeviceSetLimit(cudaLimitPersistingL2CacheSize, persisting_l2_cache_size);
+\t}}
 \tstream_attribute.accessPolicyWindow.base_ptr = (void*)({0});
 \tstream_attribute.accessPolicyWindow.num_bytes = {2};
 \tcudaStreamSetAttribute(stream, cudaStreamAttributeAccessPolicyWindow, &stream_attribute);
@@ -80,8 +164,6 @@ L2_PERSISTENT_MAP_INIT_FUNC = """
 L2_PERSISTENT_MAP_RESET_HANDLE = """
 \tstream_attribute.accessPolicyWindow.num_bytes = 0;
 \tcudaStreamSetAttribute(stream, cudaStreamAttributeAccessPolicyWindow, &stream_attribute);
-\tcudaCtxResetPersistingL2Cache();
-\tcudaDeviceSetLimit(cudaLimitPersistingL2CacheSize, init_persisting_l2_cache_size);
 """
 
 TMA_DESC_INIT_FUNC = """
@@ -98,10 +180,38 @@ TMA_DESC_INIT_FUNC = """
 \tCUtensorMapL2promotion {0}_l2Promotion= (CUtensorMapL2promotion){10};
 \tCUtensorMapFloatOOBfill {0}_oobFill= (CUtensorMapFloatOOBfill){11};
 
-\tCUresult {0}_result = CUTLASS_CUDA_DRIVER_WRAPPER_CALL(cuTensorMapEncodeTiled)(
+\tcuuint64_t {0}_key[4 * {2}];
+\tfor (int i = 0; i < {2}; ++i) {{
+\t\t{0}_key[i] = {0}_globalDim[i];
+\t\t{0}_key[{2} + i] = {0}_globalStride[i];
+\t\t{0}_key[2 * {2} + i] = {0}_boxDim[i];
+\t\t{0}_key[3 * {2} + i] = {0}_elementStrides[i];
+\t}}
+\tstatic thread_local CUtensorMap {0}_cached;
+\tstatic thread_local cuuint64_t {0}_cached_key[4 * {2}];
+\tstatic thread_local void *{0}_cached_address = nullptr;
+\tstatic thread_local bool {0}_cached_valid = false;
+
+\tCUresult {0}_result = CUDA_SUCCESS;
+\tif ({0}_cached_valid && memcmp({0}_key, {0}_cached_key, sizeof({0}_key)) == 0) {{
+\t\tif ({0}_cached_address != {0}_globalAddress) {{
+\t\t\t{0}_result = cuTensorMapReplaceAddress(&{0}_cached, {0}_globalAddress);
+\t\t\t{0}_cached_address = {0}_globalAddress;
+\t\t}}
+\t\t{0} = {0}_cached;
+\t}} else {{
+\t\t{0}_result = CUTLASS_CUDA_DRIVER_WRAPPER_CALL(cuTensorMapEncodeTiled)(
     &{0}, {0}_type, {0}_tensorRank, {0}_globalAddress, {0}_globalDim, {0}_globalStride + 1, {0}_boxDim, {0}_elementStrides, {0}_interleave, {0}_swizzle, {0}_l2Promotion, {0}_oobFill);
+\t\tif ({0}_result == CUDA_SUCCESS) {{
+\t\t\t{0}_cached = {0};
+\t\t\tmemcpy({0}_cached_key, {0}_key, sizeof({0}_key));
+\t\t\t{0}_cached_address = {0}_globalAddress;
+\t\t\t{0}_cached_valid = true;
+\t\t}}
+\t}}
 
 \tif ({0}_result != CUDA_SUCCESS) {{
+\t\t{0}_cached_valid = false;
 \t\tstd::stringstream ss;
 \t\tss << "Error: Failed to initialize the TMA descriptor {0}";
 \t\tsnprintf(error_buf, ERROR_BUF_SIZE, "%s", ss.str().c_str());
@@ -126,11 +236,38 @@ TMA_IM2COL_DESC_INIT_FUNC = """
 \tCUtensorMapL2promotion {0}_l2Promotion= (CUtensorMapL2promotion){13};
 \tCUtensorMapFloatOOBfill {0}_oobFill= (CUtensorMapFloatOOBfill){14};
 
-\tCUresult {0}_result = CUTLASS_CUDA_DRIVER_WRAPPER_CALL(cuTensorMapEncodeIm2col)(
+\tcuuint64_t {0}_key[3 * {2}];
+\tfor (int i = 0; i < {2}; ++i) {{
+\t\t{0}_key[i] = {0}_globalDim[i];
+\t\t{0}_key[{2} + i] = {0}_globalStride[i];
+\t\t{0}_key[2 * {2} + i] = {0}_elementStrides[i];
+\t}}
+\tstatic thread_local CUtensorMap {0}_cached;
+\tstatic thread_local cuuint64_t {0}_cached_key[3 * {2}];
+\tstatic thread_local void *{0}_cached_address = nullptr;
+\tstatic thread_local bool {0}_cached_valid = false;
+
+\tCUresult {0}_result = CUDA_SUCCESS;
+\tif ({0}_cached_valid && memcmp({0}_key, {0}_cached_key, sizeof({0}_key)) == 0) {{
+\t\tif ({0}_cached_address != {0}_globalAddress) {{
+\t\t\t{0}_result = cuTensorMapReplaceAddress(&{0}_cached, {0}_globalAddress);
+\t\t\t{0}_cached_address = {0}_globalAddress;
+\t\t}}
+\t\t{0} = {0}_cached;
+\t}} else {{
+\t\t{0}_result = CUTLASS_CUDA_DRIVER_WRAPPER_CALL(cuTensorMapEncodeIm2col)(
     &{0}, {0}_type, {0}_tensorRank, {0}_globalAddress, {0}_globalDim, {0}_globalStride + 1,
     {0}_lowerCorner, {0}_upperCorner, {0}_channelsPerPixel, {0}_pixelsPerColumn, {0}_elementStrides, {0}_interleave, {0}_swizzle, {0}_l2Promotion, {0}_oobFill);
+\t\tif ({0}_result == CUDA_SUCCESS) {{
+\t\t\t{0}_cached = {0};
+\t\t\tmemcpy({0}_cached_key, {0}_key, sizeof({0}_key));
+\t\t\t{0}_cached_address = {0}_globalAddress;
+\t\t\t{0}_cached_valid = true;
+\t\t}}
+\t}}
 
 \tif ({0}_result != CUDA_SUCCESS) {{
+\t\t{0}_cached_valid = false;
 \t\tstd::stringstream ss;
 \t\tss << "Error: Failed to initialize the TMA descriptor {0}";
 \t\tsnprintf(error_buf, ERROR_BUF_SIZE, "%s", ss.str().c_str());
@@ -211,6 +348,7 @@ class TLCUDASourceWrapper:
         self.tma_descriptor_args: dict | None = None
         self.l2_persistent_map: dict[str, dict] | None = {}
         self.pdl_sync_map: dict[str, int] | None = {}
+        self._attribute_calls: str | None = None
         self.parse_source_information()
         self.srcpath: str | None = None
         self.libpath: str | None = None
@@ -341,7 +479,7 @@ class TLCUDASourceWrapper:
                 kernel_launch_code += L2_PERSISTENT_MAP_RESET_HANDLE
 
         init_tma_descriptor_args = self.generate_tma_descriptor_args(desc_name_map, desc_name_var_map)
-        kernel_launch_code = init_tma_descriptor_args + kernel_launch_code
+        kernel_launch_code = self.generate_alias_check() + self.generate_attribute_guard() + init_tma_descriptor_args + kernel_launch_code
 
         # Wrap the kernel dispatch logic in an external C function
         host_func = PREDEF_HOST_FUNC.format(def_args, kernel_launch_code)
@@ -350,6 +488,32 @@ class TLCUDASourceWrapper:
     def get_declaration(self, declare_kernel_code: str) -> str:
         return declare_kernel_code.split(";")[0]
 
+    def _buffer_bytes(self, buffer: tvm.tir.Buffer) -> str | None:
+        # Bytes spanned by the buffer, None when the host function cannot compute them
+        if buffer.strides:
+            if not all(isinstance(stride, tvm.tir.IntImm) for stride in buffer.strides):
+                return None
+            offsets = [f"((int64_t)({self._pythonic_expr(dim)}) - 1) * {int(stride)}" for dim, stride in zip(buffer.shape, buffer.strides)]
+            elements = "1 + " + " + ".join(offsets)
+        else:
+            elements = " * ".join(f"(int64_t)({self._pythonic_expr(dim)})" for dim in buffer.shape) or "1"
+        bits = buffer.dtype.bits * buffer.dtype.lanes
+        if bits % 8 == 0:
+            return f"({elements}) * {bits // 8}"
+        return f"(({elements}) * {bits} + 7) / 8"
+
+    def generate_alias_check(self) -> str:
+        if self.pass_configs and self.pass_configs.get(PassConfigKey.TL_DISABLE_ALIAS_CHECK, False):
+            return ""
+        prim_func = self.prim_func
+        restrict, written = analyze_param_aliasing(prim_func, self.device_mod)
+        buffers = {i: prim_func.buffer_map[prim_func.params[i]] for i in restrict}
+        sizes = {i: self._buffer_bytes(buffer) for i, buffer in buffers.items()}
+        alias_check = ""
+        for i, j in alias_check_pairs({i for i in restrict if sizes[i] is not None}, written):
+            alias_check += PREDEF_ALIAS_CHECK.format(buffers[i].data.name, buffers[j].data.name, sizes[i], sizes[j])
+        return alias_check
+
     def generate_l2_persistent_map(self, function_name: str) -> str:
         if function_name not in self.l2_persistent_map:
             return ""
@@ -508,17 +672,55 @@ class TLCUDASourceWrapper:
 
         return list(dynamic_symbolic_set.items())
 
-    def get_init_func(self):
-        # Initialize an empty string for the CUDA function call
+    def _cluster_size(self, function_name: str) -> int:
+        size = 1
+
+        def visitor(node):
+            nonlocal size
+            if isinstance(node, tvm.tir.AttrStmt) and node.attr_key == "pragma_cluster_dims":
+                size = 1
+                for dim in str(node.value.value).split(","):
+                    size *= int(dim)
+
+        post_order_visit(self.device_mod[function_name].body, visitor)
+        return size
+
+    def _preferred_carveout(self, function_name: str) -> int | None:
+        from tilelang.engine.resource import preferred_smem_carveout
+
+        try:
+            return preferred_smem_carveout(self.device_mod[function_name], self.target, self.dynamic_smem_buf[function_name] or 0)
+        except Exception as e:
+            logger.debug(f"Keeping the default shared memory carveout of {function_name}: {e}")
+            return None
+
+    def get_attribute_calls(self) -> str:
+        """cudaFuncSetAttribute calls of the kernels, run once per device."""
+        if self._attribute_calls is not None:
+            return self._attribute_calls
         call_str = """"""
-        # If dynamic shared memory buffer is specified, prepare the cudaFuncSetAttribute call
         for function_name, dynamic_smem_buf in self.dynamic_smem_buf.items():
             if dynamic_smem_buf is not None:
                 # Format the cudaFuncSetAttribute call for dynamic shared memory
                 call_str += PREDEF_ATTRIBUTE_SET_DYNAMIC_MEMORY.format(function_name, dynamic_smem_buf)
-        # Format the initialization function using the call_str
-        init_funcs = PREDEF_INIT_FUNC.format(call_str)
-        return init_funcs
+            cluster_size = self._cluster_size(function_name)
+            if cluster_size > 8:
+                # clusters above the portable size of 8 blocks must be allowed explicitly
+                call_str += PREDEF_ATTRIBUTE_SET_NON_PORTABLE_CLUSTER.format(function_name, cluster_size)
+            carveout = self._preferred_carveout(function_name)
+            if carveout is not None:
+                call_str += PREDEF_ATTRIBUTE_SET_CARVEOUT.format(function_name, carveout)
+        self._attribute_calls = call_str
+        return call_str
+
+    def get_init_func(self):
+        call_str = self.get_attribute_calls()
+        if not call_str:
+            return PREDEF_INIT_FUNC.format(call_str)
+        return PREDEF_INIT_FUNC_ATTRIBUTES.format(call_str)
+
+    def generate_attribute_guard(self) -> str:
+        return PREDEF_ENSURE_ATTRIBUTES if self.get_attribute_calls() else ""
 
     def update_lib_code(self, code: str):
         # Update the library code with the given code string
@@ -667,6 +869,10 @@ class TLHIPSourceWrapper(TLCUDASourceWrapper):
         init_funcs = PREDEF_INIT_FUNC.format(call_str)
         return init_funcs
 
+    def generate_attribute_guard(self) -> str:
+        # init() has no per device attributes to set on HIP
+        return ""
+
     def get_stream_type(self) -> dict[str, str]:
         return {"name": "stream=hipStreamDefault", "type": "hipStream_t"}
 
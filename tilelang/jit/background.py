@@ -0,0 +1,157 @@
+"""Compiling kernels in the background while a fallback serves the calls.
+
+``@tilelang.jit`` compiles on the first call with a new key, which blocks that
+call for the seconds the lowering and the device compiler take. When shapes
+show up at runtime, e.g. new sequence lengths in a server, a
+:class:`BackgroundJIT` hands the compilation to a worker thread instead and
+runs a fallback until the kernel is ready: a torch reference, or a kernel
+compiled ahead for generic shapes. The calls switch to the compiled kernel as
+soon as it lands in the cache of the JIT::
+
+    @tilelang.jit
+    def gemm(A, B, block_M=128):
+        ...
+
+    fast_gemm = tilelang.jit.BackgroundJIT(gemm, fallback=lambda A, B, **kwargs: A @ B)
+    C = fast_gemm(A, B)  # A @ B until gemm is compiled for the shapes of A and B
+
+With a lazy-style JIT, whose call returns a kernel, the call returns a
+:class:`BackgroundKernel` taking the arguments of the kernel and running the
+fallback on them until the kernel is compiled.
+
+The function is traced on the calling thread; only the lowering and the
+device compiler, which mostly run without the GIL, run on the workers.
+"""
+
+from __future__ import annotations
+
+import concurrent.futures
+import threading
+from logging import getLogger
+from typing import TYPE_CHECKING, Any, Callable
+
+from tilelang.jit.kernel import JITKernel
+
+if TYPE_CHECKING:
+    from tilelang.jit import JITImpl
+
+logger = getLogger(__name__)
+
+
+class BackgroundKernel:
+    """A kernel being compiled, running ``fallback`` until it is ready.
+
+    Parameters
+    ----------
+    future : concurrent.futures.Future
+        Compilation of the kernel, resolving to a JITKernel.
+    fallback : Callable
+        Called with the arguments of the kernel while it compiles, or for
+        good if its compilation failed.
+    """
+
+    def __init__(self, future: concurrent.futures.Future, fallback: Callable):
+        self.future = future
+        self.fallback = fallback
+        self._kernel: JITKernel | None = None
+
+    @property
+    def kernel(self) -> JITKernel | None:
+        """The compiled kernel, None while it compiles or if it failed to."""
+        if self._kernel is None and self.future.done() and self.future.exception() is None:
+            self._kernel = self.future.result()
+        return self._kernel
+
+    def ready(self) -> bool:
+        return self.kernel is not None
+
+    def wait(self, timeout: float | None = None) -> JITKernel:
+        """Block until the kernel is compiled and return it, raising its compilation error."""
+        self._kernel = self.future.result(timeout)
+        return self._kernel
+
+    def __call__(self, *args: Any, **kwargs: Any) -> Any:
+        kernel = self.kernel
+        if kernel is None:
+            return self.fallback(*args, **kwargs)
+        return kernel(*args, **kwargs)
+
+    def __repr__(self) -> str:
+        state = "ready" if self.ready() else "failed" if self.future.done() else "compiling"
+        return f"BackgroundKernel({state}, fallback={self.fallback!r})"
+
+
+class BackgroundJIT:
+    """Compile the kernels of a JIT in the background, calling a fallback meanwhile.
+
+    Parameters
+    ----------
+    jit : JITImpl
+        The function decorated with ``@tilelang.jit``. Its kernel cache is
+        shared: kernels it already compiled are used right away, and kernels
+        compiled in the background are also used by direct calls of ``jit``.
+    fallback : Callable
+        In eager mode, called with the arguments of the call; in lazy mode,
+        with the arguments of the kernel.
+    max_workers : int
+        Number of kernels compiled at once.
+    """
+
+    def __init__(self, jit: JITImpl, fallback: Callable, max_workers: int = 1):
+        self.jit = jit
+        self.fallback = fallback
+        self._executor = concurrent.futures.ThreadPoolExecutor(max_workers, "tl-bg-comp")
+        self._pending: dict[tuple, BackgroundKernel] = {}
+        self._lock = threading.Lock()
+
+    def _publish(self, key: tuple, future: concurrent.futures.Future):
+        # Runs on the worker: a kernel is visible to every later call once in
+        # the cache, only then is the pending entry dropped. Failed kernels
+        # stay pending so their calls keep running the fallback.
+        if future.exception() is not None:
+            logger.warning(f"Background compilation of {self.jit.func.__name__} failed, keeping the fallback: {future.exception()}")
+            return
+        self.jit._kernel_cache[key] = future.result()
+        with self._lock:
+            self._pending.pop(key, None)
+
+    def __call__(self, *args: Any, **kwargs: Any) -> Any:
+        jit = self.jit
+        kwargs.update(kwargs.pop("__tune_params", {}))
+        if jit.mode == "auto":
+            jit.mode = jit._infer_jit_mode(*args, **kwargs)
+            jit.func.set_mode(jit.mode)
+
+        key, kernel_args = jit.func.parse_args(*args, **kwargs)
+        kernel = jit._kernel_cache.get(key, None)
+        if kernel is not None:
+            return kernel(*kernel_args.values()) if jit.mode == "eager" else kernel
+
+        submitted = None
+        with self._lock:
+            pending = self._pending.get(key, None)
+            if pending is None:
+                submitted = self._executor.submit(jit.compile_tir, jit.get_tir(*args, **kwargs))
+                pending = BackgroundKernel(submitted, self.fallback)
+                self._pending[key] = pending
+        if submitted is not None:
+            # Outside of the lock: the callback runs right away when the
+            # compilation is already done
+            submitted.add_done_callback(lambda future, key=key: self._publish(key, future))
+        # The kernel may be compiled before the worker published it
+        kernel = pending.kernel
+        if jit.mode == "eager":
+            return self.fallback(*args, **kwargs) if kernel is None else kernel(*kernel_args.values())
+        return pending if kernel is None else kernel
+
+    def wait(self, timeout: float | None = None):
+        """Block until the kernels being compiled are ready, e.g. before benchmarking."""
+        with self._lock:
+            futures = [pending.future for pending in self._pending.values()]
+        concurrent.futures.wait(futures, timeout)
+
+    def shutdown(self, wait: bool = True):
+        self._executor.shutdown(wait=wait)
+
+    def __repr__(self) -> str:
+        return f"BackgroundJIT({self.jit.func.__name__}, pending={len(self._pending)})"
@@ -0,0 +1,88 @@
+"""Launching sequences of small kernels from a single Python call.
+
+Decode steps issue dozens of small kernels whose runtime is comparable to
+the Python overhead of one ``JITKernel`` call. A :class:`KernelBatch` binds
+every launch once (see ``JITKernel.bind``) and issues the whole sequence on
+one stream; with the cython backend the loop over the launches runs in the
+extension, reusing the packed arguments of every kernel::
+
+    batch = tilelang.jit.KernelBatch([(rms_norm, (x, w, y)), (gemm, (y, W_qkv, qkv)), (rope, (qkv, cos, sin))])
+    batch()                       # relaunch with the bound tensors, e.g. static decode buffers
+    batch([(x2, w, y), None, None], stream=torch.cuda.current_stream())
+"""
+
+from __future__ import annotations
+
+from collections.abc import Sequence
+from typing import Any, Callable
+
+import torch
+
+from tilelang.jit.kernel import JITKernel
+
+
+def _stream_handle(stream: torch.cuda.Stream | int | None) -> int:
+    if stream is None:
+        return -1
+    if isinstance(stream, torch.cuda.Stream):
+        return stream.cuda_stream
+    return int(stream)
+
+
+class KernelBatch:
+    """An ordered sequence of bound kernel launches issued together.
+
+    Parameters
+    ----------
+    launches : Sequence[tuple[JITKernel | Callable, Sequence[Any]]]
+        The (kernel, inputs) of every launch, outputs excluded. Kernels are
+        bound to their inputs; an already bound call is taken as is.
+    """
+
+    def __init__(self, launches: Sequence[tuple[JITKernel | Callable, Sequence[Any]]]):
+        self.calls: list[Callable] = []
+        self.inputs: list[tuple[Any, ...]] = []
+        for kernel, args in launches:
+            args = tuple(args)
+            self.calls.append(kernel.bind(*args) if isinstance(kernel, JITKernel) else kernel)
+            self.inputs.append(args)
+        self._launch_native = None
+        try:
+            from tilelang.jit.adapter.cython.adapter import BoundKernelCall, launch_bound_calls
+
+            if self.calls and all(isinstance(call, BoundKernelCall) for call in self.calls):
+                self._launch_native = launch_bound_calls
+        except ImportError:
+            pass
+
+    def __len__(self) -> int:
+        return len(self.calls)
+
+    def __call__(
+        self,
+        inputs: Sequence[Sequence[Any] | None] | None = None,
+        stream: torch.cuda.Stream | int | None = None,
+        skip_tensor_validation: bool = False,
+    ) -> list[Any]:
+        """Launch every kernel in order and return their outputs.
+
+        Args:
+            inputs: New inputs of each launch, None keeping the bound ones.
+                They must have the metadata of the bound inputs.
+            stream: Stream of the launches, the current one when None.
+            skip_tensor_validation: Skip the per-tensor metadata comparison,
+                see ``JITKernel.bind``.
+        """
+        if inputs is None:
+            inputs = self.inputs
+        else:
+            if len(inputs) != len(self.calls):
+                raise ValueError(f"Expected inputs for {len(self.calls)} launches, got {len(inputs)}")
+            inputs = [bound if args is None else tuple(args) for args, bound in zip(inputs, self.inputs)]
+        handle = _stream_handle(stream)
+        if self._launch_native is not None:
+            return self._launch_native(self.calls, list(inputs), handle, skip_tensor_validation)
+        if handle == -1:
+            return [call(*args, skip_tensor_validation=skip_tensor_validation) for call, args in zip(self.calls, inputs)]
+        with torch.cuda.stream(torch.cuda.ExternalStream(handle)):
+            return [call(*args, skip_tensor_validation=skip_tensor_validation) for call, args in zip(self.calls, inputs)]
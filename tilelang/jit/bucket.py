@@ -0,0 +1,114 @@
+"""Shape-bucketed dispatch for kernels with a dynamic dimension.
+
+A single kernel compiled for a symbolic dimension uses one tile configuration
+for every size, which is far from optimal when that size spans orders of
+magnitude (e.g. the token count of decode-time GEMMs). ``compile_buckets``
+compiles one specialization per size bucket, each with its own configuration
+(typically the ``config`` of an ``AutotuneResult`` tuned for that bucket),
+and returns a :class:`BucketedKernel` that selects the specialization from the
+runtime extent of the dimension on every call::
+
+    kernel = tilelang.jit.compile_buckets(
+        lambda block_M, num_stages: matmul(T.dynamic("m"), N, K, block_M, num_stages),
+        dim="m",
+        buckets={16: dict(block_M=16, num_stages=4), 64: dict(block_M=64, num_stages=3), None: dict(block_M=128, num_stages=2)},
+        out_idx=[2],
+    )
+    C = kernel(A, B)  # A.shape[0] selects the bucket
+"""
+
+from __future__ import annotations
+
+import bisect
+from collections.abc import Mapping
+from typing import Any, Callable
+
+from tvm import tir
+
+from tilelang.jit.kernel import JITKernel
+
+
+def _locate_dim(kernel: JITKernel, dim: str) -> tuple[int, int]:
+    """Return the (input index, axis) of the first input using symbol ``dim``."""
+    out_idx = set(kernel.out_idx)
+    input_idx = 0
+    for i, param in enumerate(kernel.params):
+        if i in out_idx:
+            continue
+        for axis, extent in enumerate(param.shape):
+            if isinstance(extent, tir.Var) and extent.name == dim:
+                return input_idx, axis
+        input_idx += 1
+    raise ValueError(f"No input of kernel {kernel.prim_func.attrs['global_symbol']} has the dynamic dimension {dim!r}")
+
+
+class BucketedKernel:
+    """Dispatch calls to the kernel of the smallest bucket covering a dimension.
+
+    Parameters
+    ----------
+    kernels : Mapping[int | None, JITKernel]
+        Kernel of each bucket keyed by its inclusive upper bound; the ``None``
+        bucket handles every size above the largest bound.
+    dim : str
+        Name of the dynamic dimension the buckets are defined on.
+    """
+
+    def __init__(self, kernels: Mapping[int | None, JITKernel], dim: str):
+        self.dim = dim
+        self.bounds = sorted(bound for bound in kernels if bound is not None)
+        self.kernels = [kernels[bound] for bound in self.bounds]
+        self.fallback = kernels.get(None)
+        # Every specialization shares the signature, locate the dimension once.
+        any_kernel = self.kernels[0] if self.kernels else self.fallback
+        self._arg_index, self._axis = _locate_dim(any_kernel, dim)
+
+    def select(self, extent: int) -> JITKernel:
+        """Return the kernel specialized for a given extent of the dimension."""
+        bucket = bisect.bisect_left(self.bounds, extent)
+        if bucket < len(self.kernels):
+            return self.kernels[bucket]
+        if self.fallback is None:
+            raise ValueError(f"{self.dim}={extent} exceeds the largest bucket {self.bounds[-1]} and no fallback bucket was compiled")
+        return self.fallback
+
+    def __call__(self, *args: Any, **kwargs: Any) -> Any:
+        return self.select(args[self._arg_index].shape[self._axis])(*args, **kwargs)
+
+    def __repr__(self) -> str:
+        buckets = [f"<={bound}" for bound in self.bounds] + ([">"] if self.fallback is not None else [])
+        return f"BucketedKernel(dim={self.dim!r}, buckets={buckets})"
+
+
+def compile_buckets(
+    func: Callable[..., tir.PrimFunc],
+    dim: str,
+    buckets: Mapping[int | None, dict[str, Any]],
+    num_workers: int | None = None,
+    **compile_kwargs: Any,
+) -> BucketedKernel:
+    """Compile one specialization of ``func`` per bucket of the dynamic dimension ``dim``.
+
+    Parameters
+    ----------
+    func : Callable[..., PrimFunc]
+        Builds the program from the keyword configuration of a bucket. The
+        program must keep ``dim`` symbolic.
+    dim : str
+        Name of the symbolic dimension to dispatch on.
+    buckets : Mapping[int | None, dict]
+        Configuration of each bucket keyed by its inclusive upper bound; the
+        ``None`` key configures the bucket of all larger sizes.
+    num_workers : int, optional
+        Number of parallel compilation workers.
+    **compile_kwargs
+        Forwarded to :func:`tilelang.jit.par_compile` (``out_idx``,
+        ``target``, ``execution_backend``, ``pass_configs``, ...).
+    """
+    from tilelang.jit import par_compile
+
+    if not buckets:
+        raise ValueError("compile_buckets requires at least one bucket")
+    bounds = list(buckets)
+    kernels = par_compile([func(**buckets[bound]) for bound in bounds], num_workers=num_workers, **compile_kwargs)
+    return BucketedKernel(dict(zip(bounds, kernels)), dim)
@@ -0,0 +1,144 @@
+"""Bounded tables of compiled kernels.
+
+Every ``@tilelang.jit`` function keeps the kernels it compiled by call key,
+which holds the shapes bound to its symbolic dimensions and the dtypes of its
+tensors, and the kernel cache keeps every kernel it built or loaded. A
+long-running service seeing new shapes keeps adding kernels, and with them
+their loaded device modules. A :class:`KernelDispatchTable` bounds the number
+of kernels it holds, evicting the least recently used one past its capacity,
+which unloads the modules of the kernel once nothing else references it.
+
+The capacity of the tables defaults to ``TILELANG_KERNEL_CACHE_CAPACITY``
+(no bound when 0), and ``stats()`` reports how well it fits the workload::
+
+    @tilelang.jit(kernel_cache_capacity=64)
+    def gemm(A, B):
+        ...
+
+    print(gemm.cache_stats())  # KernelCacheStats(hits=..., misses=..., evictions=..., ...)
+"""
+
+from __future__ import annotations
+
+import threading
+from collections import OrderedDict
+from collections.abc import Hashable, Iterator
+from dataclasses import dataclass
+from typing import Any, Callable
+
+_MISSING = object()
+
+
+@dataclass(frozen=True)
+class KernelCacheStats:
+    """Lookups of a :class:`KernelDispatchTable` since its creation or last reset."""
+
+    hits: int
+    misses: int
+    evictions: int
+    size: int
+    capacity: int | None
+
+    @property
+    def hit_rate(self) -> float:
+        lookups = self.hits + self.misses
+        return self.hits / lookups if lookups else 0.0
+
+
+class KernelDispatchTable:
+    """Least-recently-used table of kernels, counting its hits and misses.
+
+    Lookups through ``get`` and ``[]`` refresh the entry they hit; ``in``
+    neither refreshes nor counts. The table is safe to share between threads,
+    e.g. with the workers of ``tilelang.jit.BackgroundJIT``.
+
+    Parameters
+    ----------
+    capacity : int, optional
+        Maximum number of kernels held, no bound when None or 0.
+    on_evict : Callable, optional
+        Called with the key and the kernel of every evicted entry.
+    """
+
+    def __init__(self, capacity: int | None = None, on_evict: Callable[[Hashable, Any], None] | None = None):
+        if capacity is not None and capacity < 0:
+            raise ValueError(f"Kernel cache capacity must be non-negative, got {capacity}")
+        self.capacity = capacity or None
+        self.on_evict = on_evict
+        self._entries: OrderedDict[Hashable, Any] = OrderedDict()
+        self._lock = threading.Lock()
+        self._hits = 0
+        self._misses = 0
+        self._evictions = 0
+
+    def get(self, key: Hashable, default: Any = None) -> Any:
+        with self._lock:
+            kernel = self._entries.get(key, _MISSING)
+            if kernel is _MISSING:
+                self._misses += 1
+                return default
+            self._hits += 1
+            self._entries.move_to_end(key)
+            return kernel
+
+    def __getitem__(self, key: Hashable) -> Any:
+        kernel = self.get(key, _MISSING)
+        if kernel is _MISSING:
+            raise KeyError(key)
+        return kernel
+
+    def __setitem__(self, key: Hashable, kernel: Any):
+        with self._lock:
+            self._entries[key] = kernel
+            self._entries.move_to_end(key)
+            evicted = []
+            while self.capacity is not None and len(self._entries) > self.capacity:
+                evicted.append(self._entries.popitem(last=False))
+            self._evictions += len(evicted)
+        # Outside of the lock, the callback may look up the table
+        if self.on_evict is not None:
+            for evicted_key, evicted_kernel in evicted:
+                self.on_evict(evicted_key, evicted_kernel)
+
+    def __contains__(self, key: Hashable) -> bool:
+        return key in self._entries
+
+    def __len__(self) -> int:
+        return len(self._entries)
+
+    def __iter__(self) -> Iterator[Hashable]:
+        with self._lock:
+            return iter(list(self._entries))
+
+    def pop(self, key: Hashable, default: Any = _MISSING) -> Any:
+        with self._lock:
+            if default is _MISSING:
+                return self._entries.pop(key)
+            return self._entries.pop(key, default)
+
+    def keys(self) -> list[Hashable]:
+        with self._lock:
+            return list(self._entries.keys())
+
+    def values(self) -> list[Any]:
+        with self._lock:
+            return list(self._entries.values())
+
+    def items(self) -> list[tuple[Hashable, Any]]:
+        with self._lock:
+            return list(self._entries.items())
+
+    def clear(self):
+        with self._lock:
+            self._entries.clear()
+
+    def stats(self) -> KernelCacheStats:
+        with self._lock:
+            return KernelCacheStats(self._hits, self._misses, self._evictions, len(self._entries), self.capacity)
+
+    def reset_stats(self):
+        with self._lock:
+            self._hits = self._misses = self._evictions = 0
+
+    def __repr__(self) -> str:
+        return f"KernelDispatchTable(size={len(self._entries)}, capacity={self.capacity})"
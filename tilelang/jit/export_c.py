@@ -0,0 +1,137 @@
+"""Export of a kernel as a C library, called without Python or TVM.
+
+The host code generated for the ``cython`` backend is already plain CUDA
+C++: it sets the function attributes, builds the TMA descriptors, computes
+the launch configuration from the dynamic dimensions and launches the
+kernels. ``export_c`` writes it out with entry points named after the kernel
+and a header declaring them with typed arguments and C linkage::
+
+    kernel = tilelang.compile(matmul(M, N, K), out_idx=[2], execution_backend="cython")
+    kernel.export_c("build/gemm", name="gemm")
+
+    // gemm.h
+    int gemm_init(void);
+    int gemm_launch(half* A, half* B, half* C, cudaStream_t stream);
+    const char* gemm_get_last_error(void);
+
+Outputs are arguments of ``<name>_launch`` like the inputs, allocated by the
+caller. ``<name>_init`` configures the current device and ``<name>_launch``
+any other device it first runs on; both return non-zero on failure, with a
+message from ``<name>_get_last_error``. The exported ``<name>.cu`` can be
+compiled into the application, or linked as the ``lib<name>.so`` built
+here.
+"""
+
+from __future__ import annotations
+
+import os
+import re
+import shutil
+from typing import TYPE_CHECKING
+
+from tilelang.jit.adapter.utils import is_cuda_target
+
+if TYPE_CHECKING:
+    from tilelang.jit.kernel import JITKernel
+
+# Types of the host code spelled with the CUDA headers
+_C_TYPES = {
+    "half_t": "half",
+    "bfloat16_t": "__nv_bfloat16",
+    "fp8_e4_t": "__nv_fp8_e4m3",
+    "fp8_e5_t": "__nv_fp8_e5m2",
+}
+
+_ENTRY_POINTS = {
+    r'extern "C" int call\(': 'extern "C" int {name}_launch(',
+    r'extern "C" int init\(\)': 'extern "C" int {name}_init()',
+    r'extern "C" const char\* get_last_error\(\)': 'extern "C" const char* {name}_get_last_error()',
+}
+
+_HEADER = """\
+// Generated by TileLang, launcher of the kernel {name}.
+#pragma once
+
+#include <stdint.h>
+#include <cuda_runtime.h>
+#include <cuda_fp16.h>
+#include <cuda_bf16.h>
+#include <cuda_fp8.h>
+
+#ifdef __cplusplus
+extern "C" {{
+#endif
+
+// Configures the current device, returns non-zero on failure.
+int {name}_init(void);
+
+// Launches the kernel on `stream`, returns non-zero on failure.
+int {name}_launch({args});
+
+// Message of the last failure.
+const char* {name}_get_last_error(void);
+
+#ifdef __cplusplus
+}}
+#endif
+"""
+
+
+def _launch_args(host_source: str) -> str:
+    match = re.search(r'extern "C" int call\((.*?)\)\s*\{', host_source, re.S)
+    if match is None:
+        raise ValueError("The host source of the kernel has no launch function")
+    args = []
+    for arg in match.group(1).split(","):
+        # drop default values and qualifiers that C does not know
+        arg = arg.split("=")[0].replace("__restrict__", "").strip()
+        arg = re.sub(r"\b\w+\b", lambda m: _C_TYPES.get(m.group(0), m.group(0)), arg, count=1)
+        args.append(" ".join(arg.split()))
+    return ", ".join(args)
+
+
+def export_c(kernel: JITKernel, directory: str, name: str | None = None, build: bool = True) -> dict[str, str]:
+    """Write the C library of a kernel compiled with the ``cython`` backend.
+
+    Args:
+        kernel: The compiled kernel
+        directory: Output directory, created if missing
+        name: Prefix of the entry points and files, the name of the kernel by default
+        build: Also compile ``lib<name>.so``
+
+    Returns:
+        dict[str, str]: Paths of the ``header``, ``source`` and, when built, ``library``
+    """
+    if kernel.execution_backend != "cython" or not is_cuda_target(kernel.target):
+        raise ValueError("export_c requires a CUDA kernel compiled with execution_backend='cython'")
+    if name is None:
+        name = kernel.prim_func.attrs["global_symbol"]
+    if not re.fullmatch(r"[A-Za-z_]\w*", name):
+        raise ValueError(f"{name!r} is not a valid C identifier")
+
+    host_source = kernel.adapter.get_host_source()
+    source = host_source
+    for pattern, replacement in _ENTRY_POINTS.items():
+        source = re.sub(pattern, replacement.format(name=name), source)
+
+    os.makedirs(directory, exist_ok=True)
+    paths = {
+        "header": os.path.join(directory, f"{name}.h"),
+        "source": os.path.join(directory, f"{name}.cu"),
+    }
+    with open(paths["header"], "w") as f:
+        f.write(_HEADER.format(name=name, args=_launch_args(host_source)))
+    with open(paths["source"], "w") as f:
+        f.write(source)
+
+    if build:
+        from tilelang.jit.adapter.libgen import LibraryGenerator
+
+        lib_generator = LibraryGenerator(kernel.target, kernel.verbose)
+        lib_generator.assign_pass_configs(kernel.pass_configs or {})
+        lib_generator.assign_compile_flags(kernel.compile_flags)
+        lib_generator.update_lib_code(source)
+        lib_generator.compile_lib()
+        paths["library"] = os.path.join(directory, f"lib{name}.so")
+        shutil.move(lib_generator.libpath, paths["library"])
+    return paths
@@ -0,0 +1,318 @@
+"""CUDA graph replay for JITKernel launches.
+
+``JITKernel.graph()`` returns a :class:`KernelGraph` that records the launches
+issued by one kernel call into a CUDA graph, once per argument signature, and
+replays that graph on later calls. Between replays only the pointer arguments
+change; they are patched into the instantiated graph with
+``cuGraphExecKernelNodeSetParams`` so the host wrapper (argument validation,
+TMA descriptor encoding, launch configuration) is not executed again.
+
+Pointer parameters are located by value: after capture every kernel node
+parameter is compared against the data pointers of the tensors that were
+passed in. 8-byte parameters holding a tensor pointer are rewritten directly,
+128-byte ``CUtensorMap`` parameters referencing a tensor are retargeted with
+``cuTensorMapReplaceAddress``. Signatures whose parameters cannot be mapped
+unambiguously are executed eagerly.
+
+HIP kernels are recorded into hipGraphs through ``torch.cuda.CUDAGraph``. HIP
+exposes no parameter layout of a kernel node to patch, so the data pointers
+of the inputs are part of the signature there, and a replay returns the
+outputs recorded with the graph, overwritten by the next replay.
+"""
+
+from __future__ import annotations
+
+import ctypes
+import logging
+from collections import OrderedDict
+from dataclasses import dataclass, field
+from typing import TYPE_CHECKING, Any
+
+import torch
+
+if TYPE_CHECKING:
+    from tilelang.jit.kernel import JITKernel
+
+logger = logging.getLogger(__name__)
+
+try:
+    import cuda.bindings.driver as cuda
+
+    is_cuda_graph_available = True
+except ImportError as e:
+    logger.debug(f"cuda-python import failed: {e}")
+    is_cuda_graph_available = False
+
+_POINTER_BYTES = 8
+_TENSOR_MAP_BYTES = 128
+_TENSOR_MAP_ALIGNMENT = 64
+
+
+def _check(result):
+    """Unpack a cuda-python driver call and raise on error."""
+    err, *values = result
+    if err != cuda.CUresult.CUDA_SUCCESS:
+        _, msg = cuda.cuGetErrorString(err)
+        raise RuntimeError(f"CUDA driver error {err}: {msg.decode() if msg else ''}")
+    if not values:
+        return None
+    return values[0] if len(values) == 1 else tuple(values)
+
+
+class _ParamBuffer:
+    """Host copy of one kernel parameter, aligned for CUtensorMap use."""
+
+    def __init__(self, data: bytes):
+        self.size = len(data)
+        self._storage = ctypes.create_string_buffer(self.size + _TENSOR_MAP_ALIGNMENT)
+        base = ctypes.addressof(self._storage)
+        self.address = (base + _TENSOR_MAP_ALIGNMENT - 1) & ~(_TENSOR_MAP_ALIGNMENT - 1)
+        ctypes.memmove(self.address, data, self.size)
+
+
+@dataclass
+class _KernelNode:
+    node: Any
+    params: Any
+    buffers: list[_ParamBuffer]
+    param_array: Any
+    # (param index, pointer argument index, is tensor map)
+    slots: list[tuple[int, int, bool]] = field(default_factory=list)
+
+
+@dataclass
+class _GraphEntry:
+    graph: Any
+    graph_exec: Any
+    nodes: list[_KernelNode]
+    # (shape, stride, dtype, device) of every output, in return order
+    output_meta: list[tuple[tuple[int, ...], tuple[int, ...], torch.dtype, torch.device]]
+    # Whether the kernel returns its outputs as a list rather than one tensor
+    return_list: bool
+    device: torch.device
+    last_pointers: tuple[int, ...] | None = None
+
+    def destroy(self):
+        cuda.cuGraphExecDestroy(self.graph_exec)
+        cuda.cuGraphDestroy(self.graph)
+
+
+@dataclass
+class _HipGraphEntry:
+    graph: torch.cuda.CUDAGraph
+    # The outputs written by every replay of the graph
+    outputs: Any
+
+    def destroy(self):
+        self.graph.reset()
+
+
+class KernelGraph:
+    """Replay a JITKernel call through cached CUDA graphs.
+
+    Parameters
+    ----------
+    kernel : JITKernel
+        The compiled CUDA kernel to record.
+    max_graphs : int, optional
+        Maximum number of argument signatures kept alive; the least recently
+        used graph is destroyed beyond that (default: 16).
+
+    Notes
+    -----
+    The first call of a signature runs eagerly and records the graph; only
+    later calls replay it. Scalar arguments are part of the signature, so
+    kernels whose scalars change on every call do not benefit from replay.
+    Kernels with ``T.Workspace`` parameters always run eagerly, since their
+    workspaces are served per stream on every call.
+    """
+
+    def __init__(self, kernel: JITKernel, max_graphs: int = 16):
+        self._is_hip = kernel.target.kind.name == "hip"
+        if not self._is_hip:
+            if not is_cuda_graph_available:
+                raise ImportError("CUDA graph replay requires cuda-python, install it via `pip install cuda-python`.")
+            if kernel.target.kind.name != "cuda":
+                raise ValueError(f"CUDA graph replay is only supported for cuda and hip targets, got {kernel.target}")
+        self.kernel = kernel
+        self.max_graphs = max_graphs
+        self._eager = kernel.adapter.workspace_layout is not None
+        self._entries: OrderedDict[tuple, _GraphEntry | None] = OrderedDict()
+        self.hits = 0
+        self.misses = 0
+
+    @property
+    def num_graphs(self) -> int:
+        return sum(entry is not None for entry in self._entries.values())
+
+    def clear(self) -> None:
+        """Destroy every recorded graph."""
+        for entry in self._entries.values():
+            if entry is not None:
+                entry.destroy()
+        self._entries.clear()
+
+    def __del__(self):
+        if is_cuda_graph_available or self._is_hip:
+            try:
+                self.clear()
+            except Exception:  # noqa: BLE001 - interpreter may be shutting down
+                pass
+
+    @staticmethod
+    def _signature(args: tuple) -> tuple:
+        signature = []
+        seen_pointers: dict[int, int] = {}
+        for arg in args:
+            if isinstance(arg, torch.Tensor):
+                # Aliased inputs are part of the signature, otherwise a pointer
+                # slot could not be mapped back to a single argument.
+                alias = seen_pointers.setdefault(arg.data_ptr(), len(seen_pointers))
+                signature.append((tuple(arg.shape), arg.stride(), arg.dtype, arg.device, alias))
+            else:
+                signature.append((type(arg), arg))
+        return tuple(signature)
+
+    def __call__(self, *args: Any) -> Any:
+        if self._eager:
+            return self.kernel(*args)
+        key = self._signature(args)
+        if self._is_hip:
+            key += tuple(arg.data_ptr() for arg in args if isinstance(arg, torch.Tensor))
+        if key in self._entries:
+            entry = self._entries[key]
+            self._entries.move_to_end(key)
+            if entry is not None:
+                self.hits += 1
+                return self._replay(entry, args)
+            return self.kernel(*args)
+
+        self.misses += 1
+        # The eager call loads the module and sets function attributes outside
+        # of capture; its outputs are the result of this call.
+        result = self.kernel(*args)
+        try:
+            entry = self._capture(args)
+        except Exception as e:  # noqa: BLE001 - fall back to eager launches
+            logger.warning(f"CUDA graph capture failed for {self.kernel.prim_func.attrs.get('global_symbol')}: {e}")
+            entry = None
+        self._entries[key] = entry
+        while len(self._entries) > self.max_graphs:
+            _, evicted = self._entries.popitem(last=False)
+            if evicted is not None:
+                evicted.destroy()
+        return result
+
+    def _capture(self, args: tuple) -> _GraphEntry | _HipGraphEntry:
+        if self._is_hip:
+            return self._capture_hip(args)
+        device = next((arg.device for arg in args if isinstance(arg, torch.Tensor)), torch.device("cuda", torch.cuda.current_device()))
+        capture_stream = torch.cuda.Stream(device=device)
+        capture_stream.wait_stream(torch.cuda.current_stream(device))
+        stream = cuda.CUstream(capture_stream.cuda_stream)
+
+        with torch.cuda.stream(capture_stream):
+            _check(cuda.cuStreamBeginCapture(stream, cuda.CUstreamCaptureMode.CU_STREAM_CAPTURE_MODE_RELAXED))
+            try:
+                outputs = self.kernel(*args)
+            finally:
+                graph = _check(cuda.cuStreamEndCapture(stream))
+        return_list = not isinstance(outputs, torch.Tensor)
+        outputs = [outputs] if not return_list else list(outputs or [])
+
+        try:
+            pointers = self._pointers(args, outputs)
+            pointer_index: dict[int, int] = {}
+            for i, ptr in enumerate(pointers):
+                pointer_index.setdefault(ptr, i)
+            nodes = self._collect_kernel_nodes(graph, pointer_index)
+            graph_exec = _check(cuda.cuGraphInstantiate(graph, 0))
+        except Exception:
+            cuda.cuGraphDestroy(graph)
+            raise
+
+        output_meta = [(tuple(t.shape), t.stride(), t.dtype, t.device) for t in outputs]
+        return _GraphEntry(
+            graph=graph,
+            graph_exec=graph_exec,
+            nodes=nodes,
+            output_meta=output_meta,
+            return_list=return_list,
+            device=device,
+            last_pointers=tuple(pointers),
+        )
+
+    def _capture_hip(self, args: tuple) -> _HipGraphEntry:
+        device = next((arg.device for arg in args if isinstance(arg, torch.Tensor)), torch.device("cuda", torch.cuda.current_device()))
+        capture_stream = torch.cuda.Stream(device=device)
+        capture_stream.wait_stream(torch.cuda.current_stream(device))
+        graph = torch.cuda.CUDAGraph()
+        with torch.cuda.graph(graph, stream=capture_stream):
+            outputs = self.kernel(*args)
+        return _HipGraphEntry(graph=graph, outputs=outputs)
+
+    @staticmethod
+    def _pointers(args: tuple, outputs: list[torch.Tensor]) -> list[int]:
+        return [t.data_ptr() for t in args if isinstance(t, torch.Tensor)] + [t.data_ptr() for t in outputs]
+
+    @staticmethod
+    def _collect_kernel_nodes(graph, pointer_index: dict[int, int]) -> list[_KernelNode]:
+        _, num_nodes = _check(cuda.cuGraphGetNodes(graph, 0))
+        graph_nodes, _ = _check(cuda.cuGraphGetNodes(graph, num_nodes))
+        nodes = []
+        for node in graph_nodes:
+            if _check(cuda.cuGraphNodeGetType(node)) != cuda.CUgraphNodeType.CU_GRAPH_NODE_TYPE_KERNEL:
+                continue
+            params = _check(cuda.cuGraphKernelNodeGetParams(node))
+            sizes = []
+            while True:
+                err, _, size = cuda.cuFuncGetParamInfo(params.func, len(sizes))
+                if err != cuda.CUresult.CUDA_SUCCESS:
+                    break
+                sizes.append(size)
+            raw = (ctypes.c_void_p * len(sizes)).from_address(int(params.kernelParams))
+            buffers = [_ParamBuffer(ctypes.string_at(raw[i], size)) for i, size in enumerate(sizes)]
+
+            slots = []
+            for i, buf in enumerate(buffers):
+                if buf.size == _POINTER_BYTES:
+                    value = ctypes.c_uint64.from_address(buf.address).value
+                    if value in pointer_index:
+                        slots.append((i, pointer_index[value], False))
+                elif buf.size == _TENSOR_MAP_BYTES:
+                    words = (ctypes.c_uint64 * (_TENSOR_MAP_BYTES // 8)).from_address(buf.address)
+                    matched = {pointer_index[w] for w in words if w in pointer_index}
+                    # A stale descriptor would silently address freed memory,
+                    # so an unmapped tensor map disables replay.
+                    if len(matched) != 1:
+                        raise RuntimeError(f"cannot map tensor map parameter {i} to a single argument")
+                    slots.append((i, matched.pop(), True))
+
+            param_array = (ctypes.c_void_p * max(len(buffers), 1))(*[buf.address for buf in buffers])
+            params.kernelParams = ctypes.addressof(param_array)
+            params.extra = 0
+            nodes.append(_KernelNode(node=node, params=params, buffers=buffers, param_array=param_array, slots=slots))
+        return nodes
+
+    def _replay(self, entry: _GraphEntry | _HipGraphEntry, args: tuple) -> Any:
+        if isinstance(entry, _HipGraphEntry):
+            entry.graph.replay()
+            return entry.outputs
+        outputs = [torch.empty_strided(shape, stride, dtype=dtype, device=device) for shape, stride, dtype, device in entry.output_meta]
+        pointers = tuple(self._pointers(args, outputs))
+        if pointers != entry.last_pointers:
+            for node in entry.nodes:
+                if not node.slots:
+                    continue
+                for param_idx, pointer_idx, is_tensor_map in node.slots:
+                    buf = node.buffers[param_idx]
+                    if is_tensor_map:
+                        _check(cuda.cuTensorMapReplaceAddress(cuda.CUtensorMap(_ptr=buf.address), pointers[pointer_idx]))
+                    else:
+                        ctypes.c_uint64.from_address(buf.address).value = pointers[pointer_idx]
+                _check(cuda.cuGraphExecKernelNodeSetParams(entry.graph_exec, node.node, node.params))
+            entry.last_pointers = pointers
+
+        stream = cuda.CUstream(torch.cuda.current_stream(entry.device).cuda_stream)
+        _check(cuda.cuGraphLaunch(entry.graph_exec, stream))
+        return outputs if entry.return_list else outputs[0]
@@ -1,5 +1,5 @@
 from __future__ import annotations
-from typing import Any, Callable, Generic, Literal, TypeVar
+from typing import TYPE_CHECKING, Any, Callable, Generic, Literal, TypeVar
 
 # Python 3.9 compatibility for ParamSpec
 try:
@@ -15,6 +15,7 @@ import tilelang
 from tilelang import tvm
 from tilelang import env
 from tilelang.engine.param import CompiledArtifact, KernelParam
+from tilelang.engine.compile_profile import CompileProfile, current_compile_profile, is_compile_profile_enabled
 from tilelang.jit.adapter import (
     BaseKernelAdapter,
     CythonKernelAdapter,
@@ -24,10 +25,17 @@ from tilelang.jit.adapter import (
 )
 from tilelang.profiler import Profiler, TensorSupplyType
 from tilelang.utils.target import determine_target
+from tilelang.utils.language import get_prim_func_name
 from tilelang.contrib import nvcc as tl_nvcc
 from tilelang.transform import PassConfigKey
+import contextlib
 import logging
 import os
+import time
+
+if TYPE_CHECKING:
+    from tilelang.jit.graph import KernelGraph
+    from tilelang.engine.traffic import KernelTrafficReport
 
 logger = logging.getLogger(__name__)
 
@@ -47,12 +55,18 @@ class JITKernel(Generic[_P, _T]):
         The adapter for the compiled function.
     torch_function : Callable
         The compiled function that can be invoked as a PyTorch-compatible function.
+    compile_profile : CompileProfile
+        The compile time profile of the kernel when compile profiling is enabled
+        (see `tilelang.engine.compile_profile`), None otherwise.
     """
 
     prim_func: PrimFunc = None
     artifact: CompiledArtifact = None
     adapter: BaseKernelAdapter = None
     torch_function: Callable = None
+    compile_profile: CompileProfile = None
+    _graph: KernelGraph = None
+    _traffic: list[KernelTrafficReport] = None
 
     # tuner result
     latency: float = None
@@ -134,7 +148,15 @@ class JITKernel(Generic[_P, _T]):
             logger.info(f"TileLang begins to compile kernel `{func_name}` with `{out_idx=}`")
 
         # Compile the TileLang function and create a kernel adapter for execution.
-        adapter = self._compile_and_create_adapter(func, out_idx)
+        if is_compile_profile_enabled(pass_configs):
+            self.compile_profile = CompileProfile(kernel_name=get_prim_func_name(func, ""), target=str(self.target))
+        start = time.perf_counter()
+        with self.compile_profile.activate() if self.compile_profile else contextlib.nullcontext():
+            adapter = self._compile_and_create_adapter(func, out_idx)
+        if self.compile_profile:
+            self.compile_profile.total_ms = (time.perf_counter() - start) * 1e3
+            if verbose:
+                logger.info(self.compile_profile.summary())
 
         if env.is_print_on_compilation_enabled():
             func_name = func.attrs.get("global_symbol")
@@ -238,7 +260,9 @@ class JITKernel(Generic[_P, _T]):
         # Compile the function with TVM, optimizing with shared memory lowering.
         enable_host_codegen = execution_backend == "tvm_ffi"
         enable_device_compile = execution_backend == "tvm_ffi"
-        with tvm.transform.PassContext(opt_level=3, config=pass_configs), self.target:
+        profile = current_compile_profile()
+        instruments = [profile.instrument()] if profile is not None else []
+        with tvm.transform.PassContext(opt_level=3, config=pass_configs, instruments=instruments), self.target:
             artifact = tilelang.lower(
                 tilelang_func,
                 target=target,
@@ -248,6 +272,7 @@ class JITKernel(Generic[_P, _T]):
             )
 
         self.artifact = artifact
+        adapter_start = time.perf_counter()
 
         # Create an adapter based on the specified execution backend.
         if execution_backend == "tvm_ffi":
@@ -327,6 +352,9 @@ class JITKernel(Generic[_P, _T]):
             # Handle invalid backend.
             raise ValueError(f"Invalid execution backend: {execution_backend}")
 
+        if profile is not None:
+            # Includes the host compiler (and nvcc for the cython/nvrtc backends).
+            profile.stages["adapter"] = (time.perf_counter() - adapter_start) * 1e3
         return adapter
 
     def _create_adapter_from_database(
@@ -457,6 +485,132 @@ class JITKernel(Generic[_P, _T]):
         assert self.artifact.host_mod is not None, "host_mod is not available"
         return str(self.artifact.host_mod)
 
+    def graph(self, max_graphs: int = 16) -> KernelGraph:
+        """
+        Returns a callable that replays this kernel through CUDA graphs.
+
+        The launch is recorded once per argument signature (shapes, strides,
+        dtypes and scalar values) and replayed on later calls with only the
+        pointer arguments patched, skipping the host wrapper entirely. On HIP
+        the graphs are hipGraphs, recorded per input pointers as well.
+
+        Parameters
+        ----------
+        max_graphs : int, optional
+            Maximum number of signatures kept alive (default: 16).
+
+        Returns
+        -------
+        KernelGraph
+            A callable with the same signature as this kernel.
+        """
+        if self._graph is None or self._graph.max_graphs != max_graphs:
+            from tilelang.jit.graph import KernelGraph
+
+            self._graph = KernelGraph(self, max_graphs=max_graphs)
+        return self._graph
+
+    def traffic_report(self, arch=None) -> list[KernelTrafficReport]:
+        """
+        Returns the static flop and memory traffic report of the kernels.
+
+        The report is computed once from the tile-level IR of the kernel,
+        lowered with the pass configs it was compiled with, see
+        ``tilelang.engine.traffic``.
+
+        Parameters
+        ----------
+        arch : TileDevice, optional
+            Architecture providing the roofline peaks (default: the one of
+            the compilation target).
+
+        Returns
+        -------
+        list[KernelTrafficReport]
+            One report per kernel of the program.
+        """
+        if self._traffic is not None and arch is None:
+            return self._traffic
+        from tilelang.carver.arch import get_arch
+        from tilelang.engine.traffic import analyze_traffic
+
+        cache = arch is None
+        if arch is None:
+            try:
+                arch = get_arch(self.target)
+            except ValueError:
+                # Targets without a TileDevice get no predicted bound
+                arch = None
+        with tvm.transform.PassContext(opt_level=3, config=self.pass_configs or {}):
+            reports = analyze_traffic(self.prim_func, target=self.target, target_host=self.target_host, arch=arch)
+        if cache:
+            self._traffic = reports
+        return reports
+
+    def bind(self, *args: Any) -> Callable:
+        """
+        Returns a call of this kernel prepared for inputs shaped like ``args``.
+
+        The inputs are validated once and the packed launch arguments are
+        cached, so later calls with tensors of the same dtypes, devices,
+        shapes and strides only update the data pointers. Unlike ``graph``,
+        every call still goes through the host wrapper, so kernels whose
+        launch configuration depends on scalar arguments stay valid.
+
+        Parameters
+        ----------
+        *args : Any
+            Inputs of a call to this kernel, outputs excluded.
+
+        Returns
+        -------
+        Callable
+            A callable taking inputs with the bound metadata. With the cython
+            backend it accepts ``skip_tensor_validation=True`` to skip the
+            metadata comparison, leaving only a check of the version stamp
+            of the kernel.
+        """
+        layout = self.adapter.workspace_layout
+        if layout is None:
+            return self.adapter.bind(*args)
+        # The workspaces are served again on every call, on its stream
+        return layout.wrap(self.adapter.bind(*layout.insert(args)))
+
+    def call_dlpack(self, *args: Any, stream: int | None = None) -> Any:
+        """
+        Runs this kernel on tensors of any framework implementing DLPack.
+
+        Unlike a regular call, it does not go through torch: the inputs are
+        any objects with ``__dlpack__`` (JAX and CuPy arrays, numpy arrays
+        for CPU targets, ...), passed as views of their memory, and the
+        outputs are TVM tensors the caller imports without a copy.
+
+        Parameters
+        ----------
+        *args : Any
+            Inputs of a call to this kernel, outputs excluded.
+        stream : int, optional
+            Raw handle of the stream to launch on, the default stream when
+            None. It is handed to the producers of the inputs as per the
+            DLPack stream protocol, so they order their pending work before
+            the kernel instead of synchronizing.
+
+        Returns
+        -------
+        Any
+            The output tensors, as TVM tensors implementing DLPack.
+
+        Example
+        -------
+        >>> out = kernel.call_dlpack(a_jax, b_jax)
+        >>> c = jax.dlpack.from_dlpack(out)
+
+        Only the tvm_ffi execution backend implements it.
+        """
+        if self.adapter.workspace_layout is not None:
+            raise NotImplementedError("Kernels with T.Workspace parameters only take torch tensors")
+        return self.adapter.call_dlpack(*args, stream=stream)
+
     def run_once(self, func: Callable | None = None) -> None:
         return self.get_profiler().run_once(func)
 
@@ -649,6 +803,18 @@ class JITKernel(Generic[_P, _T]):
         self.artifact.rt_mod.export_library(kernel_file)
         logger.info(f"Kernel library exported to {os.path.abspath(kernel_file)}")
 
+    def export_c(self, directory: str, name: str | None = None, build: bool = True) -> dict[str, str]:
+        """
+        Exports the kernel as a C library with typed entry points, callable without Python or TVM.
+
+        See `tilelang.jit.export_c.export_c`.
+        """
+        from tilelang.jit.export_c import export_c
+
+        paths = export_c(self, directory, name=name, build=build)
+        logger.info(f"Kernel launcher exported to {os.path.abspath(directory)}")
+        return paths
+
     def _get_ptx(self, verbose: bool | None = None) -> str:
         """
         Compile and return PTX for the current kernel (CUDA only).
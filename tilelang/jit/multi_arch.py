@@ -0,0 +1,128 @@
+"""Kernels compiled for several CUDA architectures.
+
+A program built for one architecture only runs on GPUs of its compute
+capability family, and the architecture decides how it is lowered: MMA on
+Ampere, WGMMA and TMA on Hopper (``sm_90a``), tcgen05 on Blackwell
+(``sm_100a``). ``compile_multi_arch`` lowers and compiles the program once per
+architecture, which only requires ``nvcc`` and no GPU, e.g. on a CPU-only
+build machine. The resulting :class:`MultiArchKernel` picks the variant of
+the device it runs on when it is first called on that device::
+
+    kernel = tilelang.jit.compile_multi_arch(matmul(M, N, K), archs=["sm_80", "sm_90a", "sm_100a"], out_idx=[2])
+    C = kernel(A, B)  # the sm_90a variant on an H100, the sm_80 one on an A100 or L40
+
+    # ship every variant in one file, selected when the bundle is loaded
+    tilelang.bundle.export_bundle({"matmul": kernel}, "matmul.tlb")
+
+The variants differ in their device code and in their host launcher (e.g.
+the TMA descriptors of Hopper kernels), so each is a library of its own
+rather than an image of a single fatbin. Each variant is an entry of the
+kernel cache keyed by its target, so a rebuild only compiles the missing
+architectures. Variants must be compiled with an execution backend whose
+compilation does not need a GPU, the ``cython`` default.
+"""
+
+from __future__ import annotations
+
+import concurrent.futures
+import threading
+from collections.abc import Sequence
+from typing import Any
+
+from tvm import tir
+
+from tilelang.bundle import parse_arch, select_arch
+from tilelang.jit.kernel import JITKernel
+
+
+class MultiArchKernel:
+    """Run the variant of a kernel compiled for the architecture of each device.
+
+    Parameters
+    ----------
+    kernels : dict[str, JITKernel]
+        Variants of one program keyed by architecture, e.g. ``"sm_90a"``.
+    """
+
+    def __init__(self, kernels: dict[str, JITKernel]):
+        if not kernels:
+            raise ValueError("MultiArchKernel requires at least one variant")
+        for arch in kernels:
+            parse_arch(arch)
+        self.kernels = dict(kernels)
+        # device index -> variant, chosen on the first call on that device
+        self._selected: dict[int, JITKernel] = {}
+        self._lock = threading.Lock()
+
+    @property
+    def archs(self) -> list[str]:
+        return list(self.kernels)
+
+    def select(self, device: int | None = None) -> JITKernel:
+        """Return the variant for a CUDA device, the current one by default."""
+        import torch
+
+        if device is None:
+            device = torch.cuda.current_device()
+        kernel = self._selected.get(device)
+        if kernel is None:
+            capability = torch.cuda.get_device_capability(device)
+            arch = select_arch(self.archs, capability)
+            if arch is None:
+                raise RuntimeError(
+                    f"No variant of {self!r} runs on device {device} of compute capability "
+                    f"{capability[0]}.{capability[1]}, compiled for {self.archs}"
+                )
+            with self._lock:
+                kernel = self._selected.setdefault(device, self.kernels[arch])
+        return kernel
+
+    def __call__(self, *args: Any, **kwargs: Any) -> Any:
+        device = next((arg.device.index for arg in args if getattr(arg, "is_cuda", False)), None)
+        return self.select(device)(*args, **kwargs)
+
+    def __repr__(self) -> str:
+        name = next(iter(self.kernels.values())).prim_func.attrs["global_symbol"]
+        return f"MultiArchKernel({name}, archs={self.archs})"
+
+
+def compile_multi_arch(
+    func: tir.PrimFunc,
+    archs: Sequence[str],
+    num_workers: int | None = None,
+    execution_backend: str = "cython",
+    **compile_kwargs: Any,
+) -> MultiArchKernel:
+    """Compile ``func`` once per CUDA architecture.
+
+    Parameters
+    ----------
+    func : PrimFunc
+        The TileLang program.
+    archs : Sequence[str]
+        Architectures to build, e.g. ``["sm_80", "sm_90a", "sm_100a"]``. Each
+        variant is lowered with the passes of its own architecture.
+    num_workers : int, optional
+        Number of parallel compilation workers.
+    execution_backend : str
+        Execution backend of the variants, ``cython`` by default, which can
+        also be exported to a bundle.
+    **compile_kwargs
+        Forwarded to :func:`tilelang.compile` (``out_idx``, ``pass_configs``,
+        ``compile_flags``, ...).
+    """
+    from tilelang.jit import compile
+
+    if not archs:
+        raise ValueError("compile_multi_arch requires at least one architecture")
+    if "target" in compile_kwargs:
+        raise ValueError("compile_multi_arch derives the target of each variant from archs")
+    for arch in archs:
+        parse_arch(arch)
+    with concurrent.futures.ThreadPoolExecutor(num_workers, "tl-multi-arch") as executor:
+        futures = {
+            arch: executor.submit(compile, func=func, target=f"cuda -arch={arch}", execution_backend=execution_backend, **compile_kwargs)
+            for arch in dict.fromkeys(archs)
+        }
+        kernels = {arch: future.result() for arch, future in futures.items()}
+    return MultiArchKernel(kernels)
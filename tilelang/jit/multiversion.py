@@ -0,0 +1,148 @@
+"""Multi-versioned kernels for aligned and unaligned inputs.
+
+When a dimension is symbolic the compiler cannot prove that tiles divide it,
+so tile copies keep their boundary predicates, ``LegalizeSafeMemoryAccess``
+guards global accesses and the vectorizer falls back to narrow accesses
+whenever a dynamic extent enters an index. ``compile_multiversion`` compiles
+two versions of a program:
+
+* a fast version in which every listed dimension is assumed divisible by its
+  factor (through ``T.assume``, which the lowering passes take into account);
+* the unmodified, checked version.
+
+The returned :class:`MultiVersionKernel` checks the extents and the alignment
+of the input pointers on every call, which only costs a few integer
+operations on the host, and launches the fast version when they hold::
+
+    kernel = tilelang.jit.compile_multiversion(
+        matmul(T.dynamic("m"), T.dynamic("k"), N), divisible={"m": 128, "k": 32}, out_idx=[2])
+    C = kernel(A, B)
+"""
+
+from __future__ import annotations
+
+from collections.abc import Mapping
+from typing import Any
+
+from tvm import tir
+
+from tilelang.jit.bucket import _locate_dim
+from tilelang.jit.kernel import JITKernel
+
+
+def assume_divisible(func: tir.PrimFunc, divisible: Mapping[str, int]) -> tir.PrimFunc:
+    """Return ``func`` with ``T.assume(dim % factor == 0)`` for every listed dimension.
+
+    Parameters
+    ----------
+    func : PrimFunc
+        Program with symbolic dimensions in the shapes of its parameters.
+    divisible : Mapping[str, int]
+        Divisor assumed for each dimension, by symbol name.
+    """
+    symbols: dict[str, tir.Var] = {}
+    for buffer in func.buffer_map.values():
+        for extent in buffer.shape:
+            if isinstance(extent, tir.Var):
+                symbols.setdefault(extent.name, extent)
+    assumes = []
+    for name, factor in divisible.items():
+        if name not in symbols:
+            raise ValueError(f"{func.attrs['global_symbol']} has no dynamic dimension {name!r}")
+        assumes.append(tir.Evaluate(tir.assume(tir.floormod(symbols[name], factor) == 0)))
+    if not assumes:
+        return func
+
+    body = func.body
+    # Keep the root block at the top of the function, the assumes go inside it.
+    if isinstance(body, tir.BlockRealize) and body.block.name_hint == "root":
+        block = body.block
+        block = tir.Block(
+            block.iter_vars,
+            block.reads,
+            block.writes,
+            block.name_hint,
+            tir.SeqStmt([*assumes, block.body]),
+            block.init,
+            block.alloc_buffers,
+            block.match_buffers,
+            block.annotations,
+        )
+        body = tir.BlockRealize(body.iter_values, body.predicate, block)
+    else:
+        body = tir.SeqStmt([*assumes, body])
+    return func.with_body(body)
+
+
+class MultiVersionKernel:
+    """Launch the fast version of a kernel when its assumptions hold at runtime.
+
+    Parameters
+    ----------
+    fast : JITKernel
+        Version compiled under the divisibility assumptions.
+    checked : JITKernel
+        Version without assumptions, used for every other call.
+    divisible : Mapping[str, int]
+        Divisor of each dynamic dimension assumed by ``fast``.
+    alignment : int
+        Byte alignment required from the data pointer of every input tensor.
+    """
+
+    def __init__(self, fast: JITKernel, checked: JITKernel, divisible: Mapping[str, int], alignment: int = 16):
+        self.fast = fast
+        self.checked = checked
+        self.alignment = alignment
+        # (input index, axis, factor) of every assumed dimension.
+        self._checks = [(*_locate_dim(checked, dim), factor) for dim, factor in divisible.items()]
+
+    def select(self, *args: Any) -> JITKernel:
+        """Return the version of the kernel valid for the given inputs."""
+        for arg_index, axis, factor in self._checks:
+            if args[arg_index].shape[axis] % factor != 0:
+                return self.checked
+        for arg in args:
+            data_ptr = getattr(arg, "data_ptr", None)
+            if data_ptr is not None and data_ptr() % self.alignment != 0:
+                return self.checked
+        return self.fast
+
+    def __call__(self, *args: Any, **kwargs: Any) -> Any:
+        return self.select(*args)(*args, **kwargs)
+
+    def __repr__(self) -> str:
+        return f"MultiVersionKernel({self.fast.prim_func.attrs['global_symbol']}, alignment={self.alignment})"
+
+
+def compile_multiversion(
+    func: tir.PrimFunc,
+    divisible: Mapping[str, int],
+    alignment: int = 16,
+    num_workers: int | None = None,
+    **compile_kwargs: Any,
+) -> MultiVersionKernel:
+    """Compile a fast version of ``func`` for divisible extents next to the checked one.
+
+    Parameters
+    ----------
+    func : PrimFunc
+        Program with symbolic dimensions.
+    divisible : Mapping[str, int]
+        Divisor assumed by the fast version for each dynamic dimension,
+        typically the tile size along that dimension.
+    alignment : int
+        Byte alignment of the input pointers required by the fast version.
+        Tensors allocated by torch are 256-byte aligned; views with an offset
+        may not be.
+    num_workers : int, optional
+        Number of parallel compilation workers.
+    **compile_kwargs
+        Forwarded to :func:`tilelang.jit.par_compile` (``out_idx``,
+        ``target``, ``execution_backend``, ``pass_configs``, ...).
+    """
+    from tilelang.jit import par_compile
+
+    if not divisible:
+        raise ValueError("compile_multiversion requires at least one divisible dimension")
+    fast, checked = par_compile([assume_divisible(func, divisible), func], num_workers=num_workers, **compile_kwargs)
+    return MultiVersionKernel(fast, checked, divisible, alignment)
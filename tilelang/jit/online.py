@@ -0,0 +1,258 @@
+"""Online tuning of a compiled kernel on the inputs it serves.
+
+Offline tuning picks a configuration for the shapes it was given, which may
+not be the shapes a deployment sees. ``compile_online`` compiles one variant
+per configuration, typically the best few of an autotuning run, and returns
+an :class:`OnlineTunedKernel`. Every call runs the active variant for the
+shape of its inputs. Every ``period``-th call is also timed with CUDA events,
+and an alternative variant runs on the same inputs on a side stream, after
+the real call. Once an alternative has ``min_samples`` timings and beats the
+active variant of that shape by ``promote_ratio``, it becomes the active
+variant::
+
+    kernel = tilelang.jit.compile_online(
+        lambda block_M, block_N: matmul(T.dynamic("m"), N, K, block_M, block_N),
+        configs=[dict(block_M=128, block_N=128), dict(block_M=64, block_N=256)],
+        out_idx=[2],
+    )
+    C = kernel(A, B)  # occasionally times the other variant on A and B
+
+The events are read on later calls once they completed, so the host never
+waits for the device. The shadow launches take at most ``max_overhead`` of
+the measured device time of the real calls: the period grows when the
+alternatives are slower than expected. An alternative that lost its trial
+is not timed again for that shape, when every alternative lost the kernel
+behaves like the active variant alone.
+
+Shadow launches run the alternative on the inputs of the call with freshly
+allocated outputs, so the variants must only write the outputs given by
+``out_idx``.
+"""
+
+from __future__ import annotations
+
+import math
+import statistics
+import threading
+from collections.abc import Sequence
+from dataclasses import dataclass, field
+from logging import getLogger
+from typing import Any, Callable
+
+from tvm import tir
+
+from tilelang.jit.kernel import JITKernel
+
+logger = getLogger(__name__)
+
+
+@dataclass
+class _ShapeState:
+    """Trial of the variants for the inputs of one shape."""
+
+    active: int
+    # latencies of each variant measured on this shape, in milliseconds
+    samples: dict[int, list[float]] = field(default_factory=dict)
+    # variants that lost their trial against the active one
+    retired: set[int] = field(default_factory=set)
+    calls: int = 0
+    next_candidate: int = 0
+
+    def candidate(self, num_variants: int) -> int | None:
+        for _ in range(num_variants):
+            index = self.next_candidate % num_variants
+            self.next_candidate += 1
+            if index != self.active and index not in self.retired:
+                return index
+        return None
+
+
+class OnlineTunedKernel:
+    """Run the best known variant per input shape, timing alternatives on the side.
+
+    Parameters
+    ----------
+    variants : Sequence[JITKernel]
+        Kernels compiled from the same program with different configurations.
+        The first one starts as the active variant of every shape.
+    configs : Sequence[dict], optional
+        Configuration of each variant, reported by ``active_config``.
+    period : int
+        Time every ``period``-th call of a shape at the least.
+    min_samples : int
+        Timings of a variant, and of the active variant, before comparing them.
+    promote_ratio : float
+        Promote an alternative whose median latency is below ``promote_ratio``
+        times the median latency of the active variant.
+    max_overhead : float
+        Upper bound on the device time of the shadow launches, as a fraction
+        of the device time of the real calls.
+    """
+
+    def __init__(
+        self,
+        variants: Sequence[JITKernel],
+        configs: Sequence[dict[str, Any]] | None = None,
+        period: int = 100,
+        min_samples: int = 10,
+        promote_ratio: float = 0.95,
+        max_overhead: float = 0.01,
+    ):
+        if not variants:
+            raise ValueError("OnlineTunedKernel requires at least one variant")
+        if configs is not None and len(configs) != len(variants):
+            raise ValueError(f"Got {len(configs)} configs for {len(variants)} variants")
+        if period < 1 or min_samples < 1 or not 0.0 < max_overhead <= 1.0:
+            raise ValueError("period and min_samples must be positive and max_overhead in (0, 1]")
+        self.variants = list(variants)
+        self.configs = list(configs) if configs is not None else [None] * len(variants)
+        self.period = period
+        self.min_samples = min_samples
+        self.promote_ratio = promote_ratio
+        self.max_overhead = max_overhead
+        self._states: dict[tuple, _ShapeState] = {}
+        # (shape key, variant, start event, end event) of timings not read yet
+        self._pending: list[tuple[tuple, int, Any, Any]] = []
+        self._lock = threading.Lock()
+        self._stream = None
+        self.shadow_launches = 0
+        self.promotions = 0
+
+    @staticmethod
+    def _shape_key(args: Sequence[Any]) -> tuple:
+        return tuple(tuple(arg.shape) if hasattr(arg, "shape") else type(arg) for arg in args)
+
+    def _state(self, key: tuple) -> _ShapeState:
+        state = self._states.get(key)
+        if state is None:
+            with self._lock:
+                state = self._states.setdefault(key, _ShapeState(active=0))
+        return state
+
+    def select(self, *args: Any) -> JITKernel:
+        """Return the active variant for the shapes of the given inputs."""
+        return self.variants[self._state(self._shape_key(args)).active]
+
+    def active_config(self, *args: Any) -> dict[str, Any] | None:
+        return self.configs[self._state(self._shape_key(args)).active]
+
+    def _harvest(self) -> None:
+        """Read the timings whose events completed and promote the winners."""
+        with self._lock:
+            done, pending = [], []
+            for timing in self._pending:
+                (done if timing[3].query() else pending).append(timing)
+            if not done:
+                return
+            self._pending = pending
+            for key, variant, start, end in done:
+                samples = self._states[key].samples.setdefault(variant, [])
+                samples.append(start.elapsed_time(end))
+                # the recent timings follow the load of the device
+                del samples[: -4 * self.min_samples]
+            for key in {timing[0] for timing in done}:
+                self._decide(key, self._states[key])
+
+    def _decide(self, key: tuple, state: _ShapeState) -> None:
+        active_samples = state.samples.get(state.active, [])
+        if len(active_samples) < self.min_samples:
+            return
+        active_latency = statistics.median(active_samples)
+        for variant, samples in list(state.samples.items()):
+            if variant == state.active or variant in state.retired:
+                continue
+            latency = statistics.median(samples)
+            # keep the shadow launches within their share of the device time
+            self.period = max(self.period, math.ceil(latency / (active_latency * self.max_overhead)))
+            if len(samples) < self.min_samples:
+                continue
+            if latency < self.promote_ratio * active_latency:
+                logger.info(f"Promoting variant {variant} ({latency:.4f} ms) over {state.active} ({active_latency:.4f} ms) for shape {key}")
+                state.retired.add(state.active)
+                # a single assignment, calls on other threads see either variant
+                state.active = variant
+                state.samples = {variant: samples}
+                self.promotions += 1
+                return
+            state.retired.add(variant)
+
+    def __call__(self, *args: Any, **kwargs: Any) -> Any:
+        key = self._shape_key(args)
+        state = self._state(key)
+        state.calls += 1
+        active = state.active
+        if state.calls % self.period != 0:
+            return self.variants[active](*args, **kwargs)
+        if self._pending:
+            self._harvest()
+        candidate = state.candidate(len(self.variants))
+        if candidate is None:
+            return self.variants[active](*args, **kwargs)
+        return self._shadow(key, active, candidate, args, kwargs)
+
+    def _shadow(self, key: tuple, active: int, candidate: int, args: tuple, kwargs: dict) -> Any:
+        import torch
+
+        if self._stream is None:
+            self._stream = torch.cuda.Stream()
+        main_stream = torch.cuda.current_stream()
+        start, end = (torch.cuda.Event(enable_timing=True) for _ in range(2))
+        start.record(main_stream)
+        result = self.variants[active](*args, **kwargs)
+        end.record(main_stream)
+
+        side_start, side_end = (torch.cuda.Event(enable_timing=True) for _ in range(2))
+        self._stream.wait_event(end)
+        with torch.cuda.stream(self._stream):
+            for arg in args:
+                if isinstance(arg, torch.Tensor):
+                    # the allocator must not reuse the inputs before the shadow launch read them
+                    arg.record_stream(self._stream)
+            side_start.record()
+            self.variants[candidate](*args, **kwargs)
+            side_end.record()
+        self.shadow_launches += 1
+        with self._lock:
+            self._pending.append((key, active, start, end))
+            self._pending.append((key, candidate, side_start, side_end))
+        return result
+
+    def __repr__(self) -> str:
+        return f"OnlineTunedKernel(variants={len(self.variants)}, shapes={len(self._states)}, promotions={self.promotions})"
+
+
+def compile_online(
+    func: Callable[..., tir.PrimFunc],
+    configs: Sequence[dict[str, Any]],
+    num_workers: int | None = None,
+    period: int = 100,
+    min_samples: int = 10,
+    promote_ratio: float = 0.95,
+    max_overhead: float = 0.01,
+    **compile_kwargs: Any,
+) -> OnlineTunedKernel:
+    """Compile one variant of ``func`` per configuration and tune between them online.
+
+    Parameters
+    ----------
+    func : Callable[..., PrimFunc]
+        Builds the program from the keyword configuration of a variant.
+    configs : Sequence[dict]
+        Configurations of the variants, the first one starts active, e.g. the
+        best configurations of an autotuning run in order.
+    num_workers : int, optional
+        Number of parallel compilation workers.
+    period, min_samples, promote_ratio, max_overhead
+        See :class:`OnlineTunedKernel`.
+    **compile_kwargs
+        Forwarded to :func:`tilelang.jit.par_compile` (``out_idx``,
+        ``target``, ``execution_backend``, ``pass_configs``, ...).
+    """
+    from tilelang.jit import par_compile
+
+    if not configs:
+        raise ValueError("compile_online requires at least one configuration")
+    kernels = par_compile([func(**config) for config in configs], num_workers=num_workers, **compile_kwargs)
+    return OnlineTunedKernel(
+        kernels, configs, period=period, min_samples=min_samples, promote_ratio=promote_ratio, max_overhead=max_overhead
+    )
@@ -14,10 +14,13 @@ from . import overrides as _overrides  # noqa: F401
 from .eager import *  # noqa: F401
 from .tir.ir import *  # noqa: F401
 from tilelang.layout import Layout, Fragment  # noqa: F401
-from .proxy import ptr, make_tensor, Buffer, Tensor, StridedTensor, FragmentBuffer, SharedBuffer, LocalBuffer  # noqa: F401
+from .proxy import ptr, make_tensor, Buffer, Tensor, StridedTensor, Workspace, FragmentBuffer, SharedBuffer, LocalBuffer  # noqa: F401
 from .loop import (
     Parallel,  # noqa: F401
     Persistent,  # noqa: F401
+    StreamK,  # noqa: F401
+    TileQueue,  # noqa: F401
+    VarlenTiles,  # noqa: F401
     Pipelined,  # noqa: F401
     serial,  # noqa: F401
     unroll,  # noqa: F401
@@ -51,11 +54,15 @@ from .allocate import (
     alloc_tcgen05_instr_desc,  # noqa: F401
     empty,  # noqa: F401
 )
-from .copy_op import copy, c2d_im2col  # noqa: F401
+from .copy_op import copy, conv_im2col, conv_dgrad_phase_taps, c2d_im2col, prefetch, gather_copy, gather, scatter  # noqa: F401
 from tilelang.tileop.base import GemmWarpPolicy  # noqa: F401
-from .gemm_op import gemm, gemm_v1, gemm_v2  # noqa: F401
+from .gemm_op import gemm, gemm_v1, gemm_v2, gemm_blockscaled, gemm_epilogue, gemm_prologue  # noqa: F401
 from .experimental.gemm_sp import gemm_sp, gemm_sp_v2  # noqa: F401
 from .fill_op import fill, clear  # noqa: F401
+from .dequantize_op import dequantize  # noqa: F401
+from .hadamard_op import hadamard  # noqa: F401
+from .convert_layout_op import convert_layout  # noqa: F401
+from .symm_op import put, get, signal, signal_wait  # noqa: F401
 from .reduce_op import (
     reduce,  # noqa: F401
     reduce_max,  # noqa: F401
@@ -68,6 +75,11 @@ from .reduce_op import (
     reduce_bitxor,  # noqa: F401
     cumsum,  # noqa: F401
     finalize_reducer,  # noqa: F401
+    cluster_allreduce,  # noqa: F401
+    topk,  # noqa: F401
+    online_softmax,  # noqa: F401
+    norm,  # noqa: F401
+    quantize,  # noqa: F401
     warp_reduce_sum,  # noqa: F401
     warp_reduce_max,  # noqa: F401
     warp_reduce_min,  # noqa: F401
@@ -75,6 +87,13 @@ from .reduce_op import (
     warp_reduce_bitor,  # noqa: F401
 )
 from .print_op import print, device_assert  # noqa: F401
+from .profile import (
+    profile_begin,  # noqa: F401
+    profile_end,  # noqa: F401
+    profile_buffer_shape,  # noqa: F401
+)
+from .device_log import device_log, device_log_buffer_shape  # noqa: F401
+from .scheduler import streamk_store, splitk_store  # noqa: F401
 from .customize import (
     atomic_max,  # noqa: F401
     atomic_min,  # noqa: F401
@@ -102,12 +121,15 @@ from .annotations import (  # noqa: F401
     annotate_safe_value,
     annotate_l2_hit_ratio,
     annotate_restrict_buffers,
+    annotate_pingpong,
 )
 
 from .random import (
     rng_init,  # noqa: F401
     rng_rand,  # noqa: F401
     rng_rand_float,  # noqa: F401
+    philox_rand,  # noqa: F401
+    philox_rand_float,  # noqa: F401
 )
 
 from .pdl import (
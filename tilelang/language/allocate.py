@@ -189,18 +189,36 @@ def alloc_tmem(shape, dtype):
     return T.alloc_buffer(shape, dtype, scope="shared.tmem")
 
 
-def alloc_reducer(shape, dtype, op="sum", replication=None):
+def alloc_reducer(shape, dtype, op="sum", replication=None, index_dtype="int32"):
     """
     Allocate a reducer buffer.
 
     Modifications needs to conform with `op`,
     such as `op="sum"` requires `reducer[...] += ...` and
     `op="max"` requires `reducer[...] = T.max(reducer[...], ...)`.
+    `op="absmax"` requires `reducer[...] = T.max(reducer[...], T.abs(...))`,
+    `op="prod"` requires `reducer[...] *= ...`, and the bitwise ops `"bitand"`, `"bitor"` and `"bitxor"`
+    require `reducer[...] = reducer[...] & ...` and so on.
+
+    `op="argmax"` and `op="argmin"` allocate a value reducer and its paired index reducer,
+    updated together when a value beats the current one::
+
+        val, idx = T.alloc_reducer(block_N, "float32", op="argmax")
+        T.fill(val, -T.infinity("float32"))
+        T.fill(idx, 0)
+        for i, j in T.Parallel(block_M, block_N):
+            if A[i, j] > val[j]:
+                val[j] = A[i, j]
+                idx[j] = i
+        T.finalize_reducer(val, idx)
+
+    Ties across threads resolve to the smallest index.
 
     Only after T.fill with proper initializer the reduction may begin;
     only after T.finalize_reducer the partial results will be available.
 
-    For `op="sum"`, filled value must be 0; for min and max, the filled initializer will become max or min clamper correspondingly.
+    For `op="sum"`, `"absmax"`, `"bitor"` and `"bitxor"`, filled value must be 0, for `"prod"` it must be 1 and for `"bitand"` all ones;
+    for min and max, the filled initializer will become max or min clamper correspondingly.
     You may want to use `T.max_value` for min and `T.min_value` for max.
 
     Args:
@@ -208,21 +226,27 @@ def alloc_reducer(shape, dtype, op="sum", replication=None):
         dtype (str): The data type of the buffer (e.g., 'float32', 'int32')
         op (str): The reduce operation corresponded with the reducer
         replication (str | None): Replication strategy, can be "all" or "none". Defaults to not specified, and the compiler will do whatever it want.
+        index_dtype (str): The data type of the index reducer of `op="argmax"` and `op="argmin"`
 
     Returns:
         T.Buffer: A TVM buffer object allocated in thread-private storage, available to reduce values in T.Parallel loops.
+            For `op="argmax"` and `op="argmin"`, a tuple of the value and index buffers.
     """
 
-    assert op in ["sum", "max", "min"]
+    assert op in ["sum", "max", "min", "prod", "absmax", "bitand", "bitor", "bitxor", "argmax", "argmin"]
     # TODO: support automatic layout
     if replication is None:
         replication = "none"
     assert replication in ["all", "none"]
 
     reducer = T.alloc_buffer(shape, dtype, scope="local.fragment")
-    block_attr({"reducer_info": {reducer.data: {"rep": replication, "op": op}}})
+    if op not in ["argmax", "argmin"]:
+        block_attr({"reducer_info": {reducer.data: {"rep": replication, "op": op}}})
+        return reducer
 
-    return reducer
+    index = T.alloc_buffer(shape, index_dtype, scope="local.fragment")
+    block_attr({"reducer_info": {buf.data: {"rep": replication, "op": op} for buf in (reducer, index)}})
+    return reducer, index
 
 
 DescKind = Literal["wgmma", "tcgen05_smem", "tcgen05_instr"]
@@ -13,12 +13,30 @@ __all__ = [
     "annotate_safe_value",
     "annotate_l2_hit_ratio",
     "annotate_restrict_buffers",
+    "annotate_pingpong",
 ]
 
 
+_SWIZZLE_DEVICE_FUNCS = {
+    "row": "rasterization2DRow",
+    "column": "rasterization2DColumn",
+    "morton": "rasterizationMorton",
+    "hilbert": "rasterizationHilbert",
+}
+
+
 def use_swizzle(panel_size: int, order: str = "row", enable: bool = True):
-    """Annotate a kernel to use a specific threadblock swizzle pattern."""
-    device_func = "rasterization2DRow" if order == "row" else "rasterization2DColumn"
+    """Annotate a kernel to use a specific threadblock swizzle pattern.
+
+    ``order`` is one of ``"row"``, ``"column"``, ``"morton"`` or ``"hilbert"``.
+    The curve orders walk square groups of ``panel_size`` x ``panel_size``
+    blocks and require ``panel_size`` to be a power of two.
+    """
+    if order not in _SWIZZLE_DEVICE_FUNCS:
+        raise ValueError(f"Unsupported swizzle order {order!r}, expected one of {list(_SWIZZLE_DEVICE_FUNCS)}")
+    if order in ("morton", "hilbert") and (panel_size <= 0 or panel_size & (panel_size - 1)):
+        raise ValueError(f"{order} swizzle requires a power-of-two panel_size, got {panel_size}")
+    device_func = _SWIZZLE_DEVICE_FUNCS[order]
     if not enable:
         return None
     return attr(None, "threadblock_swizzle_pattern", f"tl::{device_func}<{panel_size}>")
@@ -62,7 +80,9 @@ def annotate_restrict_buffers(*buffers):
 
     This annotation tells codegen to omit the `__restrict__` qualifier for the
     specified kernel buffer parameters. Use this when two (or more) buffers may
-    alias, for example overlapping slices from the same base tensor.
+    alias, for example overlapping slices from the same base tensor. Calls that
+    pass overlapping tensors for two restrict buffers, one of which the kernel
+    writes, are rejected at runtime.
 
     Example
     -------
@@ -83,3 +103,25 @@ def annotate_restrict_buffers(*buffers):
             raise TypeError(f"annotate_restrict_buffers expects Buffer arguments, got {type(buf)}") from e
     # Also return as block attribute (root block exists by default) for readability/tools.
     return block_attr({"tl.non_restrict_params": data_vars})
+
+
+def annotate_pingpong(enable: bool = True):
+    """Schedule the two consumer warpgroups of a warp specialized kernel in ping-pong.
+
+    Each consumer warpgroup computes its own rows of the tiles; with the
+    ping-pong schedule they take turns at the tensor cores, one running its
+    softmax or epilogue while the other runs its gemms, as in FlashAttention-3.
+    It needs ``threads=256`` for the consumers (plus the producer warpgroup
+    added by warp specialization) and keeps the cooperative schedule otherwise.
+    ``enable`` lets the autotuner choose between both schedules::
+
+        @autotune(configs=[{"pingpong": True}, {"pingpong": False}])
+        @tilelang.jit
+        def attention(..., pingpong=True):
+            ...
+            with T.Kernel(..., threads=256) as (bx, by):
+                T.annotate_pingpong(pingpong)
+    """
+    if not enable:
+        return None
+    return block_attr({"tl.warp_group_pingpong": 1})
@@ -1887,6 +1887,8 @@ ptx_wgmma_ss = _dtype_forward(_tir_op.ptx_wgmma_ss)
 ptx_wgmma_rs = _dtype_forward(_tir_op.ptx_wgmma_rs)
 ptx_tcgen05_mma_ss = _dtype_forward(_tir_op.ptx_tcgen05_mma_ss)
 ptx_tcgen05_mma_ts = _dtype_forward(_tir_op.ptx_tcgen05_mma_ts)
+ptx_tcgen05_mma_blockscaled_ss = _dtype_forward(_tir_op.ptx_tcgen05_mma_blockscaled_ss)
+ptx_tcgen05_cp = _dtype_forward(_tir_op.ptx_tcgen05_cp)
 ptx_ldmatrix = _dtype_forward(_tir_op.ptx_ldmatrix)
 ptx_cp_async = _dtype_forward(_tir_op.ptx_cp_async)
 ptx_cp_async_bulk = _dtype_forward(_tir_op.ptx_cp_async_bulk)
@@ -2139,6 +2141,8 @@ __all__ = [
     "ptx_wgmma_ss",
     "ptx_wgmma_rs",
     "ptx_tcgen05_mma_ss",
+    "ptx_tcgen05_mma_blockscaled_ss",
+    "ptx_tcgen05_cp",
     "ptx_ldmatrix",
     "ptx_cp_async",
     "ptx_cp_async_bulk",
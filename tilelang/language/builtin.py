@@ -153,7 +153,9 @@ def tma_store_wait(*args):
     """Wait for completion of TMA store operations.
 
     Args:
-        *args: Variable arguments specifying which store operations to wait for
+        *args: Optional number of the most recent bulk groups that may still be
+            reading their shared memory source (``cp.async.bulk.wait_group.read``).
+            Defaults to 0, waiting for every store.
 
     Returns:
         tir.Call: A handle to the store wait operation
@@ -737,6 +739,20 @@ def sync_grid():
     return tir.call_intrin("handle", tir.op.Op.get("tl.sync_grid"))
 
 
+def cluster_rank():
+    """Rank of the current thread block in its cluster, see ``T.Kernel(cluster_dims=...)``."""
+    return tir.call_intrin("int32", tir.op.Op.get("tl.cluster_rank"))
+
+
+def cluster_sync():
+    """Synchronize all threads of the thread block cluster.
+
+    Shared memory writes made before the barrier are visible to every thread
+    block of the cluster after it.
+    """
+    return tir.call_intrin("handle", tir.op.Op.get("tl.cluster_sync"))
+
+
 def initialize_wgmma_descriptor(
     descriptor: tir.Buffer,
     start_address: PrimExpr,
@@ -833,15 +849,23 @@ def cp_async_barrier_noinc(barrier_id: int | PrimExpr | tir.Call):
     return tir.call_intrin("handle", tir.op.Op.get("tl.ptx_cp_async_barrier_noinc"), barrier_id)
 
 
-def tcgen05_mma_arrive(mbar_ptr):
+def tcgen05_mma_arrive(mbar_ptr, cta_group: int = 1):
     """Signal UMMA (TCGEN05) barrier arrival for a shared-memory mbarrier pointer.
 
     Parameters
     ----------
     mbar_ptr : PrimExpr
         Pointer to the mbarrier object in shared memory (e.g., Barrier*).
+    cta_group : int
+        2 to commit the 2-CTA MMAs of a cluster CTA pair, which arrives on the
+        mbarrier at the same offset in both CTAs.
     """
-    return tir.call_intrin("void", tir.op.Op.get("tl.tcgen05_mma_arrive"), mbar_ptr)
+    return tir.call_intrin(
+        "void",
+        tir.op.Op.get("tl.tcgen05_mma_arrive"),
+        mbar_ptr,
+        annotations={"cta_group": cta_group} if cta_group != 1 else None,
+    )
 
 
 def ptx_mma_sm70(
@@ -941,3 +965,75 @@ def ptx_mma_sm70(
         accumulator,
         c_index,
     )
+
+
+def ptx_mma_blockscaled(
+    A_dtype,
+    B_dtype,
+    multiplicand_a,
+    a_index,
+    multiplicand_b,
+    b_index,
+    accumulator,
+    c_index,
+    scale_a,
+    scale_b,
+):
+    """TVM intrinsic for the block scaled ptx mma.sync of consumer Blackwell (SM120).
+
+    Issues one m16n8k32 FP8 mma with float32 accumulation, row-major A and
+    column-major B, every 32 elements of K being scaled by one UE8M0 scale
+    factor of A and one of B.
+
+    Parameters
+    ----------
+
+    A_dtype : str
+        The data type of multiplicand fragment A ("e4m3" or "e5m2").
+
+    B_dtype : str
+        The data type of multiplicand fragment B ("e4m3" or "e5m2").
+
+    multiplicand_a : Var
+        The multiplicand fragment A variable.
+
+    a_index : Expr
+        The index of multiplicand fragment A.
+
+    multiplicand_b : Var
+        The multiplicand fragment B variable.
+
+    b_index : Expr
+        The index of multiplicand fragment B.
+
+    accumulator : Var
+        The float32 accumulator fragment C variable.
+
+    c_index : Expr
+        The index of accumulator fragment C.
+
+    scale_a : Expr
+        The uint32 scale factor of the row of A the lane provides.
+
+    scale_b : Expr
+        The uint32 scale factor of the column of B the lane provides.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.ptx_mma_blockscaled"),
+        A_dtype,
+        B_dtype,
+        multiplicand_a,
+        a_index,
+        multiplicand_b,
+        b_index,
+        accumulator,
+        c_index,
+        scale_a,
+        scale_b,
+    )
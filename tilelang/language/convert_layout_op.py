@@ -0,0 +1,46 @@
+"""Fragment layout conversions exposed on the TileLang language surface."""
+
+from __future__ import annotations
+from tvm import tir
+from tilelang.utils.language import to_buffer_region, retrieve_shape, _get_buffer
+from tilelang.utils.language import is_fragment
+
+
+def convert_layout(src: tir.Buffer | tir.BufferRegion, dst: tir.Buffer | tir.BufferRegion):
+    """Copy a fragment into a fragment of the same shape laid out differently.
+
+    Each fragment keeps the layout its other users give it, e.g. the
+    accumulator layout of a ``T.gemm`` for ``src`` and the operand layout of
+    the next ``T.gemm`` for ``dst``, where a plain ``T.copy`` would make the
+    two layouts conflict. The copy is lowered after where the elements of
+    ``dst`` live in ``src``: in the registers of the same thread, in a lane of
+    the same warp, read with one shuffle per element, and otherwise through
+    shared memory.
+
+    Args:
+        src: Fragment read, as a whole.
+        dst: Fragment written, as a whole, of the shape of ``src``.
+
+    Returns:
+        tir.Call: Handle to the layout conversion intrinsic call.
+
+    Example:
+        >>> T.gemm(Q_shared, K_shared, S_local, transpose_B=True)
+        >>> T.convert_layout(S_local, P_local)
+        >>> T.gemm(P_local, V_shared, O_local)
+    """
+    for buffer in (src, dst):
+        if not is_fragment(buffer):
+            raise ValueError(f"T.convert_layout expects fragments, got {_get_buffer(buffer).scope()}")
+    src_shape, dst_shape = retrieve_shape(src), retrieve_shape(dst)
+    static = (int, tir.IntImm)
+    if len(src_shape) != len(dst_shape) or any(
+        isinstance(a, static) and isinstance(b, static) and int(a) != int(b) for a, b in zip(src_shape, dst_shape)
+    ):
+        raise ValueError(f"T.convert_layout expects fragments of the same shape, got {src_shape} and {dst_shape}")
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.convert_layout"),
+        to_buffer_region(src, access_type="r"),
+        to_buffer_region(dst, access_type="w"),
+    )
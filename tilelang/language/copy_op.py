@@ -10,6 +10,26 @@ from tilelang.utils.language import (
 )
 from tvm import ir, tir
 
+CacheHint = Literal["evict_normal", "evict_first", "evict_last", "no_allocate"]
+
+_EVICTION_POLICY_MAP = {"evict_normal": 0, "evict_first": 1, "evict_last": 2, "no_allocate": 3}
+
+
+def _to_region(data, access_type: str, name: str):
+    """Encode a buffer, region or load as a ``tl.region`` of its own extents."""
+    if isinstance(data, tir.Var) and T.has_let_value(data):
+        data = T.get_let_value(data)
+    if isinstance(data, tir.Buffer):
+        extents = list(data.shape)
+    elif isinstance(data, tir.BufferRegion):
+        extents = [r.extent for r in data.region]
+    elif isinstance(data, tir.BufferLoad):
+        region = get_buffer_region_from_load(data)
+        extents = [r.extent for r in region.region] if region is not None else [1] * len(data.indices)
+    else:
+        raise TypeError(f"{name} expects a buffer region, got {type(data)}")
+    return to_buffer_region(data, access_type=access_type, extents=extents)
+
 
 def copy(
     src: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
@@ -17,9 +37,15 @@ def copy(
     *,
     coalesced_width: int | None = None,
     disable_tma: bool = False,
-    eviction_policy: Literal["evict_normal", "evict_first", "evict_last"] | None = None,
+    eviction_policy: CacheHint | None = None,
+    cache_hint: CacheHint | None = None,
     annotations: dict | None = None,
     loop_layout: Any | None = None,
+    tma_global_address: tir.PrimExpr | None = None,
+    tma_desc_workspace: tir.Buffer | tir.BufferLoad | tir.PrimExpr | None = None,
+    tma_global_shape: list[tir.PrimExpr] | tuple[tir.PrimExpr, ...] | None = None,
+    multicast: int | tir.PrimExpr | None = None,
+    store_stages: int | None = None,
 ):
     """Copy data between memory regions.
 
@@ -29,12 +55,49 @@ def copy(
         coalesced_width (Optional[int], keyword-only): Width for coalesced memory access. Defaults to None.
         disable_tma (bool, keyword-only): Whether to disable TMA acceleration. Defaults to False.
         eviction_policy (Optional[str], keyword-only): Cache eviction policy. Defaults to None.
+        cache_hint (Optional[str], keyword-only): Cache policy of the global side of the copy, one of
+            ``"evict_normal"``, ``"evict_first"``, ``"evict_last"`` or ``"no_allocate"`` (evict_first
+            in L2 and no L1 allocation). Applies to TMA copies (``no_allocate`` is ``evict_first``
+            there) and to SIMT global loads and stores, which carry an L2 ``cache_hint`` policy on
+            sm80+ and are non-temporal on HIP. When neither this nor ``eviction_policy`` is given, a
+            global source tile addressed by every ``blockIdx`` of the kernel, hence read by a single
+            block, is loaded with ``no_allocate`` unless ``tl.disable_cache_hint_inference`` is set.
+            Alias of ``eviction_policy``. Defaults to None.
         annotations (Optional[dict], keyword-only): Additional annotations dict. If provided,
             coalesced_width, disable_tma, and eviction_policy can also be specified here.
             Values in annotations take precedence over individual arguments.
         loop_layout (Optional[Fragment], keyword-only): A parallel loop layout hint for the SIMT copy
             (only valid for normal SIMT copy; incompatible with TMA/LDSM/STSM/TMem). When provided,
             it is attached to the outermost parallel loop generated by this copy.
+        tma_global_address (Optional[PrimExpr], keyword-only): Device-side base address that replaces
+            the global address of the TMA descriptor at runtime. The global buffer of the copy only
+            serves as a template for shape, strides and box; the descriptor is encoded once on the host
+            and patched on the device with ``tensormap.replace`` before each issued copy. Either a pointer
+            (``T.address_of(...)``) or an integer address, e.g. read from a device-side problem table.
+            Requires a multi-dimensional TMA load/store (sm90+).
+        tma_desc_workspace (Optional[Buffer | BufferLoad | PrimExpr], keyword-only): 128-byte aligned
+            global memory slot that owns the patched descriptor, typically one slot per CTA and
+            per descriptor, e.g. ``workspace[bx, 0]`` of a ``(num_ctas, 128)`` uint8 buffer.
+        tma_global_shape (Optional[list[PrimExpr]], keyword-only): Shape of the tensor at
+            ``tma_global_address``, one extent per dimension of the global buffer, when it differs from
+            the template. The tensor is taken as contiguous and its extents and strides are patched
+            along with the address, so TMA clips the tile against the actual bounds. Used by grouped
+            GEMMs whose problem sizes are only known on the device.
+        multicast (Optional[int | PrimExpr], keyword-only): Bitmask of the thread blocks of the cluster
+            (by ``T.cluster_rank()``, including the current one) that copy the same global tile into
+            the same shared buffer. The TMA load is then issued once, by the lowest rank of the mask,
+            and written to every block of it, which divides the L2 traffic of the tile by the number
+            of blocks. Requires a TMA load into shared memory and ``T.Kernel(cluster_dims=...)``.
+            The previous content of the buffer must be consumed by every block of the mask before it
+            is reloaded, e.g. with ``T.cluster_sync()``.
+        store_stages (Optional[int], keyword-only): Store a 2-D fragment tile to global memory
+            through this many shared staging buffers, each holding ``rows // store_stages`` rows,
+            with asynchronous TMA stores (sm90+). The store of a slice overlaps with the staging
+            of the next one and with the work after the copy; a buffer is only rewritten once the
+            store that read it last, possibly from the previous execution of the copy, has finished
+            reading (``cp.async.bulk.wait_group.read store_stages - 1``). The kernel waits for the
+            last stores before it exits. Falls back to the default lowering with a warning when the
+            tile does not qualify.
 
     Raises:
         TypeError: If copy extents cannot be deduced from arguments
@@ -105,17 +168,299 @@ def copy(
         ann["coalesced_width"] = coalesced_width
     if "disable_tma" not in ann and disable_tma:
         ann["disable_tma"] = disable_tma
+    if cache_hint is not None:
+        if eviction_policy is not None and eviction_policy != cache_hint:
+            raise ValueError("cache_hint and eviction_policy disagree")
+        eviction_policy = cache_hint
     if "eviction_policy" not in ann and eviction_policy is not None:
-        eviction_policy_map = {"evict_normal": 0, "evict_first": 1, "evict_last": 2}
-        ann["eviction_policy"] = eviction_policy_map[eviction_policy]
+        ann["eviction_policy"] = _EVICTION_POLICY_MAP[eviction_policy]
 
     # Parallel loop layout hint (Fragment). Mirrors T.Parallel(loop_layout=...)
     if loop_layout is not None and "parallel_loop_layout" not in ann:
         ann["parallel_loop_layout"] = loop_layout
 
+    if store_stages is not None and "tma_store_stages" not in ann:
+        if store_stages < 1:
+            raise ValueError(f"store_stages must be positive, got {store_stages}")
+        ann["tma_store_stages"] = store_stages
+
+    if multicast is not None and "multicast_mask" not in ann:
+        ann["multicast_mask"] = multicast
+
+    # Device-side descriptor patching for pointer-only changes
+    if tma_global_address is not None and "tma_global_address" not in ann:
+        if tma_desc_workspace is None:
+            raise ValueError("tma_global_address requires a tma_desc_workspace slot")
+        if isinstance(tma_desc_workspace, tir.Buffer):
+            tma_desc_workspace = tma_desc_workspace[tuple(0 for _ in tma_desc_workspace.shape)]
+        if isinstance(tma_desc_workspace, tir.BufferLoad):
+            tma_desc_workspace = T.address_of(tma_desc_workspace)
+        if isinstance(tma_global_address, tir.BufferLoad):
+            tma_global_address = T.address_of(tma_global_address)
+        ann["tma_global_address"] = tma_global_address
+        ann["tma_desc_workspace"] = tma_desc_workspace
+        if tma_global_shape is not None:
+            ann["tma_global_shape"] = list(tma_global_shape)
+    elif tma_global_shape is not None:
+        raise ValueError("tma_global_shape requires a tma_global_address")
+
     return tir.call_intrin("handle", tir.op.Op.get("tl.tileop.copy"), src, dst, annotations=ann if ann else None)
 
 
+def prefetch(src: tir.Buffer | tir.BufferLoad | tir.BufferRegion):
+    """Prefetch a global memory region into L2 without waiting for it.
+
+    The rows of the region are spread over the threads of the block. Rows that
+    are 16-byte aligned multiples of 16 bytes use ``cp.async.bulk.prefetch``
+    on sm90+, other regions ``prefetch.global.L2`` per 128-byte line. Nothing
+    is written and no barrier tracks completion, so a later ``T.copy`` of the
+    region simply hits in L2. Lowers to nothing on non-CUDA targets.
+
+    Args:
+        src (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Global memory region to prefetch.
+
+    Returns:
+        tir.Call: A handle to the prefetch operation
+    """
+    return tir.call_intrin("handle", tir.op.Op.get("tl.tileop.prefetch"), _to_region(src, "r", "T.prefetch"))
+
+
+def gather_copy(
+    src: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    page_table: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    dst: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    *,
+    page_size: int | tir.PrimExpr = 1,
+    offset: int | tir.PrimExpr = 0,
+):
+    """Copy rows of ``src`` gathered through a page table into ``dst``.
+
+    Row ``i`` of the first non-unit dimension of ``dst`` is the logical row
+    ``t = offset + i``, read from physical row
+    ``page_table[t // page_size] * page_size + t % page_size`` of ``src``
+    (relative to the start of the first dimension of the ``src`` region). The
+    table is indexed along its last dimension from the start of its region,
+    the remaining non-unit dimensions are copied as ``T.copy`` does. With the
+    default ``page_size=1`` the table holds one row index per row.
+
+    On sm100 a 2D source gathered into a 2D shared tile of a multiple of four
+    rows lowers to TMA ``tile::gather4`` loads, completed through the mbarrier
+    like other TMA loads. Other cases lower to a vectorized SIMT loop, which
+    becomes 16-byte ``cp.async`` on sm80+ and buffer loads on HIP. The table
+    entries must point at valid rows, no bounds check is generated.
+
+    Args:
+        src (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Global memory region, gathered along dim 0,
+            e.g. the paged ``KV[:, head, :]``.
+        page_table (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Integer table of page indices,
+            e.g. ``block_table[bx, :]``.
+        dst (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Destination memory region.
+        page_size (Union[int, tir.PrimExpr], keyword-only): Rows per page. Defaults to 1.
+        offset (Union[int, tir.PrimExpr], keyword-only): Logical row of the first row of ``dst``. Defaults to 0.
+
+    Returns:
+        tir.Call: A handle to the gather copy operation
+    """
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.gather_copy"),
+        _to_region(src, "r", "T.gather_copy"),
+        _to_region(page_table, "r", "T.gather_copy"),
+        _to_region(dst, "w", "T.gather_copy"),
+        page_size,
+        offset,
+    )
+
+
+
+def gather(
+    src: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    index: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    dst: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+):
+    """Copy the rows ``src[index[i]]`` to the rows ``dst[i]``.
+
+    Row ``i`` of the first non-unit dimension of ``dst`` is read from row
+    ``index[i]`` of ``src`` (relative to the start of the first dimension of
+    the ``src`` region), the index table being read along its last dimension.
+    This is ``T.gather_copy`` with one row per table entry: rows of a 2D
+    source into a 2D shared tile use TMA loads on sm90+, other cases a
+    vectorized SIMT loop.
+
+    Args:
+        src (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Global memory region, gathered along dim 0.
+        index (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Integer row indices, e.g. ``sorted_ids[m_start:]``.
+        dst (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Destination memory region.
+
+    Returns:
+        tir.Call: A handle to the gather operation
+    """
+    return gather_copy(src, index, dst)
+
+
+def scatter(
+    src: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    index: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    dst: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    *,
+    reduce: Literal["add"] | None = None,
+):
+    """Copy the rows ``src[i]`` to the rows ``dst[index[i]]``.
+
+    Row ``i`` of the first non-unit dimension of ``src`` is written to row
+    ``index[i]`` of the global ``dst`` (relative to the start of the first
+    dimension of the ``dst`` region), the index table being read along its last
+    dimension. Rows of a linear 2D shared tile are written with bulk TMA stores
+    on sm90+, other cases with a vectorized SIMT loop.
+
+    With ``reduce="add"`` the rows are accumulated with atomic adds instead,
+    which combines the outputs of the experts a token was routed to, e.g.
+    ``T.scatter(out_frag, token_ids[m_start:], output, reduce="add")``.
+    Without it, rows sent to the same destination race.
+
+    Args:
+        src (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Source memory region.
+        index (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Integer destination row indices.
+        dst (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Global memory region, scattered along dim 0.
+        reduce (Optional[str], keyword-only): ``"add"`` to accumulate atomically. Defaults to None.
+
+    Returns:
+        tir.Call: A handle to the scatter operation
+    """
+    if reduce not in (None, "add"):
+        raise ValueError(f"T.scatter supports reduce=None or 'add', got {reduce!r}")
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.scatter_copy"),
+        _to_region(src, "r", "T.scatter"),
+        _to_region(index, "r", "T.scatter"),
+        _to_region(dst, "rw" if reduce else "w", "T.scatter"),
+        int(reduce == "add"),
+    )
+
+
+_CONV_MODES = {"fprop": 0, "wgrad": 0, "dgrad": 1}
+
+
+def _spatial(value, dims: int, name: str) -> list:
+    """Broadcast an int or a per spatial dimension sequence to ``dims`` entries."""
+    if isinstance(value, (list, tuple)):
+        if len(value) != dims:
+            raise ValueError(f"T.conv_im2col expects {dims} values for {name}, got {value}")
+        return list(value)
+    return [value] * dims
+
+
+def conv_im2col(
+    img: tir.Buffer,
+    col: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    pixel_step: tir.PrimExpr,
+    k_step: tir.PrimExpr,
+    kernel: int | tuple[int, ...],
+    stride: int | tuple[int, ...] = 1,
+    dilation: int | tuple[int, ...] = 1,
+    pad: int | tuple[int, ...] = 0,
+    *,
+    groups: int = 1,
+    group: tir.PrimExpr = 0,
+    mode: Literal["fprop", "wgrad", "dgrad"] = "fprop",
+    input_shape: tuple[tir.PrimExpr, ...] | None = None,
+    phase: tir.PrimExpr | tuple[tir.PrimExpr, ...] | None = None,
+    eviction_policy: Literal["evict_normal", "evict_first", "evict_last"] | None = None,
+):
+    """Load a tile of the im2col matrix of an implicit-GEMM convolution.
+
+    ``img`` is a channels-last ``[N, *spatial, C]`` global tensor with one to
+    three spatial dimensions, ``col`` a ``[P, K]`` tile. Row ``pixel_step * P + i``
+    of the matrix enumerates the GEMM pixels, batch outermost; column
+    ``k_step * K + j`` enumerates ``(tap, c)`` with the channel ``c`` of the group
+    innermost and the last kernel dimension innermost in ``tap``. With ``groups``,
+    the tile holds the ``C // groups`` channels of ``group``, so the weights of a
+    group are ``[kvol * C // groups, F // groups]`` and a depthwise convolution
+    is ``groups=C``. Out-of-bounds entries read as zero.
+
+    - ``"fprop"``: the pixels are the outputs. ``"wgrad"`` loads the same tile,
+      consumed with the pixels as the reduction: ``dW = T.gemm(dY_tile, col,
+      transpose_A=True)``.
+    - ``"dgrad"``: ``img`` is the output gradient and the pixels the inputs of
+      ``input_shape``, convolved with the flipped, transposed weights. With a
+      ``phase`` per spatial dimension and no dilation, only the inputs
+      ``phase + stride * x`` are enumerated and only the taps
+      ``kp = r + stride * t`` with ``r = (phase + pad) % stride`` are, which
+      drops the taps hitting the zeros between the strided outputs. The tile
+      then has ``ceildiv(kernel - r, stride)`` taps per dimension; see
+      :func:`conv_dgrad_phase_taps`.
+
+    Forward tiles lower to a TMA im2col load on sm90+ when the channels of the
+    tile stay within a group, other cases to a SIMT gather that becomes
+    predicated ``cp.async`` loads in a pipelined loop.
+
+    Args:
+        img (tir.Buffer): Channels-last global activation
+        col (Union[tir.Buffer, tir.BufferLoad, tir.BufferRegion]): Destination tile
+        pixel_step (tir.PrimExpr): Row tile index of the im2col matrix
+        k_step (tir.PrimExpr): Column tile index of the im2col matrix
+        kernel (Union[int, tuple[int, ...]]): Kernel size, per spatial dimension or for all
+        stride (Union[int, tuple[int, ...]]): Stride of the convolution. Defaults to 1.
+        dilation (Union[int, tuple[int, ...]]): Dilation rate. Defaults to 1.
+        pad (Union[int, tuple[int, ...]]): Padding size. Defaults to 0.
+        groups (int, keyword-only): Channel groups. Defaults to 1.
+        group (tir.PrimExpr, keyword-only): Group the tile loads. Defaults to 0.
+        mode (str, keyword-only): ``"fprop"``, ``"wgrad"`` or ``"dgrad"``. Defaults to ``"fprop"``.
+        input_shape (Optional[tuple], keyword-only): Spatial input shape, required for dgrad.
+        phase (Optional[Union[tir.PrimExpr, tuple]], keyword-only): Stride phase of a dgrad tile.
+        eviction_policy (Optional[str], keyword-only): Cache eviction policy of the TMA load.
+
+    Returns:
+        tir.Call: A handle to the im2col operation
+    """
+    if mode not in _CONV_MODES:
+        raise ValueError(f"T.conv_im2col supports mode 'fprop', 'wgrad' or 'dgrad', got {mode!r}")
+    dims = len(img.shape) - 2
+    if dims not in (1, 2, 3):
+        raise ValueError(f"T.conv_im2col expects a [N, *spatial, C] source with 1 to 3 spatial dims, got {img.shape}")
+    mode_id = _CONV_MODES[mode]
+    if mode == "dgrad":
+        if input_shape is None:
+            raise ValueError("T.conv_im2col with mode='dgrad' needs the spatial input_shape")
+        if phase is not None:
+            mode_id = 2
+    elif input_shape is not None or phase is not None:
+        raise ValueError("T.conv_im2col only takes input_shape and phase with mode='dgrad'")
+    spatial = [
+        _spatial(kernel, dims, "kernel"),
+        _spatial(stride, dims, "stride"),
+        _spatial(dilation, dims, "dilation"),
+        _spatial(pad, dims, "pad"),
+        _spatial(input_shape if input_shape is not None else 0, dims, "input_shape"),
+        _spatial(phase if phase is not None else 0, dims, "phase"),
+    ]
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.conv_im2col"),
+        to_buffer_region(img, access_type="r"),
+        _to_region(col, "w", "T.conv_im2col"),
+        pixel_step,
+        k_step,
+        groups,
+        group,
+        mode_id,
+        _EVICTION_POLICY_MAP[eviction_policy or "evict_normal"],
+        *[v for values in spatial for v in values],
+    )
+
+
+def conv_dgrad_phase_taps(kernel: int, stride: int, pad: int, phase):
+    """First kernel tap and tap count of a dgrad phase along one spatial dimension.
+
+    The taps ``first + stride * t`` for ``t < count`` are the ones
+    ``T.conv_im2col(..., mode="dgrad", phase=phase)`` enumerates, i.e. the
+    weights the tile of the phase multiplies.
+    """
+    first = (phase + pad) % stride
+    return first, (kernel - first + stride - 1) // stride
+
+
 def c2d_im2col(
     img: tir.Buffer,
     col: tir.Buffer,
@@ -129,6 +474,8 @@ def c2d_im2col(
 ):
     """Perform im2col transformation for 2D convolution.
 
+    Shorthand for :func:`conv_im2col` with a square kernel.
+
     Args:
         img (tir.Buffer): Input image buffer
         col (tir.Buffer): Output column buffer
@@ -142,22 +489,4 @@ def c2d_im2col(
     Returns:
         tir.Call: A handle to the im2col operation
     """
-    if eviction_policy is None:
-        eviction_policy = 0
-    else:
-        eviction_policy = {"evict_normal": 0, "evict_first": 1, "evict_last": 2}[eviction_policy]
-    img_region = to_buffer_region(img, access_type="r")
-    col_region = to_buffer_region(col, access_type="w")
-    return tir.call_intrin(
-        "handle",
-        tir.op.Op.get("tl.tileop.c2d_im2col"),
-        img_region,
-        col_region,
-        nhw_step,
-        c_step,
-        kernel,
-        stride,
-        dilation,
-        pad,
-        eviction_policy,
-    )
+    return conv_im2col(img, col, nhw_step, c_step, kernel, stride, dilation, pad, eviction_policy=eviction_policy)
@@ -0,0 +1,92 @@
+"""Dequantization operations exposed on the TileLang language surface."""
+
+from __future__ import annotations
+from tvm import tir
+from tilelang.utils.language import to_buffer_region, retrieve_shape, _get_buffer
+from tilelang.utils.language import is_fragment
+
+# Matches DequantFormatEnum in src/op/dequantize.h
+_DEQUANT_FORMATS = {"int4": 0, "uint4": 1, "nf4": 2, "fp4_e2m1": 3, "mxfp4": 4}
+
+
+def dequantize(
+    packed: tir.Buffer | tir.BufferRegion | tir.BufferLoad,
+    scales: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None,
+    zeros: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None,
+    out: tir.Buffer | tir.BufferRegion,
+    format: str = "int4",
+    group_size: int | None = None,
+):
+    """Decode packed 4-bit codes into a fragment, with group-wise scales.
+
+    Element ``(i, j)`` of ``out`` is decoded from the ``j % 2`` nibble (low
+    nibble first) of ``packed[i, j // 2]`` and, with ``g = j // group_size``::
+
+        out[i, j] = cast((decode(code) - zeros[i, g]) * scales[i, g])
+
+    The codes are two's complement (``int4``) or unsigned (``uint4``)
+    integers, indices into the NF4 code book (``nf4``) or e2m1 floats
+    (``fp4_e2m1``); ``mxfp4`` is e2m1 scaled by ``2 ** (scales[i, g] - 127)``,
+    the scales holding uint8 e8m0 exponents.
+
+    When ``packed`` is a fragment it is laid out after ``out``, e.g. the MMA
+    operand layout ``T.gemm`` gives a B fragment, so that every thread holds
+    the bytes of its own elements, and the copy filling it reads them straight
+    from global memory. float16 and bfloat16 outputs are then decoded in
+    registers, eight elements at a time, by LOP3/PRMT sequences; the other
+    cases are decoded element by element in a vectorized loop.
+
+    Args:
+        packed: (N, K // 2) int8 or uint8 fragment, or shared or global region.
+        scales: Optional (N, K // group_size) shared or global region.
+        zeros: Optional (N, K // group_size) shared or global region of zero
+            points, for integer formats.
+        out: (N, K) floating point fragment.
+        format (str): "int4", "uint4", "nf4", "fp4_e2m1" or "mxfp4".
+        group_size (int): Consecutive elements of a row sharing a scale, 32 for
+            mxfp4 and 128 otherwise by default.
+
+    Returns:
+        tir.Call: Handle to the dequantization intrinsic call.
+
+    Example:
+        >>> T.copy(B_packed[bx * block_N, k * block_K // 2], B_local)
+        >>> T.dequantize(B_local, S[bx * block_N, k * block_K // 128], None, B_dequant)
+        >>> T.gemm(A_shared, B_dequant, C_local, transpose_B=True)
+    """
+    if format not in _DEQUANT_FORMATS:
+        raise ValueError(f"T.dequantize expects format in {list(_DEQUANT_FORMATS)}, got {format}")
+    if not is_fragment(out):
+        raise ValueError(f"T.dequantize expects a fragment output, got {_get_buffer(out).scope()}")
+    out_shape = retrieve_shape(out)
+    if len(out_shape) != 2:
+        raise ValueError(f"T.dequantize expects an (N, K) fragment, got shape {out_shape}")
+    if format == "mxfp4" and scales is None:
+        raise ValueError("T.dequantize expects e8m0 scales for mxfp4")
+    if zeros is not None and format not in ("int4", "uint4"):
+        raise ValueError(f"T.dequantize only subtracts zero points from integers, got format {format}")
+    if group_size is None:
+        group_size = 32 if format == "mxfp4" else 128
+        if scales is None:
+            group_size = out_shape[1]
+    packed_shape = [out_shape[0], out_shape[1] // 2]
+    group_shape = [out_shape[0], out_shape[1] // group_size]
+
+    def extent_region(buf, shape, access_type):
+        # Loads such as S[bx * block_N, 0] denote a region of the given shape.
+        extents = list(shape) if isinstance(buf, tir.BufferLoad) else None
+        return to_buffer_region(buf, access_type=access_type, extents=extents)
+
+    optional = [extent_region(buf, group_shape, "r") for buf in (scales, zeros) if buf is not None]
+
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.dequantize"),
+        extent_region(packed, packed_shape, "r"),
+        to_buffer_region(out, access_type="w"),
+        _DEQUANT_FORMATS[format],
+        group_size,
+        scales is not None,
+        zeros is not None,
+        *optional,
+    )
@@ -0,0 +1,87 @@
+"""Device side logging into a ring buffer, decoded on the host.
+
+``T.device_log(msg, buffer, *values)`` appends a record of the calling thread,
+``(msg, blockIdx, threadIdx, values)``, to ``buffer``, a 1-D int64 (or uint64)
+kernel argument of ``device_log_buffer_shape(capacity)`` elements that the host
+zeroes before the launch. Unlike ``T.print`` nothing is formatted on the
+device: the lanes of a warp reserve their slots with one atomic and store a
+few words each, so logging barely perturbs the timing of the kernel. The
+records are decoded by ``tilelang.profiler.decode_device_log``. Logs are only
+lowered when ``tl.enable_device_log`` is set and compile to nothing otherwise.
+"""
+
+from __future__ import annotations
+
+from tvm import tir
+
+__all__ = [
+    "device_log",
+    "device_log_buffer_shape",
+    "device_log_format",
+]
+
+# Layout of the ring buffer, in 64-bit words: a header whose first word counts
+# the records ever written, followed by records of
+# {id | tx << 32 | ty << 42 | tz << 52 | nvalues << 58,
+#  bx | by << 32 | bz << 48, values[4]}.
+LOG_HEADER_WORDS = 4
+LOG_RECORD_WORDS = 6
+LOG_MAX_VALUES = 4
+
+# Formats are interned process wide, so the ids of a kernel stay valid for the
+# host side decoding of its buffer. A format is the message and the kind of
+# every value: "i" (int64), "u" (uint64) or "f" (float64).
+_LOG_FORMATS: list[tuple[str, tuple[str, ...]]] = []
+
+
+def _log_id(msg: str, kinds: tuple[str, ...]) -> int:
+    fmt = (msg, kinds)
+    if fmt not in _LOG_FORMATS:
+        _LOG_FORMATS.append(fmt)
+    return _LOG_FORMATS.index(fmt)
+
+
+def device_log_format(log_id: int) -> tuple[str, tuple[str, ...]]:
+    """Returns the message and value kinds recorded as ``log_id``."""
+    if 0 <= log_id < len(_LOG_FORMATS):
+        return _LOG_FORMATS[log_id]
+    return f"log_{log_id}", ()
+
+
+def device_log_buffer_shape(capacity: int) -> tuple[int]:
+    """Shape of a device log ring buffer holding ``capacity`` records."""
+    return (LOG_HEADER_WORDS + LOG_RECORD_WORDS * capacity,)
+
+
+def _log_value(value) -> tuple[str, tir.PrimExpr]:
+    value = tir.convert(value)
+    dtype = value.dtype
+    if dtype.startswith("float") or dtype.startswith("bfloat"):
+        return "f", tir.Cast("float64", value)
+    if dtype.startswith("uint"):
+        return "u", tir.Cast("uint64", value)
+    return "i", tir.Cast("int64", value)
+
+
+def device_log(msg: str, buffer: tir.Buffer, *values):
+    """Logs up to 4 scalar ``values`` of the calling thread under ``msg``.
+
+    Every thread reaching the call writes one record, conditions guard it like
+    any statement. Integers are recorded as int64/uint64 and floating point
+    values as float64.
+    """
+    assert isinstance(buffer, tir.Buffer), f"device log buffer must be a buffer, got {type(buffer)}"
+    assert len(buffer.shape) == 1 and buffer.dtype in ("int64", "uint64"), (
+        f"device log buffer must be a 1-D int64/uint64 buffer, got {buffer.dtype}{list(buffer.shape)}"
+    )
+    assert len(values) <= LOG_MAX_VALUES, f"T.device_log takes at most {LOG_MAX_VALUES} values, got {len(values)}"
+    kinds, args = zip(*(_log_value(v) for v in values)) if values else ((), ())
+    capacity = (buffer.shape[0] - LOG_HEADER_WORDS) // LOG_RECORD_WORDS
+    return tir.call_intrin(
+        "void",
+        tir.op.Op.get("tl.device_log"),
+        buffer.access_ptr("rw"),
+        capacity,
+        _log_id(msg, tuple(kinds)),
+        *args,
+    )
@@ -621,6 +621,12 @@ class IRGenerator(Generic[_P, _T]):
     gen: Callable[[BaseBuilder], Callable[_P, _T]]
     source: str
     extra_type_hints: dict[str, Any] = field(default_factory=dict)
+    # builds `gen` over other closure values, the rewrite only depends on their attributes
+    make_closure: Callable[..., Callable[[BaseBuilder], Callable[_P, _T]]] | None = None
+
+    def rebind(self, nonlocals: dict[str, Any]) -> IRGenerator[_P, _T]:
+        """The generator of the same rewritten function over other closure values."""
+        return IRGenerator(self.make_closure(**nonlocals), self.source, self.extra_type_hints, self.make_closure)
 
 
 def has_internal_prim_func(func: Callable[_P, _T]) -> bool:
@@ -691,4 +697,4 @@ def mutate(func: Callable[_P, _T]) -> IRGenerator[_P, _T]:
         func.__globals__,  # use the original globalns
     )
     fn = make_closure(**nonlocals)
-    return IRGenerator(gen=fn, source=ast.unparse(tree), extra_type_hints=mut.extra_type_hints)
+    return IRGenerator(gen=fn, source=ast.unparse(tree), extra_type_hints=mut.extra_type_hints, make_closure=make_closure)
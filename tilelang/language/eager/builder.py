@@ -1,6 +1,7 @@
 from __future__ import annotations
+from collections import OrderedDict
 from contextlib import contextmanager, AbstractContextManager
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 import inspect
 import sys
 
@@ -13,6 +14,7 @@ from tvm.tir.stmt_functor import substitute
 from .ast import BaseBuilder, IRGenerator, eval_op, has_internal_prim_func, mutate
 from .utils import construct_strides
 from tilelang.utils import side_effect
+from tilelang import env
 import tvm
 from tvm.tir import Buffer
 from tvm.script.ir_builder import tir, IRBuilder
@@ -178,6 +180,8 @@ class Builder(BaseBuilder):
         self.macro_arg_annot = {}
         self.out_idx = []
         self.out_tensor_cnt = 0
+        # name -> zero_init of the `T.Workspace` parameters
+        self.workspaces: dict[str, bool] = {}
         self.constexpr_var = set()
         self.eager_jit: EagerJITStage = "none"
         self.eager_jit_subs: dict[str, PrimExpr] = {}
@@ -235,7 +239,10 @@ class Builder(BaseBuilder):
         self.name_inside_frame, self.macro_arg_annot = save
 
     def get(self) -> PrimFunc:
-        return self.ir_builder.get()
+        func = self.ir_builder.get()
+        if self.workspaces:
+            func = func.with_attr("tl.workspace_params", self.workspaces)
+        return func
 
     def find_frame_idx(self, frame: type | tuple[type, ...], start=0) -> int | None:
         for idx in reversed(range(start, len(self.frames))):
@@ -668,6 +675,8 @@ class Builder(BaseBuilder):
 
     def prim_func_arg(self, name, value):
         if isinstance(value, (Buffer, Var)):
+            if hasattr(value, "_workspace_zero_init"):
+                self.workspaces[name] = value._workspace_zero_init
             return tir.arg(name, value)
         elif value is self.empty:
             raise ValueError(f"Argument `{name}` is not annotated")
@@ -799,8 +808,8 @@ from typing import _eval_type
 import re
 
 
-def get_type_hints(func):
-    annot = getattr(func, "__annotations__", None)
+def get_type_hints(func, annot: dict[str, Any] | None = None, localns: dict[str, Any] | None = None):
+    annot = getattr(func, "__annotations__", None) if annot is None else annot
     if annot is None:
         raise TypeError(f"Failed to get function type hints, {func} is not a function")
     hints = {}
@@ -827,7 +836,8 @@ def get_type_hints(func):
     #   n = 128
     #   def bar(A: T.Tensor((n,), T.float32)):
     #     ... # empty function, do not use `n`
-    localns = utils.get_func_nonlocals(func)
+    if localns is None:
+        localns = utils.get_func_nonlocals(func)
     for name, value in annot.items():
         if name == "return":
             continue
@@ -1154,10 +1164,635 @@ def substitute_primfunc(prim_func, vmap):
     )
 
 
+@dataclass
+class _Trace:
+    refs: list[Any]
+    ir_gen: IRGenerator
+    prim_func: PrimFunc | None = None
+
+
+@dataclass
+class _Template:
+    """A trace over symbols standing for the shape constants of its closure."""
+
+    refs: list[Any]
+    symbols: dict[str, Var] = field(default_factory=dict)
+    prim_func: PrimFunc | None = None
+    out_idx: Any = None
+    # set once a specialization equals the trace of the same values
+    validated: bool = False
+    failed: bool = False
+
+    def specialize(self, values: dict[str, int]) -> PrimFunc:
+        return _fold_constants(self.prim_func.specialize({self.symbols[k]: IntImm(self.symbols[k].dtype, v) for k, v in values.items()}))
+
+
+class _TraceCache:
+    def __init__(self, capacity: int):
+        self.capacity = capacity
+        self._entries: OrderedDict[Hashable, Any] = OrderedDict()
+        self._lock = threading.Lock()
+
+    def get(self, key: Hashable) -> Any:
+        with self._lock:
+            entry = self._entries.get(key, None)
+            if entry is not None:
+                self._entries.move_to_end(key)
+            return entry
+
+    def put(self, key: Hashable, entry: Any):
+        with self._lock:
+            self._entries[key] = entry
+            while len(self._entries) > self.capacity:
+                self._entries.popitem(last=False)
+
+    def clear(self):
+        with self._lock:
+            self._entries.clear()
+
+
+# Traces of the functions decorated by prim_func, e.g. by the kernel factories
+# called for every configuration while autotuning, by `utils.get_trace_key`
+_TRACE_CACHE_SIZE = 256
+_trace_cache = _TraceCache(_TRACE_CACHE_SIZE)
+# Rewritten functions, keyed without the scalars of their closure
+_ir_gen_cache = _TraceCache(_TRACE_CACHE_SIZE)
+# Symbolic traces, keyed without the shape constants of their closure
+_template_cache = _TraceCache(_TRACE_CACHE_SIZE)
+
+
+def clear_trace_cache():
+    """Drop the cached traces, e.g. after mutating a value a kernel reads."""
+    for cache in (_trace_cache, _ir_gen_cache, _template_cache):
+        cache.clear()
+
+
+def _get_ir_gen(func: Callable) -> IRGenerator:
+    # The rewrite of a factory called with other sizes is the same
+    nonlocals = utils.get_func_nonlocals(func)
+    scalars = frozenset(k for k, v in nonlocals.items() if v is None or isinstance(v, (bool, int, float, str)))
+    key = utils.get_trace_key(func, exclude=scalars)
+    if key is None:
+        return mutate(func)
+    entry = _ir_gen_cache.get(key[0])
+    if entry is not None:
+        return entry[1].rebind(nonlocals)
+    ir_gen = mutate(func)
+    _ir_gen_cache.put(key[0], (key[1], ir_gen))
+    return ir_gen
+
+
+def _param_annotations(sig: inspect.Signature, ir_gen: IRGenerator, func_annot: dict[str, Any]) -> dict[str, Any]:
+    annot = {}
+    for param in sig.parameters.values():
+        if param.kind == param.POSITIONAL_ONLY:
+            raise TypeError(f"PrimFunc does not support positional-only parameters: `{param.name}`")
+        if param.name in ir_gen.extra_type_hints:
+            annot[param.name] = ir_gen.extra_type_hints[param.name]
+        elif param.name in func_annot:
+            annot[param.name] = func_annot[param.name]
+    for k in annot:
+        # Call callable annotations (e.g., factory functions) to get the actual type.
+        # Skip typing generics like Optional[int], Union[...], List[...] which are
+        # callable but cannot be instantiated.
+        if not isinstance(annot[k], type) and callable(annot[k]) and get_origin(annot[k]) is None:
+            annot[k] = annot[k]()
+    return annot
+
+
+def _trace(func: Callable, ir_gen: IRGenerator, annot: dict[str, Any]) -> tuple[PrimFunc, Any]:
+    builder = Builder()
+    with builder.prim_func(func.__name__):
+        ir_gen.gen(builder)(**annot)
+    return builder.get(), builder.out_idx
+
+
+_FOLDED_OPS = {
+    tvm.tir.Add: lambda a, b: a + b,
+    tvm.tir.Sub: lambda a, b: a - b,
+    tvm.tir.Mul: lambda a, b: a * b,
+    tvm.tir.FloorDiv: tvm.tir.floordiv,
+    tvm.tir.FloorMod: tvm.tir.floormod,
+}
+
+
+def _fold_constants(func: PrimFunc) -> PrimFunc:
+    # Rebuild the arithmetic on a specialized constant through the operators,
+    # which fold it as they did while tracing the constant
+    def postorder(node):
+        if isinstance(node, tvm.tir.AttrStmt):
+            # `Specialize` leaves the domain of the launched threads
+            iv = node.node
+            if isinstance(iv, tvm.tir.IterVar) and iv.dom is not None and not iv.dom.extent.same_as(node.value):
+                iv = tvm.tir.IterVar(Range.from_min_extent(iv.dom.min, node.value), iv.var, iv.iter_type, iv.thread_tag)
+                return tvm.tir.AttrStmt(iv, node.attr_key, node.value, node.body)
+            return None
+        if isinstance(node.a, IntImm) or isinstance(node.b, IntImm):
+            return _FOLDED_OPS[type(node)](node.a, node.b)
+        return None
+
+    only = ["tir.AttrStmt", "tir.Add", "tir.Sub", "tir.Mul", "tir.FloorDiv", "tir.FloorMod"]
+    return func.with_body(tvm.tir.stmt_functor.ir_transform(func.body, None, postorder, only))
+
+
+def _get_template(func: Callable, ir_gen: IRGenerator, sig: inspect.Signature) -> tuple[_Template, dict[str, int]] | None:
+    """The symbolic trace of ``func`` and the values of its symbols, None if it has none."""
+    names = utils.get_shape_constants(func)
+    nonlocals = utils.get_func_nonlocals(func)
+    values = {k: nonlocals[k] for k in sorted(names) if type(nonlocals.get(k)) is int}
+    if not values:
+        return None
+    dtypes = {k: "int32" if -(1 << 31) <= v < (1 << 31) else "int64" for k, v in values.items()}
+    key = utils.get_trace_key(func, exclude=frozenset(values))
+    if key is None:
+        return None
+    template_key = (key[0], tuple(dtypes.items()))
+    template = _template_cache.get(template_key)
+    if template is None:
+        # The first size is traced as is, a template pays off from the second one
+        _template_cache.put(template_key, _Template(key[1]))
+        return None
+    if template.prim_func is None and not template.failed:
+        symbols = {k: Var(k, dtype) for k, dtype in dtypes.items()}
+        try:
+            localns = {**nonlocals, **symbols}
+            func_annot = get_type_hints(func, utils.get_annotation_sources(func), localns)
+            body, out_idx = _trace(func, ir_gen.rebind(localns), _param_annotations(sig, ir_gen, func_annot))
+        except Exception as e:  # noqa: BLE001
+            logger.debug(f"Cannot trace {func.__name__} over its shape constants {list(symbols)}: {e}")
+            template.failed = True
+            return None
+        params = list(body.params) + list(symbols.values())
+        template.symbols, template.out_idx = symbols, out_idx
+        template.prim_func = PrimFunc(params, body.body, body.ret_type, body.buffer_map, body.attrs)
+    if template.failed:
+        return None
+    return template, values
+
+
+def prim_func(func: Callable[_P, _T] = None, *, eager_jit: bool = False) -> PrimFunc[_P, _T] | JITFunc[_P, _T]:
+    def impl(func: Callable[_P, _T]) -> PrimFunc[_P, _T] | Callable[_P, PrimFunc[_P, _T]]:
+        # Skip the AST rewrite, and the tracing of a non-eager function, when
+        # the same code was decorated with the same closure and globals.
+        trace_key = utils.get_trace_key(func)
+        trace = _trace_cache.get(trace_key[0]) if trace_key is not None else None
+        if trace is not None and not eager_jit and trace.prim_func is not None:
+            return trace.prim_func
+        sig = inspect.signature(func)
+        ir_gen = trace.ir_gen if trace is not None else _get_ir_gen(func)
+        if trace is None and trace_key is not None:
+            trace = _Trace(trace_key[1], ir_gen)
+            _trace_cache.put(trace_key[0], trace)
+        annot = _param_annotations(sig, ir_gen, get_type_hints(func))
+
+        if eager_jit:
+            arg_names = list(sig.parameters.keys())
+            tensor_args = {k: v for k, v in annot.items() if isinstance(v, (Buffer, Var))}
+            tensor_args_defaults = {
+                k: sig.parameters[k].default for k in tensor_args if sig.parameters[k].default is not sig.parameters[k].empty
+            }
+            return JITFunc(func, arg_names, tensor_args, tensor_args_defaults, ir_gen)
+        else:
+            # Other sizes of the same kernel specialize the trace over their symbols,
+            # once it proved to equal the trace of the values
+            template = None
+            if trace_key is not None and env.is_prim_func_template_enabled():
+                template = _get_template(func, ir_gen, sig)
+            try:
+                if template is not None and template[0].validated:
+                    prim_func, out_idx = template[0].specialize(template[1]), template[0].out_idx
+                else:
+                    prim_func, out_idx = _trace(func, ir_gen, annot)
+            except Exception as e:
+                logger.fatal(f"Failed to build prim_func from {func.__name__}\nargs={annot}\nsource={ir_gen.source}")
+                raise e
+            if template is not None and not template[0].validated:
+                try:
+                    specialized = template[0].specialize(template[1])
+                    template[0].validated = tvm.ir.structural_equal(specialized, prim_func)
+                except Exception:  # noqa: BLE001
+                    pass
+                if not template[0].validated:
+                    logger.debug(f"The trace of {func.__name__} over its shape constants differs, tracing every size")
+                    template[0].prim_func, template[0].failed = None, True
+            prim_func.orig_func = func
+            if out_idx:
+                prim_func.out_idx_override = out_idx
+            if trace is not None:
+                trace.prim_func = prim_func
+            return prim_func
+
+    return impl(func) if func is not None else impl
+
+
+from typing import _eval_type
+import re
+
+
+def get_type_hints(func, annot: dict[str, Any] | None = None, localns: dict[str, Any] | None = None):
+    annot = getattr(func, "__annotations__", None) if annot is None else annot
+    if annot is None:
+        raise TypeError(f"Failed to get function type hints, {func} is not a function")
+    hints = {}
+    # Build eval namespaces from function globals plus captured closure variables
+    # This lets annotations reference symbols like `n`, `h`, or dtype vars
+    # defined in the outer scope of a nested function.
+    globalns = func.__globals__
+    # Here we add nonlocals into localns, to capture the parameters declared in the parent function
+    # ```py
+    # def foo():
+    #   n = 128 # n is nonlocal
+    #   def bar(
+    #       A: T.Tensor(n, T.float32) # we add nonlocal in its eval context
+    #   ):
+    #      for i in range(n): ...
+    # ```
+    #
+    # This is incomplete and buggy
+    #   the only bug scenario the function body doesn't use the the parameters
+    #   but such define-no-use scenario is very rare in writing kernels
+    #
+    # ```py
+    # def foo():
+    #   n = 128
+    #   def bar(A: T.Tensor((n,), T.float32)):
+    #     ... # empty function, do not use `n`
+    if localns is None:
+        localns = utils.get_func_nonlocals(func)
+    for name, value in annot.items():
+        if name == "return":
+            continue
+        if isinstance(value, tvm.DataType):
+            hints[name] = value
+            continue
+        if value is None:
+            value = type(None)
+        if isinstance(value, str):
+            # if the annotation is string, is can be: (i) a T.float32 like annotations, (ii) a ForwardRef object
+            # typing doesn't handle (i), it will try to interpret T.float32
+            #    typing see: T.float32 is str('float32'), and there is no object named `flaot32` and give a NameError
+            # here we manually interpret it to return T.float32 object
+            try:
+                _, v = value.split(".", maxsplit=1)
+            except ValueError:
+                v = value
+            if v in dt._all_dtypes:
+                try:
+                    hints[name] = eval(value, globalns, localns)
+                    continue
+                except Exception:
+                    pass
+            if sys.version_info >= (3, 10):
+                value = ForwardRef(value, module=func.__module__)
+            else:
+                value = ForwardRef(value, is_argument=True)
+            hints[name] = _eval_type(value, globalns=globalns, localns=localns)
+        else:
+            hints[name] = value
+    return hints
+
+
+def const(name: str, dtype: str = "int32") -> tuple[Var, ...]:
+    """
+    Declare constexpr variables for dynamic tensor dimensions (eager mode only).
+
+    In eager mode, use T.const() to declare shape dimensions that will be
+    inferred from actual tensor arguments at runtime.
+
+    Example::
+
+        @tilelang.jit
+        def kernel(A, B):
+            M, N = T.const("M, N")
+            A: T.Tensor[[M, N], T.float32]
+            ...
+    """
+    builder = Builder.current()
+    # assert builder is not None, "T.const() can only be used inside @tilelang.jit (eager mode)"
+    # assert builder.eager_jit, "T.const() can only be used inside @tilelang.jit (eager mode)"
+    if builder is None or builder.eager_jit == "none":
+        raise JITNoBuilderError("T.const() can only be used inside @tilelang.jit (eager mode)")
+
+    if builder.eager_jit == "phase1":
+        # in stage 1, we create constexpr variables
+        if "," in name:
+            names = re.split(r"\s*,\s*", name)
+            return tuple(builder.constexpr(n, dtype) for n in names)
+        if " " in name:
+            names = re.split(r"\s+", name)
+            return tuple(builder.constexpr(n, dtype) for n in names)
+        else:
+            return builder.constexpr(name, dtype)
+    elif builder.eager_jit == "phase2":
+        # in stage 2, we substitute constexpr variables with actual values
+        if "," in name:
+            names = re.split(r"\s*,\s*", name)
+            return tuple(builder.eager_jit_subs[n] for n in names)
+        if " " in name:
+            names = re.split(r"\s+", name)
+            return tuple(builder.eager_jit_subs[n] for n in names)
+        else:
+            return builder.eager_jit_subs[name]
+
+
+@dataclass
+class TirTemplate(Generic[_P, _T]):
+    """
+    Template for generating TIR PrimFunc with dynamic shape substitution.
+
+    For lazy-style functions, the PrimFunc is used directly without substitution.
+    For eager-style functions, constexpr variables are substituted based on
+    actual tensor shapes at runtime.
+    """
+
+    name: str
+    prim_func: PrimFunc[_P, _T]
+    matcher: dict[Var, tuple[tvm.tir.Var, str, int, str]] | None = None
+    constexprs: set[Var] = None
+    is_lazy_style: bool = False  # True if from lazy-style (returns PrimFunc directly)
+    ir_gen: IRGenerator[_P, _T] | None = None
+
+    @classmethod
+    def create(
+        cls, name: str, prim_func: PrimFunc[_P, _T], constexpr: set[Var], ir_gen: IRGenerator[_P, _T] | None = None
+    ) -> TirTemplate[_P, _T]:
+        matcher = {}
+        for k, v in prim_func.buffer_map.items():
+            for i, s in enumerate(v.shape):
+                if s in constexpr and s not in matcher:
+                    matcher[s] = (k.name, "shape", i, s.name)
+            for i, s in enumerate(v.strides):
+                if s in constexpr and s not in matcher:
+                    matcher[s] = (k.name, "stride", i, s.name)
+        for s in constexpr:
+            if s not in matcher:
+                shapes = {k: v.shape for k, v in prim_func.buffer_map.items()}
+                strides = {k: v.strides for k, v in prim_func.buffer_map.items()}
+                raise RuntimeError(
+                    f"Constexpr variable `{s}` is not used in any buffer shape or stride.\n"
+                    "At least one **DIRECT** usage is required. Please check:\n"
+                    "(1) the variable is not used\n"
+                    f"(2) all uses are indirect, e.g. {s} * 2, {s} * 3. (you can replace them with separate constexpr variables)\n"
+                    f"Buffer shapes: {shapes}\n"
+                    f"Buffer strides: {strides}"
+                )
+        matcher = {k: matcher[k] for k in constexpr}
+        return cls(name=name, prim_func=prim_func, matcher=matcher, constexprs=constexpr, is_lazy_style=False, ir_gen=ir_gen)
+
+    @classmethod
+    def from_lazy_style(cls, name: str, prim_func: PrimFunc[_P, _T]) -> TirTemplate[_P, _T]:
+        """Create template from lazy-style function that returns PrimFunc directly."""
+        return cls(name=name, prim_func=prim_func, is_lazy_style=True)
+
+    def _parse_phase2_key(self, **kwargs):
+        if self.matcher is None:
+            return ()
+        result = []
+        for k, ty, i, name in self.matcher.values():
+            if name in kwargs:
+                result.append(kwargs.get(name))
+            elif k in kwargs:
+                if ty == "shape":
+                    result.append(kwargs[k].shape[i])
+                elif ty == "stride":
+                    v = kwargs[k]
+                    if isinstance(v, Buffer):
+                        result.append(v.strides[i])
+                    else:
+                        result.append(kwargs[k].stride()[i])
+            else:
+                raise ValueError(
+                    f"Cannot find value for constexpr variable `{name}`\n"
+                    f"Please provide it as a keyword argument, e.g. `{name}=<value>`\n"
+                    f"Or provide the corresponding tensor argument `{k}`."
+                )
+        return tuple(result)
+
+    def get_tir(self, tensor_args, given_tensor_args, kwargs):
+        if self.is_lazy_style:
+            return self.prim_func
+        values = self._parse_phase2_key(**given_tensor_args, **kwargs)
+        subs = {name.orig_name: value for name, value in zip(self.matcher, values)}
+        builder = Builder()
+        builder.eager_jit = "phase2"
+        builder.eager_jit_subs = subs
+        with builder.prim_func(self.name):
+            self.ir_gen.gen(builder)(**tensor_args, **kwargs)
+        pf = builder.get()
+        if builder.out_idx:
+            pf.out_idx_override = builder.out_idx
+        return pf
+
+
+@dataclass
+class JITFunc(Generic[_P, _T]):
+    """
+    Internal wrapper for JIT-compiled functions.
+
+    This class handles both lazy and eager execution styles:
+
+    - **lazy style**: Function explicitly returns a PrimFunc. The original function
+      is called directly to obtain the TIR.
+
+    - **eager style**: Function uses the DSL builder pattern with tensor type
+      annotations. The TIR is constructed by tracing the function body through
+      the Builder.
+
+    The style is determined by `_is_lazy_style()` which checks if calling the
+    original function returns a PrimFunc directly.
+    """
+
+    orig_func: Callable[_P, _T]
+    arg_names: list[str]
+    tensor_args: dict[str, Buffer | Var]
+    tensor_args_defaults: dict[str, Any]
+    ir_gen: IRGenerator[_P, _T]
+    mode: Literal["auto", "lazy", "eager"] = "auto"
+
+    def __post_init__(self):
+        # we don't want it to show up in the constructor
+        self.p1_cache: dict[Any, TirTemplate[_P, _T]] = {}
+
+    def _parse_phase1_key(self, *args, **kwargs):
+        kwargs.update({k: v for k, v in zip(self.arg_names, args)})
+        tensor_args = {}
+        for k in self.tensor_args:
+            if k in kwargs:
+                tensor_args[k] = kwargs.pop(k)
+            elif k in self.tensor_args_defaults:
+                tensor_args[k] = self.tensor_args_defaults[k]
+        p1_key = tuple(sorted(kwargs.items()))
+        return p1_key, tensor_args, kwargs
+
+    def _is_lazy_style(self, *args, **kwargs) -> bool:
+        """
+        Check if the function uses lazy style (explicitly returns PrimFunc).
+
+        Lazy style functions define an inner @T.prim_func and return it:
+            @jit
+            def foo(M, N):
+                @T.prim_func
+                def kernel(...): ...
+                return kernel  # <- returns PrimFunc
+
+        Eager style functions use the builder pattern with type annotations:
+            @jit
+            def foo(A, B):
+                A: T.Tensor[...]
+                with T.Kernel(...): ...
+                # no return
+        """
+        if has_internal_prim_func(self.orig_func):
+            return True
+        try:
+            inspect.signature(self.orig_func).bind(*args, **kwargs)
+        except TypeError:
+            return False
+        try:
+            prim_func = self.orig_func(*args, **kwargs)
+            # lazy jit must return PrimFunc
+            if isinstance(prim_func, PrimFunc):
+                p1_key, _, _ = self._parse_phase1_key(*args, **kwargs)
+                self.p1_cache[p1_key] = TirTemplate.from_lazy_style(self.orig_func.__name__, prim_func)
+                return True
+            return False
+        except (JITNoBuilderError, EagerJITBuildError):
+            # In eager mode, we construct AST directly without prim_func,
+            # so there's no Builder available when the function is called.
+            # When eager-only features like T.const() or T.Kernel() are used,
+            # they raise JITNoBuilderError because no Builder exists yet.
+            # This indicates the function is eager-style, not lazy-style.
+            return False
+
+    def _build_tir_template(self, *args, **kwargs) -> TirTemplate[_P, _T]:
+        """Build TIR template based on the execution mode."""
+        if self.mode == "lazy":
+            # lazy: function returns PrimFunc directly
+            return TirTemplate.from_lazy_style(self.orig_func.__name__, self.orig_func(*args, **kwargs))
+        elif self.mode == "eager":
+            # eager: trace function body through Builder to construct TIR
+            builder = Builder()
+            builder.eager_jit = "phase1"
+            with builder.prim_func(self.orig_func.__name__):
+                self.ir_gen.gen(builder)(**self.tensor_args, **kwargs)
+            pf = builder.get()
+            pf.orig_func = self.orig_func
+            if builder.out_idx:
+                pf.out_idx_override = builder.out_idx
+            return TirTemplate.create(self.orig_func.__name__, pf, builder.constexpr_var, self.ir_gen)
+        else:
+            raise ValueError(f"Invalid jit mode: {self.mode}, expected 'lazy' or 'eager'")
+
+    def parse_args(self, *args, **kwargs):
+        """Parse arguments and return cache key and tensor args."""
+        p1_key, tensor_args, kwargs = self._parse_phase1_key(*args, **kwargs)
+        if not tensor_args:
+            return (p1_key, None), kwargs
+        tir_temp = self.p1_cache.get(p1_key, None)
+        if tir_temp is None:
+            # mode should be set by JITImpl before calling parse_args
+            tir_temp = self._build_tir_template(**kwargs)
+            self.p1_cache[p1_key] = tir_temp
+        p2_key = tir_temp._parse_phase2_key(**tensor_args, **kwargs)
+        return (p1_key, p2_key), tensor_args
+
+    def get_tir(self, *args, **kwargs):
+        p1_key, tensor_args, kwargs = self._parse_phase1_key(*args, **kwargs)
+        if p1_key not in self.p1_cache:
+            # in legacy gemm, we use lazy tir template to build the tir
+            self.p1_cache[p1_key] = self._build_tir_template(**kwargs)
+        return self.p1_cache[p1_key].get_tir(self.tensor_args, tensor_args, kwargs)
+
+    def __call__(self, *args, **kwargs):
+        return self.get_tir(*args, **kwargs)
+
+    def set_mode(self, mode: Literal["lazy", "eager"]):
+        """Set the JIT execution mode (internal use only)."""
+        self.mode = mode
+
+    # Proxy function attributes for compatibility with autotuner and inspect.
+    # These attributes are needed by autotuner to extract closure variables
+    # and generate cache keys.
+    _PROXIED_ATTRS = frozenset({"__closure__", "__code__", "__name__", "__globals__", "__wrapped__"})
+
+    def __getattr__(self, name):
+        if name in JITFunc._PROXIED_ATTRS:
+            if name == "__wrapped__":
+                return self.orig_func
+            return getattr(self.orig_func, name)
+        raise AttributeError(f"'{type(self).__name__}' object has no attribute '{name}'")
+
+
+def substitute_primfunc(prim_func, vmap):
+    analyzer = tvm.arith.Analyzer()
+
+    def sub(v):
+        return analyzer.simplify(substitute(v, vmap))
+
+    def substitute_buffer(buf):
+        return tvm.tir.decl_buffer(
+            data=sub(buf.data),
+            shape=[sub(dim) for dim in buf.shape],
+            dtype=buf.dtype,
+            strides=[sub(stride) for stride in buf.strides] if buf.strides else None,
+        )
+
+    return PrimFunc(
+        params=[sub(v) for v in prim_func.params],
+        body=substitute(prim_func.body, vmap),
+        buffer_map={k: substitute_buffer(v) for k, v in prim_func.buffer_map.items()},
+        attrs=prim_func.attrs,
+    )
+
+
+@dataclass
+class _Trace:
+    refs: list[Any]
+    ir_gen: IRGenerator
+    prim_func: PrimFunc | None = None
+
+
+# Traces of the functions decorated by prim_func, e.g. by the kernel factories
+# called for every configuration while autotuning, by `utils.get_trace_key`
+_TRACE_CACHE_SIZE = 256
+_trace_cache: OrderedDict[Hashable, _Trace] = OrderedDict()
+_trace_cache_lock = threading.Lock()
+
+
+def _lookup_trace(key: Hashable) -> _Trace | None:
+    with _trace_cache_lock:
+        trace = _trace_cache.get(key, None)
+        if trace is not None:
+            _trace_cache.move_to_end(key)
+        return trace
+
+
+def _store_trace(key: Hashable, trace: _Trace):
+    with _trace_cache_lock:
+        _trace_cache[key] = trace
+        while len(_trace_cache) > _TRACE_CACHE_SIZE:
+            _trace_cache.popitem(last=False)
+
+
+def clear_trace_cache():
+    """Drop the cached traces, e.g. after mutating a value a kernel reads."""
+    with _trace_cache_lock:
+        _trace_cache.clear()
+
+
 def prim_func(func: Callable[_P, _T] = None, *, eager_jit: bool = False) -> PrimFunc[_P, _T] | JITFunc[_P, _T]:
     def impl(func: Callable[_P, _T]) -> PrimFunc[_P, _T] | Callable[_P, PrimFunc[_P, _T]]:
+        # Skip the AST rewrite, and the tracing of a non-eager function, when
+        # the same code was decorated with the same closure and globals.
+        trace_key = utils.get_trace_key(func)
+        trace = _lookup_trace(trace_key[0]) if trace_key is not None else None
+        if trace is not None and not eager_jit and trace.prim_func is not None:
+            return trace.prim_func
         sig = inspect.signature(func)
-        ir_gen = mutate(func)
+        ir_gen = trace.ir_gen if trace is not None else mutate(func)
+        if trace is None and trace_key is not None:
+            trace = _Trace(trace_key[1], ir_gen)
+            _store_trace(trace_key[0], trace)
         func_annot = get_type_hints(func)
         annot = {}
         for param in sig.parameters.values():
@@ -1190,6 +1825,8 @@ def prim_func(func: Callable[_P, _T] = None, *, eager_jit: bool = False) -> Prim
                 prim_func.orig_func = func
                 if builder.out_idx:
                     prim_func.out_idx_override = builder.out_idx
+                if trace is not None:
+                    trace.prim_func = prim_func
                 return prim_func
             except Exception as e:
                 logger.fatal(f"Failed to build prim_func from {func.__name__}\nargs={annot}\nsource={ir_gen.source}")
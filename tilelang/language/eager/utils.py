@@ -1,11 +1,16 @@
 from __future__ import annotations
 import ast
+import dis
+import enum
 import inspect
+import types
+from collections.abc import Hashable
 from typing import Any, Callable, Literal
 from tilelang import env
 from hashlib import sha256
 from tvm import tir
 import linecache
+import tvm
 
 
 def disk_compile(source, name):
@@ -55,6 +60,162 @@ def get_func_nonlocals(func):
     return nonlocal_vars
 
 
+class _Untraceable(Exception):
+    pass
+
+
+def _trace_key_of(value: Any, refs: list[Any]) -> Hashable:
+    # Immutable values are keyed by value; functions, classes, modules and TVM
+    # objects by identity, kept alive in `refs` so that their ids stay unique.
+    # Anything else, e.g. a list that may be mutated in place, is untraceable.
+    if value is None or isinstance(value, (bool, int, float, complex, str, bytes, enum.Enum)):
+        return (type(value), value)
+    if isinstance(value, tvm.DataType):
+        return (tvm.DataType, str(value))
+    if isinstance(value, (tuple, frozenset)):
+        return (type(value), tuple(_trace_key_of(v, refs) for v in value))
+    if isinstance(value, (types.FunctionType, types.ModuleType, type, tvm.runtime.Object)) or callable(value):
+        refs.append(value)
+        return ("id", id(value))
+    raise _Untraceable
+
+
+def _global_names(code: types.CodeType) -> set[str]:
+    names = {ins.argval for ins in dis.get_instructions(code) if ins.opname in ("LOAD_GLOBAL", "LOAD_NAME")}
+    for const in code.co_consts:
+        if isinstance(const, types.CodeType):
+            names |= _global_names(const)
+    return names
+
+
+def get_trace_key(func: Callable, exclude: frozenset[str] = frozenset()) -> tuple[Hashable, list[Any]] | None:
+    """Key of what the trace of ``func`` depends on, None if it cannot be keyed.
+
+    The trace depends on the code of the function, which stands for its
+    source, and on the values of its closure, defaults and globals. Returns
+    the key and the objects keyed by identity, which must outlive it. The
+    closure variables of ``exclude`` are left out of the key.
+    """
+    if not inspect.isfunction(func):
+        return None
+    refs: list[Any] = []
+    globalns = func.__globals__
+    nonlocals = tuple((k, v) for k, v in get_func_nonlocals(func).items() if k not in exclude)
+    try:
+        key = (
+            func.__code__,
+            _trace_key_of(nonlocals, refs),
+            _trace_key_of(func.__defaults__, refs),
+            _trace_key_of(tuple(sorted((func.__kwdefaults__ or {}).items())), refs),
+            _trace_key_of(tuple((name, globalns[name]) for name in sorted(_global_names(func.__code__)) if name in globalns), refs),
+        )
+    except _Untraceable:
+        return None
+    return key, refs
+
+
+# Calls whose positional arguments are loop or grid extents
+_EXTENT_CALLS = frozenset({"Kernel", "Pipelined", "serial"})
+# Integer arithmetic the tracer leaves to TIR, which folds it the same way
+_INDEX_OPS = (ast.Add, ast.Sub, ast.Mult, ast.FloorDiv, ast.Mod)
+_shape_constants: dict[types.CodeType, frozenset[str]] = {}
+
+
+def _callee(node: ast.AST) -> str | None:
+    if isinstance(node, ast.Call) and isinstance(node.func, ast.Attribute):
+        return node.func.attr
+    return None
+
+
+def _tensor_shape(annot: ast.expr | None) -> ast.expr | None:
+    if isinstance(annot, ast.Call) and annot.args and _callee(annot) == "Tensor":
+        return annot.args[0]
+    if isinstance(annot, ast.Subscript) and isinstance(annot.value, ast.Attribute) and annot.value.attr == "Tensor":
+        return annot.slice.elts[0] if isinstance(annot.slice, ast.Tuple) and annot.slice.elts else annot.slice
+    return None
+
+
+def _is_extent(node: ast.Name, parents: dict[ast.AST, ast.AST]) -> bool:
+    # Climb the integer arithmetic the name is an operand of
+    child, parent = node, parents.get(node)
+    while (
+        (isinstance(parent, ast.BinOp) and isinstance(parent.op, _INDEX_OPS))
+        or (isinstance(parent, ast.UnaryOp) and isinstance(parent.op, ast.USub))
+        or (_callee(parent) == "ceildiv" and child in parent.args)
+        or (isinstance(parent, ast.Tuple) and isinstance(parents.get(parent), ast.Subscript) and parents[parent].slice is parent)
+    ):
+        child, parent = parent, parents.get(parent)
+    if _callee(parent) in _EXTENT_CALLS and child in parent.args:
+        if any(kw.arg == "cluster_dims" for kw in parent.keywords):
+            return False
+        holder = parents.get(parent)
+        return (isinstance(holder, ast.withitem) and holder.context_expr is parent) or (
+            isinstance(holder, ast.For) and holder.iter is parent
+        )
+    if isinstance(parent, ast.Subscript) and parent.slice is child and isinstance(parent.value, ast.Name):
+        # A buffer index of an assignment
+        child, parent = parent, parents.get(parent)
+        while isinstance(parent, (ast.BinOp, ast.UnaryOp)):
+            child, parent = parent, parents.get(parent)
+        if not isinstance(parent, (ast.Assign, ast.AugAssign)):
+            return False
+        return child is parent.value or child in getattr(parent, "targets", [getattr(parent, "target", None)])
+    return False
+
+
+def get_shape_constants(func: Callable) -> frozenset[str]:
+    """Closure variables of ``func`` that its trace can take as symbols.
+
+    A variable qualifies when it is never assigned and every use of it is an
+    element of the shape of a ``T.Tensor`` parameter (the outermost one from
+    rank 3 on, whose strides are products of dims), or an operand of integer
+    arithmetic (and ``ceildiv``) that is a positional extent of ``T.Kernel``,
+    ``T.Pipelined`` or ``T.serial`` or a buffer index of an assignment. Its
+    value then only flows into TIR expressions, never into a decision of the
+    Python code, so that the trace of a value equals the trace of a symbol
+    specialized to that value.
+    """
+    code = func.__code__
+    names = _shape_constants.get(code)
+    if names is not None:
+        return names
+    try:
+        tree = get_ast(func)
+    except (OSError, TypeError, SyntaxError):
+        tree = None
+    fdef = tree.body[0] if tree is not None and tree.body else None
+    if not isinstance(fdef, ast.FunctionDef):
+        _shape_constants[code] = frozenset()
+        return frozenset()
+    parents = {child: node for node in ast.walk(fdef) for child in ast.iter_child_nodes(node)}
+    shape_elems = set()
+    for arg in fdef.args.args + fdef.args.kwonlyargs:
+        shape = _tensor_shape(arg.annotation)
+        if isinstance(shape, (ast.Tuple, ast.List)):
+            # The inner dims of a tensor of rank 3 or more multiply into its strides
+            elts = shape.elts if len(shape.elts) <= 2 else shape.elts[:1]
+            shape_elems.update(e for e in elts if isinstance(e, ast.Name))
+    candidates = set(code.co_freevars)
+    used, disqualified = set(), set()
+    for node in ast.walk(fdef):
+        if isinstance(node, ast.Name) and node.id in candidates:
+            used.add(node.id)
+            if not isinstance(node.ctx, ast.Load) or not (node in shape_elems or _is_extent(node, parents)):
+                disqualified.add(node.id)
+        elif isinstance(node, (ast.Nonlocal, ast.Global)):
+            disqualified.update(node.names)
+    names = frozenset(used - disqualified)
+    _shape_constants[code] = names
+    return names
+
+
+def get_annotation_sources(func: Callable) -> dict[str, str]:
+    """Source of the parameter annotations of ``func``, to evaluate them over other closure values."""
+    fdef = get_ast(func).body[0]
+    args = fdef.args.posonlyargs + fdef.args.args + fdef.args.kwonlyargs
+    return {arg.arg: ast.unparse(arg.annotation) for arg in args if arg.annotation is not None}
+
+
 def get_ast(func: Callable):
     _, start = inspect.getsourcelines(func)
     filename = inspect.getsourcefile(func) or inspect.getfile(func)
@@ -2,6 +2,8 @@
 
 from __future__ import annotations
 
+from typing import Callable
+
 from tilelang.tileop.base import GemmWarpPolicy
 import tilelang.language as T
 from tvm import tir
@@ -11,6 +13,7 @@ from tilelang.utils.language import (
     retrieve_stride,
     retrieve_offset,
     prim_expr_equal,
+    _get_buffer,
 )
 from tilelang.language.utils import (
     buffer_region_to_tile_region,
@@ -30,6 +33,10 @@ def _gemm_impl(
     k_pack: int = 1,
     wg_wait: int = 0,
     mbar: tir.Buffer | None = None,
+    fragment_double_buffer: bool = False,
+    use_2cta: bool = False,
+    scale_factors: tuple | None = None,
+    sf_vec_size: int = 32,
 ):
     """Shared GEMM implementation.
 
@@ -101,6 +108,18 @@ def _gemm_impl(
     A_arg = buffer_region_to_tile_region(A_region, "r", [r for r in A_shape])
     B_arg = buffer_region_to_tile_region(B_region, "r", [r for r in B_shape])
     C_arg = buffer_region_to_tile_region(C_region, "rw", [r for r in C_shape])
+    annotations = {}
+    if fragment_double_buffer:
+        annotations["fragment_double_buffer"] = 1
+    if use_2cta:
+        annotations["use_2cta"] = 1
+    sf_args = []
+    if scale_factors is not None:
+        # SFA, SFB and, on sm100, their tensor memory buffers
+        for sf in scale_factors:
+            sf_region = to_buffer_region(legalize_arguments(sf))
+            sf_args.append(buffer_region_to_tile_region(sf_region, "r", retrieve_shape(sf_region)))
+        annotations["sf_vec_size"] = sf_vec_size
     return tir.call_intrin(
         "handle",
         tir.op.Op.get(op_key),
@@ -123,6 +142,8 @@ def _gemm_impl(
         mbar,
         C_coords[0],
         C_coords[1],
+        *sf_args,
+        annotations=annotations or None,
     )
 
 
@@ -167,6 +188,8 @@ def gemm_v2(
     k_pack: int = 1,
     wg_wait: int = 0,
     mbar: tir.Buffer | None = None,
+    fragment_double_buffer: bool = False,
+    use_2cta: bool = False,
 ):
     """GEMM v2: use op tl.gemm_py."""
     return _gemm_impl(
@@ -181,6 +204,8 @@ def gemm_v2(
         k_pack,
         wg_wait,
         mbar,
+        fragment_double_buffer,
+        use_2cta,
     )
 
 
@@ -199,6 +224,8 @@ def gemm(
     k_pack: int = 1,
     wg_wait: int = 0,
     mbar: tir.Buffer | None = None,
+    fragment_double_buffer: bool = False,
+    use_2cta: bool = False,
 ):
     """TileLang GEMM operator.
 
@@ -213,10 +240,214 @@ def gemm(
         k_pack (int): Numbers of packed matrix cores, for ROCm only. Defaults to 1.
         wg_wait (int): Int identifier of the warpgroup MMA batch to wait on.. Defaults to 0.
         mbar (tir.Buffer | None, optional): Mbarrier in Blackwell. Defaults to None.
+        fragment_double_buffer (bool): Double-buffer the A/B register fragments of
+            the mma lowering, loading K-slice k + 1 from shared memory before the
+            mma ops of slice k. Costs one extra set of fragment registers.
+            Defaults to False.
+        use_2cta (bool): Issue the TCGEN5MMA of sm100 across the CTA pairs of
+            a cluster (ranks 2i and 2i + 1), computing a 2M x N tile per pair.
+            Each CTA holds its M rows of A and C and N / 2 columns of B, the
+            even CTA holding the first half. Requires M == 128, an even
+            cluster size and every thread of the block reaching the gemm.
+            Defaults to False.
+
+    Returns:
+        tir.Call: A handle to the GEMM operation.
+    """
+
+    if _env.use_gemm_v1():
+        if use_2cta:
+            raise ValueError("use_2cta is only supported by gemm_v2, unset TILELANG_USE_GEMM_V1")
+        # The v1 templates always prefetch the next K-slice of the fragments.
+        return gemm_v1(A, B, C, transpose_A, transpose_B, policy, clear_accum, k_pack, wg_wait, mbar)
+    return gemm_v2(A, B, C, transpose_A, transpose_B, policy, clear_accum, k_pack, wg_wait, mbar, fragment_double_buffer, use_2cta)
+
+
+def gemm_blockscaled(
+    A: tir.Buffer | tir.Var,
+    B: tir.Buffer | tir.Var,
+    C: tir.Buffer | tir.Var,
+    SFA: tir.Buffer | tir.Var,
+    SFB: tir.Buffer | tir.Var,
+    SFA_tmem: tir.Buffer | tir.Var | None = None,
+    SFB_tmem: tir.Buffer | tir.Var | None = None,
+    transpose_A: bool = False,
+    transpose_B: bool = True,
+    clear_accum: bool = False,
+    mbar: tir.Buffer | None = None,
+    sf_vec_size: int = 32,
+):
+    """Block scaled GEMM, C += (SFA * A) @ (SFB * B).
+
+    Every ``sf_vec_size`` consecutive elements of K of a row of A (of B)
+    share a scale factor, the MMAs applying them in hardware instead of
+    dequantizing A and B first. On sm100 the TCGEN5MMA (tcgen05.mma
+    .block_scale) reads the scale factors from tensor memory:
+
+    - FP8 A/B (MXFP8): UE8M0 scale factors, ``sf_vec_size=32``.
+    - FP4 ``float4_e2m1fn`` A/B (MXFP4): UE8M0 scale factors, ``sf_vec_size=32``.
+    - FP4 ``float4_e2m1fn`` A/B (NVFP4): UE4M3 scale factors, ``sf_vec_size=16``.
+
+    On sm120, which has no tensor memory, the warp level MMA (mma.sync
+    .block_scale) reads them from shared memory, for FP8 A/B with UE8M0 scale
+    factors and ``sf_vec_size=32`` into a float32 fragment C. SFA_tmem and
+    SFB_tmem are then omitted. The same holds on CDNA4 (gfx950), where the
+    v_mfma_scale_f32_16x16x128_f8f6f4 MFMA applies them, for K a multiple
+    of 128.
+
+    Args:
+        A (tir.Buffer | tir.Var): (M, K) K-major tile of A in shared memory, M == 128 on sm100.
+        B (tir.Buffer | tir.Var): (N, K) K-major tile of B in shared memory, N % 128 == 0 on sm100.
+        C (tir.Buffer | tir.Var): (M, N) float32 accumulator in tensor memory, a fragment on sm120 and gfx950.
+        SFA (tir.Buffer | tir.Var): (M, K // sf_vec_size) 8-bit scale factors of A in
+            shared memory, the raw bytes of UE8M0 or UE4M3 values. K // sf_vec_size
+            must be a multiple of 4.
+        SFB (tir.Buffer | tir.Var): (N, K // sf_vec_size) 8-bit scale factors of B in shared memory.
+        SFA_tmem (tir.Buffer | tir.Var | None): Tensor memory of at least M // 128 * K // sf_vec_size
+            columns the scale factors of A are copied into, sm100 only.
+        SFB_tmem (tir.Buffer | tir.Var | None): Tensor memory of at least N // 128 * K // sf_vec_size
+            columns the scale factors of B are copied into, sm100 only.
+        transpose_A (bool): Must be False. Defaults to False.
+        transpose_B (bool): Must be True. Defaults to True.
+        clear_accum (bool): Whether to clear the accumulator.
+        mbar (tir.Buffer | None, optional): Mbarrier the completion of the MMAs is signaled on.
+        sf_vec_size (int): Elements of K sharing a scale factor, 32 or 16. Defaults to 32.
 
     Returns:
         tir.Call: A handle to the GEMM operation.
     """
+    if _env.use_gemm_v1():
+        raise ValueError("gemm_blockscaled is only supported by gemm_v2, unset TILELANG_USE_GEMM_V1")
+    if (SFA_tmem is None) != (SFB_tmem is None):
+        raise ValueError("gemm_blockscaled expects both SFA_tmem and SFB_tmem, or neither")
+    scale_factors = (SFA, SFB) if SFA_tmem is None else (SFA, SFB, SFA_tmem, SFB_tmem)
+    return _gemm_impl(
+        "tl.tileop.gemm_py",
+        A,
+        B,
+        C,
+        transpose_A,
+        transpose_B,
+        GemmWarpPolicy.Square,
+        clear_accum,
+        1,
+        -1,
+        mbar,
+        scale_factors=scale_factors,
+        sf_vec_size=sf_vec_size,
+    )
+
+
+@T.macro
+def _store_epilogue(C: tir.Buffer, D, fn, staging: tir.Buffer):
+    # The previous async store may still be reading the staging buffer.
+    T.tma_store_wait()
+    T.sync_threads()
+    for i, j in T.Parallel(C.shape[0], C.shape[1]):
+        staging[i, j] = T.cast(fn(C[i, j], i, j), staging.dtype)
+    T.copy(staging, D, annotations={"tma_store_async": 1})
+
+
+def gemm_epilogue(
+    C: tir.Buffer,
+    D: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    fn: Callable[[tir.PrimExpr, tir.PrimExpr, tir.PrimExpr], tir.PrimExpr] | None = None,
+    staging: tir.Buffer | None = None,
+):
+    """Apply an elementwise epilogue to a GEMM accumulator and store it to global memory.
+
+    ``fn(value, i, j)`` is evaluated on every element of the accumulator
+    fragment, ``i, j`` being its coordinates within the tile, e.g.
+    ``lambda x, i, j: T.max(x + bias[bx * block_N + j], 0)`` for bias and
+    ReLU. The result is cast to the dtype of ``D``, staged in swizzled shared
+    memory and written with a TMA store on targets that support it.
+
+    The store is asynchronous: it overlaps with whatever follows, typically
+    the main loop of the next tile of a persistent kernel, and the next
+    epilogue waits for it before reusing ``staging``. The kernel waits for
+    the last store before it exits.
+
+    Args:
+        C (tir.Buffer): 2-D accumulator fragment of the tile.
+        D (tir.Buffer | tir.BufferLoad | tir.BufferRegion): Destination tile in global memory.
+        fn (Callable, optional): Elementwise epilogue. Defaults to the identity.
+        staging (tir.Buffer, optional): Shared buffer of the shape of ``C`` in the dtype
+            of ``D``. Allocated when omitted; pass one to share it between epilogues.
+    """
+    if len(C.shape) != 2:
+        raise ValueError(f"gemm_epilogue expects a 2-D accumulator, got shape {list(C.shape)}")
+    if fn is None:
+
+        def fn(x, i, j):
+            return x
 
-    impl = gemm_v1 if _env.use_gemm_v1() else gemm_v2
-    return impl(A, B, C, transpose_A, transpose_B, policy, clear_accum, k_pack, wg_wait, mbar)
+    if staging is None:
+        staging = T.alloc_shared(C.shape, _get_buffer(D).dtype)
+    _store_epilogue(C, D, fn, staging)
+
+
+@T.macro
+def _apply_prologue(src: tir.Buffer, dst: tir.Buffer, fn):
+    for i, j in T.Parallel(src.shape[0], src.shape[1]):
+        dst[i, j] = T.cast(fn(src[i, j], i, j), dst.dtype)
+
+
+def gemm_prologue(
+    A: tir.Buffer,
+    B: tir.Buffer,
+    C: tir.Buffer,
+    a_fn: Callable[[tir.PrimExpr, tir.PrimExpr, tir.PrimExpr], tir.PrimExpr] | None = None,
+    b_fn: Callable[[tir.PrimExpr, tir.PrimExpr, tir.PrimExpr], tir.PrimExpr] | None = None,
+    a_fragment: tir.Buffer | None = None,
+    b_staging: tir.Buffer | None = None,
+    **kwargs,
+):
+    """GEMM whose operands go through an elementwise prologue, e.g. dequantization, scaling or RoPE.
+
+    ``a_fn(value, i, j)`` is evaluated on every element of the shared tile
+    ``A``, ``i, j`` being its coordinates within the tile as stored (before
+    ``transpose_A``), while it is loaded into the register fragment that
+    feeds the MMA. The fragment takes the operand layout of the GEMM, so
+    every thread transforms exactly the elements its MMA instructions read
+    and the transformed tile never goes back through shared memory; on
+    Hopper the GEMM is issued as wgmma with A from registers.
+
+    ``b_fn`` transforms ``B`` into ``b_staging``, a shared tile the GEMM
+    reads through its own swizzled layout, since wgmma and tcgen05 read B
+    from shared memory only.
+
+    A transformed operand defaults to the dtype of the other one when only
+    one is transformed, so that a quantized operand is dequantized to the
+    dtype it multiplies with.
+
+    Args:
+        A (tir.Buffer): 2-D shared (or fragment) tile of A.
+        B (tir.Buffer): 2-D shared tile of B.
+        C (tir.Buffer): Accumulator.
+        a_fn (Callable, optional): Elementwise prologue of A.
+        b_fn (Callable, optional): Elementwise prologue of B.
+        a_fragment (tir.Buffer, optional): Fragment of the shape of ``A`` holding the
+            transformed A. Allocated when omitted.
+        b_staging (tir.Buffer, optional): Shared buffer of the shape of ``B`` holding the
+            transformed B. Allocated when omitted.
+        **kwargs: Further arguments of ``T.gemm``.
+
+    Returns:
+        tir.Call: A handle to the GEMM operation.
+    """
+    for name, buffer, fn in (("A", A, a_fn), ("B", B, b_fn)):
+        if fn is not None and (not isinstance(buffer, tir.Buffer) or len(buffer.shape) != 2):
+            raise ValueError(f"gemm_prologue expects {name} to be a 2-D buffer when it has a prologue")
+    a_dtype = B.dtype if b_fn is None else A.dtype
+    b_dtype = A.dtype if a_fn is None else B.dtype
+    if a_fn is not None:
+        if a_fragment is None:
+            a_fragment = T.alloc_fragment(A.shape, a_dtype)
+        _apply_prologue(A, a_fragment, a_fn)
+        A = a_fragment
+    if b_fn is not None:
+        if b_staging is None:
+            b_staging = T.alloc_shared(B.shape, b_dtype)
+        _apply_prologue(B, b_staging, b_fn)
+        B = b_staging
+    return gemm(A, B, C, **kwargs)
@@ -0,0 +1,58 @@
+"""Walsh-Hadamard transforms exposed on the TileLang language surface."""
+
+from __future__ import annotations
+from tvm import tir
+from tilelang.utils.language import to_buffer_region, retrieve_shape, _get_buffer
+from tilelang.utils.language import is_fragment
+
+
+def hadamard(
+    buffer: tir.Buffer | tir.BufferRegion,
+    dim: int = -1,
+    scale: float | tir.PrimExpr | None = None,
+):
+    """Fast Walsh-Hadamard transform of a fragment along one dimension, in place.
+
+    With ``n = buffer.shape[dim]`` a power of two, every line along ``dim``
+    becomes ``x @ H_n * scale`` with ``H_n`` the Sylvester Hadamard matrix,
+    computed as ``log2(n)`` butterfly stages. Each stage is lowered after where
+    the layout of the fragment places its pairs of elements: in the registers
+    of a thread, through warp shuffles between lanes, and, only for the pairs
+    spanning warps, through a single exchange in shared memory. The fragment
+    keeps the layout other operators give it, e.g. the accumulator layout of
+    ``T.gemm``, so the transform fuses in front of ``T.quantize`` or a gemm
+    consuming the fragment.
+
+    Args:
+        buffer: Floating point fragment, transformed as a whole.
+        dim (int): Transformed dimension, negative values counting from the end.
+        scale: Factor applied to the result, e.g. ``1 / sqrt(n)`` for the
+            orthonormal transform. None for no scaling.
+
+    Returns:
+        tir.Call: Handle to the Hadamard transform intrinsic call.
+
+    Example:
+        >>> T.gemm(A_shared, B_shared, C_local)
+        >>> T.hadamard(C_local, dim=1, scale=1 / math.sqrt(block_N))
+        >>> T.quantize(C_local, Y[by * block_M, bx * block_N], Y_scale[by * block_M])
+    """
+    if not is_fragment(buffer):
+        raise ValueError(f"T.hadamard expects a fragment, got {_get_buffer(buffer).scope()}")
+    shape = retrieve_shape(buffer)
+    if not -len(shape) <= dim < len(shape):
+        raise ValueError(f"T.hadamard got dim {dim} for a fragment of shape {shape}")
+    dim %= len(shape)
+    n = shape[dim]
+    if not isinstance(n, int) and not isinstance(n, tir.IntImm):
+        raise ValueError(f"T.hadamard expects a static extent along dim {dim}, got {n}")
+    n = int(n)
+    if n <= 0 or n & (n - 1):
+        raise ValueError(f"T.hadamard expects a power of two extent along dim {dim}, got {n}")
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.hadamard"),
+        to_buffer_region(buffer, access_type="rw"),
+        dim,
+        1.0 if scale is None else scale,
+    )
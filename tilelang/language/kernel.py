@@ -231,6 +231,8 @@ def Kernel(
     threads: int | list[int] | tuple | None = None,
     is_cpu: bool = False,
     prelude: str | None = None,
+    cluster_dims: int | list[int] | tuple | None = None,
+    min_blocks_per_sm: int | str | None = None,
 ):
     """Tools to quickly construct a GPU kernel launch frame.
 
@@ -249,6 +251,18 @@ def Kernel(
     prelude : str
         The import c code of the kernel,
         will be injected before the generated kernel code.
+    cluster_dims : int | list[int] | tuple
+        Shape of the thread block clusters (sm_90+), 1-3 dimensions.
+        The grid extent of each dimension must be a multiple of it.
+        CTAs of a cluster can synchronize with ``T.cluster_sync`` and
+        reduce across each other with ``T.cluster_allreduce``.
+    min_blocks_per_sm : int | str
+        Blocks per SM the kernel must allow, the second argument of its
+        ``__launch_bounds__`` (1 by default): ptxas limits the registers per
+        thread so that this many blocks fit on an SM. ``"auto"`` derives it
+        from the shared memory plan and the register estimate of the lowered
+        kernel. Like any argument of the program, it can be a key of the
+        auto-tuner configurations.
 
     Returns
     -------
@@ -309,6 +323,30 @@ def Kernel(
     if prelude is not None:
         attrs["pragma_import_c"] = prelude
 
+    if cluster_dims is not None:
+        assert not is_cpu, "cluster_dims is only supported by GPU kernels"
+        if isinstance(cluster_dims, int):
+            cluster_dims = [cluster_dims]
+        cluster_dims = list(cluster_dims) + [1] * (3 - len(cluster_dims))
+        assert len(cluster_dims) == 3 and all(isinstance(d, int) and d > 0 for d in cluster_dims), (
+            f"cluster_dims must be 1-3 positive integers, got {cluster_dims}"
+        )
+        for extent, dim in zip(blocks, cluster_dims):
+            if isinstance(extent, (int, tir.IntImm)):
+                assert int(extent) % dim == 0, f"grid extent {extent} is not a multiple of the cluster dimension {dim}"
+        attrs["pragma_cluster_dims"] = ", ".join(str(d) for d in cluster_dims)
+
+    if min_blocks_per_sm is not None:
+        assert not is_cpu, "min_blocks_per_sm is only supported by GPU kernels"
+        if min_blocks_per_sm == "auto":
+            # resolved by ResolveMinBlocksPerSM once the kernel is lowered
+            min_blocks_per_sm = 0
+        else:
+            assert isinstance(min_blocks_per_sm, int) and min_blocks_per_sm > 0, (
+                f'min_blocks_per_sm must be a positive integer or "auto", got {min_blocks_per_sm!r}'
+            )
+        attrs["pragma_min_blocks_per_sm"] = min_blocks_per_sm
+
     return _ffi_api.KernelLaunch(blocks, threads, attrs)
 
 
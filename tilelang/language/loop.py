@@ -7,6 +7,8 @@ from tvm.tir import IntImm
 import tvm.script.ir_builder.tir as tb_tir
 from .eager.builder import SerialForWithStep, UnrollForWithStep
 from tilelang import _ffi_api
+from .allocate import alloc_shared
+from .kernel import get_thread_binding
 from tvm.script.ir_builder.tir import frame
 
 
@@ -94,10 +96,109 @@ def Persistent(
     return _ffi_api.Persistent(domain, wave_size, index, group_size)
 
 
+def StreamK(
+    num_tiles: tir.PrimExpr,
+    iters_per_tile: tir.PrimExpr,
+    num_programs: tir.PrimExpr,
+    pid: tir.PrimExpr,
+):
+    """Tools to construct a stream-K work loop.
+
+    The ``num_tiles * iters_per_tile`` reduction iterations of a tiled problem
+    (e.g. the output tiles and K blocks of a GEMM) are split evenly across
+    ``num_programs`` persistent programs, so the last wave no longer leaves
+    SMs idle. Program ``pid`` visits every tile its share touches.
+
+    Parameters
+    ----------
+    num_tiles : tir.PrimExpr
+        The number of output tiles.
+    iters_per_tile : tir.PrimExpr
+        The number of reduction iterations per tile (e.g. ``ceildiv(K, block_K)``).
+    num_programs : tir.PrimExpr
+        The number of persistent programs, usually the number of SMs.
+    pid : tir.PrimExpr
+        The index of the current program.
+
+    Returns
+    -------
+    res : frame.ForFrame
+        The ForFrame binding ``(tile_id, k_begin, k_end)``: the tile and the
+        half-open range of its reduction iterations owned by this program. Use
+        ``T.streamk_store`` to write back the partial result.
+    """
+    return _ffi_api.StreamK(num_tiles, iters_per_tile, num_programs, pid)
+
+
+def TileQueue(
+    num_tiles: tir.PrimExpr,
+    counter: tir.Buffer,
+):
+    """Tools to construct a dynamic persistent tile loop.
+
+    Launch the kernel with about one CTA per SM; every CTA then keeps pulling
+    tile indices from ``counter`` with an atomic add until all ``num_tiles``
+    tiles are claimed. Compared with ``T.Persistent`` the assignment is
+    dynamic, so CTAs that finish early take over the remaining tiles.
+
+    Parameters
+    ----------
+    num_tiles : tir.PrimExpr
+        The number of tiles to process.
+    counter : tir.Buffer
+        A global int32 buffer whose first element is the work counter. It
+        must be zero when the kernel starts, e.g. ``torch.zeros(1, dtype=torch.int32)``.
+
+    Returns
+    -------
+    res : frame.ForFrame
+        The ForFrame binding the claimed ``tile_id``.
+    """
+    slot = alloc_shared((1,), counter.dtype)
+    return _ffi_api.TileQueue(num_tiles, counter, slot, get_thread_binding())
+
+
+def VarlenTiles(
+    cu_tiles: tir.Buffer,
+    num_programs: tir.PrimExpr,
+    pid: tir.PrimExpr,
+):
+    """Tools to construct a persistent loop over the tiles of a ragged batch.
+
+    Sequences of different lengths are packed along one dimension, sequence
+    ``b`` covering ``cu_seqlens[b]:cu_seqlens[b + 1]``. Instead of launching
+    every sequence with the tiles of the longest one, the tiles of the real
+    tokens are numbered in sequence order and strided across ``num_programs``
+    persistent programs, so every program gets the same share of work
+    whatever the lengths. Program ``pid`` recovers the sequence of a tile by
+    a binary search of ``cu_tiles``.
+
+    Parameters
+    ----------
+    cu_tiles : tir.Buffer
+        A global int32 buffer of shape ``(batch + 1,)`` holding the number of
+        tiles of the sequences before each sequence, e.g. built on the device
+        from ``cu_seqlens`` with ``tilelang.utils.varlen.cu_seqlens_to_cu_tiles``.
+    num_programs : tir.PrimExpr
+        The number of persistent programs, usually the number of SMs.
+    pid : tir.PrimExpr
+        The index of the current program.
+
+    Returns
+    -------
+    res : frame.ForFrame
+        The ForFrame binding ``(seq_id, tile_id)``: the sequence and the index
+        of the tile inside it. The last tile of a sequence may be partial,
+        rows past ``cu_seqlens[seq_id + 1]`` belong to the next sequence and
+        must be masked by the body.
+    """
+    return _ffi_api.VarlenTiles(cu_tiles, num_programs, pid)
+
+
 def Pipelined(
     start: tir.PrimExpr,
     stop: tir.PrimExpr = None,
-    num_stages: int = 0,
+    num_stages: int | str = 0,
     order: list[int] | None = None,
     stage: list[int] | None = None,
     sync: list[list[int]] | None = None,
@@ -111,9 +212,11 @@ def Pipelined(
         The minimum value of iteration.
     stop : PrimExpr
         The maximum value of iteration.
-    num_stages : int
+    num_stages : int | str
         The max number of buffer used between pipeline producers and consumers.
-        if num_stages is 0, pipeline will not be enabled.
+        if num_stages is 0, pipeline will not be enabled. ``"auto"`` selects
+        the deepest pipeline whose multi-buffered shared memory fits the
+        target, up to 4 stages with asynchronous copies and 2 without.
     Returns
     -------
     res : frame.ForFrame
@@ -130,6 +233,10 @@ def Pipelined(
         sync = []
     if group is None:
         group = []
+    if isinstance(num_stages, str):
+        if num_stages != "auto":
+            raise ValueError(f"num_stages must be an integer or 'auto', got {num_stages!r}")
+        num_stages = -1
     # type: ignore[attr-defined] # pylint: disable=no-member
     return _ffi_api.Pipelined(start, stop, num_stages, order, stage, sync, group)
 
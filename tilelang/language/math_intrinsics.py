@@ -1,6 +1,9 @@
 """Common math intrinsics exposed on the TileLang language surface."""
 
+from __future__ import annotations
+
 from tvm import tir
+from tvm.script.parser.tir import attr
 
 
 def _validate_rounding_mode(rounding_mode):
@@ -332,7 +335,33 @@ def ieee_fdiv(x, y, rounding_mode="rn"):
     return tir.call_intrin(x.dtype, tir.op.Op.get("tl.ieee_fdiv"), x, y, rounding_mode)
 
 
+def fastmath(ulp: int | None = None):
+    """Approximate ``T.exp2``, ``T.exp`` and ``T.tanh`` within a region.
+
+    Inside the region the calls are replaced by the approximations of the
+    special function unit (``ex2.approx``, ``tanh.approx``) whose maximum
+    error, in ulps of the result type, fits ``ulp``. Vectorized calls on
+    float16 and bfloat16 use the packed f16x2/bf16x2 forms, and halves may
+    be computed in float32 when that fits the budget better. Calls whose
+    approximations exceed the budget are kept exact. Only lowered on CUDA
+    (sm75+, sm90+ for bfloat16).
+
+    Args:
+        ulp: Error budget in ulps, any approximation when None, e.g. 2 for
+            exp2 in any type and tanh in halves, but not tanh in float32.
+
+    Example:
+        >>> with T.fastmath(ulp=2):
+        ...     for i, j in T.Parallel(block_M, block_N):
+        ...         scores[i, j] = T.exp2(scores[i, j] * scale - row_max[i])
+    """
+    if ulp is not None and ulp < 0:
+        raise ValueError(f"T.fastmath expects a non-negative ulp budget, got {ulp}")
+    return attr(None, "tl.fastmath_ulp", -1 if ulp is None else ulp)
+
+
 __all__ = [
+    "fastmath",  # noqa: F401
     "__log",  # noqa: F401
     "__log2",  # noqa: F401
     "__log10",  # noqa: F401
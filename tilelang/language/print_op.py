@@ -5,11 +5,12 @@ It includes functionality to print variables, print values in buffers, condition
 
 from tilelang.language.eager.builder import Builder
 from tvm import tir
-from typing import Any
+from typing import Any, Optional
 import tilelang.language as T
 from tilelang.language.kernel import get_thread_bindings
 from tilelang.language import copy, macro, serial, alloc_shared
 from tilelang.language.utils import index_to_coordinates
+from tilelang.language.device_log import device_log
 
 
 @macro
@@ -137,7 +138,9 @@ def device_assert(condition: tir.PrimExpr, msg: str = "", no_stack_info=False):
     """
     Device-side assert emulation.
     Emits a device-side assert call on CUDA targets when CUDA is available.
-    The assert is always enabled and cannot be disabled at runtime.
+    The assert cannot be disabled at runtime; the ``tl.device_assert_mode`` pass
+    config selects how it is compiled: per thread (the default), grouped per
+    warp with a single report for a failing warp, or not at all.
     """
     if _IS_CUDA_AVAILABLE:
         if no_stack_info:
@@ -150,7 +153,7 @@ def device_assert(condition: tir.PrimExpr, msg: str = "", no_stack_info=False):
             T.call_intrin("void", tir.op.Op.get("tl.device_assert_with_msg"), condition, get_stack_str(msg, stacklevel=2))
 
 
-def print(obj: Any, msg: str = "", warp_group_id: int = 0, warp_id: int = 0) -> tir.PrimExpr:
+def print(obj: Any, msg: str = "", warp_group_id: int = 0, warp_id: int = 0, log_buffer: Optional[tir.Buffer] = None) -> tir.PrimExpr:
     """
     A generic print function that handles both TIR buffers and primitive expressions.
 
@@ -163,6 +166,9 @@ def print(obj: Any, msg: str = "", warp_group_id: int = 0, warp_id: int = 0) ->
         warp_group_id (int): The warp group id to print.
         warp_id (int): The warp id to print.
         print thread will be warp_group_id * warp_group_size + warp_id.
+        log_buffer (tir.Buffer): Optional device log ring buffer. Primitive
+        expressions are then recorded with ``T.device_log`` instead of printf,
+        see ``tilelang.language.device_log``.
 
     Returns:
         tir.PrimExpr: The TIR expression for the debug print operation.
@@ -171,6 +177,7 @@ def print(obj: Any, msg: str = "", warp_group_id: int = 0, warp_id: int = 0) ->
         ValueError: If the input object type is unsupported.
     """
     if isinstance(obj, tir.Buffer):
+        assert log_buffer is None, "T.print only logs primitive expressions to a device log buffer"
         # Buffers must be printed in just one thread to avoid duplicate outputs.
         # Retrieve the thread bindings for thread x, y, and z.
         tx, ty, tz = get_thread_bindings()
@@ -224,6 +231,8 @@ def print(obj: Any, msg: str = "", warp_group_id: int = 0, warp_id: int = 0) ->
     elif isinstance(obj, tir.PrimExpr):
         if not msg:
             msg = f"expr<{obj}>"
+        if log_buffer is not None:
+            return device_log(msg, log_buffer, obj)
         # Directly print primitive expressions.
         return print_var(obj, msg)
 
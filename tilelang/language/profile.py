@@ -0,0 +1,78 @@
+"""In-kernel profile regions recorded into a device ring buffer.
+
+``T.profile_begin(name, buffer)`` / ``T.profile_end(name, buffer)`` record the
+globaltimer and clock64 of the calling warp into ``buffer``, a 1-D int64 (or
+uint64) kernel argument of ``profile_buffer_shape(capacity)`` elements that the
+host zeroes before the launch. The records are decoded on the host by
+``tilelang.profiler.decode_profile_regions``. Regions are only lowered when
+``tl.enable_profile_region`` is set and compile to nothing otherwise.
+"""
+
+from __future__ import annotations
+
+from tvm import tir
+
+__all__ = [
+    "profile_begin",
+    "profile_end",
+    "profile_buffer_shape",
+    "profile_region_id",
+    "profile_region_name",
+]
+
+# Layout of the ring buffer, in 64-bit words: a header whose first word counts
+# the records ever written, followed by records of
+# {globaltimer, clock64, region | is_end << 32 | warp << 33 | smid << 48, block}.
+PROFILE_HEADER_WORDS = 4
+PROFILE_RECORD_WORDS = 4
+
+# Region names are interned process wide, so the ids of a kernel stay valid
+# for the host side decoding of its buffer.
+_REGION_NAMES: list[str] = []
+
+
+def profile_region_id(name: str) -> int:
+    """Returns the id recorded on device for the region ``name``."""
+    if name not in _REGION_NAMES:
+        _REGION_NAMES.append(name)
+    return _REGION_NAMES.index(name)
+
+
+def profile_region_name(region_id: int) -> str:
+    """Returns the name of the region recorded as ``region_id``."""
+    if 0 <= region_id < len(_REGION_NAMES):
+        return _REGION_NAMES[region_id]
+    return f"region_{region_id}"
+
+
+def profile_buffer_shape(capacity: int) -> tuple[int]:
+    """Shape of a profile ring buffer holding ``capacity`` records."""
+    return (PROFILE_HEADER_WORDS + PROFILE_RECORD_WORDS * capacity,)
+
+
+def _profile_record(op_name: str, name: str, buffer: tir.Buffer):
+    assert isinstance(buffer, tir.Buffer), f"profile buffer must be a buffer, got {type(buffer)}"
+    assert len(buffer.shape) == 1 and buffer.dtype in ("int64", "uint64"), (
+        f"profile buffer must be a 1-D int64/uint64 buffer, got {buffer.dtype}{list(buffer.shape)}"
+    )
+    capacity = (buffer.shape[0] - PROFILE_HEADER_WORDS) // PROFILE_RECORD_WORDS
+    return tir.call_intrin(
+        "void",
+        tir.op.Op.get(op_name),
+        buffer.access_ptr("rw"),
+        capacity,
+        profile_region_id(name),
+    )
+
+
+def profile_begin(name: str, buffer: tir.Buffer):
+    """Marks the start of the profile region ``name`` for the calling warp.
+
+    Must be called uniformly by all threads of a warp; lane 0 writes the record.
+    """
+    return _profile_record("tl.profile_begin", name, buffer)
+
+
+def profile_end(name: str, buffer: tir.Buffer):
+    """Marks the end of the profile region ``name`` for the calling warp."""
+    return _profile_record("tl.profile_end", name, buffer)
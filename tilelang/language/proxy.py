@@ -167,6 +167,21 @@ class StridedTensorProxy(BaseTensorProxy):
         return super().__call__(shape, dtype=dtype, strides=strides, scope=scope)
 
 
+class WorkspaceProxy(TensorProxy):
+    """Proxy class for the scratch global buffers of a kernel.
+
+    A workspace parameter is not passed by the caller: the kernel adapter serves
+    it from a pool of device memory kept per device and stream, and zeroes it
+    before the call when ``zero_init`` is set. Use it for split-K partials,
+    semaphores and other scratch memory only the kernel reads.
+    """
+
+    def __call__(self, shape: tuple[Any] | PrimExpr | int, dtype: str = "float32", zero_init: bool = False) -> tir.Buffer:
+        buf = super().__call__(shape, dtype=dtype)
+        buf._workspace_zero_init = bool(zero_init)
+        return buf
+
+
 class FragmentBufferProxy(BaseTensorProxy):
     """Proxy class for fragment memory buffers.
 
@@ -234,6 +249,9 @@ if TYPE_CHECKING:
 
     class StridedTensor(BaseTensor): ...
 
+    class Workspace(BaseTensor):
+        def __init__(self, shape: Sequence[SupportsIndex], dtype="float32", zero_init: bool = False): ...
+
     class FragmentBuffer(BaseTensor): ...
 
     class SharedBuffer(BaseTensor): ...
@@ -246,6 +264,7 @@ if TYPE_CHECKING:
 else:
     Tensor = TensorProxy()  # pylint: disable=invalid-name
     StridedTensor = StridedTensorProxy()  # pylint: disable=invalid-name
+    Workspace = WorkspaceProxy()  # pylint: disable=invalid-name
     FragmentBuffer = FragmentBufferProxy()  # pylint: disable=invalid-name
     SharedBuffer = SharedBufferProxy()  # pylint: disable=invalid-name
     LocalBuffer = LocalBufferProxy()  # pylint: disable=invalid-name
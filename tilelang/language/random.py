@@ -66,3 +66,46 @@ def rng_rand_float(bit=32, dist="uniform"):
     assert bit in [32, 64]
     assert dist in ["uniform", "normal"]
     return tir.call_intrin("float" + str(bit), tir.op.Op.get("tl.rng_rand_float"), dist)
+
+
+def philox_rand(seed, offset, index):
+    """Generate the stateless 32-bit unsigned random integer of an element
+
+    Unlike ``rng_rand``, no per-thread generator state is kept: the number is
+    a pure function of the key ``seed`` and the counter ``(index // 4,
+    offset)`` of Philox4x32-10, laid out as in curand's Philox. Any thread can
+    redraw the number of any element, e.g. the dropout mask of an attention
+    score in the backward pass, and the four elements of an aligned block of
+    indices vectorize into a single Philox call.
+
+    Parameters
+    ----------
+    seed : PrimExpr
+        Key of the generator, up to 64 bits.
+    offset : PrimExpr
+        Skip-ahead of the stream, up to 64 bits, e.g. the number of values a
+        previous launch with the same seed drew per element.
+    index : PrimExpr
+        Integer index of the element.
+
+    Returns
+    -------
+    random_value : PrimExpr
+        A 32-bit unsigned random integer.
+    """
+    index = tir.convert(index)
+    assert str(index.dtype).startswith(("int", "uint")), f"index must be an integer, got {index.dtype}"
+    seed = tir.Cast("uint64", tir.convert(seed))
+    offset = tir.Cast("uint64", tir.convert(offset))
+    return tir.call_intrin("uint32", tir.op.Op.get("tl.philox_rand"), seed, offset, index)
+
+
+def philox_rand_float(seed, offset, index):
+    """Generate the stateless uniform float32 of an element in (0, 1)
+
+    The top 24 bits of ``philox_rand(seed, offset, index)`` mapped to the
+    centers of 2**24 equal bins, so that neither 0 nor 1 is drawn, e.g. for
+    ``-log(u)`` in sampling.
+    """
+    bits = philox_rand(seed, offset, index) >> tir.const(8, "uint32")
+    return (tir.Cast("float32", bits) + tir.const(0.5, "float32")) * tir.const(2.0**-24, "float32")
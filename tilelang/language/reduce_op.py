@@ -288,6 +288,9 @@ def cumsum(
     dst: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None = None,
     dim: int = 0,
     reverse: bool = False,
+    reset: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None = None,
+    scan_state: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None = None,
+    tile_id: tir.PrimExpr | int | None = None,
 ):
     """
     Compute the cumulative sum of `src` along `dim`, writing results to `dst`.
@@ -296,6 +299,19 @@ def cumsum(
 
     Supports Buffer, BufferRegion, and BufferLoad inputs, allowing operations on buffer slices/regions.
 
+    Shared-memory scans can also be segmented and device-wide (CUDA):
+
+    - `reset`: integer shared buffer shaped as `src`; a nonzero flag restarts the
+      scan at its element, e.g. at the first token of every sequence.
+    - `scan_state` and `tile_id`: the tile is tile `tile_id` of sequences split
+      over CTAs and continues the scan of tiles 0..tile_id-1 in the same launch,
+      through decoupled look-back. `scan_state` is a global int64 buffer of
+      shape (num_tiles, lanes), zeroed before every launch, with `lanes` the
+      number of sequences of the tile (1 for 1D tiles, the extent of the other
+      dimension for 2D ones). A CTA waits on the tiles of lower id, so ids must
+      follow the order the CTAs start in, e.g. `bx`; for `reverse` scans count
+      the tiles from the end of the sequences. Values must be 32-bit.
+
     Examples:
         A 1D inclusive scan that writes the result into a separate shared-memory buffer:
 
@@ -328,6 +344,16 @@ def cumsum(
         ...         i = T.int32(0)
         ...         T.cumsum(InputG_fragment[i * chunk_size:(i + 1) * chunk_size], dim=0)
 
+        A device-wide scan of a long vector, one 1024-element tile per CTA:
+
+        >>> @T.prim_func
+        ... def scan(A: T.Tensor((N,), "float32"), B: T.Tensor((N,), "float32"), State: T.Tensor((N // 1024, 1), "int64")):
+        ...     with T.Kernel(N // 1024, threads=128) as bx:
+        ...         tile = T.alloc_shared((1024,), "float32")
+        ...         T.copy(A[bx * 1024], tile)
+        ...         T.cumsum(tile, scan_state=State, tile_id=bx)
+        ...         T.copy(tile, B[bx * 1024])
+
     Returns:
         tir.Call: A handle to the emitted cumulative-sum operation.
     """
@@ -351,20 +377,30 @@ def cumsum(
             if not tir.analysis.expr_deep_equal(dst_shape[i], shape[i]):
                 raise ValueError(f"cumsum dst shape {dst_shape} must match src shape {shape} (dim {i} mismatch)")
 
+    if (scan_state is None) != (tile_id is None):
+        raise ValueError("cumsum takes scan_state and tile_id together for device-wide scans")
+    segmented = reset is not None or scan_state is not None
     # Check if src is a fragment buffer
     if is_fragment(src):
+        if segmented:
+            raise ValueError("Segmented and device-wide cumsum require shared memory tiles, got a fragment")
         return cumsum_fragment(src, dst, dim, reverse)
-    return tir.call_intrin(
-        "handle",
-        tir.op.Op.get("tl.tileop.cumsum"),
+    args = [
         to_buffer_region(src, access_type="r"),
         to_buffer_region(dst, access_type="w"),
         dim,
         reverse,
-    )
+    ]
+    if segmented:
+        args += [tile_id if tile_id is not None else 0, scan_state is not None, reset is not None]
+        if scan_state is not None:
+            args.append(to_buffer_region(scan_state, access_type="rw"))
+        if reset is not None:
+            args.append(to_buffer_region(reset, access_type="r", extents=shape if isinstance(reset, tir.BufferLoad) else None))
+    return tir.call_intrin("handle", tir.op.Op.get("tl.tileop.cumsum"), *args)
 
 
-def finalize_reducer(reducer: tir.Buffer):
+def finalize_reducer(reducer: tir.Buffer, index: tir.Buffer = None, cluster: bool = False):
     """
     Finalize a reducer buffer by emitting the `tl.tileop.finalize_reducer` intrinsic.
 
@@ -373,14 +409,340 @@ def finalize_reducer(reducer: tir.Buffer):
 
     Parameters:
         reducer (tir.Buffer): Reducer buffer whose writable pointer will be finalized.
+        index (tir.Buffer): The index reducer paired with an argmax or argmin reducer by `alloc_reducer`,
+            which holds the smallest index of the reduced value afterwards. Required for, and only for, those.
+        cluster (bool): Also combine the results of all thread blocks of the cluster
+            (see `cluster_allreduce`), so that every block holds the cluster-wide result.
 
     Returns:
         tir.Call: Handle to the finalize reducer intrinsic call.
     """
+    args = [to_buffer_region(reducer, access_type="w")]
+    if index is not None:
+        args.append(to_buffer_region(index, access_type="w"))
     return tir.call_intrin(
         "handle",
         tir.op.Op.get("tl.tileop.finalize_reducer"),
-        to_buffer_region(reducer, access_type="w"),
+        *args,
+        annotations={"cluster": 1} if cluster else None,
+    )
+
+
+def cluster_allreduce(buffer: tir.Buffer, reduce_type: str = "sum"):
+    """Reduce a fragment element-wise across the thread blocks of a cluster.
+
+    Every element of `buffer` is replaced by the reduction of that element over
+    all thread blocks of the cluster, which exchange their partials through
+    distributed shared memory. This merges split-K or split-KV partial results
+    without a global memory round trip. The kernel must be launched with
+    `T.Kernel(..., cluster_dims=...)` on sm_90 or newer, and every thread of
+    every block of the cluster must execute the call.
+
+    Args:
+        buffer (tir.Buffer): Fragment or local buffer, reduced in place.
+        reduce_type (str): One of "sum", "max", "min", "bitand", "bitor", "bitxor".
+
+    Returns:
+        tir.Call: Handle to the cluster all-reduce intrinsic call.
+    """
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.cluster_allreduce"),
+        to_buffer_region(buffer, access_type="rw"),
+        reduce_type,
+    )
+
+
+
+def topk(
+    src: tir.Buffer | tir.BufferRegion | tir.BufferLoad,
+    out_vals: tir.Buffer | tir.BufferRegion | tir.BufferLoad,
+    out_idx: tir.Buffer | tir.BufferRegion | tir.BufferLoad,
+    k: int,
+    largest: bool = True,
+):
+    """Select the `k` largest (or smallest) elements of every row of a fragment.
+
+    Row `i` of `src` is reduced along its last dimension; the selected values are
+    written to row `i` of `out_vals` and their columns to row `i` of `out_idx`.
+    For k <= 32 this lowers to a bitonic merge of per-thread lists across the
+    threads sharing the row and the rows come out sorted, ties going to the lower
+    column. Larger k use a radix select over the row and the rows come out in no
+    particular order. Fragment outputs are staged through shared memory.
+
+    Args:
+        src: Fragment of shape (..., N) to select from.
+        out_vals: Buffer of shape (..., k) with the dtype of `src`.
+        out_idx: int32 buffer of shape (..., k).
+        k (int): Number of elements selected per row, 1 <= k <= N.
+        largest (bool): Select the largest elements, otherwise the smallest.
+
+    Returns:
+        tir.Call: Handle to the top-k intrinsic call.
+
+    Example:
+        >>> scores = T.alloc_fragment((block_M, num_experts), T.float32)
+        >>> T.copy(Logits[bx * block_M, 0], scores)
+        >>> T.topk(scores, TopVals[bx * block_M : (bx + 1) * block_M, :], TopIdx[bx * block_M : (bx + 1) * block_M, :], k=8)
+    """
+    if not is_fragment(src):
+        raise ValueError(f"T.topk expects a fragment source, got {_get_buffer(src).scope()}")
+    shape = retrieve_shape(src)
+    for out in (out_vals, out_idx):
+        out_shape = retrieve_shape(out)
+        if len(out_shape) != len(shape):
+            raise ValueError(f"T.topk output shape {out_shape} must have the rank of {shape}")
+
+    @macro
+    def topk_macro(src, out_vals, out_idx, k: int, largest: bool):
+        if is_fragment(out_vals) or is_fragment(out_idx):
+            vals_smem = alloc_shared(retrieve_shape(out_vals), _get_buffer(out_vals).dtype, "shared.dyn")
+            idx_smem = alloc_shared(retrieve_shape(out_idx), _get_buffer(out_idx).dtype, "shared.dyn")
+            tir.call_intrin(
+                "handle",
+                tir.op.Op.get("tl.tileop.topk"),
+                to_buffer_region(src, access_type="r"),
+                to_buffer_region(vals_smem, access_type="w"),
+                to_buffer_region(idx_smem, access_type="w"),
+                k,
+                largest,
+            )
+            copy(vals_smem, out_vals)
+            copy(idx_smem, out_idx)
+        else:
+            tir.call_intrin(
+                "handle",
+                tir.op.Op.get("tl.tileop.topk"),
+                to_buffer_region(src, access_type="r"),
+                to_buffer_region(out_vals, access_type="w"),
+                to_buffer_region(out_idx, access_type="w"),
+                k,
+                largest,
+            )
+
+    return topk_macro(src, out_vals, out_idx, k, largest)
+
+
+def online_softmax(
+    scores: tir.Buffer | tir.BufferRegion,
+    scores_max: tir.Buffer | tir.BufferRegion,
+    scores_sum: tir.Buffer | tir.BufferRegion,
+    acc: tir.Buffer | tir.BufferRegion | list | tuple | None = None,
+    scale: float = 1.0,
+):
+    """Fold a block of scores into the running statistics of an online softmax.
+
+    For every row ``i``, with ``m = scores_max[i]`` and ``s = scale``::
+
+        m' = max(m, max_j scores[i, j])
+        scores[i, j] = exp2(scores[i, j] * s - m' * s)
+        scores_sum[i] = scores_sum[i] * exp2(m * s - m' * s) + sum_j scores[i, j]
+        acc[i, :] *= exp2(m * s - m' * s)
+        scores_max[i] = m'
+
+    This is the update flash attention applies per block of keys, with ``s`` the
+    softmax scale times log2(e). The maximum and the sum of a row are gathered
+    in one pass over the fragment and merged across the threads of the row in a
+    single exchange. Rows whose scores are all -inf get zero weights.
+
+    Args:
+        scores: (M, N) float32 fragment, e.g. the C fragment of ``Q @ K^T``;
+            rewritten in place to the (unnormalized) weights.
+        scores_max: (M,) float32 fragment with the running row maximum, -inf
+            before the first block.
+        scores_sum: (M,) float32 fragment with the running row sum, 0 before the
+            first block.
+        acc: (M, D) fragment or list of fragments rescaled in place, e.g. the
+            output accumulator. Their rows must be held by the threads holding
+            the rows of ``scores``, as with GEMMs of the same warp policy.
+        scale (float): Positive factor applied to the scores before exp2.
+
+    Returns:
+        tir.Call: Handle to the online softmax intrinsic call.
+
+    Example:
+        >>> T.gemm(Q_shared, K_shared, acc_s, transpose_B=True)
+        >>> T.online_softmax(acc_s, scores_max, logsum, acc_o, scale=sm_scale * 1.44269504)
+        >>> T.copy(acc_s, acc_s_cast)
+        >>> T.gemm(acc_s_cast, V_shared, acc_o)
+    """
+    if acc is None:
+        accs = []
+    elif isinstance(acc, (list, tuple)):
+        accs = list(acc)
+    else:
+        accs = [acc]
+    for buf in [scores, scores_max, scores_sum, *accs]:
+        if not is_fragment(buf):
+            raise ValueError(f"T.online_softmax expects fragments, got {_get_buffer(buf).scope()}")
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.online_softmax"),
+        to_buffer_region(scores, access_type="rw"),
+        to_buffer_region(scores_max, access_type="rw"),
+        to_buffer_region(scores_sum, access_type="rw"),
+        tir.const(scale, "float32") if isinstance(scale, (int, float)) else scale,
+        *[to_buffer_region(a, access_type="rw") for a in accs],
+    )
+
+_NORM_TYPES = {"rms": 0, "layer": 1}
+
+
+def norm(
+    x: tir.Buffer | tir.BufferRegion,
+    out: tir.Buffer | tir.BufferRegion | tir.BufferLoad,
+    weight: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None = None,
+    bias: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None = None,
+    residual: tir.Buffer | tir.BufferRegion | tir.BufferLoad | None = None,
+    eps: float = 1e-6,
+    norm_type: str = "rms",
+    out_scale: float | tir.PrimExpr | None = None,
+):
+    """Normalize the rows of a fragment, optionally fused with a residual add.
+
+    For every row ``i`` of ``x`` (after ``x += residual`` when given)::
+
+        rms:   y = x[i, :] * rsqrt(mean(x[i, :] ** 2) + eps)
+        layer: y = (x[i, :] - mean(x[i, :])) * rsqrt(var(x[i, :]) + eps)
+        out[i, :] = cast((y * weight + bias) * out_scale)
+
+    Both statistics of a row are gathered in one pass over the fragment; the
+    LayerNorm mean and variance come from Welford updates and are merged across
+    the threads of the row in a single exchange. ``x`` keeps the sum with the
+    residual, to be written back as the next residual. Casts to float8 outputs
+    saturate, so ``out_scale`` can quantize the rows. Unless another operator
+    fixed its layout, ``x`` is laid out so that the accesses to ``out`` and
+    ``residual`` are vectorized, and so is the copy filling it.
+
+    Args:
+        x: (M, N) floating point fragment; statistics are kept in float32.
+        out: (M, N) destination in any scope, e.g. ``Y[bx * block_M, 0]``, or
+            ``x`` itself.
+        weight: Optional (N,) scale in shared or global memory.
+        bias: Optional (N,) shift in shared or global memory.
+        residual: Optional (M, N) shared or global region added to ``x``.
+        eps (float): Added to the variance before rsqrt.
+        norm_type (str): "rms" or "layer".
+        out_scale: Optional factor applied before casting to the dtype of ``out``.
+
+    Returns:
+        tir.Call: Handle to the normalization intrinsic call.
+
+    Example:
+        >>> T.copy(X[bx * block_M, 0], x)
+        >>> T.norm(x, Y_fp8[bx * block_M, 0], weight=W, residual=R[bx * block_M, 0], out_scale=1.0 / s)
+        >>> T.copy(x, R[bx * block_M, 0])
+    """
+    if norm_type not in _NORM_TYPES:
+        raise ValueError(f"T.norm expects norm_type in {list(_NORM_TYPES)}, got {norm_type}")
+    if not is_fragment(x):
+        raise ValueError(f"T.norm expects a fragment, got {_get_buffer(x).scope()}")
+    x_shape = retrieve_shape(x)
+    if len(x_shape) != 2:
+        raise ValueError(f"T.norm expects an (M, N) fragment, got shape {x_shape}")
+
+    def extent_region(src, shape, access_type):
+        # Loads such as Y[bx * block_M, 0] denote a region of the given shape.
+        extents = list(shape) if isinstance(src, tir.BufferLoad) else None
+        return to_buffer_region(src, access_type=access_type, extents=extents)
+
+    optional = [
+        extent_region(buf, shape, "r")
+        for buf, shape in ((weight, x_shape[1:]), (bias, x_shape[1:]), (residual, x_shape))
+        if buf is not None
+    ]
+    if out_scale is None:
+        out_scale = 1.0
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.norm"),
+        to_buffer_region(x, access_type="rw"),
+        extent_region(out, x_shape, "w"),
+        _NORM_TYPES[norm_type],
+        tir.const(eps, "float32") if isinstance(eps, (int, float)) else eps,
+        tir.const(out_scale, "float32") if isinstance(out_scale, (int, float)) else out_scale,
+        weight is not None,
+        bias is not None,
+        residual is not None,
+        *optional,
+    )
+
+
+_QUANT_GRANULARITIES = {"token": 0, "block": 1, "tensor": 2}
+
+
+def quantize(
+    src: tir.Buffer | tir.BufferRegion,
+    dst: tir.Buffer | tir.BufferRegion | tir.BufferLoad,
+    scale_out: tir.Buffer | tir.BufferRegion | tir.BufferLoad,
+    granularity: str = "token",
+    stochastic_rounding: bool = False,
+):
+    """Quantize a fragment with scales derived from its absolute maxima.
+
+    The elements of ``src`` sharing a scale form a group: a row for
+    ``"token"``, ``G`` consecutive elements of a row for ``"blockG"`` (e.g.
+    ``"block128"``) or the whole fragment for ``"tensor"``. For every group::
+
+        amax = max(max(abs(src[group])), 1e-4)
+        dst[group] = cast(clamp(src[group] * max(dst.dtype) / amax))
+        scale_out[group] = amax / max(dst.dtype)
+
+    so that ``dst * scale_out`` dequantizes. The group maxima are merged
+    across threads by warp shuffles (shared memory past a warp), and the fp32
+    to float8 casts of consecutive elements use packed saturating conversions.
+    Applied to a GEMM accumulator, this fuses the quantization of the next
+    layer's activations into the epilogue.
+
+    Args:
+        src: (M, N) floating point fragment, e.g. a GEMM accumulator.
+        dst: (M, N) float8 or int8 destination in any scope, e.g. ``Y[bx * block_M, 0]``.
+        scale_out: float32 scales, (M,) for ``"token"``, (M, N // G) for ``"blockG"``
+            and (1,) for ``"tensor"``, in shared or global memory, or in a fragment
+            for ``"token"``. ``"tensor"`` reduces over the fragment of the block.
+        granularity (str): ``"token"``, ``"blockG"`` or ``"tensor"``.
+        stochastic_rounding (bool): Round stochastically with ``T.rng_rand``, which
+            needs a ``T.rng_init`` earlier in the kernel.
+
+    Returns:
+        tir.Call: Handle to the quantization intrinsic call.
+
+    Example:
+        >>> T.gemm(A_shared, B_shared, C_local)
+        >>> T.quantize(C_local, Y_fp8[by * block_M, bx * block_N], Y_s[by * block_M, bx * (block_N // 128)], granularity="block128")
+    """
+    group_size = 0
+    if granularity.startswith("block") and granularity[5:].isdigit():
+        group_size = int(granularity[5:])
+        granularity = "block"
+    if granularity not in _QUANT_GRANULARITIES or (granularity == "block" and group_size <= 0):
+        raise ValueError(f'T.quantize expects granularity "token", "blockG" or "tensor", got {granularity}')
+    if not is_fragment(src):
+        raise ValueError(f"T.quantize expects a fragment, got {_get_buffer(src).scope()}")
+    src_shape = retrieve_shape(src)
+    if len(src_shape) != 2:
+        raise ValueError(f"T.quantize expects an (M, N) fragment, got shape {src_shape}")
+    if granularity == "token":
+        scale_shape = src_shape[:1]
+    elif granularity == "block":
+        scale_shape = [src_shape[0], src_shape[1] // group_size]
+    else:
+        scale_shape = [1]
+
+    def extent_region(buf, shape, access_type):
+        # Loads such as Y[bx * block_M, 0] denote a region of the given shape.
+        extents = list(shape) if isinstance(buf, tir.BufferLoad) else None
+        return to_buffer_region(buf, access_type=access_type, extents=extents)
+
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.quantize"),
+        to_buffer_region(src, access_type="r"),
+        extent_region(dst, src_shape, "w"),
+        extent_region(scale_out, scale_shape, "w"),
+        _QUANT_GRANULARITIES[granularity],
+        group_size,
+        stochastic_rounding,
     )
 
 
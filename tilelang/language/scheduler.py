@@ -0,0 +1,90 @@
+"""Helpers for tile schedulers that split the reduction of a tile across programs, such as ``T.StreamK`` and split-K."""
+
+from tvm import tir
+from tilelang.language import copy, macro
+from tilelang.language.allocate import alloc_shared
+from tilelang.language.atomic import atomic_add, atomic_store
+from tilelang.language.builtin import sync_threads
+from tilelang.language.fill_op import clear
+from tilelang.language.kernel import get_thread_binding
+from tilelang.language.loop import Parallel, serial
+
+
+@macro
+def streamk_store(
+    src: tir.Buffer,
+    dst: tir.BufferLoad,
+    k_begin: tir.PrimExpr,
+    k_end: tir.PrimExpr,
+    iters_per_tile: tir.PrimExpr,
+):
+    """Write back the accumulator of one ``T.StreamK`` work unit.
+
+    A program that owns every reduction iteration of the tile stores it
+    directly; otherwise several programs contribute to the tile and their
+    partial sums are reduced with atomic adds. ``dst`` must therefore be
+    zero-initialized before the kernel runs whenever a tile can be split.
+
+    Parameters:
+        src (tir.Buffer): The accumulator fragment of the tile.
+        dst (tir.BufferLoad): The origin of the tile in the global output.
+        k_begin (tir.PrimExpr): First reduction iteration owned by this program.
+        k_end (tir.PrimExpr): End of the owned reduction iterations.
+        iters_per_tile (tir.PrimExpr): Number of reduction iterations per tile.
+    """
+    if k_begin == 0 and k_end == iters_per_tile:
+        copy(src, dst)
+    else:
+        atomic_add(dst, src)
+
+
+@macro
+def splitk_store(
+    src: tir.Buffer,
+    dst: tir.BufferLoad,
+    split_idx: tir.PrimExpr,
+    split_k: int,
+    workspace: tir.Buffer = None,
+    semaphore: tir.BufferLoad = None,
+):
+    """Write back the accumulator of one split of a split-K tile.
+
+    Without a workspace the splits reduce their partial sums into ``dst`` with
+    atomic adds, so ``dst`` must be zero-initialized and the rounding of the
+    result depends on the order the splits finish in.
+
+    With ``workspace`` and ``semaphore`` the reduction is deterministic, in
+    the same kernel: each split stores its partial tile at ``split_idx`` in
+    ``workspace`` and draws a ticket from the ``semaphore`` counter of the
+    tile. The split drawing the last ticket sums the partial tiles in split
+    order, writes the tile and resets the counter, so the counters only have
+    to be zero-initialized once. ``src`` holds the sum afterwards.
+
+    Parameters:
+        src (tir.Buffer): The 2D accumulator fragment of the tile.
+        dst (tir.BufferLoad): The origin of the tile in the global output.
+        split_idx (tir.PrimExpr): Index of this split of the reduction.
+        split_k (int): Number of splits of the reduction.
+        workspace (tir.Buffer): Partial tiles, of the accumulator type and of
+            shape ``(split_k, *dst.buffer.shape)``.
+        semaphore (tir.BufferLoad): The int32 arrival counter of the tile.
+    """
+    if workspace is None:
+        atomic_add(dst, src)
+    else:
+        ticket = alloc_shared((1,), "int32")
+        copy(src, workspace[split_idx, dst.indices[0], dst.indices[1]])
+        sync_threads()
+        if get_thread_binding() == 0:
+            # releases the partial tile stored by the block, and acquires the
+            # ones of the splits that arrived before
+            ticket[0] = atomic_add(semaphore, 1, memory_order="acq_rel", return_prev=True)
+        sync_threads()
+        if ticket[0] == split_k - 1:
+            clear(src)
+            for s in serial(split_k):
+                for i, j in Parallel(src.shape[0], src.shape[1]):
+                    src[i, j] += workspace[s, dst.indices[0] + i, dst.indices[1] + j]
+            copy(src, dst)
+            if get_thread_binding() == 0:
+                atomic_store(semaphore, 0, memory_order="relaxed")
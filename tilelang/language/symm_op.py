@@ -0,0 +1,134 @@
+"""Communication between the ranks of a node through symmetric tensors.
+
+The operators address the tensor of a peer through the symmetric tensor of
+the current rank, allocated by ``tilelang.jit.adapter.SymmetricHeap`` at the
+same offset on every rank, so kernels take plain tensors and run with every
+execution backend.
+"""
+
+from __future__ import annotations
+from typing import Literal
+from tvm import tir
+from tilelang.utils.language import to_buffer_region, get_buffer_region_from_load, legalize_pairwise_extents
+
+_SIGNAL_OPS = {"set": 0, "add": 1}
+
+_SIGNAL_COMPARES = {"eq": 0, "ne": 1, "ge": 2, "gt": 3, "le": 4, "lt": 5}
+
+
+def _extent(data):
+    if isinstance(data, tir.Buffer):
+        return list(data.shape)
+    if isinstance(data, tir.BufferRegion):
+        return [r.extent for r in data.region]
+    if isinstance(data, tir.BufferLoad):
+        region = get_buffer_region_from_load(data)
+        return [r.extent for r in region.region] if region is not None else None
+    raise TypeError(f"Expected a buffer region, got {type(data)}")
+
+
+def _peer_copy(src, dst, peer, direction: int):
+    src_extent, dst_extent = _extent(src), _extent(dst)
+    assert src_extent or dst_extent, "Can't deduce copy extents from args"
+    src_extent = src_extent or [1] * len(dst_extent)
+    dst_extent = dst_extent or [1] * len(src_extent)
+    src_extent, dst_extent = legalize_pairwise_extents(src_extent, dst_extent)
+    return tir.call_intrin(
+        "handle",
+        tir.op.Op.get("tl.tileop.peer_copy"),
+        to_buffer_region(src, access_type="r", extents=src_extent),
+        to_buffer_region(dst, access_type="w", extents=dst_extent),
+        peer,
+        direction,
+    )
+
+
+def put(
+    src: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    dst: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    peer: int | tir.PrimExpr,
+):
+    """Copy a tile into the symmetric tensor of rank ``peer``.
+
+    Lowered as ``T.copy(src, dst)`` with ``dst`` standing for the same tensor
+    of ``peer``, written through its CUDA IPC mapping (without TMA). The
+    writes are ordered before a later ``T.signal`` of the block.
+
+    Args:
+        src: Tile in shared memory, fragments or global memory.
+        dst: Region of a global symmetric tensor, as seen on this rank.
+        peer: Rank of the node holding the written tensor.
+
+    Example:
+        >>> T.put(A_shared, Y[by * block_M, 0], peer)
+        >>> T.signal(flags[rank], 1, peer)
+    """
+    return _peer_copy(src, dst, peer, 0)
+
+
+def get(
+    src: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    dst: tir.Buffer | tir.BufferLoad | tir.BufferRegion,
+    peer: int | tir.PrimExpr,
+):
+    """Copy a tile out of the symmetric tensor of rank ``peer``.
+
+    Lowered as ``T.copy(src, dst)`` with ``src`` standing for the same tensor
+    of ``peer``, read through its CUDA IPC mapping (without TMA).
+
+    Args:
+        src: Region of a global symmetric tensor, as seen on this rank.
+        dst: Tile in shared memory, fragments or global memory.
+        peer: Rank of the node holding the read tensor.
+    """
+    return _peer_copy(src, dst, peer, 1)
+
+
+def signal(
+    sig: tir.BufferLoad,
+    value: int | tir.PrimExpr,
+    peer: int | tir.PrimExpr,
+    op: Literal["set", "add"] = "set",
+):
+    """Set or add to a signal of rank ``peer`` once the block is done.
+
+    The threads of the block synchronize first, then one of them updates
+    ``sig`` of ``peer`` with a release at system scope: the writes of the
+    block before the signal, e.g. by ``T.put``, are visible to the peer once
+    it observes the new value.
+
+    Args:
+        sig: Element of a uint64 symmetric tensor, as seen on this rank.
+        value: Value set or added.
+        peer: Rank whose signal is updated.
+        op (str): ``"set"`` or ``"add"``.
+    """
+    if op not in _SIGNAL_OPS:
+        raise ValueError(f"T.signal expects op in {list(_SIGNAL_OPS)}, got {op}")
+    if not isinstance(sig, tir.BufferLoad):
+        raise TypeError(f"T.signal expects an element of a signal tensor, got {type(sig)}")
+    return tir.call_intrin("handle", tir.op.Op.get("tl.tileop.signal"), sig, value, peer, _SIGNAL_OPS[op])
+
+
+def signal_wait(
+    sig: tir.BufferLoad,
+    value: int | tir.PrimExpr,
+    cmp: Literal["eq", "ne", "ge", "gt", "le", "lt"] = "ge",
+):
+    """Block until a local signal compares to ``value``.
+
+    One thread polls ``sig`` with acquires at system scope and the block
+    synchronizes after it, so the writes the peers ordered before their
+    signals are visible to all threads.
+
+    Args:
+        sig: Element of a uint64 symmetric tensor of this rank.
+        value: Value compared to.
+        cmp (str): ``sig cmp value`` ends the wait, one of ``"eq"``, ``"ne"``,
+            ``"ge"``, ``"gt"``, ``"le"`` and ``"lt"``.
+    """
+    if cmp not in _SIGNAL_COMPARES:
+        raise ValueError(f"T.signal_wait expects cmp in {list(_SIGNAL_COMPARES)}, got {cmp}")
+    if not isinstance(sig, tir.BufferLoad):
+        raise TypeError(f"T.signal_wait expects an element of a signal tensor, got {type(sig)}")
+    return tir.call_intrin("handle", tir.op.Op.get("tl.tileop.signal_wait"), sig, value, _SIGNAL_COMPARES[cmp])
@@ -1155,6 +1155,7 @@ def ptx_tcgen05_mma_ss(
     ws=None,
     warp_specialized=None,
     variant=None,
+    cta_group=1,
 ):
     """TVM intrinsic for tcgen05.mma shared-memory × shared-memory instructions.
 
@@ -1165,6 +1166,8 @@ def ptx_tcgen05_mma_ss(
     Alternatively, use `variant="ws"` (or "default").
     - kind_dtype: instruction kind selector (e.g., T.float16 for kind::f16,
       "tf32" for kind::tf32, "int8" for kind::i8, "float8_e4m3" for kind::f8f6f4).
+    - cta_group: 2 issues the cta_group::2 instruction of a cluster CTA pair,
+      which has no .ws variant and ignores the masks.
     """
     # Aliases precedence: if either `ws` or `warp_specialized` is provided, they override enable_ws
     if ws is not None:
@@ -1201,6 +1204,7 @@ def ptx_tcgen05_mma_ss(
         mask2,
         mask3,
         enable_ws,
+        annotations={"cta_group": cta_group} if cta_group != 1 else None,
     )
 
 
@@ -1226,6 +1230,8 @@ def ptx_tcgen05_mma_ts(
      desc_val, scale_out, mask0, mask1, mask2, mask3).
     - kind_dtype: instruction kind selector (e.g., T.float16 for kind::f16,
       "tf32" for kind::tf32, "int8" for kind::i8, "float8_e4m3" for kind::f8f6f4).
+    - cta_group: 2 issues the cta_group::2 instruction of a cluster CTA pair,
+      which has no .ws variant and ignores the masks.
     """
     return call_intrin(
         "handle",
@@ -1246,6 +1252,66 @@ def ptx_tcgen05_mma_ts(
     )
 
 
+def ptx_tcgen05_mma_blockscaled_ss(
+    kind,
+    scale_vec,
+    desc_a,
+    A_offset,
+    desc_b,
+    B_offset,
+    C_ptr,
+    C_offset,
+    SFA_ptr,
+    SFA_offset,
+    SFB_ptr,
+    SFB_offset,
+    desc_val,
+    scale_out,
+):
+    """TVM intrinsic for block scaled tcgen05.mma shared-memory × shared-memory instructions.
+
+    - kind: "mxf8f6f4" or "mxf4nvf4".
+    - scale_vec: number of scale factors per row of an MMA, 1 for MXFP8,
+      2 for MXFP4 and 4 for NVFP4.
+    - SFA_ptr/SFB_ptr: tensor memory buffers holding the scale factors of A and
+      B, SFA_offset/SFB_offset being column offsets into them.
+    """
+    return call_intrin(
+        "handle",
+        _tvm_op.Op.get("tl.ptx_tcgen05_mma_blockscaled_ss"),
+        kind,
+        scale_vec,
+        desc_a,
+        A_offset,
+        desc_b,
+        B_offset,
+        C_ptr,
+        C_offset,
+        SFA_ptr,
+        SFA_offset,
+        SFB_ptr,
+        SFB_offset,
+        desc_val,
+        scale_out,
+    )
+
+
+def ptx_tcgen05_cp(desc, desc_offset, tmem_ptr, tmem_offset):
+    """TVM intrinsic for tcgen05.cp.32x128b.warpx4, copying 32 rows of 16 bytes
+    described by the shared memory descriptor ``desc`` (plus ``desc_offset``
+    bytes) into 4 columns of tensor memory at column ``tmem_offset`` of
+    ``tmem_ptr``, replicated to the 4 sub-partitions of the lanes.
+    """
+    return call_intrin(
+        "handle",
+        _tvm_op.Op.get("tl.ptx_tcgen05_cp"),
+        desc,
+        desc_offset,
+        tmem_ptr,
+        tmem_offset,
+    )
+
+
 def mma_store(dtype, m, n, dst_ptr, src_ptr, src_offset, dst_stride):
     """TVM intrinsic for storing the result of PTX MMA into a destination pointer
 
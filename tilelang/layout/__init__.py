@@ -6,11 +6,14 @@ from .fragment import Fragment  # noqa: F401
 from .swizzle import (
     make_swizzled_layout,  # noqa: F401
     make_volta_swizzled_layout,  # noqa: F401
+    make_mfma_swizzled_layout,  # noqa: F401
     make_wgmma_swizzled_layout,  # noqa: F401
     make_tcgen05mma_swizzled_layout,  # noqa: F401
+    make_tcgen05_scale_factor_layout,  # noqa: F401
+    make_tcgen05_scale_factor_tmem_layout,  # noqa: F401
     make_full_bank_swizzled_layout,  # noqa: F401
     make_half_bank_swizzled_layout,  # noqa: F401
     make_quarter_bank_swizzled_layout,  # noqa: F401
     make_linear_layout,  # noqa: F401
 )
-from .gemm_sp import make_cutlass_metadata_layout  # noqa: F401
+from .gemm_sp import make_cutlass_metadata_layout, make_cdna_metadata_layout  # noqa: F401
@@ -147,7 +147,29 @@ def make_cutlass_metadata_layout_sm8x(buffer: tvm.tir.Buffer, mma_dtype: str):
     return T.Layout(buffer.shape, ColumnMajorInterleaved)
 
 
+def make_cdna_metadata_layout(buffer: tvm.tir.Buffer, mma_dtype: str = T.float16):
+    """Make a layout of metadata for the CDNA3 sparse mfma (v_smfmac). The metadata is kept row-major in smem and gmem:
+        each byte holds the 2-bit positions of the kept values of two consecutive groups of 4 along K, low bits first,
+        which is exactly the per-lane index operand of the instruction, so no interleaving is needed.
+    Args:
+        buffer: metadata buffer of shape (M, K // E_factor), any 8/16/32 bit integer type
+        mma_dtype: dtype of mma operand A, float16 or bfloat16
+    """
+    if mma_dtype not in [T.float16, T.bfloat16]:
+        raise NotImplementedError(f"Unsupported dtype for sparse mfma: {mma_dtype}")
+    if buffer.dtype not in [T.int8, T.uint8, T.int16, T.uint16, T.int32, T.uint32]:
+        raise ValueError(f"metadata should be an 8/16/32 bit integer, got {buffer.dtype}")
+
+    def RowMajor(i: int, k: int):
+        return i, k
+
+    return T.Layout(buffer.shape, RowMajor)
+
+
 def make_cutlass_metadata_layout(buffer: tvm.tir.Buffer, mma_dtype: str = T.float16, arch: str | None = None, **extra_args):
+    if arch is not None and arch.startswith("gfx"):
+        return make_cdna_metadata_layout(buffer=buffer, mma_dtype=mma_dtype)
+
     if arch is None:
         arch = nvcc.get_target_compute_version()
 
@@ -82,6 +82,18 @@ def make_volta_swizzled_layout(buffer: Buffer | BufferLoad | BufferRegion, is_a:
     )
 
 
+# for CDNA Matrix Core Intrinsics, K-major operands read vec_bytes per lane
+def make_mfma_swizzled_layout(buffer: Buffer | BufferLoad | BufferRegion, vec_bytes: int = 16):
+    stride, continuous = _get_stride_continuous(buffer)
+    element_size = _get_element_size(buffer)
+    return _ffi_api.make_mfma_swizzled_layout(
+        stride,
+        continuous,
+        element_size,
+        vec_bytes,
+    )
+
+
 # for WGMMA Intrinsics
 def make_wgmma_swizzled_layout(buffer: Buffer | BufferLoad | BufferRegion, continuity: int = None, k_major: bool = True):
     stride, continuous = _get_stride_continuous(buffer)
@@ -112,6 +124,20 @@ def make_tcgen05mma_swizzled_layout(buffer: Buffer | BufferLoad | BufferRegion,
     )
 
 
+# for the scale factors of block scaled TCGEN05MMA
+def make_tcgen05_scale_factor_layout(buffer: Buffer | BufferLoad | BufferRegion):
+    """Shared memory layout of a (rows, num_sf) scale factor buffer copied into
+    tensor memory by tcgen05.cp, rows being M for A or N for B."""
+    rows, num_sf = _get_stride_continuous(buffer)
+    return _ffi_api.make_tcgen05_scale_factor_layout(rows, num_sf)
+
+
+def make_tcgen05_scale_factor_tmem_layout(rows: int, num_sf: int):
+    """Tensor memory placement of a (rows, num_sf) scale factor matrix,
+    mapping (row, sf) to (lane, column, byte in the 32-bit column)."""
+    return _ffi_api.make_tcgen05_scale_factor_tmem_layout(rows, num_sf)
+
+
 # swizzle 128B
 # args: buffer or (stride, continuous, element_size)
 def make_full_bank_swizzled_layout(*args):
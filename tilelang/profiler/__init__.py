@@ -8,12 +8,37 @@ from dataclasses import dataclass
 from tilelang.utils.tensor import (
     get_tensor_supply,
     TensorSupplyType,
+    TensorSupplyPool,
     torch_assert_close,
     is_float8_dtype,
 )
 from tilelang.engine.param import KernelParam
+from tilelang.utils.allclose import gpu_assert_close
 from tilelang.jit.adapter import BaseKernelAdapter
-from tilelang.profiler.bench import do_bench
+import math
+from tilelang.profiler.bench import BenchStats, do_bench
+from tilelang.profiler.region import (
+    alloc_profile_buffer,  # noqa: F401
+    decode_profile_regions,
+    export_profile_trace,
+    profile_regions_to_trace,  # noqa: F401
+)
+from tilelang.profiler.device_log import (
+    alloc_device_log_buffer,  # noqa: F401
+    count_device_log,  # noqa: F401
+    decode_device_log,
+    format_device_log,  # noqa: F401
+)
+from tilelang.profiler.metrics import (
+    DEFAULT_METRICS,
+    KernelMetrics,
+    collect_kernel_metrics,
+    roofline,
+)
+
+
+# Outputs from this size on are validated by the device-side checker.
+GPU_CHECK_MIN_ELEMENTS = 1 << 24
 
 
 @dataclass
@@ -25,12 +50,14 @@ class Profiler:
         result_idx: Indices indicating which parameters are output tensors
         supply_type: Type of tensor supply to use (e.g., random, zeros, etc.)
         adapter: Optional kernel adapter for interfacing with different backends
+        supply_pool: Optional pool reusing the generated tensors across profilers
     """
 
     params: list[KernelParam]
     result_idx: list[int]
     supply_type: TensorSupplyType
     adapter: BaseKernelAdapter | None = None
+    supply_pool: TensorSupplyPool | None = None
 
     def __post_init__(self):
         """Initialize tensor supply after dataclass initialization"""
@@ -58,15 +85,16 @@ class Profiler:
         return self
 
     def _get_inputs(self, with_output=False):
-        ins = []
-        for i in range(len(self.params)):
-            if with_output or i not in self.result_idx:
-                ins.append(self.supply(self.params[i]))
-        return ins
+        if self.supply_pool is not None:
+            return self.supply_pool.get_inputs(self._get_params(with_output), self.supply_type)
+        return [self.supply(param) for param in self._get_params(with_output)]
 
     def _get_params(self, with_output=False):
         params = []
         for i in range(len(self.params)):
+            # The adapter serves the workspaces
+            if self.params[i].workspace:
+                continue
             if with_output or i not in self.result_idx:
                 params.append(self.params[i])
         return params
@@ -78,6 +106,7 @@ class Profiler:
         atol: float = 1e-2,
         rtol: float = 1e-2,
         max_mismatched_ratio=0.01,
+        gpu_check: bool | None = None,
     ):
         """Validates kernel output against a reference implementation.
 
@@ -87,6 +116,9 @@ class Profiler:
             atol: Absolute tolerance for comparison
             rtol: Relative tolerance for comparison
             max_mismatched_ratio: Maximum allowed ratio of mismatched elements
+            gpu_check: Compare with the TileLang checker of
+                tilelang.utils.allclose instead of torch_assert_close; by
+                default for CUDA tensors of at least GPU_CHECK_MIN_ELEMENTS
         """
         ins = self._get_inputs() if input_tensors is None else input_tensors
         ref_outs = reference_program(*ins)
@@ -123,6 +155,20 @@ class Profiler:
             if lhs is not None and rhs is not None:
                 # in case of numsplit template, the ref output may be None
                 # which means the value is invalid, so we skip the comparison
+                use_gpu_check = gpu_check
+                if use_gpu_check is None:
+                    use_gpu_check = lhs.is_cuda and rhs.is_cuda and lhs.numel() >= GPU_CHECK_MIN_ELEMENTS
+                if use_gpu_check and lhs.shape == rhs.shape:
+                    gpu_assert_close(
+                        lhs,
+                        rhs.to(lhs.dtype) if rhs.dtype != lhs.dtype else rhs,
+                        rtol=rtol,
+                        atol=atol,
+                        max_mismatched_ratio=max_mismatched_ratio,
+                        base_name="tilelang",
+                        ref_name="ref",
+                    )
+                    continue
                 torch_assert_close(
                     lhs if not is_float8_dtype(lhs.dtype) else lhs.to(torch.float32),
                     rhs if not is_float8_dtype(rhs.dtype) else rhs.to(torch.float32),
@@ -231,6 +277,152 @@ class Profiler:
             return_mode=return_mode,
         )
 
+    def bench_modes(
+        self,
+        func: Callable | None = None,
+        modes: tuple[str, ...] = ("cold", "warm", "weights", "loaded"),
+        input_tensors: list[torch.Tensor] = None,
+        streaming_idx: list[int] | None = None,
+        warmup: int = 25,
+        rep: int = 100,
+    ) -> dict[str, BenchStats]:
+        """Benchmarks a function under the cache and load conditions of a deployment.
+
+        Modes:
+            cold: the L2 cache is cleared before every run, as in do_bench
+            warm: back-to-back runs on the same inputs, everything L2-resident
+            weights: the inputs in ``streaming_idx`` rotate through enough
+                copies to miss in L2 every run, the other inputs (the weights)
+                stay warm
+            loaded: warm runs next to a DRAM bandwidth hog on another stream
+
+        Args:
+            func: Function to benchmark (uses adapter if None)
+            modes: Modes to measure, in order
+            input_tensors: Optional pre-generated input tensors
+            streaming_idx: Inputs streamed in the "weights" mode (default: the
+                first input, e.g. the activations of a GEMM)
+            warmup: Warmup time in milliseconds
+            rep: Benchmark time in milliseconds per mode
+
+        Returns:
+            dict[str, BenchStats]: Per-run runtime distribution of each mode
+        """
+        if func is None:
+            assert self.adapter is not None, "benchmarking function should be provided"
+            func = self.adapter
+        ins = self._get_inputs() if input_tensors is None else input_tensors
+        results = {}
+        for mode in modes:
+            bench_func = partial(func, *ins)
+            flush_l2, background_load = False, False
+            if mode == "cold":
+                flush_l2 = True
+            elif mode == "weights":
+                streaming_idx = [0] if streaming_idx is None else streaming_idx
+                streamed_bytes = sum(ins[i].numel() * ins[i].element_size() for i in streaming_idx)
+                l2_bytes = torch.cuda.get_device_properties(torch.cuda.current_device()).L2_cache_size
+                # enough copies that a copy is evicted before it comes around again
+                copies = min(64, max(2, math.ceil(2 * l2_bytes / max(streamed_bytes, 1))))
+                bench_func = []
+                for _ in range(copies):
+                    args = list(ins)
+                    for i in streaming_idx:
+                        args[i] = ins[i].clone()
+                    bench_func.append(partial(func, *args))
+            elif mode == "loaded":
+                background_load = True
+            elif mode != "warm":
+                raise ValueError(f"Unknown benchmark mode: {mode}")
+            times = do_bench(
+                bench_func,
+                warmup=warmup,
+                rep=rep,
+                return_mode="all",
+                flush_l2=flush_l2,
+                background_load=background_load,
+            )
+            results[mode] = BenchStats(mode, times)
+        return results
+
+    def decode_profile_regions(self, buffer: torch.Tensor, warp_roles=None) -> list[dict]:
+        """Decodes the T.profile_begin/T.profile_end ring buffer of a launch.
+
+        Args:
+            buffer: The profile buffer passed to the kernel, see alloc_profile_buffer
+            warp_roles: Optional dict or callable naming the warps of a block
+
+        Returns:
+            list[dict]: The completed regions of every (SM, block, warp)
+        """
+        torch.cuda.synchronize()
+        return decode_profile_regions(buffer, warp_roles)
+
+    def export_profile_trace(self, buffer: torch.Tensor, path: str, warp_roles=None) -> list[dict]:
+        """Writes the profile regions of a launch as a Chrome trace / Perfetto timeline.
+
+        Args:
+            buffer: The profile buffer passed to the kernel, see alloc_profile_buffer
+            path: Output JSON file
+            warp_roles: Optional dict or callable naming the warps of a block
+
+        Returns:
+            list[dict]: The decoded regions
+        """
+        torch.cuda.synchronize()
+        return export_profile_trace(buffer, path, warp_roles)
+
+    def decode_device_log(self, buffer: torch.Tensor) -> list[dict]:
+        """Decodes the T.device_log ring buffer of a launch.
+
+        Args:
+            buffer: The log buffer passed to the kernel, see alloc_device_log_buffer
+
+        Returns:
+            list[dict]: The records of every logging thread
+        """
+        torch.cuda.synchronize()
+        return decode_device_log(buffer)
+
+    def collect_metrics(
+        self,
+        func: Callable | None = None,
+        input_tensors: list[torch.Tensor] = None,
+        flops: float | None = None,
+        dtype: str = "float16",
+        arch=None,
+        metrics: dict[str, str] = DEFAULT_METRICS,
+    ) -> list[KernelMetrics]:
+        """Collects the CUPTI hardware counters of every kernel of one launch.
+
+        Args:
+            func: Function to measure (uses adapter if None)
+            input_tensors: Optional pre-generated input tensors
+            flops: FLOPs of the measured kernel; with it each kernel gets a
+                roofline position against the peak numbers of ``arch``
+            dtype: Input dtype selecting the peak tensor throughput
+            arch: TileDevice providing the peak numbers (auto-detected if None)
+            metrics: Counters to collect, see tilelang.profiler.metrics
+
+        Returns:
+            list[KernelMetrics]: DRAM/L2 bytes, occupancy, tensor pipe utilization,
+            shared memory bank conflicts and roofline of each kernel
+        """
+        if func is None:
+            assert self.adapter is not None, "profiling function should be provided"
+            func = self.adapter
+        ins = self._get_inputs() if input_tensors is None else input_tensors
+        kernels = collect_kernel_metrics(partial(func, *ins), metrics)
+        if flops is not None:
+            if arch is None:
+                from tilelang.carver.arch import auto_infer_current_arch
+
+                arch = auto_infer_current_arch()
+            for kernel in kernels:
+                if kernel.time_ns:
+                    kernel.roofline = roofline(kernel, flops, arch, dtype)
+        return kernels
+
     @property
     def func(self):
         assert self.adapter is not None, "adapter should be provided"
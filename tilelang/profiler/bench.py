@@ -2,8 +2,11 @@
 
 from __future__ import annotations
 
+import math
 import os
 import sys
+from collections.abc import Sequence
+from dataclasses import dataclass
 from typing import Callable, Literal
 
 import torch
@@ -61,8 +64,81 @@ device = "cuda:0" if IS_CUDA else "mps:0"
 Event = torch.cuda.Event if IS_CUDA else torch.mps.Event
 
 
+@dataclass(frozen=True)
+class BenchStats:
+    """Distribution of the per-iteration runtimes of one benchmark mode, in milliseconds."""
+
+    mode: str
+    times: list[float]
+
+    def quantile(self, q: float) -> float:
+        return torch.quantile(torch.tensor(self.times, dtype=torch.float), q).item()
+
+    @property
+    def p50(self) -> float:
+        return self.quantile(0.5)
+
+    @property
+    def p99(self) -> float:
+        return self.quantile(0.99)
+
+    @property
+    def mean(self) -> float:
+        return sum(self.times) / len(self.times)
+
+    @property
+    def min(self) -> float:
+        return min(self.times)
+
+    def __repr__(self) -> str:
+        return f"BenchStats({self.mode}, p50={self.p50:.4f}, p99={self.p99:.4f}, mean={self.mean:.4f}, n={len(self.times)})"
+
+
+class BandwidthHog:
+    """Synthetic neighbor saturating DRAM bandwidth from a side stream.
+
+    ``start`` enqueues enough copies between two buffers larger than the L2
+    cache to cover a given duration, so the benchmarked kernel competes for
+    memory bandwidth and L2 capacity as it would next to other kernels.
+    """
+
+    def __init__(self, nbytes: int = int(512e6)):
+        self.stream = torch.cuda.Stream()
+        self.src = torch.empty(nbytes // 8, dtype=torch.int32, device="cuda")
+        self.dst = torch.empty_like(self.src)
+        self._copy_ms: float | None = None
+
+    def _copy(self):
+        self.dst.copy_(self.src)
+
+    def copy_ms(self) -> float:
+        if self._copy_ms is None:
+            start_event = torch.cuda.Event(enable_timing=True)
+            end_event = torch.cuda.Event(enable_timing=True)
+            with torch.cuda.stream(self.stream):
+                self._copy()
+                start_event.record()
+                for _ in range(3):
+                    self._copy()
+                end_event.record()
+            end_event.synchronize()
+            self._copy_ms = start_event.elapsed_time(end_event) / 3
+        return self._copy_ms
+
+    def start(self, duration_ms: float):
+        copies = math.ceil(duration_ms / self.copy_ms()) + 1
+        # the side stream only starts after the work already queued
+        self.stream.wait_stream(torch.cuda.current_stream())
+        with torch.cuda.stream(self.stream):
+            for _ in range(copies):
+                self._copy()
+
+    def stop(self):
+        self.stream.synchronize()
+
+
 def do_bench(
-    fn: Callable,
+    fn: Callable | Sequence[Callable],
     warmup: float = 25,
     rep: float = 100,
     _n_warmup: int = 0,
@@ -70,7 +146,9 @@ def do_bench(
     quantiles: list[float] | None = None,
     fast_flush: bool = True,
     backend: Literal["event", "cupti"] = "event",
-    return_mode: Literal["min", "max", "mean", "median"] = "mean",
+    return_mode: Literal["min", "max", "mean", "median", "all"] = "mean",
+    flush_l2: bool = True,
+    background_load: bool = False,
 ) -> float | list[float]:
     """Benchmark the runtime of a PyTorch function with L2 cache management.
 
@@ -81,7 +159,8 @@ def do_bench(
     - Offering flexible result aggregation (mean/median/min/max/quantiles)
 
     Args:
-        fn: Function to benchmark
+        fn: Function to benchmark, or functions run in turn by the iterations
+            (e.g. the same kernel on different activation buffers)
         warmup: Target warmup time in milliseconds (default: 25)
         rep: Target total benchmark time in milliseconds (default: 100)
         _n_warmup: Manual override for warmup iterations (default: 0 = auto)
@@ -89,30 +168,38 @@ def do_bench(
         quantiles: Performance percentiles to compute (e.g., [0.5, 0.95])
         fast_flush: Use faster L2 cache flush with int32 vs int8 (default: True)
         backend: Profiler backend - "event" (CUDA events) or "cupti" (default: "event")
-        return_mode: Result aggregation method - "mean", "median", "min", or "max"
+        return_mode: Result aggregation method - "mean", "median", "min", "max",
+            or "all" for the list of per-iteration runtimes
+        flush_l2: Clear the L2 cache before every iteration (default: True),
+            False measures with the L2 cache warm from the previous iteration
+        background_load: Run a `BandwidthHog` on a side stream during the
+            timed iterations (event backend only)
 
     Returns:
         Runtime in milliseconds (float) or list of quantile values if quantiles specified
     """
-    assert return_mode in ["min", "max", "mean", "median"], f"Invalid return_mode: {return_mode}"
+    assert return_mode in ["min", "max", "mean", "median", "all"], f"Invalid return_mode: {return_mode}"
+    fns = list(fn) if isinstance(fn, Sequence) else [fn]
 
     # Initial function call and synchronization
-    fn()
+    for f in fns:
+        f()
     torch.cuda.synchronize()
 
     # Create L2 cache flush buffer (256 MB)
     # Fast flush uses int32 (4 bytes), regular uses int8 (1 byte)
     cache_size = int(256e6 // 4) if fast_flush else int(256e6)
     cache_dtype = torch.int if fast_flush else torch.int8
-    cache = torch.empty(cache_size, dtype=cache_dtype, device="cuda")
+    cache = torch.empty(cache_size, dtype=cache_dtype, device="cuda") if flush_l2 else None
 
     # Estimate kernel runtime with 5 iterations
     start_event = torch.cuda.Event(enable_timing=True)
     end_event = torch.cuda.Event(enable_timing=True)
     start_event.record()
-    for _ in range(5):
-        cache.zero_()
-        fn()
+    for i in range(5):
+        if cache is not None:
+            cache.zero_()
+        fns[i % len(fns)]()
     end_event.record()
     start_event.synchronize()
     end_event.synchronize()
@@ -123,21 +210,32 @@ def do_bench(
     n_repeat = _n_repeat if _n_repeat > 0 else max(1, int(rep / estimate_ms))
 
     # Warmup phase
-    for _ in range(n_warmup):
-        fn()
+    for i in range(n_warmup):
+        fns[i % len(fns)]()
 
     # Benchmarking phase
     if backend == "event":
-        return _bench_with_cuda_events(fn, cache, n_repeat, quantiles, return_mode)
+        hog = None
+        if background_load:
+            hog = BandwidthHog()
+            # the neighbor slows the runs down, cover them with a margin
+            hog.start(2 * n_repeat * estimate_ms)
+        try:
+            return _bench_with_cuda_events(fns, cache, n_repeat, quantiles, return_mode)
+        finally:
+            if hog is not None:
+                hog.stop()
     elif backend == "cupti":
-        return _bench_with_cupti(fn, cache, n_repeat)
+        if background_load or len(fns) > 1:
+            raise ValueError("The cupti backend measures a single function without background load")
+        return _bench_with_cupti(fns[0], cache, n_repeat)
     else:
         raise ValueError(f"Unknown profiler backend: {backend}")
 
 
 def _bench_with_cuda_events(
-    fn: Callable,
-    cache: torch.Tensor,
+    fns: list[Callable],
+    cache: torch.Tensor | None,
     n_repeat: int,
     quantiles: list[float] | None,
     return_mode: str,
@@ -149,9 +247,10 @@ def _bench_with_cuda_events(
 
     # Run benchmark iterations
     for i in range(n_repeat):
-        cache.zero_()  # Clear L2 cache
+        if cache is not None:
+            cache.zero_()  # Clear L2 cache
         start_events[i].record()
-        fn()
+        fns[i % len(fns)]()
         end_events[i].record()
 
     # Synchronize and collect timings
@@ -160,6 +259,8 @@ def _bench_with_cuda_events(
         [s.elapsed_time(e) for s, e in zip(start_events, end_events)],
         dtype=torch.float,
     )
+    if return_mode == "all":
+        return times.tolist()
 
     # Return quantiles if requested
     if quantiles is not None:
@@ -172,7 +273,7 @@ def _bench_with_cuda_events(
 
 def _bench_with_cupti(
     fn: Callable,
-    cache: torch.Tensor,
+    cache: torch.Tensor | None,
     n_repeat: int,
 ) -> float:
     """Benchmark using CUPTI profiler for detailed kernel timing."""
@@ -186,7 +287,8 @@ def _bench_with_cupti(
         with profiler:
             for _ in range(2):
                 for _ in range(n_repeat):
-                    cache.zero_()
+                    if cache is not None:
+                        cache.zero_()
                     fn()
                 profiler.step()
 
@@ -0,0 +1,78 @@
+"""Host side decoding of the T.device_log ring buffer."""
+
+from __future__ import annotations
+
+import struct
+from typing import Any
+
+from tilelang.language.device_log import (
+    LOG_HEADER_WORDS,
+    LOG_RECORD_WORDS,
+    device_log_buffer_shape,
+    device_log_format,
+)
+
+_U64_MASK = (1 << 64) - 1
+
+
+def alloc_device_log_buffer(capacity: int, device: Any = "cuda"):
+    """Allocates a zeroed device log ring buffer holding ``capacity`` records."""
+    import torch
+
+    return torch.zeros(device_log_buffer_shape(capacity), dtype=torch.int64, device=device)
+
+
+def _decode_value(kind: str, word: int):
+    if kind == "f":
+        return struct.unpack("<d", struct.pack("<Q", word))[0]
+    if kind == "i":
+        return word - (1 << 64) if word >> 63 else word
+    return word
+
+
+def decode_device_log(buffer) -> list[dict[str, Any]]:
+    """Decodes the records of a device log buffer.
+
+    Args:
+        buffer: The ring buffer written by the kernel (tensor or list of ints).
+
+    Returns:
+        One dict per record with msg, block and thread (as (x, y, z)) and
+        values, in the order the records were reserved. When more records were
+        written than the buffer holds, the slots hold the latest record written
+        to them and the order is only kept per slot; ``count_device_log``
+        tells how many records were written in total.
+    """
+    words = buffer.tolist() if hasattr(buffer, "tolist") else list(buffer)
+    words = [int(w) & _U64_MASK for w in words]
+    capacity = (len(words) - LOG_HEADER_WORDS) // LOG_RECORD_WORDS
+    assert capacity > 0, "device log buffer holds no record"
+    records = []
+    for slot in range(min(words[0], capacity)):
+        base = LOG_HEADER_WORDS + LOG_RECORD_WORDS * slot
+        header, block = words[base], words[base + 1]
+        msg, kinds = device_log_format(header & 0xFFFFFFFF)
+        nvalues = (header >> 58) & 0x7
+        if len(kinds) != nvalues:
+            kinds = ("i",) * nvalues
+        records.append({
+            "msg": msg,
+            "block": (block & 0xFFFFFFFF, (block >> 32) & 0xFFFF, (block >> 48) & 0xFFFF),
+            "thread": ((header >> 32) & 0x3FF, (header >> 42) & 0x3FF, (header >> 52) & 0x3F),
+            "values": [_decode_value(kind, words[base + 2 + i]) for i, kind in enumerate(kinds)],
+        })
+    return records
+
+
+def count_device_log(buffer) -> int:
+    """Returns the number of records ever written to a device log buffer."""
+    return int(buffer[0])
+
+
+def format_device_log(records: list[dict[str, Any]]) -> str:
+    """Formats decoded records like the lines ``T.print`` writes."""
+    lines = []
+    for r in records:
+        values = ", ".join(repr(v) for v in r["values"])
+        lines.append(f"msg='{r['msg']}' BlockIdx={r['block']}, ThreadIdx={r['thread']}: values=[{values}]")
+    return "\n".join(lines)
@@ -0,0 +1,178 @@
+"""Per kernel hardware counters collected with the CUPTI range profiler.
+
+``collect_kernel_metrics`` replays every kernel launched by a function under the
+CUPTI range profiler (through the PyTorch profiler) and reports, per kernel, the
+DRAM and L2 traffic, the achieved occupancy, the tensor pipe utilization and the
+shared memory bank conflicts. ``roofline`` places a kernel on the roofline of a
+``TileDevice``, which tells whether a config is memory or compute bound and how
+far it is from the roof.
+"""
+
+from __future__ import annotations
+
+import json
+import os
+import tempfile
+from dataclasses import asdict, dataclass, field
+from typing import Any, Callable
+
+# KernelMetrics field -> CUPTI (perfworks) metric.
+DEFAULT_METRICS: dict[str, str] = {
+    "time_ns": "gpu__time_duration.sum",
+    "dram_bytes_read": "dram__bytes_read.sum",
+    "dram_bytes_write": "dram__bytes_write.sum",
+    "l2_bytes": "lts__t_bytes.sum",
+    "achieved_occupancy": "sm__warps_active.avg.pct_of_peak_sustained_active",
+    "tensor_pipe_utilization": "sm__pipe_tensor_cycles_active.avg.pct_of_peak_sustained_active",
+    "smem_bank_conflicts": "l1tex__data_bank_conflicts_pipe_lsu_mem_shared.sum",
+}
+
+
+@dataclass
+class Roofline:
+    """Position of a kernel on the roofline of a device."""
+
+    arithmetic_intensity: float  # FLOP per DRAM byte
+    achieved_flops: float  # FLOP/s
+    achieved_bandwidth: float  # DRAM bytes/s
+    peak_flops: float | None
+    peak_bandwidth: float | None
+    # Arithmetic intensity where the memory roof meets the compute roof.
+    ridge_point: float | None
+    # "memory" or "compute", None without peak numbers.
+    bound: str | None
+    # Achieved FLOP/s over the roof at this arithmetic intensity.
+    fraction_of_roof: float | None
+
+
+@dataclass
+class KernelMetrics:
+    """Hardware counters of one kernel launch; a counter is None when unavailable."""
+
+    name: str
+    time_ns: float | None = None
+    dram_bytes_read: float | None = None
+    dram_bytes_write: float | None = None
+    l2_bytes: float | None = None
+    # Percentages of the peak sustained rate.
+    achieved_occupancy: float | None = None
+    tensor_pipe_utilization: float | None = None
+    smem_bank_conflicts: float | None = None
+    # Every collected metric by its CUPTI name.
+    raw: dict[str, float] = field(default_factory=dict)
+    roofline: Roofline | None = None
+
+    @property
+    def dram_bytes(self) -> float | None:
+        if self.dram_bytes_read is None and self.dram_bytes_write is None:
+            return None
+        return (self.dram_bytes_read or 0.0) + (self.dram_bytes_write or 0.0)
+
+    def to_dict(self) -> dict[str, Any]:
+        result = asdict(self)
+        result["dram_bytes"] = self.dram_bytes
+        return result
+
+
+def parse_metric_trace(trace: dict[str, Any], metrics: dict[str, str] = DEFAULT_METRICS) -> list[KernelMetrics]:
+    """Extracts the per kernel ranges of a Chrome trace exported by the PyTorch profiler."""
+    by_metric = {metric: name for name, metric in metrics.items()}
+    results = []
+    for event in trace.get("traceEvents", []):
+        if event.get("cat") != "cuda_profiler_range":
+            continue
+        args = event.get("args", {})
+        kernel = KernelMetrics(name=event.get("name", ""))
+        for metric, value in args.items():
+            try:
+                value = float(value)
+            except (TypeError, ValueError):
+                continue
+            kernel.raw[metric] = value
+            if metric in by_metric:
+                setattr(kernel, by_metric[metric], value)
+        results.append(kernel)
+    return results
+
+
+def collect_kernel_metrics(
+    fn: Callable[[], Any],
+    metrics: dict[str, str] = DEFAULT_METRICS,
+    kernel_filter: Callable[[str], bool] | None = None,
+) -> list[KernelMetrics]:
+    """Runs ``fn`` once under the CUPTI range profiler.
+
+    Each kernel is replayed until all counters are collected, so the launches
+    must be idempotent; the reported time comes from ``gpu__time_duration``
+    and not from the (serialized) replay.
+
+    Args:
+        fn: Function launching the kernels to measure.
+        metrics: KernelMetrics field (or any name) to CUPTI metric mapping;
+            unmapped metrics end up in ``raw`` only.
+        kernel_filter: Keeps the kernels whose name it accepts.
+
+    Returns:
+        One KernelMetrics per kernel launch, in launch order.
+    """
+    import torch
+    from torch._C._profiler import _ExperimentalConfig
+
+    config = _ExperimentalConfig(profiler_metrics=list(metrics.values()), profiler_measure_per_kernel=True)
+    torch.cuda.synchronize()
+    with torch.profiler.profile(activities=[torch.profiler.ProfilerActivity.CUDA], experimental_config=config) as profiler:
+        fn()
+        torch.cuda.synchronize()
+
+    fd, path = tempfile.mkstemp(suffix=".json", prefix="tilelang_cupti_metrics_")
+    os.close(fd)
+    try:
+        profiler.export_chrome_trace(path)
+        with open(path) as f:
+            trace = json.load(f)
+    finally:
+        os.remove(path)
+
+    results = parse_metric_trace(trace, metrics)
+    if not results:
+        raise RuntimeError(
+            "The CUPTI range profiler reported no kernel. It requires a PyTorch build whose Kineto "
+            "supports CUPTI profiler metrics, and the permission to access GPU performance counters."
+        )
+    if kernel_filter is not None:
+        results = [kernel for kernel in results if kernel_filter(kernel.name)]
+    return results
+
+
+def roofline(kernel: KernelMetrics, flops: float, arch=None, dtype: str = "float16") -> Roofline:
+    """Places ``kernel`` on the roofline of ``arch``.
+
+    Args:
+        kernel: Measured kernel, needs ``time_ns`` and the DRAM bytes.
+        flops: Floating point operations performed by the kernel.
+        arch: A TileDevice providing the peak numbers, if any.
+        dtype: Input dtype selecting the peak tensor throughput.
+    """
+    assert kernel.time_ns, f"kernel {kernel.name} has no duration"
+    seconds = kernel.time_ns * 1e-9
+    dram_bytes = kernel.dram_bytes or 0.0
+    intensity = flops / dram_bytes if dram_bytes else float("inf")
+    achieved_flops = flops / seconds
+    peak_flops = arch.peak_tensor_flops(dtype) if arch is not None else None
+    peak_bandwidth = arch.peak_memory_bandwidth() if arch is not None else None
+
+    ridge_point = bound = fraction = None
+    if peak_flops and peak_bandwidth:
+        ridge_point = peak_flops / peak_bandwidth
+        bound = "memory" if intensity < ridge_point else "compute"
+        fraction = achieved_flops / min(peak_flops, intensity * peak_bandwidth)
+    return Roofline(
+        arithmetic_intensity=intensity,
+        achieved_flops=achieved_flops,
+        achieved_bandwidth=dram_bytes / seconds,
+        peak_flops=peak_flops,
+        peak_bandwidth=peak_bandwidth,
+        ridge_point=ridge_point,
+        bound=bound,
+        fraction_of_roof=fraction,
+    )
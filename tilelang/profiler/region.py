@@ -0,0 +1,131 @@
+"""Host side decoding of the T.profile_begin/T.profile_end ring buffer."""
+
+from __future__ import annotations
+
+import json
+from typing import Any, Callable, Dict, Optional, Union
+
+from tilelang.language.profile import (
+    PROFILE_HEADER_WORDS,
+    PROFILE_RECORD_WORDS,
+    profile_buffer_shape,
+    profile_region_name,
+)
+
+_U64_MASK = (1 << 64) - 1
+
+WarpRoles = Optional[Union[Dict[int, str], Callable[[int], str]]]
+
+
+def alloc_profile_buffer(capacity: int, device: Any = "cuda"):
+    """Allocates a zeroed profile ring buffer holding ``capacity`` records."""
+    import torch
+
+    return torch.zeros(profile_buffer_shape(capacity), dtype=torch.int64, device=device)
+
+
+def _warp_role(warp_roles: WarpRoles, warp: int) -> str | None:
+    if warp_roles is None:
+        return None
+    if callable(warp_roles):
+        return warp_roles(warp)
+    return warp_roles.get(warp)
+
+
+def _read_records(buffer) -> list[tuple[int, int, int, int]]:
+    words = buffer.tolist() if hasattr(buffer, "tolist") else list(buffer)
+    words = [int(w) & _U64_MASK for w in words]
+    capacity = (len(words) - PROFILE_HEADER_WORDS) // PROFILE_RECORD_WORDS
+    assert capacity > 0, "profile buffer holds no record"
+    count = min(words[0], capacity)
+    records = []
+    for slot in range(count):
+        base = PROFILE_HEADER_WORDS + PROFILE_RECORD_WORDS * slot
+        records.append(tuple(words[base : base + PROFILE_RECORD_WORDS]))
+    return records
+
+
+def decode_profile_regions(buffer, warp_roles: WarpRoles = None) -> list[dict[str, Any]]:
+    """Pairs the begin/end records of a profile buffer into regions.
+
+    Args:
+        buffer: The ring buffer written by the kernel (tensor or list of ints).
+        warp_roles: Optional mapping (or callable) from warp id in the block to
+            a role name such as "producer"/"consumer".
+
+    Returns:
+        One dict per completed region with name, sm, block, warp, role, start_ns,
+        end_ns, duration_ns and cycles, sorted by start time. Records whose
+        counterpart was overwritten after the buffer wrapped are dropped.
+    """
+    records = sorted(_read_records(buffer), key=lambda r: (r[0], r[1]))
+    open_regions: dict[tuple[int, int, int], list[tuple[int, int]]] = {}
+    regions = []
+    for timer, cycles, header, block in records:
+        region = header & 0xFFFFFFFF
+        is_end = (header >> 32) & 0x1
+        warp = (header >> 33) & 0x7FFF
+        sm = (header >> 48) & 0xFFFF
+        key = (block, warp, region)
+        if not is_end:
+            open_regions.setdefault(key, []).append((timer, cycles))
+            continue
+        if not open_regions.get(key):
+            continue
+        start_timer, start_cycles = open_regions[key].pop()
+        regions.append({
+            "name": profile_region_name(region),
+            "sm": sm,
+            "block": block,
+            "warp": warp,
+            "role": _warp_role(warp_roles, warp),
+            "start_ns": start_timer,
+            "end_ns": timer,
+            "duration_ns": timer - start_timer,
+            "cycles": (cycles - start_cycles) & _U64_MASK,
+        })
+    regions.sort(key=lambda r: (r["start_ns"], r["sm"], r["block"], r["warp"]))
+    return regions
+
+
+def profile_regions_to_trace(regions: list[dict[str, Any]]) -> dict[str, Any]:
+    """Converts decoded regions to a Chrome trace / Perfetto timeline.
+
+    Each SM is a process and each (block, warp) a thread of it, so the warp roles
+    of concurrently resident blocks show up as separate tracks.
+    """
+    t0 = min((r["start_ns"] for r in regions), default=0)
+    threads: dict[tuple[int, int, int], int] = {}
+    events = []
+    for r in regions:
+        key = (r["sm"], r["block"], r["warp"])
+        if key not in threads:
+            threads[key] = len(threads)
+            label = f"block {r['block']} warp {r['warp']}"
+            if r["role"]:
+                label += f" ({r['role']})"
+            events.append({"ph": "M", "name": "thread_name", "pid": r["sm"], "tid": threads[key], "args": {"name": label}})
+        events.append({
+            "ph": "X",
+            "name": r["name"],
+            "pid": r["sm"],
+            "tid": threads[key],
+            "ts": (r["start_ns"] - t0) / 1e3,
+            "dur": r["duration_ns"] / 1e3,
+            "args": {"cycles": r["cycles"], "block": r["block"], "warp": r["warp"]},
+        })
+    for sm in sorted({r["sm"] for r in regions}):
+        events.append({"ph": "M", "name": "process_name", "pid": sm, "args": {"name": f"SM {sm}"}})
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def export_profile_trace(buffer, path: str, warp_roles: WarpRoles = None) -> list[dict[str, Any]]:
+    """Decodes ``buffer`` and writes it to ``path`` as Chrome trace JSON.
+
+    The file opens in chrome://tracing and ui.perfetto.dev. Returns the decoded
+    regions.
+    """
+    regions = decode_profile_regions(buffer, warp_roles)
+    with open(path, "w") as f:
+        json.dump(profile_regions_to_trace(regions), f)
+    return regions
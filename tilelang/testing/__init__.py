@@ -8,7 +8,8 @@ from tilelang.contrib import nvcc
 from tvm.testing.utils import requires_cuda, requires_package, requires_llvm, requires_metal, requires_rocm, _compose
 
 from tilelang.utils.tensor import torch_assert_close as torch_assert_close
-from .perf_regression import process_func, regression
+from .perf_regression import PerfMeasurement, process_func, regression
+from .fuzz import FuzzCase, fuzz_shapes, sample_shapes  # noqa: F401
 
 __all__ = [
     "requires_package",
@@ -20,6 +21,7 @@ __all__ = [
     "requires_cuda_compute_version",
     "process_func",
     "regression",
+    "PerfMeasurement",
 ] + [f"requires_cuda_compute_version_{op}" for op in ("ge", "gt", "le", "lt", "eq")]
 
 
@@ -0,0 +1,140 @@
+"""Shape fuzzing of a kernel against a reference program.
+
+A kernel validated on the shapes of its unit test can still break on sizes
+that are not multiples of its tiles, on extents smaller than a tile or on
+large problems. ``fuzz_shapes`` builds the kernel for the extremes of every
+dimension and then for random sizes, runs it next to the reference program
+and compares their outputs with ``gpu_allclose``, so that each case only
+costs the two launches and a checker launch::
+
+    report = tilelang.testing.fuzz_shapes(
+        lambda M, N, K: matmul(M, N, K, 128, 128, 32),
+        ref_prog=lambda A, B: A @ B,
+        dims={"M": (1, 4096), "N": (16, 4096), "K": [64, 128, 1000]},
+    )
+    assert all(case.passed for case in report), [case for case in report if not case.passed]
+"""
+
+from __future__ import annotations
+
+import itertools
+import math
+import random
+import traceback
+from collections.abc import Mapping, Sequence
+from dataclasses import dataclass, field
+from typing import Any, Callable
+
+import torch
+
+from tilelang.utils.allclose import AllcloseReport, gpu_allclose
+from tilelang.utils.tensor import TensorSupplyType
+
+
+@dataclass
+class FuzzCase:
+    """Outcome of one fuzzed shape."""
+
+    shape: dict[str, int]
+    # check of each output, in order
+    reports: list[AllcloseReport] = field(default_factory=list)
+    # build or launch failure, with its traceback
+    error: str | None = None
+    passed: bool = False
+
+
+def sample_shapes(dims: Mapping[str, tuple[int, int] | Sequence[int]], num_cases: int, seed: int = 0) -> list[dict[str, int]]:
+    """Enumerate the extremes of every dimension, then sample random shapes.
+
+    A dimension given as `(lo, hi)` is sampled log-uniformly in that range,
+    with a bias towards sizes that are not powers of two; one given as a list
+    is drawn from the list.
+    """
+    rng = random.Random(seed)
+    names = list(dims)
+
+    def extremes(spec):
+        return (spec[0], spec[1]) if isinstance(spec, tuple) else (min(spec), max(spec))
+
+    def draw(spec):
+        if not isinstance(spec, tuple):
+            return rng.choice(list(spec))
+        lo, hi = spec
+        value = int(round(math.exp(rng.uniform(math.log(max(lo, 1)), math.log(max(hi, 1))))))
+        if rng.random() < 0.5:
+            # off by a few from the sampled size, away from any tile multiple
+            value += rng.choice([-3, -1, 1, 7])
+        return min(max(value, lo), hi)
+
+    shapes = []
+    for corner in itertools.product(*(sorted(set(extremes(dims[name]))) for name in names)):
+        shapes.append(dict(zip(names, corner)))
+    shapes = shapes[:num_cases]
+    attempts = 0
+    while len(shapes) < num_cases and attempts < 100 * num_cases:
+        attempts += 1
+        shape = {name: draw(dims[name]) for name in names}
+        if shape not in shapes:
+            shapes.append(shape)
+    return shapes
+
+
+def _as_list(outputs: Any) -> list[torch.Tensor]:
+    if outputs is None:
+        return []
+    if isinstance(outputs, torch.Tensor):
+        return [outputs]
+    return list(outputs)
+
+
+def fuzz_shapes(
+    build: Callable[..., Any],
+    ref_prog: Callable[..., Any],
+    dims: Mapping[str, tuple[int, int] | Sequence[int]],
+    num_cases: int = 16,
+    seed: int = 0,
+    make_inputs: Callable[..., list[torch.Tensor]] | None = None,
+    supply_type: TensorSupplyType = TensorSupplyType.Auto,
+    rtol: float = 1e-2,
+    atol: float = 1e-2,
+    max_mismatched_ratio: float = 0.01,
+) -> list[FuzzCase]:
+    """Check a kernel against `ref_prog` on fuzzed shapes.
+
+    Args:
+        build: Returns the `JITKernel` of a shape, given as keyword arguments
+        ref_prog: Reference taking the inputs of the kernel
+        dims: Range `(lo, hi)` or list of sizes of every dimension
+        num_cases: Number of shapes checked
+        seed: Seed of the shape sampling
+        make_inputs: Returns the inputs of a shape, defaults to the inputs
+            supplied by the profiler of the kernel
+        supply_type: Tensor supply of the default inputs
+        rtol, atol, max_mismatched_ratio: Tolerances of the comparison
+
+    Returns:
+        list[FuzzCase]: One case per shape, failures included
+    """
+    cases = []
+    for shape in sample_shapes(dims, num_cases, seed):
+        case = FuzzCase(shape)
+        cases.append(case)
+        try:
+            kernel = build(**shape)
+            if make_inputs is not None:
+                inputs = make_inputs(**shape)
+            else:
+                inputs = kernel.get_profiler(tensor_supply_type=supply_type)._get_inputs()
+            outputs = _as_list(kernel(*inputs))
+            refs = _as_list(ref_prog(*inputs))
+            if len(outputs) != len(refs):
+                raise ValueError(f"The kernel returned {len(outputs)} outputs, the reference {len(refs)}")
+            passed = True
+            for out, ref in zip(outputs, refs):
+                report = gpu_allclose(out, ref.to(out.dtype), rtol=rtol, atol=atol)
+                case.reports.append(report)
+                passed = passed and report.num_mismatched <= int(report.total * max_mismatched_ratio)
+            case.passed = passed
+        except Exception:
+            case.error = traceback.format_exc()
+    return cases
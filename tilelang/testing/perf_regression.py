@@ -15,6 +15,22 @@ import warnings
 class PerfResult:
     name: str
     latency: float
+    # Work of one launch, when the benchmark reports it (see PerfMeasurement).
+    flops: float | None = None
+    bytes: float | None = None
+
+
+@dataclass(frozen=True)
+class PerfMeasurement:
+    """What a perf function may return instead of a bare latency.
+
+    With the FLOPs and/or DRAM bytes of one launch, the regression runner also
+    reports TFLOPS, GB/s and the percentage of the roofline of the GPU.
+    """
+
+    latency: float
+    flops: float | None = None
+    bytes: float | None = None
 
 
 _RESULTS: list[PerfResult] = []
@@ -25,7 +41,15 @@ _RESULTS_JSON_PREFIX = "__TILELANG_PERF_RESULTS_JSON__="
 
 
 def _results_to_jsonable() -> list[dict[str, float | str]]:
-    return [{"name": r.name, "latency": r.latency} for r in _RESULTS]
+    items = []
+    for r in _RESULTS:
+        item = {"name": r.name, "latency": r.latency}
+        if r.flops is not None:
+            item["flops"] = r.flops
+        if r.bytes is not None:
+            item["bytes"] = r.bytes
+        items.append(item)
+    return items
 
 
 def _emit_results() -> None:
@@ -48,24 +72,32 @@ def _reset_results() -> None:
     _RESULTS.clear()
 
 
-def process_func(func: Callable[..., float], name: str | None = None, /, **kwargs: Any) -> None:
+def _measure(func: Callable[..., float | PerfMeasurement], kwargs: dict[str, Any]) -> PerfMeasurement:
+    result = func(**kwargs)
+    if isinstance(result, PerfMeasurement):
+        return result
+    return PerfMeasurement(latency=float(result))
+
+
+def process_func(func: Callable[..., float | PerfMeasurement], name: str | None = None, /, **kwargs: Any) -> None:
     """Execute a single perf function and record its latency.
 
-    `func` is expected to return a positive latency scalar (seconds or ms; we
-    treat it as an opaque number, only ratios matter for regression).
+    `func` is expected to return a positive latency scalar in ms (only ratios
+    matter for regression), or a PerfMeasurement carrying the work of the
+    launch as well.
     """
     result_name = getattr(func, "__module__", "<unknown>") if name is None else name
     if result_name.startswith("regression_"):
         result_name = result_name[len("regression_") :]
-    latency = float(func(**kwargs))
+    measurement = _measure(func, kwargs)
     _iter = 0
-    while latency <= 0.0 and _iter < _MAX_RETRY_NUM:
-        latency = float(func(**kwargs))
+    while measurement.latency <= 0.0 and _iter < _MAX_RETRY_NUM:
+        measurement = _measure(func, kwargs)
         _iter += 1
-    if latency <= 0.0:
-        warnings.warn(f"{result_name} has latency {latency} <= 0. Please verify the profiling results.", RuntimeWarning, 1)
+    if measurement.latency <= 0.0:
+        warnings.warn(f"{result_name} has latency {measurement.latency} <= 0. Please verify the profiling results.", RuntimeWarning, 1)
         return
-    _RESULTS.append(PerfResult(name=result_name, latency=latency))
+    _RESULTS.append(PerfResult(name=result_name, latency=float(measurement.latency), flops=measurement.flops, bytes=measurement.bytes))
 
 
 def regression(prefixes: Sequence[str] = ("regression_",), verbose: bool = True) -> None:
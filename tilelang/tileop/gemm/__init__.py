@@ -11,7 +11,10 @@ from .gemm_mma_sm70 import GemmMMASm70
 from .gemm_wgmma import GemmWGMMA
 from .gemm_tcgen05 import GemmTCGEN5
 from .gemm_mfma import GemmMFMA
+from .gemm_wmma import GemmWMMA
 from .gemm_cutedsl import GemmCuTeDSL
+from .gemm_gemv import GemmGEMV
+from .gemm_metal import GemmMetal
 from tilelang import _ffi_api
 from tilelang.utils.target import target_is_volta
 from tilelang.jit.adapter.utils import is_cutedsl_target
@@ -129,9 +132,10 @@ class GemmPy(Node, Scriptable):
 
         The selection logic follows this priority:
         1. WGMMA for Hopper architecture with sufficient matrix size and warp count
-        2. MFMA for CDNA (AMD) architecture
-        3. MMA for CUDA architecture
-        4. Fallback to MMA for other cases
+        2. GEMV for tiles with fewer than 16 rows and A, B in shared memory
+        3. simdgroup_matrix for Metal, MFMA for CDNA (AMD) architecture, WMMA for RDNA (AMD) architecture
+        4. MMA for CUDA architecture
+        5. Fallback to MMA for other cases
 
         Args:
             thread_nums: Number of threads in the block
@@ -170,6 +174,12 @@ class GemmPy(Node, Scriptable):
             return GemmTCGEN5
         elif gemm_inst.is_mfma():
             return GemmMFMA
+        elif gemm_inst.is_wmma():
+            return GemmWMMA
+        elif gemm_inst.is_gemv():
+            return GemmGEMV
+        elif gemm_inst.is_metal_simdgroup():
+            return GemmMetal
         elif gemm_inst.is_tcgen5mma():
             raise NotImplementedError("TCGEN5MMA is not implemented")
         else:
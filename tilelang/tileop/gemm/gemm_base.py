@@ -121,6 +121,47 @@ class GemmBase:
     def policy(self) -> GemmWarpPolicy:
         return getattr(self.gemm_node, "policy", None)
 
+    @property
+    def fragment_double_buffer(self) -> bool:
+        annotations = getattr(self.gemm_node, "annotations", None)
+        if annotations is None or "fragment_double_buffer" not in annotations:
+            return False
+        return bool(int(annotations["fragment_double_buffer"]))
+
+    @property
+    def use_2cta(self) -> bool:
+        annotations = getattr(self.gemm_node, "annotations", None)
+        if annotations is None or "use_2cta" not in annotations:
+            return False
+        return bool(int(annotations["use_2cta"]))
+
+    @property
+    def is_blockscaled(self) -> bool:
+        return self.SFARegion is not None
+
+    @property
+    def SFARegion(self):
+        return getattr(self.gemm_node, "sfaRegion", None)
+
+    @property
+    def SFBRegion(self):
+        return getattr(self.gemm_node, "sfbRegion", None)
+
+    @property
+    def SFA_tmem(self) -> tir.Buffer:
+        return self.gemm_node.sfaTmemRegion.buffer
+
+    @property
+    def SFB_tmem(self) -> tir.Buffer:
+        return self.gemm_node.sfbTmemRegion.buffer
+
+    @property
+    def sf_vec_size(self) -> int:
+        annotations = getattr(self.gemm_node, "annotations", None)
+        if annotations is None or "sf_vec_size" not in annotations:
+            return 32
+        return int(annotations["sf_vec_size"])
+
     @property
     def mbarptr(self) -> PrimExpr:
         return getattr(self.gemm_node, "mbarPtr", tvm.tir.const(0, T.uint32))
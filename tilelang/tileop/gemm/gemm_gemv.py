@@ -0,0 +1,103 @@
+from .gemm_base import GemmBase
+from tilelang.utils.language import is_full_region
+from tilelang import tvm as tvm
+from tilelang import _ffi_api
+from tvm.target import Target
+from tvm.ir import Range
+from tvm import tir
+from tilelang import language as T
+from tilelang.transform.simplify import _Simplify
+
+
+def _matrix_element(region: tir.BufferRegion, row, col) -> tir.BufferLoad:
+    """Element (row, col) of the matrix held by the last two dims of `region`."""
+    indices = [r.min for r in region.region[:-2]]
+    indices += [region.region[-2].min + row, region.region[-1].min + col]
+    return tir.BufferLoad(region.buffer, indices)
+
+
+class GemmGEMV(GemmBase):
+    """SIMT GEMM for tiles with fewer rows than an MMA tile, e.g. decoding.
+
+    Every thread accumulates one column of C at a time, for all M rows, with
+    ``k_lanes`` consecutive lanes splitting K and each loading ``vec``
+    consecutive elements of A and B at once. The partial sums are merged by an
+    xor butterfly of warp shuffles, leaving the sum in every lane: C is
+    replicated over the ``k_lanes`` lanes of a column. The partition is chosen
+    by GemmPyNode::gemvPartition.
+    """
+
+    def _partition(self, thread_nums: int, target: Target):
+        partition = _ffi_api.GemmPyGemvPartition(self.gemm_node, int(thread_nums), target)
+        assert len(partition) == 2, f"GEMV path does not apply to M={self.M}, N={self.N}, K={self.K}"
+        k_lanes, vec = (int(x) for x in partition)
+        return k_lanes, vec, int(thread_nums) // k_lanes
+
+    def infer_layout(self, target: Target, thread_nums: int):
+        k_lanes, _, slots = self._partition(thread_nums, target)
+        M = self.M
+        layout = T.Fragment(
+            self.C.shape,
+            forward_thread_fn=lambda i, j, rep: (j % slots) * k_lanes + rep,
+            replicate=k_lanes,
+            forward_index_fn=lambda i, j: (j // slots) * M + i,
+        )
+        return {self.C: layout}
+
+    def lower(self, layout_map: dict, target: Target, thread_bounds: Range, thread_var: tir.Var):
+        k_lanes, vec, slots = self._partition(thread_bounds.extent, target)
+        M, N, K = self.M, self.N, self.K
+        in_dtype, accum_dtype = self.in_dtype, self.accum_dtype
+        trans_A, trans_B = self.trans_A, self.trans_B
+        A_region, B_region, C_region = self.ARegion, self.BRegion, self.CRegion
+        C_buf = C_region.buffer
+        clear_accum = self.clear_accum
+        assert is_full_region(C_region), "Fragment output C must be a full region"
+
+        passes = N // slots
+        k_iters = K // (k_lanes * vec)
+        log_k_lanes = k_lanes.bit_length() - 1
+        tx = thread_var - thread_bounds.min
+        lane, slot = tx % k_lanes, tx // k_lanes
+
+        def load_a(i, ki, v):
+            k = (ki * k_lanes + lane) * vec + v
+            return _matrix_element(A_region, k, i) if trans_A else _matrix_element(A_region, i, k)
+
+        def load_b(p, ki, v):
+            k = (ki * k_lanes + lane) * vec + v
+            n = p * slots + slot
+            return _matrix_element(B_region, n, k) if trans_B else _matrix_element(B_region, k, n)
+
+        @T.prim_func
+        def _gemm_gemv() -> None:
+            """
+            Reduces the vec-wide slices of K of the lane against A for every
+            column of the thread, then merges the lanes of the column.
+            """
+            A_local = T.alloc_local((M * vec,), in_dtype)
+            B_local = T.alloc_local((vec,), in_dtype)
+            acc = T.alloc_local((M,), accum_dtype)
+            if clear_accum:
+                T.clear(C_buf)
+            for p in T.unroll(passes):
+                for i in T.unroll(M):
+                    acc[i] = T.cast(0, accum_dtype)
+                for ki in T.serial(k_iters):
+                    for v in T.vectorized(vec):
+                        B_local[v] = load_b(p, ki, v)
+                    for i in T.unroll(M):
+                        for v in T.vectorized(vec):
+                            A_local[i * vec + v] = load_a(i, ki, v)
+                    for i in T.unroll(M):
+                        for v in T.unroll(vec):
+                            acc[i] += T.cast(A_local[i * vec + v], accum_dtype) * T.cast(B_local[v], accum_dtype)
+                for i in T.unroll(M):
+                    if log_k_lanes > 0:
+                        for s in T.unroll(log_k_lanes):
+                            acc[i] += T.shfl_xor(acc[i], T.shift_left(1, s))
+                    C_buf[i, p * slots + slot] += acc[i]
+
+        # Simplify to optimize the index computing
+        # Must inline let statements to simplify the analysis
+        return _Simplify(_gemm_gemv, inline_let=True)
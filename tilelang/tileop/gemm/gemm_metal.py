@@ -0,0 +1,77 @@
+from .gemm_base import GemmBase
+from .inst import GemmInst
+from tilelang.intrinsics.metal_macro_generator import SimdgroupIntrinEmitter
+from tilelang.utils.language import is_shared
+from tilelang import tvm as tvm
+from tvm.target import Target
+from tvm.ir import Range
+from tvm import tir
+from tilelang import language as T
+from tilelang.transform.simplify import _Simplify
+
+
+class GemmMetal(GemmBase):
+    """GEMM on the simdgroup_matrix 8x8 units of Apple GPUs.
+
+    A, B and C all live in threadgroup memory. A simdgroup matrix has no
+    per-thread layout a fragment could describe, so every gemm loads the C
+    tiles of its simdgroup into simdgroup matrices, accumulates the
+    ``block_K / 8`` steps there and stores them back; double buffer A and B
+    with ``T.Pipelined(..., num_stages=2)``. simdgroup_multiply_accumulate takes
+    A, B and C in one dtype, float16, float32 or bfloat16 (Metal 3.1, M3 and
+    later): allocate the shared operands in the accumulator dtype to
+    accumulate 16-bit inputs in float32.
+    """
+
+    def _make_emitter(self, target: Target, thread_nums: int, thread_var: tir.Var | None = None) -> SimdgroupIntrinEmitter:
+        assert self.is_gemm_ss() and is_shared(self.C), (
+            f"simdgroup_matrix gemm expects A, B and C in shared memory, got A: {self.A.scope()}, B: {self.B.scope()}, C: {self.C.scope()}"
+        )
+        m_warp, n_warp = self.policy.compute_warp_partition(self.M, self.N, thread_nums, target, GemmInst.METAL_SIMDGROUP)
+        return SimdgroupIntrinEmitter(
+            a_dtype=self.A.dtype,
+            b_dtype=self.B.dtype,
+            accum_dtype=self.C.dtype,
+            a_transposed=self.trans_A,
+            b_transposed=self.trans_B,
+            block_row_warps=m_warp,
+            block_col_warps=n_warp,
+            warp_row_tiles=int(self.M // m_warp),
+            warp_col_tiles=int(self.N // n_warp),
+            chunk=int(self.K),
+            thread_var=thread_var,
+        )
+
+    def infer_layout(self, target: Target, thread_nums: int):
+        self._make_emitter(target, thread_nums)
+        # simdgroup_load and simdgroup_store address row-major tiles
+        return {}
+
+    def lower(self, layout_map: dict, target: Target, thread_bounds: Range, thread_var: tir.Var):
+        emitter = self._make_emitter(target, thread_bounds.extent, thread_var - thread_bounds.min)
+        A_region, B_region, C_region = self.ARegion, self.BRegion, self.CRegion
+        micro_size_k = emitter.micro_size
+        block_K = emitter.chunk
+        clear_accum = self.clear_accum
+
+        @T.prim_func
+        def _gemm_sss() -> None:
+            """
+            Loads the C tiles of the simdgroup, then for every 8-wide K step the
+            tiles of A and B from threadgroup memory, and accumulates with
+            simdgroup_multiply_accumulate before storing C back.
+            """
+            A_sg = emitter.alloc_a()
+            B_sg = emitter.alloc_b()
+            C_sg = emitter.alloc_c()
+            if clear_accum:
+                emitter.fill_c(C_sg)
+            else:
+                emitter.load_c(C_sg, C_region)
+            for ki in T.unroll(block_K // micro_size_k):
+                emitter.load_a(A_sg, A_region, ki)
+                emitter.load_b(B_sg, B_region, ki)
+                emitter.mma(A_sg, B_sg, C_sg)
+            emitter.store_c(C_sg, C_region)
+
+        return _Simplify(_gemm_sss, inline_let=True)
@@ -1,6 +1,6 @@
 from .gemm_base import GemmBase
 from .inst import GemmInst
-from tilelang.layout import make_swizzled_layout
+from tilelang.layout import make_swizzled_layout, make_mfma_swizzled_layout
 from tilelang.intrinsics.mfma_macro_generator import (
     MatrixCoreIntrinEmitter,
 )
@@ -18,9 +18,11 @@ class GemmMFMA(GemmBase):
         m_warp, n_warp = self.policy.compute_warp_partition(self.M, self.N, thread_nums, target, GemmInst.MFMA)
         warp_row_tiles = int(self.M // m_warp)
         warp_col_tiles = int(self.N // n_warp)
+        # Block scaled gemms may mix e4m3 and e5m2 operands
+        b_dtype = self.B.dtype if self.is_blockscaled else self.in_dtype
         mfma_emitter = MatrixCoreIntrinEmitter(
-            a_dtype=self.in_dtype,
-            b_dtype=self.in_dtype,
+            a_dtype=self.A.dtype,
+            b_dtype=b_dtype,
             accum_dtype=self.accum_dtype,
             a_transposed=self.trans_A,
             b_transposed=self.trans_B,
@@ -30,24 +32,25 @@ class GemmMFMA(GemmBase):
             warp_col_tiles=warp_col_tiles,
             chunk=self.chunk,
             k_pack=self.k_pack,
+            is_gfx950=self._is_gfx950(target),
         )
 
         if self.is_gemm_ss():
             return {
-                self.A: make_swizzled_layout(self.A),
-                self.B: make_swizzled_layout(self.B),
+                self.A: self._make_shared_layout(self.A, mfma_emitter, matrix="A"),
+                self.B: self._make_shared_layout(self.B, mfma_emitter, matrix="B"),
                 self.C: mfma_emitter.make_mfma_store_layout(self.C),
             }
         elif self.is_gemm_sr():
             return {
-                self.A: make_swizzled_layout(self.A),
+                self.A: self._make_shared_layout(self.A, mfma_emitter, matrix="A"),
                 self.B: mfma_emitter.make_mfma_load_layout(self.B, matrix="B"),
                 self.C: mfma_emitter.make_mfma_store_layout(self.C),
             }
         elif self.is_gemm_rs():
             return {
                 self.A: mfma_emitter.make_mfma_load_layout(self.A, matrix="A"),
-                self.B: make_swizzled_layout(self.B),
+                self.B: self._make_shared_layout(self.B, mfma_emitter, matrix="B"),
                 self.C: mfma_emitter.make_mfma_store_layout(self.C),
             }
         elif self.is_gemm_rr():
@@ -59,14 +62,33 @@ class GemmMFMA(GemmBase):
         else:
             raise ValueError(f"Unsupported gemm combination, A: {self.A.scope()}, B: {self.B.scope()}")
 
+    def _make_shared_layout(self, buf, mfma_emitter: MatrixCoreIntrinEmitter, matrix: str):
+        """The LDS layout of a shared operand.
+
+        A K-major operand is read ``local_size * k_pack`` elements per lane, in
+        ds_read_b64 or ds_read_b128 as wide as the row allows, and the lanes of
+        one LDS clock read consecutive rows: swizzle in units of that width so
+        they hit distinct banks. The other operands keep the generic swizzle.
+        """
+        k_major = not self.trans_A if matrix == "A" else self.trans_B
+        if not k_major:
+            return make_swizzled_layout(buf)
+        local_size = mfma_emitter.local_size_a if matrix == "A" else mfma_emitter.local_size_b
+        vec_bytes = min(local_size * mfma_emitter.k_pack * tvm.DataType(buf.dtype).bits // 8, 16)
+        if vec_bytes < 8:
+            return make_swizzled_layout(buf)
+        return make_mfma_swizzled_layout(buf, vec_bytes=vec_bytes)
+
     def lower(self, layout_map: dict, target: Target, thread_bounds: Range, thread_var: tir.Var):
         thread_nums = thread_bounds.extent
         m_warp, n_warp = self.policy.compute_warp_partition(self.M, self.N, thread_nums, target, GemmInst.MFMA)
         warp_row_tiles = int(self.M // m_warp)
         warp_col_tiles = int(self.N // n_warp)
+        # Block scaled gemms may mix e4m3 and e5m2 operands
+        b_dtype = self.B.dtype if self.is_blockscaled else self.in_dtype
         mfma_emitter = MatrixCoreIntrinEmitter(
-            a_dtype=self.in_dtype,
-            b_dtype=self.in_dtype,
+            a_dtype=self.A.dtype,
+            b_dtype=b_dtype,
             accum_dtype=self.accum_dtype,
             a_transposed=self.trans_A,
             b_transposed=self.trans_B,
@@ -77,9 +99,10 @@ class GemmMFMA(GemmBase):
             chunk=self.chunk,
             thread_var=thread_var,
             k_pack=self.k_pack,
+            is_gfx950=self._is_gfx950(target),
         )
 
-        in_dtype = self.in_dtype
+        in_dtype = self.A.dtype
         warp_rows = mfma_emitter.warp_rows
         warp_cols = mfma_emitter.warp_cols
         local_size_a = mfma_emitter.local_size_a
@@ -103,7 +126,28 @@ class GemmMFMA(GemmBase):
 
         assert is_full_region(C_region), "Fragment output C must be a full region"
 
-        if self.is_gemm_ss():
+        if self.is_blockscaled:
+            assert self.is_gemm_ss(), "block scaled mfma expects A and B in shared memory"
+            SFA_region = self.SFARegion
+            SFB_region = self.SFBRegion
+
+            @T.prim_func
+            def _gemm_ssr_blockscaled() -> None:
+                """
+                Same as _gemm_ssr, but every mfma scales its K-slice by the
+                scale factors of the rows of A and columns of B.
+                """
+                A_local = T.alloc_local((warp_rows * local_size_a), in_dtype)
+                B_local = T.alloc_local((warp_cols * local_size_b), b_dtype)
+                if clear_accum:
+                    T.clear(C_buf)
+                for ki in T.serial(0, (block_K // micro_size_k)):
+                    mfma_emitter.ldmatrix_a(A_local, A_region, ki)
+                    mfma_emitter.ldmatrix_b(B_local, B_region, ki)
+                    mfma_emitter.mfma_blockscaled(A_local, B_local, C_buf, SFA_region, SFB_region, ki)
+
+            return _Simplify(_gemm_ssr_blockscaled, inline_let=True)
+        elif self.is_gemm_ss():
 
             @T.prim_func
             def _gemm_ssr() -> None:
@@ -217,6 +261,10 @@ class GemmMFMA(GemmBase):
         else:
             raise ValueError(f"Unsupported gemm combination, A: {self.A.scope()}, B: {self.B.scope()}")
 
+    @staticmethod
+    def _is_gfx950(target: Target) -> bool:
+        return str(target.attrs.get("mcpu", "")).startswith("gfx950")
+
     def is_gemm_ss(self) -> bool:
         return is_shared(self.A) and is_shared(self.B)
 
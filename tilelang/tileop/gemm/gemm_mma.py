@@ -29,6 +29,7 @@ class GemmMMA(GemmBase):
             warp_row_tiles=warp_row_tiles,
             warp_col_tiles=warp_col_tiles,
             chunk=self.chunk,
+            target=target,
         )
         if self.is_gemm_ss():
             return {
@@ -62,9 +63,11 @@ class GemmMMA(GemmBase):
         m_warp, n_warp = self.policy.compute_warp_partition(self.M, self.N, thread_nums, target, GemmInst.MMA)
         warp_row_tiles = int(self.M // m_warp)
         warp_col_tiles = int(self.N // n_warp)
+        # Block scaled gemms may mix e4m3 and e5m2 operands
+        b_dtype = self.B.dtype if self.is_blockscaled else self.in_dtype
         mma_emitter = TensorCoreIntrinEmitter(
             a_dtype=self.in_dtype,
-            b_dtype=self.in_dtype,
+            b_dtype=b_dtype,
             accum_dtype=self.accum_dtype,
             a_transposed=self.trans_A,
             b_transposed=self.trans_B,
@@ -74,6 +77,7 @@ class GemmMMA(GemmBase):
             warp_col_tiles=warp_col_tiles,
             chunk=self.chunk,
             thread_var=thread_var,
+            target=target,
         )
 
         in_dtype = self.in_dtype
@@ -99,7 +103,57 @@ class GemmMMA(GemmBase):
 
         assert is_full_region(C_region), "Fragment output C must be a full region"
 
-        if self.is_gemm_ss():
+        num_k_slices = block_K // micro_size_k
+        if self.is_blockscaled:
+            assert self.is_gemm_ss(), "block scaled mma expects A and B in shared memory"
+            SFA_region = self.SFARegion
+            SFB_region = self.SFBRegion
+
+            @T.prim_func
+            def _gemm_ssr_blockscaled() -> None:
+                """
+                Same as _gemm_ssr, but every mma scales its K-slice by the
+                scale factors of the rows of A and columns of B.
+                """
+                A_local = T.alloc_local((warp_rows * local_size_a), in_dtype)
+                B_local = T.alloc_local((warp_cols * local_size_b), b_dtype)
+                if clear_accum:
+                    T.clear(C_buf)
+                for ki in T.serial(0, num_k_slices):
+                    mma_emitter.ldmatrix_a(A_local, A_region, ki)
+                    mma_emitter.ldmatrix_b(B_local, B_region, ki)
+                    mma_emitter.mma_blockscaled(A_local, B_local, C_buf, SFA_region, SFB_region, ki)
+
+            return _Simplify(_gemm_ssr_blockscaled, inline_let=True)
+        elif self.is_gemm_ss() and self.fragment_double_buffer and num_k_slices % 2 == 0:
+            num_k_pairs = num_k_slices // 2
+
+            @T.prim_func
+            def _gemm_ssr_double_buffer() -> None:
+                """
+                Same as _gemm_ssr, but with two register buffers per operand:
+                the ldmatrix of K-slice ki + 1 is issued before the mma ops of
+                slice ki, so that shared memory latency is hidden behind them.
+                """
+                A_local_0 = T.alloc_local((warp_rows * local_size_a), in_dtype)
+                B_local_0 = T.alloc_local((warp_cols * local_size_b), in_dtype)
+                A_local_1 = T.alloc_local((warp_rows * local_size_a), in_dtype)
+                B_local_1 = T.alloc_local((warp_cols * local_size_b), in_dtype)
+                if clear_accum:
+                    T.clear(C_buf)
+                mma_emitter.ldmatrix_a(A_local_0, A_region, 0)
+                mma_emitter.ldmatrix_b(B_local_0, B_region, 0)
+                for kp in T.unroll(num_k_pairs):
+                    mma_emitter.ldmatrix_a(A_local_1, A_region, kp * 2 + 1)
+                    mma_emitter.ldmatrix_b(B_local_1, B_region, kp * 2 + 1)
+                    mma_emitter.mma(A_local_0, B_local_0, C_buf, kp * 2)
+                    if kp < num_k_pairs - 1:
+                        mma_emitter.ldmatrix_a(A_local_0, A_region, kp * 2 + 2)
+                        mma_emitter.ldmatrix_b(B_local_0, B_region, kp * 2 + 2)
+                    mma_emitter.mma(A_local_1, B_local_1, C_buf, kp * 2 + 1)
+
+            return _Simplify(_gemm_ssr_double_buffer, inline_let=True)
+        elif self.is_gemm_ss():
 
             @T.prim_func
             def _gemm_ssr() -> None:
@@ -1,6 +1,6 @@
 from .gemm_base import GemmBase
 from .inst import GemmInst
-from tilelang.layout import make_tcgen05mma_swizzled_layout
+from tilelang.layout import make_tcgen05mma_swizzled_layout, make_tcgen05_scale_factor_layout
 from tilelang.intrinsics.tcgen05_macro_generator import (
     TensorCoreIntrinEmitter,
 )
@@ -41,17 +41,25 @@ class GemmTCGEN5(GemmBase):
         )
         a_is_k_major = not self.trans_A
         b_is_k_major = self.trans_B
+        # each CTA of a 2-CTA pair holds half of the N columns of B
+        b_n = self.N // 2 if self.use_2cta else self.N
 
         if self.is_gemm_ss():
             a_continuity = self.M if a_is_k_major else 4 * self.K // m_warp
-            b_continuity = self.K if b_is_k_major else self.N // n_warp
+            b_continuity = self.K if b_is_k_major else b_n // n_warp
 
-            return {
+            layouts = {
                 # WGMMA does not support padding
                 self.A: make_tcgen05mma_swizzled_layout(self.A, continuity=a_continuity, k_major=a_is_k_major),
                 self.B: make_tcgen05mma_swizzled_layout(self.B, continuity=b_continuity, k_major=b_is_k_major),
                 self.C: mma_emitter.make_mma_store_layout(self.C),
             }
+            if self.is_blockscaled:
+                # the scale factors are copied into tensor memory in chunks of
+                # 128 rows x 4 scale factors
+                layouts[self.SFARegion.buffer] = make_tcgen05_scale_factor_layout(self.SFARegion)
+                layouts[self.SFBRegion.buffer] = make_tcgen05_scale_factor_layout(self.SFBRegion)
+            return layouts
         # No special swizzle requirement; rely on existing layout.
         return {}
 
@@ -81,7 +89,14 @@ class GemmTCGEN5(GemmBase):
         if not self.is_gemm_ss():
             raise ValueError(f"TCGEN5MMA currently only supports gemm_ss, got A scope {self.A.scope()}, B scope {self.B.scope()}")
 
-        atom_m, atom_n, atom_k, enable_ws, enable_2cta = mma_emitter.get_tcgen5_mma_meta(self.M, self.N, self.K)
+        cta_group = 2 if self.use_2cta else 1
+        if self.is_blockscaled and cta_group == 2:
+            raise ValueError("Block scaled TCGEN5MMA does not support use_2cta")
+        if cta_group == 2 and not mma_emitter.get_tcgen5_mma_meta(self.M, self.N, self.K, use_2cta=True):
+            raise ValueError(
+                f"Unsupported 2-CTA TCGEN5MMA configuration: M={self.M}, N={self.N}, K={self.K}, "
+                f"A dtype={self.in_dtype}, accum dtype={self.accum_dtype}, it requires M == 128 and N % 32 == 0"
+            )
 
         if self.A.scope() not in {"shared", "shared.dyn", "shared.tmem"}:
             raise ValueError(f"Unsupported A scope for TCGEN5MMA: {self.A.scope()}")
@@ -119,6 +134,35 @@ class GemmTCGEN5(GemmBase):
             "TCGEN5MMA requires thread bounds to be multiples of warp size (32) and aligned to warps."
         )
 
+        if self.is_blockscaled:
+            SFA_shared = self.SFARegion
+            SFB_shared = self.SFBRegion
+            SFA_tmem = self.SFA_tmem
+            SFB_tmem = self.SFB_tmem
+            sf_vec_size = self.sf_vec_size
+
+            @T.prim_func
+            def _gemm_blockscaled() -> None:
+                if thread_var // 32 == thread_bounds.min // warp_size:
+                    mma_emitter.tcgen05mma_blockscaled(
+                        A_shared, B_shared, C_local, SFA_shared, SFB_shared, SFA_tmem, SFB_tmem, mbarptr, clear_accum, sf_vec_size
+                    )
+
+            return _Simplify(_gemm_blockscaled, inline_let=True)
+
+        if cta_group == 2:
+            # The even CTA of the pair issues the MMAs over the operands of
+            # both, which the cluster barrier publishes. Every thread of both
+            # CTAs must reach it, which rules out warp specialized kernels.
+            @T.prim_func
+            def _gemm_ss_2cta() -> None:
+                T.fence_proxy_async()
+                T.cluster_sync()
+                if T.cluster_rank() % 2 == 0 and thread_var // 32 == thread_bounds.min // warp_size:
+                    mma_emitter.tcgen05mma(A_shared, B_shared, C_local, mbarptr, clear_accum, cta_group=2)
+
+            return _Simplify(_gemm_ss_2cta, inline_let=True)
+
         @T.prim_func
         def _gemm_ss_cond() -> None:
             if thread_var // 32 == thread_bounds.min // warp_size:
@@ -1,13 +1,16 @@
 from enum import IntEnum
 
 
-# TODO(lei): support Volta and WMMA?
+# TODO(lei): support Volta?
 # same definition with src/op/gemm.h
 class GemmInst(IntEnum):
     MMA = 0
     WGMMA = 1
     TCGEN5MMA = 2
     MFMA = 3
+    WMMA = 4
+    GEMV = 5
+    METAL_SIMDGROUP = 6
 
     def is_mma(self) -> bool:
         return self == GemmInst.MMA
@@ -21,5 +24,14 @@ class GemmInst(IntEnum):
     def is_mfma(self) -> bool:
         return self == GemmInst.MFMA
 
+    def is_wmma(self) -> bool:
+        return self == GemmInst.WMMA
+
+    def is_gemv(self) -> bool:
+        return self == GemmInst.GEMV
+
+    def is_metal_simdgroup(self) -> bool:
+        return self == GemmInst.METAL_SIMDGROUP
+
     def __repr__(self) -> str:
         return self.name
@@ -2,6 +2,7 @@ from tilelang import tvm as tvm
 from tvm import tir
 from tilelang.utils.target import (
     target_is_cuda,
+    target_is_cdna,
 )
 from tvm.target import Target
 from tvm.ir.base import Node
@@ -10,6 +11,7 @@ from tvm.runtime import Scriptable
 import tvm_ffi
 from tilelang.tileop.base import GemmWarpPolicy
 from .gemm_sp_mma import GemmSPMMA
+from .gemm_sp_mfma import GemmSPMFMA
 
 
 @tvm_ffi.register_global_func("tl.gemm_sp_py.infer_layout")
@@ -57,6 +59,8 @@ class GemmSPPy(Node, Scriptable):
         if target_is_cuda(target):
             # TODO(lei): Support more cuda architectures, now mma only
             return GemmSPMMA(self).infer_layout(target, thread_nums)
+        elif target_is_cdna(target):
+            return GemmSPMFMA(self).infer_layout(target, thread_nums)
         else:
             raise ValueError(f"Unsupported target: {target}")
 
@@ -65,5 +69,7 @@ class GemmSPPy(Node, Scriptable):
             # TODO(lei): Support more cuda architectures, now mma only
             # Now only implement ssr layout
             return GemmSPMMA(self).lower(target, thread_nums, thread_var)
+        elif target_is_cdna(target):
+            return GemmSPMFMA(self).lower(target, thread_nums, thread_var)
         else:
             raise ValueError(f"Unsupported target: {target}")
@@ -0,0 +1,117 @@
+from .gemm_sp_base import GemmSPBase
+from tilelang.tileop.gemm.inst import GemmInst
+from tilelang.layout import make_swizzled_layout
+from tilelang.intrinsics.mfma_macro_generator import SparseMatrixCoreIntrinEmitter
+from tilelang import tvm as tvm
+from tvm.target import Target
+from tvm import tir
+from tilelang import language as T
+from tilelang.transform.simplify import _Simplify
+
+
+class GemmSPMFMA(GemmSPBase):
+    def _make_emitter(self, target: Target, thread_nums: int, thread_var: tir.Var | None = None):
+        mcpu = str(target.attrs.get("mcpu", ""))
+        if not mcpu.startswith(("gfx94", "gfx95")):
+            raise ValueError(f"Sparse mfma requires CDNA3 or newer, got {mcpu}")
+        m_warp, n_warp = self.policy.compute_warp_partition(self.M, self.N, thread_nums, target, GemmInst.MFMA)
+        warp_row_tiles = int(self.M // m_warp)
+        warp_col_tiles = int(self.N // n_warp)
+        return SparseMatrixCoreIntrinEmitter(
+            a_dtype=self.in_dtype,
+            e_dtype=self.e_dtype,
+            b_dtype=self.in_dtype,
+            accum_dtype=self.accum_dtype,
+            a_transposed=self.trans_A,
+            b_transposed=self.trans_B,
+            e_transposed=self.trans_E,
+            block_row_warps=m_warp,
+            block_col_warps=n_warp,
+            warp_row_tiles=warp_row_tiles,
+            warp_col_tiles=warp_col_tiles,
+            warp_k=self.K,
+            thread_var=thread_var,
+        )
+
+    def infer_layout(self, target: Target, thread_nums: int):
+        mfma_emitter = self._make_emitter(target, thread_nums)
+        if self.is_gemm_ss():
+            return {
+                self.A: make_swizzled_layout(self.A),
+                self.B: make_swizzled_layout(self.B),
+                self.C: mfma_emitter.make_mfma_store_layout(self.C),
+            }
+        elif self.is_gemm_sr():
+            return {
+                self.A: make_swizzled_layout(self.A),
+                self.B: mfma_emitter.make_mfma_load_layout(self.B, matrix="B"),
+                self.C: mfma_emitter.make_mfma_store_layout(self.C),
+            }
+        else:
+            raise ValueError(f"Unsupported gemm combination for sparse mfma, A: {self.A.scope()}, B: {self.B.scope()}")
+
+    def lower(self, target: Target, thread_nums: int, thread_var: tir.Var):
+        mfma_emitter = self._make_emitter(target, thread_nums, thread_var)
+
+        in_dtype = self.in_dtype
+        warp_rows = mfma_emitter.warp_rows
+        warp_cols = mfma_emitter.warp_cols
+        local_size_a = mfma_emitter.local_size_a
+        local_size_e = mfma_emitter.local_size_e
+        local_size_b = mfma_emitter.local_size_b
+        micro_size_k = mfma_emitter.micro_size_k
+        A_shared = self.A
+        E_shared = self.E
+        B_shared = self.B
+        C_local = self.C
+        clear_accum = self.clear_accum
+        assert micro_size_k <= self.K, f"K dimension {self.K} should be >= micro size k {micro_size_k}"
+        if self.is_gemm_ss():
+
+            @T.prim_func
+            def _gemm_ssr() -> None:
+                """
+                The inner macro that loads data from shared buffers A_shared,
+                E_shared and B_shared into local fragments, then issues sparse
+                Matrix Core ops, accumulating into C_local.
+                """
+                A_local = T.alloc_local((warp_rows * local_size_a), in_dtype)
+                E_local = T.alloc_local((warp_rows * local_size_e), T.int32)
+                B_local = T.alloc_local((warp_cols * local_size_b), in_dtype)
+
+                if clear_accum:
+                    T.clear(C_local)
+
+                for ki in T.serial(0, (self.K // micro_size_k)):
+                    mfma_emitter.ldmatrix_a(A_local, A_shared, ki)
+                    mfma_emitter.ldmatrix_e(E_local, E_shared, ki)
+                    mfma_emitter.ldmatrix_b(B_local, B_shared, ki)
+                    mfma_emitter.mfma_sp(A_local, E_local, B_local, C_local)
+
+            # Simplify to optimize the index computing
+            # Must inline let statements to simplify the analysis
+            return _Simplify(_gemm_ssr, inline_let=True)
+        elif self.is_gemm_sr():
+            B_local = self.B
+
+            @T.prim_func
+            def _gemm_srr() -> None:
+                """
+                The inner macro that loads data from shared buffers A_shared
+                and E_shared into local fragments, then issues sparse Matrix
+                Core ops with the register resident B, accumulating into C_local.
+                """
+                A_local = T.alloc_local((warp_rows * local_size_a), in_dtype)
+                E_local = T.alloc_local((warp_rows * local_size_e), T.int32)
+
+                if clear_accum:
+                    T.clear(C_local)
+
+                for ki in T.serial(0, (self.K // micro_size_k)):
+                    mfma_emitter.ldmatrix_a(A_local, A_shared, ki)
+                    mfma_emitter.ldmatrix_e(E_local, E_shared, ki)
+                    mfma_emitter.mfma_sp(A_local, E_local, B_local, C_local, ki)
+
+            return _Simplify(_gemm_srr, inline_let=True)
+        else:
+            raise ValueError(f"Unsupported gemm combination for sparse mfma, A: {self.A.scope()}, B: {self.B.scope()}")
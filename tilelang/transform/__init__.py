@@ -9,6 +9,9 @@ from tvm.ir.transform import PassContext  # noqa: F401
 from .add_bufstore_wrapper import AddWrapperForSingleBufStore  # noqa: F401
 from .hoist_broadcast_values import HoistBroadcastValues  # noqa: F401
 from .decouple_type_cast import DecoupleTypeCast  # noqa: F401
+from .min_blocks_per_sm import ResolveMinBlocksPerSM  # noqa: F401
+from .horizontal_fusion import fuse_kernels  # noqa: F401
+from .megakernel import fuse_task_graph, task_graph_workspace_size  # noqa: F401
 
 
 def get_pass_context():
@@ -38,6 +41,20 @@ def PipelinePlanning():
     return _ffi_api.PipelinePlanning()  # type: ignore
 
 
+def PipelineStageSelection():
+    """Resolve ``T.Pipelined(..., num_stages="auto")`` to a concrete depth
+
+    The depth is chosen from the shared memory capacity of the target and the
+    bytes of the shared buffers each stage fills from global memory.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.PipelineStageSelection()  # type: ignore
+
+
 def LayoutInference():
     """LayoutInference
 
@@ -149,6 +166,91 @@ def RewriteWgmmaSync():
     return _ffi_api.RewriteWgmmaSync()  # type: ignore
 
 
+def EliminateRedundantCopies():
+    """Remove the copies from global memory that reload a tile nothing has
+    written since, and hoist the copies that load the same tile in every
+    iteration of a loop out of it.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.EliminateRedundantCopies()  # type: ignore
+
+
+def EliminateDeadFragmentStores():
+    """Remove the writes of local and fragment buffers nothing reads, and fold
+    the clear of an accumulator into the first gemm that overwrites it.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.EliminateDeadFragmentStores()  # type: ignore
+
+
+def FuseSiblingReductions():
+    """Fuse consecutive reductions of the same fragment along the same
+    dimension into one reduction with several outputs.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.FuseSiblingReductions()  # type: ignore
+
+
+def FuseSiblingParallelLoops():
+    """Fuse consecutive elementwise parallel loops over the same tile, and
+    turn the fragments only passed between them into scalars.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.FuseSiblingParallelLoops()  # type: ignore
+
+
+def CoalesceTmaCopies():
+    """Merge consecutive copies from global into adjacent shared regions into
+    one copy, lowered to a single TMA load.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.CoalesceTmaCopies()  # type: ignore
+
+
+def DeferWgmmaWait():
+    """Move the wait of every Hopper gemm in a loop to the first statement
+    that depends on it, with the smallest wgmma.wait_group depth.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.DeferWgmmaWait()  # type: ignore
+
+
+def ScheduleWarpGroupPingPong():
+    """Alternate the two consumer warpgroups of the loops marked by
+    ``T.annotate_pingpong`` at the tensor cores, through named barriers.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.ScheduleWarpGroupPingPong()  # type: ignore
+
+
 def ThreadSync(storage_scope: str):
     """Insert sync between parallel read/write of shared buffers.
 
@@ -284,6 +386,31 @@ def LegalizeSafeMemoryAccess():
     return _ffi_api.LegalizeSafeMemoryAccess()  # type: ignore
 
 
+def LoopUnswitching():
+    """Hoist the boundary checks of loop nests out of them, so that interior
+    tiles run the nests without predicates and edge tiles run them guarded.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.LoopUnswitching()  # type: ignore
+
+
+def AggregateAtomics():
+    """Mark the atomic add, max and min calls whose destinations the lanes of a
+    warp may share, so that they combine their values before issuing one atomic
+    per distinct address.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.AggregateAtomics()  # type: ignore
+
+
 def MakePackedAPI():
     """MakePackedAPI
 
@@ -393,7 +520,17 @@ def FlattenBuffer():
 
 
 def EliminateStorageSyncForMBarrier():
-    """EliminateStorageSyncForMBarrier"""
+    """Remove the block-wide syncs that order no conflicting pair of shared
+    memory accesses: the accesses on both sides are disjoint for all threads,
+    both read, or a TMA write is read after an mbarrier wait of all threads.
+    Disabled by ``tl.disable_sync_elision``, each removed sync is logged with
+    ``tl.enable_sync_elision_verbose``.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
     return _ffi_api.EliminateStorageSyncForMBarrier()  # type: ignore
 
 
@@ -413,11 +550,70 @@ def LowerL2Persistent():
     return _ffi_api.LowerL2Persistent()  # type: ignore
 
 
+def ReduceIndexStrength():
+    """Hoist the loop-invariant parts of the flattened buffer indices into let
+    bindings in front of their loops, and divide the provably non-negative
+    indices by constants as unsigned.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.ReduceIndexStrength()  # type: ignore
+
+
+def LowerFastMath():
+    """Replace exp2, exp and tanh in ``T.fastmath`` regions by approximations
+    of the special function unit within the ulp budget of the region, packed
+    over pairs of halves when vectorized, and drop the regions.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.LowerFastMath()  # type: ignore
+
+
+def PredictRegisterPressure():
+    """Estimate the registers each thread keeps live from the local buffers and
+    let-bound values, recompute cheap values at their uses where the estimate
+    exceeds the budget, and warn about the loop where it still does.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.PredictRegisterPressure()  # type: ignore
+
+
+def DemoteThreadPrivateShared():
+    """Demote the shared buffers whose elements each thread only accesses its
+    own contiguous slice of to local buffers holding that slice.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.DemoteThreadPrivateShared()  # type: ignore
+
+
 def MarkCudaSyncCalls(have_pdl: bool = False):
     """MarkCudaSyncCalls"""
     return _ffi_api.MarkCudaSyncCalls(have_pdl)  # type: ignore
 
 
+def ChainCudaKernelLaunches(have_pdl: bool = False):
+    """Chain consecutive device kernels of a host function with PDL.
+
+    Only active when ``tl.enable_pdl_chaining`` is set in the pass context.
+    """
+    return _ffi_api.ChainCudaKernelLaunches(have_pdl)  # type: ignore
+
+
 def PersistThreadblock():
     """PersistThreadblock"""
     return _ffi_api.PersistThreadblock()  # type: ignore
@@ -0,0 +1,164 @@
+"""Horizontal fusion of independent kernels into a single launch.
+
+A decode step launches many small kernels that neither depend on each other
+nor fill the GPU on their own (per layer norms, RoPE, the small gemms of
+different heads). ``fuse_kernels`` concatenates their grids along
+``blockIdx.x``: every range of block indices runs the body of one original
+kernel, with its block indices recovered from the offset within the range.
+The fused kernel launches the largest thread block of all kernels, and the
+bodies written for fewer threads are guarded by their thread range, which is
+the range layout inference then distributes their fragments over.
+
+Each body keeps its own shared allocations. They are only live in their
+branch, so ``MergeSharedMemoryAllocations`` lets the branches reuse the same
+dynamic shared memory and the fused kernel needs the largest footprint
+rather than their sum.
+"""
+
+from __future__ import annotations
+
+from collections.abc import Sequence
+
+from tvm import arith, tir
+from tvm.ir import Range
+from tvm.tir.stmt_functor import renew_defs, substitute
+
+_BLOCK_TAGS = ("blockIdx.x", "blockIdx.y", "blockIdx.z")
+_THREAD_TAGS = ("threadIdx.x", "threadIdx.y", "threadIdx.z")
+_THREAD_INDEX = 1
+
+
+def _cast(dtype: str, value: tir.PrimExpr) -> tir.PrimExpr:
+    return value if value.dtype == dtype else tir.Cast(dtype, value)
+
+
+def _int32(value: tir.PrimExpr) -> tir.PrimExpr:
+    return _cast("int32", value)
+
+
+def _split_launch(func: tir.PrimFunc) -> tuple[dict[str, tuple[tir.Var, tir.PrimExpr]], tir.Stmt]:
+    """The launch extents of the ``T.Kernel`` of ``func`` and the body inside it."""
+    body = func.body
+    if isinstance(body, tir.BlockRealize) and not body.block.alloc_buffers and not body.block.match_buffers:
+        body = body.block.body
+    launch = {}
+    while isinstance(body, tir.AttrStmt) and body.attr_key == "thread_extent":
+        launch[body.node.thread_tag] = (body.node.var, body.value)
+        body = body.body
+    name = func.attrs["global_symbol"] if func.attrs and "global_symbol" in func.attrs else "kernel"
+    if not any(tag in launch for tag in _BLOCK_TAGS) or any(tag not in _BLOCK_TAGS + _THREAD_TAGS for tag in launch):
+        raise ValueError(f"{name} must be a single GPU T.Kernel to be fused")
+    for tag in _THREAD_TAGS:
+        if tag in launch and not isinstance(launch[tag][1], tir.IntImm):
+            raise ValueError(f"{name} launches a dynamic number of threads along {tag}")
+    return launch, body
+
+
+def _prepare_kernels(funcs: Sequence[tir.PrimFunc]):
+    """Splits the kernels and chooses the thread block running all of them."""
+    # Fresh definitions, so that a kernel may be fused with itself
+    kernels = [(func, *_split_launch(func)) for func in (renew_defs(func) for func in funcs)]
+    num_threads = {}
+    for _, launch, _ in kernels:
+        for tag in _THREAD_TAGS:
+            if tag in launch:
+                num_threads[tag] = max(num_threads.get(tag, 1), launch[tag][1].value)
+    thread_vars = {tag: tir.Var(tag.replace("threadIdx.", "t"), "int32") for tag in num_threads}
+    return kernels, num_threads, thread_vars
+
+
+def _bind_body(launch, body, local, num_threads, thread_vars, analyzer):
+    """The body of a kernel running its block ``local`` on the fused thread block.
+
+    Returns the body and the number of blocks of the kernel.
+    """
+    grid = [_int32(launch[tag][1]) if tag in launch else tir.IntImm("int32", 1) for tag in _BLOCK_TAGS]
+    vmap = {}
+    block_index = [
+        tir.floormod(local, grid[0]),
+        tir.floormod(tir.floordiv(local, grid[0]), grid[1]),
+        tir.floordiv(local, grid[0] * grid[1]),
+    ]
+    for tag, index in zip(_BLOCK_TAGS, block_index):
+        if tag in launch:
+            var = launch[tag][0]
+            vmap[var] = analyzer.simplify(_cast(var.dtype, index))
+    guards = []
+    for tag, extent in num_threads.items():
+        threads = launch[tag][1].value if tag in launch else 1
+        if tag in launch:
+            var = launch[tag][0]
+            vmap[var] = _cast(var.dtype, thread_vars[tag])
+        if threads < extent:
+            guards.append(thread_vars[tag] < threads)
+    body = substitute(body, vmap)
+    if guards:
+        # The spare threads of the fused block idle through this body
+        cond = guards[0]
+        for guard in guards[1:]:
+            cond = tir.And(cond, guard)
+        body = tir.IfThenElse(cond, body, None)
+    return body, analyzer.simplify(grid[0] * grid[1] * grid[2])
+
+
+def _launch(stmt, block_var, num_blocks, num_threads, thread_vars):
+    """``stmt`` launched on ``num_blocks`` blocks of the fused thread block."""
+    for tag in reversed(_THREAD_TAGS):
+        if tag in num_threads:
+            extent = tir.IntImm("int32", num_threads[tag])
+            stmt = tir.AttrStmt(tir.IterVar(Range(0, extent), thread_vars[tag], _THREAD_INDEX, tag), "thread_extent", extent, stmt)
+    return tir.AttrStmt(tir.IterVar(Range(0, num_blocks), block_var, _THREAD_INDEX, "blockIdx.x"), "thread_extent", num_blocks, stmt)
+
+
+def _fused_params(kernels):
+    params, buffer_map = [], {}
+    for func, _, _ in kernels:
+        params.extend(func.params)
+        buffer_map.update(func.buffer_map)
+    return params, buffer_map
+
+
+def fuse_kernels(funcs: Sequence[tir.PrimFunc], name: str = "fused_kernel") -> tir.PrimFunc:
+    """Fuses independent kernels into one kernel launched once.
+
+    The kernels must not depend on each other's results, since their blocks
+    run concurrently. The parameters of the fused kernel are those of
+    ``funcs``, in order, so it is called with the arguments of every kernel
+    one after the other.
+
+    Bodies written for warp specialization rewrite the thread count of the
+    kernel they are in and should be compiled with
+    ``tl.disable_warp_specialized`` once fused.
+
+    Args:
+        funcs: The kernels, each a PrimFunc whose body is one ``T.Kernel``.
+        name: Global symbol of the fused kernel.
+
+    Returns:
+        The fused PrimFunc.
+    """
+    if len(funcs) < 2:
+        raise ValueError(f"fuse_kernels takes at least two kernels, got {len(funcs)}")
+    analyzer = arith.Analyzer()
+    kernels, num_threads, thread_vars = _prepare_kernels(funcs)
+    block_var = tir.Var("bx", "int32")
+
+    offset = tir.IntImm("int32", 0)
+    offsets, bodies = [], []
+    for _, launch, body in kernels:
+        body, num_blocks = _bind_body(launch, body, block_var - offset, num_threads, thread_vars, analyzer)
+        offsets.append(offset)
+        bodies.append(body)
+        offset = analyzer.simplify(offset + num_blocks)
+
+    stmt = bodies[-1]
+    for i in reversed(range(len(bodies) - 1)):
+        stmt = tir.IfThenElse(block_var < offsets[i + 1], bodies[i], stmt)
+    stmt = _launch(stmt, block_var, offset, num_threads, thread_vars)
+
+    params, buffer_map = _fused_params(kernels)
+    fused = tir.PrimFunc(params, stmt, buffer_map=buffer_map)
+    if kernels[0][0].attrs:
+        for key, value in kernels[0][0].attrs.items():
+            fused = fused.with_attr(key, value)
+    return fused.with_attr("global_symbol", name)
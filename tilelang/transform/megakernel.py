@@ -0,0 +1,187 @@
+"""Megakernels: a graph of dependent kernels run by one persistent kernel.
+
+``fuse_task_graph`` compiles a DAG of kernels, e.g. every kernel of a
+transformer layer, into a single launch. Every block of every kernel is a
+task; the tasks are numbered kernel after kernel in topological order and
+the persistent workers pull them from a device side queue, an atomic
+counter, exactly like ``T.TileQueue``. Before running a task the worker waits
+for its dependencies:
+
+- ``"all"`` (the default) waits until every block of the producer finished,
+  counted by one completion counter per kernel;
+- ``"tile"`` only waits for the block of the producer with the same index,
+  through one flag per block, for elementwise chains over the same grid.
+
+A task only ever waits for tasks claimed before it, by workers that are
+already running, so the graph cannot deadlock whatever the number of
+resident workers. The producer publishes its results with a release after a
+block wide barrier, and the consumer reads them after an acquire followed by
+a barrier.
+
+The workspace of the queue and the counters is the last parameter of the
+fused kernel, an int32 tensor of ``task_graph_workspace_size(...)`` elements
+that must be zeroed before every launch.
+"""
+
+from __future__ import annotations
+
+from collections.abc import Mapping, Sequence
+
+from tvm import arith, tir
+
+from tilelang.transform.horizontal_fusion import _bind_body, _fused_params, _launch, _prepare_kernels
+
+_DEPENDENCY_KINDS = ("all", "tile")
+
+
+def _normalize_deps(num_kernels: int, deps) -> dict[int, list[tuple[int, str]]]:
+    if deps is None:
+        # Stream order: every kernel waits for the one before it
+        return {i: [(i - 1, "all")] for i in range(1, num_kernels)}
+    normalized = {}
+    for consumer, producers in deps.items():
+        edges = []
+        for producer in producers:
+            producer, kind = producer if isinstance(producer, tuple) else (producer, "all")
+            if kind not in _DEPENDENCY_KINDS:
+                raise ValueError(f"unknown dependency kind {kind!r}, expected one of {_DEPENDENCY_KINDS}")
+            if not 0 <= producer < consumer < num_kernels:
+                raise ValueError(f"kernel {consumer} depends on kernel {producer}: kernels must be in topological order")
+            edges.append((producer, kind))
+        normalized[consumer] = edges
+    return normalized
+
+
+def task_graph_workspace_size(funcs: Sequence[tir.PrimFunc]) -> int:
+    """Number of int32 words of the workspace of ``fuse_task_graph(funcs)``."""
+    kernels, num_threads, thread_vars = _prepare_kernels(funcs)
+    analyzer = arith.Analyzer()
+    total = 0
+    for _, launch, body in kernels:
+        _, num_blocks = _bind_body(launch, body, tir.IntImm("int32", 0), num_threads, thread_vars, analyzer)
+        total += int(num_blocks)
+    return 1 + len(kernels) + total
+
+
+def fuse_task_graph(
+    funcs: Sequence[tir.PrimFunc],
+    deps: Mapping[int, Sequence[int | tuple[int, str]]] | None = None,
+    num_workers: int | None = None,
+    name: str = "megakernel",
+) -> tir.PrimFunc:
+    """Fuses a DAG of kernels into one persistent kernel with a task queue.
+
+    Args:
+        funcs: The kernels in topological order, each a PrimFunc whose body
+            is one ``T.Kernel`` with a static grid.
+        deps: For every kernel index, the indices of the kernels it depends
+            on, each optionally as ``(index, "tile")`` to only wait for the
+            block of the same index. By default every kernel depends on the
+            one before it, as on a stream.
+        num_workers: Number of persistent blocks, the number of SMs of the
+            current device by default.
+        name: Global symbol of the fused kernel.
+
+    Returns:
+        The fused PrimFunc, taking the arguments of every kernel one after
+        the other and then the workspace. Like ``fuse_kernels``, it should be
+        compiled with ``tl.disable_warp_specialized``.
+    """
+    from tilelang.language.atomic import _MEMORY_ORDER_ID_MAP
+
+    deps = _normalize_deps(len(funcs), deps)
+    if num_workers is None:
+        import torch
+
+        num_workers = torch.cuda.get_device_properties(torch.cuda.current_device()).multi_processor_count
+    analyzer = arith.Analyzer()
+    kernels, num_threads, thread_vars = _prepare_kernels(funcs)
+    task = tir.Var("task", "int32")
+
+    offsets, bodies, num_tiles = [], [], []
+    offset = 0
+    for _, launch, body in kernels:
+        body, num_blocks = _bind_body(launch, body, task - offset, num_threads, thread_vars, analyzer)
+        if not isinstance(num_blocks, tir.IntImm):
+            raise ValueError("the kernels of a task graph must have static grids")
+        offsets.append(offset)
+        bodies.append(body)
+        num_tiles.append(num_blocks.value)
+        offset += num_blocks.value
+    total = offset
+    for consumer, edges in deps.items():
+        for producer, kind in edges:
+            if kind == "tile" and num_tiles[producer] != num_tiles[consumer]:
+                raise ValueError(f"tile dependency of kernel {consumer} on kernel {producer} with different grids")
+
+    num_kernels = len(kernels)
+    workspace = tir.decl_buffer((1 + num_kernels + total,), "int32", name="task_graph_workspace")
+    workspace_handle = tir.Var("task_graph_workspace_handle", "handle")
+    slot = tir.decl_buffer((1,), "int32", name="task_slot", scope="shared")
+
+    def word(index):
+        return tir.BufferLoad(workspace, [index])
+
+    def flag(kernel, local):
+        return word(1 + num_kernels + offsets[kernel] + local)
+
+    def atomic_add(dst, value, order):
+        return tir.call_intrin("handle", "tl.atomic_add_elem_op", tir.address_of(dst), value, _MEMORY_ORDER_ID_MAP[order])
+
+    def atomic_load(src):
+        return tir.call_intrin("int32", "tl.atomic_load_elem_op", tir.address_of(src), _MEMORY_ORDER_ID_MAP["acquire"])
+
+    def atomic_store(dst, value):
+        return tir.call_intrin("handle", "tl.atomic_store_elem_op", tir.address_of(dst), value, _MEMORY_ORDER_ID_MAP["release"])
+
+    sync = tir.Evaluate(tir.call_intrin("int32", "tir.tvm_storage_sync", "shared"))
+    leader = None
+    for var in thread_vars.values():
+        leader = var == 0 if leader is None else tir.And(leader, var == 0)
+    waited = {(producer, kind) for edges in deps.values() for producer, kind in edges}
+
+    tasks = []
+    for i, body in enumerate(bodies):
+        local = task - offsets[i]
+        waits = []
+        for producer, kind in deps.get(i, []):
+            if kind == "all":
+                cond = atomic_load(word(1 + producer)) < num_tiles[producer]
+            else:
+                cond = atomic_load(flag(producer, local)) == 0
+            waits.append(tir.While(cond, tir.Evaluate(0)))
+        signals = []
+        if (i, "all") in waited:
+            signals.append(tir.Evaluate(atomic_add(word(1 + i), 1, "release")))
+        if (i, "tile") in waited:
+            signals.append(tir.Evaluate(atomic_store(flag(i, local), 1)))
+        stmts = []
+        if waits:
+            stmts += [tir.IfThenElse(leader, tir.SeqStmt(waits) if len(waits) > 1 else waits[0], None), sync]
+        stmts.append(body)
+        if signals:
+            # Every thread of the block is done with the task before it is published
+            stmts += [sync, tir.IfThenElse(leader, tir.SeqStmt(signals) if len(signals) > 1 else signals[0], None)]
+        tasks.append(tir.SeqStmt(stmts) if len(stmts) > 1 else stmts[0])
+
+    dispatch = tasks[-1]
+    for i in reversed(range(len(tasks) - 1)):
+        dispatch = tir.IfThenElse(task < offsets[i + 1], tasks[i], dispatch)
+
+    claim = tir.call_intrin("int32", "tl.atomic_add_ret_elem_op", tir.address_of(word(0)), 1)
+    fetch = tir.IfThenElse(leader, tir.BufferStore(slot, claim, [0]), None)
+    done = tir.IfThenElse(total <= task, tir.Evaluate(tir.call_intrin("handle", "tl.loop_break")), None)
+    # The second barrier keeps the leader from overwriting the slot before
+    # every thread has read the claimed task.
+    inner = tir.LetStmt(task, tir.BufferLoad(slot, [0]), tir.SeqStmt([sync, done, dispatch]))
+    # Every worker claims at most total + 1 tasks
+    loop = tir.For(tir.Var("w", "int32"), 0, total + 1, tir.ForKind.SERIAL, tir.SeqStmt([fetch, sync, inner]))
+    root = tir.BlockRealize([], True, tir.Block([], [], [], "task_graph", loop, alloc_buffers=[slot]))
+    stmt = _launch(root, tir.Var("bx", "int32"), tir.IntImm("int32", num_workers), num_threads, thread_vars)
+
+    params, buffer_map = _fused_params(kernels)
+    params.append(workspace_handle)
+    buffer_map[workspace_handle] = workspace
+    # The tasks may share tensors, so the parameters are not marked as
+    # non-aliasing and read through the coherent path.
+    return tir.PrimFunc(params, stmt, buffer_map=buffer_map).with_attr("global_symbol", name)
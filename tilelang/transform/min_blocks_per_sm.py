@@ -0,0 +1,42 @@
+from tvm.target import Target
+from tvm.tir import AttrStmt, IntImm, PrimFunc
+from tvm.tir.stmt_functor import ir_transform
+from tvm.tir.transform import prim_func_pass
+
+# Attribute attached by T.Kernel(min_blocks_per_sm=...), 0 requests the
+# automatic selection.
+MIN_BLOCKS_PER_SM_ATTR = "pragma_min_blocks_per_sm"
+
+
+def ResolveMinBlocksPerSM(target: Target):
+    """
+    TVM Pass: ResolveMinBlocksPerSM.
+
+    Replaces the ``T.Kernel(min_blocks_per_sm="auto")`` request of a device kernel
+    with the block count chosen by `tilelang.engine.resource.auto_min_blocks_per_sm`
+    from its lowered shared memory plan and register estimate. The CUDA code
+    generator emits the value as the second argument of ``__launch_bounds__``.
+    Explicit block counts are left untouched.
+    """
+
+    def pass_fn(func: PrimFunc, mod, ctx):
+        from tilelang.engine.resource import auto_min_blocks_per_sm
+
+        resolved = {}
+
+        def pre_visit(statement):
+            return None
+
+        def post_visit(statement):
+            if not (isinstance(statement, AttrStmt) and statement.attr_key == MIN_BLOCKS_PER_SM_ATTR):
+                return statement
+            if not (isinstance(statement.value, IntImm) and statement.value.value == 0):
+                return statement
+            if "blocks" not in resolved:
+                resolved["blocks"] = auto_min_blocks_per_sm(func, target)
+            return AttrStmt(statement.node, statement.attr_key, IntImm("int32", resolved["blocks"]), statement.body)
+
+        return func.with_body(ir_transform(func.body, pre_visit, post_visit, ["tir.AttrStmt"]))
+
+    return prim_func_pass(pass_fn, opt_level=0)
+
@@ -29,6 +29,34 @@ class PassConfigKey(str, Enum):
     TL_ENABLE_PTXAS_VERBOSE_OUTPUT = "tl.enable_ptxas_verbose_output"
     """Enable ptxas verbose output. Default: False"""
 
+    TL_FAST_COMPILE = "tl.fast_compile"
+    """Compile quickly at the cost of some kernel performance, to screen
+    autotuning candidates: skip the passes that mostly cost compile time
+    (loop unswitching, aggressive and optimal shared memory merging, the
+    final index simplifications), never print ptxas statistics and pass
+    `-O1` to nvcc and ptxas. Default: False"""
+
+    TL_REGISTER_BUDGET = "tl.register_budget"
+    """Registers per thread the pre-codegen register pressure estimate is
+    checked against. Default: 0, i.e. 65536 divided by the block size, at most
+    255"""
+
+    TL_DISABLE_REMATERIALIZATION = "tl.disable_rematerialization"
+    """Keep cheap let-bound values live instead of recomputing them at their
+    uses where the register pressure estimate exceeds the budget.
+    Default: False"""
+
+    TL_DISABLE_INDEX_STRENGTH_REDUCTION = "tl.disable_index_strength_reduction"
+    """Keep the flattened buffer indices as they are instead of hoisting their
+    loop-invariant parts and dividing non-negative indices as unsigned.
+    Default: False"""
+
+    TL_UNROLL_CODE_SIZE_BUDGET = "tl.unroll_code_size_budget"
+    """Estimated instructions the unrolled loops of a kernel may expand into.
+    A loop that does not fit is unrolled partially with `#pragma unroll N`.
+    Default: 0, i.e. the instruction cache of the target (8192 on CUDA and
+    HIP); negative disables the budget"""
+
     TL_DEVICE_COMPILE_FLAGS = "tl.device_compile_flags"
     """Additional device compiler flags passed to nvcc/NVRTC.
 
@@ -46,12 +74,42 @@ class PassConfigKey(str, Enum):
     TL_CONFIG_INDEX_BITWIDTH = "tl.config_index_bitwidth"
     """Bitwidth for configuration indices. Default: 32"""
 
+    TL_DISABLE_INDEX_BITWIDTH_DISPATCH = "tl.disable_index_bitwidth_dispatch"
+    """Promote the indices whose bounds are only known symbolically to int64
+    instead of versioning the kernel body with a check at kernel entry that
+    picks an int32 version when they fit. Default: False"""
+
     TL_DISABLE_TMA_LOWER = "tl.disable_tma_lower"
     """Disable TMA (Tensor Memory Access) lowering. Default: False"""
 
     TL_DISABLE_SAFE_MEMORY_ACCESS = "tl.disable_safe_memory_legalize"
     """Disable safe memory access optimization. Default: False"""
 
+    TL_DISABLE_LOOP_UNSWITCHING = "tl.disable_loop_unswitching"
+    """Disable hoisting the boundary checks of loop nests out of interior tiles. Default: False"""
+
+    TL_DISABLE_COPY_ELIMINATION = "tl.disable_copy_elimination"
+    """Disable removing the copies that reload a tile already held, and hoisting the copies of a tile every iteration of a loop
+    loads out of the loop. Default: False"""
+
+    TL_DISABLE_DEAD_STORE_ELIMINATION = "tl.disable_dead_store_elimination"
+    """Disable removing the writes of register buffers nothing reads, and folding the clear of an accumulator into the
+    first gemm overwriting it. Default: False"""
+
+    TL_DISABLE_REDUCE_FUSION = "tl.disable_reduce_fusion"
+    """Disable lowering consecutive reductions of the same fragment along the same dimension in one loop and one
+    cross-thread exchange. Default: False"""
+
+    TL_DISABLE_PARALLEL_LOOP_FUSION = "tl.disable_parallel_loop_fusion"
+    """Disable fusing consecutive elementwise T.Parallel loops over the same tile, which keeps the fragments passed
+    between them in registers. Default: False"""
+
+    TL_DISABLE_ALIAS_CHECK = "tl.disable_alias_check"
+    """Disable the check that the ``__restrict__`` buffers of a call do not overlap. Default: False"""
+
+    TL_DISABLE_ATOMIC_AGGREGATION = "tl.disable_atomic_aggregation"
+    """Disable combining the values of the lanes of a warp that atomically update the same address. Default: False"""
+
     TL_DISABLE_VECTORIZE_256 = "tl.disable_vectorize_256"
     """Disable usage of LDG/STG 256. Default: False"""
 
@@ -64,15 +122,138 @@ class PassConfigKey(str, Enum):
     TL_DISABLE_WGMMA = "tl.disable_wgmma"
     """Disable usage of Hopper WGMMA. Default: False"""
 
+    TL_DISABLE_GEMV = "tl.disable_gemv"
+    """Disable the SIMT path of T.gemm for tiles with fewer than 16 rows, which
+    splits K over the lanes of a warp. Default: False"""
+
     TL_DEBUG_MERGE_SHARED_MEMORY_ALLOCATIONS = "tl.debug_merge_shared_memory_allocations"
     """Enable debug information for merge shared memory allocations. Default: False"""
 
     TL_ENABLE_AGGRESSIVE_SHARED_MEMORY_MERGE = "tl.enable_aggressive_shared_memory_merge"
     """Enable aggressive merge of shared memory allocations. Default: False"""
 
+    TL_ENABLE_OPTIMAL_SHARED_MEMORY_PACKING = "tl.enable_optimal_shared_memory_packing"
+    """Pack the merged shared memory buffers into the smallest arena found by an
+    offline search over their lifetimes and alignments, instead of a linear scan,
+    and log the footprint against its lower bound. Slower to compile, meant for
+    kernels one more pipeline stage or CTA per SM away from fitting.
+    Default: False"""
+
+    TL_ENABLE_PDL_CHAINING = "tl.enable_pdl_chaining"
+    """Chain the device kernels of a multi-kernel function with programmatic
+    dependent launch (sm90+). Each kernel but the first waits on its predecessor
+    with pdl_sync and is launched with the PDL attribute, each kernel but the last
+    triggers its successor early. Kernels that already call T.pdl_sync or
+    T.pdl_trigger are left untouched. Default: False"""
+
+    TL_ENABLE_CPU_PARALLEL_GRID = "tl.enable_cpu_parallel_grid"
+    """Run the blocks of CPU kernels (T.Kernel(..., is_cpu=True)) on an OpenMP
+    thread team instead of a serial loop nest. Blocks are scheduled dynamically;
+    the thread count follows OMP_NUM_THREADS and workers are pinned according to
+    OMP_PLACES (e.g. OMP_PLACES=cores). Default: False"""
+
+    TL_ENABLE_COMPILE_PROFILE = "tl.enable_compile_profile"
+    """Record a compile profile (per pass wall time and IR size, codegen and device
+    compiler time, cache hit/miss) attached to the kernel as JITKernel.compile_profile.
+    Also enabled for every kernel by TILELANG_COMPILE_PROFILE=1. Default: False"""
+
+    TL_ENABLE_DEVICE_COMPILE_PCH = "tl.enable_device_compile_pch"
+    """Compile the device code with NVRTC and a persistent precompiled header cache
+    of tl_templates and CUTLASS/CuTe, keyed on the target arch and device compile
+    flags, instead of re-parsing the headers with nvcc for every kernel. Falls back
+    to nvcc when NVRTC >= 12.8 is unavailable or rejects the kernel. On ROCm the
+    device code is compiled in memory with hipRTC (hip-python) instead of hipcc,
+    falling back to hipcc likewise. Default: False"""
+
+    TL_ENABLE_AUTO_L2_PERSISTENT = "tl.enable_auto_l2_persistent"
+    """Let LowerL2Persistent pin the read-only global buffer reused by the most
+    CTAs in the persisting L2 window when the kernel has no
+    T.annotate_l2_hit_ratio. Default: False"""
+
+    TL_WARP_SPECIALIZED_OCCUPANCY = "tl.warp_specialized_occupancy"
+    """CTAs per SM the automatic producer/consumer register split of
+    warp-specialized kernels is sized for. The consumer warp groups get the
+    registers left after the producer's, out of the 64K per SM divided by this
+    occupancy. Default: 1"""
+
+    TL_DISABLE_CACHE_HINT_INFERENCE = "tl.disable_cache_hint_inference"
+    """Disable the no_allocate cache hint inferred for the T.copy global source
+    tiles read by a single block (addressed by every blockIdx of the kernel).
+    Explicit ``cache_hint``/``eviction_policy`` arguments still apply. Default: False"""
+
+    TL_PIPELINE_PREFETCH_DISTANCE = "tl.pipeline_prefetch_distance"
+    """Number of iterations ahead of the TMA loads of a software pipeline whose
+    global tiles are prefetched into L2 (cp.async.bulk.prefetch). Inside a
+    T.Persistent loop the last iterations prefetch the first tiles of the next
+    work item. 0 disables the prefetches. Default: 0"""
+
+    TL_ENABLE_SHARED_SWIZZLE_INFERENCE = "tl.enable_shared_swizzle_inference"
+    """Estimate the bank conflicts of the shared buffers accessed by T.Parallel
+    loops and SIMT copies, and give the buffers no operator laid out the bank
+    swizzle (32B/64B/128B) with the fewest wavefronts. Default: False"""
+
+    TL_ENABLE_BANK_CONFLICT_REPORT = "tl.enable_bank_conflict_report"
+    """Log the estimated bank conflicts of every shared buffer and of its
+    swizzle candidates during layout inference. Default: False"""
+
+    TL_ENABLE_HOST_SIGNATURE_CACHE = "tl.enable_host_signature_cache"
+    """Skip the value checks of the host stub (dtypes, shapes, strides, offsets,
+    devices) while the arguments hash to the signature of the last call that
+    passed them, run them in full otherwise. Requires an LLVM host. Default: False"""
+
+    TL_DISABLE_WGMMA_WAIT_DEFERRAL = "tl.disable_wgmma_wait_deferral"
+    """Keep the wgmma.wait_group 0 right after every Hopper T.gemm instead of
+    deferring it to the first statement that reads its accumulators, and
+    waiting only for the gemms that statement depends on. Default: False"""
+
+    TL_DISABLE_TMA_COALESCE = "tl.disable_tma_coalesce"
+    """Keep consecutive T.copy from one global buffer into adjacent regions of
+    one shared buffer as separate TMA loads instead of merging them into one
+    load of the combined box. Default: False"""
+
+    TL_DISABLE_PIPELINE_TRIP_COUNT_DISPATCH = "tl.disable_pipeline_trip_count_dispatch"
+    """Emit a single fully predicated prologue and epilogue for software
+    pipelines over a dynamic trip count instead of dispatching at runtime
+    between a path for trip counts of at least the number of stages, whose
+    prologue and epilogue drop the bound checks they cannot fail, and a path
+    for shorter trip counts without the steady-state loop. Default: False"""
+
+    TL_PARALLEL_LOWER_WORKERS = "tl.parallel_lower_workers"
+    """Number of threads lowering the independent PrimFuncs of a multi-kernel
+    IRModule concurrently in `tilelang.lower`, including their device codegen
+    and NVCC invocations. 0 or 1 lowers serially, -1 uses all CPUs. Default: 0"""
+
+    TL_DISABLE_PHASE_CACHE = "tl.disable_phase_cache"
+    """Re-run every lowering phase instead of resuming from the module cached
+    after `LowerAndLegalize` or `OptimizeForTarget` by an earlier compile of the
+    same program whose pass configs only differ in configs read by later
+    phases, see `tilelang.engine.phase_cache`. Default: False"""
+
+    TL_ENABLE_PROFILE_REGION = "tl.enable_profile_region"
+    """Lower T.profile_begin/T.profile_end to globaltimer/clock64 records in the
+    profile ring buffer. When disabled the regions compile to nothing. Default: False"""
+
+    TL_DEVICE_ASSERT_MODE = "tl.device_assert_mode"
+    """How T.device_assert is compiled: thread checks and reports every thread,
+    warp votes the condition with __any_sync so a failing warp reports once
+    from its first failing lane, and off compiles the asserts out, conditions
+    included. Default: thread"""
+
+    TL_ENABLE_DEVICE_LOG = "tl.enable_device_log"
+    """Lower T.device_log (and T.print with a log_buffer) to records in the device
+    log ring buffer. When disabled the logs, values included, compile to nothing.
+    Default: False"""
+
     TL_DISABLE_SHUFFLE_ELECT = "tl.disable_shuffle_elect"
     """Disable shuffle election optimization. Default: False"""
 
+    TL_DISABLE_SYNC_ELISION = "tl.disable_sync_elision"
+    """Keep the block-wide syncs the thread sync pass inserted even when the
+    accesses they separate are proven ordered or disjoint. Default: False"""
+
+    TL_ENABLE_SYNC_ELISION_VERBOSE = "tl.enable_sync_elision_verbose"
+    """Log every block-wide sync removed by the sync elision. Default: False"""
+
     TL_DISABLE_THREAD_STORAGE_SYNC = "tl.disable_thread_storage_sync"
     """Disable thread storage synchronization pass. When enabled, disables the
     automatic insertion of thread synchronization barriers (e.g., __syncthreads())
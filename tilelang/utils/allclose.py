@@ -0,0 +1,176 @@
+"""Tolerance checks computed on the device.
+
+``torch_assert_close`` builds several full-size temporaries (the mismatch
+mask, the absolute and relative differences) and prints the tensors when the
+check fails, which is slow and memory hungry for outputs of several GB, e.g.
+when the auto-tuner validates every candidate. ``gpu_allclose`` runs a single
+TileLang kernel over the flattened tensors instead: each block walks a
+grid-stride range and reports its mismatch count, its largest absolute error
+and its first mismatching index, and only these per-block partials are
+reduced by torch.
+
+The kernel is compiled once per pair of dtypes and tolerances, the length of
+the tensors is a dynamic dimension.
+"""
+
+from __future__ import annotations
+
+import functools
+from dataclasses import dataclass
+
+import numpy as np
+import torch
+
+# Partials computed by the checker, independent of the length of the tensors.
+_NUM_BLOCKS = 1024
+_BLOCK = 1024
+_THREADS = 256
+_INT32_MAX = 2**31 - 1
+# Elements handed to one launch, so that the indices fit in int32.
+_MAX_ELEMENTS_PER_LAUNCH = 2**30
+
+
+@dataclass(frozen=True)
+class AllcloseReport:
+    """Outcome of comparing two tensors elementwise within a tolerance."""
+
+    num_mismatched: int
+    total: int
+    max_abs_error: float
+    # index of the first mismatching element, None when every element matches
+    first_index: tuple[int, ...] | None
+
+    @property
+    def mismatched_ratio(self) -> float:
+        return self.num_mismatched / self.total if self.total else 0.0
+
+
+@functools.lru_cache(maxsize=None)
+def allclose_kernel(a_dtype: str, b_dtype: str, rtol: float, atol: float, equal_nan: bool = True):
+    """Compile the checker of `|a - b| <= atol + rtol * |b|` for flat tensors of any length."""
+    import tilelang
+    import tilelang.language as T
+
+    n = T.dynamic("n")
+    num_blocks, block = _NUM_BLOCKS, _BLOCK
+
+    @T.prim_func
+    def check(
+        A: T.Tensor((n,), a_dtype),
+        B: T.Tensor((n,), b_dtype),
+        Count: T.Tensor((num_blocks,), T.int32),
+        MaxErr: T.Tensor((num_blocks,), T.float32),
+        First: T.Tensor((num_blocks,), T.int32),
+    ):
+        with T.Kernel(num_blocks, threads=_THREADS) as bx:
+            bad = T.alloc_fragment((block,), T.int32)
+            err = T.alloc_fragment((block,), T.float32)
+            first = T.alloc_fragment((block,), T.int32)
+            chunk_count = T.alloc_fragment((1,), T.int32)
+            chunk_err = T.alloc_fragment((1,), T.float32)
+            chunk_first = T.alloc_fragment((1,), T.int32)
+            count = T.alloc_fragment((1,), T.int32)
+            max_err = T.alloc_fragment((1,), T.float32)
+            first_bad = T.alloc_fragment((1,), T.int32)
+            T.clear(count)
+            T.clear(max_err)
+            T.fill(first_bad, _INT32_MAX)
+            for c in T.serial(T.ceildiv(n, num_blocks * block)):
+                for i in T.Parallel(block):
+                    idx = (c * num_blocks + bx) * block + i
+                    a = T.if_then_else(idx < n, T.cast(A[idx], T.float32), T.float32(0))
+                    b = T.if_then_else(idx < n, T.cast(B[idx], T.float32), T.float32(0))
+                    diff = T.abs(a - b)
+                    nan_a = T.isnan(a)
+                    nan_b = T.isnan(b)
+                    # a NaN only matches a NaN, and only with equal_nan
+                    nan_mismatch = (nan_a or nan_b) and not (equal_nan and nan_a and nan_b)
+                    is_bad = idx < n and (nan_mismatch or diff > atol + rtol * T.abs(b))
+                    bad[i] = T.if_then_else(is_bad, 1, 0)
+                    # inf - inf is NaN, which must not poison the maximum
+                    err[i] = T.if_then_else(T.isnan(diff), T.float32(0), diff)
+                    first[i] = T.if_then_else(is_bad, idx, _INT32_MAX)
+                T.reduce_sum(bad, chunk_count, dim=0)
+                T.reduce_max(err, chunk_err, dim=0)
+                T.reduce_min(first, chunk_first, dim=0)
+                count[0] = count[0] + chunk_count[0]
+                max_err[0] = T.max(max_err[0], chunk_err[0])
+                first_bad[0] = T.min(first_bad[0], chunk_first[0])
+            Count[bx] = count[0]
+            MaxErr[bx] = max_err[0]
+            First[bx] = first_bad[0]
+
+    return tilelang.compile(check, out_idx=[2, 3, 4])
+
+
+def _dtype_name(dtype: torch.dtype) -> str:
+    return str(dtype).replace("torch.", "")
+
+
+def gpu_allclose(
+    tensor_a: torch.Tensor,
+    tensor_b: torch.Tensor,
+    rtol: float = 1e-2,
+    atol: float = 1e-3,
+    equal_nan: bool = True,
+) -> AllcloseReport:
+    """Compare two CUDA tensors of the same shape on the device.
+
+    Only four scalars are copied back to the host, the mismatch count, the
+    largest absolute error and the first mismatching index.
+    """
+    if tensor_a.shape != tensor_b.shape:
+        raise ValueError(f"Shape mismatch: {tuple(tensor_a.shape)} vs {tuple(tensor_b.shape)}")
+    if not (tensor_a.is_cuda and tensor_b.is_cuda):
+        raise ValueError("gpu_allclose compares CUDA tensors")
+    flat_a = tensor_a.reshape(-1)
+    flat_b = tensor_b.reshape(-1)
+    kernel = allclose_kernel(_dtype_name(flat_a.dtype), _dtype_name(flat_b.dtype), float(rtol), float(atol), equal_nan)
+    total = flat_a.numel()
+    counts, errors, firsts = [], [], []
+    for offset in range(0, total, _MAX_ELEMENTS_PER_LAUNCH):
+        part_a = flat_a[offset : offset + _MAX_ELEMENTS_PER_LAUNCH]
+        part_b = flat_b[offset : offset + _MAX_ELEMENTS_PER_LAUNCH]
+        count, max_err, first = kernel(part_a, part_b)
+        counts.append(count.sum(dtype=torch.int64))
+        errors.append(max_err.max())
+        # the sentinel of a clean part stays above every real index
+        firsts.append(torch.where(first == _INT32_MAX, total, first.to(torch.int64) + offset).min())
+    if not counts:
+        return AllcloseReport(0, 0, 0.0, None)
+    num_mismatched, max_abs_error, first_flat = (
+        torch.stack(counts).sum().item(),
+        torch.stack(errors).max().item(),
+        torch.stack(firsts).min().item(),
+    )
+    first_index = None
+    if num_mismatched > 0:
+        first_index = tuple(int(i) for i in np.unravel_index(first_flat, tuple(tensor_a.shape)))
+    return AllcloseReport(num_mismatched, total, max_abs_error, first_index)
+
+
+def gpu_assert_close(
+    tensor_a: torch.Tensor,
+    tensor_b: torch.Tensor,
+    rtol: float = 1e-2,
+    atol: float = 1e-3,
+    max_mismatched_ratio: float = 0.001,
+    equal_nan: bool = True,
+    base_name: str = "LHS",
+    ref_name: str = "RHS",
+) -> AllcloseReport:
+    """`torch_assert_close` computed by `gpu_allclose`, without printing the tensors."""
+    report = gpu_allclose(tensor_a, tensor_b, rtol=rtol, atol=atol, equal_nan=equal_nan)
+    max_allowed_mismatched = int(report.total * max_mismatched_ratio)
+    if report.num_mismatched > max_allowed_mismatched:
+        idx = report.first_index
+        a_val = tensor_a[idx].item()
+        b_val = tensor_b[idx].item()
+        raise AssertionError(
+            f"Too many mismatched elements: {report.num_mismatched} > {max_allowed_mismatched} "
+            f"({max_mismatched_ratio * 100:.2f}% allowed, but get {report.mismatched_ratio * 100:.2f}%)."
+            f"\nFirst mismatch at index {list(idx)}: {base_name}={a_val:.6f}, {ref_name}={b_val:.6f}, "
+            f"abs_diff={abs(a_val - b_val):.6f}"
+            f"\nGreatest absolute difference: {report.max_abs_error}"
+        )
+    return report
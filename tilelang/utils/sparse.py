@@ -1,7 +1,10 @@
 from __future__ import annotations
+import functools
 import os
+from dataclasses import dataclass
 import torch
 import warnings
+from tilelang import tvm
 from tilelang.contrib import nvcc
 from tilelang.utils.tensor import is_float8_dtype, fp8_remove_negative_zeros_
 from torch.utils.cpp_extension import load, _import_module_from_library
@@ -74,10 +77,178 @@ def compress_sm80(A: torch.Tensor, transposed: bool) -> tuple[torch.Tensor, torc
         SparseSemiStructuredTensor._FORCE_CUTLASS = orig_val
 
 
+def compress_cdna(A: torch.Tensor, transposed: bool, e_dtype: torch.dtype = torch.uint8) -> tuple[torch.Tensor, torch.Tensor]:
+    """
+    Compress a 2:4 sparse tensor for the CDNA3 sparse mfma, see `tilelang.layout.make_cdna_metadata_layout`.
+    Each metadata byte holds the 2-bit positions of the kept values of two consecutive groups of 4 along K,
+    wider metadata dtypes pack consecutive bytes little-endian.
+    """
+    if transposed:
+        A = A.t()
+    M, K = A.shape
+    bits = torch.iinfo(e_dtype).bits
+    if K % bits != 0:
+        raise ValueError(f"K ({K}) should be divisible by {bits} for {e_dtype} metadata")
+    groups = A.reshape(M, K // 4, 4)
+    # keep the non-zeros, preferring the lower positions when a group has fewer than 2
+    score = (groups != 0).to(torch.int32) * 4 - torch.arange(4, device=A.device, dtype=torch.int32)
+    pos = score.topk(2, dim=-1).indices.sort(dim=-1).values
+    A_sp = groups.gather(-1, pos).reshape(M, K // 2)
+    nibble = (pos[..., 0] | (pos[..., 1] << 2)).reshape(M, K // 8, 2)
+    E = (nibble[..., 0] | (nibble[..., 1] << 4)).to(torch.uint8).view(e_dtype)
+    if transposed:
+        A_sp = A_sp.t()
+    return A_sp.contiguous(), E.contiguous()
+
+
+def _default_metadata_dtype(dtype: str, arch: str) -> str:
+    if arch.startswith("gfx") or nvcc.parse_compute_version(arch) >= (9, 0):
+        return "uint8"
+    # sm8x packs the groups of a 16-bit operand in int16, of an 8-bit one in int32
+    return "int16" if tvm.DataType(dtype).bits == 16 else "int32"
+
+
+def make_compressor(
+    M: int,
+    K: int,
+    dtype: str,
+    arch: str | None = None,
+    e_dtype: str | None = None,
+    transposed: bool = False,
+    threads: int = 256,
+    **layout_args,
+):
+    """
+    Build a TileLang kernel compressing a tensor to 2:4 sparsity along K, with magnitude pruning.
+
+    Each group of 4 values along K keeps its two largest magnitudes, the lower positions on ties, so a tensor
+    which already is 2:4 sparse is compressed losslessly, and a dense one is pruned on the way. The kept values
+    go to ``A_sp [M, K // 2]`` in order, and their 2-bit positions to the metadata ``E [M, K // bits(e_dtype)]``:
+    every 4 bits hold the two positions of a group, low bits first. ``E`` is annotated with
+    ``make_cutlass_metadata_layout``, so it is stored in the layout ``T.gemm_sp`` reads.
+
+    Args:
+        M, K: Shape of the dense operand, ``[K, M]`` when ``transposed``
+        dtype: 8 or 16-bit operand dtype
+        arch: Target architecture, e.g. "8.0", "9.0" or "gfx942", the current device by default
+        e_dtype: Metadata dtype, what the architecture expects by default
+        transposed: Whether the operand and ``A_sp`` are transposed, i.e. K-major
+        threads: Threads per block, each compresses one metadata element
+        **layout_args: Passed to ``make_cutlass_metadata_layout``, e.g. ``block_k`` for sm90
+
+    Returns:
+        The ``T.prim_func`` ``(A, A_sp, E)``
+    """
+    import tilelang.language as T
+    from tilelang.layout import make_cutlass_metadata_layout
+
+    dtype = str(T.dtype(dtype))
+    if tvm.DataType(dtype).bits not in (8, 16):
+        raise NotImplementedError(f"2:4 compression of {dtype} is not supported, only 8 and 16-bit dtypes are")
+    if arch is None:
+        arch = "gfx" if torch.version.hip is not None else nvcc.get_target_compute_version()
+    if e_dtype is None:
+        e_dtype = _default_metadata_dtype(dtype, arch)
+    e_dtype = str(T.dtype(e_dtype))
+    e_bits = tvm.DataType(e_dtype).bits
+    if K % e_bits != 0:
+        raise ValueError(f"K ({K}) should be divisible by {e_bits} for {e_dtype} metadata")
+    n_meta = K // e_bits
+    A_shape = (K, M) if transposed else (M, K)
+    A_sp_shape = (K // 2, M) if transposed else (M, K // 2)
+
+    def at(buffer, row, k):
+        return buffer[k, row] if transposed else buffer[row, k]
+
+    # consecutive threads read consecutive rows of a K-major operand
+    def row_of(idx):
+        return idx % M if transposed else idx // n_meta
+
+    def col_of(idx):
+        return idx // M if transposed else idx % n_meta
+
+    # whether the value at q is kept before the one at p
+    def beats(vals, q, p):
+        mag_q, mag_p = T.abs(T.Cast(T.float32, vals[q])), T.abs(T.Cast(T.float32, vals[p]))
+        return mag_q > mag_p or (mag_q == mag_p and q < p)
+
+    @T.prim_func
+    def compress_2to4(
+        A: T.Tensor(A_shape, dtype),
+        A_sp: T.Tensor(A_sp_shape, dtype),
+        E: T.Tensor((M, n_meta), e_dtype),
+    ):
+        with T.Kernel(T.ceildiv(M * n_meta, threads), threads=threads) as bx:
+            T.annotate_layout({E: make_cutlass_metadata_layout(E, mma_dtype=dtype, arch=arch, **layout_args)})
+            tx = T.get_thread_binding()
+            vals = T.alloc_local((4,), dtype)
+            meta = T.alloc_var(T.uint32)
+            kept = T.alloc_var(T.int32)
+            rank = T.alloc_var(T.int32)
+            idx = bx * threads + tx
+            row = row_of(idx)
+            col = col_of(idx)
+            if idx < M * n_meta:
+                meta = T.uint32(0)
+                for g in T.unroll(e_bits // 4):
+                    for p in T.unroll(4):
+                        vals[p] = at(A, row, col * e_bits + g * 4 + p)
+                    kept = 0
+                    for p in T.unroll(4):
+                        rank = 0
+                        for q in T.unroll(4):
+                            if q != p and beats(vals, q, p):
+                                rank += 1
+                        if rank < 2:
+                            if transposed:
+                                A_sp[col * (e_bits // 2) + g * 2 + kept, row] = vals[p]
+                            else:
+                                A_sp[row, col * (e_bits // 2) + g * 2 + kept] = vals[p]
+                            meta = meta | (T.Cast(T.uint32, p) << T.Cast(T.uint32, g * 4 + kept * 2))
+                            kept += 1
+                E[row, col] = T.Cast(e_dtype, meta)
+
+    return compress_2to4
+
+
+@functools.lru_cache(maxsize=None)
+def _compressor_kernel(M, K, dtype, arch, e_dtype, transposed, layout_args):
+    import tilelang
+
+    func = make_compressor(M, K, dtype, arch=arch, e_dtype=e_dtype, transposed=transposed, **dict(layout_args))
+    return tilelang.compile(func, out_idx=[1, 2])
+
+
+def compress_on_device(
+    A: torch.Tensor,
+    transposed: bool = False,
+    arch: str | None = None,
+    e_dtype: torch.dtype | None = None,
+    **layout_args,
+) -> tuple[torch.Tensor, torch.Tensor]:
+    """
+    Compress ``A`` to 2:4 sparsity on the GPU with the kernel of ``make_compressor``, pruning by magnitude.
+
+    The outputs are what ``compress`` returns for a tensor with two non-zeros in every group of 4 (groups with
+    fewer may encode the positions of their zeros differently), but compression stays on the device and needs no
+    extension build, e.g. to recompress the pruned weights every few steps of training.
+    The kernel is compiled once per shape, dtype and metadata layout.
+    """
+    K, M = A.shape if transposed else A.shape[::-1]
+    dtype = str(A.dtype).replace("torch.", "")
+    if e_dtype is not None:
+        e_dtype = str(e_dtype).replace("torch.", "")
+    kernel = _compressor_kernel(M, K, dtype, arch, e_dtype, transposed, tuple(sorted(layout_args.items())))
+    return kernel(A.contiguous())
+
+
 def compress(A: torch.Tensor, transposed: bool, arch: str | None = None, **kwargs) -> tuple[torch.Tensor, torch.Tensor]:
     """
-    Compress a tensor using the appropriate method based on the CUDA architecture.
+    Compress a tensor using the appropriate method based on the CUDA or CDNA architecture.
     """
+    if (arch is None and torch.version.hip is not None) or (arch is not None and arch.startswith("gfx")):
+        return compress_cdna(A, transposed=transposed, e_dtype=kwargs.get("e_dtype", torch.uint8))
+
     if arch is None:
         arch = nvcc.get_target_compute_version()
 
@@ -168,3 +339,66 @@ def arange_semi_sparse(M: int, K: int, dtype=torch.float16, device="cuda", trans
     if transposed:
         tensor = tensor.t().contiguous()
     return tensor
+
+
+@dataclass
+class BlockSparseLayout:
+    """
+    Compressed (CSR) schedule of a block-sparse attention mask.
+
+    Row ``r = (b * heads + h) * num_q_blocks + m`` stands for query block ``m``
+    of head ``h`` of batch ``b``; its active KV blocks are
+    ``col_idx[row_ptr[r]:row_ptr[r + 1]]`` in increasing order.
+
+    Attributes:
+        row_ptr (torch.Tensor): int32 ``[rows + 1]`` offsets into ``col_idx``.
+        col_idx (torch.Tensor): int32 ``[max(nnz, 1)]`` active KV blocks.
+        row_order (torch.Tensor): int32 ``[rows]`` rows by decreasing number of
+            active blocks, the order in which CTAs should pick them up.
+        max_row_nnz (int): Largest number of active blocks of a row.
+    """
+
+    row_ptr: torch.Tensor
+    col_idx: torch.Tensor
+    row_order: torch.Tensor
+    max_row_nnz: int
+
+    @property
+    def num_rows(self) -> int:
+        return self.row_order.numel()
+
+
+def compress_block_mask(block_mask: torch.Tensor, batch: int | None = None, heads: int | None = None) -> BlockSparseLayout:
+    """
+    Compress a block mask into the CSR schedule of its active KV blocks.
+
+    Kernels iterating the schedule only visit active blocks instead of scanning
+    the dense mask, and launching the rows in ``row_order`` hands the longest
+    rows out first so CTAs finish evenly.
+
+    Args:
+        block_mask (torch.Tensor): Boolean ``[batch, heads, q_blocks, kv_blocks]``
+            mask, or a static ``[q_blocks, kv_blocks]`` one shared by every batch
+            and head (``batch`` and ``heads`` are then required).
+        batch (int, optional): Batch size of a static mask.
+        heads (int, optional): Number of heads of a static mask.
+
+    Returns:
+        BlockSparseLayout: The compressed schedule, on the device of the mask.
+    """
+    if block_mask.dim() == 2:
+        if batch is None or heads is None:
+            raise ValueError("A static [q_blocks, kv_blocks] mask needs batch and heads")
+        block_mask = block_mask.expand(batch, heads, *block_mask.shape)
+    if block_mask.dim() != 4:
+        raise ValueError(f"Expected a 2D or 4D block mask, got shape {tuple(block_mask.shape)}")
+    mask = block_mask.reshape(-1, block_mask.shape[-1]) != 0
+    row_nnz = mask.sum(dim=-1, dtype=torch.int32)
+    row_ptr = torch.zeros(mask.shape[0] + 1, dtype=torch.int32, device=mask.device)
+    row_ptr[1:] = torch.cumsum(row_nnz, dim=0)
+    # nonzero walks the mask row-major, so the blocks of a row stay sorted
+    col_idx = mask.nonzero()[:, 1].to(torch.int32)
+    if col_idx.numel() == 0:
+        col_idx = torch.zeros(1, dtype=torch.int32, device=mask.device)
+    row_order = torch.argsort(row_nnz, descending=True, stable=True).to(torch.int32)
+    return BlockSparseLayout(row_ptr, col_idx.contiguous(), row_order, int(row_nnz.max().item()) if row_nnz.numel() else 0)
@@ -202,6 +202,10 @@ def target_is_cdna(target: Target) -> bool:
     return _ffi_api.TargetIsCDNA(target)
 
 
+def target_is_rdna(target: Target) -> bool:
+    return _ffi_api.TargetIsRDNA(target)
+
+
 def target_has_async_copy(target: Target) -> bool:
     return _ffi_api.TargetHasAsyncCopy(target)
 
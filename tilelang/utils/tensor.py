@@ -1,5 +1,9 @@
 """The profiler and convert to torch utils"""
 
+from __future__ import annotations
+
+import threading
+from collections import OrderedDict
 from enum import Enum
 import torch
 from tvm import tir
@@ -128,12 +132,15 @@ def get_tensor_supply(supply_type: TensorSupplyType = TensorSupplyType.Integer):
                 return torch.randint(low=0, high=2, size=shape, device=device, dtype=dtype)
             else:
                 return torch.randint(low=-2, high=3, size=shape, device=device, dtype=dtype)
-        elif supply_type == TensorSupplyType.Uniform:
-            return torch.empty(*shape, device=device, dtype=torch.float32).uniform_(-1.0, 1.0).to(dtype)
+
+        # Fill the natively supported float dtypes in place, without a float32 staging tensor
+        fill_dtype = dtype if dtype in {torch.float16, torch.float32, torch.bfloat16} else torch.float32
+        if supply_type == TensorSupplyType.Uniform:
+            return torch.empty(*shape, device=device, dtype=fill_dtype).uniform_(-1.0, 1.0).to(dtype)
         elif supply_type == TensorSupplyType.Normal:
-            return torch.empty(*shape, device=device, dtype=torch.float32).normal_(-1.0, 1.0).to(dtype)
+            return torch.empty(*shape, device=device, dtype=fill_dtype).normal_(-1.0, 1.0).to(dtype)
         elif supply_type == TensorSupplyType.Randn:
-            return torch.randn(*shape, device=device).to(dtype)
+            return torch.randn(*shape, device=device, dtype=fill_dtype).to(dtype)
         elif supply_type == TensorSupplyType.Zero:
             return torch.zeros(*shape, device=device, dtype=dtype)
         elif supply_type == TensorSupplyType.One:
@@ -144,6 +151,105 @@ def get_tensor_supply(supply_type: TensorSupplyType = TensorSupplyType.Integer):
     return get_tensor
 
 
+class TensorSupplyPool:
+    """Inputs generated once per (shape, dtype, supply type) and shared by profilers.
+
+    Benchmarking every configuration of a tuning run on freshly generated
+    inputs spends much of the run allocating and filling tensors of the same
+    shapes. The pool hands out the tensors it generated for a signature
+    instead. The n-th parameter of a signature within one call gets the n-th
+    tensor of that signature, so two inputs of the same shape and dtype, e.g.
+    the keys and the values of an attention, are never aliased.
+
+    Tensors are generated on the device by ``get_tensor_supply`` and the pool
+    evicts the least recently used ones past ``capacity_bytes``, by default a
+    quarter of the memory of the device.
+    """
+
+    def __init__(self, capacity_bytes: int | None = None):
+        self.capacity_bytes = capacity_bytes
+        self._tensors: OrderedDict[tuple, torch.Tensor] = OrderedDict()
+        self._bytes = 0
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.misses = 0
+
+    def _capacity(self) -> int | None:
+        if self.capacity_bytes is None and torch.cuda.is_available():
+            self.capacity_bytes = torch.cuda.get_device_properties(torch.cuda.current_device()).total_memory // 4
+        return self.capacity_bytes
+
+    @staticmethod
+    def _signature(param, supply_type: TensorSupplyType) -> tuple:
+        from .device import get_current_device
+
+        return (
+            tuple(int(extent) if not isinstance(extent, tir.Var) else str(extent) for extent in param.shape),
+            param.torch_dtype(),
+            param.is_unsigned(),
+            supply_type,
+            str(get_current_device()),
+        )
+
+    def get_inputs(self, params: list, supply_type: TensorSupplyType) -> list[torch.Tensor]:
+        """Return one tensor per parameter, generating those the pool lacks."""
+        supply = None
+        ordinals: dict[tuple, int] = {}
+        tensors = []
+        for param in params:
+            signature = self._signature(param, supply_type)
+            ordinal = ordinals.get(signature, 0)
+            ordinals[signature] = ordinal + 1
+            key = (*signature, ordinal)
+            with self._lock:
+                tensor = self._tensors.get(key)
+                if tensor is not None:
+                    self._tensors.move_to_end(key)
+                    self.hits += 1
+            if tensor is None:
+                if supply is None:
+                    supply = get_tensor_supply(supply_type)
+                tensor = supply(param)
+                self._insert(key, tensor)
+            tensors.append(tensor)
+        return tensors
+
+    def _insert(self, key: tuple, tensor: torch.Tensor) -> None:
+        nbytes = tensor.numel() * tensor.element_size()
+        with self._lock:
+            self.misses += 1
+            previous = self._tensors.pop(key, None)
+            if previous is not None:
+                self._bytes -= previous.numel() * previous.element_size()
+            capacity = self._capacity()
+            # the tensors handed out stay alive with their callers, the pool only drops its references
+            while capacity is not None and self._tensors and self._bytes + nbytes > capacity:
+                _, evicted = self._tensors.popitem(last=False)
+                self._bytes -= evicted.numel() * evicted.element_size()
+            self._tensors[key] = tensor
+            self._bytes += nbytes
+
+    @property
+    def nbytes(self) -> int:
+        return self._bytes
+
+    def clear(self) -> None:
+        with self._lock:
+            self._tensors.clear()
+            self._bytes = 0
+
+
+_supply_pool: TensorSupplyPool | None = None
+
+
+def get_supply_pool() -> TensorSupplyPool:
+    """The process-wide pool shared by the profilers of the auto-tuner."""
+    global _supply_pool
+    if _supply_pool is None:
+        _supply_pool = TensorSupplyPool()
+    return _supply_pool
+
+
 # Adapted from https://github.com/pytorch/pytorch/blob/main/torch/testing/_comparison.py
 def _compare_attributes(
     actual: torch.Tensor,
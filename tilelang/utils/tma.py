@@ -0,0 +1,20 @@
+"""Host-side TMA descriptor cache helpers."""
+
+from __future__ import annotations
+
+from tilelang import _ffi_api
+
+
+def get_tma_descriptor_cache_stats() -> dict[str, int]:
+    """Return the hit/miss counters of the runtime TMA descriptor cache.
+
+    ``hits`` counts launches that reused an identical descriptor,
+    ``address_patches`` counts launches that only retargeted the global
+    address of a cached descriptor and ``misses`` counts full re-encodes.
+    """
+    return {str(k): int(v) for k, v in _ffi_api.TensorMapCacheStats().items()}
+
+
+def clear_tma_descriptor_cache() -> None:
+    """Drop every cached TMA descriptor and reset the counters."""
+    _ffi_api.TensorMapCacheClear()
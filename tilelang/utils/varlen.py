@@ -0,0 +1,28 @@
+"""Schedules of ragged batches packed with ``cu_seqlens``."""
+
+from __future__ import annotations
+
+import torch
+
+
+def cu_seqlens_to_cu_tiles(cu_seqlens: torch.Tensor, block_size: int) -> torch.Tensor:
+    """Count the tiles of the sequences of a ragged batch, for ``T.VarlenTiles``.
+
+    Sequence ``b`` spans ``cu_seqlens[b]:cu_seqlens[b + 1]`` and is cut into
+    ``ceil(len / block_size)`` tiles. The prefix sum runs on the device of
+    ``cu_seqlens``, so building the schedule never synchronizes with the host.
+
+    Args:
+        cu_seqlens (torch.Tensor): Cumulative sequence lengths, ``(batch + 1,)``.
+        block_size (int): Tokens of a tile.
+
+    Returns:
+        torch.Tensor: The int32 ``(batch + 1,)`` number of tiles before each
+        sequence, its last element the number of tiles of the batch.
+    """
+    assert cu_seqlens.dim() == 1, "cu_seqlens must be one dimensional"
+    seqlens = (cu_seqlens[1:] - cu_seqlens[:-1]).to(torch.int32)
+    tiles = torch.div(seqlens + block_size - 1, block_size, rounding_mode="floor")
+    cu_tiles = torch.zeros(cu_seqlens.numel(), dtype=torch.int32, device=cu_seqlens.device)
+    cu_tiles[1:] = torch.cumsum(tiles, dim=0, dtype=torch.int32)
+    return cu_tiles